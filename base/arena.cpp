@@ -0,0 +1,68 @@
+#include "base/arena.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace base
+{
+namespace
+{
+uint8_t * Align(uint8_t * p, size_t alignment)
+{
+  auto const address = reinterpret_cast<uintptr_t>(p);
+  return p + ((alignment - address % alignment) % alignment);
+}
+}  // namespace
+
+// static
+size_t constexpr Arena::kDefaultBlockSize;
+
+Arena::Arena(size_t blockSize) : m_blockSize(blockSize)
+{
+  CHECK_GREATER(m_blockSize, 0, ());
+}
+
+void * Arena::Allocate(size_t size, size_t alignment)
+{
+  ASSERT_GREATER(alignment, 0, ());
+  ASSERT_EQUAL(alignment & (alignment - 1), 0, ("Alignment must be a power of two."));
+
+  m_allocated += size;
+  if (size + alignment > m_blockSize / 4)
+  {
+    m_largeBlocks.emplace_back(new uint8_t[size + alignment]);
+    return Align(m_largeBlocks.back().get(), alignment);
+  }
+
+  uint8_t * p = Align(m_begin, alignment);
+  if (m_begin == nullptr || p + size > m_end)
+  {
+    NextBlock();
+    p = Align(m_begin, alignment);
+  }
+  m_begin = p + size;
+  return p;
+}
+
+void Arena::Reset()
+{
+  m_largeBlocks.clear();
+  m_currentBlock = 0;
+  m_begin = m_blocks.empty() ? nullptr : m_blocks[0].get();
+  m_end = m_blocks.empty() ? nullptr : m_begin + m_blockSize;
+  m_allocated = 0;
+}
+
+void Arena::NextBlock()
+{
+  if (m_begin != nullptr)
+    ++m_currentBlock;
+  if (m_currentBlock == m_blocks.size())
+    m_blocks.emplace_back(new uint8_t[m_blockSize]);
+  m_begin = m_blocks[m_currentBlock].get();
+  m_end = m_begin + m_blockSize;
+}
+}  // namespace base
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace base
+{
+// Monotonic allocator for short-lived objects of a request, e.g. containers of a routing
+// query. Memory is taken from big blocks and is released only by Reset() or destruction,
+// so an allocation is a pointer bump. Reset() keeps regular blocks, so a reused arena
+// doesn't touch the heap at all after the first request.
+//
+// *NOTE* This class is NOT thread-safe.
+class Arena
+{
+public:
+  static size_t constexpr kDefaultBlockSize = 64 * 1024;
+
+  explicit Arena(size_t blockSize = kDefaultBlockSize);
+
+  void * Allocate(size_t size, size_t alignment);
+
+  // Invalidates all memory allocated by the arena.
+  void Reset();
+
+  // Total size of allocations since the last Reset().
+  size_t GetAllocatedBytes() const { return m_allocated; }
+
+private:
+  void NextBlock();
+
+  size_t const m_blockSize;
+  std::vector<std::unique_ptr<uint8_t[]>> m_blocks;
+  // Blocks for allocations which are bigger than a quarter of the block size.
+  std::vector<std::unique_ptr<uint8_t[]>> m_largeBlocks;
+  size_t m_currentBlock = 0;
+  uint8_t * m_begin = nullptr;
+  uint8_t * m_end = nullptr;
+  size_t m_allocated = 0;
+
+  DISALLOW_COPY_AND_MOVE(Arena);
+};
+
+// STL allocator over |Arena|. Deallocation is a no-op, memory returns to the arena by Reset().
+// A default constructed allocator uses operator new, so containers with this allocator may be
+// used without an arena as well.
+template <typename T>
+class ArenaAllocator
+{
+public:
+  using value_type = T;
+
+  ArenaAllocator() noexcept = default;
+  explicit ArenaAllocator(Arena & arena) noexcept : m_arena(&arena) {}
+
+  template <typename U>
+  ArenaAllocator(ArenaAllocator<U> const & other) noexcept : m_arena(other.GetArena())
+  {
+  }
+
+  T * allocate(size_t n)
+  {
+    if (m_arena == nullptr)
+      return static_cast<T *>(::operator new(n * sizeof(T)));
+    return static_cast<T *>(m_arena->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T * p, size_t) noexcept
+  {
+    if (m_arena == nullptr)
+      ::operator delete(p);
+  }
+
+  Arena * GetArena() const noexcept { return m_arena; }
+
+private:
+  Arena * m_arena = nullptr;
+};
+
+template <typename T, typename U>
+bool operator==(ArenaAllocator<T> const & lhs, ArenaAllocator<U> const & rhs) noexcept
+{
+  return lhs.GetArena() == rhs.GetArena();
+}
+
+template <typename T, typename U>
+bool operator!=(ArenaAllocator<T> const & lhs, ArenaAllocator<U> const & rhs) noexcept
+{
+  return !(lhs == rhs);
+}
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+}  // namespace base
@@ -8,8 +8,10 @@ ROOT_DIR = ..
 include($$ROOT_DIR/common.pri)
 
 SOURCES += \
+    arena.cpp \
     base.cpp \
     bwt.cpp \
+    coalescing_task.cpp \
     condition.cpp \
     deferred_task.cpp \
     exception.cpp \
@@ -35,11 +37,14 @@ SOURCES += \
     threaded_container.cpp \
     timegm.cpp \
     timer.cpp \
+    trace.cpp \
     uni_string_dfa.cpp \
+    work_stealing_pool.cpp \
     worker_thread.cpp \
 
 HEADERS += \
     SRC_FIRST.hpp \
+    arena.hpp \
     array_adapters.hpp \
     assert.hpp \
     base.hpp \
@@ -50,11 +55,13 @@ HEADERS += \
     cancellable.hpp \
     checked_cast.hpp \
     clustering_map.hpp \
+    coalescing_task.hpp \
     collection_cast.hpp \
     condition.hpp \
     deferred_task.hpp \
     dfa_helpers.hpp \
     exception.hpp \
+    flat_map.hpp \
     get_time.hpp \
     gmtime.hpp \
     internal/message.hpp \
@@ -99,7 +106,9 @@ HEADERS += \
     threaded_priority_queue.hpp \
     timegm.hpp \
     timer.hpp \
+    trace.hpp \
     uni_string_dfa.hpp \
     visitor.hpp \
     waiter.hpp \
+    work_stealing_pool.hpp \
     worker_thread.hpp \
@@ -0,0 +1,74 @@
+#include "testing/testing.hpp"
+
+#include "base/arena.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace base;
+using namespace std;
+
+namespace
+{
+bool IsAligned(void const * p, size_t alignment)
+{
+  return reinterpret_cast<uintptr_t>(p) % alignment == 0;
+}
+
+UNIT_TEST(Arena_Allocate)
+{
+  Arena arena(1024 /* blockSize */);
+  auto * c = static_cast<char *>(arena.Allocate(1, 1));
+  auto * d = arena.Allocate(sizeof(double), alignof(double));
+  TEST(IsAligned(d, alignof(double)), ());
+  TEST_NOT_EQUAL(static_cast<void *>(c), d, ());
+
+  // Allocations which don't fit the current block go to the next one.
+  for (size_t i = 0; i < 100; ++i)
+    TEST(IsAligned(arena.Allocate(100, 16), 16), ());
+
+  // Large allocations.
+  auto * large = static_cast<uint8_t *>(arena.Allocate(10000, 8));
+  large[0] = large[9999] = 1;
+  TEST_EQUAL(arena.GetAllocatedBytes(), 1 + sizeof(double) + 100 * 100 + 10000, ());
+
+  arena.Reset();
+  TEST_EQUAL(arena.GetAllocatedBytes(), 0, ());
+  // Blocks are reused after Reset().
+  TEST_EQUAL(arena.Allocate(1, 1), static_cast<void *>(c), ());
+}
+
+UNIT_TEST(Arena_Containers)
+{
+  Arena arena(4096 /* blockSize */);
+  {
+    ArenaVector<int> v{ArenaAllocator<int>(arena)};
+    for (int i = 0; i < 1000; ++i)
+      v.push_back(i);
+    TEST_EQUAL(v.size(), 1000, ());
+    TEST_EQUAL(v[999], 999, ());
+
+    using Allocator = ArenaAllocator<pair<int const, string>>;
+    map<int, string, less<int>, Allocator> m{Allocator(arena)};
+    unordered_map<int, string, hash<int>, equal_to<int>, Allocator> u{Allocator(arena)};
+    for (int i = 0; i < 100; ++i)
+    {
+      m[i] = to_string(i);
+      u[i] = to_string(i);
+    }
+    TEST_EQUAL(m.size(), 100, ());
+    TEST_EQUAL(u.at(42), "42", ());
+    TEST_GREATER(arena.GetAllocatedBytes(), 1000 * sizeof(int), ());
+  }
+  arena.Reset();
+
+  // Default allocator uses the heap.
+  ArenaVector<string> heap;
+  heap.emplace_back("Hello");
+  TEST_EQUAL(heap.back(), "Hello", ());
+  TEST(heap.get_allocator() != ArenaAllocator<string>(arena), ());
+}
+}  // namespace
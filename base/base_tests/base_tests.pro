@@ -14,15 +14,18 @@ DEFINES += OMIM_UNIT_TEST_DISABLE_PLATFORM_INIT
 
 SOURCES += \
   ../../testing/testingmain.cpp \
+  arena_test.cpp \
   assert_test.cpp \
   bits_test.cpp \
   buffer_vector_test.cpp \
   bwt_tests.cpp \
   cache_test.cpp \
   clustering_map_tests.cpp \
+  coalescing_task_tests.cpp \
   collection_cast_test.cpp \
   condition_test.cpp \
   containers_test.cpp \
+  flat_map_test.cpp \
   levenshtein_dfa_test.cpp \
   logging_test.cpp \
   newtype_test.cpp \
@@ -48,8 +51,10 @@ SOURCES += \
   threads_test.cpp \
   timegm_test.cpp \
   timer_test.cpp \
+  trace_test.cpp \
   uni_string_dfa_test.cpp \
   visitor_tests.cpp \
+  work_stealing_pool_tests.cpp \
   worker_thread_tests.cpp \
 
 HEADERS +=
@@ -4,6 +4,7 @@
 #include "base/checked_cast.hpp"
 
 #include <cstdlib>
+#include <random>
 #include <vector>
 
 namespace
@@ -48,6 +49,26 @@ UNIT_TEST(Select1Test)
   TEST_EQUAL(0U, bits::select1(1, 1), ());
 }
 
+UNIT_TEST(Select64)
+{
+  TEST_EQUAL(bits::Select64(1, 0), 0, ());
+  TEST_EQUAL(bits::Select64(uint64_t(1) << 63, 0), 63, ());
+  TEST_EQUAL(bits::Select64(0xFFFFFFFFFFFFFFFF, 63), 63, ());
+  TEST_EQUAL(bits::Select64(0x8000000100000100, 1), 32, ());
+
+  std::mt19937 rng(0);
+  for (size_t t = 0; t < 1000; ++t)
+  {
+    uint64_t const x = (static_cast<uint64_t>(rng()) << 32) | rng();
+    uint32_t rank = 0;
+    for (uint32_t j = 0; j < 64; ++j)
+    {
+      if ((x >> j) & 1)
+        TEST_EQUAL(bits::Select64(x, rank++), j, (x));
+    }
+  }
+}
+
 UNIT_TEST(ROL)
 {
   TEST_EQUAL(bits::ROL<uint32_t>(0), 0, ());
@@ -103,6 +124,14 @@ UNIT_TEST(NumHiZeroBits64)
   TEST_EQUAL(bits::NumHiZeroBits64(0x000000000000FDEFULL), 48, ());
 }
 
+UNIT_TEST(NumLoZeroBits64)
+{
+  TEST_EQUAL(bits::NumLoZeroBits64(0), 64, ());
+  TEST_EQUAL(bits::NumLoZeroBits64(0xFFFFFFFFFFFFFFFFULL), 0, ());
+  TEST_EQUAL(bits::NumLoZeroBits64(0x0FABCDEF0FABCDE0ULL), 5, ());
+  TEST_EQUAL(bits::NumLoZeroBits64(0x8000000000000000ULL), 63, ());
+}
+
 UNIT_TEST(NumUsedBits)
 {
   TEST_EQUAL(bits::NumUsedBits(0), 0, ());
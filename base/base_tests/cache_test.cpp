@@ -4,6 +4,8 @@
 #include "base/stl_add.hpp"
 
 #include <functional>
+#include <thread>
+#include <vector>
 
 namespace
 {
@@ -180,3 +182,86 @@ UNIT_TEST(Cache_Init)
   TEST_EQUAL(cache.Find(5, found), 'b', ());
   TEST(found, ());
 }
+
+UNIT_TEST(ConcurrentCache_Smoke)
+{
+  // Two shards of two entries.
+  my::ConcurrentCache<uint32_t, uint32_t> cache(4 * sizeof(uint32_t) * 2, 1 /* logShardsCount */);
+
+  uint32_t value = 0;
+  TEST(!cache.Find(1, value), ());
+  cache.Insert(1, 10);
+  TEST(cache.Find(1, value), ());
+  TEST_EQUAL(value, 10, ());
+
+  cache.Insert(1, 11);
+  TEST(cache.Find(1, value), ());
+  TEST_EQUAL(value, 11, ());
+  TEST_EQUAL(cache.GetBytes(), 2 * sizeof(uint32_t), ());
+
+  TEST_EQUAL(cache.GetOrCompute(2, []() { return 20; }), 20, ());
+  TEST_EQUAL(cache.GetOrCompute(2, []() { return 21; }), 20, ());
+
+  TEST_EQUAL(cache.GetAccessCount(), 5, ());
+  TEST_EQUAL(cache.GetMissCount(), 2, ());
+
+  for (uint32_t i = 0; i < 100; ++i)
+    cache.Insert(i, i);
+  TEST_LESS_OR_EQUAL(cache.GetBytes(), 4 * 2 * sizeof(uint32_t), ());
+
+  cache.Clear();
+  TEST_EQUAL(cache.GetBytes(), 0, ());
+  TEST(!cache.Find(99, value), ());
+}
+
+UNIT_TEST(ConcurrentCache_Clock)
+{
+  // A single shard of three entries of different sizes.
+  my::ConcurrentCache<uint32_t, uint32_t> cache(
+      3 /* maxBytes */, 0 /* logShardsCount */,
+      [](uint32_t key, uint32_t /* value */) { return key == 3 ? 2 : 1; });
+
+  cache.Insert(1, 1);
+  cache.Insert(2, 2);
+  cache.Insert(4, 4);
+
+  // Entry 1 is referenced and gets a second chance, entries 2 and 4 are evicted.
+  uint32_t value;
+  TEST(cache.Find(1, value), ());
+  cache.Insert(3, 3);
+
+  TEST(cache.Find(1, value), ());
+  TEST(cache.Find(3, value), ());
+  TEST(!cache.Find(2, value), ());
+  TEST(!cache.Find(4, value), ());
+  TEST_EQUAL(cache.GetBytes(), 3, ());
+
+  // Entries which are larger than a shard are not cached.
+  my::ConcurrentCache<uint32_t, uint32_t> tinyCache(
+      1 /* maxBytes */, 0 /* logShardsCount */,
+      [](uint32_t, uint32_t) { return 2; });
+  tinyCache.Insert(1, 1);
+  TEST(!tinyCache.Find(1, value), ());
+}
+
+UNIT_TEST(ConcurrentCache_Threads)
+{
+  my::ConcurrentCache<uint32_t, uint32_t> cache(1024 * sizeof(uint32_t) * 2);
+
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([&cache, t]() {
+      for (uint32_t i = 0; i < 10000; ++i)
+      {
+        uint32_t const key = (i * 7 + t) % 2048;
+        TEST_EQUAL(cache.GetOrCompute(key, [key]() { return key * 2; }), key * 2, ());
+      }
+    });
+  }
+  for (auto & thread : threads)
+    thread.join();
+
+  TEST_EQUAL(cache.GetAccessCount(), 40000, ());
+  TEST_LESS_OR_EQUAL(cache.GetBytes(), 1024 * sizeof(uint32_t) * 2, ());
+}
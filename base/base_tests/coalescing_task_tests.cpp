@@ -0,0 +1,90 @@
+#include "testing/testing.hpp"
+
+#include "base/coalescing_task.hpp"
+#include "base/worker_thread.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+using namespace base;
+using namespace std;
+
+namespace
+{
+class Counter
+{
+public:
+  void Add(int value)
+  {
+    lock_guard<mutex> lock(m_mu);
+    ++m_calls;
+    m_lastValue = value;
+    m_cv.notify_one();
+  }
+
+  void WaitCalls(int calls)
+  {
+    unique_lock<mutex> lock(m_mu);
+    m_cv.wait(lock, [&]() { return m_calls >= calls; });
+  }
+
+  int GetCalls()
+  {
+    lock_guard<mutex> lock(m_mu);
+    return m_calls;
+  }
+
+  int GetLastValue()
+  {
+    lock_guard<mutex> lock(m_mu);
+    return m_lastValue;
+  }
+
+private:
+  mutex m_mu;
+  condition_variable m_cv;
+  int m_calls = 0;
+  int m_lastValue = -1;
+};
+
+UNIT_TEST(CoalescingTask_Smoke)
+{
+  WorkerThread thread;
+  Counter counter;
+  CoalescingTask task(thread, chrono::milliseconds(100));
+
+  for (int i = 0; i < 100; ++i)
+    task.Push([&counter, i]() { counter.Add(i); });
+  counter.WaitCalls(1);
+  TEST_EQUAL(counter.GetLastValue(), 99, ());
+
+  task.Push([&counter]() { counter.Add(100); });
+  counter.WaitCalls(2);
+  TEST_EQUAL(counter.GetCalls(), 2, ());
+  TEST_EQUAL(counter.GetLastValue(), 100, ());
+}
+
+UNIT_TEST(CoalescingTask_Drop)
+{
+  WorkerThread thread;
+  Counter counter;
+  {
+    CoalescingTask task(thread, chrono::milliseconds(10));
+    task.Push([&counter]() { counter.Add(0); });
+    task.Drop();
+    task.Push([&counter]() { counter.Add(1); });
+    counter.WaitCalls(1);
+    TEST_EQUAL(counter.GetLastValue(), 1, ());
+
+    // Destruction drops the pending task.
+    task.Push([&counter]() { counter.Add(2); });
+  }
+
+  // Waits for the delayed task of the destroyed CoalescingTask.
+  Counter barrier;
+  thread.PushDelayed(chrono::milliseconds(50), [&barrier]() { barrier.Add(0); });
+  barrier.WaitCalls(1);
+  TEST_EQUAL(counter.GetCalls(), 1, ());
+}
+}  // namespace
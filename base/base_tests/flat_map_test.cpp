@@ -0,0 +1,59 @@
+#include "testing/testing.hpp"
+
+#include "base/flat_map.hpp"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace base;
+using namespace std;
+
+namespace
+{
+using Values = vector<pair<int, string>>;
+using IntValues = vector<pair<int, int>>;
+using IntMap = FlatMap<int, int>;
+
+UNIT_TEST(FlatMap_Smoke)
+{
+  FlatMap<int, string> m;
+  TEST(m.empty(), ());
+  TEST(m.find(1) == m.end(), ());
+
+  TEST(m.emplace(5, "five").second, ());
+  TEST(m.emplace(7, "seven").second, ());
+  TEST(m.insert(make_pair(1, "one")).second, ());
+  TEST(!m.emplace(5, "FIVE").second, ());
+  m[3] = "three";
+
+  TEST_EQUAL(m.size(), 4, ());
+  Values const expected = {{1, "one"}, {3, "three"}, {5, "five"}, {7, "seven"}};
+  TEST_EQUAL(Values(m.begin(), m.end()), expected, ());
+
+  auto const it = m.find(5);
+  TEST(it != m.end(), ());
+  TEST_EQUAL(it->second, "five", ());
+  TEST(m.find(4) == m.end(), ());
+  TEST(m.find(8) == m.end(), ());
+  TEST_EQUAL(m.count(3), 1, ());
+
+  TEST_EQUAL(m.erase(3), 1, ());
+  TEST_EQUAL(m.erase(3), 0, ());
+  TEST_EQUAL(m.count(3), 0, ());
+  TEST_EQUAL(m.size(), 3, ());
+
+  m.clear();
+  TEST(m.empty(), ());
+}
+
+UNIT_TEST(FlatMap_InitializerList)
+{
+  IntMap const m = {{3, 30}, {1, 10}, {2, 20}, {1, 100}};
+  TEST_EQUAL(m.size(), 3, ());
+  IntValues const expected = {{1, 10}, {2, 20}, {3, 30}};
+  TEST_EQUAL(IntValues(m.begin(), m.end()), expected, ());
+  IntValues unsorted = {{2, 20}, {3, 30}, {1, 10}};
+  TEST(m == IntMap(move(unsorted)), ());
+}
+}  // namespace
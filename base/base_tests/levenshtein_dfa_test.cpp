@@ -1,10 +1,14 @@
+#include "testing/benchmark.hpp"
 #include "testing/testing.hpp"
 
 #include "base/dfa_helpers.hpp"
 #include "base/levenshtein_dfa.hpp"
+#include "base/stl_add.hpp"
 
+#include <memory>
 #include <sstream>
 #include <string>
+#include <vector>
 
 using namespace std;
 using namespace strings;
@@ -182,4 +186,36 @@ UNIT_TEST(LevenshteinDFA_ErrorsMade)
     TEST_EQUAL(GetResult(dfa, "кафер"), Result(Status::Accepts, 1 /* errorsMade */), ());
   }
 }
+UNIT_TEST(LevenshteinDFA_Copy)
+{
+  unique_ptr<LevenshteinDFA> dfa = my::make_unique<LevenshteinDFA>("paris", 1 /* maxErrors */);
+  LevenshteinDFA const copy = *dfa;
+  auto const numStates = dfa->GetNumStates();
+  dfa.reset();
+
+  TEST_EQUAL(copy.GetNumStates(), numStates, ());
+  TEST_EQUAL(GetResult(copy, "paris"), Result(Status::Accepts, 0 /* errorsMade */), ());
+  TEST_EQUAL(GetResult(copy, "pariz"), Result(Status::Accepts, 1 /* errorsMade */), ());
+  TEST_EQUAL(GetResult(copy, "pzriz").m_status, Status::Rejects, ());
+}
+
+#ifndef DEBUG
+BENCHMARK_TEST(LevenshteinDFA_Match)
+{
+  LevenshteinDFA const dfa("ленинградский", 2 /* maxErrors */);
+
+  // Words of a trie are matched char by char, most of them are rejected early.
+  vector<string> words = {"ленинградский", "ленинградская", "ленинский", "лениградский",
+                          "ленинградскай", "петроградский", "ленинград", "ленинградский проспект"};
+  for (char c = 'a'; c <= 'z'; ++c)
+    words.push_back(string(12, c));
+
+  size_t accepted = 0;
+  testing::RunBenchmark("LevenshteinDFA match", 100 /* warmUps */, 10000 /* repetitions */, [&]() {
+    for (auto const & word : words)
+      accepted += Accepts(dfa, word) ? 1 : 0;
+  });
+  TEST_GREATER(accepted, 0, ());
+}
+#endif
 }  // namespace
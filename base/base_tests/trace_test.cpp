@@ -0,0 +1,82 @@
+#include "testing/testing.hpp"
+
+#include "base/trace.hpp"
+
+#include <mutex>
+#include <sstream>
+#include <string>
+
+using namespace base::trace;
+
+namespace
+{
+size_t CountEvents(EventType type)
+{
+  size_t count = 0;
+  for (auto const & e : GetEvents())
+  {
+    if (e.m_type == type)
+      ++count;
+  }
+  return count;
+}
+}  // namespace
+
+UNIT_TEST(Trace_Disabled)
+{
+  Disable();
+  Enable(4);
+  Disable();
+  {
+    ScopedEvent const event("scope");
+    AddCounter("counter", 1);
+  }
+  TEST(GetEvents().empty(), ());
+}
+
+UNIT_TEST(Trace_RingBuffer)
+{
+  Enable(4);
+  for (uint64_t i = 0; i < 6; ++i)
+    AddCounter("counter", i);
+  {
+    ScopedEvent const event("scope");
+  }
+  Disable();
+
+  auto const events = GetEvents();
+  TEST_EQUAL(events.size(), 4, ());
+  TEST_EQUAL(events[0].m_value, 3, ());
+  TEST_EQUAL(events[1].m_value, 4, ());
+  TEST_EQUAL(events[2].m_value, 5, ());
+  TEST_EQUAL(events[3].m_type, EventType::Scope, ());
+  TEST_EQUAL(std::string(events[3].m_name), "scope", ());
+  for (size_t i = 1; i < events.size(); ++i)
+    TEST_LESS_OR_EQUAL(events[i - 1].m_timestampUs, events[i].m_timestampUs, ());
+
+  std::ostringstream os;
+  Dump(os);
+  TEST_NOT_EQUAL(os.str().find("\tCounter\tcounter\t5\n"), std::string::npos, (os.str()));
+}
+
+UNIT_TEST(Trace_LockWait)
+{
+  Enable(16);
+
+  std::mutex mu;
+  {
+    LockGuard<std::mutex> lock(mu, "uncontended");
+  }
+  TEST_EQUAL(CountEvents(EventType::LockWait), 0, ());
+
+  // Emulates a lock which is held by another thread.
+  bool locked = false;
+  Lock("contended", []() { return false; }, [&locked]() { locked = true; });
+  TEST(locked, ());
+  Disable();
+
+  auto const events = GetEvents();
+  TEST_EQUAL(events.size(), 1, ());
+  TEST_EQUAL(events[0].m_type, EventType::LockWait, ());
+  TEST_EQUAL(std::string(events[0].m_name), "contended", ());
+}
@@ -0,0 +1,168 @@
+#include "testing/testing.hpp"
+
+#include "base/work_stealing_pool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace base;
+using namespace std;
+
+namespace
+{
+UNIT_TEST(WorkStealingPool_Smoke)
+{
+  {
+    WorkStealingPool pool(4 /* threadsCount */);
+    TEST_EQUAL(pool.GetThreadsCount(), 4, ());
+  }
+
+  {
+    WorkStealingPool pool;
+    TEST_GREATER(pool.GetThreadsCount(), 0, ());
+    TEST(pool.Shutdown(WorkStealingPool::Exit::SkipPending), ());
+    TEST(!pool.Shutdown(WorkStealingPool::Exit::SkipPending), ());
+    TEST(!pool.Push([]() {}), ());
+  }
+}
+
+UNIT_TEST(WorkStealingPool_ExecPending)
+{
+  atomic<int> counter(0);
+  {
+    WorkStealingPool pool(3 /* threadsCount */);
+    for (int i = 0; i < 1000; ++i)
+      TEST(pool.Push([&counter]() { ++counter; }), ());
+    TEST(pool.Shutdown(WorkStealingPool::Exit::ExecPending), ());
+  }
+  TEST_EQUAL(counter, 1000, ());
+}
+
+UNIT_TEST(WorkStealingPool_NestedTasks)
+{
+  WorkStealingPool pool(4 /* threadsCount */);
+  atomic<int> counter(0);
+  vector<future<void>> futures;
+  for (int i = 0; i < 10; ++i)
+  {
+    // Tasks pushed by workers are stolen by other workers.
+    futures.push_back(pool.Submit([&pool, &counter]() {
+      for (int j = 0; j < 100; ++j)
+        pool.Push([&counter]() { ++counter; });
+    }));
+  }
+  for (auto & f : futures)
+    f.get();
+  pool.Shutdown(WorkStealingPool::Exit::ExecPending);
+  TEST_EQUAL(counter, 1000, ());
+}
+
+UNIT_TEST(WorkStealingPool_Futures)
+{
+  WorkStealingPool pool(2 /* threadsCount */);
+
+  auto sum = pool.Submit([]() { return 2 + 2; });
+  TEST_EQUAL(sum.get(), 4, ());
+
+  auto error = pool.Submit([]() -> int { throw runtime_error("Error"); });
+  TEST_THROW(error.get(), runtime_error, ());
+
+  auto chained = pool.SubmitThen([]() { return 21; }, [](int x) { return to_string(x * 2); },
+                                 WorkStealingPool::Priority::High);
+  TEST_EQUAL(chained.get(), "42", ());
+}
+
+UNIT_TEST(WorkStealingPool_Cancel)
+{
+  WorkStealingPool pool(1 /* threadsCount */);
+
+  // Blocks the only worker until tasks below are pushed and cancelled.
+  mutex mu;
+  condition_variable cv;
+  bool ready = false;
+  pool.Push([&]() {
+    unique_lock<mutex> lk(mu);
+    cv.wait(lk, [&]() { return ready; });
+  });
+
+  auto cancellable = make_shared<my::Cancellable>();
+  bool called = false;
+  auto cancelled = pool.Submit([&called]() { called = true; },
+                               WorkStealingPool::Priority::Normal, cancellable);
+  auto notCancelled = pool.Submit([]() { return 1; });
+  cancellable->Cancel();
+
+  {
+    lock_guard<mutex> lk(mu);
+    ready = true;
+  }
+  cv.notify_one();
+
+  TEST_THROW(cancelled.get(), WorkStealingPool::CancelledException, ());
+  TEST(!called, ());
+  TEST_EQUAL(notCancelled.get(), 1, ());
+}
+
+UNIT_TEST(WorkStealingPool_Priorities)
+{
+  WorkStealingPool pool(1 /* threadsCount */);
+
+  mutex mu;
+  condition_variable cv;
+  bool ready = false;
+  pool.Push([&]() {
+    unique_lock<mutex> lk(mu);
+    cv.wait(lk, [&]() { return ready; });
+  });
+
+  vector<WorkStealingPool::Priority> order;
+  for (auto const priority : {WorkStealingPool::Priority::Low, WorkStealingPool::Priority::Normal,
+                              WorkStealingPool::Priority::High})
+  {
+    pool.Push([&order, priority]() { order.push_back(priority); }, priority);
+  }
+
+  {
+    lock_guard<mutex> lk(mu);
+    ready = true;
+  }
+  cv.notify_one();
+  pool.Shutdown(WorkStealingPool::Exit::ExecPending);
+
+  TEST_EQUAL(order, vector<WorkStealingPool::Priority>({WorkStealingPool::Priority::High,
+                                                        WorkStealingPool::Priority::Normal,
+                                                        WorkStealingPool::Priority::Low}),
+             ());
+}
+
+UNIT_TEST(WorkStealingPool_SkipPending)
+{
+  WorkStealingPool pool(1 /* threadsCount */);
+  mutex mu;
+  condition_variable cv;
+  bool ready = false;
+  pool.Push([&]() {
+    unique_lock<mutex> lk(mu);
+    cv.wait(lk, [&]() { return ready; });
+  });
+  auto skipped = pool.Submit([]() { return 1; });
+
+  thread unblock([&]() {
+    this_thread::sleep_for(chrono::milliseconds(10));
+    lock_guard<mutex> lk(mu);
+    ready = true;
+    cv.notify_one();
+  });
+  pool.Shutdown(WorkStealingPool::Exit::SkipPending);
+  unblock.join();
+
+  TEST_THROW(skipped.get(), future_error, ());
+}
+}  // namespace
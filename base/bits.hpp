@@ -5,6 +5,10 @@
 #include <limits>
 #include <type_traits>
 
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
 namespace bits
 {
   // Count the number of 1 bits. Implementation: see Hacker's delight book.
@@ -63,11 +67,16 @@ namespace bits
 
   inline uint32_t PopCount(uint64_t x) noexcept
   {
+#if defined(__GNUC__) || defined(__clang__)
+    // Compiles to a single instruction where the hardware supports it.
+    return static_cast<uint32_t>(__builtin_popcountll(x));
+#else
     x = x - ((x & 0xAAAAAAAAAAAAAAAA) >> 1);
     x = (x & 0x3333333333333333) + ((x >> 2) & 0x3333333333333333);
     x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0F;
     x = (x * 0x0101010101010101) >> 56;
     return static_cast<uint32_t>(x);
+#endif
   }
 
   inline uint8_t FloorLog(uint64_t x) noexcept
@@ -191,6 +200,18 @@ namespace bits
     return result;
   }
   
+  inline uint32_t NumLoZeroBits64(uint64_t n)
+  {
+    if (n == 0) return 64;
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<uint32_t>(__builtin_ctzll(n));
+#else
+    uint32_t result = 0;
+    while ((n & 1) == 0) { ++result; n >>= 1; }
+    return result;
+#endif
+  }
+
   // Computes number of bits needed to store the number, it is not equal to number of ones.
   // E.g. if we have a number (in bit representation) 00001000b then NumUsedBits is 4.
   inline uint32_t NumUsedBits(uint64_t n)
@@ -208,4 +229,34 @@ namespace bits
   }
 
   inline bool IsPow2Minus1(uint64_t n) { return (n & (n + 1)) == 0; }
+
+  // Returns position of the |i|-th (0-based) set bit of |x|, |x| must have more than |i| set bits.
+  // It uses pdep when BMI2 is enabled, otherwise it finds the byte by broadword comparison of
+  // byte prefix popcounts, see S. Vigna, "Broadword implementation of rank/select queries".
+  inline uint32_t Select64(uint64_t x, uint32_t i)
+  {
+    ASSERT_LESS(i, PopCount(x), (x));
+#if defined(__BMI2__)
+    return NumLoZeroBits64(_pdep_u64(uint64_t(1) << i, x));
+#else
+    uint64_t const kOnesStep8 = 0x0101010101010101ULL;
+    uint64_t const kMSBsStep8 = 0x80 * kOnesStep8;
+
+    uint64_t s = x - ((x & 0xAAAAAAAAAAAAAAAAULL) >> 1);
+    s = (s & 0x3333333333333333ULL) + ((s >> 2) & 0x3333333333333333ULL);
+    s = (s + (s >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    // The j-th byte is the number of set bits in bytes [0, j].
+    s *= kOnesStep8;
+
+    // Number of bytes with at most |i| set bits in their prefix, multiplied by 8.
+    uint64_t const le = ((i * kOnesStep8 | kMSBsStep8) - s) & kMSBsStep8;
+    uint32_t const place = PopCount(le) * 8;
+    uint32_t rank = i - static_cast<uint32_t>(((s << 8) >> place) & 0xFF);
+
+    uint64_t byte = (x >> place) & 0xFF;
+    for (; rank != 0; --rank)
+      byte &= byte - 1;
+    return place + NumLoZeroBits64(byte);
+#endif
+  }
 }  // namespace bits
@@ -4,9 +4,16 @@
 #include "base/base.hpp"
 #include "base/macros.hpp"
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 
 namespace my
@@ -166,4 +173,187 @@ namespace my
     uint64_t m_miss;
     uint64_t m_access;
   };
+
+  // Thread-safe cache of a bounded size in bytes. Keys are spread over independently locked
+  // shards, so lookups from different threads rarely contend. Every shard evicts entries by
+  // the CLOCK algorithm: an entry which was hit since the last pass of the clock hand gets
+  // a second chance. Values are returned by copy, so heavy values should be kept by shared_ptr.
+  // Hit and miss counters are the same as in CacheWithStat.
+  template <typename TKey, typename TValue, typename THash = std::hash<TKey>>
+  class ConcurrentCache
+  {
+    DISALLOW_COPY_AND_MOVE(ConcurrentCache);
+
+  public:
+    // Returns the number of bytes which are taken by an entry.
+    using SizeFn = std::function<size_t(TKey const & key, TValue const & value)>;
+
+    /// @param[in] maxBytes is a total size of entries in all shards.
+    /// @param[in] logShardsCount is pow of two for number of shards.
+    explicit ConcurrentCache(size_t maxBytes, uint32_t logShardsCount = 4,
+                             SizeFn const & sizeFn = &DefaultSize)
+      : m_shards(size_t(1) << logShardsCount)
+      , m_maxShardBytes(maxBytes >> logShardsCount)
+      , m_sizeFn(sizeFn)
+      , m_miss(0)
+      , m_access(0)
+    {
+      ASSERT_LESS(logShardsCount, 16, ());
+      ASSERT(m_sizeFn, ());
+    }
+
+    // Copies the value of |key| to |value| and returns true if |key| is cached.
+    bool Find(TKey const & key, TValue & value)
+    {
+      m_access.fetch_add(1, std::memory_order_relaxed);
+
+      Shard & shard = GetShard(key);
+      std::lock_guard<std::mutex> lock(shard.m_mutex);
+      auto const it = shard.m_index.find(key);
+      if (it == shard.m_index.end())
+      {
+        m_miss.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+
+      Entry & entry = shard.m_entries[it->second];
+      entry.m_referenced = true;
+      value = entry.m_value;
+      return true;
+    }
+
+    // Caches |value| for |key|, the previous value of |key| is replaced. Values which are
+    // larger than a shard are not cached.
+    void Insert(TKey const & key, TValue const & value)
+    {
+      size_t const bytes = m_sizeFn(key, value);
+      if (bytes > m_maxShardBytes)
+        return;
+
+      Shard & shard = GetShard(key);
+      std::lock_guard<std::mutex> lock(shard.m_mutex);
+      auto const it = shard.m_index.find(key);
+      if (it != shard.m_index.end())
+        RemoveEntry(shard, it->second);
+
+      while (shard.m_bytes + bytes > m_maxShardBytes)
+        EvictEntry(shard);
+
+      shard.m_index.emplace(key, shard.m_entries.size());
+      shard.m_entries.push_back({key, value, bytes, false /* referenced */});
+      shard.m_bytes += bytes;
+    }
+
+    // Returns a cached value of |key| or caches and returns |fn()|. |fn| is called without
+    // locks, so concurrent misses of the same key may call it several times.
+    template <typename Fn>
+    TValue GetOrCompute(TKey const & key, Fn && fn)
+    {
+      TValue value;
+      if (Find(key, value))
+        return value;
+
+      value = fn();
+      Insert(key, value);
+      return value;
+    }
+
+    void Clear()
+    {
+      for (auto & shard : m_shards)
+      {
+        std::lock_guard<std::mutex> lock(shard.m_mutex);
+        shard.m_index.clear();
+        shard.m_entries.clear();
+        shard.m_bytes = 0;
+        shard.m_hand = 0;
+      }
+      m_access = 0;
+      m_miss = 0;
+    }
+
+    size_t GetBytes() const
+    {
+      size_t bytes = 0;
+      for (auto & shard : m_shards)
+      {
+        std::lock_guard<std::mutex> lock(shard.m_mutex);
+        bytes += shard.m_bytes;
+      }
+      return bytes;
+    }
+
+    uint64_t GetAccessCount() const { return m_access.load(std::memory_order_relaxed); }
+    uint64_t GetMissCount() const { return m_miss.load(std::memory_order_relaxed); }
+
+    double GetCacheMiss() const
+    {
+      uint64_t const access = GetAccessCount();
+      if (access == 0)
+        return 0.0;
+      return static_cast<double>(GetMissCount()) / static_cast<double>(access);
+    }
+
+  private:
+    struct Entry
+    {
+      TKey m_key;
+      TValue m_value;
+      size_t m_bytes;
+      bool m_referenced;
+    };
+
+    struct Shard
+    {
+      mutable std::mutex m_mutex;
+      std::unordered_map<TKey, size_t, THash> m_index;
+      // Entries of the clock, |m_hand| points to the next candidate for eviction.
+      std::vector<Entry> m_entries;
+      size_t m_hand = 0;
+      size_t m_bytes = 0;
+    };
+
+    static size_t DefaultSize(TKey const &, TValue const &) { return sizeof(TKey) + sizeof(TValue); }
+
+    Shard & GetShard(TKey const & key)
+    {
+      // Mixes the hash, as std::hash of integers is the identity and low bits of keys are
+      // often correlated.
+      uint64_t const h = static_cast<uint64_t>(THash()(key)) * 0x9E3779B97F4A7C15ULL;
+      return m_shards[static_cast<size_t>(h >> 32) & (m_shards.size() - 1)];
+    }
+
+    // Moves the last entry to the place of the removed one.
+    static void RemoveEntry(Shard & shard, size_t i)
+    {
+      shard.m_bytes -= shard.m_entries[i].m_bytes;
+      shard.m_index.erase(shard.m_entries[i].m_key);
+      if (i + 1 != shard.m_entries.size())
+      {
+        shard.m_entries[i] = std::move(shard.m_entries.back());
+        shard.m_index[shard.m_entries[i].m_key] = i;
+      }
+      shard.m_entries.pop_back();
+      if (shard.m_hand >= shard.m_entries.size())
+        shard.m_hand = 0;
+    }
+
+    static void EvictEntry(Shard & shard)
+    {
+      ASSERT(!shard.m_entries.empty(), ());
+      while (shard.m_entries[shard.m_hand].m_referenced)
+      {
+        shard.m_entries[shard.m_hand].m_referenced = false;
+        if (++shard.m_hand == shard.m_entries.size())
+          shard.m_hand = 0;
+      }
+      RemoveEntry(shard, shard.m_hand);
+    }
+
+    std::vector<Shard> m_shards;
+    size_t const m_maxShardBytes;
+    SizeFn const m_sizeFn;
+    std::atomic<uint64_t> m_miss;
+    std::atomic<uint64_t> m_access;
+  };
 }
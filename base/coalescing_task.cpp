@@ -0,0 +1,46 @@
+#include "base/coalescing_task.hpp"
+
+#include <utility>
+
+namespace base
+{
+CoalescingTask::CoalescingTask(WorkerThread & thread, Duration const & maxDelay)
+  : m_thread(thread), m_maxDelay(maxDelay), m_state(std::make_shared<State>())
+{
+}
+
+CoalescingTask::~CoalescingTask() { Drop(); }
+
+void CoalescingTask::Push(TaskLoop::Task && task)
+{
+  std::lock_guard<std::mutex> lock(m_state->m_mutex);
+  m_state->m_task = std::move(task);
+  if (m_state->m_scheduled)
+    return;
+
+  std::weak_ptr<State> weakState = m_state;
+  m_state->m_scheduled = m_thread.PushDelayed(m_maxDelay, [weakState]()
+  {
+    auto const state = weakState.lock();
+    if (!state)
+      return;
+
+    TaskLoop::Task task;
+    {
+      std::lock_guard<std::mutex> lock(state->m_mutex);
+      task = std::move(state->m_task);
+      state->m_task = nullptr;
+      state->m_scheduled = false;
+    }
+
+    if (task)
+      task();
+  });
+}
+
+void CoalescingTask::Drop()
+{
+  std::lock_guard<std::mutex> lock(m_state->m_mutex);
+  m_state->m_task = nullptr;
+}
+}  // namespace base
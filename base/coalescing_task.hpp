@@ -0,0 +1,46 @@
+#pragma once
+
+#include "base/macros.hpp"
+#include "base/task_loop.hpp"
+#include "base/worker_thread.hpp"
+
+#include <memory>
+#include <mutex>
+
+namespace base
+{
+// Merges tasks which are pushed more often than they are worth running, e.g. updates on
+// every frame of a continuous map panning. Only the last pushed task is run, and it is run
+// on |thread| not later than |maxDelay| after the first task which has not run yet was
+// pushed. So a larger |maxDelay| saves more work at the cost of a larger latency of updates.
+//
+// NOTE: this class is thread-safe. Tasks which have not run yet are dropped on destruction.
+class CoalescingTask
+{
+public:
+  using Duration = WorkerThread::Duration;
+
+  CoalescingTask(WorkerThread & thread, Duration const & maxDelay);
+  ~CoalescingTask();
+
+  // Replaces the pending task by |task|.
+  void Push(TaskLoop::Task && task);
+
+  // Drops the pending task.
+  void Drop();
+
+private:
+  struct State
+  {
+    std::mutex m_mutex;
+    TaskLoop::Task m_task;
+    bool m_scheduled = false;
+  };
+
+  WorkerThread & m_thread;
+  Duration const m_maxDelay;
+  std::shared_ptr<State> m_state;
+
+  DISALLOW_COPY_AND_MOVE(CoalescingTask);
+};
+}  // namespace base
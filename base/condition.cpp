@@ -1,5 +1,6 @@
 #include "base/condition.hpp"
 #include "base/mutex.hpp"
+#include "base/trace.hpp"
 
 #include "std/target_os.hpp"
 
@@ -88,10 +89,11 @@ namespace threads
 
 namespace threads
 {
-  ConditionGuard::ConditionGuard(Condition & condition)
+  ConditionGuard::ConditionGuard(Condition & condition, char const * traceName)
     : m_Condition(condition)
   {
-    m_Condition.Lock();
+    base::trace::Lock(traceName, [this]() { return m_Condition.TryLock(); },
+                      [this]() { m_Condition.Lock(); });
   }
 
   ConditionGuard::~ConditionGuard()
@@ -35,7 +35,8 @@ namespace threads
   private:
     Condition & m_Condition;
   public:
-    ConditionGuard(Condition & condition);
+    /// Waits for the lock are traced under |traceName|, see base/trace.hpp.
+    ConditionGuard(Condition & condition, char const * traceName = "ConditionGuard");
     ~ConditionGuard();
     void Wait(unsigned ms = -1);
     void Signal(bool broadcast = false);
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+namespace base
+{
+// An associative container with the interface of std::map which keeps
+// its values in a vector sorted by keys.
+//
+// Lookups are binary searches over a contiguous array, so they are
+// much more cache friendly than lookups in std::map and the container
+// needs no memory per element except the element itself.  Insertion
+// of a key which is greater than all keys of the container is
+// amortized O(1), insertion in the middle is O(size()), so the
+// container is intended to be filled in the order of keys and then
+// read.
+//
+// *NOTE* Iterators are invalidated by insertions and erasures.
+template <typename Key, typename Value, typename Less = std::less<Key>>
+class FlatMap
+{
+public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<Key, Value>;
+  using Storage = std::vector<value_type>;
+  using iterator = typename Storage::iterator;
+  using const_iterator = typename Storage::const_iterator;
+
+  FlatMap() = default;
+
+  // Duplicate keys are inserted only once, as std::map does it.
+  FlatMap(std::initializer_list<value_type> values) : FlatMap(values.begin(), values.end()) {}
+
+  template <typename It>
+  FlatMap(It begin, It end) : m_values(begin, end)
+  {
+    SortAndUnique();
+  }
+
+  // |values| may be unsorted, duplicate keys are inserted only once.
+  explicit FlatMap(Storage && values) : m_values(std::move(values)) { SortAndUnique(); }
+
+  iterator begin() { return m_values.begin(); }
+  iterator end() { return m_values.end(); }
+  const_iterator begin() const { return m_values.cbegin(); }
+  const_iterator end() const { return m_values.cend(); }
+  const_iterator cbegin() const { return m_values.cbegin(); }
+  const_iterator cend() const { return m_values.cend(); }
+
+  size_t size() const { return m_values.size(); }
+  bool empty() const { return m_values.empty(); }
+  void clear() { m_values.clear(); }
+  void reserve(size_t n) { m_values.reserve(n); }
+  void shrink_to_fit() { m_values.shrink_to_fit(); }
+
+  iterator find(Key const & key)
+  {
+    auto const it = LowerBound(key);
+    return it != m_values.end() && !m_less(key, it->first) ? it : m_values.end();
+  }
+
+  const_iterator find(Key const & key) const
+  {
+    auto const it = LowerBound(key);
+    return it != m_values.cend() && !m_less(key, it->first) ? it : m_values.cend();
+  }
+
+  size_t count(Key const & key) const { return find(key) == cend() ? 0 : 1; }
+
+  std::pair<iterator, bool> insert(value_type const & value) { return insert(value_type(value)); }
+
+  std::pair<iterator, bool> insert(value_type && value)
+  {
+    if (m_values.empty() || m_less(m_values.back().first, value.first))
+    {
+      m_values.push_back(std::move(value));
+      return {std::prev(m_values.end()), true};
+    }
+
+    auto const it = LowerBound(value.first);
+    if (!m_less(value.first, it->first))
+      return {it, false};
+    return {m_values.insert(it, std::move(value)), true};
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&... args)
+  {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+
+  Value & operator[](Key const & key) { return insert(value_type(key, Value())).first->second; }
+
+  size_t erase(Key const & key)
+  {
+    auto const it = find(key);
+    if (it == m_values.end())
+      return 0;
+    m_values.erase(it);
+    return 1;
+  }
+
+  bool operator==(FlatMap const & rhs) const { return m_values == rhs.m_values; }
+  bool operator!=(FlatMap const & rhs) const { return !(*this == rhs); }
+
+private:
+  iterator LowerBound(Key const & key)
+  {
+    return std::lower_bound(m_values.begin(), m_values.end(), key,
+                            [this](value_type const & v, Key const & k) { return m_less(v.first, k); });
+  }
+
+  const_iterator LowerBound(Key const & key) const
+  {
+    return std::lower_bound(m_values.cbegin(), m_values.cend(), key,
+                            [this](value_type const & v, Key const & k) { return m_less(v.first, k); });
+  }
+
+  void SortAndUnique()
+  {
+    auto const lessByKey = [this](value_type const & lhs, value_type const & rhs) {
+      return m_less(lhs.first, rhs.first);
+    };
+    std::stable_sort(m_values.begin(), m_values.end(), lessByKey);
+    auto const equalByKey = [this](value_type const & lhs, value_type const & rhs) {
+      return !m_less(lhs.first, rhs.first) && !m_less(rhs.first, lhs.first);
+    };
+    m_values.erase(std::unique(m_values.begin(), m_values.end(), equalByKey), m_values.end());
+  }
+
+  Storage m_values;
+  Less m_less;
+};
+}  // namespace base
@@ -4,6 +4,7 @@
 #include "base/stl_helpers.hpp"
 
 #include <algorithm>
+#include <map>
 #include <queue>
 #include <set>
 #include <sstream>
@@ -172,39 +173,47 @@ void LevenshteinDFA::State::Normalize()
 LevenshteinDFA::LevenshteinDFA(UniString const & s, size_t prefixCharsToKeep, size_t maxErrors)
   : m_size(s.size()), m_maxErrors(maxErrors)
 {
-  m_alphabet.assign(s.begin(), s.end());
-  my::SortUnique(m_alphabet);
+  auto table = std::make_shared<Table>();
+  auto & alphabet = table->m_alphabet;
+
+  alphabet.assign(s.begin(), s.end());
+  my::SortUnique(alphabet);
 
   UniChar missed = 0;
-  for (size_t i = 0; i < m_alphabet.size() && missed >= m_alphabet[i]; ++i)
+  for (size_t i = 0; i < alphabet.size() && missed >= alphabet[i]; ++i)
   {
-    if (missed == m_alphabet[i])
+    if (missed == alphabet[i])
       ++missed;
   }
-  m_alphabet.push_back(missed);
+  alphabet.push_back(missed);
+
+  size_t const alphabetSize = alphabet.size();
+  auto & transitions = table->m_transitions;
+  auto & accepting = table->m_accepting;
+  auto & errorsMade = table->m_errorsMade;
 
   std::queue<State> states;
   std::map<State, size_t> visited;
 
-  auto pushState = [&states, &visited, this](State const & state, size_t id)
+  auto pushState = [&](State const & state, size_t id)
   {
-    ASSERT_EQUAL(id, m_transitions.size(), ());
+    ASSERT_EQUAL(id, accepting.size(), ());
     ASSERT_EQUAL(visited.count(state), 0, (state, id));
 
-    ASSERT_EQUAL(m_transitions.size(), m_accepting.size(), ());
-    ASSERT_EQUAL(m_transitions.size(), m_errorsMade.size(), ());
+    ASSERT_EQUAL(accepting.size(), errorsMade.size(), ());
+    ASSERT_EQUAL(accepting.size() * alphabetSize, transitions.size(), ());
 
     states.emplace(state);
     visited[state] = id;
-    m_transitions.emplace_back(m_alphabet.size());
-    m_accepting.push_back(false);
-    m_errorsMade.push_back(ErrorsMade(state));
+    transitions.resize(transitions.size() + alphabetSize);
+    accepting.push_back(0);
+    errorsMade.push_back(ErrorsMade(state));
   };
 
   pushState(MakeStart(), kStartingState);
   pushState(MakeRejecting(), kRejectingState);
 
-  TransitionTable table(s);
+  TransitionTable tt(s);
 
   while (!states.empty())
   {
@@ -214,15 +223,15 @@ LevenshteinDFA::LevenshteinDFA(UniString const & s, size_t prefixCharsToKeep, si
 
     ASSERT_GREATER(visited.count(curr), 0, (curr));
     auto const id = visited[curr];
-    ASSERT_LESS(id, m_transitions.size(), ());
+    ASSERT_LESS(id, accepting.size(), ());
 
     if (IsAccepting(curr))
-      m_accepting[id] = true;
+      accepting[id] = 1;
 
-    for (size_t i = 0; i < m_alphabet.size(); ++i)
+    for (size_t i = 0; i < alphabetSize; ++i)
     {
       State next;
-      table.Move(curr, prefixCharsToKeep, m_alphabet[i], next);
+      tt.Move(curr, prefixCharsToKeep, alphabet[i], next);
 
       size_t nid;
 
@@ -237,9 +246,11 @@ LevenshteinDFA::LevenshteinDFA(UniString const & s, size_t prefixCharsToKeep, si
         nid = it->second;
       }
 
-      m_transitions[id][i] = nid;
+      transitions[id * alphabetSize + i] = nid;
     }
   }
+
+  m_table = std::move(table);
 }
 
 LevenshteinDFA::LevenshteinDFA(std::string const & s, size_t prefixCharsToKeep, size_t maxErrors)
@@ -313,21 +324,6 @@ size_t LevenshteinDFA::ErrorsMade(State const & s) const
   return errorsMade;
 }
 
-size_t LevenshteinDFA::Move(size_t s, UniChar c) const
-{
-  ASSERT_GREATER(m_alphabet.size(), 0, ());
-  ASSERT(is_sorted(m_alphabet.begin(), m_alphabet.end() - 1), ());
-
-  size_t i;
-  auto const it = lower_bound(m_alphabet.begin(), m_alphabet.end() - 1, c);
-  if (it == m_alphabet.end() - 1 || *it != c)
-    i = m_alphabet.size() - 1;
-  else
-    i = distance(m_alphabet.begin(), it);
-
-  return m_transitions[s][i];
-}
-
 std::string DebugPrint(LevenshteinDFA::Position const & p)
 {
   std::ostringstream os;
@@ -3,6 +3,8 @@
 #include "base/string_utils.hpp"
 
 #include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <vector>
 
 namespace strings
@@ -64,31 +66,71 @@ public:
     std::vector<Position> m_positions;
   };
 
+  // Compiled DFA: transitions of all states in a single table of
+  // |GetNumStates() * m_alphabet.size()| entries, so a move is an
+  // alphabet lookup and an array access. The table is immutable and
+  // is shared by copies of the DFA, so copies are cheap.
+  struct Table
+  {
+    size_t GetNumStates() const { return m_accepting.size(); }
+
+    // Returns index of |c| in the alphabet. The last letter of the
+    // alphabet stands for all letters not in the pattern.
+    size_t GetLetter(UniChar c) const
+    {
+      size_t const last = m_alphabet.size() - 1;
+      size_t lo = 0;
+      size_t hi = last;
+      while (lo < hi)
+      {
+        size_t const mid = lo + (hi - lo) / 2;
+        if (m_alphabet[mid] < c)
+          lo = mid + 1;
+        else
+          hi = mid;
+      }
+      return lo != last && m_alphabet[lo] == c ? lo : last;
+    }
+
+    size_t Move(size_t s, UniChar c) const
+    {
+      return m_transitions[s * m_alphabet.size() + GetLetter(c)];
+    }
+
+    // Sorted letters of the pattern followed by a letter which is not
+    // in the pattern.
+    std::vector<UniChar> m_alphabet;
+
+    std::vector<size_t> m_transitions;
+    std::vector<uint8_t> m_accepting;
+    std::vector<size_t> m_errorsMade;
+  };
+
   // An iterator to the current state in the DFA.
   //
   // *NOTE* The class *IS NOT* thread safe. Moreover, it should not be
-  // used after destruction of the corresponding DFA.
+  // used after destruction of the corresponding DFA and all its copies.
   class Iterator
   {
   public:
     Iterator & Move(UniChar c)
     {
-      m_s = m_dfa.Move(m_s, c);
+      m_s = m_table->Move(m_s, c);
       return *this;
     }
 
-    bool Accepts() const { return m_dfa.IsAccepting(m_s); }
-    bool Rejects() const { return m_dfa.IsRejecting(m_s); }
+    bool Accepts() const { return m_table->m_accepting[m_s] != 0; }
+    bool Rejects() const { return m_s == kRejectingState; }
 
-    size_t ErrorsMade() const { return m_dfa.ErrorsMade(m_s); }
+    size_t ErrorsMade() const { return m_table->m_errorsMade[m_s]; }
 
   private:
     friend class LevenshteinDFA;
 
-    explicit Iterator(LevenshteinDFA const & dfa) : m_s(kStartingState), m_dfa(dfa) {}
+    explicit Iterator(Table const & table) : m_s(kStartingState), m_table(&table) {}
 
     size_t m_s;
-    LevenshteinDFA const & m_dfa;
+    Table const * m_table;
   };
 
   LevenshteinDFA(LevenshteinDFA const &) = default;
@@ -99,13 +141,12 @@ public:
   LevenshteinDFA(UniString const & s, size_t maxErrors);
   LevenshteinDFA(std::string const & s, size_t maxErrors);
 
-  inline Iterator Begin() const { return Iterator(*this); }
+  inline Iterator Begin() const { return Iterator(*m_table); }
 
-  size_t GetNumStates() const { return m_transitions.size(); }
-  size_t GetAlphabetSize() const { return m_alphabet.size(); }
+  size_t GetNumStates() const { return m_table->GetNumStates(); }
+  size_t GetAlphabetSize() const { return m_table->m_alphabet.size(); }
 
 private:
-  friend class Iterator;
 
   State MakeStart();
   State MakeRejecting();
@@ -115,25 +156,16 @@ private:
 
   bool IsAccepting(Position const & p) const;
   bool IsAccepting(State const & s) const;
-  inline bool IsAccepting(size_t s) const { return m_accepting[s]; }
 
   inline bool IsRejecting(State const & s) const { return s.m_positions.empty(); }
-  inline bool IsRejecting(size_t s) const { return s == kRejectingState; }
 
   // Returns minimum number of made errors among accepting positions in |s|.
   size_t ErrorsMade(State const & s) const;
-  size_t ErrorsMade(size_t s) const { return m_errorsMade[s]; }
-
-  size_t Move(size_t s, UniChar c) const;
 
   size_t const m_size;
   size_t const m_maxErrors;
 
-  std::vector<UniChar> m_alphabet;
-
-  std::vector<std::vector<size_t>> m_transitions;
-  std::vector<bool> m_accepting;
-  std::vector<size_t> m_errorsMade;
+  std::shared_ptr<Table const> m_table;
 };
 
 std::string DebugPrint(LevenshteinDFA::Position const & p);
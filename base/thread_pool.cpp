@@ -3,6 +3,7 @@
 #include "base/stl_add.hpp"
 #include "base/thread.hpp"
 #include "base/threaded_list.hpp"
+#include "base/trace.hpp"
 
 #include <functional>
 #include <utility>
@@ -35,7 +36,10 @@ namespace threads
           }
 
           if (!task->IsCancelled())
+          {
+            base::trace::ScopedEvent const event("ThreadPool task");
             task->Do();
+          }
           m_finishFn(task);
         }
       }
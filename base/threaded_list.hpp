@@ -24,7 +24,7 @@ public:
   template <typename Fn>
   void ProcessList(Fn const & fn)
   {
-    threads::ConditionGuard g(m_Cond);
+    threads::ConditionGuard g(m_Cond, "ThreadedList");
 
     bool hadElements = !m_list.empty();
 
@@ -40,7 +40,7 @@ public:
 
   void PushBack(T const & t)
   {
-    threads::ConditionGuard g(m_Cond);
+    threads::ConditionGuard g(m_Cond, "ThreadedList");
 
     bool doSignal = m_list.empty();
 
@@ -53,7 +53,7 @@ public:
 
   void PushFront(T const & t)
   {
-    threads::ConditionGuard g(m_Cond);
+    threads::ConditionGuard g(m_Cond, "ThreadedList");
 
     bool doSignal = m_list.empty();
 
@@ -97,7 +97,7 @@ public:
 
   T const Front(bool doPop)
   {
-    threads::ConditionGuard g(m_Cond);
+    threads::ConditionGuard g(m_Cond, "ThreadedList");
 
     if (WaitNonEmpty())
       return T();
@@ -114,7 +114,7 @@ public:
 
   T const Back(bool doPop)
   {
-    threads::ConditionGuard g(m_Cond);
+    threads::ConditionGuard g(m_Cond, "ThreadedList");
 
     if (WaitNonEmpty())
       return T();
@@ -131,7 +131,7 @@ public:
 
   size_t Size() const
   {
-    threads::ConditionGuard g(m_Cond);
+    threads::ConditionGuard g(m_Cond, "ThreadedList");
     return m_list.size();
   }
 
@@ -142,7 +142,7 @@ public:
 
   void Clear()
   {
-    threads::ConditionGuard g(m_Cond);
+    threads::ConditionGuard g(m_Cond, "ThreadedList");
     m_list.clear();
     m_isEmpty = true;
   }
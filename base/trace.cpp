@@ -0,0 +1,129 @@
+#include "base/trace.hpp"
+
+#include "base/assert.hpp"
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <thread>
+
+namespace base
+{
+namespace trace
+{
+namespace impl
+{
+std::atomic<bool> g_enabled(false);
+}  // namespace impl
+
+namespace
+{
+class RingBuffer
+{
+public:
+  void Reset(size_t capacity)
+  {
+    ASSERT_GREATER(capacity, 0, ());
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_events.assign(capacity, Event());
+    m_next = 0;
+    m_full = false;
+  }
+
+  void Add(Event const & event)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Tracing may be disabled and enabled again between the check and this call.
+    if (m_events.empty())
+      return;
+
+    m_events[m_next] = event;
+    if (++m_next == m_events.size())
+    {
+      m_next = 0;
+      m_full = true;
+    }
+  }
+
+  std::vector<Event> Get() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_full)
+      return std::vector<Event>(m_events.begin(), m_events.begin() + m_next);
+
+    std::vector<Event> events(m_events.begin() + m_next, m_events.end());
+    events.insert(events.end(), m_events.begin(), m_events.begin() + m_next);
+    return events;
+  }
+
+private:
+  mutable std::mutex m_mutex;
+  std::vector<Event> m_events;
+  // Position of the next event to write, the oldest event when the buffer is full.
+  size_t m_next = 0;
+  bool m_full = false;
+};
+
+RingBuffer & GetBuffer()
+{
+  static RingBuffer buffer;
+  return buffer;
+}
+
+std::chrono::steady_clock::time_point GetStartTime()
+{
+  static auto const start = std::chrono::steady_clock::now();
+  return start;
+}
+}  // namespace
+
+std::string DebugPrint(EventType type)
+{
+  switch (type)
+  {
+  case EventType::Scope: return "Scope";
+  case EventType::Counter: return "Counter";
+  case EventType::LockWait: return "LockWait";
+  }
+}
+
+void Enable(size_t capacity)
+{
+  GetStartTime();
+  GetBuffer().Reset(capacity);
+  impl::g_enabled.store(true, std::memory_order_relaxed);
+}
+
+void Disable() { impl::g_enabled.store(false, std::memory_order_relaxed); }
+
+uint64_t NowUs()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                               GetStartTime())
+      .count();
+}
+
+void AddEvent(EventType type, char const * name, uint64_t timestampUs, uint64_t value)
+{
+  Event event;
+  event.m_name = name;
+  event.m_type = type;
+  event.m_timestampUs = timestampUs;
+  event.m_value = value;
+  event.m_threadId = std::hash<std::thread::id>()(std::this_thread::get_id());
+  GetBuffer().Add(event);
+}
+
+std::vector<Event> GetEvents() { return GetBuffer().Get(); }
+
+void Dump(std::ostream & os)
+{
+  for (auto const & e : GetEvents())
+  {
+    os << e.m_timestampUs << '\t' << e.m_threadId << '\t' << DebugPrint(e.m_type) << '\t'
+       << e.m_name << '\t' << e.m_value << '\n';
+  }
+}
+}  // namespace trace
+}  // namespace base
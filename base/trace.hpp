@@ -0,0 +1,136 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace base
+{
+namespace trace
+{
+// Lightweight instrumentation for studying performance on devices. Scoped events,
+// counters and waits for contended locks are put into a ring buffer, which can be
+// dumped on demand. Tracing is disabled by default, and then every instrumentation
+// point costs a single relaxed atomic load.
+//
+// All names must be string literals or have static storage duration in some other way.
+//
+// NOTE: all functions here are thread-safe.
+
+enum class EventType
+{
+  Scope,
+  Counter,
+  LockWait
+};
+
+std::string DebugPrint(EventType type);
+
+struct Event
+{
+  char const * m_name = nullptr;
+  EventType m_type = EventType::Scope;
+  // Microseconds since the first use of tracing.
+  uint64_t m_timestampUs = 0;
+  // Duration in microseconds for Scope and LockWait events, the value for Counter events.
+  uint64_t m_value = 0;
+  size_t m_threadId = 0;
+};
+
+size_t constexpr kDefaultCapacity = 4096;
+
+namespace impl
+{
+extern std::atomic<bool> g_enabled;
+
+uint64_t constexpr kNotStarted = UINT64_MAX;
+}  // namespace impl
+
+// Starts collecting events into a ring buffer of |capacity| events. Events which were
+// collected before are discarded.
+void Enable(size_t capacity = kDefaultCapacity);
+// Stops collecting events, collected events are kept until the next Enable().
+void Disable();
+inline bool IsEnabled() { return impl::g_enabled.load(std::memory_order_relaxed); }
+
+uint64_t NowUs();
+
+void AddEvent(EventType type, char const * name, uint64_t timestampUs, uint64_t value);
+inline void AddCounter(char const * name, uint64_t value)
+{
+  if (IsEnabled())
+    AddEvent(EventType::Counter, name, NowUs(), value);
+}
+
+// Returns collected events, the oldest ones go first.
+std::vector<Event> GetEvents();
+// Writes collected events as tab-separated lines: timestamp, thread, type, name, value.
+void Dump(std::ostream & os);
+
+class ScopedEvent
+{
+public:
+  explicit ScopedEvent(char const * name)
+    : m_name(name), m_startUs(IsEnabled() ? NowUs() : impl::kNotStarted)
+  {
+  }
+
+  ~ScopedEvent()
+  {
+    if (m_startUs != impl::kNotStarted && IsEnabled())
+      AddEvent(EventType::Scope, m_name, m_startUs, NowUs() - m_startUs);
+  }
+
+private:
+  char const * const m_name;
+  uint64_t const m_startUs;
+
+  DISALLOW_COPY_AND_MOVE(ScopedEvent);
+};
+
+// Takes a lock by |tryLock| and |lock| functors. When the lock is held by another thread
+// and tracing is enabled, the time of waiting is recorded as a LockWait event.
+template <typename TryLockFn, typename LockFn>
+void Lock(char const * name, TryLockFn && tryLock, LockFn && lock)
+{
+  if (tryLock())
+    return;
+
+  if (!IsEnabled())
+  {
+    lock();
+    return;
+  }
+
+  uint64_t const startUs = NowUs();
+  lock();
+  AddEvent(EventType::LockWait, name, startUs, NowUs() - startUs);
+}
+
+// The same as above for std::mutex, std::unique_lock and other standard lockables.
+template <typename Lockable>
+void Lock(Lockable & lockable, char const * name)
+{
+  Lock(name, [&lockable]() { return lockable.try_lock(); }, [&lockable]() { lockable.lock(); });
+}
+
+// A replacement for std::lock_guard, which traces contention of |mutex|.
+template <typename Mutex>
+class LockGuard
+{
+public:
+  LockGuard(Mutex & mutex, char const * name) : m_mutex(mutex) { Lock(m_mutex, name); }
+  ~LockGuard() { m_mutex.unlock(); }
+
+private:
+  Mutex & m_mutex;
+
+  DISALLOW_COPY_AND_MOVE(LockGuard);
+};
+}  // namespace trace
+}  // namespace base
@@ -0,0 +1,168 @@
+#include "base/work_stealing_pool.hpp"
+
+#include "base/assert.hpp"
+#include "base/stl_add.hpp"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace base
+{
+WorkStealingPool::WorkStealingPool(size_t threadsCount) : m_nextWorker(0)
+{
+  if (threadsCount == 0)
+    threadsCount = max(thread::hardware_concurrency(), 1u);
+
+  for (size_t i = 0; i < threadsCount; ++i)
+    m_workers.push_back(my::make_unique<Worker>());
+
+  m_threads.reserve(threadsCount);
+  for (size_t i = 0; i < threadsCount; ++i)
+    m_threads.emplace_back(&WorkStealingPool::ProcessTasks, this, i);
+
+  {
+    lock_guard<mutex> lk(m_mu);
+    for (auto const & t : m_threads)
+      m_threadIds.push_back(t.get_id());
+    m_started = true;
+  }
+  m_cv.notify_all();
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+  Shutdown(Exit::SkipPending);
+}
+
+bool WorkStealingPool::Push(Task && task) { return Push(move(task), Priority::Normal); }
+
+bool WorkStealingPool::Push(Task const & task) { return Push(Task(task), Priority::Normal); }
+
+bool WorkStealingPool::Push(Task && task, Priority priority)
+{
+  ASSERT_NOT_EQUAL(priority, Priority::Count, ());
+
+  size_t worker = GetCurrentWorker();
+  bool const fromWorker = worker != GetThreadsCount();
+  if (!fromWorker)
+    worker = m_nextWorker++ % GetThreadsCount();
+
+  lock_guard<mutex> lk(m_mu);
+  if (m_shutdown)
+    return false;
+
+  {
+    auto & w = *m_workers[worker];
+    lock_guard<mutex> wlk(w.m_mu);
+    auto & tasks = w.m_tasks[static_cast<size_t>(priority)];
+    if (fromWorker)
+      tasks.push_front(move(task));
+    else
+      tasks.push_back(move(task));
+  }
+
+  ++m_numPending;
+  m_cv.notify_one();
+  return true;
+}
+
+bool WorkStealingPool::Shutdown(Exit e)
+{
+  {
+    lock_guard<mutex> lk(m_mu);
+    if (m_shutdown)
+      return false;
+    m_shutdown = true;
+    m_exit = e;
+  }
+  m_cv.notify_all();
+
+  ASSERT_EQUAL(GetCurrentWorker(), GetThreadsCount(), ("Pool can't be shut down by its worker."));
+  for (auto & t : m_threads)
+    t.join();
+
+  // Destroys skipped tasks, so their futures get broken promises.
+  for (auto & w : m_workers)
+  {
+    for (auto & tasks : w->m_tasks)
+      tasks.clear();
+  }
+  return true;
+}
+
+size_t WorkStealingPool::GetCurrentWorker() const
+{
+  auto const id = this_thread::get_id();
+  // |m_threadIds| isn't changed after the start.
+  auto const it = find(m_threadIds.begin(), m_threadIds.end(), id);
+  return static_cast<size_t>(it - m_threadIds.begin());
+}
+
+bool WorkStealingPool::TryPop(size_t worker, Task & task)
+{
+  size_t const numWorkers = GetThreadsCount();
+  for (size_t p = 0; p < static_cast<size_t>(Priority::Count); ++p)
+  {
+    // The own queue is used as a stack, queues of other workers are used as queues.
+    for (size_t i = 0; i < numWorkers; ++i)
+    {
+      auto & w = *m_workers[(worker + i) % numWorkers];
+      lock_guard<mutex> lk(w.m_mu);
+      auto & tasks = w.m_tasks[p];
+      if (tasks.empty())
+        continue;
+      if (i == 0)
+      {
+        task = move(tasks.front());
+        tasks.pop_front();
+      }
+      else
+      {
+        task = move(tasks.back());
+        tasks.pop_back();
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkStealingPool::ProcessTasks(size_t worker)
+{
+  {
+    unique_lock<mutex> lk(m_mu);
+    m_cv.wait(lk, [this]() { return m_started; });
+  }
+
+  while (true)
+  {
+    {
+      unique_lock<mutex> lk(m_mu);
+      m_cv.wait(lk, [this]() { return m_shutdown || m_numPending != 0; });
+      if (m_shutdown && (m_exit == Exit::SkipPending || m_numPending == 0))
+        return;
+      // Every worker which passes here takes exactly one task, so there is a task for it
+      // in one of the queues.
+      --m_numPending;
+    }
+
+    Task task;
+    while (!TryPop(worker, task))
+      this_thread::yield();
+    task();
+  }
+}
+
+string DebugPrint(WorkStealingPool::Priority priority)
+{
+  switch (priority)
+  {
+  case WorkStealingPool::Priority::High: return "High";
+  case WorkStealingPool::Priority::Normal: return "Normal";
+  case WorkStealingPool::Priority::Low: return "Low";
+  case WorkStealingPool::Priority::Count: return "Count";
+  }
+  return {};
+}
+}  // namespace base
@@ -0,0 +1,199 @@
+#pragma once
+
+#include "base/cancellable.hpp"
+#include "base/exception.hpp"
+#include "base/macros.hpp"
+#include "base/task_loop.hpp"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace base
+{
+// Thread pool which is intended to be shared by subsystems instead of their own threads.
+//
+// Every worker has its own queues of tasks. Tasks pushed from a worker go to the front of its
+// queue, so related tasks run on the same core, other tasks are distributed between workers
+// round-robin. An idle worker takes the oldest task of another worker. Tasks of a higher
+// priority are taken first, the order of tasks of the same priority isn't guaranteed.
+//
+// *NOTE* This class IS thread-safe, but it must be destroyed not on one of its workers.
+class WorkStealingPool : public TaskLoop
+{
+public:
+  DECLARE_EXCEPTION(CancelledException, RootException);
+
+  enum class Priority
+  {
+    High,
+    Normal,
+    Low,
+    Count
+  };
+
+  enum class Exit
+  {
+    ExecPending,
+    SkipPending
+  };
+
+  using Cancellable = std::shared_ptr<my::Cancellable>;
+
+  // |threadsCount| equal to zero means the number of cores.
+  explicit WorkStealingPool(size_t threadsCount = 0);
+  ~WorkStealingPool() override;
+
+  // Pushes task with the normal priority. Returns false when the pool is shut down.
+  bool Push(Task && task) override;
+  bool Push(Task const & task) override;
+
+  bool Push(Task && task, Priority priority);
+
+  // Runs |fn| and returns its result through the future. If the pool is shut down or
+  // |cancellable| is cancelled before |fn| starts, |fn| isn't called and the future holds
+  // std::future_error or CancelledException. Long tasks may check |cancellable| themselves.
+  template <typename Fn>
+  std::future<typename std::result_of<Fn()>::type> Submit(Fn && fn,
+                                                          Priority priority = Priority::Normal,
+                                                          Cancellable const & cancellable = {})
+  {
+    using Result = typename std::result_of<Fn()>::type;
+    auto promise = std::make_shared<std::promise<Result>>();
+    auto future = promise->get_future();
+    auto task = std::make_shared<typename std::decay<Fn>::type>(std::forward<Fn>(fn));
+    Push([promise, task, cancellable]() {
+      if (cancellable && cancellable->IsCancelled())
+      {
+        promise->set_exception(MakeCancelled("Task is cancelled before start."));
+        return;
+      }
+      try
+      {
+        SetValue(*promise, *task);
+      }
+      catch (...)
+      {
+        promise->set_exception(std::current_exception());
+      }
+    }, priority);
+    return future;
+  }
+
+  // Runs |fn| and then pushes |then| with its result as a separate task of the same priority,
+  // without blocking any worker. Returns the future of |then|. |fn| must return a value.
+  template <typename Fn, typename Then>
+  std::future<typename std::result_of<Then(typename std::result_of<Fn()>::type)>::type>
+  SubmitThen(Fn && fn, Then && then, Priority priority = Priority::Normal,
+             Cancellable const & cancellable = {})
+  {
+    using Result = typename std::result_of<Fn()>::type;
+    using ThenResult = typename std::result_of<Then(Result)>::type;
+    static_assert(!std::is_void<Result>::value, "Use Submit() for tasks without results.");
+    auto promise = std::make_shared<std::promise<ThenResult>>();
+    auto future = promise->get_future();
+    auto task = std::make_shared<typename std::decay<Fn>::type>(std::forward<Fn>(fn));
+    auto continuation = std::make_shared<typename std::decay<Then>::type>(std::forward<Then>(then));
+    Push([this, promise, task, continuation, priority, cancellable]() {
+      if (cancellable && cancellable->IsCancelled())
+      {
+        promise->set_exception(MakeCancelled("Task is cancelled before start."));
+        return;
+      }
+      try
+      {
+        auto result = std::make_shared<Result>((*task)());
+        bool const pushed = Push([promise, continuation, result, cancellable]() {
+          if (cancellable && cancellable->IsCancelled())
+          {
+            promise->set_exception(MakeCancelled("Continuation is cancelled before start."));
+            return;
+          }
+          try
+          {
+            SetValue(*promise, [&continuation, &result]() {
+              return (*continuation)(std::move(*result));
+            });
+          }
+          catch (...)
+          {
+            promise->set_exception(std::current_exception());
+          }
+        }, priority);
+        if (!pushed)
+        {
+          promise->set_exception(MakeCancelled("Pool is shut down before continuation."));
+        }
+      }
+      catch (...)
+      {
+        promise->set_exception(std::current_exception());
+      }
+    }, priority);
+    return future;
+  }
+
+  // Sends a signal to workers to shut down and waits for them. Returns false when the pool
+  // was shut down previously.
+  bool Shutdown(Exit e);
+
+  size_t GetThreadsCount() const { return m_workers.size(); }
+
+private:
+  struct Worker
+  {
+    std::mutex m_mu;
+    std::array<std::deque<Task>, static_cast<size_t>(Priority::Count)> m_tasks;
+  };
+
+  static std::exception_ptr MakeCancelled(char const * msg)
+  {
+    return std::make_exception_ptr(CancelledException("CancelledException", msg));
+  }
+
+  template <typename Result, typename Fn>
+  static typename std::enable_if<!std::is_void<Result>::value>::type SetValue(
+      std::promise<Result> & promise, Fn && fn)
+  {
+    promise.set_value(fn());
+  }
+
+  template <typename Fn>
+  static void SetValue(std::promise<void> & promise, Fn && fn)
+  {
+    fn();
+    promise.set_value();
+  }
+
+  // Returns index of the worker which runs on the calling thread or GetThreadsCount().
+  size_t GetCurrentWorker() const;
+  bool TryPop(size_t worker, Task & task);
+  void ProcessTasks(size_t worker);
+
+  std::vector<std::unique_ptr<Worker>> m_workers;
+  std::vector<std::thread> m_threads;
+  std::vector<std::thread::id> m_threadIds;
+
+  std::mutex m_mu;
+  std::condition_variable m_cv;
+  bool m_started = false;
+  bool m_shutdown = false;
+  Exit m_exit = Exit::SkipPending;
+  // Number of tasks in all queues, guarded by |m_mu|.
+  size_t m_numPending = 0;
+  std::atomic<size_t> m_nextWorker;
+
+  DISALLOW_COPY_AND_MOVE(WorkStealingPool);
+};
+
+std::string DebugPrint(WorkStealingPool::Priority priority);
+}  // namespace base
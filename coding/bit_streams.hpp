@@ -215,6 +215,37 @@ public:
 
 #undef READ_BYTE
 
+  // Skips zero bits up to the first one bit and reads it. Returns the number of skipped bits.
+  // It's the same as calling Read(1) until it returns 1 but zero bits are counted a byte at
+  // a time.
+  uint32_t ReadUnary()
+  {
+    uint32_t zeros = 0;
+    while (true)
+    {
+      if (m_bufferedBits == 0)
+      {
+        m_src.Read(&m_buf, 1);
+        m_bufferedBits = CHAR_BIT;
+      }
+
+      // Bits above |m_bufferedBits| are always zero.
+      if (m_buf != 0)
+      {
+        uint32_t const n = bits::NumLoZeroBits64(m_buf) + 1;
+        zeros += n - 1;
+        m_bitsRead += n;
+        m_bufferedBits -= n;
+        m_buf = static_cast<uint8_t>(static_cast<uint32_t>(m_buf) >> n);
+        return zeros;
+      }
+
+      zeros += m_bufferedBits;
+      m_bitsRead += m_bufferedBits;
+      m_bufferedBits = 0;
+    }
+  }
+
 private:
   TSource & m_src;
   uint64_t m_bitsRead;
@@ -0,0 +1,236 @@
+#include "coding/block_compression.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "base/assert.hpp"
+#include "base/stl_add.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iterator>
+#include <thread>
+#include <utility>
+
+using namespace std;
+
+namespace coding
+{
+namespace
+{
+class NoneCodec : public BlockCodec
+{
+public:
+  BlockCodecId GetId() const override { return BlockCodecId::None; }
+
+  bool Compress(void const * data, size_t size, vector<uint8_t> & out) const override
+  {
+    auto const * bytes = static_cast<uint8_t const *>(data);
+    out.insert(out.end(), bytes, bytes + size);
+    return true;
+  }
+
+  bool Decompress(void const * data, size_t size, vector<uint8_t> & out) const override
+  {
+    return Compress(data, size, out);
+  }
+};
+
+class ZLibCodec : public BlockCodec
+{
+public:
+  ZLibCodec(ZLib::Deflate::Level level, string const & dictionary)
+    : m_deflate(ZLib::Deflate::Format::ZLib, level, dictionary)
+    , m_inflate(ZLib::Inflate::Format::ZLib, dictionary)
+  {
+  }
+
+  BlockCodecId GetId() const override { return BlockCodecId::ZLib; }
+
+  bool Compress(void const * data, size_t size, vector<uint8_t> & out) const override
+  {
+    return m_deflate(data, size, back_inserter(out));
+  }
+
+  bool Decompress(void const * data, size_t size, vector<uint8_t> & out) const override
+  {
+    return m_inflate(data, size, back_inserter(out));
+  }
+
+private:
+  ZLib::Deflate const m_deflate;
+  ZLib::Inflate const m_inflate;
+};
+
+// Calls |fn| for [0, count) on at most |threadsCount| threads. Returns false if any call
+// returns false.
+template <typename Fn>
+bool ForEachBlock(size_t threadsCount, size_t count, Fn && fn)
+{
+  threadsCount = min(max(threadsCount, static_cast<size_t>(1)), count);
+  if (threadsCount <= 1)
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      if (!fn(i))
+        return false;
+    }
+    return true;
+  }
+
+  atomic<size_t> next(0);
+  atomic<bool> ok(true);
+  auto const worker = [&]() {
+    for (size_t i = next++; i < count && ok; i = next++)
+    {
+      if (!fn(i))
+        ok = false;
+    }
+  };
+
+  vector<thread> threads;
+  threads.reserve(threadsCount);
+  for (size_t i = 0; i < threadsCount; ++i)
+    threads.emplace_back(worker);
+  for (auto & t : threads)
+    t.join();
+  return ok;
+}
+}  // namespace
+
+string DebugPrint(BlockCodecId id)
+{
+  switch (id)
+  {
+  case BlockCodecId::None: return "None";
+  case BlockCodecId::ZLib: return "ZLib";
+  }
+  return "Unknown codec " + to_string(static_cast<int>(id));
+}
+
+unique_ptr<BlockCodec> MakeBlockCodec(BlockCodecId id, ZLib::Deflate::Level level,
+                                      string const & dictionary)
+{
+  switch (id)
+  {
+  case BlockCodecId::None: return my::make_unique<NoneCodec>();
+  case BlockCodecId::ZLib: return my::make_unique<ZLibCodec>(level, dictionary);
+  }
+  return nullptr;
+}
+
+// BlockCompressor ---------------------------------------------------------------------------------
+// static
+size_t constexpr BlockCompressor::kDefaultBlockSize;
+
+BlockCompressor::BlockCompressor(unique_ptr<BlockCodec> codec, size_t threadsCount,
+                                 size_t blockSize)
+  : m_codec(move(codec)), m_threadsCount(threadsCount), m_blockSize(blockSize)
+{
+  CHECK(m_codec, ());
+  CHECK_GREATER(m_blockSize, 0, ());
+}
+
+bool BlockCompressor::Compress(void const * data, size_t size, vector<uint8_t> & out) const
+{
+  if (data == nullptr && size != 0)
+    return false;
+
+  auto const * bytes = static_cast<uint8_t const *>(data);
+  size_t const numBlocks = (size + m_blockSize - 1) / m_blockSize;
+  vector<vector<uint8_t>> blocks(numBlocks);
+  bool const ok = ForEachBlock(m_threadsCount, numBlocks, [&](size_t i) {
+    size_t const offset = i * m_blockSize;
+    return m_codec->Compress(bytes + offset, min(m_blockSize, size - offset), blocks[i]);
+  });
+  if (!ok)
+    return false;
+
+  MemWriter<vector<uint8_t>> writer(out);
+  writer.Seek(out.size());
+  WriteToSink(writer, static_cast<uint8_t>(m_codec->GetId()));
+  WriteVarUint(writer, static_cast<uint64_t>(numBlocks));
+  for (size_t i = 0; i < numBlocks; ++i)
+  {
+    WriteVarUint(writer, static_cast<uint64_t>(min(m_blockSize, size - i * m_blockSize)));
+    WriteVarUint(writer, static_cast<uint64_t>(blocks[i].size()));
+  }
+  for (auto const & block : blocks)
+    writer.Write(block.data(), block.size());
+  return true;
+}
+
+// BlockDecompressor -------------------------------------------------------------------------------
+BlockDecompressor::BlockDecompressor(size_t threadsCount, string const & dictionary)
+  : m_threadsCount(threadsCount), m_dictionary(dictionary)
+{
+}
+
+bool BlockDecompressor::Decompress(void const * data, size_t size, vector<uint8_t> & out) const
+{
+  if (data == nullptr && size != 0)
+    return false;
+
+  unique_ptr<BlockCodec> codec;
+  // Positions of compressed blocks in |data| and positions of decompressed blocks in |out|.
+  vector<pair<uint64_t, uint64_t>> compressed;
+  vector<pair<uint64_t, uint64_t>> decompressed;
+  uint64_t offset = 0;
+  try
+  {
+    MemReaderWithExceptions reader(data, size);
+    ReaderSource<MemReaderWithExceptions> source(reader);
+    auto const id = static_cast<BlockCodecId>(ReadPrimitiveFromSource<uint8_t>(source));
+    codec = MakeBlockCodec(id, ZLib::Deflate::Level::DefaultCompression, m_dictionary);
+    if (!codec)
+      return false;
+
+    auto const numBlocks = ReadVarUint<uint64_t>(source);
+    // Each block takes at least two bytes of the header.
+    if (numBlocks > source.Size() / 2)
+      return false;
+
+    uint64_t decompressedSize = 0;
+    for (uint64_t i = 0; i < numBlocks; ++i)
+    {
+      auto const rawSize = ReadVarUint<uint64_t>(source);
+      auto const compressedSize = ReadVarUint<uint64_t>(source);
+      decompressed.emplace_back(decompressedSize, rawSize);
+      compressed.emplace_back(offset, compressedSize);
+      decompressedSize += rawSize;
+      offset += compressedSize;
+    }
+    uint64_t const blocksBegin = source.Pos();
+    if (offset != size - blocksBegin)
+      return false;
+    for (auto & block : compressed)
+      block.first += blocksBegin;
+    offset = decompressedSize;
+  }
+  catch (Reader::Exception const &)
+  {
+    return false;
+  }
+
+  size_t const outBegin = out.size();
+  out.resize(outBegin + static_cast<size_t>(offset));
+  auto const * bytes = static_cast<uint8_t const *>(data);
+  return ForEachBlock(m_threadsCount, compressed.size(), [&](size_t i) {
+    vector<uint8_t> block;
+    block.reserve(static_cast<size_t>(decompressed[i].second));
+    if (!codec->Decompress(bytes + compressed[i].first,
+                           static_cast<size_t>(compressed[i].second), block))
+    {
+      return false;
+    }
+    if (block.size() != decompressed[i].second)
+      return false;
+    if (!block.empty())
+      memcpy(&out[outBegin + decompressed[i].first], block.data(), block.size());
+    return true;
+  });
+}
+}  // namespace coding
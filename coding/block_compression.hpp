@@ -0,0 +1,81 @@
+#pragma once
+
+#include "coding/zlib.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace coding
+{
+// Codec of a block. Values are stored in compressed data.
+enum class BlockCodecId : uint8_t
+{
+  // Blocks are stored as is.
+  None = 0,
+  ZLib = 1
+};
+
+std::string DebugPrint(BlockCodecId id);
+
+// Compresses and decompresses independent blocks. New codecs implement this interface and
+// get a new BlockCodecId.
+class BlockCodec
+{
+public:
+  virtual ~BlockCodec() = default;
+
+  virtual BlockCodecId GetId() const = 0;
+  // Both methods append results to |out| and return false on errors.
+  virtual bool Compress(void const * data, size_t size, std::vector<uint8_t> & out) const = 0;
+  virtual bool Decompress(void const * data, size_t size, std::vector<uint8_t> & out) const = 0;
+};
+
+// |dictionary| is a preset dictionary for codecs which support it, it's ignored by others.
+// Returns nullptr for unknown |id|.
+std::unique_ptr<BlockCodec> MakeBlockCodec(BlockCodecId id,
+                                           ZLib::Deflate::Level level = ZLib::Deflate::Level::BestCompression,
+                                           std::string const & dictionary = {});
+
+// Splits data into blocks of |blockSize| bytes and compresses them separately on |threadsCount|
+// threads, so they may be decompressed in parallel too. The ratio is a bit worse than for
+// a single stream, the difference is negligible for blocks of hundreds of kilobytes.
+//
+// Format:
+// [BlockCodecId: uint8]
+// [number of blocks: VarUint]
+// [decompressed size: VarUint] [compressed size: VarUint] for each block
+// [compressed block] for each block
+class BlockCompressor
+{
+public:
+  static size_t constexpr kDefaultBlockSize = 256 * 1024;
+
+  // |codec| must not be null.
+  BlockCompressor(std::unique_ptr<BlockCodec> codec, size_t threadsCount,
+                  size_t blockSize = kDefaultBlockSize);
+
+  bool Compress(void const * data, size_t size, std::vector<uint8_t> & out) const;
+
+private:
+  std::unique_ptr<BlockCodec> m_codec;
+  size_t const m_threadsCount;
+  size_t const m_blockSize;
+};
+
+// Decompresses data of BlockCompressor. Codecs are created from ids in the data,
+// |dictionary| is passed to them.
+class BlockDecompressor
+{
+public:
+  explicit BlockDecompressor(size_t threadsCount, std::string const & dictionary = {});
+
+  bool Decompress(void const * data, size_t size, std::vector<uint8_t> & out) const;
+
+private:
+  size_t const m_threadsCount;
+  std::string const m_dictionary;
+};
+}  // namespace coding
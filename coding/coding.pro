@@ -12,8 +12,10 @@ include($$ROOT_DIR/common.pri)
 
 SOURCES += \
     base64.cpp \
+    block_compression.cpp \
     compressed_bit_vector.cpp \
     csv_reader.cpp \
+    elias_fano.cpp \
     file_container.cpp \
     file_name_utils.cpp \
     file_reader.cpp \
@@ -40,6 +42,7 @@ HEADERS += \
     $$ROOT_DIR/3party/expat/expat_impl.h \
     base64.hpp \
     bit_streams.hpp \
+    block_compression.hpp \
     buffer_reader.hpp \
     bwt_coder.hpp \
     byte_stream.hpp \
@@ -52,6 +55,7 @@ HEADERS += \
     diff.hpp \
     diff_patch_common.hpp \
     elias_coder.hpp \
+    elias_fano.hpp \
     endianness.hpp \
     file_container.hpp \
     file_name_utils.hpp \
@@ -100,4 +100,39 @@ UNIT_TEST(BitStreams_Large)
     }
   }
 }
+
+UNIT_TEST(BitStreams_ReadUnary)
+{
+  using TBuffer = vector<uint8_t>;
+  using TWriter = MemWriter<TBuffer>;
+
+  vector<uint32_t> const zeros = {0, 1, 7, 8, 9, 0, 0, 15, 16, 17, 3, 40};
+
+  TBuffer buf;
+  {
+    TWriter w(buf);
+    BitWriter<TWriter> bits(w);
+    for (auto const n : zeros)
+    {
+      bits.WriteAtMost64Bits(0, n);
+      bits.Write(1, 1);
+      // Some bits after the unary code to check they are not lost.
+      bits.Write(5, 3);
+    }
+  }
+
+  {
+    MemReader r(buf.data(), buf.size());
+    ReaderSource<MemReader> src(r);
+    BitReader<ReaderSource<MemReader>> bits(src);
+    uint64_t bitsRead = 0;
+    for (auto const n : zeros)
+    {
+      TEST_EQUAL(bits.ReadUnary(), n, ());
+      TEST_EQUAL(bits.Read(3), 5, (n));
+      bitsRead += n + 4;
+      TEST_EQUAL(bits.BitsRead(), bitsRead, (n));
+    }
+  }
+}
 }  // namespace
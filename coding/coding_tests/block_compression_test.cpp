@@ -0,0 +1,106 @@
+#include "testing/testing.hpp"
+
+#include "coding/block_compression.hpp"
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace coding;
+using namespace std;
+
+namespace
+{
+vector<uint8_t> MakeData(size_t size)
+{
+  mt19937 rng(0);
+  vector<uint8_t> data(size);
+  // Compressible data: short runs of random bytes.
+  for (size_t i = 0; i < size; ++i)
+    data[i] = static_cast<uint8_t>(rng() % 8 + (i / 100) % 4);
+  return data;
+}
+
+void TestCompressDecompress(BlockCodecId id, vector<uint8_t> const & original, size_t threadsCount,
+                            size_t blockSize)
+{
+  BlockCompressor const compressor(MakeBlockCodec(id), threadsCount, blockSize);
+  vector<uint8_t> compressed;
+  TEST(compressor.Compress(original.data(), original.size(), compressed), (id));
+
+  vector<uint8_t> decompressed;
+  TEST(BlockDecompressor(threadsCount).Decompress(compressed.data(), compressed.size(),
+                                                   decompressed),
+       (id));
+  TEST_EQUAL(decompressed, original, (id, threadsCount, blockSize));
+}
+
+UNIT_TEST(BlockCompression_Smoke)
+{
+  for (auto const id : {BlockCodecId::None, BlockCodecId::ZLib})
+  {
+    TestCompressDecompress(id, {}, 1 /* threadsCount */, 10 /* blockSize */);
+    TestCompressDecompress(id, {1, 2, 3}, 1 /* threadsCount */, 10 /* blockSize */);
+    TestCompressDecompress(id, MakeData(100000), 1 /* threadsCount */, 4096 /* blockSize */);
+    TestCompressDecompress(id, MakeData(100000), 4 /* threadsCount */, 4096 /* blockSize */);
+    TestCompressDecompress(id, MakeData(100001), 3 /* threadsCount */, 1000 /* blockSize */);
+  }
+}
+
+UNIT_TEST(BlockCompression_Ratio)
+{
+  auto const original = MakeData(100000);
+  BlockCompressor const compressor(MakeBlockCodec(BlockCodecId::ZLib), 2 /* threadsCount */);
+  vector<uint8_t> compressed;
+  TEST(compressor.Compress(original.data(), original.size(), compressed), ());
+  TEST_LESS(compressed.size(), original.size() / 2, ());
+}
+
+UNIT_TEST(BlockCompression_Dictionary)
+{
+  string const dictionary = "traffic speed group segment";
+  string const text = "speed group of a segment";
+  vector<uint8_t> const original(text.begin(), text.end());
+
+  BlockCompressor const compressor(
+      MakeBlockCodec(BlockCodecId::ZLib, ZLib::Deflate::Level::BestCompression, dictionary),
+      1 /* threadsCount */);
+  vector<uint8_t> compressed;
+  TEST(compressor.Compress(original.data(), original.size(), compressed), ());
+
+  vector<uint8_t> decompressed;
+  TEST(BlockDecompressor(1 /* threadsCount */, dictionary)
+           .Decompress(compressed.data(), compressed.size(), decompressed),
+       ());
+  TEST_EQUAL(decompressed, original, ());
+
+  decompressed.clear();
+  TEST(!BlockDecompressor(1 /* threadsCount */)
+            .Decompress(compressed.data(), compressed.size(), decompressed),
+       ());
+}
+
+UNIT_TEST(BlockCompression_CorruptedData)
+{
+  auto const original = MakeData(10000);
+  BlockCompressor const compressor(MakeBlockCodec(BlockCodecId::ZLib), 2 /* threadsCount */,
+                                   1000 /* blockSize */);
+  vector<uint8_t> compressed;
+  TEST(compressor.Compress(original.data(), original.size(), compressed), ());
+
+  BlockDecompressor const decompressor(2 /* threadsCount */);
+  vector<uint8_t> decompressed;
+  TEST(!decompressor.Decompress(compressed.data(), compressed.size() - 1, decompressed), ());
+
+  auto unknownCodec = compressed;
+  unknownCodec[0] = 100;
+  TEST(!decompressor.Decompress(unknownCodec.data(), unknownCodec.size(), decompressed), ());
+
+  auto corrupted = compressed;
+  corrupted[corrupted.size() / 2] ^= 0xFF;
+  TEST(!decompressor.Decompress(corrupted.data(), corrupted.size(), decompressed), ());
+
+  TEST(!decompressor.Decompress(nullptr, 0, decompressed), ());
+}
+}  // namespace
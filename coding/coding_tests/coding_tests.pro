@@ -21,6 +21,7 @@ include($$ROOT_DIR/common.pri)
 SOURCES += ../../testing/testingmain.cpp \
     base64_test.cpp \
     bit_streams_test.cpp \
+    block_compression_test.cpp \
     bwt_coder_tests.cpp \
     coder_util_test.cpp \
     compressed_bit_vector_test.cpp \
@@ -28,6 +29,7 @@ SOURCES += ../../testing/testingmain.cpp \
     dd_vector_test.cpp \
     diff_test.cpp \
     elias_coder_test.cpp \
+    elias_fano_test.cpp \
     endianness_test.cpp \
     file_container_test.cpp \
     file_data_test.cpp \
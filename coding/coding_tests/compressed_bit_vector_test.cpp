@@ -1,10 +1,15 @@
+#include "testing/benchmark.hpp"
 #include "testing/testing.hpp"
 
 #include "coding/compressed_bit_vector.hpp"
 #include "coding/writer.hpp"
 
+#include "base/logging.hpp"
+#include "base/macros.hpp"
+
 #include "std/algorithm.hpp"
 #include "std/iterator.hpp"
+#include "std/random.hpp"
 #include "std/set.hpp"
 
 namespace
@@ -467,3 +472,87 @@ UNIT_TEST(CompressedBitVector_SparseLeaveFirstNBits)
   for (uint64_t bit = 0; bit < (1 << 10); ++bit)
     TEST(!cbv->GetBit(bit), (bit));
 }
+
+UNIT_TEST(CompressedBitVector_Subtract5)
+{
+  // The minuend has more bit groups than the subtrahend.
+  vector<uint64_t> setBits1;
+  for (uint64_t i = 0; i < 200; ++i)
+    setBits1.push_back(i);
+  vector<uint64_t> setBits2 = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  auto cbv1 = coding::CompressedBitVectorBuilder::FromBitPositions(setBits1);
+  auto cbv2 = coding::CompressedBitVectorBuilder::FromBitPositions(setBits2);
+  TEST(cbv1.get(), ());
+  TEST(cbv2.get(), ());
+  TEST_EQUAL(coding::CompressedBitVector::StorageStrategy::Dense, cbv1->GetStorageStrategy(), ());
+  TEST_EQUAL(coding::CompressedBitVector::StorageStrategy::Dense, cbv2->GetStorageStrategy(), ());
+
+  auto cbv3 = coding::CompressedBitVector::Subtract(*cbv1, *cbv2);
+  TEST(cbv3.get(), ());
+  TEST_EQUAL(coding::CompressedBitVector::StorageStrategy::Dense, cbv3->GetStorageStrategy(), ());
+  CheckSubtraction(setBits1, setBits2, *cbv3);
+}
+
+UNIT_TEST(CompressedBitVector_IntersectGalloping)
+{
+  // Sparse vectors of very different sizes are intersected by galloping.
+  vector<uint64_t> setBits1 = {0, 3, 999, 1000, 5001, 77775, 99999, 100000, 123456};
+  vector<uint64_t> setBits2;
+  for (uint64_t i = 0; i < 100000; i += 5)
+    setBits2.push_back(i);
+  auto cbv1 = coding::CompressedBitVectorBuilder::FromBitPositions(setBits1);
+  auto cbv2 = coding::CompressedBitVectorBuilder::FromBitPositions(setBits2);
+  TEST(cbv1.get(), ());
+  TEST(cbv2.get(), ());
+  TEST_EQUAL(coding::CompressedBitVector::StorageStrategy::Sparse, cbv1->GetStorageStrategy(), ());
+  TEST_EQUAL(coding::CompressedBitVector::StorageStrategy::Sparse, cbv2->GetStorageStrategy(), ());
+
+  auto cbv3 = coding::CompressedBitVector::Intersect(*cbv1, *cbv2);
+  TEST(cbv3.get(), ());
+  CheckIntersection(setBits1, setBits2, *cbv3);
+  // 0, 1000 and 77775 are divisible by 5.
+  TEST_EQUAL(cbv3->PopCount(), 3, ());
+
+  auto cbv4 = coding::CompressedBitVector::Intersect(*cbv2, *cbv1);
+  TEST(cbv4.get(), ());
+  CheckIntersection(setBits2, setBits1, *cbv4);
+}
+
+BENCHMARK_TEST(CompressedBitVector_IntersectUnion)
+{
+  // Bit vectors of sizes which are typical for search: a dense one of a
+  // common token, a sparse one of a rare token and a sparse one of
+  // features in a rect.
+  uint64_t constexpr kNumFeatures = 1 << 20;
+  minstd_rand rng(0);
+  auto const makeBits = [&](uint64_t step) {
+    vector<uint64_t> setBits;
+    uniform_int_distribution<uint64_t> dist(1, 2 * step - 1);
+    for (uint64_t i = dist(rng); i < kNumFeatures; i += dist(rng))
+      setBits.push_back(i);
+    return setBits;
+  };
+
+  auto const dense1 = coding::CompressedBitVectorBuilder::FromBitPositions(makeBits(2));
+  auto const dense2 = coding::CompressedBitVectorBuilder::FromBitPositions(makeBits(3));
+  auto const sparse = coding::CompressedBitVectorBuilder::FromBitPositions(makeBits(16));
+  auto const rare = coding::CompressedBitVectorBuilder::FromBitPositions(makeBits(4096));
+  TEST_EQUAL(dense1->GetStorageStrategy(), coding::CompressedBitVector::StorageStrategy::Dense, ());
+  TEST_EQUAL(dense2->GetStorageStrategy(), coding::CompressedBitVector::StorageStrategy::Dense, ());
+  TEST_EQUAL(sparse->GetStorageStrategy(), coding::CompressedBitVector::StorageStrategy::Sparse, ());
+  TEST_EQUAL(rare->GetStorageStrategy(), coding::CompressedBitVector::StorageStrategy::Sparse, ());
+
+  auto const measure = [&](char const * name, coding::CompressedBitVector const & lhs,
+                           coding::CompressedBitVector const & rhs) {
+    uint64_t popCount = 0;
+    testing::RunBenchmark(name, 2 /* warmUps */, 20 /* repetitions */, [&]() {
+      popCount += coding::CompressedBitVector::Intersect(lhs, rhs)->PopCount();
+      popCount += coding::CompressedBitVector::Union(lhs, rhs)->PopCount();
+    });
+    FORCE_USE_VALUE(popCount);
+  };
+
+  measure("CBV intersection and union, dense x dense", *dense1, *dense2);
+  measure("CBV intersection and union, dense x sparse", *dense1, *sparse);
+  measure("CBV intersection and union, sparse x sparse", *sparse, *rare);
+}
@@ -0,0 +1,124 @@
+#include "testing/testing.hpp"
+
+#include "coding/elias_fano.hpp"
+#include "coding/writer.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace coding;
+using namespace std;
+
+namespace
+{
+void TestBitVector(vector<bool> const & bits)
+{
+  vector<uint64_t> words((bits.size() + 63) / 64);
+  for (size_t i = 0; i < bits.size(); ++i)
+  {
+    if (bits[i])
+      words[i / 64] |= uint64_t(1) << (i % 64);
+  }
+
+  auto const v = RankSelectBitVector::Create(words, bits.size());
+  TEST_EQUAL(v.Size(), bits.size(), ());
+
+  uint64_t rank = 0;
+  for (size_t i = 0; i < bits.size(); ++i)
+  {
+    TEST_EQUAL(v.Rank1(i), rank, (i));
+    TEST_EQUAL(v.Get(i), bits[i], (i));
+    if (bits[i])
+    {
+      TEST_EQUAL(v.Select1(rank), i, (rank));
+      ++rank;
+    }
+  }
+  TEST_EQUAL(v.Rank1(bits.size()), rank, ());
+  TEST_EQUAL(v.NumOnes(), rank, ());
+}
+
+void TestEliasFano(vector<uint64_t> const & values)
+{
+  auto const ef = EliasFano::Create(values);
+  TEST_EQUAL(ef.Size(), values.size(), ());
+  for (size_t i = 0; i < values.size(); ++i)
+    TEST_EQUAL(ef.Get(i), values[i], (i));
+
+  // Serialized sequence is mapped without copying.
+  vector<uint8_t> buffer;
+  {
+    MemWriter<vector<uint8_t>> writer(buffer);
+    ef.Serialize(writer);
+  }
+  TEST_EQUAL(buffer.size(), ef.ByteSize(), ());
+  vector<uint64_t> aligned(buffer.size() / sizeof(uint64_t));
+  memcpy(aligned.data(), buffer.data(), buffer.size());
+  auto const mapped = EliasFano::Map(aligned.data(), buffer.size());
+  TEST_EQUAL(mapped.Size(), values.size(), ());
+  for (size_t i = 0; i < values.size(); ++i)
+    TEST_EQUAL(mapped.Get(i), values[i], (i));
+
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    auto const expected = lower_bound(values.begin(), values.end(), values[i]) - values.begin();
+    TEST_EQUAL(ef.LowerBound(values[i]), expected, (i));
+  }
+  if (!values.empty())
+    TEST_EQUAL(ef.LowerBound(values.back() + 1), values.size(), ());
+}
+
+UNIT_TEST(RankSelectBitVector_Smoke)
+{
+  TestBitVector({});
+  TestBitVector({true});
+  TestBitVector({false, true, false, true, true});
+  TestBitVector(vector<bool>(1000, true));
+  TestBitVector(vector<bool>(1000, false));
+}
+
+UNIT_TEST(RankSelectBitVector_Random)
+{
+  mt19937 rng(0);
+  for (uint32_t density : {2, 10, 1000})
+  {
+    vector<bool> bits(20000);
+    for (size_t i = 0; i < bits.size(); ++i)
+      bits[i] = rng() % density == 0;
+    TestBitVector(bits);
+  }
+}
+
+UNIT_TEST(EliasFano_Smoke)
+{
+  TestEliasFano({});
+  TestEliasFano({0});
+  TestEliasFano({5, 5, 5});
+  TestEliasFano({0, 1, 2, 3, 100, 1000000, 1ULL << 40});
+}
+
+UNIT_TEST(EliasFano_Random)
+{
+  mt19937 rng(0);
+  vector<uint64_t> values;
+  uint64_t value = 0;
+  for (size_t i = 0; i < 10000; ++i)
+  {
+    value += rng() % 300;
+    values.push_back(value);
+  }
+  TestEliasFano(values);
+
+  // The size is close to n * (2 + log(u / n)) bits.
+  auto const ef = EliasFano::Create(values);
+  TEST_LESS(ef.ByteSize(), values.size() * 11 / 8 + 1024, ());
+}
+
+UNIT_TEST(EliasFano_BadData)
+{
+  vector<uint64_t> data = {10, 3, 100};
+  TEST_THROW(EliasFano::Map(data.data(), data.size() * sizeof(uint64_t)), SuccinctException, ());
+  TEST_THROW(EliasFano::Map(data.data(), 5), SuccinctException, ());
+}
+}  // namespace
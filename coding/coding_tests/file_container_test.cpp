@@ -206,6 +206,40 @@ UNIT_TEST(FilesContainer_RewriteExisting)
   FileWriter::DeleteFileX(fName);
 }
 
+UNIT_TEST(FilesContainer_CacheCounters)
+{
+  string const fName = "file_container.tmp";
+  string const data(5000, 'a');
+  {
+    FilesContainerW writer(fName);
+    for (string const tag : {"first", "second"})
+    {
+      FileWriter w = writer.GetWriter(tag);
+      w.Write(data.data(), data.size());
+    }
+  }
+
+  {
+    FilesContainerR cont(fName);
+    string buffer(data.size(), '\0');
+    cont.GetReader("first").Read(0, &buffer[0], buffer.size());
+    TEST_EQUAL(buffer, data, ());
+
+    // Subreaders of a section are counted for the section too.
+    auto const second = cont.GetReader("second");
+    second.SubReader(100, 10).Read(0, &buffer[0], 10);
+    second.SubReader(100, 10).Read(0, &buffer[0], 10);
+
+    auto const first = cont.GetCacheCounters("first");
+    TEST_GREATER(first.m_misses + first.m_hits, 0, (first));
+    auto const secondCounters = cont.GetCacheCounters("second");
+    TEST_GREATER_OR_EQUAL(secondCounters.m_hits, 1, (secondCounters));
+    TEST_EQUAL(cont.GetCacheCounters("unknown").m_misses, 0, ());
+  }
+
+  FileWriter::DeleteFileX(fName);
+}
+
 UNIT_TEST(FilesMappingContainer_Handle)
 {
   string const fName = "file_container.tmp";
@@ -234,6 +268,44 @@ UNIT_TEST(FilesMappingContainer_Handle)
   FileWriter::DeleteFileX(fName);
 }
 
+UNIT_TEST(FilesMappingContainer_SectionView)
+{
+  string const fName = "file_container.tmp";
+  MY_SCOPE_GUARD(deleteFile, bind(&FileWriter::DeleteFileX, fName));
+
+  vector<uint64_t> const values = {1, 2, 3, 0xFFFFFFFFFFFFFFFF};
+  {
+    FilesContainerW writer(fName);
+    // A section of odd size to check that the next one is aligned.
+    writer.Write(vector<uint8_t>(3, 7), "odd");
+    FileWriter w = writer.GetWriter("values");
+    w.Write(values.data(), values.size() * sizeof(values[0]));
+  }
+
+  {
+    FilesMappingContainer cont(fName);
+    auto const view = SectionView<uint64_t>::Map(cont, "values");
+    TEST(view.IsValid(), ());
+    TEST_EQUAL(vector<uint64_t>(view.begin(), view.end()), values, ());
+    TEST_EQUAL(view[3], values[3], ());
+    TEST_EQUAL(view.At(0), values[0], ());
+    TEST_THROW(view.At(4), Reader::SizeException, ());
+
+    TEST_THROW(SectionView<uint16_t>::Map(cont, "odd"), Reader::SizeException, ());
+    TEST_EQUAL(SectionView<uint8_t>::Map(cont, "odd").Size(), 3, ());
+  }
+
+  {
+    FilesContainerR cont(fName);
+    SectionView<uint64_t> view;
+    TEST(!view.IsValid(), ());
+    TEST(view.IsEmpty(), ());
+
+    view = SectionView<uint64_t>::Map(cont, "values");
+    TEST_EQUAL(vector<uint64_t>(view.begin(), view.end()), values, ());
+  }
+}
+
 UNIT_TEST(FilesMappingContainer_MoveHandle)
 {
   static uint8_t const kNumMapTests = 200;
@@ -49,3 +49,23 @@ UNIT_TEST(FileSorter_Random)
 
   TestFileSorter(data, "file_sorter_test_random.tmp", data.size() / 10);
 }
+
+UNIT_TEST(FileSorter_ManyChunks)
+{
+  mt19937 rng(1);
+  vector<uint32_t> data(100000);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = rng() % 1000;
+
+  // Chunks of 250 items are read by several blocks.
+  TestFileSorter(data, "file_sorter_test_many_chunks.tmp", 1000);
+  // Chunks of 16 items with an incomplete last chunk.
+  data.resize(data.size() - 7);
+  TestFileSorter(data, "file_sorter_test_small_chunks.tmp", 10);
+}
+
+UNIT_TEST(FileSorter_Empty)
+{
+  vector<uint32_t> data;
+  TestFileSorter(data, "file_sorter_test_empty.tmp", 10);
+}
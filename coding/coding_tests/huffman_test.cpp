@@ -2,6 +2,7 @@
 
 #include "coding/huffman.hpp"
 #include "coding/reader.hpp"
+#include "coding/write_to_sink.hpp"
 #include "coding/writer.hpp"
 
 #include "base/string_utils.hpp"
@@ -127,4 +128,47 @@ UNIT_TEST(Huffman_Serialization_Data)
   TEST_EQUAL(expected, received, ());
 }
 
+UNIT_TEST(Huffman_LongCodes)
+{
+  // Fibonacci frequencies make codes longer than a single table lookup.
+  vector<uint32_t> symbols;
+  uint32_t a = 1, b = 1;
+  for (uint32_t symbol = 0; symbol < 20; ++symbol)
+  {
+    for (uint32_t i = 0; i < a; ++i)
+      symbols.push_back(symbol);
+    b += a;
+    swap(a, b);
+  }
+
+  HuffmanCoder hW;
+  hW.Init(symbols.begin(), symbols.end());
+  HuffmanCoder::Code code;
+  TEST(hW.Encode(0, code), ());
+  TEST_GREATER(code.len, 11, ());
+
+  // Every string is followed by a byte, which must not be consumed by decoding.
+  vector<vector<uint32_t>> const strs = {{}, {0}, {19}, {19, 19, 0}, symbols, {0, 1, 2, 3, 4}};
+  vector<uint8_t> buf;
+  MemWriter<vector<uint8_t>> writer(buf);
+  hW.WriteEncoding(writer);
+  for (auto const & s : strs)
+  {
+    hW.EncodeAndWrite(writer, s.begin(), s.end());
+    WriteToSink(writer, static_cast<uint8_t>(0xAB));
+  }
+
+  HuffmanCoder hR;
+  MemReader memReader(&buf[0], buf.size());
+  ReaderSource<MemReader> reader(memReader);
+  hR.ReadEncoding(reader);
+  for (auto const & s : strs)
+  {
+    vector<uint32_t> received;
+    hR.ReadAndDecode(reader, back_inserter(received));
+    TEST_EQUAL(s, received, ());
+    TEST_EQUAL(ReadPrimitiveFromSource<uint8_t>(reader), 0xAB, ());
+  }
+  TEST_EQUAL(reader.Pos(), writer.Pos(), ());
+}
 }  // namespace coding
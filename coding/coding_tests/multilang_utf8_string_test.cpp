@@ -130,3 +130,24 @@ UNIT_TEST(MultilangString_HasString)
   TEST(!s.HasString(1), ());
   TEST(!s.HasString(32), ());
 }
+
+UNIT_TEST(MultilangString_GetBestString)
+{
+  StringUtf8Multilang s;
+  s.AddString(0, "xxx");
+  s.AddString(18, "yyy");
+  s.AddString(63, "zzz");
+
+  int8_t lang;
+  string str;
+  TEST(s.GetBestString({1, 63, 18}, lang, str), ());
+  TEST_EQUAL(lang, 63, ());
+  TEST_EQUAL(str, "zzz", ());
+
+  TEST(s.GetBestString({18, 0}, lang, str), ());
+  TEST_EQUAL(lang, 18, ());
+  TEST_EQUAL(str, "yyy", ());
+
+  TEST(!s.GetBestString({1, 32}, lang, str), ());
+  TEST(!s.GetBestString({}, lang, str), ());
+}
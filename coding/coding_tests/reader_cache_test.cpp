@@ -42,3 +42,38 @@ UNIT_TEST(CacheReaderRandomTest)
     TEST_EQUAL(readMem, readCache, (pos, len, i));
   }
 }
+
+UNIT_TEST(CacheReaderReadahead)
+{
+  vector<char> data(100000);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<char>(i % 251);
+  MemReader const memReader(&data[0], data.size());
+
+  // Sequential reads.
+  ReaderCache<MemReader const> cache(10 /* logPageSize */, 5 /* logPageCount */,
+                                     8 /* maxReadaheadPages */);
+  string read(100, '0');
+  for (size_t pos = 0; pos + read.size() <= data.size(); pos += read.size())
+  {
+    cache.Read(memReader, pos, &read[0], read.size());
+    TEST(equal(read.begin(), read.end(), data.begin() + pos), (pos));
+  }
+  auto const & counters = cache.GetCounters();
+  size_t const numPages = (data.size() + 1023) / 1024;
+  TEST_GREATER(counters.m_readaheadPages, numPages / 2, (counters));
+  TEST_LESS(counters.m_misses, numPages / 2, (counters));
+
+  // Random reads don't trigger readahead.
+  ReaderCache<MemReader const> randomCache(10 /* logPageSize */, 5 /* logPageCount */,
+                                           8 /* maxReadaheadPages */);
+  ReaderCacheCounters rangeCounters;
+  for (size_t pos : {50000, 3500, 90000, 20000, 70000})
+  {
+    randomCache.Read(memReader, pos, &read[0], read.size(), &rangeCounters);
+    TEST(equal(read.begin(), read.end(), data.begin() + pos), (pos));
+  }
+  TEST_EQUAL(randomCache.GetCounters().m_readaheadPages, 0, ());
+  TEST_EQUAL(randomCache.GetCounters().m_misses, 5, ());
+  TEST_EQUAL(rangeCounters.m_misses, 5, ());
+}
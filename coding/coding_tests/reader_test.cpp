@@ -88,6 +88,37 @@ UNIT_TEST(FileReaderReadAsText)
   FileWriter::DeleteFileX(fName);
 }
 
+UNIT_TEST(FileReaderReadBatch)
+{
+  char const fName[] = "reader_batch_test_tmp.dat";
+  {
+    FileWriter writer(fName);
+    writer.Write(&kData[0], kData.size());
+  }
+
+  {
+    FileReader fileReader(fName, true /* withExceptions */);
+    // Scattered, unordered and empty requests in a subreader.
+    FileReader const subReader = fileReader.SubReader(6, kData.size() - 6);
+    char brown[5], fox[3], dog[3], empty[1];
+    vector<Reader::ReadRequest> const requests = {
+        {28, dog, 3}, {0, brown, 5}, {0, empty, 0}, {6, fox, 3}};
+    subReader.ReadBatch(requests);
+    TEST_EQUAL(string(brown, 5), "brown", ());
+    TEST_EQUAL(string(fox, 3), "fox", ());
+    TEST_EQUAL(string(dog, 3), "dog", ());
+
+    MemReader memReader(kData.c_str(), kData.size());
+    char quick[5];
+    memReader.ReadBatch({{0, quick, 5}});
+    TEST_EQUAL(string(quick, 5), "Quick", ());
+
+    TEST_ANY_THROW(subReader.ReadBatch({{kData.size(), brown, 1}}), ());
+  }
+
+  FileWriter::DeleteFileX(fName);
+}
+
 UNIT_TEST(ReaderStreamBuf)
 {
   string const name = "test.txt";
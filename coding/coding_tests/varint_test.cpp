@@ -1,4 +1,5 @@
 #include "coding/varint.hpp"
+#include "testing/benchmark.hpp"
 #include "testing/testing.hpp"
 
 #include "coding/byte_stream.hpp"
@@ -178,3 +179,55 @@ UNIT_TEST(ReadVarInt64Array)
   }
 }
 
+UNIT_TEST(ReadVarUint64Array_SmallValues)
+{
+  // Runs of one byte varints of different lengths mixed with long ones.
+  vector<uint64_t> values;
+  for (size_t run = 0; run < 20; ++run)
+  {
+    for (size_t i = 0; i < run; ++i)
+      values.push_back((run * 7 + i) % 128);
+    values.push_back(128 + run * 1000);
+  }
+
+  vector<unsigned char> data;
+  {
+    PushBackByteSink<vector<unsigned char> > dst(data);
+    for (auto const v : values)
+      WriteVarUint(dst, v);
+  }
+
+  for (size_t count = 0; count <= values.size(); ++count)
+  {
+    vector<uint64_t> result;
+    void const * pEnd = ReadVarUint64Array(&data[0], count, MakeBackInsertFunctor(result));
+    TEST_EQUAL(result, vector<uint64_t>(values.begin(), values.begin() + count), (count));
+
+    vector<uint64_t> result2;
+    TEST_EQUAL(ReadVarUint64Array(&data[0], pEnd, MakeBackInsertFunctor(result2)), pEnd, (count));
+    TEST_EQUAL(result2, result, (count));
+  }
+}
+
+#ifndef DEBUG
+BENCHMARK_TEST(ReadVarUint64Array)
+{
+  // Mostly small values, as deltas of sorted feature ids are.
+  vector<uint64_t> values;
+  for (uint64_t i = 0; i < 100000; ++i)
+    values.push_back(i % 16 == 0 ? i * 1000 : i % 100);
+
+  vector<unsigned char> data;
+  {
+    PushBackByteSink<vector<unsigned char> > dst(data);
+    for (auto const v : values)
+      WriteVarUint(dst, v);
+  }
+
+  uint64_t sum = 0;
+  testing::RunBenchmark("ReadVarUint64Array", 3 /* warmUps */, 50 /* repetitions */, [&]() {
+    ReadVarUint64Array(&data[0], values.size(), [&sum](uint64_t v) { sum += v; });
+  });
+  FORCE_USE_VALUE(sum);
+}
+#endif
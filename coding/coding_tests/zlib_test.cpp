@@ -68,6 +68,32 @@ UNIT_TEST(ZLib_Large)
   TestDeflateInflate(original);
 }
 
+UNIT_TEST(ZLib_Dictionary)
+{
+  string const dictionary = "{\"segment\": 0, \"speed\": 0, \"direction\": \"forward\"}";
+  string const original = "{\"segment\": 17, \"speed\": 60, \"direction\": \"forward\"}";
+
+  Deflate const deflate(Deflate::Format::ZLib, Deflate::Level::BestCompression);
+  Deflate const deflateWithDictionary(Deflate::Format::ZLib, Deflate::Level::BestCompression,
+                                      dictionary);
+
+  string compressed;
+  TEST(deflate(original, back_inserter(compressed)), ());
+  string compressedWithDictionary;
+  TEST(deflateWithDictionary(original, back_inserter(compressedWithDictionary)), ());
+  TEST_LESS(compressedWithDictionary.size(), compressed.size(), ());
+
+  string decompressed;
+  TEST(Inflate(Inflate::Format::ZLib, dictionary)(compressedWithDictionary,
+                                                   back_inserter(decompressed)),
+       ());
+  TEST_EQUAL(decompressed, original, ());
+
+  // Data can't be decompressed without the dictionary.
+  decompressed.clear();
+  TEST(!Inflate(Inflate::Format::ZLib)(compressedWithDictionary, back_inserter(decompressed)), ());
+}
+
 UNIT_TEST(GZip_ForeignData)
 {
   // To get this array of bytes, type following:
@@ -11,6 +11,84 @@ namespace coding
 {
 namespace
 {
+// When a sparse vector is this many times larger than the other one,
+// they are intersected by galloping over the larger vector.
+size_t constexpr kGallopingRatio = 32;
+
+unique_ptr<CompressedBitVector> BuildFromBitGroups(vector<uint64_t> && bitGroups,
+                                                   uint64_t popCount);
+
+// Word-level kernels. They work on plain arrays, so compilers
+// vectorize them with the instructions of the target platform.
+uint64_t AndWords(uint64_t const * a, uint64_t const * b, size_t n, uint64_t * res)
+{
+  uint64_t popCount = 0;
+  for (size_t i = 0; i < n; ++i)
+  {
+    res[i] = a[i] & b[i];
+    popCount += bits::PopCount(res[i]);
+  }
+  return popCount;
+}
+
+uint64_t AndNotWords(uint64_t const * a, uint64_t const * b, size_t n, uint64_t * res)
+{
+  uint64_t popCount = 0;
+  for (size_t i = 0; i < n; ++i)
+  {
+    res[i] = a[i] & ~b[i];
+    popCount += bits::PopCount(res[i]);
+  }
+  return popCount;
+}
+
+uint64_t OrWords(uint64_t const * a, uint64_t const * b, size_t n, uint64_t * res)
+{
+  uint64_t popCount = 0;
+  for (size_t i = 0; i < n; ++i)
+  {
+    res[i] = a[i] | b[i];
+    popCount += bits::PopCount(res[i]);
+  }
+  return popCount;
+}
+
+uint64_t PopCountWords(uint64_t const * a, size_t n)
+{
+  uint64_t popCount = 0;
+  for (size_t i = 0; i < n; ++i)
+    popCount += bits::PopCount(a[i]);
+  return popCount;
+}
+
+// Appends to |res| values of the sorted range [smallBegin, smallEnd)
+// which are in the sorted range [largeBegin, largeEnd). Each value is
+// looked for by exponential search from the position of the previous
+// one, so it takes O(n log(m / n)) for ranges of sizes n and m.
+template <typename TIt>
+void GallopingIntersection(TIt smallBegin, TIt smallEnd, TIt largeBegin, TIt largeEnd,
+                           vector<uint64_t> & res)
+{
+  auto first = largeBegin;
+  for (auto it = smallBegin; it != smallEnd && first != largeEnd; ++it)
+  {
+    uint64_t const value = *it;
+    size_t const remaining = static_cast<size_t>(largeEnd - first);
+
+    // All values before |first| are less than |value|, so is first[step / 2].
+    size_t step = 1;
+    while (step < remaining && first[step] < value)
+      step *= 2;
+
+    first = lower_bound(first + step / 2, first + min(step + 1, remaining), value);
+    if (first != largeEnd && *first == value)
+    {
+      res.push_back(value);
+      ++first;
+    }
+  }
+}
+
 struct IntersectOp
 {
   IntersectOp() {}
@@ -21,20 +99,25 @@ struct IntersectOp
     size_t sizeA = a.NumBitGroups();
     size_t sizeB = b.NumBitGroups();
     vector<uint64_t> resGroups(min(sizeA, sizeB));
-    for (size_t i = 0; i < resGroups.size(); ++i)
-      resGroups[i] = a.GetBitGroup(i) & b.GetBitGroup(i);
-    return coding::CompressedBitVectorBuilder::FromBitGroups(move(resGroups));
+    uint64_t const popCount =
+        AndWords(a.GetBitGroups(), b.GetBitGroups(), resGroups.size(), resGroups.data());
+    return BuildFromBitGroups(move(resGroups), popCount);
   }
 
   // The intersection of dense and sparse is always sparse.
   unique_ptr<coding::CompressedBitVector> operator()(coding::DenseCBV const & a,
                                                      coding::SparseCBV const & b) const
   {
+    uint64_t const * groups = a.GetBitGroups();
+    uint64_t const numBits = a.NumBitGroups() * DenseCBV::kBlockSize;
+
     vector<uint64_t> resPos;
-    for (size_t i = 0; i < b.PopCount(); ++i)
+    resPos.reserve(min(a.PopCount(), b.PopCount()));
+    // Positions are sorted, so the ones beyond the dense vector may be skipped at once.
+    for (auto it = b.Begin(); it != b.End() && *it < numBits; ++it)
     {
-      auto pos = b.Select(i);
-      if (a.GetBit(pos))
+      uint64_t const pos = *it;
+      if ((groups[pos / DenseCBV::kBlockSize] >> (pos % DenseCBV::kBlockSize)) & 1)
         resPos.push_back(pos);
     }
     return make_unique<coding::SparseCBV>(move(resPos));
@@ -50,7 +133,23 @@ struct IntersectOp
                                                      coding::SparseCBV const & b) const
   {
     vector<uint64_t> resPos;
-    set_intersection(a.Begin(), a.End(), b.Begin(), b.End(), back_inserter(resPos));
+    size_t const sizeA = a.PopCount();
+    size_t const sizeB = b.PopCount();
+    if (sizeA * kGallopingRatio < sizeB)
+    {
+      resPos.reserve(sizeA);
+      GallopingIntersection(a.Begin(), a.End(), b.Begin(), b.End(), resPos);
+    }
+    else if (sizeB * kGallopingRatio < sizeA)
+    {
+      resPos.reserve(sizeB);
+      GallopingIntersection(b.Begin(), b.End(), a.Begin(), a.End(), resPos);
+    }
+    else
+    {
+      resPos.reserve(min(sizeA, sizeB));
+      set_intersection(a.Begin(), a.End(), b.Begin(), b.End(), back_inserter(resPos));
+    }
     return make_unique<coding::SparseCBV>(move(resPos));
   }
 };
@@ -64,10 +163,13 @@ struct SubtractOp
   {
     size_t sizeA = a.NumBitGroups();
     size_t sizeB = b.NumBitGroups();
-    vector<uint64_t> resGroups(min(sizeA, sizeB));
-    for (size_t i = 0; i < resGroups.size(); ++i)
-      resGroups[i] = a.GetBitGroup(i) & ~b.GetBitGroup(i);
-    return CompressedBitVectorBuilder::FromBitGroups(move(resGroups));
+    vector<uint64_t> resGroups(sizeA);
+    size_t const commonSize = min(sizeA, sizeB);
+    uint64_t popCount =
+        AndNotWords(a.GetBitGroups(), b.GetBitGroups(), commonSize, resGroups.data());
+    copy(a.GetBitGroups() + commonSize, a.GetBitGroups() + sizeA, resGroups.begin() + commonSize);
+    popCount += PopCountWords(resGroups.data() + commonSize, sizeA - commonSize);
+    return BuildFromBitGroups(move(resGroups), popCount);
   }
 
   unique_ptr<coding::CompressedBitVector> operator()(coding::DenseCBV const & a,
@@ -131,19 +233,12 @@ struct UnionOp
     size_t commonSize = min(sizeA, sizeB);
     size_t resultSize = max(sizeA, sizeB);
     vector<uint64_t> resGroups(resultSize);
-    for (size_t i = 0; i < commonSize; ++i)
-      resGroups[i] = a.GetBitGroup(i) | b.GetBitGroup(i);
-    if (a.NumBitGroups() == resultSize)
-    {
-      for (size_t i = commonSize; i < resultSize; ++i)
-        resGroups[i] = a.GetBitGroup(i);
-    }
-    else
-    {
-      for (size_t i = commonSize; i < resultSize; ++i)
-        resGroups[i] = b.GetBitGroup(i);
-    }
-    return CompressedBitVectorBuilder::FromBitGroups(move(resGroups));
+    uint64_t popCount =
+        OrWords(a.GetBitGroups(), b.GetBitGroups(), commonSize, resGroups.data());
+    uint64_t const * tail = (sizeA == resultSize ? a.GetBitGroups() : b.GetBitGroups());
+    copy(tail + commonSize, tail + resultSize, resGroups.begin() + commonSize);
+    popCount += PopCountWords(resGroups.data() + commonSize, resultSize - commonSize);
+    return BuildFromBitGroups(move(resGroups), popCount);
   }
 
   unique_ptr<coding::CompressedBitVector> operator()(coding::DenseCBV const & a,
@@ -254,6 +349,34 @@ bool DenseEnough(uint64_t popCount, uint64_t totalBits)
   return popCount * 10 >= totalBits * 3;
 }
 
+// Builds a bit vector from |bitGroups| with |popCount| bits set.
+unique_ptr<CompressedBitVector> BuildFromBitGroups(vector<uint64_t> && bitGroups,
+                                                   uint64_t popCount)
+{
+  static uint64_t const kBlockSize = DenseCBV::kBlockSize;
+
+  ASSERT_EQUAL(popCount, PopCountWords(bitGroups.data(), bitGroups.size()), ());
+
+  while (!bitGroups.empty() && bitGroups.back() == 0)
+    bitGroups.pop_back();
+  if (bitGroups.empty())
+    return make_unique<SparseCBV>(move(bitGroups));
+
+  uint64_t const maxBit = kBlockSize * (bitGroups.size() - 1) + bits::FloorLog(bitGroups.back());
+
+  if (DenseEnough(popCount, maxBit))
+    return DenseCBV::BuildFromBitGroups(move(bitGroups), popCount);
+
+  vector<uint64_t> setBits;
+  setBits.reserve(popCount);
+  for (size_t i = 0; i < bitGroups.size(); ++i)
+  {
+    for (uint64_t group = bitGroups[i]; group != 0; group &= group - 1)
+      setBits.push_back(kBlockSize * i + bits::NumLoZeroBits64(group));
+  }
+  return make_unique<SparseCBV>(move(setBits));
+}
+
 template <typename TBitPositions>
 unique_ptr<CompressedBitVector> BuildFromBitPositions(TBitPositions && setBits)
 {
@@ -288,10 +411,17 @@ DenseCBV::DenseCBV(vector<uint64_t> const & setBits)
 // static
 unique_ptr<DenseCBV> DenseCBV::BuildFromBitGroups(vector<uint64_t> && bitGroups)
 {
+  uint64_t const popCount = PopCountWords(bitGroups.data(), bitGroups.size());
+  return BuildFromBitGroups(move(bitGroups), popCount);
+}
+
+// static
+unique_ptr<DenseCBV> DenseCBV::BuildFromBitGroups(vector<uint64_t> && bitGroups,
+                                                  uint64_t popCount)
+{
+  ASSERT_EQUAL(popCount, PopCountWords(bitGroups.data(), bitGroups.size()), ());
   unique_ptr<DenseCBV> cbv(new DenseCBV());
-  cbv->m_popCount = 0;
-  for (size_t i = 0; i < bitGroups.size(); ++i)
-    cbv->m_popCount += bits::PopCount(bitGroups[i]);
+  cbv->m_popCount = popCount;
   cbv->m_bitGroups = move(bitGroups);
   return cbv;
 }
@@ -427,31 +557,8 @@ unique_ptr<CompressedBitVector> CompressedBitVectorBuilder::FromBitPositions(
 unique_ptr<CompressedBitVector> CompressedBitVectorBuilder::FromBitGroups(
     vector<uint64_t> && bitGroups)
 {
-  static uint64_t const kBlockSize = DenseCBV::kBlockSize;
-
-  while (!bitGroups.empty() && bitGroups.back() == 0)
-    bitGroups.pop_back();
-  if (bitGroups.empty())
-    return make_unique<SparseCBV>(move(bitGroups));
-
-  uint64_t const maxBit = kBlockSize * (bitGroups.size() - 1) + bits::FloorLog(bitGroups.back());
-  uint64_t popCount = 0;
-  for (size_t i = 0; i < bitGroups.size(); ++i)
-    popCount += bits::PopCount(bitGroups[i]);
-
-  if (DenseEnough(popCount, maxBit))
-    return DenseCBV::BuildFromBitGroups(move(bitGroups));
-
-  vector<uint64_t> setBits;
-  for (size_t i = 0; i < bitGroups.size(); ++i)
-  {
-    for (size_t j = 0; j < kBlockSize; ++j)
-    {
-      if (((bitGroups[i] >> j) & 1) > 0)
-        setBits.push_back(kBlockSize * i + j);
-    }
-  }
-  return make_unique<SparseCBV>(setBits);
+  uint64_t const popCount = PopCountWords(bitGroups.data(), bitGroups.size());
+  return BuildFromBitGroups(move(bitGroups), popCount);
 }
 
 string DebugPrint(CompressedBitVector::StorageStrategy strat)
@@ -5,6 +5,7 @@
 #include "coding/writer.hpp"
 
 #include "base/assert.hpp"
+#include "base/bits.hpp"
 #include "base/ref_counted.hpp"
 
 #include "std/algorithm.hpp"
@@ -97,19 +98,23 @@ public:
   // Not to be confused with the constructor: the semantics
   // of the array of integers is completely different.
   static unique_ptr<DenseCBV> BuildFromBitGroups(vector<uint64_t> && bitGroups);
+  // The same as above when the number of set bits in |bitGroups| is already known.
+  static unique_ptr<DenseCBV> BuildFromBitGroups(vector<uint64_t> && bitGroups,
+                                                 uint64_t popCount);
 
   size_t NumBitGroups() const { return m_bitGroups.size(); }
 
+  // Returns NumBitGroups() bit groups, it's used by word-level operations.
+  uint64_t const * GetBitGroups() const { return m_bitGroups.data(); }
+
   template <typename TFn>
   void ForEach(TFn && f) const
   {
     for (size_t i = 0; i < m_bitGroups.size(); ++i)
     {
-      for (size_t j = 0; j < kBlockSize; ++j)
-      {
-        if (((m_bitGroups[i] >> j) & 1) > 0)
-          f(kBlockSize * i + j);
-      }
+      // Visits set bits only, from the lowest to the highest.
+      for (uint64_t group = m_bitGroups[i]; group != 0; group &= group - 1)
+        f(kBlockSize * i + bits::NumLoZeroBits64(group));
     }
   }
 
@@ -30,9 +30,7 @@ public:
   template <typename TReader>
   static uint64_t Decode(BitReader<TReader> & reader)
   {
-    uint8_t n = 0;
-    while (reader.Read(1) == 0)
-      ++n;
+    uint8_t const n = static_cast<uint8_t>(reader.ReadUnary());
 
     ASSERT_LESS_OR_EQUAL(n, 63, ());
 
@@ -0,0 +1,237 @@
+#include "coding/elias_fano.hpp"
+
+#include "coding/endianness.hpp"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace coding
+{
+namespace
+{
+// Number of words of the header of RankSelectBitVector.
+uint64_t constexpr kBitVectorHeaderWords = 2;
+// Number of words of the header of EliasFano.
+uint64_t constexpr kEliasFanoHeaderWords = 3;
+
+uint64_t DivideRoundUp(uint64_t x, uint64_t y) { return (x + y - 1) / y; }
+
+uint64_t const * ToWords(void const * data, size_t size)
+{
+  CHECK(!IsBigEndian(), ("Mapping of succinct structures needs a little-endian host."));
+  if (reinterpret_cast<uintptr_t>(data) % alignof(uint64_t) != 0 || size % sizeof(uint64_t) != 0)
+    MYTHROW(SuccinctException, ("Data isn't aligned:", size));
+  return static_cast<uint64_t const *>(data);
+}
+}  // namespace
+
+// RankSelectBitVector -----------------------------------------------------------------------------
+// static
+uint64_t constexpr RankSelectBitVector::kBlockBits;
+// static
+uint64_t constexpr RankSelectBitVector::kSelectSampleRate;
+
+// static
+vector<uint64_t> RankSelectBitVector::Build(vector<uint64_t> const & bits, uint64_t numBits)
+{
+  uint64_t const numWords = DivideRoundUp(numBits, 64);
+  CHECK_LESS_OR_EQUAL(numWords, bits.size(), ());
+
+  vector<uint64_t> data = {numBits, 0 /* numOnes */};
+  data.insert(data.end(), bits.begin(), bits.begin() + numWords);
+  // Clears bits after the end, so rank of the last block is correct.
+  if (numBits % 64 != 0)
+    data.back() &= bits::GetFullMask(static_cast<uint8_t>(numBits % 64));
+
+  uint64_t const kWordsPerBlock = kBlockBits / 64;
+  uint64_t const numBlocks = DivideRoundUp(numWords, kWordsPerBlock);
+  uint64_t numOnes = 0;
+  vector<uint64_t> selects;
+  for (uint64_t block = 0; block < numBlocks; ++block)
+  {
+    data.push_back(numOnes);
+    for (uint64_t w = block * kWordsPerBlock; w < min(numWords, (block + 1) * kWordsPerBlock); ++w)
+    {
+      uint64_t const word = data[kBitVectorHeaderWords + w];
+      uint64_t const ones = bits::PopCount(word);
+      // The first sample is the 0-th set bit.
+      uint64_t const nextSample = DivideRoundUp(numOnes, kSelectSampleRate) * kSelectSampleRate;
+      if (nextSample < numOnes + ones)
+        selects.push_back(block);
+      numOnes += ones;
+    }
+  }
+  data.push_back(numOnes);
+  data.insert(data.end(), selects.begin(), selects.end());
+  data[1] = numOnes;
+  return data;
+}
+
+// static
+RankSelectBitVector RankSelectBitVector::Map(void const * data, size_t size)
+{
+  RankSelectBitVector v;
+  v.Init(ToWords(data, size), size / sizeof(uint64_t));
+  return v;
+}
+
+// static
+RankSelectBitVector RankSelectBitVector::Create(vector<uint64_t> const & bits, uint64_t numBits)
+{
+  RankSelectBitVector v;
+  v.m_storage = Build(bits, numBits);
+  v.Init(v.m_storage.data(), v.m_storage.size());
+  return v;
+}
+
+void RankSelectBitVector::Init(uint64_t const * data, uint64_t numWords)
+{
+  if (numWords < kBitVectorHeaderWords)
+    MYTHROW(SuccinctException, ("Bad size of bit vector:", numWords));
+
+  m_numBits = data[0];
+  m_numOnes = data[1];
+  uint64_t const numBitWords = DivideRoundUp(m_numBits, 64);
+  uint64_t const numBlocks = DivideRoundUp(numBitWords, kBlockBits / 64);
+  uint64_t const numSelects = DivideRoundUp(m_numOnes, kSelectSampleRate);
+  if (numBitWords > numWords ||
+      kBitVectorHeaderWords + numBitWords + numBlocks + 1 + numSelects != numWords)
+  {
+    MYTHROW(SuccinctException, ("Bad size of bit vector:", numWords, m_numBits, m_numOnes));
+  }
+
+  m_data = data;
+  m_numWords = numWords;
+  m_bits = data + kBitVectorHeaderWords;
+  m_ranks = m_bits + numBitWords;
+  m_selects = m_ranks + numBlocks + 1;
+}
+
+uint64_t RankSelectBitVector::Rank1(uint64_t i) const
+{
+  ASSERT_LESS_OR_EQUAL(i, m_numBits, ());
+  uint64_t const block = i / kBlockBits;
+  uint64_t rank = m_ranks[block];
+  uint64_t const lastWord = i / 64;
+  for (uint64_t w = block * (kBlockBits / 64); w < lastWord; ++w)
+    rank += bits::PopCount(m_bits[w]);
+  if (i % 64 != 0)
+    rank += bits::PopCount(m_bits[lastWord] & bits::GetFullMask(static_cast<uint8_t>(i % 64)));
+  return rank;
+}
+
+uint64_t RankSelectBitVector::Select1(uint64_t k) const
+{
+  ASSERT_LESS(k, m_numOnes, ());
+  uint64_t block = m_selects[k / kSelectSampleRate];
+  while (m_ranks[block + 1] <= k)
+    ++block;
+
+  uint64_t rank = k - m_ranks[block];
+  uint64_t w = block * (kBlockBits / 64);
+  while (true)
+  {
+    uint64_t const ones = bits::PopCount(m_bits[w]);
+    if (rank < ones)
+      break;
+    rank -= ones;
+    ++w;
+  }
+  return w * 64 + bits::Select64(m_bits[w], static_cast<uint32_t>(rank));
+}
+
+// EliasFano ---------------------------------------------------------------------------------------
+// static
+vector<uint64_t> EliasFano::Build(vector<uint64_t> const & values)
+{
+  CHECK(is_sorted(values.begin(), values.end()), ());
+
+  uint64_t const n = values.size();
+  uint64_t const universe = values.empty() ? 0 : values.back() + 1;
+  // Low bits are floor(log(u / n)), it minimizes the size.
+  uint64_t numLowBits = 0;
+  if (n != 0 && universe > n)
+    numLowBits = bits::FloorLog(universe / n);
+
+  uint64_t const numLowWords = DivideRoundUp(n * numLowBits, 64);
+  vector<uint64_t> data = {n, numLowBits, numLowWords};
+  data.resize(kEliasFanoHeaderWords + numLowWords);
+  uint64_t * low = data.data() + kEliasFanoHeaderWords;
+
+  // The i-th value sets bit (value >> numLowBits) + i of high bits.
+  uint64_t const numHighBits = n == 0 ? 0 : (values.back() >> numLowBits) + n;
+  vector<uint64_t> high(DivideRoundUp(numHighBits, 64));
+  for (uint64_t i = 0; i < n; ++i)
+  {
+    uint64_t const value = values[i];
+    if (numLowBits != 0)
+    {
+      uint64_t const lowValue = value & bits::GetFullMask(static_cast<uint8_t>(numLowBits));
+      uint64_t const bit = i * numLowBits;
+      low[bit / 64] |= lowValue << (bit % 64);
+      if (bit % 64 + numLowBits > 64)
+        low[bit / 64 + 1] |= lowValue >> (64 - bit % 64);
+    }
+    uint64_t const highBit = (value >> numLowBits) + i;
+    high[highBit / 64] |= uint64_t(1) << (highBit % 64);
+  }
+
+  auto const highVector = RankSelectBitVector::Build(high, numHighBits);
+  data.insert(data.end(), highVector.begin(), highVector.end());
+  return data;
+}
+
+// static
+EliasFano EliasFano::Map(void const * data, size_t size)
+{
+  EliasFano ef;
+  ef.Init(ToWords(data, size), size);
+  return ef;
+}
+
+// static
+EliasFano EliasFano::Create(vector<uint64_t> const & values)
+{
+  EliasFano ef;
+  ef.m_storage = Build(values);
+  ef.Init(ef.m_storage.data(), ef.m_storage.size() * sizeof(uint64_t));
+  return ef;
+}
+
+void EliasFano::Init(uint64_t const * data, size_t size)
+{
+  uint64_t const numWords = size / sizeof(uint64_t);
+  if (numWords < kEliasFanoHeaderWords || data[1] >= 64 ||
+      numWords < kEliasFanoHeaderWords + data[2] || DivideRoundUp(data[0] * data[1], 64) != data[2])
+  {
+    MYTHROW(SuccinctException, ("Bad size of Elias-Fano sequence:", size));
+  }
+
+  m_size = data[0];
+  m_numLowBits = data[1];
+  m_low = data + kEliasFanoHeaderWords;
+  uint64_t const highBegin = kEliasFanoHeaderWords + data[2];
+  m_high = RankSelectBitVector::Map(data + highBegin, (numWords - highBegin) * sizeof(uint64_t));
+  if (m_high.NumOnes() != m_size)
+    MYTHROW(SuccinctException, ("Bad high bits of Elias-Fano sequence:", m_high.NumOnes(), m_size));
+
+  m_data = data;
+  m_byteSize = size;
+}
+
+uint64_t EliasFano::LowerBound(uint64_t value) const
+{
+  uint64_t begin = 0;
+  uint64_t end = m_size;
+  while (begin < end)
+  {
+    uint64_t const mid = begin + (end - begin) / 2;
+    if (Get(mid) < value)
+      begin = mid + 1;
+    else
+      end = mid;
+  }
+  return begin;
+}
+}  // namespace coding
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "coding/write_to_sink.hpp"
+
+#include "base/assert.hpp"
+#include "base/bits.hpp"
+#include "base/exception.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace coding
+{
+DECLARE_EXCEPTION(SuccinctException, RootException);
+
+// Bit vector with constant time rank and select.
+//
+// The vector is serialized as an array of 64-bit little-endian words, so it may be used right
+// from a memory mapped section, see Map(). The layout is:
+// [number of bits] [number of set bits] [words of bits]
+// [number of set bits before each block of kBlockBits bits, one more for the end]
+// [block of each kSelectSampleRate-th set bit]
+//
+// Rank counts set bits of at most 8 words after the block sample. Select jumps to the block of
+// the closest sample and scans rank samples forward, the scan is short unless set bits are
+// very sparse, and selects in a word with bits::Select64().
+class RankSelectBitVector
+{
+public:
+  static uint64_t constexpr kBlockBits = 512;
+  static uint64_t constexpr kSelectSampleRate = 512;
+
+  RankSelectBitVector() = default;
+
+  // |bits| are bits in the order of words, the lowest bit of a word goes first.
+  static std::vector<uint64_t> Build(std::vector<uint64_t> const & bits, uint64_t numBits);
+
+  // |data| must be 8-byte aligned and must outlive the vector.
+  // Throws SuccinctException if |size| doesn't match the data.
+  static RankSelectBitVector Map(void const * data, size_t size);
+
+  // Builds a vector which owns its data.
+  static RankSelectBitVector Create(std::vector<uint64_t> const & bits, uint64_t numBits);
+
+  RankSelectBitVector(RankSelectBitVector && rhs) = default;
+  RankSelectBitVector & operator=(RankSelectBitVector && rhs) = default;
+
+  uint64_t Size() const { return m_numBits; }
+  uint64_t NumOnes() const { return m_numOnes; }
+  // Size of the serialized vector in bytes.
+  size_t ByteSize() const { return static_cast<size_t>(m_numWords) * sizeof(uint64_t); }
+
+  bool Get(uint64_t i) const
+  {
+    ASSERT_LESS(i, m_numBits, ());
+    return (m_bits[i / 64] >> (i % 64)) & 1;
+  }
+
+  // Returns the number of set bits in [0, i).
+  uint64_t Rank1(uint64_t i) const;
+
+  // Returns position of the |k|-th (0-based) set bit.
+  uint64_t Select1(uint64_t k) const;
+
+  // Returns the |i|-th word of bits, it's used by sequences over the vector.
+  uint64_t GetWord(uint64_t i) const { return m_bits[i]; }
+
+  template <typename Sink>
+  void Serialize(Sink & sink) const
+  {
+    for (uint64_t i = 0; i < m_numWords; ++i)
+      WriteToSink(sink, m_data[i]);
+  }
+
+private:
+  void Init(uint64_t const * data, uint64_t numWords);
+
+  std::vector<uint64_t> m_storage;
+  uint64_t const * m_data = nullptr;
+  uint64_t m_numWords = 0;
+
+  uint64_t m_numBits = 0;
+  uint64_t m_numOnes = 0;
+  uint64_t const * m_bits = nullptr;
+  uint64_t const * m_ranks = nullptr;
+  uint64_t const * m_selects = nullptr;
+};
+
+// Elias-Fano representation of a non-decreasing sequence of integers: n values of universe u
+// take about n * (2 + log(u / n)) bits and the i-th value is accessed in constant time.
+//
+// Serialized layout, in 64-bit little-endian words:
+// [number of values] [number of low bits] [number of words of low bits] [low bits]
+// [RankSelectBitVector of high bits]
+class EliasFano
+{
+public:
+  EliasFano() = default;
+
+  // |values| must be non-decreasing.
+  static std::vector<uint64_t> Build(std::vector<uint64_t> const & values);
+
+  // |data| must be 8-byte aligned and must outlive the sequence.
+  // Throws SuccinctException if |size| doesn't match the data.
+  static EliasFano Map(void const * data, size_t size);
+
+  static EliasFano Create(std::vector<uint64_t> const & values);
+
+  EliasFano(EliasFano && rhs) = default;
+  EliasFano & operator=(EliasFano && rhs) = default;
+
+  uint64_t Size() const { return m_size; }
+  bool IsEmpty() const { return m_size == 0; }
+  size_t ByteSize() const { return m_byteSize; }
+
+  uint64_t Get(uint64_t i) const
+  {
+    ASSERT_LESS(i, m_size, ());
+    uint64_t const high = m_high.Select1(i) - i;
+    return (high << m_numLowBits) | GetLow(i);
+  }
+
+  // Returns index of the first value which is not less than |value| or Size().
+  uint64_t LowerBound(uint64_t value) const;
+
+  template <typename Sink>
+  void Serialize(Sink & sink) const
+  {
+    for (size_t i = 0; i < m_byteSize / sizeof(uint64_t); ++i)
+      WriteToSink(sink, m_data[i]);
+  }
+
+private:
+  void Init(uint64_t const * data, size_t size);
+
+  uint64_t GetLow(uint64_t i) const
+  {
+    if (m_numLowBits == 0)
+      return 0;
+    uint64_t const bit = i * m_numLowBits;
+    uint64_t const word = bit / 64;
+    uint64_t const shift = bit % 64;
+    uint64_t low = m_low[word] >> shift;
+    if (shift + m_numLowBits > 64)
+      low |= m_low[word + 1] << (64 - shift);
+    return low & bits::GetFullMask(static_cast<uint8_t>(m_numLowBits));
+  }
+
+  std::vector<uint64_t> m_storage;
+  uint64_t const * m_data = nullptr;
+  size_t m_byteSize = 0;
+
+  uint64_t m_size = 0;
+  uint64_t m_numLowBits = 0;
+  uint64_t const * m_low = nullptr;
+  RankSelectBitVector m_high;
+};
+}  // namespace coding
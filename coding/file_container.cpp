@@ -70,12 +70,23 @@ FilesContainerR::FilesContainerR(string const & filePath,
   : m_source(make_unique<FileReader>(filePath, logPageSize, logPageCount))
 {
   ReadInfo(m_source);
+  RegisterCacheRanges();
 }
 
 FilesContainerR::FilesContainerR(TReader const & file)
   : m_source(file)
 {
   ReadInfo(m_source);
+  RegisterCacheRanges();
+}
+
+void FilesContainerR::RegisterCacheRanges()
+{
+  auto reader = dynamic_cast<FileReader *>(m_source.GetPtr());
+  if (!reader)
+    return;
+  for (auto const & info : m_info)
+    reader->RegisterCacheRange(info.m_offset, info.m_size);
 }
 
 FilesContainerR::TReader FilesContainerR::GetReader(Tag const & tag) const
@@ -97,6 +108,15 @@ pair<uint64_t, uint64_t> FilesContainerR::GetAbsoluteOffsetAndSize(Tag const & t
   return make_pair(offset + p->m_offset, p->m_size);
 }
 
+ReaderCacheCounters FilesContainerR::GetCacheCounters(Tag const & tag) const
+{
+  Info const * p = GetInfo(tag);
+  auto reader = dynamic_cast<FileReader const *>(m_source.GetPtr());
+  if (!p || !reader)
+    return {};
+  return reader->GetCacheCounters(p->m_offset, p->m_size);
+}
+
 FilesContainerBase::Info const * FilesContainerBase::GetInfo(Tag const & tag) const
 {
   auto i = lower_bound(m_info.begin(), m_info.end(), tag, LessInfo());
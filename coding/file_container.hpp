@@ -2,9 +2,11 @@
 #include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
 
+#include "std/cstdint.hpp"
 #include "std/vector.hpp"
 #include "std/string.hpp"
 #include "std/noncopyable.hpp"
+#include "std/type_traits.hpp"
 #include "std/utility.hpp"
 
 
@@ -126,7 +128,13 @@ public:
 
   pair<uint64_t, uint64_t> GetAbsoluteOffsetAndSize(Tag const & tag) const;
 
+  /// Returns page cache accesses of all readers of section |tag|. Counters are zero if the
+  /// section doesn't exist or the container isn't read by FileReader.
+  ReaderCacheCounters GetCacheCounters(Tag const & tag) const;
+
 private:
+  void RegisterCacheRanges();
+
   TReader m_source;
 };
 
@@ -226,6 +234,84 @@ private:
   detail::MappedFile m_file;
 };
 
+/// Read-only array of T which is used right from the mapped memory of a section,
+/// without copying. Sections written by FilesContainerW are aligned, so a view
+/// of any T with alignment up to kSectionAlignment is aligned too.
+template <typename T>
+class SectionView
+{
+  static_assert(is_pod<T>::value, "");
+  static_assert(alignof(T) <= FilesContainerBase::kSectionAlignment, "");
+
+public:
+  SectionView() = default;
+
+  /// Throws Reader::SizeException if the size of the mapped data is not a multiple
+  /// of sizeof(T) and Reader::ReadException if the data is not aligned for T.
+  explicit SectionView(FilesMappingContainer::Handle && handle)
+  {
+    if (handle.GetSize() % sizeof(T) != 0)
+    {
+      MYTHROW(Reader::SizeException,
+              ("Size of the section:", handle.GetSize(), "is not a multiple of", sizeof(T)));
+    }
+    if (reinterpret_cast<uintptr_t>(handle.GetData<char>()) % alignof(T) != 0)
+      MYTHROW(Reader::ReadException, ("The section is not aligned for", alignof(T)));
+    m_handle.Assign(move(handle));
+  }
+
+  SectionView(SectionView && rhs) { m_handle.Assign(move(rhs.m_handle)); }
+
+  SectionView & operator=(SectionView && rhs)
+  {
+    m_handle.Assign(move(rhs.m_handle));
+    return *this;
+  }
+
+  static SectionView Map(FilesMappingContainer const & cont, FilesContainerBase::Tag const & tag)
+  {
+    return SectionView(cont.Map(tag));
+  }
+
+  /// Maps the section right from the file of |cont|. Throws Reader::OpenException when
+  /// |cont| is not a plain file, e.g. an mwm inside an apk.
+  static SectionView Map(FilesContainerR const & cont, FilesContainerBase::Tag const & tag)
+  {
+    auto const p = cont.GetAbsoluteOffsetAndSize(tag);
+    detail::MappedFile file;
+    file.Open(cont.GetFileName());
+    // Mapped memory stays valid after the file is closed.
+    return SectionView(file.Map(p.first, p.second, tag));
+  }
+
+  bool IsValid() const { return m_handle.IsValid(); }
+  size_t Size() const { return IsValid() ? m_handle.GetDataCount<T>() : 0; }
+  bool IsEmpty() const { return Size() == 0; }
+
+  T const * Data() const { return m_handle.GetData<T>(); }
+  T const * begin() const { return Data(); }
+  T const * end() const { return Data() + Size(); }
+
+  T const & operator[](size_t i) const
+  {
+    ASSERT_LESS(i, Size(), ());
+    return Data()[i];
+  }
+
+  /// Same as operator[] but throws Reader::SizeException when |i| is out of bounds.
+  T const & At(size_t i) const
+  {
+    if (i >= Size())
+      MYTHROW(Reader::SizeException, ("Index", i, "is out of section of size", Size()));
+    return Data()[i];
+  }
+
+private:
+  FilesMappingContainer::Handle m_handle;
+
+  DISALLOW_COPY(SectionView);
+};
+
 class FilesContainerW : public FilesContainerBase
 {
 public:
@@ -2,6 +2,10 @@
 #include "coding/reader_cache.hpp"
 #include "coding/internal/file_data.hpp"
 
+#include "std/algorithm.hpp"
+#include "std/map.hpp"
+#include "std/utility.hpp"
+
 #ifndef LOG_FILE_READER_STATS
 #define LOG_FILE_READER_STATS 0
 #endif // LOG_FILE_READER_STATS
@@ -30,8 +34,9 @@ namespace
 class FileReader::FileReaderData
 {
 public:
-  FileReaderData(string const & fileName, uint32_t logPageSize, uint32_t logPageCount)
-    : m_FileData(fileName), m_ReaderCache(logPageSize, logPageCount)
+  FileReaderData(string const & fileName, uint32_t logPageSize, uint32_t logPageCount,
+                 uint32_t maxReadaheadPages)
+    : m_FileData(fileName), m_ReaderCache(logPageSize, logPageCount, maxReadaheadPages)
   {
 #if LOG_FILE_READER_STATS
     m_ReadCallCount = 0;
@@ -47,7 +52,7 @@ public:
 
   uint64_t Size() const { return m_FileData.Size(); }
 
-  void Read(uint64_t pos, void * p, size_t size)
+  void Read(uint64_t pos, void * p, size_t size, ReaderCacheCounters * rangeCounters = nullptr)
   {
 #if LOG_FILE_READER_STATS
     if (((++m_ReadCallCount) & LOG_FILE_READER_EVERY_N_READS_MASK) == 0)
@@ -56,22 +61,85 @@ public:
     }
 #endif
 
-    return m_ReaderCache.Read(m_FileData, pos, p, size);
+    return m_ReaderCache.Read(m_FileData, pos, p, size, rangeCounters);
+  }
+
+  ReaderCacheCounters * RegisterRange(uint64_t pos, uint64_t size)
+  {
+    return &m_rangeCounters[make_pair(pos, size)];
+  }
+
+  ReaderCacheCounters * FindRange(uint64_t pos, uint64_t size)
+  {
+    auto const it = m_rangeCounters.find(make_pair(pos, size));
+    return it == m_rangeCounters.end() ? nullptr : &it->second;
+  }
+
+  ReaderCacheCounters const & GetTotalCounters() const { return m_ReaderCache.GetCounters(); }
+
+  void SetMaxReadaheadPages(uint32_t maxReadaheadPages)
+  {
+    m_ReaderCache.SetMaxReadaheadPages(maxReadaheadPages);
+  }
+
+  // Positions of |requests| are absolute.
+  void ReadBatch(vector<Reader::ReadRequest> const & requests,
+                 ReaderCacheCounters * rangeCounters = nullptr)
+  {
+    // Ranges closer than this are hinted as one range.
+    uint64_t const kMaxGap = 4096;
+
+    vector<size_t> order(requests.size());
+    for (size_t i = 0; i < order.size(); ++i)
+      order[i] = i;
+    sort(order.begin(), order.end(), [&requests](size_t lhs, size_t rhs) {
+      return requests[lhs].m_pos < requests[rhs].m_pos;
+    });
+
+    // Lets the OS fetch all the ranges at once, then reads them in the order of the file.
+    uint64_t begin = 0;
+    uint64_t end = 0;
+    for (auto const i : order)
+    {
+      auto const & request = requests[i];
+      if (request.m_size == 0)
+        continue;
+      if (end != 0 && request.m_pos <= end + kMaxGap)
+      {
+        end = max(end, request.m_pos + request.m_size);
+        continue;
+      }
+      if (end != 0)
+        m_FileData.Prefetch(begin, end - begin);
+      begin = request.m_pos;
+      end = request.m_pos + request.m_size;
+    }
+    if (end != 0)
+      m_FileData.Prefetch(begin, end - begin);
+
+    for (auto const i : order)
+      Read(requests[i].m_pos, requests[i].m_data, requests[i].m_size, rangeCounters);
   }
 
 private:
   FileDataWithCachedSize m_FileData;
   ReaderCache<FileDataWithCachedSize, LOG_FILE_READER_STATS> m_ReaderCache;
+  // Absolute offset and size of a registered range -> its counters.
+  map<pair<uint64_t, uint64_t>, ReaderCacheCounters> m_rangeCounters;
 
 #if LOG_FILE_READER_STATS
   uint32_t m_ReadCallCount;
 #endif
 };
 
+// static
+uint32_t constexpr FileReader::kDefaultMaxReadaheadPages;
+
 FileReader::FileReader(string const & fileName, bool withExceptions,
-                       uint32_t logPageSize, uint32_t logPageCount)
+                       uint32_t logPageSize, uint32_t logPageCount, uint32_t maxReadaheadPages)
   : BaseType(fileName)
-  , m_fileData(new FileReaderData(fileName, logPageSize, logPageCount))
+  , m_fileData(new FileReaderData(fileName, logPageSize, logPageCount, maxReadaheadPages))
+  , m_cacheCounters(nullptr)
   , m_offset(0)
   , m_size(m_fileData->Size())
   , m_withExceptions(withExceptions)
@@ -80,10 +148,14 @@ FileReader::FileReader(string const & fileName, bool withExceptions,
 FileReader::FileReader(FileReader const & reader, uint64_t offset, uint64_t size)
   : BaseType(reader.GetName())
   , m_fileData(reader.m_fileData)
+  , m_cacheCounters(m_fileData->FindRange(offset, size))
   , m_offset(offset)
   , m_size(size)
   , m_withExceptions(reader.m_withExceptions)
-{}
+{
+  if (!m_cacheCounters)
+    m_cacheCounters = reader.m_cacheCounters;
+}
 
 uint64_t FileReader::Size() const
 {
@@ -93,7 +165,19 @@ uint64_t FileReader::Size() const
 void FileReader::Read(uint64_t pos, void * p, size_t size) const
 {
   CheckPosAndSize(pos, size);
-  m_fileData->Read(m_offset + pos, p, size);
+  m_fileData->Read(m_offset + pos, p, size, m_cacheCounters);
+}
+
+void FileReader::ReadBatch(vector<ReadRequest> const & requests) const
+{
+  vector<ReadRequest> absolute;
+  absolute.reserve(requests.size());
+  for (auto const & request : requests)
+  {
+    CheckPosAndSize(request.m_pos, request.m_size);
+    absolute.emplace_back(m_offset + request.m_pos, request.m_data, request.m_size);
+  }
+  m_fileData->ReadBatch(absolute, m_cacheCounters);
 }
 
 FileReader FileReader::SubReader(uint64_t pos, uint64_t size) const
@@ -109,6 +193,28 @@ unique_ptr<Reader> FileReader::CreateSubReader(uint64_t pos, uint64_t size) cons
   return unique_ptr<Reader>(new FileReader(*this, m_offset + pos, size));
 }
 
+void FileReader::RegisterCacheRange(uint64_t pos, uint64_t size)
+{
+  CheckPosAndSize(pos, size);
+  m_fileData->RegisterRange(m_offset + pos, size);
+}
+
+ReaderCacheCounters FileReader::GetCacheCounters(uint64_t pos, uint64_t size) const
+{
+  auto const * counters = m_fileData->FindRange(m_offset + pos, size);
+  return counters ? *counters : ReaderCacheCounters();
+}
+
+ReaderCacheCounters FileReader::GetTotalCacheCounters() const
+{
+  return m_fileData->GetTotalCounters();
+}
+
+void FileReader::SetMaxReadaheadPages(uint32_t maxReadaheadPages)
+{
+  m_fileData->SetMaxReadaheadPages(maxReadaheadPages);
+}
+
 bool FileReader::AssertPosAndSize(uint64_t pos, uint64_t size) const
 {
   uint64_t const allSize1 = Size();
@@ -137,4 +243,6 @@ void FileReader::SetOffsetAndSize(uint64_t offset, uint64_t size)
   CheckPosAndSize(offset, size);
   m_offset = offset;
   m_size = size;
+  if (auto * counters = m_fileData->FindRange(offset, size))
+    m_cacheCounters = counters;
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include "coding/reader.hpp"
+#include "coding/reader_cache.hpp"
 #include "base/base.hpp"
 #include "std/shared_ptr.hpp"
 
@@ -14,17 +15,30 @@ public:
   explicit FileReader(string const & fileName,
                       bool withExceptions = false,
                       uint32_t logPageSize = 10,
-                      uint32_t logPageCount = 4);
+                      uint32_t logPageCount = 4,
+                      uint32_t maxReadaheadPages = kDefaultMaxReadaheadPages);
+
+  static uint32_t constexpr kDefaultMaxReadaheadPages = 4;
 
   class FileReaderData;
 
   uint64_t Size() const override;
   void Read(uint64_t pos, void * p, size_t size) const override;
+  void ReadBatch(vector<ReadRequest> const & requests) const override;
   FileReader SubReader(uint64_t pos, uint64_t size) const;
   unique_ptr<Reader> CreateSubReader(uint64_t pos, uint64_t size) const override;
 
   inline uint64_t GetOffset() const { return m_offset; }
 
+  /// Page cache of a file is shared by all its readers. Accesses of the cache are counted for
+  /// the whole file and for ranges registered by RegisterCacheRange(), e.g. mwm sections.
+  /// Readers of a registered range and their subreaders add their accesses to the range.
+  /// Positions of ranges are relative to this reader.
+  void RegisterCacheRange(uint64_t pos, uint64_t size);
+  ReaderCacheCounters GetCacheCounters(uint64_t pos, uint64_t size) const;
+  ReaderCacheCounters GetTotalCacheCounters() const;
+  void SetMaxReadaheadPages(uint32_t maxReadaheadPages);
+
 protected:
   void CheckPosAndSize(uint64_t pos, uint64_t size) const;
 
@@ -37,6 +51,8 @@ private:
   FileReader(FileReader const & reader, uint64_t offset, uint64_t size);
 
   shared_ptr<FileReaderData> m_fileData;
+  // Counters of the registered range which contains this reader, may be null.
+  ReaderCacheCounters * m_cacheCounters;
   uint64_t m_offset;
   uint64_t m_size;
   bool m_withExceptions;
@@ -10,9 +10,12 @@
 #include "std/queue.hpp"
 #include "std/unique_ptr.hpp"
 #include "std/string.hpp"
+#include "std/thread.hpp"
 #include "std/utility.hpp"
 #include "std/vector.hpp"
 
+#include <exception>
+
 template <typename LessT>
 struct Sorter
 {
@@ -24,6 +27,10 @@ struct Sorter
   }
 };
 
+// Sorts items which don't fit into memory. Sorted chunks of |bufferBytes| are spilled to the tmp
+// file on a background thread, so adding of items goes on while the previous chunk is sorted and
+// written, and memory usage is up to twice the buffer. Chunks are merged with buffered sequential
+// reads of every chunk.
 template <
     typename T,                                       // Item type.
     class OutputSinkT = FileWriter,                   // Sink to output into result file.
@@ -59,23 +66,40 @@ public:
   {
     ASSERT(m_pTmpWriter.get(), ());
     FlushToTmpFile();
+    WaitForFlush();
 
     // Write output.
     {
       m_pTmpWriter.reset();
       FileReader reader(m_TmpFileName);
+
+      // Read buffers of all chunks take about as much memory as the sort buffer, but not less
+      // than a page per chunk.
+      size_t const chunksCount = (m_ItemCount + m_BufferCapacity - 1) / m_BufferCapacity;
+      size_t const readBufferCapacity =
+          max(max(size_t(1), size_t(4096) / sizeof(T)), m_BufferCapacity / max(size_t(1), chunksCount));
+
+      vector<ChunkReader> chunks;
+      chunks.reserve(chunksCount);
+      for (uint32_t i = 0; i < m_ItemCount; i += m_BufferCapacity)
+      {
+        uint32_t const end = static_cast<uint32_t>(min(static_cast<uint64_t>(m_ItemCount),
+                                                       static_cast<uint64_t>(i) + m_BufferCapacity));
+        chunks.emplace_back(reader, i, end, readBufferCapacity);
+      }
+
       ItemIndexPairGreater fGreater(m_Less);
       PriorityQueueType q(fGreater);
-      for (uint32_t i = 0; i < m_ItemCount; i += m_BufferCapacity)
-        Push(q, i, reader);
+      for (uint32_t i = 0; i < chunks.size(); ++i)
+        q.push(make_pair(chunks[i].Next(), i));
 
       while (!q.empty())
       {
         m_OutputSink(q.top().first);
-        uint32_t const i = q.top().second + 1;
+        uint32_t const i = q.top().second;
         q.pop();
-        if (i % m_BufferCapacity != 0 && i < m_ItemCount)
-          Push(q, i, reader);
+        if (!chunks[i].IsEmpty())
+          q.push(make_pair(chunks[i].Next(), i));
       }
     }
     FileWriter::DeleteFileX(m_TmpFileName);
@@ -98,6 +122,9 @@ public:
         LOG(LERROR, (e.what()));
       }
     }
+
+    if (m_FlushThread.joinable())
+      m_FlushThread.join();
   }
 
 private:
@@ -114,21 +141,76 @@ private:
   typedef priority_queue<pair<T, uint32_t>, vector<pair<T, uint32_t> >, ItemIndexPairGreater>
       PriorityQueueType;
 
+  // Reads items [begin, end) of the tmp file by blocks.
+  class ChunkReader
+  {
+  public:
+    ChunkReader(FileReader const & reader, uint32_t begin, uint32_t end, size_t bufferCapacity)
+      : m_Reader(reader), m_Next(begin), m_End(end), m_BufferCapacity(bufferCapacity)
+    {
+      ASSERT_LESS(begin, end, ());
+    }
+
+    bool IsEmpty() const { return m_Pos == m_Buffer.size() && m_Next == m_End; }
+
+    T const & Next()
+    {
+      if (m_Pos == m_Buffer.size())
+      {
+        ASSERT_LESS(m_Next, m_End, ());
+        m_Buffer.resize(min(m_BufferCapacity, static_cast<size_t>(m_End - m_Next)));
+        m_Reader.Read(static_cast<uint64_t>(m_Next) * sizeof(T), &m_Buffer[0],
+                      m_Buffer.size() * sizeof(T));
+        m_Next += static_cast<uint32_t>(m_Buffer.size());
+        m_Pos = 0;
+      }
+      return m_Buffer[m_Pos++];
+    }
+
+  private:
+    FileReader const & m_Reader;
+    uint32_t m_Next;
+    uint32_t const m_End;
+    size_t const m_BufferCapacity;
+    vector<T> m_Buffer;
+    size_t m_Pos = 0;
+  };
+
   void FlushToTmpFile()
   {
     if (m_Buffer.empty())
       return;
-    SorterT<LessT> sorter(m_Less);
-    sorter(m_Buffer.begin(), m_Buffer.end());
-    m_pTmpWriter->Write(&m_Buffer[0], m_Buffer.size() * sizeof(T));
-    m_Buffer.clear();
+
+    WaitForFlush();
+    m_FlushBuffer.swap(m_Buffer);
+    m_Buffer.reserve(m_BufferCapacity);
+
+    m_FlushThread = thread([this]()
+    {
+      try
+      {
+        SorterT<LessT> sorter(m_Less);
+        sorter(m_FlushBuffer.begin(), m_FlushBuffer.end());
+        m_pTmpWriter->Write(&m_FlushBuffer[0], m_FlushBuffer.size() * sizeof(T));
+      }
+      catch (...)
+      {
+        m_FlushError = std::current_exception();
+      }
+      m_FlushBuffer.clear();
+    });
   }
 
-  void Push(PriorityQueueType & q, uint32_t i, FileReader const & reader)
+  void WaitForFlush()
   {
-    T item;
-    reader.Read(static_cast<uint64_t>(i) * sizeof(T), &item, sizeof(T));
-    q.push(pair<T, uint32_t>(item, i));
+    if (m_FlushThread.joinable())
+      m_FlushThread.join();
+    if (m_FlushError)
+    {
+      std::exception_ptr error;
+      swap(error, m_FlushError);
+      std::rethrow_exception(error);
+    }
   }
 
   string const m_TmpFileName;
@@ -136,6 +218,10 @@ private:
   OutputSinkT & m_OutputSink;
   unique_ptr<FileWriter> m_pTmpWriter;
   vector<T> m_Buffer;
+  // The chunk which is sorted and written by |m_FlushThread|.
+  vector<T> m_FlushBuffer;
+  thread m_FlushThread;
+  std::exception_ptr m_FlushError;
   uint32_t m_ItemCount;
   LessT m_Less;
 };
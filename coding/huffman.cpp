@@ -2,6 +2,14 @@
 
 #include "base/logging.hpp"
 
+#include "std/limits.hpp"
+
+namespace
+{
+// Max number of bits which are decoded by a single lookup.
+size_t constexpr kMaxTableBits = 11;
+}  // namespace
+
 namespace coding
 {
 HuffmanCoder::~HuffmanCoder()
@@ -46,10 +54,65 @@ void HuffmanCoder::Clear()
 {
   DeleteHuffmanTree(m_root);
   m_root = nullptr;
+  m_table.clear();
+  m_tableBits = 0;
+  m_minCodeLen = 0;
   m_encoderTable.clear();
   m_decoderTable.clear();
 }
 
+void HuffmanCoder::BuildDecodingTable()
+{
+  m_table.clear();
+  m_tableBits = 0;
+  m_minCodeLen = 0;
+  if (!m_root)
+    return;
+
+  size_t minLen = numeric_limits<size_t>::max();
+  size_t maxLen = 0;
+  GetCodeLens(m_root, minLen, maxLen);
+  if (maxLen < minLen)
+    return;
+
+  m_minCodeLen = minLen;
+  m_tableBits = min(maxLen, kMaxTableBits);
+  m_table.assign(static_cast<size_t>(1) << m_tableBits, nullptr);
+  FillDecodingTable(m_root, 0 /* path */);
+}
+
+void HuffmanCoder::FillDecodingTable(Node const * root, uint32_t path)
+{
+  if (!root)
+    return;
+
+  if (root->isLeaf || root->depth == m_tableBits)
+  {
+    for (size_t i = path; i < m_table.size(); i += static_cast<size_t>(1) << root->depth)
+      m_table[i] = root;
+    return;
+  }
+
+  FillDecodingTable(root->l, path);
+  FillDecodingTable(root->r, path + (static_cast<uint32_t>(1) << root->depth));
+}
+
+void HuffmanCoder::GetCodeLens(Node const * root, size_t & minLen, size_t & maxLen) const
+{
+  if (!root)
+    return;
+
+  if (root->isLeaf)
+  {
+    minLen = min(minLen, root->depth);
+    maxLen = max(maxLen, root->depth);
+    return;
+  }
+
+  GetCodeLens(root->l, minLen, maxLen);
+  GetCodeLens(root->r, minLen, maxLen);
+}
+
 void HuffmanCoder::DeleteHuffmanTree(Node * root)
 {
   if (!root)
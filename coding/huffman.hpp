@@ -101,6 +101,7 @@ public:
     Clear();
     BuildHuffmanTree(Freqs(args...));
     BuildTables(m_root, 0);
+    BuildDecodingTable();
   }
 
   void Clear();
@@ -162,6 +163,8 @@ public:
       cur->isLeaf = true;
       cur->symbol = symbol;
     }
+
+    BuildDecodingTable();
   }
 
   bool Encode(uint32_t symbol, Code & code) const;
@@ -195,14 +198,53 @@ public:
     return EncodeAndWrite(writer, s.begin(), s.end());
   }
 
+  // Decodes up to m_tableBits bits at once by a table lookup and walks the tree only for
+  // longer codes. Bytes are read ahead only while they surely contain bits of the remaining
+  // symbols, so |src| is left at the same position as by a bit-by-bit decoding.
   template <typename TSource, typename OutIt>
   OutIt ReadAndDecode(TSource & src, OutIt out) const
   {
-    BitReader<TSource> bitReader(src);
-    size_t sz = static_cast<size_t>(ReadVarUint<uint32_t, TSource>(src));
-    vector<strings::UniChar> v(sz);
+    size_t const sz = static_cast<size_t>(ReadVarUint<uint32_t, TSource>(src));
+    uint64_t const tableMask = (static_cast<uint64_t>(1) << m_tableBits) - 1;
+
+    uint64_t buffer = 0;
+    size_t bufferBits = 0;
+    auto const readByte = [&src, &buffer, &bufferBits]() {
+      uint8_t byte;
+      src.Read(&byte, 1);
+      buffer |= static_cast<uint64_t>(byte) << bufferBits;
+      bufferBits += CHAR_BIT;
+    };
+
     for (size_t i = 0; i < sz; ++i)
-      *out++ = ReadAndDecode(bitReader);
+    {
+      while (bufferBits + CHAR_BIT <= 64 &&
+             static_cast<uint64_t>(sz - i) * m_minCodeLen > bufferBits)
+      {
+        readByte();
+      }
+
+      Node const * cur = m_root;
+      if (bufferBits >= m_tableBits && !m_table.empty())
+      {
+        cur = m_table[static_cast<size_t>(buffer & tableMask)];
+        CHECK(cur, ("Could not decode a Huffman-encoded symbol."));
+        buffer >>= cur->depth;
+        bufferBits -= cur->depth;
+      }
+
+      CHECK(cur, ("Could not decode a Huffman-encoded symbol."));
+      while (!cur->isLeaf)
+      {
+        if (bufferBits == 0)
+          readByte();
+        cur = (buffer & 1) == 0 ? cur->l : cur->r;
+        buffer >>= 1;
+        --bufferBits;
+        CHECK(cur, ("Could not decode a Huffman-encoded symbol."));
+      }
+      *out++ = cur->symbol;
+    }
     return out;
   }
 
@@ -271,28 +313,16 @@ private:
     return sz;
   }
 
-  template <typename TSource>
-  uint32_t ReadAndDecode(BitReader<TSource> & bitReader) const
-  {
-    Node * cur = m_root;
-    while (cur)
-    {
-      if (cur->isLeaf)
-        return cur->symbol;
-      uint8_t bit = bitReader.Read(1);
-      if (bit == 0)
-        cur = cur->l;
-      else
-        cur = cur->r;
-    }
-    CHECK(false, ("Could not decode a Huffman-encoded symbol."));
-    return 0;
-  }
-
   // Converts a Huffman tree into the more convenient representation
   // of encoding and decoding tables.
   void BuildTables(Node * root, uint32_t path);
 
+  // Builds the table of nodes which are reached by all sequences of m_tableBits bits.
+  // Leaves which are closer to the root fill all entries with the prefix of their codes.
+  void BuildDecodingTable();
+  void FillDecodingTable(Node const * root, uint32_t path);
+  void GetCodeLens(Node const * root, size_t & minLen, size_t & maxLen) const;
+
   void DeleteHuffmanTree(Node * root);
 
   void BuildHuffmanTree(Freqs const & freqs);
@@ -302,6 +332,9 @@ private:
   void SetDepths(Node * root, uint32_t depth);
 
   Node * m_root;
+  vector<Node const *> m_table;
+  size_t m_tableBits = 0;
+  size_t m_minCodeLen = 0;
   map<Code, uint32_t> m_decoderTable;
   map<uint32_t, Code> m_encoderTable;
 };
@@ -19,6 +19,10 @@
   #include <io.h>
 #endif
 
+#if defined(OMIM_OS_LINUX) || defined(OMIM_OS_ANDROID)
+  #include <fcntl.h>
+#endif
+
 #ifdef OMIM_OS_TIZEN
 #include "tizen/inc/FIo.hpp"
 #endif
@@ -154,6 +158,18 @@ uint64_t FileData::Pos() const
 #endif
 }
 
+void FileData::Prefetch(uint64_t pos, uint64_t size) const
+{
+#if defined(OMIM_OS_LINUX) || defined(OMIM_OS_ANDROID)
+  // It's only a hint, so errors are ignored.
+  UNUSED_VALUE(posix_fadvise(fileno(m_File), static_cast<off_t>(pos), static_cast<off_t>(size),
+                             POSIX_FADV_WILLNEED));
+#else
+  UNUSED_VALUE(pos);
+  UNUSED_VALUE(size);
+#endif
+}
+
 void FileData::Seek(uint64_t pos)
 {
   ASSERT_NOT_EQUAL(m_Op, OP_APPEND, (m_FileName, m_Op, pos));
@@ -38,6 +38,10 @@ public:
   void Read(uint64_t pos, void * p, size_t size);
   void Write(void const * p, size_t size);
 
+  /// Hints the OS that [pos, pos + size) is going to be read soon, so the OS may start
+  /// reading it in background. Does nothing where it's not supported.
+  void Prefetch(uint64_t pos, uint64_t size) const;
+
   void Flush();
   void Truncate(uint64_t sz);
 
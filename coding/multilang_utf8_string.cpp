@@ -209,6 +209,47 @@ bool StringUtf8Multilang::HasString(int8_t lang) const
   return false;
 }
 
+bool StringUtf8Multilang::GetBestString(vector<int8_t> const & priorityList, int8_t & lang,
+                                        string & utf8s) const
+{
+  size_t const kNoRank = priorityList.size();
+
+  // Ranks of all language codes, as the code takes 6 bits.
+  array<size_t, kMaxSupportedLanguages> ranks;
+  ranks.fill(kNoRank);
+  for (size_t i = priorityList.size(); i != 0; --i)
+  {
+    int8_t const code = priorityList[i - 1];
+    if (code >= 0 && code < kMaxSupportedLanguages)
+      ranks[code] = i - 1;
+  }
+
+  size_t bestRank = kNoRank;
+  size_t bestBegin = 0;
+  size_t bestEnd = 0;
+
+  size_t const sz = m_s.size();
+  for (size_t i = 0; i < sz && bestRank != 0;)
+  {
+    size_t const next = GetNextIndex(i);
+    size_t const rank = ranks[m_s[i] & 0x3F];
+    if (rank < bestRank)
+    {
+      bestRank = rank;
+      bestBegin = i + 1;
+      bestEnd = next;
+    }
+    i = next;
+  }
+
+  if (bestRank == kNoRank)
+    return false;
+
+  lang = priorityList[bestRank];
+  utf8s.assign(m_s.c_str() + bestBegin, bestEnd - bestBegin);
+  return true;
+}
+
 namespace
 {
 
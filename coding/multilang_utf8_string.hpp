@@ -8,6 +8,7 @@
 
 #include "std/array.hpp"
 #include "std/string.hpp"
+#include "std/vector.hpp"
 
 namespace utils
 {
@@ -115,6 +116,11 @@ public:
 
   bool HasString(int8_t lang) const;
 
+  /// Finds the string of the first language of |priorityList| which is present, in a
+  /// single pass over the buffer, so callers don't have to call GetString() per language.
+  /// @returns false if there are no strings of |priorityList| languages.
+  bool GetBestString(vector<int8_t> const & priorityList, int8_t & lang, string & utf8s) const;
+
   int8_t FindString(string const & utf8s) const;
 
   template <class TSink>
@@ -11,6 +11,12 @@ void Reader::ReadAsString(string & s) const
   Read(0, &s[0], sz);
 }
 
+void Reader::ReadBatch(vector<ReadRequest> const & requests) const
+{
+  for (auto const & request : requests)
+    Read(request.m_pos, request.m_data, request.m_size);
+}
+
 bool Reader::IsEqual(string const & name1, string const & name2)
 {
 #if defined(OMIM_OS_WINDOWS)
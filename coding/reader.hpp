@@ -21,11 +21,25 @@ public:
   DECLARE_EXCEPTION(ReadException, Exception);
   DECLARE_EXCEPTION(TooManyFilesException, Exception);
 
+  struct ReadRequest
+  {
+    ReadRequest(uint64_t pos, void * data, size_t size) : m_pos(pos), m_data(data), m_size(size) {}
+
+    uint64_t m_pos;
+    void * m_data;
+    size_t m_size;
+  };
+
   virtual ~Reader() {}
   virtual uint64_t Size() const = 0;
   virtual void Read(uint64_t pos, void * p, size_t size) const = 0;
   virtual unique_ptr<Reader> CreateSubReader(uint64_t pos, uint64_t size) const = 0;
 
+  /// Reads all |requests|. Readers of files may reorder the reads and ask the OS to fetch
+  /// all the ranges in advance, which is much faster than a sequence of Read() calls
+  /// for scattered ranges on slow storage. The default implementation calls Read().
+  virtual void ReadBatch(vector<ReadRequest> const & requests) const;
+
   void ReadAsString(string & s) const;
 
   static bool IsEqual(string const & name1, string const & name2);
@@ -117,6 +131,11 @@ public:
     m_p->Read(pos, p, size);
   }
 
+  void ReadBatch(vector<Reader::ReadRequest> const & requests) const
+  {
+    m_p->ReadBatch(requests);
+  }
+
   void ReadAsString(string & s) const
   {
     m_p->ReadAsString(s);
@@ -5,10 +5,37 @@
 #include "base/stats.hpp"
 
 #include "std/algorithm.hpp"
+#include "std/cstdint.hpp"
 #include "std/cstring.hpp"
 #include "std/sstream.hpp"
+#include "std/string.hpp"
 #include "std/vector.hpp"
 
+// Page accesses of a ReaderCache. Unlike the compile-time stats below they are always collected.
+struct ReaderCacheCounters
+{
+  ReaderCacheCounters & operator+=(ReaderCacheCounters const & rhs)
+  {
+    m_hits += rhs.m_hits;
+    m_misses += rhs.m_misses;
+    m_readaheadPages += rhs.m_readaheadPages;
+    return *this;
+  }
+
+  uint64_t m_hits = 0;
+  uint64_t m_misses = 0;
+  // Pages which were read in advance by sequential access detection.
+  uint64_t m_readaheadPages = 0;
+};
+
+inline string DebugPrint(ReaderCacheCounters const & counters)
+{
+  ostringstream out;
+  out << "ReaderCacheCounters [ hits: " << counters.m_hits << ", misses: " << counters.m_misses
+      << ", readahead pages: " << counters.m_readaheadPages << " ]";
+  return out.str();
+}
+
 
 namespace impl
 {
@@ -42,16 +69,22 @@ template <> struct ReaderCacheStats<true>
 
 }
 
+// Page cache over |reader|. When reads go one after another the cache reads next pages with
+// the same call to |reader|, the number of read in advance pages doubles with every next page
+// up to |maxReadaheadPages| and drops to zero on a random access.
 template <class ReaderT, bool bStats = false>
 class ReaderCache
 {
 public:
-  ReaderCache(uint32_t logPageSize, uint32_t logPageCount)
+  ReaderCache(uint32_t logPageSize, uint32_t logPageCount, uint32_t maxReadaheadPages = 0)
     : m_Cache(logPageCount), m_LogPageSize(logPageSize)
   {
+    SetMaxReadaheadPages(maxReadaheadPages);
   }
 
-  void Read(ReaderT & reader, uint64_t pos, void * p, size_t size)
+  /// Accesses of pages are added to |rangeCounters| too if it is not null.
+  void Read(ReaderT & reader, uint64_t pos, void * p, size_t size,
+            ReaderCacheCounters * rangeCounters = nullptr)
   {
     if (size == 0)
       return;
@@ -59,10 +92,11 @@ public:
     m_Stats.m_ReadSize(static_cast<uint32_t>(size));
     char * pDst = static_cast<char *>(p);
     uint64_t pageNum = pos >> m_LogPageSize;
+    UpdateAccessPattern(pageNum, (pos + size - 1) >> m_LogPageSize);
     size_t const firstPageOffset = static_cast<size_t>(pos - (pageNum << m_LogPageSize));
     size_t const firstCopySize = min(size, PageSize() - firstPageOffset);
     ASSERT_GREATER(firstCopySize, 0, ());
-    memcpy(pDst, ReadPage(reader, pageNum) + firstPageOffset, firstCopySize);
+    memcpy(pDst, ReadPage(reader, pageNum, rangeCounters) + firstPageOffset, firstCopySize);
     size -= firstCopySize;
     pos += firstCopySize;
     pDst += firstCopySize;
@@ -70,7 +104,7 @@ public:
     while (size > 0)
     {
       size_t const copySize = min(size, PageSize());
-      memcpy(pDst, ReadPage(reader, pageNum), copySize);
+      memcpy(pDst, ReadPage(reader, pageNum, rangeCounters), copySize);
       size -= copySize;
       pos += copySize;
       pDst += copySize;
@@ -78,6 +112,15 @@ public:
     }
   }
 
+  /// Readahead never takes more than a half of the cache, zero disables it.
+  void SetMaxReadaheadPages(uint32_t maxReadaheadPages)
+  {
+    m_MaxReadaheadPages = min(maxReadaheadPages, m_Cache.GetCacheSize() / 2);
+    m_ReadaheadPages = 0;
+  }
+
+  ReaderCacheCounters const & GetCounters() const { return m_Counters; }
+
   string GetStatsStr() const
   {
     return m_Stats.GetStatsStr(m_LogPageSize, m_Cache.GetCacheSize());
@@ -86,22 +129,83 @@ public:
 private:
   inline size_t PageSize() const { return 1 << m_LogPageSize; }
 
-  inline char const * ReadPage(ReaderT & reader, uint64_t pageNum)
+  // A read is sequential if it starts on the last page of the previous read or on the next one.
+  void UpdateAccessPattern(uint64_t firstPage, uint64_t lastPage)
+  {
+    bool const sequential =
+        m_HasLastPage && (firstPage == m_LastPage || firstPage == m_LastPage + 1);
+    if (!sequential)
+      m_ReadaheadPages = 0;
+    else if (lastPage > m_LastPage)
+      m_ReadaheadPages = min(m_MaxReadaheadPages, max(1U, m_ReadaheadPages * 2));
+    m_LastPage = lastPage;
+    m_HasLastPage = true;
+  }
+
+  inline char const * ReadPage(ReaderT & reader, uint64_t pageNum,
+                               ReaderCacheCounters * rangeCounters)
   {
     bool cached;
-    vector<char> & v = m_Cache.Find(pageNum, cached);
+    vector<char> * v = &m_Cache.Find(pageNum, cached);
     m_Stats.m_CacheHit(cached ? 1 : 0);
-    if (!cached)
+    ReaderCacheCounters counters;
+    if (cached)
+    {
+      counters.m_hits = 1;
+    }
+    else
     {
-      if (v.empty())
-        v.resize(PageSize());
+      counters.m_misses = 1;
       uint64_t const pos = pageNum << m_LogPageSize;
-      reader.Read(pos, &v[0], min(PageSize(), static_cast<size_t>(reader.Size() - pos)));
+      uint64_t const readerSize = reader.Size();
+      uint64_t const numPages = (readerSize + PageSize() - 1) >> m_LogPageSize;
+      uint64_t const readahead =
+          min(static_cast<uint64_t>(m_ReadaheadPages), numPages - pageNum - 1);
+      size_t const readSize = static_cast<size_t>(
+          min(static_cast<uint64_t>(PageSize()) * (readahead + 1), readerSize - pos));
+      if (readahead == 0)
+      {
+        if (v->empty())
+          v->resize(PageSize());
+        reader.Read(pos, &(*v)[0], readSize);
+      }
+      else
+      {
+        m_ReadaheadBuffer.resize(readSize);
+        reader.Read(pos, m_ReadaheadBuffer.data(), readSize);
+        for (uint64_t i = 1; i <= readahead; ++i)
+        {
+          bool found;
+          vector<char> & page = m_Cache.Find(pageNum + i, found);
+          if (found)
+            continue;
+          size_t const offset = static_cast<size_t>(i << m_LogPageSize);
+          page.resize(PageSize());
+          memcpy(&page[0], &m_ReadaheadBuffer[offset], min(PageSize(), readSize - offset));
+          ++counters.m_readaheadPages;
+        }
+        // Next pages may have evicted |pageNum|, so it's put to the cache after them.
+        bool found;
+        v = &m_Cache.Find(pageNum, found);
+        v->resize(PageSize());
+        memcpy(&(*v)[0], m_ReadaheadBuffer.data(), min(PageSize(), readSize));
+      }
     }
-    return &v[0];
+
+    m_Counters += counters;
+    if (rangeCounters)
+      *rangeCounters += counters;
+    return &(*v)[0];
   }
 
   my::Cache<uint64_t, vector<char> > m_Cache;
   uint32_t const m_LogPageSize;
   impl::ReaderCacheStats<bStats> m_Stats;
+
+  uint32_t m_MaxReadaheadPages = 0;
+  uint32_t m_ReadaheadPages = 0;
+  uint64_t m_LastPage = 0;
+  bool m_HasLastPage = false;
+  vector<char> m_ReadaheadBuffer;
+  ReaderCacheCounters m_Counters;
 };
@@ -255,7 +255,9 @@ public:
         CHECK_GREATER_OR_EQUAL(sub.m_offset + sub.m_length, sub.m_offset, ());
         offset += sub.m_length;
       }
-      BWTCoder::ReadAndDecodeBlock(source, std::back_inserter(entry.m_value));
+      entry.m_value.reserve(offset);
+      BWTCoder::ReadAndDecodeBlock(source, m_bwtBuffer, m_revBuffer,
+                                   std::back_inserter(entry.m_value));
       entry.m_valid = true;
     }
     ASSERT(entry.m_valid, ());
@@ -293,6 +295,9 @@ private:
 
   BlockedTextStorageIndex m_index;
   std::vector<CacheEntry> m_cache;
+  // Buffers which are reused for decoding of blocks.
+  std::vector<uint8_t> m_bwtBuffer;
+  std::vector<uint8_t> m_revBuffer;
   bool m_initialized = false;
 };
 
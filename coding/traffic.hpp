@@ -53,6 +53,13 @@ public:
   // Version 0:
   //   Coordinates are truncated and stored as integers. All integers
   //   are written as varints.
+  // Version 1:
+  //   The same as Version 0 with traffic added to every point.
+  // Version 2:
+  //   Coordinates are truncated to a grid of kCoordBits bits and all points except
+  //   the first one store signed (zigzag) deltas of the grid coordinates instead of
+  //   truncated deltas of degrees, so a coordinate of a point of a track usually takes
+  //   one or two bytes instead of five, and truncation errors are not accumulated.
   template <typename Writer, typename Collection>
   static size_t SerializeDataPoints(uint32_t version, Writer & writer, Collection const & points)
   {
@@ -60,6 +67,7 @@ public:
     {
     case 0: return SerializeDataPointsV0(writer, points);
     case 1: return SerializeDataPointsV1(writer, points);
+    case 2: return SerializeDataPointsV2(writer, points);
 
     default: ASSERT(false, ("Unexpected serializer version:", version)); break;
     }
@@ -74,6 +82,7 @@ public:
     {
     case 0: return DeserializeDataPointsV0(src, result);
     case 1: return DeserializeDataPointsV1(src, result);
+    case 2: return DeserializeDataPointsV2(src, result);
 
     default: ASSERT(false, ("Unexpected serializer version:", version)); break;
     }
@@ -158,6 +167,45 @@ private:
     return static_cast<size_t>(writer.Pos() - startPos);
   }
 
+  template <typename Writer, typename Collection>
+  static size_t SerializeDataPointsV2(Writer & writer, Collection const & points)
+  {
+    auto const startPos = writer.Pos();
+
+    uint64_t lastTimestamp = 0;
+    int64_t lastLat = 0;
+    int64_t lastLon = 0;
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      int64_t const lat = DoubleToUint32(points[i].m_latLon.lat, ms::LatLon::kMinLat,
+                                         ms::LatLon::kMaxLat, kCoordBits);
+      int64_t const lon = DoubleToUint32(points[i].m_latLon.lon, ms::LatLon::kMinLon,
+                                         ms::LatLon::kMaxLon, kCoordBits);
+      if (i == 0)
+      {
+        WriteVarUint(writer, points[i].m_timestamp);
+        WriteVarUint(writer, static_cast<uint32_t>(lat));
+        WriteVarUint(writer, static_cast<uint32_t>(lon));
+      }
+      else
+      {
+        ASSERT_LESS_OR_EQUAL(lastTimestamp, points[i].m_timestamp, ());
+        WriteVarUint(writer, points[i].m_timestamp - lastTimestamp);
+        WriteVarInt(writer, lat - lastLat);
+        WriteVarInt(writer, lon - lastLon);
+      }
+      WriteVarUint(writer, static_cast<uint32_t>(points[i].m_traffic));
+
+      lastTimestamp = points[i].m_timestamp;
+      lastLat = lat;
+      lastLon = lon;
+    }
+
+    ASSERT_LESS_OR_EQUAL(writer.Pos() - startPos, numeric_limits<size_t>::max(),
+                         ("Too much data."));
+    return static_cast<size_t>(writer.Pos() - startPos);
+  }
+
   template <typename Source, typename Collection>
   static void DeserializeDataPointsV0(Source & src, Collection & result)
   {
@@ -225,5 +273,38 @@ private:
       }
     }
   }
+
+  template <typename Source, typename Collection>
+  static void DeserializeDataPointsV2(Source & src, Collection & result)
+  {
+    bool first = true;
+    uint64_t lastTimestamp = 0;
+    int64_t lastLat = 0;
+    int64_t lastLon = 0;
+
+    while (src.Size() > 0)
+    {
+      if (first)
+      {
+        lastTimestamp = ReadVarUint<uint64_t>(src);
+        lastLat = ReadVarUint<uint32_t>(src);
+        lastLon = ReadVarUint<uint32_t>(src);
+        first = false;
+      }
+      else
+      {
+        lastTimestamp += ReadVarUint<uint64_t>(src);
+        lastLat += ReadVarInt<int64_t>(src);
+        lastLon += ReadVarInt<int64_t>(src);
+      }
+      auto const traffic = base::asserted_cast<uint8_t>(ReadVarUint<uint32_t>(src));
+
+      double const lat = Uint32ToDouble(static_cast<uint32_t>(lastLat), ms::LatLon::kMinLat,
+                                        ms::LatLon::kMaxLat, kCoordBits);
+      double const lon = Uint32ToDouble(static_cast<uint32_t>(lastLon), ms::LatLon::kMinLon,
+                                        ms::LatLon::kMaxLon, kCoordBits);
+      result.emplace_back(lastTimestamp, ms::LatLon(lat, lon), traffic);
+    }
+  }
 };
 }  // namespace coding
@@ -74,6 +74,8 @@ public:
 
   bool IsEqual(string const & fName) const { return m_Reader.IsEqual(fName); }
 
+  ReaderT const & GetReader() const { return m_Reader; }
+
 protected:
   ReaderT m_Reader;
   uint64_t m_ReaderSize;
@@ -8,6 +8,7 @@
 #include "base/exception.hpp"
 #include "base/stl_add.hpp"
 
+#include "std/cstring.hpp"
 #include "std/string.hpp"
 #include "std/type_traits.hpp"
 
@@ -193,7 +194,13 @@ public:
     ASSERT_LESS_OR_EQUAL(reinterpret_cast<uintptr_t>(p), reinterpret_cast<uintptr_t>(m_pEnd), ());
     return p < m_pEnd;
   }
+  // Returns true if the next 8 bytes may be read at once.
+  bool CanReadWord(void const * p) const
+  {
+    return static_cast<uint8_t const *>(m_pEnd) - static_cast<uint8_t const *>(p) >= 8;
+  }
   void NextVarInt() {}
+  void NextVarInts(size_t) {}
 private:
   void const * m_pEnd;
 };
@@ -203,7 +210,10 @@ class ReadVarInt64ArrayGivenSize
 public:
   explicit ReadVarInt64ArrayGivenSize(size_t const count) : m_Remaining(count) {}
   bool Continue(void const *) const { return m_Remaining > 0; }
+  // Every remaining varint takes at least one byte.
+  bool CanReadWord(void const *) const { return m_Remaining >= 8; }
   void NextVarInt() { --m_Remaining; }
+  void NextVarInts(size_t count) { m_Remaining -= count; }
 private:
   size_t m_Remaining;
 };
@@ -220,6 +230,21 @@ inline void const * ReadVarInt64Array(void const * pBeg, WhileConditionT whileCo
   uint8_t const * p = pBegChar;
   while (whileCondition.Continue(p))
   {
+    // Deltas are mostly small, so check whether the next 8 varints are one byte each.
+    if (count32 == 0 && count64 == 0 && whileCondition.CanReadWord(p))
+    {
+      uint64_t word;
+      memcpy(&word, p, sizeof(word));
+      if ((word & 0x8080808080808080ULL) == 0)
+      {
+        for (size_t i = 0; i < 8; ++i)
+          f(converter(static_cast<uint64_t>(p[i])));
+        whileCondition.NextVarInts(8);
+        p += 8;
+        continue;
+      }
+    }
+
     uint8_t const t = *p++;
     res32 += (static_cast<uint32_t>(t & 127) << count32);
     count32 += 7;
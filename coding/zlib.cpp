@@ -20,6 +20,11 @@ int ToInt(ZLib::Deflate::Level level)
   case Level::DefaultCompression: return Z_DEFAULT_COMPRESSION;
   }
 }
+
+unsigned char const * ToBytes(string const & s)
+{
+  return reinterpret_cast<unsigned char const *>(s.data());
+}
 }  // namespace
 
 // ZLib::Processor ---------------------------------------------------------------------------------
@@ -55,7 +60,8 @@ bool ZLib::Processor::BufferIsFull() const
 
 // ZLib::Deflate -----------------------------------------------------------------------------------
 ZLib::DeflateProcessor::DeflateProcessor(Deflate::Format format, Deflate::Level level,
-                                         void const * data, size_t size) noexcept
+                                         void const * data, size_t size,
+                                         string const & dictionary) noexcept
   : Processor(data, size)
 {
   auto bits = MAX_WBITS;
@@ -69,6 +75,13 @@ ZLib::DeflateProcessor::DeflateProcessor(Deflate::Format format, Deflate::Level
       deflateInit2(&m_stream, ToInt(level) /* level */, Z_DEFLATED /* method */,
                    bits /* windowBits */, 8 /* memLevel */, Z_DEFAULT_STRATEGY /* strategy */);
   m_init = (ret == Z_OK);
+  if (m_init && !dictionary.empty())
+  {
+    m_init = deflateSetDictionary(&m_stream, ToBytes(dictionary),
+                                  static_cast<unsigned int>(dictionary.size())) == Z_OK;
+    if (!m_init)
+      deflateEnd(&m_stream);
+  }
 }
 
 ZLib::DeflateProcessor::~DeflateProcessor() noexcept
@@ -85,8 +98,8 @@ int ZLib::DeflateProcessor::Process(int flush)
 
 // ZLib::Inflate -----------------------------------------------------------------------------------
 ZLib::InflateProcessor::InflateProcessor(Inflate::Format format, void const * data,
-                                         size_t size) noexcept
-  : Processor(data, size)
+                                         size_t size, string const & dictionary) noexcept
+  : Processor(data, size), m_dictionary(dictionary)
 {
   auto bits = MAX_WBITS;
   switch (format)
@@ -108,6 +121,14 @@ ZLib::InflateProcessor::~InflateProcessor() noexcept
 int ZLib::InflateProcessor::Process(int flush)
 {
   ASSERT(IsInit(), ());
+  int const ret = inflate(&m_stream, flush);
+  if (ret != Z_NEED_DICT || m_dictionary.empty())
+    return ret;
+
+  int const setRet = inflateSetDictionary(&m_stream, ToBytes(m_dictionary),
+                                          static_cast<unsigned int>(m_dictionary.size()));
+  if (setRet != Z_OK)
+    return setRet;
   return inflate(&m_stream, flush);
 }
 }  // namespace coding
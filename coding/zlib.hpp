@@ -30,13 +30,17 @@ public:
     };
 
     explicit Inflate(Format format) noexcept : m_format(format) {}
+    // |dictionary| must be the same as the one passed to Deflate.
+    Inflate(Format format, string const & dictionary) : m_format(format), m_dictionary(dictionary)
+    {
+    }
 
     template <typename OutIt>
     bool operator()(void const * data, size_t size, OutIt out) const
     {
       if (data == nullptr)
         return false;
-      InflateProcessor processor(m_format, data, size);
+      InflateProcessor processor(m_format, data, size, m_dictionary);
       return Process(processor, out);
     }
 
@@ -48,6 +52,7 @@ public:
 
   private:
     Format const m_format;
+    string const m_dictionary;
   };
 
   class Deflate
@@ -68,13 +73,20 @@ public:
     };
 
     Deflate(Format format, Level level) noexcept : m_format(format), m_level(level) {}
+    // Preset |dictionary| improves compression of small data which has a lot in common with
+    // the dictionary, e.g. data of the same structure. It is supported by the ZLib format only.
+    Deflate(Format format, Level level, string const & dictionary)
+      : m_format(format), m_level(level), m_dictionary(dictionary)
+    {
+      ASSERT(m_dictionary.empty() || m_format == Format::ZLib, ());
+    }
 
     template <typename OutIt>
     bool operator()(void const * data, size_t size, OutIt out) const
     {
       if (data == nullptr)
         return false;
-      DeflateProcessor processor(m_format, m_level, data, size);
+      DeflateProcessor processor(m_format, m_level, data, size, m_dictionary);
       return Process(processor, out);
     }
 
@@ -87,6 +99,7 @@ public:
   private:
     Format const m_format;
     Level const m_level;
+    string const m_dictionary;
   };
 
 private:
@@ -123,7 +136,7 @@ private:
   {
   public:
     DeflateProcessor(Deflate::Format format, Deflate::Level level, void const * data,
-                     size_t size) noexcept;
+                     size_t size, string const & dictionary) noexcept;
     virtual ~DeflateProcessor() noexcept override;
 
     int Process(int flush);
@@ -134,11 +147,15 @@ private:
   class InflateProcessor final : public Processor
   {
   public:
-    InflateProcessor(Inflate::Format format, void const * data, size_t size) noexcept;
+    InflateProcessor(Inflate::Format format, void const * data, size_t size,
+                     string const & dictionary) noexcept;
     virtual ~InflateProcessor() noexcept override;
 
     int Process(int flush);
 
+  private:
+    string const & m_dictionary;
+
     DISALLOW_COPY_AND_MOVE(InflateProcessor);
   };
 
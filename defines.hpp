@@ -6,6 +6,7 @@
 #define DIFF_APPLYING_FILE_EXTENSION ".diff.applying"
 #define FONT_FILE_EXTENSION ".ttf"
 #define OSM2FEATURE_FILE_EXTENSION ".osm2ft"
+#define SECTIONS_MANIFEST_FILE_EXTENSION ".sections"
 #define EXTENSION_TMP ".tmp"
 #define ADDR_FILE_EXTENSION ".addr"
 #define RAW_GEOM_FILE_EXTENSION ".rawgeom"
@@ -24,6 +25,8 @@
 #define INDEX_FILE_TAG "idx"
 #define SEARCH_INDEX_FILE_TAG "sdx"
 #define SEARCH_ADDRESS_FILE_TAG "addr"
+#define SEARCH_STREETS_HOUSES_FILE_TAG "streets_houses"
+#define SEARCH_CATEGORY_BITMAPS_FILE_TAG "category_bitmaps"
 #define CITIES_BOUNDARIES_FILE_TAG "cities_boundaries"
 #define HEADER_FILE_TAG "header"
 #define VERSION_FILE_TAG "version"
@@ -34,6 +37,8 @@
 #define RESTRICTIONS_FILE_TAG "restrictions"
 #define ROUTING_FILE_TAG "routing"
 #define CROSS_MWM_FILE_TAG "cross_mwm"
+#define SHORTCUT_OVERLAY_FILE_TAG "shortcut_overlay"
+#define SPEED_PROFILES_FILE_TAG "speed_profiles"
 #define FEATURE_OFFSETS_FILE_TAG "offs"
 #define RANKS_FILE_TAG "ranks"
 #define REGION_INFO_FILE_TAG "rgninfo"
@@ -57,6 +62,7 @@
 #define RESUME_FILE_EXTENSION ".resume"
 #define DOWNLOADING_FILE_EXTENSION ".downloading"
 #define BOOKMARKS_FILE_EXTENSION ".kml"
+#define BOOKMARKS_CACHE_FILE_EXTENSION ".kmb"
 #define ROUTING_FILE_EXTENSION ".routing"
 #define NOROUTING_FILE_EXTENSION ".norouting"
 #define TRANSIT_FILE_EXTENSION ".transit.json"
@@ -78,6 +84,8 @@
 
 #define SEARCH_CATEGORIES_FILE_NAME "categories.txt"
 
+#define CLASSIFICATOR_CACHE_FILE "classificator.bin"
+
 #define PACKED_POLYGONS_INFO_TAG "info"
 #define PACKED_POLYGONS_FILE "packed_polygons.bin"
 #define PACKED_POLYGONS_OBSOLETE_FILE "packed_polygons_obsolete.bin"
@@ -16,6 +16,8 @@ struct BindingDecl
   glConst m_componentType;
   uint8_t m_stride;
   uint8_t m_offset;
+  // Integer components are mapped to [0, 1] for unsigned and to [-1, 1] for signed types.
+  bool m_needNormalize = false;
 
   bool operator != (BindingDecl const & other) const;
   bool operator < (BindingDecl const & other) const;
@@ -42,15 +44,35 @@ protected:
   uint16_t m_info;
 };
 
+template <typename TFieldType>
+glConst GetComponentType()
+{
+  return gl_const::GLFloatType;
+}
+
+template <>
+inline glConst GetComponentType<glsl::u16vec2>()
+{
+  return gl_const::GLUnsignedShortType;
+}
+
+template <>
+inline glConst GetComponentType<glsl::i16vec4>()
+{
+  return gl_const::GLShortType;
+}
+
 template <typename TFieldType, typename TVertexType>
-uint8_t FillDecl(size_t index, string const & attrName, dp::BindingInfo & info, uint8_t offset)
+uint8_t FillDecl(size_t index, string const & attrName, dp::BindingInfo & info, uint8_t offset,
+                 bool needNormalize = false)
 {
   dp::BindingDecl & decl = info.GetBindingDecl(index);
   decl.m_attributeName = attrName;
   decl.m_componentCount = glsl::GetComponentCount<TFieldType>();
-  decl.m_componentType = gl_const::GLFloatType;
+  decl.m_componentType = GetComponentType<TFieldType>();
   decl.m_offset = offset;
   decl.m_stride = sizeof(TVertexType);
+  decl.m_needNormalize = needNormalize;
 
   return sizeof(TFieldType);
 }
@@ -65,9 +87,10 @@ public:
   }
 
   template<typename TFieldType>
-  void FillDecl(string const & attrName)
+  void FillDecl(string const & attrName, bool needNormalize = false)
   {
-    m_offset += dp::FillDecl<TFieldType, TVertex>(m_index, attrName, m_info, m_offset);
+    m_offset += dp::FillDecl<TFieldType, TVertex>(m_index, attrName, m_info, m_offset,
+                                                  needNormalize);
     ++m_index;
   }
 
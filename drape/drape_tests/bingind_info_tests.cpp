@@ -29,3 +29,44 @@ UNIT_TEST(DynamicHandlingTest)
     TEST_EQUAL(info.IsDynamic(), true, ());
   }
 }
+
+UNIT_TEST(CompactBindingTest)
+{
+  struct Vertex
+  {
+    glsl::vec3 m_position;
+    glsl::u16vec2 m_texCoord;
+    glsl::i16vec4 m_normal;
+  };
+
+  BindingFiller<Vertex> filler(3);
+  filler.FillDecl<glsl::vec3>("a_position");
+  filler.FillDecl<glsl::u16vec2>("a_texCoord", true /* needNormalize */);
+  filler.FillDecl<glsl::i16vec4>("a_normal", true /* needNormalize */);
+
+  BindingInfo const & info = filler.m_info;
+  TEST_EQUAL(info.GetElementSize(), 24, ());
+
+  BindingDecl const & texCoord = info.GetBindingDecl(1);
+  TEST_EQUAL(texCoord.m_componentType, gl_const::GLUnsignedShortType, ());
+  TEST_EQUAL(texCoord.m_offset, 12, ());
+  TEST(texCoord.m_needNormalize, ());
+
+  BindingDecl const & normal = info.GetBindingDecl(2);
+  TEST_EQUAL(normal.m_componentType, gl_const::GLShortType, ());
+  TEST_EQUAL(normal.m_componentCount, 4, ());
+  TEST_EQUAL(normal.m_offset, 16, ());
+  TEST(!info.GetBindingDecl(0).m_needNormalize, ());
+}
+
+UNIT_TEST(QuantizationTest)
+{
+  glsl::u16vec2 const uv = glsl::ToUnorm16(glsl::vec2(0.5f, 2.0f));
+  TEST_EQUAL(uv.x, 32768, ());
+  TEST_EQUAL(uv.y, 65535, ());
+
+  glsl::i16vec4 const normal = glsl::ToSnorm16(glsl::vec3(0.0f, -1.0f, 1.0f));
+  TEST_EQUAL(normal.x, 0, ());
+  TEST_EQUAL(normal.y, -32767, ());
+  TEST_EQUAL(normal.z, 32767, ());
+}
@@ -4,6 +4,7 @@
 #include "base/assert.hpp"
 
 #include "std/string.hpp"
+#include "std/vector.hpp"
 
 using namespace emul;
 
@@ -95,6 +96,23 @@ bool GLFunctions::glLinkProgram(uint32_t programID, string & errorLog)
   return MOCK_CALL(glLinkProgram(programID, errorLog));
 }
 
+bool GLFunctions::IsProgramBinarySupported()
+{
+  return MOCK_CALL(IsProgramBinarySupported());
+}
+
+bool GLFunctions::glGetProgramBinary(uint32_t programID, vector<uint8_t> & binary,
+                                     glConst & format)
+{
+  return MOCK_CALL(glGetProgramBinary(programID, binary, format));
+}
+
+bool GLFunctions::glProgramBinary(uint32_t programID, glConst format,
+                                  vector<uint8_t> const & binary)
+{
+  return MOCK_CALL(glProgramBinary(programID, format, binary));
+}
+
 void GLFunctions::glDeleteProgram(uint32_t programID)
 {
   MOCK_CALL(glDeleteProgram(programID));
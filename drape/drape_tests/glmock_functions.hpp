@@ -2,6 +2,7 @@
 
 #include "drape/glconstants.hpp"
 #include "std/string.hpp"
+#include "std/vector.hpp"
 
 #include <gmock/gmock.h>
 
@@ -51,6 +52,11 @@ public:
   MOCK_METHOD2(glAttachShader, void(uint32_t programID, uint32_t shaderID));
   MOCK_METHOD2(glDetachShader, void(uint32_t programID, uint32_t shaderID));
   MOCK_METHOD2(glLinkProgram, bool(uint32_t programID, string & errorLog));
+  MOCK_METHOD0(IsProgramBinarySupported, bool());
+  MOCK_METHOD3(glGetProgramBinary, bool(uint32_t programID, vector<uint8_t> & binary,
+                                        glConst & format));
+  MOCK_METHOD3(glProgramBinary, bool(uint32_t programID, glConst format,
+                                     vector<uint8_t> const & binary));
   MOCK_METHOD1(glDeleteProgram, void(uint32_t programID));
 
   MOCK_METHOD2(glGetAttribLocation, int32_t(uint32_t programID, string const & name));
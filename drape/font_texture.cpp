@@ -8,7 +8,9 @@
 #include "base/string_utils.hpp"
 #include "base/stl_add.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/chrono.hpp"
+#include "std/cstring.hpp"
 #include "std/string.hpp"
 #include "std/vector.hpp"
 #include "std/map.hpp"
@@ -92,17 +94,26 @@ GlyphGenerator::GlyphGenerator(ref_ptr<GlyphManager> mng, TCompletionHandler con
   : m_mng(mng)
   , m_completionHandler(completionHandler)
   , m_isRunning(true)
-  , m_isSuspended(false)
-  , m_thread(&GlyphGenerator::Routine, this)
+  , m_generatingCount(0)
 {
   ASSERT(m_completionHandler != nullptr, ());
+
+  uint32_t const kMaxThreadsCount = 2;
+  uint32_t const threadsCount = max(1U, min(kMaxThreadsCount, thread::hardware_concurrency() / 2));
+  m_threads.reserve(threadsCount);
+  for (uint32_t i = 0; i < threadsCount; ++i)
+    m_threads.emplace_back(&GlyphGenerator::Routine, this);
 }
 
 GlyphGenerator::~GlyphGenerator()
 {
-  m_isRunning = false;
-  m_condition.notify_one();
-  m_thread.join();
+  {
+    lock_guard<mutex> lock(m_queueLock);
+    m_isRunning = false;
+  }
+  m_condition.notify_all();
+  for (auto & t : m_threads)
+    t.join();
   m_completionHandler = nullptr;
 
   for (GlyphGenerationData & data : m_queue)
@@ -110,36 +121,45 @@ GlyphGenerator::~GlyphGenerator()
   m_queue.clear();
 }
 
-void GlyphGenerator::WaitForGlyph(list<GlyphGenerationData> & queue)
+bool GlyphGenerator::WaitForGlyph(list<GlyphGenerationData> & queue)
 {
   unique_lock<mutex> lock(m_queueLock);
-  m_isSuspended = true;
   m_condition.wait(lock, [this] { return !m_queue.empty() || !m_isRunning; });
-  m_isSuspended = false;
-  queue.swap(m_queue);
+  if (!m_isRunning)
+    return false;
+
+  queue.splice(queue.end(), m_queue, m_queue.begin());
+  ++m_generatingCount;
+  return true;
+}
+
+void GlyphGenerator::OnGlyphGenerated()
+{
+  lock_guard<mutex> lock(m_queueLock);
+  ASSERT_GREATER(m_generatingCount, 0, ());
+  --m_generatingCount;
 }
 
 bool GlyphGenerator::IsSuspended() const
 {
   lock_guard<mutex> lock(m_queueLock);
-  return m_isSuspended;
+  return m_queue.empty() && m_generatingCount == 0;
 }
 
 void GlyphGenerator::Routine(GlyphGenerator * generator)
 {
   ASSERT(generator != nullptr, ());
-  while (generator->m_isRunning)
+  list<GlyphGenerationData> queue;
+  while (generator->WaitForGlyph(queue))
   {
-    list<GlyphGenerationData> queue;
-    generator->WaitForGlyph(queue);
+    GlyphGenerationData & data = queue.front();
+    GlyphManager::Glyph glyph = generator->m_mng->GenerateGlyph(data.m_glyph);
+    data.m_glyph.m_image.Destroy();
+    generator->m_completionHandler(data.m_rect, glyph);
+    queue.clear();
 
-    // generate glyphs
-    for (GlyphGenerationData & data : queue)
-    {
-      GlyphManager::Glyph glyph = generator->m_mng->GenerateGlyph(data.m_glyph);
-      data.m_glyph.m_image.Destroy();
-      generator->m_completionHandler(data.m_rect, glyph);
-    }
+    // The generated glyph is pending for uploading now, so it's safe to report suspension.
+    generator->OnGlyphGenerated();
   }
 }
 
@@ -252,7 +272,16 @@ void GlyphIndex::UploadResources(ref_ptr<Texture> texture)
   {
     m_mng->MarkGlyphReady(it->second);
 
-    if (!it->second.m_image.m_data)
+    GlyphManager::Glyph & glyph = it->second;
+    m2::RectU const & rect = it->first;
+    if (glyph.m_image.m_data && (glyph.m_image.m_width == 0 || glyph.m_image.m_height == 0 ||
+                                 rect.SizeX() == 0 || rect.SizeY() == 0))
+    {
+      LOG(LWARNING, ("Glyph skipped", glyph.m_code));
+      glyph.m_image.Destroy();
+    }
+
+    if (!glyph.m_image.m_data)
       it = pendingNodes.erase(it);
     else
       ++it;
@@ -261,23 +290,56 @@ void GlyphIndex::UploadResources(ref_ptr<Texture> texture)
   if (pendingNodes.empty())
     return;
 
+  // Glyphs are packed into rows one by one, so runs of adjacent glyphs of a row are uploaded
+  // as single strips. Texels under shorter glyphs of a row never belong to other glyphs.
+  uint8_t const bytesPerPixel = GetBytesPerPixel(texture->GetFormat());
+  vector<uint8_t> strip;
+  size_t runStart = 0;
   for (size_t i = 0; i < pendingNodes.size(); ++i)
   {
     GlyphManager::Glyph & glyph = pendingNodes[i].second;
     m2::RectU const rect = pendingNodes[i].first;
-    m2::PointU const zeroPoint = rect.LeftBottom();
-    if (glyph.m_image.m_width == 0 || glyph.m_image.m_height == 0 || rect.SizeX() == 0 || rect.SizeY() == 0)
+    ASSERT_EQUAL(glyph.m_image.m_width, rect.SizeX(), ());
+    ASSERT_EQUAL(glyph.m_image.m_height, rect.SizeY(), ());
+
+    if (i + 1 < pendingNodes.size())
     {
-      LOG(LWARNING, ("Glyph skipped", glyph.m_code));
+      m2::RectU const & nextRect = pendingNodes[i + 1].first;
+      if (nextRect.minY() == rect.minY() && nextRect.minX() == rect.maxX())
+        continue;
+    }
+
+    if (runStart == i)
+    {
+      uint8_t * srcMemory = SharedBufferManager::GetRawPointer(glyph.m_image.m_data);
+      texture->UploadData(rect.minX(), rect.minY(), rect.SizeX(), rect.SizeY(), make_ref(srcMemory));
+      glyph.m_image.Destroy();
+      runStart = i + 1;
       continue;
     }
-    ASSERT_EQUAL(glyph.m_image.m_width, rect.SizeX(), ());
-    ASSERT_EQUAL(glyph.m_image.m_height, rect.SizeY(), ());
 
-    uint8_t * srcMemory = SharedBufferManager::GetRawPointer(glyph.m_image.m_data);
-    texture->UploadData(zeroPoint.x, zeroPoint.y, rect.SizeX(), rect.SizeY(), make_ref(srcMemory));
-    
-    glyph.m_image.Destroy();
+    uint32_t const stripX = pendingNodes[runStart].first.minX();
+    uint32_t const stripWidth = rect.maxX() - stripX;
+    uint32_t stripHeight = 0;
+    for (size_t j = runStart; j <= i; ++j)
+      stripHeight = max(stripHeight, pendingNodes[j].first.SizeY());
+
+    strip.assign(stripWidth * stripHeight * bytesPerPixel, 0);
+    for (size_t j = runStart; j <= i; ++j)
+    {
+      GlyphManager::Glyph & g = pendingNodes[j].second;
+      m2::RectU const & r = pendingNodes[j].first;
+      uint8_t const * src = SharedBufferManager::GetRawPointer(g.m_image.m_data);
+      size_t const rowSize = r.SizeX() * bytesPerPixel;
+      for (uint32_t row = 0; row < r.SizeY(); ++row)
+      {
+        memcpy(strip.data() + (row * stripWidth + r.minX() - stripX) * bytesPerPixel,
+               src + row * rowSize, rowSize);
+      }
+      g.m_image.Destroy();
+    }
+    texture->UploadData(stripX, rect.minY(), stripWidth, stripHeight, make_ref(strip.data()));
+    runStart = i + 1;
   }
 }
 
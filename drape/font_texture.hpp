@@ -5,7 +5,6 @@
 #include "drape/glyph_manager.hpp"
 #include "drape/dynamic_texture.hpp"
 
-#include "std/atomic.hpp"
 #include "std/condition_variable.hpp"
 #include "std/list.hpp"
 #include "std/map.hpp"
@@ -93,11 +92,14 @@ public:
 
   void GenerateGlyph(m2::RectU const & rect, GlyphManager::Glyph const & glyph);
 
+  // Returns true if there are no glyphs in the queue and all threads are waiting for glyphs.
   bool IsSuspended() const;
 
 private:
   static void Routine(GlyphGenerator * generator);
-  void WaitForGlyph(list<GlyphGenerationData> & queue);
+  // Moves the next glyph to |queue|. Returns false if the generator is stopped.
+  bool WaitForGlyph(list<GlyphGenerationData> & queue);
+  void OnGlyphGenerated();
 
   ref_ptr<GlyphManager> m_mng;
   TCompletionHandler m_completionHandler;
@@ -105,10 +107,12 @@ private:
   list<GlyphGenerationData> m_queue;
   mutable mutex m_queueLock;
 
-  atomic<bool> m_isRunning;
+  bool m_isRunning;
   condition_variable m_condition;
-  bool m_isSuspended;
-  thread m_thread;
+  // Number of glyphs which are being generated now.
+  uint32_t m_generatingCount;
+  // Generation of SDF is expensive, so glyphs are generated by several threads.
+  vector<thread> m_threads;
 };
 
 class GlyphIndex
@@ -81,6 +81,12 @@ typedef void(DP_APIENTRY * TglGetProgramivFn)(GLuint programID, GLenum name, GLi
 typedef void(DP_APIENTRY * TglGetProgramInfoLogFn)(GLuint programID, GLsizei maxLength,
                                                    GLsizei * length, GLchar * infoLog);
 
+typedef void(DP_APIENTRY * TglGetProgramBinaryFn)(GLuint programID, GLsizei bufSize,
+                                                  GLsizei * length, GLenum * binaryFormat,
+                                                  void * binary);
+typedef void(DP_APIENTRY * TglProgramBinaryFn)(GLuint programID, GLenum binaryFormat,
+                                               void const * binary, GLsizei length);
+
 typedef void(DP_APIENTRY * TglUseProgramFn)(GLuint programID);
 typedef GLint(DP_APIENTRY * TglGetAttribLocationFn)(GLuint program, GLchar const * name);
 typedef void(DP_APIENTRY * TglBindAttribLocationFn)(GLuint program, GLuint index,
@@ -159,6 +165,8 @@ TglLinkProgramFn glLinkProgramFn = nullptr;
 TglDeleteProgramFn glDeleteProgramFn = nullptr;
 TglGetProgramivFn glGetProgramivFn = nullptr;
 TglGetProgramInfoLogFn glGetProgramInfoLogFn = nullptr;
+TglGetProgramBinaryFn glGetProgramBinaryFn = nullptr;
+TglProgramBinaryFn glProgramBinaryFn = nullptr;
 
 TglUseProgramFn glUseProgramFn = nullptr;
 TglGetAttribLocationFn glGetAttribLocationFn = nullptr;
@@ -193,6 +201,14 @@ TglGetStringiFn glGetStringiFn = nullptr;
   #define GL_NUM_EXTENSIONS 0x821D
 #endif
 
+#if !defined(GL_PROGRAM_BINARY_LENGTH)
+  #define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+
+#if !defined(GL_NUM_PROGRAM_BINARY_FORMATS)
+  #define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+
 std::mutex s_mutex;
 bool s_inited = false;
 }  // namespace
@@ -265,6 +281,8 @@ void GLFunctions::Init(dp::ApiVersion apiVersion)
     glMapBufferRangeFn = (TglMapBufferRangeFn)eglGetProcAddress("glMapBufferRangeEXT");
     glFlushMappedBufferRangeFn =
         (TglFlushMappedBufferRangeFn)eglGetProcAddress("glFlushMappedBufferRangeEXT");
+    glGetProgramBinaryFn = (TglGetProgramBinaryFn)eglGetProcAddress("glGetProgramBinaryOES");
+    glProgramBinaryFn = (TglProgramBinaryFn)eglGetProcAddress("glProgramBinaryOES");
   }
   else if (CurrentApiVersion == dp::ApiVersion::OpenGLES3)
   {
@@ -275,6 +293,8 @@ void GLFunctions::Init(dp::ApiVersion apiVersion)
     glMapBufferRangeFn = ::glMapBufferRange;
     glFlushMappedBufferRangeFn = ::glFlushMappedBufferRange;
     glGetStringiFn = ::glGetStringi;
+    glGetProgramBinaryFn = ::glGetProgramBinary;
+    glProgramBinaryFn = ::glProgramBinary;
   }
   else
   {
@@ -300,6 +320,8 @@ void GLFunctions::Init(dp::ApiVersion apiVersion)
     glMapBufferRangeFn = &::glMapBufferRange;
     glFlushMappedBufferRangeFn = &::glFlushMappedBufferRange;
     glGetStringiFn = &::glGetStringi;
+    glGetProgramBinaryFn = &::glGetProgramBinary;
+    glProgramBinaryFn = &::glProgramBinary;
   }
   else
   {
@@ -733,6 +755,53 @@ void GLFunctions::glDeleteProgram(uint32_t programID)
   GLCHECK(glDeleteProgramFn(programID));
 }
 
+bool GLFunctions::IsProgramBinarySupported()
+{
+  if (glGetProgramBinaryFn == nullptr || glProgramBinaryFn == nullptr)
+    return false;
+
+  GLint formatsCount = 0;
+  GLCHECK(::glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatsCount));
+  return formatsCount > 0;
+}
+
+bool GLFunctions::glGetProgramBinary(uint32_t programID, std::vector<uint8_t> & binary,
+                                     glConst & format)
+{
+  if (glGetProgramBinaryFn == nullptr)
+    return false;
+
+  ASSERT(glGetProgramivFn != nullptr, ());
+  GLint length = 0;
+  GLCHECK(glGetProgramivFn(programID, GL_PROGRAM_BINARY_LENGTH, &length));
+  if (length <= 0)
+    return false;
+
+  binary.resize(static_cast<size_t>(length));
+  GLsizei written = 0;
+  GLenum binaryFormat = 0;
+  GLCHECK(glGetProgramBinaryFn(programID, length, &written, &binaryFormat, binary.data()));
+  binary.resize(static_cast<size_t>(written));
+  format = binaryFormat;
+  return !binary.empty();
+}
+
+bool GLFunctions::glProgramBinary(uint32_t programID, glConst format,
+                                  std::vector<uint8_t> const & binary)
+{
+  if (glProgramBinaryFn == nullptr)
+    return false;
+
+  ASSERT(glGetProgramivFn != nullptr, ());
+  glProgramBinaryFn(programID, format, binary.data(), static_cast<GLsizei>(binary.size()));
+  // An outdated binary may raise GL_INVALID_ENUM, it must not be reported as an error.
+  while (::glGetError() != GL_NO_ERROR) {}
+
+  GLint result = GL_FALSE;
+  GLCHECK(glGetProgramivFn(programID, GL_LINK_STATUS, &result));
+  return result == GL_TRUE;
+}
+
 void GLFunctions::glUseProgram(uint32_t programID)
 {
   ASSERT(glUseProgramFn != nullptr, ());
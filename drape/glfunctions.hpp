@@ -7,6 +7,7 @@
 
 #include <string>
 #include <thread>
+#include <vector>
 
 class GLFunctions
 {
@@ -85,6 +86,16 @@ public:
   static bool glLinkProgram(uint32_t programID, std::string & errorLog);
   static void glDeleteProgram(uint32_t programID);
 
+  /// Program binaries support (OpenGL ES 3.0 or GL_OES_get_program_binary).
+  static bool IsProgramBinarySupported();
+  /// Returns false if the binary of a linked program can't be retrieved.
+  static bool glGetProgramBinary(uint32_t programID, std::vector<uint8_t> & binary,
+                                 glConst & format);
+  /// Loads a binary retrieved by glGetProgramBinary into a program and returns link status.
+  /// Binaries are rejected by drivers of other versions, so a failure is not an error.
+  static bool glProgramBinary(uint32_t programID, glConst format,
+                              std::vector<uint8_t> const & binary);
+
   static void glUseProgram(uint32_t programID);
   static int8_t glGetAttribLocation(uint32_t programID, std::string const & name);
   static void glBindAttribLocation(uint32_t programID, uint8_t index, std::string const & name);
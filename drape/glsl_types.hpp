@@ -10,6 +10,7 @@
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
+#include <glm/gtc/type_precision.hpp>
 
 #include <glm/mat3x3.hpp>
 #include <glm/mat4x4.hpp>
@@ -28,6 +29,11 @@ using glm::dvec2;
 using glm::dvec3;
 using glm::dvec4;
 
+// Compact types for vertex attributes, they are normalized to [0, 1] and [-1, 1]
+// when vertex attributes are bound.
+using glm::u16vec2;
+using glm::i16vec4;
+
 using glm::mat3;
 using glm::mat4;
 using glm::mat4x2;
@@ -63,6 +69,27 @@ inline m2::PointD FromVec2(glsl::vec2 const & pt)
   return m2::PointD(pt.x, pt.y);
 }
 
+// Quantizes texture coordinates in [0, 1] to unsigned normalized 16-bit values.
+inline u16vec2 ToUnorm16(vec2 const & v)
+{
+  auto const toUnorm = [](float f)
+  {
+    return static_cast<uint16_t>(glm::clamp(f, 0.0f, 1.0f) * 65535.0f + 0.5f);
+  };
+  return u16vec2(toUnorm(v.x), toUnorm(v.y));
+}
+
+// Quantizes a normal with coordinates in [-1, 1] to signed normalized 16-bit values.
+// The 4th component pads the attribute to 8 bytes and is ignored by shaders.
+inline i16vec4 ToSnorm16(vec3 const & v)
+{
+  auto const toSnorm = [](float f)
+  {
+    return static_cast<int16_t>(glm::round(glm::clamp(f, -1.0f, 1.0f) * 32767.0f));
+  };
+  return i16vec4(toSnorm(v.x), toSnorm(v.y), toSnorm(v.z), 0);
+}
+
 inline vec4 ToVec4(dp::Color const & color)
 {
   return glsl::vec4(double(color.GetRed()) / 255,
@@ -101,4 +128,16 @@ inline uint8_t GetComponentCount<vec4>()
   return 4;
 }
 
+template <>
+inline uint8_t GetComponentCount<u16vec2>()
+{
+  return 2;
+}
+
+template <>
+inline uint8_t GetComponentCount<i16vec4>()
+{
+  return 4;
+}
+
 } // namespace glsl
@@ -33,6 +33,7 @@ GPUBuffer::GPUBuffer(Target t, void const * data, uint8_t elementSize, uint32_t
   : TBase(elementSize, capacity)
   , m_t(t)
   , m_mappingOffset(0)
+  , m_allocatedBytes(0)
 #ifdef DEBUG
   , m_isMapped(false)
 #endif
@@ -44,6 +45,8 @@ GPUBuffer::~GPUBuffer()
 {
   GLFunctions::glBindBuffer(0, glTarget(m_t));
   GLFunctions::glDeleteBuffer(m_bufferID);
+  dp::GPUMemTracker::Inst().RemoveAllocatedBytes(dp::GPUMemTracker::Category::Buffers,
+                                                 m_allocatedBytes);
 
 #if defined(TRACK_GPU_MEM)
   dp::GPUMemTracker::Inst().RemoveDeallocated("VBO", m_bufferID);
@@ -159,6 +162,11 @@ void GPUBuffer::Resize(void const * data, uint32_t elementCount)
   if (data != nullptr)
     SetDataSize(elementCount);
 
+  dp::GPUMemTracker & tracker = dp::GPUMemTracker::Inst();
+  tracker.RemoveAllocatedBytes(dp::GPUMemTracker::Category::Buffers, m_allocatedBytes);
+  m_allocatedBytes = GetCapacity() * GetElementSize();
+  tracker.AddAllocatedBytes(dp::GPUMemTracker::Category::Buffers, m_allocatedBytes);
+
 #if defined(TRACK_GPU_MEM)
   dp::GPUMemTracker & memTracker = dp::GPUMemTracker::Inst();
   memTracker.RemoveDeallocated("VBO", m_bufferID);
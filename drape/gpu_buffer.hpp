@@ -27,6 +27,8 @@ public:
   void UpdateData(void * gpuPtr, void const * data, uint32_t elementOffset, uint32_t elementCount);
   void Unmap();
 
+  uint32_t GetAllocatedBytes() const { return m_allocatedBytes; }
+
 protected:
   // Discard old data.
   void Resize(void const * data, uint32_t elementCount);
@@ -36,6 +38,7 @@ private:
   Target m_t;
   uint32_t m_bufferID;
   uint32_t m_mappingOffset;
+  uint32_t m_allocatedBytes;
 
 #ifdef DEBUG
   bool m_isMapped;
@@ -33,11 +33,18 @@ GpuProgram::GpuProgram(int programIndex, ref_ptr<Shader> vertexShader,
   }
 }
 
+GpuProgram::GpuProgram(int programIndex, uint32_t programID, uint8_t textureSlotsCount)
+  : m_programID(programID)
+  , m_textureSlotsCount(textureSlotsCount)
+{
+  LoadUniformLocations();
+}
+
 GpuProgram::~GpuProgram()
 {
   Unbind();
 
-  if (SupportManager::Instance().IsTegraDevice())
+  if (m_vertexShader && SupportManager::Instance().IsTegraDevice())
   {
     GLFunctions::glDetachShader(m_programID, m_vertexShader->GetID());
     GLFunctions::glDetachShader(m_programID, m_fragmentShader->GetID());
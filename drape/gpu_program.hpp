@@ -14,8 +14,12 @@ class GpuProgram
 public:
   GpuProgram(int programIndex, ref_ptr<Shader> vertexShader, ref_ptr<Shader> fragmentShader,
              uint8_t textureSlotsCount);
+  // Takes ownership of a program which has been linked already, e.g. loaded from a binary.
+  GpuProgram(int programIndex, uint32_t programID, uint8_t textureSlotsCount);
   ~GpuProgram();
 
+  uint32_t GetID() const { return m_programID; }
+
   void Bind();
   void Unbind();
 
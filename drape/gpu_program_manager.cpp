@@ -2,20 +2,48 @@
 #include "drape/glfunctions.hpp"
 #include "drape/support_manager.hpp"
 
+#include "platform/platform.hpp"
+
+#include "coding/file_name_utils.hpp"
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/write_to_sink.hpp"
+
 #include "base/logging.hpp"
 #include "base/stl_add.hpp"
 
 #include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <vector>
 
 namespace dp
 {
+namespace
+{
+// Must be increased when the format of cached binaries is changed.
+uint32_t constexpr kBinaryCacheVersion = 1;
+
+// FNV-1a, names of cached binaries must be the same on all runs.
+uint64_t HashString(char const * str, uint64_t hash)
+{
+  for (; *str != '\0'; ++str)
+  {
+    hash ^= static_cast<uint8_t>(*str);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+}  // namespace
+
 GpuProgramManager::~GpuProgramManager()
 {
   m_programs.clear();
   m_shaders.clear();
 }
 
-void GpuProgramManager::Init(drape_ptr<gpu::GpuProgramGetter> && programGetter)
+void GpuProgramManager::Init(drape_ptr<gpu::GpuProgramGetter> && programGetter,
+                             std::string const & binaryCacheDir)
 {
   m_programGetter = std::move(programGetter);
   ASSERT(m_programGetter != nullptr, ());
@@ -38,6 +66,20 @@ void GpuProgramManager::Init(drape_ptr<gpu::GpuProgramGetter> && programGetter)
 
   if (GLFunctions::CurrentApiVersion == dp::ApiVersion::OpenGLES3)
     m_globalDefines.append("#define GLES3\n");
+
+  if (!binaryCacheDir.empty() && GLFunctions::IsProgramBinarySupported() &&
+      Platform::MkDirChecked(binaryCacheDir))
+  {
+    m_binaryCacheDir = binaryCacheDir;
+    std::ostringstream key;
+    key << kBinaryCacheVersion << '\n'
+        << GLFunctions::glGetString(gl_const::GLVendor) << '\n'
+        << GLFunctions::glGetString(gl_const::GLRenderer) << '\n'
+        << GLFunctions::glGetString(gl_const::GLVersion) << '\n'
+        << m_globalDefines;
+    m_binaryCacheKey = key.str();
+    LOG(LINFO, ("Program binaries are cached in", m_binaryCacheDir));
+  }
 }
 
 ref_ptr<GpuProgram> GpuProgramManager::GetProgram(int index)
@@ -47,14 +89,28 @@ ref_ptr<GpuProgram> GpuProgramManager::GetProgram(int index)
     return make_ref(it->second);
 
   auto const & programInfo = m_programGetter->GetProgramInfo(index);
-  auto vertexShader = GetShader(programInfo.m_vertexIndex, programInfo.m_vertexSource,
-                                Shader::Type::VertexShader);
-  auto fragmentShader = GetShader(programInfo.m_fragmentIndex, programInfo.m_fragmentSource,
-                                  Shader::Type::FragmentShader);
-
   auto const textureSlotsCount = std::max(m_minTextureSlotsCount, programInfo.m_textureSlotsCount);
-  drape_ptr<GpuProgram> program = make_unique_dp<GpuProgram>(index, vertexShader, fragmentShader,
-                                                             textureSlotsCount);
+
+  std::string binaryPath;
+  drape_ptr<GpuProgram> program;
+  if (!m_binaryCacheDir.empty())
+  {
+    binaryPath = GetBinaryPath(programInfo);
+    program = LoadProgramBinary(index, binaryPath, textureSlotsCount);
+  }
+
+  if (program == nullptr)
+  {
+    auto vertexShader = GetShader(programInfo.m_vertexIndex, programInfo.m_vertexSource,
+                                  Shader::Type::VertexShader);
+    auto fragmentShader = GetShader(programInfo.m_fragmentIndex, programInfo.m_fragmentSource,
+                                    Shader::Type::FragmentShader);
+    program = make_unique_dp<GpuProgram>(index, vertexShader, fragmentShader, textureSlotsCount);
+
+    if (!binaryPath.empty())
+      SaveProgramBinary(binaryPath, *program);
+  }
+
   ref_ptr<GpuProgram> result = make_ref(program);
   m_programs.emplace(index, move(program));
 
@@ -72,4 +128,71 @@ ref_ptr<Shader> GpuProgramManager::GetShader(int index, string const & source, S
   m_shaders.emplace(index, move(shader));
   return result;
 }
+
+std::string GpuProgramManager::GetBinaryPath(gpu::GpuProgramInfo const & programInfo) const
+{
+  uint64_t hash = 14695981039346656037ULL;
+  hash = HashString(m_binaryCacheKey.c_str(), hash);
+  hash = HashString(programInfo.m_vertexSource, hash);
+  hash = HashString(programInfo.m_fragmentSource, hash);
+
+  std::ostringstream name;
+  name << std::hex << std::setw(16) << std::setfill('0') << hash << ".bin";
+  return my::JoinPath(m_binaryCacheDir, name.str());
+}
+
+drape_ptr<GpuProgram> GpuProgramManager::LoadProgramBinary(int index, std::string const & path,
+                                                           uint8_t textureSlotsCount) const
+{
+  if (!Platform::IsFileExistsByFullPath(path))
+    return nullptr;
+
+  uint32_t format = 0;
+  std::vector<uint8_t> binary;
+  try
+  {
+    FileReader reader(path);
+    if (reader.Size() <= sizeof(format))
+      return nullptr;
+
+    format = ReadPrimitiveFromPos<uint32_t>(reader, 0);
+    binary.resize(static_cast<size_t>(reader.Size() - sizeof(format)));
+    reader.Read(sizeof(format), binary.data(), binary.size());
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't read program binary", path, e.Msg()));
+    return nullptr;
+  }
+
+  uint32_t const programID = GLFunctions::glCreateProgram();
+  if (!GLFunctions::glProgramBinary(programID, format, binary))
+  {
+    // The binary has been built by another version of the driver, it'll be rewritten.
+    GLFunctions::glDeleteProgram(programID);
+    return nullptr;
+  }
+
+  return make_unique_dp<GpuProgram>(index, programID, textureSlotsCount);
+}
+
+void GpuProgramManager::SaveProgramBinary(std::string const & path,
+                                          GpuProgram const & program) const
+{
+  glConst format = 0;
+  std::vector<uint8_t> binary;
+  if (!GLFunctions::glGetProgramBinary(program.GetID(), binary, format))
+    return;
+
+  try
+  {
+    FileWriter writer(path);
+    WriteToSink(writer, static_cast<uint32_t>(format));
+    writer.Write(binary.data(), binary.size());
+  }
+  catch (Writer::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't write program binary", path, e.Msg()));
+  }
+}
 }  // namespace dp
@@ -18,13 +18,21 @@ public:
   GpuProgramManager() = default;
   ~GpuProgramManager();
 
-  void Init(drape_ptr<gpu::GpuProgramGetter> && programGetter);
+  // If |binaryCacheDir| isn't empty and the driver supports program binaries, linked
+  // programs are stored there and are loaded on the next runs without compilation.
+  void Init(drape_ptr<gpu::GpuProgramGetter> && programGetter,
+            std::string const & binaryCacheDir = std::string());
 
   ref_ptr<GpuProgram> GetProgram(int index);
 
 private:
   ref_ptr<Shader> GetShader(int index, string const & source, Shader::Type t);
 
+  std::string GetBinaryPath(gpu::GpuProgramInfo const & programInfo) const;
+  drape_ptr<GpuProgram> LoadProgramBinary(int index, std::string const & path,
+                                          uint8_t textureSlotsCount) const;
+  void SaveProgramBinary(std::string const & path, GpuProgram const & program) const;
+
   using ProgramMap = std::map<int, drape_ptr<GpuProgram>>;
   using ShaderMap = std::map<int, drape_ptr<Shader>>;
   ProgramMap m_programs;
@@ -33,6 +41,11 @@ private:
   uint8_t m_minTextureSlotsCount = 0;
   drape_ptr<gpu::GpuProgramGetter> m_programGetter;
 
+  // Empty if the binary cache is disabled.
+  std::string m_binaryCacheDir;
+  // Binaries are valid only for the driver and the defines they have been built with.
+  std::string m_binaryCacheKey;
+
   DISALLOW_COPY_AND_MOVE(GpuProgramManager);
 };
 }  // namespace dp
@@ -2,6 +2,7 @@
 
 #include "glextensions_list.hpp"
 #include "glfunctions.hpp"
+#include "utils/gpu_mem_tracker.hpp"
 
 #include "platform/platform.hpp"
 
@@ -29,10 +30,14 @@ HWTexture::HWTexture()
   , m_pixelBufferID(0)
   , m_pixelBufferSize(0)
   , m_pixelBufferElementSize(0)
+  , m_pixelBufferOffset(0)
+  , m_allocatedBytes(0)
 {}
 
 HWTexture::~HWTexture()
 {
+  dp::GPUMemTracker::Inst().RemoveAllocatedBytes(dp::GPUMemTracker::Category::Textures,
+                                                 m_allocatedBytes);
 #if defined(TRACK_GPU_MEM)
   dp::GPUMemTracker::Inst().RemoveDeallocated("Texture", m_textureID);
   dp::GPUMemTracker::Inst().RemoveDeallocated("PBO", m_pixelBufferID);
@@ -57,6 +62,11 @@ void HWTexture::Create(Params const & params, ref_ptr<void> /*data*/)
     m_pixelBufferSize = static_cast<uint32_t>(kPboPercent * m_width * m_height * bytesPerPixel);
   }
 
+  dp::GPUMemTracker & tracker = dp::GPUMemTracker::Inst();
+  tracker.RemoveAllocatedBytes(dp::GPUMemTracker::Category::Textures, m_allocatedBytes);
+  m_allocatedBytes = bytesPerPixel * m_width * m_height + m_pixelBufferSize;
+  tracker.AddAllocatedBytes(dp::GPUMemTracker::Category::Textures, m_allocatedBytes);
+
 #if defined(TRACK_GPU_MEM)
   uint32_t const memSize = (CHAR_BIT * bytesPerPixel * m_width * m_height) >> 3;
   dp::GPUMemTracker::Inst().AddAllocated("Texture", m_textureID, memSize);
@@ -193,8 +203,18 @@ void OpenGLHWTexture::UploadData(uint32_t x, uint32_t y, uint32_t width, uint32_
   {
     ASSERT_GREATER(m_pixelBufferElementSize, 0, ());
     GLFunctions::glBindBuffer(m_pixelBufferID, gl_const::GLPixelBufferWrite);
-    GLFunctions::glBufferSubData(gl_const::GLPixelBufferWrite, mappingSize, data.get(), 0);
-    GLFunctions::glTexSubImage2D(x, y, width, height, layout, pixelType, nullptr);
+    if (m_pixelBufferOffset + mappingSize > m_pixelBufferSize)
+    {
+      GLFunctions::glBufferData(gl_const::GLPixelBufferWrite, m_pixelBufferSize, nullptr,
+                                gl_const::GLDynamicDraw);
+      m_pixelBufferOffset = 0;
+    }
+    GLFunctions::glBufferSubData(gl_const::GLPixelBufferWrite, mappingSize, data.get(),
+                                 m_pixelBufferOffset);
+    GLFunctions::glTexSubImage2D(x, y, width, height, layout, pixelType,
+                                 reinterpret_cast<void const *>(
+                                     static_cast<uintptr_t>(m_pixelBufferOffset)));
+    m_pixelBufferOffset += mappingSize;
     GLFunctions::glBindBuffer(0, gl_const::GLPixelBufferWrite);
   }
   else
@@ -55,6 +55,9 @@ public:
 
   uint32_t GetID() const;
 
+  // Returns the size of the texture and its pixel buffer in bytes.
+  uint32_t GetAllocatedBytes() const { return m_allocatedBytes; }
+
 protected:
   void UnpackFormat(TextureFormat format, glConst & layout, glConst & pixelType);
 
@@ -66,6 +69,10 @@ protected:
   uint32_t m_pixelBufferID;
   uint32_t m_pixelBufferSize;
   uint32_t m_pixelBufferElementSize;
+  // Uploads are written one after another into the pixel buffer, so the driver doesn't
+  // have to wait for previous transfers from it. The storage is orphaned when it's full.
+  uint32_t m_pixelBufferOffset;
+  uint32_t m_allocatedBytes;
 };
 
 class HWTextureAllocator
@@ -18,6 +18,12 @@ int const kInvalidFrame = -1;
 
 namespace
 {
+bool IsSameScreen(ScreenBase const & s1, ScreenBase const & s2)
+{
+  return s1.GtoPMatrix() == s2.GtoPMatrix() && s1.isPerspective() == s2.isPerspective() &&
+         s1.Pto3dMatrix() == s2.Pto3dMatrix() && s1.PixelRectIn3d() == s2.PixelRectIn3d();
+}
+
 class HandleComparator
 {
 public:
@@ -68,12 +74,17 @@ private:
 
 OverlayTree::OverlayTree(double visualScale)
   : m_frameCounter(kInvalidFrame)
+  , m_isSameScreen(false)
+  , m_isPlacingInvalidated(true)
   , m_isDisplacementEnabled(true)
   , m_frameUpdatePeriod(kMinFrameUpdatePeriod)
 {
   m_traits.SetVisualScale(visualScale);
   for (size_t i = 0; i < m_handles.size(); i++)
+  {
     m_handles[i].reserve(kAverageHandlesCount[i]);
+    m_candidates[i].reserve(kAverageHandlesCount[i]);
+  }
 }
 
 void OverlayTree::Clear()
@@ -84,6 +95,7 @@ void OverlayTree::Clear()
   for (auto & handles : m_handles)
     handles.clear();
   m_displacers.clear();
+  m_isPlacingInvalidated = true;
 }
 
 bool OverlayTree::Frame()
@@ -118,10 +130,11 @@ bool OverlayTree::IsNeedUpdate() const
 void OverlayTree::StartOverlayPlacing(ScreenBase const & screen)
 {
   ASSERT(IsNeedUpdate(), ());
-  TBase::Clear();
-  m_handlesCache.clear();
+  // The tree is cleared in EndOverlayPlacing, if the previous placing can't be kept.
+  m_lastHandlesCache.clear();
+  m_lastHandlesCache.swap(m_handlesCache);
+  m_isSameScreen = IsSameScreen(GetModelView(), screen);
   m_traits.SetModelView(screen);
-  m_displacementInfo.clear();
 }
 
 void OverlayTree::Remove(ref_ptr<OverlayHandle> handle)
@@ -130,7 +143,10 @@ void OverlayTree::Remove(ref_ptr<OverlayHandle> handle)
     return;
 
   if (m_handlesCache.find(handle) != m_handlesCache.end())
+  {
     m_frameCounter = kInvalidFrame;
+    m_isPlacingInvalidated = true;
+  }
 }
 
 void OverlayTree::Add(ref_ptr<OverlayHandle> handle)
@@ -175,6 +191,19 @@ void OverlayTree::Add(ref_ptr<OverlayHandle> handle)
   m_handles[rank].emplace_back(handle);
 }
 
+bool OverlayTree::CanKeepPlacing() const
+{
+  if (m_isPlacingInvalidated || !m_isSameScreen)
+    return false;
+
+  for (size_t rank = 0; rank < m_candidates.size(); ++rank)
+  {
+    if (m_candidates[rank] != m_lastCandidates[rank])
+      return false;
+  }
+  return true;
+}
+
 void OverlayTree::InsertHandle(ref_ptr<OverlayHandle> handle, int currentRank,
                                ref_ptr<OverlayHandle> const & parentOverlay)
 {
@@ -286,27 +315,48 @@ void OverlayTree::EndOverlayPlacing()
 {
   ASSERT(IsNeedUpdate(), ());
 
-  m_displacers.clear();
-
 #ifdef DEBUG_OVERLAYS_OUTPUT
   LOG(LINFO, ("- BEGIN OVERLAYS PLACING"));
 #endif
 
   HandleComparator comparator(false /* enableMask */);
 
+  ScreenBase const & modelView = GetModelView();
   for (int rank = 0; rank < dp::OverlayRanksCount; rank++)
   {
     std::sort(m_handles[rank].begin(), m_handles[rank].end(), comparator);
+    m_candidates[rank].clear();
     for (auto const & handle : m_handles[rank])
+      m_candidates[rank].emplace_back(handle, handle->GetExtendedPixelRect(modelView));
+  }
+
+  // Placing depends only on the collected handles and the screen, so if they haven't changed
+  // the handles which were visible after the previous placing stay visible.
+  if (CanKeepPlacing())
+  {
+    m_handlesCache.swap(m_lastHandlesCache);
+  }
+  else
+  {
+    TBase::Clear();
+    m_displacers.clear();
+    m_displacementInfo.clear();
+    for (int rank = 0; rank < dp::OverlayRanksCount; rank++)
     {
-      ref_ptr<OverlayHandle> parentOverlay;
-      if (!CheckHandle(handle, rank, parentOverlay))
-        continue;
+      for (auto const & handle : m_handles[rank])
+      {
+        ref_ptr<OverlayHandle> parentOverlay;
+        if (!CheckHandle(handle, rank, parentOverlay))
+          continue;
 
-      InsertHandle(handle, rank, parentOverlay);
+        InsertHandle(handle, rank, parentOverlay);
+      }
     }
   }
-  
+  m_lastHandlesCache.clear();
+  m_lastCandidates.swap(m_candidates);
+  m_isPlacingInvalidated = false;
+
   for (int rank = 0; rank < dp::OverlayRanksCount; rank++)
   {
     for (auto const & handle : m_handles[rank])
@@ -430,11 +480,15 @@ void OverlayTree::SetDisplacementEnabled(bool enabled)
     return;
   m_isDisplacementEnabled = enabled;
   m_frameCounter = kInvalidFrame;
+  m_isPlacingInvalidated = true;
 }
 
 void OverlayTree::SetSelectedFeature(FeatureID const & featureID)
 {
+  if (m_selectedFeatureID == featureID)
+    return;
   m_selectedFeatureID = featureID;
+  m_isPlacingInvalidated = true;
 }
 
 OverlayTree::TDisplacementInfo const & OverlayTree::GetDisplacementInfo() const
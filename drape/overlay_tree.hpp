@@ -93,7 +93,31 @@ public:
   TDisplacementInfo const & GetDisplacementInfo() const;
 
 private:
+  // A handle which was collected for placing with the properties which affect placing.
+  struct PlacingCandidate
+  {
+    PlacingCandidate(ref_ptr<OverlayHandle> handle, m2::RectD const & pixelRect)
+      : m_handle(handle)
+      , m_overlayId(handle->GetOverlayID())
+      , m_priority(handle->GetPriority())
+      , m_pixelRect(pixelRect)
+    {}
+
+    bool operator==(PlacingCandidate const & other) const
+    {
+      return m_handle == other.m_handle && m_overlayId == other.m_overlayId &&
+             m_priority == other.m_priority && m_pixelRect == other.m_pixelRect;
+    }
+
+    ref_ptr<OverlayHandle> m_handle;
+    OverlayID m_overlayId;
+    uint64_t m_priority;
+    m2::RectD m_pixelRect;
+  };
+  using TCandidates = std::array<std::vector<PlacingCandidate>, dp::OverlayRanksCount>;
+
   ScreenBase const & GetModelView() const { return m_traits.GetModelView(); }
+  bool CanKeepPlacing() const;
   void InsertHandle(ref_ptr<OverlayHandle> handle, int currentRank,
                     ref_ptr<OverlayHandle> const & parentOverlay);
   bool CheckHandle(ref_ptr<OverlayHandle> handle, int currentRank,
@@ -109,6 +133,14 @@ private:
   std::array<std::vector<ref_ptr<OverlayHandle>>, dp::OverlayRanksCount> m_handles;
   HandlesCache m_handlesCache;
 
+  // Placing of the previous update. If the screen and the collected handles are the same,
+  // the previous placing is kept instead of placing all handles again.
+  TCandidates m_candidates;
+  TCandidates m_lastCandidates;
+  HandlesCache m_lastHandlesCache;
+  bool m_isSameScreen;
+  bool m_isPlacingInvalidated;
+
   bool m_isDisplacementEnabled;
 
   FeatureID m_selectedFeatureID;
@@ -43,6 +43,7 @@ drape_ptr<OverlayHandle> RenderBucket::PopOverlayHandle()
   swap(m_overlay[0], m_overlay[lastElement]);
   drape_ptr<OverlayHandle> h = move(m_overlay[lastElement]);
   m_overlay.pop_back();
+  m_overlaysVisibility.clear();
   return h;
 }
 
@@ -54,6 +55,7 @@ ref_ptr<OverlayHandle> RenderBucket::GetOverlayHandle(size_t index)
 void RenderBucket::AddOverlayHandle(drape_ptr<OverlayHandle> && handle)
 {
   m_overlay.push_back(move(handle));
+  m_overlaysVisibility.clear();
 }
 
 void RenderBucket::BeforeUpdate()
@@ -96,16 +98,22 @@ void RenderBucket::Render(bool drawAsLine)
 
   if (!m_overlay.empty())
   {
+    // The index buffer contains indexes of visible overlays only. Visibility changes only
+    // when the overlay tree is rebuilt, so the buffer isn't uploaded on every frame.
+    bool const visibilityChanged = UpdateOverlaysVisibility();
+
     // in simple case when overlay is symbol each element will be contains 6 indexes
     AttributeBufferMutator attributeMutator;
-    IndexBufferMutator indexMutator(static_cast<uint32_t>(6 * m_overlay.size()));
+    uint32_t const indexesCount = visibilityChanged ? static_cast<uint32_t>(6 * m_overlay.size()) : 0;
+    IndexBufferMutator indexMutator(indexesCount);
     ref_ptr<IndexBufferMutator> rfpIndex = make_ref(&indexMutator);
     ref_ptr<AttributeBufferMutator> rfpAttrib = make_ref(&attributeMutator);
 
     bool hasIndexMutation = false;
+    bool hasAttributeMutation = false;
     for (drape_ptr<OverlayHandle> const & handle : m_overlay)
     {
-      if (handle->IndexesRequired())
+      if (visibilityChanged && handle->IndexesRequired())
       {
         if (handle->IsVisible())
           handle->GetElementIndexes(rfpIndex);
@@ -113,14 +121,34 @@ void RenderBucket::Render(bool drawAsLine)
       }
 
       if (handle->HasDynamicAttributes())
+      {
         handle->GetAttributeMutation(rfpAttrib);
+        hasAttributeMutation = true;
+      }
     }
 
-    m_buffer->ApplyMutation(hasIndexMutation ? rfpIndex : nullptr, rfpAttrib);
+    if (hasIndexMutation || hasAttributeMutation)
+      m_buffer->ApplyMutation(hasIndexMutation ? rfpIndex : nullptr, rfpAttrib);
   }
   m_buffer->Render(drawAsLine);
 }
 
+bool RenderBucket::UpdateOverlaysVisibility()
+{
+  bool changed = m_overlaysVisibility.size() != m_overlay.size();
+  m_overlaysVisibility.resize(m_overlay.size());
+  for (size_t i = 0; i < m_overlay.size(); ++i)
+  {
+    bool const isVisible = m_overlay[i]->IsVisible();
+    if (m_overlaysVisibility[i] != isVisible)
+    {
+      m_overlaysVisibility[i] = isVisible;
+      changed = true;
+    }
+  }
+  return changed;
+}
+
 void RenderBucket::SetFeatureMinZoom(int minZoom)
 {
   if (minZoom < m_featuresMinZoom)
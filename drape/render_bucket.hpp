@@ -57,11 +57,15 @@ public:
 
 private:
   void BeforeUpdate();
+  // Returns true if visibility of any overlay has changed since the last call.
+  bool UpdateOverlaysVisibility();
 
 private:
   int m_featuresMinZoom = numeric_limits<int>::max();
 
   vector<drape_ptr<OverlayHandle> > m_overlay;
+  // Visibility of overlays at the moment of the last update of the index buffer.
+  vector<bool> m_overlaysVisibility;
   drape_ptr<VertexArrayBuffer> m_buffer;
 };
 
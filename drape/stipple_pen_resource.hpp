@@ -123,7 +123,7 @@ public:
   StipplePenTexture(m2::PointU const & size, ref_ptr<HWTextureAllocator> allocator)
     : m_index(size)
   {
-    TBase::TextureParams params{size, TextureFormat::ALPHA, gl_const::GLNearest, false /* m_usePixelBuffer */};
+    TBase::TextureParams params{size, TextureFormat::ALPHA, gl_const::GLNearest, true /* m_usePixelBuffer */};
     TBase::Init(allocator, make_ref(&m_index), params);
   }
 
@@ -516,6 +516,25 @@ void TextureManager::Init(Params const & params)
     else
       m_glyphGroups.push_back(GlyphGroup(start, end));
   });
+
+  PrewarmGlyphs();
+}
+
+void TextureManager::PrewarmGlyphs()
+{
+  // Digits, latin letters and punctuation are used in house numbers, road numbers and
+  // names of all countries. They are rasterized and put into generation queue beforehand,
+  // so the first tiles with text don't wait for them.
+  strings::UniChar const kFirstChar = 0x20;
+  strings::UniChar const kLastChar = 0x7E;
+
+  strings::UniString text;
+  text.reserve(kLastChar - kFirstChar + 1);
+  for (strings::UniChar c = kFirstChar; c <= kLastChar; ++c)
+    text.push_back(c);
+
+  TGlyphsBuffer regions;
+  GetGlyphRegions(text, GlyphManager::kDynamicGlyphSize, regions);
 }
 
 void TextureManager::OnSwitchMapStyle()
@@ -63,7 +63,7 @@ public:
   ColorTexture(m2::PointU const & size, ref_ptr<HWTextureAllocator> allocator)
     : m_palette(size)
   {
-    TBase::TextureParams params{size, TextureFormat::RGBA8, gl_const::GLNearest, false /* m_usePixelBuffer */};
+    TBase::TextureParams params{size, TextureFormat::RGBA8, gl_const::GLNearest, true /* m_usePixelBuffer */};
     TBase::Init(allocator, make_ref(&m_palette), params);
   }
 
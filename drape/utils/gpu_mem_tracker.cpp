@@ -1,5 +1,8 @@
 #include "drape/utils/gpu_mem_tracker.hpp"
 
+#include "base/assert.hpp"
+#include "base/macros.hpp"
+
 #include "std/tuple.hpp"
 #include "std/sstream.hpp"
 
@@ -80,4 +83,29 @@ void GPUMemTracker::RemoveDeallocated(string const & tag, uint32_t id)
   m_memTracker.erase(make_pair(tag, id));
 }
 
+void GPUMemTracker::AddAllocatedBytes(Category category, uint64_t bytes)
+{
+  m_allocatedBytes[static_cast<size_t>(category)] += bytes;
+}
+
+void GPUMemTracker::RemoveAllocatedBytes(Category category, uint64_t bytes)
+{
+  uint64_t const prev = m_allocatedBytes[static_cast<size_t>(category)].fetch_sub(bytes);
+  ASSERT_LESS_OR_EQUAL(bytes, prev, ());
+  UNUSED_VALUE(prev);
+}
+
+uint64_t GPUMemTracker::GetAllocatedBytes(Category category) const
+{
+  return m_allocatedBytes[static_cast<size_t>(category)];
+}
+
+uint64_t GPUMemTracker::GetAllocatedBytes() const
+{
+  uint64_t result = 0;
+  for (auto const & bytes : m_allocatedBytes)
+    result += bytes;
+  return result;
+}
+
 } // namespace dp
@@ -4,6 +4,8 @@
 
 #include "base/mutex.hpp"
 
+#include "std/array.hpp"
+#include "std/atomic.hpp"
 #include "std/map.hpp"
 #include "std/noncopyable.hpp"
 #include "std/string.hpp"
@@ -39,6 +41,20 @@ public:
   void SetUsed(string const & tag, uint32_t id, uint32_t size);
   void RemoveDeallocated(string const & tag, uint32_t id);
 
+  // Unlike the tagged tracking above, the summary accounting is always enabled.
+  // It's cheap enough to be used for the GPU memory budget in release builds.
+  enum class Category
+  {
+    Buffers = 0,
+    Textures,
+    Count
+  };
+
+  void AddAllocatedBytes(Category category, uint64_t bytes);
+  void RemoveAllocatedBytes(Category category, uint64_t bytes);
+  uint64_t GetAllocatedBytes(Category category) const;
+  uint64_t GetAllocatedBytes() const;
+
 private:
   GPUMemTracker() = default;
 
@@ -48,6 +64,8 @@ private:
   map<TMemTag, TAlocUsedMem> m_memTracker;
 
   threads::Mutex m_mutex;
+
+  array<atomic<uint64_t>, static_cast<size_t>(Category::Count)> m_allocatedBytes = {};
 };
 
 } // namespace dp
@@ -9,6 +9,7 @@ namespace
 enum VertexType
 {
   Area,
+  CompactArea,
   Area3d,
   HatchingArea,
   SolidTexturing,
@@ -43,16 +44,28 @@ dp::BindingInfo AreaBindingInit()
   return filler.m_info;
 }
 
+dp::BindingInfo CompactAreaBindingInit()
+{
+  static_assert(sizeof(CompactAreaVertex) == (sizeof(CompactAreaVertex::TPosition) +
+                                              sizeof(CompactAreaVertex::TCompactTexCoord)), "");
+
+  dp::BindingFiller<CompactAreaVertex> filler(2);
+  filler.FillDecl<CompactAreaVertex::TPosition>("a_position");
+  filler.FillDecl<CompactAreaVertex::TCompactTexCoord>("a_colorTexCoords", true /* needNormalize */);
+
+  return filler.m_info;
+}
+
 dp::BindingInfo Area3dBindingInit()
 {
   static_assert(sizeof(Area3dVertex) == (sizeof(Area3dVertex::TPosition) +
-                                         sizeof(Area3dVertex::TNormal3d) +
-                                         sizeof(Area3dVertex::TTexCoord)), "");
+                                         sizeof(Area3dVertex::TCompactNormal3d) +
+                                         sizeof(Area3dVertex::TCompactTexCoord)), "");
 
   dp::BindingFiller<Area3dVertex> filler(3);
   filler.FillDecl<Area3dVertex::TPosition>("a_position");
-  filler.FillDecl<Area3dVertex::TNormal3d>("a_normal");
-  filler.FillDecl<Area3dVertex::TTexCoord>("a_colorTexCoords");
+  filler.FillDecl<Area3dVertex::TCompactNormal3d>("a_normal", true /* needNormalize */);
+  filler.FillDecl<Area3dVertex::TCompactTexCoord>("a_colorTexCoords", true /* needNormalize */);
 
   return filler.m_info;
 }
@@ -198,6 +211,7 @@ BindingNode g_bindingNodes[TypeCount];
 TInitFunction g_initFunctions[TypeCount] =
 {
   &AreaBindingInit,
+  &CompactAreaBindingInit,
   &Area3dBindingInit,
   &HatchingAreaBindingInit,
   &SolidTexturingBindingInit,
@@ -242,18 +256,35 @@ dp::BindingInfo const & AreaVertex::GetBindingInfo()
   return GetBinding(Area);
 }
 
+CompactAreaVertex::CompactAreaVertex()
+  : m_position(0.0, 0.0, 0.0)
+  , m_colorTexCoord(0, 0)
+{
+}
+
+CompactAreaVertex::CompactAreaVertex(TPosition const & position, TTexCoord const & colorTexCoord)
+  : m_position(position)
+  , m_colorTexCoord(glsl::ToUnorm16(colorTexCoord))
+{
+}
+
+dp::BindingInfo const & CompactAreaVertex::GetBindingInfo()
+{
+  return GetBinding(CompactArea);
+}
+
 Area3dVertex::Area3dVertex()
   : m_position(0.0, 0.0, 0.0)
-  , m_normal(0.0, 0.0, 0.0)
-  , m_colorTexCoord(0.0, 0.0)
+  , m_normal(0, 0, 0, 0)
+  , m_colorTexCoord(0, 0)
 {
 }
 
 Area3dVertex::Area3dVertex(TPosition const & position, TPosition const & normal,
                            TTexCoord const & colorTexCoord)
   : m_position(position)
-  , m_normal(normal)
-  , m_colorTexCoord(colorTexCoord)
+  , m_normal(glsl::ToSnorm16(normal))
+  , m_colorTexCoord(glsl::ToUnorm16(colorTexCoord))
 {
 }
 
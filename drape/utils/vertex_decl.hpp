@@ -15,6 +15,9 @@ struct BaseVertex
   using TNormal = glsl::vec2;
   using TNormal3d = glsl::vec3;
   using TTexCoord = glsl::vec2;
+  // Normalized on binding, see glsl::ToUnorm16() and glsl::ToSnorm16().
+  using TCompactTexCoord = glsl::u16vec2;
+  using TCompactNormal3d = glsl::i16vec4;
 };
 
 struct AreaVertex : BaseVertex
@@ -28,14 +31,26 @@ struct AreaVertex : BaseVertex
   static dp::BindingInfo const & GetBindingInfo();
 };
 
+// The same as AreaVertex, but texture coordinates take 4 bytes instead of 8.
+struct CompactAreaVertex : BaseVertex
+{
+  CompactAreaVertex();
+  CompactAreaVertex(TPosition const & position, TTexCoord const & colorTexCoord);
+
+  TPosition m_position;
+  TCompactTexCoord m_colorTexCoord;
+
+  static dp::BindingInfo const & GetBindingInfo();
+};
+
 struct Area3dVertex : BaseVertex
 {
   Area3dVertex();
   Area3dVertex(TPosition const & position, const TPosition & normal, TTexCoord const & colorTexCoord);
 
   TPosition m_position;
-  TNormal3d m_normal;
-  TTexCoord m_colorTexCoord;
+  TCompactNormal3d m_normal;
+  TCompactTexCoord m_colorTexCoord;
 
   static dp::BindingInfo const & GetBindingInfo();
 };
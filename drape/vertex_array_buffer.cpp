@@ -246,6 +246,21 @@ uint32_t VertexArrayBuffer::GetDynamicBufferOffset(BindingInfo const & bindingIn
 
 uint32_t VertexArrayBuffer::GetIndexCount() const { return GetIndexBuffer()->GetCurrentSize(); }
 
+uint32_t VertexArrayBuffer::GetByteSize() const
+{
+  auto const getSize = [](ref_ptr<DataBufferBase> buffer)
+  {
+    return buffer->GetCurrentSize() * buffer->GetElementSize();
+  };
+
+  uint32_t size = getSize(GetIndexBuffer());
+  for (auto const & buffer : m_staticBuffers)
+    size += getSize(buffer.second->GetBuffer());
+  for (auto const & buffer : m_dynamicBuffers)
+    size += getSize(buffer.second->GetBuffer());
+  return size;
+}
+
 void VertexArrayBuffer::UploadIndexes(void const * data, uint32_t count)
 {
   ASSERT_LESS_OR_EQUAL(count, GetIndexBuffer()->GetAvailableSize(), ());
@@ -336,8 +351,8 @@ void VertexArrayBuffer::BindBuffers(BuffersMap const & buffers) const
       assert(attributeLocation != -1);
       GLFunctions::glEnableVertexAttribute(attributeLocation);
       GLFunctions::glVertexAttributePointer(attributeLocation, decl.m_componentCount,
-                                            decl.m_componentType, false, decl.m_stride,
-                                            decl.m_offset);
+                                            decl.m_componentType, decl.m_needNormalize,
+                                            decl.m_stride, decl.m_offset);
     }
   }
 }
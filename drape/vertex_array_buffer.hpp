@@ -51,6 +51,8 @@ public:
   uint32_t GetStartIndexValue() const;
   uint32_t GetDynamicBufferOffset(BindingInfo const & bindingInfo);
   uint32_t GetIndexCount() const;
+  // Size of all vertex and index buffers in bytes.
+  uint32_t GetByteSize() const;
 
   void UploadData(BindingInfo const & bindingInfo, void const * data, uint32_t count);
   void UploadIndexes(void const * data, uint32_t count);
@@ -50,11 +50,11 @@ void AreaShape::DrawArea(ref_ptr<dp::Batcher> batcher, m2::PointD const & colorU
 {
   glsl::vec2 const uv = glsl::ToVec2(colorUv);
 
-  buffer_vector<gpu::AreaVertex, 128> vertexes;
+  buffer_vector<gpu::CompactAreaVertex, 128> vertexes;
   vertexes.resize(m_vertexes.size());
   transform(m_vertexes.begin(), m_vertexes.end(), vertexes.begin(), [&uv, this](m2::PointF const & vertex)
   {
-    return gpu::AreaVertex(glsl::vec3(glsl::ToVec2(ConvertToLocal(vertex, m_params.m_tileCenter, kShapeCoordScalar)),
+    return gpu::CompactAreaVertex(glsl::vec3(glsl::ToVec2(ConvertToLocal(vertex, m_params.m_tileCenter, kShapeCoordScalar)),
                                       m_params.m_depth), uv);
   });
 
@@ -62,7 +62,7 @@ void AreaShape::DrawArea(ref_ptr<dp::Batcher> batcher, m2::PointD const & colorU
   state.SetColorTexture(texture);
 
   dp::AttributeProvider provider(1, static_cast<uint32_t>(vertexes.size()));
-  provider.InitStream(0, gpu::AreaVertex::GetBindingInfo(), make_ref(vertexes.data()));
+  provider.InitStream(0, gpu::CompactAreaVertex::GetBindingInfo(), make_ref(vertexes.data()));
   batcher->InsertTriangleList(state, make_ref(&provider));
 
   // Generate outline.
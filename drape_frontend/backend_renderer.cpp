@@ -31,7 +31,12 @@ BackendRenderer::BackendRenderer(Params && params)
   , m_model(params.m_model)
   , m_readManager(make_unique_dp<ReadManager>(params.m_commutator, m_model,
                                               params.m_allow3dBuildings, params.m_trafficEnabled))
-  , m_trafficGenerator(make_unique_dp<TrafficGenerator>(bind(&BackendRenderer::FlushTrafficRenderData, this, _1)))
+  , m_trafficGenerator(make_unique_dp<TrafficGenerator>(bind(&BackendRenderer::FlushTrafficRenderData, this, _1),
+                                                        [this](TileKey const & tileKey)
+                                                        {
+                                                          return m_requestedTiles->CheckTileKey(tileKey) &&
+                                                                 m_readManager->CheckTileKey(tileKey);
+                                                        }))
   , m_userMarkGenerator(make_unique_dp<UserMarkGenerator>(bind(&BackendRenderer::FlushUserMarksRenderData, this, _1)))
   , m_requestedTiles(params.m_requestedTiles)
   , m_updateCurrentCountryFn(params.m_updateCurrentCountryFn)
@@ -132,6 +137,13 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
       break;
     }
 
+  case Message::EvictTiles:
+    {
+      ref_ptr<EvictTilesMessage> msg = message;
+      m_readManager->Evict(msg->GetTiles());
+      break;
+    }
+
   case Message::ShowChoosePositionMark:
     {
       RecacheChoosePositionMark();
@@ -214,7 +226,7 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
 #if defined(DRAPE_MEASURER) && defined(GENERATING_STATISTIC)
         DrapeMeasurer::Instance().StartShapesGeneration();
 #endif
-        for (drape_ptr<MapShape> const & shape : msg->GetShapes())
+        for (auto const & shape : msg->GetShapes())
         {
           batcher->SetFeatureMinZoom(shape->GetFeatureMinZoom());
           shape->Draw(batcher, m_texMng);
@@ -238,13 +250,19 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
         DrapeMeasurer::Instance().StartOverlayShapesGeneration();
 #endif
         OverlayBatcher batcher(tileKey);
-        for (drape_ptr<MapShape> const & shape : msg->GetShapes())
+        for (auto const & shape : msg->GetShapes())
           batcher.Batch(shape, m_texMng);
 
         TOverlaysRenderData renderData;
         batcher.Finish(renderData);
         if (!renderData.empty())
         {
+          if (DrapeMeasurer::Instance().IsTracing())
+          {
+            for (auto const & data : renderData)
+              DrapeMeasurer::Instance().AddUploadedBytes(data.m_bucket->GetBuffer()->GetByteSize());
+          }
+
           m_overlays.reserve(m_overlays.size() + renderData.size());
           move(renderData.begin(), renderData.end(), back_inserter(m_overlays));
         }
@@ -387,7 +405,7 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
       ref_ptr<FlushTrafficGeometryMessage> msg = message;
       auto const & tileKey = msg->GetKey();
       if (m_requestedTiles->CheckTileKey(tileKey) && m_readManager->CheckTileKey(tileKey))
-        m_trafficGenerator->FlushSegmentsGeometry(tileKey, msg->GetSegments(), m_texMng);
+        m_trafficGenerator->FlushSegmentsGeometry(tileKey, move(msg->GetSegments()), m_texMng);
       break;
     }
 
@@ -395,9 +413,20 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
     {
       ref_ptr<UpdateTrafficMessage> msg = message;
       m_trafficGenerator->UpdateColoring(msg->GetSegmentsColoring());
-      m_commutator->PostMessage(ThreadsCommutator::RenderThread,
-                                make_unique_dp<RegenerateTrafficMessage>(),
-                                MessagePriority::Normal);
+
+      // Only traffic of the rendered tiles is regenerated, the tiles are not reread.
+      for (auto const & coloring : msg->GetSegmentsColoring())
+      {
+        vector<TileKey> tiles;
+        vector<TrafficRenderData> renderData;
+        m_trafficGenerator->RegenerateTraffic(coloring.first, m_texMng, tiles, renderData);
+        if (tiles.empty())
+          continue;
+        m_commutator->PostMessage(ThreadsCommutator::RenderThread,
+                                  make_unique_dp<RegenerateTrafficMessage>(coloring.first, move(tiles),
+                                                                           move(renderData)),
+                                  MessagePriority::Normal);
+      }
       break;
     }
 
@@ -557,7 +586,7 @@ void BackendRenderer::Routine::Do()
 void BackendRenderer::InitGLDependentResource()
 {
   uint32_t constexpr kBatchSize = 5000;
-  m_batchersPool = make_unique_dp<BatchersPool<TileKey, TileKeyStrictComparator>>(kReadingThreadsCount,
+  m_batchersPool = make_unique_dp<BatchersPool<TileKey, TileKeyStrictComparator>>(GetReadingThreadsCount(),
                                                bind(&BackendRenderer::FlushGeometry, this, _1, _2, _3),
                                                kBatchSize, kBatchSize);
   m_trafficGenerator->Init();
@@ -601,6 +630,8 @@ void BackendRenderer::RecacheMapShapes()
 void BackendRenderer::FlushGeometry(TileKey const & key, dp::GLState const & state,
                                     drape_ptr<dp::RenderBucket> && buffer)
 {
+  if (DrapeMeasurer::Instance().IsTracing())
+    DrapeMeasurer::Instance().AddUploadedBytes(buffer->GetBuffer()->GetByteSize());
   GLFunctions::glFlush();
   m_commutator->PostMessage(ThreadsCommutator::RenderThread,
                             make_unique_dp<FlushRenderBucketMessage>(key, state, move(buffer)),
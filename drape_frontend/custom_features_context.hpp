@@ -2,23 +2,35 @@
 
 #include "indexer/feature_decl.hpp"
 
+#include "base/assert.hpp"
+
+#include <algorithm>
 #include <memory>
 #include <set>
 #include <utility>
+#include <vector>
 
 namespace df
 {
 struct CustomFeaturesContext
 {
-  std::set<FeatureID> const m_features;
+  // Sorted features, they are looked up for every read feature, so
+  // a vector is used instead of a set.
+  std::vector<FeatureID> const m_features;
 
-  explicit CustomFeaturesContext(std::set<FeatureID> && features)
+  explicit CustomFeaturesContext(std::vector<FeatureID> && features)
     : m_features(std::move(features))
+  {
+    ASSERT(std::is_sorted(m_features.cbegin(), m_features.cend()), ());
+  }
+
+  explicit CustomFeaturesContext(std::set<FeatureID> const & features)
+    : m_features(features.cbegin(), features.cend())
   {}
 
   bool Contains(FeatureID const & id) const
   {
-    return m_features.find(id) != m_features.cend();
+    return std::binary_search(m_features.cbegin(), m_features.cend(), id);
   }
 };
 
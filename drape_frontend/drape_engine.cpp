@@ -748,4 +748,11 @@ void DrapeEngine::RunFirstLaunchAnimation()
                                   make_unique_dp<RunFirstLaunchAnimationMessage>(),
                                   MessagePriority::Normal);
 }
+
+void DrapeEngine::SetGpuMemoryBudget(uint64_t budgetInBytes)
+{
+  m_threadCommutator->PostMessage(ThreadsCommutator::RenderThread,
+                                  make_unique_dp<SetGpuMemoryBudgetMessage>(budgetInBytes),
+                                  MessagePriority::Normal);
+}
 }  // namespace df
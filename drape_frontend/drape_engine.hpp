@@ -213,6 +213,10 @@ public:
 
   void RunFirstLaunchAnimation();
 
+  // The furthest tiles are evicted when GPU memory consumption exceeds the budget.
+  // Zero budget means no limit.
+  void SetGpuMemoryBudget(uint64_t budgetInBytes);
+
 private:
   void AddUserEvent(drape_ptr<UserEvent> && e);
   void PostUserEvent(drape_ptr<UserEvent> && e);
@@ -95,6 +95,7 @@ SOURCES += \
     text_layout.cpp \
     text_shape.cpp \
     threads_commutator.cpp \
+    tile_shapes_cache.cpp \
     tile_info.cpp \
     tile_key.cpp \
     tile_utils.cpp \
@@ -200,6 +201,7 @@ HEADERS += \
     text_layout.hpp \
     text_shape.hpp \
     threads_commutator.hpp \
+    tile_shapes_cache.hpp \
     tile_info.hpp \
     tile_key.hpp \
     tile_utils.hpp \
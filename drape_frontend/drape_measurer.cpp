@@ -1,7 +1,26 @@
 #include "drape_measurer.hpp"
 
+#include <sstream>
+
 namespace df
 {
+namespace
+{
+// Tracing stops recording when the limit is reached, so forgotten tracing doesn't eat the memory.
+size_t constexpr kMaxTraceEventsCount = 1 << 18;
+
+void WriteJsonString(std::ostringstream & ss, std::string const & str)
+{
+  ss << '"';
+  for (char const c : str)
+  {
+    if (c == '"' || c == '\\')
+      ss << '\\';
+    ss << c;
+  }
+  ss << '"';
+}
+}  // namespace
 
 DrapeMeasurer & DrapeMeasurer::Instance()
 {
@@ -395,6 +414,153 @@ std::string DrapeMeasurer::DrapeStatistic::ToString() const
   return ss.str();
 }
 
+void DrapeMeasurer::StartTracing()
+{
+  std::lock_guard<std::mutex> lock(m_traceMutex);
+  m_traceStartTime = std::chrono::steady_clock::now();
+  m_traceEvents.clear();
+  m_traceThreadIds.clear();
+  m_uploadedBytes = 0;
+  m_isTracing = true;
+}
+
+void DrapeMeasurer::StopTracing()
+{
+  m_isTracing = false;
+}
+
+void DrapeMeasurer::AddTraceEvent(std::string const & name, char const * category,
+                                  TTimePoint start, TTimePoint end, TTraceArgs && args)
+{
+  if (!m_isTracing)
+    return;
+
+  TraceEvent event;
+  event.m_name = name;
+  event.m_category = category;
+  event.m_phase = 'X';
+  event.m_args = std::move(args);
+
+  std::lock_guard<std::mutex> lock(m_traceMutex);
+  event.m_timestampUs = GetTraceTimestampUs(start);
+  event.m_durationUs = GetTraceTimestampUs(end) - event.m_timestampUs;
+  AddTraceEventImpl(std::move(event));
+}
+
+void DrapeMeasurer::AddTraceCounter(std::string const & name, int64_t value)
+{
+  if (!m_isTracing)
+    return;
+
+  TraceEvent event;
+  event.m_name = name;
+  event.m_category = "counter";
+  event.m_phase = 'C';
+  event.m_args.emplace_back("value", value);
+
+  std::lock_guard<std::mutex> lock(m_traceMutex);
+  event.m_timestampUs = GetTraceTimestampUs(std::chrono::steady_clock::now());
+  AddTraceEventImpl(std::move(event));
+}
+
+void DrapeMeasurer::AddUploadedBytes(uint32_t bytesCount)
+{
+  if (!m_isTracing)
+    return;
+
+  TraceEvent event;
+  event.m_name = "UploadedBytes";
+  event.m_category = "counter";
+  event.m_phase = 'C';
+
+  std::lock_guard<std::mutex> lock(m_traceMutex);
+  m_uploadedBytes += bytesCount;
+  event.m_args.emplace_back("value", static_cast<int64_t>(m_uploadedBytes));
+  event.m_timestampUs = GetTraceTimestampUs(std::chrono::steady_clock::now());
+  AddTraceEventImpl(std::move(event));
+}
+
+void DrapeMeasurer::AddTraceEventImpl(TraceEvent && event)
+{
+  if (m_traceEvents.size() >= kMaxTraceEventsCount)
+    return;
+
+  auto const threadId = std::this_thread::get_id();
+  auto it = m_traceThreadIds.find(threadId);
+  if (it == m_traceThreadIds.end())
+  {
+    auto const id = static_cast<uint32_t>(m_traceThreadIds.size() + 1);
+    it = m_traceThreadIds.insert(std::make_pair(threadId, id)).first;
+  }
+  event.m_threadId = it->second;
+  m_traceEvents.push_back(std::move(event));
+}
+
+int64_t DrapeMeasurer::GetTraceTimestampUs(TTimePoint timePoint) const
+{
+  using namespace std::chrono;
+  return duration_cast<microseconds>(timePoint - m_traceStartTime).count();
+}
+
+std::string DrapeMeasurer::ExportTrace()
+{
+  std::ostringstream ss;
+  ss << "{\"traceEvents\":[";
+
+  std::lock_guard<std::mutex> lock(m_traceMutex);
+  bool isFirst = true;
+  for (auto const & event : m_traceEvents)
+  {
+    if (!isFirst)
+      ss << ",";
+    isFirst = false;
+
+    ss << "\n{\"name\":";
+    WriteJsonString(ss, event.m_name);
+    ss << ",\"cat\":\"" << event.m_category << "\",\"ph\":\"" << event.m_phase
+       << "\",\"pid\":1,\"tid\":" << event.m_threadId << ",\"ts\":" << event.m_timestampUs;
+    if (event.m_phase == 'X')
+      ss << ",\"dur\":" << event.m_durationUs;
+    if (!event.m_args.empty())
+    {
+      ss << ",\"args\":{";
+      for (size_t i = 0; i < event.m_args.size(); ++i)
+      {
+        if (i != 0)
+          ss << ",";
+        WriteJsonString(ss, event.m_args[i].first);
+        ss << ":" << event.m_args[i].second;
+      }
+      ss << "}";
+    }
+    ss << "}";
+  }
+  ss << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  return ss.str();
+}
+
+DrapeMeasurer::TraceScope::TraceScope(std::string const & name, char const * category)
+  : m_name(name)
+  , m_category(category)
+  , m_isTracing(DrapeMeasurer::Instance().IsTracing())
+  , m_start(m_isTracing ? std::chrono::steady_clock::now() : TTimePoint())
+{}
+
+DrapeMeasurer::TraceScope::~TraceScope()
+{
+  if (m_isTracing)
+  {
+    DrapeMeasurer::Instance().AddTraceEvent(m_name, m_category, m_start,
+                                            std::chrono::steady_clock::now(), std::move(m_args));
+  }
+}
+
+void DrapeMeasurer::TraceScope::AddArg(std::string const & name, int64_t value)
+{
+  if (m_isTracing)
+    m_args.emplace_back(name, value);
+}
+
 DrapeMeasurer::DrapeStatistic DrapeMeasurer::GetDrapeStatistic()
 {
   DrapeStatistic statistic;
@@ -7,11 +7,16 @@
 #include "base/thread.hpp"
 #include "base/timer.hpp"
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <numeric>
+#include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 namespace df
@@ -119,11 +124,72 @@ public:
 
   DrapeStatistic GetDrapeStatistic();
 
+  // Tracing doesn't need any compile-time flags and can be switched on in release builds.
+  // Recorded events are exported in the Chrome trace event format (chrome://tracing).
+  using TTimePoint = std::chrono::steady_clock::time_point;
+  using TTraceArgs = std::vector<std::pair<std::string, int64_t>>;
+
+  void StartTracing();
+  void StopTracing();
+  bool IsTracing() const { return m_isTracing; }
+
+  // Records a span of the current thread from |start| to |end|.
+  void AddTraceEvent(std::string const & name, char const * category, TTimePoint start,
+                     TTimePoint end, TTraceArgs && args = {});
+  // Records a value of the counter |name| at the current moment.
+  void AddTraceCounter(std::string const & name, int64_t value);
+  // Accumulates bytes of vertex and index buffers which are uploaded to GPU.
+  void AddUploadedBytes(uint32_t bytesCount);
+
+  // Returns recorded events as a JSON object of the Chrome trace event format.
+  std::string ExportTrace();
+
+  // Records a span from construction to destruction if tracing is enabled.
+  class TraceScope
+  {
+  public:
+    TraceScope(std::string const & name, char const * category);
+    ~TraceScope();
+
+    void AddArg(std::string const & name, int64_t value);
+
+  private:
+    std::string const m_name;
+    char const * const m_category;
+    bool const m_isTracing;
+    TTimePoint const m_start;
+    TTraceArgs m_args;
+  };
+
 private:
   DrapeMeasurer() = default;
 
+  struct TraceEvent
+  {
+    std::string m_name;
+    char const * m_category = "";
+    // 'X' for spans and 'C' for counters.
+    char m_phase = 'X';
+    uint32_t m_threadId = 0;
+    int64_t m_timestampUs = 0;
+    int64_t m_durationUs = 0;
+    TTraceArgs m_args;
+  };
+
+  // Must be called under |m_traceMutex|.
+  void AddTraceEventImpl(TraceEvent && event);
+  int64_t GetTraceTimestampUs(TTimePoint timePoint) const;
+
   bool m_isEnabled = false;
 
+  std::atomic<bool> m_isTracing{false};
+  std::mutex m_traceMutex;
+  TTimePoint m_traceStartTime;
+  std::vector<TraceEvent> m_traceEvents;
+  // Chrome trace viewer needs small integer thread ids.
+  std::map<std::thread::id, uint32_t> m_traceThreadIds;
+  uint64_t m_uploadedBytes = 0;
+
 #ifdef GENERATING_STATISTIC
   std::chrono::time_point<std::chrono::steady_clock> m_startScenePreparingTime;
   std::chrono::nanoseconds m_maxScenePreparingTime;
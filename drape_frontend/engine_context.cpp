@@ -43,16 +43,28 @@ void EngineContext::BeginReadTile()
 
 void EngineContext::Flush(TMapShapes && shapes)
 {
+  if (m_recordedShapes)
+  {
+    auto & geometry = m_recordedShapes->m_geometry;
+    geometry.insert(geometry.end(), shapes.begin(), shapes.end());
+  }
   PostMessage(make_unique_dp<MapShapeReadedMessage>(m_tileKey, move(shapes)));
 }
 
 void EngineContext::FlushOverlays(TMapShapes && shapes)
 {
+  if (m_recordedShapes)
+  {
+    auto & overlays = m_recordedShapes->m_overlays;
+    overlays.insert(overlays.end(), shapes.begin(), shapes.end());
+  }
   PostMessage(make_unique_dp<OverlayMapShapeReadedMessage>(m_tileKey, move(shapes)));
 }
 
 void EngineContext::FlushTrafficGeometry(TrafficSegmentsGeometry && geometry)
 {
+  if (m_recordedShapes)
+    m_recordedShapes->m_trafficGeometry = geometry;
   m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
                             make_unique_dp<FlushTrafficGeometryMessage>(m_tileKey, move(geometry)),
                             MessagePriority::Low);
@@ -63,6 +75,28 @@ void EngineContext::EndReadTile()
   PostMessage(make_unique_dp<TileReadEndMessage>(m_tileKey));
 }
 
+void EngineContext::FlushCachedShapes(TileShapes const & shapes)
+{
+  if (!shapes.m_geometry.empty())
+    PostMessage(make_unique_dp<MapShapeReadedMessage>(m_tileKey, TMapShapes(shapes.m_geometry)));
+  if (!shapes.m_overlays.empty())
+  {
+    PostMessage(make_unique_dp<OverlayMapShapeReadedMessage>(m_tileKey,
+                                                             TMapShapes(shapes.m_overlays)));
+  }
+  FlushTrafficGeometry(TrafficSegmentsGeometry(shapes.m_trafficGeometry));
+}
+
+void EngineContext::StartRecording()
+{
+  m_recordedShapes = make_shared<TileShapes>();
+}
+
+shared_ptr<TileShapes> EngineContext::FinishRecording()
+{
+  return move(m_recordedShapes);
+}
+
 void EngineContext::PostMessage(drape_ptr<Message> && message)
 {
   m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread, move(message),
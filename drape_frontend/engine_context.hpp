@@ -4,11 +4,14 @@
 #include "drape_frontend/map_shape.hpp"
 #include "drape_frontend/tile_utils.hpp"
 #include "drape_frontend/threads_commutator.hpp"
+#include "drape_frontend/tile_shapes_cache.hpp"
 #include "drape_frontend/traffic_generator.hpp"
 
 #include "drape/constants.hpp"
 #include "drape/pointers.hpp"
 
+#include <memory>
+
 namespace dp
 {
 class TextureManager;
@@ -45,6 +48,13 @@ public:
   void FlushTrafficGeometry(TrafficSegmentsGeometry && geometry);
   void EndReadTile();
 
+  // Flushes shapes of the tile which were cached by a previous reading.
+  void FlushCachedShapes(TileShapes const & shapes);
+
+  // All shapes flushed after StartRecording() are collected to be put into a cache.
+  void StartRecording();
+  std::shared_ptr<TileShapes> FinishRecording();
+
 private:
   void PostMessage(drape_ptr<Message> && message);
 
@@ -56,5 +66,7 @@ private:
   bool m_3dBuildingsEnabled;
   bool m_trafficEnabled;
   int m_displacementMode;
+
+  std::shared_ptr<TileShapes> m_recordedShapes;
 };
 }  // namespace df
@@ -26,6 +26,8 @@
 #include "indexer/map_style_reader.hpp"
 #include "indexer/scales.hpp"
 
+#include "platform/platform.hpp"
+
 #include "geometry/any_rect2d.hpp"
 
 #include "base/timer.hpp"
@@ -36,6 +38,10 @@
 #include <algorithm>
 #include <cmath>
 #include <chrono>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
 
 using namespace std::placeholders;
 
@@ -46,6 +52,26 @@ namespace
 float constexpr kIsometryAngle = static_cast<float>(math::pi) * 76.0f / 180.0f;
 double const kVSyncInterval = 0.06;
 //double const kVSyncInterval = 0.014;
+// Tiles are evicted until the consumed GPU memory is less than this part of the budget,
+// so we don't have to evict tiles on every flush.
+double const kGpuMemoryEvictionFactor = 0.9;
+// Linked shader programs are cached here to avoid their compilation on start.
+char const * const kShadersCacheDir = "shaders_cache";
+// Buildings of tiles which are farther from the viewer than this number of tile sizes
+// are rendered as flat footprints.
+double const kMax3dBuildingsDistanceInTiles = 3.0;
+// Max number of tiles with extruded buildings, buildings of other tiles are flat.
+size_t const kMaxExtruded3dBuildingsTilesCount = 12;
+
+// In perspective mode the viewer looks at the map from the bottom of the screen.
+m2::PointD GetViewerPoint(ScreenBase const & screen)
+{
+  if (!screen.isPerspective())
+    return screen.GetOrg();
+
+  m2::RectD const & pixelRect = screen.PixelRectIn3d();
+  return screen.PtoG(screen.P3dtoP(m2::PointD(pixelRect.Center().x, pixelRect.maxY())));
+}
 
 struct MergedGroupKey
 {
@@ -193,24 +219,33 @@ void FrontendRenderer::UpdateCanBeDeletedStatus()
 {
   m2::RectD const & screenRect = m_userEventStream.GetCurrentScreen().ClipRect();
 
-  std::vector<m2::RectD> notFinishedTileRects;
-  notFinishedTileRects.reserve(m_notFinishedTiles.size());
-  for (auto const & tileKey : m_notFinishedTiles)
-    notFinishedTileRects.push_back(tileKey.GetGlobalRect());
+  auto const getRects = [](TTilesCollection const & tiles)
+  {
+    std::vector<m2::RectD> rects;
+    rects.reserve(tiles.size());
+    for (auto const & tileKey : tiles)
+      rects.push_back(tileKey.GetGlobalRect());
+    return rects;
+  };
+  std::vector<m2::RectD> const notFinishedTileRects = getRects(m_notFinishedTiles);
+  std::vector<m2::RectD> const tileWithoutOverlaysRects = getRects(m_tilesWithoutOverlays);
 
-  for (RenderLayer & layer : m_layers)
+  for (size_t layerId = 0; layerId < m_layers.size(); ++layerId)
   {
+    RenderLayer & layer = m_layers[layerId];
+    auto const & waitedTileRects = layerId == RenderState::OverlayLayer ? tileWithoutOverlaysRects
+                                                                        : notFinishedTileRects;
     for (auto & group : layer.m_renderGroups)
     {
       if (!group->IsPendingOnDelete())
         continue;
 
       bool canBeDeleted = true;
-      if (!notFinishedTileRects.empty())
+      if (!waitedTileRects.empty())
       {
         m2::RectD const tileRect = group->GetTileKey().GetGlobalRect();
         if (tileRect.IsIntersect(screenRect))
-          canBeDeleted = !HasIntersection(tileRect, notFinishedTileRects);
+          canBeDeleted = !HasIntersection(tileRect, waitedTileRects);
       }
       layer.m_isDirty |= group->UpdateCanBeDeletedStatus(canBeDeleted, m_currentZoomLevel,
                                                          make_ref(m_overlayTree));
@@ -218,6 +253,77 @@ void FrontendRenderer::UpdateCanBeDeletedStatus()
   }
 }
 
+void FrontendRenderer::EvictTilesIfOverBudget()
+{
+  if (m_gpuMemoryBudget == 0)
+    return;
+
+  uint64_t allocatedBytes = dp::GPUMemTracker::Inst().GetAllocatedBytes();
+  if (allocatedBytes <= m_gpuMemoryBudget)
+    return;
+
+  // Only completely read tiles of the current zoom level are evicted. The other tiles
+  // are either still being read or going to be deleted soon.
+  std::map<TileKey, uint64_t> tilesSizes;
+  for (auto const layerId : {RenderState::GeometryLayer, RenderState::Geometry3dLayer,
+                             RenderState::OverlayLayer})
+  {
+    for (auto const & group : m_layers[layerId].m_renderGroups)
+    {
+      TileKey const & key = group->GetTileKey();
+      if (group->IsPendingOnDelete() || key.m_zoomLevel != m_currentZoomLevel ||
+          m_notFinishedTiles.find(key) != m_notFinishedTiles.end())
+      {
+        continue;
+      }
+      tilesSizes[key] += group->GetByteSize();
+    }
+  }
+  if (tilesSizes.size() < 2)
+    return;
+
+  m2::PointD const viewerPoint = GetViewerPoint(m_userEventStream.GetCurrentScreen());
+
+  std::vector<std::pair<double, TileKey>> tiles;
+  tiles.reserve(tilesSizes.size());
+  for (auto const & tileSize : tilesSizes)
+  {
+    tiles.emplace_back(tileSize.first.GetGlobalRect().Center().SquareLength(viewerPoint),
+                       tileSize.first);
+  }
+  std::sort(tiles.begin(), tiles.end(), [](std::pair<double, TileKey> const & l,
+                                           std::pair<double, TileKey> const & r)
+  {
+    return l.first > r.first;
+  });
+
+  // The nearest tile is never evicted.
+  auto const targetBytes = static_cast<uint64_t>(kGpuMemoryEvictionFactor * m_gpuMemoryBudget);
+  TTilesCollection evictedTiles;
+  for (size_t i = 0; i + 1 < tiles.size() && allocatedBytes > targetBytes; ++i)
+  {
+    uint64_t const tileSize = tilesSizes[tiles[i].second];
+    allocatedBytes -= std::min(allocatedBytes, tileSize);
+    evictedTiles.insert(tiles[i].second);
+  }
+
+  auto removePredicate = [&evictedTiles](drape_ptr<RenderGroup> const & group)
+  {
+    return !group->IsPendingOnDelete() &&
+           evictedTiles.find(group->GetTileKey()) != evictedTiles.end();
+  };
+  for (RenderLayer & layer : m_layers)
+    layer.m_isDirty |= RemoveGroups(removePredicate, layer.m_renderGroups, make_ref(m_overlayTree));
+
+  LOG(LINFO, ("GPU memory budget", m_gpuMemoryBudget, "is exceeded,", evictedTiles.size(),
+              "tiles are evicted."));
+
+  // Evicted tiles will be read again when they get into the coverage next time.
+  m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
+                            make_unique_dp<EvictTilesMessage>(std::move(evictedTiles)),
+                            MessagePriority::Normal);
+}
+
 void FrontendRenderer::AcceptMessage(ref_ptr<Message> message)
 {
   switch (message->GetType())
@@ -232,6 +338,7 @@ void FrontendRenderer::AcceptMessage(ref_ptr<Message> message)
       {
         PrepareBucket(state, bucket);
         AddToRenderGroup<RenderGroup>(state, std::move(bucket), key);
+        EvictTilesIfOverBudget();
       }
       break;
     }
@@ -250,7 +357,17 @@ void FrontendRenderer::AcceptMessage(ref_ptr<Message> message)
                                         overlayRenderData.m_tileKey);
         }
       }
+
+      // Overlays of every finished tile have arrived.
+      for (auto it = m_tilesWithoutOverlays.begin(); it != m_tilesWithoutOverlays.end();)
+      {
+        if (m_notFinishedTiles.find(*it) == m_notFinishedTiles.end())
+          it = m_tilesWithoutOverlays.erase(it);
+        else
+          ++it;
+      }
       UpdateCanBeDeletedStatus();
+      EvictTilesIfOverBudget();
 
       m_firstTilesReady = true;
       if (m_firstLaunchAnimationTriggered)
@@ -278,7 +395,10 @@ void FrontendRenderer::AcceptMessage(ref_ptr<Message> message)
         }
       }
       if (changed)
+      {
         UpdateCanBeDeletedStatus();
+        EvictTilesIfOverBudget();
+      }
 
       if (m_notFinishedTiles.empty())
       {
@@ -729,7 +849,6 @@ void FrontendRenderer::AcceptMessage(ref_ptr<Message> message)
       break;
     }
 
-  case Message::RegenerateTraffic:
   case Message::SetSimplifiedTrafficColors:
   case Message::SetDisplacementMode:
   case Message::UpdateMetalines:
@@ -755,6 +874,16 @@ void FrontendRenderer::AcceptMessage(ref_ptr<Message> message)
       break;
     }
 
+  case Message::RegenerateTraffic:
+    {
+      if (!m_trafficEnabled)
+        break;
+      ref_ptr<RegenerateTrafficMessage> msg = message;
+      m_trafficRenderer->UpdateRenderData(make_ref(m_gpuProgramManager), msg->GetMwmId(),
+                                          msg->GetTiles(), msg->AcceptTrafficData());
+      break;
+    }
+
   case Message::ClearTrafficData:
     {
       ref_ptr<ClearTrafficDataMessage> msg = message;
@@ -818,6 +947,14 @@ void FrontendRenderer::AcceptMessage(ref_ptr<Message> message)
       break;
     }
 
+  case Message::SetGpuMemoryBudget:
+    {
+      ref_ptr<SetGpuMemoryBudgetMessage> msg = message;
+      m_gpuMemoryBudget = msg->GetBudgetInBytes();
+      EvictTilesIfOverBudget();
+      break;
+    }
+
   default:
     ASSERT(false, ());
   }
@@ -834,6 +971,10 @@ void FrontendRenderer::UpdateGLResources()
 
   for (auto const & routeData : m_routeRenderer->GetRouteData())
   {
+    // All segments of a subroute are rebuilt together.
+    if (routeData->m_segmentIndex != 0)
+      continue;
+
     auto msg = make_unique_dp<AddSubrouteMessage>(routeData->m_subrouteId,
                                                   routeData->m_subroute,
                                                   m_lastRecacheRouteId);
@@ -1121,6 +1262,7 @@ void FrontendRenderer::EndUpdateOverlayTree()
 
 void FrontendRenderer::RenderScene(ScreenBase const & modelView)
 {
+  DrapeMeasurer::TraceScope traceScope("RenderScene", "frontend");
 #if defined(DRAPE_MEASURER) && (defined(RENDER_STATISTIC) || defined(TRACK_GPU_MEM))
   DrapeMeasurer::Instance().BeforeRenderFrame();
 #endif
@@ -1243,8 +1385,50 @@ void FrontendRenderer::Render3dLayer(ScreenBase const & modelView, bool useFrame
   GLFunctions::glEnable(gl_const::GLDepthTest);
 
   layer.Sort(make_ref(m_overlayTree));
+
+  // Buildings of the nearest tiles are extruded, the rest ones are flat, so walls of
+  // distant buildings don't consume fill rate. Groups of tiles out of view are skipped.
+  m2::RectD const & clipRect = modelView.ClipRect();
+  m2::PointD const viewerPoint = GetViewerPoint(modelView);
+  std::map<TileKey, double> tilesDistances;
+  for (drape_ptr<RenderGroup> const & group : layer.m_renderGroups)
+  {
+    TileKey const & key = group->GetTileKey();
+    if (tilesDistances.find(key) != tilesDistances.end())
+      continue;
+    m2::RectD const tileRect = key.GetGlobalRect();
+    tilesDistances[key] = tileRect.Center().Length(viewerPoint) / tileRect.SizeX();
+  }
+
+  std::vector<std::pair<double, TileKey>> tiles;
+  tiles.reserve(tilesDistances.size());
+  for (auto const & tileDistance : tilesDistances)
+    tiles.emplace_back(tileDistance.second, tileDistance.first);
+  std::sort(tiles.begin(), tiles.end());
+
+  std::set<TileKey> extrudedTiles;
+  for (size_t i = 0; i < tiles.size() && i < kMaxExtruded3dBuildingsTilesCount; ++i)
+  {
+    if (tiles[i].first > kMax3dBuildingsDistanceInTiles)
+      break;
+    extrudedTiles.insert(tiles[i].second);
+  }
+
+  float const zScale = static_cast<float>(modelView.GetZScale());
   for (drape_ptr<RenderGroup> const & group : layer.m_renderGroups)
+  {
+    bool const isExtruded = extrudedTiles.find(group->GetTileKey()) != extrudedTiles.end();
+
+    // Walls of extruded buildings can be seen out of their tile.
+    m2::RectD tileRect = group->GetTileKey().GetGlobalRect();
+    if (isExtruded)
+      tileRect.Scale(2.0);
+    if (!clipRect.IsIntersect(tileRect))
+      continue;
+
+    group->SetZScale(isExtruded ? zScale : 0.0f);
     RenderSingleGroup(modelView, make_ref(group));
+  }
 
   if (useFramebuffer)
   {
@@ -1305,6 +1489,7 @@ void FrontendRenderer::RenderUserMarksLayer(ScreenBase const & modelView, Render
 
 void FrontendRenderer::BuildOverlayTree(ScreenBase const & modelView)
 {
+  DrapeMeasurer::TraceScope traceScope("BuildOverlayTree", "frontend");
   static std::vector<RenderState::DepthLayer> layers = {RenderState::OverlayLayer,
                                                         RenderState::LocalAdsMarkLayer,
                                                         RenderState::NavigationLayer,
@@ -1661,6 +1846,7 @@ TTilesCollection FrontendRenderer::ResolveTileKeys(ScreenBase const & screen)
   int const dataZoomLevel = ClipTileZoomByMaxDataZoom(m_currentZoomLevel);
 
   m_notFinishedTiles.clear();
+  m_tilesWithoutOverlays.clear();
 
   // Request new tiles.
   TTilesCollection tiles;
@@ -1673,6 +1859,7 @@ TTilesCollection FrontendRenderer::ResolveTileKeys(ScreenBase const & screen)
     {
       tiles.insert(key);
       m_notFinishedTiles.insert(key);
+      m_tilesWithoutOverlays.insert(key);
     }
     else
     {
@@ -1768,7 +1955,8 @@ void FrontendRenderer::OnContextCreate()
   dp::SupportManager::Instance().Init();
 
   m_gpuProgramManager = make_unique_dp<dp::GpuProgramManager>();
-  m_gpuProgramManager->Init(make_unique_dp<gpu::ShaderMapper>(m_apiVersion));
+  m_gpuProgramManager->Init(make_unique_dp<gpu::ShaderMapper>(m_apiVersion),
+                            GetPlatform().WritablePathForFile(kShadersCacheDir));
 
   dp::BlendingParams blendingParams;
   blendingParams.Apply();
@@ -227,6 +227,7 @@ private:
   void InvalidateRect(m2::RectD const & gRect);
   bool CheckTileGenerations(TileKey const & tileKey);
   void UpdateCanBeDeletedStatus();
+  void EvictTilesIfOverBudget();
 
   void OnCompassTapped();
 
@@ -277,6 +278,9 @@ private:
 
   ScreenBase m_lastReadedModelView;
   TTilesCollection m_notFinishedTiles;
+  // Overlays are flushed when all requested tiles are read, so pending on delete overlays
+  // of parent tiles are kept until overlays of these tiles arrive.
+  TTilesCollection m_tilesWithoutOverlays;
 
   int m_currentZoomLevel = -1;
 
@@ -285,6 +289,9 @@ private:
   uint64_t m_maxUserMarksGeneration;
   int m_mergeBucketsCounter = 0;
 
+  // Zero budget means no limit.
+  uint64_t m_gpuMemoryBudget = 0;
+
   int m_lastRecacheRouteId = 0;
 
   struct FollowRouteData
@@ -100,16 +100,18 @@ void GpsTrackRenderer::ClearRenderData()
 void GpsTrackRenderer::UpdatePoints(std::vector<GpsTrackPoint> const & toAdd,
                                     std::vector<uint32_t> const & toRemove)
 {
-  bool wasChanged = false;
+  bool wasRemoved = false;
   if (!toRemove.empty())
   {
-    auto removePredicate = [&toRemove](GpsTrackPoint const & pt)
+    std::vector<uint32_t> sortedToRemove = toRemove;
+    std::sort(sortedToRemove.begin(), sortedToRemove.end());
+    auto removePredicate = [&sortedToRemove](GpsTrackPoint const & pt)
     {
-      return std::find(toRemove.begin(), toRemove.end(), pt.m_id) != toRemove.end();
+      return std::binary_search(sortedToRemove.begin(), sortedToRemove.end(), pt.m_id);
     };
     m_points.erase(std::remove_if(m_points.begin(), m_points.end(), removePredicate),
                    m_points.end());
-    wasChanged = true;
+    wasRemoved = true;
   }
 
   if (!toAdd.empty())
@@ -118,15 +120,20 @@ void GpsTrackRenderer::UpdatePoints(std::vector<GpsTrackPoint> const & toAdd,
     if (!m_points.empty())
       ASSERT(GpsPointsSortPredicate(m_points.back(), toAdd.front()), ());
     m_points.insert(m_points.end(), toAdd.begin(), toAdd.end());
-    wasChanged = true;
   }
 
-  if (wasChanged)
+  // Points are mostly appended, so the spline is rebuilt only after removal.
+  if (wasRemoved)
   {
     m_pointsSpline = m2::Spline(m_points.size());
     for (size_t i = 0; i < m_points.size(); i++)
       m_pointsSpline.AddPoint(m_points[i].m_point);
   }
+  else
+  {
+    for (auto const & pt : toAdd)
+      m_pointsSpline.AddPoint(pt.m_point);
+  }
 
   m_needUpdate = true;
 }
@@ -327,6 +334,7 @@ void GpsTrackRenderer::Update()
 void GpsTrackRenderer::Clear()
 {
   m_points.clear();
+  m_pointsSpline.Clear();
   m_needUpdate = true;
 }
 }  // namespace df
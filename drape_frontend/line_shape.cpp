@@ -55,6 +55,18 @@ private:
   float const m_maskLength;
 };
 
+// Returns the number of segments of |path| which produce geometry.
+size_t GetSegmentsCount(vector<m2::PointD> const & path)
+{
+  size_t count = 0;
+  for (size_t i = 1; i < path.size(); ++i)
+  {
+    if (!path[i].EqualDxDy(path[i - 1], 1.0E-5))
+      ++count;
+  }
+  return count;
+}
+
 struct BaseBuilderParams
 {
   dp::TextureManager::ColorRegion m_color;
@@ -69,12 +81,11 @@ template <typename TVertex>
 class BaseLineBuilder : public ILineShapeInfo
 {
 public:
-  BaseLineBuilder(BaseBuilderParams const & params, size_t geomsSize, size_t joinsSize)
+  BaseLineBuilder(BaseBuilderParams const & params, size_t geomsSize)
     : m_params(params)
     , m_colorCoord(glsl::ToVec2(params.m_color.GetTexRect().Center()))
   {
     m_geometry.reserve(geomsSize);
-    m_joinGeom.reserve(joinsSize);
   }
 
   dp::BindingInfo const & GetBindingInfo() override
@@ -139,8 +150,6 @@ protected:
   TGeometryBuffer m_geometry;
   TGeometryBuffer m_joinGeom;
 
-  vector<glsl::vec2> m_normalBuffer;
-
   BaseBuilderParams m_params;
   glsl::vec2 const m_colorCoord;
 };
@@ -173,9 +182,16 @@ class SolidLineBuilder : public BaseLineBuilder<gpu::LineVertex>
 public:
   using BuilderParams = BaseBuilderParams;
 
-  SolidLineBuilder(BuilderParams const & params, size_t pointsInSpline)
-    : TBase(params, pointsInSpline * 2, (pointsInSpline - 2) * 8)
-  {}
+  // Buffers are reserved for the exact number of vertices, every segment is a quad and
+  // every join and cap is a triangle.
+  SolidLineBuilder(BuilderParams const & params, size_t segmentsCount)
+    : TBase(params, segmentsCount * 4)
+  {
+    size_t capsCount = params.m_cap != dp::ButtCap ? 2 : 0;
+    if (params.m_join == dp::RoundJoin && segmentsCount > 1)
+      capsCount += segmentsCount - 1;
+    m_capGeometry.reserve(capsCount * 3);
+  }
 
   dp::GLState GetState() override
   {
@@ -249,7 +265,6 @@ private:
     static float const kSqrt3 = sqrt(3.0f);
     float const radius = GetHalfWidth();
 
-    m_capGeometry.reserve(3);
     m_capGeometry.push_back(CapVertex(CapVertex::TPosition(pos, m_params.m_depth),
                                       CapVertex::TNormal(-radius * kSqrt3, -radius, radius),
                                       CapVertex::TTexCoord(m_colorCoord)));
@@ -273,7 +288,7 @@ public:
   using BuilderParams = BaseBuilderParams;
 
   SimpleSolidLineBuilder(BuilderParams const & params, size_t pointsInSpline, int lineWidth)
-    : TBase(params, pointsInSpline, 0)
+    : TBase(params, pointsInSpline)
     , m_lineWidth(lineWidth)
   {}
 
@@ -308,12 +323,15 @@ public:
     float m_baseGtoP;
   };
 
-  DashedLineBuilder(BuilderParams const & params, size_t pointsInSpline)
-    : TBase(params, pointsInSpline * 8, (pointsInSpline - 2) * 8)
+  // Buffers are reserved by Reserve() when the number of dashes is known.
+  explicit DashedLineBuilder(BuilderParams const & params)
+    : TBase(params, 0)
     , m_texCoordGen(params.m_stipple)
     , m_baseGtoPScale(params.m_baseGtoP)
   {}
 
+  void Reserve(size_t dashesCount) { m_geometry.reserve(dashesCount * 4); }
+
   int GetDashesCount(float const globalLength) const
   {
     float const pixelLen = globalLength * m_baseGtoPScale;
@@ -361,21 +379,36 @@ template <>
 void LineShape::Construct<DashedLineBuilder>(DashedLineBuilder & builder) const
 {
   vector<m2::PointD> const & path = m_spline->GetPath();
+  // Lengths of segments are calculated by the spline, |lengths[i - 1]| is the length of
+  // the segment which ends at |path[i]|.
+  vector<double> const & lengths = m_spline->GetLengths();
   ASSERT_GREATER(path.size(), 1, ());
+  ASSERT_EQUAL(lengths.size() + 1, path.size(), ());
+
+  size_t dashesCount = 0;
+  for (size_t i = 1; i < path.size(); ++i)
+  {
+    if (!path[i].EqualDxDy(path[i - 1], 1.0E-5))
+      dashesCount += max(1, builder.GetDashesCount(static_cast<float>(lengths[i - 1])));
+  }
+  builder.Reserve(dashesCount);
 
   // build geometry
+  glsl::vec2 p1 = glsl::ToVec2(ConvertToLocal(path.front(), m_params.m_tileCenter, kShapeCoordScalar));
   for (size_t i = 1; i < path.size(); ++i)
   {
+    glsl::vec2 const p2 = glsl::ToVec2(ConvertToLocal(path[i], m_params.m_tileCenter, kShapeCoordScalar));
     if (path[i].EqualDxDy(path[i - 1], 1.0E-5))
+    {
+      p1 = p2;
       continue;
+    }
 
-    glsl::vec2 const p1 = glsl::ToVec2(ConvertToLocal(path[i - 1], m_params.m_tileCenter, kShapeCoordScalar));
-    glsl::vec2 const p2 = glsl::ToVec2(ConvertToLocal(path[i], m_params.m_tileCenter, kShapeCoordScalar));
     glsl::vec2 tangent, leftNormal, rightNormal;
     CalculateTangentAndNormals(p1, p2, tangent, leftNormal, rightNormal);
 
     // calculate number of steps to cover line segment
-    float const initialGlobalLength = static_cast<float>((path[i] - path[i - 1]).Length());
+    float const initialGlobalLength = static_cast<float>(lengths[i - 1]);
     int const steps = max(1, builder.GetDashesCount(initialGlobalLength));
     float const maskSize = glsl::length(p2 - p1) / steps;
     float const offsetSize = initialGlobalLength / steps;
@@ -395,6 +428,7 @@ void LineShape::Construct<DashedLineBuilder>(DashedLineBuilder & builder) const
 
       currentStartPivot = newPivot;
     }
+    p1 = p2;
   }
 }
 
@@ -411,17 +445,20 @@ void LineShape::Construct<SolidLineBuilder>(SolidLineBuilder & builder) const
   if (builder.GetHalfWidth() <= kJoinsGenerationThreshold)
     generateJoins = false;
 
-  // build geometry
-  glsl::vec2 firstPoint = glsl::ToVec2(ConvertToLocal(path.front(), m_params.m_tileCenter, kShapeCoordScalar));
+  // build geometry, every point is converted to local coordinates once
+  glsl::vec2 const firstPoint = glsl::ToVec2(ConvertToLocal(path.front(), m_params.m_tileCenter, kShapeCoordScalar));
+  glsl::vec2 p1 = firstPoint;
   glsl::vec2 lastPoint;
   bool hasConstructedSegments = false;
   for (size_t i = 1; i < path.size(); ++i)
   {
+    glsl::vec2 const p2 = glsl::ToVec2(ConvertToLocal(path[i], m_params.m_tileCenter, kShapeCoordScalar));
     if (path[i].EqualDxDy(path[i - 1], 1.0E-5))
+    {
+      p1 = p2;
       continue;
+    }
 
-    glsl::vec2 const p1 = glsl::ToVec2(ConvertToLocal(path[i - 1], m_params.m_tileCenter, kShapeCoordScalar));
-    glsl::vec2 const p2 = glsl::ToVec2(ConvertToLocal(path[i], m_params.m_tileCenter, kShapeCoordScalar));
     glsl::vec2 tangent, leftNormal, rightNormal;
     CalculateTangentAndNormals(p1, p2, tangent, leftNormal, rightNormal);
 
@@ -438,6 +475,7 @@ void LineShape::Construct<SolidLineBuilder>(SolidLineBuilder & builder) const
       builder.SubmitJoin(p2);
 
     lastPoint = p2;
+    p1 = p2;
     hasConstructedSegments = true;
   }
 
@@ -514,7 +552,7 @@ void LineShape::Prepare(ref_ptr<dp::TextureManager> textures) const
     {
       SolidLineBuilder::BuilderParams p;
       commonParamsBuilder(p);
-      auto builder = make_unique<SolidLineBuilder>(p, m_spline->GetPath().size());
+      auto builder = make_unique<SolidLineBuilder>(p, GetSegmentsCount(m_spline->GetPath()));
       Construct<SolidLineBuilder>(*builder);
       m_lineShapeInfo = move(builder);
     }
@@ -530,7 +568,7 @@ void LineShape::Prepare(ref_ptr<dp::TextureManager> textures) const
     p.m_baseGtoP = m_params.m_baseGtoPScale;
     p.m_glbHalfWidth = pxHalfWidth / m_params.m_baseGtoPScale;
 
-    auto builder = make_unique<DashedLineBuilder>(p, m_spline->GetPath().size());
+    auto builder = make_unique<DashedLineBuilder>(p);
     Construct<DashedLineBuilder>(*builder);
     m_lineShapeInfo = move(builder);
   }
@@ -7,6 +7,7 @@
 
 #include "geometry/point2d.hpp"
 
+#include "std/shared_ptr.hpp"
 #include "std/vector.hpp"
 
 namespace dp
@@ -46,7 +47,8 @@ private:
   int m_minZoom = 0;
 };
 
-using TMapShapes = vector<drape_ptr<MapShape>>;
+// Shapes are shared, because shapes of a tile are kept in TileShapesCache after drawing.
+using TMapShapes = vector<shared_ptr<MapShape>>;
 
 class MapShapeMessage : public Message
 {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+
 namespace df
 {
 
@@ -83,11 +85,21 @@ public:
     RunFirstLaunchAnimation,
     UpdateMetalines,
     PostUserEvent,
+    SetGpuMemoryBudget,
+    EvictTiles,
   };
 
   virtual ~Message() {}
   virtual Type GetType() const { return Unknown; }
   virtual bool IsGLContextDependent() const { return false; }
+
+  // Time of posting is tracked only while DrapeMeasurer is tracing.
+  using TTimePoint = std::chrono::steady_clock::time_point;
+  void SetPostTime(TTimePoint postTime) { m_postTime = postTime; }
+  TTimePoint GetPostTime() const { return m_postTime; }
+
+private:
+  TTimePoint m_postTime;
 };
 
 enum class MessagePriority
@@ -1,25 +1,69 @@
 #include "drape_frontend/message_acceptor.hpp"
 
+#include "drape_frontend/drape_measurer.hpp"
 #include "drape_frontend/message.hpp"
 
+#include <string>
+
 namespace df
 {
+namespace
+{
+// Messages of higher priority posted after a batch is taken wait for the batch,
+// so the batch is small.
+size_t const kMessagesBatchSize = 16;
+}  // namespace
 
 MessageAcceptor::MessageAcceptor()
   : m_infinityWaiting(false)
+  , m_isQueueClosed(false)
 {
 }
 
 bool MessageAcceptor::ProcessSingleMessage(bool waitForMessage)
 {
-  m_infinityWaiting = waitForMessage;
-  drape_ptr<Message> message = m_messageQueue.PopMessage(waitForMessage);
-  m_infinityWaiting = false;
-
-  if (message == nullptr)
+  if (m_isQueueClosed)
+  {
+    m_messagesBatch.clear();
     return false;
-
+  }
+
+  if (m_messagesBatch.empty())
+  {
+    m_infinityWaiting = waitForMessage;
+    bool const hasMessages = m_messageQueue.PopMessages(waitForMessage, kMessagesBatchSize,
+                                                        m_messagesBatch);
+    m_infinityWaiting = false;
+
+    if (!hasMessages)
+      return false;
+  }
+
+  drape_ptr<Message> message = std::move(m_messagesBatch.front());
+  m_messagesBatch.pop_front();
+
+  auto & measurer = DrapeMeasurer::Instance();
+  if (!measurer.IsTracing())
+  {
+    AcceptMessage(make_ref(message));
+    return true;
+  }
+
+  // Messages are named by numbers of their types in Message::Type.
+  auto const type = message->GetType();
+  auto const postTime = message->GetPostTime();
+  auto const start = std::chrono::steady_clock::now();
   AcceptMessage(make_ref(message));
+  auto const end = std::chrono::steady_clock::now();
+
+  DrapeMeasurer::TTraceArgs args;
+  if (postTime != Message::TTimePoint())
+  {
+    using namespace std::chrono;
+    args.emplace_back("latency_us", duration_cast<microseconds>(start - postTime).count());
+  }
+  measurer.AddTraceEvent("Message " + std::to_string(static_cast<int>(type)), "message", start,
+                         end, std::move(args));
   return true;
 }
 
@@ -29,6 +73,14 @@ void MessageAcceptor::EnableMessageFiltering(TFilterMessageFn needFilterMessageF
 
   m_needFilterMessageFn = needFilterMessageFn;
   m_messageQueue.FilterMessages(needFilterMessageFn);
+
+  for (auto it = m_messagesBatch.begin(); it != m_messagesBatch.end();)
+  {
+    if (needFilterMessageFn(make_ref(*it)))
+      it = m_messagesBatch.erase(it);
+    else
+      ++it;
+  }
 }
 
 void MessageAcceptor::DisableMessageFiltering()
@@ -41,11 +93,14 @@ void MessageAcceptor::PostMessage(drape_ptr<Message> && message, MessagePriority
   if (m_needFilterMessageFn != nullptr && m_needFilterMessageFn(make_ref(message)))
     return;
 
+  if (DrapeMeasurer::Instance().IsTracing())
+    message->SetPostTime(std::chrono::steady_clock::now());
   m_messageQueue.PushMessage(move(message), priority);
 }
 
 void MessageAcceptor::CloseQueue()
 {
+  m_isQueueClosed = true;
   m_messageQueue.CancelWait();
   m_messageQueue.ClearQuery();
 }
@@ -67,11 +122,11 @@ bool MessageAcceptor::IsQueueEmpty() const
   return m_messageQueue.IsEmpty();
 }
 
+#endif
+
 size_t MessageAcceptor::GetQueueSize() const
 {
   return m_messageQueue.GetSize();
 }
 
-#endif
-
 } // namespace df
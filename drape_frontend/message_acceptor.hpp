@@ -5,6 +5,7 @@
 #include "drape/pointers.hpp"
 
 #include "std/atomic.hpp"
+#include "std/deque.hpp"
 
 namespace df
 {
@@ -30,8 +31,8 @@ protected:
 
 #ifdef DEBUG_MESSAGE_QUEUE
   bool IsQueueEmpty() const;
-  size_t GetQueueSize() const;
 #endif
+  size_t GetQueueSize() const;
 
   using TFilterMessageFn = function<bool (ref_ptr<Message>)>;
   void EnableMessageFiltering(TFilterMessageFn needFilterMessageFn);
@@ -43,7 +44,11 @@ private:
   void PostMessage(drape_ptr<Message> && message, MessagePriority priority);
 
   MessageQueue m_messageQueue;
+  // Messages are taken from the queue in batches to lock it once per several messages.
+  // The batch is accessed on the target thread only.
+  deque<drape_ptr<Message>> m_messagesBatch;
   atomic<bool> m_infinityWaiting;
+  atomic<bool> m_isQueueClosed;
   TFilterMessageFn m_needFilterMessageFn;
 };
 
@@ -2,6 +2,7 @@
 
 #include "base/assert.hpp"
 #include "base/stl_add.hpp"
+#include "base/trace.hpp"
 
 #include "std/chrono.hpp"
 
@@ -19,9 +20,13 @@ MessageQueue::~MessageQueue()
   ClearQuery();
 }
 
-drape_ptr<Message> MessageQueue::PopMessage(bool waitForMessage)
+bool MessageQueue::PopMessages(bool waitForMessage, size_t maxCount,
+                               deque<drape_ptr<Message>> & messages)
 {
-  unique_lock<mutex> lock(m_mutex);
+  ASSERT_GREATER(maxCount, 0, ());
+
+  unique_lock<mutex> lock(m_mutex, defer_lock);
+  base::trace::Lock(lock, "MessageQueue");
   if (waitForMessage && m_messages.empty() && m_lowPriorityMessages.empty())
   {
     m_isWaiting = true;
@@ -30,23 +35,32 @@ drape_ptr<Message> MessageQueue::PopMessage(bool waitForMessage)
   }
 
   if (m_messages.empty() && m_lowPriorityMessages.empty())
-    return nullptr;
+    return false;
 
-  if (!m_messages.empty())
+  // Low priority messages are taken only if there are no other messages.
+  size_t count = 0;
+  while (count < maxCount && !m_messages.empty())
   {
-    drape_ptr<Message> msg = move(m_messages.front().first);
+    messages.push_back(move(m_messages.front().first));
     m_messages.pop_front();
-    return msg;
+    ++count;
   }
 
-  drape_ptr<Message> msg = move(m_lowPriorityMessages.front());
-  m_lowPriorityMessages.pop_front();
-  return msg;
+  if (count == 0)
+  {
+    while (count < maxCount && !m_lowPriorityMessages.empty())
+    {
+      messages.push_back(move(m_lowPriorityMessages.front()));
+      m_lowPriorityMessages.pop_front();
+      ++count;
+    }
+  }
+  return true;
 }
 
 void MessageQueue::PushMessage(drape_ptr<Message> && message, MessagePriority priority)
 {
-  lock_guard<mutex> lock(m_mutex);
+  base::trace::LockGuard<mutex> lock(m_mutex, "MessageQueue");
 
   switch (priority)
   {
@@ -96,7 +110,7 @@ void MessageQueue::FilterMessages(TFilterMessageFn needFilterMessageFn)
 {
   ASSERT(needFilterMessageFn != nullptr, ());
 
-  lock_guard<mutex> lock(m_mutex);
+  base::trace::LockGuard<mutex> lock(m_mutex, "MessageQueue");
   for (auto it = m_messages.begin(); it != m_messages.end(); )
   {
     if (needFilterMessageFn(make_ref(it->first)))
@@ -118,21 +132,21 @@ void MessageQueue::FilterMessages(TFilterMessageFn needFilterMessageFn)
 
 bool MessageQueue::IsEmpty() const
 {
-  lock_guard<mutex> lock(m_mutex);
+  base::trace::LockGuard<mutex> lock(m_mutex, "MessageQueue");
   return m_messages.empty() && m_lowPriorityMessages.empty();
 }
 
+#endif
+
 size_t MessageQueue::GetSize() const
 {
-  lock_guard<mutex> lock(m_mutex);
+  base::trace::LockGuard<mutex> lock(m_mutex, "MessageQueue");
   return m_messages.size() + m_lowPriorityMessages.size();
 }
 
-#endif
-
 void MessageQueue::CancelWait()
 {
-  lock_guard<mutex> lock(m_mutex);
+  base::trace::LockGuard<mutex> lock(m_mutex, "MessageQueue");
   CancelWaitImpl();
 }
 
@@ -22,8 +22,9 @@ public:
   MessageQueue();
   ~MessageQueue();
 
-  /// if queue is empty then return NULL
-  drape_ptr<Message> PopMessage(bool waitForMessage);
+  /// Moves up to |maxCount| messages to the back of |messages| in order of processing.
+  /// Returns false if queue is empty.
+  bool PopMessages(bool waitForMessage, size_t maxCount, deque<drape_ptr<Message>> & messages);
   void PushMessage(drape_ptr<Message> && message, MessagePriority priority);
   void CancelWait();
   void ClearQuery();
@@ -33,8 +34,8 @@ public:
 
 #ifdef DEBUG_MESSAGE_QUEUE
   bool IsEmpty() const;
-  size_t GetSize() const;
 #endif
+  size_t GetSize() const;
 
 private:
   void CancelWaitImpl();
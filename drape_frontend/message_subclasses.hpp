@@ -1002,7 +1002,24 @@ private:
 class RegenerateTrafficMessage : public Message
 {
 public:
+  RegenerateTrafficMessage(MwmSet::MwmId const & mwmId, vector<TileKey> && tiles,
+                           vector<TrafficRenderData> && trafficData)
+    : m_mwmId(mwmId)
+    , m_tiles(move(tiles))
+    , m_trafficData(move(trafficData))
+  {}
+
   Type GetType() const override { return Message::RegenerateTraffic; }
+  bool IsGLContextDependent() const override { return true; }
+
+  MwmSet::MwmId const & GetMwmId() const { return m_mwmId; }
+  vector<TileKey> const & GetTiles() const { return m_tiles; }
+  vector<TrafficRenderData> && AcceptTrafficData() { return move(m_trafficData); }
+
+private:
+  MwmSet::MwmId const m_mwmId;
+  vector<TileKey> m_tiles;
+  vector<TrafficRenderData> m_trafficData;
 };
 
 class UpdateTrafficMessage : public Message
@@ -1222,4 +1239,34 @@ public:
 private:
   drape_ptr<UserEvent> m_event;
 };
+
+class SetGpuMemoryBudgetMessage : public Message
+{
+public:
+  explicit SetGpuMemoryBudgetMessage(uint64_t budgetInBytes)
+    : m_budgetInBytes(budgetInBytes)
+  {}
+
+  Type GetType() const override { return Message::SetGpuMemoryBudget; }
+
+  uint64_t GetBudgetInBytes() const { return m_budgetInBytes; }
+
+private:
+  uint64_t const m_budgetInBytes;
+};
+
+class EvictTilesMessage : public Message
+{
+public:
+  explicit EvictTilesMessage(TTilesCollection && tiles)
+    : m_tiles(std::move(tiles))
+  {}
+
+  Type GetType() const override { return Message::EvictTiles; }
+
+  TTilesCollection const & GetTiles() const { return m_tiles; }
+
+private:
+  TTilesCollection m_tiles;
+};
 }  // namespace df
@@ -56,13 +56,32 @@ void MetalineManager::Update(std::set<MwmSet::MwmId> const & mwms)
   }
 }
 
-m2::SharedSpline MetalineManager::GetMetaline(FeatureID const & fid) const
+m2::SharedSpline MetalineManager::GetMetaline(FeatureID const & fid)
 {
+  MetalineData metaline;
+  {
+    std::lock_guard<std::mutex> lock(m_metalineCacheMutex);
+    auto const metalineIt = m_metalineCache.find(fid);
+    if (metalineIt != m_metalineCache.end())
+      return metalineIt->second;
+
+    auto const mwmIt = m_mwmsMetalines.find(fid.m_mwmId);
+    if (mwmIt == m_mwmsMetalines.end())
+      return m2::SharedSpline();
+    auto const indexIt = mwmIt->second.m_metalineIndices.find(fid.m_index);
+    if (indexIt == mwmIt->second.m_metalineIndices.end())
+      return m2::SharedSpline();
+    metaline = mwmIt->second.m_metalines[indexIt->second];
+  }
+
+  // Features are read without the lock, so the metaline can be merged by several
+  // threads at once. The spline which is put into the cache first is used.
+  m2::SharedSpline const spline = MergeMetaline(m_model, metaline);
+
   std::lock_guard<std::mutex> lock(m_metalineCacheMutex);
-  auto const metalineIt = m_metalineCache.find(fid);
-  if (metalineIt == m_metalineCache.end())
-    return m2::SharedSpline();
-  return metalineIt->second;
+  for (auto const & featureId : metaline.m_features)
+    m_metalineCache.emplace(featureId, spline);
+  return m_metalineCache[fid];
 }
 
 void MetalineManager::OnTaskFinished(threads::IRoutine * task)
@@ -70,21 +89,17 @@ void MetalineManager::OnTaskFinished(threads::IRoutine * task)
   ASSERT(dynamic_cast<ReadMetalineTask *>(task) != nullptr, ());
   ReadMetalineTask * t = static_cast<ReadMetalineTask *>(task);
 
-  // Update metaline cache.
-  if (!task->IsCancelled())
+  if (!task->IsCancelled() && !t->GetMetalines().m_metalines.empty())
   {
-    std::lock_guard<std::mutex> lock(m_metalineCacheMutex);
-    auto const & metalines = t->GetMetalines();
-    for (auto const & metaline : metalines)
-      m_metalineCache[metaline.first] = metaline.second;
-
-    if (!metalines.empty())
     {
-      LOG(LDEBUG, ("Metalines prepared:", t->GetMwmId()));
-      m_commutator->PostMessage(ThreadsCommutator::RenderThread,
-                                make_unique_dp<UpdateMetalinesMessage>(),
-                                MessagePriority::Normal);
+      std::lock_guard<std::mutex> lock(m_metalineCacheMutex);
+      m_mwmsMetalines[t->GetMwmId()] = std::move(t->GetMetalines());
     }
+
+    LOG(LDEBUG, ("Metalines prepared:", t->GetMwmId()));
+    m_commutator->PostMessage(ThreadsCommutator::RenderThread,
+                              make_unique_dp<UpdateMetalinesMessage>(),
+                              MessagePriority::Normal);
   }
 
   t->Reset();
@@ -7,6 +7,7 @@
 
 #include "indexer/feature_decl.hpp"
 
+#include <map>
 #include <mutex>
 #include <set>
 
@@ -25,7 +26,9 @@ public:
 
   void Update(std::set<MwmSet::MwmId> const & mwms);
 
-  m2::SharedSpline GetMetaline(FeatureID const & fid) const;
+  // Returns the merged spline of a metaline which the feature belongs to. Splines are
+  // merged on the first request and shared by all tiles.
+  m2::SharedSpline GetMetaline(FeatureID const & fid);
 
 private:
   void OnTaskFinished(threads::IRoutine * task);
@@ -34,8 +37,9 @@ private:
 
   MapDataProvider & m_model;
 
+  std::map<MwmSet::MwmId, MwmMetalines> m_mwmsMetalines;
   MetalineCache m_metalineCache;
-  mutable std::mutex m_metalineCacheMutex;
+  std::mutex m_metalineCacheMutex;
 
   std::set<MwmSet::MwmId> m_mwms;
   std::mutex m_mwmsMutex;
@@ -24,7 +24,7 @@ OverlayBatcher::OverlayBatcher(TileKey const & key)
   });
 }
 
-void OverlayBatcher::Batch(drape_ptr<MapShape> const & shape, ref_ptr<dp::TextureManager> texMng)
+void OverlayBatcher::Batch(shared_ptr<MapShape> const & shape, ref_ptr<dp::TextureManager> texMng)
 {
   m_batcher.SetFeatureMinZoom(shape->GetFeatureMinZoom());
   shape->Draw(make_ref(&m_batcher), texMng);
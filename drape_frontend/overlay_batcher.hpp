@@ -6,6 +6,7 @@
 #include "drape/batcher.hpp"
 #include "drape/pointers.hpp"
 
+#include "std/shared_ptr.hpp"
 #include "std/vector.hpp"
 
 namespace dp
@@ -36,7 +37,7 @@ class OverlayBatcher
 {
 public:
   OverlayBatcher(TileKey const & key);
-  void Batch(drape_ptr<MapShape> const & shape, ref_ptr<dp::TextureManager> texMng);
+  void Batch(shared_ptr<MapShape> const & shape, ref_ptr<dp::TextureManager> texMng);
   void Finish(TOverlaysRenderData & data);
 
 private:
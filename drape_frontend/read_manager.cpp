@@ -5,16 +5,23 @@
 
 #include "drape/constants.hpp"
 
+#include "platform/platform.hpp"
+
 #include "base/buffer_vector.hpp"
 #include "base/stl_add.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <functional>
+#include <iterator>
 
 namespace df
 {
 namespace
 {
+// Tiles of a couple of screens around the current one.
+size_t constexpr kMaxCachedTilesCount = 64;
+
 struct LessCoverageCell
 {
   bool operator()(std::shared_ptr<TileInfo> const & l,
@@ -35,8 +42,44 @@ struct LessCoverageCell
     return l->GetTileKey() < r->GetTileKey();
   }
 };
+
+// Sorts |tiles| in the order of reading: tiles of the current zoom level go first,
+// then tiles are ordered by the distance from the viewport center. So visible tiles
+// which are in the focus of the user are read before tiles on the edges of the screen.
+template <typename TTiles>
+void SortByReadingPriority(ScreenBase const & screen, TTiles & tiles)
+{
+  int const zoomLevel = df::GetDrawTileScale(screen);
+  m2::PointD const center = screen.GlobalRect().GlobalCenter();
+  std::sort(tiles.begin(), tiles.end(), [&](TileKey const & l, TileKey const & r)
+  {
+    int const lZoomDiff = std::abs(l.m_zoomLevel - zoomLevel);
+    int const rZoomDiff = std::abs(r.m_zoomLevel - zoomLevel);
+    if (lZoomDiff != rZoomDiff)
+      return lZoomDiff < rZoomDiff;
+    return l.GetGlobalRect().Center().SquareLength(center) <
+           r.GetGlobalRect().Center().SquareLength(center);
+  });
+}
 }  // namespace
 
+uint8_t GetReadingThreadsCount()
+{
+  uint8_t constexpr kMinThreadsCount = 2;
+  uint8_t constexpr kMaxThreadsCount = 4;
+  // Frontend and backend renderers take two cores.
+  unsigned const kBusyCoresCount = 2;
+
+  static uint8_t const threadsCount = [&]() -> uint8_t
+  {
+    unsigned const cores = GetPlatform().CpuCores();
+    if (cores <= kBusyCoresCount + kMinThreadsCount)
+      return kMinThreadsCount;
+    return static_cast<uint8_t>(std::min<unsigned>(cores - kBusyCoresCount, kMaxThreadsCount));
+  }();
+  return threadsCount;
+}
+
 bool ReadManager::LessByTileInfo::operator()(std::shared_ptr<TileInfo> const & l,
                                              std::shared_ptr<TileInfo> const & r) const
 {
@@ -56,6 +99,7 @@ ReadManager::ReadManager(ref_ptr<ThreadsCommutator> commutator, MapDataProvider
   , m_counter(0)
   , m_generationCounter(0)
   , m_userMarksGenerationCounter(0)
+  , m_shapesCache(kMaxCachedTilesCount)
 {
   Start();
 }
@@ -66,7 +110,7 @@ void ReadManager::Start()
     return;
 
   using namespace std::placeholders;
-  m_pool = make_unique_dp<threads::ThreadPool>(kReadingThreadsCount,
+  m_pool = make_unique_dp<threads::ThreadPool>(GetReadingThreadsCount(),
                                                std::bind(&ReadManager::OnTaskFinished, this, _1));
 }
 
@@ -93,16 +137,6 @@ void ReadManager::OnTaskFinished(threads::IRoutine * task)
   {
     std::lock_guard<std::mutex> lock(m_finishedTilesMutex);
 
-    // decrement counter
-    ASSERT(m_counter > 0, ());
-    --m_counter;
-    if (m_counter == 0)
-    {
-      m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
-                                make_unique_dp<FinishReadingMessage>(),
-                                MessagePriority::Normal);
-    }
-
     if (!task->IsCancelled())
     {
       m_activeTiles.erase(t->GetTileKey());
@@ -114,6 +148,17 @@ void ReadManager::OnTaskFinished(threads::IRoutine * task)
                                                                       false /* forceUpdateUserMarks */),
                                 MessagePriority::Normal);
     }
+
+    // The tile is reported as finished before the end of reading, so FrontendRenderer
+    // knows that overlays of all finished tiles come with FinishReading.
+    ASSERT(m_counter > 0, ());
+    --m_counter;
+    if (m_counter == 0)
+    {
+      m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
+                                make_unique_dp<FinishReadingMessage>(),
+                                MessagePriority::Normal);
+    }
   }
 
   t->Reset();
@@ -131,6 +176,9 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, bool have3dBuildings
 
   if (m_modeChanged || forceUpdate || MustDropAllTiles(screen))
   {
+    // Cached shapes are valid only if nothing but the viewport has changed.
+    if (m_modeChanged || forceUpdate)
+      m_shapesCache.Clear();
     m_modeChanged = false;
 
     for (auto const & info : m_tileInfos)
@@ -141,7 +189,9 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, bool have3dBuildings
     ++m_generationCounter;
     ++m_userMarksGenerationCounter;
 
-    for (auto const & tileKey : tiles)
+    buffer_vector<TileKey, 8> orderedTiles(tiles.begin(), tiles.end());
+    SortByReadingPriority(screen, orderedTiles);
+    for (auto const & tileKey : orderedTiles)
       PushTaskBackForTileKey(tileKey, texMng, metalineMng);
   }
   else
@@ -171,8 +221,13 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, bool have3dBuildings
     if (forceUpdateUserMarks)
       ++m_userMarksGenerationCounter;
     CheckFinishedTiles(readyTiles, forceUpdateUserMarks);
-    for (auto const & tileKey : newTiles)
-      PushTaskBackForTileKey(tileKey, texMng, metalineMng);
+
+    // New tiles are read before the tiles requested by previous updates, because they
+    // are the ones the user is looking at after a pan. Tasks are pushed to the front
+    // of the queue, so they are pushed in the reverse order of priority.
+    SortByReadingPriority(screen, newTiles);
+    for (size_t i = newTiles.size(); i > 0; --i)
+      PushTaskFrontForTileKey(newTiles[i - 1], texMng, metalineMng);
   }
 
   m_currentViewport = screen;
@@ -180,6 +235,8 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, bool have3dBuildings
 
 void ReadManager::Invalidate(TTilesCollection const & keyStorage)
 {
+  m_shapesCache.Invalidate(keyStorage);
+
   TTileSet tilesToErase;
   for (auto const & info : m_tileInfos)
   {
@@ -194,11 +251,25 @@ void ReadManager::Invalidate(TTilesCollection const & keyStorage)
   }
 }
 
+void ReadManager::Evict(TTilesCollection const & keyStorage)
+{
+  TTileSet tilesToErase;
+  for (auto const & info : m_tileInfos)
+  {
+    if (keyStorage.find(info->GetTileKey()) != keyStorage.end())
+      tilesToErase.insert(info);
+  }
+
+  for (auto const & info : tilesToErase)
+    ClearTileInfo(info);
+}
+
 void ReadManager::InvalidateAll()
 {
   for (auto const & info : m_tileInfos)
     CancelTileInfo(info);
   m_tileInfos.clear();
+  m_shapesCache.Clear();
 
   m_modeChanged = true;
 }
@@ -225,12 +296,28 @@ void ReadManager::PushTaskBackForTileKey(TileKey const & tileKey,
                                          ref_ptr<MetalineManager> metalineMng)
 {
   ASSERT(m_pool != nullptr, ());
+  m_pool->PushBack(CreateTaskForTileKey(tileKey, texMng, metalineMng));
+}
+
+void ReadManager::PushTaskFrontForTileKey(TileKey const & tileKey,
+                                          ref_ptr<dp::TextureManager> texMng,
+                                          ref_ptr<MetalineManager> metalineMng)
+{
+  ASSERT(m_pool != nullptr, ());
+  m_pool->PushFront(CreateTaskForTileKey(tileKey, texMng, metalineMng));
+}
+
+ReadMWMTask * ReadManager::CreateTaskForTileKey(TileKey const & tileKey,
+                                                ref_ptr<dp::TextureManager> texMng,
+                                                ref_ptr<MetalineManager> metalineMng)
+{
   auto context = make_unique_dp<EngineContext>(TileKey(tileKey, m_generationCounter, m_userMarksGenerationCounter),
                                                m_commutator, texMng, metalineMng,
                                                m_customFeaturesContext,
                                                m_have3dBuildings && m_allow3dBuildings,
                                                m_trafficEnabled, m_displacementMode);
-  std::shared_ptr<TileInfo> tileInfo = std::make_shared<TileInfo>(std::move(context));
+  std::shared_ptr<TileInfo> tileInfo = std::make_shared<TileInfo>(std::move(context),
+                                                                  make_ref(&m_shapesCache));
   m_tileInfos.insert(tileInfo);
   ReadMWMTask * task = m_tasksPool.Get();
 
@@ -239,7 +326,7 @@ void ReadManager::PushTaskBackForTileKey(TileKey const & tileKey,
     std::lock_guard<std::mutex> lock(m_finishedTilesMutex);
     m_activeTiles.insert(tileKey);
   }
-  m_pool->PushBack(task);
+  return task;
 }
 
 void ReadManager::CheckFinishedTiles(TTileInfoCollection const & requestedTiles, bool forceUpdateUserMarks)
@@ -323,21 +410,33 @@ void ReadManager::SetDisplacementMode(int displacementMode)
 
 bool ReadManager::SetCustomFeatures(std::set<FeatureID> && ids)
 {
-  size_t const sz = m_customFeaturesContext ? m_customFeaturesContext->m_features.size() : 0;
-  m_customFeaturesContext = std::make_shared<CustomFeaturesContext>(std::move(ids));
+  auto context = std::make_shared<CustomFeaturesContext>(ids);
+  std::vector<FeatureID> const noFeatures;
+  auto const & oldFeatures = m_customFeaturesContext ? m_customFeaturesContext->m_features
+                                                     : noFeatures;
+
+  // Only cached tiles of mwms whose custom features are changed are
+  // read again.
+  std::vector<FeatureID> changed;
+  std::set_symmetric_difference(oldFeatures.cbegin(), oldFeatures.cend(),
+                                context->m_features.cbegin(), context->m_features.cend(),
+                                std::back_inserter(changed));
+  m_customFeaturesContext = std::move(context);
+  if (changed.empty())
+    return false;
 
-  return sz != m_customFeaturesContext->m_features.size();
+  std::set<MwmSet::MwmId> mwms;
+  for (auto const & id : changed)
+    mwms.insert(id.m_mwmId);
+  m_shapesCache.InvalidateMwms(mwms);
+  return true;
 }
 
 std::vector<FeatureID> ReadManager::GetCustomFeaturesArray() const
 {
   if (!m_customFeaturesContext)
     return {};
-  std::vector<FeatureID> features;
-  features.reserve(m_customFeaturesContext->m_features.size());
-  for (auto const & s : m_customFeaturesContext->m_features)
-    features.push_back(s);
-  return features;
+  return m_customFeaturesContext->m_features;
 }
 
 bool ReadManager::RemoveCustomFeatures(MwmSet::MwmId const & mwmId)
@@ -345,16 +444,17 @@ bool ReadManager::RemoveCustomFeatures(MwmSet::MwmId const & mwmId)
   if (!m_customFeaturesContext)
     return false;
 
-  std::set<FeatureID> features;
+  std::vector<FeatureID> features;
   for (auto const & s : m_customFeaturesContext->m_features)
   {
     if (s.m_mwmId != mwmId)
-      features.insert(s);
+      features.push_back(s);
   }
   if (features.size() == m_customFeaturesContext->m_features.size())
     return false;
 
   m_customFeaturesContext = std::make_shared<CustomFeaturesContext>(std::move(features));
+  m_shapesCache.InvalidateMwms({mwmId});
   return true;
 }
 
@@ -363,7 +463,12 @@ bool ReadManager::RemoveAllCustomFeatures()
   if (!m_customFeaturesContext || m_customFeaturesContext->m_features.empty())
     return false;
 
-  m_customFeaturesContext = std::make_shared<CustomFeaturesContext>(std::set<FeatureID>());
+  std::set<MwmSet::MwmId> mwms;
+  for (auto const & id : m_customFeaturesContext->m_features)
+    mwms.insert(id.m_mwmId);
+
+  m_customFeaturesContext = std::make_shared<CustomFeaturesContext>(std::vector<FeatureID>());
+  m_shapesCache.InvalidateMwms(mwms);
   return true;
 }
 } // namespace df
@@ -3,6 +3,7 @@
 #include "drape_frontend/engine_context.hpp"
 #include "drape_frontend/read_mwm_task.hpp"
 #include "drape_frontend/tile_info.hpp"
+#include "drape_frontend/tile_shapes_cache.hpp"
 #include "drape_frontend/tile_utils.hpp"
 
 #include "geometry/screenbase.hpp"
@@ -28,7 +29,9 @@ class MapDataProvider;
 class CoverageUpdateDescriptor;
 class MetalineManager;
 
-uint8_t constexpr kReadingThreadsCount = 2;
+// Returns the number of tile reading threads. It depends on the number of CPU cores, because
+// the frontend, backend and UI threads need cores too.
+uint8_t GetReadingThreadsCount();
 
 class ReadManager
 {
@@ -45,6 +48,9 @@ public:
                       TTilesCollection const & tiles, ref_ptr<dp::TextureManager> texMng,
                       ref_ptr<MetalineManager> metalineMng);
   void Invalidate(TTilesCollection const & keyStorage);
+  // Forgets tiles which geometry has been evicted by the frontend renderer, so they are
+  // read again on the next coverage update. Cached shapes of the tiles are kept.
+  void Evict(TTilesCollection const & keyStorage);
   void InvalidateAll();
 
   bool CheckTileKey(TileKey const & tileKey) const;
@@ -67,6 +73,11 @@ private:
 
   void PushTaskBackForTileKey(TileKey const & tileKey, ref_ptr<dp::TextureManager> texMng,
                               ref_ptr<MetalineManager> metalineMng);
+  void PushTaskFrontForTileKey(TileKey const & tileKey, ref_ptr<dp::TextureManager> texMng,
+                               ref_ptr<MetalineManager> metalineMng);
+  ReadMWMTask * CreateTaskForTileKey(TileKey const & tileKey,
+                                     ref_ptr<dp::TextureManager> texMng,
+                                     ref_ptr<MetalineManager> metalineMng);
 
   ref_ptr<ThreadsCommutator> m_commutator;
 
@@ -102,6 +113,8 @@ private:
 
   CustomFeaturesContextPtr m_customFeaturesContext;
 
+  TileShapesCache m_shapesCache;
+
   void CancelTileInfo(std::shared_ptr<TileInfo> const & tileToCancel);
   void ClearTileInfo(std::shared_ptr<TileInfo> const & tileToClear);
   void IncreaseCounter(int value);
@@ -13,6 +13,8 @@
 #include "indexer/feature_decl.hpp"
 #include "indexer/scales.hpp"
 
+#include "base/bits.hpp"
+
 #include "defines.hpp"
 
 #include <algorithm>
@@ -22,34 +24,54 @@ namespace
 {
 double const kPointEqualityEps = 1e-7;
 
-struct MetalineData
+df::MwmMetalines ReadMetalinesFromFile(MwmSet::MwmId const & mwmId)
 {
-  std::vector<FeatureID> m_features;
-  std::vector<bool> m_directions;
-};
-
-std::vector<MetalineData> ReadMetalinesFromFile(MwmSet::MwmId const & mwmId)
-{ 
   try
   {
-    std::vector<MetalineData> model;
+    df::MwmMetalines model;
     ModelReaderPtr reader = FilesContainerR(mwmId.GetInfo()->GetLocalFile().GetPath(MapOptions::Map))
                                             .GetReader(METALINES_FILE_TAG);
     ReaderSrc src(reader.GetPtr());
     uint8_t const version = ReadPrimitiveFromSource<uint8_t>(src);
-    if (version == 1)
+    if (version != 1 && version != 2)
+      return model;
+
+    int64_t prevFirst = 0;
+    for (auto metalineIndex = ReadVarUint<uint32_t>(src); metalineIndex > 0; --metalineIndex)
     {
-      for (auto metalineIndex = ReadVarUint<uint32_t>(src); metalineIndex > 0; --metalineIndex)
+      df::MetalineData data;
+      int64_t prev = prevFirst;
+      for (auto i = ReadVarUint<uint32_t>(src); i > 0; --i)
       {
-        MetalineData data;
-        for (auto i = ReadVarUint<uint32_t>(src); i > 0; --i)
+        if (version == 1)
         {
           int32_t const fid = ReadVarInt<int32_t>(src);
           data.m_features.push_back(FeatureID(mwmId, static_cast<uint32_t>(std::abs(fid))));
           data.m_directions.push_back(fid > 0);
+          continue;
         }
-        model.push_back(std::move(data));
+
+        // Version 2: deltas of feature ids with a direction in the lowest bit.
+        uint64_t const code = ReadVarUint<uint64_t>(src);
+        prev += bits::ZigZagDecode(code >> 1);
+        data.m_features.push_back(FeatureID(mwmId, static_cast<uint32_t>(prev)));
+        data.m_directions.push_back((code & 1) != 0);
       }
+      if (!data.m_features.empty())
+        prevFirst = data.m_features.front().m_index;
+
+      // A feature can't belong to several metalines, the first metaline wins.
+      bool const hasUsedFeature = std::any_of(data.m_features.begin(), data.m_features.end(),
+                                              [&model](FeatureID const & fid)
+      {
+        return model.m_metalineIndices.find(fid.m_index) != model.m_metalineIndices.end();
+      });
+      if (hasUsedFeature)
+        continue;
+
+      for (auto const & fid : data.m_features)
+        model.m_metalineIndices[fid.m_index] = model.m_metalines.size();
+      model.m_metalines.push_back(std::move(data));
     }
     return model;
   }
@@ -93,6 +115,7 @@ void ReadMetalineTask::Init(MwmSet::MwmId const & mwmId)
 void ReadMetalineTask::Reset()
 {
   m_mwmId.Reset();
+  m_metalines = MwmMetalines();
   IRoutine::Reset();
 }
 
@@ -108,66 +131,51 @@ void ReadMetalineTask::Do()
   if (m_mwmId.GetInfo()->GetType() != MwmInfo::MwmTypeT::COUNTRY)
     return;
 
-  auto metalines = ReadMetalinesFromFile(m_mwmId);
-  for (auto const & metaline : metalines)
+  m_metalines = ReadMetalinesFromFile(m_mwmId);
+}
+
+m2::SharedSpline MergeMetaline(MapDataProvider const & model, MetalineData const & metaline)
+{
+  bool failed = false;
+  size_t curIndex = 0;
+  std::vector<std::vector<m2::PointD>> points;
+  points.reserve(5);
+  model.ReadFeatures([&metaline, &failed, &curIndex, &points](FeatureType const & ft)
   {
-    if (IsCancelled())
+    if (failed)
       return;
-
-    bool failed = false;
-    for (auto const & fid : metaline.m_features)
+    if (curIndex >= metaline.m_features.size() || ft.GetID() != metaline.m_features[curIndex])
     {
-      if (m_metalines.find(fid) != m_metalines.end())
-      {
-        failed = true;
-        break;
-      }
+      failed = true;
+      return;
     }
-    if (failed)
-      continue;
-
-    size_t curIndex = 0;
-    std::vector<std::vector<m2::PointD>> points;
-    points.reserve(5);
-    m_model.ReadFeatures([&metaline, &failed, &curIndex, &points](FeatureType const & ft)
+    std::vector<m2::PointD> featurePoints;
+    featurePoints.reserve(5);
+    ft.ForEachPoint([&featurePoints](m2::PointD const & pt)
     {
-      if (failed)
-        return;
-      if (ft.GetID() != metaline.m_features[curIndex])
-      {
-        failed = true;
-        return;
-      }
-      std::vector<m2::PointD> featurePoints;
-      featurePoints.reserve(5);
-      ft.ForEachPoint([&featurePoints](m2::PointD const & pt)
-      {
-        if (featurePoints.empty() || !featurePoints.back().EqualDxDy(pt, kPointEqualityEps))
-          featurePoints.push_back(pt);
-      }, scales::GetUpperScale());
-      if (featurePoints.size() < 2)
-      {
-        failed = true;
-        return;
-      }
-      if (!metaline.m_directions[curIndex])
-        std::reverse(featurePoints.begin(), featurePoints.end());
+      if (featurePoints.empty() || !featurePoints.back().EqualDxDy(pt, kPointEqualityEps))
+        featurePoints.push_back(pt);
+    }, scales::GetUpperScale());
+    if (featurePoints.size() < 2)
+    {
+      failed = true;
+      return;
+    }
+    if (!metaline.m_directions[curIndex])
+      std::reverse(featurePoints.begin(), featurePoints.end());
 
-      points.push_back(std::move(featurePoints));
-      curIndex++;
-    }, metaline.m_features);
+    points.push_back(std::move(featurePoints));
+    curIndex++;
+  }, metaline.m_features);
 
-    if (failed || points.empty())
-      continue;
+  if (failed || points.empty())
+    return m2::SharedSpline();
 
-    std::vector<m2::PointD> const mergedPoints = MergePoints(points);
-    if (mergedPoints.empty())
-      continue;
+  std::vector<m2::PointD> const mergedPoints = MergePoints(points);
+  if (mergedPoints.empty())
+    return m2::SharedSpline();
 
-    m2::SharedSpline const spline(mergedPoints);
-    for (auto const & fid : metaline.m_features)
-      m_metalines[fid] = spline;
-  }
+  return m2::SharedSpline(mergedPoints);
 }
 
 ReadMetalineTask * ReadMetalineTaskFactory::GetNew() const
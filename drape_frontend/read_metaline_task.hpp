@@ -9,7 +9,9 @@
 #include "base/thread.hpp"
 #include "base/thread_pool.hpp"
 
+#include <cstdint>
 #include <map>
+#include <vector>
 
 namespace df
 {
@@ -17,6 +19,26 @@ class MapDataProvider;
 
 using MetalineCache = std::map<FeatureID, m2::SharedSpline>;
 
+struct MetalineData
+{
+  std::vector<FeatureID> m_features;
+  std::vector<bool> m_directions;
+};
+
+// Metalines of a mwm as they are stored in the metalines section.
+struct MwmMetalines
+{
+  std::vector<MetalineData> m_metalines;
+  // Indices of metalines by indices of their features.
+  std::map<uint32_t, size_t> m_metalineIndices;
+};
+
+// Reads geometry of features of |metaline| and merges it into a single spline.
+// Returns a null spline when features can't be merged.
+m2::SharedSpline MergeMetaline(MapDataProvider const & model, MetalineData const & metaline);
+
+// Reads the metalines section of a mwm. Splines aren't merged here, MetalineManager
+// merges them on demand.
 class ReadMetalineTask : public threads::IRoutine
 {
 public:
@@ -28,13 +50,13 @@ public:
   void Reset() override;
   bool IsCancelled() const override;
 
-  MetalineCache const & GetMetalines() const { return m_metalines; }
+  MwmMetalines & GetMetalines() { return m_metalines; }
   MwmSet::MwmId const & GetMwmId() const { return m_mwmId; }
 
 private:
   MapDataProvider & m_model;
   MwmSet::MwmId m_mwmId;
-  MetalineCache m_metalines;
+  MwmMetalines m_metalines;
 };
 
 class ReadMetalineTaskFactory
@@ -1,5 +1,7 @@
 #include "drape_frontend/read_mwm_task.hpp"
 
+#include "drape_frontend/drape_measurer.hpp"
+
 namespace df
 {
 ReadMWMTask::ReadMWMTask(MapDataProvider & model)
@@ -46,6 +48,11 @@ void ReadMWMTask::Do()
   shared_ptr<TileInfo> tile = m_tileInfo.lock();
   if (tile == nullptr)
     return;
+
+  DrapeMeasurer::TraceScope traceScope("ReadMWMTask", "reading");
+  traceScope.AddArg("x", m_tileKey.m_x);
+  traceScope.AddArg("y", m_tileKey.m_y);
+  traceScope.AddArg("zoom", m_tileKey.m_zoomLevel);
   try
   {
     tile->ReadFeatures(m_model);
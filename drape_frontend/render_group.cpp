@@ -78,6 +78,14 @@ bool RenderGroup::HasOverlayHandles() const
   return false;
 }
 
+uint64_t RenderGroup::GetByteSize() const
+{
+  uint64_t size = 0;
+  for (auto & renderBucket : m_renderBuckets)
+    size += renderBucket->GetBuffer()->GetByteSize();
+  return size;
+}
+
 void RenderGroup::RemoveOverlay(ref_ptr<dp::OverlayTree> tree)
 {
   for (auto & renderBucket : m_renderBuckets)
@@ -152,6 +160,11 @@ void RenderGroup::AddBucket(drape_ptr<dp::RenderBucket> && bucket)
   m_renderBuckets.push_back(std::move(bucket));
 }
 
+void RenderGroup::SetZScale(float zScale)
+{
+  m_uniforms.SetFloatValue("zScale", zScale);
+}
+
 bool RenderGroup::IsOverlay() const
 {
   auto const depthLayer = GetDepthLayer(m_state);
@@ -67,6 +67,12 @@ public:
 
   bool IsEmpty() const { return m_renderBuckets.empty(); }
 
+  // Overrides the general scale of heights, zero scale makes 3d geometry flat.
+  void SetZScale(float zScale);
+
+  // Returns the size of geometry of the group in GPU memory.
+  uint64_t GetByteSize() const;
+
   void DeleteLater() const { m_pendingOnDelete = true; }
   bool IsPendingOnDelete() const { return m_pendingOnDelete; }
   bool CanBeDeleted() const { return m_canBeDeleted; }
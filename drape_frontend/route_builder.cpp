@@ -2,6 +2,8 @@
 
 #include "drape_frontend/route_shape.hpp"
 
+#include <algorithm>
+
 namespace df
 {
 RouteBuilder::RouteBuilder(TFlushRouteFn const & flushRouteFn,
@@ -13,22 +15,46 @@ RouteBuilder::RouteBuilder(TFlushRouteFn const & flushRouteFn,
 void RouteBuilder::Build(dp::DrapeID subrouteId, SubrouteConstPtr subroute,
                          ref_ptr<dp::TextureManager> textures, int recacheId)
 {
-  drape_ptr<RouteData> routeData = make_unique_dp<RouteData>();
-  routeData->m_subrouteId = subrouteId;
-  routeData->m_subroute = subroute;
-  routeData->m_pivot = routeData->m_subroute->m_polyline.GetLimitRect().Center();
-  routeData->m_recacheId = recacheId;
-  RouteShape::CacheRoute(textures, *routeData.get());
   RouteCacheData cacheData;
-  cacheData.m_polyline = routeData->m_subroute->m_polyline;
-  cacheData.m_baseDepthIndex = routeData->m_subroute->m_baseDepthIndex;
+  cacheData.m_polyline = subroute->m_polyline;
+  cacheData.m_baseDepthIndex = subroute->m_baseDepthIndex;
   m_routeCache.insert(std::make_pair(subrouteId, std::move(cacheData)));
 
-  // Flush route geometry.
-  GLFunctions::glFlush();
+  auto const & points = subroute->m_polyline.GetPoints();
+  if (points.size() < 2)
+    return;
+
+  // Segments are flushed one by one, so memory is spent on geometry of one segment only
+  // and the beginning of the route is shown before the whole route is built.
+  double const length = subroute->m_polyline.GetLength();
+  double segmentBaseLength = 0.0;
+  size_t segmentIndex = 0;
+  for (size_t startIndex = 0; startIndex + 1 < points.size();
+       startIndex += kMaxRouteSegmentPointsCount - 1)
+  {
+    size_t const endIndex = std::min(startIndex + kMaxRouteSegmentPointsCount - 1,
+                                     points.size() - 1);
+
+    drape_ptr<RouteData> routeData = make_unique_dp<RouteData>();
+    routeData->m_subrouteId = subrouteId;
+    routeData->m_subroute = subroute;
+    routeData->m_recacheId = recacheId;
+    routeData->m_length = length;
+    routeData->m_segmentIndex = segmentIndex++;
+    routeData->m_startPointIndex = startIndex;
+    routeData->m_endPointIndex = endIndex;
+    routeData->m_segmentBaseLength = segmentBaseLength;
+    for (size_t i = startIndex; i <= endIndex; ++i)
+      routeData->m_boundingBox.Add(points[i]);
+    routeData->m_pivot = routeData->m_boundingBox.Center();
+    segmentBaseLength += RouteShape::CacheRoute(textures, *routeData.get());
+
+    // Flush route geometry.
+    GLFunctions::glFlush();
 
-  if (m_flushRouteFn != nullptr)
-    m_flushRouteFn(std::move(routeData));
+    if (m_flushRouteFn != nullptr)
+      m_flushRouteFn(std::move(routeData));
+  }
 }
 
 void RouteBuilder::ClearRouteCache()
@@ -254,6 +254,10 @@ void RouteRenderer::UpdateRoute(ScreenBase const & screen, CacheRouteArrowsCallb
   ASSERT(callback != nullptr, ());
   for (auto const & routeData : m_routeData)
   {
+    // Arrows are calculated for the whole subroute, so only the first segment is enough.
+    if (routeData->m_segmentIndex != 0)
+      continue;
+
     auto & additional = m_routeAdditional[routeData->m_subrouteId];
 
     // Interpolate values by zoom level.
@@ -399,6 +403,12 @@ void RouteRenderer::RenderRouteData(drape_ptr<RouteData> const & routeData,
 
   float const currentHalfWidth = m_routeAdditional[routeData->m_subrouteId].m_currentHalfWidth;
   auto const screenHalfWidth = static_cast<float>(currentHalfWidth * screen.GetScale());
+
+  // Skip rendering of segments which are out of the screen.
+  m2::RectD boundingBox = routeData->m_boundingBox;
+  boundingBox.Inflate(screenHalfWidth, screenHalfWidth);
+  if (!screen.ClipRect().IsIntersect(boundingBox))
+    return;
   auto dist = static_cast<float>(kInvalidDistance);
   if (m_followingEnabled)
     dist = static_cast<float>(m_distanceFromBegin - routeData->m_subroute->m_baseDistance);
@@ -529,8 +539,10 @@ void RouteRenderer::RenderRoute(ScreenBase const & screen, bool trafficShown,
 void RouteRenderer::AddRouteData(drape_ptr<RouteData> && routeData,
                                  ref_ptr<dp::GpuProgramManager> mng)
 {
-  // Remove old route data with the same id.
-  RemoveRouteData(routeData->m_subrouteId);
+  // Remove old route data with the same id. The other segments of the subroute
+  // come after the first one.
+  if (routeData->m_segmentIndex == 0)
+    RemoveRouteData(routeData->m_subrouteId);
 
   // Add new route data.
   m_routeData.push_back(std::move(routeData));
@@ -538,7 +550,9 @@ void RouteRenderer::AddRouteData(drape_ptr<RouteData> && routeData,
   std::sort(m_routeData.begin(), m_routeData.end(),
             [](drape_ptr<RouteData> const & d1, drape_ptr<RouteData> const & d2)
   {
-    return d1->m_subroute->m_baseDistance > d2->m_subroute->m_baseDistance;
+    if (d1->m_subroute->m_baseDistance != d2->m_subroute->m_baseDistance)
+      return d1->m_subroute->m_baseDistance > d2->m_subroute->m_baseDistance;
+    return d1->m_segmentIndex > d2->m_segmentIndex;
   });
 }
 
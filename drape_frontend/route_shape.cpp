@@ -13,6 +13,8 @@
 
 #include "base/logging.hpp"
 
+#include <algorithm>
+
 namespace df
 {
 namespace
@@ -135,8 +137,8 @@ void GenerateArrowsTriangles(glsl::vec4 const & pivot, std::vector<glsl::vec2> c
 
 void RouteShape::PrepareGeometry(std::vector<m2::PointD> const & path, m2::PointD const & pivot,
                                  std::vector<glsl::vec4> const & segmentsColors, float baseDepth,
-                                 TGeometryBuffer & geometry, TGeometryBuffer & joinsGeometry,
-                                 double & outputLength)
+                                 float baseLength, TGeometryBuffer & geometry,
+                                 TGeometryBuffer & joinsGeometry, double & outputLength)
 {
   ASSERT(path.size() > 1, ());
 
@@ -149,10 +151,10 @@ void RouteShape::PrepareGeometry(std::vector<m2::PointD> const & path, m2::Point
     return;
 
   // Build geometry.
-  float length = 0.0f;
+  float length = baseLength;
   for (size_t i = 0; i < segments.size() ; ++i)
     length += glsl::length(segments[i].m_points[EndPoint] - segments[i].m_points[StartPoint]);
-  outputLength = length;
+  outputLength = length - baseLength;
 
   float depth = baseDepth;
   float const depthStep = kRouteDepth / (1 + segments.size());
@@ -396,12 +398,23 @@ void RouteShape::CacheRouteArrows(ref_ptr<dp::TextureManager> mng, m2::PolylineD
                 AV::GetBindingInfo(), routeArrowsData.m_renderProperty);
 }
 
-void RouteShape::CacheRoute(ref_ptr<dp::TextureManager> textures, RouteData & routeData)
+double RouteShape::CacheRoute(ref_ptr<dp::TextureManager> textures, RouteData & routeData)
 {
+  auto const & subroute = routeData.m_subroute;
+  auto const & points = subroute->m_polyline.GetPoints();
+  ASSERT_LESS(routeData.m_startPointIndex, routeData.m_endPointIndex, ());
+  ASSERT_LESS(routeData.m_endPointIndex, points.size(), ());
+  std::vector<m2::PointD> const path(points.begin() + routeData.m_startPointIndex,
+                                     points.begin() + routeData.m_endPointIndex + 1);
+
+  // Traffic is defined for polyline segments, so the segments of the route segment are taken.
   std::vector<glsl::vec4> segmentsColors;
-  segmentsColors.reserve(routeData.m_subroute->m_traffic.size());
-  for (auto speedGroup : routeData.m_subroute->m_traffic)
+  size_t const trafficStart = std::min(routeData.m_startPointIndex, subroute->m_traffic.size());
+  size_t const trafficEnd = std::min(routeData.m_endPointIndex, subroute->m_traffic.size());
+  segmentsColors.reserve(trafficEnd - trafficStart);
+  for (size_t i = trafficStart; i < trafficEnd; ++i)
   {
+    auto speedGroup = subroute->m_traffic[i];
     speedGroup = TrafficGenerator::CheckColorsSimplification(speedGroup);
     auto const colorConstant = TrafficGenerator::GetColorBySpeedGroup(speedGroup, true /* route */);
     dp::Color const color = df::GetColorConstant(colorConstant);
@@ -413,11 +426,13 @@ void RouteShape::CacheRoute(ref_ptr<dp::TextureManager> textures, RouteData & ro
 
   TGeometryBuffer geometry;
   TGeometryBuffer joinsGeometry;
-  PrepareGeometry(routeData.m_subroute->m_polyline.GetPoints(), routeData.m_pivot, segmentsColors,
-                  static_cast<float>(routeData.m_subroute->m_baseDepthIndex * kDepthPerSubroute),
-                  geometry, joinsGeometry, routeData.m_length);
+  double segmentLength = 0.0;
+  PrepareGeometry(path, routeData.m_pivot, segmentsColors,
+                  static_cast<float>(subroute->m_baseDepthIndex * kDepthPerSubroute),
+                  static_cast<float>(routeData.m_segmentBaseLength), geometry, joinsGeometry,
+                  segmentLength);
 
-  auto state = CreateGLState(routeData.m_subroute->m_pattern.m_isDashed ?
+  auto state = CreateGLState(subroute->m_pattern.m_isDashed ?
                              gpu::ROUTE_DASH_PROGRAM : gpu::ROUTE_PROGRAM,
                              RenderState::GeometryLayer);
   state.SetColorTexture(textures->GetSymbolsTexture());
@@ -425,6 +440,7 @@ void RouteShape::CacheRoute(ref_ptr<dp::TextureManager> textures, RouteData & ro
   BatchGeometry(state, make_ref(geometry.data()), static_cast<uint32_t>(geometry.size()),
                 make_ref(joinsGeometry.data()), static_cast<uint32_t>(joinsGeometry.size()),
                 RV::GetBindingInfo(), routeData.m_renderProperty);
+  return segmentLength;
 }
 
 void RouteShape::BatchGeometry(dp::GLState const & state, ref_ptr<void> geometry, uint32_t geomSize,
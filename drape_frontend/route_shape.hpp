@@ -34,6 +34,10 @@ float const kArrowTailFactor = static_cast<float>(2.0 * kArrowTailTextureWidth /
 double const kArrowHeightFactor = kArrowTextureHeight / kArrowBodyHeight;
 double const kArrowAspect = kArrowTextureWidth / kArrowTextureHeight;
 
+// Long subroutes are split into segments of bounded number of points. Every segment
+// has its own pivot and bounding box, so it can be culled and it is built in small batches.
+size_t const kMaxRouteSegmentPointsCount = 1000;
+
 enum class RouteType : uint8_t
 {
   Car,
@@ -91,7 +95,16 @@ struct BaseRouteData
 struct RouteData : public BaseRouteData
 {
   SubrouteConstPtr m_subroute;
+  // Length of the whole subroute.
   double m_length = 0.0;
+
+  // The segment of the subroute polyline this data is built for.
+  size_t m_segmentIndex = 0;
+  size_t m_startPointIndex = 0;
+  size_t m_endPointIndex = 0;
+  // Distance from the beginning of the subroute to the start of the segment.
+  double m_segmentBaseLength = 0.0;
+  m2::RectD m_boundingBox;
 };
 
 struct RouteArrowsData : public BaseRouteData {};
@@ -111,7 +124,9 @@ public:
   using AV = gpu::SolidTexturingVertex;
   using TArrowGeometryBuffer = buffer_vector<AV, 128>;
 
-  static void CacheRoute(ref_ptr<dp::TextureManager> textures, RouteData & routeData);
+  // Caches the segment of the subroute which is defined by the point indices of |routeData|.
+  // Returns the length of the segment.
+  static double CacheRoute(ref_ptr<dp::TextureManager> textures, RouteData & routeData);
 
   static void CacheRouteArrows(ref_ptr<dp::TextureManager> mng, m2::PolylineD const & polyline,
                                std::vector<ArrowBorders> const & borders, double baseDepthIndex,
@@ -120,8 +135,8 @@ public:
 private:
   static void PrepareGeometry(std::vector<m2::PointD> const & path, m2::PointD const & pivot,
                               std::vector<glsl::vec4> const & segmentsColors, float baseDepth,
-                              TGeometryBuffer & geometry, TGeometryBuffer & joinsGeometry,
-                              double & outputLength);
+                              float baseLength, TGeometryBuffer & geometry,
+                              TGeometryBuffer & joinsGeometry, double & outputLength);
   static void PrepareArrowGeometry(std::vector<m2::PointD> const & path, m2::PointD const & pivot,
                                    m2::RectF const & texRect, float depthStep, float depth,
                                    TArrowGeometryBuffer & geometry,
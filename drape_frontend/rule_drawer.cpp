@@ -258,14 +258,21 @@ void RuleDrawer::ProcessAreaStyle(FeatureType const & f, Stylist const & s,
   bool isBuildingOutline = false;
   if (f.GetLayer() >= 0)
   {
-    bool const hasParts = IsBuildingHasPartsChecker::Instance()(f);
-    bool const isPart = IsBuildingPartChecker::Instance()(f);
+    enum BuildingCheckers { HasParts, Part, Building, Bridge, Tunnel };
+    static ftypes::MultiChecker const checkers({&IsBuildingHasPartsChecker::Instance(),
+                                                &IsBuildingPartChecker::Instance(),
+                                                &ftypes::IsBuildingChecker::Instance(),
+                                                &ftypes::IsBridgeChecker::Instance(),
+                                                &ftypes::IsTunnelChecker::Instance()});
+    auto const mask = checkers(f);
+    bool const hasParts = ftypes::MultiChecker::IsMatched(mask, HasParts);
+    bool const isPart = ftypes::MultiChecker::IsMatched(mask, Part);
 
     // Looks like nonsense, but there are some osm objects with types
     // highway-path-bridge and building (sic!) at the same time (pedestrian crossing).
-    isBuilding = (isPart || ftypes::IsBuildingChecker::Instance()(f)) &&
-        !ftypes::IsBridgeChecker::Instance()(f) &&
-        !ftypes::IsTunnelChecker::Instance()(f);
+    isBuilding = (isPart || ftypes::MultiChecker::IsMatched(mask, Building)) &&
+        !ftypes::MultiChecker::IsMatched(mask, Bridge) &&
+        !ftypes::MultiChecker::IsMatched(mask, Tunnel);
 
     isBuildingOutline = isBuilding && hasParts && !isPart;
     is3dBuilding = m_context->Is3dBuildingsEnabled() && (isBuilding && !isBuildingOutline);
@@ -42,6 +42,10 @@ public:
 
   void operator()(FeatureType const & f);
 
+  // Returns true if the reading of the tile was cancelled. Features which are read after
+  // the cancellation are skipped, so the caller should stop reading.
+  bool WasCancelled() const { return m_wasCancelled; }
+
 private:
   void ProcessAreaStyle(FeatureType const & f, Stylist const & s, TInsertShapeFn const & insertShape,
                         int & minVisibleScale);
@@ -19,8 +19,10 @@ using namespace std::placeholders;
 
 namespace df
 {
-TileInfo::TileInfo(drape_ptr<EngineContext> && engineContext)
+TileInfo::TileInfo(drape_ptr<EngineContext> && engineContext,
+                   ref_ptr<TileShapesCache> shapesCache)
   : m_context(std::move(engineContext))
+  , m_shapesCache(shapesCache)
   , m_isCanceled(false)
 {}
 
@@ -62,6 +64,19 @@ void TileInfo::ReadFeatures(MapDataProvider const & model)
   // Reading can be interrupted by exception throwing
   MY_SCOPE_GUARD(ReleaseReadTile, std::bind(&EngineContext::EndReadTile, m_context.get()));
 
+  // Shapes of a tile which was visible recently are sent again without reading
+  // and styling of its features.
+  if (auto const shapes = m_shapesCache->Get(GetTileKey()))
+  {
+    CheckCanceled();
+    m_context->GetMetalineManager()->Update(shapes->m_mwms);
+    m_context->FlushCachedShapes(*shapes);
+    return;
+  }
+
+  uint64_t const cacheEpoch = m_shapesCache->GetEpoch();
+  m_context->StartRecording();
+
   ReadFeatureIndex(model);
   CheckCanceled();
 
@@ -70,10 +85,26 @@ void TileInfo::ReadFeatures(MapDataProvider const & model)
   if (!m_featureInfo.empty())
   {
     auto const deviceLang = StringUtf8Multilang::GetLangIndex(languages::GetCurrentNorm());
+    // RuleDrawer flushes overlays on destruction, so it must be destroyed before
+    // the recorded shapes are taken.
     RuleDrawer drawer(std::bind(&TileInfo::InitStylist, this, deviceLang, _1, _2),
                       std::bind(&TileInfo::IsCancelled, this),
                       model.m_isCountryLoadedByName, make_ref(m_context));
-    model.ReadFeatures(std::bind<void>(std::ref(drawer), _1), m_featureInfo);
+    model.ReadFeatures([&drawer](FeatureType const & ft)
+    {
+      drawer(ft);
+      // Loading of the rest of features of an outdated tile is a waste of time
+      // of the reading thread, which is needed for visible tiles.
+      if (drawer.WasCancelled())
+        MYTHROW(ReadCanceledException, ());
+    }, m_featureInfo);
+  }
+
+  auto shapes = m_context->FinishRecording();
+  if (!IsCancelled())
+  {
+    shapes->m_mwms = m_mwms;
+    m_shapesCache->Put(GetTileKey(), cacheEpoch, std::move(shapes));
   }
 #if defined(DRAPE_MEASURER) && defined(TILES_STATISTIC)
   DrapeMeasurer::Instance().EndTileReading();
@@ -3,6 +3,7 @@
 #include "drape_frontend/custom_features_context.hpp"
 #include "drape_frontend/engine_context.hpp"
 #include "drape_frontend/tile_key.hpp"
+#include "drape_frontend/tile_shapes_cache.hpp"
 
 #include "indexer/feature_decl.hpp"
 
@@ -25,7 +26,7 @@ class TileInfo
 public:
   DECLARE_EXCEPTION(ReadCanceledException, RootException);
 
-  TileInfo(drape_ptr<EngineContext> && engineContext);
+  TileInfo(drape_ptr<EngineContext> && engineContext, ref_ptr<TileShapesCache> shapesCache);
 
   void ReadFeatures(MapDataProvider const & model);
   void Cancel();
@@ -45,6 +46,7 @@ private:
 
 private:
   drape_ptr<EngineContext> m_context;
+  ref_ptr<TileShapesCache> m_shapesCache;
   std::vector<FeatureID> m_featureInfo;
   std::atomic<bool> m_isCanceled;
   std::set<MwmSet::MwmId> m_mwms;
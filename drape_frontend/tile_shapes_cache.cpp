@@ -0,0 +1,116 @@
+#include "drape_frontend/tile_shapes_cache.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+
+namespace df
+{
+TileShapesCache::TileShapesCache(size_t maxTilesCount) : m_maxTilesCount(maxTilesCount)
+{
+  ASSERT_GREATER(m_maxTilesCount, 0, ());
+}
+
+uint64_t TileShapesCache::GetEpoch() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_epoch;
+}
+
+std::shared_ptr<TileShapes const> TileShapesCache::Get(TileKey const & tileKey)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto const it = m_entries.find(tileKey);
+  if (it == m_entries.end())
+    return nullptr;
+
+  m_lru.splice(m_lru.begin(), m_lru, it->second.second);
+  return it->second.first;
+}
+
+void TileShapesCache::Put(TileKey const & tileKey, uint64_t epoch,
+                          std::shared_ptr<TileShapes const> shapes)
+{
+  ASSERT(shapes, ());
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (epoch != m_epoch)
+    return;
+
+  auto const it = m_entries.find(tileKey);
+  if (it != m_entries.end())
+  {
+    it->second.first = std::move(shapes);
+    m_lru.splice(m_lru.begin(), m_lru, it->second.second);
+    return;
+  }
+
+  if (m_entries.size() == m_maxTilesCount)
+  {
+    m_entries.erase(m_lru.back());
+    m_lru.pop_back();
+  }
+
+  m_lru.push_front(tileKey);
+  m_entries.emplace(tileKey, TEntry(std::move(shapes), m_lru.begin()));
+}
+
+void TileShapesCache::Invalidate(TTilesCollection const & tiles)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  ++m_epoch;
+
+  // Data of the invalidated tiles is a part of cached tiles of other zoom levels too.
+  for (auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    m2::RectD const rect = it->first.GetGlobalRect();
+    bool const intersects = std::any_of(tiles.begin(), tiles.end(), [&rect](TileKey const & tileKey)
+    {
+      return rect.IsIntersect(tileKey.GetGlobalRect());
+    });
+    if (!intersects)
+    {
+      ++it;
+      continue;
+    }
+    m_lru.erase(it->second.second);
+    it = m_entries.erase(it);
+  }
+}
+
+void TileShapesCache::InvalidateMwms(std::set<MwmSet::MwmId> const & mwms)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  ++m_epoch;
+
+  for (auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    auto const & tileMwms = it->second.first->m_mwms;
+    bool const contains = std::any_of(mwms.begin(), mwms.end(), [&tileMwms](MwmSet::MwmId const & id)
+    {
+      return tileMwms.find(id) != tileMwms.end();
+    });
+    if (!contains)
+    {
+      ++it;
+      continue;
+    }
+    m_lru.erase(it->second.second);
+    it = m_entries.erase(it);
+  }
+}
+
+void TileShapesCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  ++m_epoch;
+  m_lru.clear();
+  m_entries.clear();
+}
+
+size_t TileShapesCache::GetTilesCount() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_entries.size();
+}
+}  // namespace df
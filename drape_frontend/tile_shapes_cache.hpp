@@ -0,0 +1,67 @@
+#pragma once
+
+#include "drape_frontend/map_shape.hpp"
+#include "drape_frontend/tile_key.hpp"
+#include "drape_frontend/tile_utils.hpp"
+#include "drape_frontend/traffic_generator.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <utility>
+
+namespace df
+{
+// Everything RuleDrawer produces for a tile. Shapes are immutable after preparation,
+// so they can be drawn again when the tile comes back into view.
+struct TileShapes
+{
+  TMapShapes m_geometry;
+  TMapShapes m_overlays;
+  TrafficSegmentsGeometry m_trafficGeometry;
+  std::set<MwmSet::MwmId> m_mwms;
+};
+
+// Thread-safe LRU cache of shapes of read tiles. Tiles are identified by coordinates and
+// zoom level, generations of tile keys are not taken into account. The cache must be
+// invalidated when anything which affects shapes of tiles changes: map style, rendering
+// modes, map data, etc. Shapes of tiles which were being read during an invalidation
+// are not put into the cache.
+class TileShapesCache
+{
+public:
+  explicit TileShapesCache(size_t maxTilesCount);
+
+  // Returns the epoch which should be passed to Put() for a tile which is going to be read.
+  uint64_t GetEpoch() const;
+
+  // Returns nullptr if there are no shapes of |tileKey|.
+  std::shared_ptr<TileShapes const> Get(TileKey const & tileKey);
+  void Put(TileKey const & tileKey, uint64_t epoch, std::shared_ptr<TileShapes const> shapes);
+
+  // Removes all cached tiles of all zoom levels which intersect |tiles|.
+  void Invalidate(TTilesCollection const & tiles);
+  // Removes all cached tiles which contain features of any of |mwms|.
+  void InvalidateMwms(std::set<MwmSet::MwmId> const & mwms);
+  void Clear();
+
+  size_t GetTilesCount() const;
+
+private:
+  using TLru = std::list<TileKey>;
+  using TEntry = std::pair<std::shared_ptr<TileShapes const>, TLru::iterator>;
+
+  size_t const m_maxTilesCount;
+
+  mutable std::mutex m_mutex;
+  uint64_t m_epoch = 0;
+  // The most recently used tiles are in the front.
+  TLru m_lru;
+  std::map<TileKey, TEntry> m_entries;
+};
+}  // namespace df
@@ -123,11 +123,55 @@ void TrafficGenerator::ClearGLDependentResources()
 {
   InvalidateTexturesCache();
   m_batchersPool.reset();
+  m_tilesGeometry.clear();
 }
 
-void TrafficGenerator::FlushSegmentsGeometry(TileKey const & tileKey, TrafficSegmentsGeometry const & geom,
+void TrafficGenerator::FlushSegmentsGeometry(TileKey const & tileKey, TrafficSegmentsGeometry && geom,
                                              ref_ptr<dp::TextureManager> textures)
 {
+  for (auto const & mwmGeometry : geom)
+    GenerateSegmentsGeometry(tileKey, mwmGeometry.first, mwmGeometry.second, textures);
+
+  GLFunctions::glFlush();
+
+  CacheSegmentsGeometry(tileKey, move(geom));
+}
+
+void TrafficGenerator::RegenerateTraffic(MwmSet::MwmId const & mwmId,
+                                         ref_ptr<dp::TextureManager> textures,
+                                         vector<TileKey> & tiles,
+                                         vector<TrafficRenderData> & renderData)
+{
+  m_renderDataCollector = &renderData;
+  for (auto it = m_tilesGeometry.begin(); it != m_tilesGeometry.end();)
+  {
+    if (!m_checkTileFn(it->first))
+    {
+      it = m_tilesGeometry.erase(it);
+      continue;
+    }
+
+    auto const geomIt = it->second.find(mwmId);
+    if (geomIt != it->second.end())
+    {
+      tiles.push_back(it->first);
+      GenerateSegmentsGeometry(it->first, mwmId, geomIt->second, textures);
+    }
+    ++it;
+  }
+  m_renderDataCollector = nullptr;
+
+  GLFunctions::glFlush();
+}
+
+void TrafficGenerator::GenerateSegmentsGeometry(TileKey const & tileKey, MwmSet::MwmId const & mwmId,
+                                                TrafficSegmentsGeometry::mapped_type const & segments,
+                                                ref_ptr<dp::TextureManager> textures)
+{
+  auto const coloringIt = m_coloring.find(mwmId);
+  if (coloringIt == m_coloring.end())
+    return;
+
   FillColorsCache(textures);
   ASSERT(m_colorsCacheValid, ());
   auto const texture = m_colorsCache[static_cast<size_t>(traffic::SpeedGroup::G0)].GetTexture();
@@ -145,76 +189,99 @@ void TrafficGenerator::FlushSegmentsGeometry(TileKey const & tileKey, TrafficSeg
   static float const kDepths[] = {2.0f, 1.0f, 0.0f};
   static vector<int> const kGenerateCapsZoomLevel = {14, 14, 16};
 
-  for (auto geomIt = geom.begin(); geomIt != geom.end(); ++geomIt)
+  for (auto const & roadClass : kRoadClasses)
+    m_batchersPool->ReserveBatcher(TrafficBatcherKey(mwmId, tileKey, roadClass));
+
+  auto & coloring = coloringIt->second;
+  for (size_t i = 0; i < segments.size(); i++)
   {
-    auto coloringIt = m_coloring.find(geomIt->first);
-    if (coloringIt != m_coloring.end())
+    traffic::TrafficInfo::RoadSegmentId const & sid = segments[i].first;
+    auto segmentColoringIt = coloring.find(sid);
+    if (segmentColoringIt != coloring.end())
     {
-      for (auto const & roadClass : kRoadClasses)
-        m_batchersPool->ReserveBatcher(TrafficBatcherKey(geomIt->first, tileKey, roadClass));
+      // We do not generate geometry for unknown segments.
+      if (segmentColoringIt->second == traffic::SpeedGroup::Unknown)
+        continue;
+
+      TrafficSegmentGeometry const & g = segments[i].second;
+      ref_ptr<dp::Batcher> batcher =
+          m_batchersPool->GetBatcher(TrafficBatcherKey(mwmId, tileKey, g.m_roadClass));
+
+      float const depth = kDepths[static_cast<size_t>(g.m_roadClass)];
 
-      auto & coloring = coloringIt->second;
-      for (size_t i = 0; i < geomIt->second.size(); i++)
+      ASSERT(m_colorsCacheValid, ());
+      dp::TextureManager::ColorRegion const & colorRegion =
+          m_colorsCache[static_cast<size_t>(segmentColoringIt->second)];
+      float const vOffset = kCoordVOffsets[static_cast<size_t>(segmentColoringIt->second)];
+      float const minU = kMinCoordU[static_cast<size_t>(segmentColoringIt->second)];
+
+      int width = 0;
+      if (TrafficRenderer::CanBeRendereredAsLine(g.m_roadClass, tileKey.m_zoomLevel, width))
+      {
+        vector<TrafficLineStaticVertex> staticGeometry;
+        GenerateLineSegment(colorRegion, g.m_polyline, tileKey.GetGlobalRect().Center(), depth,
+                            staticGeometry);
+        if (staticGeometry.empty())
+          continue;
+
+        m_providerLines.Reset(static_cast<uint32_t>(staticGeometry.size()));
+        m_providerLines.UpdateStream(0 /* stream index */, make_ref(staticGeometry.data()));
+
+        dp::GLState curLineState = lineState;
+        curLineState.SetLineWidth(width);
+        batcher->InsertLineStrip(curLineState, make_ref(&m_providerLines));
+      }
+      else
       {
-        traffic::TrafficInfo::RoadSegmentId const & sid = geomIt->second[i].first;
-        auto segmentColoringIt = coloring.find(sid);
-        if (segmentColoringIt != coloring.end())
-        {
-          // We do not generate geometry for unknown segments.
-          if (segmentColoringIt->second == traffic::SpeedGroup::Unknown)
-            continue;
-
-          TrafficSegmentGeometry const & g = geomIt->second[i].second;
-          ref_ptr<dp::Batcher> batcher =
-              m_batchersPool->GetBatcher(TrafficBatcherKey(geomIt->first, tileKey, g.m_roadClass));
-
-          float const depth = kDepths[static_cast<size_t>(g.m_roadClass)];
-
-          ASSERT(m_colorsCacheValid, ());
-          dp::TextureManager::ColorRegion const & colorRegion =
-              m_colorsCache[static_cast<size_t>(segmentColoringIt->second)];
-          float const vOffset = kCoordVOffsets[static_cast<size_t>(segmentColoringIt->second)];
-          float const minU = kMinCoordU[static_cast<size_t>(segmentColoringIt->second)];
-
-          int width = 0;
-          if (TrafficRenderer::CanBeRendereredAsLine(g.m_roadClass, tileKey.m_zoomLevel, width))
-          {
-            vector<TrafficLineStaticVertex> staticGeometry;
-            GenerateLineSegment(colorRegion, g.m_polyline, tileKey.GetGlobalRect().Center(), depth,
-                                staticGeometry);
-            if (staticGeometry.empty())
-              continue;
-
-            m_providerLines.Reset(static_cast<uint32_t>(staticGeometry.size()));
-            m_providerLines.UpdateStream(0 /* stream index */, make_ref(staticGeometry.data()));
-
-            dp::GLState curLineState = lineState;
-            curLineState.SetLineWidth(width);
-            batcher->InsertLineStrip(curLineState, make_ref(&m_providerLines));
-          }
-          else
-          {
-            vector<TrafficStaticVertex> staticGeometry;
-            bool const generateCaps =
-                (tileKey.m_zoomLevel > kGenerateCapsZoomLevel[static_cast<uint32_t>(g.m_roadClass)]);
-            GenerateSegment(colorRegion, g.m_polyline, tileKey.GetGlobalRect().Center(),
-                            generateCaps, depth, vOffset, minU, staticGeometry);
-            if (staticGeometry.empty())
-              continue;
-
-            m_providerTriangles.Reset(static_cast<uint32_t>(staticGeometry.size()));
-            m_providerTriangles.UpdateStream(0 /* stream index */, make_ref(staticGeometry.data()));
-            batcher->InsertTriangleList(state, make_ref(&m_providerTriangles));
-          }
-        }
+        vector<TrafficStaticVertex> staticGeometry;
+        bool const generateCaps =
+            (tileKey.m_zoomLevel > kGenerateCapsZoomLevel[static_cast<uint32_t>(g.m_roadClass)]);
+        GenerateSegment(colorRegion, g.m_polyline, tileKey.GetGlobalRect().Center(),
+                        generateCaps, depth, vOffset, minU, staticGeometry);
+        if (staticGeometry.empty())
+          continue;
+
+        m_providerTriangles.Reset(static_cast<uint32_t>(staticGeometry.size()));
+        m_providerTriangles.UpdateStream(0 /* stream index */, make_ref(staticGeometry.data()));
+        batcher->InsertTriangleList(state, make_ref(&m_providerTriangles));
       }
+    }
+  }
+
+  for (auto const & roadClass : kRoadClasses)
+    m_batchersPool->ReleaseBatcher(TrafficBatcherKey(mwmId, tileKey, roadClass));
+}
 
-      for (auto const & roadClass : kRoadClasses)
-        m_batchersPool->ReleaseBatcher(TrafficBatcherKey(geomIt->first, tileKey, roadClass));
+void TrafficGenerator::CacheSegmentsGeometry(TileKey const & tileKey, TrafficSegmentsGeometry && geom)
+{
+  // Geometry of the tiles which are not rendered anymore is not needed for regeneration.
+  for (auto it = m_tilesGeometry.begin(); it != m_tilesGeometry.end();)
+  {
+    if (m_checkTileFn(it->first))
+      ++it;
+    else
+      it = m_tilesGeometry.erase(it);
+  }
+
+  auto it = m_tilesGeometry.find(tileKey);
+  if (it != m_tilesGeometry.end())
+  {
+    if (it->first.EqualStrict(tileKey))
+    {
+      // The same generation of the tile, so the geometry is an addition to the cached one.
+      for (auto & mwmGeometry : geom)
+      {
+        auto & segments = it->second[mwmGeometry.first];
+        segments.insert(segments.end(), make_move_iterator(mwmGeometry.second.begin()),
+                        make_move_iterator(mwmGeometry.second.end()));
+      }
+      return;
     }
+    m_tilesGeometry.erase(it);
   }
 
-  GLFunctions::glFlush();
+  if (!geom.empty())
+    m_tilesGeometry.emplace(tileKey, move(geom));
 }
 
 void TrafficGenerator::UpdateColoring(TrafficSegmentsColoring const & coloring)
@@ -227,6 +294,7 @@ void TrafficGenerator::ClearCache()
 {
   InvalidateTexturesCache();
   m_coloring.clear();
+  m_tilesGeometry.clear();
 }
 
 void TrafficGenerator::ClearCache(MwmSet::MwmId const & mwmId)
@@ -247,7 +315,10 @@ void TrafficGenerator::FlushGeometry(TrafficBatcherKey const & key, dp::GLState
   renderData.m_mwmId = key.m_mwmId;
   renderData.m_tileKey = key.m_tileKey;
   renderData.m_roadClass = key.m_roadClass;
-  m_flushRenderDataFn(move(renderData));
+  if (m_renderDataCollector != nullptr)
+    m_renderDataCollector->push_back(move(renderData));
+  else
+    m_flushRenderDataFn(move(renderData));
 }
 
 void TrafficGenerator::GenerateSegment(dp::TextureManager::ColorRegion const & colorRegion,
@@ -129,9 +129,12 @@ class TrafficGenerator final
 {
 public:
   using TFlushRenderDataFn = function<void (TrafficRenderData && renderData)>;
+  // Returns true if the tile is still rendered, so its traffic may be regenerated.
+  using TCheckTileFn = function<bool (TileKey const & tileKey)>;
 
-  explicit TrafficGenerator(TFlushRenderDataFn flushFn)
+  TrafficGenerator(TFlushRenderDataFn flushFn, TCheckTileFn checkTileFn)
     : m_flushRenderDataFn(flushFn)
+    , m_checkTileFn(checkTileFn)
     , m_providerTriangles(1 /* stream count */, 0 /* vertices count*/)
     , m_providerLines(1 /* stream count */, 0 /* vertices count*/)
   {}
@@ -139,10 +142,16 @@ public:
   void Init();
   void ClearGLDependentResources();
 
-  void FlushSegmentsGeometry(TileKey const & tileKey, TrafficSegmentsGeometry const & geom,
+  void FlushSegmentsGeometry(TileKey const & tileKey, TrafficSegmentsGeometry && geom,
                              ref_ptr<dp::TextureManager> textures);
   void UpdateColoring(TrafficSegmentsColoring const & coloring);
 
+  // Regenerates traffic of |mwmId| from the cached segments geometry of the rendered tiles,
+  // so the tiles are not reread when the coloring changes. The regenerated tiles are added
+  // to |tiles| and their render data is added to |renderData| instead of being flushed.
+  void RegenerateTraffic(MwmSet::MwmId const & mwmId, ref_ptr<dp::TextureManager> textures,
+                         vector<TileKey> & tiles, vector<TrafficRenderData> & renderData);
+
   void ClearCache();
   void ClearCache(MwmSet::MwmId const & mwmId);
   void InvalidateTexturesCache();
@@ -189,16 +198,28 @@ private:
                            vector<TrafficLineStaticVertex> & staticGeometry);
   void FillColorsCache(ref_ptr<dp::TextureManager> textures);
 
+  void GenerateSegmentsGeometry(TileKey const & tileKey, MwmSet::MwmId const & mwmId,
+                                TrafficSegmentsGeometry::mapped_type const & segments,
+                                ref_ptr<dp::TextureManager> textures);
+  void CacheSegmentsGeometry(TileKey const & tileKey, TrafficSegmentsGeometry && geom);
+
   void FlushGeometry(TrafficBatcherKey const & key, dp::GLState const & state,
                      drape_ptr<dp::RenderBucket> && buffer);
 
   TrafficSegmentsColoring m_coloring;
 
+  // Segments geometry of the rendered tiles, strict comparison is not used since only
+  // the latest generation of a tile is kept.
+  map<TileKey, TrafficSegmentsGeometry> m_tilesGeometry;
+
   array<dp::TextureManager::ColorRegion, static_cast<size_t>(traffic::SpeedGroup::Count)> m_colorsCache;
   bool m_colorsCacheValid = false;
 
   drape_ptr<BatchersPool<TrafficBatcherKey, TrafficBatcherKeyComparator>> m_batchersPool;
   TFlushRenderDataFn m_flushRenderDataFn;
+  TCheckTileFn m_checkTileFn;
+  // Render data is collected here instead of being flushed while traffic is regenerated.
+  vector<TrafficRenderData> * m_renderDataCollector = nullptr;
 
   dp::AttributeProvider m_providerTriangles;
   dp::AttributeProvider m_providerLines;
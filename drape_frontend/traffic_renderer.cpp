@@ -101,11 +101,31 @@ void TrafficRenderer::AddRenderData(ref_ptr<dp::GpuProgramManager> mng, TrafficR
 
   // Add new render data.
   m_renderData.emplace_back(move(renderData));
-  TrafficRenderData & rd = m_renderData.back();
+  BuildRenderData(mng, m_renderData.back());
+}
+
+void TrafficRenderer::UpdateRenderData(ref_ptr<dp::GpuProgramManager> mng, MwmSet::MwmId const & mwmId,
+                                       std::vector<TileKey> const & tiles,
+                                       std::vector<TrafficRenderData> && renderData)
+{
+  m_renderData.erase(remove_if(m_renderData.begin(), m_renderData.end(), [&mwmId, &tiles](TrafficRenderData const & rd)
+  {
+    return rd.m_mwmId == mwmId && find(tiles.begin(), tiles.end(), rd.m_tileKey) != tiles.end();
+  }), m_renderData.end());
 
-  ref_ptr<dp::GpuProgram> program = mng->GetProgram(rd.m_state.GetProgramIndex());
+  m_renderData.reserve(m_renderData.size() + renderData.size());
+  for (auto & rd : renderData)
+  {
+    m_renderData.emplace_back(move(rd));
+    BuildRenderData(mng, m_renderData.back());
+  }
+}
+
+void TrafficRenderer::BuildRenderData(ref_ptr<dp::GpuProgramManager> mng, TrafficRenderData & renderData)
+{
+  ref_ptr<dp::GpuProgram> program = mng->GetProgram(renderData.m_state.GetProgramIndex());
   program->Bind();
-  rd.m_bucket->GetBuffer()->Build(program);
+  renderData.m_bucket->GetBuffer()->Build(program);
 }
 
 void TrafficRenderer::OnUpdateViewport(CoverageResult const & coverage, int currentZoomLevel,
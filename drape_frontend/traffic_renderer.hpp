@@ -22,6 +22,10 @@ public:
   void AddRenderData(ref_ptr<dp::GpuProgramManager> mng,
                      TrafficRenderData && renderData);
 
+  // Replaces render data of |mwmId| for |tiles| with the regenerated one.
+  void UpdateRenderData(ref_ptr<dp::GpuProgramManager> mng, MwmSet::MwmId const & mwmId,
+                        std::vector<TileKey> const & tiles, std::vector<TrafficRenderData> && renderData);
+
   void RenderTraffic(ScreenBase const & screen, int zoomLevel, float opacity,
                      ref_ptr<dp::GpuProgramManager> mng,
                      dp::UniformValuesStorage const & commonUniforms);
@@ -39,6 +43,8 @@ public:
   static bool CanBeRendereredAsLine(RoadClass const & roadClass, int zoomLevel, int & width);
 
 private:
+  void BuildRenderData(ref_ptr<dp::GpuProgramManager> mng, TrafficRenderData & renderData);
+
   static float GetPixelWidth(RoadClass const & roadClass, int zoomLevel);
   static float GetPixelWidthInternal(RoadClass const & roadClass, int zoomLevel);
 
@@ -9,6 +9,7 @@
 #include "indexer/scales.hpp"
 
 #include <algorithm>
+#include <iterator>
 
 namespace df
 {
@@ -30,8 +31,61 @@ void UserMarkGenerator::RemoveGroup(MarkGroupID groupId)
 
 void UserMarkGenerator::SetGroup(MarkGroupID groupId, drape_ptr<MarkIDCollection> && ids)
 {
-  m_groups[groupId] = std::move(ids);
-  UpdateIndex(groupId);
+  std::sort(ids->m_marksID.begin(), ids->m_marksID.end());
+
+  auto const groupIt = m_groups.find(groupId);
+  if (groupIt == m_groups.end())
+  {
+    m_groups.emplace(groupId, std::move(ids));
+    UpdateIndex(groupId);
+    return;
+  }
+
+  // Only created, removed and moved marks are reindexed, so a change of one mark doesn't
+  // cost reindexing of the whole group.
+  drape_ptr<MarkIDCollection> const oldIds = std::move(groupIt->second);
+  groupIt->second = std::move(ids);
+  MarkIDCollection const & newIds = *groupIt->second;
+
+  IDCollection removedIds;
+  std::set_difference(oldIds->m_marksID.begin(), oldIds->m_marksID.end(),
+                      newIds.m_marksID.begin(), newIds.m_marksID.end(),
+                      std::back_inserter(removedIds));
+  for (auto markId : removedIds)
+  {
+    auto const it = m_marks.find(markId);
+    if (it != m_marks.end())
+      RemoveMarkFromIndex(markId, *it->second);
+  }
+
+  IDCollection addedIds;
+  std::set_difference(newIds.m_marksID.begin(), newIds.m_marksID.end(),
+                      oldIds->m_marksID.begin(), oldIds->m_marksID.end(),
+                      std::back_inserter(addedIds));
+  for (auto markId : addedIds)
+  {
+    m_movedMarks.erase(markId);
+    AddMarkToIndex(groupId, markId);
+  }
+
+  for (auto it = m_movedMarks.begin(); it != m_movedMarks.end();)
+  {
+    if (std::binary_search(newIds.m_marksID.begin(), newIds.m_marksID.end(), *it))
+    {
+      AddMarkToIndex(groupId, *it);
+      it = m_movedMarks.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  if (m_linesChanged || oldIds->m_linesID != newIds.m_linesID)
+  {
+    UpdateLinesIndex(groupId);
+    CleanIndex();
+  }
 }
 
 void UserMarkGenerator::SetRemovedUserMarks(drape_ptr<MarkIDCollection> && ids)
@@ -39,7 +93,14 @@ void UserMarkGenerator::SetRemovedUserMarks(drape_ptr<MarkIDCollection> && ids)
   if (ids == nullptr)
     return;
   for (auto const & id : ids->m_marksID)
-    m_marks.erase(id);
+  {
+    auto const it = m_marks.find(id);
+    if (it == m_marks.end())
+      continue;
+    RemoveMarkFromIndex(id, *it->second);
+    m_movedMarks.erase(id);
+    m_marks.erase(it);
+  }
   for (auto const & id : ids->m_linesID)
     m_lines.erase(id);
 }
@@ -58,14 +119,25 @@ void UserMarkGenerator::SetUserMarks(drape_ptr<UserMarksRenderCollection> && mar
   {
     auto it = m_marks.find(pair.first);
     if (it != m_marks.end())
+    {
+      if (it->second->m_pivot != pair.second->m_pivot ||
+          it->second->m_minZoom != pair.second->m_minZoom)
+      {
+        RemoveMarkFromIndex(pair.first, *it->second);
+        m_movedMarks.insert(pair.first);
+      }
       it->second = std::move(pair.second);
+    }
     else
+    {
       m_marks.emplace(pair.first, std::move(pair.second));
+    }
   }
 }
 
 void UserMarkGenerator::SetUserLines(drape_ptr<UserLinesRenderCollection> && lines)
 {
+  m_linesChanged = m_linesChanged || !lines->empty();
   for (auto & pair : *lines.get())
   {
     auto it = m_lines.find(pair.first);
@@ -93,20 +165,31 @@ void UserMarkGenerator::UpdateIndex(MarkGroupID groupId)
   if (groupIt == m_groups.end())
     return;
 
-  MarkIDCollection & idCollection = *groupIt->second.get();
+  for (auto markId : groupIt->second->m_marksID)
+  {
+    m_movedMarks.erase(markId);
+    AddMarkToIndex(groupId, markId);
+  }
+
+  UpdateLinesIndex(groupId);
+  CleanIndex();
+}
 
-  for (auto markId : idCollection.m_marksID)
+void UserMarkGenerator::UpdateLinesIndex(MarkGroupID groupId)
+{
+  m_linesChanged = false;
+  for (auto & tileGroups : m_index)
   {
-    UserMarkRenderParams const & params = *m_marks[markId].get();
-    for (int zoomLevel = params.m_minZoom; zoomLevel <= scales::GetUpperScale(); ++zoomLevel)
-    {
-      TileKey const tileKey = GetTileKeyByPoint(params.m_pivot, zoomLevel);
-      ref_ptr<MarkIDCollection> groupIDs = GetIdCollection(tileKey, groupId);
-      groupIDs->m_marksID.push_back(static_cast<uint32_t>(markId));
-    }
+    auto itGroupIndexes = tileGroups.second->find(groupId);
+    if (itGroupIndexes != tileGroups.second->end())
+      itGroupIndexes->second->m_linesID.clear();
   }
 
-  for (auto lineId : idCollection.m_linesID)
+  auto const groupIt = m_groups.find(groupId);
+  if (groupIt == m_groups.end())
+    return;
+
+  for (auto lineId : groupIt->second->m_linesID)
   {
     UserLineRenderParams const & params = *m_lines[lineId].get();
 
@@ -132,8 +215,41 @@ void UserMarkGenerator::UpdateIndex(MarkGroupID groupId)
       });
     }
   }
+}
 
-  CleanIndex();
+void UserMarkGenerator::AddMarkToIndex(MarkGroupID groupId, MarkID markId)
+{
+  UserMarkRenderParams const & params = *m_marks[markId].get();
+  for (int zoomLevel = params.m_minZoom; zoomLevel <= scales::GetUpperScale(); ++zoomLevel)
+  {
+    TileKey const tileKey = GetTileKeyByPoint(params.m_pivot, zoomLevel);
+    ref_ptr<MarkIDCollection> groupIDs = GetIdCollection(tileKey, groupId);
+    groupIDs->m_marksID.push_back(static_cast<uint32_t>(markId));
+  }
+}
+
+void UserMarkGenerator::RemoveMarkFromIndex(MarkID markId, UserMarkRenderParams const & params)
+{
+  for (int zoomLevel = params.m_minZoom; zoomLevel <= scales::GetUpperScale(); ++zoomLevel)
+  {
+    auto const tileIt = m_index.find(GetTileKeyByPoint(params.m_pivot, zoomLevel));
+    if (tileIt == m_index.end())
+      continue;
+
+    MarksIDGroups & tileGroups = *tileIt->second;
+    for (auto groupIt = tileGroups.begin(); groupIt != tileGroups.end();)
+    {
+      IDCollection & ids = groupIt->second->m_marksID;
+      ids.erase(std::remove(ids.begin(), ids.end(), markId), ids.end());
+      if (ids.empty() && groupIt->second->m_linesID.empty())
+        groupIt = tileGroups.erase(groupIt);
+      else
+        ++groupIt;
+    }
+
+    if (tileGroups.empty())
+      m_index.erase(tileIt);
+  }
 }
 
 ref_ptr<MarkIDCollection> UserMarkGenerator::GetIdCollection(TileKey const & tileKey, MarkGroupID groupId)
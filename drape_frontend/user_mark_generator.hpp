@@ -35,6 +35,9 @@ public:
 
 private:
   void UpdateIndex(MarkGroupID groupId);
+  void UpdateLinesIndex(MarkGroupID groupId);
+  void AddMarkToIndex(MarkGroupID groupId, MarkID markId);
+  void RemoveMarkFromIndex(MarkID markId, UserMarkRenderParams const & params);
 
   ref_ptr<MarkIDCollection> GetIdCollection(TileKey const & tileKey, MarkGroupID groupId);
   void CleanIndex();
@@ -57,6 +60,11 @@ private:
 
   MarksIndex m_index;
 
+  // Marks which pivot or min zoom has been changed since the last SetGroup(), they are
+  // removed from the index and wait to be added back.
+  std::set<MarkID> m_movedMarks;
+  bool m_linesChanged = false;
+
   TFlushFn m_flushFn;
 };
 }  // namespace df
@@ -16,7 +16,9 @@
 #include "indexer/feature_decl.hpp"
 
 #include "geometry/clipping.hpp"
+#include "geometry/distance.hpp"
 #include "geometry/mercator.hpp"
+#include "geometry/simplification.hpp"
 
 #include <vector>
 
@@ -31,6 +33,52 @@ int const kLineSimplifyLevelEnd = 15;
 
 namespace
 {
+// Min length of a segment and max deviation of a simplified line, in pixels.
+double const kMinSegmentLengthInPixel = 4.0;
+double const kSimplificationToleranceInPixel = 1.0;
+
+m2::SharedSpline const & GetSimplifiedSpline(UserLineRenderParams & renderInfo, int zoomLevel)
+{
+  auto & spline = renderInfo.m_simplifiedSplines[zoomLevel];
+  if (!spline.IsNull())
+    return spline;
+
+  double const vs = df::VisualParams::Instance().GetVisualScale();
+  double const pixelInGlobal = GetScale(zoomLevel);
+  double const minSegmentLength = kMinSegmentLengthInPixel * vs * pixelInGlobal;
+  double const tolerance = kSimplificationToleranceInPixel * vs * pixelInGlobal;
+
+  // Short segments are merged first, then Douglas-Peucker removes points of nearly
+  // straight parts, which are the most of points of long tracks on small scales.
+  std::vector<m2::PointD> const & path = renderInfo.m_spline->GetPath();
+  std::vector<m2::PointD> filtered;
+  filtered.reserve(path.size());
+  m2::PointD lastAddedPoint;
+  for (auto const & point : path)
+  {
+    if (filtered.size() > 1 &&
+        point.SquareLength(lastAddedPoint) < minSegmentLength * minSegmentLength)
+    {
+      filtered.back() = point;
+    }
+    else
+    {
+      filtered.push_back(point);
+      lastAddedPoint = point;
+    }
+  }
+
+  std::vector<m2::PointD> simplified;
+  simplified.reserve(filtered.size());
+  SimplifyDP(filtered.begin(), filtered.end(), tolerance * tolerance,
+             m2::DistanceToLineSquare<m2::PointD>(), MakeBackInsertFunctor(simplified));
+  if (simplified.size() < 2)
+    simplified = {path.front(), path.back()};
+
+  spline.Reset(new m2::Spline(simplified));
+  return spline;
+}
+
 
 template <typename TCreateVector>
 void AlignFormingNormals(TCreateVector const & fn, dp::Anchor anchor,
@@ -244,18 +292,15 @@ void CacheUserLines(TileKey const & tileKey, ref_ptr<dp::TextureManager> texture
   float const vs = static_cast<float>(df::VisualParams::Instance().GetVisualScale());
   bool const simplify = tileKey.m_zoomLevel <= kLineSimplifyLevelEnd;
 
-  double sqrScale = 1.0;
-  if (simplify)
-  {
-    double const currentScaleGtoP = 1.0 / GetScale(tileKey.m_zoomLevel);
-    sqrScale = math::sqr(currentScaleGtoP);
-  }
-
   for (auto id : linesId)
   {
     auto const it = renderParams.find(id);
     ASSERT(it != renderParams.end(), ());
-    UserLineRenderParams const & renderInfo = *it->second.get();
+    UserLineRenderParams & renderInfo = *it->second.get();
+
+    // Simplified splines are cached, so a line isn't simplified again for every tile.
+    m2::SharedSpline const spline =
+        simplify ? GetSimplifiedSpline(renderInfo, tileKey.m_zoomLevel) : renderInfo.m_spline;
 
     m2::RectD const tileRect = tileKey.GetGlobalRect();
 
@@ -263,7 +308,7 @@ void CacheUserLines(TileKey const & tileKey, ref_ptr<dp::TextureManager> texture
     double const maxLength = range / (1 << (tileKey.m_zoomLevel - 1));
 
     bool intersected = false;
-    ProcessSplineSegmentRects(renderInfo.m_spline, maxLength,
+    ProcessSplineSegmentRects(spline, maxLength,
                               [&tileRect, &intersected](m2::RectD const & segmentRect)
     {
       if (segmentRect.IsIntersect(tileRect))
@@ -274,27 +319,6 @@ void CacheUserLines(TileKey const & tileKey, ref_ptr<dp::TextureManager> texture
     if (!intersected)
       continue;
 
-    m2::SharedSpline spline = renderInfo.m_spline;
-    if (simplify)
-    {
-      spline.Reset(new m2::Spline(renderInfo.m_spline->GetSize()));
-
-      static double const kMinSegmentLength = math::sqr(4.0 * vs);
-      m2::PointD lastAddedPoint;
-      for (auto const & point : renderInfo.m_spline->GetPath())
-      {
-        if (spline->GetSize() > 1 && point.SquareLength(lastAddedPoint) * sqrScale < kMinSegmentLength)
-        {
-          spline->ReplacePoint(point);
-        }
-        else
-        {
-          spline->AddPoint(point);
-          lastAddedPoint = point;
-        }
-      }
-    }
-
     auto const clippedSplines = m2::ClipSplineByRect(tileRect, spline);
     for (auto const & clippedSpline : clippedSplines)
     {
@@ -8,6 +8,7 @@
 
 #include "geometry/spline.hpp"
 
+#include <map>
 #include <memory>
 #include <unordered_map>
 
@@ -52,6 +53,8 @@ struct UserLineRenderParams
   RenderState::DepthLayer m_depthLayer = RenderState::UserLineLayer;
   std::vector<LineLayer> m_layers;
   m2::SharedSpline m_spline;
+  // Simplified splines by zoom levels, they are built on demand by CacheUserLines().
+  std::map<int, m2::SharedSpline> m_simplifiedSplines;
 };
 
 using UserMarksRenderCollection = std::unordered_map<MarkID, drape_ptr<UserMarkRenderParams>>;
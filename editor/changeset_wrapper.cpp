@@ -109,6 +109,9 @@ ChangesetWrapper::ChangesetWrapper(TKeySecret const & keySecret,
 
 ChangesetWrapper::~ChangesetWrapper()
 {
+  if (m_queuedChangesCount != 0)
+    LOG(LWARNING, (m_queuedChangesCount, "queued changes were not uploaded."));
+
   if (m_changesetId)
   {
     try
@@ -232,36 +235,66 @@ XMLFeature ChangesetWrapper::GetMatchingAreaFeatureFromOSM(vector<m2::PointD> co
 
 void ChangesetWrapper::Create(XMLFeature node)
 {
-  if (m_changesetId == kInvalidChangesetId)
-    m_changesetId = m_api.CreateChangeSet(m_changesetComments);
-
-  // Changeset id should be updated for every OSM server commit.
-  node.SetAttribute("changeset", strings::to_string(m_changesetId));
-  // TODO(AlexZ): Think about storing/logging returned OSM ids.
-  UNUSED_VALUE(m_api.CreateElement(node));
-  m_created_types[GetTypeForFeature(node)]++;
+  // Placeholder ids are replaced with real ones by the server.
+  node.SetAttribute("id", strings::to_string(--m_lastPlaceholderId));
+  QueueChange("create", node);
+  m_queued_created_types[GetTypeForFeature(node)]++;
 }
 
 void ChangesetWrapper::Modify(XMLFeature node)
 {
-  if (m_changesetId == kInvalidChangesetId)
-    m_changesetId = m_api.CreateChangeSet(m_changesetComments);
-
-  // Changeset id should be updated for every OSM server commit.
-  node.SetAttribute("changeset", strings::to_string(m_changesetId));
-  m_api.ModifyElement(node);
-  m_modified_types[GetTypeForFeature(node)]++;
+  QueueChange("modify", node);
+  m_queued_modified_types[GetTypeForFeature(node)]++;
 }
 
 void ChangesetWrapper::Delete(XMLFeature node)
+{
+  QueueChange("delete", node);
+  m_queued_deleted_types[GetTypeForFeature(node)]++;
+}
+
+void ChangesetWrapper::QueueChange(char const * action, XMLFeature & node)
 {
   if (m_changesetId == kInvalidChangesetId)
     m_changesetId = m_api.CreateChangeSet(m_changesetComments);
 
+  pugi::xml_node root = m_diff.child("osmChange");
+  if (!root)
+  {
+    root = m_diff.append_child("osmChange");
+    root.append_attribute("version") = "0.6";
+  }
+
   // Changeset id should be updated for every OSM server commit.
   node.SetAttribute("changeset", strings::to_string(m_changesetId));
-  m_api.DeleteElement(node);
-  m_deleted_types[GetTypeForFeature(node)]++;
+  VERIFY(node.AttachToParentNode(root.append_child(action)), ());
+  ++m_queuedChangesCount;
+}
+
+void ChangesetWrapper::Flush()
+{
+  if (m_queuedChangesCount == 0)
+    return;
+
+  ostringstream diff;
+  m_diff.save(diff, "  ");
+
+  m_diff.reset();
+  m_queuedChangesCount = 0;
+  m_lastPlaceholderId = 0;
+  TTypeCount created, modified, deleted;
+  created.swap(m_queued_created_types);
+  modified.swap(m_queued_modified_types);
+  deleted.swap(m_queued_deleted_types);
+
+  m_api.UploadChangeSetDiff(m_changesetId, diff.str());
+
+  for (auto const & tc : created)
+    m_created_types[tc.first] += tc.second;
+  for (auto const & tc : modified)
+    m_modified_types[tc.first] += tc.second;
+  for (auto const & tc : deleted)
+    m_deleted_types[tc.first] += tc.second;
 }
 
 string ChangesetWrapper::TypeCountToString(TTypeCount const & typeCount)
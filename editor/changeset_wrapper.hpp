@@ -43,6 +43,7 @@ public:
   editor::XMLFeature GetMatchingNodeFeatureFromOSM(m2::PointD const & center);
   editor::XMLFeature GetMatchingAreaFeatureFromOSM(vector<m2::PointD> const & geomerty);
 
+  /// Changes are queued and are not sent to OSM until Flush() is called.
   /// Throws exceptions from above list.
   void Create(editor::XMLFeature node);
 
@@ -53,6 +54,11 @@ public:
   /// Throws exceptions from above list.
   void Delete(editor::XMLFeature node);
 
+  /// Uploads all queued changes as one osmChange diff. Queued changes are dropped
+  /// in any case, and none of them is applied if an exception is thrown.
+  void Flush();
+  size_t GetQueuedChangesCount() const { return m_queuedChangesCount; }
+
   uint64_t GetChangesetId() const { return m_changesetId; }
 
 private:
@@ -61,11 +67,25 @@ private:
   void LoadXmlFromOSM(ms::LatLon const & ll, pugi::xml_document & doc, double radiusInMeters = 1.0);
   void LoadXmlFromOSM(ms::LatLon const & min, ms::LatLon const & max, pugi::xml_document & doc);
 
+  /// Throws exceptions from above list.
+  void QueueChange(char const * action, editor::XMLFeature & node);
+
   ServerApi06::TKeyValueTags m_changesetComments;
   ServerApi06 m_api;
   static constexpr uint64_t kInvalidChangesetId = 0;
   uint64_t m_changesetId = kInvalidChangesetId;
 
+  /// osmChange document with queued changes.
+  pugi::xml_document m_diff;
+  size_t m_queuedChangesCount = 0;
+  /// Created elements have negative placeholder ids within a diff.
+  int64_t m_lastPlaceholderId = 0;
+
+  /// Types of queued changes, they are moved to types below after a successful Flush().
+  TTypeCount m_queued_modified_types;
+  TTypeCount m_queued_created_types;
+  TTypeCount m_queued_deleted_types;
+
   TTypeCount m_modified_types;
   TTypeCount m_created_types;
   TTypeCount m_deleted_types;
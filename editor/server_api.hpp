@@ -42,6 +42,7 @@ public:
   DECLARE_EXCEPTION(ErrorAddingNote, ServerApi06Exception);
   DECLARE_EXCEPTION(DeletedElementHasNoIdAttribute, ServerApi06Exception);
   DECLARE_EXCEPTION(ErrorDeletingElement, ServerApi06Exception);
+  DECLARE_EXCEPTION(UploadChangeSetDiffHasFailed, ServerApi06Exception);
   DECLARE_EXCEPTION(CantGetUserPreferences, ServerApi06Exception);
   DECLARE_EXCEPTION(CantParseUserPreferences, ServerApi06Exception);
 
@@ -71,6 +72,10 @@ public:
   /// @param element should already have all attributes set, including "id", "version", "changeset".
   /// @returns true if element was successfully deleted (or was already deleted).
   void DeleteElement(editor::XMLFeature const & element) const;
+  /// Uploads all elements of osmChange document in one request. Server applies either all
+  /// of the changes or none of them.
+  /// @param osmChange should have "changeset" attribute of all elements set to |changesetId|.
+  void UploadChangeSetDiff(uint64_t changesetId, string const & osmChange) const;
   void UpdateChangeSet(uint64_t changesetId, TKeyValueTags const & kvTags) const;
   void CloseChangeSet(uint64_t changesetId) const;
   /// @returns id of a created note.
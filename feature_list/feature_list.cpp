@@ -1,4 +1,5 @@
 #include "base/logging.hpp"
+#include "base/stl_helpers.hpp"
 #include "base/string_utils.hpp"
 
 #include "coding/file_name_utils.hpp"
@@ -24,7 +25,12 @@
 #include "storage/storage.hpp"
 
 #include "std/algorithm.hpp"
+#include "std/atomic.hpp"
+#include "std/condition_variable.hpp"
 #include "std/iostream.hpp"
+#include "std/mutex.hpp"
+#include "std/sstream.hpp"
+#include "std/thread.hpp"
 
 class ClosestPoint
 {
@@ -174,9 +180,7 @@ public:
 
   void ClearCache() { m_villagesCache.Clear(); }
 
-  void operator()(FeatureType const & f, uint32_t const & id) { Process(f); }
-
-  void Process(FeatureType const & f)
+  void Process(FeatureType const & f, ostream & out)
   {
     f.ParseBeforeStatistic();
     string const & category = GetReadableType(f);
@@ -235,10 +239,82 @@ public:
                               website,      cuisine,    stars,        operatr,   internet,
                               denomination, wheelchair, opening_hours};
     AppendNames(f, columns);
-    PrintAsCSV(columns, ';', cout);
+    PrintAsCSV(columns, ';', out);
   }
 };
 
+// Processes mwms on several threads and prints their features in the order of mwms.
+// Every mwm is printed as soon as it and all mwms before it are processed.
+class ParallelExporter
+{
+public:
+  ParallelExporter(Index const & index, vector<shared_ptr<MwmInfo>> const & mwms)
+    : m_index(index), m_mwms(mwms), m_outputs(mwms.size()), m_ready(mwms.size(), false)
+  {
+  }
+
+  void Run(size_t numThreads, ostream & out)
+  {
+    vector<thread> threads;
+    for (size_t i = 0; i < numThreads; ++i)
+      threads.emplace_back(&ParallelExporter::ProcessMwms, this);
+
+    for (size_t i = 0; i < m_mwms.size(); ++i)
+    {
+      string output;
+      {
+        unique_lock<mutex> lock(m_mu);
+        m_cv.wait(lock, [this, i]() { return m_ready[i]; });
+        output.swap(m_outputs[i]);
+      }
+      out << output;
+      out.flush();
+    }
+
+    for (auto & t : threads)
+      t.join();
+  }
+
+private:
+  void ProcessMwms()
+  {
+    Processor doProcess(m_index);
+    while (true)
+    {
+      size_t const i = m_next++;
+      if (i >= m_mwms.size())
+        break;
+
+      auto const & mwmInfo = m_mwms[i];
+      LOG(LINFO, ("Processing", mwmInfo->GetCountryName()));
+      ostringstream out;
+      MwmSet::MwmId mwmId(mwmInfo);
+      Index::FeaturesLoaderGuard loader(m_index, mwmId);
+      for (uint32_t ftIndex = 0; ftIndex < loader.GetNumFeatures(); ftIndex++)
+      {
+        FeatureType ft;
+        if (loader.GetFeatureByIndex(static_cast<uint32_t>(ftIndex), ft))
+          doProcess.Process(ft, out);
+      }
+      doProcess.ClearCache();
+
+      lock_guard<mutex> lock(m_mu);
+      m_outputs[i] = out.str();
+      m_ready[i] = true;
+      m_cv.notify_one();
+    }
+  }
+
+  Index const & m_index;
+  vector<shared_ptr<MwmInfo>> const & m_mwms;
+  atomic<size_t> m_next{0};
+
+  mutex m_mu;
+  condition_variable m_cv;
+  vector<string> m_outputs;
+  vector<bool> m_ready;
+};
+
 void PrintHeader()
 {
   vector<string> columns = {"id",           "lat",        "lon",          "mwm",      "category",
@@ -304,27 +380,18 @@ int main(int argc, char ** argv)
     CHECK(id.IsAlive(), ("Mwm is not alive?", mwm));
   }
 
-  Processor doProcess(index);
   PrintHeader();
   vector<shared_ptr<MwmInfo>> mwmInfos;
   index.GetMwmsInfo(mwmInfos);
-  for (auto const & mwmInfo : mwmInfos)
+  my::EraseIf(mwmInfos, [&](shared_ptr<MwmInfo> const & mwmInfo)
   {
-    if (mwmInfo->GetType() != MwmInfo::COUNTRY)
-      continue;
-    if (argc > 3 && !strings::StartsWith(mwmInfo->GetCountryName() + DATA_FILE_EXTENSION, argv[3]))
-      continue;
-    LOG(LINFO, ("Processing", mwmInfo->GetCountryName()));
-    MwmSet::MwmId mwmId(mwmInfo);
-    Index::FeaturesLoaderGuard loader(index, mwmId);
-    for (uint32_t ftIndex = 0; ftIndex < loader.GetNumFeatures(); ftIndex++)
-    {
-      FeatureType ft;
-      if (loader.GetFeatureByIndex(static_cast<uint32_t>(ftIndex), ft))
-        doProcess.Process(ft);
-    }
-    doProcess.ClearCache();
-  }
+    return mwmInfo->GetType() != MwmInfo::COUNTRY ||
+           (argc > 3 &&
+            !strings::StartsWith(mwmInfo->GetCountryName() + DATA_FILE_EXTENSION, argv[3]));
+  });
+
+  ParallelExporter exporter(index, mwmInfos);
+  exporter.Run(max(thread::hardware_concurrency(), 1U), cout);
 
   return 0;
 }
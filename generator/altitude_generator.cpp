@@ -1,4 +1,5 @@
 #include "generator/altitude_generator.hpp"
+#include "generator/parallel_utils.hpp"
 #include "generator/routing_generator.hpp"
 #include "generator/srtm_parser.hpp"
 
@@ -22,7 +23,6 @@
 #include "base/assert.hpp"
 #include "base/checked_cast.hpp"
 #include "base/logging.hpp"
-#include "base/scope_guard.hpp"
 #include "base/stl_helpers.hpp"
 #include "base/string_utils.hpp"
 
@@ -46,7 +46,10 @@ using namespace routing;
 class SrtmGetter : public AltitudeGetter
 {
 public:
-  SrtmGetter(std::string const & srtmDir) : m_srtmManager(srtmDir) {}
+  SrtmGetter(std::string const & srtmDir, std::string const & srtmCacheDir)
+    : m_srtmManager(srtmDir, srtmCacheDir, srtmCacheDir.empty() ? 0 : kMaxCachedTiles)
+  {
+  }
 
   // AltitudeGetter overrides:
   feature::TAltitude GetAltitude(m2::PointD const & p) override
@@ -55,9 +58,14 @@ public:
   }
 
 private:
+  // A decompressed tile takes 25 MB, mapped ones are evicted from memory by the kernel anyway.
+  static size_t constexpr kMaxCachedTiles = 64;
+
   generator::SrtmTileManager m_srtmManager;
 };
 
+size_t constexpr SrtmGetter::kMaxCachedTiles;
+
 class Processor
 {
 public:
@@ -75,8 +83,10 @@ public:
 
   using TFeatureAltitudes = std::vector<FeatureAltitude>;
 
-  Processor(AltitudeGetter & altitudeGetter)
-    : m_altitudeGetter(altitudeGetter), m_minAltitude(kInvalidAltitude)
+  Processor(AltitudeGetter & altitudeGetter, size_t threadsCount)
+    : m_altitudeGetter(altitudeGetter)
+    , m_threadsCount(std::max(threadsCount, static_cast<size_t>(1)))
+    , m_minAltitude(kInvalidAltitude)
   {
   }
 
@@ -97,9 +107,7 @@ public:
       return;
     }
 
-    bool hasAltitude = false;
-    MY_SCOPE_GUARD(altitudeAvailabilityBuilding,
-                   [&]() { m_altitudeAvailabilityBuilder.push_back(hasAltitude); });
+    m_altitudeAvailabilityBuilder.push_back(false);
 
     if (!routing::IsRoad(feature::TypesHolder(f)))
       return;
@@ -109,32 +117,37 @@ public:
     if (pointsCount == 0)
       return;
 
-    TAltitudes altitudes;
-    TAltitude minFeatureAltitude = kInvalidAltitude;
+    m_roads.emplace_back();
+    Road & road = m_roads.back();
+    road.m_featureId = id;
+    road.m_points.reserve(pointsCount);
     for (size_t i = 0; i < pointsCount; ++i)
-    {
-      TAltitude const a = m_altitudeGetter.GetAltitude(f.GetPoint(i));
-      if (a == kInvalidAltitude)
-      {
-        // One invalid point invalidates the whole feature.
-        return;
-      }
+      road.m_points.push_back(f.GetPoint(i));
 
-      if (minFeatureAltitude == kInvalidAltitude)
-        minFeatureAltitude = a;
-      else
-        minFeatureAltitude = std::min(minFeatureAltitude, a);
+    if (m_roads.size() >= kRoadsBatchSize)
+      Flush();
+  }
 
-      altitudes.push_back(a);
-    }
+  // Gets altitudes of the collected roads. Must be called after the last feature.
+  void Flush()
+  {
+    generator::ForEachIndexInParallel(m_threadsCount, m_roads.size(),
+                                      [this](size_t i) { CalcAltitudes(m_roads[i]); });
 
-    hasAltitude = true;
-    m_featureAltitudes.emplace_back(id, Altitudes(std::move(altitudes)));
+    for (Road & road : m_roads)
+    {
+      if (road.m_altitudes.empty())
+        continue;
 
-    if (m_minAltitude == kInvalidAltitude)
-      m_minAltitude = minFeatureAltitude;
-    else
-      m_minAltitude = std::min(minFeatureAltitude, m_minAltitude);
+      m_altitudeAvailabilityBuilder.set(road.m_featureId, true);
+      m_featureAltitudes.emplace_back(road.m_featureId, Altitudes(std::move(road.m_altitudes)));
+
+      if (m_minAltitude == kInvalidAltitude)
+        m_minAltitude = road.m_minAltitude;
+      else
+        m_minAltitude = std::min(road.m_minAltitude, m_minAltitude);
+    }
+    m_roads.clear();
   }
 
   bool HasAltitudeInfo() const { return !m_featureAltitudes.empty(); }
@@ -146,22 +159,66 @@ public:
   }
 
 private:
+  // Roads are collected in batches, so altitudes of a batch are got on several threads.
+  static size_t constexpr kRoadsBatchSize = 4096;
+
+  struct Road
+  {
+    uint32_t m_featureId = 0;
+    std::vector<m2::PointD> m_points;
+    // Empty if altitude of some point is unknown.
+    TAltitudes m_altitudes;
+    TAltitude m_minAltitude = kInvalidAltitude;
+  };
+
+  void CalcAltitudes(Road & road) const
+  {
+    TAltitudes altitudes;
+    altitudes.reserve(road.m_points.size());
+    TAltitude minAltitude = kInvalidAltitude;
+    for (auto const & p : road.m_points)
+    {
+      TAltitude const a = m_altitudeGetter.GetAltitude(p);
+      if (a == kInvalidAltitude)
+      {
+        // One invalid point invalidates the whole feature.
+        return;
+      }
+
+      if (minAltitude == kInvalidAltitude)
+        minAltitude = a;
+      else
+        minAltitude = std::min(minAltitude, a);
+
+      altitudes.push_back(a);
+    }
+
+    road.m_altitudes = std::move(altitudes);
+    road.m_minAltitude = minAltitude;
+  }
+
   AltitudeGetter & m_altitudeGetter;
+  size_t const m_threadsCount;
+  std::vector<Road> m_roads;
   TFeatureAltitudes m_featureAltitudes;
   succinct::bit_vector_builder m_altitudeAvailabilityBuilder;
   TAltitude m_minAltitude;
 };
+
+size_t constexpr Processor::kRoadsBatchSize;
 }  // namespace
 
 namespace routing
 {
-void BuildRoadAltitudes(std::string const & mwmPath, AltitudeGetter & altitudeGetter)
+void BuildRoadAltitudes(std::string const & mwmPath, AltitudeGetter & altitudeGetter,
+                        size_t threadsCount)
 {
   try
   {
     // Preparing altitude information.
-    Processor processor(altitudeGetter);
+    Processor processor(altitudeGetter, threadsCount);
     feature::ForEachFromDat(mwmPath, processor);
+    processor.Flush();
 
     if (!processor.HasAltitudeInfo())
     {
@@ -234,10 +291,11 @@ void BuildRoadAltitudes(std::string const & mwmPath, AltitudeGetter & altitudeGe
   }
 }
 
-void BuildRoadAltitudes(std::string const & mwmPath, std::string const & srtmDir)
+void BuildRoadAltitudes(std::string const & mwmPath, std::string const & srtmDir,
+                        std::string const & srtmCacheDir, size_t threadsCount)
 {
-  LOG(LINFO, ("mwmPath =", mwmPath, "srtmDir =", srtmDir));
-  SrtmGetter srtmGetter(srtmDir);
-  BuildRoadAltitudes(mwmPath, srtmGetter);
+  LOG(LINFO, ("mwmPath =", mwmPath, "srtmDir =", srtmDir, "srtmCacheDir =", srtmCacheDir));
+  SrtmGetter srtmGetter(srtmDir, srtmCacheDir);
+  BuildRoadAltitudes(mwmPath, srtmGetter, threadsCount);
 }
 }  // namespace routing
@@ -4,6 +4,7 @@
 
 #include "indexer/feature_altitude.hpp"
 
+#include <cstddef>
 #include <string>
 
 namespace routing
@@ -11,6 +12,8 @@ namespace routing
 class AltitudeGetter
 {
 public:
+  /// \note It's called on several threads if BuildRoadAltitudes() is called with
+  /// |threadsCount| > 1.
   virtual feature::TAltitude GetAltitude(m2::PointD const & p) = 0;
 };
 
@@ -24,6 +27,11 @@ public:
 /// 16                  altitude availability feat. table offset - 16
 /// feat. table offset  feature table         alt. info offset - feat. table offset
 /// alt. info offset    altitude info         end of section - alt. info offset
-void BuildRoadAltitudes(std::string const & mwmPath, AltitudeGetter & altitudeGetter);
-void BuildRoadAltitudes(std::string const & mwmPath, std::string const & srtmDir);
+void BuildRoadAltitudes(std::string const & mwmPath, AltitudeGetter & altitudeGetter,
+                        size_t threadsCount = 1);
+/// \param srtmCacheDir is a directory for decompressed SRTM tiles. They are unzipped once
+/// and mapped then. If it's empty tiles are unzipped to memory for every mwm.
+void BuildRoadAltitudes(std::string const & mwmPath, std::string const & srtmDir,
+                        std::string const & srtmCacheDir = std::string(),
+                        size_t threadsCount = 1);
 }  // namespace routing
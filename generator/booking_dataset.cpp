@@ -29,6 +29,7 @@ BookingHotel::BookingHotel(std::string const & src)
   CLOG(LDEBUG, strings::to_double(rec[FieldIndex(Fields::Longtitude)], m_latLon.lon), ());
 
   m_name = rec[FieldIndex(Fields::Name)];
+  m_nameWords = impl::MakeWeightedBagOfWords(m_name);
   m_address = rec[FieldIndex(Fields::Address)];
 
   CLOG(LDEBUG, strings::to_uint(rec[FieldIndex(Fields::Stars)], m_stars), ());
@@ -198,10 +199,13 @@ BookingDataset::ObjectId BookingDataset::FindMatchingObjectIdImpl(FeatureBuilder
   // Find |kMaxSelectedElements| nearest values to a point.
   auto const bookingIndexes =
       m_storage.GetNearestObjects(MercatorBounds::ToLatLon(fb.GetKeyPoint()));
+  if (bookingIndexes.empty())
+    return Object::InvalidObjectId();
 
+  auto const nameWords = impl::MakeWeightedBagOfWords(name);
   for (auto const j : bookingIndexes)
   {
-    if (sponsored_scoring::Match(m_storage.GetObjectById(j), fb).IsMatched())
+    if (sponsored_scoring::Match(m_storage.GetObjectById(j), fb, nameWords).IsMatched())
       return j;
   }
 
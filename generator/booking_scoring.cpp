@@ -28,7 +28,8 @@ bool MatchStats<BookingHotel>::IsMatched() const
 
 // TODO(mgsergio): Do I need to specialize this method?
 template <>
-MatchStats<BookingHotel> Match(BookingHotel const & h, FeatureBuilder1 const & fb)
+MatchStats<BookingHotel> Match(BookingHotel const & h, FeatureBuilder1 const & fb,
+                               impl::WeightedBagOfWords const & fbName)
 {
   MatchStats<BookingHotel> score;
 
@@ -38,10 +39,16 @@ MatchStats<BookingHotel> Match(BookingHotel const & h, FeatureBuilder1 const & f
       impl::GetLinearNormDistanceScore(distance, BookingDataset::kDistanceLimitInMeters);
 
   // TODO(mgsergio): Check all translations and use the best one.
-  score.m_nameSimilarityScore =
-      impl::GetNameSimilarityScore(h.m_name, fb.GetName(StringUtf8Multilang::kDefaultCode));
+  score.m_nameSimilarityScore = impl::GetNameSimilarityScore(h.m_nameWords, fbName);
 
   return score;
 }
+
+template <>
+MatchStats<BookingHotel> Match(BookingHotel const & h, FeatureBuilder1 const & fb)
+{
+  return Match(h, fb,
+               impl::MakeWeightedBagOfWords(fb.GetName(StringUtf8Multilang::kDefaultCode)));
+}
 }  // namespace sponsored_scoring
 }  // namespace generator
@@ -1,5 +1,6 @@
 #include "generator/borders_loader.hpp"
 #include "generator/borders_generator.hpp"
+#include "generator/parallel_utils.hpp"
 
 #include "defines.hpp"
 
@@ -20,8 +21,11 @@
 
 #include "base/exception.hpp"
 #include "base/logging.hpp"
+#include "base/math.hpp"
 #include "base/string_utils.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <functional>
 #include <iomanip>
@@ -31,71 +35,201 @@
 namespace borders
 {
 
-class PolygonLoader
+// BordersCoverage ---------------------------------------------------------------------------------
+BordersCoverage::BordersCoverage(std::vector<Region> const & regions, m2::RectD const & rect)
+  : m_rect(rect)
 {
-  CountryPolygons m_polygons;
-  m2::RectD m_rect;
+  if (rect.IsEmptyInterior())
+    return;
 
-  CountriesContainerT & m_countries;
+  m_cellWidth = rect.SizeX() / kSideCells;
+  m_cellHeight = rect.SizeY() / kSideCells;
+  m_cells.assign(kSideCells * kSideCells, CellType::Outside);
 
-public:
-  PolygonLoader(CountriesContainerT & countries)
-    : m_countries(countries) {}
+  for (Region const & region : regions)
+    FillInside(region);
 
-  void operator() (std::string const & name, std::vector<m2::RegionD> const & borders)
+  for (Region const & region : regions)
   {
-    if (m_polygons.m_name.empty())
-      m_polygons.m_name = name;
+    std::vector<m2::PointD> const & points = region.Data();
+    for (size_t i = 0; i < points.size(); ++i)
+      MarkBoundary(points[i], points[(i + 1) % points.size()]);
+  }
+}
 
-    for (m2::RegionD const & border : borders)
+BordersCoverage::CellType BordersCoverage::Get(m2::PointD const & pt) const
+{
+  if (m_cells.empty())
+    return CellType::Boundary;
+  if (!m_rect.IsPointInside(pt))
+    return CellType::Outside;
+  return m_cells[GetRow(pt.y) * kSideCells + GetColumn(pt.x)];
+}
+
+size_t BordersCoverage::GetColumn(double x) const
+{
+  double const column = floor((x - m_rect.minX()) / m_cellWidth);
+  return static_cast<size_t>(my::clamp(column, 0.0, static_cast<double>(kSideCells - 1)));
+}
+
+size_t BordersCoverage::GetRow(double y) const
+{
+  double const row = floor((y - m_rect.minY()) / m_cellHeight);
+  return static_cast<size_t>(my::clamp(row, 0.0, static_cast<double>(kSideCells - 1)));
+}
+
+void BordersCoverage::MarkBoundary(m2::PointD const & a, m2::PointD const & b)
+{
+  // Every point of the segment is closer than a half of a cell to one of the samples,
+  // so cells around the samples cover all cells which are touched by the segment.
+  double const step = std::min(m_cellWidth, m_cellHeight) / 2;
+  size_t const samples = static_cast<size_t>(ceil(a.Length(b) / step)) + 1;
+  for (size_t i = 0; i <= samples; ++i)
+  {
+    m2::PointD const p = a + (b - a) * (static_cast<double>(i) / samples);
+    size_t const row = GetRow(p.y);
+    size_t const column = GetColumn(p.x);
+    for (size_t r = (row == 0 ? 0 : row - 1); r <= std::min(row + 1, kSideCells - 1); ++r)
     {
-      m2::RectD const rect(border.GetRect());
-      m_rect.Add(rect);
-      m_polygons.m_regions.Add(border, rect);
+      for (size_t c = (column == 0 ? 0 : column - 1); c <= std::min(column + 1, kSideCells - 1); ++c)
+        m_cells[r * kSideCells + c] = CellType::Boundary;
     }
   }
+}
 
-  void Finish()
+void BordersCoverage::FillInside(Region const & region)
+{
+  // Crossings of borders with horizontal lines through centers of rows of cells.
+  std::vector<std::vector<double>> crossings(kSideCells);
+  std::vector<m2::PointD> const & points = region.Data();
+  for (size_t i = 0; i < points.size(); ++i)
   {
-    if (!m_polygons.IsEmpty())
+    m2::PointD const & a = points[i];
+    m2::PointD const & b = points[(i + 1) % points.size()];
+    if (a.y == b.y)
+      continue;
+
+    double const minY = std::min(a.y, b.y);
+    double const maxY = std::max(a.y, b.y);
+    // Rows whose centers are in [minY, maxY).
+    double const first = ceil((minY - m_rect.minY()) / m_cellHeight - 0.5);
+    double const last = ceil((maxY - m_rect.minY()) / m_cellHeight - 0.5) - 1;
+    for (double r = std::max(first, 0.0); r <= std::min(last, kSideCells - 1.0); ++r)
     {
-      ASSERT_NOT_EQUAL ( m_rect, m2::RectD::GetEmptyRect(), () );
-      m_countries.Add(m_polygons, m_rect);
+      double const y = m_rect.minY() + (r + 0.5) * m_cellHeight;
+      crossings[static_cast<size_t>(r)].push_back(a.x + (b.x - a.x) * (y - a.y) / (b.y - a.y));
     }
+  }
 
-    m_polygons.Clear();
-    m_rect.MakeEmpty();
+  for (size_t row = 0; row < kSideCells; ++row)
+  {
+    auto & xs = crossings[row];
+    std::sort(xs.begin(), xs.end());
+    for (size_t i = 0; i + 1 < xs.size(); i += 2)
+    {
+      // Cells whose centers are in [xs[i], xs[i + 1]).
+      double const first = ceil((xs[i] - m_rect.minX()) / m_cellWidth - 0.5);
+      double const last = ceil((xs[i + 1] - m_rect.minX()) / m_cellWidth - 0.5) - 1;
+      for (double c = std::max(first, 0.0); c <= std::min(last, kSideCells - 1.0); ++c)
+        m_cells[row * kSideCells + static_cast<size_t>(c)] = CellType::Inside;
+    }
   }
-};
+}
 
-template <class ToDo>
-void ForEachCountry(std::string const & baseDir, ToDo & toDo)
+namespace
+{
+std::string GetBordersPath(std::string const & baseDir, std::string const & name)
+{
+  return baseDir + BORDERS_DIR + name + BORDERS_EXTENSION;
+}
+
+/// Returns names of countries which have borders in |baseDir|, only countries from |names|
+/// if it's not empty.
+std::vector<std::string> GetCountryNames(std::string const & baseDir,
+                                         std::set<std::string> const & names)
 {
   std::string const bordersDir = baseDir + BORDERS_DIR;
   CHECK(Platform::IsFileExistsByFullPath(bordersDir), ("Cannot read borders directory", bordersDir));
 
   Platform::FilesList files;
   Platform::GetFilesByExt(bordersDir, BORDERS_EXTENSION, files);
+
+  std::vector<std::string> countries;
   for (std::string file : files)
   {
-    std::vector<m2::RegionD> borders;
-    if (osm::LoadBorders(bordersDir + file, borders))
+    my::GetNameWithoutExt(file);
+    if (names.empty() || names.count(file) != 0)
+      countries.push_back(file);
+  }
+  return countries;
+}
+
+/// Borders are loaded concurrently by batches of |threadsCount| countries and passed to |toDo|
+/// in the order of files.
+template <class ToDo>
+void ForEachCountry(std::string const & baseDir, size_t threadsCount, ToDo & toDo)
+{
+  std::vector<std::string> const countries = GetCountryNames(baseDir, std::set<std::string>());
+  size_t const batchSize = std::max(threadsCount, static_cast<size_t>(1));
+
+  std::vector<std::vector<m2::RegionD>> borders;
+  std::vector<char> loaded;
+  for (size_t begin = 0; begin < countries.size(); begin += batchSize)
+  {
+    size_t const end = std::min(countries.size(), begin + batchSize);
+    borders.assign(end - begin, std::vector<m2::RegionD>());
+    loaded.assign(end - begin, false);
+    generator::ForEachIndexInParallel(threadsCount, end - begin, [&](size_t i) {
+      loaded[i] = osm::LoadBorders(GetBordersPath(baseDir, countries[begin + i]), borders[i]);
+    });
+
+    for (size_t i = 0; i < borders.size(); ++i)
     {
-      my::GetNameWithoutExt(file);
-      toDo(file, borders);
-      toDo.Finish();
+      if (loaded[i])
+        toDo(countries[begin + i], borders[i]);
     }
   }
 }
+}  // namespace
 
-bool LoadCountriesList(std::string const & baseDir, CountriesContainerT & countries)
+bool LoadCountriesList(std::string const & baseDir, CountriesContainerT & countries,
+                       std::set<std::string> const & names, size_t threadsCount)
 {
   countries.Clear();
 
   LOG(LINFO, ("Loading countries."));
 
-  PolygonLoader loader(countries);
-  ForEachCountry(baseDir, loader);
+  std::vector<std::string> const countryNames = GetCountryNames(baseDir, names);
+  std::vector<CountryPolygons> polygons(countryNames.size());
+  std::vector<m2::RectD> rects(countryNames.size());
+  generator::ForEachIndexInParallel(threadsCount, countryNames.size(), [&](size_t i) {
+    std::vector<m2::RegionD> borders;
+    if (!osm::LoadBorders(GetBordersPath(baseDir, countryNames[i]), borders))
+      return;
+
+    CountryPolygons & country = polygons[i];
+    country.m_name = countryNames[i];
+    for (m2::RegionD const & border : borders)
+    {
+      m2::RectD const rect(border.GetRect());
+      rects[i].Add(rect);
+      country.m_regions.Add(border, rect);
+    }
+    country.m_regions.Build();
+
+    if (!country.IsEmpty())
+      country.m_coverage = BordersCoverage(borders, rects[i]);
+  });
+
+  for (size_t i = 0; i < polygons.size(); ++i)
+  {
+    if (!polygons[i].IsEmpty())
+    {
+      ASSERT_NOT_EQUAL(rects[i], m2::RectD::GetEmptyRect(), ());
+      countries.Add(std::move(polygons[i]), rects[i]);
+    }
+  }
+  countries.Build();
 
   LOG(LINFO, ("Countries loaded:", countries.GetSize()));
 
@@ -148,8 +282,6 @@ public:
     }
   }
 
-  void Finish() {}
-
   void WritePolygonsInfo()
   {
     FileWriter w = m_writer.GetWriter(PACKED_POLYGONS_INFO_TAG);
@@ -157,10 +289,10 @@ public:
   }
 };
 
-void GeneratePackedBorders(std::string const & baseDir)
+void GeneratePackedBorders(std::string const & baseDir, size_t threadsCount)
 {
   PackedBordersGenerator generator(baseDir);
-  ForEachCountry(baseDir, generator);
+  ForEachCountry(baseDir, threadsCount, generator);
   generator.WritePolygonsInfo();
 }
 
@@ -1,9 +1,14 @@
 #pragma once
 
+#include "geometry/packed_tree4d.hpp"
+#include "geometry/rect2d.hpp"
 #include "geometry/region2d.hpp"
-#include "geometry/tree4d.hpp"
 
+#include <cstddef>
+#include <cstdint>
+#include <set>
 #include <string>
+#include <vector>
 
 #define BORDERS_DIR "borders/"
 #define BORDERS_EXTENSION ".poly"
@@ -11,7 +16,40 @@
 namespace borders
 {
   typedef m2::RegionD Region;
-  typedef m4::Tree<Region> RegionsContainerT;
+  typedef m4::PackedTree<Region> RegionsContainerT;
+
+  /// Uniform grid over the rect of a country which classifies most points without polygon
+  /// tests. Only points in cells which are crossed by borders need polygon tests.
+  class BordersCoverage
+  {
+  public:
+    enum class CellType : uint8_t
+    {
+      Outside,
+      Inside,
+      Boundary
+    };
+
+    /// Number of cells along each side of the rect.
+    static size_t constexpr kSideCells = 256;
+
+    BordersCoverage() = default;
+    BordersCoverage(std::vector<Region> const & regions, m2::RectD const & rect);
+
+    /// Returns Boundary for all points when the coverage is empty.
+    CellType Get(m2::PointD const & pt) const;
+
+  private:
+    size_t GetColumn(double x) const;
+    size_t GetRow(double y) const;
+    void MarkBoundary(m2::PointD const & a, m2::PointD const & b);
+    void FillInside(Region const & region);
+
+    m2::RectD m_rect;
+    double m_cellWidth = 0.0;
+    double m_cellHeight = 0.0;
+    std::vector<CellType> m_cells;
+  };
 
   struct CountryPolygons
   {
@@ -21,19 +59,27 @@ namespace borders
     void Clear()
     {
       m_regions.Clear();
+      m_coverage = BordersCoverage();
       m_name.clear();
       m_index = -1;
     }
 
     RegionsContainerT m_regions;
+    BordersCoverage m_coverage;
     std::string m_name;
     mutable int m_index;
   };
 
-  typedef m4::Tree<CountryPolygons> CountriesContainerT;
+  /// Countries and regions are loaded once and are queried for every feature, so they are
+  /// kept in packed trees, which are built by LoadCountriesList().
+  typedef m4::PackedTree<CountryPolygons> CountriesContainerT;
 
-  bool LoadCountriesList(std::string const & baseDir, CountriesContainerT & countries);
+  /// Loads only countries from |names| if it's not empty. Files of borders are loaded and
+  /// coverages are built on |threadsCount| threads.
+  bool LoadCountriesList(std::string const & baseDir, CountriesContainerT & countries,
+                         std::set<std::string> const & names = std::set<std::string>(),
+                         size_t threadsCount = 1);
 
-  void GeneratePackedBorders(std::string const & baseDir);
+  void GeneratePackedBorders(std::string const & baseDir, size_t threadsCount = 1);
   void UnpackBorders(std::string const & baseDir, std::string const & targetDir);
 }
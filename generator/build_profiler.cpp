@@ -0,0 +1,180 @@
+#include "generator/build_profiler.hpp"
+
+#include "coding/file_writer.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include "std/target_os.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <sstream>
+
+#include "3party/jansson/myjansson.hpp"
+
+#ifndef OMIM_OS_WINDOWS
+#include <sys/resource.h>
+#include <time.h>
+#endif
+
+using namespace std;
+
+namespace generator
+{
+namespace
+{
+#ifndef OMIM_OS_WINDOWS
+double ToSeconds(timeval const & t) { return t.tv_sec + t.tv_usec / 1e6; }
+#endif
+
+void ReadThreadIo(BuildProfiler::Usage & usage)
+{
+#if defined(OMIM_OS_LINUX)
+  ifstream io("/proc/thread-self/io");
+  string key;
+  uint64_t value;
+  while (io >> key >> value)
+  {
+    if (key == "rchar:")
+      usage.m_readBytes = value;
+    else if (key == "wchar:")
+      usage.m_writtenBytes = value;
+  }
+#endif
+}
+
+my::JSONPtr ToJSON(BuildProfiler::Usage const & usage)
+{
+  auto node = my::NewJSONObject();
+  ToJSONObject(*node, "wall_seconds", usage.m_wallSeconds);
+  ToJSONObject(*node, "thread_cpu_seconds", usage.m_threadCpuSeconds);
+  ToJSONObject(*node, "process_cpu_seconds", usage.m_processCpuSeconds);
+  ToJSONObject(*node, "peak_rss_bytes", usage.m_peakRssBytes);
+  ToJSONObject(*node, "read_bytes", usage.m_readBytes);
+  ToJSONObject(*node, "written_bytes", usage.m_writtenBytes);
+  return node;
+}
+}  // namespace
+
+char const * const BuildProfiler::kGeneralReport = "generator";
+
+BuildProfiler::Stage::Stage(BuildProfiler & profiler, string const & report, string const & name)
+  : m_profiler(profiler), m_report(report), m_name(name), m_start(GetCurrentUsage())
+{
+}
+
+BuildProfiler::Stage::~Stage()
+{
+  Usage const end = GetCurrentUsage();
+
+  Usage usage;
+  usage.m_wallSeconds = m_timer.ElapsedSeconds();
+  usage.m_threadCpuSeconds = end.m_threadCpuSeconds - m_start.m_threadCpuSeconds;
+  usage.m_processCpuSeconds = end.m_processCpuSeconds - m_start.m_processCpuSeconds;
+  usage.m_peakRssBytes = end.m_peakRssBytes;
+  usage.m_readBytes = end.m_readBytes - m_start.m_readBytes;
+  usage.m_writtenBytes = end.m_writtenBytes - m_start.m_writtenBytes;
+
+  LOG(LINFO, ("Stage", m_name, "of", m_report, "is finished:", usage));
+  m_profiler.AddStage(m_report, m_name, usage);
+}
+
+// static
+BuildProfiler::Usage BuildProfiler::GetCurrentUsage()
+{
+  Usage usage;
+#ifndef OMIM_OS_WINDOWS
+  timespec t;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t) == 0)
+    usage.m_threadCpuSeconds = t.tv_sec + t.tv_nsec / 1e9;
+
+  struct rusage ru;
+  if (getrusage(RUSAGE_SELF, &ru) == 0)
+  {
+    usage.m_processCpuSeconds = ToSeconds(ru.ru_utime) + ToSeconds(ru.ru_stime);
+#if defined(OMIM_OS_MAC)
+    // ru_maxrss is in bytes on macOS.
+    usage.m_peakRssBytes = static_cast<uint64_t>(ru.ru_maxrss);
+#else
+    // ru_maxrss is in kilobytes on Linux.
+    usage.m_peakRssBytes = static_cast<uint64_t>(ru.ru_maxrss) * 1024;
+#endif
+  }
+#endif
+  ReadThreadIo(usage);
+  return usage;
+}
+
+void BuildProfiler::AddStage(string const & report, string const & name, Usage const & usage)
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_reports[report].emplace_back(name, usage);
+}
+
+vector<pair<string, BuildProfiler::Usage>> BuildProfiler::GetStages(string const & report) const
+{
+  lock_guard<mutex> lock(m_mutex);
+  auto const it = m_reports.find(report);
+  if (it == m_reports.end())
+    return {};
+  return it->second;
+}
+
+bool BuildProfiler::SaveReport(string const & report, string const & fileName) const
+{
+  auto const stages = GetStages(report);
+  if (stages.empty())
+    return false;
+
+  Usage total;
+  auto stagesNode = my::NewJSONArray();
+  for (auto const & stage : stages)
+  {
+    auto const & usage = stage.second;
+    total.m_wallSeconds += usage.m_wallSeconds;
+    total.m_threadCpuSeconds += usage.m_threadCpuSeconds;
+    total.m_processCpuSeconds += usage.m_processCpuSeconds;
+    total.m_peakRssBytes = max(total.m_peakRssBytes, usage.m_peakRssBytes);
+    total.m_readBytes += usage.m_readBytes;
+    total.m_writtenBytes += usage.m_writtenBytes;
+
+    auto stageNode = ToJSON(usage);
+    ToJSONObject(*stageNode, "name", stage.first);
+    json_array_append_new(stagesNode.get(), stageNode.release());
+  }
+
+  auto root = my::NewJSONObject();
+  ToJSONObject(*root, "name", report);
+  ToJSONObject(*root, "stages", *stagesNode.release());
+  ToJSONObject(*root, "total", *ToJSON(total).release());
+
+  unique_ptr<char, JSONFreeDeleter> buffer(
+      json_dumps(root.get(), JSON_INDENT(2) | JSON_PRESERVE_ORDER));
+  CHECK(buffer, ());
+
+  try
+  {
+    FileWriter writer(fileName);
+    string const content(buffer.get());
+    writer.Write(content.data(), content.size());
+  }
+  catch (Writer::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't write build profile", fileName, e.Msg()));
+    return false;
+  }
+  return true;
+}
+
+string DebugPrint(BuildProfiler::Usage const & usage)
+{
+  ostringstream out;
+  out << "Usage [ wall: " << usage.m_wallSeconds << " s, thread cpu: " << usage.m_threadCpuSeconds
+      << " s, process cpu: " << usage.m_processCpuSeconds
+      << " s, peak rss: " << usage.m_peakRssBytes / (1024 * 1024)
+      << " MiB, read: " << usage.m_readBytes << " B, written: " << usage.m_writtenBytes << " B ]";
+  return out.str();
+}
+}  // namespace generator
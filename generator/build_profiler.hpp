@@ -0,0 +1,70 @@
+#pragma once
+
+#include "base/timer.hpp"
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace generator
+{
+// Collects resources which are used by stages of the generation and saves them as json reports,
+// one report per mwm.
+class BuildProfiler
+{
+public:
+  // Name of the report for stages which don't belong to an mwm, e.g. preprocessing.
+  static char const * const kGeneralReport;
+
+  struct Usage
+  {
+    double m_wallSeconds = 0.0;
+    // CPU time of the thread which runs the stage.
+    double m_threadCpuSeconds = 0.0;
+    // CPU time of the process. It includes helper threads of the stage but also stages of
+    // other mwms which are run concurrently.
+    double m_processCpuSeconds = 0.0;
+    // Peak resident set size of the process at the end of the stage.
+    uint64_t m_peakRssBytes = 0;
+    // Bytes which are read and written by the thread which runs the stage, including cached
+    // reads. Access to memory mapped files isn't counted. Linux only.
+    uint64_t m_readBytes = 0;
+    uint64_t m_writtenBytes = 0;
+  };
+
+  // Measures a stage from construction to destruction.
+  class Stage
+  {
+  public:
+    Stage(BuildProfiler & profiler, std::string const & report, std::string const & name);
+    ~Stage();
+
+  private:
+    BuildProfiler & m_profiler;
+    std::string const m_report;
+    std::string const m_name;
+    my::Timer m_timer;
+    Usage m_start;
+  };
+
+  // Returns cumulative usage of the calling thread and the process, wall time is zero.
+  static Usage GetCurrentUsage();
+
+  void AddStage(std::string const & report, std::string const & name, Usage const & usage);
+
+  std::vector<std::pair<std::string, Usage>> GetStages(std::string const & report) const;
+
+  // Saves stages of |report| to |fileName| in json. Returns false if |report| has no stages or
+  // the file can't be written.
+  bool SaveReport(std::string const & report, std::string const & fileName) const;
+
+private:
+  mutable std::mutex m_mutex;
+  std::map<std::string, std::vector<std::pair<std::string, Usage>>> m_reports;
+};
+
+std::string DebugPrint(BuildProfiler::Usage const & usage);
+}  // namespace generator
@@ -1,5 +1,7 @@
 #include "generator/centers_table_builder.hpp"
 
+#include "generator/parallel_utils.hpp"
+
 #include "search/search_trie.hpp"
 
 #include "indexer/centers_table.hpp"
@@ -15,9 +17,21 @@
 
 #include "defines.hpp"
 
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <vector>
+
 namespace indexer
 {
-bool BuildCentersTableFromDataFile(std::string const & filename, bool forceRebuild)
+namespace
+{
+// Number of consecutive features which are decoded by a thread at once.
+uint32_t constexpr kFeaturesRangeSize = 4096;
+}  // namespace
+
+bool BuildCentersTableFromDataFile(std::string const & filename, bool forceRebuild,
+                                   size_t threadsCount)
 {
   try
   {
@@ -50,12 +64,31 @@ bool BuildCentersTableFromDataFile(std::string const & filename, bool forceRebui
       }
 
       feature::DataHeader const header(rcont);
-      FeaturesVector const features(rcont, header, table.get());
-
       builder.SetCodingParams(header.GetDefCodingParams());
-      features.ForEach([&](FeatureType & ft, uint32_t featureId) {
-        builder.Put(featureId, feature::GetCenter(ft));
+
+      // Centers of ranges of consecutive features are computed in parallel. Readers of a
+      // container aren't thread-safe, so every thread decodes features by its own
+      // FeaturesVectorTest.
+      size_t const numFeatures = table->size();
+      std::vector<m2::PointD> centers(numFeatures);
+      size_t const numRanges = (numFeatures + kFeaturesRangeSize - 1) / kFeaturesRangeSize;
+      generator::ForEachIndexWithWorkers(threadsCount, numRanges, [&]() {
+        auto features = std::make_shared<FeaturesVectorTest>(filename);
+        return [&, features](size_t i) {
+          auto const begin = static_cast<uint32_t>(i * kFeaturesRangeSize);
+          auto const end = static_cast<uint32_t>(
+              std::min(numFeatures, static_cast<size_t>(begin) + kFeaturesRangeSize));
+          std::vector<uint32_t> indices(end - begin);
+          std::iota(indices.begin(), indices.end(), begin);
+          features->GetVector().ForEachByIndices(
+              indices, [&centers](FeatureType & ft, uint32_t featureId) {
+                centers[featureId] = feature::GetCenter(ft);
+              });
+        };
       });
+
+      for (size_t i = 0; i < centers.size(); ++i)
+        builder.Put(static_cast<uint32_t>(i), centers[i]);
     }
 
     {
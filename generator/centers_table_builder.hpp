@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 
 class FilesContainerR;
@@ -8,6 +9,7 @@ class Writer;
 namespace indexer
 {
 // Builds the latest version of the centers table section and writes
-// it to the mwm file.
-bool BuildCentersTableFromDataFile(std::string const & filename, bool forceRebuild = false);
+// it to the mwm file. Centers of features are computed on |threadsCount| threads.
+bool BuildCentersTableFromDataFile(std::string const & filename, bool forceRebuild = false,
+                                   size_t threadsCount = 1);
 }  // namespace indexer
@@ -1,5 +1,7 @@
 #include "generator/check_model.hpp"
 
+#include "generator/parallel_utils.hpp"
+
 #include "defines.hpp"
 
 #include "indexer/features_vector.hpp"
@@ -13,7 +15,9 @@ using namespace feature;
 
 namespace check_model
 {
-  void ReadFeatures(std::string const & fName)
+  namespace
+  {
+  void CheckFeatures(std::string const & fName)
   {
     Classificator const & c = classif();
 
@@ -40,7 +44,21 @@ namespace check_model
 
       IsDrawableLike(vTypes, ft.GetFeatureType());
     });
+  }
+  }  // namespace
 
+  void ReadFeatures(std::string const & fName)
+  {
+    CheckFeatures(fName);
     LOG(LINFO, ("OK"));
   }
+
+  void ReadFeatures(std::vector<std::string> const & fNames, size_t threadsCount)
+  {
+    generator::ForEachIndexInParallel(threadsCount, fNames.size(), [&fNames](size_t i)
+    {
+      CheckFeatures(fNames[i]);
+      LOG(LINFO, (fNames[i], "OK"));
+    });
+  }
 }
@@ -1,7 +1,11 @@
 #pragma once
+#include <cstddef>
 #include <string>
+#include <vector>
 
 namespace check_model
 {
   void ReadFeatures(std::string const & fName);
+  // Checks mwms |fNames| on |threadsCount| threads.
+  void ReadFeatures(std::vector<std::string> const & fNames, size_t threadsCount);
 }
@@ -209,7 +209,7 @@ class RegionInCellSplitter final
 {
 public:
   using TCell = RectId;
-  using TIndex = m4::Tree<m2::RegionI>;
+  using TIndex = m4::PackedTree<m2::RegionI>;
   using TProcessResultFunc = function<void(TCell const &, DoDifference &)>;
 
   static int constexpr kStartLevel = 4;
@@ -313,15 +313,18 @@ public:
   }
 };
 
-void CoastlineFeaturesGenerator::GetFeatures(vector<FeatureBuilder1> & features)
+void CoastlineFeaturesGenerator::ForEachFeature(function<void(FeatureBuilder1 const &)> const & fn)
 {
   size_t const maxThreads = thread::hardware_concurrency();
   CHECK_GREATER(maxThreads, 0, ("Not supported platform"));
 
-  mutex featuresMutex;
+  // All regions are added by now, and the tree is queried for every cell.
+  m_tree.Build();
+
+  mutex fnMutex;
   RegionInCellSplitter::Process(
       maxThreads, RegionInCellSplitter::kStartLevel, m_tree,
-      [&features, &featuresMutex, this](RegionInCellSplitter::TCell const & cell, DoDifference & cellData)
+      [&fn, &fnMutex, this](RegionInCellSplitter::TCell const & cell, DoDifference & cellData)
       {
         FeatureBuilder1 fb;
         fb.SetCoastCell(cell.ToInt64(RegionInCellSplitter::kHighLevel + 1));
@@ -334,8 +337,8 @@ void CoastlineFeaturesGenerator::GetFeatures(vector<FeatureBuilder1> & features)
         CHECK_GREATER(fb.GetPolygonsCount(), 0, ());
         CHECK_GREATER_OR_EQUAL(fb.GetPointsCount(), 3, ());
 
-        // save result
-        lock_guard<mutex> lock(featuresMutex);
-        features.emplace_back(move(fb));
+        // pass result
+        lock_guard<mutex> lock(fnMutex);
+        fn(fb);
       });
 }
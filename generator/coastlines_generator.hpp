@@ -4,9 +4,10 @@
 
 #include "indexer/cell_id.hpp"
 
-#include "geometry/tree4d.hpp"
+#include "geometry/packed_tree4d.hpp"
 #include "geometry/region2d.hpp"
 
+#include <functional>
 
 class FeatureBuilder1;
 
@@ -14,7 +15,7 @@ class CoastlineFeaturesGenerator
 {
   FeatureMergeProcessor m_merger;
 
-  using TTree = m4::Tree<m2::RegionI>;
+  using TTree = m4::PackedTree<m2::RegionI>;
   TTree m_tree;
 
   uint32_t m_coastType;
@@ -28,5 +29,8 @@ public:
   /// @return false if coasts are not merged and FLAG_fail_on_coasts is set
   bool Finish();
 
-  void GetFeatures(vector<FeatureBuilder1> & vecFb);
+  /// Builds coast polygons cell by cell on several threads and passes them to |fn| as soon as
+  /// a cell is ready, so only features of cells in processing are kept in memory.
+  /// Calls of |fn| are serialized.
+  void ForEachFeature(std::function<void(FeatureBuilder1 const &)> const & fn);
 };
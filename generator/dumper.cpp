@@ -1,5 +1,7 @@
 #include "generator/dumper.hpp"
 
+#include "generator/parallel_utils.hpp"
+
 #include "search/search_index_values.hpp"
 #include "search/search_trie.hpp"
 
@@ -17,6 +19,8 @@
 #include <functional>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 using namespace std;
@@ -44,13 +48,34 @@ struct SearchTokensCollector
   {
     if (m_currentCount > 0)
       m_tokens.emplace_back(m_currentCount, m_currentS);
-    sort(m_tokens.begin(), m_tokens.end(), greater<pair<uint32_t, strings::UniString>>());
   }
 
   vector<pair<uint32_t, strings::UniString>> m_tokens;
   strings::UniString m_currentS;
   uint32_t m_currentCount;
 };
+
+// Calls |collect| for every mwm of |fPaths| on |threadsCount| threads. Every thread has its
+// own Collector, collectors are merged into |result| at the end.
+template <typename Collector, typename Collect>
+void CollectInParallel(vector<string> const & fPaths, size_t threadsCount, Collect && collect,
+                       Collector & result)
+{
+  vector<unique_ptr<Collector>> collectors;
+  mutex collectorsMutex;
+  generator::ForEachIndexWithWorkers(threadsCount, fPaths.size(), [&]() {
+    Collector * collector = nullptr;
+    {
+      lock_guard<mutex> lock(collectorsMutex);
+      collectors.push_back(make_unique<Collector>());
+      collector = collectors.back().get();
+    }
+    return [&, collector](size_t i) { collect(fPaths[i], *collector); };
+  });
+
+  for (auto const & collector : collectors)
+    result.Merge(*collector);
+}
 }  // namespace
 
 namespace feature
@@ -86,6 +111,14 @@ namespace feature
       if (!found.second)
         found.first->second++;
     }
+
+    void Merge(TypesCollector const & other)
+    {
+      for (auto const & stat : other.m_stats)
+        m_stats[stat.first] += stat.second;
+      m_namesCount += other.m_namesCount;
+      m_totalCount += other.m_totalCount;
+    }
   };
 
   template <class T>
@@ -94,10 +127,15 @@ namespace feature
     return first.second > second.second;
   }
 
-  void DumpTypes(string const & fPath)
+  void DumpTypes(string const & fPath) { DumpTypes(vector<string>{fPath}, 1 /* threadsCount */); }
+
+  void DumpTypes(vector<string> const & fPaths, size_t threadsCount)
   {
     TypesCollector doClass;
-    feature::ForEachFromDat(fPath, doClass);
+    CollectInParallel(fPaths, threadsCount, [](string const & fPath, TypesCollector & collector)
+    {
+      feature::ForEachFromDat(fPath, collector);
+    }, doClass);
 
     typedef pair<vector<uint32_t>, size_t> stats_elem_type;
     typedef vector<stats_elem_type> vec_to_sort;
@@ -154,6 +192,21 @@ namespace feature
     {
       f.ForEachName(*this);
     }
+
+    // An example name of a merged prefix is the one of this collector if it has the prefix.
+    void Merge(PrefixesCollector const & other)
+    {
+      for (auto const & langStats : other.m_stats)
+      {
+        auto & stats = m_stats[langStats.first];
+        for (auto const & stat : langStats.second)
+        {
+          auto found = stats.insert(stat);
+          if (!found.second)
+            found.first->second.first += stat.second.first;
+        }
+      }
+    }
   };
 
   static size_t const MIN_OCCURRENCE = 3;
@@ -182,9 +235,17 @@ namespace feature
   }
 
   void DumpPrefixes(string const & fPath)
+  {
+    DumpPrefixes(vector<string>{fPath}, 1 /* threadsCount */);
+  }
+
+  void DumpPrefixes(vector<string> const & fPaths, size_t threadsCount)
   {
     PrefixesCollector doClass;
-    feature::ForEachFromDat(fPath, doClass);
+    CollectInParallel(fPaths, threadsCount, [](string const & fPath, PrefixesCollector & collector)
+    {
+      feature::ForEachFromDat(fPath, collector);
+    }, doClass);
     for (TokensContainerT::iterator it = doClass.m_stats.begin();
          it != doClass.m_stats.end(); ++it)
     {
@@ -192,7 +253,19 @@ namespace feature
     }
   }
 
-  void DumpSearchTokens(string const & fPath, size_t maxTokensToShow)
+  // Numbers of features per search token.
+  struct SearchTokensCounter
+  {
+    void Merge(SearchTokensCounter const & other)
+    {
+      for (auto const & count : other.m_counts)
+        m_counts[count.first] += count.second;
+    }
+
+    map<strings::UniString, uint32_t> m_counts;
+  };
+
+  void CountSearchTokens(string const & fPath, SearchTokensCounter & counter)
   {
     using TValue = FeatureIndexValue;
 
@@ -207,10 +280,31 @@ namespace feature
     trie::ForEachRef(*trieRoot, f, strings::UniString());
     f.Finish();
 
-    for (size_t i = 0; i < min(maxTokensToShow, f.m_tokens.size()); ++i)
+    for (auto const & token : f.m_tokens)
+      counter.m_counts[token.second] += token.first;
+  }
+
+  void DumpSearchTokens(string const & fPath, size_t maxTokensToShow)
+  {
+    DumpSearchTokens(vector<string>{fPath}, maxTokensToShow, 1 /* threadsCount */);
+  }
+
+  void DumpSearchTokens(vector<string> const & fPaths, size_t maxTokensToShow,
+                        size_t threadsCount)
+  {
+    SearchTokensCounter counter;
+    CollectInParallel(fPaths, threadsCount, &CountSearchTokens, counter);
+
+    vector<pair<uint32_t, strings::UniString>> tokens;
+    tokens.reserve(counter.m_counts.size());
+    for (auto const & count : counter.m_counts)
+      tokens.emplace_back(count.second, count.first);
+    sort(tokens.begin(), tokens.end(), greater<pair<uint32_t, strings::UniString>>());
+
+    for (size_t i = 0; i < min(maxTokensToShow, tokens.size()); ++i)
     {
-      auto const & s = f.m_tokens[i].second;
-      cout << f.m_tokens[i].first << " " << strings::ToUtf8(s) << endl;
+      auto const & s = tokens[i].second;
+      cout << tokens[i].first << " " << strings::ToUtf8(s) << endl;
     }
   }
 
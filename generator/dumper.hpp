@@ -1,16 +1,25 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
+#include <vector>
 
 namespace feature
 {
+  // The functions below which take several mwms scan them on threadsCount threads.
+  // Every thread aggregates statistics of its mwms and the results are merged at the end.
+
   void DumpTypes(std::string const & fPath);
+  void DumpTypes(std::vector<std::string> const & fPaths, size_t threadsCount);
   void DumpPrefixes(std::string const & fPath);
+  void DumpPrefixes(std::vector<std::string> const & fPaths, size_t threadsCount);
 
   // Writes top maxTokensToShow tokens sorted by their
   // frequency, i.e. by the number of features in
   // an mwm that contain the token in their name.
   void DumpSearchTokens(std::string const & fPath, size_t maxTokensToShow);
+  void DumpSearchTokens(std::vector<std::string> const & fPaths, size_t maxTokensToShow,
+                        size_t threadsCount);
 
   // Writes the names of all features in the locale provided by lang
   // (e.g. "en", "ru", "sv"). If the locale is not recognized, writes all names
@@ -6,6 +6,9 @@
 
 #include "coding/point_to_integer.hpp"
 
+#include <algorithm>
+#include <utility>
+
 MergedFeatureBuilder1::MergedFeatureBuilder1(FeatureBuilder1 const & fb)
   : FeatureBuilder1(fb), m_isRound(false)
 {
@@ -21,6 +24,8 @@ void MergedFeatureBuilder1::SetRound()
 
 void MergedFeatureBuilder1::AppendFeature(MergedFeatureBuilder1 const & fb, bool fromBegin, bool toBack)
 {
+  m_priority = -1.0;
+
   // Also merge Osm IDs for debugging
   m_osmIds.insert(m_osmIds.end(), fb.m_osmIds.begin(), fb.m_osmIds.end());
 
@@ -54,7 +59,7 @@ void MergedFeatureBuilder1::AppendFeature(MergedFeatureBuilder1 const & fb, bool
     }
     else
     {
-      thisG.insert(thisG.begin(), fbG.begin(), fbG.end() - 1);
+      m_frontPoints.insert(m_frontPoints.end(), fbG.rbegin() + 1, fbG.rend());
       CalcRect(fbG.begin(), fbG.end() - 1, m_limitRect);
     }
   }
@@ -67,12 +72,22 @@ void MergedFeatureBuilder1::AppendFeature(MergedFeatureBuilder1 const & fb, bool
     }
     else
     {
-      thisG.insert(thisG.begin(), fbG.rbegin(), fbG.rend() - 1);
+      m_frontPoints.insert(m_frontPoints.end(), fbG.begin() + 1, fbG.end());
       CalcRect(fbG.rbegin(), fbG.rend() - 1, m_limitRect);
     }
   }
 }
 
+void MergedFeatureBuilder1::FlushFrontPoints()
+{
+  if (m_frontPoints.empty())
+    return;
+
+  TPointSeq & thisG = m_polygons.front();
+  thisG.insert(thisG.begin(), m_frontPoints.rbegin(), m_frontPoints.rend());
+  m_frontPoints.clear();
+}
+
 bool MergedFeatureBuilder1::EqualGeometry(MergedFeatureBuilder1 const & fb) const
 {
   return (GetOuterGeometry() == fb.GetOuterGeometry());
@@ -106,11 +121,15 @@ size_t MergedFeatureBuilder1::GetKeyPointsCount() const
 
 double MergedFeatureBuilder1::GetPriority() const
 {
+  if (m_priority >= 0.0)
+    return m_priority;
+
   TPointSeq const & poly = GetOuterGeometry();
 
   double pr = 0.0;
   for (size_t i = 1; i < poly.size(); ++i)
     pr += poly[i-1].SquareLength(poly[i]);
+  m_priority = pr;
   return pr;
 }
 
@@ -181,10 +200,28 @@ void FeatureMergeProcessor::Remove(MergedFeatureBuilder1 const * p)
 
 void FeatureMergeProcessor::DoMerge(FeatureEmitterIFace & emitter)
 {
+  // Features are started from the least keys, as equal features must go one after another to
+  // be united. Keys are never added while merging, so it's enough to sort them once.
+  std::vector<key_t> keys;
+  keys.reserve(m_map.size());
+  for (auto const & kv : m_map)
+    keys.push_back(kv.first);
+  std::sort(keys.begin(), keys.end());
+
+  size_t nextKey = 0;
   while (!m_map.empty())
   {
     // Get any starting feature.
-    vector_t & vS = m_map.begin()->second;
+    map_t::iterator start = m_map.end();
+    while (start == m_map.end())
+    {
+      CHECK_LESS(nextKey, keys.size(), ());
+      start = m_map.find(keys[nextKey]);
+      if (start == m_map.end())
+        ++nextKey;
+    }
+
+    vector_t & vS = start->second;
     CHECK(!vS.empty(), ());
     MergedFeatureBuilder1 * p = vS.front();  // may be 'back' is better
 
@@ -197,8 +234,8 @@ void FeatureMergeProcessor::DoMerge(FeatureEmitterIFace & emitter)
       Remove(p);
     }
 
-    // We will merge to the copy of p.
-    MergedFeatureBuilder1 curr(*p);
+    // We will merge to the copy of p, the removed feature is not needed anymore.
+    MergedFeatureBuilder1 curr = isRemoved ? std::move(*p) : *p;
     curr.SetType(type);
 
     // Iterate through key points while merging.
@@ -251,6 +288,8 @@ void FeatureMergeProcessor::DoMerge(FeatureEmitterIFace & emitter)
       }
     }
 
+    curr.FlushFrontPoints();
+
     if (m_last.NotEmpty() && m_last.EqualGeometry(curr))
     {
       // curr is equal with m_last by geometry - just add new type to m_last
@@ -262,7 +301,7 @@ void FeatureMergeProcessor::DoMerge(FeatureEmitterIFace & emitter)
       // emit m_last and set curr as last processed feature (m_last)
       if (m_last.NotEmpty())
         emitter(m_last);
-      m_last = curr;
+      m_last = std::move(curr);
     }
 
     // Delete if the feature was removed from map.
@@ -4,6 +4,7 @@
 
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 /// Feature builder class that used while feature type processing and merging.
@@ -13,6 +14,13 @@ class MergedFeatureBuilder1 : public FeatureBuilder1
 
   TPointSeq m_roundBounds[2];
 
+  // Points which are prepended to the geometry while merging, in the reverse order, so
+  // prepending doesn't move the whole geometry every time. See FlushFrontPoints().
+  TPointSeq m_frontPoints;
+
+  // Cached priority, negative when it's not calculated yet.
+  mutable double m_priority = -1.0;
+
 public:
   MergedFeatureBuilder1() : m_isRound(false) {}
   MergedFeatureBuilder1(FeatureBuilder1 const & fb);
@@ -23,12 +31,18 @@ public:
   void ZeroParams() { m_params.MakeZero(); }
 
   void AppendFeature(MergedFeatureBuilder1 const & fb, bool fromBegin, bool toBack);
+  /// Moves prepended points to the geometry, must be called after merging before the geometry
+  /// is used.
+  void FlushFrontPoints();
 
   bool EqualGeometry(MergedFeatureBuilder1 const & fb) const;
 
   inline bool NotEmpty() const { return !GetOuterGeometry().empty(); }
 
-  inline m2::PointD FirstPoint() const { return GetOuterGeometry().front(); }
+  inline m2::PointD FirstPoint() const
+  {
+    return m_frontPoints.empty() ? GetOuterGeometry().front() : m_frontPoints.back();
+  }
   inline m2::PointD LastPoint() const { return GetOuterGeometry().back(); }
 
   inline bool PopAnyType(uint32_t & type) { return m_params.PopAnyType(type); }
@@ -61,7 +75,7 @@ class FeatureMergeProcessor
   MergedFeatureBuilder1 m_last;
 
   typedef std::vector<MergedFeatureBuilder1 *> vector_t;
-  typedef std::map<key_t, vector_t> map_t;
+  typedef std::unordered_map<key_t, vector_t> map_t;
   map_t m_map;
 
   void Insert(m2::PointD const & pt, MergedFeatureBuilder1 * p);
@@ -2,6 +2,7 @@
 #include "generator/feature_builder.hpp"
 #include "generator/feature_generator.hpp"
 #include "generator/gen_mwm_info.hpp"
+#include "generator/parallel_utils.hpp"
 #include "generator/region_meta.hpp"
 #include "generator/tesselator.hpp"
 
@@ -28,23 +29,53 @@
 #include "base/scope_guard.hpp"
 #include "base/string_utils.hpp"
 
+#include <algorithm>
+#include <vector>
+
+#include "boost/crc.hpp"
+
 namespace
 {
-  typedef pair<uint64_t, uint64_t> CellAndOffsetT;
+  struct FeatureKey
+  {
+    bool operator<(FeatureKey const & rhs) const
+    {
+      if (m_order != rhs.m_order)
+        return m_order < rhs.m_order;
+      return m_contentHash < rhs.m_contentHash;
+    }
+
+    uint64_t m_order = 0;
+    // Hash of the feature which orders features with equal |m_order| in reproducible builds.
+    uint64_t m_contentHash = 0;
+    // Offset of the feature in the raw features file.
+    uint64_t m_offset = 0;
+  };
+
+  // CRC-64/ECMA-182, it's the same on all platforms in contrast to std::hash.
+  using ContentCrc = boost::crc_optimal<64, 0x42F0E1EBA9EA3693ULL, 0, 0, false, false>;
+
+  // Depth of cells which group features when they are sorted by tiles. Tiles of this scale
+  // are the most common ones among the tiles of detailed scales which are read at once.
+  uint32_t constexpr kTileCellDepth = 10;
+  uint32_t constexpr kMinScaleBits = 5;
 
   class CalculateMidPoints
   {
     m2::PointD m_midLoc, m_midAll;
     size_t m_locCount, m_allCount;
     uint32_t m_coordBits;
+    bool m_sortByTiles;
+    bool m_reproducible;
 
   public:
-    CalculateMidPoints() :
-      m_midAll(0, 0), m_allCount(0), m_coordBits(serial::CodingParams().GetCoordBits())
+    CalculateMidPoints(bool sortByTiles, bool reproducible) :
+      m_midAll(0, 0), m_allCount(0), m_coordBits(serial::CodingParams().GetCoordBits()),
+      m_sortByTiles(sortByTiles), m_reproducible(reproducible)
     {
     }
 
-    vector<CellAndOffsetT> m_vec;
+    vector<FeatureKey> m_vec;
 
     void operator() (FeatureBuilder1 const & ft, uint64_t pos)
     {
@@ -62,8 +93,20 @@ namespace
       /// @todo Probably, we need to keep that objects if 9 scale (as we do in 17 scale).
       if (minScale != -1 || feature::RequireGeometryInIndex(ft.GetFeatureBase()))
       {
-        uint64_t const order = (static_cast<uint64_t>(minScale) << 59) | (pointAsInt64 >> 5);
-        m_vec.push_back(make_pair(order, pos));
+        FeatureKey key;
+        key.m_order = GetOrder(minScale, pointAsInt64);
+        key.m_offset = pos;
+        if (m_reproducible)
+        {
+          // Order of features with equal keys after std::sort differs between implementations
+          // of the standard library, so such features are ordered by their contents.
+          FeatureBuilder1::TBuffer buffer;
+          ft.Serialize(buffer);
+          ContentCrc crc;
+          crc.process_bytes(buffer.data(), buffer.size());
+          key.m_contentHash = crc.checksum();
+        }
+        m_vec.push_back(key);
       }
     }
 
@@ -77,12 +120,33 @@ namespace
     }
 
     m2::PointD GetCenter() const { return m_midAll / m_allCount; }
+
+  private:
+    // By default features are sorted by their min drawable scale and then by the Z-order of
+    // their middle points. When features are sorted by tiles, the cell of kTileCellDepth goes
+    // first, so all features of a tile are stored together whatever their scales are, and
+    // a tile of detailed scales is read by a few sequential reads.
+    uint64_t GetOrder(int minScale, uint64_t pointAsInt64) const
+    {
+      uint64_t const scale = static_cast<uint64_t>(minScale) & ((1 << kMinScaleBits) - 1);
+      if (!m_sortByTiles)
+        return (scale << (64 - kMinScaleBits)) | (pointAsInt64 >> kMinScaleBits);
+
+      uint32_t const pointBits = 2 * m_coordBits;
+      uint32_t const cellBits = 2 * kTileCellDepth;
+      ASSERT_LESS(cellBits, pointBits, ());
+      uint64_t const cell = pointAsInt64 >> (pointBits - cellBits);
+      uint64_t const inCell = pointAsInt64 & ((static_cast<uint64_t>(1) << (pointBits - cellBits)) - 1);
+
+      uint32_t const inCellBits = 64 - cellBits - kMinScaleBits;
+      uint64_t const order = (cell << (64 - cellBits)) | (scale << inCellBits);
+      if (pointBits - cellBits <= inCellBits)
+        return order | (inCell << (inCellBits - (pointBits - cellBits)));
+      return order | (inCell >> (pointBits - cellBits - inCellBits));
+    }
   };
 
-  bool SortMidPointsFunc(CellAndOffsetT const & c1, CellAndOffsetT const & c2)
-  {
-    return c1.first < c2.first;
-  }
+  size_t constexpr kFeaturesBatchSize = 1024;
 }
 
 namespace feature
@@ -199,6 +263,18 @@ namespace feature
       }
     }
 
+    /// Serialized geometry of a feature which doesn't depend on other features.
+    struct Geometry
+    {
+      using TBuffer = vector<uint8_t>;
+
+      FeatureBuilder2::SupportingData m_buffer;
+      /// Outer points and triangles with their scale indices in the order of
+      /// m_buffer.m_ptsOffset and m_buffer.m_trgOffset, the offsets are set on writing.
+      vector<pair<int, TBuffer>> m_outerPts;
+      vector<pair<int, TBuffer>> m_outerTrg;
+    };
+
   private:
     typedef vector<m2::PointD> points_t;
     typedef list<points_t> polygons_t;
@@ -206,10 +282,10 @@ namespace feature
     class GeometryHolder
     {
     public:
-      FeatureBuilder2::SupportingData m_buffer;
+      FeatureBuilder2::SupportingData & m_buffer;
 
     private:
-      FeaturesCollector2 & m_rMain;
+      Geometry & m_geometry;
       FeatureBuilder2 & m_rFB;
 
       points_t m_current;
@@ -229,8 +305,10 @@ namespace feature
         points_t toSave(points.begin() + 1, points.end());
 
         m_buffer.m_ptsMask |= (1 << i);
-        m_buffer.m_ptsOffset.push_back(m_rMain.GetFileSize(*m_rMain.m_geoFile[i]));
-        serial::SaveOuterPath(toSave, cp, *m_rMain.m_geoFile[i]);
+        m_buffer.m_ptsOffset.push_back(0);
+        m_geometry.m_outerPts.emplace_back(i, Geometry::TBuffer());
+        MemWriter<Geometry::TBuffer> sink(m_geometry.m_outerPts.back().second);
+        serial::SaveOuterPath(toSave, cp, sink);
       }
 
       void WriteOuterTriangles(polygons_t const & polys, int i)
@@ -264,8 +342,10 @@ namespace feature
 
         // saving to file
         m_buffer.m_trgMask |= (1 << i);
-        m_buffer.m_trgOffset.push_back(m_rMain.GetFileSize(*m_rMain.m_trgFile[i]));
-        saver.Save(*m_rMain.m_trgFile[i]);
+        m_buffer.m_trgOffset.push_back(0);
+        m_geometry.m_outerTrg.emplace_back(i, Geometry::TBuffer());
+        MemWriter<Geometry::TBuffer> sink(m_geometry.m_outerTrg.back().second);
+        saver.Save(sink);
       }
 
       void FillInnerPointsMask(points_t const & points, uint32_t scaleIndex)
@@ -314,10 +394,8 @@ namespace feature
       };
 
     public:
-      GeometryHolder(FeaturesCollector2 & rMain,
-                     FeatureBuilder2 & fb,
-                     DataHeader const & header)
-        : m_rMain(rMain), m_rFB(fb), m_header(header),
+      GeometryHolder(Geometry & geometry, FeatureBuilder2 & fb, DataHeader const & header)
+        : m_buffer(geometry.m_buffer), m_geometry(geometry), m_rFB(fb), m_header(header),
           m_ptsInner(true), m_trgInner(true)
       {
       }
@@ -405,8 +483,8 @@ namespace feature
       }
     };
 
-    void SimplifyPoints(points_t const & in, points_t & out, int level,
-                        bool isCoast, m2::RectD const & rect)
+    static void SimplifyPoints(points_t const & in, points_t & out, int level,
+                               bool isCoast, m2::RectD const & rect)
     {
       if (isCoast)
       {
@@ -446,10 +524,35 @@ namespace feature
 
     bool IsCountry() const { return m_header.GetType() == feature::DataHeader::country; }
 
+    /// Appends outer geometry to the tmp files and sets its offsets.
+    void WriteOuterGeometry(Geometry & geometry)
+    {
+      auto & buffer = geometry.m_buffer;
+      ASSERT_EQUAL(buffer.m_ptsOffset.size(), geometry.m_outerPts.size(), ());
+      for (size_t i = 0; i < geometry.m_outerPts.size(); ++i)
+      {
+        auto const & pts = geometry.m_outerPts[i];
+        TmpFile & file = *m_geoFile[pts.first];
+        buffer.m_ptsOffset[i] = GetFileSize(file);
+        file.Write(pts.second.data(), pts.second.size());
+      }
+
+      ASSERT_EQUAL(buffer.m_trgOffset.size(), geometry.m_outerTrg.size(), ());
+      for (size_t i = 0; i < geometry.m_outerTrg.size(); ++i)
+      {
+        auto const & trg = geometry.m_outerTrg[i];
+        TmpFile & file = *m_trgFile[trg.first];
+        buffer.m_trgOffset[i] = GetFileSize(file);
+        file.Write(trg.second.data(), trg.second.size());
+      }
+    }
+
   public:
-    uint32_t operator()(FeatureBuilder2 & fb)
+    /// Simplifies and tesselates geometry of |fb| for all scales. Doesn't change the collector,
+    /// so it can be called for different features concurrently.
+    void MakeGeometry(FeatureBuilder2 & fb, Geometry & geometry) const
     {
-      GeometryHolder holder(*this, fb, m_header);
+      GeometryHolder holder(geometry, fb, m_header);
 
       bool const isLine = fb.IsLine();
       bool const isArea = fb.IsArea();
@@ -520,13 +623,20 @@ namespace feature
           }
         }
       }
+    }
+
+    /// Writes |fb| with |geometry| made by MakeGeometry. Features are written in the order of calls.
+    uint32_t Write(FeatureBuilder2 & fb, Geometry & geometry)
+    {
+      WriteOuterGeometry(geometry);
 
+      auto & buffer = geometry.m_buffer;
       uint32_t featureId = kInvalidFeatureId;
-      if (fb.PreSerialize(holder.m_buffer))
+      if (fb.PreSerialize(buffer))
       {
-        fb.Serialize(holder.m_buffer, m_header.GetDefCodingParams());
+        fb.Serialize(buffer, m_header.GetDefCodingParams());
 
-        featureId = WriteFeatureBase(holder.m_buffer.m_buffer, fb);
+        featureId = WriteFeatureBase(buffer.m_buffer, fb);
 
         fb.GetAddressData().Serialize(*(m_helperFile[SEARCH_TOKENS]));
 
@@ -563,11 +673,11 @@ namespace feature
     std::string const datFilePath = info.GetTargetFileName(name);
 
     // stores cellIds for middle points
-    CalculateMidPoints midPoints;
+    CalculateMidPoints midPoints(info.m_sortFeaturesByTiles, info.m_reproducible);
     ForEachFromDatRawFormat(srcFilePath, midPoints);
 
     // sort features by their middle point
-    sort(midPoints.m_vec.begin(), midPoints.m_vec.end(), &SortMidPointsFunc);
+    sort(midPoints.m_vec.begin(), midPoints.m_vec.end());
 
     // store sorted features
     {
@@ -604,16 +714,33 @@ namespace feature
       {
         FeaturesCollector2 collector(datFilePath, header, regionData, info.m_versionDate);
 
-        for (size_t i = 0; i < midPoints.m_vec.size(); ++i)
+        // Geometry of a batch of features is made concurrently, then features are written
+        // in the sorted order, so the result doesn't depend on the number of threads.
+        size_t const threadsCount = std::max(info.m_threadsCount, static_cast<size_t>(1));
+        size_t const batchSize = threadsCount == 1 ? 1 : kFeaturesBatchSize;
+        vector<FeatureBuilder1> features;
+        vector<FeaturesCollector2::Geometry> geometries;
+
+        for (size_t begin = 0; begin < midPoints.m_vec.size(); begin += batchSize)
         {
-          ReaderSource<FileReader> src(reader);
-          src.Skip(midPoints.m_vec[i].second);
+          size_t const end = std::min(midPoints.m_vec.size(), begin + batchSize);
+
+          features.assign(end - begin, FeatureBuilder1());
+          for (size_t i = begin; i < end; ++i)
+          {
+            ReaderSource<FileReader> src(reader);
+            src.Skip(midPoints.m_vec[i].m_offset);
+            ReadFromSourceRowFormat(src, features[i - begin]);
+          }
 
-          FeatureBuilder1 f;
-          ReadFromSourceRowFormat(src, f);
+          geometries.assign(features.size(), FeaturesCollector2::Geometry());
+          generator::ForEachIndexInParallel(threadsCount, features.size(), [&](size_t i) {
+            collector.MakeGeometry(GetFeatureBuilder2(features[i]), geometries[i]);
+          });
 
-          // emit the feature
-          collector(GetFeatureBuilder2(f));
+          // emit the features
+          for (size_t i = 0; i < features.size(); ++i)
+            collector.Write(GetFeatureBuilder2(features[i]), geometries[i]);
         }
 
         collector.Finish();
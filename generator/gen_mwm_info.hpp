@@ -49,10 +49,13 @@ class OsmID2FeatureID : public Accumulator<std::pair<osm::Id, uint32_t /* featur
 public:
   template <class TSink> void Flush(TSink & sink)
   {
-    std::sort(m_data.begin(), m_data.end());
+    Sort();
     BaseT::Flush(sink);
   }
 
+  /// Should be called after Add() and before GetFeatureID().
+  void Sort() { std::sort(m_data.begin(), m_data.end()); }
+
   /// Find a feature id for an OSM id.
   bool GetFeatureID(osm::Id const & id, uint32_t & result) const
   {
@@ -86,6 +89,9 @@ public:
       return false;
     }
 
+    // Mappings are sorted by Flush() but GetFeatureID() must not depend on the writer.
+    if (!std::is_sorted(m_data.begin(), m_data.end()))
+      Sort();
     return true;
   }
 };
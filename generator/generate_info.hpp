@@ -9,6 +9,7 @@
 #include "defines.hpp"
 
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -20,7 +21,8 @@ struct GenerateInfo
   {
     Memory,
     Index,
-    File
+    File,
+    Mapped
   };
 
   enum class OsmSourceType
@@ -53,7 +55,12 @@ struct GenerateInfo
 
   uint32_t m_versionDate = 0;
 
+  // Number of threads which make geometry of features of a single mwm.
+  size_t m_threadsCount = 1;
+
   std::vector<std::string> m_bucketNames;
+  // Countries which are generated when the planet is split by polygons, all countries if empty.
+  std::set<std::string> m_countriesToGenerate;
 
   bool m_createWorld = false;
   bool m_splitByPolygons = false;
@@ -62,7 +69,10 @@ struct GenerateInfo
   bool m_genAddresses = false;
   bool m_failOnCoasts = false;
   bool m_preloadCache = false;
-
+  // Store features of a tile together instead of grouping them by min drawable scales.
+  bool m_sortFeaturesByTiles = false;
+  // Make byte-identical mwms whatever the number of threads and the machine are.
+  bool m_reproducible = false;
 
   GenerateInfo() = default;
 
@@ -84,6 +94,8 @@ struct GenerateInfo
       m_nodeStorageType = NodeStorageType::Index;
     else if (type == "mem")
       m_nodeStorageType = NodeStorageType::Memory;
+    else if (type == "mmap")
+      m_nodeStorageType = NodeStorageType::Mapped;
     else
       LOG(LCRITICAL, ("Incorrect node_storage type:", type));
   }
@@ -20,6 +20,7 @@ SOURCES += \
     booking_scoring.cpp \
     borders_generator.cpp \
     borders_loader.cpp \
+    build_profiler.cpp \
     centers_table_builder.cpp \
     check_model.cpp \
     cities_boundaries_builder.cpp \
@@ -29,12 +30,15 @@ SOURCES += \
     feature_generator.cpp \
     feature_merger.cpp \
     feature_sorter.cpp \
+    intermediate_data.cpp \
+    memory_aware_scheduler.cpp \
     metalines_builder.cpp \
     opentable_dataset.cpp \
     opentable_scoring.cpp \
     osm2meta.cpp \
     osm2type.cpp \
     osm_element.cpp \
+    osm_elements_pipeline.cpp \
     osm_id.cpp \
     osm_source.cpp \
     region_meta.cpp \
@@ -46,6 +50,8 @@ SOURCES += \
     routing_helpers.cpp \
     routing_index_generator.cpp \
     search_index_builder.cpp \
+    sections_manifest.cpp \
+    speed_profiles_generator.cpp \
     sponsored_scoring.cpp \
     srtm_parser.cpp \
     statistics.cpp \
@@ -65,6 +71,7 @@ HEADERS += \
     booking_dataset.hpp \
     borders_generator.hpp \
     borders_loader.hpp \
+    build_profiler.hpp \
     centers_table_builder.hpp \
     check_model.hpp \
     cities_boundaries_builder.hpp \
@@ -79,15 +86,18 @@ HEADERS += \
     generate_info.hpp \
     intermediate_data.hpp\
     intermediate_elements.hpp\
+    memory_aware_scheduler.hpp \
     metalines_builder.hpp \
     opentable_dataset.hpp \
     osm2meta.hpp \
     osm2type.hpp \
     osm_element.hpp \
+    osm_elements_pipeline.hpp \
     osm_id.hpp \
     osm_o5m_source.hpp \
     osm_translator.hpp \
     osm_xml_source.hpp \
+    parallel_utils.hpp \
     polygonizer.hpp \
     region_meta.hpp \
     restriction_collector.hpp \
@@ -98,6 +108,8 @@ HEADERS += \
     routing_helpers.hpp \
     routing_index_generator.hpp \
     search_index_builder.hpp \
+    sections_manifest.hpp \
+    speed_profiles_generator.hpp \
     sponsored_dataset.hpp \
     sponsored_dataset_inl.hpp \
     sponsored_object_storage.hpp \
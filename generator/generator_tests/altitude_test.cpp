@@ -156,6 +156,24 @@ void TestAltitudes(Index const & index, MwmSet::MwmId const & mwmId, std::string
     }
   };
   feature::ForEachFromDat(mwmPath, processor);
+
+  // Altitudes which are loaded in a batch are the same as ones loaded one by one.
+  vector<pair<uint32_t, size_t>> features;
+  feature::ForEachFromDat(mwmPath, [&features](FeatureType const & f, uint32_t const & id)
+  {
+    f.ParseGeometry(FeatureType::BEST_GEOMETRY);
+    features.emplace_back(id, f.GetPointsCount());
+  });
+  // Reversed order makes sure that the batch is sorted by the loader.
+  reverse(features.begin(), features.end());
+
+  AltitudeLoader batchLoader(index, mwmId);
+  batchLoader.LoadAltitudes(features);
+  for (auto const & feature : features)
+  {
+    TEST_EQUAL(batchLoader.GetAltitudes(feature.first, feature.second),
+               loader.GetAltitudes(feature.first, feature.second), (feature.first));
+  }
 }
 
 void TestAltitudesBuilding(vector<TPoint3DList> const & roads, bool hasAltitudeExpected,
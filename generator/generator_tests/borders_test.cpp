@@ -0,0 +1,73 @@
+#include "testing/testing.hpp"
+
+#include "generator/borders_loader.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+#include "geometry/region2d.hpp"
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+using namespace borders;
+using namespace std;
+
+namespace
+{
+using CellType = BordersCoverage::CellType;
+
+Region MakeRegion(vector<m2::PointD> const & points) { return Region(points.begin(), points.end()); }
+
+bool IsInside(vector<Region> const & regions, m2::PointD const & pt)
+{
+  for (auto const & region : regions)
+  {
+    if (region.Contains(pt))
+      return true;
+  }
+  return false;
+}
+}  // namespace
+
+UNIT_TEST(BordersCoverage_Smoke)
+{
+  // An L-shaped country with an island.
+  vector<Region> const regions = {
+      MakeRegion({{0, 0}, {10, 0}, {10, 3}, {3, 3}, {3, 10}, {0, 10}}),
+      MakeRegion({{7, 7}, {9, 7}, {8, 9.5}})};
+  m2::RectD rect;
+  for (auto const & region : regions)
+    rect.Add(region.GetRect());
+
+  BordersCoverage const coverage(regions, rect);
+  TEST(coverage.Get(m2::PointD(1, 1)) == CellType::Inside, ());
+  TEST(coverage.Get(m2::PointD(1.5, 9)) == CellType::Inside, ());
+  TEST(coverage.Get(m2::PointD(6, 6)) == CellType::Outside, ());
+  TEST(coverage.Get(m2::PointD(8, 7.5)) == CellType::Inside, ());
+  TEST(coverage.Get(m2::PointD(3, 5)) == CellType::Boundary, ());
+  TEST(coverage.Get(m2::PointD(11, 5)) == CellType::Outside, ());
+
+  mt19937 rng(0);
+  uniform_real_distribution<double> coord(-1, 11);
+  size_t boundary = 0;
+  size_t const kPoints = 10000;
+  for (size_t i = 0; i < kPoints; ++i)
+  {
+    m2::PointD const pt(coord(rng), coord(rng));
+    switch (coverage.Get(pt))
+    {
+    case CellType::Inside: TEST(IsInside(regions, pt), (pt)); break;
+    case CellType::Outside: TEST(!IsInside(regions, pt), (pt)); break;
+    case CellType::Boundary: ++boundary; break;
+    }
+  }
+  // Most points are classified without polygon tests.
+  TEST_LESS(boundary, kPoints / 10, ());
+}
+
+UNIT_TEST(BordersCoverage_Empty)
+{
+  BordersCoverage const coverage;
+  TEST(coverage.Get(m2::PointD(0, 0)) == CellType::Boundary, ());
+}
@@ -0,0 +1,105 @@
+#include "testing/testing.hpp"
+
+#include "generator/build_profiler.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_name_utils.hpp"
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "3party/jansson/myjansson.hpp"
+
+using namespace generator;
+using namespace std;
+
+namespace
+{
+void WriteToFile(string const & fileName, size_t size)
+{
+  FileWriter writer(fileName);
+  vector<uint8_t> const data(size, 1);
+  writer.Write(data.data(), data.size());
+}
+}  // namespace
+
+UNIT_TEST(BuildProfiler_Stages)
+{
+  string const fileName =
+      my::JoinFoldersToPath(GetPlatform().WritableDir(), "build_profiler_test.bin");
+
+  BuildProfiler profiler;
+  {
+    BuildProfiler::Stage stage(profiler, "Country", "geometry");
+    WriteToFile(fileName, 100000);
+  }
+  {
+    BuildProfiler::Stage stage(profiler, "Country", "index");
+  }
+  {
+    BuildProfiler::Stage stage(profiler, BuildProfiler::kGeneralReport, "preprocess");
+  }
+  my::DeleteFileX(fileName);
+
+  auto const stages = profiler.GetStages("Country");
+  TEST_EQUAL(stages.size(), 2, ());
+  TEST_EQUAL(stages[0].first, "geometry", ());
+  TEST_EQUAL(stages[1].first, "index", ());
+  TEST_GREATER(stages[0].second.m_peakRssBytes, 0, ());
+  TEST_GREATER_OR_EQUAL(stages[0].second.m_wallSeconds, 0.0, ());
+#if defined(OMIM_OS_LINUX)
+  TEST_GREATER_OR_EQUAL(stages[0].second.m_writtenBytes, 100000, ());
+#endif
+
+  TEST_EQUAL(profiler.GetStages(BuildProfiler::kGeneralReport).size(), 1, ());
+  TEST(profiler.GetStages("Unknown").empty(), ());
+}
+
+UNIT_TEST(BuildProfiler_SaveReport)
+{
+  string const fileName =
+      my::JoinFoldersToPath(GetPlatform().WritableDir(), "build_profiler_test.json");
+
+  BuildProfiler profiler;
+  TEST(!profiler.SaveReport("Country", fileName), ());
+
+  BuildProfiler::Usage usage;
+  usage.m_wallSeconds = 1.5;
+  usage.m_peakRssBytes = 100;
+  usage.m_writtenBytes = 10;
+  profiler.AddStage("Country", "geometry", usage);
+  usage.m_peakRssBytes = 50;
+  profiler.AddStage("Country", "index", usage);
+
+  TEST(profiler.SaveReport("Country", fileName), ());
+
+  string content;
+  FileReader(fileName).ReadAsString(content);
+  my::DeleteFileX(fileName);
+
+  my::Json json(content);
+  string name;
+  FromJSONObject(json.get(), "name", name);
+  TEST_EQUAL(name, "Country", ());
+
+  auto * stages = my::GetJSONObligatoryField(json.get(), "stages");
+  TEST_EQUAL(json_array_size(stages), 2, ());
+  FromJSONObject(json_array_get(stages, 1), "name", name);
+  TEST_EQUAL(name, "index", ());
+
+  auto * total = my::GetJSONObligatoryField(json.get(), "total");
+  double wallSeconds = 0.0;
+  uint64_t peakRssBytes = 0;
+  uint64_t writtenBytes = 0;
+  FromJSONObject(total, "wall_seconds", wallSeconds);
+  FromJSONObject(total, "peak_rss_bytes", peakRssBytes);
+  FromJSONObject(total, "written_bytes", writtenBytes);
+  TEST_ALMOST_EQUAL_ULPS(wallSeconds, 3.0, ());
+  TEST_EQUAL(peakRssBytes, 100, ());
+  TEST_EQUAL(writtenBytes, 20, ());
+}
@@ -187,3 +187,41 @@ UNIT_TEST(FeatureMerger_Rounds)
 
   TEST_EQUAL(emitter.GetSize(), 1, ());
 }
+
+UNIT_TEST(FeatureMerger_ChainGeometry)
+{
+  classificator::Load();
+
+  // Segments of a line in a shuffled order, some of them are reversed, so the line is
+  // extended from both sides while merging.
+  vector<pair<P, P>> const segments = {{P(2, 0), P(3, 0)}, {P(1, 0), P(0, 0)}, {P(4, 0), P(5, 0)},
+                                       {P(2, 0), P(1, 0)}, {P(4, 0), P(3, 0)}};
+
+  FeatureMergeProcessor processor(POINT_COORD_BITS);
+  for (auto const & s : segments)
+  {
+    FeatureBuilder1 fb;
+    fb.SetLinear();
+    fb.AddPoint(s.first);
+    fb.AddPoint(s.second);
+    fb.AddType(0);
+    processor(fb);
+  }
+
+  class GeometryEmitter : public FeatureEmitterIFace
+  {
+  public:
+    void operator() (FeatureBuilder1 const & fb) override { m_geometries.push_back(fb.GetOuterGeometry()); }
+
+    vector<FeatureBuilder1::TPointSeq> m_geometries;
+  } emitter;
+  processor.DoMerge(emitter);
+
+  TEST_EQUAL(emitter.m_geometries.size(), 1, ());
+  auto points = emitter.m_geometries.front();
+  if (points.front() != P(0, 0))
+    reverse(points.begin(), points.end());
+
+  FeatureBuilder1::TPointSeq const expected = {P(0, 0), P(1, 0), P(2, 0), P(3, 0), P(4, 0), P(5, 0)};
+  TEST_EQUAL(points, expected, ());
+}
@@ -34,18 +34,23 @@ HEADERS += \
 SOURCES += \
     ../../testing/testingmain.cpp \
     altitude_test.cpp \
+    borders_test.cpp \
+    build_profiler_test.cpp \
     check_mwms.cpp \
     coasts_test.cpp \
     feature_builder_test.cpp \
     feature_merger_test.cpp \
+    memory_aware_scheduler_test.cpp \
     metadata_parser_test.cpp \
     osm2meta_test.cpp \
+    osm_elements_pipeline_test.cpp \
     osm_id_test.cpp \
     osm_o5m_source_test.cpp \
     osm_type_test.cpp \
     road_access_test.cpp \
     restriction_collector_test.cpp \
     restriction_test.cpp \
+    sections_manifest_test.cpp \
     source_data.cpp \
     source_to_element_test.cpp \
     srtm_parser_test.cpp \
@@ -8,8 +8,22 @@
 
 #include "testing/testing.hpp"
 
+#include "generator/intermediate_data.hpp"
 #include "generator/intermediate_elements.hpp"
 
+#include "platform/platform_tests_support/scoped_file.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/internal/file_data.hpp"
+
+#include "base/math.hpp"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
 
 UNIT_TEST(Intermediate_Data_empty_way_element_save_load_test)
 {
@@ -99,3 +113,133 @@ UNIT_TEST(Intermediate_Data_relation_element_save_load_test)
   TEST_NOT_EQUAL(e2.tags["key1old"], "value1old", ());
   TEST_NOT_EQUAL(e2.tags["key2old"], "value2old", ());
 }
+
+namespace
+{
+using TPoints = std::vector<std::pair<uint64_t, std::pair<double, double>>>;
+
+template <class TStorage>
+void TestPoints(TStorage const & storage, TPoints const & points)
+{
+  double lat = 0.0;
+  double lon = 0.0;
+  for (auto const & p : points)
+  {
+    TEST(storage.GetPoint(p.first, lat, lon), (p.first));
+    TEST(my::AlmostEqualAbs(lat, p.second.first, 1e-7), (p.first, lat));
+    TEST(my::AlmostEqualAbs(lon, p.second.second, 1e-7), (p.first, lon));
+  }
+}
+}  // namespace
+
+UNIT_TEST(Intermediate_Data_mapped_point_storage_test)
+{
+  platform::tests_support::ScopedFile file("test_mapped_nodes.dat");
+
+  TPoints const points = {
+      {1, {55.7558, 37.6173}}, {10, {-33.8688, 151.2093}}, {1000000, {-90.0, -180.0}}};
+
+  {
+    cache::MappedFilePointStorage<cache::EMode::Write> storage(file.GetFullPath());
+    for (auto const & p : points)
+      storage.AddPoint(p.first, p.second.first, p.second.second);
+    TEST_EQUAL(storage.GetProcessedPoint(), points.size(), ());
+  }
+
+  {
+    cache::MappedFilePointStorage<cache::EMode::Read> storage(file.GetFullPath());
+    TestPoints(storage, points);
+    storage.Preload();
+    TestPoints(storage, points);
+  }
+
+  // The format is the same as the format of the raw storage.
+  uint64_t size = 0;
+  TEST(my::GetFileSize(file.GetFullPath(), size), ());
+  TEST_EQUAL(size, (points.back().first + 1) * sizeof(cache::PointStorage::LatLon), ());
+  TestPoints(cache::RawFilePointStorage<cache::EMode::Read>(file.GetFullPath()), points);
+}
+
+UNIT_TEST(Intermediate_Data_point_storage_updaters_test)
+{
+  TPoints const points = {{1, {55.7558, 37.6173}}, {10, {-33.8688, 151.2093}}};
+  TPoints const updated = {{1, {55.7558, 37.6173}}, {10, {10.0, 20.0}}, {2000, {-1.0, -2.0}}};
+
+  {
+    platform::tests_support::ScopedFile file("test_raw_nodes.dat");
+    {
+      cache::RawFilePointStorage<cache::EMode::Write> storage(file.GetFullPath());
+      for (auto const & p : points)
+        storage.AddPoint(p.first, p.second.first, p.second.second);
+    }
+    {
+      cache::RawFilePointStorageUpdater updater(file.GetFullPath());
+      updater.AddPoint(10, 10.0, 20.0);
+      updater.AddPoint(2000, -1.0, -2.0);
+      updater.RemovePoint(5000);
+    }
+
+    cache::MappedFilePointStorage<cache::EMode::Read> storage(file.GetFullPath());
+    TestPoints(storage, updated);
+  }
+
+  {
+    platform::tests_support::ScopedFile file("test_map_nodes.dat.short");
+    std::string const name = GetPlatform().WritablePathForFile("test_map_nodes.dat");
+    {
+      cache::MapFilePointStorage<cache::EMode::Write> storage(name);
+      for (auto const & p : points)
+        storage.AddPoint(p.first, p.second.first, p.second.second);
+      storage.AddPoint(3, 1.0, 1.0);
+    }
+    {
+      cache::MapFilePointStorageUpdater updater(name);
+      updater.AddPoint(10, 10.0, 20.0);
+      updater.AddPoint(2000, -1.0, -2.0);
+      updater.RemovePoint(3);
+    }
+
+    cache::MapFilePointStorage<cache::EMode::Read> storage(name);
+    TestPoints(storage, updated);
+    double lat, lon;
+    TEST(!storage.GetPoint(3, lat, lon), ());
+  }
+}
+
+UNIT_TEST(Intermediate_Data_element_cache_append_test)
+{
+  platform::tests_support::ScopedFile file("test_ways.dat");
+  platform::tests_support::ScopedFile offsets("test_ways.dat" OFFSET_EXT);
+
+  WayElement way(1 /* fake osm id */);
+  {
+    cache::OSMElementCache<cache::EMode::Write> ways(file.GetFullPath());
+    way.nodes = {1, 2};
+    ways.Write(1, way);
+    way.nodes = {3, 4};
+    ways.Write(2, way);
+    ways.SaveOffsets();
+  }
+  {
+    cache::OSMElementCache<cache::EMode::Write> ways(file.GetFullPath(), false /* preload */,
+                                                    true /* append */);
+    way.nodes = {5, 6, 7};
+    ways.Write(2, way);
+    way.nodes = {8, 9};
+    ways.Write(3, way);
+    ways.SaveOffsets();
+  }
+
+  for (bool const preload : {false, true})
+  {
+    cache::OSMElementCache<cache::EMode::Read> ways(file.GetFullPath(), preload);
+    ways.LoadOffsets();
+
+    TEST(ways.Read(1, way), ());
+    TEST_EQUAL(way.nodes, std::vector<uint64_t>({1, 2}), ());
+    TEST(ways.Read(2, way), ());
+    TEST_EQUAL(way.nodes, std::vector<uint64_t>({5, 6, 7}), ());
+    TEST(ways.Read(3, way), ());
+    TEST_EQUAL(way.nodes, std::vector<uint64_t>({8, 9}), ());
+  }
+}
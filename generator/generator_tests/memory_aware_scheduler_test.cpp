@@ -0,0 +1,109 @@
+#include "testing/testing.hpp"
+
+#include "generator/memory_aware_scheduler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace generator;
+using namespace std;
+
+namespace
+{
+class MemoryCounter
+{
+public:
+  void Acquire(uint64_t memory)
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_used += memory;
+    ++m_running;
+    m_maxUsed = max(m_maxUsed, m_used);
+    m_maxRunning = max(m_maxRunning, m_running);
+  }
+
+  void Release(uint64_t memory)
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_used -= memory;
+    --m_running;
+  }
+
+  uint64_t GetMaxUsed() const { return m_maxUsed; }
+  size_t GetMaxRunning() const { return m_maxRunning; }
+
+private:
+  mutex m_mutex;
+  uint64_t m_used = 0;
+  uint64_t m_maxUsed = 0;
+  size_t m_running = 0;
+  size_t m_maxRunning = 0;
+};
+
+void AddTasks(MemoryAwareScheduler & scheduler, vector<uint64_t> const & memories,
+              MemoryCounter & counter, atomic<size_t> & numDone)
+{
+  for (auto const memory : memories)
+  {
+    scheduler.AddTask(memory, [memory, &counter, &numDone] {
+      counter.Acquire(memory);
+      this_thread::sleep_for(chrono::milliseconds(5));
+      counter.Release(memory);
+      ++numDone;
+    });
+  }
+}
+}  // namespace
+
+UNIT_TEST(MemoryAwareScheduler_MemoryLimit)
+{
+  vector<uint64_t> const memories = {10, 20, 30, 40, 50, 60, 70, 80, 90, 100, 5, 5, 5, 5};
+
+  MemoryAwareScheduler scheduler(4 /* numThreads */, 100 /* maxMemory */);
+  MemoryCounter counter;
+  atomic<size_t> numDone(0);
+  AddTasks(scheduler, memories, counter, numDone);
+  scheduler.Run();
+
+  TEST_EQUAL(numDone, memories.size(), ());
+  TEST_LESS_OR_EQUAL(counter.GetMaxUsed(), 100, ());
+  TEST_LESS_OR_EQUAL(counter.GetMaxRunning(), 4, ());
+}
+
+UNIT_TEST(MemoryAwareScheduler_TooBigTask)
+{
+  MemoryAwareScheduler scheduler(3 /* numThreads */, 100 /* maxMemory */);
+  MemoryCounter counter;
+  atomic<size_t> numDone(0);
+  AddTasks(scheduler, {10, 500, 10, 10}, counter, numDone);
+  scheduler.Run();
+
+  // The task which doesn't fit the limit runs alone.
+  TEST_EQUAL(numDone, 4, ());
+  TEST_EQUAL(counter.GetMaxUsed(), 500, ());
+}
+
+UNIT_TEST(MemoryAwareScheduler_Order)
+{
+  MemoryAwareScheduler scheduler(1 /* numThreads */, 0 /* maxMemory */);
+  vector<uint64_t> order;
+  for (uint64_t const memory : {3, 1, 4, 1, 5})
+    scheduler.AddTask(memory, [memory, &order] { order.push_back(memory); });
+  scheduler.Run();
+
+  TEST_EQUAL(order, vector<uint64_t>({5, 4, 3, 1, 1}), ());
+}
+
+UNIT_TEST(MemoryAwareScheduler_Exception)
+{
+  MemoryAwareScheduler scheduler(2 /* numThreads */, 0 /* maxMemory */);
+  scheduler.AddTask(1, [] { throw runtime_error("Task failed"); });
+  scheduler.AddTask(1, [] {});
+  TEST_THROW(scheduler.Run(), runtime_error, ());
+}
@@ -0,0 +1,82 @@
+#include "testing/testing.hpp"
+
+#include "generator/osm_element.hpp"
+#include "generator/osm_elements_pipeline.hpp"
+
+#include "base/string_utils.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace generator;
+using namespace std;
+
+namespace
+{
+void MakeSource(uint64_t numElements, OsmElementsPipeline::Processor const & fn)
+{
+  for (uint64_t i = 0; i < numElements; ++i)
+  {
+    OsmElement e;
+    e.type = OsmElement::EntityType::Node;
+    e.id = i;
+    e.AddTag("name", strings::to_string(i));
+    fn(&e);
+  }
+}
+
+void TestPipeline(size_t numWorkers, size_t batchSize, uint64_t numElements)
+{
+  OsmElementsPipeline pipeline(numWorkers, batchSize);
+
+  vector<OsmElement> result;
+  pipeline.Run([&](OsmElementsPipeline::Processor const & fn) { MakeSource(numElements, fn); },
+               [](OsmElement * e) { e->AddTag("prepared", "yes"); },
+               [&result](OsmElement * e) { result.push_back(*e); });
+
+  TEST_EQUAL(result.size(), numElements, (numWorkers, batchSize));
+  for (uint64_t i = 0; i < result.size(); ++i)
+  {
+    auto const & e = result[i];
+    TEST_EQUAL(e.id, i, (numWorkers, batchSize));
+    TEST_EQUAL(e.Tags().size(), 2, (e));
+    TEST_EQUAL(e.GetTag("name"), strings::to_string(i), (e));
+    TEST_EQUAL(e.GetTag("prepared"), "yes", (e));
+  }
+}
+}  // namespace
+
+UNIT_TEST(OsmElementsPipeline_Order)
+{
+  for (size_t const numWorkers : {0, 1, 3})
+  {
+    for (size_t const batchSize : {1, 7, 1024})
+    {
+      TestPipeline(numWorkers, batchSize, 0 /* numElements */);
+      TestPipeline(numWorkers, batchSize, 1 /* numElements */);
+      TestPipeline(numWorkers, batchSize, 10000 /* numElements */);
+    }
+  }
+}
+
+UNIT_TEST(OsmElementsPipeline_Exceptions)
+{
+  OsmElementsPipeline pipeline(2 /* numWorkers */, 10 /* batchSize */);
+  auto const source = [](OsmElementsPipeline::Processor const & fn) { MakeSource(1000, fn); };
+  auto const noop = [](OsmElement *) {};
+  auto const thrower = [](OsmElement * e) {
+    if (e->id == 500)
+      throw runtime_error("Broken element");
+  };
+
+  TEST_THROW(pipeline.Run(source, thrower, noop), runtime_error, ());
+  TEST_THROW(pipeline.Run(source, noop, thrower), runtime_error, ());
+  TEST_THROW(pipeline.Run([&](OsmElementsPipeline::Processor const & fn) {
+                            source(thrower);
+                            source(fn);
+                          },
+                          noop, noop),
+             runtime_error, ());
+}
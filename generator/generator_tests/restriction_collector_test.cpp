@@ -2,6 +2,7 @@
 
 #include "generator/generator_tests_support/routing_helpers.hpp"
 
+#include "generator/gen_mwm_info.hpp"
 #include "generator/osm_id.hpp"
 #include "generator/restriction_collector.hpp"
 
@@ -32,16 +33,21 @@ UNIT_TEST(RestrictionTest_ValidCase)
 {
   RestrictionCollector restrictionCollector;
   // Adding feature ids.
-  restrictionCollector.AddFeatureId(30 /* featureId */, osm::Id::Way(3));
-  restrictionCollector.AddFeatureId(10 /* featureId */, osm::Id::Way(1));
-  restrictionCollector.AddFeatureId(50 /* featureId */, osm::Id::Way(5));
-  restrictionCollector.AddFeatureId(70 /* featureId */, osm::Id::Way(7));
-  restrictionCollector.AddFeatureId(20 /* featureId */, osm::Id::Way(2));
+  gen::OsmID2FeatureID osmIdToFeatureId;
+  osmIdToFeatureId.Add(std::make_pair(osm::Id::Way(3), 30 /* featureId */));
+  osmIdToFeatureId.Add(std::make_pair(osm::Id::Way(1), 10 /* featureId */));
+  osmIdToFeatureId.Add(std::make_pair(osm::Id::Way(5), 50 /* featureId */));
+  osmIdToFeatureId.Add(std::make_pair(osm::Id::Way(7), 70 /* featureId */));
+  osmIdToFeatureId.Add(std::make_pair(osm::Id::Way(2), 20 /* featureId */));
+  osmIdToFeatureId.Sort();
 
   // Adding restrictions.
-  TEST(restrictionCollector.AddRestriction(Restriction::Type::No, {osm::Id::Way(1), osm::Id::Way(2)}), ());
-  TEST(restrictionCollector.AddRestriction(Restriction::Type::No, {osm::Id::Way(2), osm::Id::Way(3)}), ());
-  TEST(restrictionCollector.AddRestriction(Restriction::Type::Only, {osm::Id::Way(5), osm::Id::Way(7)}), ());
+  TEST(restrictionCollector.AddRestriction(Restriction::Type::No, {osm::Id::Way(1), osm::Id::Way(2)},
+                                           osmIdToFeatureId), ());
+  TEST(restrictionCollector.AddRestriction(Restriction::Type::No, {osm::Id::Way(2), osm::Id::Way(3)},
+                                           osmIdToFeatureId), ());
+  TEST(restrictionCollector.AddRestriction(Restriction::Type::Only, {osm::Id::Way(5), osm::Id::Way(7)},
+                                           osmIdToFeatureId), ());
   my::SortUnique(restrictionCollector.m_restrictions);
 
   // Checking the result.
@@ -56,10 +62,13 @@ UNIT_TEST(RestrictionTest_ValidCase)
 UNIT_TEST(RestrictionTest_InvalidCase)
 {
   RestrictionCollector restrictionCollector;
-  restrictionCollector.AddFeatureId(0 /* featureId */, osm::Id::Way(0));
-  restrictionCollector.AddFeatureId(20 /* featureId */, osm::Id::Way(2));
+  gen::OsmID2FeatureID osmIdToFeatureId;
+  osmIdToFeatureId.Add(std::make_pair(osm::Id::Way(0), 0 /* featureId */));
+  osmIdToFeatureId.Add(std::make_pair(osm::Id::Way(2), 20 /* featureId */));
+  osmIdToFeatureId.Sort();
 
-  TEST(!restrictionCollector.AddRestriction(Restriction::Type::No, {osm::Id::Way(0), osm::Id::Way(1)}), ());
+  TEST(!restrictionCollector.AddRestriction(Restriction::Type::No, {osm::Id::Way(0), osm::Id::Way(1)},
+                                            osmIdToFeatureId), ());
 
   TEST(!restrictionCollector.HasRestrictions(), ());
   TEST(restrictionCollector.IsValid(), ());
@@ -83,7 +92,8 @@ UNIT_TEST(RestrictionTest_ParseRestrictions)
   Platform const & platform = Platform();
 
   TEST(restrictionCollector.ParseRestrictions(
-           my::JoinFoldersToPath(platform.WritableDir(), kRestrictionPath)),
+           my::JoinFoldersToPath(platform.WritableDir(), kRestrictionPath),
+           gen::OsmID2FeatureID()),
        ());
   TEST(!restrictionCollector.HasRestrictions(), ());
 }
@@ -123,5 +133,12 @@ UNIT_TEST(RestrictionTest_RestrictionCollectorWholeClassTest)
                                                {Restriction::Type::Only, {1, 2}},
                                                {Restriction::Type::Only, {3, 4}}};
   TEST_EQUAL(restrictions, expectedRestrictions, ());
+
+  // The same mapping is shared by collectors.
+  gen::OsmID2FeatureID osmIdToFeatureId;
+  TEST(osmIdToFeatureId.ReadFromFile(osmIdsToFeatureIdsFullPath), ());
+  RestrictionCollector const sharedMappingCollector(
+      my::JoinFoldersToPath(platform.WritableDir(), kRestrictionPath), osmIdToFeatureId);
+  TEST_EQUAL(sharedMappingCollector.GetRestrictions(), expectedRestrictions, ());
 }
 }  // namespace routing
@@ -0,0 +1,76 @@
+#include "testing/testing.hpp"
+
+#include "generator/sections_manifest.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_container.hpp"
+#include "coding/file_name_utils.hpp"
+#include "coding/file_reader.hpp"
+#include "coding/internal/file_data.hpp"
+
+#include "base/scope_guard.hpp"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace generator;
+using namespace std;
+
+namespace
+{
+void WriteContainer(string const & fileName, vector<pair<string, string>> const & sections)
+{
+  FilesContainerW container(fileName);
+  for (auto const & section : sections)
+    container.Write(vector<char>(section.second.begin(), section.second.end()), section.first);
+  container.Finish();
+}
+
+string ReadFile(string const & fileName)
+{
+  string contents;
+  FileReader(fileName).ReadAsString(contents);
+  return contents;
+}
+}  // namespace
+
+UNIT_TEST(SectionsManifest_Smoke)
+{
+  string const dir = GetPlatform().WritableDir();
+  string const first = my::JoinFoldersToPath(dir, "sections_manifest_test_1.mwm");
+  string const second = my::JoinFoldersToPath(dir, "sections_manifest_test_2.mwm");
+  string const manifest = first + ".sections";
+  MY_SCOPE_GUARD(cleanup, [&]() {
+    my::DeleteFileX(first);
+    my::DeleteFileX(second);
+    my::DeleteFileX(manifest);
+  });
+
+  WriteContainer(first, {{"dat", "features"}, {"idx", "index"}});
+  // The same sections in another order.
+  WriteContainer(second, {{"idx", "index"}, {"dat", "features"}});
+
+  auto const hashes = GetSectionHashes(first);
+  TEST_EQUAL(hashes.size(), 2, ());
+  TEST_EQUAL(hashes[0].m_tag, "dat", ());
+  TEST_EQUAL(hashes[0].m_size, 8, ());
+  TEST_EQUAL(hashes[1].m_tag, "idx", ());
+  TEST_EQUAL(hashes[1].m_size, 5, ());
+
+  auto const otherHashes = GetSectionHashes(second);
+  TEST_EQUAL(otherHashes.size(), 2, ());
+  for (size_t i = 0; i < hashes.size(); ++i)
+    TEST_EQUAL(hashes[i].m_crc32, otherHashes[i].m_crc32, ());
+
+  WriteContainer(second, {{"dat", "featureS"}, {"idx", "index"}});
+  auto const changedHashes = GetSectionHashes(second);
+  TEST_NOT_EQUAL(hashes[0].m_crc32, changedHashes[0].m_crc32, ());
+  TEST_EQUAL(hashes[1].m_crc32, changedHashes[1].m_crc32, ());
+
+  TEST(WriteSectionsManifest(first, manifest), ());
+  string const contents = ReadFile(manifest);
+  TEST_EQUAL(contents.find("dat 8 "), 0, (contents));
+  TEST_NOT_EQUAL(contents.find("\nidx 5 "), string::npos, (contents));
+}
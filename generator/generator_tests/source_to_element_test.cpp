@@ -3,8 +3,10 @@
 #include "coding/parse_xml.hpp"
 #include "generator/osm_source.hpp"
 #include "generator/osm_element.hpp"
+#include "generator/osm_xml_source.hpp"
 
 #include <iterator>
+#include <utility>
 
 #include "source_data.hpp"
 
@@ -66,3 +68,48 @@ UNIT_TEST(Source_To_Element_check_equivalence)
     TEST_EQUAL(elementsXML[i], elementsO5M[i], ());
   }
 }
+
+UNIT_TEST(Source_To_Element_create_from_osc_test)
+{
+  std::istringstream ss(R"(<?xml version="1.0" encoding="UTF-8"?>
+<osmChange version="0.6" generator="test">
+  <create>
+    <node id="1" version="1" lat="55.75" lon="37.61">
+      <tag k="name" v="Moscow"/>
+    </node>
+  </create>
+  <modify>
+    <way id="2" version="2">
+      <nd ref="1"/>
+      <nd ref="3"/>
+      <tag k="highway" v="primary"/>
+    </way>
+  </modify>
+  <delete>
+    <relation id="4" version="3"/>
+  </delete>
+</osmChange>)");
+  SourceReader reader(ss);
+
+  std::vector<std::pair<OscSource::Action, OsmElement>> elements;
+  OscSource parser([&elements](OscSource::Action action, OsmElement * e)
+  {
+    elements.emplace_back(action, *e);
+  });
+  ParseXMLSequence(reader, parser);
+
+  TEST_EQUAL(elements.size(), 3, ());
+
+  TEST(elements[0].first == OscSource::Action::Create, ());
+  TEST_EQUAL(elements[0].second.type, OsmElement::EntityType::Node, ());
+  TEST_EQUAL(elements[0].second.id, 1, ());
+  TEST_EQUAL(elements[0].second.GetTag("name"), "Moscow", ());
+
+  TEST(elements[1].first == OscSource::Action::Modify, ());
+  TEST_EQUAL(elements[1].second.type, OsmElement::EntityType::Way, ());
+  TEST_EQUAL(elements[1].second.Nodes(), std::vector<uint64_t>({1, 3}), ());
+
+  TEST(elements[2].first == OscSource::Action::Delete, ());
+  TEST_EQUAL(elements[2].second.type, OsmElement::EntityType::Relation, ());
+  TEST_EQUAL(elements[2].second.id, 4, ());
+}
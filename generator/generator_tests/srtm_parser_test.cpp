@@ -2,7 +2,17 @@
 
 #include "generator/srtm_parser.hpp"
 
+#include "platform/platform_tests_support/scoped_dir.hpp"
+#include "platform/platform_tests_support/scoped_file.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_name_utils.hpp"
+
+#include <string>
+
 using namespace generator;
+using namespace platform::tests_support;
 
 namespace
 {
@@ -25,4 +35,39 @@ UNIT_TEST(FilenameTests)
   name = GetBase({-34.622358, -58.383654});
   TEST_EQUAL(name, "S35W059", ());
 }
+
+UNIT_TEST(SrtmTileManager_Cache)
+{
+  std::string const kCacheDir = "srtm-cache";
+  std::string const kSrtmDir = "not-existing-srtm-dir/";
+  size_t const kTileSize = 3601 * 3601 * 2;
+
+  // A tile with the same height in all points, heights are stored in big endian.
+  auto const makeTile = [kTileSize](char high, char low) {
+    std::string tile;
+    tile.reserve(kTileSize);
+    while (tile.size() < kTileSize)
+    {
+      tile.push_back(high);
+      tile.push_back(low);
+    }
+    return tile;
+  };
+
+  ScopedDir const scopedDir(kCacheDir);
+  ScopedFile const tile1(my::JoinFoldersToPath(kCacheDir, "N00E000.hgt"), makeTile(1, 2));
+  ScopedFile const tile2(my::JoinFoldersToPath(kCacheDir, "N00E001.hgt"), makeTile(2, 1));
+  // A damaged tile is ignored.
+  ScopedFile const tile3(my::JoinFoldersToPath(kCacheDir, "N00E002.hgt"), "damaged");
+
+  std::string const cacheDir =
+      my::AddSlashIfNeeded(my::JoinFoldersToPath(GetPlatform().WritableDir(), kCacheDir));
+  SrtmTileManager manager(kSrtmDir, cacheDir, 1 /* maxTiles */);
+  for (size_t i = 0; i < 3; ++i)
+  {
+    TEST_EQUAL(manager.GetHeight({0.5, 0.5}), 0x0102, ());
+    TEST_EQUAL(manager.GetHeight({0.5, 1.5}), 0x0201, ());
+    TEST_EQUAL(manager.GetHeight({0.5, 2.5}), feature::kInvalidAltitude, ());
+  }
+}
 }  // namespace
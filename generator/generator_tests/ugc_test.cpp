@@ -43,3 +43,26 @@ UNIT_TEST(UGC_TranslateRatingTest)
   TEST_EQUAL(ugc.m_ratings[0].m_key, "2", ());
   TEST(my::AlmostEqualAbs(ugc.m_ratings[0].m_value, 3.4f, 1e-6f), ());
 }
+
+UNIT_TEST(UGC_ForEachSortedTest)
+{
+  generator::UGCDB db(":memory:");
+  TEST(db.Exec(g_database), ("Can't open database"));
+
+  std::vector<osm::Id> ids;
+  ugc::UGC ugc;
+  bool rc = db.ForEachSorted([&](osm::Id const & id, std::string const & value) {
+    ids.push_back(id);
+    if (id == osm::Id(9826353))
+      generator::UGCTranslator::ParseUGC(value, ugc);
+  });
+  TEST(rc, ());
+  TEST_EQUAL(ids, std::vector<osm::Id>({osm::Id(9826352), osm::Id(9826353)}), ());
+
+  TEST_EQUAL(ugc.m_ratings.size(), 3, ());
+  TEST_EQUAL(ugc.m_ratings[2].m_key, "6", ());
+  TEST_EQUAL(ugc.m_reviews.size(), 1, ());
+
+  TEST(generator::UGCDB::KeyLess(osm::Id::Way(1), osm::Id::Relation(1)), ());
+  TEST(generator::UGCDB::KeyLess(osm::Id::Relation(1), osm::Id::Node(1)), ());
+}
@@ -1,20 +1,26 @@
 #include "generator/altitude_generator.hpp"
 #include "generator/borders_generator.hpp"
 #include "generator/borders_loader.hpp"
+#include "generator/build_profiler.hpp"
 #include "generator/centers_table_builder.hpp"
 #include "generator/check_model.hpp"
 #include "generator/cities_boundaries_builder.hpp"
 #include "generator/dumper.hpp"
 #include "generator/feature_generator.hpp"
 #include "generator/feature_sorter.hpp"
+#include "generator/gen_mwm_info.hpp"
 #include "generator/generate_info.hpp"
+#include "generator/memory_aware_scheduler.hpp"
 #include "generator/metalines_builder.hpp"
 #include "generator/osm_source.hpp"
+#include "generator/parallel_utils.hpp"
 #include "generator/restriction_generator.hpp"
 #include "generator/road_access_generator.hpp"
 #include "generator/routing_generator.hpp"
 #include "generator/routing_index_generator.hpp"
 #include "generator/search_index_builder.hpp"
+#include "generator/sections_manifest.hpp"
+#include "generator/speed_profiles_generator.hpp"
 #include "generator/statistics.hpp"
 #include "generator/traffic_generator.hpp"
 #include "generator/transit_generator.hpp"
@@ -41,8 +47,12 @@
 
 #include "std/unique_ptr.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "defines.hpp"
 
@@ -61,18 +71,34 @@ DEFINE_string(data_path, "", "Working directory, 'path_to_exe/../../data' if emp
 DEFINE_string(user_resource_path, "", "User defined resource path for classificator.txt and etc.");
 DEFINE_string(intermediate_data_path, "", "Path to stored nodes, ways, relations.");
 DEFINE_string(output, "", "File name for process (without 'mwm' ext).");
-DEFINE_bool(preload_cache, false, "Preload all ways and relations cache.");
+DEFINE_bool(preload_cache, false, "Preload all ways and relations cache (and nodes for mmap node_storage).");
 DEFINE_string(node_storage, "map",
-              "Type of storage for intermediate points representation. Available: raw, map, mem.");
+              "Type of storage for intermediate points representation. Available: raw, map, mem, mmap.");
+DEFINE_uint64(threads_count, 1,
+              "Number of threads, the number of cores if 0. Mwms are processed concurrently, "
+              "spare threads make geometry of features.");
+DEFINE_uint64(max_memory_mb, 0,
+              "Approximate memory limit for mwms which are processed concurrently, no limit if 0.");
 DEFINE_uint64(planet_version, my::SecondsSinceEpoch(),
               "Version as seconds since epoch, by default - now.");
 
 // Preprocessing and feature generator.
 DEFINE_bool(preprocess, false, "1st pass - create nodes/ways/relations data.");
+DEFINE_string(osc_file_name, "",
+              "Osm change file (.osc) to apply to the intermediate data instead of --preprocess. "
+              "Only countries which may change are generated by the next passes, so "
+              "--osm_file_name should be the planet with the change applied.");
 DEFINE_bool(generate_features, false, "2nd pass - generate intermediate features.");
 DEFINE_bool(generate_geometry, false,
             "3rd pass - split and simplify geometry and triangles for features.");
 DEFINE_bool(generate_index, false, "4rd pass - generate index.");
+DEFINE_bool(sort_features_by_tiles, false,
+            "Store features which are close to each other together whatever their min "
+            "drawable scales are, so tiles of detailed scales are read sequentially.");
+DEFINE_bool(reproducible, false,
+            "Make byte-identical mwms whatever the number of threads and the machine are: order "
+            "features with equal keys by their contents, require --planet_version and write "
+            "hashes of sections to .mwm" SECTIONS_MANIFEST_FILE_EXTENSION " files.");
 DEFINE_bool(generate_search_index, false, "5th pass - generate search index.");
 DEFINE_bool(generate_cities_boundaries, false, "Generate section with cities boundaries");
 DEFINE_bool(generate_world, false, "Generate separate world file.");
@@ -86,11 +112,18 @@ DEFINE_bool(make_cross_section, false, "Make cross section in routing file for c
 DEFINE_bool(make_routing_index, false, "Make sections with the routing information.");
 DEFINE_bool(make_cross_mwm, false,
             "Make section for cross mwm routing (for dynamic indexed routing).");
+DEFINE_bool(make_shortcut_overlay, false,
+            "Make shortcut overlay section for car routing (routing section should be built).");
 DEFINE_bool(disable_cross_mwm_progress, false,
             "Disable log of cross mwm section building progress.");
 DEFINE_string(srtm_path, "",
               "Path to srtm directory. If set, generates a section with altitude information "
               "about roads.");
+DEFINE_string(srtm_cache_path, "",
+              "Path to a directory for decompressed srtm tiles. If set, tiles are unzipped once "
+              "and mapped to memory by all mwms and next runs.");
+DEFINE_string(speed_profiles_path, "",
+              "Path to csv file with historical speeds of car roads (see speed_profiles_generator.hpp).");
 DEFINE_string(transit_path, "", "Path to directory with transit graphs in json.");
 
 // Sponsored-related.
@@ -110,9 +143,13 @@ DEFINE_bool(dump_types, false, "Prints all types combinations and their total co
 DEFINE_bool(dump_prefixes, false, "Prints statistics on feature's' name prefixes.");
 DEFINE_bool(dump_search_tokens, false, "Print statistics on search tokens.");
 DEFINE_string(dump_feature_names, "", "Print all feature names by 2-letter locale.");
+DEFINE_bool(scan_all_mwms, false,
+            "Apply --dump_types, --dump_prefixes, --dump_search_tokens and --check_mwm to all "
+            "mwms in data_path instead of --output. Mwms are scanned in parallel.");
 
 // Service functions.
-DEFINE_bool(generate_classif, false, "Generate classificator.");
+DEFINE_bool(generate_classif, false,
+            "Generate binary classificator cache " CLASSIFICATOR_CACHE_FILE " in data_path.");
 DEFINE_bool(generate_packed_borders, false, "Generate packed file with country polygons.");
 DEFINE_string(unpack_borders, "", "Convert packed_polygons to a directory of polygon files (specify folder).");
 DEFINE_bool(unpack_mwm, false, "Unpack each section of mwm into a separate file with name filePath.sectionName.");
@@ -121,9 +158,30 @@ DEFINE_string(delete_section, "", "Delete specified section (defines.hpp) from c
 DEFINE_bool(generate_addresses_file, false, "Generate .addr file (for '--output' option) with full addresses list.");
 DEFINE_bool(generate_traffic_keys, false,
             "Generate keys for the traffic map (road segment -> speed group).");
+DEFINE_bool(save_build_profile, false,
+            "Save wall and cpu time, peak memory and io of generation stages to "
+            "'mwm_name.mwm.profile.json' next to each mwm and to 'generator.profile.json' for "
+            "stages which don't belong to an mwm.");
 
 using namespace generator;
 
+namespace
+{
+// Passes over an mwm keep its features in memory several times, e.g. sorted features and
+// geometry of all scales, so memory usage is proportional to the size of the data.
+uint64_t constexpr kMemoryPerDataByte = 4;
+
+char const kProfileExtension[] = ".profile.json";
+
+uint64_t EstimateBucketMemory(std::string const & tmpFile, std::string const & datFile)
+{
+  uint64_t size = 0;
+  if (!Platform::GetFileSizeByFullPath(tmpFile, size))
+    Platform::GetFileSizeByFullPath(datFile, size);
+  return size * kMemoryPerDataByte;
+}
+}  // namespace
+
 int main(int argc, char ** argv)
 {
   google::SetUsageMessage(
@@ -165,15 +223,29 @@ int main(int argc, char ** argv)
     genInfo.m_boundariesTable = make_shared<generator::OsmIdToBoundariesTable>();
 
   genInfo.m_versionDate = static_cast<uint32_t>(FLAGS_planet_version);
+  genInfo.m_sortFeaturesByTiles = FLAGS_sort_features_by_tiles;
+  genInfo.m_reproducible = FLAGS_reproducible;
+  if (FLAGS_reproducible && google::GetCommandLineFlagInfoOrDie("planet_version").is_default)
+    LOG(LCRITICAL, ("--planet_version must be set for reproducible builds."));
+
+  size_t const threadsCount =
+      FLAGS_threads_count == 0 ? std::max(std::thread::hardware_concurrency(), 1u)
+                               : static_cast<size_t>(FLAGS_threads_count);
+  // Planet-wide passes use all the threads.
+  genInfo.m_threadsCount = threadsCount;
 
   if (!FLAGS_node_storage.empty())
     genInfo.SetNodeStorageType(FLAGS_node_storage);
   if (!FLAGS_osm_file_type.empty())
     genInfo.SetOsmFileType(FLAGS_osm_file_type);
 
+  BuildProfiler profiler;
+  std::string const generalReport = BuildProfiler::kGeneralReport;
+
   // Generate intermediate files.
   if (FLAGS_preprocess)
   {
+    BuildProfiler::Stage stage(profiler, generalReport, "preprocess");
     LOG(LINFO, ("Generating intermediate data ...."));
     if (!GenerateIntermediateData(genInfo))
     {
@@ -181,6 +253,23 @@ int main(int argc, char ** argv)
     }
   }
 
+  // Update intermediate files.
+  if (!FLAGS_osc_file_name.empty())
+  {
+    LOG(LINFO, ("Updating intermediate data ...."));
+    {
+      BuildProfiler::Stage stage(profiler, generalReport, "osm_change");
+      if (!UpdateIntermediateData(genInfo, FLAGS_osc_file_name, genInfo.m_countriesToGenerate))
+        return -1;
+    }
+
+    if (genInfo.m_countriesToGenerate.empty())
+    {
+      LOG(LINFO, ("No country is affected by", FLAGS_osc_file_name));
+      return 0;
+    }
+  }
+
   // Use merged style.
   GetStyleReader().SetCurrentStyle(MapStyleMerged);
 
@@ -189,7 +278,8 @@ int main(int argc, char ** argv)
       FLAGS_generate_index || FLAGS_generate_search_index || FLAGS_generate_cities_boundaries ||
       FLAGS_calc_statistics || FLAGS_type_statistics || FLAGS_dump_types || FLAGS_dump_prefixes ||
       FLAGS_dump_feature_names != "" || FLAGS_check_mwm || FLAGS_srtm_path != "" ||
-      FLAGS_make_routing_index || FLAGS_make_cross_mwm || FLAGS_generate_traffic_keys ||
+      FLAGS_make_routing_index || FLAGS_make_cross_mwm || FLAGS_make_shortcut_overlay ||
+      FLAGS_generate_traffic_keys ||
       FLAGS_transit_path != "")
   {
     classificator::Load();
@@ -198,7 +288,7 @@ int main(int argc, char ** argv)
 
   // Load mwm tree only if we need it
   std::unique_ptr<storage::CountryParentGetter> countryParentGetter;
-  if (FLAGS_make_routing_index || FLAGS_make_cross_mwm)
+  if (FLAGS_make_routing_index || FLAGS_make_cross_mwm || FLAGS_make_shortcut_overlay)
   {
     countryParentGetter =
         make_unique<storage::CountryParentGetter>();
@@ -216,8 +306,11 @@ int main(int argc, char ** argv)
     genInfo.m_fileName = FLAGS_output;
     genInfo.m_genAddresses = FLAGS_generate_addresses_file;
 
-    if (!GenerateFeatures(genInfo))
-      return -1;
+    {
+      BuildProfiler::Stage stage(profiler, generalReport, "features");
+      if (!GenerateFeatures(genInfo))
+        return -1;
+    }
 
     if (FLAGS_generate_world)
     {
@@ -231,17 +324,23 @@ int main(int argc, char ** argv)
       genInfo.m_bucketNames.push_back(FLAGS_output);
   }
 
-  // Enumerate over all dat files that were created.
-  size_t const count = genInfo.m_bucketNames.size();
-  for (size_t i = 0; i < count; ++i)
+  std::string srtmCacheDir;
+  if (!FLAGS_srtm_path.empty() && !FLAGS_srtm_cache_path.empty())
   {
-    std::string const & country = genInfo.m_bucketNames[i];
+    srtmCacheDir = my::AddSlashIfNeeded(FLAGS_srtm_cache_path);
+    if (!Platform::MkDirChecked(srtmCacheDir))
+      LOG(LCRITICAL, ("Can't create srtm cache directory", srtmCacheDir));
+  }
+
+  // Process all dat files that were created.
+  auto const processBucket = [&](std::string const & country) {
     std::string const datFile = my::JoinFoldersToPath(path, country + DATA_FILE_EXTENSION);
     std::string const osmToFeatureFilename =
         genInfo.GetTargetFileName(country) + OSM2FEATURE_FILE_EXTENSION;
 
     if (FLAGS_generate_geometry)
     {
+      BuildProfiler::Stage stage(profiler, country, "geometry");
       int mapType = feature::DataHeader::country;
       if (country == WORLD_FILE_NAME)
         mapType = feature::DataHeader::world;
@@ -252,11 +351,11 @@ int main(int argc, char ** argv)
 
       LOG(LINFO, ("Generating result features for", country));
       if (!feature::GenerateFinalFeatures(genInfo, country, mapType))
-        continue;
+        return true;
 
       LOG(LINFO, ("Generating offsets table for", datFile));
       if (!feature::BuildOffsetsTable(datFile))
-        continue;
+        return true;
 
       if (mapType == feature::DataHeader::country)
       {
@@ -271,6 +370,7 @@ int main(int argc, char ** argv)
 
     if (FLAGS_generate_index)
     {
+      BuildProfiler::Stage stage(profiler, country, "index");
       LOG(LINFO, ("Generating index for", datFile));
 
       if (!indexer::BuildIndexFromDataFile(datFile, FLAGS_intermediate_data_path + country))
@@ -279,22 +379,36 @@ int main(int argc, char ** argv)
 
     if (FLAGS_generate_search_index)
     {
-      LOG(LINFO, ("Generating search index for", datFile));
-
-      if (!indexer::BuildSearchIndexFromDataFile(datFile, true))
-        LOG(LCRITICAL, ("Error generating search index."));
+      {
+        BuildProfiler::Stage stage(profiler, country, "search_index");
+        LOG(LINFO, ("Generating search index for", datFile));
+
+        if (!indexer::BuildSearchIndexFromDataFile(datFile, true /* forceRebuild */,
+                                                   genInfo.m_threadsCount))
+        {
+          LOG(LCRITICAL, ("Error generating search index."));
+        }
+      }
 
-      LOG(LINFO, ("Generating rank table for", datFile));
-      if (!search::RankTableBuilder::CreateIfNotExists(datFile))
-        LOG(LCRITICAL, ("Error generating rank table."));
+      {
+        BuildProfiler::Stage stage(profiler, country, "rank_table");
+        LOG(LINFO, ("Generating rank table for", datFile));
+        if (!search::RankTableBuilder::CreateIfNotExists(datFile))
+          LOG(LCRITICAL, ("Error generating rank table."));
+      }
 
-      LOG(LINFO, ("Generating centers table for", datFile));
-      if (!indexer::BuildCentersTableFromDataFile(datFile, true /* forceRebuild */))
-        LOG(LCRITICAL, ("Error generating centers table."));
+      {
+        BuildProfiler::Stage stage(profiler, country, "centers");
+        LOG(LINFO, ("Generating centers table for", datFile));
+        if (!indexer::BuildCentersTableFromDataFile(datFile, true /* forceRebuild */,
+                                                    genInfo.m_threadsCount))
+          LOG(LCRITICAL, ("Error generating centers table."));
+      }
     }
 
     if (FLAGS_generate_cities_boundaries)
     {
+      BuildProfiler::Stage stage(profiler, country, "cities_boundaries");
       LOG(LINFO, ("Generating cities boundaries for", datFile));
       CHECK(genInfo.m_boundariesTable, ());
       if (!generator::BuildCitiesBoundaries(datFile, osmToFeatureFilename,
@@ -305,10 +419,16 @@ int main(int argc, char ** argv)
     }
 
     if (!FLAGS_srtm_path.empty())
-      routing::BuildRoadAltitudes(datFile, FLAGS_srtm_path);
+    {
+      BuildProfiler::Stage stage(profiler, country, "altitudes");
+      routing::BuildRoadAltitudes(datFile, FLAGS_srtm_path, srtmCacheDir, genInfo.m_threadsCount);
+    }
 
     if (!FLAGS_transit_path.empty())
+    {
+      BuildProfiler::Stage stage(profiler, country, "transit");
       routing::transit::BuildTransit(datFile, FLAGS_transit_path);
+    }
 
     if (FLAGS_make_routing_index)
     {
@@ -317,16 +437,37 @@ int main(int argc, char ** argv)
         // All the mwms should use proper VehicleModels.
         LOG(LCRITICAL, ("Countries file is needed. Please set countries file name (countries.txt or "
                         "countries_obsolete.txt). File must be located in data directory."));
-        return -1;
+        return false;
       }
 
+      BuildProfiler::Stage stage(profiler, country, "routing");
       std::string const restrictionsFilename =
           genInfo.GetIntermediateFileName(RESTRICTIONS_FILENAME, "" /* extension */);
       std::string const roadAccessFilename =
           genInfo.GetIntermediateFileName(ROAD_ACCESS_FILENAME, "" /* extension */);
 
-      routing::BuildRoadRestrictions(datFile, restrictionsFilename, osmToFeatureFilename);
-      routing::BuildRoadAccessInfo(datFile, roadAccessFilename, osmToFeatureFilename);
+      // The mapping is loaded once and both collectors look up feature ids in it concurrently.
+      // Sections are written one after another because they are written to the same file.
+      gen::OsmID2FeatureID osmIdToFeatureId;
+      if (osmIdToFeatureId.ReadFromFile(osmToFeatureFilename))
+      {
+        std::unique_ptr<routing::RestrictionCollector> restrictionCollector;
+        std::unique_ptr<routing::RoadAccessCollector> roadAccessCollector;
+        generator::ForEachIndexInParallel(genInfo.m_threadsCount, 2 /* count */, [&](size_t i) {
+          if (i == 0)
+          {
+            restrictionCollector = make_unique<routing::RestrictionCollector>(
+                restrictionsFilename, osmIdToFeatureId);
+          }
+          else
+          {
+            roadAccessCollector = make_unique<routing::RoadAccessCollector>(
+                datFile, roadAccessFilename, osmIdToFeatureId);
+          }
+        });
+        routing::BuildRoadRestrictions(datFile, *restrictionCollector);
+        routing::BuildRoadAccessInfo(datFile, *roadAccessCollector);
+      }
       routing::BuildRoutingIndex(datFile, country, *countryParentGetter);
     }
 
@@ -337,17 +478,46 @@ int main(int argc, char ** argv)
         // All the mwms should use proper VehicleModels.
         LOG(LCRITICAL, ("Countries file is needed. Please set countries file name (countries.txt or "
                         "countries_obsolete.txt). File must be located in data directory."));
-        return -1;
+        return false;
       }
 
+      BuildProfiler::Stage stage(profiler, country, "cross_mwm");
       if (!routing::BuildCrossMwmSection(path, datFile, country, *countryParentGetter,
-                                         osmToFeatureFilename, FLAGS_disable_cross_mwm_progress))
+                                         osmToFeatureFilename, FLAGS_disable_cross_mwm_progress,
+                                         genInfo.m_threadsCount))
         LOG(LCRITICAL, ("Error generating cross mwm section."));
     }
 
+    if (FLAGS_make_shortcut_overlay)
+    {
+      if (!countryParentGetter)
+      {
+        // All the mwms should use proper VehicleModels.
+        LOG(LCRITICAL, ("Countries file is needed. Please set countries file name (countries.txt or "
+                        "countries_obsolete.txt). File must be located in data directory."));
+        return false;
+      }
+
+      BuildProfiler::Stage stage(profiler, country, "shortcut_overlay");
+      if (!routing::BuildShortcutOverlaySection(path, datFile, country, *countryParentGetter))
+        LOG(LCRITICAL, ("Error generating shortcut overlay section."));
+    }
+
+    if (!FLAGS_speed_profiles_path.empty())
+    {
+      BuildProfiler::Stage stage(profiler, country, "speed_profiles");
+      if (!routing::BuildSpeedProfilesSection(datFile, FLAGS_speed_profiles_path,
+                                              osmToFeatureFilename))
+      {
+        LOG(LCRITICAL, ("Error generating speed profiles section."));
+      }
+    }
+
     if (!FLAGS_ugc_data.empty())
     {
-      if (!BuildUgcMwmSection(FLAGS_ugc_data, datFile, osmToFeatureFilename))
+      BuildProfiler::Stage stage(profiler, country, "ugc");
+      if (!BuildUgcMwmSection(FLAGS_ugc_data, datFile, osmToFeatureFilename,
+                              genInfo.m_threadsCount))
       {
         LOG(LCRITICAL, ("Error generating UGC mwm section."));
       }
@@ -355,10 +525,50 @@ int main(int argc, char ** argv)
 
     if (FLAGS_generate_traffic_keys)
     {
-      if (!traffic::GenerateTrafficKeysFromDataFile(datFile))
+      BuildProfiler::Stage stage(profiler, country, "traffic_keys");
+      if (!traffic::GenerateTrafficKeysFromDataFile(datFile, genInfo.m_threadsCount))
         LOG(LCRITICAL, ("Error generating traffic keys."));
     }
+
+    if (genInfo.m_reproducible && Platform::IsFileExistsByFullPath(datFile))
+    {
+      LOG(LINFO, ("Writing sections manifest for", datFile));
+      if (!generator::WriteSectionsManifest(datFile, datFile + SECTIONS_MANIFEST_FILE_EXTENSION))
+        LOG(LCRITICAL, ("Error writing sections manifest."));
+    }
+    return true;
+  };
+
+  // Threads which are not taken by mwms make geometry of features.
+  if (!genInfo.m_bucketNames.empty())
+    genInfo.m_threadsCount = std::max(threadsCount / genInfo.m_bucketNames.size(), size_t(1));
+
+  MemoryAwareScheduler scheduler(threadsCount, FLAGS_max_memory_mb * 1024 * 1024);
+  std::atomic<bool> bucketFailed(false);
+  for (auto const & country : genInfo.m_bucketNames)
+  {
+    scheduler.AddTask(EstimateBucketMemory(genInfo.GetTmpFileName(country),
+                                           my::JoinFoldersToPath(path, country + DATA_FILE_EXTENSION)),
+                      [&processBucket, &bucketFailed, country] {
+                        if (!processBucket(country))
+                          bucketFailed = true;
+                      });
   }
+  scheduler.Run();
+
+  if (FLAGS_save_build_profile)
+  {
+    profiler.SaveReport(generalReport,
+                        my::JoinFoldersToPath(path, generalReport + kProfileExtension));
+    for (auto const & country : genInfo.m_bucketNames)
+    {
+      profiler.SaveReport(
+          country, my::JoinFoldersToPath(path, country + DATA_FILE_EXTENSION + kProfileExtension));
+    }
+  }
+
+  if (bucketFailed)
+    return -1;
 
   std::string const datFile = my::JoinFoldersToPath(path, FLAGS_output + DATA_FILE_EXTENSION);
 
@@ -383,14 +593,25 @@ int main(int argc, char ** argv)
     stats::PrintTypeStatistic(info);
   }
 
+  std::vector<std::string> scannedFiles = {datFile};
+  if (FLAGS_scan_all_mwms)
+  {
+    Platform::FilesList files;
+    Platform::GetFilesByExt(path, DATA_FILE_EXTENSION, files);
+    std::sort(files.begin(), files.end());
+    scannedFiles.clear();
+    for (auto const & file : files)
+      scannedFiles.push_back(my::JoinFoldersToPath(path, file));
+  }
+
   if (FLAGS_dump_types)
-    feature::DumpTypes(datFile);
+    feature::DumpTypes(scannedFiles, threadsCount);
 
   if (FLAGS_dump_prefixes)
-    feature::DumpPrefixes(datFile);
+    feature::DumpPrefixes(scannedFiles, threadsCount);
 
   if (FLAGS_dump_search_tokens)
-    feature::DumpSearchTokens(datFile, 100 /* maxTokensToShow */);
+    feature::DumpSearchTokens(scannedFiles, 100 /* maxTokensToShow */, threadsCount);
 
   if (FLAGS_dump_feature_names != "")
     feature::DumpFeatureNames(datFile, FLAGS_dump_feature_names);
@@ -402,13 +623,16 @@ int main(int argc, char ** argv)
     DeleteSection(datFile, FLAGS_delete_section);
 
   if (FLAGS_generate_packed_borders)
-    borders::GeneratePackedBorders(path);
+    borders::GeneratePackedBorders(path, threadsCount);
+
+  if (FLAGS_generate_classif)
+    classificator::GenerateCache(my::JoinFoldersToPath(path, CLASSIFICATOR_CACHE_FILE));
 
   if (!FLAGS_unpack_borders.empty())
     borders::UnpackBorders(path, FLAGS_unpack_borders);
 
   if (FLAGS_check_mwm)
-    check_model::ReadFeatures(datFile);
+    check_model::ReadFeatures(scannedFiles, threadsCount);
 
   if (!FLAGS_osrm_file_name.empty() && FLAGS_make_routing)
     routing::BuildRoutingIndex(path, FLAGS_output, FLAGS_osrm_file_name);
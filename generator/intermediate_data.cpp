@@ -0,0 +1,175 @@
+#include "generator/intermediate_data.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "base/assert.hpp"
+
+#include "std/target_os.hpp"
+
+#include <atomic>
+#include <thread>
+
+#ifndef OMIM_OS_WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace cache
+{
+namespace detail
+{
+namespace
+{
+// The file grows by 1 GiB, so it's remapped only a few dozen times for the planet.
+uint64_t constexpr kGrowCount = (uint64_t(1) << 30) / sizeof(PointStorage::LatLon);
+size_t constexpr kPrefillBlockSize = 64 * 1024 * 1024;
+}  // namespace
+
+#ifndef OMIM_OS_WINDOWS
+MappedPointFile::MappedPointFile(string const & name, EMode mode) : m_name(name), m_mode(mode)
+{
+  if (m_mode == EMode::Write)
+  {
+    m_fd = open(m_name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (m_fd == -1)
+      MYTHROW(Writer::OpenException, ("open failed for file", m_name));
+    return;
+  }
+
+  m_fd = open(m_name.c_str(), O_RDONLY);
+  if (m_fd == -1)
+    MYTHROW(Reader::OpenException, ("open failed for file", m_name));
+
+  struct stat s;
+  if (fstat(m_fd, &s) == -1)
+    MYTHROW(Reader::OpenException, ("fstat failed for file", m_name));
+  CHECK_EQUAL(s.st_size % sizeof(LatLon), 0, ("Damaged file", m_name));
+
+  m_count = static_cast<uint64_t>(s.st_size) / sizeof(LatLon);
+  if (m_count == 0)
+    return;
+
+  void * data = mmap(nullptr, m_count * sizeof(LatLon), PROT_READ, MAP_SHARED, m_fd, 0);
+  if (data == MAP_FAILED)
+    MYTHROW(Reader::OpenException, ("mmap failed for file", m_name));
+  // Points of ways are spread over the whole file, readahead only wastes the page cache.
+  madvise(data, m_count * sizeof(LatLon), MADV_RANDOM);
+
+  m_data = static_cast<LatLon *>(data);
+  m_mappedCount = m_count;
+}
+
+MappedPointFile::~MappedPointFile()
+{
+  Unmap();
+  if (m_mode == EMode::Write && ftruncate(m_fd, m_count * sizeof(LatLon)) == -1)
+    LOG(LERROR, ("ftruncate failed for file", m_name));
+  close(m_fd);
+}
+
+void MappedPointFile::Grow(uint64_t id)
+{
+  ASSERT(m_mode == EMode::Write, ());
+
+  uint64_t const count = (id / kGrowCount + 1) * kGrowCount;
+  Unmap();
+
+  // The file is sparse, so the unused tail doesn't take disk space.
+  if (ftruncate(m_fd, count * sizeof(LatLon)) == -1)
+    MYTHROW(Writer::WriteException, ("ftruncate failed for file", m_name, "size", count));
+
+  void * data = mmap(nullptr, count * sizeof(LatLon), PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+  if (data == MAP_FAILED)
+    MYTHROW(Writer::WriteException, ("mmap failed for file", m_name, "size", count));
+
+  m_data = static_cast<LatLon *>(data);
+  m_mappedCount = count;
+}
+
+void MappedPointFile::Prefill()
+{
+  if (m_mode == EMode::Write || m_count == 0)
+    return;
+
+  uint64_t const size = m_count * sizeof(LatLon);
+  void * data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (data == MAP_FAILED)
+  {
+    LOG(LWARNING, ("Can't allocate", size, "bytes to prefill", m_name, "nodes are read from file"));
+    return;
+  }
+#ifdef MADV_HUGEPAGE
+  madvise(data, size, MADV_HUGEPAGE);
+#endif
+
+  LOG(LINFO, ("Nodes prefilling is started"));
+
+  // Threads read interleaved blocks, so the disk is read sequentially as a whole.
+  size_t const numThreads = max(thread::hardware_concurrency(), 1u);
+  uint64_t const numBlocks = (size + kPrefillBlockSize - 1) / kPrefillBlockSize;
+  atomic<uint64_t> nextBlock(0);
+  atomic<bool> failed(false);
+
+  vector<thread> threads;
+  threads.reserve(numThreads);
+  for (size_t i = 0; i < numThreads; ++i)
+  {
+    threads.emplace_back([&] {
+      for (uint64_t block = nextBlock++; block < numBlocks && !failed; block = nextBlock++)
+      {
+        uint64_t pos = block * kPrefillBlockSize;
+        uint64_t const end = min(size, pos + kPrefillBlockSize);
+        while (pos < end)
+        {
+          ssize_t const read = pread(m_fd, static_cast<uint8_t *>(data) + pos, end - pos, pos);
+          if (read <= 0)
+          {
+            failed = true;
+            break;
+          }
+          pos += static_cast<uint64_t>(read);
+        }
+      }
+    });
+  }
+  for (auto & t : threads)
+    t.join();
+
+  if (failed)
+  {
+    munmap(data, size);
+    MYTHROW(Reader::ReadException, ("pread failed for file", m_name));
+  }
+
+  Unmap();
+  m_data = static_cast<LatLon *>(data);
+  m_mappedCount = m_count;
+
+  LOG(LINFO, ("Nodes prefilling is finished"));
+}
+
+void MappedPointFile::Unmap()
+{
+  if (m_data)
+    munmap(m_data, m_mappedCount * sizeof(LatLon));
+  m_data = nullptr;
+  m_mappedCount = 0;
+}
+#else
+MappedPointFile::MappedPointFile(string const & name, EMode mode) : m_name(name), m_mode(mode)
+{
+  MYTHROW(RootException, ("Mapped node storage is not supported on Windows"));
+}
+
+MappedPointFile::~MappedPointFile() {}
+void MappedPointFile::Grow(uint64_t) {}
+void MappedPointFile::Prefill() {}
+void MappedPointFile::Unmap() {}
+#endif  // OMIM_OS_WINDOWS
+}  // namespace detail
+}  // namespace cache
@@ -13,7 +13,9 @@
 #include <deque>
 #include <exception>
 #include <fstream>
+#include <iterator>
 #include <limits>
+#include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -29,6 +31,33 @@ enum class EMode { Write = true, Read = false };
 
 namespace detail
 {
+/// Opens files of caches. Files in write mode are truncated or, if |append| is true,
+/// new data is written to the end of existing files.
+template <class TFile>
+struct CacheFileOpener;
+
+template <>
+struct CacheFileOpener<FileReader>
+{
+  static FileReader Open(std::string const & name, bool /* append */) { return FileReader(name); }
+};
+
+template <>
+struct CacheFileOpener<FileWriter>
+{
+  static FileWriter Open(std::string const & name, bool append)
+  {
+    if (!append)
+      return FileWriter(name);
+
+    // Pos() of a file opened with OP_APPEND is not defined before the first write,
+    // but offsets of the data are needed.
+    FileWriter writer(name, FileWriter::OP_WRITE_EXISTING);
+    writer.Seek(writer.Size());
+    return writer;
+  }
+};
+
 template <class TFile, class TValue>
 class IndexFile
 {
@@ -59,7 +88,10 @@ class IndexFile
   }
 
 public:
-  explicit IndexFile(std::string const & name) : m_file(name.c_str()) {}
+  explicit IndexFile(std::string const & name, bool append = false)
+    : m_file(CacheFileOpener<TFile>::Open(name, append))
+  {
+  }
 
   std::string GetFileName() const { return m_file.GetName(); }
 
@@ -106,12 +138,14 @@ public:
     m_elements.push_back(std::make_pair(k, v));
   }
 
+  /// If there are several values by |key| the biggest one is returned. For offsets it's
+  /// the offset of data which is written last, so updated elements override old ones.
   bool GetValueByKey(TKey key, TValue & value) const
   {
-    auto it = std::lower_bound(m_elements.begin(), m_elements.end(), key, ElementComparator());
-    if ((it != m_elements.end()) && ((*it).first == key))
+    auto it = std::upper_bound(m_elements.begin(), m_elements.end(), key, ElementComparator());
+    if ((it != m_elements.begin()) && ((*std::prev(it)).first == key))
     {
-      value = (*it).second;
+      value = (*std::prev(it)).second;
       return true;
     }
     return false;
@@ -147,9 +181,10 @@ protected:
   bool m_preload = false;
 
 public:
-  OSMElementCache(std::string const & name, bool preload = false)
-  : m_storage(name)
-  , m_offsets(name + OFFSET_EXT)
+  /// |append| is used in write mode to add elements to an existing cache.
+  OSMElementCache(std::string const & name, bool preload = false, bool append = false)
+  : m_storage(detail::CacheFileOpener<TStorage>::Open(name, append))
+  , m_offsets(name + OFFSET_EXT, append)
   , m_name(name)
   , m_preload(preload)
   {
@@ -241,6 +276,9 @@ public:
 
   inline size_t GetProcessedPoint() const { return m_processedPoint; }
   inline void IncProcessedPoint() { ++m_processedPoint; }
+
+  /// Loads all points to memory in advance if the storage reads them on demand.
+  void Preload() {}
 };
 
 template <EMode TMode>
@@ -391,7 +429,12 @@ public:
       LatLonPos ll;
       m_file.Read(pos, &ll, sizeof(ll));
 
-      m_map.emplace(std::make_pair(ll.pos, std::make_pair(ll.lat, ll.lon)));
+      // Points which are written later override old ones, zero coordinates mean
+      // a removed point (see MapFilePointStorageUpdater).
+      if (ll.lat == 0 && ll.lon == 0)
+        m_map.erase(ll.pos);
+      else
+        m_map[ll.pos] = std::make_pair(ll.lat, ll.lon);
 
       pos += sizeof(ll);
     }
@@ -426,4 +469,176 @@ public:
   }
 };
 
+namespace detail
+{
+/// Dense by id array of points which is mapped to a file. The file has the same format
+/// as the file of RawFilePointStorage. In write mode the file grows sparsely, so only
+/// pages with points take disk space, and points are written without syscalls.
+class MappedPointFile
+{
+public:
+  using LatLon = PointStorage::LatLon;
+
+  MappedPointFile(std::string const & name, EMode mode);
+  ~MappedPointFile();
+
+  /// Write mode only.
+  LatLon & GetOrCreate(uint64_t id)
+  {
+    if (id >= m_mappedCount)
+      Grow(id);
+    m_count = std::max(m_count, id + 1);
+    return m_data[id];
+  }
+
+  /// Returns nullptr if there is no point with |id|.
+  LatLon const * Get(uint64_t id) const
+  {
+    if (id >= m_count)
+      return nullptr;
+    LatLon const & ll = m_data[id];
+    // assume that valid coordinate is not (0, 0)
+    return (ll.lat != 0 || ll.lon != 0) ? &ll : nullptr;
+  }
+
+  /// Copies the file to anonymous memory on all cores. The memory is advised
+  /// to be backed by huge pages, so random reads of the ways pass don't fault and miss the TLB.
+  void Prefill();
+
+private:
+  void Grow(uint64_t id);
+  void Unmap();
+
+  std::string m_name;
+  EMode m_mode;
+  int m_fd = -1;
+  LatLon * m_data = nullptr;
+  // Number of points in the file.
+  uint64_t m_count = 0;
+  // Number of points in the mapped memory.
+  uint64_t m_mappedCount = 0;
+};
+}  // namespace detail
+
+template <EMode TMode>
+class MappedFilePointStorage : public PointStorage
+{
+  detail::MappedPointFile m_file;
+
+  constexpr static double const kValueOrder = 1E+7;
+
+public:
+  explicit MappedFilePointStorage(std::string const & name) : m_file(name, TMode) {}
+
+  template <EMode T = TMode>
+  typename enable_if<T == EMode::Write, void>::type AddPoint(uint64_t id, double lat, double lng)
+  {
+    int64_t const lat64 = lat * kValueOrder;
+    int64_t const lng64 = lng * kValueOrder;
+
+    LatLon & ll = m_file.GetOrCreate(id);
+    ll.lat = static_cast<int32_t>(lat64);
+    ll.lon = static_cast<int32_t>(lng64);
+    CHECK_EQUAL(static_cast<int64_t>(ll.lat), lat64, ("Latitude is out of 32bit boundary!"));
+    CHECK_EQUAL(static_cast<int64_t>(ll.lon), lng64, ("Longtitude is out of 32bit boundary!"));
+
+    IncProcessedPoint();
+  }
+
+  template <EMode T = TMode>
+  typename enable_if<T == EMode::Read, bool>::type GetPoint(uint64_t id, double & lat,
+                                                            double & lng) const
+  {
+    LatLon const * ll = m_file.Get(id);
+    if (ll)
+    {
+      lat = static_cast<double>(ll->lat) / kValueOrder;
+      lng = static_cast<double>(ll->lon) / kValueOrder;
+      return true;
+    }
+    LOG(LERROR, ("Node with id = ", id, " not found!"));
+    return false;
+  }
+
+  void Preload() { m_file.Prefill(); }
+};
+
+/// Updates points in the files of RawFilePointStorage, RawMemPointStorage and
+/// MappedFilePointStorage which have the same format. It's used to apply osm changes.
+class RawFilePointStorageUpdater : public PointStorage
+{
+  FileWriter m_file;
+
+  constexpr static double const kValueOrder = 1E+7;
+
+public:
+  explicit RawFilePointStorageUpdater(std::string const & name)
+    : m_file(name, FileWriter::OP_WRITE_EXISTING)
+  {
+  }
+
+  void AddPoint(uint64_t id, double lat, double lng)
+  {
+    int64_t const lat64 = lat * kValueOrder;
+    int64_t const lng64 = lng * kValueOrder;
+
+    LatLon ll;
+    ll.lat = static_cast<int32_t>(lat64);
+    ll.lon = static_cast<int32_t>(lng64);
+    CHECK_EQUAL(static_cast<int64_t>(ll.lat), lat64, ("Latitude is out of 32bit boundary!"));
+    CHECK_EQUAL(static_cast<int64_t>(ll.lon), lng64, ("Longtitude is out of 32bit boundary!"));
+
+    m_file.Seek(id * sizeof(ll));
+    m_file.Write(&ll, sizeof(ll));
+
+    IncProcessedPoint();
+  }
+
+  void RemovePoint(uint64_t id)
+  {
+    // Points with zero coordinates are treated as absent ones.
+    LatLon const ll = {0, 0};
+    if (id * sizeof(ll) >= m_file.Size())
+      return;
+
+    m_file.Seek(id * sizeof(ll));
+    m_file.Write(&ll, sizeof(ll));
+  }
+};
+
+/// Appends points to the file of MapFilePointStorage, the last point with an id is loaded.
+class MapFilePointStorageUpdater : public PointStorage
+{
+  FileWriter m_file;
+
+  constexpr static double const kValueOrder = 1E+7;
+
+public:
+  explicit MapFilePointStorageUpdater(std::string const & name)
+    : m_file(name + ".short", FileWriter::OP_APPEND)
+  {
+  }
+
+  void AddPoint(uint64_t id, double lat, double lng)
+  {
+    int64_t const lat64 = lat * kValueOrder;
+    int64_t const lng64 = lng * kValueOrder;
+
+    LatLonPos ll;
+    ll.pos = id;
+    ll.lat = static_cast<int32_t>(lat64);
+    ll.lon = static_cast<int32_t>(lng64);
+    CHECK_EQUAL(static_cast<int64_t>(ll.lat), lat64, ("Latitude is out of 32bit boundary!"));
+    CHECK_EQUAL(static_cast<int64_t>(ll.lon), lng64, ("Longtitude is out of 32bit boundary!"));
+    m_file.Write(&ll, sizeof(ll));
+
+    IncProcessedPoint();
+  }
+
+  void RemovePoint(uint64_t id)
+  {
+    LatLonPos const ll = {id, 0, 0};
+    m_file.Write(&ll, sizeof(ll));
+  }
+};
 }  // namespace cache
@@ -0,0 +1,98 @@
+#include "generator/memory_aware_scheduler.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+
+namespace generator
+{
+MemoryAwareScheduler::MemoryAwareScheduler(size_t numThreads, uint64_t maxMemory)
+  : m_numThreads(numThreads), m_maxMemory(maxMemory)
+{
+  CHECK_GREATER(m_numThreads, 0, ());
+}
+
+void MemoryAwareScheduler::AddTask(uint64_t memory, Task const & task)
+{
+  m_tasks.emplace_back(memory, task);
+}
+
+void MemoryAwareScheduler::Run()
+{
+  stable_sort(m_tasks.begin(), m_tasks.end(),
+              [](pair<uint64_t, Task> const & lhs, pair<uint64_t, Task> const & rhs) {
+                return lhs.first > rhs.first;
+              });
+
+  mutex mu;
+  condition_variable cv;
+  // Tasks which have not started yet, in the order of |m_tasks|.
+  vector<size_t> pending(m_tasks.size());
+  for (size_t i = 0; i < pending.size(); ++i)
+    pending[i] = i;
+  uint64_t usedMemory = 0;
+  size_t numRunning = 0;
+  exception_ptr error;
+
+  auto const fits = [&](size_t i) {
+    return numRunning == 0 || m_maxMemory == 0 || usedMemory + m_tasks[i].first <= m_maxMemory;
+  };
+
+  auto const worker = [&] {
+    unique_lock<mutex> lock(mu);
+    while (true)
+    {
+      auto it = pending.end();
+      cv.wait(lock, [&] {
+        if (pending.empty() || error)
+          return true;
+        it = find_if(pending.begin(), pending.end(), fits);
+        return it != pending.end();
+      });
+      if (pending.empty() || error)
+        return;
+
+      size_t const i = *it;
+      pending.erase(it);
+      usedMemory += m_tasks[i].first;
+      ++numRunning;
+
+      lock.unlock();
+      try
+      {
+        m_tasks[i].second();
+      }
+      catch (...)
+      {
+        lock.lock();
+        if (!error)
+          error = current_exception();
+        lock.unlock();
+      }
+      lock.lock();
+
+      usedMemory -= m_tasks[i].first;
+      --numRunning;
+      cv.notify_all();
+    }
+  };
+
+  vector<thread> threads;
+  size_t const numThreads = min(m_numThreads, m_tasks.size());
+  threads.reserve(numThreads);
+  for (size_t i = 0; i < numThreads; ++i)
+    threads.emplace_back(worker);
+  for (auto & t : threads)
+    t.join();
+
+  m_tasks.clear();
+  if (error)
+    rethrow_exception(error);
+}
+}  // namespace generator
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace generator
+{
+// Runs tasks on several threads so that the sum of memory estimations of running tasks
+// doesn't exceed the budget. A task which doesn't fit the budget alone runs when no other
+// task runs. Tasks with bigger estimations start first: they usually take longer, so the
+// tasks which run last are short ones and threads don't idle at the end.
+class MemoryAwareScheduler
+{
+public:
+  using Task = std::function<void()>;
+
+  // |maxMemory| == 0 means that memory is unlimited.
+  MemoryAwareScheduler(size_t numThreads, uint64_t maxMemory);
+
+  void AddTask(uint64_t memory, Task const & task);
+
+  // Runs all added tasks and waits for them. If tasks throw, tasks which have not started yet
+  // are skipped and the first exception is rethrown.
+  void Run();
+
+private:
+  size_t const m_numThreads;
+  uint64_t const m_maxMemory;
+  std::vector<std::pair<uint64_t, Task>> m_tasks;
+};
+}  // namespace generator
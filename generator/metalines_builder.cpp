@@ -1,4 +1,5 @@
 #include "generator/metalines_builder.hpp"
+#include "generator/parallel_utils.hpp"
 #include "generator/routing_helpers.hpp"
 
 #include "indexer/classificator.hpp"
@@ -7,17 +8,20 @@
 #include "coding/varint.hpp"
 #include "coding/write_to_sink.hpp"
 
+#include "base/bits.hpp"
 #include "base/checked_cast.hpp"
 #include "base/logging.hpp"
 #include "base/string_utils.hpp"
 
 #include "defines.hpp"
 
+#include <algorithm>
 #include <cstdint>
+#include <unordered_set>
 
 namespace
 {
-uint8_t const kMetaLinesSectionVersion = 1;
+uint8_t const kMetaLinesSectionVersion = 2;
 
 using Ways = std::vector<int32_t>;
 
@@ -87,16 +91,42 @@ public:
 namespace feature
 {
 /// A list of segments, that is, LineStrings, sharing the same attributes.
+/// Ways are only collected while features are translated, they are merged in Merge().
 class Segments
 {
+  std::vector<LineString> m_lines;
   std::list<LineString> m_parts;
 
 public:
-  explicit Segments(OsmElement const & way) { m_parts.emplace_back(way); }
+  explicit Segments(OsmElement const & way) { m_lines.emplace_back(way); }
 
-  void Add(OsmElement const & way)
+  void Add(OsmElement const & way) { m_lines.emplace_back(way); }
+
+  /// Merges collected ways in the order they were added.
+  void Merge()
+  {
+    for (LineString & line : m_lines)
+      Merge(line);
+    m_lines.clear();
+    m_lines.shrink_to_fit();
+  }
+
+  std::vector<Ways> GetLongWays() const
+  {
+    std::vector<Ways> result;
+    for (LineString const & line : m_parts)
+    {
+      if (line.GetWays().size() > 1)
+      {
+        result.push_back(line.GetWays());
+      }
+    }
+    return result;
+  }
+
+private:
+  void Merge(LineString & line)
   {
-    LineString line(way);
     auto found = m_parts.end();
     for (auto i = m_parts.begin(); i != m_parts.end(); ++i)
     {
@@ -122,19 +152,6 @@ public:
       }
     }
   }
-
-  std::vector<Ways> GetLongWays() const
-  {
-    std::vector<Ways> result;
-    for (LineString const & line : m_parts)
-    {
-      if (line.GetWays().size() > 1)
-      {
-        result.push_back(line.GetWays());
-      }
-    }
-    return result;
-  }
 };
 
 // MetalinesBuilder --------------------------------------------------------------------------------
@@ -162,6 +179,14 @@ void MetalinesBuilder::operator()(OsmElement const & el, FeatureParams const & p
 
 void MetalinesBuilder::Flush()
 {
+  // Segments with different keys are independent, so they are merged in parallel.
+  std::vector<Segments *> segments;
+  segments.reserve(m_data.size());
+  for (auto const & seg : m_data)
+    segments.push_back(seg.second.get());
+  generator::ForEachIndexInParallel(m_threadsCount, segments.size(),
+                                    [&segments](size_t i) { segments[i]->Merge(); });
+
   try
   {
     uint32_t count = 0;
@@ -196,9 +221,8 @@ bool WriteMetalinesSection(std::string const & mwmPath, std::string const & meta
 
   FileReader reader(metalinesPath);
   ReaderSource<FileReader> src(reader);
-  std::vector<uint8_t> buffer;
-  MemWriter<std::vector<uint8_t>> memWriter(buffer);
-  uint32_t count = 0;
+  std::vector<std::vector<int32_t>> metalines;
+  std::unordered_set<uint32_t> usedFeatures;
 
   while (src.Size() > 0)
   {
@@ -218,15 +242,46 @@ bool WriteMetalinesSection(std::string const & mwmPath, std::string const & meta
       featureIds.push_back(wayId > 0 ? featureId : -featureId);
     }
 
-    if (featureIds.size() > 1)
+    // Keep a metaline if we have got at least two segments. A feature can't belong
+    // to several metalines, the first metaline wins.
+    if (featureIds.size() < 2)
+      continue;
+    bool const hasUsedFeature =
+        std::any_of(featureIds.begin(), featureIds.end(), [&usedFeatures](int32_t fid) {
+          return usedFeatures.count(static_cast<uint32_t>(std::abs(fid))) != 0;
+        });
+    if (hasUsedFeature)
+      continue;
+    for (auto const fid : featureIds)
+      usedFeatures.insert(static_cast<uint32_t>(std::abs(fid)));
+    metalines.push_back(std::move(featureIds));
+  }
+
+  // Metalines are sorted by their first feature, so the first feature is coded as a delta
+  // to the first feature of the previous metaline and other features are coded as deltas
+  // to the previous feature of the same metaline. The lowest bit is the feature direction.
+  std::sort(metalines.begin(), metalines.end(),
+            [](std::vector<int32_t> const & lhs, std::vector<int32_t> const & rhs) {
+              return std::abs(lhs.front()) < std::abs(rhs.front());
+            });
+
+  std::vector<uint8_t> buffer;
+  MemWriter<std::vector<uint8_t>> memWriter(buffer);
+  int64_t prevFirst = 0;
+  for (auto const & featureIds : metalines)
+  {
+    WriteVarUint(memWriter, featureIds.size());
+    int64_t prev = prevFirst;
+    for (auto const fid : featureIds)
     {
-      // Write vector to buffer if we have got at least two segments.
-      WriteVarUint(memWriter, featureIds.size());
-      for (auto const & fid : featureIds)
-        WriteVarInt(memWriter, fid);
-      ++count;
+      int64_t const id = std::abs(static_cast<int64_t>(fid));
+      uint64_t const delta = bits::ZigZagEncode(id - prev);
+      WriteVarUint(memWriter, (delta << 1) | (fid > 0 ? 1 : 0));
+      prev = id;
     }
+    prevFirst = std::abs(static_cast<int64_t>(featureIds.front()));
   }
+  uint32_t const count = base::checked_cast<uint32_t>(metalines.size());
 
   // Write buffer to section.
   FilesContainerW cont(mwmPath, FileWriter::OP_WRITE_EXISTING);
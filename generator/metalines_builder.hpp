@@ -16,19 +16,24 @@ class Segments;
 class MetalinesBuilder
 {
 public:
-  explicit MetalinesBuilder(std::string const & filePath) : m_filePath(filePath) {}
+  /// Segments of different metalines are merged on |threadsCount| threads in Flush().
+  explicit MetalinesBuilder(std::string const & filePath, size_t threadsCount = 1)
+    : m_filePath(filePath), m_threadsCount(threadsCount)
+  {
+  }
 
   ~MetalinesBuilder() { Flush(); }
 
   /// Add a highway segment to the collection of metalines.
   void operator()(OsmElement const & el, FeatureParams const & params);
 
-  /// Write all metalines to the intermediate file.
+  /// Merge segments and write all metalines to the intermediate file.
   void Flush();
 
 private:
   std::unordered_map<size_t, std::shared_ptr<Segments>> m_data;
   std::string m_filePath;
+  size_t m_threadsCount;
 };
 
 /// Read an intermediate file from MetalinesBuilder and convert it to an mwm section.
@@ -1,16 +1,28 @@
 #include "generator/mwm_diff/diff.hpp"
 
+#include "generator/parallel_utils.hpp"
+
+#include "coding/endianness.hpp"
+#include "coding/file_container.hpp"
 #include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
 #include "coding/reader.hpp"
+#include "coding/varint.hpp"
 #include "coding/write_to_sink.hpp"
 #include "coding/writer.hpp"
 #include "coding/zlib.hpp"
 
+#include "base/checked_cast.hpp"
 #include "base/logging.hpp"
+#include "base/rolling_hash.hpp"
+#include "base/stl_add.hpp"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <iterator>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "3party/bsdiff-courgette/bsdiff/bsdiff.h"
@@ -23,7 +35,9 @@ enum Version
 {
   // Format Version 0: bsdiff+gzip.
   VERSION_V0 = 0,
-  VERSION_LATEST = VERSION_V0
+  // Format Version 1: content-defined chunks of sections, see MakeDiffVersion1().
+  VERSION_V1 = 1,
+  VERSION_LATEST = VERSION_V1
 };
 
 bool MakeDiffVersion0(FileReader & oldReader, FileReader & newReader, FileWriter & diffFileWriter)
@@ -53,16 +67,16 @@ bool MakeDiffVersion0(FileReader & oldReader, FileReader & newReader, FileWriter
 }
 
 bool ApplyDiffVersion0(FileReader & oldReader, FileWriter & newWriter,
-                       ReaderSource<FileReader> & diffFileSource)
+                       vector<uint8_t> const & deflatedDiff)
 {
-  vector<uint8_t> deflatedDiff(diffFileSource.Size());
-  diffFileSource.Read(deflatedDiff.data(), deflatedDiff.size());
-
   using Inflate = coding::ZLib::Inflate;
-  vector<uint8_t> decompressedData;
   Inflate inflate(Inflate::Format::ZLib);
   vector<uint8_t> diffBuf;
-  inflate(deflatedDiff.data(), deflatedDiff.size(), back_inserter(diffBuf));
+  if (!inflate(deflatedDiff.data(), deflatedDiff.size(), back_inserter(diffBuf)))
+  {
+    LOG(LERROR, ("Could not inflate mwm diff."));
+    return false;
+  }
 
   MemReader diffMemReader(diffBuf.data(), diffBuf.size());
 
@@ -76,6 +90,388 @@ bool ApplyDiffVersion0(FileReader & oldReader, FileWriter & newWriter,
 
   return true;
 }
+
+// Chunks are cut where the rolling hash of the last kWindowSize bytes has kChunkBits high zero
+// bits, so cuts depend on the content only and unchanged data of both mwms is cut in the same way.
+size_t constexpr kWindowSize = 48;
+uint32_t constexpr kChunkBits = 12;
+uint64_t constexpr kMinChunkSize = 512;
+uint64_t constexpr kMaxChunkSize = 64 * 1024;
+// Operations are packed into blocks which are deflated separately, so a diff is applied
+// with memory proportional to the block size.
+size_t constexpr kMaxBlockSize = 1024 * 1024;
+size_t constexpr kCopyBufferSize = 64 * 1024;
+
+enum Operation : uint8_t
+{
+  // [vu offset in the old mwm] [vu size]
+  OPERATION_COPY = 0,
+  // [vu size] [bytes]
+  OPERATION_INSERT = 1
+};
+
+struct Range
+{
+  uint64_t m_begin;
+  uint64_t m_end;
+};
+
+struct Chunk
+{
+  uint64_t m_hash;
+  uint64_t m_offset;
+  uint64_t m_size;
+};
+
+struct DiffOperation
+{
+  Operation m_operation;
+  // Offset in the old mwm for copy, offset in the new mwm for insert.
+  uint64_t m_offset;
+  uint64_t m_size;
+};
+
+vector<uint8_t> ReadFile(FileReader const & reader)
+{
+  vector<uint8_t> data(static_cast<size_t>(reader.Size()));
+  if (!data.empty())
+    reader.Read(0 /* pos */, data.data(), data.size());
+  return data;
+}
+
+// Splits the file into sections of the container and gaps between them. Sections are diffed
+// independently. A file which is not a container is one range.
+vector<Range> GetRanges(string const & path, vector<uint8_t> const & data)
+{
+  uint64_t const fileSize = data.size();
+  vector<Range> sections;
+  try
+  {
+    uint64_t infoOffset = 0;
+    if (fileSize >= sizeof(infoOffset))
+      memcpy(&infoOffset, data.data(), sizeof(infoOffset));
+    infoOffset = SwapIfBigEndian(infoOffset);
+    if (infoOffset < sizeof(infoOffset) || infoOffset >= fileSize)
+      MYTHROW(Reader::Exception, ("Not a container:", path));
+
+    FilesContainerR const container(path);
+    container.ForEachTag([&](FilesContainerR::Tag const & tag) {
+      auto const offsetAndSize = container.GetAbsoluteOffsetAndSize(tag);
+      if (offsetAndSize.second != 0)
+        sections.push_back({offsetAndSize.first, offsetAndSize.first + offsetAndSize.second});
+    });
+  }
+  catch (Reader::Exception const &)
+  {
+    sections.clear();
+  }
+
+  sort(sections.begin(), sections.end(),
+       [](Range const & lhs, Range const & rhs) { return lhs.m_begin < rhs.m_begin; });
+
+  vector<Range> ranges;
+  uint64_t pos = 0;
+  for (auto const & section : sections)
+  {
+    if (section.m_begin < pos || section.m_end > fileSize)
+      continue;
+    if (section.m_begin > pos)
+      ranges.push_back({pos, section.m_begin});
+    ranges.push_back(section);
+    pos = section.m_end;
+  }
+  if (pos < fileSize)
+    ranges.push_back({pos, fileSize});
+  return ranges;
+}
+
+// FNV-1a.
+uint64_t GetChunkHash(uint8_t const * data, uint64_t size)
+{
+  uint64_t hash = 14695981039346656037ULL;
+  for (uint64_t i = 0; i < size; ++i)
+  {
+    hash ^= data[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+vector<Chunk> GetChunks(vector<uint8_t> const & data, Range const & range)
+{
+  static_assert(kMinChunkSize >= kWindowSize, "");
+
+  vector<Chunk> chunks;
+  uint64_t begin = range.m_begin;
+  while (begin < range.m_end)
+  {
+    uint64_t const limit = min(range.m_end, begin + kMaxChunkSize);
+    uint64_t end = limit;
+    if (begin + kMinChunkSize < limit)
+    {
+      RollingHasher64 hasher;
+      uint64_t pos = begin + kMinChunkSize;
+      auto hash = hasher.Init(data.data() + pos - kWindowSize, kWindowSize);
+      while ((hash >> (64 - kChunkBits)) != 0 && pos < limit)
+      {
+        hash = hasher.Scroll(data[pos - kWindowSize], data[pos]);
+        ++pos;
+      }
+      end = pos;
+    }
+
+    chunks.push_back({GetChunkHash(data.data() + begin, end - begin), begin, end - begin});
+    begin = end;
+  }
+  return chunks;
+}
+
+void AddOperation(Operation operation, uint64_t offset, uint64_t size,
+                  vector<DiffOperation> & operations)
+{
+  if (size == 0)
+    return;
+
+  if (!operations.empty())
+  {
+    auto & last = operations.back();
+    if (last.m_operation == operation && last.m_offset + last.m_size == offset)
+    {
+      last.m_size += size;
+      return;
+    }
+  }
+  operations.push_back({operation, offset, size});
+}
+
+class ChunksIndex
+{
+public:
+  ChunksIndex(vector<uint8_t> const & data, vector<vector<Chunk>> const & chunks) : m_data(data)
+  {
+    // The first chunk with the hash wins, so the index doesn't depend on threads.
+    for (auto const & rangeChunks : chunks)
+    {
+      for (auto const & chunk : rangeChunks)
+        m_chunks.emplace(chunk.m_hash, chunk);
+    }
+  }
+
+  // Returns true and the offset of the same chunk in the indexed data if it exists.
+  bool Find(uint8_t const * data, Chunk const & chunk, uint64_t & offset) const
+  {
+    auto const it = m_chunks.find(chunk.m_hash);
+    if (it == m_chunks.end() || it->second.m_size != chunk.m_size ||
+        memcmp(m_data.data() + it->second.m_offset, data, chunk.m_size) != 0)
+    {
+      return false;
+    }
+    offset = it->second.m_offset;
+    return true;
+  }
+
+private:
+  vector<uint8_t> const & m_data;
+  unordered_map<uint64_t, Chunk> m_chunks;
+};
+
+vector<DiffOperation> DiffRange(vector<uint8_t> const & oldData, vector<uint8_t> const & newData,
+                                ChunksIndex const & index, Range const & range)
+{
+  vector<DiffOperation> operations;
+  for (auto const & chunk : GetChunks(newData, range))
+  {
+    uint8_t const * data = newData.data() + chunk.m_offset;
+
+    uint64_t oldOffset;
+    if (index.Find(data, chunk, oldOffset))
+    {
+      AddOperation(OPERATION_COPY, oldOffset, chunk.m_size, operations);
+      continue;
+    }
+
+    // A changed chunk usually starts with the data which follows the previous copied chunk.
+    uint64_t common = 0;
+    if (!operations.empty() && operations.back().m_operation == OPERATION_COPY)
+    {
+      uint64_t const oldBegin = operations.back().m_offset + operations.back().m_size;
+      uint64_t const maxCommon = min(chunk.m_size, oldData.size() - oldBegin);
+      while (common < maxCommon && oldData[oldBegin + common] == data[common])
+        ++common;
+      AddOperation(OPERATION_COPY, oldBegin, common, operations);
+    }
+    AddOperation(OPERATION_INSERT, chunk.m_offset + common, chunk.m_size - common, operations);
+  }
+  return operations;
+}
+
+// Packs |operations| into blocks of at most about kMaxBlockSize bytes.
+vector<vector<uint8_t>> MakeBlocks(vector<uint8_t> const & newData,
+                                   vector<DiffOperation> const & operations)
+{
+  vector<vector<uint8_t>> blocks(1);
+  auto const getBlock = [&blocks]() -> vector<uint8_t> & {
+    if (blocks.back().size() >= kMaxBlockSize)
+      blocks.emplace_back();
+    return blocks.back();
+  };
+
+  for (auto const & op : operations)
+  {
+    if (op.m_operation == OPERATION_COPY)
+    {
+      auto & block = getBlock();
+      MemWriter<vector<uint8_t>> writer(block);
+      writer.Seek(block.size());
+      WriteToSink(writer, static_cast<uint8_t>(OPERATION_COPY));
+      WriteVarUint(writer, op.m_offset);
+      WriteVarUint(writer, op.m_size);
+      continue;
+    }
+
+    uint64_t offset = op.m_offset;
+    uint64_t const end = op.m_offset + op.m_size;
+    while (offset < end)
+    {
+      auto & block = getBlock();
+      uint64_t const size = min(end - offset, static_cast<uint64_t>(kMaxBlockSize - block.size()));
+      MemWriter<vector<uint8_t>> writer(block);
+      writer.Seek(block.size());
+      WriteToSink(writer, static_cast<uint8_t>(OPERATION_INSERT));
+      WriteVarUint(writer, size);
+      writer.Write(newData.data() + offset, size);
+      offset += size;
+    }
+  }
+
+  if (blocks.back().empty())
+    blocks.pop_back();
+  return blocks;
+}
+
+// Format:
+// [uint32 version] [uint64 old mwm size] [uint64 new mwm size]
+// [uint32 size of deflated block] [deflated block] ...
+// Every block is a sequence of operations, the new mwm is a concatenation of their results.
+bool MakeDiffVersion1(FileReader & oldReader, FileReader & newReader, string const & oldMwmPath,
+                      string const & newMwmPath, FileWriter & diffFileWriter)
+{
+  size_t const threadsCount = max(thread::hardware_concurrency(), 1u);
+
+  auto const oldData = ReadFile(oldReader);
+  auto const newData = ReadFile(newReader);
+  auto const oldRanges = GetRanges(oldMwmPath, oldData);
+  auto const newRanges = GetRanges(newMwmPath, newData);
+
+  vector<vector<Chunk>> oldChunks(oldRanges.size());
+  generator::ForEachIndexInParallel(threadsCount, oldRanges.size(), [&](size_t i) {
+    oldChunks[i] = GetChunks(oldData, oldRanges[i]);
+  });
+  ChunksIndex const index(oldData, oldChunks);
+  oldChunks.clear();
+
+  vector<vector<DiffOperation>> rangeOperations(newRanges.size());
+  generator::ForEachIndexInParallel(threadsCount, newRanges.size(), [&](size_t i) {
+    rangeOperations[i] = DiffRange(oldData, newData, index, newRanges[i]);
+  });
+
+  vector<DiffOperation> operations;
+  for (auto const & ops : rangeOperations)
+  {
+    for (auto const & op : ops)
+      AddOperation(op.m_operation, op.m_offset, op.m_size, operations);
+  }
+  rangeOperations.clear();
+
+  auto blocks = MakeBlocks(newData, operations);
+
+  using Deflate = coding::ZLib::Deflate;
+  Deflate const deflate(Deflate::Format::ZLib, Deflate::Level::BestCompression);
+  vector<vector<uint8_t>> deflatedBlocks(blocks.size());
+  bool deflated = true;
+  generator::ForEachIndexInParallel(threadsCount, blocks.size(), [&](size_t i) {
+    if (!deflate(blocks[i].data(), blocks[i].size(), back_inserter(deflatedBlocks[i])))
+      deflated = false;
+    vector<uint8_t>().swap(blocks[i]);
+  });
+  if (!deflated)
+  {
+    LOG(LERROR, ("Could not deflate mwm diff block."));
+    return false;
+  }
+
+  WriteToSink(diffFileWriter, static_cast<uint32_t>(VERSION_V1));
+  WriteToSink(diffFileWriter, static_cast<uint64_t>(oldData.size()));
+  WriteToSink(diffFileWriter, static_cast<uint64_t>(newData.size()));
+  for (auto const & block : deflatedBlocks)
+  {
+    WriteToSink(diffFileWriter, base::checked_cast<uint32_t>(block.size()));
+    diffFileWriter.Write(block.data(), block.size());
+  }
+
+  LOG(LINFO, ("Mwm diff: operations", operations.size(), "blocks", deflatedBlocks.size()));
+  return true;
+}
+
+// Inflates the block to |block| and appends results of its operations to |newWriter|.
+// zlib checks the block with its checksum, so a corrupted block is detected before it is applied.
+bool ApplyBlockVersion1(FileReader & oldReader, uint8_t const * deflatedBlock, size_t size,
+                        vector<uint8_t> & block, vector<uint8_t> & buffer, FileWriter & newWriter)
+{
+  using Inflate = coding::ZLib::Inflate;
+  Inflate const inflate(Inflate::Format::ZLib);
+
+  block.clear();
+  if (!inflate(deflatedBlock, size, back_inserter(block)))
+  {
+    LOG(LERROR, ("Could not inflate mwm diff block."));
+    return false;
+  }
+
+  uint64_t const oldSize = oldReader.Size();
+  buffer.resize(kCopyBufferSize);
+  MemReader blockReader(block.data(), block.size());
+  ReaderSource<MemReader> src(blockReader);
+  while (src.Size() > 0)
+  {
+    auto const operation = ReadPrimitiveFromSource<uint8_t>(src);
+    switch (operation)
+    {
+    case OPERATION_COPY:
+    {
+      uint64_t offset = ReadVarUint<uint64_t>(src);
+      uint64_t const end = offset + ReadVarUint<uint64_t>(src);
+      if (end > oldSize || end < offset)
+      {
+        LOG(LERROR, ("Wrong copy operation in mwm diff:", offset, end, oldSize));
+        return false;
+      }
+      while (offset < end)
+      {
+        size_t const size = static_cast<size_t>(min(end - offset, uint64_t(buffer.size())));
+        oldReader.Read(offset, buffer.data(), size);
+        newWriter.Write(buffer.data(), size);
+        offset += size;
+      }
+      break;
+    }
+    case OPERATION_INSERT:
+    {
+      auto const size = ReadVarUint<uint64_t>(src);
+      if (size > src.Size())
+      {
+        LOG(LERROR, ("Wrong insert operation in mwm diff:", size, src.Size()));
+        return false;
+      }
+      newWriter.Write(block.data() + src.Pos(), size);
+      src.Skip(size);
+      break;
+    }
+    default: LOG(LERROR, ("Unknown operation in mwm diff:", operation)); return false;
+    }
+  }
+  return true;
+}
 }  // namespace
 
 namespace generator
@@ -93,6 +489,8 @@ bool MakeDiff(string const & oldMwmPath, string const & newMwmPath, string const
     switch (VERSION_LATEST)
     {
     case VERSION_V0: return MakeDiffVersion0(oldReader, newReader, diffFileWriter);
+    case VERSION_V1:
+      return MakeDiffVersion1(oldReader, newReader, oldMwmPath, newMwmPath, diffFileWriter);
     default:
       LOG(LERROR,
           ("Making mwm diffs with diff format version", VERSION_LATEST, "is not implemented"));
@@ -116,18 +514,19 @@ bool ApplyDiff(string const & oldMwmPath, string const & newMwmPath, string cons
 {
   try
   {
-    FileReader oldReader(oldMwmPath);
-    FileWriter newWriter(newMwmPath);
+    DiffApplier applier(oldMwmPath, newMwmPath);
     FileReader diffFileReader(diffPath);
 
-    ReaderSource<FileReader> diffFileSource(diffFileReader);
-    auto const version = ReadPrimitiveFromSource<uint32_t>(diffFileSource);
-
-    switch (version)
+    vector<uint8_t> buffer(kCopyBufferSize);
+    uint64_t const diffSize = diffFileReader.Size();
+    for (uint64_t pos = 0; pos < diffSize; pos += buffer.size())
     {
-    case VERSION_V0: return ApplyDiffVersion0(oldReader, newWriter, diffFileSource);
-    default: LOG(LERROR, ("Unknown version format of mwm diff:", version));
+      size_t const size = static_cast<size_t>(min(diffSize - pos, uint64_t(buffer.size())));
+      diffFileReader.Read(pos, buffer.data(), size);
+      if (!applier.Feed(buffer.data(), size))
+        return false;
     }
+    return applier.Finish();
   }
   catch (Reader::Exception const & e)
   {
@@ -139,8 +538,156 @@ bool ApplyDiff(string const & oldMwmPath, string const & newMwmPath, string cons
     LOG(LERROR, ("Could not open file when applying a patch:", e.Msg()));
     return false;
   }
+}
+
+// DiffApplier -------------------------------------------------------------------------------------
+DiffApplier::DiffApplier(string const & oldMwmPath, string const & newMwmPath)
+  : m_oldReader(my::make_unique<FileReader>(oldMwmPath))
+  , m_newWriter(my::make_unique<FileWriter>(newMwmPath))
+{
+}
 
+bool DiffApplier::Feed(void const * data, size_t size)
+{
+  if (m_state == State::Failed)
+    return false;
+
+  // Drops processed bytes when they take most of the buffer.
+  if (m_pos != 0 && m_pos >= m_buffer.size() / 2)
+  {
+    m_buffer.erase(m_buffer.begin(), m_buffer.begin() + m_pos);
+    m_pos = 0;
+  }
+  auto const * bytes = static_cast<uint8_t const *>(data);
+  m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+
+  try
+  {
+    if (Process())
+      return true;
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LERROR, ("Could not read the old mwm when applying a patch:", e.Msg()));
+  }
+  catch (Writer::Exception const & e)
+  {
+    LOG(LERROR, ("Could not write the new mwm when applying a patch:", e.Msg()));
+  }
+  m_state = State::Failed;
   return false;
 }
+
+bool DiffApplier::Finish()
+{
+  if (m_state == State::Failed)
+    return false;
+
+  bool result = false;
+  try
+  {
+    switch (m_state)
+    {
+    case State::BufferAll:
+    {
+      vector<uint8_t> const deflatedDiff(m_buffer.begin() + m_pos, m_buffer.end());
+      result = ApplyDiffVersion0(*m_oldReader, *m_newWriter, deflatedDiff);
+      break;
+    }
+    case State::BlockSize:
+      result = m_pos == m_buffer.size() && m_newWriter->Pos() == m_newSize;
+      if (!result)
+        LOG(LERROR, ("Wrong size of the new mwm:", m_newWriter->Pos(), "expected:", m_newSize));
+      break;
+    default: LOG(LERROR, ("Mwm diff is truncated.")); break;
+    }
+
+    // Closes the new mwm, so it may be renamed.
+    m_newWriter.reset();
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LERROR, ("Could not read the old mwm when applying a patch:", e.Msg()));
+    result = false;
+  }
+  catch (Writer::Exception const & e)
+  {
+    LOG(LERROR, ("Could not write the new mwm when applying a patch:", e.Msg()));
+    result = false;
+  }
+
+  m_state = State::Failed;
+  return result;
+}
+
+uint64_t DiffApplier::GetWrittenSize() const { return m_newWriter ? m_newWriter->Pos() : 0; }
+
+bool DiffApplier::Process()
+{
+  while (true)
+  {
+    MemReader reader(m_buffer.data() + m_pos, m_buffer.size() - m_pos);
+    ReaderSource<MemReader> src(reader);
+    switch (m_state)
+    {
+    case State::Version:
+      if (src.Size() < sizeof(uint32_t))
+        return true;
+      m_version = ReadPrimitiveFromSource<uint32_t>(src);
+      switch (m_version)
+      {
+      case VERSION_V0: m_state = State::BufferAll; break;
+      case VERSION_V1: m_state = State::Header; break;
+      default: LOG(LERROR, ("Unknown version format of mwm diff:", m_version)); return false;
+      }
+      break;
+
+    case State::Header:
+    {
+      if (src.Size() < 2 * sizeof(uint64_t))
+        return true;
+      auto const oldSize = ReadPrimitiveFromSource<uint64_t>(src);
+      m_newSize = ReadPrimitiveFromSource<uint64_t>(src);
+      if (oldSize != m_oldReader->Size())
+      {
+        LOG(LERROR, ("The diff is made for an mwm of size", oldSize, "not", m_oldReader->Size()));
+        return false;
+      }
+      m_state = State::BlockSize;
+      break;
+    }
+
+    case State::BlockSize:
+      if (src.Size() < sizeof(uint32_t))
+        return true;
+      m_blockSize = ReadPrimitiveFromSource<uint32_t>(src);
+      m_state = State::Block;
+      break;
+
+    case State::Block:
+    {
+      if (src.Size() < m_blockSize)
+        return true;
+      if (!ApplyBlockVersion1(*m_oldReader, m_buffer.data() + m_pos, m_blockSize, m_block,
+                              m_copyBuffer, *m_newWriter))
+      {
+        return false;
+      }
+      src.Skip(m_blockSize);
+      if (m_newWriter->Pos() > m_newSize)
+      {
+        LOG(LERROR, ("The new mwm is larger than expected:", m_newSize));
+        return false;
+      }
+      m_state = State::BlockSize;
+      break;
+    }
+
+    case State::BufferAll: return true;
+    case State::Failed: return false;
+    }
+    m_pos += static_cast<size_t>(src.Pos());
+  }
+}
 }  // namespace mwm_diff
 }  // namespace generator
@@ -1,6 +1,13 @@
 #pragma once
 
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace generator
 {
@@ -20,5 +27,55 @@ bool MakeDiff(std::string const & oldMwmPath, std::string const & newMwmPath,
 // Returns true on success and false on failure.
 bool ApplyDiff(std::string const & oldMwmPath, std::string const & newMwmPath,
                std::string const & diffPath);
+
+// Applies a diff which comes in pieces, e.g. while it is downloaded, so the diff doesn't need
+// to be stored. The new mwm is written sequentially, every block of the diff is checked and
+// applied as soon as it is complete, so memory is bounded by the size of a block.
+// Diffs of format version 0 can't be applied partially and are buffered until Finish().
+//
+// *NOTE* The new mwm is incomplete until Finish() returns true.
+class DiffApplier
+{
+public:
+  // Throws Reader::Exception or Writer::Exception if the files can't be opened.
+  DiffApplier(std::string const & oldMwmPath, std::string const & newMwmPath);
+
+  // Consumes the next |size| bytes of the diff. Returns false if the diff is broken or the new
+  // mwm can't be written, the applier can't be used after that.
+  bool Feed(void const * data, size_t size);
+
+  // Returns true if the whole diff is consumed and the new mwm is complete and closed.
+  bool Finish();
+
+  // Number of bytes of the new mwm which are written so far.
+  uint64_t GetWrittenSize() const;
+
+private:
+  enum class State
+  {
+    Version,
+    Header,
+    BlockSize,
+    Block,
+    BufferAll,
+    Failed
+  };
+
+  bool Process();
+
+  std::unique_ptr<FileReader> m_oldReader;
+  std::unique_ptr<FileWriter> m_newWriter;
+
+  State m_state = State::Version;
+  uint32_t m_version = 0;
+  uint64_t m_newSize = 0;
+  uint32_t m_blockSize = 0;
+
+  // Unprocessed bytes of the diff start at |m_pos|.
+  std::vector<uint8_t> m_buffer;
+  size_t m_pos = 0;
+  std::vector<uint8_t> m_block;
+  std::vector<uint8_t> m_copyBuffer;
+};
 }  // namespace mwm_diff
 }  // namespace generator
@@ -4,12 +4,20 @@
 
 #include "platform/platform.hpp"
 
+#include "coding/file_container.hpp"
 #include "coding/file_name_utils.hpp"
+#include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
 #include "coding/internal/file_data.hpp"
 
+#include "base/logging.hpp"
 #include "base/scope_guard.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
 using namespace std;
 
 namespace generator
@@ -41,5 +49,123 @@ UNIT_TEST(IncrementalUpdates_Smoke)
 
   TEST(my::IsEqualFiles(newMwmPath1, newMwmPath2), ());
 }
+
+UNIT_TEST(IncrementalUpdates_ModifiedSections)
+{
+  string const oldMwmPath = my::JoinFoldersToPath(GetPlatform().WritableDir(), "diff-old.mwm");
+  string const newMwmPath1 = my::JoinFoldersToPath(GetPlatform().WritableDir(), "diff-new1.mwm");
+  string const newMwmPath2 = my::JoinFoldersToPath(GetPlatform().WritableDir(), "diff-new2.mwm");
+  string const diffPath = my::JoinFoldersToPath(GetPlatform().WritableDir(), "diff.mwmdiff");
+
+  MY_SCOPE_GUARD(cleanup, [&] {
+    FileWriter::DeleteFileX(oldMwmPath);
+    FileWriter::DeleteFileX(newMwmPath1);
+    FileWriter::DeleteFileX(newMwmPath2);
+    FileWriter::DeleteFileX(diffPath);
+  });
+
+  mt19937 rng(0);
+  auto const makeSection = [&rng](size_t size) {
+    vector<uint8_t> data(size);
+    for (auto & b : data)
+      b = static_cast<uint8_t>(rng());
+    return data;
+  };
+
+  auto const geometry = makeSection(1 << 20);
+  auto const index = makeSection(300000);
+  {
+    FilesContainerW writer(oldMwmPath);
+    writer.Write(geometry, "geom");
+    writer.Write(index, "idx");
+  }
+
+  // Insert, change and remove some data in one section and add a new one.
+  vector<uint8_t> newGeometry(geometry.begin(), geometry.begin() + 100000);
+  newGeometry.insert(newGeometry.end(), 1000, 7);
+  newGeometry.insert(newGeometry.end(), geometry.begin() + 100000, geometry.begin() + 500000);
+  for (size_t i = 300000; i < 300100; ++i)
+    newGeometry[i] ^= 0xFF;
+  newGeometry.insert(newGeometry.end(), geometry.begin() + 600000, geometry.end());
+  {
+    FilesContainerW writer(newMwmPath1);
+    writer.Write(newGeometry, "geom");
+    writer.Write(makeSection(1000), "new");
+    writer.Write(index, "idx");
+  }
+
+  TEST(MakeDiff(oldMwmPath, newMwmPath1, diffPath), ());
+  TEST(ApplyDiff(oldMwmPath, newMwmPath2, diffPath), ());
+
+  TEST(my::IsEqualFiles(newMwmPath1, newMwmPath2), ());
+  TEST_LESS(my::FileData(diffPath, my::FileData::OP_READ).Size(), 30000, ());
+}
+
+UNIT_TEST(IncrementalUpdates_DiffApplier)
+{
+  string const oldMwmPath = my::JoinFoldersToPath(GetPlatform().WritableDir(), "applier-old.mwm");
+  string const newMwmPath1 = my::JoinFoldersToPath(GetPlatform().WritableDir(), "applier-new1.mwm");
+  string const newMwmPath2 = my::JoinFoldersToPath(GetPlatform().WritableDir(), "applier-new2.mwm");
+  string const diffPath = my::JoinFoldersToPath(GetPlatform().WritableDir(), "applier.mwmdiff");
+
+  MY_SCOPE_GUARD(cleanup, [&] {
+    FileWriter::DeleteFileX(oldMwmPath);
+    FileWriter::DeleteFileX(newMwmPath1);
+    FileWriter::DeleteFileX(newMwmPath2);
+    FileWriter::DeleteFileX(diffPath);
+  });
+
+  mt19937 rng(0);
+  vector<uint8_t> geometry(3 << 20);
+  for (auto & b : geometry)
+    b = static_cast<uint8_t>(rng());
+  {
+    FilesContainerW writer(oldMwmPath);
+    writer.Write(geometry, "geom");
+  }
+  // New data doesn't compress, so the diff has several blocks.
+  for (size_t i = 1000000; i < 2500000; ++i)
+    geometry[i] = static_cast<uint8_t>(rng());
+  {
+    FilesContainerW writer(newMwmPath1);
+    writer.Write(geometry, "geom");
+  }
+  TEST(MakeDiff(oldMwmPath, newMwmPath1, diffPath), ());
+
+  string diff;
+  FileReader(diffPath).ReadAsString(diff);
+
+  {
+    // Feeds the diff in pieces of random sizes, like a download does.
+    DiffApplier applier(oldMwmPath, newMwmPath2);
+    size_t pos = 0;
+    while (pos < diff.size())
+    {
+      size_t const size = min(diff.size() - pos, static_cast<size_t>(rng() % 100000));
+      TEST(applier.Feed(diff.data() + pos, size), (pos));
+      pos += size;
+    }
+    TEST_GREATER(applier.GetWrittenSize(), 0, ());
+    TEST(applier.Finish(), ());
+  }
+  TEST(my::IsEqualFiles(newMwmPath1, newMwmPath2), ());
+
+  // Broken diffs are reported with errors.
+  my::ScopedLogAbortLevelChanger const logAbortLevel;
+  {
+    // Truncated diff.
+    DiffApplier applier(oldMwmPath, newMwmPath2);
+    TEST(applier.Feed(diff.data(), diff.size() - 1), ());
+    TEST(!applier.Finish(), ());
+  }
+
+  {
+    // Corrupted block.
+    string corrupted = diff;
+    corrupted[corrupted.size() / 2] ^= 0xFF;
+    DiffApplier applier(oldMwmPath, newMwmPath2);
+    TEST(!applier.Feed(corrupted.data(), corrupted.size()) || !applier.Finish(), ());
+  }
+}
 }  // namespace mwm_diff
 }  // namespace generator
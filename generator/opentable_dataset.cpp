@@ -28,6 +28,7 @@ OpentableRestaurant::OpentableRestaurant(std::string const & src)
   CLOG(LDEBUG, strings::to_double(rec[FieldIndex(Fields::Longtitude)], m_latLon.lon), ());
 
   m_name = rec[FieldIndex(Fields::Name)];
+  m_nameWords = impl::MakeWeightedBagOfWords(m_name);
   m_address = rec[FieldIndex(Fields::Address)];
   m_descUrl = rec[FieldIndex(Fields::DescUrl)];
 }
@@ -83,10 +84,13 @@ OpentableDataset::ObjectId OpentableDataset::FindMatchingObjectIdImpl(FeatureBui
 
   // Find |kMaxSelectedElements| nearest values to a point.
   auto const nearbyIds = m_storage.GetNearestObjects(MercatorBounds::ToLatLon(fb.GetKeyPoint()));
+  if (nearbyIds.empty())
+    return Object::InvalidObjectId();
 
+  auto const nameWords = impl::MakeWeightedBagOfWords(name);
   for (auto const objId : nearbyIds)
   {
-    if (sponsored_scoring::Match(m_storage.GetObjectById(objId), fb).IsMatched())
+    if (sponsored_scoring::Match(m_storage.GetObjectById(objId), fb, nameWords).IsMatched())
       return objId;
   }
 
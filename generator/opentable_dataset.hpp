@@ -1,6 +1,7 @@
 #pragma once
 
 #include "generator/sponsored_dataset.hpp"
+#include "generator/sponsored_scoring.hpp"
 
 #include "geometry/latlon.hpp"
 
@@ -45,6 +46,8 @@ struct OpentableRestaurant
   ObjectId m_id{InvalidObjectId()};
   ms::LatLon m_latLon = ms::LatLon::Zero();
   std::string m_name;
+  // |m_name| prepared for matching.
+  impl::WeightedBagOfWords m_nameWords;
   std::string m_street;
   std::string m_houseNumber;
 
@@ -27,7 +27,8 @@ bool MatchStats<OpentableRestaurant>::IsMatched() const
 }
 
 template <>
-MatchStats<OpentableRestaurant> Match(OpentableRestaurant const & r, FeatureBuilder1 const & fb)
+MatchStats<OpentableRestaurant> Match(OpentableRestaurant const & r, FeatureBuilder1 const & fb,
+                                      impl::WeightedBagOfWords const & fbName)
 {
   MatchStats<OpentableRestaurant> score;
 
@@ -36,10 +37,16 @@ MatchStats<OpentableRestaurant> Match(OpentableRestaurant const & r, FeatureBuil
   score.m_linearNormDistanceScore =
       impl::GetLinearNormDistanceScore(distance, OpentableDataset::kDistanceLimitInMeters);
 
-  score.m_nameSimilarityScore =
-      impl::GetNameSimilarityScore(r.m_name, fb.GetName(StringUtf8Multilang::kDefaultCode));
+  score.m_nameSimilarityScore = impl::GetNameSimilarityScore(r.m_nameWords, fbName);
 
   return score;
 }
+
+template <>
+MatchStats<OpentableRestaurant> Match(OpentableRestaurant const & r, FeatureBuilder1 const & fb)
+{
+  return Match(r, fb,
+               impl::MakeWeightedBagOfWords(fb.GetName(StringUtf8Multilang::kDefaultCode)));
+}
 }  // namespace sponsored_scoring
 }  // namespace generator
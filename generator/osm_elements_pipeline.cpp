@@ -0,0 +1,212 @@
+#include "generator/osm_elements_pipeline.hpp"
+
+#include "base/assert.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+using Batch = vector<OsmElement>;
+
+class Context
+{
+public:
+  explicit Context(size_t maxBatchesInFlight) : m_maxBatchesInFlight(maxBatchesInFlight) {}
+
+  // Reader stage. Drops |batch| if an error occurred: the source can't be
+  // interrupted safely, so the rest of it is read idly.
+  void PushSourceBatch(Batch && batch)
+  {
+    unique_lock<mutex> lock(m_mutex);
+    m_cv.wait(lock, [this] { return m_batchesInFlight < m_maxBatchesInFlight || m_error; });
+    if (m_error)
+      return;
+
+    m_toPrepare.emplace_back(m_numPushed++, move(batch));
+    ++m_batchesInFlight;
+    m_cv.notify_all();
+  }
+
+  void FinishSource()
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_sourceFinished = true;
+    m_cv.notify_all();
+  }
+
+  // Prepare stage. Returns false when there are no batches to prepare anymore.
+  bool PopBatchToPrepare(pair<uint64_t, Batch> & batch)
+  {
+    unique_lock<mutex> lock(m_mutex);
+    m_cv.wait(lock, [this] { return !m_toPrepare.empty() || m_sourceFinished || m_error; });
+    if (m_error || m_toPrepare.empty())
+      return false;
+
+    batch = move(m_toPrepare.front());
+    m_toPrepare.pop_front();
+    return true;
+  }
+
+  void PushPreparedBatch(uint64_t id, Batch && batch)
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_prepared.emplace(id, move(batch));
+    m_cv.notify_all();
+  }
+
+  // Emit stage. Returns batches in the order of the source and false when all
+  // batches are emitted.
+  bool PopPreparedBatch(Batch & batch)
+  {
+    unique_lock<mutex> lock(m_mutex);
+    m_cv.wait(lock, [this] {
+      return m_error || (m_sourceFinished && m_numPopped == m_numPushed) ||
+             (!m_prepared.empty() && m_prepared.begin()->first == m_numPopped);
+    });
+    if (m_error || m_prepared.empty())
+      return false;
+
+    auto const it = m_prepared.begin();
+    ASSERT_EQUAL(it->first, m_numPopped, ());
+    batch = move(it->second);
+    m_prepared.erase(it);
+    ++m_numPopped;
+    --m_batchesInFlight;
+    m_cv.notify_all();
+    return true;
+  }
+
+  void SetError(exception_ptr error)
+  {
+    lock_guard<mutex> lock(m_mutex);
+    if (!m_error)
+      m_error = error;
+    m_cv.notify_all();
+  }
+
+  exception_ptr GetError()
+  {
+    lock_guard<mutex> lock(m_mutex);
+    return m_error;
+  }
+
+private:
+  size_t const m_maxBatchesInFlight;
+
+  mutex m_mutex;
+  condition_variable m_cv;
+
+  deque<pair<uint64_t, Batch>> m_toPrepare;
+  map<uint64_t, Batch> m_prepared;
+  size_t m_batchesInFlight = 0;
+  uint64_t m_numPushed = 0;
+  uint64_t m_numPopped = 0;
+  bool m_sourceFinished = false;
+  exception_ptr m_error;
+};
+}  // namespace
+
+namespace generator
+{
+// static
+size_t constexpr OsmElementsPipeline::kDefaultBatchSize;
+
+OsmElementsPipeline::OsmElementsPipeline(size_t numWorkers, size_t batchSize)
+  : m_numWorkers(numWorkers), m_batchSize(batchSize)
+{
+  CHECK_GREATER(m_batchSize, 0, ());
+}
+
+void OsmElementsPipeline::Run(Source const & source, Processor const & prepare,
+                              Processor const & emit) const
+{
+  if (m_numWorkers == 0)
+  {
+    source([&](OsmElement * e) {
+      prepare(e);
+      emit(e);
+    });
+    return;
+  }
+
+  // Enough batches to keep all workers busy while the emitter waits for the oldest one.
+  Context ctx(2 * m_numWorkers + 1);
+
+  thread reader([&] {
+    try
+    {
+      Batch batch;
+      batch.reserve(m_batchSize);
+      source([&](OsmElement * e) {
+        batch.push_back(move(*e));
+        if (batch.size() == m_batchSize)
+        {
+          ctx.PushSourceBatch(move(batch));
+          batch = Batch();
+          batch.reserve(m_batchSize);
+        }
+      });
+      if (!batch.empty())
+        ctx.PushSourceBatch(move(batch));
+    }
+    catch (...)
+    {
+      ctx.SetError(current_exception());
+    }
+    ctx.FinishSource();
+  });
+
+  vector<thread> workers;
+  workers.reserve(m_numWorkers);
+  for (size_t i = 0; i < m_numWorkers; ++i)
+  {
+    workers.emplace_back([&] {
+      try
+      {
+        pair<uint64_t, Batch> batch;
+        while (ctx.PopBatchToPrepare(batch))
+        {
+          for (auto & e : batch.second)
+            prepare(&e);
+          ctx.PushPreparedBatch(batch.first, move(batch.second));
+        }
+      }
+      catch (...)
+      {
+        ctx.SetError(current_exception());
+      }
+    });
+  }
+
+  try
+  {
+    Batch batch;
+    while (ctx.PopPreparedBatch(batch))
+    {
+      for (auto & e : batch)
+        emit(&e);
+    }
+  }
+  catch (...)
+  {
+    ctx.SetError(current_exception());
+  }
+
+  reader.join();
+  for (auto & worker : workers)
+    worker.join();
+
+  if (auto const error = ctx.GetError())
+    rethrow_exception(error);
+}
+}  // namespace generator
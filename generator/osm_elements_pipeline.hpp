@@ -0,0 +1,34 @@
+#pragma once
+
+#include "generator/osm_element.hpp"
+
+#include <cstddef>
+#include <functional>
+
+namespace generator
+{
+// Processes osm elements in three stages:
+// 1. A reader thread gets elements from |source| and packs them into batches.
+// 2. Worker threads call |prepare| for all elements of a batch. Elements of different
+//    batches are prepared concurrently, so |prepare| must not modify shared state.
+// 3. The calling thread calls |emit| for all elements in the order of |source|.
+// The number of batches in flight is limited, so memory usage doesn't depend on the
+// size of the source. Exceptions of all stages are rethrown on the calling thread.
+class OsmElementsPipeline
+{
+public:
+  using Processor = std::function<void(OsmElement *)>;
+  using Source = std::function<void(Processor const &)>;
+
+  static size_t constexpr kDefaultBatchSize = 1024;
+
+  // |numWorkers| == 0 means that all stages run on the calling thread.
+  explicit OsmElementsPipeline(size_t numWorkers, size_t batchSize = kDefaultBatchSize);
+
+  void Run(Source const & source, Processor const & prepare, Processor const & emit) const;
+
+private:
+  size_t const m_numWorkers;
+  size_t const m_batchSize;
+};
+}  // namespace generator
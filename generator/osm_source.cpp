@@ -6,9 +6,11 @@
 #include "generator/intermediate_data.hpp"
 #include "generator/intermediate_elements.hpp"
 #include "generator/osm_element.hpp"
+#include "generator/osm_elements_pipeline.hpp"
 #include "generator/osm_o5m_source.hpp"
 #include "generator/osm_translator.hpp"
 #include "generator/osm_xml_source.hpp"
+#include "generator/parallel_utils.hpp"
 #include "generator/polygonizer.hpp"
 #include "generator/tag_admixer.hpp"
 #include "generator/towns_dumper.hpp"
@@ -29,9 +31,15 @@
 #include "base/stl_helpers.hpp"
 
 #include "coding/file_name_utils.hpp"
+#include "coding/internal/file_data.hpp"
 #include "coding/parse_xml.hpp"
 
+#include <algorithm>
+#include <map>
 #include <memory>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "defines.hpp"
 
@@ -126,12 +134,13 @@ class IntermediateData
   }
 
 public:
-  IntermediateData(TNodesHolder & nodes, feature::GenerateInfo & info)
+  /// |append| is used in write mode to add elements to existing intermediate data.
+  IntermediateData(TNodesHolder & nodes, feature::GenerateInfo & info, bool append = false)
   : m_nodes(nodes)
-  , m_ways(info.GetIntermediateFileName(WAYS_FILE, ""), info.m_preloadCache)
-  , m_relations(info.GetIntermediateFileName(RELATIONS_FILE, ""), info.m_preloadCache)
-  , m_nodeToRelations(info.GetIntermediateFileName(NODES_FILE, ID2REL_EXT))
-  , m_wayToRelations(info.GetIntermediateFileName(WAYS_FILE,ID2REL_EXT))
+  , m_ways(info.GetIntermediateFileName(WAYS_FILE, ""), info.m_preloadCache, append)
+  , m_relations(info.GetIntermediateFileName(RELATIONS_FILE, ""), info.m_preloadCache, append)
+  , m_nodeToRelations(info.GetIntermediateFileName(NODES_FILE, ID2REL_EXT), append)
+  , m_wayToRelations(info.GetIntermediateFileName(WAYS_FILE,ID2REL_EXT), append)
   {
   }
 
@@ -141,6 +150,8 @@ public:
   void AddWay(TKey id, WayElement const & e) { m_ways.Write(id, e); }
   bool GetWay(TKey id, WayElement & e) { return m_ways.Read(id, e); }
 
+  bool GetRelation(TKey id, RelationElement & e) { return m_relations.Read(id, e); }
+
   void AddRelation(TKey id, RelationElement const & e)
   {
     string const & relationType = e.GetType();
@@ -272,7 +283,7 @@ private:
 
 class MainFeaturesEmitter : public EmitterBase
 {
-  using TWorldGenerator = WorldMapGenerator<feature::FeaturesCollector>;
+  using TWorldGenerator = ConcurrentWorldMapGenerator<feature::FeaturesCollector>;
   using TCountriesGenerator = CountryMapGenerator<feature::Polygonizer<feature::FeaturesCollector>>;
 
   unique_ptr<TCountriesGenerator> m_countries;
@@ -291,6 +302,9 @@ class MainFeaturesEmitter : public EmitterBase
   generator::OpentableDataset m_opentableDataset;
   generator::ViatorDataset m_viatorDataset;
   shared_ptr<generator::OsmIdToBoundariesTable> m_boundariesTable;
+  // Outer geometry of city boundaries. Their boxes are computed in Finish() on several threads.
+  vector<pair<osm::Id, FeatureBuilder1::TPointSeq>> m_cityBoundaries;
+  size_t const m_threadsCount;
 
   /// Used to prepare a list of cities to serve as a list of nodes
   /// for building a highway graph with OSRM for low zooms.
@@ -315,6 +329,25 @@ class MainFeaturesEmitter : public EmitterBase
     return params.FindType(placeType, 1);
   }
 
+  void AppendCityBoundaries()
+  {
+    if (!m_boundariesTable)
+      return;
+
+    vector<indexer::CityBoundary> boundaries(m_cityBoundaries.size());
+    generator::ForEachIndexInParallel(m_threadsCount, m_cityBoundaries.size(), [&](size_t i) {
+      boundaries[i] = indexer::CityBoundary(m_cityBoundaries[i].second);
+    });
+
+    // Boundaries are appended in the emission order, so the table doesn't depend on threads.
+    for (size_t i = 0; i < boundaries.size(); ++i)
+      m_boundariesTable->Append(m_cityBoundaries[i].first, move(boundaries[i]));
+
+    LOG(LINFO, ("Cities boundaries:", boundaries.size()));
+    m_cityBoundaries.clear();
+    m_cityBoundaries.shrink_to_fit();
+  }
+
   void UnionEqualPlacesIds(Place const & place)
   {
     if (!m_boundariesTable)
@@ -335,6 +368,7 @@ public:
     , m_opentableDataset(info.m_opentableDatafileName, info.m_opentableReferenceDir)
     , m_viatorDataset(info.m_viatorDatafileName)
     , m_boundariesTable(info.m_boundariesTable)
+    , m_threadsCount(max(info.m_threadsCount, static_cast<size_t>(1)))
   {
     Classificator const & c = classif();
 
@@ -368,7 +402,7 @@ public:
       m_countries = my::make_unique<TCountriesGenerator>(info);
 
     if (info.m_createWorld)
-      m_world.reset(new TWorldGenerator(info));
+      m_world.reset(new TWorldGenerator(info, m_threadsCount));
   }
 
   void operator()(FeatureBuilder1 & fb) override
@@ -434,8 +468,7 @@ public:
     if (type == ftype::GetEmptyValue())
       return;
 
-    auto const id = fb.GetLastOsmId();
-    m_boundariesTable->Append(id, indexer::CityBoundary(fb.GetOuterGeometry()));
+    m_cityBoundaries.emplace_back(fb.GetLastOsmId(), fb.GetOuterGeometry());
 
     Place const place(fb, type);
     UnionEqualPlacesIds(place);
@@ -445,6 +478,7 @@ public:
   bool Finish() override
   {
     DumpSkippedElements();
+    AppendCityBoundaries();
 
     // Emit all required booking objects to the map.
     m_bookingDataset.BuildOsmObjects([this](FeatureBuilder1 & fb) { Emit(fb); });
@@ -472,17 +506,14 @@ public:
       size_t totalPoints = 0;
       size_t totalPolygons = 0;
 
-      vector<FeatureBuilder1> vecFb;
-      m_coasts->GetFeatures(vecFb);
-
-      for (auto & fb : vecFb)
+      m_coasts->ForEachFeature([&](FeatureBuilder1 const & fb)
       {
         (*m_coastsHolder)(fb);
 
         ++totalFeatures;
         totalPoints += fb.GetPointsCount();
         totalPolygons += fb.GetPolygonsCount();
-      }
+      });
       LOG(LINFO, ("Total features:", totalFeatures, "total polygons:", totalPolygons,
                   "total points:", totalPoints));
     }
@@ -733,6 +764,8 @@ bool GenerateFeaturesImpl(feature::GenerateInfo & info, EmitterBase & emitter)
   try
   {
     TNodesHolder nodes(info.GetIntermediateFileName(NODES_FILE, ""));
+    if (info.m_preloadCache)
+      nodes.Preload();
 
     using TDataCache = IntermediateData<TNodesHolder, cache::EMode::Read>;
     TDataCache cache(nodes, info);
@@ -743,7 +776,7 @@ bool GenerateFeaturesImpl(feature::GenerateInfo & info, EmitterBase & emitter)
         emitter, cache, info.m_makeCoasts ? classif().GetCoastType() : 0,
         info.GetAddressesFileName(), info.GetIntermediateFileName(RESTRICTIONS_FILENAME, ""),
         info.GetIntermediateFileName(ROAD_ACCESS_FILENAME, ""),
-        info.GetIntermediateFileName(METALINES_FILENAME, ""));
+        info.GetIntermediateFileName(METALINES_FILENAME, ""), info.m_threadsCount);
 
     TagAdmixer tagAdmixer(info.GetIntermediateFileName("ways", ".csv"),
                           info.GetIntermediateFileName("towns", ".csv"));
@@ -751,25 +784,36 @@ bool GenerateFeaturesImpl(feature::GenerateInfo & info, EmitterBase & emitter)
     OsmTagMixer osmTagMixer(GetPlatform().ResourcesDir() + MIXED_TAGS_FILE);
 
     // Here we can add new tags to the elements!
-    auto const fn = [&](OsmElement * e)
+    // Tags of different elements are processed concurrently, the tag processors are read-only.
+    auto const prepare = [&](OsmElement * e)
     {
       tagReplacer(e);
       tagAdmixer(e);
       osmTagMixer(e);
-
-      parser.EmitElement(e);
     };
 
+    // The translator reads the intermediate data and the emitter accumulates features,
+    // so elements are emitted on this thread in the order of the source.
+    auto const emit = [&](OsmElement * e) { parser.EmitElement(e); };
+
     SourceReader reader = info.m_osmFileName.empty() ? SourceReader() : SourceReader(info.m_osmFileName);
-    switch (info.m_osmFileType)
+    auto const source = [&](generator::OsmElementsPipeline::Processor const & fn)
     {
-      case feature::GenerateInfo::OsmSourceType::XML:
-        ProcessOsmElementsFromXML(reader, fn);
-        break;
-      case feature::GenerateInfo::OsmSourceType::O5M:
-        ProcessOsmElementsFromO5M(reader, fn);
-        break;
-    }
+      switch (info.m_osmFileType)
+      {
+        case feature::GenerateInfo::OsmSourceType::XML:
+          ProcessOsmElementsFromXML(reader, fn);
+          break;
+        case feature::GenerateInfo::OsmSourceType::O5M:
+          ProcessOsmElementsFromO5M(reader, fn);
+          break;
+      }
+    };
+
+    // Source decoding and emitting take two threads, the rest prepare elements.
+    size_t const numThreads = thread::hardware_concurrency();
+    generator::OsmElementsPipeline pipeline(numThreads > 2 ? numThreads - 2 : 1);
+    pipeline.Run(source, prepare, emit);
 
     LOG(LINFO, ("Processing", info.m_osmFileName, "done."));
 
@@ -833,6 +877,8 @@ bool GenerateFeatures(feature::GenerateInfo & info, EmitterFactory factory)
       return GenerateFeaturesImpl<cache::MapFilePointStorage<cache::EMode::Read>>(info, *emitter);
     case feature::GenerateInfo::NodeStorageType::Memory:
       return GenerateFeaturesImpl<cache::RawMemPointStorage<cache::EMode::Read>>(info, *emitter);
+    case feature::GenerateInfo::NodeStorageType::Mapped:
+      return GenerateFeaturesImpl<cache::MappedFilePointStorage<cache::EMode::Read>>(info, *emitter);
   }
   return false;
 }
@@ -847,6 +893,270 @@ bool GenerateIntermediateData(feature::GenerateInfo & info)
       return GenerateIntermediateDataImpl<cache::MapFilePointStorage<cache::EMode::Write>>(info);
     case feature::GenerateInfo::NodeStorageType::Memory:
       return GenerateIntermediateDataImpl<cache::RawMemPointStorage<cache::EMode::Write>>(info);
+    case feature::GenerateInfo::NodeStorageType::Mapped:
+      return GenerateIntermediateDataImpl<cache::MappedFilePointStorage<cache::EMode::Write>>(info);
+  }
+  return false;
+}
+
+namespace
+{
+using TOsmChange = vector<pair<OscSource::Action, OsmElement>>;
+
+// Reads the change and leaves only the last action for every element.
+void ReadOsmChange(string const & fileName, TOsmChange & change)
+{
+  change.clear();
+  SourceReader reader(fileName);
+  OscSource parser([&change](OscSource::Action action, OsmElement * e) {
+    change.emplace_back(action, *e);
+  });
+  ParseXMLSequence(reader, parser);
+
+  set<pair<OsmElement::EntityType, uint64_t>> seen;
+  TOsmChange lastActions;
+  for (auto it = change.rbegin(); it != change.rend(); ++it)
+  {
+    if (seen.emplace(it->second.type, it->second.id).second)
+      lastActions.push_back(move(*it));
+  }
+  reverse(lastActions.begin(), lastActions.end());
+  change.swap(lastActions);
+}
+
+// Removes pairs of element id and relation id from the index |fileName| for |relations|.
+void RemoveRelationsFromIndex(string const & fileName, unordered_set<uint64_t> const & relations)
+{
+  using TElement = pair<uint64_t, uint64_t>;
+  size_t constexpr kBlockSize = 1 << 20;
+
+  string const tmpFileName = fileName + ".tmp";
+  {
+    FileReader reader(fileName);
+    FileWriter writer(tmpFileName);
+    uint64_t const size = reader.Size();
+    CHECK_EQUAL(size % sizeof(TElement), 0, ("Damaged file", fileName));
+
+    vector<TElement> buffer;
+    for (uint64_t pos = 0; pos < size; pos += buffer.size() * sizeof(TElement))
+    {
+      buffer.resize(static_cast<size_t>(min<uint64_t>(kBlockSize, (size - pos) / sizeof(TElement))));
+      reader.Read(pos, buffer.data(), buffer.size() * sizeof(TElement));
+
+      for (auto const & e : buffer)
+      {
+        if (relations.count(e.second) == 0)
+          writer.Write(&e, sizeof(e));
+      }
+    }
+  }
+  CHECK(my::RenameFileX(tmpFileName, fileName), (tmpFileName, fileName));
+}
+
+// Collects the bounding rects of the changed elements before and after the change.
+// Features of an element are put to all countries which borders intersect its rect
+// (see Polygonizer), so these countries should be generated again.
+template <class TNodesHolder>
+void CalcChangedRects(feature::GenerateInfo & info, TOsmChange const & change,
+                      vector<m2::RectD> & rects)
+{
+  unordered_map<uint64_t, m2::PointD> newNodes;
+  unordered_set<uint64_t> deletedNodes;
+  unordered_map<uint64_t, OsmElement const *> newWays;
+  for (auto const & c : change)
+  {
+    OsmElement const & e = c.second;
+    if (e.type == OsmElement::EntityType::Node)
+    {
+      if (c.first == OscSource::Action::Delete)
+        deletedNodes.insert(e.id);
+      else
+        newNodes[e.id] = MercatorBounds::FromLatLon(e.lat, e.lon);
+    }
+    else if (e.type == OsmElement::EntityType::Way && c.first != OscSource::Action::Delete)
+    {
+      newWays[e.id] = &e;
+    }
+  }
+
+  TNodesHolder nodes(info.GetIntermediateFileName(NODES_FILE, ""));
+  using TDataCache = IntermediateData<TNodesHolder, cache::EMode::Read>;
+  TDataCache cache(nodes, info);
+  cache.LoadIndex();
+
+  auto const addOldNode = [&](uint64_t id, m2::RectD & rect) {
+    double y, x;
+    if (cache.GetNode(id, y, x))
+      rect.Add(m2::PointD(x, y));
+  };
+
+  auto const addNewNode = [&](uint64_t id, m2::RectD & rect) {
+    auto const it = newNodes.find(id);
+    if (it != newNodes.end())
+      rect.Add(it->second);
+    else if (deletedNodes.count(id) == 0)
+      addOldNode(id, rect);
+  };
+
+  auto const addOldWay = [&](uint64_t id, m2::RectD & rect) {
+    WayElement way(id);
+    if (!cache.GetWay(id, way))
+      return;
+    for (uint64_t const node : way.nodes)
+      addOldNode(node, rect);
+  };
+
+  auto const addNewWay = [&](uint64_t id, m2::RectD & rect) {
+    auto const it = newWays.find(id);
+    if (it == newWays.end())
+    {
+      addOldWay(id, rect);
+      return;
+    }
+    for (uint64_t const node : it->second->Nodes())
+      addNewNode(node, rect);
+  };
+
+  for (auto const & c : change)
+  {
+    OsmElement const & e = c.second;
+    bool const hasOld = c.first != OscSource::Action::Create;
+    bool const hasNew = c.first != OscSource::Action::Delete;
+
+    m2::RectD rect;
+    switch (e.type)
+    {
+      case OsmElement::EntityType::Node:
+      {
+        if (hasOld)
+          addOldNode(e.id, rect);
+        if (hasNew)
+          rect.Add(newNodes[e.id]);
+        break;
+      }
+      case OsmElement::EntityType::Way:
+      {
+        if (hasOld)
+          addOldWay(e.id, rect);
+        if (hasNew)
+          addNewWay(e.id, rect);
+        break;
+      }
+      case OsmElement::EntityType::Relation:
+      {
+        RelationElement relation;
+        if (hasOld && cache.GetRelation(e.id, relation))
+        {
+          for (auto const & node : relation.nodes)
+            addOldNode(node.first, rect);
+          for (auto const & way : relation.ways)
+            addOldWay(way.first, rect);
+        }
+        if (hasNew)
+        {
+          for (auto const & member : e.Members())
+          {
+            if (member.type == OsmElement::EntityType::Node)
+              addNewNode(member.ref, rect);
+            else if (member.type == OsmElement::EntityType::Way)
+              addNewWay(member.ref, rect);
+          }
+        }
+        break;
+      }
+      default: break;
+    }
+
+    if (rect.IsValid())
+      rects.push_back(rect);
+  }
+}
+
+template <class TNodesHolder>
+void ApplyOsmChange(feature::GenerateInfo & info, TOsmChange const & change)
+{
+  // Relations are removed from the indexes of their members and changed ones are added again.
+  unordered_set<uint64_t> changedRelations;
+  for (auto const & c : change)
+  {
+    if (c.second.type == OsmElement::EntityType::Relation)
+      changedRelations.insert(c.second.id);
+  }
+  RemoveRelationsFromIndex(info.GetIntermediateFileName(NODES_FILE, ID2REL_EXT), changedRelations);
+  RemoveRelationsFromIndex(info.GetIntermediateFileName(WAYS_FILE, ID2REL_EXT), changedRelations);
+
+  TNodesHolder nodes(info.GetIntermediateFileName(NODES_FILE, ""));
+  using TDataCache = IntermediateData<TNodesHolder, cache::EMode::Write>;
+  TDataCache cache(nodes, info, true /* append */);
+
+  // Deleted ways and relations stay in the caches, but nothing refers to them.
+  for (auto const & c : change)
+  {
+    if (c.first != OscSource::Action::Delete)
+      AddElementToCache(cache, c.second);
+    else if (c.second.type == OsmElement::EntityType::Node)
+      nodes.RemovePoint(c.second.id);
+  }
+
+  cache.SaveIndex();
+  LOG(LINFO, ("Added points count = ", nodes.GetProcessedPoint()));
+}
+
+template <class TNodesReader, class TNodesUpdater>
+bool UpdateIntermediateDataImpl(feature::GenerateInfo & info, string const & oscFileName,
+                                set<string> & affectedCountries)
+{
+  try
+  {
+    LOG(LINFO, ("Reading osm change", oscFileName));
+    TOsmChange change;
+    ReadOsmChange(oscFileName, change);
+    LOG(LINFO, ("Changed elements:", change.size()));
+
+    vector<m2::RectD> rects;
+    CalcChangedRects<TNodesReader>(info, change, rects);
+
+    borders::CountriesContainerT countries;
+    CHECK(borders::LoadCountriesList(info.m_targetDir, countries, std::set<std::string>(),
+                                     info.m_threadsCount),
+          ("Error loading country polygons files"));
+    for (auto const & rect : rects)
+    {
+      countries.ForEachInRect(rect, [&](borders::CountryPolygons const & country) {
+        bool intersects = false;
+        country.m_regions.ForEachInRect(rect, [&](borders::Region const &) { intersects = true; });
+        if (intersects)
+          affectedCountries.insert(country.m_name);
+      });
+    }
+
+    ApplyOsmChange<TNodesUpdater>(info, change);
+    LOG(LINFO, ("Intermediate data is updated, affected countries:", affectedCountries));
+  }
+  catch (RootException const & e)
+  {
+    LOG(LCRITICAL, ("Error with file ", e.what()));
+  }
+  return true;
+}
+}  // namespace
+
+bool UpdateIntermediateData(feature::GenerateInfo & info, string const & oscFileName,
+                            set<string> & affectedCountries)
+{
+  // Points of the raw, mem and mmap storages are stored in files of the same format.
+  using TDenseReader = cache::MappedFilePointStorage<cache::EMode::Read>;
+  switch (info.m_nodeStorageType)
+  {
+    case feature::GenerateInfo::NodeStorageType::File:
+    case feature::GenerateInfo::NodeStorageType::Memory:
+    case feature::GenerateInfo::NodeStorageType::Mapped:
+      return UpdateIntermediateDataImpl<TDenseReader, cache::RawFilePointStorageUpdater>(
+          info, oscFileName, affectedCountries);
+    case feature::GenerateInfo::NodeStorageType::Index:
+      return UpdateIntermediateDataImpl<cache::MapFilePointStorage<cache::EMode::Read>,
+                                        cache::MapFilePointStorageUpdater>(info, oscFileName,
+                                                                            affectedCountries);
   }
   return false;
 }
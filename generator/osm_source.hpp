@@ -6,6 +6,7 @@
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <set>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -62,6 +63,10 @@ using EmitterFactory = std::function<std::unique_ptr<EmitterBase>(feature::Gener
 bool GenerateFeatures(feature::GenerateInfo & info,
                       EmitterFactory factory = MakeMainFeatureEmitter);
 bool GenerateIntermediateData(feature::GenerateInfo & info);
+/// Applies osm change file |oscFileName| to the intermediate data which is made by
+/// GenerateIntermediateData() and adds names of countries which may change to |affectedCountries|.
+bool UpdateIntermediateData(feature::GenerateInfo & info, std::string const & oscFileName,
+                            std::set<std::string> & affectedCountries);
 
 void ProcessOsmElementsFromO5M(SourceReader & stream, std::function<void(OsmElement *)> processor);
 void ProcessOsmElementsFromXML(SourceReader & stream, std::function<void(OsmElement *)> processor);
@@ -560,13 +560,14 @@ public:
                          std::string const & addrFilePath = {},
                          std::string const & restrictionsFilePath = {},
                          std::string const & roadAccessFilePath = {},
-                         std::string const & metalinesFilePath = {})
+                         std::string const & metalinesFilePath = {},
+                         size_t threadsCount = 1)
     : m_emitter(emitter)
     , m_holder(holder)
     , m_coastType(coastType)
     , m_nodeRelations(m_routingTagsProcessor)
     , m_wayRelations(m_routingTagsProcessor)
-    , m_metalinesBuilder(metalinesFilePath)
+    , m_metalinesBuilder(metalinesFilePath, threadsCount)
   {
     if (!addrFilePath.empty())
       m_addrWriter.reset(new FileWriter(addrFilePath));
@@ -95,3 +95,65 @@ public:
     }
   }
 };
+
+/// Parses osm change (.osc) files. Elements of a change are wrapped by <create>, <modify>
+/// and <delete> tags, the rest of the format is the same as osm xml.
+class OscSource
+{
+public:
+  enum class Action
+  {
+    Create,
+    Modify,
+    Delete
+  };
+
+  using TEmmiterFn = std::function<void(Action, OsmElement *)>;
+
+  OscSource(TEmmiterFn fn)
+    : m_source([this](OsmElement * e) { m_EmmiterFn(m_action, e); }), m_EmmiterFn(fn)
+  {
+  }
+
+  void CharData(std::string const &) {}
+
+  void AddAttr(std::string const & key, std::string const & value)
+  {
+    if (m_depth > 1)
+      m_source.AddAttr(key, value);
+  }
+
+  bool Push(std::string const & tagName)
+  {
+    switch (++m_depth)
+    {
+      case 1:
+        return true;
+      case 2:
+        if (tagName == "create")
+          m_action = Action::Create;
+        else if (tagName == "delete")
+          m_action = Action::Delete;
+        else
+          m_action = Action::Modify;
+        break;
+      default:
+        break;
+    }
+    // The action tag is the root tag for |m_source|.
+    return m_source.Push(tagName);
+  }
+
+  void Pop(std::string const & v)
+  {
+    if (m_depth-- > 1)
+      m_source.Pop(v);
+  }
+
+private:
+  XMLSource m_source;
+  TEmmiterFn m_EmmiterFn;
+
+  size_t m_depth = 0;
+  Action m_action = Action::Modify;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace generator
+{
+/// Calls |makeWorker| once on every one of |threadsCount| threads and then calls the returned
+/// worker for indices in [0, count) on the same thread. It's useful when workers need
+/// per-thread state which isn't thread-safe. The calling thread is one of the threads.
+/// The first exception thrown by a worker is rethrown after all threads stop.
+template <typename MakeWorker>
+void ForEachIndexWithWorkers(size_t threadsCount, size_t count, MakeWorker && makeWorker)
+{
+  if (threadsCount <= 1 || count <= 1)
+  {
+    if (count == 0)
+      return;
+
+    auto worker = makeWorker();
+    for (size_t i = 0; i < count; ++i)
+      worker(i);
+    return;
+  }
+
+  std::atomic<size_t> next(0);
+  std::mutex errorMutex;
+  std::exception_ptr error;
+  auto const run = [&]() {
+    try
+    {
+      auto worker = makeWorker();
+      for (size_t i = next++; i < count; i = next++)
+        worker(i);
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(errorMutex);
+      if (!error)
+        error = std::current_exception();
+      next = count;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < std::min(threadsCount, count); ++i)
+    threads.emplace_back(run);
+  run();
+  for (auto & t : threads)
+    t.join();
+
+  if (error)
+    std::rethrow_exception(error);
+}
+
+/// Calls |fn| for all indices in [0, count) on |threadsCount| threads. The calling thread
+/// is one of them. The first exception thrown by |fn| is rethrown after all threads stop.
+template <typename Fn>
+void ForEachIndexInParallel(size_t threadsCount, size_t count, Fn && fn)
+{
+  ForEachIndexWithWorkers(threadsCount, count, [&fn]() { return std::ref(fn); });
+}
+}  // namespace generator
@@ -60,7 +60,8 @@ namespace feature
 
       if (info.m_splitByPolygons)
       {
-        CHECK(borders::LoadCountriesList(info.m_targetDir, m_countries),
+        CHECK(borders::LoadCountriesList(info.m_targetDir, m_countries,
+                                         info.m_countriesToGenerate, info.m_threadsCount),
             ("Error loading country polygons files"));
       }
       else
@@ -68,6 +69,7 @@ namespace feature
         // Insert fake country polygon equal to whole world to
         // create only one output file which contains all features
         m_countries.Add(borders::CountryPolygons(info.m_fileName), MercatorBounds::FullRect());
+        m_countries.Build();
       }
     }
     ~Polygonizer()
@@ -78,16 +80,25 @@ namespace feature
 
     struct PointChecker
     {
-      borders::RegionsContainerT const & m_regions;
+      borders::CountryPolygons const & m_country;
       bool m_belongs;
 
-      PointChecker(borders::RegionsContainerT const & regions)
-        : m_regions(regions), m_belongs(false) {}
+      PointChecker(borders::CountryPolygons const & country)
+        : m_country(country), m_belongs(false) {}
 
       bool operator()(m2::PointD const & pt)
       {
-        m_regions.ForEachInRect(m2::RectD(pt, pt),
-                                std::bind<void>(std::ref(*this), std::placeholders::_1, std::cref(pt)));
+        // Polygons are tested only for points near borders.
+        switch (m_country.m_coverage.Get(pt))
+        {
+        case borders::BordersCoverage::CellType::Inside: m_belongs = true; break;
+        case borders::BordersCoverage::CellType::Outside: break;
+        case borders::BordersCoverage::CellType::Boundary:
+          m_country.m_regions.ForEachInRect(
+              m2::RectD(pt, pt),
+              std::bind<void>(std::ref(*this), std::placeholders::_1, std::cref(pt)));
+          break;
+        }
         return !m_belongs;
       }
 
@@ -194,7 +205,7 @@ namespace feature
       {
         for (size_t i = 0; i < m_Countries.size(); ++i)
         {
-          PointChecker doCheck(m_Countries[i]->m_regions);
+          PointChecker doCheck(*m_Countries[i]);
           m_fb.ForEachGeometryPoint(doCheck);
 
           if (doCheck.m_belongs)
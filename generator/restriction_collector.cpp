@@ -1,7 +1,5 @@
 #include "generator/restriction_collector.hpp"
 
-#include "generator/routing_helpers.hpp"
-
 #include "base/assert.hpp"
 #include "base/logging.hpp"
 #include "base/scope_guard.hpp"
@@ -35,19 +33,29 @@ namespace routing
 RestrictionCollector::RestrictionCollector(std::string const & restrictionPath,
                                            std::string const & osmIdsToFeatureIdPath)
 {
-  MY_SCOPE_GUARD(clean, [this](){
-    m_osmIdToFeatureId.clear();
-    m_restrictions.clear();
-  });
-
-  if (!ParseOsmIdToFeatureIdMapping(osmIdsToFeatureIdPath, m_osmIdToFeatureId))
+  gen::OsmID2FeatureID osmIdToFeatureId;
+  if (!osmIdToFeatureId.ReadFromFile(osmIdsToFeatureIdPath))
   {
     LOG(LWARNING, ("An error happened while parsing feature id to osm ids mapping from file:",
                    osmIdsToFeatureIdPath));
     return;
   }
 
-  if (!ParseRestrictions(restrictionPath))
+  Collect(restrictionPath, osmIdToFeatureId);
+}
+
+RestrictionCollector::RestrictionCollector(std::string const & restrictionPath,
+                                           gen::OsmID2FeatureID const & osmIdToFeatureId)
+{
+  Collect(restrictionPath, osmIdToFeatureId);
+}
+
+void RestrictionCollector::Collect(std::string const & restrictionPath,
+                                   gen::OsmID2FeatureID const & osmIdToFeatureId)
+{
+  MY_SCOPE_GUARD(clean, [this](){ m_restrictions.clear(); });
+
+  if (!ParseRestrictions(restrictionPath, osmIdToFeatureId))
   {
     LOG(LWARNING, ("An error happened while parsing restrictions from file:",  restrictionPath));
     return;
@@ -67,7 +75,8 @@ bool RestrictionCollector::IsValid() const
                  [](Restriction const & r) { return !r.IsValid(); }) == end(m_restrictions);
 }
 
-bool RestrictionCollector::ParseRestrictions(std::string const & path)
+bool RestrictionCollector::ParseRestrictions(std::string const & path,
+                                             gen::OsmID2FeatureID const & osmIdToFeatureId)
 {
   std::ifstream stream(path);
   if (stream.fail())
@@ -95,37 +104,30 @@ bool RestrictionCollector::ParseRestrictions(std::string const & path)
       return false;
     }
 
-    AddRestriction(type, osmIds);
+    AddRestriction(type, osmIds, osmIdToFeatureId);
   }
   return true;
 }
 
-bool RestrictionCollector::AddRestriction(Restriction::Type type, std::vector<osm::Id> const & osmIds)
+bool RestrictionCollector::AddRestriction(Restriction::Type type, std::vector<osm::Id> const & osmIds,
+                                          gen::OsmID2FeatureID const & osmIdToFeatureId)
 {
   std::vector<uint32_t> featureIds(osmIds.size());
   for (size_t i = 0; i < osmIds.size(); ++i)
   {
-    auto const result = m_osmIdToFeatureId.find(osmIds[i]);
-    if (result == m_osmIdToFeatureId.cend())
+    // Only one feature id is found for |osmIds[i]|.
+    if (!osmIdToFeatureId.GetFeatureID(osmIds[i], featureIds[i]))
     {
       // It could happend near mwm border when one of a restriction lines is not included in mwm
       // but the restriction is included.
       return false;
     }
-
-    // Only one feature id is found for |osmIds[i]|.
-    featureIds[i] = result->second;
   }
 
   m_restrictions.emplace_back(type, featureIds);
   return true;
 }
 
-void RestrictionCollector::AddFeatureId(uint32_t featureId, osm::Id osmId)
-{
-  ::routing::AddFeatureId(osmId, featureId, m_osmIdToFeatureId);
-}
-
 bool FromString(std::string str, Restriction::Type & type)
 {
   if (str == kNo)
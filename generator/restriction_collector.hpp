@@ -1,5 +1,6 @@
 #pragma once
 
+#include "generator/gen_mwm_info.hpp"
 #include "generator/osm_id.hpp"
 
 #include "routing/restrictions_serialization.hpp"
@@ -22,6 +23,10 @@ public:
   /// \param restrictionPath full path to file with road restrictions in osm id terms.
   /// \param osmIdsToFeatureIdsPath full path to file with mapping from osm ids to feature ids.
   RestrictionCollector(std::string const & restrictionPath, std::string const & osmIdsToFeatureIdsPath);
+  /// \param osmIdToFeatureId sorted mapping from osm ids to feature ids. It's not copied, so
+  /// several collectors may share one mapping and run in parallel.
+  RestrictionCollector(std::string const & restrictionPath,
+                       gen::OsmID2FeatureID const & osmIdToFeatureId);
 
   bool HasRestrictions() const { return !m_restrictions.empty(); }
 
@@ -38,6 +43,8 @@ private:
   friend void UnitTest_RestrictionTest_ParseRestrictions();
   friend void UnitTest_RestrictionTest_ParseFeatureId2OsmIdsMapping();
 
+  void Collect(std::string const & restrictionPath, gen::OsmID2FeatureID const & osmIdToFeatureId);
+
   /// \brief Parses comma separated text file with line in following format:
   /// <type of restrictions>, <osm id 1 of the restriction>, <osm id 2>, and so on
   /// For example:
@@ -45,10 +52,7 @@ private:
   /// No, 157616940, 157616940,
   /// No, 157616940, 157617107,
   /// \param path path to the text file with restrictions.
-  bool ParseRestrictions(std::string const & path);
-
-  /// \brief Adds feature id and corresponding |osmId| to |m_osmIdToFeatureId|.
-  void AddFeatureId(uint32_t featureId, osm::Id osmId);
+  bool ParseRestrictions(std::string const & path, gen::OsmID2FeatureID const & osmIdToFeatureId);
 
   /// \brief Adds a restriction (vector of osm id).
   /// \param type is a type of restriction
@@ -56,10 +60,10 @@ private:
   /// \note This method should be called to add a restriction when feature ids of the restriction
   /// are unknown. The feature ids should be set later with a call of |SetFeatureId(...)| method.
   /// \returns true if restriction is add and false otherwise.
-  bool AddRestriction(Restriction::Type type, std::vector<osm::Id> const & osmIds);
+  bool AddRestriction(Restriction::Type type, std::vector<osm::Id> const & osmIds,
+                      gen::OsmID2FeatureID const & osmIdToFeatureId);
 
   RestrictionVec m_restrictions;
-  std::map<osm::Id, uint32_t> m_osmIdToFeatureId;
 };
 
 bool FromString(std::string str, Restriction::Type & type);
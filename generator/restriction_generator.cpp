@@ -1,7 +1,5 @@
 #include "generator/restriction_generator.hpp"
 
-#include "generator/restriction_collector.hpp"
-
 #include "coding/file_container.hpp"
 #include "coding/file_writer.hpp"
 
@@ -28,6 +26,18 @@ bool BuildRoadRestrictions(std::string const & mwmPath, std::string const & rest
     return false;
   }
 
+  return BuildRoadRestrictions(mwmPath, restrictionCollector);
+}
+
+bool BuildRoadRestrictions(std::string const & mwmPath,
+                           RestrictionCollector const & restrictionCollector)
+{
+  if (!restrictionCollector.HasRestrictions() || !restrictionCollector.IsValid())
+  {
+    LOG(LWARNING, ("No valid restrictions for", mwmPath));
+    return false;
+  }
+
   RestrictionVec const & restrictions = restrictionCollector.GetRestrictions();
 
   auto const firstOnlyIt =
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "generator/restriction_collector.hpp"
+
 #include <string>
 
 namespace routing
@@ -31,4 +33,7 @@ namespace routing
 /// OsmID2FeatureID class or using a similar way.
 bool BuildRoadRestrictions(std::string const & mwmPath, std::string const & restrictionPath,
                            std::string const & osmIdsToFeatureIdsPath);
+
+/// \brief Builds section with road restrictions which are already collected by |collector|.
+bool BuildRoadRestrictions(std::string const & mwmPath, RestrictionCollector const & collector);
 }  // namespace routing
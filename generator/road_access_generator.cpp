@@ -1,7 +1,6 @@
 #include "generator/road_access_generator.hpp"
 
 #include "generator/osm_id.hpp"
-#include "generator/routing_helpers.hpp"
 
 #include "routing/road_access.hpp"
 #include "routing/road_access_serialization.hpp"
@@ -54,7 +53,7 @@ TagMapping const kBicycleTagMapping = {
     {OsmElement::Tag("bicycle", "no"), RoadAccess::Type::No},
 };
 
-bool ParseRoadAccess(string const & roadAccessPath, map<osm::Id, uint32_t> const & osmIdToFeatureId,
+bool ParseRoadAccess(string const & roadAccessPath, gen::OsmID2FeatureID const & osmIdToFeatureId,
                      FeaturesVector const & featuresVector,
                      RoadAccessCollector::RoadAccessByVehicleType & roadAccessByVehicleType)
 {
@@ -114,15 +113,13 @@ bool ParseRoadAccess(string const & roadAccessPath, map<osm::Id, uint32_t> const
     }
     ++iter;
 
-    auto const it = osmIdToFeatureId.find(osm::Id::Way(osmId));
+    uint32_t featureId;
     // Even though this osm element has a tag that is interesting for us,
     // we have not created a feature from it. Possible reasons:
     // no primary tag, unsupported type, etc.
-    if (it == osmIdToFeatureId.cend())
+    if (!osmIdToFeatureId.GetFeatureID(osm::Id::Way(osmId), featureId))
       continue;
 
-    uint32_t const featureId = it->second;
-
     addSegment(Segment(kFakeNumMwmId, featureId, 0 /* wildcard segment idx */,
                        true /* wildcard isForward */),
                vehicleType, roadAccessType, osmId);
@@ -201,8 +198,8 @@ bool RoadAccessWriter::IsOpened() const { return m_stream && m_stream.is_open();
 RoadAccessCollector::RoadAccessCollector(string const & dataFilePath, string const & roadAccessPath,
                                          string const & osmIdsToFeatureIdsPath)
 {
-  map<osm::Id, uint32_t> osmIdToFeatureId;
-  if (!ParseOsmIdToFeatureIdMapping(osmIdsToFeatureIdsPath, osmIdToFeatureId))
+  gen::OsmID2FeatureID osmIdToFeatureId;
+  if (!osmIdToFeatureId.ReadFromFile(osmIdsToFeatureIdsPath))
   {
     LOG(LWARNING, ("An error happened while parsing feature id to osm ids mapping from file:",
                    osmIdsToFeatureIdsPath));
@@ -210,6 +207,18 @@ RoadAccessCollector::RoadAccessCollector(string const & dataFilePath, string con
     return;
   }
 
+  Collect(dataFilePath, roadAccessPath, osmIdToFeatureId);
+}
+
+RoadAccessCollector::RoadAccessCollector(string const & dataFilePath, string const & roadAccessPath,
+                                         gen::OsmID2FeatureID const & osmIdToFeatureId)
+{
+  Collect(dataFilePath, roadAccessPath, osmIdToFeatureId);
+}
+
+void RoadAccessCollector::Collect(string const & dataFilePath, string const & roadAccessPath,
+                                  gen::OsmID2FeatureID const & osmIdToFeatureId)
+{
   FeaturesVectorTest featuresVector(dataFilePath);
 
   RoadAccessCollector::RoadAccessByVehicleType roadAccessByVehicleType;
@@ -229,9 +238,13 @@ RoadAccessCollector::RoadAccessCollector(string const & dataFilePath, string con
 void BuildRoadAccessInfo(string const & dataFilePath, string const & roadAccessPath,
                          string const & osmIdsToFeatureIdsPath)
 {
-  LOG(LINFO, ("Generating road access info for", dataFilePath));
+  BuildRoadAccessInfo(dataFilePath,
+                      RoadAccessCollector(dataFilePath, roadAccessPath, osmIdsToFeatureIdsPath));
+}
 
-  RoadAccessCollector collector(dataFilePath, roadAccessPath, osmIdsToFeatureIdsPath);
+void BuildRoadAccessInfo(string const & dataFilePath, RoadAccessCollector const & collector)
+{
+  LOG(LINFO, ("Generating road access info for", dataFilePath));
 
   if (!collector.IsValid())
   {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "generator/gen_mwm_info.hpp"
 #include "generator/intermediate_elements.hpp"
 #include "generator/osm_element.hpp"
 
@@ -59,6 +60,9 @@ public:
 
   RoadAccessCollector(std::string const & dataFilePath, std::string const & roadAccessPath,
                       std::string const & osmIdsToFeatureIdsPath);
+  // |osmIdToFeatureId| is a sorted mapping which may be shared with other collectors.
+  RoadAccessCollector(std::string const & dataFilePath, std::string const & roadAccessPath,
+                      gen::OsmID2FeatureID const & osmIdToFeatureId);
 
   RoadAccessByVehicleType const & GetRoadAccessAllTypes() const
   {
@@ -68,6 +72,9 @@ public:
   bool IsValid() const { return m_valid; }
 
 private:
+  void Collect(std::string const & dataFilePath, std::string const & roadAccessPath,
+               gen::OsmID2FeatureID const & osmIdToFeatureId);
+
   RoadAccessByVehicleType m_roadAccessByVehicleType;
   bool m_valid = true;
 };
@@ -76,4 +83,5 @@ private:
 // road accessibility information for one mwm file.
 void BuildRoadAccessInfo(std::string const & dataFilePath, std::string const & roadAccessPath,
                          std::string const & osmIdsToFeatureIdsPath);
+void BuildRoadAccessInfo(std::string const & dataFilePath, RoadAccessCollector const & collector);
 }  // namespace routing
@@ -3,6 +3,7 @@
 #include "generator/borders_generator.hpp"
 #include "generator/borders_loader.hpp"
 #include "generator/osm_id.hpp"
+#include "generator/parallel_utils.hpp"
 #include "generator/routing_helpers.hpp"
 
 #include "routing/base/astar_algorithm.hpp"
@@ -11,6 +12,8 @@
 #include "routing/index_graph.hpp"
 #include "routing/index_graph_loader.hpp"
 #include "routing/index_graph_serialization.hpp"
+#include "routing/shortcut_overlay.hpp"
+#include "routing/shortcut_overlay_serialization.hpp"
 #include "routing/vehicle_mask.hpp"
 
 #include "routing_common/bicycle_model.hpp"
@@ -28,13 +31,17 @@
 
 #include "base/checked_cast.hpp"
 #include "base/logging.hpp"
+#include "base/timer.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <map>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 using namespace feature;
@@ -173,6 +180,89 @@ private:
   IndexGraph & m_graph;
 };
 
+using SegmentSet = unordered_set<Segment, Segment::Hash>;
+
+// Segments of car roads with speed not less than kCoreMinSpeedKMpH are candidates to the core
+// of the shortcut overlay.
+double constexpr kCoreMinSpeedKMpH = 60.0;
+// Core segment is removed from the core if the wave from it settles more segments. It limits
+// generation time and the size of the section for segments surrounded by minor roads only.
+size_t constexpr kMaxSettledSegmentsPerCore = 10000;
+
+// Wrapper for a wave from |source| which doesn't go through other core segments.
+class CoreDijkstraWrapper final
+{
+public:
+  // AStarAlgorithm types aliases:
+  using TVertexType = Segment;
+  using TEdgeType = SegmentEdge;
+  using TWeightType = RouteWeight;
+
+  CoreDijkstraWrapper(IndexGraph & graph, SegmentSet const & core, Segment const & source)
+    : m_graph(graph), m_core(core), m_source(source)
+  {
+  }
+
+  void GetOutgoingEdgesList(TVertexType const & vertex, vector<TEdgeType> & edges)
+  {
+    edges.clear();
+    if (vertex != m_source && m_core.count(vertex) != 0)
+      return;
+
+    m_graph.GetEdgeList(vertex, true /* isOutgoing */, edges);
+  }
+
+  void GetIngoingEdgesList(TVertexType const & vertex, vector<TEdgeType> & edges)
+  {
+    edges.clear();
+    if (vertex != m_source && m_core.count(vertex) != 0)
+      return;
+
+    m_graph.GetEdgeList(vertex, false /* isOutgoing */, edges);
+  }
+
+  TWeightType HeuristicCostEstimate(TVertexType const & /* from */, TVertexType const & /* to */)
+  {
+    return GetAStarWeightZero<TWeightType>();
+  }
+
+private:
+  IndexGraph & m_graph;
+  SegmentSet const & m_core;
+  Segment const m_source;
+};
+
+// Collects core candidates: segments of fast roads which end at a joint.
+void CalcCoreCandidates(IndexGraph const & graph, Geometry & geometry,
+                        vector<Segment> & candidates)
+{
+  vector<uint32_t> featureIds;
+  graph.ForEachRoad(
+      [&](uint32_t featureId, RoadJointIds const & /* road */) { featureIds.push_back(featureId); });
+  // Roads are kept in a hash table, the order is fixed to make the section reproducible.
+  sort(featureIds.begin(), featureIds.end());
+
+  for (uint32_t const featureId : featureIds)
+  {
+    RoadGeometry const & road = geometry.GetRoad(featureId);
+    if (!road.IsValid() || road.GetSpeed() < kCoreMinSpeedKMpH)
+      continue;
+
+    for (uint32_t segmentIdx = 0; segmentIdx + 1 < road.GetPointsCount(); ++segmentIdx)
+    {
+      for (bool const forward : {true, false})
+      {
+        if (!forward && road.IsOneWay())
+          continue;
+
+        Segment const segment(kFakeNumMwmId, featureId, segmentIdx, forward);
+        if (graph.GetJointId(segment.GetRoadPoint(true /* front */)) != Joint::kInvalidId)
+          candidates.push_back(segment);
+      }
+    }
+  }
+}
+
 // Calculate distance from the starting border point to the transition along the border.
 // It could be measured clockwise or counterclockwise, direction doesn't matter.
 double CalcDistanceAlongTheBorders(vector<m2::RegionD> const & borders,
@@ -274,67 +364,180 @@ void CalcCrossMwmTransitions(string const & path, string const & mwmFile, string
   }
 }
 
+// Reports progress of weights filling with the estimation of the remaining time.
+class LeapsProgress final
+{
+public:
+  LeapsProgress(size_t numEnters, bool disabled) : m_numEnters(numEnters), m_disabled(disabled) {}
+
+  void OnWavePassed()
+  {
+    size_t const passed = ++m_passed;
+    if (m_disabled || passed % kPeriod != 0)
+      return;
+
+    double const elapsed = m_timer.ElapsedSeconds();
+    double const eta = elapsed / passed * (m_numEnters - passed);
+    LOG(LINFO, ("Building leaps:", passed, "/", m_numEnters, "waves passed, elapsed:", elapsed,
+                "seconds, eta:", eta, "seconds"));
+  }
+
+private:
+  static size_t constexpr kPeriod = 10;
+
+  size_t const m_numEnters;
+  bool const m_disabled;
+  my::Timer m_timer;
+  atomic<size_t> m_passed{0};
+};
+
+size_t constexpr LeapsProgress::kPeriod;
+
 void FillWeights(string const & path, string const & mwmFile, string const & country,
                  CountryParentNameGetterFn const & countryParentNameGetterFn,
-                 bool disableCrossMwmProgress, CrossMwmConnector & connector)
+                 bool disableCrossMwmProgress, size_t threadsCount, CrossMwmConnector & connector)
 {
   my::Timer timer;
 
   shared_ptr<VehicleModelInterface> vehicleModel =
       CarModelFactory(countryParentNameGetterFn).GetVehicleModelForCountry(country);
-  IndexGraph graph(GeometryLoader::CreateFromFile(mwmFile, vehicleModel),
-                   EdgeEstimator::Create(VehicleType::Car, vehicleModel->GetMaxSpeed(),
-                                         nullptr /* trafficStash */));
 
-  MwmValue mwmValue(LocalCountryFile(path, platform::CountryFile(country), 0 /* version */));
-  DeserializeIndexGraph(mwmValue, kCarMask, graph);
+  vector<Segment> const & enters = connector.GetEnters();
+  vector<Segment> const & exits = connector.GetExits();
+  SegmentSet const exitsSet(exits.cbegin(), exits.cend());
+
+  // Weights from every enter to reachable exits, in the order of |enters|.
+  vector<map<Segment, RouteWeight>> weights(enters.size());
+  LeapsProgress progress(enters.size(), disableCrossMwmProgress);
+
+  // IndexGraph loads geometry lazily and isn't thread-safe, so every thread has its own graph.
+  // A wave from an enter is stopped as soon as all exits are settled.
+  generator::ForEachIndexWithWorkers(threadsCount, enters.size(), [&]() {
+    auto graph = make_shared<IndexGraph>(
+        GeometryLoader::CreateFromFile(mwmFile, vehicleModel),
+        EdgeEstimator::Create(VehicleType::Car, vehicleModel->GetMaxSpeed(),
+                              nullptr /* trafficStash */));
+    MwmValue mwmValue(LocalCountryFile(path, platform::CountryFile(country), 0 /* version */));
+    DeserializeIndexGraph(mwmValue, kCarMask, *graph);
+
+    auto context = make_shared<AStarAlgorithm<DijkstraWrapper>::Context>();
+    return [&, graph, context](size_t i) {
+      AStarAlgorithm<DijkstraWrapper> astar;
+      DijkstraWrapper wrapper(*graph);
+      size_t exitsLeft = exitsSet.size();
+      astar.PropagateWave(wrapper, enters[i],
+                          [&](Segment const & vertex) {
+                            if (exitsSet.count(vertex) != 0 &&
+                                weights[i].emplace(vertex, context->GetDistance(vertex)).second)
+                            {
+                              --exitsLeft;
+                            }
+                            return exitsLeft != 0;
+                          } /* visitVertex */,
+                          *context);
+      progress.OnWavePassed();
+    };
+  });
+
+  map<Segment, size_t> enterToIdx;
+  for (size_t i = 0; i < enters.size(); ++i)
+    enterToIdx.emplace(enters[i], i);
 
-  map<Segment, map<Segment, RouteWeight>> weights;
-  auto const numEnters = connector.GetEnters().size();
   size_t foundCount = 0;
   size_t notFoundCount = 0;
-  for (size_t i = 0; i < numEnters; ++i)
-  {
-    if (!disableCrossMwmProgress && (i % 10 == 0) && (i != 0))
-      LOG(LINFO, ("Building leaps:", i, "/", numEnters, "waves passed"));
+  connector.FillWeights([&](Segment const & enter, Segment const & exit) {
+    auto const idxIt = enterToIdx.find(enter);
+    CHECK(idxIt != enterToIdx.end(), (enter));
 
-    Segment const & enter = connector.GetEnter(i);
+    auto const & enterWeights = weights[idxIt->second];
+    auto const it = enterWeights.find(exit);
+    if (it == enterWeights.end())
+    {
+      ++notFoundCount;
+      return CrossMwmConnector::kNoRoute;
+    }
+
+    ++foundCount;
+    return it->second.ToCrossMwmWeight();
+  });
 
-    AStarAlgorithm<DijkstraWrapper> astar;
-    DijkstraWrapper wrapper(graph);
-    AStarAlgorithm<DijkstraWrapper>::Context context;
-    astar.PropagateWave(wrapper, enter,
-                        [](Segment const & /* vertex */) { return true; } /* visitVertex */,
+  LOG(LINFO, ("Leaps finished, elapsed:", timer.ElapsedSeconds(), "seconds, routes found:",
+              foundCount, ", not found:", notFoundCount));
+}
+
+void CalcShortcutOverlay(IndexGraph & graph, vector<Segment> const & candidates,
+                         ShortcutOverlay & overlay)
+{
+  SegmentSet core(candidates.cbegin(), candidates.cend());
+  // Shortcuts of a core segment depend on the core: when a segment is removed from the core
+  // all segments with shortcuts to it should be processed again.
+  unordered_map<Segment, map<Segment, RouteWeight>, Segment::Hash> shortcuts;
+  unordered_map<Segment, vector<Segment>, Segment::Hash> sources;
+
+  deque<Segment> queue(candidates.cbegin(), candidates.cend());
+  SegmentSet queued(candidates.cbegin(), candidates.cend());
+  size_t processed = 0;
+
+  AStarAlgorithm<CoreDijkstraWrapper> astar;
+  AStarAlgorithm<CoreDijkstraWrapper>::Context context;
+
+  while (!queue.empty())
+  {
+    Segment const source = queue.front();
+    queue.pop_front();
+    queued.erase(source);
+
+    if (core.count(source) == 0)
+      continue;
+
+    if (++processed % 10000 == 0)
+      LOG(LINFO, ("Building shortcuts:", processed, "waves passed, core:", core.size()));
+
+    CoreDijkstraWrapper wrapper(graph, core, source);
+    map<Segment, RouteWeight> targets;
+    size_t settled = 0;
+    astar.PropagateWave(wrapper, source,
+                        [&](Segment const & vertex) {
+                          if (++settled > kMaxSettledSegmentsPerCore)
+                            return false;
+                          if (vertex != source && core.count(vertex) != 0)
+                            targets.emplace(vertex, context.GetDistance(vertex));
+                          return true;
+                        } /* visitVertex */,
                         context);
 
-    for (Segment const & exit : connector.GetExits())
+    if (settled > kMaxSettledSegmentsPerCore)
     {
-      if (context.HasDistance(exit))
-      {
-        weights[enter][exit] = context.GetDistance(exit);
-        ++foundCount;
-      }
-      else
+      core.erase(source);
+      shortcuts.erase(source);
+      for (Segment const & s : sources[source])
       {
-        ++notFoundCount;
+        if (core.count(s) != 0 && queued.insert(s).second)
+          queue.push_back(s);
       }
+      sources.erase(source);
+      continue;
     }
-  }
 
-  connector.FillWeights([&](Segment const & enter, Segment const & exit) {
-    auto it0 = weights.find(enter);
-    if (it0 == weights.end())
-      return CrossMwmConnector::kNoRoute;
-
-    auto it1 = it0->second.find(exit);
-    if (it1 == it0->second.end())
-      return CrossMwmConnector::kNoRoute;
+    for (auto const & kv : targets)
+      sources[kv.first].push_back(source);
+    shortcuts[source] = move(targets);
+  }
 
-    return it1->second.ToCrossMwmWeight();
-  });
+  for (auto const & segment : candidates)
+  {
+    if (core.count(segment) != 0)
+      overlay.AddCore(segment);
+  }
 
-  LOG(LINFO, ("Leaps finished, elapsed:", timer.ElapsedSeconds(), "seconds, routes found:",
-              foundCount, ", not found:", notFoundCount));
+  for (auto const & kv : shortcuts)
+  {
+    for (auto const & target : kv.second)
+    {
+      CHECK(core.count(target.first) != 0, (target.first));
+      overlay.AddShortcut(kv.first, target.first, target.second);
+    }
+  }
 }
 
 serial::CodingParams LoadCodingParams(string const & mwmFile)
@@ -378,7 +581,8 @@ bool BuildRoutingIndex(string const & filename, string const & country,
 
 bool BuildCrossMwmSection(string const & path, string const & mwmFile, string const & country,
                           CountryParentNameGetterFn const & countryParentNameGetterFn,
-                          string const & osmToFeatureFile, bool disableCrossMwmProgress)
+                          string const & osmToFeatureFile, bool disableCrossMwmProgress,
+                          size_t threadsCount)
 {
   LOG(LINFO, ("Building cross mwm section for", country));
 
@@ -403,7 +607,7 @@ bool BuildCrossMwmSection(string const & path, string const & mwmFile, string co
   // We use leaps for cars only. To use leaps for other vehicle types add weights generation
   // here and change WorldGraph mode selection rule in IndexRouter::CalculateSubroute.
   FillWeights(path, mwmFile, country, countryParentNameGetterFn, disableCrossMwmProgress,
-              connectors[static_cast<size_t>(VehicleType::Car)]);
+              threadsCount, connectors[static_cast<size_t>(VehicleType::Car)]);
 
   serial::CodingParams const codingParams = LoadCodingParams(mwmFile);
   FilesContainerW cont(mwmFile, FileWriter::OP_WRITE_EXISTING);
@@ -415,4 +619,48 @@ bool BuildCrossMwmSection(string const & path, string const & mwmFile, string co
   LOG(LINFO, ("Cross mwm section generated, size:", sectionSize, "bytes"));
   return true;
 }
+
+bool BuildShortcutOverlaySection(string const & path, string const & mwmFile,
+                                 string const & country,
+                                 CountryParentNameGetterFn const & countryParentNameGetterFn)
+{
+  LOG(LINFO, ("Building shortcut overlay section for", country));
+  my::Timer timer;
+
+  try
+  {
+    shared_ptr<VehicleModelInterface> vehicleModel =
+        CarModelFactory(countryParentNameGetterFn).GetVehicleModelForCountry(country);
+    IndexGraph graph(GeometryLoader::CreateFromFile(mwmFile, vehicleModel),
+                     EdgeEstimator::Create(VehicleType::Car, vehicleModel->GetMaxSpeed(),
+                                           nullptr /* trafficStash */));
+
+    MwmValue mwmValue(LocalCountryFile(path, platform::CountryFile(country), 0 /* version */));
+    DeserializeIndexGraph(mwmValue, kCarMask, graph);
+
+    vector<Segment> candidates;
+    CalcCoreCandidates(graph, graph.GetGeometry(), candidates);
+    LOG(LINFO, ("Core candidates:", candidates.size()));
+
+    ShortcutOverlay overlay;
+    CalcShortcutOverlay(graph, candidates, overlay);
+
+    FilesContainerW cont(mwmFile, FileWriter::OP_WRITE_EXISTING);
+    FileWriter writer = cont.GetWriter(SHORTCUT_OVERLAY_FILE_TAG);
+    auto const startPos = writer.Pos();
+    ShortcutOverlaySerializer::Serialize(overlay, writer);
+    auto const sectionSize = writer.Pos() - startPos;
+
+    LOG(LINFO, ("Shortcut overlay section generated, size:", sectionSize, "bytes, core:",
+                overlay.GetNumCore(), ", shortcuts:", overlay.GetNumShortcuts(), ", elapsed:",
+                timer.ElapsedSeconds(), "seconds"));
+    return true;
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("An exception happened while creating", SHORTCUT_OVERLAY_FILE_TAG, "section:",
+                 e.what()));
+    return false;
+  }
+}
 }  // namespace routing
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <string>
@@ -10,8 +11,15 @@ using CountryParentNameGetterFn = std::function<std::string(std::string const &)
 
 bool BuildRoutingIndex(std::string const & filename, std::string const & country,
                        CountryParentNameGetterFn const & countryParentNameGetterFn);
+// Weights between enters and exits are calculated on |threadsCount| threads. Every thread
+// loads its own copy of car road graph.
 bool BuildCrossMwmSection(std::string const & path, std::string const & mwmFile,
                           std::string const & country,
                           CountryParentNameGetterFn const & countryParentNameGetterFn,
-                          std::string const & osmToFeatureFile, bool disableCrossMwmProgress);
+                          std::string const & osmToFeatureFile, bool disableCrossMwmProgress,
+                          size_t threadsCount = 1);
+// Builds shortcut overlay section for car routing. Routing section should be built before.
+bool BuildShortcutOverlaySection(std::string const & path, std::string const & mwmFile,
+                                 std::string const & country,
+                                 CountryParentNameGetterFn const & countryParentNameGetterFn);
 }  // namespace routing
@@ -1,9 +1,14 @@
 #include "search_index_builder.hpp"
 
+#include "generator/parallel_utils.hpp"
+
+#include "search/categories_cache.hpp"
+#include "search/category_bitmaps_table.hpp"
 #include "search/common.hpp"
 #include "search/reverse_geocoder.hpp"
 #include "search/search_index_values.hpp"
 #include "search/search_trie.hpp"
+#include "search/streets_houses_table.hpp"
 #include "search/types_skipper.hpp"
 
 #include "indexer/categories_holder.hpp"
@@ -39,6 +44,8 @@
 #include <fstream>
 #include <initializer_list>
 #include <limits>
+#include <map>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -324,7 +331,38 @@ void AddFeatureNameIndexPairs(FeaturesVectorTest const & features,
       synonyms.get(), keyValuePairs, categoriesHolder, header.GetScaleRange(), valueBuilder));
 }
 
-void BuildAddressTable(FilesContainerR & container, Writer & writer)
+// Category keys are added by FeatureInserter, so features of a precomputed category are
+// exactly the features the search index has for the key of the category.
+template <typename TKey, typename TValue>
+void BuildCategoryBitmaps(vector<pair<TKey, TValue>> const & keyValuePairs, Writer & writer)
+{
+  Classificator const & c = classif();
+
+  search::CategoryBitmapsTable::Builder builder;
+  map<TKey, uint32_t> keyToType;
+  search::ForEachPrecomputedCategoryType([&](uint32_t type) {
+    strings::UniString const category = search::FeatureTypeToString(c.GetIndexForType(type));
+    TKey key;
+    key.reserve(category.size() + 1);
+    key.push_back(search::kCategoriesLang);
+    key.append(category.begin(), category.end());
+    keyToType.emplace(key, type);
+    builder.AddType(type);
+  });
+
+  for (auto const & kv : keyValuePairs)
+  {
+    auto const it = keyToType.find(kv.first);
+    if (it != keyToType.end())
+      builder.Add(it->second, kv.second.m_featureId);
+  }
+
+  builder.Serialize(writer);
+  LOG(LINFO, ("Category bitmaps for", builder.GetNumCategories(), "categories"));
+}
+
+void BuildAddressTable(FilesContainerR & container, Writer & writer,
+                       Writer & streetsHousesWriter)
 {
   ReaderSource<ModelReaderPtr> src = container.GetReader(SEARCH_TOKENS_FILE_TAG);
   uint32_t address = 0, missing = 0;
@@ -336,28 +374,39 @@ void BuildAddressTable(FilesContainerR & container, Writer & writer)
   ASSERT_EQUAL(res.second, MwmSet::RegResult::Success, ());
   search::ReverseGeocoder rgc(mwmIndex);
 
+  auto const & buildingChecker = ftypes::IsBuildingChecker::Instance();
+  search::StreetsHousesTable::Builder streetsHouses;
+  uint32_t numFeatures = 0;
+
   {
     FixedBitsDDVector<3, FileReader>::Builder<Writer> building2Street(writer);
 
+    using TStreet = search::ReverseGeocoder::Street;
+    vector<TStreet> streets;
+
     FeaturesVectorTest features(container);
     for (uint32_t index = 0; src.Size() > 0; ++index)
     {
       feature::AddressData data;
       data.Deserialize(src);
 
+      FeatureType ft;
+      features.GetVector().GetByIndex(index, ft);
+      ft.SetID({res.first, index});
+
+      // Search matches houses with streets only for buildings and
+      // features with house numbers, see search::Model.
+      bool const isHouse = !ft.GetHouseNumber().empty() || buildingChecker(ft);
+
       size_t streetIndex = 0;
       bool streetMatched = false;
       strings::UniString const street = search::GetStreetNameAsKey(data.Get(feature::AddressData::STREET));
-      if (!street.empty())
-      {
-        FeatureType ft;
-        features.GetVector().GetByIndex(index, ft);
-        ft.SetID({res.first, index});
-
-        using TStreet = search::ReverseGeocoder::Street;
-        vector<TStreet> streets;
+      streets.clear();
+      if (!street.empty() || isHouse)
         rgc.GetNearbyStreets(ft, streets);
 
+      if (!street.empty())
+      {
         streetIndex = rgc.GetMatchedStreetIndex(street, streets);
         if (streetIndex < streets.size())
         {
@@ -374,11 +423,32 @@ void BuildAddressTable(FilesContainerR & container, Writer & writer)
         building2Street.PushBack(base::checked_cast<decltype(building2Street)::ValueType>(streetIndex));
       else
         building2Street.PushBackUndefined();
+
+      if (isHouse)
+      {
+        // Mirrors search::FeaturesLayerMatcher::GetMatchingStreet()
+        // for features which are not edited.
+        auto const it = find_if(streets.begin(), streets.end(), [](TStreet const & s) {
+          return s.m_distanceMeters > search::ReverseGeocoder::kLookupRadiusM;
+        });
+        size_t const numNearby = distance(streets.begin(), it);
+        if (streetMatched && streetIndex < numNearby)
+          streetsHouses.Add(index, streets[streetIndex].m_id.m_index);
+        else if (numNearby != 0 &&
+                 streets[0].m_distanceMeters < search::ReverseGeocoder::kMaxApproxStreetDistanceM)
+          streetsHouses.Add(index, streets[0].m_id.m_index);
+      }
+
+      numFeatures = index + 1;
     }
 
     LOG(LINFO, ("Address: Building -> Street (opt, all)", building2Street.GetCount()));
   }
 
+  streetsHouses.SetNumFeatures(numFeatures);
+  streetsHouses.Serialize(streetsHousesWriter);
+  LOG(LINFO, ("Address: Streets <-> Houses pairs", streetsHouses.GetNumPairs()));
+
   double matchedPercent = 100;
   if (address > 0)
     matchedPercent = 100.0 * (1.0 - static_cast<double>(missing) / static_cast<double>(address));
@@ -389,7 +459,8 @@ void BuildAddressTable(FilesContainerR & container, Writer & writer)
 
 namespace indexer
 {
-bool BuildSearchIndexFromDataFile(string const & filename, bool forceRebuild)
+bool BuildSearchIndexFromDataFile(string const & filename, bool forceRebuild,
+                                  size_t threadsCount)
 {
   Platform & platform = GetPlatform();
 
@@ -409,18 +480,32 @@ bool BuildSearchIndexFromDataFile(string const & filename, bool forceRebuild)
         mwmName + "." SEARCH_ADDRESS_FILE_TAG EXTENSION_TMP);
   MY_SCOPE_GUARD(addrFileGuard, bind(&FileWriter::DeleteFileX, addrFilePath));
 
+  string const streetsHousesFilePath = platform.WritablePathForFile(
+        mwmName + "." SEARCH_STREETS_HOUSES_FILE_TAG EXTENSION_TMP);
+  MY_SCOPE_GUARD(streetsHousesFileGuard,
+                 bind(&FileWriter::DeleteFileX, streetsHousesFilePath));
+
+  string const categoryBitmapsFilePath = platform.WritablePathForFile(
+        mwmName + "." SEARCH_CATEGORY_BITMAPS_FILE_TAG EXTENSION_TMP);
+  MY_SCOPE_GUARD(categoryBitmapsFileGuard,
+                 bind(&FileWriter::DeleteFileX, categoryBitmapsFilePath));
+
   try
   {
     {
       FileWriter writer(indexFilePath);
-      BuildSearchIndex(readContainer, writer);
+      FileWriter categoryBitmapsWriter(categoryBitmapsFilePath);
+      BuildSearchIndex(readContainer, writer, threadsCount, &categoryBitmapsWriter);
       LOG(LINFO, ("Search index size =", writer.Size()));
+      LOG(LINFO, ("Search category bitmaps size =", categoryBitmapsWriter.Size()));
     }
     if (filename != WORLD_FILE_NAME && filename != WORLD_COASTS_FILE_NAME)
     {
       FileWriter writer(addrFilePath);
-      BuildAddressTable(readContainer, writer);
+      FileWriter streetsHousesWriter(streetsHousesFilePath);
+      BuildAddressTable(readContainer, writer, streetsHousesWriter);
       LOG(LINFO, ("Search address table size =", writer.Size()));
+      LOG(LINFO, ("Search streets-houses table size =", streetsHousesWriter.Size()));
     }
     {
       // The behaviour of generator_tool's generate_search_index
@@ -448,6 +533,16 @@ bool BuildSearchIndexFromDataFile(string const & filename, bool forceRebuild)
         FilesContainerW writeContainer(readContainer.GetFileName(), FileWriter::OP_WRITE_EXISTING);
         writeContainer.Write(addrFilePath, SEARCH_ADDRESS_FILE_TAG);
       }
+
+      {
+        FilesContainerW writeContainer(readContainer.GetFileName(), FileWriter::OP_WRITE_EXISTING);
+        writeContainer.Write(streetsHousesFilePath, SEARCH_STREETS_HOUSES_FILE_TAG);
+      }
+
+      {
+        FilesContainerW writeContainer(readContainer.GetFileName(), FileWriter::OP_WRITE_EXISTING);
+        writeContainer.Write(categoryBitmapsFilePath, SEARCH_CATEGORY_BITMAPS_FILE_TAG);
+      }
     }
   }
   catch (Reader::Exception const & e)
@@ -464,7 +559,8 @@ bool BuildSearchIndexFromDataFile(string const & filename, bool forceRebuild)
   return true;
 }
 
-void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter)
+void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter, size_t threadsCount,
+                      Writer * categoryBitmapsWriter)
 {
   using TKey = strings::UniString;
   using TValue = FeatureIndexValue;
@@ -480,14 +576,53 @@ void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter)
   auto codingParams = trie::GetCodingParams(features.GetHeader().GetDefCodingParams());
   SingleValueSerializer<TValue> serializer(codingParams);
 
-  vector<pair<TKey, TValue>> searchIndexKeyValuePairs;
-  AddFeatureNameIndexPairs(features, categoriesHolder, searchIndexKeyValuePairs);
+  using TKeyValuePairs = vector<pair<TKey, TValue>>;
+  using TValueList = ValueList<TValue>;
 
-  sort(searchIndexKeyValuePairs.begin(), searchIndexKeyValuePairs.end());
-  LOG(LINFO, ("End sorting strings:", timer.ElapsedSeconds()));
+  // Every key starts with a language, so keys of different languages make independent
+  // subtries of the root. They are sorted and written to memory on several threads and then
+  // the root joins them.
+  vector<TKeyValuePairs> partitions;
+  {
+    TKeyValuePairs searchIndexKeyValuePairs;
+    AddFeatureNameIndexPairs(features, categoriesHolder, searchIndexKeyValuePairs);
+    if (categoryBitmapsWriter)
+      BuildCategoryBitmaps(searchIndexKeyValuePairs, *categoryBitmapsWriter);
 
-  trie::Build<Writer, TKey, ValueList<TValue>, SingleValueSerializer<TValue>>(
-      indexWriter, serializer, searchIndexKeyValuePairs);
+    map<strings::UniChar, TKeyValuePairs> langToPairs;
+    for (auto & kv : searchIndexKeyValuePairs)
+    {
+      CHECK(!kv.first.empty(), ());
+      langToPairs[kv.first[0]].push_back(move(kv));
+    }
+    for (auto & langPairs : langToPairs)
+      partitions.push_back(move(langPairs.second));
+  }
+  LOG(LINFO, ("End collecting strings:", timer.ElapsedSeconds()));
+
+  using TNodeInfo = trie::NodeInfo<TValueList>;
+  vector<vector<uint8_t>> subtries(partitions.size());
+  vector<unique_ptr<TNodeInfo>> subtrieRoots(partitions.size());
+  generator::ForEachIndexInParallel(threadsCount, partitions.size(), [&](size_t i) {
+    auto & pairs = partitions[i];
+    sort(pairs.begin(), pairs.end());
+
+    MemWriter<vector<uint8_t>> writer(subtries[i]);
+    subtrieRoots[i] = make_unique<TNodeInfo>(trie::WriteNodesExceptRoot<Writer, TValueList>(
+        writer, serializer, pairs.begin(), pairs.end()));
+    TKeyValuePairs().swap(pairs);
+  });
+  LOG(LINFO, ("End building subtries:", timer.ElapsedSeconds()));
+
+  vector<TNodeInfo> roots;
+  roots.reserve(subtrieRoots.size());
+  for (size_t i = 0; i < subtries.size(); ++i)
+  {
+    indexWriter.Write(subtries[i].data(), subtries[i].size());
+    vector<uint8_t>().swap(subtries[i]);
+    roots.push_back(move(*subtrieRoots[i]));
+  }
+  trie::WriteRoot(indexWriter, serializer, roots);
 
   LOG(LINFO, ("End building search index, elapsed seconds:", timer.ElapsedSeconds()));
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 
 class FilesContainerR;
@@ -11,7 +12,12 @@ namespace indexer
 // An attempt to rewrite the search index of an old mwm may result in a future crash
 // when using search because this function does not update mwm's version. This results
 // in version mismatch when trying to read the index.
-bool BuildSearchIndexFromDataFile(std::string const & filename, bool forceRebuild = false);
+// Subtries of the search index are built on |threadsCount| threads.
+bool BuildSearchIndexFromDataFile(std::string const & filename, bool forceRebuild = false,
+                                  size_t threadsCount = 1);
 
-void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter);
+// Features of categories from search::ForEachPrecomputedCategoryType() are written to
+// |categoryBitmapsWriter| if it's not nullptr, see search::CategoryBitmapsTable.
+void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter, size_t threadsCount = 1,
+                      Writer * categoryBitmapsWriter = nullptr);
 }  // namespace indexer
@@ -0,0 +1,72 @@
+#include "generator/sections_manifest.hpp"
+
+#include "coding/file_container.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/reader.hpp"
+
+#include "base/logging.hpp"
+#include "base/stl_add.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include "boost/crc.hpp"
+
+namespace generator
+{
+std::vector<SectionHash> GetSectionHashes(std::string const & mwmPath)
+{
+  FilesContainerR container(mwmPath);
+  std::vector<std::string> tags;
+  container.ForEachTag(MakeBackInsertFunctor(tags));
+  std::sort(tags.begin(), tags.end());
+
+  std::vector<char> buffer(1024 * 1024);
+  std::vector<SectionHash> hashes;
+  hashes.reserve(tags.size());
+  for (auto const & tag : tags)
+  {
+    ReaderSource<FilesContainerR::TReader> src(container.GetReader(tag));
+
+    SectionHash hash;
+    hash.m_tag = tag;
+    hash.m_size = src.Size();
+
+    boost::crc_32_type crc;
+    while (src.Size() > 0)
+    {
+      size_t const size = static_cast<size_t>(std::min<uint64_t>(src.Size(), buffer.size()));
+      src.Read(buffer.data(), size);
+      crc.process_bytes(buffer.data(), size);
+    }
+    hash.m_crc32 = crc.checksum();
+
+    hashes.push_back(hash);
+  }
+  return hashes;
+}
+
+bool WriteSectionsManifest(std::string const & mwmPath, std::string const & manifestPath)
+{
+  try
+  {
+    std::ostringstream os;
+    for (auto const & hash : GetSectionHashes(mwmPath))
+    {
+      os << hash.m_tag << ' ' << hash.m_size << ' ' << std::hex << std::setw(8)
+         << std::setfill('0') << hash.m_crc32 << std::dec << '\n';
+    }
+
+    std::string const manifest = os.str();
+    FileWriter writer(manifestPath);
+    writer.Write(manifest.data(), manifest.size());
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Can't write sections manifest of", mwmPath, "to", manifestPath, e.Msg()));
+    return false;
+  }
+  return true;
+}
+}  // namespace generator
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace generator
+{
+struct SectionHash
+{
+  std::string m_tag;
+  uint64_t m_size = 0;
+  uint32_t m_crc32 = 0;
+};
+
+// Returns sizes and CRC32 of contents of all sections of |mwmPath| sorted by tags, so
+// the result doesn't depend on the order in which sections were written.
+std::vector<SectionHash> GetSectionHashes(std::string const & mwmPath);
+
+// Writes "tag size crc32" lines for all sections of |mwmPath| to |manifestPath|. Manifests
+// of reproducible builds of the same data must be equal, which is checked by a plain diff.
+bool WriteSectionsManifest(std::string const & mwmPath, std::string const & manifestPath);
+}  // namespace generator
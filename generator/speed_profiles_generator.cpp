@@ -0,0 +1,139 @@
+#include "generator/speed_profiles_generator.hpp"
+
+#include "generator/osm_id.hpp"
+#include "generator/routing_helpers.hpp"
+
+#include "routing/segment.hpp"
+#include "routing/speed_profiles.hpp"
+#include "routing/speed_profiles_serialization.hpp"
+
+#include "coding/file_container.hpp"
+#include "coding/file_writer.hpp"
+
+#include "base/logging.hpp"
+#include "base/string_utils.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+
+#include "defines.hpp"
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+char constexpr kDelim[] = ", \t\r\n";
+
+bool ParseSpeedProfiles(string const & speedProfilesPath,
+                        map<osm::Id, uint32_t> const & osmIdToFeatureId, SpeedProfiles & profiles)
+{
+  ifstream stream(speedProfilesPath);
+  if (!stream)
+  {
+    LOG(LWARNING, ("Could not open", speedProfilesPath));
+    return false;
+  }
+
+  map<SpeedProfiles::Profile, uint32_t> profileIds;
+  string line;
+  for (uint32_t lineNo = 1; getline(stream, line); ++lineNo)
+  {
+    strings::SimpleTokenizer iter(line, kDelim);
+
+    uint64_t osmId;
+    if (!iter || !strings::to_uint64(*iter, osmId))
+    {
+      LOG(LERROR, ("Error when parsing speed profiles: bad osm id at line", lineNo));
+      return false;
+    }
+    ++iter;
+
+    uint32_t segmentIdx;
+    if (!iter || !strings::to_uint(*iter, segmentIdx))
+    {
+      LOG(LERROR, ("Error when parsing speed profiles: bad segment idx at line", lineNo));
+      return false;
+    }
+    ++iter;
+
+    uint32_t forward;
+    if (!iter || !strings::to_uint(*iter, forward) || forward > 1)
+    {
+      LOG(LERROR, ("Error when parsing speed profiles: bad direction at line", lineNo));
+      return false;
+    }
+    ++iter;
+
+    SpeedProfiles::Profile profile;
+    for (auto & speed : profile)
+    {
+      uint32_t percent;
+      if (!iter || !strings::to_uint(*iter, percent) || percent > SpeedProfiles::kMaxSpeedPercent)
+      {
+        LOG(LERROR, ("Error when parsing speed profiles: bad speed at line", lineNo));
+        return false;
+      }
+      speed = static_cast<uint8_t>(percent);
+      ++iter;
+    }
+
+    if (iter)
+    {
+      LOG(LERROR, ("Error when parsing speed profiles: too many speeds at line", lineNo));
+      return false;
+    }
+
+    auto const it = osmIdToFeatureId.find(osm::Id::Way(osmId));
+    // The way is not a feature of the mwm. For example, it belongs to another mwm.
+    if (it == osmIdToFeatureId.cend())
+      continue;
+
+    auto const emplaceRes = profileIds.emplace(profile, 0);
+    if (emplaceRes.second)
+      emplaceRes.first->second = profiles.AddProfile(profile);
+
+    profiles.SetProfile(Segment(kFakeNumMwmId, it->second, segmentIdx, forward == 1),
+                        emplaceRes.first->second);
+  }
+
+  return true;
+}
+}  // namespace
+
+namespace routing
+{
+bool BuildSpeedProfilesSection(string const & mwmFile, string const & speedProfilesPath,
+                               string const & osmIdsToFeatureIdsPath)
+{
+  LOG(LINFO, ("Generating speed profiles for", mwmFile));
+
+  map<osm::Id, uint32_t> osmIdToFeatureId;
+  if (!ParseOsmIdToFeatureIdMapping(osmIdsToFeatureIdsPath, osmIdToFeatureId))
+  {
+    LOG(LWARNING, ("An error happened while parsing feature id to osm ids mapping from file:",
+                   osmIdsToFeatureIdsPath));
+    return false;
+  }
+
+  SpeedProfiles profiles;
+  if (!ParseSpeedProfiles(speedProfilesPath, osmIdToFeatureId, profiles))
+    return false;
+
+  if (profiles.IsEmpty())
+  {
+    LOG(LINFO, ("There are no speed profiles for", mwmFile));
+    return true;
+  }
+
+  FilesContainerW cont(mwmFile, FileWriter::OP_WRITE_EXISTING);
+  FileWriter writer = cont.GetWriter(SPEED_PROFILES_FILE_TAG);
+  SpeedProfilesSerializer::Serialize(profiles, writer);
+
+  LOG(LINFO, (SPEED_PROFILES_FILE_TAG, "section is built for", mwmFile, ":",
+              profiles.GetNumSegments(), "segments,", profiles.GetNumProfiles(), "profiles"));
+  return true;
+}
+}  // namespace routing
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <string>
+
+namespace routing
+{
+// Builds the section with historical speeds of car roads from |speedProfilesPath|.
+// Every line of the csv file is a speed profile of a segment:
+// osm way id, segment idx, forward (0 or 1) and SpeedProfiles::kBucketsPerDay speeds
+// in percents of the road speed. 0 means that there's no historical speed of the bucket.
+// Segments with equal speeds share one profile in the section.
+bool BuildSpeedProfilesSection(std::string const & mwmFile, std::string const & speedProfilesPath,
+                               std::string const & osmIdsToFeatureIdsPath);
+}  // namespace routing
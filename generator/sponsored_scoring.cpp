@@ -10,7 +10,7 @@
 
 namespace
 {
-using WeightedBagOfWords = std::vector<std::pair<strings::UniString, double>>;
+using generator::impl::WeightedBagOfWords;
 
 std::vector<strings::UniString> StringToWords(std::string const & str)
 {
@@ -92,11 +92,13 @@ double GetLinearNormDistanceScore(double distance, double const maxDistance)
   return 1.0 - distance / maxDistance;
 }
 
-double GetNameSimilarityScore(std::string const & booking_name, std::string const & osm_name)
+WeightedBagOfWords MakeWeightedBagOfWords(std::string const & name)
 {
-  auto const aws = MakeWeightedBagOfWords(StringToWords(booking_name));
-  auto const bws = MakeWeightedBagOfWords(StringToWords(osm_name));
+  return ::MakeWeightedBagOfWords(StringToWords(name));
+}
 
+double GetNameSimilarityScore(WeightedBagOfWords const & aws, WeightedBagOfWords const & bws)
+{
   if (aws.empty() && bws.empty())
     return 1.0;
   if (aws.empty() || bws.empty())
@@ -104,5 +106,11 @@ double GetNameSimilarityScore(std::string const & booking_name, std::string cons
 
   return WeightedBagOfWordsCos(aws, bws);
 }
+
+double GetNameSimilarityScore(std::string const & booking_name, std::string const & osm_name)
+{
+  return GetNameSimilarityScore(MakeWeightedBagOfWords(booking_name),
+                                MakeWeightedBagOfWords(osm_name));
+}
 }  // namespace impl
 }  // namespace generator
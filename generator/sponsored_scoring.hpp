@@ -1,6 +1,10 @@
 #pragma once
 
+#include "base/string_utils.hpp"
+
 #include <string>
+#include <utility>
+#include <vector>
 
 class FeatureBuilder1;
 
@@ -8,7 +12,14 @@ namespace generator
 {
 namespace impl
 {
+/// Normalized words of a name with their weights, sorted by words.
+using WeightedBagOfWords = std::vector<std::pair<strings::UniString, double>>;
+
 double GetLinearNormDistanceScore(double distance, double maxDistance);
+
+/// Names are compared many times, so they should be converted to bags of words once.
+WeightedBagOfWords MakeWeightedBagOfWords(std::string const & name);
+double GetNameSimilarityScore(WeightedBagOfWords const & lhs, WeightedBagOfWords const & rhs);
 double GetNameSimilarityScore(std::string const & booking_name, std::string const & osm_name);
 }  // namespace impl
 
@@ -30,5 +41,10 @@ struct MatchStats
 /// Matches a given sponsored object against a given OSM object.
 template <typename SponsoredObject>
 MatchStats<SponsoredObject> Match(SponsoredObject const & o, FeatureBuilder1 const & fb);
+
+/// The same as above but the name of |fb| is already converted by MakeWeightedBagOfWords().
+template <typename SponsoredObject>
+MatchStats<SponsoredObject> Match(SponsoredObject const & o, FeatureBuilder1 const & fb,
+                                  impl::WeightedBagOfWords const & fbName);
 }  // namespace booking_scoring
 }  // namespace generator
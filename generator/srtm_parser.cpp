@@ -1,12 +1,17 @@
 #include "generator/srtm_parser.hpp"
 
 #include "coding/endianness.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
+#include "coding/mmap_reader.hpp"
 #include "coding/zip_reader.hpp"
 
 #include "base/logging.hpp"
 
+#include <functional>
 #include <iomanip>
 #include <sstream>
+#include <thread>
 
 namespace generator
 {
@@ -41,16 +46,76 @@ SrtmTile::SrtmTile()
   Invalidate();
 }
 
-SrtmTile::SrtmTile(SrtmTile && rhs) : m_data(move(rhs.m_data)), m_valid(rhs.m_valid)
+SrtmTile::SrtmTile(SrtmTile && rhs)
+  : m_data(move(rhs.m_data)), m_mapped(move(rhs.m_mapped)), m_valid(rhs.m_valid)
 {
   rhs.Invalidate();
 }
 
-void SrtmTile::Init(std::string const & dir, ms::LatLon const & coord)
+SrtmTile::~SrtmTile() {}
+
+void SrtmTile::Init(std::string const & dir, ms::LatLon const & coord,
+                    std::string const & cacheDir)
 {
   Invalidate();
 
   std::string const base = GetBase(coord);
+  if (cacheDir.empty())
+  {
+    Unzip(dir, base);
+    return;
+  }
+
+  std::string const cacheFile = cacheDir + base + ".hgt";
+  if (InitFromCache(cacheFile))
+    return;
+
+  Unzip(dir, base);
+  if (!IsValid())
+    return;
+
+  // Several generators may share the cache, so the tile is written to a unique temporary
+  // file which is renamed then.
+  std::string const tmpFile =
+      cacheFile + ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+  {
+    FileWriter writer(tmpFile);
+    writer.Write(m_data.data(), m_data.size());
+  }
+  if (!my::RenameFileX(tmpFile, cacheFile))
+  {
+    LOG(LWARNING, ("Can't store SRTM tile to cache:", cacheFile));
+    my::DeleteFileX(tmpFile);
+    return;
+  }
+
+  InitFromCache(cacheFile);
+}
+
+bool SrtmTile::InitFromCache(std::string const & cacheFile)
+{
+  uint64_t size = 0;
+  if (!my::GetFileSize(cacheFile, size) || size != kSrtmTileSize)
+    return false;
+
+  try
+  {
+    m_mapped = make_unique<MmapReader>(cacheFile);
+  }
+  catch (Reader::OpenException const & e)
+  {
+    LOG(LWARNING, ("Can't map cached SRTM tile:", cacheFile, "reason:", e.Msg()));
+    return false;
+  }
+
+  m_data.clear();
+  m_data.shrink_to_fit();
+  m_valid = true;
+  return true;
+}
+
+void SrtmTile::Unzip(std::string const & dir, std::string const & base)
+{
   std::string const cont = dir + base + ".SRTMGL1.hgt.zip";
   std::string file = base + ".hgt";
 
@@ -84,7 +149,7 @@ void SrtmTile::Init(std::string const & dir, ms::LatLon const & coord)
   m_valid = true;
 }
 
-feature::TAltitude SrtmTile::GetHeight(ms::LatLon const & coord)
+feature::TAltitude SrtmTile::GetHeight(ms::LatLon const & coord) const
 {
   if (!IsValid())
     return feature::kInvalidAltitude;
@@ -136,36 +201,73 @@ std::string SrtmTile::GetBase(ms::LatLon coord)
   return ss.str();
 }
 
+feature::TAltitude const * SrtmTile::Data() const
+{
+  if (m_mapped)
+    return reinterpret_cast<feature::TAltitude const *>(m_mapped->Data());
+  return reinterpret_cast<feature::TAltitude const *>(m_data.data());
+}
+
+size_t SrtmTile::Size() const
+{
+  if (m_mapped)
+    return m_mapped->Size() / sizeof(feature::TAltitude);
+  return m_data.size() / sizeof(feature::TAltitude);
+}
+
 void SrtmTile::Invalidate()
 {
   m_data.clear();
   m_data.shrink_to_fit();
+  m_mapped.reset();
   m_valid = false;
 }
 
 // SrtmTileManager ---------------------------------------------------------------------------------
-SrtmTileManager::SrtmTileManager(std::string const & dir) : m_dir(dir) {}
+SrtmTileManager::SrtmTileManager(std::string const & dir, std::string const & cacheDir,
+                                 size_t maxTiles)
+  : m_dir(dir), m_cacheDir(cacheDir), m_maxTiles(maxTiles)
+{
+}
+
 feature::TAltitude SrtmTileManager::GetHeight(ms::LatLon const & coord)
+{
+  // The tile is used out of the lock, it's alive even if it's released from the cache meanwhile.
+  return GetTile(coord)->GetHeight(coord);
+}
+
+SrtmTileManager::TTilePtr SrtmTileManager::GetTile(ms::LatLon const & coord)
 {
   std::string const base = SrtmTile::GetBase(coord);
-  auto it = m_tiles.find(base);
-  if (it == m_tiles.end())
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_index.find(base);
+  if (it != m_index.end())
   {
-    SrtmTile tile;
-    try
-    {
-      tile.Init(m_dir, coord);
-    }
-    catch (RootException const & e)
-    {
-      LOG(LINFO, ("Can't init SRTM tile:", base, "reason:", e.Msg()));
-    }
+    m_tiles.splice(m_tiles.begin(), m_tiles, it->second);
+    return it->second->second;
+  }
 
-    // It's OK to store even invalid tiles and return invalid height
-    // for them later.
-    it = m_tiles.emplace(base, std::move(tile)).first;
+  auto tile = std::make_shared<SrtmTile>();
+  try
+  {
+    tile->Init(m_dir, coord, m_cacheDir);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LINFO, ("Can't init SRTM tile:", base, "reason:", e.Msg()));
   }
 
-  return it->second.GetHeight(coord);
+  // It's OK to store even invalid tiles and return invalid height
+  // for them later.
+  m_tiles.emplace_front(base, tile);
+  m_index[base] = m_tiles.begin();
+
+  if (m_maxTiles != 0 && m_tiles.size() > m_maxTiles)
+  {
+    m_index.erase(m_tiles.back().first);
+    m_tiles.pop_back();
+  }
+  return tile;
 }
 }  // namespace generator
@@ -7,8 +7,14 @@
 #include "base/macros.hpp"
 
 #include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <utility>
+
+class MmapReader;
 
 namespace generator
 {
@@ -17,40 +23,60 @@ class SrtmTile
 public:
   SrtmTile();
   SrtmTile(SrtmTile && rhs);
+  ~SrtmTile();
 
-  void Init(std::string const & dir, ms::LatLon const & coord);
+  // Unzips the tile from |dir|. If |cacheDir| is not empty the decompressed tile is
+  // mapped from |cacheDir|, it's stored there on the first use.
+  void Init(std::string const & dir, ms::LatLon const & coord,
+            std::string const & cacheDir = std::string());
 
   inline bool IsValid() const { return m_valid; }
   // Returns height in meters at |coord| or kInvalidAltitude.
-  feature::TAltitude GetHeight(ms::LatLon const & coord);
+  feature::TAltitude GetHeight(ms::LatLon const & coord) const;
 
   static std::string GetBase(ms::LatLon coord);
 
 private:
-  inline feature::TAltitude const * Data() const
-  {
-    return reinterpret_cast<feature::TAltitude const *>(m_data.data());
-  };
+  bool InitFromCache(std::string const & cacheFile);
+  void Unzip(std::string const & dir, std::string const & base);
 
-  inline size_t Size() const { return m_data.size() / sizeof(feature::TAltitude); }
+  feature::TAltitude const * Data() const;
+  size_t Size() const;
   void Invalidate();
 
   std::string m_data;
+  std::unique_ptr<MmapReader> m_mapped;
   bool m_valid;
 
   DISALLOW_COPY(SrtmTile);
 };
 
+// Thread-safe cache of SRTM tiles.
 class SrtmTileManager
 {
 public:
-  SrtmTileManager(std::string const & dir);
+  // See SrtmTile::Init() about |cacheDir|. If |maxTiles| is not 0 the least recently used
+  // tiles are released when there are more tiles. Mapped tiles are cheap to load again,
+  // while unzipping a tile takes much longer.
+  explicit SrtmTileManager(std::string const & dir, std::string const & cacheDir = std::string(),
+                           size_t maxTiles = 0);
 
   feature::TAltitude GetHeight(ms::LatLon const & coord);
 
 private:
+  using TTilePtr = std::shared_ptr<SrtmTile>;
+  // Tiles from the most recently used to the least recently used one.
+  using TTiles = std::list<std::pair<std::string, TTilePtr>>;
+
+  TTilePtr GetTile(ms::LatLon const & coord);
+
   std::string m_dir;
-  std::unordered_map<std::string, SrtmTile> m_tiles;
+  std::string m_cacheDir;
+  size_t m_maxTiles;
+
+  std::mutex m_mutex;
+  TTiles m_tiles;
+  std::unordered_map<std::string, TTiles::iterator> m_index;
 
   DISALLOW_COPY(SrtmTileManager);
 };
@@ -104,13 +104,14 @@ public:
     }
   }
 
-  void operator()(OsmElement * e)
+  void operator()(OsmElement * e) const
   {
-    if (e->type == OsmElement::EntityType::Way && m_ways.find(e->id) != m_ways.end())
+    auto const wayIt = e->type == OsmElement::EntityType::Way ? m_ways.find(e->id) : m_ways.end();
+    if (wayIt != m_ways.end())
     {
       // Exclude ferry routes.
       if (find(e->Tags().begin(), e->Tags().end(), m_ferryTag) == e->Tags().end())
-        e->AddTag("highway", m_ways[e->id]);
+        e->AddTag("highway", wayIt->second);
     }
     else if (e->type == OsmElement::EntityType::Node && m_capitals.find(e->id) != m_capitals.end())
     {
@@ -166,7 +167,7 @@ public:
     }
   }
 
-  void operator()(OsmElement * p)
+  void operator()(OsmElement * p) const
   {
     for (auto & tag : p->m_tags)
     {
@@ -223,7 +224,7 @@ public:
     }
   }
 
-  void operator()(OsmElement * p)
+  void operator()(OsmElement * p) const
   {
     std::pair<OsmElement::EntityType, uint64_t> elementId = {p->type, p->id};
     auto elements = m_elements.find(elementId);
@@ -1,5 +1,7 @@
 #include "generator/traffic_generator.hpp"
 
+#include "generator/parallel_utils.hpp"
+
 #include "routing/routing_helpers.hpp"
 
 #include "traffic/traffic_info.hpp"
@@ -11,20 +13,74 @@
 #include "indexer/feature_algo.hpp"
 #include "indexer/feature_processor.hpp"
 #include "indexer/features_offsets_table.hpp"
+#include "indexer/features_vector.hpp"
 
 #include "coding/file_container.hpp"
 #include "coding/file_writer.hpp"
 
+#include <algorithm>
+#include <memory>
+#include <numeric>
 #include <vector>
 
 namespace traffic
 {
-bool GenerateTrafficKeysFromDataFile(std::string const & mwmPath)
+namespace
+{
+// Number of consecutive features which are read by a thread at once.
+uint32_t constexpr kFeaturesRangeSize = 4096;
+
+// Features are split into ranges of consecutive indices, and every thread reads features by
+// its own FeaturesVectorTest. Keys of ranges are joined in the order of ranges, so they are
+// sorted just like keys of TrafficInfo::ExtractTrafficKeys().
+void ExtractTrafficKeys(std::string const & mwmPath, size_t threadsCount,
+                        std::vector<TrafficInfo::RoadSegmentId> & result)
+{
+  size_t numFeatures = 0;
+  {
+    FeaturesVectorTest features(mwmPath);
+    numFeatures = features.GetVector().GetNumFeatures();
+  }
+
+  // Features can't be read by indices without the offsets table.
+  if (threadsCount <= 1 || numFeatures == 0)
+  {
+    TrafficInfo::ExtractTrafficKeys(mwmPath, result);
+    return;
+  }
+
+  size_t const numRanges = (numFeatures + kFeaturesRangeSize - 1) / kFeaturesRangeSize;
+  std::vector<std::vector<TrafficInfo::RoadSegmentId>> rangeKeys(numRanges);
+  generator::ForEachIndexWithWorkers(threadsCount, numRanges, [&]() {
+    auto features = std::make_shared<FeaturesVectorTest>(mwmPath);
+    return [&, features](size_t i) {
+      auto const begin = static_cast<uint32_t>(i * kFeaturesRangeSize);
+      auto const end = static_cast<uint32_t>(
+          std::min(numFeatures, static_cast<size_t>(begin) + kFeaturesRangeSize));
+      std::vector<uint32_t> indices(end - begin);
+      std::iota(indices.begin(), indices.end(), begin);
+      features->GetVector().ForEachByIndices(indices, [&](FeatureType & ft, uint32_t fid) {
+        TrafficInfo::AppendTrafficKeys(ft, fid, rangeKeys[i]);
+      });
+    };
+  });
+
+  result.clear();
+  for (auto & keys : rangeKeys)
+  {
+    result.insert(result.end(), keys.begin(), keys.end());
+    std::vector<TrafficInfo::RoadSegmentId>().swap(keys);
+  }
+  ASSERT(std::is_sorted(result.begin(), result.end()), ());
+}
+}  // namespace
+
+bool GenerateTrafficKeysFromDataFile(std::string const & mwmPath, size_t threadsCount)
 {
   try
   {
     std::vector<TrafficInfo::RoadSegmentId> keys;
-    TrafficInfo::ExtractTrafficKeys(mwmPath, keys);
+    ExtractTrafficKeys(mwmPath, threadsCount, keys);
 
     std::vector<uint8_t> buf;
     TrafficInfo::SerializeTrafficKeys(keys, buf);
@@ -1,8 +1,9 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 
 namespace traffic
 {
-bool GenerateTrafficKeysFromDataFile(std::string const & mwmPath);
+bool GenerateTrafficKeysFromDataFile(std::string const & mwmPath, size_t threadsCount = 1);
 }  // namespace traffic
@@ -121,6 +121,7 @@ void BuildTransit(string const & mwmPath, string const & transitDir)
   header.m_gatesOffset = base::checked_cast<uint32_t>(w.Pos() - startOffset);
 
   // @TODO(bykoianko) Gates should be added after stops but before edges.
+  header.m_edgesOffset = base::checked_cast<uint32_t>(w.Pos() - startOffset);
 
   SerializeObject<Edge>(root, "edges", serializer);
   header.m_transfersOffset = base::checked_cast<uint32_t>(w.Pos() - startOffset);
@@ -90,6 +90,39 @@ bool UGCDB::Exec(std::string const & statement)
   return true;
 }
 
+bool UGCDB::ForEachSorted(
+    std::function<void(osm::Id const & id, std::string const & value)> const & fn)
+{
+  if (!m_db)
+    return false;
+
+  sqlite3_stmt * stmt = nullptr;
+  auto rc = sqlite3_prepare_v2(m_db, "SELECT key, value FROM ratings ORDER BY key;", -1, &stmt,
+                               nullptr);
+  if (rc != SQLITE_OK)
+  {
+    LOG(LERROR, ("SQL error:", sqlite3_errmsg(m_db)));
+    return false;
+  }
+
+  std::string value;
+  while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+  {
+    osm::Id const id(static_cast<uint64_t>(sqlite3_column_int64(stmt, 0)));
+    auto const text = sqlite3_column_text(stmt, 1);
+    if (text)
+      value.assign(reinterpret_cast<char const *>(text), sqlite3_column_bytes(stmt, 1));
+    else
+      value = "{}";
+    fn(id, value);
+  }
+
+  if (rc != SQLITE_DONE)
+    LOG(LERROR, ("SQL error:", sqlite3_errmsg(m_db)));
+  sqlite3_finalize(stmt);
+  return rc == SQLITE_DONE;
+}
+
 bool UGCDB::ValueToBlob(std::string const & src, std::vector<uint8_t> & blob)
 {
   blob.assign(src.cbegin(), src.cend());
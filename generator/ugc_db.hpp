@@ -6,6 +6,7 @@
 #include "base/macros.hpp"
 
 #include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -29,6 +30,18 @@ public:
   WARN_UNUSED_RESULT bool Get(osm::Id const & id, std::vector<uint8_t> & blob);
   WARN_UNUSED_RESULT bool Exec(std::string const & statement);
 
+  /// Streams all rows of the ratings table by a single query. Rows are passed to |fn| in the
+  /// order of keys, keys are compared as signed 64-bit integers as sqlite does.
+  /// See also KeyLess().
+  WARN_UNUSED_RESULT bool ForEachSorted(
+      std::function<void(osm::Id const & id, std::string const & value)> const & fn);
+
+  /// The order of ids in ForEachSorted().
+  static bool KeyLess(osm::Id const & lhs, osm::Id const & rhs)
+  {
+    return static_cast<int64_t>(lhs.EncodedId()) < static_cast<int64_t>(rhs.EncodedId());
+  }
+
 private:
   bool ValueToBlob(std::string const & src, std::vector<uint8_t> & blob);
 
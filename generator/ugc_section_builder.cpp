@@ -1,6 +1,8 @@
 #include "generator/ugc_section_builder.hpp"
 
 #include "generator/gen_mwm_info.hpp"
+#include "generator/parallel_utils.hpp"
+#include "generator/ugc_db.hpp"
 #include "generator/ugc_translator.hpp"
 
 #include "ugc/binary/index_ugc.hpp"
@@ -10,13 +12,15 @@
 #include "indexer/feature_processor.hpp"
 #include "indexer/ftraits.hpp"
 
+#include <algorithm>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace generator
 {
 bool BuildUgcMwmSection(std::string const & srcDbFilename, std::string const & mwmFile,
-                        std::string const & osmToFeatureFilename)
+                        std::string const & osmToFeatureFilename, size_t threadsCount)
 {
   using ugc::binary::IndexUGC;
 
@@ -31,10 +35,8 @@ bool BuildUgcMwmSection(std::string const & srcDbFilename, std::string const & m
     featureToOsmId.emplace(p.second /* feature id */, p.first /* osm id */);
   });
 
-  UGCTranslator translator(srcDbFilename);
-
-  std::vector<IndexUGC> content;
-
+  // Osm ids and feature ids of features which may have UGC.
+  std::vector<std::pair<osm::Id, uint32_t>> features;
   feature::ForEachFromDat(mwmFile, [&](FeatureType const & f, uint32_t featureId) {
     auto const ugcMasks = ftraits::UGC::GetValue({f}).m_mask;
 
@@ -45,12 +47,66 @@ bool BuildUgcMwmSection(std::string const & srcDbFilename, std::string const & m
     CHECK(it != featureToOsmId.cend(),
           ("FeatureID", featureId, "is not found in", osmToFeatureFilename));
 
-    ugc::UGC result;
-    if (!translator.TranslateUGC(it->second, result))
-      return;
+    features.emplace_back(it->second, featureId);
+  });
 
-    content.emplace_back(featureId, result);
+  if (features.empty())
+    return true;
+
+  // Features are sorted in the order of rows of the database to join them by a single scan.
+  std::sort(features.begin(), features.end(),
+            [](std::pair<osm::Id, uint32_t> const & lhs, std::pair<osm::Id, uint32_t> const & rhs) {
+              if (lhs.first != rhs.first)
+                return UGCDB::KeyLess(lhs.first, rhs.first);
+              return lhs.second < rhs.second;
+            });
+
+  std::vector<std::pair<osm::Id, std::string>> rows;
+  size_t next = 0;
+  UGCDB db(srcDbFilename);
+  bool const scanned = db.ForEachSorted([&](osm::Id const & id, std::string const & value) {
+    while (next < features.size() && UGCDB::KeyLess(features[next].first, id))
+      ++next;
+    if (next < features.size() && features[next].first == id)
+      rows.emplace_back(id, value);
   });
+  // As before, an unreadable database means that there is no UGC.
+  if (!scanned)
+    return true;
+
+  // Json values of rows with unique ids and pairs of an index in |values| and a feature id.
+  std::vector<std::string> values;
+  std::vector<std::pair<size_t, uint32_t>> matches;
+  next = 0;
+  for (size_t i = 0; i < rows.size();)
+  {
+    size_t j = i + 1;
+    while (j < rows.size() && rows[j].first == rows[i].first)
+      ++j;
+
+    if (j - i != 1)
+    {
+      LOG(LWARNING, ("Osm id duplication in UGC database", rows[i].first));
+      i = j;
+      continue;
+    }
+
+    while (features[next].first != rows[i].first)
+      ++next;
+    for (; next < features.size() && features[next].first == rows[i].first; ++next)
+      matches.emplace_back(values.size(), features[next].second);
+    values.push_back(std::move(rows[i].second));
+    i = j;
+  }
+
+  std::vector<ugc::UGC> ugcs(values.size());
+  ForEachIndexInParallel(threadsCount, values.size(),
+                         [&](size_t i) { UGCTranslator::ParseUGC(values[i], ugcs[i]); });
+
+  std::vector<IndexUGC> content;
+  content.reserve(matches.size());
+  for (auto const & m : matches)
+    content.emplace_back(m.second /* feature id */, ugcs[m.first]);
 
   if (content.empty())
     return true;
@@ -1,9 +1,12 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 
 namespace generator
 {
+/// Reads all rows of the UGC database by a single sorted scan, joins them with features
+/// of |mwmFile| and decodes json on |threadsCount| threads.
 bool BuildUgcMwmSection(std::string const & srcDbFilename, std::string const & mwmFile,
-                        std::string const & osmToFeatureFilename);
+                        std::string const & osmToFeatureFilename, size_t threadsCount = 1);
 }  // namespace generator
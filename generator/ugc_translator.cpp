@@ -42,6 +42,14 @@ bool UGCTranslator::TranslateUGC(osm::Id const & id, ugc::UGC & ugc)
   return true;
 }
 
+// static
+void UGCTranslator::ParseUGC(std::string const & value, ugc::UGC & ugc)
+{
+  my::Json json(value);
+  ugc::DeserializerJsonV0 des(json.get());
+  des(ugc);
+}
+
 void UGCTranslator::CreateDb(std::string const & data)
 {
   CHECK(m_db.Exec(data), ());
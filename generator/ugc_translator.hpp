@@ -15,6 +15,9 @@ public:
 
   bool TranslateUGC(osm::Id const & id, ugc::UGC & ugc);
 
+  /// Parses a single json |value| of the UGC database. It's thread-safe.
+  static void ParseUGC(std::string const & value, ugc::UGC & ugc);
+
   // For testing only
   void CreateDb(std::string const & data);
 
@@ -73,7 +73,7 @@ ViatorCity::ObjectId ViatorDataset::FindMatchingObjectId(FeatureBuilder1 const &
 
   for (auto const objId : nearbyIds)
   {
-    auto const city = m_storage.GetObjectById(objId);
+    auto const & city = m_storage.GetObjectById(objId);
     if (name == city.m_name)
       return objId;
 
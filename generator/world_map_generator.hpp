@@ -13,6 +13,14 @@
 
 #include "defines.hpp"
 
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
 namespace
 {
 class WaterBoundaryChecker
@@ -303,9 +311,114 @@ public:
       m_worldBucket.PushSure(fb);
   }
 
+  bool NeedPushToWorld(FeatureBuilder1 const & fb) const { return m_worldBucket.NeedPushToWorld(fb); }
+
   void DoMerge() { m_merger.DoMerge(m_worldBucket); }
 };
 
+/// Runs WorldMapGenerator on a separate thread, so world features are checked, cut by water
+/// and written concurrently with the planet pass. Features are passed by batches through a queue
+/// of a bounded size, so memory usage doesn't depend on the speed of the world thread.
+/// With |threadsCount| <= 1 features are processed on the calling thread.
+template <class FeatureOutT>
+class ConcurrentWorldMapGenerator
+{
+public:
+  static size_t constexpr kBatchSize = 1024;
+  static size_t constexpr kMaxBatchesInQueue = 16;
+
+  ConcurrentWorldMapGenerator(feature::GenerateInfo const & info, size_t threadsCount)
+    : m_generator(info)
+  {
+    if (threadsCount > 1)
+      m_thread = std::thread(&ConcurrentWorldMapGenerator::ProcessBatches, this);
+  }
+
+  ~ConcurrentWorldMapGenerator() { Stop(); }
+
+  void operator()(FeatureBuilder1 const & fb)
+  {
+    if (!m_generator.NeedPushToWorld(fb))
+      return;
+
+    if (!m_thread.joinable())
+    {
+      m_generator(fb);
+      return;
+    }
+
+    m_batch.push_back(fb);
+    if (m_batch.size() == kBatchSize)
+      PushBatch();
+  }
+
+  /// Waits for all pushed features and merges linear features.
+  void DoMerge()
+  {
+    PushBatch();
+    Stop();
+    m_generator.DoMerge();
+  }
+
+private:
+  void PushBatch()
+  {
+    if (m_batch.empty() || !m_thread.joinable())
+      return;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this]() { return m_batches.size() < kMaxBatchesInQueue; });
+    m_batches.push_back(std::move(m_batch));
+    m_batch.clear();
+    m_cv.notify_all();
+  }
+
+  void Stop()
+  {
+    if (!m_thread.joinable())
+      return;
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_finished = true;
+      m_cv.notify_all();
+    }
+    m_thread.join();
+  }
+
+  void ProcessBatches()
+  {
+    while (true)
+    {
+      std::vector<FeatureBuilder1> batch;
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this]() { return m_finished || !m_batches.empty(); });
+        if (m_batches.empty())
+          return;
+
+        batch = std::move(m_batches.front());
+        m_batches.pop_front();
+        m_cv.notify_all();
+      }
+
+      for (auto & fb : batch)
+        m_generator(std::move(fb));
+    }
+  }
+
+  WorldMapGenerator<FeatureOutT> m_generator;
+
+  std::vector<FeatureBuilder1> m_batch;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::deque<std::vector<FeatureBuilder1>> m_batches;
+  bool m_finished = false;
+
+  std::thread m_thread;
+};
+
 template <class FeatureOutT>
 class CountryMapGenerator
 {
@@ -10,6 +10,7 @@
 #include "base/math.hpp"
 
 #include "std/algorithm.hpp"
+#include "std/utility.hpp"
 
 namespace covering
 {
@@ -4,14 +4,36 @@
 
 double ms::DistanceOnSphere(double lat1Deg, double lon1Deg, double lat2Deg, double lon2Deg)
 {
-  double const lat1 = my::DegToRad(lat1Deg);
-  double const lat2 = my::DegToRad(lat2Deg);
-  double const dlat = sin((lat2 - lat1) * 0.5);
-  double const dlon = sin((my::DegToRad(lon2Deg) - my::DegToRad(lon1Deg)) * 0.5);
-  double const y = dlat * dlat + dlon * dlon * cos(lat1) * cos(lat2);
+  return DistanceOnSphere(SpherePoint(lat1Deg, lon1Deg), SpherePoint(lat2Deg, lon2Deg));
+}
+
+ms::SpherePoint::SpherePoint(double latDeg, double lonDeg)
+  : m_lat(my::DegToRad(latDeg)), m_lon(my::DegToRad(lonDeg)), m_cosLat(cos(m_lat))
+{
+}
+
+double ms::DistanceOnSphere(SpherePoint const & p1, SpherePoint const & p2)
+{
+  double const dlat = sin((p2.m_lat - p1.m_lat) * 0.5);
+  double const dlon = sin((p2.m_lon - p1.m_lon) * 0.5);
+  double const y = dlat * dlat + dlon * dlon * p1.m_cosLat * p2.m_cosLat;
   return 2.0 * atan2(sqrt(y), sqrt(max(0.0, 1.0 - y)));
 }
 
+void ms::DistancesOnEarth(LatLon const * latLons, size_t count, double * distances)
+{
+  if (count < 2)
+    return;
+
+  SpherePoint prev(latLons[0].lat, latLons[0].lon);
+  for (size_t i = 1; i < count; ++i)
+  {
+    SpherePoint const cur(latLons[i].lat, latLons[i].lon);
+    distances[i - 1] = EarthRadiusMeters() * DistanceOnSphere(prev, cur);
+    prev = cur;
+  }
+}
+
 double ms::AreaOnSphere(ms::LatLon const & ll1, ms::LatLon const & ll2, ms::LatLon const & ll3)
 {
   // Todo: proper area on sphere (not needed for now)
@@ -2,6 +2,8 @@
 #include "base/base.hpp"
 #include "geometry/latlon.hpp"
 
+#include <cstddef>
+
 // namespace ms - "math on sphere", similar to the namespaces m2 and mn.
 namespace ms
 {
@@ -15,6 +17,26 @@ inline double OneDegreeEquatorLengthMeters() { return 111319.49079; }
 // lat1, lat2, lon1, lon2 - in degrees.
 double DistanceOnSphere(double lat1Deg, double lon1Deg, double lat2Deg, double lon2Deg);
 
+// Point on unit sphere with its trigonometry calculated once, so a point shared by
+// consecutive segments of a polyline is converted to radians and its cosine is computed once.
+struct SpherePoint
+{
+  SpherePoint() = default;
+  SpherePoint(double latDeg, double lonDeg);
+
+  double m_lat = 0.0;
+  double m_lon = 0.0;
+  double m_cosLat = 1.0;
+};
+
+// Same as DistanceOnSphere(), the result is exactly the same.
+double DistanceOnSphere(SpherePoint const & p1, SpherePoint const & p2);
+
+// Calculates distances in meters between consecutive points of |latLons|: |distances[i]| is
+// the distance between |latLons[i]| and |latLons[i + 1]|, |distances| has |count| - 1 elements.
+// Every point is processed once and no memory is allocated.
+void DistancesOnEarth(LatLon const * latLons, size_t count, double * distances);
+
 // Area on unit sphere for a triangle (ll1, ll2, ll3).
 double AreaOnSphere(LatLon const & ll1, LatLon const & ll2, LatLon const & ll3);
 
@@ -48,8 +48,10 @@ HEADERS += \
   line2d.hpp \
   mercator.hpp \
   nearby_points_sweeper.hpp \
+  packed_tree4d.hpp \
   packer.hpp \
   point2d.hpp \
+  points_grid.hpp \
   pointu_to_uint64.hpp \
   polygon.hpp \
   polyline2d.hpp \
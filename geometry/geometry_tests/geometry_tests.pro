@@ -37,8 +37,10 @@ SOURCES += \
   line2d_tests.cpp \
   mercator_test.cpp \
   nearby_points_sweeper_test.cpp \
+  packed_tree4d_test.cpp \
   packer_test.cpp \
   point_test.cpp \
+  points_grid_test.cpp \
   pointu_to_uint64_test.cpp \
   polygon_test.cpp \
   rect_test.cpp \
@@ -6,6 +6,10 @@
 #include "base/macros.hpp"
 #include "base/logging.hpp"
 
+#include <vector>
+
+using namespace std;
+
 
 UNIT_TEST(Mercator_Grid)
 {
@@ -81,3 +85,27 @@ UNIT_TEST(Mercator_Sample1)
   LOG(LINFO, (MercatorBounds::XToLon(27.531491200000001385),
               MercatorBounds::YToLat(64.392864299248202542)));
 }
+
+UNIT_TEST(Mercator_DistancesOnEarth)
+{
+  vector<m2::PointD> const points = {MercatorBounds::FromLatLon(55.75, 37.62),
+                                     MercatorBounds::FromLatLon(55.76, 37.6),
+                                     MercatorBounds::FromLatLon(-33.86, 151.21),
+                                     MercatorBounds::FromLatLon(-33.86, 151.21),
+                                     MercatorBounds::FromLatLon(40.71, -74.0)};
+
+  vector<double> distances(points.size() - 1);
+  MercatorBounds::DistancesOnEarth(points.data(), points.size(), distances.data());
+  for (size_t i = 0; i + 1 < points.size(); ++i)
+    TEST_EQUAL(distances[i], MercatorBounds::DistanceOnEarth(points[i], points[i + 1]), (i));
+
+  vector<ms::LatLon> latLons;
+  for (auto const & p : points)
+    latLons.push_back(MercatorBounds::ToLatLon(p));
+  ms::DistancesOnEarth(latLons.data(), latLons.size(), distances.data());
+  for (size_t i = 0; i + 1 < latLons.size(); ++i)
+    TEST_EQUAL(distances[i], ms::DistanceOnEarth(latLons[i], latLons[i + 1]), (i));
+
+  // Nothing is written for a single point.
+  MercatorBounds::DistancesOnEarth(points.data(), 1, nullptr);
+}
@@ -117,5 +117,39 @@ UNIT_TEST(NearbyPointsSweeper_CornerCases)
     TEST_EQUAL(expected, actual, ());
   }
 }
+
+UNIT_TEST(NearbyPointsSweeper_Priority)
+{
+  {
+    NearbyPointsSweeper sweeper(1.0);
+    sweeper.Add(0.0, 0.0, 0 /* index */, 0 /* priority */);
+    sweeper.Add(0.0, 0.5, 1 /* index */, 1 /* priority */);
+    sweeper.Add(0.0, 1.0, 2 /* index */, 0 /* priority */);
+    sweeper.Add(0.0, 1.6, 3 /* index */, 0 /* priority */);
+
+    TIndexSet expected = {1, 3};
+    TIndexSet actual;
+    sweeper.Sweep(MakeInsertFunctor(actual));
+
+    TEST_EQUAL(expected, actual, ());
+  }
+
+  {
+    // Points which are in the same cell or in neighbouring cells of
+    // the grid but are far enough along one of the axes survive.
+    NearbyPointsSweeper sweeper(1.0);
+    sweeper.Reserve(4);
+    sweeper.Add(0.1, 0.1, 0 /* index */, 2 /* priority */);
+    sweeper.Add(1.2, 0.9, 1 /* index */, 1 /* priority */);
+    sweeper.Add(-0.9, 1.2, 2 /* index */, 1 /* priority */);
+    sweeper.Add(-0.5, -0.5, 3 /* index */, 0 /* priority */);
+
+    TIndexSet expected = {0, 1, 2};
+    TIndexSet actual;
+    sweeper.Sweep(MakeInsertFunctor(actual));
+
+    TEST_EQUAL(expected, actual, ());
+  }
+}
 }  // namespace
 }  // namespace search
@@ -0,0 +1,103 @@
+#include "testing/testing.hpp"
+
+#include "geometry/packed_tree4d.hpp"
+#include "geometry/rect2d.hpp"
+#include "geometry/tree4d.hpp"
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using Rects = std::vector<m2::RectD>;
+using Ids = std::vector<size_t>;
+
+// Ids are indexes in a vector of rects.
+struct Traits
+{
+  m2::RectD LimitRect(size_t id) const { return (*m_rects)[id]; }
+
+  Rects const * m_rects;
+};
+
+using PackedTree = m4::PackedTree<size_t, Traits>;
+
+Ids Sorted(Ids ids)
+{
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+UNIT_TEST(PackedTree4D_Smoke)
+{
+  Rects const rects = {m2::RectD(0, 0, 1, 1), m2::RectD(1, 1, 2, 2), m2::RectD(2, 2, 3, 3)};
+
+  PackedTree tree(Traits{&rects});
+  tree.Build();
+  TEST(tree.IsEmpty(), ());
+  tree.ForEachInRect(m2::RectD(0, 0, 1, 1), [](size_t) { TEST(false, ()); });
+
+  for (size_t i = 0; i < rects.size(); ++i)
+    tree.Add(i);
+  TEST_EQUAL(tree.GetSize(), 3, ());
+  tree.Build();
+
+  Ids actual;
+  tree.ForEach([&actual](size_t id) { actual.push_back(id); });
+  TEST_EQUAL(Sorted(actual), Ids({0, 1, 2}), ());
+
+  actual.clear();
+  tree.ForEachInRect(m2::RectD(1.5, 1.5, 1.5, 1.5), [&actual](size_t id) { actual.push_back(id); });
+  TEST_EQUAL(actual, Ids({1}), ());
+
+  // Rects which only touch a query rect don't intersect it, as in m4::Tree.
+  actual.clear();
+  tree.ForEachInRect(m2::RectD(3, 3, 4, 4), [&actual](size_t id) { actual.push_back(id); });
+  TEST(actual.empty(), (actual));
+}
+
+UNIT_TEST(PackedTree4D_SameAsTree)
+{
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<double> coord(-100.0, 100.0);
+  std::uniform_real_distribution<double> size(0.0, 10.0);
+
+  Rects rects;
+  for (size_t i = 0; i < 10000; ++i)
+  {
+    double const x = coord(rng);
+    double const y = coord(rng);
+    rects.emplace_back(x, y, x + size(rng), y + size(rng));
+  }
+
+  m4::Tree<size_t, Traits> tree(Traits{&rects});
+  PackedTree packed(Traits{&rects});
+  for (size_t i = 0; i < rects.size(); ++i)
+  {
+    tree.Add(i);
+    packed.Add(i);
+  }
+  packed.Build();
+  TEST_EQUAL(tree.GetSize(), packed.GetSize(), ());
+
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    double const x = coord(rng);
+    double const y = coord(rng);
+    // Points and rects are queried.
+    double const d = i % 2 == 0 ? 0.0 : size(rng);
+    m2::RectD const query(x, y, x + d, y + d);
+
+    Ids expected;
+    tree.ForEachInRect(query, [&expected](size_t id) { expected.push_back(id); });
+    Ids actual;
+    packed.ForEachInRectEx(query, [&](m2::RectD const & rect, size_t id) {
+      TEST_EQUAL(rect, rects[id], ());
+      actual.push_back(id);
+    });
+    TEST_EQUAL(Sorted(expected), Sorted(actual), (query));
+  }
+}
+}  // namespace
@@ -0,0 +1,60 @@
+#include "testing/testing.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/points_grid.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using namespace m2;
+
+namespace
+{
+using Clusters = std::vector<std::vector<uint32_t>>;
+
+Clusters Normalize(Clusters clusters)
+{
+  for (auto & cluster : clusters)
+    std::sort(cluster.begin(), cluster.end());
+  std::sort(clusters.begin(), clusters.end());
+  return clusters;
+}
+
+UNIT_TEST(PointsGrid_AnyNearby)
+{
+  PointsGrid<uint32_t> grid(1.0);
+  grid.Add(PointD(0.5, 0.5), 0);
+  grid.Add(PointD(-0.5, 1.2), 1);
+  grid.Add(PointD(5.0, 5.0), 2);
+
+  std::vector<uint32_t> values;
+  TEST(!grid.AnyNearby(PointD(0.1, 0.1), [&values](PointD const &, uint32_t value) {
+    values.push_back(value);
+    return false;
+  }), ());
+  std::sort(values.begin(), values.end());
+  TEST_EQUAL(values, std::vector<uint32_t>({0, 1}), ());
+
+  TEST(grid.AnyNearby(PointD(5.5, 4.5), [](PointD const &, uint32_t value) { return value == 2; }),
+       ());
+  TEST(!grid.AnyNearby(PointD(3.0, 3.0), [](PointD const &, uint32_t) { return true; }), ());
+}
+
+UNIT_TEST(PointsGrid_Clusters)
+{
+  PointsGrid<uint32_t> grid(1.0);
+  TEST(grid.GetClusters().empty(), ());
+
+  // A chain of points in neighbouring cells.
+  grid.Add(PointD(0.5, 0.5), 0);
+  grid.Add(PointD(1.5, -0.5), 1);
+  grid.Add(PointD(2.5, 0.5), 2);
+  grid.Add(PointD(2.6, 0.6), 3);
+  // Separate points.
+  grid.Add(PointD(0.5, 2.5), 4);
+  grid.Add(PointD(-5.5, -5.5), 5);
+
+  TEST_EQUAL(Normalize(grid.GetClusters()), Clusters({{0, 1, 2, 3}, {4}, {5}}), ());
+}
+}  // namespace
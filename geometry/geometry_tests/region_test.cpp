@@ -4,6 +4,9 @@
 
 #include "geometry/region2d.hpp"
 
+#include "std/cmath.hpp"
+#include "std/vector.hpp"
+
 
 namespace {
 
@@ -261,3 +264,48 @@ UNIT_TEST(Region_border_intersecion_Test)
 
   TEST(!region.FindIntersection(P(5.0, 5.0), P(2.0, 2.0), intersection), ("This case has no intersection"));
 }
+
+namespace
+{
+template <class P>
+void TestIndexedRegion(vector<P> const & points, typename P::value_type step)
+{
+  m2::Region<P> region(points.begin(), points.end());
+  m2::IndexedRegion<P> const indexed{m2::Region<P>(region)};
+  TEST_EQUAL(indexed.GetRect(), region.GetRect(), ());
+
+  auto const rect = region.GetRect();
+  for (auto x = rect.minX() - step; x <= rect.maxX() + step; x += step)
+  {
+    for (auto y = rect.minY() - step; y <= rect.maxY() + step; y += step)
+      TEST_EQUAL(indexed.Contains(P(x, y)), region.Contains(P(x, y)), (x, y));
+  }
+
+  for (auto const & p : points)
+    TEST(indexed.Contains(p), (p));
+}
+}  // namespace
+
+UNIT_TEST(IndexedRegion_Contains)
+{
+  // A star with many vertices, some of them have the same y.
+  vector<m2::PointD> star;
+  for (int i = 0; i < 200; ++i)
+  {
+    double const angle = 2 * math::pi * i / 200;
+    double const r = (i % 2 == 0) ? 100.0 : 40.0 + i % 7;
+    star.emplace_back(std::round(r * cos(angle)), std::round(r * sin(angle)));
+  }
+  TestIndexedRegion(star, 1.0);
+
+  vector<m2::PointI> starI;
+  for (auto const & p : star)
+    starI.emplace_back(static_cast<int>(p.x), static_cast<int>(p.y));
+  TestIndexedRegion(starI, 1);
+
+  // A region with a horizontal edge and a point on it.
+  TestIndexedRegion(vector<m2::PointD>{{0, 0}, {4, 0}, {4, 4}, {2, 4}, {0, 4}}, 0.25);
+
+  m2::IndexedRegionD const empty;
+  TEST(!empty.Contains(m2::PointD(0, 0)), ());
+}
@@ -46,6 +46,20 @@ double MercatorBounds::DistanceOnEarth(m2::PointD const & p1, m2::PointD const &
   return ms::DistanceOnEarth(ToLatLon(p1), ToLatLon(p2));
 }
 
+void MercatorBounds::DistancesOnEarth(m2::PointD const * points, size_t count, double * distances)
+{
+  if (count < 2)
+    return;
+
+  ms::SpherePoint prev = ToSpherePoint(points[0]);
+  for (size_t i = 1; i < count; ++i)
+  {
+    ms::SpherePoint const cur = ToSpherePoint(points[i]);
+    distances[i - 1] = ms::EarthRadiusMeters() * ms::DistanceOnSphere(prev, cur);
+    prev = cur;
+  }
+}
+
 double MercatorBounds::AreaOnEarth(m2::PointD const & p1, m2::PointD const & p2, m2::PointD const & p3)
 {
   return ms::AreaOnEarth(ToLatLon(p1), ToLatLon(p2), ToLatLon(p3));
@@ -1,4 +1,5 @@
 #pragma once
+#include "geometry/distance_on_sphere.hpp"
 #include "geometry/latlon.hpp"
 #include "geometry/point2d.hpp"
 #include "geometry/rect2d.hpp"
@@ -115,6 +116,13 @@ struct MercatorBounds
     return {YToLat(point.y), XToLon(point.x)};
   }
 
+  /// Converts |point| for distance calculations: a point shared by several segments is
+  /// converted once, see ms::DistanceOnSphere(SpherePoint const &, SpherePoint const &).
+  inline static ms::SpherePoint ToSpherePoint(m2::PointD const & point)
+  {
+    return ms::SpherePoint(YToLat(point.y), XToLon(point.x));
+  }
+
   /// Converts lat lon rect to mercator one
   inline static m2::RectD FromLatLonRect(m2::RectD const & latLonRect)
   {
@@ -131,6 +139,12 @@ struct MercatorBounds
   /// Calculates distance on Earth by two points in mercator
   static double DistanceOnEarth(m2::PointD const & p1, m2::PointD const & p2);
 
+  /// Calculates distances on Earth between consecutive mercator |points|: |distances[i]| is
+  /// the distance between |points[i]| and |points[i + 1]|, |distances| has |count| - 1 elements.
+  /// Every point is converted to lat lon once and no memory is allocated, the distances are
+  /// exactly the same as DistanceOnEarth() returns.
+  static void DistancesOnEarth(m2::PointD const * points, size_t count, double * distances);
+
   /// Calculates area of a triangle on Earth in m² by three points
   static double AreaOnEarth(m2::PointD const & p1, m2::PointD const & p2, m2::PointD const & p3);
 };
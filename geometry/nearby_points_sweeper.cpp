@@ -2,34 +2,36 @@
 
 namespace m2
 {
-// NearbyPointsSweeper::Event ----------------------------------------------------------------------
-NearbyPointsSweeper::Event::Event(Type type, double y, double x, size_t index)
-  : m_type(type), m_y(y), m_x(x), m_index(index)
+// NearbyPointsSweeper::Point ----------------------------------------------------------------------
+NearbyPointsSweeper::Point::Point(double x, double y, size_t index, uint8_t priority)
+  : m_point(x, y), m_index(index), m_priority(priority)
 {
 }
 
-bool NearbyPointsSweeper::Event::operator<(Event const & rhs) const
+bool NearbyPointsSweeper::Point::operator<(Point const & rhs) const
 {
-  if (m_y != rhs.m_y)
-    return m_y < rhs.m_y;
+  if (m_priority != rhs.m_priority)
+    return m_priority > rhs.m_priority;
 
-  if (m_type != rhs.m_type)
-    return m_type < rhs.m_type;
+  if (m_point.y != rhs.m_point.y)
+    return m_point.y < rhs.m_point.y;
 
-  if (m_x != rhs.m_x)
-    return m_x < rhs.m_x;
+  if (m_point.x != rhs.m_point.x)
+    return m_point.x < rhs.m_point.x;
 
   return m_index < rhs.m_index;
 }
 
 // NearbyPointsSweeper -----------------------------------------------------------------------------
-NearbyPointsSweeper::NearbyPointsSweeper(double eps) : m_eps(eps), m_heps(std::max(eps * 0.5, 0.0))
+NearbyPointsSweeper::NearbyPointsSweeper(double eps)
+  : m_eps(eps), m_cellSize(eps > 0.0 ? eps : 1.0)
 {
 }
 
-void NearbyPointsSweeper::Add(double x, double y, size_t index)
+void NearbyPointsSweeper::Reserve(size_t size) { m_points.reserve(size); }
+
+void NearbyPointsSweeper::Add(double x, double y, size_t index, uint8_t priority)
 {
-  m_events.emplace_back(Event::TYPE_SEGMENT_START, y - m_heps, x, index);
-  m_events.emplace_back(Event::TYPE_SEGMENT_END, y + m_heps, x, index);
+  m_points.emplace_back(x, y, index, priority);
 }
 }  // namespace m2
@@ -1,23 +1,25 @@
 #pragma once
 
-#include "base/assert.hpp"
+#include "geometry/point2d.hpp"
+#include "geometry/points_grid.hpp"
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
-#include <limits>
-#include <set>
-#include <utility>
 #include <vector>
 
 namespace m2
 {
 // This class can be used to greedily sweep points on a plane that are
 // too close to each other.  Two points are considered to be "too
-// close" when Manhattan distance between them is less than or equal
-// to some preselected epsilon. Note, the result is not the largest
-// subset of points that can be selected, but it can be computed quite
-// fast and gives satisfactory results.
+// close" when distance between them along each of the axes is less
+// than or equal to some preselected epsilon. Points are considered in
+// the order of decreasing priority, and then from bottom to top, and
+// a point survives if it's not too close to any of the survived
+// points. Note, the result is not the largest subset of points that
+// can be selected, but it can be computed quite fast and gives
+// satisfactory results.
 //
 // *NOTE* The class is NOT thread-safe.
 class NearbyPointsSweeper
@@ -25,106 +27,57 @@ class NearbyPointsSweeper
 public:
   explicit NearbyPointsSweeper(double eps);
 
+  // Reserves memory for |size| points, should be called before a
+  // batch of Add() calls when the size of the batch is known.
+  void Reserve(size_t size);
+
   // Adds a new point (|x|, |y|) on the plane. |index| is used to
   // identify individual points, and will be reported for survived
-  // points during the Sweep phase.
-  void Add(double x, double y, size_t index);
-
-  // Emits indexes of all survived points. Complexity: O(n * log(n)),
-  // where n is the number of already added points.
+  // points during the Sweep phase. Points with greater |priority|
+  // survive in favour of close points with lower priority.
+  void Add(double x, double y, size_t index, uint8_t priority = 0);
+
+  // Emits indexes of all survived points. Complexity: O(n * log(n))
+  // for ordering of points by priority and position, and O(n) on
+  // average for the sweep itself, where n is the number of already
+  // added points.
   template <typename TEmitter>
   void Sweep(TEmitter && emitter)
   {
-    std::sort(m_events.begin(), m_events.end());
+    std::sort(m_points.begin(), m_points.end());
 
-    std::set<std::pair<double, size_t>> line;
+    PointsGrid<size_t> survived(m_cellSize);
+    survived.Reserve(m_points.size());
 
-    for (auto const & event : m_events)
+    for (auto const & point : m_points)
     {
-      switch (event.m_type)
-      {
-      case Event::TYPE_SEGMENT_START:
-      {
-        if (line.empty())
-        {
-          line.emplace(event.m_x, event.m_index);
-          break;
-        }
-
-        auto it = line.upper_bound(std::make_pair(event.m_x, std::numeric_limits<size_t>::max()));
-
-        bool add = true;
-        while (true)
-        {
-          if (line.empty())
-            break;
-
-          if (it == line.end())
-          {
-            --it;
-            continue;
-          }
-
-          double const x = it->first;
-          if (fabs(x - event.m_x) <= m_eps)
-          {
-            add = false;
-            break;
-          }
-
-          if (x + m_eps < event.m_x)
-            break;
-
-          if (it == line.begin())
-            break;
-
-          --it;
-        }
-
-        if (add)
-          line.emplace(event.m_x, event.m_index);
-
-        break;
-      }
-
-      case Event::TYPE_SEGMENT_END:
-      {
-        auto it = line.find(std::make_pair(event.m_x, event.m_index));
-        if (it != line.end())
-        {
-          emitter(event.m_index);
-          line.erase(it);
-        }
-        break;
-      }
-      };
+      bool const tooClose = survived.AnyNearby(
+          point.m_point, [this, &point](PointD const & p, size_t /* index */) {
+            return fabs(p.x - point.m_point.x) <= m_eps && fabs(p.y - point.m_point.y) <= m_eps;
+          });
+      if (tooClose)
+        continue;
+
+      survived.Add(point.m_point, point.m_index);
+      emitter(point.m_index);
     }
-
-    ASSERT(line.empty(), ("Sweep line must be empty after events processing:", line));
   }
 
 private:
-  struct Event
+  struct Point
   {
-    enum Type
-    {
-      TYPE_SEGMENT_START,
-      TYPE_SEGMENT_END
-    };
-
-    Event(Type type, double y, double x, size_t index);
-
-    bool operator<(Event const & rhs) const;
+    Point(double x, double y, size_t index, uint8_t priority);
 
-    Type m_type;
+    bool operator<(Point const & rhs) const;
 
-    double m_y;
-    double m_x;
+    PointD m_point;
     size_t m_index;
+    uint8_t m_priority;
   };
 
-  std::vector<Event> m_events;
+  std::vector<Point> m_points;
   double const m_eps;
-  double const m_heps;
+  // Size of grid cells must be positive and not less than |m_eps|.
+  double const m_cellSize;
 };
 }  // namespace m2
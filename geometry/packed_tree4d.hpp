@@ -0,0 +1,292 @@
+#pragma once
+
+#include "geometry/rect2d.hpp"
+#include "geometry/tree4d.hpp"
+
+#include "base/assert.hpp"
+#include "base/buffer_vector.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace m4
+{
+// Static R-tree of objects with rects. Objects are added at first,
+// then the tree is bulk loaded by Build() with the Sort-Tile-Recursive
+// algorithm and is stored in flat arrays. It's a drop-in alternative
+// to m4::Tree for the cases when all objects are known in advance:
+// queries are several times faster and the tree takes less memory,
+// but objects can't be erased or replaced.
+//
+// Rects of entries are stored as a structure of arrays, so rects of
+// all children of a node are tested by a single loop, which is
+// vectorized by compilers.
+//
+// *NOTE* Queries are thread-safe, Add() and Build() are not.
+template <typename T, typename Traits = TraitsDef<T>>
+class PackedTree
+{
+public:
+  // Max number of children of a node.
+  static size_t constexpr kBranching = 16;
+
+  explicit PackedTree(Traits const & traits = Traits()) : m_traits(traits) {}
+
+  void Add(T const & obj) { Add(obj, m_traits.LimitRect(obj)); }
+  void Add(T && obj)
+  {
+    m2::RectD const rect = m_traits.LimitRect(obj);
+    Add(std::move(obj), rect);
+  }
+
+  void Add(T const & obj, m2::RectD const & rect)
+  {
+    m_values.push_back(obj);
+    AddRect(rect);
+  }
+  void Add(T && obj, m2::RectD const & rect)
+  {
+    m_values.push_back(std::move(obj));
+    AddRect(rect);
+  }
+
+  // Packs all added objects into the tree. Must be called after the
+  // last Add() and before queries by rect.
+  void Build()
+  {
+    m_built = true;
+    if (m_values.empty())
+      return;
+    m_levels.resize(1);
+
+    std::vector<uint32_t> const order = GetOrder();
+    std::vector<T> values;
+    values.reserve(m_values.size());
+    Level leaves;
+    leaves.Reserve(order.size());
+    for (auto const i : order)
+    {
+      values.push_back(std::move(m_values[i]));
+      leaves.Add(m_levels[0].GetRect(i));
+    }
+    m_values.swap(values);
+    m_levels[0].Swap(leaves);
+
+    // Upper levels group consecutive nodes, which are close to each
+    // other as leaves are ordered by tiles.
+    while (m_levels.back().Size() > kBranching)
+    {
+      Level const & children = m_levels.back();
+      Level parents;
+      parents.Reserve((children.Size() + kBranching - 1) / kBranching);
+      for (size_t begin = 0; begin < children.Size(); begin += kBranching)
+      {
+        m2::RectD rect;
+        for (size_t i = begin; i < std::min(begin + kBranching, children.Size()); ++i)
+          rect.Add(children.GetRect(i));
+        parents.Add(rect);
+      }
+      m_levels.push_back(std::move(parents));
+    }
+  }
+
+  template <typename ToDo>
+  void ForEach(ToDo && toDo) const
+  {
+    for (auto const & value : m_values)
+      toDo(value);
+  }
+
+  template <typename ToDo>
+  void ForEachEx(ToDo && toDo) const
+  {
+    for (size_t i = 0; i < m_values.size(); ++i)
+      toDo(m_levels[0].GetRect(i), m_values[i]);
+  }
+
+  // Calls |toDo| for all objects whose rects intersect |rect|, in the
+  // same sense as m4::Tree does.
+  template <typename ToDo>
+  void ForEachInRect(m2::RectD const & rect, ToDo && toDo) const
+  {
+    ForEachInRectEx(rect, [&toDo](m2::RectD const &, T const & value) { toDo(value); });
+  }
+
+  template <typename ToDo>
+  void ForEachInRectEx(m2::RectD const & rect, ToDo && toDo) const
+  {
+    ASSERT(m_built || m_values.empty(), ("Build() must be called before queries."));
+    if (m_values.empty())
+      return;
+
+    struct Range
+    {
+      size_t m_level;
+      size_t m_begin;
+      size_t m_end;
+    };
+
+    buffer_vector<Range, 64> ranges;
+    ranges.push_back({m_levels.size() - 1, 0, m_levels.back().Size()});
+    while (!ranges.empty())
+    {
+      Range const range = ranges.back();
+      ranges.pop_back();
+
+      Level const & level = m_levels[range.m_level];
+      uint8_t hits[kBranching];
+      size_t const size = range.m_end - range.m_begin;
+      level.Intersect(range.m_begin, size, rect, hits);
+
+      for (size_t i = 0; i < size; ++i)
+      {
+        if (!hits[i])
+          continue;
+
+        size_t const index = range.m_begin + i;
+        if (range.m_level == 0)
+        {
+          toDo(level.GetRect(index), m_values[index]);
+          continue;
+        }
+
+        size_t const begin = index * kBranching;
+        size_t const end = std::min(begin + kBranching, m_levels[range.m_level - 1].Size());
+        ranges.push_back({range.m_level - 1, begin, end});
+      }
+    }
+  }
+
+  bool IsEmpty() const { return m_values.empty(); }
+
+  size_t GetSize() const { return m_values.size(); }
+
+  void Clear()
+  {
+    m_values.clear();
+    m_levels.clear();
+    m_built = false;
+  }
+
+private:
+  // Rects of nodes of a level of the tree.
+  class Level
+  {
+  public:
+    void Reserve(size_t size)
+    {
+      m_minX.reserve(size);
+      m_minY.reserve(size);
+      m_maxX.reserve(size);
+      m_maxY.reserve(size);
+    }
+
+    void Add(m2::RectD const & rect)
+    {
+      m_minX.push_back(rect.minX());
+      m_minY.push_back(rect.minY());
+      m_maxX.push_back(rect.maxX());
+      m_maxY.push_back(rect.maxY());
+    }
+
+    void Swap(Level & rhs)
+    {
+      m_minX.swap(rhs.m_minX);
+      m_minY.swap(rhs.m_minY);
+      m_maxX.swap(rhs.m_maxX);
+      m_maxY.swap(rhs.m_maxY);
+    }
+
+    m2::RectD GetRect(size_t i) const
+    {
+      return m2::RectD(m_minX[i], m_minY[i], m_maxX[i], m_maxY[i]);
+    }
+
+    double GetCenterX(size_t i) const { return (m_minX[i] + m_maxX[i]) * 0.5; }
+    double GetCenterY(size_t i) const { return (m_minY[i] + m_maxY[i]) * 0.5; }
+
+    size_t Size() const { return m_minX.size(); }
+
+    // Sets |hits|[i] to 1 iff rect of the node |begin| + i intersects |rect|, for i < |size|.
+    void Intersect(size_t begin, size_t size, m2::RectD const & rect, uint8_t * hits) const
+    {
+      ASSERT_LESS_OR_EQUAL(size, kBranching, ());
+      double const minX = rect.minX();
+      double const minY = rect.minY();
+      double const maxX = rect.maxX();
+      double const maxY = rect.maxY();
+      double const * nodeMinX = m_minX.data() + begin;
+      double const * nodeMinY = m_minY.data() + begin;
+      double const * nodeMaxX = m_maxX.data() + begin;
+      double const * nodeMaxY = m_maxY.data() + begin;
+      // No branches, so the loop is vectorized.
+      for (size_t i = 0; i < size; ++i)
+      {
+        hits[i] = static_cast<uint8_t>((nodeMaxX[i] > minX) & (nodeMinX[i] < maxX) &
+                                       (nodeMaxY[i] > minY) & (nodeMinY[i] < maxY));
+      }
+    }
+
+  private:
+    std::vector<double> m_minX;
+    std::vector<double> m_minY;
+    std::vector<double> m_maxX;
+    std::vector<double> m_maxY;
+  };
+
+  void AddRect(m2::RectD const & rect)
+  {
+    if (m_levels.empty())
+      m_levels.emplace_back();
+    // Levels are rebuilt for new objects.
+    m_levels.resize(1);
+    m_levels[0].Add(rect);
+    m_built = false;
+  }
+
+  // Returns the order of objects by Sort-Tile-Recursive: objects are
+  // split into vertical slices by x of centers, then every slice is
+  // sorted by y of centers, so every run of kBranching objects is a
+  // compact tile.
+  std::vector<uint32_t> GetOrder() const
+  {
+    Level const & leaves = m_levels[0];
+    std::vector<uint32_t> order(leaves.Size());
+    std::iota(order.begin(), order.end(), 0);
+
+    auto const byX = [&leaves](uint32_t lhs, uint32_t rhs) {
+      return leaves.GetCenterX(lhs) < leaves.GetCenterX(rhs);
+    };
+    auto const byY = [&leaves](uint32_t lhs, uint32_t rhs) {
+      return leaves.GetCenterY(lhs) < leaves.GetCenterY(rhs);
+    };
+
+    size_t const leavesCount = (order.size() + kBranching - 1) / kBranching;
+    size_t const slicesCount = static_cast<size_t>(std::ceil(std::sqrt(leavesCount)));
+    size_t const sliceSize = slicesCount * kBranching;
+
+    std::stable_sort(order.begin(), order.end(), byX);
+    for (size_t begin = 0; begin < order.size(); begin += sliceSize)
+    {
+      auto const end = order.begin() + std::min(begin + sliceSize, order.size());
+      std::stable_sort(order.begin() + begin, end, byY);
+    }
+    return order;
+  }
+
+  Traits m_traits;
+  std::vector<T> m_values;
+  // Levels of the tree from leaves to the root, rects of objects are
+  // stored as the level of leaves.
+  std::vector<Level> m_levels;
+  bool m_built = false;
+};
+
+template <typename T, typename Traits>
+size_t constexpr PackedTree<T, Traits>::kBranching;
+}  // namespace m4
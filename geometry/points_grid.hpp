@@ -0,0 +1,142 @@
+#pragma once
+
+#include "geometry/point2d.hpp"
+
+#include "base/assert.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace m2
+{
+// Hash grid of points with square cells of a fixed size. Points are
+// added one by one and can't be removed. Lookup of points which are
+// not farther than the cell size from a given point (in any of the
+// coordinates) takes constant time on average, as only a 3x3 block
+// of cells must be visited.
+//
+// *NOTE* The class is NOT thread-safe.
+template <typename Value>
+class PointsGrid
+{
+public:
+  explicit PointsGrid(double cellSize) : m_cellSize(cellSize)
+  {
+    ASSERT_GREATER(m_cellSize, 0.0, ());
+  }
+
+  void Reserve(size_t size) { m_cells.reserve(size); }
+
+  void Add(PointD const & p, Value const & value)
+  {
+    m_cells[GetCell(p.x, p.y)].emplace_back(p, value);
+  }
+
+  // Calls |fn| for all points whose distance to |p| along each of
+  // the axes is not greater than the cell size, and maybe for a few
+  // farther ones, so |fn| must check the distance on its own.
+  // Iteration stops when |fn| returns true.
+  // Returns true iff iteration was stopped by |fn|.
+  template <typename Fn>
+  bool AnyNearby(PointD const & p, Fn && fn) const
+  {
+    Cell const cell = GetCell(p.x, p.y);
+    for (int64_t dx = -1; dx <= 1; ++dx)
+    {
+      for (int64_t dy = -1; dy <= 1; ++dy)
+      {
+        auto const it = m_cells.find(Cell(cell.first + dx, cell.second + dy));
+        if (it == m_cells.end())
+          continue;
+        for (auto const & entry : it->second)
+        {
+          if (fn(entry.first, entry.second))
+            return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  // Splits values into clusters, so values of points which are not
+  // farther than the cell size from each other along each of the axes
+  // are in the same cluster. As whole cells are merged, some farther
+  // points may be in the same cluster too. Values of a cluster are
+  // grouped by cells, the order of clusters is unspecified.
+  std::vector<std::vector<Value>> GetClusters() const
+  {
+    std::unordered_map<Cell, size_t, CellHash> ids;
+    ids.reserve(m_cells.size());
+    for (auto const & cell : m_cells)
+      ids.emplace(cell.first, ids.size());
+
+    // Disjoint sets of cells.
+    std::vector<size_t> parents(ids.size());
+    for (size_t i = 0; i < parents.size(); ++i)
+      parents[i] = i;
+    auto const getRoot = [&parents](size_t id) {
+      while (parents[id] != id)
+      {
+        parents[id] = parents[parents[id]];
+        id = parents[id];
+      }
+      return id;
+    };
+
+    // It's enough to look at a half of neighbours, as the relation is symmetric.
+    static std::pair<int64_t, int64_t> const kNeighbours[] = {{1, -1}, {1, 0}, {1, 1}, {0, 1}};
+    for (auto const & id : ids)
+    {
+      for (auto const & d : kNeighbours)
+      {
+        auto const it = ids.find(Cell(id.first.first + d.first, id.first.second + d.second));
+        if (it != ids.end())
+          parents[getRoot(it->second)] = getRoot(id.second);
+      }
+    }
+
+    std::vector<std::vector<Value>> clusters;
+    std::vector<size_t> rootToCluster(ids.size(), ids.size());
+    for (auto const & cell : m_cells)
+    {
+      size_t & cluster = rootToCluster[getRoot(ids[cell.first])];
+      if (cluster == ids.size())
+      {
+        cluster = clusters.size();
+        clusters.emplace_back();
+      }
+      for (auto const & entry : cell.second)
+        clusters[cluster].push_back(entry.second);
+    }
+    return clusters;
+  }
+
+  double GetCellSize() const { return m_cellSize; }
+
+private:
+  using Cell = std::pair<int64_t, int64_t>;
+
+  struct CellHash
+  {
+    size_t operator()(Cell const & cell) const
+    {
+      std::hash<int64_t> const hash;
+      return hash(cell.first) * 1000003 ^ hash(cell.second);
+    }
+  };
+
+  Cell GetCell(double x, double y) const
+  {
+    return Cell(static_cast<int64_t>(std::floor(x / m_cellSize)),
+                static_cast<int64_t>(std::floor(y / m_cellSize)));
+  }
+
+  std::unordered_map<Cell, std::vector<std::pair<PointD, Value>>, CellHash> m_cells;
+  double const m_cellSize;
+};
+}  // namespace m2
@@ -8,7 +8,10 @@
 
 #include "std/vector.hpp"
 #include "std/algorithm.hpp"
+#include "std/cstdint.hpp"
+#include "std/function.hpp"
 #include "std/type_traits.hpp"
+#include "std/utility.hpp"
 
 
 namespace m2
@@ -75,9 +78,14 @@ namespace m2
     };
   }
 
+  template <class PointT>
+  class IndexedRegion;
+
   template <class PointT>
   class Region
   {
+    template <class TPoint>
+    friend class IndexedRegion;
     template <class TArchive, class TPoint>
     friend TArchive & operator << (TArchive & ar, Region<TPoint> const & region);
     template <class TArchive, class TPoint>
@@ -198,53 +206,68 @@ namespace m2
       int lCross = 0; /* number of left edge/ray crossings */
 
       size_t const numPoints = m_points.size();
+      for (size_t i = 0; i < numPoints; ++i)
+      {
+        if (AddCrossings(m_points[i == 0 ? numPoints - 1 : i - 1], m_points[i], pt, equalF,
+                         rCross, lCross))
+        {
+          return true;
+        }
+      }
+
+      return IsInside(rCross, lCross);
+    }
+
+    /// Adds crossings of the edge (|prev|, |curr|) with the horizontal rays from |pt| to
+    /// |rCross| and |lCross|. Returns true if |curr| is equal to |pt|.
+    /// @note The edge gives crossings only if y of |pt| is between y of its ends.
+    template <class TEqualF>
+    static bool AddCrossings(PointT const & prev, PointT const & curr, PointT const & pt,
+                             TEqualF equalF, int & rCross, int & lCross)
+    {
+      if (equalF.EqualPoints(curr, pt))
+        return true;
 
       typedef typename TraitsT::BigType BigCoordT;
       typedef Point<BigCoordT> BigPointT;
 
-      BigPointT prev = BigPointT(m_points[numPoints - 1]) - BigPointT(pt);
-      for (size_t i = 0; i < numPoints; ++i)
-      {
-        if (equalF.EqualPoints(m_points[i], pt))
-          return true;
+      BigPointT const prevV = BigPointT(prev) - BigPointT(pt);
+      BigPointT const currV = BigPointT(curr) - BigPointT(pt);
+
+      bool const rCheck = ((currV.y > 0) != (prevV.y > 0));
+      bool const lCheck = ((currV.y < 0) != (prevV.y < 0));
 
-        BigPointT const curr = BigPointT(m_points[i]) - BigPointT(pt);
+      if (rCheck || lCheck)
+      {
+        ASSERT_NOT_EQUAL ( currV.y, prevV.y, () );
 
-        bool const rCheck = ((curr.y > 0) != (prev.y > 0));
-        bool const lCheck = ((curr.y < 0) != (prev.y < 0));
+        BigCoordT const delta = prevV.y - currV.y;
+        BigCoordT const cp = CrossProduct(currV, prevV);
 
-        if (rCheck || lCheck)
+        // Squared precision is needed here because of comparison between cross product of two
+        // vectors and zero. It's impossible to compare them relatively, so they're compared
+        // absolutely, and, as cross product is proportional to product of lengths of both
+        // operands precision must be squared too.
+        if (!equalF.EqualZeroSquarePrecision(cp))
         {
-          ASSERT_NOT_EQUAL ( curr.y, prev.y, () );
-
-          BigCoordT const delta = prev.y - curr.y;
-          BigCoordT const cp = CrossProduct(curr, prev);
-
-          // Squared precision is needed here because of comparison between cross product of two
-          // vectors and zero. It's impossible to compare them relatively, so they're compared
-          // absolutely, and, as cross product is proportional to product of lengths of both
-          // operands precision must be squared too.
-          if (!equalF.EqualZeroSquarePrecision(cp))
-          {
-            bool const PrevGreaterCurr = delta > 0.0;
-
-            if (rCheck && ((cp > 0) == PrevGreaterCurr)) ++rCross;
-            if (lCheck && ((cp > 0) != PrevGreaterCurr)) ++lCross;
-          }
-        }
+          bool const PrevGreaterCurr = delta > 0.0;
 
-        prev = curr;
+          if (rCheck && ((cp > 0) == PrevGreaterCurr)) ++rCross;
+          if (lCheck && ((cp > 0) != PrevGreaterCurr)) ++lCross;
+        }
       }
 
+      return false;
+    }
+
+    static bool IsInside(int rCross, int lCross)
+    {
       /* q on the edge if left and right cross are not the same parity. */
       if ((rCross & 1) != (lCross & 1))
         return true;  // on the edge
 
       /* q inside if an odd number of crossings. */
-      if (rCross & 1)
-        return true;  // inside
-      else
-        return false; // outside
+      return (rCross & 1) != 0;
     }
 
     bool Contains(PointT const & pt) const
@@ -356,7 +379,120 @@ namespace m2
     return false;
   }
 
+  /// Region with its edges indexed by horizontal bands for repeated Contains() queries.
+  /// An edge gives crossings for a point only if y of the point is between y of the edge ends
+  /// and a vertex may be equal to the point only if their y are almost equal. So Contains()
+  /// checks the edges of the band of the point only, with the same predicates as
+  /// Region::Contains() does, and its results are the same.
+  template <class PointT>
+  class IndexedRegion
+  {
+  public:
+    typedef typename Region<PointT>::CoordT CoordT;
+
+    IndexedRegion() = default;
+    explicit IndexedRegion(Region<PointT> && region) : m_region(move(region)) { BuildIndex(); }
+
+    Region<PointT> const & GetRegion() const { return m_region; }
+    m2::Rect<CoordT> const & GetRect() const { return m_region.GetRect(); }
+    vector<PointT> const & Data() const { return m_region.Data(); }
+
+    bool Contains(PointT const & pt) const
+    {
+      if (!m_region.GetRect().IsPointInside(pt))
+        return false;
+
+      typename Region<PointT>::TraitsT::EqualType const equalF;
+      auto const & points = m_region.Data();
+      size_t const band = GetBand(static_cast<double>(pt.y));
+
+      int rCross = 0;
+      int lCross = 0;
+      for (uint32_t i = m_bandOffsets[band]; i < m_bandOffsets[band + 1]; ++i)
+      {
+        uint32_t const curr = m_bandEdges[i];
+        uint32_t const prev = curr == 0 ? static_cast<uint32_t>(points.size() - 1) : curr - 1;
+        if (Region<PointT>::AddCrossings(points[prev], points[curr], pt, equalF, rCross, lCross))
+          return true;
+      }
+
+      return Region<PointT>::IsInside(rCross, lCross);
+    }
+
+    bool AtBorder(PointT const & pt, double const delta) const
+    {
+      return m_region.AtBorder(pt, delta);
+    }
+
+    bool FindIntersection(PointT const & point1, PointT const & point2, PointT & result) const
+    {
+      return m_region.FindIntersection(point1, point2, result);
+    }
+
+  private:
+    // Average number of edges per band of a region with short edges.
+    static size_t constexpr kEdgesPerBand = 2;
+    static size_t constexpr kMaxBandsCount = 1 << 16;
+
+    size_t GetBand(double y) const
+    {
+      if (m_bandHeight <= 0.0 || y <= m_minY)
+        return 0;
+      return min(static_cast<size_t>((y - m_minY) / m_bandHeight), m_bandsCount - 1);
+    }
+
+    void BuildIndex()
+    {
+      auto const & points = m_region.Data();
+      m_bandsCount = my::clamp(points.size() / kEdgesPerBand, static_cast<size_t>(1),
+                               kMaxBandsCount);
+      m_minY = static_cast<double>(m_region.GetRect().minY());
+      m_bandHeight = (static_cast<double>(m_region.GetRect().maxY()) - m_minY) / m_bandsCount;
+
+      // Vertices which are almost equal to a point lie in the bands of the point.
+      double const margin =
+          is_floating_point<CoordT>::value ? 2 * detail::DefEqualFloat::kPrecision : 0.0;
+
+      // Edge i goes from point i - 1 to point i.
+      auto const forEachBand = [&](uint32_t edge, function<void(size_t band)> const & fn) {
+        PointT const & prev = points[edge == 0 ? points.size() - 1 : edge - 1];
+        PointT const & curr = points[edge];
+        double const minY = static_cast<double>(min(prev.y, curr.y)) - margin;
+        double const maxY = static_cast<double>(max(prev.y, curr.y)) + margin;
+        for (size_t band = GetBand(minY); band <= GetBand(maxY); ++band)
+          fn(band);
+      };
+
+      m_bandOffsets.assign(m_bandsCount + 1, 0);
+      for (uint32_t edge = 0; edge < points.size(); ++edge)
+        forEachBand(edge, [&](size_t band) { ++m_bandOffsets[band + 1]; });
+      for (size_t band = 0; band < m_bandsCount; ++band)
+        m_bandOffsets[band + 1] += m_bandOffsets[band];
+
+      m_bandEdges.resize(m_bandOffsets.back());
+      vector<uint32_t> filled(m_bandOffsets.begin(), m_bandOffsets.end() - 1);
+      for (uint32_t edge = 0; edge < points.size(); ++edge)
+        forEachBand(edge, [&](size_t band) { m_bandEdges[filled[band]++] = edge; });
+    }
+
+    Region<PointT> m_region;
+
+    double m_minY = 0.0;
+    double m_bandHeight = 0.0;
+    size_t m_bandsCount = 1;
+    // Edges which may give crossings for points of band i are
+    // m_bandEdges[m_bandOffsets[i], m_bandOffsets[i + 1]).
+    vector<uint32_t> m_bandOffsets = {0, 0};
+    vector<uint32_t> m_bandEdges;
+  };
+
+  template <class PointT>
+  size_t constexpr IndexedRegion<PointT>::kEdgesPerBand;
+  template <class PointT>
+  size_t constexpr IndexedRegion<PointT>::kMaxBandsCount;
+
   typedef Region<m2::PointD> RegionD;
   typedef Region<m2::PointI> RegionI;
   typedef Region<m2::PointU> RegionU;
+  typedef IndexedRegion<m2::PointD> IndexedRegionD;
 }
@@ -79,6 +79,33 @@ TAltitudes const & AltitudeLoader::GetAltitudes(uint32_t featureId, size_t point
   if (it != m_cache.end())
     return it->second;
 
+  ReaderSource<FilesContainerR::TReader> src(*m_reader);
+  return ReadAltitudes(featureId, pointCount, src);
+}
+
+void AltitudeLoader::LoadAltitudes(vector<pair<uint32_t, size_t>> features)
+{
+  if (!HasAltitudes())
+  {
+    for (auto const & feature : features)
+      GetAltitudes(feature.first, feature.second);
+    return;
+  }
+
+  // Offsets of altitudes in the section grow with feature ids, so all the features
+  // are read with a single forward pass.
+  sort(features.begin(), features.end());
+  ReaderSource<FilesContainerR::TReader> src(*m_reader);
+  for (auto const & feature : features)
+  {
+    if (m_cache.find(feature.first) == m_cache.end())
+      ReadAltitudes(feature.first, feature.second, src);
+  }
+}
+
+TAltitudes const & AltitudeLoader::ReadAltitudes(uint32_t featureId, size_t pointCount,
+                                                 ReaderSource<FilesContainerR::TReader> & src)
+{
   if (!m_altitudeAvailability[featureId])
   {
     LOG(LDEBUG, ("Feature Id", featureId, "of", m_countryFileName,
@@ -93,12 +120,16 @@ TAltitudes const & AltitudeLoader::GetAltitudes(uint32_t featureId, size_t point
 
   uint64_t const altitudeInfoOffsetInSection = m_header.m_altitudesOffset + offset;
   CHECK_LESS(altitudeInfoOffsetInSection, m_reader->Size(), ("Feature Id", featureId, "of", m_countryFileName));
+  if (src.Pos() > altitudeInfoOffsetInSection)
+  {
+    ReaderSource<FilesContainerR::TReader> sectionSrc(*m_reader);
+    return ReadAltitudes(featureId, pointCount, sectionSrc);
+  }
 
   try
   {
     Altitudes altitudes;
-    ReaderSource<FilesContainerR::TReader> src(*m_reader);
-    src.Skip(altitudeInfoOffsetInSection);
+    src.Skip(altitudeInfoOffsetInSection - src.Pos());
     bool const isDeserialized = altitudes.Deserialize(m_header.m_minAltitude, pointCount,
                                                       m_countryFileName, featureId,  src);
 
@@ -4,9 +4,11 @@
 #include "indexer/mwm_set.hpp"
 
 #include "coding/memory_region.hpp"
+#include "coding/reader.hpp"
 
 #include "std/string.hpp"
 #include "std/unique_ptr.hpp"
+#include "std/utility.hpp"
 #include "std/vector.hpp"
 
 #include "3party/succinct/rs_bit_vector.hpp"
@@ -22,11 +24,21 @@ public:
   /// or the returned vector is empty.
   TAltitudes const & GetAltitudes(uint32_t featureId, size_t pointCount);
 
+  /// \brief Loads altitudes of many features to the cache, so GetAltitudes() for them
+  /// doesn't touch the section. Altitudes are read in order of their offsets in the section.
+  /// \param features pairs of feature id and point count of the feature.
+  void LoadAltitudes(vector<pair<uint32_t, size_t>> features);
+
   bool HasAltitudes() const;
 
   void ClearCache() { m_cache.clear(); }
 
 private:
+  /// Reads altitudes of a feature and puts them to the cache. |src| is moved forward to
+  /// the altitudes of the feature. If |src| is already beyond them, they're read by a new source.
+  TAltitudes const & ReadAltitudes(uint32_t featureId, size_t pointCount,
+                                   ReaderSource<FilesContainerR::TReader> & src);
+
   unique_ptr<CopiedMemoryRegion> m_altitudeAvailabilityRegion;
   unique_ptr<CopiedMemoryRegion> m_featureTableRegion;
 
@@ -17,11 +17,15 @@
 #include "base/checked_cast.hpp"
 #include "base/logging.hpp"
 
+#include "std/array.hpp"
+#include "std/cstring.hpp"
 #include "std/unordered_map.hpp"
 
 #include "3party/succinct/elias_fano.hpp"
 #include "3party/succinct/rs_bit_vector.hpp"
 
+#include "defines.hpp"
+
 namespace search
 {
 namespace
@@ -134,7 +138,12 @@ public:
   static_assert(sizeof(Header) == 16, "Wrong header size.");
 
   CentersTableV0(Reader & reader, serial::CodingParams const & codingParams)
-    : m_reader(reader), m_codingParams(codingParams)
+    : m_reader(&reader), m_codingParams(codingParams)
+  {
+  }
+
+  CentersTableV0(unique_ptr<MemoryRegion> && region, serial::CodingParams const & codingParams)
+    : m_region(move(region)), m_codingParams(codingParams)
   {
   }
 
@@ -147,72 +156,122 @@ public:
     uint32_t const base = rank / kBlockSize;
     uint32_t const offset = rank % kBlockSize;
 
-    auto & entry = m_cache[base];
-    if (entry.empty())
+    auto it = m_cache.find(base);
+    if (it == m_cache.end())
     {
-      entry.resize(kBlockSize);
+      it = m_cache.emplace(base, TBlock()).first;
 
       auto const start = m_offsets.select(base);
       auto const end = base + 1 < m_offsets.num_ones()
                            ? m_offsets.select(base + 1)
                            : m_header.m_endOffset - m_header.m_deltasOffset;
 
-      vector<uint8_t> data(end - start);
-
-      m_reader.Read(m_header.m_deltasOffset + start, data.data(), data.size());
-
-      MemReader mreader(data.data(), data.size());
-      NonOwningReaderSource msource(mreader);
-
-      uint64_t delta = ReadVarUint<uint64_t>(msource);
-      entry[0] = DecodeDelta(delta, m_codingParams.GetBasePoint());
-
-      for (size_t i = 1; i < kBlockSize && msource.Size() > 0; ++i)
+      if (m_region)
+      {
+        // Deltas are decoded right from the mapped memory.
+        MemReader mreader(m_region->ImmutableData() + m_header.m_deltasOffset + start,
+                          end - start);
+        DecodeBlock(mreader, it->second);
+      }
+      else
       {
-        delta = ReadVarUint<uint64_t>(msource);
-        entry[i] = DecodeDelta(delta, entry[i - 1]);
+        vector<uint8_t> data(end - start);
+        m_reader->Read(m_header.m_deltasOffset + start, data.data(), data.size());
+        MemReader mreader(data.data(), data.size());
+        DecodeBlock(mreader, it->second);
       }
     }
 
-    center = PointU2PointD(entry[offset], m_codingParams.GetCoordBits());
+    center = PointU2PointD(it->second[offset], m_codingParams.GetCoordBits());
     return true;
   }
 
 private:
+  using TBlock = array<m2::PointU, kBlockSize>;
+
   // CentersTable overrides:
   bool Init() override
   {
-    m_header.Read(m_reader);
+    if (m_region)
+    {
+      if (m_region->Size() < sizeof(m_header))
+        return false;
+      MemReader reader(m_region->ImmutableData(), m_region->Size());
+      m_header.Read(reader);
+    }
+    else
+    {
+      m_header.Read(*m_reader);
+    }
 
     if (!m_header.IsValid())
       return false;
 
+    if (m_region && m_header.m_endOffset > m_region->Size())
+    {
+      LOG(LERROR, ("End of section after end of region:", m_header.m_endOffset, m_region->Size()));
+      return false;
+    }
+
     bool const isHostBigEndian = IsBigEndian();
     bool const isDataBigEndian = m_header.m_base.m_endianness == 1;
     bool const endiannesMismatch = isHostBigEndian != isDataBigEndian;
 
+    MapPart(sizeof(m_header), m_header.m_positionsOffset, endiannesMismatch, m_idsRegion, m_ids);
+    MapPart(m_header.m_positionsOffset, m_header.m_deltasOffset, endiannesMismatch,
+            m_offsetsRegion, m_offsets);
+    return true;
+  }
+
+  // Maps |cont| right onto the memory region when it's possible,
+  // otherwise maps |cont| onto a copy of the [begin, end) part of the
+  // table.
+  template <typename TCont>
+  void MapPart(uint32_t begin, uint32_t end, bool endiannesMismatch,
+               unique_ptr<CopiedMemoryRegion> & copy, TCont & cont)
+  {
+    if (m_region && !endiannesMismatch)
     {
-      uint32_t const idsSize = m_header.m_positionsOffset - sizeof(m_header);
-      vector<uint8_t> data(idsSize);
-      m_reader.Read(sizeof(m_header), data.data(), data.size());
-      m_idsRegion = make_unique<CopiedMemoryRegion>(move(data));
-      EndiannessAwareMap(endiannesMismatch, *m_idsRegion, m_ids);
+      uint8_t const * data = m_region->ImmutableData() + begin;
+      if (reinterpret_cast<uintptr_t>(data) % sizeof(uint64_t) == 0)
+      {
+        TCont c;
+        coding::MapVisitor visitor(data);
+        c.map(visitor);
+        c.swap(cont);
+        return;
+      }
     }
 
+    vector<uint8_t> data(end - begin);
+    if (m_region)
+      memcpy(data.data(), m_region->ImmutableData() + begin, data.size());
+    else
+      m_reader->Read(begin, data.data(), data.size());
+    copy = make_unique<CopiedMemoryRegion>(move(data));
+    EndiannessAwareMap(endiannesMismatch, *copy, cont);
+  }
+
+  void DecodeBlock(MemReader & reader, TBlock & block) const
+  {
+    NonOwningReaderSource source(reader);
+
+    uint64_t delta = ReadVarUint<uint64_t>(source);
+    block[0] = DecodeDelta(delta, m_codingParams.GetBasePoint());
+
+    for (size_t i = 1; i < kBlockSize && source.Size() > 0; ++i)
     {
-      uint32_t const offsetsSize = m_header.m_deltasOffset - m_header.m_positionsOffset;
-      vector<uint8_t> data(offsetsSize);
-      m_reader.Read(m_header.m_positionsOffset, data.data(), data.size());
-      m_offsetsRegion = make_unique<CopiedMemoryRegion>(move(data));
-      EndiannessAwareMap(endiannesMismatch, *m_offsetsRegion, m_offsets);
+      delta = ReadVarUint<uint64_t>(source);
+      block[i] = DecodeDelta(delta, block[i - 1]);
     }
-
-    return true;
   }
 
-private:
   Header m_header;
-  Reader & m_reader;
+
+  // Exactly one of |m_reader| and |m_region| is set.
+  Reader * m_reader = nullptr;
+  unique_ptr<MemoryRegion> m_region;
+
   serial::CodingParams const m_codingParams;
 
   unique_ptr<CopiedMemoryRegion> m_idsRegion;
@@ -221,7 +280,7 @@ private:
   succinct::rs_bit_vector m_ids;
   succinct::elias_fano m_offsets;
 
-  unordered_map<uint32_t, vector<m2::PointU>> m_cache;
+  unordered_map<uint32_t, TBlock> m_cache;
 };
 }  // namespace
 
@@ -263,6 +322,33 @@ unique_ptr<CentersTable> CentersTable::Load(Reader & reader,
   return table;
 }
 
+// static
+unique_ptr<CentersTable> CentersTable::Load(unique_ptr<MemoryRegion> && region,
+                                            serial::CodingParams const & codingParams)
+{
+  if (!region || region->Size() < sizeof(uint16_t))
+    return unique_ptr<CentersTable>();
+
+  MemReader reader(region->ImmutableData(), region->Size());
+  uint16_t const version = ReadPrimitiveFromPos<uint16_t>(reader, 0 /* pos */);
+  if (version != 0)
+    return unique_ptr<CentersTable>();
+
+  unique_ptr<CentersTable> table = make_unique<CentersTableV0>(move(region), codingParams);
+  if (!table->Init())
+    return unique_ptr<CentersTable>();
+  return table;
+}
+
+// static
+unique_ptr<CentersTable> CentersTable::Load(FilesMappingContainer const & mcont,
+                                            serial::CodingParams const & codingParams)
+{
+  if (!mcont.IsExist(CENTERS_FILE_TAG))
+    return unique_ptr<CentersTable>();
+  return Load(make_unique<MappedMemoryRegion>(mcont.Map(CENTERS_FILE_TAG)), codingParams);
+}
+
 // CentersTableBuilder -----------------------------------------------------------------------------
 void CentersTableBuilder::Put(uint32_t featureId, m2::PointD const & center)
 {
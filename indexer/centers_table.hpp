@@ -9,6 +9,8 @@
 #include "std/vector.hpp"
 
 class FilesContainerR;
+class FilesMappingContainer;
+class MemoryRegion;
 class Reader;
 class Writer;
 
@@ -55,6 +57,18 @@ public:
   // CentersTable can't be loaded.
   static unique_ptr<CentersTable> Load(Reader & reader, serial::CodingParams const & codingParams);
 
+  // Loads CentersTable instance which decodes centers right from
+  // |region| without intermediate buffers. Returns nullptr if
+  // CentersTable can't be loaded.
+  static unique_ptr<CentersTable> Load(unique_ptr<MemoryRegion> && region,
+                                       serial::CodingParams const & codingParams);
+
+  // Loads CentersTable instance from the memory-mapped centers
+  // section of |mcont|. Returns nullptr if there is no such section
+  // or CentersTable can't be loaded.
+  static unique_ptr<CentersTable> Load(FilesMappingContainer const & mcont,
+                                       serial::CodingParams const & codingParams);
+
 private:
   virtual bool Init() = 0;
 };
@@ -54,6 +54,7 @@ void ClassifObject::AddDrawRule(drule::Key const & k)
     if (k == *i)
       return; // already exists
   m_drawRule.insert(i, k);
+  m_suitable.clear();
 }
 
 ClassifObjectPtr ClassifObject::BinaryFind(string const & s) const
@@ -82,6 +83,7 @@ void ClassifObject::LoadPolicy::EndChilds()
 
 void ClassifObject::Sort()
 {
+  m_suitable.clear();
   sort(m_drawRule.begin(), m_drawRule.end(), less_scales());
   sort(m_objs.begin(), m_objs.end(), less_name_t());
   for_each(m_objs.begin(), m_objs.end(), bind(&ClassifObject::Sort, _1));
@@ -93,6 +95,7 @@ void ClassifObject::Swap(ClassifObject & r)
   swap(m_drawRule, r.m_drawRule);
   swap(m_objs, r.m_objs);
   swap(m_visibility, r.m_visibility);
+  swap(m_suitable, r.m_suitable);
 }
 
 ClassifObject const * ClassifObject::GetObject(size_t i) const
@@ -219,18 +222,12 @@ namespace ftype
   void TruncValue(uint32_t & type, uint8_t level)
   {
     ASSERT_GREATER ( level, 0, () );
-    uint8_t cl = get_control_level(type);
+    if (get_control_level(type) <= level)
+      return;
 
-    while (cl > level)
-    {
-      // remove control level
-      set_value(type, cl, 0);
-
-      --cl;
-
-      // set control level
-      set_value(type, cl, 1);
-    }
+    // Keep values of the first |level| levels and set control level right after them.
+    uint8_t const bits = level * bits_count;
+    type = (type & ((uint32_t(1) << bits) - 1)) | (uint32_t(1) << bits);
   }
 
   uint8_t GetLevel(uint32_t type)
@@ -241,6 +238,16 @@ namespace ftype
 
 namespace
 {
+  bool IsSuitable(int ft, int ruleType)
+  {
+    static const int visible[3][drule::count_of_rules] = {
+      { 0, 0, 1, 1, 1, 0, 0, 0 },   // fpoint
+      { 1, 0, 0, 0, 0, 1, 0, 1 },   // fline
+      { 1, 1, 1, 1, 1, 0, 0, 0 }    // farea
+    };
+    return visible[ft][ruleType] == 1;
+  }
+
   class suitable_getter
   {
     typedef vector<drule::Key> vec_t;
@@ -253,13 +260,7 @@ namespace
 
     void add_rule(int ft, iter_t i)
     {
-      static const int visible[3][drule::count_of_rules] = {
-        { 0, 0, 1, 1, 1, 0, 0, 0 },   // fpoint
-        { 1, 0, 0, 0, 0, 1, 0, 1 },   // fline
-        { 1, 1, 1, 1, 1, 0, 0, 0 }    // farea
-      };
-
-      if (visible[ft][i->m_type] == 1)
+      if (IsSuitable(ft, i->m_type))
       {
         m_keys.push_back(*i);
         m_added = true;
@@ -289,11 +290,47 @@ void ClassifObject::GetSuitable(int scale, feature::EGeomType ft, drule::KeysT &
   if (!m_visibility[scale])
     return;
 
+  if (!m_suitable.empty())
+  {
+    SuitableRules const & rules = m_suitable[ft];
+    keys.append(rules.m_keys.begin() + rules.m_offsets[scale],
+                rules.m_keys.begin() + rules.m_offsets[scale + 1]);
+    return;
+  }
+
   // find rules for 'scale'
   suitable_getter rulesGetter(m_drawRule, keys);
   rulesGetter.find(ft, scale);
 }
 
+void ClassifObject::PrecomputeSuitable()
+{
+  m_suitable.clear();
+  if (!m_drawRule.empty())
+  {
+    m_suitable.resize(3);
+    for (int ft = 0; ft < 3; ++ft)
+    {
+      SuitableRules & rules = m_suitable[ft];
+      // |m_drawRule| is sorted by scales.
+      size_t i = 0;
+      for (int scale = 0; scale < static_cast<int>(rules.m_offsets.size()); ++scale)
+      {
+        rules.m_offsets[scale] = static_cast<uint32_t>(rules.m_keys.size());
+        for (; i < m_drawRule.size() && m_drawRule[i].m_scale == scale; ++i)
+        {
+          if (IsSuitable(ft, m_drawRule[i].m_type))
+            rules.m_keys.push_back(m_drawRule[i]);
+        }
+      }
+      ASSERT_EQUAL(i, m_drawRule.size(), ());
+    }
+  }
+
+  for (auto & obj : m_objs)
+    obj.PrecomputeSuitable();
+}
+
 bool ClassifObject::IsDrawable(int scale) const
 {
   return (m_visibility[scale] && IsDrawableAny());
@@ -371,6 +408,16 @@ void Classificator::ReadClassificator(istream & s)
   m_coastType = GetTypeByPath({ "natural", "coastline" });
 }
 
+void Classificator::ReadClassificator(ClassifObject & root)
+{
+  m_root.Swap(root);
+  ClassifObject().Swap(root);
+
+  m_root.Sort();
+
+  m_coastType = GetTypeByPath({ "natural", "coastline" });
+}
+
 void Classificator::SortClassificator()
 {
   GetMutableRoot()->Sort();
@@ -427,6 +474,11 @@ void Classificator::ReadTypesMapping(istream & s)
   m_mapping.Load(s);
 }
 
+void Classificator::ReadTypesMapping(vector<uint32_t> const & types)
+{
+  m_mapping.Load(types);
+}
+
 void Classificator::Clear()
 {
   ClassifObject("world").Swap(m_root);
@@ -6,6 +6,7 @@
 #include "indexer/scales.hpp"
 #include "indexer/types_mapping.hpp"
 
+#include "std/array.hpp"
 #include "std/bitset.hpp"
 #include "std/initializer_list.hpp"
 #include "std/iostream.hpp"
@@ -77,10 +78,14 @@ public:
 
   string const & GetName() const { return m_name; }
   ClassifObject const * GetObject(size_t i) const;
+  size_t GetObjectsCount() const { return m_objs.size(); }
 
   void ConcatChildNames(string & s) const;
 
   void GetSuitable(int scale, feature::EGeomType ft, drule::KeysT & keys) const;
+  /// Builds a flat table of GetSuitable() results for all scales and geometry types.
+  /// Should be called for the whole tree after all draw rules are added.
+  void PrecomputeSuitable();
   inline vector<drule::Key> const & GetDrawingRules() const { return m_drawRule; }
 
   bool IsDrawable(int scale) const;
@@ -142,10 +147,20 @@ public:
   //@}
 
 private:
+  // Draw rules suitable for a geometry type, sorted by scales, and offsets
+  // of the first rule of every scale in |m_keys|.
+  struct SuitableRules
+  {
+    vector<drule::Key> m_keys;
+    array<uint32_t, scales::UPPER_STYLE_SCALE + 2> m_offsets;
+  };
+
   string m_name;
   vector<drule::Key> m_drawRule;
   vector<ClassifObject> m_objs;
   TVisibleMask m_visibility;
+  // Suitable rules for every geometry type, empty until PrecomputeSuitable().
+  vector<SuitableRules> m_suitable;
 };
 
 inline void swap(ClassifObject & r1, ClassifObject & r2)
@@ -173,6 +188,11 @@ public:
   void ReadClassificator(istream & s);
   void ReadTypesMapping(istream & s);
 
+  /// Takes the tree and the types which are loaded from the binary cache,
+  /// see classificator_cache.hpp. |root| is left empty.
+  void ReadClassificator(ClassifObject & root);
+  void ReadTypesMapping(vector<uint32_t> const & types);
+
   void SortClassificator();
   //@}
 
@@ -197,6 +217,7 @@ public:
   uint32_t GetIndexForType(uint32_t t) const { return m_mapping.GetIndex(t); }
   uint32_t GetTypeForIndex(uint32_t i) const { return m_mapping.GetType(i); }
   bool IsTypeValid(uint32_t t) const { return m_mapping.HasIndex(t); }
+  IndexAndTypeMapping const & GetTypesMapping() const { return m_mapping; }
 
   inline uint32_t GetCoastType() const { return m_coastType; }
 
@@ -0,0 +1,130 @@
+#include "indexer/classificator_cache.hpp"
+
+#include "indexer/classificator.hpp"
+
+#include "coding/read_write_utils.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/logging.hpp"
+
+#include <vector>
+
+using namespace std;
+
+namespace classificator
+{
+namespace
+{
+uint32_t constexpr kVersion = 0;
+// The same limit as in tree::LoadTreeAsText().
+uint32_t constexpr kMaxChildrenCount = 128;
+// Protects from deep recursion on broken data, real trees are much lower.
+uint32_t constexpr kMaxDepth = 16;
+
+// 64-bit FNV-1a.
+void UpdateHash(uint64_t & hash, string const & s)
+{
+  for (unsigned char const c : s)
+  {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+}
+
+template <typename Sink>
+void SaveTree(ClassifObject const & obj, Sink & sink)
+{
+  rw::Write(sink, obj.GetName());
+  uint32_t const count = static_cast<uint32_t>(obj.GetObjectsCount());
+  WriteVarUint(sink, count);
+  for (uint32_t i = 0; i < count; ++i)
+    SaveTree(*obj.GetObject(i), sink);
+}
+
+template <typename Source>
+void LoadTree(Source & src, ClassifObject::LoadPolicy & policy, uint32_t depth)
+{
+  string name;
+  rw::Read(src, name);
+  policy.Name(name);
+
+  uint32_t const count = ReadVarUint<uint32_t>(src);
+  if (count > kMaxChildrenCount || (count != 0 && depth == kMaxDepth))
+    MYTHROW(Reader::Exception, ("Bad classificator tree:", name, count, depth));
+
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    policy.Start(i);
+    LoadTree(src, policy, depth + 1);
+    policy.End();
+  }
+}
+}  // namespace
+
+uint64_t GetSourcesHash(string const & classificatorText, string const & typesText)
+{
+  uint64_t hash = 14695981039346656037ULL;
+  UpdateHash(hash, classificatorText);
+  // Separates the files, so moving text from one file to another changes the hash.
+  UpdateHash(hash, string(1, '\0'));
+  UpdateHash(hash, typesText);
+  return hash;
+}
+
+void SaveCache(Classificator const & c, uint64_t sourcesHash, Writer & writer)
+{
+  WriteToSink(writer, kVersion);
+  WriteToSink(writer, sourcesHash);
+  SaveTree(*c.GetRoot(), writer);
+
+  auto const & types = c.GetTypesMapping().GetTypes();
+  WriteVarUint(writer, static_cast<uint32_t>(types.size()));
+  for (auto const type : types)
+    WriteVarUint(writer, type);
+}
+
+bool LoadCache(Reader const & reader, uint64_t sourcesHash, Classificator & c)
+{
+  ClassifObject root;
+  vector<uint32_t> types;
+  try
+  {
+    NonOwningReaderSource src(reader);
+    auto const version = ReadPrimitiveFromSource<uint32_t>(src);
+    if (version != kVersion)
+    {
+      LOG(LWARNING, ("Unknown version of classificator cache:", version));
+      return false;
+    }
+    if (ReadPrimitiveFromSource<uint64_t>(src) != sourcesHash)
+    {
+      LOG(LINFO, ("Classificator cache is built for other sources."));
+      return false;
+    }
+
+    ClassifObject::LoadPolicy policy(&root);
+    LoadTree(src, policy, 0 /* depth */);
+
+    uint32_t const count = ReadVarUint<uint32_t>(src);
+    // Every type takes at least one byte.
+    if (count > src.Size())
+      MYTHROW(Reader::Exception, ("Bad number of types:", count));
+    types.resize(count);
+    for (auto & type : types)
+      type = ReadVarUint<uint32_t>(src);
+
+    if (src.Size() != 0)
+      MYTHROW(Reader::Exception, ("Trailing data in classificator cache:", src.Size()));
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't read classificator cache:", e.Msg()));
+    return false;
+  }
+
+  c.ReadClassificator(root);
+  c.ReadTypesMapping(types);
+  return true;
+}
+}  // namespace classificator
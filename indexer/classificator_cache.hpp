@@ -0,0 +1,27 @@
+#pragma once
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include <cstdint>
+#include <string>
+
+class Classificator;
+
+namespace classificator
+{
+// Binary form of classificator.txt and types.txt which is loaded without text parsing.
+// It's generated by generator_tool --generate_classif and is used only when it's built from
+// the same text files: the hash of their contents is stored in the header.
+//
+// Format:
+// [version: uint32] [hash of sources: uint64]
+// [tree in pre-order, every node is: name, number of children]
+// [number of types] [types in order of indices]
+uint64_t GetSourcesHash(std::string const & classificatorText, std::string const & typesText);
+
+void SaveCache(Classificator const & c, uint64_t sourcesHash, Writer & writer);
+
+// Returns false and leaves |c| unchanged when the cache is built for other sources or is broken.
+bool LoadCache(Reader const & reader, uint64_t sourcesHash, Classificator & c);
+}  // namespace classificator
@@ -1,41 +1,71 @@
 #include "indexer/classificator_loader.hpp"
 #include "indexer/classificator.hpp"
+#include "indexer/classificator_cache.hpp"
 #include "indexer/drawing_rules.hpp"
 #include "indexer/map_style_reader.hpp"
 
 #include "platform/platform.hpp"
 
-#include "coding/reader_streambuf.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/reader.hpp"
 
 #include "base/logging.hpp"
 
-#include "std/iostream.hpp"
+#include "defines.hpp"
+
+#include "std/sstream.hpp"
 
 
 namespace
 {
-void ReadCommon(unique_ptr<Reader> classificator,
-                unique_ptr<Reader> types)
+char const kClassificatorFile[] = "classificator.txt";
+char const kTypesFile[] = "types.txt";
+
+struct Sources
+{
+  Sources()
+  {
+    Platform & p = GetPlatform();
+    p.GetReader(kClassificatorFile)->ReadAsString(m_classificator);
+    p.GetReader(kTypesFile)->ReadAsString(m_types);
+    m_hash = classificator::GetSourcesHash(m_classificator, m_types);
+  }
+
+  string m_classificator;
+  string m_types;
+  uint64_t m_hash;
+};
+
+void ReadCommon(Sources const & sources)
 {
   Classificator & c = classif();
   c.Clear();
 
   {
     //LOG(LINFO, ("Reading classificator"));
-    ReaderStreamBuf buffer(move(classificator));
-
-    istream s(&buffer);
+    istringstream s(sources.m_classificator);
     c.ReadClassificator(s);
   }
 
   {
     //LOG(LINFO, ("Reading types mapping"));
-    ReaderStreamBuf buffer(move(types));
-
-    istream s(&buffer);
+    istringstream s(sources.m_types);
     c.ReadTypesMapping(s);
   }
 }
+
+// Returns the cache file if it exists.
+unique_ptr<Reader> GetCacheReader()
+{
+  try
+  {
+    return GetPlatform().GetReader(CLASSIFICATOR_CACHE_FILE);
+  }
+  catch (RootException const &)
+  {
+    return nullptr;
+  }
+}
 }  // namespace
 
 namespace classificator
@@ -44,7 +74,9 @@ void Load()
 {
   LOG(LDEBUG, ("Reading of classificator started"));
 
-  Platform & p = GetPlatform();
+  // Text files are the same for all styles, so they are read once.
+  Sources const sources;
+  auto const cache = GetCacheReader();
 
   MapStyle const originMapStyle = GetStyleReader().GetCurrentStyle();
 
@@ -55,8 +87,8 @@ void Load()
     if (mapStyle != MapStyleMerged || originMapStyle == MapStyleMerged)
     {
       GetStyleReader().SetCurrentStyle(mapStyle);
-      ReadCommon(p.GetReader("classificator.txt"),
-                 p.GetReader("types.txt"));
+      if (!cache || !LoadCache(*cache, sources.m_hash, classif()))
+        ReadCommon(sources);
 
       drule::LoadRules();
     }
@@ -66,4 +98,14 @@ void Load()
 
   LOG(LDEBUG, ("Reading of classificator finished"));
 }
+
+void GenerateCache(string const & filePath)
+{
+  Sources const sources;
+  ReadCommon(sources);
+
+  FileWriter writer(filePath);
+  SaveCache(classif(), sources.m_hash, writer);
+  LOG(LINFO, ("Classificator cache is saved to", filePath));
+}
 }  // namespace classificator
@@ -6,4 +6,8 @@
 namespace classificator
 {
   void Load();
+
+  /// Reads classificator of the current style from the text files and saves its binary form,
+  /// which is used by Load() while the text files aren't changed, to |filePath|.
+  void GenerateCache(string const & filePath);
 }
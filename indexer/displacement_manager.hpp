@@ -8,13 +8,18 @@
 #include "indexer/scales.hpp"
 
 #include "geometry/point2d.hpp"
+#include "geometry/points_grid.hpp"
 #include "geometry/rect2d.hpp"
 #include "geometry/screenbase.hpp"
-#include "geometry/tree4d.hpp"
 
+#include "base/thread.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/atomic.hpp"
 #include "std/map.hpp"
 #include "std/queue.hpp"
 #include "std/target_os.hpp"
+#include "std/thread.hpp"
 #include "std/vector.hpp"
 
 namespace
@@ -105,6 +110,12 @@ public:
     }
 
     // Pass feature to the index otherwise.
+    AddNotDisplaceable(cells, bucket, index);
+  }
+
+  /// Pass feature which can't be displaced, i.e. not a point feature, to the bucket.
+  void AddNotDisplaceable(vector<int64_t> const & cells, uint32_t bucket, uint32_t index)
+  {
     for (auto const & cell : cells)
       m_sorter.Add(CellFeatureBucketTuple(CellFeaturePair(cell, index), bucket));
   }
@@ -115,48 +126,48 @@ public:
   /// After all features passed to sorter.
   void Displace()
   {
-    m4::Tree<DisplaceableNode> acceptedNodes;
-
     // Sort in priority descend mode.
     sort(m_storage.begin(), m_storage.end(), greater<DisplaceableNode>());
 
-    for (auto const & node : m_storage)
-    {
-      auto scale = node.m_minScale;
-      // Do not filter high level objects. Including metro and country names.
-      static auto const maximumIgnoredZoom = feature::GetDrawableScaleRange(
-        classif().GetTypeByPath({"railway", "station", "subway"})).first;
+    // Do not filter high level objects. Including metro and country names.
+    static auto const maximumIgnoredZoom = feature::GetDrawableScaleRange(
+      classif().GetTypeByPath({"railway", "station", "subway"})).first;
 
-      if (maximumIgnoredZoom < 0 || scale <= maximumIgnoredZoom)
-      {
-        AddNodeToSorter(node, static_cast<uint32_t>(scale));
-        acceptedNodes.Add(node);
-        continue;
-      }
-      for (; scale < scales::GetUpperScale(); ++scale)
-      {
-        float const delta = CalculateDeltaForZoom(scale);
-        float const squaredDelta = delta * delta;
-
-        m2::RectD const displacementRect(node.m_center, node.m_center);
-        bool isDisplaced = false;
-        acceptedNodes.ForEachInRect(m2::Inflate(displacementRect, {delta, delta}),
-            [&isDisplaced, &node, &squaredDelta, &scale](DisplaceableNode const & rhs)
-            {
-              if (node.m_center.SquareLength(rhs.m_center) < squaredDelta && rhs.m_maxScale > scale)
-                isDisplaced = true;
-            });
-        if (isDisplaced)
-          continue;
-
-        // Add feature to index otherwise.
-        AddNodeToSorter(node, scale);
-        acceptedNodes.Add(node);
-        break;
-      }
-      if (scale == scales::GetUpperScale())
-        AddNodeToSorter(node, scale);
+    vector<int> scales(m_storage.size());
+    if (maximumIgnoredZoom < 0)
+    {
+      for (size_t i = 0; i < m_storage.size(); ++i)
+        scales[i] = m_storage[i].m_minScale;
     }
+    else
+    {
+      // A node may be displaced only by nodes which are closer than the displacement radius
+      // at the first displaceable zoom level, so clusters of close nodes are independent
+      // and are displaced in parallel. The result doesn't depend on the number of threads.
+      m2::PointsGrid<uint32_t> grid(CalculateDeltaForZoom(maximumIgnoredZoom + 1));
+      grid.Reserve(m_storage.size());
+      for (uint32_t i = 0; i < m_storage.size(); ++i)
+        grid.Add(m_storage[i].m_center, i);
+      auto clusters = grid.GetClusters();
+
+      atomic<size_t> nextCluster(0);
+      auto const displace = [&]() {
+        for (size_t i = nextCluster++; i < clusters.size(); i = nextCluster++)
+          DisplaceCluster(clusters[i], maximumIgnoredZoom, scales);
+      };
+
+      size_t const threadsCount =
+          min(static_cast<size_t>(max(thread::hardware_concurrency(), 1u)), clusters.size());
+      vector<threads::SimpleThread> threads;
+      for (size_t i = 1; i < threadsCount; ++i)
+        threads.emplace_back(displace);
+      displace();
+      for (auto & thread : threads)
+        thread.join();
+    }
+
+    for (size_t i = 0; i < m_storage.size(); ++i)
+      AddNodeToSorter(m_storage[i], static_cast<uint32_t>(scales[i]));
   }
 
 private:
@@ -205,11 +216,13 @@ private:
     // Same to dynamic displacement behaviour.
     bool operator>(DisplaceableNode const & rhs) const
     {
-      if (m_priority > rhs.m_priority)
-        return true;
-      return (m_priority == rhs.m_priority && m_fID < rhs.m_fID);
+      if (m_priority != rhs.m_priority)
+        return m_priority > rhs.m_priority;
+      // Ties are broken by ids, so the order doesn't depend on the sort implementation.
+      if (m_fID != rhs.m_fID)
+        return m_fID < rhs.m_fID;
+      return m_index < rhs.m_index;
     }
-    m2::RectD const GetLimitRect() const { return m2::RectD(m_center, m_center); }
   };
 
   template <class TFeature>
@@ -219,10 +232,57 @@ private:
     return types.GetGeoType() == feature::GEOM_POINT;
   }
 
+  /// Calculates scales for nodes of a |cluster|, i.e. for nodes with given positions in m_storage.
+  void DisplaceCluster(vector<uint32_t> & cluster, int maximumIgnoredZoom, vector<int> & scales) const
+  {
+    // Nodes of a cluster are grouped by grid cells, so they're sorted back in priority order.
+    sort(cluster.begin(), cluster.end());
+
+    // Accepted nodes are indexed by a hash grid per zoom level with cells of the displacement
+    // radius at the level, so a check whether a node is displaced takes constant time.
+    vector<m2::PointsGrid<DisplaceableNode const *>> acceptedNodes;
+    if (cluster.size() > 1)
+    {
+      for (int scale = 0; scale < scales::GetUpperScale(); ++scale)
+        acceptedNodes.emplace_back(CalculateDeltaForZoom(scale));
+    }
+
+    for (auto const i : cluster)
+    {
+      DisplaceableNode const & node = m_storage[i];
+      auto scale = node.m_minScale;
+      for (; scale > maximumIgnoredZoom && scale < scales::GetUpperScale(); ++scale)
+      {
+        if (acceptedNodes.empty())
+          break;
+
+        float const delta = CalculateDeltaForZoom(scale);
+        float const squaredDelta = delta * delta;
+
+        bool const isDisplaced = acceptedNodes[scale].AnyNearby(
+            node.m_center, [&node, squaredDelta, scale](m2::PointD const & center,
+                                                        DisplaceableNode const * rhs) {
+              return node.m_center.SquareLength(center) < squaredDelta && rhs->m_maxScale > scale;
+            });
+        if (!isDisplaced)
+          break;
+      }
+      scales[i] = scale;
+
+      if (acceptedNodes.empty() || scale == scales::GetUpperScale())
+        continue;
+
+      // Only nodes which are still visible at a level may displace other nodes there.
+      int const maxScale = min(node.m_maxScale, scales::GetUpperScale());
+      for (int s = maximumIgnoredZoom + 1; s < maxScale; ++s)
+        acceptedNodes[s].Add(node.m_center, &node);
+    }
+  }
+
   float CalculateDeltaForZoom(int32_t zoom) const
   {
     // zoom - 1 is similar to drape.
-    double const worldSizeDivisor = 1 << (zoom - 1);
+    double const worldSizeDivisor = 1 << max(zoom - 1, 0);
     return kPOIDisplacementRadiusMultiplier / worldSizeDivisor;
   }
 
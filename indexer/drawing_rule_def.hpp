@@ -12,6 +12,8 @@ namespace drule
     int m_type;
     int m_index;
     int m_priority;
+    /// True if the rule is applied only to features which match its runtime selector.
+    bool m_hasSelector = false;
 
     Key() : m_scale(-1), m_type(-1), m_index(-1), m_priority(-1) {}
     Key(int s, int t, int i) : m_scale(s), m_type(t), m_index(i), m_priority(-1) {}
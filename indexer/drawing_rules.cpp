@@ -389,11 +389,13 @@ namespace
         }
       }
 
+      bool const hasSelector = selector != nullptr;
       BaseRule * obj = new TRule(rule);
       obj->SetSelector(move(selector));
       Key k = m_holder.AddRule(scale, type, obj);
       p->SetVisibilityOnScale(true, scale);
       k.SetPriority(rule.priority());
+      k.m_hasSelector = hasSelector;
       p->AddDrawRule(k);
     }
 
@@ -524,6 +526,7 @@ void RulesHolder::LoadFromBinaryProto(string const & s)
   CHECK ( doSet.m_cont.ParseFromString(s), ("Error in proto loading!") );
 
   classif().GetMutableRoot()->ForEachObject(ref(doSet));
+  classif().GetMutableRoot()->PrecomputeSuitable();
 
   InitBackgroundColors(doSet.m_cont);
   InitColors(doSet.m_cont);
@@ -367,6 +367,13 @@ void FeatureType::ParseMetadata() const
   m_metadataParsed = true;
 }
 
+string FeatureType::GetMetadataField(feature::Metadata::EType type) const
+{
+  if (m_metadataParsed)
+    return m_metadata.Get(type);
+  return m_pLoader->ParseMetadataField(type);
+}
+
 StringUtf8Multilang const & FeatureType::GetNames() const
 {
   ParseCommon();
@@ -492,6 +499,26 @@ FeatureType::geom_stat_t FeatureType::GetTrianglesSize(int scale) const
   return geom_stat_t(sz, m_triangles.size());
 }
 
+size_t FeatureType::GetMemoryUsage() const
+{
+  size_t bytes = sizeof(*this);
+  if (m_points.size() > static_buffer)
+    bytes += m_points.size() * sizeof(m2::PointD);
+  if (m_triangles.size() > static_buffer)
+    bytes += m_triangles.size() * sizeof(m2::PointD);
+
+  m_params.name.ForEach([&bytes](int8_t /* langCode */, string const & name)
+  {
+    bytes += name.size() + 1;
+    return true;
+  });
+  bytes += m_params.house.Get().size() + m_params.ref.size();
+
+  for (auto const type : m_metadata.GetPresentTypes())
+    bytes += m_metadata.Get(type).size();
+  return bytes;
+}
+
 void FeatureType::GetPreferredNames(string & primary, string & secondary) const
 {
   if (!HasName())
@@ -311,6 +311,10 @@ public:
     return m_metadata;
   }
 
+  /// @return The value of metadata |type|. Reads only this value if the
+  /// metadata is not parsed yet.
+  string GetMetadataField(feature::Metadata::EType type) const;
+
   /// @name Statistic functions.
   //@{
   inline void ParseBeforeStatistic() const
@@ -346,6 +350,10 @@ public:
   geom_stat_t GetTrianglesSize(int scale) const;
   //@}
 
+  /// @return Approximate number of bytes used by the feature with
+  /// already parsed geometry, names and metadata.
+  size_t GetMemoryUsage() const;
+
   void SwapGeometry(FeatureType & r);
 
   inline void SwapPoints(buffer_vector<m2::PointD, 32> & points) const
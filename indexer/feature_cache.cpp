@@ -0,0 +1,89 @@
+#include "indexer/feature_cache.hpp"
+
+#include "base/assert.hpp"
+
+using namespace std;
+
+void FeatureCache::SetMaxBytes(size_t maxBytes)
+{
+  lock_guard<mutex> lock(m_lock);
+  m_maxBytes = maxBytes;
+  ShrinkImpl();
+}
+
+bool FeatureCache::IsEnabled() const
+{
+  lock_guard<mutex> lock(m_lock);
+  return m_maxBytes != 0;
+}
+
+bool FeatureCache::Get(FeatureID const & id, FeatureType & ft)
+{
+  lock_guard<mutex> lock(m_lock);
+  auto const it = m_index.find(id);
+  if (it == m_index.end())
+  {
+    ++m_stats.m_misses;
+    return false;
+  }
+
+  ++m_stats.m_hits;
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  ft = it->second->m_feature;
+  return true;
+}
+
+void FeatureCache::Put(FeatureType const & ft)
+{
+  size_t const bytes = ft.GetMemoryUsage();
+
+  lock_guard<mutex> lock(m_lock);
+  if (bytes > m_maxBytes)
+    return;
+
+  auto const it = m_index.find(ft.GetID());
+  if (it != m_index.end())
+  {
+    // The feature has been put by another thread.
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return;
+  }
+
+  m_entries.push_front({ft, bytes});
+  m_index.emplace(ft.GetID(), m_entries.begin());
+  m_bytes += bytes;
+  ShrinkImpl();
+}
+
+void FeatureCache::Clear()
+{
+  lock_guard<mutex> lock(m_lock);
+  m_index.clear();
+  m_entries.clear();
+  m_bytes = 0;
+}
+
+FeatureCache::Stats FeatureCache::GetStats() const
+{
+  lock_guard<mutex> lock(m_lock);
+  return m_stats;
+}
+
+size_t FeatureCache::GetBytes() const
+{
+  lock_guard<mutex> lock(m_lock);
+  return m_bytes;
+}
+
+void FeatureCache::ShrinkImpl()
+{
+  while (m_bytes > m_maxBytes)
+  {
+    ASSERT(!m_entries.empty(), ());
+    Entry const & entry = m_entries.back();
+    m_bytes -= entry.m_bytes;
+    m_index.erase(entry.m_feature.GetID());
+    m_entries.pop_back();
+    ++m_stats.m_evictions;
+  }
+}
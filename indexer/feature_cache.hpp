@@ -0,0 +1,67 @@
+#pragma once
+
+#include "indexer/feature.hpp"
+#include "indexer/feature_decl.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+
+// Thread-safe LRU cache of decoded original (not edited) features, limited
+// by the memory used by the features. Cached features are parsed with
+// FeatureType::ParseEverything(), i.e. they have the best geometry, so
+// the cache suits only clients which don't need simplified geometry.
+// Cached features don't need their loaders, so they outlive FeaturesVector-s
+// which have read them.
+class FeatureCache
+{
+public:
+  struct Stats
+  {
+    // Number of features taken from the cache.
+    uint64_t m_hits = 0;
+    // Number of features not found in the cache.
+    uint64_t m_misses = 0;
+    // Number of features removed from the cache to fit the budget.
+    uint64_t m_evictions = 0;
+  };
+
+  // The cache is disabled when |maxBytes| is zero.
+  explicit FeatureCache(size_t maxBytes = 0) : m_maxBytes(maxBytes) {}
+
+  void SetMaxBytes(size_t maxBytes);
+  bool IsEnabled() const;
+
+  // Copies the cached feature with |id| to |ft|. Returns false when there is
+  // no such feature in the cache.
+  bool Get(FeatureID const & id, FeatureType & ft);
+
+  // Caches a copy of |ft|, which must be parsed with ParseEverything().
+  void Put(FeatureType const & ft);
+
+  void Clear();
+
+  Stats GetStats() const;
+  size_t GetBytes() const;
+
+private:
+  struct Entry
+  {
+    FeatureType m_feature;
+    size_t m_bytes;
+  };
+  using Entries = std::list<Entry>;
+
+  // Evicts least recently used features to fit |m_maxBytes|. Must be called under |m_lock|.
+  void ShrinkImpl();
+
+  mutable std::mutex m_lock;
+  // Most recently used features go first.
+  Entries m_entries;
+  std::map<FeatureID, Entries::iterator> m_index;
+  size_t m_maxBytes;
+  size_t m_bytes = 0;
+  Stats m_stats;
+};
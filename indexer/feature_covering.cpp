@@ -5,143 +5,131 @@
 #include "indexer/scales.hpp"
 
 #include "geometry/covering_utils.hpp"
+#include "geometry/mercator.hpp"
 
 #include "std/vector.hpp"
 
 
-namespace
+namespace covering
+{
+FeatureIntersector::Trg::Trg(m2::PointD const & a, m2::PointD const & b, m2::PointD const & c)
+  : m_a(a), m_b(b), m_c(c)
 {
+  m_rect.Add(a);
+  m_rect.Add(b);
+  m_rect.Add(c);
+}
 
-// This class should only be used with covering::CoverObject()!
-class FeatureIntersector
+void FeatureIntersector::Clear()
 {
-public:
-  struct Trg
+  m_polyline.clear();
+  m_trg.clear();
+  m_rect.MakeEmpty();
+}
+
+CellObjectIntersection FeatureIntersector::operator() (RectId const & cell) const
+{
+  m2::RectD cellRect;
   {
-    m2::PointD m_a, m_b, m_c;
-    Trg(m2::PointD const & a, m2::PointD const & b, m2::PointD const & c)
-      : m_a(a), m_b(b), m_c(c) {}
-  };
-
-  vector<m2::PointD> m_polyline;
-  vector<Trg> m_trg;
-  m2::RectD m_rect;
-
-  // Note:
-  // 1. Here we don't need to differentiate between CELL_OBJECT_INTERSECT and OBJECT_INSIDE_CELL.
-  // 2. We can return CELL_OBJECT_INTERSECT instead of CELL_INSIDE_OBJECT - it's just
-  //    a performance penalty.
-  covering::CellObjectIntersection operator() (RectId const & cell) const
+    // Check for limit rect intersection.
+    pair<uint32_t, uint32_t> const xy = cell.XY();
+    uint32_t const r = cell.Radius();
+    ASSERT_GREATER_OR_EQUAL(xy.first, r, ());
+    ASSERT_GREATER_OR_EQUAL(xy.second, r, ());
+
+    cellRect = m2::RectD(xy.first - r, xy.second - r, xy.first + r, xy.second + r);
+    if (!cellRect.IsIntersect(m_rect))
+      return CELL_OBJECT_NO_INTERSECTION;
+  }
+
+  for (size_t i = 0; i < m_trg.size(); ++i)
   {
-    using namespace covering;
+    if (!cellRect.IsIntersect(m_trg[i].m_rect))
+      continue;
 
-    m2::RectD cellRect;
-    {
-      // Check for limit rect intersection.
-      pair<uint32_t, uint32_t> const xy = cell.XY();
-      uint32_t const r = cell.Radius();
-      ASSERT_GREATER_OR_EQUAL(xy.first, r, ());
-      ASSERT_GREATER_OR_EQUAL(xy.second, r, ());
-
-      cellRect = m2::RectD(xy.first - r, xy.second - r, xy.first + r, xy.second + r);
-      if (!cellRect.IsIntersect(m_rect))
-        return CELL_OBJECT_NO_INTERSECTION;
-    }
+    CellObjectIntersection const res =
+        IntersectCellWithTriangle(cell, m_trg[i].m_a, m_trg[i].m_b, m_trg[i].m_c);
 
-    for (size_t i = 0; i < m_trg.size(); ++i)
+    switch (res)
     {
-      m2::RectD r;
-      r.Add(m_trg[i].m_a);
-      r.Add(m_trg[i].m_b);
-      r.Add(m_trg[i].m_c);
-      if (!cellRect.IsIntersect(r))
-        continue;
-
-      CellObjectIntersection const res =
-          IntersectCellWithTriangle(cell, m_trg[i].m_a, m_trg[i].m_b, m_trg[i].m_c);
-
-      switch (res)
-      {
-      case CELL_OBJECT_NO_INTERSECTION:
-        break;
-      case CELL_INSIDE_OBJECT:
-        return CELL_INSIDE_OBJECT;
-      case CELL_OBJECT_INTERSECT:
-      case OBJECT_INSIDE_CELL:
-        return CELL_OBJECT_INTERSECT;
-      }
+    case CELL_OBJECT_NO_INTERSECTION:
+      break;
+    case CELL_INSIDE_OBJECT:
+      return CELL_INSIDE_OBJECT;
+    case CELL_OBJECT_INTERSECT:
+    case OBJECT_INSIDE_CELL:
+      return CELL_OBJECT_INTERSECT;
     }
+  }
 
-    for (size_t i = 1; i < m_polyline.size(); ++i)
+  for (size_t i = 1; i < m_polyline.size(); ++i)
+  {
+    CellObjectIntersection const res =
+        IntersectCellWithLine(cell, m_polyline[i], m_polyline[i-1]);
+    switch (res)
     {
-      CellObjectIntersection const res =
-          IntersectCellWithLine(cell, m_polyline[i], m_polyline[i-1]);
-      switch (res)
-      {
-      case CELL_OBJECT_NO_INTERSECTION:
-        break;
-      case CELL_INSIDE_OBJECT:
-        ASSERT(false, (cell, i, m_polyline));
-        return CELL_OBJECT_INTERSECT;
-      case CELL_OBJECT_INTERSECT:
-      case OBJECT_INSIDE_CELL:
-        return CELL_OBJECT_INTERSECT;
-      }
+    case CELL_OBJECT_NO_INTERSECTION:
+      break;
+    case CELL_INSIDE_OBJECT:
+      ASSERT(false, (cell, i, m_polyline));
+      return CELL_OBJECT_INTERSECT;
+    case CELL_OBJECT_INTERSECT:
+    case OBJECT_INSIDE_CELL:
+      return CELL_OBJECT_INTERSECT;
     }
-
-    return CELL_OBJECT_NO_INTERSECTION;
   }
 
-  typedef CellIdConverter<MercatorBounds, RectId> CellIdConverterType;
-
-  m2::PointD ConvertPoint(m2::PointD const & p)
-  {
-    m2::PointD const pt(CellIdConverterType::XToCellIdX(p.x),
-                        CellIdConverterType::YToCellIdY(p.y));
-    m_rect.Add(pt);
-    return pt;
-  }
+  return CELL_OBJECT_NO_INTERSECTION;
+}
 
-  void operator() (m2::PointD const & pt)
-  {
-    m_polyline.push_back(ConvertPoint(pt));
-  }
+m2::PointD FeatureIntersector::ConvertPoint(m2::PointD const & p)
+{
+  using TConverter = CellIdConverter<MercatorBounds, RectId>;
 
-  void operator() (m2::PointD const & a, m2::PointD const & b, m2::PointD const & c)
-  {
-    m_trg.emplace_back(ConvertPoint(a), ConvertPoint(b), ConvertPoint(c));
-  }
-};
+  m2::PointD const pt(TConverter::XToCellIdX(p.x), TConverter::YToCellIdY(p.y));
+  m_rect.Add(pt);
+  return pt;
+}
 
+void FeatureIntersector::operator() (m2::PointD const & pt)
+{
+  m_polyline.push_back(ConvertPoint(pt));
 }
 
-namespace covering
+void FeatureIntersector::operator() (m2::PointD const & a, m2::PointD const & b,
+                                     m2::PointD const & c)
 {
+  m_trg.emplace_back(ConvertPoint(a), ConvertPoint(b), ConvertPoint(c));
+}
 
-vector<int64_t> CoverFeature(FeatureType const & f, int cellDepth, uint64_t cellPenaltyArea)
+void LoadFeatureGeometry(FeatureType const & f, FeatureIntersector & isect)
 {
   // We need to cover feature for the best geometry, because it's indexed once for the
   // first top level scale. Do reset current cached geometry first.
   f.ResetGeometry();
   int const scale = FeatureType::BEST_GEOMETRY;
 
-  FeatureIntersector fIsect;
-  f.ForEachPoint(fIsect, scale);
-  f.ForEachTriangle(fIsect, scale);
+  isect.Clear();
+  f.ForEachPoint(isect, scale);
+  f.ForEachTriangle(isect, scale);
 
-  CHECK(!(fIsect.m_trg.empty() && fIsect.m_polyline.empty()) &&
+  CHECK(!(isect.m_trg.empty() && isect.m_polyline.empty()) &&
         f.GetLimitRect(scale).IsValid(), (f.DebugString(scale)));
+}
 
-  if (fIsect.m_trg.empty() && fIsect.m_polyline.size() == 1)
+vector<int64_t> CoverFeature(FeatureIntersector const & isect, int cellDepth,
+                             uint64_t cellPenaltyArea)
+{
+  if (isect.m_trg.empty() && isect.m_polyline.size() == 1)
   {
-    m2::PointD const pt = fIsect.m_polyline[0];
+    m2::PointD const pt = isect.m_polyline[0];
     return vector<int64_t>(
           1, RectId::FromXY(static_cast<uint32_t>(pt.x), static_cast<uint32_t>(pt.y),
                             RectId::DEPTH_LEVELS - 1).ToInt64(cellDepth));
   }
 
   vector<RectId> cells;
-  covering::CoverObject(fIsect, cellPenaltyArea, cells, cellDepth, RectId::Root());
+  covering::CoverObject(isect, cellPenaltyArea, cells, cellDepth, RectId::Root());
 
   vector<int64_t> res(cells.size());
   for (size_t i = 0; i < cells.size(); ++i)
@@ -150,6 +138,13 @@ vector<int64_t> CoverFeature(FeatureType const & f, int cellDepth, uint64_t cell
   return res;
 }
 
+vector<int64_t> CoverFeature(FeatureType const & f, int cellDepth, uint64_t cellPenaltyArea)
+{
+  FeatureIntersector isect;
+  LoadFeatureGeometry(f, isect);
+  return CoverFeature(isect, cellDepth, cellPenaltyArea);
+}
+
 void SortAndMergeIntervals(IntervalsT v, IntervalsT & res)
 {
 #ifdef DEBUG
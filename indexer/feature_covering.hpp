@@ -1,4 +1,6 @@
 #pragma once
+#include "geometry/covering_utils.hpp"
+#include "geometry/point2d.hpp"
 #include "geometry/rect2d.hpp"
 
 #include "coding/point_to_integer.hpp"
@@ -14,6 +16,48 @@ namespace covering
   typedef pair<int64_t, int64_t> IntervalT;
   typedef vector<IntervalT> IntervalsT;
 
+  // Geometry of a feature in cell id coordinates, it should only be used with
+  // covering::CoverObject()! Unlike FeatureType it doesn't refer to the mwm,
+  // so geometries of different features may be covered on different threads.
+  class FeatureIntersector
+  {
+  public:
+    struct Trg
+    {
+      Trg(m2::PointD const & a, m2::PointD const & b, m2::PointD const & c);
+
+      m2::PointD m_a, m_b, m_c;
+      // Bounding rect is calculated once, not for every cell the triangle is checked with.
+      m2::RectD m_rect;
+    };
+
+    void Clear();
+
+    // Note:
+    // 1. Here we don't need to differentiate between CELL_OBJECT_INTERSECT and OBJECT_INSIDE_CELL.
+    // 2. We can return CELL_OBJECT_INTERSECT instead of CELL_INSIDE_OBJECT - it's just
+    //    a performance penalty.
+    CellObjectIntersection operator() (RectId const & cell) const;
+
+    void operator() (m2::PointD const & pt);
+    void operator() (m2::PointD const & a, m2::PointD const & b, m2::PointD const & c);
+
+    vector<m2::PointD> m_polyline;
+    vector<Trg> m_trg;
+    m2::RectD m_rect;
+
+  private:
+    m2::PointD ConvertPoint(m2::PointD const & p);
+  };
+
+  // Reads the best geometry of |feature| to |isect|.
+  void LoadFeatureGeometry(FeatureType const & feature, FeatureIntersector & isect);
+
+  // Cover geometry loaded by LoadFeatureGeometry() with RectIds and return their integer
+  // representations.
+  vector<int64_t> CoverFeature(FeatureIntersector const & isect, int cellDepth,
+                               uint64_t cellPenaltyArea);
+
   // Cover feature with RectIds and return their integer representations.
   vector<int64_t> CoverFeature(FeatureType const & feature,
                                int cellDepth,
@@ -255,29 +255,39 @@ uint32_t LoaderCurrent::ParseTriangles(int scale)
   return sz;
 }
 
+bool LoaderCurrent::GetMetadataOffset(uint32_t & offset) const
+{
+  struct TMetadataIndexEntry
+  {
+    uint32_t key;
+    uint32_t value;
+  };
+  DDVector<TMetadataIndexEntry, FilesContainerR::TReader> idx(m_Info.GetMetadataIndexReader());
+
+  auto it = lower_bound(
+      idx.begin(), idx.end(),
+      TMetadataIndexEntry{static_cast<uint32_t>(m_pF->m_id.m_index), 0},
+      [](TMetadataIndexEntry const & v1, TMetadataIndexEntry const & v2)
+      {
+        return v1.key < v2.key;
+      });
+
+  if (it == idx.end() || m_pF->m_id.m_index != it->key)
+    return false;
+
+  offset = it->value;
+  return true;
+}
+
 void LoaderCurrent::ParseMetadata()
 {
   try
   {
-    struct TMetadataIndexEntry
-    {
-      uint32_t key;
-      uint32_t value;
-    };
-    DDVector<TMetadataIndexEntry, FilesContainerR::TReader> idx(m_Info.GetMetadataIndexReader());
-
-    auto it = lower_bound(
-        idx.begin(), idx.end(),
-        TMetadataIndexEntry{static_cast<uint32_t>(m_pF->m_id.m_index), 0},
-        [](TMetadataIndexEntry const & v1, TMetadataIndexEntry const & v2)
-        {
-          return v1.key < v2.key;
-        });
-
-    if (it != idx.end() && m_pF->m_id.m_index == it->key)
+    uint32_t offset;
+    if (GetMetadataOffset(offset))
     {
       ReaderSource<FilesContainerR::TReader> src(m_Info.GetMetadataReader());
-      src.Skip(it->value);
+      src.Skip(offset);
       if (m_Info.GetMWMFormat() >= version::Format::v8)
         m_pF->m_metadata.Deserialize(src);
       else
@@ -290,6 +300,30 @@ void LoaderCurrent::ParseMetadata()
   }
 }
 
+string LoaderCurrent::ParseMetadataField(uint8_t type)
+{
+  try
+  {
+    uint32_t offset;
+    if (GetMetadataOffset(offset))
+    {
+      ReaderSource<FilesContainerR::TReader> src(m_Info.GetMetadataReader());
+      src.Skip(offset);
+      if (m_Info.GetMWMFormat() >= version::Format::v8)
+        return Metadata::DeserializeField(src, type);
+
+      Metadata metadata;
+      metadata.DeserializeFromMWMv7OrLower(src);
+      return metadata.Get(type);
+    }
+  }
+  catch (Reader::OpenException const &)
+  {
+    // now ignore exception because not all mwm have needed sections
+  }
+  return string();
+}
+
 int LoaderCurrent::GetScaleIndex(int scale) const
 {
   int const count = m_Info.GetScalesCount();
@@ -18,6 +18,9 @@ namespace feature
     int GetScaleIndex(int scale, offsets_t const & offsets) const;
     //@}
 
+    /// @return false if the feature has no metadata.
+    bool GetMetadataOffset(uint32_t & offset) const;
+
   public:
     LoaderCurrent(SharedLoadInfo const & info) : BaseT(info) {}
     /// LoaderBase overrides:
@@ -28,5 +31,6 @@ namespace feature
     uint32_t ParseGeometry(int scale) override;
     uint32_t ParseTriangles(int scale) override;
     void ParseMetadata() override;
+    string ParseMetadataField(uint8_t type) override;
   };
 }
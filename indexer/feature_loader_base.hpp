@@ -5,6 +5,7 @@
 #include "coding/file_container.hpp"
 
 #include "std/noncopyable.hpp"
+#include "std/string.hpp"
 
 
 class FeatureType;
@@ -79,6 +80,8 @@ namespace feature
     virtual uint32_t ParseGeometry(int scale) = 0;
     virtual uint32_t ParseTriangles(int scale) = 0;
     virtual void ParseMetadata() = 0;
+    /// @return The value of metadata |type| without parsing the rest of metadata.
+    virtual string ParseMetadataField(uint8_t type) = 0;
 
     inline uint32_t GetTypesSize() const { return m_CommonOffset - m_TypesOffset; }
 
@@ -83,6 +83,27 @@ public:
     }
   }
 
+  /// Reads only the value of |type| from serialized metadata, values of
+  /// other types are skipped without copying.
+  /// @return An empty string if there is no such value.
+  template <class TSource>
+  static string DeserializeField(TSource & src, uint8_t type)
+  {
+    string value;
+    auto const sz = ReadVarUint<uint32_t>(src);
+    for (size_t i = 0; i < sz; ++i)
+    {
+      auto const key = ReadVarUint<uint32_t>(src);
+      if (key == type)
+      {
+        utils::ReadString(src, value);
+        break;
+      }
+      src.Skip(ReadVarUint<uint32_t>(src) + 1);
+    }
+    return value;
+  }
+
   inline bool Equals(MetadataBase const & other) const
   {
     return m_metadata == other.m_metadata;
@@ -62,36 +62,15 @@ bool GetTransliteratedName(feature::RegionData const & regionData, StringUtf8Mul
 
 bool GetBestName(StringUtf8Multilang const & src, vector<int8_t> const & priorityList, string & out)
 {
-  auto bestIndex = priorityList.size();
-
-  auto const findAndSet = [](vector<int8_t> const & langs, int8_t const code, string const & name,
-                             size_t & bestIndex, string & outName)
-  {
-    auto const it = find(langs.begin(), langs.end(), code);
-    if (it != langs.end() && bestIndex > static_cast<size_t>(distance(langs.begin(), it)))
-    {
-      bestIndex = distance(langs.begin(), it);
-      outName = name;
-    }
-  };
-
-  src.ForEach([&](int8_t code, string const & name)
-  {
-    if (bestIndex == 0)
-      return false;
-
-    findAndSet(priorityList, code, name, bestIndex, out);
-    return true;
-  });
+  int8_t lang;
+  if (!src.GetBestString(priorityList, lang, out))
+    return false;
 
   // There are many "junk" names in Arabian island.
-  if (bestIndex < priorityList.size() &&
-      priorityList[bestIndex] == StrUtf8::kInternationalCode)
-  {
+  if (lang == StrUtf8::kInternationalCode)
     out = out.substr(0, out.find_first_of(','));
-  }
 
-  return bestIndex < priorityList.size();
+  return true;
 }
 
 vector<int8_t> GetSimilarToDeviceLanguages(int8_t deviceLang)
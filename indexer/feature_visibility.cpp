@@ -118,6 +118,10 @@ void FilterRulesByRuntimeSelector(FeatureType const & f, int zoomLevel, drule::K
 {
   keys.erase_if([&f, zoomLevel](drule::Key const & key)->bool
   {
+    // Rules without selectors are applied to all features.
+    if (!key.m_hasSelector)
+      return false;
+
     drule::BaseRule const * const rule = drule::rules().Find(key);
     if (rule == nullptr)
       return true;
@@ -70,11 +70,9 @@ namespace feature
   {
     unique_ptr<FeaturesOffsetsTable> table(new FeaturesOffsetsTable());
 
-    table->m_file.Open(cont.GetFileName());
-    auto p = cont.GetAbsoluteOffsetAndSize(FEATURE_OFFSETS_FILE_TAG);
-    table->m_handle.Assign(table->m_file.Map(p.first, p.second, FEATURE_OFFSETS_FILE_TAG));
+    table->m_section = SectionView<char>::Map(cont, FEATURE_OFFSETS_FILE_TAG);
 
-    succinct::mapper::map(table->m_table, table->m_handle.GetData<char>());
+    succinct::mapper::map(table->m_table, table->m_section.Data());
     return table;
   }
 
@@ -107,8 +107,7 @@ namespace feature
     succinct::elias_fano m_table;
     unique_ptr<MmapReader> m_pReader;
 
-    detail::MappedFile m_file;
-    detail::MappedFile::Handle m_handle;
+    SectionView<char> m_section;
   };
 
   // Builds feature offsets table in an mwm or rebuilds an existing
@@ -5,6 +5,8 @@
 #include "platform/constants.hpp"
 #include "platform/mwm_version.hpp"
 
+#include "coding/byte_stream.hpp"
+
 
 void FeaturesVector::GetByIndex(uint32_t index, FeatureType & ft) const
 {
@@ -14,6 +16,107 @@ void FeaturesVector::GetByIndex(uint32_t index, FeatureType & ft) const
   ft.Deserialize(m_LoadInfo.GetLoader(), &m_buffer[offset]);
 }
 
+void FeaturesVector::ReadRecords(vector<uint32_t> const & indices) const
+{
+  m_batchBuffer.clear();
+  m_recordOffsets.resize(indices.size());
+
+  if (!m_table)
+  {
+    // Ends of records are unknown without the offsets table, so they are read one by one.
+    vector<char> record;
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+      uint32_t offset = 0, size = 0;
+      m_RecordReader.ReadRecord(indices[i], record, offset, size);
+      m_recordOffsets[i] = m_batchBuffer.size() + offset;
+      m_batchBuffer.insert(m_batchBuffer.end(), record.begin(), record.begin() + size);
+    }
+    return;
+  }
+
+  auto const & reader = m_RecordReader.GetReader();
+  uint64_t const readerSize = reader.Size();
+  size_t const numFeatures = m_table->size();
+
+  vector<pair<uint64_t, uint64_t>> ranges(indices.size());
+  size_t bufferSize = 0;
+  for (size_t i = 0; i < indices.size(); ++i)
+  {
+    auto const index = indices[i];
+    uint64_t const begin = m_table->GetFeatureOffset(index);
+    uint64_t const end =
+        index + 1 < numFeatures ? m_table->GetFeatureOffset(index + 1) : readerSize;
+    ranges[i] = make_pair(begin, end);
+    m_recordOffsets[i] = bufferSize;
+    bufferSize += static_cast<size_t>(end - begin);
+  }
+
+  m_batchBuffer.resize(bufferSize);
+  vector<Reader::ReadRequest> requests;
+  requests.reserve(ranges.size());
+  for (size_t i = 0; i < ranges.size(); ++i)
+  {
+    requests.emplace_back(ranges[i].first, m_batchBuffer.data() + m_recordOffsets[i],
+                          static_cast<size_t>(ranges[i].second - ranges[i].first));
+  }
+  reader.ReadBatch(requests);
+
+  // Skips sizes of records.
+  for (auto & offset : m_recordOffsets)
+  {
+    ArrayByteSource source(&m_batchBuffer[offset]);
+    VarRecordSizeReaderVarint(source);
+    offset = static_cast<size_t>(source.PtrC() - m_batchBuffer.data());
+  }
+}
+
+FeaturesVector::MetadataCursor::MetadataCursor(feature::SharedLoadInfo const & info)
+  : m_format(info.GetMWMFormat())
+{
+  try
+  {
+    m_index = make_unique<ReaderSource<FilesContainerR::TReader>>(info.GetMetadataIndexReader());
+    m_metadata = make_unique<FilesContainerR::TReader>(info.GetMetadataReader());
+  }
+  catch (Reader::OpenException const &)
+  {
+    // Not all mwms have metadata sections.
+    m_index.reset();
+    return;
+  }
+  Next();
+}
+
+void FeaturesVector::MetadataCursor::Read(uint32_t index, FeatureType & ft)
+{
+  while (m_hasEntry && m_key < index)
+    Next();
+
+  feature::Metadata metadata;
+  if (m_hasEntry && m_key == index)
+  {
+    ReaderSource<FilesContainerR::TReader> src(*m_metadata);
+    src.Skip(m_value);
+    if (m_format >= version::Format::v8)
+      metadata.Deserialize(src);
+    else
+      metadata.DeserializeFromMWMv7OrLower(src);
+  }
+  ft.SetMetadata(metadata);
+}
+
+void FeaturesVector::MetadataCursor::Next()
+{
+  // Index entries are pairs of uint32_t feature index and offset of
+  // its metadata, sorted by feature indices.
+  m_hasEntry = m_index && m_index->Size() > 0;
+  if (!m_hasEntry)
+    return;
+  m_key = ReadPrimitiveFromSource<uint32_t>(*m_index);
+  m_value = ReadPrimitiveFromSource<uint32_t>(*m_index);
+}
+
 size_t FeaturesVector::GetNumFeatures() const
 {
   return m_table ? m_table->size() : 0;
@@ -2,10 +2,27 @@
 #include "feature.hpp"
 #include "feature_loader_base.hpp"
 
+#include "coding/reader.hpp"
 #include "coding/var_record_reader.hpp"
 
+#include "std/unique_ptr.hpp"
 
-namespace feature { class FeaturesOffsetsTable; }
+
+namespace feature
+{
+class FeaturesOffsetsTable;
+
+/// Fields of features which FeaturesVector::ForEach can decode in advance.
+enum FeatureFields : uint32_t
+{
+  FIELD_TYPES = 1 << 0,
+  /// Names, layer, rank, house number and center of point features.
+  FIELD_COMMON = 1 << 1,
+  FIELD_GEOMETRY = 1 << 2,
+  FIELD_TRIANGLES = 1 << 3,
+  FIELD_METADATA = 1 << 4,
+};
+}  // namespace feature
 
 /// Note! This class is NOT Thread-Safe.
 /// You should have separate instance of Vector for every thread.
@@ -22,6 +39,20 @@ public:
 
   void GetByIndex(uint32_t index, FeatureType & ft) const;
 
+  /// Reads features |indices| with one batched read and calls |toDo| for each of them in
+  /// the order of |indices|. It's faster than GetByIndex() for many features, e.g. features
+  /// of a tile. A feature passed to |toDo| is valid only during the call.
+  template <class ToDo> void ForEachByIndices(vector<uint32_t> const & indices, ToDo && toDo) const
+  {
+    ReadRecords(indices);
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+      FeatureType ft;
+      ft.Deserialize(m_LoadInfo.GetLoader(), &m_batchBuffer[m_recordOffsets[i]]);
+      toDo(ft, indices[i]);
+    }
+  }
+
   size_t GetNumFeatures() const;
 
   template <class ToDo> void ForEach(ToDo && toDo) const
@@ -41,6 +72,33 @@ public:
     });
   }
 
+  /// Same as above, but |fields| are decoded for every feature before
+  /// |toDo| is called, geometry is decoded at |scale|. Metadata is read
+  /// sequentially instead of a binary search in the metadata index per
+  /// feature, so it's the way to go for full scans of an mwm.
+  template <class ToDo>
+  void ForEach(ToDo && toDo, uint32_t fields, int scale = FeatureType::BEST_GEOMETRY) const
+  {
+    unique_ptr<MetadataCursor> metadata;
+    if ((fields & feature::FIELD_METADATA) && m_table)
+      metadata = make_unique<MetadataCursor>(m_LoadInfo);
+
+    ForEach([&](FeatureType & ft, uint32_t index)
+    {
+      if (fields & feature::FIELD_TYPES)
+        ft.ParseTypes();
+      if (fields & feature::FIELD_COMMON)
+        ft.ParseCommon();
+      if (fields & feature::FIELD_GEOMETRY)
+        ft.ParseGeometry(scale);
+      if (fields & feature::FIELD_TRIANGLES)
+        ft.ParseTriangles(scale);
+      if (metadata)
+        metadata->Read(index, ft);
+      toDo(ft, index);
+    });
+  }
+
   template <class ToDo> static void ForEachOffset(ModelReaderPtr reader, ToDo && toDo)
   {
     VarRecordReader<ModelReaderPtr, &VarRecordSizeReaderVarint> recordReader(reader, 256);
@@ -53,9 +111,37 @@ public:
 private:
   friend class FeaturesVectorTest;
 
+  /// Reads records of |indices| to |m_batchBuffer|, data of the i-th record starts at
+  /// |m_recordOffsets[i]|.
+  void ReadRecords(vector<uint32_t> const & indices) const;
+
+  /// Reads metadata of features in the order of increasing indices.
+  class MetadataCursor
+  {
+  public:
+    explicit MetadataCursor(feature::SharedLoadInfo const & info);
+
+    void Read(uint32_t index, FeatureType & ft);
+
+  private:
+    void Next();
+
+    unique_ptr<ReaderSource<FilesContainerR::TReader>> m_index;
+    unique_ptr<FilesContainerR::TReader> m_metadata;
+    version::Format m_format;
+
+    bool m_hasEntry = false;
+    uint32_t m_key = 0;
+    uint32_t m_value = 0;
+  };
+
   feature::SharedLoadInfo m_LoadInfo;
   VarRecordReader<FilesContainerR::TReader, &VarRecordSizeReaderVarint> m_RecordReader;
   mutable vector<char> m_buffer;
+  // Records of ForEachByIndices(). They are separate from |m_buffer| because
+  // GetByIndex() may be called while they are processed.
+  mutable vector<char> m_batchBuffer;
+  mutable vector<size_t> m_recordOffsets;
   feature::FeaturesOffsetsTable const * m_table;
 };
 
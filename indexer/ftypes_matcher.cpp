@@ -144,6 +144,69 @@ bool BaseChecker::operator()(vector<uint32_t> const & types) const
   return false;
 }
 
+// static
+size_t constexpr MultiChecker::kMaxCheckers;
+
+MultiChecker::MultiChecker(vector<BaseChecker const *> const & checkers)
+{
+  CHECK_LESS_OR_EQUAL(checkers.size(), kMaxCheckers, ());
+
+  map<uint8_t, map<uint32_t, TMask>> levels;
+  for (size_t i = 0; i < checkers.size(); ++i)
+  {
+    BaseChecker const * checker = checkers[i];
+    ASSERT(checker, ());
+    TMask const bit = TMask(1) << i;
+    bool hasTypes = false;
+    auto & types = levels[static_cast<uint8_t>(checker->GetLevel())];
+    checker->ForEachType([&](uint32_t type)
+    {
+      types[type] |= bit;
+      hasTypes = true;
+    });
+    if (!hasTypes)
+      m_customCheckers.emplace_back(checker, bit);
+  }
+
+  for (auto const & level : levels)
+  {
+    if (level.second.empty())
+      continue;
+    m_levels.push_back({level.first, {level.second.begin(), level.second.end()}});
+  }
+}
+
+MultiChecker::TMask MultiChecker::operator()(feature::TypesHolder const & types) const
+{
+  TMask mask = 0;
+  for (uint32_t const t : types)
+  {
+    for (auto const & level : m_levels)
+    {
+      uint32_t const type = BaseChecker::PrepareToMatch(t, level.m_level);
+      auto const it = lower_bound(level.m_types.begin(), level.m_types.end(), type,
+                                  [](pair<uint32_t, TMask> const & p, uint32_t type)
+                                  {
+                                    return p.first < type;
+                                  });
+      if (it != level.m_types.end() && it->first == type)
+        mask |= it->second;
+    }
+
+    for (auto const & checker : m_customCheckers)
+    {
+      if ((mask & checker.second) == 0 && checker.first->IsMatched(t))
+        mask |= checker.second;
+    }
+  }
+  return mask;
+}
+
+MultiChecker::TMask MultiChecker::operator()(FeatureType const & ft) const
+{
+  return this->operator()(feature::TypesHolder(ft));
+}
+
 IsPeakChecker::IsPeakChecker()
 {
   Classificator const & c = classif();
@@ -39,6 +39,8 @@ public:
 
   static uint32_t PrepareToMatch(uint32_t type, uint8_t level);
 
+  size_t GetLevel() const { return m_level; }
+
   template <typename TFn>
   void ForEachType(TFn && fn) const
   {
@@ -46,6 +48,37 @@ public:
   }
 };
 
+/// Answers several checkers at once. Types of all checkers are merged to sorted
+/// tables, one table per truncation level, so every type of a feature is
+/// truncated and looked up once per level instead of being searched by every
+/// checker. Also, types of a FeatureType are collected only once.
+class MultiChecker
+{
+public:
+  using TMask = uint64_t;
+  static size_t constexpr kMaxCheckers = 64;
+
+  /// Bit i of results corresponds to |checkers[i]|. Checkers without types,
+  /// i.e. with overridden IsMatched(), are called as is.
+  explicit MultiChecker(vector<BaseChecker const *> const & checkers);
+
+  TMask operator() (feature::TypesHolder const & types) const;
+  TMask operator() (FeatureType const & ft) const;
+
+  static bool IsMatched(TMask mask, size_t i) { return ((mask >> i) & 1) != 0; }
+
+private:
+  struct Level
+  {
+    uint8_t m_level;
+    // Truncated types and masks of checkers of the types, sorted by types.
+    vector<pair<uint32_t, TMask>> m_types;
+  };
+
+  vector<Level> m_levels;
+  vector<pair<BaseChecker const *, TMask>> m_customCheckers;
+};
+
 class IsPeakChecker : public BaseChecker
 {
   IsPeakChecker();
@@ -3,6 +3,7 @@
 #include "base/assert.hpp"
 #include "base/stl_add.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/complex.hpp"
 #include "std/vector.hpp"
 
@@ -18,6 +19,14 @@ namespace
     return m2::PointU(static_cast<uvalue_t>(my::clamp(point.x, 0.0, static_cast<double>(maxPoint.x))),
                       static_cast<uvalue_t>(my::clamp(point.y, 0.0, static_cast<double>(maxPoint.y))));
   }
+
+  /// @return v / 2 clamped to [0, maxValue] and rounded down.
+  inline uint32_t ClampHalf(uint32_t maxValue, int64_t v)
+  {
+    if (v < 0)
+      return 0;
+    return static_cast<uint32_t>(min(v >> 1, static_cast<int64_t>(maxValue)));
+  }
 }
 
 m2::PointU PredictPointInPolyline(m2::PointU const & maxPoint,
@@ -26,7 +35,12 @@ m2::PointU PredictPointInPolyline(m2::PointU const & maxPoint,
 {
   // return ClampPoint(maxPoint, m2::PointI64(p1) + m2::PointI64(p1) - m2::PointI64(p2));
   // return ClampPoint(maxPoint, m2::PointI64(p1) + (m2::PointI64(p1) - m2::PointI64(p2)) / 2);
-  return ClampPoint(maxPoint, m2::PointD(p1) + (m2::PointD(p1) - m2::PointD(p2)) / 2.0);
+  // return ClampPoint(maxPoint, m2::PointD(p1) + (m2::PointD(p1) - m2::PointD(p2)) / 2.0);
+
+  // Integer version of the commented line above, the results are the same:
+  // p1 + (p1 - p2) / 2 is rounded down after clamping to [0, maxPoint].
+  return m2::PointU(ClampHalf(maxPoint.x, 3 * static_cast<int64_t>(p1.x) - p2.x),
+                    ClampHalf(maxPoint.y, 3 * static_cast<int64_t>(p1.y) - p2.y));
 }
 
 m2::PointU PredictPointInPolyline(m2::PointU const & maxPoint,
@@ -61,7 +75,10 @@ m2::PointU PredictPointInTriangle(m2::PointU const & maxPoint,
                                   m2::PointU const & p3)
 {
   // parallelogram prediction
-  return ClampPoint(maxPoint, p1 + p2 - p3);
+  // Same as ClampPoint(maxPoint, p1 + p2 - p3) without conversions to doubles,
+  // note that the sum wraps around as unsigned.
+  m2::PointU const p = p1 + p2 - p3;
+  return m2::PointU(min(p.x, maxPoint.x), min(p.y, maxPoint.y));
 }
 
 
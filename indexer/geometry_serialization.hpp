@@ -6,6 +6,7 @@
 
 #include "geometry/point2d.hpp"
 
+#include "coding/byte_stream.hpp"
 #include "coding/point_to_integer.hpp"
 #include "coding/reader.hpp"
 #include "coding/varint.hpp"
@@ -143,6 +144,79 @@ namespace serial
   }
   //@}
 
+  /// @name Progressive paths.
+  /// A path of a detailed scale is stored as a refinement of a path of a less detailed scale:
+  /// for every segment of the coarse path, the number of points which are inserted into it and
+  /// the inserted points as deltas from the previous points. Points of the coarse path must be
+  /// a subsequence of points of the fine path with the same first and last points, which is
+  /// the case when the coarse path is simplified from the fine one.
+  //@{
+  template <class TSink>
+  void SaveOuterPathRefinement(vector<m2::PointD> const & coarse, vector<m2::PointD> const & fine,
+                               CodingParams const & params, TSink & sink)
+  {
+    ASSERT_GREATER(coarse.size(), 1, ());
+    uint32_t const coordBits = params.GetCoordBits();
+
+    vector<char> buffer;
+    MemWriter<vector<char>> writer(buffer);
+
+    size_t j = 0;
+    for (size_t i = 0; i + 1 < coarse.size(); ++i)
+    {
+      m2::PointU prev = PointD2PointU(coarse[i], coordBits);
+      CHECK(j < fine.size() && PointD2PointU(fine[j], coordBits) == prev, (i, j));
+
+      m2::PointU const next = PointD2PointU(coarse[i + 1], coordBits);
+      // The last points of the paths are matched explicitly, as paths may contain repeated points.
+      size_t end = j + 1;
+      if (i + 2 == coarse.size())
+        end = fine.size() - 1;
+      while (end < fine.size() && PointD2PointU(fine[end], coordBits) != next)
+        ++end;
+      CHECK_LESS(end, fine.size(), ("Coarse path is not a subsequence of fine path."));
+
+      WriteVarUint(writer, static_cast<uint32_t>(end - j - 1));
+      for (++j; j < end; ++j)
+      {
+        m2::PointU const curr = PointD2PointU(fine[j], coordBits);
+        WriteVarUint(writer, EncodeDelta(curr, prev));
+        prev = curr;
+      }
+    }
+    CHECK_EQUAL(j + 1, fine.size(), ());
+
+    WriteBufferToSink(buffer, sink);
+  }
+
+  template <class TSource, class TPoints>
+  void LoadOuterPathRefinement(TSource & src, TPoints const & coarse, CodingParams const & params,
+                               TPoints & fine)
+  {
+    ASSERT_GREATER(coarse.size(), 1, ());
+    uint32_t const coordBits = params.GetCoordBits();
+
+    uint32_t const count = ReadVarUint<uint32_t>(src);
+    vector<char> buffer(count);
+    src.Read(buffer.data(), count);
+    ArrayByteSource bufferSrc(buffer.data());
+
+    fine.clear();
+    for (size_t i = 0; i + 1 < coarse.size(); ++i)
+    {
+      fine.push_back(coarse[i]);
+      m2::PointU prev = PointD2PointU(coarse[i], coordBits);
+      uint32_t const inserted = ReadVarUint<uint32_t>(bufferSrc);
+      for (uint32_t k = 0; k < inserted; ++k)
+      {
+        prev = DecodeDelta(ReadVarUint<uint64_t>(bufferSrc), prev);
+        fine.push_back(PointU2PointD(prev, coordBits));
+      }
+    }
+    fine.push_back(coarse.back());
+  }
+  //@}
+
   /// @name Triangles.
   //@{
   template <class TSink>
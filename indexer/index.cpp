@@ -29,6 +29,7 @@ void MwmValue::SetTable(MwmInfoEx & info)
   if (version < version::Format::v5)
     return;
 
+  std::lock_guard<std::mutex> lock(info.m_tableLock);
   m_table = info.m_table.lock();
   if (!m_table)
   {
@@ -40,6 +41,15 @@ void MwmValue::SetTable(MwmInfoEx & info)
   }
 }
 
+size_t MwmValue::GetMemoryUsage() const
+{
+  // The offsets table is shared by all values of the mwm, so only the
+  // page cache of the container reader is taken into account, see
+  // FileReader.
+  size_t constexpr kReaderCacheBytes = (1 << 10) * (1 << 4);
+  return sizeof(*this) + kReaderCacheBytes;
+}
+
 //////////////////////////////////////////////////////////////////////////////////
 // Index implementation
 //////////////////////////////////////////////////////////////////////////////////
@@ -87,12 +97,16 @@ bool Index::DeregisterMap(CountryFile const & countryFile) { return Deregister(c
 // Index::FeaturesLoaderGuard implementation
 //////////////////////////////////////////////////////////////////////////////////
 
-Index::FeaturesLoaderGuard::FeaturesLoaderGuard(Index const & index, MwmId const & id)
+Index::FeaturesLoaderGuard::FeaturesLoaderGuard(Index const & index, MwmId const & id,
+                                                bool useFeatureCache)
   : m_handle(index.GetMwmHandleById(id))
 {
   if (!m_handle.IsAlive())
     return;
 
+  if (useFeatureCache && index.m_featureCache.IsEnabled())
+    m_cache = &index.m_featureCache;
+
   auto const & value = *m_handle.GetValue<MwmValue>();
   m_vector = make_unique<FeaturesVector>(value.m_cont, value.GetHeader(), value.m_table.get());
 }
@@ -153,9 +167,19 @@ bool Index::FeaturesLoaderGuard::GetOriginalFeatureByIndex(uint32_t index, Featu
   if (!m_handle.IsAlive())
     return false;
 
+  FeatureID const fid(m_handle.GetId(), index);
+  if (m_cache && m_cache->Get(fid, ft))
+    return true;
+
   ASSERT(m_vector != nullptr, ());
   m_vector->GetByIndex(index, ft);
-  ft.SetID(FeatureID(m_handle.GetId(), index));
+  ft.SetID(fid);
+
+  if (m_cache)
+  {
+    ft.ParseEverything();
+    m_cache->Put(ft);
+  }
   return true;
 }
 
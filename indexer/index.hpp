@@ -2,6 +2,7 @@
 #include "indexer/cell_id.hpp"
 #include "indexer/data_factory.hpp"
 #include "indexer/feature.hpp"
+#include "indexer/feature_cache.hpp"
 #include "indexer/feature_covering.hpp"
 #include "indexer/features_offsets_table.hpp"
 #include "indexer/features_vector.hpp"
@@ -15,10 +16,15 @@
 #include "defines.hpp"
 
 #include "base/macros.hpp"
+#include "base/stl_add.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <exception>
 #include <limits>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -33,10 +39,10 @@ private:
   // MwmSet's cache. We can't use shared_ptr because of offsets table
   // must be removed as soon as the last corresponding MwmValue is
   // destroyed. Also, note that this value must be used and modified
-  // only in MwmValue::SetTable() method, which, in turn, is called
-  // only in the MwmSet critical section, protected by a lock.  So,
-  // there's an implicit synchronization on this field.
+  // only in MwmValue::SetTable() method under |m_tableLock|, because
+  // values of the same mwm may be created concurrently.
   std::weak_ptr<feature::FeaturesOffsetsTable> m_table;
+  std::mutex m_tableLock;
 };
 
 class MwmValue : public MwmSet::MwmValueBase
@@ -51,6 +57,9 @@ public:
   explicit MwmValue(platform::LocalCountryFile const & localFile);
   void SetTable(MwmInfoEx & info);
 
+  // MwmSet::MwmValueBase overrides:
+  size_t GetMemoryUsage() const override;
+
   inline feature::DataHeader const & GetHeader() const { return m_factory.GetHeader(); }
   inline feature::RegionData const & GetRegionData() const { return m_factory.GetRegionData(); }
   inline version::MwmVersion const & GetMwmVersion() const { return m_factory.GetMwmVersion(); }
@@ -84,8 +93,38 @@ public:
   ///         now, returns false.
   bool DeregisterMap(platform::CountryFile const & countryFile);
 
+  /// Cache of decoded features shared by FeaturesLoaderGuard-s which opt in
+  /// to it. The cache is disabled until its memory budget is set.
+  FeatureCache & GetFeatureCache() const { return m_featureCache; }
+
 private:
 
+  // Reads the current version of the feature |index| of the mwm |mwmID|
+  // and passes it to |f|. Deleted and obsolete features are skipped.
+  template <typename F>
+  static void ReadFeature(F & f, osm::Editor & editor, FeaturesVector const & fv,
+                          MwmId const & mwmID, uint32_t index)
+  {
+    FeatureType feature;
+    switch (editor.GetFeatureStatus(mwmID, index))
+    {
+    case osm::Editor::FeatureStatus::Deleted:
+    case osm::Editor::FeatureStatus::Obsolete:
+      return;
+    case osm::Editor::FeatureStatus::Modified:
+      VERIFY(editor.GetEditedFeature(mwmID, index, feature), ());
+      f(feature);
+      return;
+    case osm::Editor::FeatureStatus::Created:
+      CHECK(false, ("Created features index should be generated."));
+    case osm::Editor::FeatureStatus::Untouched: break;
+    }
+
+    fv.GetByIndex(index, feature);
+    feature.SetID(FeatureID(mwmID, index));
+    f(feature);
+  }
+
   template <typename F> class ReadMWMFunctor
   {
     F & m_f;
@@ -125,35 +164,13 @@ private:
         CheckUniqueIndexes checkUnique(header.GetFormat() >= version::Format::v5);
         MwmId const & mwmID = handle.GetId();
 
-        for (auto const & i : interval)
-        {
-          index.ForEachInIntervalAndScale(
-              [&](uint32_t index)
-              {
-                if (!checkUnique(index))
-                  return;
-
-                FeatureType feature;
-                switch (m_editor.GetFeatureStatus(mwmID, index))
-                {
-                case osm::Editor::FeatureStatus::Deleted:
-                case osm::Editor::FeatureStatus::Obsolete:
-                  return;
-                case osm::Editor::FeatureStatus::Modified:
-                  VERIFY(m_editor.GetEditedFeature(mwmID, index, feature), ());
-                  m_f(feature);
-                  return;
-                case osm::Editor::FeatureStatus::Created:
-                  CHECK(false, ("Created features index should be generated."));
-                case osm::Editor::FeatureStatus::Untouched: break;
-                }
-
-                fv.GetByIndex(index, feature);
-                feature.SetID(FeatureID(mwmID, index));
-                m_f(feature);
-              },
-              i.first, i.second, scale);
-        }
+        index.ForEachInIntervalsAndScale(
+            [&](uint32_t index)
+            {
+              if (checkUnique(index))
+                ReadFeature(m_f, m_editor, fv, mwmID, index);
+            },
+            interval, scale);
       }
     }
   };
@@ -193,18 +210,15 @@ private:
         CheckUniqueIndexes checkUnique(header.GetFormat() >= version::Format::v5);
         MwmId const & mwmID = handle.GetId();
 
-        for (auto const & i : interval)
-        {
-          index.ForEachInIntervalAndScale(
-              [&](uint32_t index)
-              {
-                if (osm::Editor::FeatureStatus::Deleted !=
-                        m_editor.GetFeatureStatus(mwmID, index) &&
-                    checkUnique(index))
-                  m_f(FeatureID(mwmID, index));
-              },
-              i.first, i.second, scale);
-        }
+        index.ForEachInIntervalsAndScale(
+            [&](uint32_t index)
+            {
+              if (osm::Editor::FeatureStatus::Deleted !=
+                      m_editor.GetFeatureStatus(mwmID, index) &&
+                  checkUnique(index))
+                m_f(FeatureID(mwmID, index));
+            },
+            interval, scale);
       }
     }
   };
@@ -232,6 +246,156 @@ public:
     ForEachInIntervals(implFunctor, covering::FullCover, m2::RectD::GetInfiniteRect(), scale);
   }
 
+  // Parallel version of ForEachInRect for bulk queries. The work is
+  // split by mwms and by chunks of covering intervals between
+  // |numThreads| threads, zero means the number of cores. Every thread
+  // reads features by its own mwm handles. Note that |f| is called
+  // concurrently, so it must be thread-safe, and features are not
+  // ordered by mwms.
+  template <typename F>
+  void ForEachInRectParallel(F && f, m2::RectD const & rect, int scale, size_t numThreads) const
+  {
+    // Number of covering intervals read by a thread at once.
+    size_t constexpr kIntervalsPerTask = 16;
+
+    struct MwmTask
+    {
+      MwmId m_id;
+      int m_scale = 0;
+      covering::IntervalsT m_intervals;
+      // Shared by all tasks of the mwm, absent for old mwms without
+      // the features offsets table.
+      std::unique_ptr<ConcurrentCheckUniqueIndexes> m_checkUnique;
+    };
+
+    struct IntervalsTask
+    {
+      size_t m_mwm;
+      size_t m_begin;
+      size_t m_end;
+    };
+
+    std::vector<std::shared_ptr<MwmInfo>> infos;
+    GetMwmsInfo(infos);
+
+    covering::CoveringGetter cov(rect, covering::ViewportWithLowLevels);
+    osm::Editor & editor = osm::Editor::Instance();
+
+    std::vector<MwmTask> mwms;
+    std::vector<IntervalsTask> tasks;
+    for (auto const & info : infos)
+    {
+      if (scale < info->m_minScale || scale > info->m_maxScale ||
+          !rect.IsIntersect(info->m_limitRect))
+      {
+        continue;
+      }
+
+      MwmId const id(info);
+      MwmHandle const handle = GetMwmHandleById(id);
+      MwmValue const * value = handle.GetValue<MwmValue>();
+      if (!value)
+        continue;
+
+      // Created features are not in the index, they are read here.
+      editor.ForEachFeatureInMwmRectAndScale(id, [&f](FeatureType & ft) { f(ft); }, rect, scale);
+
+      feature::DataHeader const & header = value->GetHeader();
+      MwmTask mwm;
+      mwm.m_id = id;
+      // In case of WorldCoasts we should pass correct scale in ForEachInIntervalAndScale.
+      mwm.m_scale = std::min(scale, header.GetLastScale());
+      // Use last coding scale for covering (see index_builder.cpp).
+      mwm.m_intervals = cov.Get(header.GetLastScale());
+
+      size_t chunkSize = mwm.m_intervals.size();
+      if (header.GetFormat() >= version::Format::v5 && value->m_table)
+      {
+        mwm.m_checkUnique = my::make_unique<ConcurrentCheckUniqueIndexes>(value->m_table->size());
+        chunkSize = kIntervalsPerTask;
+      }
+
+      for (size_t i = 0; i < mwm.m_intervals.size(); i += chunkSize)
+        tasks.push_back({mwms.size(), i, std::min(i + chunkSize, mwm.m_intervals.size())});
+      mwms.push_back(std::move(mwm));
+    }
+
+    std::atomic<size_t> nextTask(0);
+    std::mutex exceptionLock;
+    std::exception_ptr exception;
+
+    auto const worker = [&]()
+    {
+      size_t currentMwm = tasks.size();
+      MwmHandle handle;
+      std::unique_ptr<FeaturesVector> fv;
+      std::unique_ptr<ScaleIndex<ModelReaderPtr>> index;
+
+      try
+      {
+        for (size_t i = nextTask++; i < tasks.size(); i = nextTask++)
+        {
+          IntervalsTask const & task = tasks[i];
+          MwmTask const & mwm = mwms[task.m_mwm];
+          if (task.m_mwm != currentMwm)
+          {
+            currentMwm = task.m_mwm;
+            index.reset();
+            fv.reset();
+            handle = GetMwmHandleById(mwm.m_id);
+            MwmValue const * value = handle.GetValue<MwmValue>();
+            if (value)
+            {
+              fv = my::make_unique<FeaturesVector>(value->m_cont, value->GetHeader(),
+                                                    value->m_table.get());
+              index = my::make_unique<ScaleIndex<ModelReaderPtr>>(
+                  value->m_cont.GetReader(INDEX_FILE_TAG), value->m_factory);
+            }
+          }
+
+          if (!fv)
+            continue;
+
+          // Tasks of mwms without the shared checker cover all intervals.
+          CheckUniqueIndexes localCheckUnique(false /* useBits */);
+          covering::IntervalsT const intervals(mwm.m_intervals.begin() + task.m_begin,
+                                               mwm.m_intervals.begin() + task.m_end);
+          index->ForEachInIntervalsAndScale(
+              [&](uint32_t featureIndex)
+              {
+                bool const unique = mwm.m_checkUnique ? (*mwm.m_checkUnique)(featureIndex)
+                                                      : localCheckUnique(featureIndex);
+                if (unique)
+                  ReadFeature(f, editor, *fv, mwm.m_id, featureIndex);
+              },
+              intervals, mwm.m_scale);
+        }
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(exceptionLock);
+        if (!exception)
+          exception = std::current_exception();
+        // Other threads stop after their current tasks.
+        nextTask = tasks.size();
+      }
+    };
+
+    if (numThreads == 0)
+      numThreads = std::max(std::thread::hardware_concurrency(), 1U);
+    numThreads = std::min(numThreads, tasks.size());
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < numThreads; ++i)
+      threads.emplace_back(worker);
+    worker();
+    for (auto & thread : threads)
+      thread.join();
+
+    if (exception)
+      std::rethrow_exception(exception);
+  }
+
   // "features" must be sorted using FeatureID::operator< as predicate.
   template <typename F>
   void ReadFeatures(F && f, std::vector<FeatureID> const & features) const
@@ -248,24 +412,35 @@ public:
         MwmValue const * pValue = handle.GetValue<MwmValue>();
         FeaturesVector const featureReader(pValue->m_cont, pValue->GetHeader(),
                                            pValue->m_table.get());
+        // Features which aren't edited are read in batches, edited ones break a batch to keep
+        // the order of |features|.
+        std::vector<uint32_t> pending;
+        auto const flush = [&]() {
+          featureReader.ForEachByIndices(pending, [&](FeatureType & ft, uint32_t index) {
+            ft.SetID(FeatureID(id, index));
+            f(ft);
+          });
+          pending.clear();
+        };
         do
         {
           osm::Editor::FeatureStatus const fts = editor.GetFeatureStatus(id, fidIter->m_index);
           ASSERT_NOT_EQUAL(osm::Editor::FeatureStatus::Deleted, fts,
                            ("Deleted feature was cached. It should not be here. Please review your code."));
-          FeatureType featureType;
           if (fts == osm::Editor::FeatureStatus::Modified || fts == osm::Editor::FeatureStatus::Created)
           {
+            flush();
+            FeatureType featureType;
             VERIFY(editor.GetEditedFeature(id, fidIter->m_index, featureType), ());
+            f(featureType);
           }
           else
           {
-            featureReader.GetByIndex(fidIter->m_index, featureType);
-            featureType.SetID(*fidIter);
+            pending.push_back(fidIter->m_index);
           }
-          f(featureType);
         }
         while (++fidIter != endIter && id == fidIter->m_mwmId);
+        flush();
       }
       else
       {
@@ -280,7 +455,10 @@ public:
   class FeaturesLoaderGuard
   {
   public:
-    FeaturesLoaderGuard(Index const & index, MwmId const & id);
+    /// @param useFeatureCache if true, original features are taken from and
+    /// put to the feature cache of |index|. Such features always have the best
+    /// geometry, see FeatureCache.
+    FeaturesLoaderGuard(Index const & index, MwmId const & id, bool useFeatureCache = false);
 
     inline MwmSet::MwmId const & GetId() const { return m_handle.GetId(); }
     std::string GetCountryFileName() const;
@@ -301,6 +479,7 @@ public:
   private:
     MwmHandle m_handle;
     std::unique_ptr<FeaturesVector> m_vector;
+    FeatureCache * m_cache = nullptr;
     osm::Editor & m_editor = osm::Editor::Instance();
   };
 
@@ -378,4 +557,6 @@ private:
       editor.ForEachFeatureInMwmRectAndScale(worldID[1], f, rect, scale);
     }
   }
+
+  mutable FeatureCache m_featureCache;
 };
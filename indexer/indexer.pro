@@ -16,6 +16,7 @@ SOURCES += \
     categories_index.cpp \
     centers_table.cpp \
     classificator.cpp \
+    classificator_cache.cpp \
     classificator_loader.cpp \
     coding_params.cpp \
     cuisines.cpp \
@@ -29,6 +30,7 @@ SOURCES += \
     edits_migration.cpp \
     feature.cpp \
     feature_algo.cpp \
+    feature_cache.cpp \
     feature_covering.cpp \
     feature_data.cpp \
     feature_decl.cpp \
@@ -53,6 +55,7 @@ SOURCES += \
     mwm_set.cpp \
     new_feature_categories.cpp \  # it's in indexer because of CategoriesHolder dependency.
     old/feature_loader_101.cpp \
+    opening_hours_cache.cpp \
     osm_editor.cpp \
     postcodes_matcher.cpp \  # it's in indexer due to editor wich is in indexer and depends on postcodes_marcher
     rank_table.cpp \
@@ -73,6 +76,7 @@ HEADERS += \
     cities_boundaries_serdes.hpp \
     city_boundary.hpp \
     classificator.hpp \
+    classificator_cache.hpp \
     classificator_loader.hpp \
     coding_params.hpp \
     cuisines.hpp \
@@ -88,6 +92,7 @@ HEADERS += \
     feature.hpp \
     feature_algo.hpp \
     feature_altitude.hpp \
+    feature_cache.hpp \
     feature_covering.hpp \
     feature_data.hpp \
     feature_decl.hpp \
@@ -119,6 +124,7 @@ HEADERS += \
     new_feature_categories.hpp \  # it's in indexer because of CategoriesHolder dependency.
     old/feature_loader_101.hpp \
     old/interval_index_101.hpp \
+    opening_hours_cache.hpp \
     osm_editor.hpp \
     postcodes_matcher.hpp \   # it's in indexer due to editor wich is in indexer and depends on postcodes_marcher
     rank_table.hpp \
@@ -9,6 +9,7 @@
 #include "platform/platform.hpp"
 
 #include "coding/file_name_utils.hpp"
+#include "coding/memory_region.hpp"
 #include "coding/reader.hpp"
 #include "coding/writer.hpp"
 
@@ -117,4 +118,37 @@ UNIT_CLASS_TEST(CentersTableTest, Subset)
     }
   }
 }
+
+UNIT_CLASS_TEST(CentersTableTest, MemoryRegion)
+{
+  vector<pair<uint32_t, m2::PointD>> features;
+  for (uint32_t i = 0; i < 200; ++i)
+    features.emplace_back(2 * i, m2::PointD(0.1 * i, -0.1 * i));
+
+  serial::CodingParams codingParams;
+
+  TBuffer buffer;
+  {
+    CentersTableBuilder builder;
+
+    builder.SetCodingParams(codingParams);
+    for (auto const & feature : features)
+      builder.Put(feature.first, feature.second);
+
+    MemWriter<TBuffer> writer(buffer);
+    builder.Freeze(writer);
+  }
+
+  auto table = CentersTable::Load(make_unique<CopiedMemoryRegion>(move(buffer)), codingParams);
+  TEST(table.get(), ());
+
+  for (auto const & feature : features)
+  {
+    m2::PointD actual;
+    TEST(table->Get(feature.first, actual), (feature.first));
+    TEST_LESS_OR_EQUAL(MercatorBounds::DistanceOnEarth(actual, feature.second), 1, ());
+
+    TEST(!table->Get(feature.first + 1, actual), (feature.first + 1));
+  }
+}
 }  // namespace
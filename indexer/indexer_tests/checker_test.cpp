@@ -159,3 +159,34 @@ UNIT_TEST(GetHighwayClassTest)
   types3.Add(c.GetTypeByPath({"highway"}));
   TEST_EQUAL(ftypes::GetHighwayClass(types3), ftypes::HighwayClass::Error, ());
 }
+
+UNIT_TEST(MultiChecker)
+{
+  classificator::Load();
+
+  Classificator const & c = classif();
+
+  vector<ftypes::BaseChecker const *> const checkers = {
+      &ftypes::IsStreetChecker::Instance(), &ftypes::IsLinkChecker::Instance(),
+      &ftypes::IsBridgeChecker::Instance(), &ftypes::IsTunnelChecker::Instance(),
+      &ftypes::IsBuildingChecker::Instance(), &ftypes::IsAddressObjectChecker::Instance()};
+  ftypes::MultiChecker const multiChecker(checkers);
+
+  vector<vector<uint32_t>> const typeSets = {
+      GetStreetTypes(), GetStreetAndNotStreetTypes(), GetLinkTypes(), GetBridgeTypes(),
+      GetTunnelTypes(), GetBridgeAndTunnelTypes(),
+      {c.GetTypeByPath({"building"}), c.GetTypeByPath({"highway", "footway", "bridge"})},
+      {c.GetTypeByPath({"building", "address"})},
+      {c.GetTypeByPath({"highway"})}};
+
+  for (auto const & types : typeSets)
+  {
+    feature::TypesHolder holder;
+    for (auto const t : types)
+      holder.Add(t);
+
+    auto const mask = multiChecker(holder);
+    for (size_t i = 0; i < checkers.size(); ++i)
+      TEST_EQUAL(ftypes::MultiChecker::IsMatched(mask, i), (*checkers[i])(types), (i, types));
+  }
+}
@@ -0,0 +1,78 @@
+#include "testing/testing.hpp"
+
+#include "indexer/classificator.hpp"
+#include "indexer/classificator_cache.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+string const kClassificator =
+    "world +\n"
+    "  building -\n"
+    "  highway +\n"
+    "    secondary -\n"
+    "    primary -\n"
+    "  {}\n"
+    "  natural +\n"
+    "    coastline -\n"
+    "  {}\n"
+    "{}\n";
+
+string const kTypes =
+    "highway|primary\n"
+    "natural|coastline\n"
+    "building\n"
+    "highway|secondary\n";
+
+UNIT_TEST(ClassificatorCache_Smoke)
+{
+  Classificator & c = classif();
+  c.Clear();
+  {
+    istringstream s(kClassificator);
+    c.ReadClassificator(s);
+  }
+  {
+    istringstream s(kTypes);
+    c.ReadTypesMapping(s);
+  }
+
+  uint64_t const hash = classificator::GetSourcesHash(kClassificator, kTypes);
+  TEST_NOT_EQUAL(hash, classificator::GetSourcesHash(kClassificator, kTypes + "\n"), ());
+
+  vector<uint8_t> buffer;
+  {
+    MemWriter<vector<uint8_t>> writer(buffer);
+    classificator::SaveCache(c, hash, writer);
+  }
+
+  MemReader reader(buffer.data(), buffer.size());
+  Classificator loaded;
+  TEST(!classificator::LoadCache(reader, hash + 1, loaded), ());
+  TEST(classificator::LoadCache(reader, hash, loaded), ());
+
+  TEST_EQUAL(loaded.GetTypesMapping().GetTypes(), c.GetTypesMapping().GetTypes(), ());
+  TEST_EQUAL(loaded.GetCoastType(), c.GetCoastType(), ());
+  for (auto const & path : {vector<string>{"building"}, vector<string>{"highway", "primary"},
+                            vector<string>{"highway", "secondary"}})
+  {
+    uint32_t const type = c.GetTypeByPath(path);
+    TEST_EQUAL(loaded.GetTypeByPath(path), type, (path));
+    TEST_EQUAL(loaded.GetIndexForType(type), c.GetIndexForType(type), (path));
+  }
+
+  // Truncated cache isn't loaded.
+  MemReaderWithExceptions truncated(buffer.data(), buffer.size() - 1);
+  Classificator broken;
+  TEST(!classificator::LoadCache(truncated, hash, broken), ());
+}
+}  // namespace
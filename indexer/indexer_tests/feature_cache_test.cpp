@@ -0,0 +1,85 @@
+#include "testing/testing.hpp"
+
+#include "indexer/feature.hpp"
+#include "indexer/feature_cache.hpp"
+#include "indexer/mwm_set.hpp"
+
+#include "coding/multilang_utf8_string.hpp"
+
+#include <memory>
+#include <string>
+
+using namespace std;
+
+namespace
+{
+// Features are not parsed, so only their ids and sizes may be checked.
+FeatureType MakeFeature(MwmSet::MwmId const & mwmId, uint32_t index, string const & name)
+{
+  FeatureType ft;
+  ft.SetID(FeatureID(mwmId, index));
+  StringUtf8Multilang names;
+  names.AddString(StringUtf8Multilang::kDefaultCode, name);
+  ft.SetNames(names);
+  return ft;
+}
+}  // namespace
+
+UNIT_TEST(FeatureCache_Disabled)
+{
+  MwmSet::MwmId const mwmId(make_shared<MwmInfo>());
+  FeatureCache cache;
+  TEST(!cache.IsEnabled(), ());
+
+  cache.Put(MakeFeature(mwmId, 0, "Baker Street"));
+  FeatureType ft;
+  TEST(!cache.Get(FeatureID(mwmId, 0), ft), ());
+  TEST_EQUAL(cache.GetBytes(), 0, ());
+}
+
+UNIT_TEST(FeatureCache_Smoke)
+{
+  MwmSet::MwmId const mwmA(make_shared<MwmInfo>());
+  MwmSet::MwmId const mwmB(make_shared<MwmInfo>());
+
+  FeatureType const feature = MakeFeature(mwmA, 0, "Baker Street");
+  size_t const bytes = feature.GetMemoryUsage();
+
+  // Room for two features.
+  FeatureCache cache(2 * bytes);
+  TEST(cache.IsEnabled(), ());
+
+  cache.Put(feature);
+  cache.Put(MakeFeature(mwmB, 0, "Abbey Road"));
+
+  FeatureType ft;
+  TEST(cache.Get(FeatureID(mwmA, 0), ft), ());
+  TEST_EQUAL(ft.GetID(), FeatureID(mwmA, 0), ());
+  TEST_EQUAL(ft.GetMemoryUsage(), bytes, ());
+  TEST(cache.Get(FeatureID(mwmB, 0), ft), ());
+  TEST(!cache.Get(FeatureID(mwmA, 1), ft), ());
+
+  // (mwmA, 0) is the least recently used now.
+  cache.Put(MakeFeature(mwmB, 1, "Oxford St"));
+  TEST(!cache.Get(FeatureID(mwmA, 0), ft), ());
+  TEST(cache.Get(FeatureID(mwmB, 0), ft), ());
+  TEST(cache.Get(FeatureID(mwmB, 1), ft), ());
+  TEST_LESS_OR_EQUAL(cache.GetBytes(), 2 * bytes, ());
+
+  auto stats = cache.GetStats();
+  TEST_EQUAL(stats.m_hits, 4, ());
+  TEST_EQUAL(stats.m_misses, 2, ());
+  TEST_EQUAL(stats.m_evictions, 1, ());
+
+  cache.SetMaxBytes(0);
+  TEST(!cache.IsEnabled(), ());
+  TEST_EQUAL(cache.GetBytes(), 0, ());
+  stats = cache.GetStats();
+  TEST_EQUAL(stats.m_evictions, 3, ());
+
+  cache.SetMaxBytes(bytes);
+  cache.Put(feature);
+  cache.Clear();
+  TEST(!cache.Get(FeatureID(mwmA, 0), ft), ());
+  TEST_EQUAL(cache.GetBytes(), 0, ());
+}
@@ -88,6 +88,24 @@ UNIT_TEST(Feature_Serialization)
   }
 }
 
+UNIT_TEST(Feature_Metadata_DeserializeField)
+{
+  Metadata original;
+  for (auto const & value : kKeyValues)
+    original.Set(value.first, value.second);
+
+  vector<char> buffer;
+  MemWriter<decltype(buffer)> writer(buffer);
+  original.Serialize(writer);
+
+  for (uint8_t type = 1; type < Metadata::FMD_COUNT; ++type)
+  {
+    MemReader reader(buffer.data(), buffer.size());
+    ReaderSource<MemReader> src(reader);
+    TEST_EQUAL(Metadata::DeserializeField(src, type), original.Get(type), (type));
+  }
+}
+
 UNIT_TEST(Feature_Metadata_GetWikipedia)
 {
   Metadata m;
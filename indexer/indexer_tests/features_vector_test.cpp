@@ -70,4 +70,36 @@ UNIT_TEST(FeaturesVectorTest_ParseMetadata)
              });
   TEST_EQUAL(expected, actual, ());
 }
+
+UNIT_TEST(FeaturesVectorTest_ForEachWithFields)
+{
+  LocalCountryFile localFile = LocalCountryFile::MakeForTesting("minsk-pass");
+
+  Index index;
+  auto result = index.RegisterMap(localFile);
+  TEST_EQUAL(result.second, MwmSet::RegResult::Success, ());
+
+  MwmSet::MwmHandle handle = index.GetMwmHandleById(result.first);
+  TEST(handle.IsAlive(), ());
+
+  auto const * value = handle.GetValue<MwmValue>();
+  FeaturesVector fv(value->m_cont, value->GetHeader(), value->m_table.get());
+
+  vector<pair<string, feature::Metadata>> expected;
+  fv.ForEach([&](FeatureType & ft, uint32_t /* index */)
+             {
+               expected.emplace_back(DebugPrint(ft), ft.GetMetadata());
+             });
+
+  size_t i = 0;
+  fv.ForEach([&](FeatureType & ft, uint32_t index)
+             {
+               TEST_LESS(i, expected.size(), ());
+               TEST_EQUAL(expected[i].first, DebugPrint(ft), (index));
+               TEST(expected[i].second.Equals(ft.GetMetadata()), (index));
+               ++i;
+             },
+             feature::FIELD_TYPES | feature::FIELD_COMMON | feature::FIELD_METADATA);
+  TEST_EQUAL(i, expected.size(), ());
+}
 }  // namespace
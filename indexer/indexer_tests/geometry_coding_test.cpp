@@ -1,3 +1,4 @@
+#include "testing/benchmark.hpp"
 #include "testing/testing.hpp"
 
 #include "indexer/geometry_coding.hpp"
@@ -59,6 +60,41 @@ UNIT_TEST(PredictPointsInPolyline2_Clamp0)
   TEST_EQUAL(PU(4, 0), PredictPointInPolyline(PU(5, 5), PU(4, 1), PU(4, 4)), ());
 }
 
+UNIT_TEST(PredictPointsInPolyline2_LargeCoords)
+{
+  // Predictions must be exactly the same as predictions made in doubles,
+  // otherwise mwms can't be decoded.
+  auto const predictInDoubles = [](PU const & maxPoint, PU const & p1, PU const & p2)
+  {
+    m2::PointD const p = m2::PointD(p1) + (m2::PointD(p1) - m2::PointD(p2)) / 2.0;
+    return PU(static_cast<uint32_t>(my::clamp(p.x, 0.0, static_cast<double>(maxPoint.x))),
+              static_cast<uint32_t>(my::clamp(p.y, 0.0, static_cast<double>(maxPoint.y))));
+  };
+
+  uint32_t const kMax = numeric_limits<uint32_t>::max();
+  vector<uint32_t> const coords = {0, 1, 2, 3, 1 << 29, (1 << 30) - 1, 1U << 31, kMax - 1, kMax};
+  for (PU const maxPoint : {PU(kMax, kMax), PU((1 << 30) - 1, 1U << 31)})
+  {
+    for (uint32_t const c1 : coords)
+    {
+      for (uint32_t const c2 : coords)
+      {
+        PU const p1(c1, c2), p2(c2, c1);
+        TEST_EQUAL(predictInDoubles(maxPoint, p1, p2), PredictPointInPolyline(maxPoint, p1, p2),
+                   (maxPoint, p1, p2));
+      }
+    }
+  }
+}
+
+UNIT_TEST(PredictPointInTriangle_Clamp)
+{
+  TEST_EQUAL(PU(5, 3), PredictPointInTriangle(PU(8, 8), PU(4, 2), PU(3, 2), PU(2, 1)), ());
+  TEST_EQUAL(PU(8, 8), PredictPointInTriangle(PU(8, 8), PU(6, 6), PU(6, 6), PU(1, 1)), ());
+  // The sum wraps around as unsigned, so negative predictions are clamped to max.
+  TEST_EQUAL(PU(8, 8), PredictPointInTriangle(PU(8, 8), PU(0, 0), PU(1, 1), PU(2, 2)), ());
+}
+
 /*
 UNIT_TEST(PredictPointsInPolyline3_Square)
 {
@@ -197,3 +233,27 @@ UNIT_TEST(DecodeEncodePolyline_DataSet1)
   TestPolylineEncode("DataSet1", points, GetMaxPoint(),
                      &geo_coding::EncodePolyline, &geo_coding::DecodePolyline);
 }
+
+#ifndef DEBUG
+BENCHMARK_TEST(DecodePolyline)
+{
+  size_t const count = ARRAY_SIZE(LargePolygon::kLargePolygon);
+  vector<m2::PointU> points;
+  points.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+    points.push_back(D2U(LargePolygon::kLargePolygon[i]));
+
+  m2::PointU const basePoint = serial::CodingParams().GetBasePoint();
+  vector<uint64_t> deltas(count);
+  geo_coding::OutDeltasT deltasA(deltas);
+  geo_coding::EncodePolyline(make_read_adapter(points), basePoint, GetMaxPoint(), deltasA);
+
+  vector<m2::PointU> decodedPoints(count);
+  testing::RunBenchmark("DecodePolyline", 10 /* warmUps */, 1000 /* repetitions */, [&]() {
+    geo_coding::OutPointsT decodedPointsA(decodedPoints);
+    geo_coding::DecodePolyline(make_read_adapter(deltas), basePoint, GetMaxPoint(),
+                               decodedPointsA);
+  });
+  TEST_EQUAL(points, decodedPoints, ());
+}
+#endif
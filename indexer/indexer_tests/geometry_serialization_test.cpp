@@ -67,3 +67,43 @@ UNIT_TEST(SaveLoadPolyline_DataSet1)
 
   TEST(is_equal(r1, r2), (r1, r2));
 }
+
+UNIT_TEST(SaveLoadPolylineRefinement_DataSet1)
+{
+  using namespace index_test;
+
+  serial::CodingParams cp;
+  vector<m2::PointD> fine(arr1, arr1 + ARRAY_SIZE(arr1));
+  // Points are compared after quantization, so keep quantized points only.
+  for (auto & p : fine)
+    p = PointU2PointD(PointD2PointU(p, cp.GetCoordBits()), cp.GetCoordBits());
+
+  vector<m2::PointD> coarse;
+  for (size_t i = 0; i + 1 < fine.size(); i += 5)
+    coarse.push_back(fine[i]);
+  coarse.push_back(fine.back());
+
+  vector<char> refinement;
+  PushBackByteSink<vector<char>> w(refinement);
+  serial::SaveOuterPathRefinement(coarse, fine, cp, w);
+
+  vector<char> full;
+  PushBackByteSink<vector<char>> fullWriter(full);
+  serial::SaveOuterPath(fine, cp, fullWriter);
+  TEST_LESS(refinement.size(), full.size(), ());
+
+  vector<m2::PointD> loaded;
+  ArrayByteSource r(&refinement[0]);
+  serial::LoadOuterPathRefinement(r, coarse, cp, loaded);
+
+  TEST_EQUAL(fine.size(), loaded.size(), ());
+  for (size_t i = 0; i < fine.size(); ++i)
+    TEST(is_equal(fine[i], loaded[i]), (fine[i], loaded[i]));
+
+  // Refinement of the same path.
+  refinement.clear();
+  serial::SaveOuterPathRefinement(fine, fine, cp, w);
+  ArrayByteSource sameSrc(&refinement[0]);
+  serial::LoadOuterPathRefinement(sameSrc, fine, cp, loaded);
+  TEST_EQUAL(fine, loaded, ());
+}
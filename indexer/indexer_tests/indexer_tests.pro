@@ -33,9 +33,11 @@ SOURCES += \
     cell_id_test.cpp \
     centers_table_test.cpp \
     checker_test.cpp \
+    classificator_cache_test.cpp \
     cities_boundaries_serdes_tests.cpp \
     drules_selector_parser_test.cpp \
     editable_map_object_test.cpp \
+    feature_cache_test.cpp \
     feature_metadata_test.cpp \
     feature_names_test.cpp \
     feature_xml_test.cpp \
@@ -47,10 +49,12 @@ SOURCES += \
     index_test.cpp \
     interval_index_test.cpp \
     mwm_set_test.cpp \
+    opening_hours_cache_test.cpp \
     osm_editor_test.cpp \
     polyline_point_to_int64_test.cpp \
     postcodes_matcher_tests.cpp \
     rank_table_test.cpp \
+    road_shields_parser_test.cpp \
     scales_test.cpp \
     search_string_utils_test.cpp \
     sort_and_merge_intervals_test.cpp \
@@ -5,6 +5,8 @@
 #include "coding/writer.hpp"
 #include "base/macros.hpp"
 #include "base/stl_add.hpp"
+#include "std/algorithm.hpp"
+#include "std/random.hpp"
 #include "std/utility.hpp"
 #include "std/vector.hpp"
 
@@ -276,3 +278,45 @@ UNIT_TEST(IntervalIndex_Simple5)
   }
 }
 
+
+UNIT_TEST(IntervalIndex_ForEachInIntervals)
+{
+  mt19937 rng(0);
+  vector<CellIdFeaturePairForTest> data;
+  for (uint32_t i = 0; i < 3000; ++i)
+    data.push_back(CellIdFeaturePairForTest(0xA0B1000000ULL + (rng() & 0x3FFFFF), i));
+  sort(data.begin(), data.end(),
+       [](CellIdFeaturePairForTest const & lhs, CellIdFeaturePairForTest const & rhs)
+       {
+         return lhs.GetCell() < rhs.GetCell();
+       });
+  vector<char> serialIndex;
+  MemWriter<vector<char> > writer(serialIndex);
+  BuildIntervalIndex(data.begin(), data.end(), writer, 40);
+  MemReader reader(&serialIndex[0], serialIndex.size());
+  IntervalIndex<MemReader> index(reader);
+
+  for (size_t test = 0; test < 100; ++test)
+  {
+    // Unsorted and overlapping intervals, some of them are out of the index keys.
+    IntervalIndexBase::IntervalsT intervals;
+    for (size_t i = 0; i < 1 + test % 20; ++i)
+    {
+      int64_t const beg = 0xA0B0F00000LL + (rng() & 0x5FFFFF);
+      intervals.emplace_back(beg, beg + (rng() & (i % 2 == 0 ? 0xFF : 0xFFFF)));
+    }
+    if (test % 10 == 0)
+      intervals.emplace_back(0xFFFFFFFF00LL, 0x20000000000LL);
+
+    vector<uint32_t> expected;
+    for (auto const & i : intervals)
+      index.ForEach(MakeBackInsertFunctor(expected), i.first, i.second);
+    sort(expected.begin(), expected.end());
+    expected.erase(unique(expected.begin(), expected.end()), expected.end());
+
+    vector<uint32_t> values;
+    index.ForEachInIntervals(MakeBackInsertFunctor(values), intervals);
+    sort(values.begin(), values.end());
+    TEST_EQUAL(values, expected, (test));
+  }
+}
@@ -157,3 +157,76 @@ UNIT_TEST(MwmSetLockAndIdTest)
   TEST(!handle.GetId().IsAlive(), ());
   TEST(!handle.GetId().GetInfo().get(), ());
 }
+
+UNIT_TEST(MwmSetCacheTest)
+{
+  class TestValue : public MwmSet::MwmValueBase
+  {
+  public:
+    // MwmSet::MwmValueBase overrides:
+    size_t GetMemoryUsage() const override { return 100; }
+  };
+
+  class CacheMwmSet : public TestMwmSet
+  {
+  public:
+    CacheMwmSet() : TestMwmSet(3 /* cacheSize */, 250 /* cacheBytes */) {}
+
+  protected:
+    // MwmSet overrides:
+    unique_ptr<MwmValueBase> CreateValue(MwmInfo &) const override
+    {
+      return make_unique<TestValue>();
+    }
+  };
+
+  CacheMwmSet mwmSet;
+  auto const id0 = mwmSet.Register(LocalCountryFile::MakeForTesting("0")).first;
+  auto const id1 = mwmSet.Register(LocalCountryFile::MakeForTesting("1")).first;
+  auto const id2 = mwmSet.Register(LocalCountryFile::MakeForTesting("2")).first;
+
+  for (auto const & id : {id0, id1, id2})
+    TEST(mwmSet.GetMwmHandleById(id).IsAlive(), ());
+
+  // Only two values fit the budget, so the value of mwm 0 is evicted.
+  auto stats = mwmSet.GetCacheStats();
+  TEST_EQUAL(stats.m_hits, 0, ());
+  TEST_EQUAL(stats.m_misses, 3, ());
+  TEST_EQUAL(stats.m_evictions, 1, ());
+
+  TEST(mwmSet.GetMwmHandleById(id2).IsAlive(), ());
+  TEST(mwmSet.GetMwmHandleById(id1).IsAlive(), ());
+  TEST(mwmSet.GetMwmHandleById(id0).IsAlive(), ());
+
+  stats = mwmSet.GetCacheStats();
+  TEST_EQUAL(stats.m_hits, 2, ());
+  TEST_EQUAL(stats.m_misses, 4, ());
+  TEST_EQUAL(stats.m_evictions, 2, ());
+}
+
+UNIT_TEST(MwmSetRegisterManyTest)
+{
+  TestMwmSet mwmSet;
+  TMwmsInfo mwmsInfo;
+
+  vector<LocalCountryFile> files;
+  for (char c = '0'; c <= '9'; ++c)
+    files.push_back(LocalCountryFile::MakeForTesting(string(1, c)));
+  files.push_back(LocalCountryFile::MakeForTesting("3"));
+
+  auto const results = mwmSet.Register(files, 4 /* threadsCount */);
+  TEST_EQUAL(results.size(), files.size(), ());
+  for (size_t i = 0; i + 1 < results.size(); ++i)
+  {
+    TEST_EQUAL(results[i].second, MwmSet::RegResult::Success, (i));
+    TEST(results[i].first.IsAlive(), (i));
+    TEST_EQUAL(results[i].first.GetInfo()->m_maxScale, i, ());
+  }
+  TEST_EQUAL(results.back().second, MwmSet::RegResult::VersionAlreadyExists, ());
+  TEST_EQUAL(results.back().first, results[3].first, ());
+
+  GetMwmsInfo(mwmSet, mwmsInfo);
+  TestFilesPresence(mwmsInfo, {"0", "1", "2", "3", "4", "5", "6", "7", "8", "9"});
+
+  TEST(mwmSet.Register(vector<LocalCountryFile>()).empty(), ());
+}
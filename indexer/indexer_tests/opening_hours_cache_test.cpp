@@ -0,0 +1,28 @@
+#include "testing/testing.hpp"
+
+#include "indexer/opening_hours_cache.hpp"
+
+#include <ctime>
+
+using namespace osm;
+
+UNIT_TEST(OpeningHoursCache_Smoke)
+{
+  auto const oh = GetParsedOpeningHours("Mo-Su 09:00-21:00");
+  TEST(oh->IsValid(), ());
+  // Rules are parsed once and are shared by all features with the same opening hours.
+  TEST_EQUAL(GetParsedOpeningHours("Mo-Su 09:00-21:00"), oh, ());
+
+  std::tm tm{};
+  tm.tm_year = 117;
+  tm.tm_mon = 5;
+  tm.tm_mday = 1;
+  tm.tm_hour = 12;
+  tm.tm_isdst = -1;
+  time_t const noon = mktime(&tm);
+  TEST(oh->IsOpen(noon), ());
+  TEST(!oh->IsOpen(noon + 10 * 60 * 60), ());
+
+  TEST(!GetParsedOpeningHours("not a rule")->IsValid(), ());
+  TEST(GetParsedOpeningHours("24/7")->IsTwentyFourHours(), ());
+}
@@ -0,0 +1,44 @@
+#include "testing/testing.hpp"
+
+#include "indexer/road_shields_parser.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace ftypes;
+using namespace std;
+
+namespace
+{
+vector<string> GetShields(string const & mwmName, string const & roadNumber)
+{
+  vector<string> result;
+  for (auto const & shield : GetRoadShields(mwmName, roadNumber))
+    result.push_back(DebugPrint(shield));
+  return result;
+}
+}  // namespace
+
+UNIT_TEST(RoadShields_Countries)
+{
+  TEST(GetShields("US_New York_West", "").empty(), ());
+
+  auto const us = GetShields("US_New York_West", "I 95;US:NY/17");
+  TEST_EQUAL(us.size(), 2, (us));
+
+  // The same ref is parsed by the rules of another country.
+  TEST_NOT_EQUAL(us, GetShields("Germany_Berlin", "I 95;US:NY/17"), ());
+}
+
+UNIT_TEST(RoadShields_Cache)
+{
+  auto const expected = GetShields("Russia_Moscow", "M 1;E 30");
+  TEST_EQUAL(expected.size(), 2, (expected));
+
+  // Cached results must be the same as parsed ones, for any region of a country.
+  for (size_t i = 0; i < 3; ++i)
+  {
+    TEST_EQUAL(GetShields("Russia_Tver Oblast", "M 1;E 30"), expected, ());
+    TEST_EQUAL(GetShields("Russia_Moscow", "M 1;E 30"), expected, ());
+  }
+}
@@ -5,6 +5,7 @@
 #include "base/string_utils.hpp"
 
 #include <cstdint>
+#include <random>
 #include <string>
 #include <utility>
 #include <vector>
@@ -189,3 +190,29 @@ UNIT_TEST(NormalizeAndSimplifyString_Numero)
   TEST_EQUAL(NormalizeAndSimplifyStringUtf8("Area # "), "area   ", ());
   TEST_EQUAL(NormalizeAndSimplifyStringUtf8("Area #One"), "area #one", ());
 }
+
+UNIT_TEST(NormalizeAndSimplifyString_Latin1FastPath)
+{
+  // Every char is folded independently of its neighbours, so a string
+  // prefixed by a non-Latin char, which disables the fast path, must be
+  // folded to the same chars.
+  string const kSlowPrefix = "Ж";
+  UniString const slowPrefix = NormalizeAndSimplifyString(kSlowPrefix);
+
+  mt19937 rng(0);
+  uniform_int_distribution<uint32_t> length(0, 16);
+  uniform_int_distribution<uint32_t> latin1(1, 0xFF);
+
+  UniString fast;
+  for (size_t i = 0; i < 10000; ++i)
+  {
+    UniString chars;
+    for (uint32_t j = length(rng); j != 0; --j)
+      chars.push_back(latin1(rng));
+    string const s = ToUtf8(chars);
+
+    NormalizeAndSimplifyString(s, fast);
+    UniString const slow = NormalizeAndSimplifyString(kSlowPrefix + s);
+    TEST_EQUAL(slowPrefix + fast, slow, (s));
+  }
+}
@@ -13,6 +13,10 @@ namespace tests
 
 class TestMwmSet : public MwmSet
 {
+public:
+  TestMwmSet() = default;
+  TestMwmSet(size_t cacheSize, size_t cacheBytes) : MwmSet(cacheSize, cacheBytes) {}
+
 protected:
   /// @name MwmSet overrides
   //@{
@@ -223,3 +223,56 @@ UNIT_TEST(TrieBuilder_Build)
     }
   }
 }
+
+UNIT_TEST(TrieBuilder_BuildFromSubtries)
+{
+  using TKey = buffer_vector<trie::TrieChar, 8>;
+  using TValue = uint32_t;
+  using TKeyValuePair = pair<TKey, TValue>;
+  using TValueList = ValueList<TValue>;
+  using TSink = PushBackByteSink<vector<uint8_t>>;
+
+  vector<string> const strings = {"",    "",    "A",   "AA",  "AAB", "AB",  "ABC", "B",
+                                  "BAA", "BAB", "BBB", "BBB", "C",   "CCA", "DAB"};
+  vector<TKeyValuePair> v;
+  for (size_t i = 0; i < strings.size(); ++i)
+    v.emplace_back(TKey(strings[i].begin(), strings[i].end()), static_cast<TValue>(i % 3));
+  sort(v.begin(), v.end());
+
+  SingleValueSerializer<TValue> serializer;
+
+  vector<uint8_t> expected;
+  {
+    TSink sink(expected);
+    trie::Build<TSink, TKey, TValueList, SingleValueSerializer<TValue>>(sink, serializer, v);
+  }
+
+  // Empty keys go to a separate subtrie, other keys are grouped by the first char.
+  auto const getGroup = [](TKey const & key) {
+    return key.empty() ? -1 : static_cast<int64_t>(key[0]);
+  };
+
+  // Subtries are written to separate buffers, as if on different threads.
+  vector<vector<uint8_t>> buffers;
+  vector<trie::NodeInfo<TValueList>> roots;
+  for (auto beg = v.begin(); beg != v.end();)
+  {
+    auto end = beg;
+    while (end != v.end() && getGroup(end->first) == getGroup(beg->first))
+      ++end;
+
+    buffers.emplace_back();
+    TSink sink(buffers.back());
+    roots.push_back(trie::WriteNodesExceptRoot<TSink, TValueList>(sink, serializer, beg, end));
+    beg = end;
+  }
+  TEST_GREATER(roots.size(), 2, ());
+
+  vector<uint8_t> buf;
+  TSink sink(buf);
+  for (auto const & b : buffers)
+    sink.Write(b.data(), b.size());
+  trie::WriteRoot(sink, serializer, roots);
+
+  TEST_EQUAL(buf, expected, ());
+}
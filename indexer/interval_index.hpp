@@ -9,6 +9,8 @@
 #include "base/assert.hpp"
 #include "base/buffer_vector.hpp"
 
+#include "std/algorithm.hpp"
+
 
 class IntervalIndexBase : public IntervalIndexIFace
 {
@@ -71,12 +73,152 @@ public:
     }
   }
 
+  /// Calls |f| for all values of keys from |intervals| in a single walk of the tree,
+  /// so nodes shared by several intervals are read and decoded only once.
+  /// Intervals may be given in any order and may overlap.
+  template <typename F>
+  void ForEachInIntervals(F const & f, IntervalsT const & intervals) const
+  {
+    if (m_Header.m_Levels == 0)
+      return;
+
+    // Inclusive intervals, sorted and merged.
+    buffer_vector<pair<uint64_t, uint64_t>, 64> keys;
+    keys.reserve(intervals.size());
+    uint64_t const keyEnd = KeyEnd();
+    for (auto const & i : intervals)
+    {
+      ASSERT_GREATER_OR_EQUAL(i.first, 0, ());
+      uint64_t const beg = static_cast<uint64_t>(i.first);
+      uint64_t const end = min(static_cast<uint64_t>(i.second), keyEnd);
+      if (beg < end)
+        keys.push_back(make_pair(beg, end - 1));
+    }
+    if (keys.empty())
+      return;
+
+    sort(keys.begin(), keys.end());
+    size_t n = 0;
+    for (size_t i = 1; i < keys.size(); ++i)
+    {
+      if (keys[i].first <= keys[n].second + 1)
+        keys[n].second = max(keys[n].second, keys[i].second);
+      else
+        keys[++n] = keys[i];
+    }
+    keys.resize(n + 1);
+
+    ForEachNodeInIntervals(f, keys.data(), keys.data() + keys.size(), 0 /* nodeBeg */,
+                           m_Header.m_Levels, 0,
+                           m_LevelOffsets[m_Header.m_Levels + 1] - m_LevelOffsets[m_Header.m_Levels]);
+  }
+
   virtual void DoForEach(FunctionT const & f, uint64_t beg, uint64_t end)
   {
     ForEach(f, beg, end);
   }
 
+  virtual void DoForEachInIntervals(FunctionT const & f, IntervalsT const & intervals)
+  {
+    ForEachInIntervals(f, intervals);
+  }
+
 private:
+  using KeyInterval = pair<uint64_t, uint64_t>;
+
+  /// [first, last) are sorted disjoint inclusive intervals of absolute keys,
+  /// all of them intersect the node which starts at |nodeBeg|.
+  template <typename F>
+  void ForEachNodeInIntervals(F const & f, KeyInterval const * first, KeyInterval const * last,
+                              uint64_t nodeBeg, int level, uint32_t offset, uint32_t size) const
+  {
+    offset += m_LevelOffsets[level];
+
+    buffer_vector<uint8_t, 1024> data;
+    data.resize_no_init(size);
+
+    m_Reader.Read(offset, &data[0], size);
+    ArrayByteSource src(&data[0]);
+    void const * pEnd = &data[0] + size;
+
+    if (level == 0)
+    {
+      uint32_t value = 0;
+      while (src.Ptr() < pEnd)
+      {
+        uint32_t key = 0;
+        src.Read(&key, m_Header.m_LeafBytes);
+        uint64_t const absKey = nodeBeg + SwapIfBigEndian(key);
+        while (first != last && first->second < absKey)
+          ++first;
+        if (first == last)
+          break;
+        value += ReadVarInt<int32_t>(src);
+        if (absKey >= first->first)
+          f(value);
+      }
+      return;
+    }
+
+    uint8_t const skipBits = (m_Header.m_LeafBytes << 3) + (level - 1) * m_Header.m_BitsPerLevel;
+    uint64_t const levelBytesFF = (1ULL << skipBits) - 1;
+    uint64_t const nodeEnd = nodeBeg + (1ULL << (skipBits + m_Header.m_BitsPerLevel)) - 1;
+    uint32_t const end0 =
+        static_cast<uint32_t>((min((last - 1)->second, nodeEnd) - nodeBeg) >> skipBits);
+    ASSERT_LESS(end0, (1U << m_Header.m_BitsPerLevel), (nodeBeg, skipBits));
+
+    // Calls ForEachNodeInIntervals for the child |i| if some of the intervals intersect it.
+    // Returns false when there are no intervals after the child.
+    auto const forChild = [&](uint32_t i, uint32_t childOffset, uint32_t childSize)
+    {
+      uint64_t const childBeg = nodeBeg + (static_cast<uint64_t>(i) << skipBits);
+      uint64_t const childEnd = childBeg + levelBytesFF;
+      while (first != last && first->second < childBeg)
+        ++first;
+      if (first == last)
+        return false;
+      if (first->first > childEnd)
+        return true;
+      KeyInterval const * it = first;
+      while (it != last && it->first <= childEnd)
+        ++it;
+      ForEachNodeInIntervals(f, first, it, childBeg, level - 1, childOffset, childSize);
+      return true;
+    };
+
+    uint32_t const offsetAndFlag = ReadVarUint<uint32_t>(src);
+    uint32_t childOffset = offsetAndFlag >> 1;
+    if (offsetAndFlag & 1)
+    {
+      // Reading bitmap.
+      uint8_t const * pBitmap = static_cast<uint8_t const *>(src.Ptr());
+      src.Advance(BitmapSize(m_Header.m_BitsPerLevel));
+      for (uint32_t i = 0; i <= end0; ++i)
+      {
+        if (bits::GetBit(pBitmap, i))
+        {
+          uint32_t childSize = ReadVarUint<uint32_t>(src);
+          if (!forChild(i, childOffset, childSize))
+            return;
+          childOffset += childSize;
+        }
+      }
+    }
+    else
+    {
+      while (src.Ptr() < pEnd)
+      {
+        uint8_t const i = src.ReadByte();
+        if (i > end0)
+          break;
+        uint32_t childSize = ReadVarUint<uint32_t>(src);
+        if (!forChild(i, childOffset, childSize))
+          return;
+        childOffset += childSize;
+      }
+    }
+  }
+
 
   template <typename F>
   void ForEachLeaf(F const & f, uint64_t const beg, uint64_t const end,
@@ -2,6 +2,8 @@
 
 #include "std/cstdint.hpp"
 #include "std/function.hpp"
+#include "std/utility.hpp"
+#include "std/vector.hpp"
 
 
 class IntervalIndexIFace
@@ -10,6 +12,16 @@ public:
   virtual ~IntervalIndexIFace() {}
 
   typedef function<void (uint32_t)> FunctionT;
+  /// Intervals [beg, end) of keys, the same as covering::IntervalsT.
+  typedef vector<pair<int64_t, int64_t>> IntervalsT;
 
   virtual void DoForEach(FunctionT const & f, uint64_t beg, uint64_t end) = 0;
+
+  /// Calls |f| for all values of all |intervals|. Values of keys covered by
+  /// several intervals may be passed to |f| several times.
+  virtual void DoForEachInIntervals(FunctionT const & f, IntervalsT const & intervals)
+  {
+    for (auto const & i : intervals)
+      DoForEach(f, i.first, i.second);
+  }
 };
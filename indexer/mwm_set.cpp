@@ -11,6 +11,7 @@
 #include "std/algorithm.hpp"
 #include "std/exception.hpp"
 #include "std/sstream.hpp"
+#include "std/thread.hpp"
 
 #include "defines.hpp"
 
@@ -88,69 +89,130 @@ MwmSet::MwmId MwmSet::GetMwmIdByCountryFileImpl(CountryFile const & countryFile)
 pair<MwmSet::MwmId, MwmSet::RegResult> MwmSet::Register(LocalCountryFile const & localFile)
 {
   pair<MwmSet::MwmId, MwmSet::RegResult> result;
-  auto registerFile = [&](EventList & events)
+  WithEventLog([&](EventList & events)
+               {
+                 result = RegisterUnsafe(localFile, [&]() { return CreateInfo(localFile); },
+                                         events);
+               });
+  return result;
+}
+
+vector<pair<MwmSet::MwmId, MwmSet::RegResult>> MwmSet::Register(
+    vector<LocalCountryFile> const & localFiles, size_t threadsCount)
+{
+  if (threadsCount == 0)
+    threadsCount = max(thread::hardware_concurrency(), 1u);
+  threadsCount = min(threadsCount, localFiles.size());
+
+  // CreateInfo() only reads the file, so headers are read in parallel before the lock is taken.
+  vector<unique_ptr<MwmInfo>> infos(localFiles.size());
+  // Not vector<bool>, its elements are written by different threads.
+  vector<uint8_t> isBad(localFiles.size(), 0);
+  atomic<size_t> next(0);
+  auto readHeaders = [&]()
   {
-    CountryFile const & countryFile = localFile.GetCountryFile();
-    MwmId const id = GetMwmIdByCountryFileImpl(countryFile);
-    if (!id.IsAlive())
+    for (size_t i = next++; i < localFiles.size(); i = next++)
     {
-      result = RegisterImpl(localFile, events);
-      return;
+      try
+      {
+        infos[i] = CreateInfo(localFiles[i]);
+      }
+      catch (RootException const & e)
+      {
+        LOG(LERROR, ("Can't read header of", localFiles[i].GetCountryName(), e.Msg()));
+        isBad[i] = 1;
+      }
     }
+  };
 
-    shared_ptr<MwmInfo> info = id.GetInfo();
+  vector<thread> threads;
+  for (size_t i = 1; i < threadsCount; ++i)
+    threads.emplace_back(readHeaders);
+  readHeaders();
+  for (auto & t : threads)
+    t.join();
 
-    // Deregister old mwm for the country.
-    if (info->GetVersion() < localFile.GetVersion())
-    {
-      EventList subEvents;
-      DeregisterImpl(id, subEvents);
-      result = RegisterImpl(localFile, subEvents);
-
-      // In the case of success all sub-events are
-      // replaced with a single UPDATE event. Otherwise,
-      // sub-events are reported as is.
-      if (result.second == MwmSet::RegResult::Success)
-        events.Add(Event(Event::TYPE_UPDATED, localFile, info->GetLocalFile()));
-      else
-        events.Append(subEvents);
-      return;
-    }
+  vector<pair<MwmId, RegResult>> results(localFiles.size());
+  WithEventLog([&](EventList & events)
+               {
+                 for (size_t i = 0; i < localFiles.size(); ++i)
+                 {
+                   if (isBad[i])
+                   {
+                     results[i] = make_pair(MwmId(), RegResult::BadFile);
+                     continue;
+                   }
+                   results[i] = RegisterUnsafe(localFiles[i], [&]() { return move(infos[i]); },
+                                               events);
+                 }
+               });
+  return results;
+}
 
-    string const name = countryFile.GetName();
-    // Update the status of the mwm with the same version.
-    if (info->GetVersion() == localFile.GetVersion())
-    {
-      LOG(LINFO, ("Updating already registered mwm:", name));
-      SetStatus(*info, MwmInfo::STATUS_REGISTERED, events);
-      info->m_file = localFile;
-      result = make_pair(id, RegResult::VersionAlreadyExists);
-      return;
-    }
+template <typename TCreateInfo>
+pair<MwmSet::MwmId, MwmSet::RegResult> MwmSet::RegisterUnsafe(LocalCountryFile const & localFile,
+                                                              TCreateInfo && createInfo,
+                                                              EventList & events)
+{
+  CountryFile const & countryFile = localFile.GetCountryFile();
+  MwmId const id = GetMwmIdByCountryFileImpl(countryFile);
+  if (!id.IsAlive())
+    return AddInfo(localFile, createInfo(), events);
 
-    LOG(LWARNING, ("Trying to add too old (", localFile.GetVersion(), ") mwm (", name,
-                   "), current version:", info->GetVersion()));
-    result = make_pair(MwmId(), RegResult::VersionTooOld);
-    return;
-  };
+  shared_ptr<MwmInfo> info = id.GetInfo();
 
-  WithEventLog(registerFile);
-  return result;
+  // Deregister old mwm for the country.
+  if (info->GetVersion() < localFile.GetVersion())
+  {
+    EventList subEvents;
+    DeregisterImpl(id, subEvents);
+    auto const result = AddInfo(localFile, createInfo(), subEvents);
+
+    // In the case of success all sub-events are
+    // replaced with a single UPDATE event. Otherwise,
+    // sub-events are reported as is.
+    if (result.second == MwmSet::RegResult::Success)
+      events.Add(Event(Event::TYPE_UPDATED, localFile, info->GetLocalFile()));
+    else
+      events.Append(subEvents);
+    return result;
+  }
+
+  string const name = countryFile.GetName();
+  // Update the status of the mwm with the same version.
+  if (info->GetVersion() == localFile.GetVersion())
+  {
+    LOG(LINFO, ("Updating already registered mwm:", name));
+    SetStatus(*info, MwmInfo::STATUS_REGISTERED, events);
+    info->m_file = localFile;
+    return make_pair(id, RegResult::VersionAlreadyExists);
+  }
+
+  LOG(LWARNING, ("Trying to add too old (", localFile.GetVersion(), ") mwm (", name,
+                 "), current version:", info->GetVersion()));
+  return make_pair(MwmId(), RegResult::VersionTooOld);
 }
 
 pair<MwmSet::MwmId, MwmSet::RegResult> MwmSet::RegisterImpl(LocalCountryFile const & localFile,
                                                             EventList & events)
 {
   // This function can throw an exception for a bad mwm file.
-  shared_ptr<MwmInfo> info(CreateInfo(localFile));
+  return AddInfo(localFile, CreateInfo(localFile), events);
+}
+
+pair<MwmSet::MwmId, MwmSet::RegResult> MwmSet::AddInfo(LocalCountryFile const & localFile,
+                                                       unique_ptr<MwmInfo> info,
+                                                       EventList & events)
+{
   if (!info)
     return make_pair(MwmId(), RegResult::UnsupportedFileFormat);
 
-  info->m_file = localFile;
-  SetStatus(*info, MwmInfo::STATUS_REGISTERED, events);
-  m_info[localFile.GetCountryName()].push_back(info);
+  shared_ptr<MwmInfo> sharedInfo(move(info));
+  sharedInfo->m_file = localFile;
+  SetStatus(*sharedInfo, MwmInfo::STATUS_REGISTERED, events);
+  m_info[localFile.GetCountryName()].push_back(sharedInfo);
 
-  return make_pair(MwmId(info), RegResult::Success);
+  return make_pair(MwmId(sharedInfo), RegResult::Success);
 }
 
 bool MwmSet::DeregisterImpl(MwmId const & id, EventList & events)
@@ -168,7 +230,7 @@ bool MwmSet::DeregisterImpl(MwmId const & id, EventList & events)
     {
       if (it->first == id)
       {
-        m_cache.erase(it);
+        ClearCacheImpl(it, next(it));
         break;
       }
     }
@@ -201,7 +263,7 @@ bool MwmSet::DeregisterImpl(CountryFile const & countryFile, EventList & events)
 
 bool MwmSet::IsLoaded(CountryFile const & countryFile) const
 {
-  lock_guard<mutex> lock(m_lock);
+  base::trace::LockGuard<mutex> lock(m_lock, "MwmSet");
 
   MwmId const id = GetMwmIdByCountryFileImpl(countryFile);
   return id.IsAlive() && id.GetInfo()->IsRegistered();
@@ -209,7 +271,7 @@ bool MwmSet::IsLoaded(CountryFile const & countryFile) const
 
 void MwmSet::GetMwmsInfo(vector<shared_ptr<MwmInfo>> & info) const
 {
-  lock_guard<mutex> lock(m_lock);
+  base::trace::LockGuard<mutex> lock(m_lock, "MwmSet");
   info.clear();
   info.reserve(m_info.size());
   for (auto const & p : m_info)
@@ -258,18 +320,50 @@ void MwmSet::ProcessEventList(EventList & events)
 
 unique_ptr<MwmSet::MwmValueBase> MwmSet::LockValue(MwmId const & id)
 {
-  unique_ptr<MwmSet::MwmValueBase> result;
+  unique_ptr<MwmValueBase> result;
+  {
+    base::trace::LockGuard<mutex> lock(m_lock, "MwmSet");
+    if (!LockValueImpl(id, result) || result)
+      return result;
+    ++m_cacheStats.m_misses;
+  }
+
+  // The taken reference prevents mwm from deregistration, so it's
+  // safe to create a value without |m_lock|.
+  shared_ptr<MwmInfo> info = id.GetInfo();
+  bool deregister = false;
+  try
+  {
+    return CreateValue(*info);
+  }
+  catch (Reader::TooManyFilesException const & ex)
+  {
+    LOG(LERROR, ("Too many open files, can't open:", info->GetCountryName()));
+  }
+  catch (exception const & ex)
+  {
+    LOG(LERROR, ("Can't create MWMValue for", info->GetCountryName(), "Reason", ex.what()));
+    deregister = true;
+  }
+
   WithEventLog([&](EventList & events)
                {
-                 result = LockValueImpl(id, events);
+                 ASSERT_GREATER(info->m_numRefs, 0, ());
+                 --info->m_numRefs;
+                 if (deregister ||
+                     (info->m_numRefs == 0 &&
+                      info->GetStatus() == MwmInfo::STATUS_MARKED_TO_DEREGISTER))
+                 {
+                   DeregisterImpl(id, events);
+                 }
                });
-  return result;
+  return nullptr;
 }
 
-unique_ptr<MwmSet::MwmValueBase> MwmSet::LockValueImpl(MwmId const & id, EventList & events)
+bool MwmSet::LockValueImpl(MwmId const & id, unique_ptr<MwmValueBase> & value)
 {
   if (!id.IsAlive())
-    return nullptr;
+    return false;
   shared_ptr<MwmInfo> info = id.GetInfo();
 
   // It's better to return valid "value pointer" even for "out-of-date" files,
@@ -284,41 +378,29 @@ unique_ptr<MwmSet::MwmValueBase> MwmSet::LockValueImpl(MwmId const & id, EventLi
   {
     if (it->first == id)
     {
-      unique_ptr<MwmValueBase> result = move(it->second);
+      value = move(it->second);
+      m_cacheBytes -= value->GetMemoryUsage();
       m_cache.erase(it);
-      return result;
+      ++m_cacheStats.m_hits;
+      break;
     }
   }
-
-  try
-  {
-    return CreateValue(*info);
-  }
-  catch (Reader::TooManyFilesException const & ex)
-  {
-    LOG(LERROR, ("Too many open files, can't open:", info->GetCountryName()));
-    --info->m_numRefs;
-    return nullptr;
-  }
-  catch (exception const & ex)
-  {
-    LOG(LERROR, ("Can't create MWMValue for", info->GetCountryName(), "Reason", ex.what()));
-
-    --info->m_numRefs;
-    DeregisterImpl(id, events);
-    return nullptr;
-  }
+  return true;
 }
 
 void MwmSet::UnlockValue(MwmId const & id, unique_ptr<MwmValueBase> p)
 {
+  vector<unique_ptr<MwmValueBase>> evicted;
   WithEventLog([&](EventList & events)
                {
-                 UnlockValueImpl(id, move(p), events);
+                 UnlockValueImpl(id, move(p), evicted, events);
                });
+  // |evicted| values are destroyed here, without |m_lock|, as
+  // closing of files may be slow.
 }
 
-void MwmSet::UnlockValueImpl(MwmId const & id, unique_ptr<MwmValueBase> p, EventList & events)
+void MwmSet::UnlockValueImpl(MwmId const & id, unique_ptr<MwmValueBase> p,
+                             vector<unique_ptr<MwmValueBase>> & evicted, EventList & events)
 {
   ASSERT(id.IsAlive(), (id));
   ASSERT(p.get() != nullptr, ());
@@ -336,65 +418,68 @@ void MwmSet::UnlockValueImpl(MwmId const & id, unique_ptr<MwmValueBase> p, Event
     /// @todo Probably, it's better to store only "unique by id" free caches here.
     /// But it's no obvious if we have many threads working with the single mwm.
 
+    m_cacheBytes += p->GetMemoryUsage();
     m_cache.push_back(make_pair(id, move(p)));
-    if (m_cache.size() > m_cacheSize)
+    while (!m_cache.empty() && IsCacheOverLimits())
     {
-      ASSERT_EQUAL(m_cache.size(), m_cacheSize + 1, ());
+      evicted.push_back(move(m_cache.front().second));
+      m_cacheBytes -= evicted.back()->GetMemoryUsage();
       m_cache.pop_front();
+      ++m_cacheStats.m_evictions;
     }
   }
 }
 
 void MwmSet::Clear()
 {
-  lock_guard<mutex> lock(m_lock);
+  base::trace::LockGuard<mutex> lock(m_lock, "MwmSet");
   ClearCacheImpl(m_cache.begin(), m_cache.end());
   m_info.clear();
 }
 
 void MwmSet::ClearCache()
 {
-  lock_guard<mutex> lock(m_lock);
+  base::trace::LockGuard<mutex> lock(m_lock, "MwmSet");
   ClearCacheImpl(m_cache.begin(), m_cache.end());
 }
 
+MwmSet::CacheStats MwmSet::GetCacheStats() const
+{
+  base::trace::LockGuard<mutex> lock(m_lock, "MwmSet");
+  return m_cacheStats;
+}
+
 MwmSet::MwmId MwmSet::GetMwmIdByCountryFile(CountryFile const & countryFile) const
 {
-  lock_guard<mutex> lock(m_lock);
+  base::trace::LockGuard<mutex> lock(m_lock, "MwmSet");
   return GetMwmIdByCountryFileImpl(countryFile);
 }
 
 MwmSet::MwmHandle MwmSet::GetMwmHandleByCountryFile(CountryFile const & countryFile)
 {
-  MwmSet::MwmHandle handle;
-  WithEventLog([&](EventList & events)
-               {
-                 handle = GetMwmHandleByIdImpl(GetMwmIdByCountryFileImpl(countryFile), events);
-               });
-  return handle;
+  return GetMwmHandleById(GetMwmIdByCountryFile(countryFile));
 }
 
 MwmSet::MwmHandle MwmSet::GetMwmHandleById(MwmId const & id)
 {
-  MwmSet::MwmHandle handle;
-  WithEventLog([&](EventList & events)
-               {
-                 handle = GetMwmHandleByIdImpl(id, events);
-               });
-  return handle;
+  return MwmHandle(*this, id, LockValue(id));
 }
 
-MwmSet::MwmHandle MwmSet::GetMwmHandleByIdImpl(MwmId const & id, EventList & events)
+void MwmSet::ClearCacheImpl(CacheType::iterator beg, CacheType::iterator end)
 {
-  unique_ptr<MwmValueBase> value;
-  if (id.IsAlive())
-    value = LockValueImpl(id, events);
-  return MwmHandle(*this, id, move(value));
+  for (auto it = beg; it != end; ++it)
+  {
+    if (it->second)
+      m_cacheBytes -= it->second->GetMemoryUsage();
+  }
+  m_cache.erase(beg, end);
 }
 
-void MwmSet::ClearCacheImpl(CacheType::iterator beg, CacheType::iterator end)
+bool MwmSet::IsCacheOverLimits() const
 {
-  m_cache.erase(beg, end);
+  if (m_cache.size() > m_cacheSize)
+    return true;
+  return m_cacheBytesLimit != 0 && m_cacheBytes > m_cacheBytesLimit;
 }
 
 void MwmSet::ClearCache(MwmId const & id)
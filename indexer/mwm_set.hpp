@@ -7,6 +7,7 @@
 #include "geometry/rect2d.hpp"
 
 #include "base/macros.hpp"
+#include "base/trace.hpp"
 
 #include "indexer/feature_meta.hpp"
 
@@ -118,13 +119,33 @@ public:
   };
 
 public:
-  explicit MwmSet(size_t cacheSize = 64) : m_cacheSize(cacheSize) {}
+  // |cacheSize| limits the number of cached values, i.e. the number of
+  // opened files, |cacheBytes| limits the total memory usage of cached
+  // values. Zero |cacheBytes| means that memory usage is not limited.
+  explicit MwmSet(size_t cacheSize = 64, size_t cacheBytes = 0)
+    : m_cacheSize(cacheSize), m_cacheBytesLimit(cacheBytes)
+  {
+  }
   virtual ~MwmSet() = default;
 
   class MwmValueBase
   {
   public:
     virtual ~MwmValueBase() = default;
+
+    // Returns an estimation of the memory used by the value. It's used
+    // to keep the cache of values in the budget.
+    virtual size_t GetMemoryUsage() const { return 0; }
+  };
+
+  struct CacheStats
+  {
+    // Number of handles taken from the cache.
+    uint64_t m_hits = 0;
+    // Number of handles with newly created values.
+    uint64_t m_misses = 0;
+    // Number of values removed from the cache to fit limits.
+    uint64_t m_evictions = 0;
   };
 
   // Mwm handle, which is used to refer to mwm and prevent it from
@@ -259,6 +280,12 @@ protected:
 
 public:
   pair<MwmId, RegResult> Register(platform::LocalCountryFile const & localFile);
+
+  /// Registers |localFiles| in their order. Headers of the files are read by |threadsCount|
+  /// threads in parallel and without the lock, |threadsCount| equal to zero means the number
+  /// of cores. Files which can't be read get RegResult::BadFile.
+  vector<pair<MwmId, RegResult>> Register(vector<platform::LocalCountryFile> const & localFiles,
+                                          size_t threadsCount = 0);
   //@}
 
   /// @name Remove mwm.
@@ -294,6 +321,8 @@ public:
 
   void ClearCache();
 
+  CacheStats GetCacheStats() const;
+
   MwmId GetMwmIdByCountryFile(platform::CountryFile const & countryFile) const;
 
   MwmHandle GetMwmHandleByCountryFile(platform::CountryFile const & countryFile);
@@ -310,6 +339,10 @@ public:
 
 protected:
   virtual unique_ptr<MwmInfo> CreateInfo(platform::LocalCountryFile const & localFile) const = 0;
+
+  // Note that this function is called without |m_lock|, because
+  // opening of an mwm is slow and other threads shouldn't wait for
+  // it. The mwm can't be deregistered during the call.
   virtual unique_ptr<MwmValueBase> CreateValue(MwmInfo & info) const = 0;
 
 private:
@@ -327,7 +360,7 @@ private:
   {
     EventList events;
     {
-      lock_guard<mutex> lock(m_lock);
+      base::trace::LockGuard<mutex> lock(m_lock, "MwmSet");
       fn(events);
     }
     ProcessEventList(events);
@@ -339,20 +372,44 @@ private:
   // Triggers observers on each event in |events|.
   void ProcessEventList(EventList & events);
 
-  /// @precondition This function is always called under mutex m_lock.
-  MwmHandle GetMwmHandleByIdImpl(MwmId const & id, EventList & events);
+  // Registers |localFile| replacing an older version of the mwm. |createInfo| returns info for
+  // |localFile| and is called only if the file needs a new info.
+  // @precondition This function is always called under mutex m_lock.
+  template <typename TCreateInfo>
+  pair<MwmId, RegResult> RegisterUnsafe(platform::LocalCountryFile const & localFile,
+                                        TCreateInfo && createInfo, EventList & events);
+
+  // Adds |info| created for |localFile|, |info| is null for an unsupported file.
+  // @precondition This function is always called under mutex m_lock.
+  pair<MwmId, RegResult> AddInfo(platform::LocalCountryFile const & localFile,
+                                 unique_ptr<MwmInfo> info, EventList & events);
 
   unique_ptr<MwmValueBase> LockValue(MwmId const & id);
-  unique_ptr<MwmValueBase> LockValueImpl(MwmId const & id, EventList & events);
+
+  /// Takes a reference to mwm and a cached value if there is one.
+  /// \return False if mwm is not alive.
+  /// @precondition This function is always called under mutex m_lock.
+  bool LockValueImpl(MwmId const & id, unique_ptr<MwmValueBase> & value);
+
   void UnlockValue(MwmId const & id, unique_ptr<MwmValueBase> p);
-  void UnlockValueImpl(MwmId const & id, unique_ptr<MwmValueBase> p, EventList & events);
+
+  /// Puts |p| to the cache, values which don't fit cache limits are
+  /// moved to |evicted| to be destroyed without |m_lock|.
+  /// @precondition This function is always called under mutex m_lock.
+  void UnlockValueImpl(MwmId const & id, unique_ptr<MwmValueBase> p,
+                       vector<unique_ptr<MwmValueBase>> & evicted, EventList & events);
 
   /// Do the cleaning for [beg, end) without acquiring the mutex.
   /// @precondition This function is always called under mutex m_lock.
   void ClearCacheImpl(CacheType::iterator beg, CacheType::iterator end);
 
+  bool IsCacheOverLimits() const;
+
   CacheType m_cache;
   size_t const m_cacheSize;
+  size_t const m_cacheBytesLimit;
+  size_t m_cacheBytes = 0;
+  CacheStats m_cacheStats;
 
 protected:
   /// @precondition This function is always called under mutex m_lock.
@@ -36,6 +36,7 @@ namespace old_101 { namespace feature
     uint32_t ParseGeometry(int scale) override;
     uint32_t ParseTriangles(int scale) override;
     void ParseMetadata() override {}  /// not supported in this version
+    string ParseMetadataField(uint8_t /* type */) override { return string(); }
   };
 }
 }
@@ -0,0 +1,51 @@
+#include "indexer/opening_hours_cache.hpp"
+
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+using namespace std;
+
+namespace
+{
+// Distinct opening hours rules are few compared to features, so the cache
+// is just dropped when it's full instead of evicting the least recently
+// used entries.
+size_t constexpr kMaxCacheSize = 10000;
+
+class OpeningHoursCache
+{
+public:
+  shared_ptr<osmoh::OpeningHours const> Get(string const & openingHours)
+  {
+    {
+      lock_guard<mutex> lock(m_mutex);
+      auto const it = m_rules.find(openingHours);
+      if (it != m_rules.end())
+        return it->second;
+    }
+
+    // Parsing is done out of the lock, a rare concurrent parsing of the
+    // same rule gives the same result.
+    auto rules = make_shared<osmoh::OpeningHours const>(openingHours);
+
+    lock_guard<mutex> lock(m_mutex);
+    if (m_rules.size() >= kMaxCacheSize)
+      m_rules.clear();
+    return m_rules.emplace(openingHours, move(rules)).first->second;
+  }
+
+private:
+  mutex m_mutex;
+  unordered_map<string, shared_ptr<osmoh::OpeningHours const>> m_rules;
+};
+}  // namespace
+
+namespace osm
+{
+shared_ptr<osmoh::OpeningHours const> GetParsedOpeningHours(string const & openingHours)
+{
+  static OpeningHoursCache cache;
+  return cache.Get(openingHours);
+}
+}  // namespace osm
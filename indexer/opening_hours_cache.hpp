@@ -0,0 +1,16 @@
+#pragma once
+
+#include "3party/opening_hours/opening_hours.hpp"
+
+#include <memory>
+#include <string>
+
+namespace osm
+{
+// Returns parsed |openingHours| rules. Parsing of a rule is much more
+// expensive than its evaluation, and the same rules are shared by many
+// features, so parsed rules are cached by the raw metadata string.
+// Returned rules may be evaluated for any time without reparsing.
+// Thread-safe.
+std::shared_ptr<osmoh::OpeningHours const> GetParsedOpeningHours(std::string const & openingHours);
+}  // namespace osm
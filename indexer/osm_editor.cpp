@@ -64,6 +64,9 @@ constexpr char const * kRelationsAreNotSupported = "Relations are not supported
 constexpr char const * kNeedsRetry = "Needs Retry";
 constexpr char const * kWrongMatch = "Matched feature has no tags";
 
+// Max number of features whose changes are uploaded in one osmChange diff.
+size_t constexpr kUploadBatchSize = 50;
+
 bool NeedsUpload(string const & uploadStatus)
 {
   return uploadStatus != kUploaded &&
@@ -172,6 +175,7 @@ void Editor::LoadMapEdits()
 
   // TODO(mgsergio): synchronize access to m_features.
   m_features.clear();
+  m_editedIndices.reset();
   for (xml_node mwm : doc.child(kXmlRootNode).children(kXmlMwmNode))
   {
     string const mapName = mwm.attribute("name").as_string("");
@@ -252,6 +256,7 @@ void Editor::LoadMapEdits()
           }
           // Insert initialized structure at the end: exceptions are possible in above code.
           m_features[fid.m_mwmId].emplace(fid.m_index, move(fti));
+          MarkEditedIndex(fid.m_index);
         }
         catch (editor::XMLFeatureError const & ex)
         {
@@ -336,6 +341,7 @@ bool Editor::Save() const
 void Editor::ClearAllLocalEdits()
 {
   m_features.clear();
+  m_editedIndices.reset();
   Save();
   Invalidate();
 }
@@ -362,7 +368,7 @@ void Editor::OnMapDeregistered(platform::LocalCountryFile const & localFile)
 Editor::FeatureStatus Editor::GetFeatureStatus(MwmSet::MwmId const & mwmId, uint32_t index) const
 {
   // Most popular case optimization.
-  if (m_features.empty())
+  if (m_features.empty() || !MayBeEdited(index))
     return FeatureStatus::Untouched;
 
   auto const * featureInfo = GetFeatureTypeInfo(mwmId, index);
@@ -530,6 +536,7 @@ Editor::SaveResult Editor::SaveEditedFeature(EditableMapObject const & emo)
   // Reset upload status so already uploaded features can be uploaded again after modification.
   fti.m_uploadStatus = {};
   m_features[fid.m_mwmId][fid.m_index] = move(fti);
+  MarkEditedIndex(fid.m_index);
 
   // TODO(AlexZ): Synchronize Save call/make it on a separate thread.
   bool const savedSuccessfully = Save();
@@ -729,6 +736,56 @@ void Editor::UploadChanges(string const & key, string const & secret, TChangeset
 
     int uploadedFeaturesCount = 0, errorsCount = 0;
     ChangesetWrapper changeset({key, secret}, tags);
+
+    auto const finishUpload = [this](FeatureTypeInfo & fti, string const & ourDebugFeatureString)
+    {
+      // TODO(AlexZ): Use timestamp from the server.
+      fti.m_uploadAttemptTimestamp = time(nullptr);
+
+      if (fti.m_uploadStatus != kUploaded)
+      {
+        ms::LatLon const ll = MercatorBounds::ToLatLon(feature::GetCenter(fti.m_feature));
+        alohalytics::LogEvent("Editor_DataSync_error", {{"type", fti.m_uploadStatus},
+                              {"details", fti.m_uploadError}, {"our", ourDebugFeatureString},
+                              {"mwm", fti.m_feature.GetID().GetMwmName()},
+                              {"mwm_version", strings::to_string(fti.m_feature.GetID().GetMwmVersion())}},
+                              alohalytics::Location::FromLatLon(ll.lat, ll.lon));
+      }
+      SaveUploadedInformation(fti);
+    };
+
+    // Features whose changes are queued in the changeset but are not uploaded yet.
+    vector<pair<FeatureTypeInfo *, string>> queued;
+    // Uploads queued changes and saves upload information of all features processed since
+    // the previous flush, so an interrupted upload is resumed from the first not saved feature.
+    auto const flush = [&]()
+    {
+      try
+      {
+        changeset.Flush();
+        for (auto & q : queued)
+        {
+          q.first->m_uploadStatus = kUploaded;
+          q.first->m_uploadError.clear();
+        }
+        uploadedFeaturesCount += static_cast<int>(queued.size());
+      }
+      catch (RootException const & ex)
+      {
+        for (auto & q : queued)
+        {
+          q.first->m_uploadStatus = kNeedsRetry;
+          q.first->m_uploadError = ex.Msg();
+        }
+        errorsCount += static_cast<int>(queued.size());
+        LOG(LWARNING, (ex.what()));
+      }
+      for (auto & q : queued)
+        finishUpload(*q.first, q.second);
+      queued.clear();
+      Save();
+    };
+
     for (auto & id : features)
     {
       for (auto & index : id.second)
@@ -739,6 +796,7 @@ void Editor::UploadChanges(string const & key, string const & secret, TChangeset
           continue;
 
         string ourDebugFeatureString;
+        size_t const queuedChangesCount = changeset.GetQueuedChangesCount();
 
         try
         {
@@ -843,6 +901,13 @@ void Editor::UploadChanges(string const & key, string const & secret, TChangeset
                 changeset, *originalFeaturePtr));
             break;
           }
+          if (changeset.GetQueuedChangesCount() != queuedChangesCount)
+          {
+            queued.emplace_back(&fti, move(ourDebugFeatureString));
+            if (queued.size() == kUploadBatchSize)
+              flush();
+            continue;
+          }
           fti.m_uploadStatus = kUploaded;
           fti.m_uploadError.clear();
           ++uploadedFeaturesCount;
@@ -875,22 +940,11 @@ void Editor::UploadChanges(string const & key, string const & secret, TChangeset
           ++errorsCount;
           LOG(LWARNING, (ex.what()));
         }
-        // TODO(AlexZ): Use timestamp from the server.
-        fti.m_uploadAttemptTimestamp = time(nullptr);
-
-        if (fti.m_uploadStatus != kUploaded)
-        {
-          ms::LatLon const ll = MercatorBounds::ToLatLon(feature::GetCenter(fti.m_feature));
-          alohalytics::LogEvent("Editor_DataSync_error", {{"type", fti.m_uploadStatus},
-                                {"details", fti.m_uploadError}, {"our", ourDebugFeatureString},
-                                {"mwm", fti.m_feature.GetID().GetMwmName()},
-                                {"mwm_version", strings::to_string(fti.m_feature.GetID().GetMwmVersion())}},
-                                alohalytics::Location::FromLatLon(ll.lat, ll.lon));
-        }
-        // Call Save every time we modify each feature's information.
-        SaveUploadedInformation(fti);
+        finishUpload(fti, ourDebugFeatureString);
       }
     }
+    flush();
+
 
     alohalytics::LogEvent("Editor_DataSync_finished", {{"errors", strings::to_string(errorsCount)},
                           {"uploaded", strings::to_string(uploadedFeaturesCount)},
@@ -915,7 +969,7 @@ void Editor::UploadChanges(string const & key, string const & secret, TChangeset
 
 void Editor::SaveUploadedInformation(FeatureTypeInfo const & fromUploader)
 {
-  // TODO(AlexZ): Correctly synchronize this call and Save() at the end.
+  // TODO(AlexZ): Correctly synchronize this call and Save() of the uploader.
   FeatureID const & fid = fromUploader.m_feature.GetID();
   auto id = m_features.find(fid.m_mwmId);
   if (id == m_features.end())
@@ -927,7 +981,6 @@ void Editor::SaveUploadedInformation(FeatureTypeInfo const & fromUploader)
   fti.m_uploadAttemptTimestamp = fromUploader.m_uploadAttemptTimestamp;
   fti.m_uploadStatus = fromUploader.m_uploadStatus;
   fti.m_uploadError = fromUploader.m_uploadError;
-  Save();
 }
 
 // Macros is used to avoid code duplication.
@@ -935,6 +988,9 @@ void Editor::SaveUploadedInformation(FeatureTypeInfo const & fromUploader)
   do                                                                      \
   {                                                                       \
     /* TODO(mgsergio): machedMwm should be synchronized. */               \
+    if (!MayBeEdited(index))                                              \
+      return nullptr;                                                     \
+                                                                          \
     auto const matchedMwm = m_features.find(mwmId);                       \
     if (matchedMwm == m_features.end())                                   \
       return nullptr;                                                     \
@@ -1130,6 +1186,7 @@ void Editor::UploadNotes(string const & key, string const & secret)
 void Editor::MarkFeatureWithStatus(FeatureID const & fid, FeatureStatus status)
 {
   auto & fti = m_features[fid.m_mwmId][fid.m_index];
+  MarkEditedIndex(fid.m_index);
 
   auto const originalFeaturePtr = GetOriginalFeature(fid);
 
@@ -16,6 +16,7 @@
 
 #include "base/timer.hpp"
 
+#include "std/bitset.hpp"
 #include "std/ctime.hpp"
 #include "std/function.hpp"
 #include "std/map.hpp"
@@ -236,6 +237,15 @@ private:
 
   void MarkFeatureWithStatus(FeatureID const & fid, FeatureStatus status);
 
+  /// Marks |index| in the filter of edited features. Must be called for every feature
+  /// which is put into |m_features|.
+  void MarkEditedIndex(uint32_t index) { m_editedIndices.set(index % kEditedIndicesFilterSize); }
+  /// @returns false if there are no edited features with |index| in any mwm.
+  bool MayBeEdited(uint32_t index) const
+  {
+    return m_editedIndices.test(index % kEditedIndicesFilterSize);
+  }
+
   // These methods are just checked wrappers around Delegate.
   MwmSet::MwmId GetMwmIdByMapName(string const & name);
   unique_ptr<FeatureType> GetOriginalFeature(FeatureID const & fid) const;
@@ -246,6 +256,13 @@ private:
   /// Deleted, edited and created features.
   map<MwmSet::MwmId, map<uint32_t, FeatureTypeInfo>> m_features;
 
+  static size_t constexpr kEditedIndicesFilterSize = 1 << 16;
+  /// Indices of edited features of all mwms modulo filter size. GetFeatureStatus() is called
+  /// for every read feature, and the filter rejects almost all untouched features with
+  /// a single bit test instead of lookups in |m_features|. Bits are never reset on removal
+  /// of a single feature, so a set bit only means that a feature *may* be edited.
+  bitset<kEditedIndicesFilterSize> m_editedIndices;
+
   unique_ptr<Delegate> m_delegate;
 
   /// Invalidate map viewport after edits.
@@ -23,6 +23,7 @@
 #include "base/logging.hpp"
 #include "base/macros.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/exception.hpp"
 #include "std/utility.hpp"
 
@@ -77,6 +78,54 @@ unique_ptr<MappedMemoryRegion> GetMemoryRegionForTag(FilesMappingContainer const
   return make_unique<MappedMemoryRegion>(move(handle));
 }
 
+// A memory region mapped right from the file of a FilesContainerR.
+// Unlike a copied region, its pages are shared between all processes
+// which read the same mwm.
+class FileMappedMemoryRegion : public MemoryRegion
+{
+public:
+  // Returns nullptr when the section can't be mapped, for example,
+  // when the container isn't a plain file.
+  static unique_ptr<FileMappedMemoryRegion> Create(FilesContainerR const & rcont,
+                                                   FilesContainerBase::Tag const & tag)
+  {
+    if (!rcont.IsExist(tag))
+      return unique_ptr<FileMappedMemoryRegion>();
+
+    unique_ptr<FileMappedMemoryRegion> region(new FileMappedMemoryRegion());
+    try
+    {
+      region->m_section = SectionView<uint8_t>::Map(rcont, tag);
+    }
+    catch (Reader::Exception const & e)
+    {
+      LOG(LDEBUG, ("Can't map section", tag, "of", rcont.GetFileName(), e.Msg()));
+      return unique_ptr<FileMappedMemoryRegion>();
+    }
+
+    // Checks that the mapped data is the data of the section.
+    FilesContainerR::TReader reader = rcont.GetReader(tag);
+    uint8_t header[kHeaderSize];
+    size_t const size = static_cast<size_t>(min(reader.Size(), kHeaderSize));
+    reader.Read(0, header, size);
+    if (!equal(header, header + size, region->ImmutableData()))
+      return unique_ptr<FileMappedMemoryRegion>();
+
+    return region;
+  }
+
+  // MemoryRegion overrides:
+  uint64_t Size() const override { return m_section.Size(); }
+  uint8_t const * ImmutableData() const override { return m_section.Data(); }
+
+private:
+  FileMappedMemoryRegion() = default;
+
+  SectionView<uint8_t> m_section;
+
+  DISALLOW_COPY(FileMappedMemoryRegion);
+};
+
 // RankTable version 1, uses simple dense coding to store and access
 // array of ranks.
 class RankTableV0 : public RankTable
@@ -114,8 +163,9 @@ public:
       ReverseFreeze(m_coding, writer, "SimpleDenseCoding");
   }
 
-  // Loads RankTableV0 from a raw memory region.
-  static unique_ptr<RankTableV0> Load(unique_ptr<MappedMemoryRegion> && region)
+  // Loads RankTableV0 from a raw read-only memory region.
+  template <typename TRegion>
+  static unique_ptr<RankTableV0> Load(unique_ptr<TRegion> && region)
   {
     if (!region.get())
       return unique_ptr<RankTableV0>();
@@ -268,6 +318,11 @@ unique_ptr<RankTable> CreateRankTableIfNotExists(FilesContainerR & rcont)
 // static
 unique_ptr<RankTable> RankTable::Load(FilesContainerR const & rcont)
 {
+  // Copies the section only when it can't be mapped, or when it has
+  // the opposite endianness and must be modified.
+  auto table = LoadRankTable(FileMappedMemoryRegion::Create(rcont, RANKS_FILE_TAG));
+  if (table)
+    return table;
   return LoadRankTable(GetMemoryRegionForTag(rcont, RANKS_FILE_TAG));
 }
 
@@ -63,9 +63,11 @@ public:
   // unless you know what you do.
   virtual void Serialize(Writer & writer, bool preserveHostEndianness) = 0;
 
-  // Copies whole section corresponding to a rank table and
-  // deserializes it. Returns nullptr if there're no ranks section or
-  // rank table's header is damaged.
+  // Maps whole section corresponding to a rank table right from the
+  // file of |rcont|, so processes which use the same mwm share the
+  // memory, and deserializes it. The section is copied when it can't
+  // be mapped or has improper endianness. Returns nullptr if there're
+  // no ranks section or rank table's header is damaged.
   //
   // *NOTE* Return value can outlive |rcont|. Also note that there is
   // undefined behaviour if ranks section exists but internally
@@ -6,6 +6,8 @@
 
 #include <algorithm>
 #include <array>
+#include <functional>
+#include <mutex>
 #include <unordered_map>
 #include <utility>
 
@@ -466,51 +468,113 @@ public:
   {
   }
 };
-}  // namespace
-
-namespace ftypes
+// Parses |roadNumber| by the rules of the country |countryName|.
+std::set<RoadShield> ParseRoadShields(std::string const & countryName,
+                                      std::string const & roadNumber)
 {
-std::set<RoadShield> GetRoadShields(FeatureType const & f)
-{
-  std::string const roadNumber = f.GetRoadNumber();
-  if (roadNumber.empty())
-    return std::set<RoadShield>();
-
-  // Find out country name.
-  std::string mwmName = f.GetID().GetMwmName();
-  ASSERT_NOT_EQUAL(mwmName, FeatureID::kInvalidFileName, ());
-  auto const underlinePos = mwmName.find('_');
-  if (underlinePos != std::string::npos)
-    mwmName = mwmName.substr(0, underlinePos);
-
-  if (mwmName == "US")
+  if (countryName == "US")
     return USRoadShieldParser(roadNumber).GetRoadShields();
-  if (mwmName == "UK")
+  if (countryName == "UK")
     return UKRoadShieldParser(roadNumber).GetRoadShields();
-  if (mwmName == "Russia")
+  if (countryName == "Russia")
     return RussiaRoadShieldParser(roadNumber).GetRoadShields();
-  if (mwmName == "France")
+  if (countryName == "France")
     return FranceRoadShieldParser(roadNumber).GetRoadShields();
-  if (mwmName == "Germany")
+  if (countryName == "Germany")
     return GermanyRoadShieldParser(roadNumber).GetRoadShields();
-  if (mwmName == "Spain")
+  if (countryName == "Spain")
     return SpainRoadShieldParser(roadNumber).GetRoadShields();
-  if (mwmName == "Ukraine")
+  if (countryName == "Ukraine")
     return UkraineRoadShieldParser(roadNumber).GetRoadShields();
-  if (mwmName == "Belarus")
+  if (countryName == "Belarus")
     return BelarusRoadShieldParser(roadNumber).GetRoadShields();
-  if (mwmName == "Latvia")
+  if (countryName == "Latvia")
     return LatviaRoadShieldParser(roadNumber).GetRoadShields();
-  if (mwmName == "Netherlands")
+  if (countryName == "Netherlands")
     return NetherlandsRoadShieldParser(roadNumber).GetRoadShields();
-  if (mwmName == "Finland")
+  if (countryName == "Finland")
     return FinlandRoadShieldParser(roadNumber).GetRoadShields();
-  if (mwmName == "Estonia")
+  if (countryName == "Estonia")
     return EstoniaRoadShieldParser(roadNumber).GetRoadShields();
 
   return SimpleRoadShieldParser(roadNumber, SimpleRoadShieldParser::ShieldTypes()).GetRoadShields();
 }
 
+// Parsed shields of road numbers. The same road is drawn in every tile it
+// crosses and the same ref is shared by many features of a road, so most
+// lookups hit the cache. The cache is used by several reading threads.
+class RoadShieldsCache
+{
+public:
+  std::set<RoadShield> Get(std::string const & countryName, std::string const & roadNumber)
+  {
+    Key key(countryName, roadNumber);
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto const it = m_shields.find(key);
+      if (it != m_shields.end())
+        return it->second;
+    }
+
+    // Parsing is done out of the lock, a rare concurrent parsing of the same
+    // road number gives the same result.
+    std::set<RoadShield> shields = ParseRoadShields(countryName, roadNumber);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Road numbers are few compared to features, so the cache is just dropped
+    // when it's full instead of evicting the least recently used entries.
+    if (m_shields.size() >= kMaxCacheSize)
+      m_shields.clear();
+    m_shields.emplace(std::move(key), shields);
+    return shields;
+  }
+
+private:
+  using Key = std::pair<std::string, std::string>;
+
+  struct KeyHash
+  {
+    size_t operator()(Key const & key) const
+    {
+      std::hash<std::string> const hash;
+      return hash(key.first) * 31 ^ hash(key.second);
+    }
+  };
+
+  static size_t constexpr kMaxCacheSize = 10000;
+
+  std::mutex m_mutex;
+  std::unordered_map<Key, std::set<RoadShield>, KeyHash> m_shields;
+};
+
+size_t constexpr RoadShieldsCache::kMaxCacheSize;
+
+RoadShieldsCache g_roadShieldsCache;
+}  // namespace
+
+namespace ftypes
+{
+std::set<RoadShield> GetRoadShields(FeatureType const & f)
+{
+  std::string const roadNumber = f.GetRoadNumber();
+  if (roadNumber.empty())
+    return std::set<RoadShield>();
+
+  std::string const mwmName = f.GetID().GetMwmName();
+  ASSERT_NOT_EQUAL(mwmName, FeatureID::kInvalidFileName, ());
+  return GetRoadShields(mwmName, roadNumber);
+}
+
+std::set<RoadShield> GetRoadShields(std::string const & mwmName, std::string const & roadNumber)
+{
+  if (roadNumber.empty())
+    return std::set<RoadShield>();
+
+  // Find out country name.
+  auto const underlinePos = mwmName.find('_');
+  return g_roadShieldsCache.Get(mwmName.substr(0, underlinePos), roadNumber);
+}
+
 std::string DebugPrint(RoadShieldType shieldType)
 {
   using ftypes::RoadShieldType;
@@ -5,6 +5,7 @@
 #include "geometry/rect2d.hpp"
 
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -52,7 +53,11 @@ struct RoadShield
   }
 };
 
+// Parsed shields are cached by road numbers, so the function is cheap for
+// features which are drawn repeatedly. Thread-safe.
 std::set<RoadShield> GetRoadShields(FeatureType const & f);
+// Returns shields of |roadNumber| of a feature from the mwm |mwmName|.
+std::set<RoadShield> GetRoadShields(std::string const & mwmName, std::string const & roadNumber);
 std::string DebugPrint(RoadShieldType shieldType);
 std::string DebugPrint(RoadShield const & shield);
 }  // namespace ftypes
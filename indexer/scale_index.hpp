@@ -69,6 +69,21 @@ public:
     }
   }
 
+  /// The same as ForEachInIntervalAndScale for every interval, but every
+  /// index is walked only once for all |intervals|.
+  template <typename F>
+  void ForEachInIntervalsAndScale(F const & f, IntervalIndexIFace::IntervalsT const & intervals,
+                                  int scale) const
+  {
+    auto const scaleBucket = BucketByScale(scale);
+    if (scaleBucket < m_IndexForScale.size())
+    {
+      IntervalIndexIFace::FunctionT f1(cref(f));
+      for (size_t i = 0; i <= scaleBucket; ++i)
+        m_IndexForScale[i]->DoForEachInIntervals(f1, intervals);
+    }
+  }
+
 private:
   vector<IntervalIndexIFace *> m_IndexForScale;
 };
@@ -18,8 +18,12 @@
 #include "base/logging.hpp"
 #include "base/macros.hpp"
 #include "base/scope_guard.hpp"
+#include "base/thread.hpp"
 
+#include "std/algorithm.hpp"
+#include "std/atomic.hpp"
 #include "std/string.hpp"
+#include "std/thread.hpp"
 #include "std/type_traits.hpp"
 #include "std/utility.hpp"
 #include "std/vector.hpp"
@@ -40,20 +44,23 @@ public:
     , m_codingDepth(covering::GetCodingDepth(header.GetLastScale()))
     , m_featuresInBucket(featuresInBucket)
     , m_cellsInBucket(cellsInBucket)
+    , m_tasks(kBatchSize)
+    , m_tasksCount(0)
   {
     m_featuresInBucket.resize(m_bucketsCount);
     m_cellsInBucket.resize(m_bucketsCount);
   }
 
+  ~FeatureCoverer() { ASSERT_EQUAL(m_tasksCount, 0, ("Finish() is not called.")); }
+
   template <class TFeature>
-  void operator() (TFeature const & ft, uint32_t index) const
+  void operator() (TFeature const & ft, uint32_t index)
   {
     m_scalesIdx = 0;
     uint32_t const minScaleClassif = min(scales::GetUpperScale(),
                                          feature::GetMinDrawableScaleClassifOnly(ft));
     // The classificator won't allow this feature to be drawable for smaller
     // scales so the first buckets can be safely skipped.
-    // todo(@pimenov) Parallelizing this loop may be helpful.
     for (uint32_t bucket = minScaleClassif; bucket < m_bucketsCount; ++bucket)
     {
       // There is a one-to-one correspondence between buckets and scales.
@@ -65,16 +72,80 @@ public:
         continue;
       }
 
-      vector<int64_t> const cells = covering::CoverFeature(ft, m_codingDepth, 250);
-      m_displacement.Add(cells, bucket, ft, index);
+      // Features are read on this thread only, their geometry is covered by a batch on
+      // all threads.
+      Task & task = m_tasks[m_tasksCount];
+      covering::LoadFeatureGeometry(ft, task.m_isect);
+      task.m_index = index;
+      task.m_bucket = bucket;
 
-      m_featuresInBucket[bucket] += 1;
-      m_cellsInBucket[bucket] += cells.size();
+      // Points are covered by one cell and may be displaced, so the feature is needed for them.
+      if (task.m_isect.m_trg.empty() && task.m_isect.m_polyline.size() == 1)
+      {
+        vector<int64_t> const cells = covering::CoverFeature(task.m_isect, m_codingDepth, 250);
+        m_displacement.Add(cells, bucket, ft, index);
+        AddToStats(bucket, cells.size());
+        break;
+      }
 
+      if (++m_tasksCount == m_tasks.size())
+        CoverTasks();
       break;
     }
   }
 
+  // Covers and passes to the displacement manager the rest of features.
+  void Finish() { CoverTasks(); }
+
+private:
+  static size_t constexpr kBatchSize = 1024;
+
+  struct Task
+  {
+    covering::FeatureIntersector m_isect;
+    vector<int64_t> m_cells;
+    uint32_t m_index = 0;
+    uint32_t m_bucket = 0;
+  };
+
+  void AddToStats(uint32_t bucket, size_t cellsCount)
+  {
+    m_featuresInBucket[bucket] += 1;
+    m_cellsInBucket[bucket] += cellsCount;
+  }
+
+  void CoverTasks()
+  {
+    if (m_tasksCount == 0)
+      return;
+
+    // Features have very different sizes, so tasks are taken one by one.
+    atomic<size_t> nextTask(0);
+    auto const cover = [&]() {
+      for (size_t i = nextTask++; i < m_tasksCount; i = nextTask++)
+        m_tasks[i].m_cells = covering::CoverFeature(m_tasks[i].m_isect, m_codingDepth, 250);
+    };
+
+    size_t const threadsCount =
+        min(static_cast<size_t>(max(thread::hardware_concurrency(), 1u)), m_tasksCount);
+    vector<threads::SimpleThread> threads;
+    threads.reserve(threadsCount - 1);
+    for (size_t i = 1; i < threadsCount; ++i)
+      threads.emplace_back(cover);
+    cover();
+    for (auto & thread : threads)
+      thread.join();
+
+    // Cells are passed in the order of features, though the sorter doesn't depend on it.
+    for (size_t i = 0; i < m_tasksCount; ++i)
+    {
+      Task const & task = m_tasks[i];
+      m_displacement.AddNotDisplaceable(task.m_cells, task.m_bucket, task.m_index);
+      AddToStats(task.m_bucket, task.m_cells.size());
+    }
+    m_tasksCount = 0;
+  }
+
 private:
   // Every feature should be indexed at most once, namely for the smallest possible scale where
   //   -- its geometry is non-empty;
@@ -82,7 +153,7 @@ private:
   //   -- it is allowed by the classificator.
   // If the feature is invisible at all scales, do not index it.
   template <class TFeature>
-  bool FeatureShouldBeIndexed(TFeature const & ft, int scale, bool needReset) const
+  bool FeatureShouldBeIndexed(TFeature const & ft, int scale, bool needReset)
   {
     while (m_scalesIdx < m_header.GetScalesCount() && m_header.GetScale(m_scalesIdx) < scale)
     {
@@ -111,13 +182,17 @@ private:
   // and then only move forward. Its purpose is to detect the moments when we
   // need to reread the feature's geometry.
   feature::DataHeader const & m_header;
-  mutable size_t m_scalesIdx;
+  size_t m_scalesIdx;
 
   uint32_t m_bucketsCount;
   TDisplacementManager & m_displacement;
   int m_codingDepth;
   vector<uint32_t> & m_featuresInBucket;
   vector<uint32_t> & m_cellsInBucket;
+
+  // Tasks are reused by batches, so geometry buffers are not reallocated for every feature.
+  vector<Task> m_tasks;
+  size_t m_tasksCount;
 };
 
 template <class SinkT>
@@ -162,8 +237,9 @@ void IndexScales(feature::DataHeader const & header, TFeaturesVector const & fea
     TDisplacementManager manager(sorter);
     vector<uint32_t> featuresInBucket(bucketsCount);
     vector<uint32_t> cellsInBucket(bucketsCount);
-    features.ForEach(
-        FeatureCoverer<TDisplacementManager>(header, manager, featuresInBucket, cellsInBucket));
+    FeatureCoverer<TDisplacementManager> coverer(header, manager, featuresInBucket, cellsInBucket);
+    features.ForEach(coverer);
+    coverer.Finish();
     manager.Displace();
     sorter.SortAndFinish();
 
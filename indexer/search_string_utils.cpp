@@ -5,6 +5,11 @@
 #include "base/macros.hpp"
 #include "base/mem_trie.hpp"
 
+#include "std/array.hpp"
+#include "std/iterator.hpp"
+
+#include "3party/utfcpp/source/utf8/unchecked.h"
+
 using namespace std;
 using namespace strings;
 
@@ -36,14 +41,14 @@ void RemoveNumeroSigns(UniString & s)
     i = j;
   }
 }
-}  // namespace
 
-UniString NormalizeAndSimplifyString(string const & s)
+// Applies all transformations of NormalizeAndSimplifyString() which
+// depend on a single char only, i.e. all of them but RemoveNumeroSigns().
+void FoldChars(UniString & s)
 {
-  UniString uniString = MakeUniString(s);
-  for (size_t i = 0; i < uniString.size(); ++i)
+  for (size_t i = 0; i < s.size(); ++i)
   {
-    UniChar & c = uniString[i];
+    UniChar & c = s[i];
     switch (c)
     {
     // Replace "d with stroke" to simple d letter. Used in Vietnamese.
@@ -72,12 +77,12 @@ UniString NormalizeAndSimplifyString(string const & s)
     case 0x0152:  // Œ
     case 0x0153:  // œ
       c = 'o';
-      uniString.insert(uniString.begin() + (i++) + 1, 'e');
+      s.insert(s.begin() + (i++) + 1, 'e');
       break;
     case 0x00c6:  // Æ
     case 0x00e6:  // æ
       c = 'a';
-      uniString.insert(uniString.begin() + (i++) + 1, 'e');
+      s.insert(s.begin() + (i++) + 1, 'e');
       break;
     case 0x2116:  // №
       c = '#';
@@ -85,19 +90,110 @@ UniString NormalizeAndSimplifyString(string const & s)
     }
   }
 
-  MakeLowerCaseInplace(uniString);
-  NormalizeInplace(uniString);
+  MakeLowerCaseInplace(s);
+  NormalizeInplace(s);
 
   // Remove accents that can appear after NFKD normalization.
-  uniString.erase_if([](UniChar const & c) {
+  s.erase_if([](UniChar const & c) {
     // ̀  COMBINING GRAVE ACCENT
     // ́  COMBINING ACUTE ACCENT
     return (c == 0x0300 || c == 0x0301);
   });
+}
+
+size_t constexpr kMaxLatin1FoldSize = 4;
+
+// Folded forms of all chars less than 0x100, they are computed by
+// FoldChars() once, so Latin strings are folded by table lookups.
+class Latin1Folds
+{
+public:
+  struct Fold
+  {
+    UniChar m_chars[kMaxLatin1FoldSize];
+    uint8_t m_size = 0;
+  };
+
+  Latin1Folds()
+  {
+    // Zero char is not supported by MakeLowerCaseInplace(), it's kept as is.
+    m_folds[0].m_chars[0] = 0;
+    m_folds[0].m_size = 1;
+
+    for (UniChar c = 1; c < m_folds.size(); ++c)
+    {
+      UniString s(1, c);
+      FoldChars(s);
+      CHECK_LESS_OR_EQUAL(s.size(), kMaxLatin1FoldSize, (c));
+
+      auto & fold = m_folds[c];
+      fold.m_size = static_cast<uint8_t>(s.size());
+      copy(s.begin(), s.end(), fold.m_chars);
+    }
+  }
+
+  static Latin1Folds const & Instance()
+  {
+    static Latin1Folds const folds;
+    return folds;
+  }
+
+  Fold const & operator[](UniChar c) const { return m_folds[c]; }
+
+private:
+  array<Fold, 0x100> m_folds;
+};
+
+// Decodes and folds |s| if all its chars are less than 0x100, i.e. are
+// encoded by one byte or by two bytes with 0xC2 or 0xC3 lead byte.
+// Returns false otherwise, |result| is undefined in this case.
+bool FoldLatin1(string const & s, UniString & result)
+{
+  auto const & folds = Latin1Folds::Instance();
+
+  size_t const n = s.size();
+  for (size_t i = 0; i < n; ++i)
+  {
+    UniChar c = static_cast<uint8_t>(s[i]);
+    if (c >= 0x80)
+    {
+      if ((c != 0xC2 && c != 0xC3) || i + 1 == n)
+        return false;
+
+      auto const t = static_cast<uint8_t>(s[++i]);
+      if ((t & 0xC0) != 0x80)
+        return false;
+      c = ((c & 0x1F) << 6) | (t & 0x3F);
+    }
 
-  RemoveNumeroSigns(uniString);
+    auto const & fold = folds[c];
+    if (fold.m_size == 1)
+      result.push_back(fold.m_chars[0]);
+    else
+      result.append(fold.m_chars, fold.m_chars + fold.m_size);
+  }
+  return true;
+}
+}  // namespace
+
+UniString NormalizeAndSimplifyString(string const & s)
+{
+  UniString result;
+  NormalizeAndSimplifyString(s, result);
+  return result;
+}
+
+void NormalizeAndSimplifyString(string const & s, UniString & result)
+{
+  result.clear();
+  if (!FoldLatin1(s, result))
+  {
+    result.clear();
+    utf8::unchecked::utf8to32(s.begin(), s.end(), back_inserter(result));
+    FoldChars(result);
+  }
 
-  return uniString;
+  RemoveNumeroSigns(result);
 
   /// @todo Restore this logic to distinguish и-й in future.
   /*
@@ -16,6 +16,9 @@ namespace search
 // This function should be used for all search strings normalization.
 // It does some magic text transformation which greatly helps us to improve our search.
 strings::UniString NormalizeAndSimplifyString(std::string const & s);
+// The same as above, but reuses the buffer of |result|. Strings of
+// Latin-1 chars only are processed by a fast table-driven path.
+void NormalizeAndSimplifyString(std::string const & s, strings::UniString & result);
 
 template <class Delims, typename Fn>
 void SplitUniString(strings::UniString const & uniS, Fn f, Delims const & delims)
@@ -9,6 +9,7 @@
 #include "base/logging.hpp"
 
 #include "std/algorithm.hpp"
+#include "std/iterator.hpp"
 #include "std/vector.hpp"
 #include "std/utility.hpp"
 
@@ -231,10 +232,14 @@ void AppendValue(TNodeInfo & node, TValue const & value)
     LOG(LERROR, ("Cannot append to a finalized value list."));
 }
 
-template <typename TSink, typename TKey, typename TValueList, typename TSerializer>
-void Build(TSink & sink, TSerializer const & serializer,
-           vector<pair<TKey, typename TValueList::TValue>> const & data)
+// Writes all the nodes of the trie for the sorted range [beg, end) except the root and returns
+// the root. Sizes of children are relative, so the subtries of keys which start with different
+// chars may be written independently and joined by WriteRoot().
+template <typename TSink, typename TValueList, typename TSerializer, typename TIter>
+NodeInfo<TValueList> WriteNodesExceptRoot(TSink & sink, TSerializer const & serializer,
+                                          TIter const beg, TIter const end)
 {
+  using TKey = typename iterator_traits<TIter>::value_type::first_type;
   using TValue = typename TValueList::TValue;
   using TNodeInfo = NodeInfo<TValueList>;
 
@@ -244,10 +249,10 @@ void Build(TSink & sink, TSerializer const & serializer,
   TKey prevKey;
   pair<TKey, TValue> prevE;  // e for "element".
 
-  for (auto it = data.begin(); it != data.end(); ++it)
+  for (auto it = beg; it != end; ++it)
   {
     auto e = *it;
-    if (it != data.begin() && e == prevE)
+    if (it != beg && e == prevE)
       continue;
 
     auto const & key = e.first;
@@ -269,9 +274,36 @@ void Build(TSink & sink, TSerializer const & serializer,
 
   // Pop all the nodes from the stack.
   PopNodes(sink, serializer, nodes, nodes.size() - 1);
+  return move(nodes.back());
+}
+
+// Writes the root which joins |roots| of subtries. Nodes of the subtries must be already written
+// to |sink| one after another in the order of |roots|, and keys of every next subtrie must
+// be greater than keys of the previous ones.
+template <typename TSink, typename TValueList, typename TSerializer>
+void WriteRoot(TSink & sink, TSerializer const & serializer,
+               vector<NodeInfo<TValueList>> const & roots)
+{
+  NodeInfo<TValueList> root(sink.Pos(), kDefaultChar);
+  for (auto const & subtrieRoot : roots)
+  {
+    for (auto const & value : subtrieRoot.m_temporaryValueList)
+      AppendValue(root, value);
+    root.m_children.insert(root.m_children.end(), subtrieRoot.m_children.begin(),
+                           subtrieRoot.m_children.end());
+  }
+
+  WriteNodeReverse(sink, serializer, kDefaultChar /* baseChar */, root, true /* isRoot */);
+}
+
+template <typename TSink, typename TKey, typename TValueList, typename TSerializer>
+void Build(TSink & sink, TSerializer const & serializer,
+           vector<pair<TKey, typename TValueList::TValue>> const & data)
+{
+  auto root = WriteNodesExceptRoot<TSink, TValueList>(sink, serializer, data.begin(), data.end());
 
   // Write the root.
-  WriteNodeReverse(sink, serializer, kDefaultChar /* baseChar */, nodes.back(), true /* isRoot */);
+  WriteNodeReverse(sink, serializer, kDefaultChar /* baseChar */, root, true /* isRoot */);
 }
 
 }  // namespace trie
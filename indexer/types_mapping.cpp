@@ -34,6 +34,13 @@ void IndexAndTypeMapping::Load(istream & s)
   }
 }
 
+void IndexAndTypeMapping::Load(vector<uint32_t> const & types)
+{
+  Clear();
+  for (uint32_t ind = 0; ind < types.size(); ++ind)
+    Add(ind, types[ind]);
+}
+
 void IndexAndTypeMapping::Add(uint32_t ind, uint32_t type)
 {
   ASSERT_EQUAL ( ind, m_types.size(), () );
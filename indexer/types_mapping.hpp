@@ -18,6 +18,10 @@ class IndexAndTypeMapping
 public:
   void Clear();
   void Load(istream & s);
+  /// Loads mapping from types in order of indices.
+  void Load(vector<uint32_t> const & types);
+
+  vector<uint32_t> const & GetTypes() const { return m_types; }
 
   uint32_t GetType(uint32_t ind) const
   {
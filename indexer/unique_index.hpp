@@ -1,7 +1,9 @@
 #pragma once
 
+#include "base/assert.hpp"
 #include "base/base.hpp"
 
+#include "std/atomic.hpp"
 #include "std/unordered_set.hpp"
 #include "std/vector.hpp"
 
@@ -51,3 +53,22 @@ public:
     return Add(index);
   }
 };
+
+// Thread-safe version of CheckUniqueIndexes for indices less than
+// |numIndices|.
+class ConcurrentCheckUniqueIndexes
+{
+  vector<atomic<bool>> m_v;
+
+public:
+  explicit ConcurrentCheckUniqueIndexes(size_t numIndices) : m_v(numIndices) {}
+
+  /// @return true If index was absent.
+  bool operator()(uint32_t index)
+  {
+    ASSERT_LESS(index, m_v.size(), ());
+    if (index >= m_v.size())
+      return false;
+    return !m_v[index].exchange(true);
+  }
+};
@@ -32,6 +32,10 @@ uint64_t constexpr kMaxFilesSizeInBytes = 10 * 1024 * 1024;
 float const kEventsDisposingRate = 0.2f;
 
 auto constexpr kSendingTimeout = std::chrono::hours(1);
+// Events are flushed to files in batches, when there are enough of them
+// or periodically, so the background thread doesn't write on every event.
+size_t constexpr kMaxEventsInMemory = 512;
+auto constexpr kFlushingPeriod = std::chrono::seconds(30);
 int64_t constexpr kEventMaxLifetimeInSeconds = 24 * 183 * 3600;  // About half of year.
 auto constexpr kDeletionPeriod = std::chrono::hours(24);
 
@@ -192,20 +196,20 @@ bool Statistics::RequestEvents(std::list<Event> & events, bool & needToSend)
 {
   std::unique_lock<std::mutex> lock(m_mutex);
 
-  bool const isTimeout = !m_condition.wait_for(lock, kSendingTimeout, [this]
+  m_condition.wait_for(lock, kFlushingPeriod, [this]
   {
-    return !m_isRunning || !m_events.empty();
+    return !m_isRunning || m_events.size() >= kMaxEventsInMemory;
   });
 
+  // Events which are registered before the teardown are flushed anyway.
+  events = std::move(m_events);
+  m_events.clear();
+
   if (!m_isRunning)
     return false;
 
-  using namespace std::chrono;
-  needToSend = m_isFirstSending || isTimeout ||
+  needToSend = m_isFirstSending ||
     (std::chrono::steady_clock::now() > (m_lastSending + kSendingTimeout));
-
-  events = std::move(m_events);
-  m_events.clear();
   return true;
 }
 
@@ -215,7 +219,8 @@ void Statistics::RegisterEvent(Event && event)
   if (!m_isRunning)
     return;
   m_events.push_back(std::move(event));
-  m_condition.notify_one();
+  if (m_events.size() >= kMaxEventsInMemory)
+    m_condition.notify_one();
 }
 
 void Statistics::RegisterEvents(std::list<Event> && events)
@@ -224,7 +229,8 @@ void Statistics::RegisterEvents(std::list<Event> && events)
   if (!m_isRunning)
     return;
   m_events.splice(m_events.end(), std::move(events));
-  m_condition.notify_one();
+  if (m_events.size() >= kMaxEventsInMemory)
+    m_condition.notify_one();
 }
 
 void Statistics::ThreadRoutine()
@@ -233,13 +239,19 @@ void Statistics::ThreadRoutine()
   bool needToSend = false;
   while (RequestEvents(events, needToSend))
   {
-    ProcessEvents(events);
-    events.clear();
+    if (!events.empty())
+    {
+      ProcessEvents(events);
+      events.clear();
+    }
 
     // Send statistics to server.
     if (needToSend)
       SendToServer();
   }
+
+  if (!events.empty())
+    ProcessEvents(events);
 }
 
 std::list<Event> Statistics::WriteEvents(std::list<Event> & events, std::string & fileNameToRebuild)
@@ -247,8 +259,15 @@ std::list<Event> Statistics::WriteEvents(std::list<Event> & events, std::string
   try
   {
     CreateDirIfNotExist();
-    if (m_metadataCache.empty())
+
+    // The directory is scanned once, then the cache is kept up to date
+    // by writing, rebuilding and sending of files.
+    if (!m_isMetadataIndexed)
+    {
+      // The flag is set before indexing, as BalanceMemory() writes events too.
+      m_isMetadataIndexed = true;
       IndexMetadata();
+    }
 
     std::unique_ptr<FileWriter> writer;
 
@@ -554,6 +573,8 @@ void Statistics::CleanupAfterTesting()
   std::string const statsFolder = StatisticsFolder();
   if (GetPlatform().IsFileExistsByFullPath(statsFolder))
     GetPlatform().RmDirRecursively(statsFolder);
+  m_metadataCache.clear();
+  m_isMetadataIndexed = false;
 }
 
 void Statistics::SetCustomServerSerializer(ServerSerializer && serializer)
@@ -79,6 +79,7 @@ private:
     }
   };
   std::map<MetadataKey, Metadata> m_metadataCache;
+  bool m_isMetadataIndexed = false;
   std::chrono::steady_clock::time_point m_lastSending;
   bool m_isFirstSending = true;
 
@@ -0,0 +1,257 @@
+#include "map/batch_service.hpp"
+
+#include "map/routing_helpers.hpp"
+
+#include "routing/checkpoints.hpp"
+#include "routing/index_router.hpp"
+#include "routing/num_mwm_id.hpp"
+#include "routing/route.hpp"
+#include "routing/router_delegate.hpp"
+
+#include "search/engine.hpp"
+#include "search/processor_factory.hpp"
+
+#include "indexer/categories_holder.hpp"
+#include "indexer/classificator_loader.hpp"
+
+#include "platform/local_country_file.hpp"
+#include "platform/local_country_file_utils.hpp"
+#include "platform/platform.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+#include "base/stl_add.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <limits>
+#include <map>
+#include <utility>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+BatchService::RouteResult CalculateRoute(IndexRouter & router,
+                                         BatchService::RouteRequest const & request,
+                                         uint32_t timeoutSec)
+{
+  BatchService::RouteResult result;
+  if (request.m_checkpoints.size() < 2)
+  {
+    result.m_code = IRouter::NoCurrentPosition;
+    return result;
+  }
+
+  RouterDelegate delegate;
+  delegate.SetTimeout(timeoutSec);
+
+  Route route(router.GetName());
+  result.m_code = router.CalculateRoute(Checkpoints(vector<m2::PointD>(request.m_checkpoints)),
+                                        m2::PointD::Zero() /* startDirection */,
+                                        false /* adjustToPrevRoute */, delegate, route);
+  if (result.m_code != IRouter::NoError)
+    return result;
+
+  result.m_distanceMeters = route.GetTotalDistanceMeters();
+  result.m_etaSeconds = route.GetTotalTimeSec();
+  result.m_polyline = route.GetPoly().GetPoints();
+  return result;
+}
+}  // namespace
+
+struct BatchService::RouteBatch
+{
+  RouteBatch(vector<RouteRequest> && requests, RouteResultsFn const & fn)
+    : m_requests(move(requests)), m_results(m_requests.size()), m_remaining(m_requests.size()),
+      m_fn(fn)
+  {
+  }
+
+  vector<RouteRequest> const m_requests;
+  // Every result is written by one thread only, the last thread passes all of them to |m_fn|.
+  vector<RouteResult> m_results;
+  atomic<size_t> m_remaining;
+  RouteResultsFn const m_fn;
+};
+
+BatchService::BatchService(Params const & params)
+  : m_infoGetter(storage::CountryInfoReader::CreateCountryInfoReader(GetPlatform()))
+  , m_numMwmIds(make_shared<NumMwmIds>())
+  , m_roadJunctionsCache(make_shared<RoadJunctionsCache>(params.m_roadJunctionsCacheBytes))
+  , m_routingTimeoutSec(params.m_routingTimeoutSec)
+{
+  classificator::Load();
+
+  vector<platform::LocalCountryFile> localFiles;
+  platform::FindAllLocalMapsAndCleanup(numeric_limits<int64_t>::max() /* the latest version */,
+                                       localFiles);
+  for (auto & localFile : localFiles)
+  {
+    localFile.SyncWithDisk();
+    auto const result = m_index.RegisterMap(localFile);
+    if (result.second != MwmSet::RegResult::Success)
+    {
+      LOG(LWARNING, ("Can't register", localFile, "result:", result.second));
+      continue;
+    }
+
+    if (result.first.GetInfo()->GetType() == MwmInfo::COUNTRY)
+      m_numMwmIds->RegisterFile(localFile.GetCountryFile());
+  }
+
+  search::Engine::Params searchParams(params.m_locale, max(params.m_numSearchThreads,
+                                                           static_cast<size_t>(1)));
+  m_searchEngine = my::make_unique<search::Engine>(m_index, GetDefaultCategories(), *m_infoGetter,
+                                                   my::make_unique<search::ProcessorFactory>(),
+                                                   searchParams);
+
+  size_t const numRoutingThreads = max(params.m_numRoutingThreads, static_cast<size_t>(1));
+  for (size_t i = 0; i < numRoutingThreads; ++i)
+    m_routingThreads.emplace_back(&BatchService::RoutingLoop, this);
+}
+
+BatchService::~BatchService()
+{
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_shutdown = true;
+    m_cv.notify_all();
+  }
+
+  for (auto & thread : m_routingThreads)
+    thread.join();
+
+  // Search threads are stopped before the index is destroyed.
+  m_searchEngine.reset();
+}
+
+void BatchService::Route(vector<RouteRequest> && requests, RouteResultsFn const & fn)
+{
+  if (requests.empty())
+  {
+    fn({});
+    return;
+  }
+
+  auto batch = make_shared<RouteBatch>(move(requests), fn);
+  lock_guard<mutex> lock(m_mutex);
+  for (size_t i = 0; i < batch->m_requests.size(); ++i)
+  {
+    RouteTask task;
+    task.m_batch = batch;
+    task.m_index = i;
+    m_routeTasks.push(move(task));
+  }
+  m_cv.notify_all();
+}
+
+void BatchService::Search(vector<SearchRequest> && requests, SearchResultsFn const & fn)
+{
+  if (requests.empty())
+  {
+    fn({});
+    return;
+  }
+
+  struct SearchBatch
+  {
+    SearchBatch(size_t size, SearchResultsFn const & fn)
+      : m_results(size), m_remaining(size), m_fn(fn)
+    {
+    }
+
+    vector<search::Results> m_results;
+    atomic<size_t> m_remaining;
+    SearchResultsFn const m_fn;
+  };
+
+  auto batch = make_shared<SearchBatch>(requests.size(), fn);
+  for (size_t i = 0; i < requests.size(); ++i)
+  {
+    search::SearchParams & params = requests[i].m_params;
+    params.m_onStarted = nullptr;
+    params.m_onResults = [batch, i](search::Results const & results) {
+      if (!results.IsEndMarker())
+        return;
+
+      batch->m_results[i] = results;
+      if (--batch->m_remaining == 0)
+        batch->m_fn(move(batch->m_results));
+    };
+    m_searchEngine->Search(params, requests[i].m_viewport);
+  }
+}
+
+vector<BatchService::RouteResult> BatchService::RouteSync(vector<RouteRequest> && requests)
+{
+  auto promise = make_shared<std::promise<vector<RouteResult>>>();
+  auto future = promise->get_future();
+  Route(move(requests),
+        [promise](vector<RouteResult> && results) { promise->set_value(move(results)); });
+  return future.get();
+}
+
+vector<search::Results> BatchService::SearchSync(vector<SearchRequest> && requests)
+{
+  auto promise = make_shared<std::promise<vector<search::Results>>>();
+  auto future = promise->get_future();
+  Search(move(requests),
+         [promise](vector<search::Results> && results) { promise->set_value(move(results)); });
+  return future.get();
+}
+
+void BatchService::RoutingLoop()
+{
+  auto const countryFileGetter = [this](m2::PointD const & pt) {
+    return m_infoGetter->GetRegionCountryId(pt);
+  };
+  auto const getMwmRectByName = [this](string const & countryId) {
+    return m_infoGetter->GetLimitRectForLeaf(countryId);
+  };
+
+  // Routers are created on demand and are used by this thread only.
+  map<VehicleType, unique_ptr<IndexRouter>> routers;
+
+  while (true)
+  {
+    RouteTask task;
+    {
+      unique_lock<mutex> lock(m_mutex);
+      m_cv.wait(lock, [this]() { return m_shutdown || !m_routeTasks.empty(); });
+      if (m_shutdown)
+        break;
+
+      task = move(m_routeTasks.front());
+      m_routeTasks.pop();
+    }
+
+    RouteBatch & batch = *task.m_batch;
+    RouteRequest const & request = batch.m_requests[task.m_index];
+
+    auto & router = routers[request.m_vehicleType];
+    if (!router)
+    {
+      router = my::make_unique<IndexRouter>(
+          request.m_vehicleType, false /* loadAltitudes */, CountryParentNameGetterFn(),
+          countryFileGetter, getMwmRectByName, m_numMwmIds,
+          MakeNumMwmTree(*m_numMwmIds, *m_infoGetter), m_trafficCache, m_index);
+      router->SetRoadJunctionsCache(m_roadJunctionsCache);
+    }
+
+    try
+    {
+      batch.m_results[task.m_index] = CalculateRoute(*router, request, m_routingTimeoutSec);
+    }
+    catch (RootException const & e)
+    {
+      LOG(LERROR, ("Can't calculate route:", e.what()));
+      batch.m_results[task.m_index].m_code = IRouter::InternalError;
+    }
+
+    if (--batch.m_remaining == 0)
+      batch.m_fn(move(batch.m_results));
+  }
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "routing/road_junctions_cache.hpp"
+#include "routing/router.hpp"
+#include "routing/vehicle_mask.hpp"
+
+#include "search/result.hpp"
+#include "search/search_params.hpp"
+
+#include "storage/country_info_getter.hpp"
+
+#include "indexer/index.hpp"
+
+#include "traffic/traffic_cache.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include "base/macros.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace routing
+{
+class NumMwmIds;
+}  // namespace routing
+
+namespace search
+{
+class Engine;
+}  // namespace search
+
+// Headless facade over Index, IndexRouter and search::Engine for bulk routing and search,
+// e.g. on servers. Unlike Framework it needs neither a GUI thread nor a drape engine:
+// requests are processed on worker threads and callbacks are called on these threads.
+//
+// All workers share the Index with its cache of mwm handles, the country info getter and
+// mwm ids. Every routing thread keeps an IndexRouter per vehicle type, so caches of road
+// graphs are reused by the following requests of the thread. Road geometry is shared by
+// routers of all threads and vehicle types.
+//
+// NOTE: this class is thread-safe.
+class BatchService final
+{
+public:
+  struct Params
+  {
+    std::string m_locale = "en";
+    size_t m_numRoutingThreads = 1;
+    size_t m_numSearchThreads = 1;
+    // Routing requests are cancelled after the timeout, 0 means an infinite timeout.
+    uint32_t m_routingTimeoutSec = 0;
+    // Memory budget for road geometry shared by all routers.
+    size_t m_roadJunctionsCacheBytes = 256 * 1024 * 1024;
+  };
+
+  struct RouteRequest
+  {
+    routing::VehicleType m_vehicleType = routing::VehicleType::Car;
+    // Mercator points of start, intermediate points and finish.
+    std::vector<m2::PointD> m_checkpoints;
+  };
+
+  struct RouteResult
+  {
+    routing::IRouter::ResultCode m_code = routing::IRouter::InternalError;
+    double m_distanceMeters = 0.0;
+    double m_etaSeconds = 0.0;
+    std::vector<m2::PointD> m_polyline;
+  };
+
+  struct SearchRequest
+  {
+    // |m_onStarted| and |m_onResults| are replaced by the service.
+    search::SearchParams m_params;
+    m2::RectD m_viewport;
+  };
+
+  using RouteResultsFn = std::function<void(std::vector<RouteResult> && results)>;
+  using SearchResultsFn = std::function<void(std::vector<search::Results> && results)>;
+
+  // Registers the latest versions of maps which are found in the writable directory.
+  explicit BatchService(Params const & params);
+  // Routing requests which are not started yet are dropped, their callbacks are not called.
+  ~BatchService();
+
+  // Posts |requests| to routing threads. |fn| is called once, when all requests are processed,
+  // with results in the order of requests. It's called on one of routing threads.
+  void Route(std::vector<RouteRequest> && requests, RouteResultsFn const & fn);
+
+  // Posts |requests| to the search engine. |fn| is called once with final results of all
+  // requests in their order. It's called on one of search threads.
+  void Search(std::vector<SearchRequest> && requests, SearchResultsFn const & fn);
+
+  // Blocking versions of Route and Search.
+  std::vector<RouteResult> RouteSync(std::vector<RouteRequest> && requests);
+  std::vector<search::Results> SearchSync(std::vector<SearchRequest> && requests);
+
+  Index const & GetIndex() const { return m_index; }
+
+private:
+  struct RouteBatch;
+
+  struct RouteTask
+  {
+    std::shared_ptr<RouteBatch> m_batch;
+    size_t m_index = 0;
+  };
+
+  void RoutingLoop();
+
+  Index m_index;
+  std::unique_ptr<storage::CountryInfoGetter> m_infoGetter;
+  std::shared_ptr<routing::NumMwmIds> m_numMwmIds;
+  traffic::TrafficCache const m_trafficCache;
+  std::shared_ptr<routing::RoadJunctionsCache> m_roadJunctionsCache;
+  std::unique_ptr<search::Engine> m_searchEngine;
+  uint32_t const m_routingTimeoutSec;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::queue<RouteTask> m_routeTasks;
+  bool m_shutdown = false;
+  std::vector<std::thread> m_routingThreads;
+
+  DISALLOW_COPY_AND_MOVE(BatchService);
+};
@@ -1,10 +1,12 @@
 #include "map/benchmark_tool/api.hpp"
 
 #include "std/iostream.hpp"
+#include "std/fstream.hpp"
 #include "std/numeric.hpp"
 #include "std/algorithm.hpp"
 #include "std/iomanip.hpp"
 #include "std/iterator.hpp"
+#include "std/sstream.hpp"
 
 
 namespace bench
@@ -54,4 +56,60 @@ void AllResult::Print()
   }
 }
 
+map<string, double> Report::GetMedians() const
+{
+  map<string, double> medians;
+  for (auto const & c : m_times)
+  {
+    vector<double> times = c.second;
+    sort(times.begin(), times.end());
+    medians[c.first] = times[times.size() / 2];
+  }
+  return medians;
+}
+
+void Report::Save(ostream & os) const
+{
+  os << fixed << setprecision(6);
+  for (auto const & c : m_times)
+  {
+    vector<double> times = c.second;
+    sort(times.begin(), times.end());
+    os << c.first << '\t' << times[times.size() / 2] << '\t' << times.front() << '\t'
+       << times.back() << '\t' << times.size() << endl;
+  }
+}
+
+bool LoadBaseline(string const & path, map<string, double> & medians)
+{
+  ifstream is(path);
+  if (!is)
+    return false;
+
+  string line;
+  while (getline(is, line))
+  {
+    istringstream ss(line);
+    string name;
+    double median;
+    if (!(ss >> name >> median))
+      return false;
+    medians[name] = median;
+  }
+  return true;
+}
+
+vector<string> FindRegressions(map<string, double> const & baseline, Report const & report,
+                               double threshold)
+{
+  vector<string> regressions;
+  for (auto const & c : report.GetMedians())
+  {
+    auto const it = baseline.find(c.first);
+    if (it != baseline.end() && c.second > it->second * (1.0 + threshold))
+      regressions.push_back(c.first);
+  }
+  return regressions;
+}
+
 }
@@ -1,9 +1,18 @@
 #pragma once
 
+#include "std/iostream.hpp"
+#include "std/map.hpp"
+#include "std/shared_ptr.hpp"
 #include "std/vector.hpp"
 #include "std/string.hpp"
 #include "std/utility.hpp"
 
+class MwmInfo;
+
+namespace model
+{
+class FeaturesFetcher;
+}
 
 namespace bench
 {
@@ -43,4 +52,49 @@ namespace bench
 
   /// @param[in] count number of times to run benchmark
   void RunFeaturesLoadingBenchmark(string const & file, pair<int, int> scaleR, AllResult & res);
+
+  struct Params
+  {
+    /// Runs which are not measured, to warm up disk and memory caches.
+    size_t m_warmUpRuns = 1;
+    size_t m_runs = 5;
+  };
+
+  /// Times of all measured runs of benchmark cases.
+  class Report
+  {
+  public:
+    void Add(string const & name, double seconds) { m_times[name].push_back(seconds); }
+
+    /// @returns medians of times of all cases.
+    map<string, double> GetMedians() const;
+
+    /// Writes a tab-separated line "name median min max runs" in seconds for every case.
+    /// The output can be read by LoadBaseline().
+    void Save(ostream & os) const;
+
+  private:
+    map<string, vector<double>> m_times;
+  };
+
+  /// Registers mwm |file| in |src|.
+  /// @returns info of the registered mwm or nullptr.
+  shared_ptr<MwmInfo> RegisterMap(string const & file, model::FeaturesFetcher & src);
+
+  /// Reads medians of cases saved by Report::Save().
+  bool LoadBaseline(string const & path, map<string, double> & medians);
+
+  /// @returns names of cases whose medians are greater than ones of |baseline| by more than
+  /// |threshold| (0.1 means 10%). Cases absent in |baseline| are ignored.
+  vector<string> FindRegressions(map<string, double> const & baseline, Report const & report,
+                                 double threshold);
+
+  /// Measures Index::ForEachInRect and decoding of geometry of read features separately
+  /// for every scale of |scaleR|, the whole mwm is covered by rects of a scale in every run.
+  void RunScalesBenchmark(string const & file, pair<int, int> scaleR, Params const & params,
+                          Report & report);
+
+  /// Measures reverse geocoding of |pointsCount| pseudo-random points of the mwm.
+  void RunReverseGeocodingBenchmark(string const & file, size_t pointsCount,
+                                    Params const & params, Report & report);
 }
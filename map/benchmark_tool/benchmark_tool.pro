@@ -7,7 +7,7 @@ TEMPLATE = app
 
 ROOT_DIR = ../..
 
-DEPENDENCIES = map ugc indexer platform editor geometry coding base gflags protobuf succinct pugixml stats_client icu agg
+DEPENDENCIES = map ugc search indexer platform editor geometry coding base gflags protobuf succinct pugixml stats_client icu agg
 
 include($$ROOT_DIR/common.pri)
 
@@ -27,6 +27,7 @@ SOURCES += \
     features_loading.cpp \
     main.cpp \
     api.cpp \
+    reverse_geocoding.cpp \
 
 HEADERS += \
     api.hpp \
@@ -10,6 +10,7 @@
 #include "coding/file_name_utils.hpp"
 
 #include "base/macros.hpp"
+#include "base/string_utils.hpp"
 #include "base/timer.hpp"
 
 
@@ -57,6 +58,14 @@ namespace
     }
   };
 
+  void ClampScaleRange(MwmInfo const & info, pair<int, int> & scaleRange)
+  {
+    if (info.m_minScale > scaleRange.first)
+      scaleRange.first = info.m_minScale;
+    if (info.m_maxScale < scaleRange.second)
+      scaleRange.second = info.m_maxScale;
+  }
+
   void RunBenchmark(model::FeaturesFetcher const & src, m2::RectD const & rect,
                     pair<int, int> const & scaleRange, AllResult & res)
   {
@@ -96,7 +105,7 @@ namespace
   }
 }
 
-void RunFeaturesLoadingBenchmark(string const & file, pair<int, int> scaleRange, AllResult & res)
+shared_ptr<MwmInfo> RegisterMap(string const & file, model::FeaturesFetcher & src)
 {
   string fileName = file;
   my::GetNameFromFullPath(fileName);
@@ -105,22 +114,51 @@ void RunFeaturesLoadingBenchmark(string const & file, pair<int, int> scaleRange,
   platform::LocalCountryFile localFile =
       platform::LocalCountryFile::MakeForTesting(fileName);
 
-  model::FeaturesFetcher src;
   auto const r = src.RegisterMap(localFile);
   if (r.second != MwmSet::RegResult::Success)
-    return;
+    return nullptr;
+  return r.first.GetInfo();
+}
 
-  uint8_t const minScale = r.first.GetInfo()->m_minScale;
-  uint8_t const maxScale = r.first.GetInfo()->m_maxScale;
-  if (minScale > scaleRange.first)
-    scaleRange.first = minScale;
-  if (maxScale < scaleRange.second)
-    scaleRange.second = maxScale;
+void RunFeaturesLoadingBenchmark(string const & file, pair<int, int> scaleRange, AllResult & res)
+{
+  model::FeaturesFetcher src;
+  auto const info = RegisterMap(file, src);
+  if (!info)
+    return;
 
+  ClampScaleRange(*info, scaleRange);
   if (scaleRange.first > scaleRange.second)
     return;
 
-  RunBenchmark(src, r.first.GetInfo()->m_limitRect, scaleRange, res);
+  RunBenchmark(src, info->m_limitRect, scaleRange, res);
+}
+
+void RunScalesBenchmark(string const & file, pair<int, int> scaleRange, Params const & params,
+                        Report & report)
+{
+  model::FeaturesFetcher src;
+  auto const info = RegisterMap(file, src);
+  if (!info)
+    return;
+
+  ClampScaleRange(*info, scaleRange);
+  for (int scale = scaleRange.first; scale <= scaleRange.second; ++scale)
+  {
+    string const suffix = "/scale=" + strings::to_string(scale);
+    for (size_t run = 0; run < params.m_warmUpRuns + params.m_runs; ++run)
+    {
+      AllResult res;
+      RunBenchmark(src, info->m_limitRect, make_pair(scale, scale), res);
+      if (run < params.m_warmUpRuns)
+        continue;
+
+      res.m_reading.CalcMetrics();
+      double const decoding = res.m_reading.m_all < 0.0 ? 0.0 : res.m_reading.m_all;
+      report.Add("for_each_in_rect" + suffix, res.m_all - decoding);
+      report.Add("geometry_decoding" + suffix, decoding);
+    }
+  }
 }
 
 }
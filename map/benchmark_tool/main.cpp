@@ -3,6 +3,9 @@
 #include "indexer/classificator_loader.hpp"
 #include "indexer/data_header.hpp"
 
+#include "base/logging.hpp"
+
+#include "std/fstream.hpp"
 #include "std/iostream.hpp"
 
 #include "3party/gflags/src/gflags/gflags.h"
@@ -12,6 +15,14 @@ DEFINE_string(input, "", "MWM file name in the data directory");
 DEFINE_int32(lowS, 10, "Low processing scale");
 DEFINE_int32(highS, 17, "High processing scale");
 DEFINE_bool(print_scales, false, "Print geometry scales for MWM and exit");
+DEFINE_bool(suite, false, "Run all benchmarks several times and print tab-separated results: "
+                          "name, median, min and max times in seconds and number of runs");
+DEFINE_int32(runs, 5, "Number of measured runs of every suite benchmark");
+DEFINE_int32(warmup_runs, 1, "Number of not measured runs before measured ones");
+DEFINE_int32(reverse_geocoding_points, 1000, "Number of points to reverse geocode in a run");
+DEFINE_string(output, "", "File to save suite results to, stdout is used if empty");
+DEFINE_string(baseline, "", "Saved suite results to compare with");
+DEFINE_double(threshold, 0.1, "Max allowed slowdown of median time relative to the baseline");
 
 
 int main(int argc, char ** argv)
@@ -37,6 +48,51 @@ int main(int argc, char ** argv)
     return 0;
   }
 
+  if (FLAGS_suite && !FLAGS_input.empty())
+  {
+    using namespace bench;
+
+    Params params;
+    params.m_runs = static_cast<size_t>(max(FLAGS_runs, 1));
+    params.m_warmUpRuns = static_cast<size_t>(max(FLAGS_warmup_runs, 0));
+
+    Report report;
+    RunScalesBenchmark(FLAGS_input, make_pair(FLAGS_lowS, FLAGS_highS), params, report);
+    if (FLAGS_reverse_geocoding_points > 0)
+    {
+      RunReverseGeocodingBenchmark(FLAGS_input, static_cast<size_t>(FLAGS_reverse_geocoding_points),
+                                   params, report);
+    }
+
+    if (FLAGS_output.empty())
+    {
+      report.Save(cout);
+    }
+    else
+    {
+      ofstream os(FLAGS_output);
+      report.Save(os);
+    }
+
+    if (!FLAGS_baseline.empty())
+    {
+      map<string, double> baseline;
+      if (!LoadBaseline(FLAGS_baseline, baseline))
+      {
+        LOG(LERROR, ("Can't load baseline", FLAGS_baseline));
+        return 1;
+      }
+
+      auto const regressions = FindRegressions(baseline, report, FLAGS_threshold);
+      if (!regressions.empty())
+      {
+        LOG(LWARNING, ("Regressions relative to", FLAGS_baseline, ":", regressions));
+        return 1;
+      }
+    }
+    return 0;
+  }
+
   if (!FLAGS_input.empty())
   {
     using namespace bench;
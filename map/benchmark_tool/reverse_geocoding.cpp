@@ -0,0 +1,48 @@
+#include "map/benchmark_tool/api.hpp"
+
+#include "map/feature_vec_model.hpp"
+
+#include "search/reverse_geocoder.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "base/timer.hpp"
+
+#include "std/random.hpp"
+
+
+namespace bench
+{
+
+void RunReverseGeocodingBenchmark(string const & file, size_t pointsCount, Params const & params,
+                                  Report & report)
+{
+  model::FeaturesFetcher src;
+  auto const info = RegisterMap(file, src);
+  if (!info)
+    return;
+
+  // The same points are used in all runs and by all launches of the tool.
+  m2::RectD const & rect = info->m_limitRect;
+  minstd_rand engine;
+  uniform_real_distribution<double> xs(rect.minX(), rect.maxX());
+  uniform_real_distribution<double> ys(rect.minY(), rect.maxY());
+  vector<m2::PointD> points(pointsCount);
+  for (auto & p : points)
+    p = m2::PointD(xs(engine), ys(engine));
+
+  search::ReverseGeocoder const coder(src.GetIndex());
+  for (size_t run = 0; run < params.m_warmUpRuns + params.m_runs; ++run)
+  {
+    my::Timer timer;
+    for (auto const & p : points)
+    {
+      search::ReverseGeocoder::Address addr;
+      coder.GetNearbyAddress(p, addr);
+    }
+    if (run >= params.m_warmUpRuns)
+      report.Add("reverse_geocoding", timer.ElapsedSeconds());
+  }
+}
+
+}
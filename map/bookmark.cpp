@@ -1,4 +1,5 @@
 #include "map/bookmark.hpp"
+#include "map/bookmark_cache.hpp"
 #include "map/track.hpp"
 
 #include "map/framework.hpp"
@@ -577,12 +578,26 @@ bool BookmarkCategory::LoadFromKML(ReaderPtr<Reader> const & reader)
 BookmarkCategory * BookmarkCategory::CreateFromKMLFile(std::string const & file, Framework & framework)
 {
   std::auto_ptr<BookmarkCategory> cat(new BookmarkCategory("", framework));
+  if (bookmarks::LoadCache(file, *cat))
+  {
+    cat->m_file = file;
+    return cat.release();
+  }
+
   try
   {
     if (cat->LoadFromKML(make_unique<FileReader>(file)))
+    {
       cat->m_file = file;
+      // The next start doesn't parse this file. Imported files are copied to the settings
+      // directory, files from other places aren't cached.
+      if (file.find(GetPlatform().SettingsDir()) == 0)
+        bookmarks::SaveCache(*cat, file);
+    }
     else
+    {
       cat.reset();
+    }
   }
   catch (std::exception const & e)
   {
@@ -872,7 +887,13 @@ bool BookmarkCategory::SaveToKMLFile()
       VERIFY(my::RenameFileX(fileTmp, m_file), (fileTmp, m_file));
       // delete old file
       if (!oldFile.empty())
+      {
         VERIFY(my::DeleteFileX(oldFile), (oldFile, m_file));
+        my::DeleteFileX(bookmarks::GetCacheFileName(oldFile));
+      }
+
+      if (!bookmarks::SaveCache(*this, m_file))
+        my::DeleteFileX(bookmarks::GetCacheFileName(m_file));
 
       return true;
     }
@@ -0,0 +1,288 @@
+#include "map/bookmark_cache.hpp"
+
+#include "map/bookmark.hpp"
+#include "map/track.hpp"
+
+#include "coding/file_name_utils.hpp"
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
+#include "coding/mmap_reader.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "base/logging.hpp"
+#include "base/stl_add.hpp"
+
+#include "defines.hpp"
+
+#include <cstring>
+#include <vector>
+
+#include "zlib.h"
+
+using namespace std;
+
+namespace bookmarks
+{
+namespace
+{
+uint8_t constexpr kVersion = 0;
+
+struct KmlSignature
+{
+  bool operator==(KmlSignature const & rhs) const
+  {
+    return m_size == rhs.m_size && m_checksum == rhs.m_checksum;
+  }
+
+  uint64_t m_size = 0;
+  uint32_t m_checksum = 0;
+};
+
+bool GetKmlSignature(string const & kmlFile, KmlSignature & signature)
+{
+  try
+  {
+    string content;
+    FileReader(kmlFile).ReadAsString(content);
+    signature.m_size = content.size();
+    signature.m_checksum = static_cast<uint32_t>(
+        crc32(crc32(0, Z_NULL, 0), reinterpret_cast<Bytef const *>(content.data()),
+              static_cast<uInt>(content.size())));
+    return true;
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't read", kmlFile, e.Msg()));
+    return false;
+  }
+}
+
+template <typename T>
+uint64_t ToBits(T value)
+{
+  static_assert(sizeof(T) <= sizeof(uint64_t), "");
+  uint64_t bits = 0;
+  memcpy(&bits, &value, sizeof(T));
+  return bits;
+}
+
+template <typename T>
+T FromBits(uint64_t bits)
+{
+  T value;
+  memcpy(&value, &bits, sizeof(T));
+  return value;
+}
+
+// Points are stored exactly: the cache must not change coordinates which are saved
+// back to KML.
+template <typename Sink>
+void WritePoint(Sink & sink, m2::PointD const & pt)
+{
+  WriteToSink(sink, ToBits(pt.x));
+  WriteToSink(sink, ToBits(pt.y));
+}
+
+template <typename Source>
+m2::PointD ReadPoint(Source & src)
+{
+  double const x = FromBits<double>(ReadPrimitiveFromSource<uint64_t>(src));
+  double const y = FromBits<double>(ReadPrimitiveFromSource<uint64_t>(src));
+  if (!MercatorBounds::ValidX(x) || !MercatorBounds::ValidY(y))
+    MYTHROW(Reader::Exception, ("Bad point in bookmarks cache:", x, y));
+  return m2::PointD(x, y);
+}
+
+template <typename Sink>
+void Serialize(BookmarkCategory const & category, KmlSignature const & signature, Sink & sink)
+{
+  WriteToSink(sink, kVersion);
+  WriteVarUint(sink, signature.m_size);
+  WriteToSink(sink, signature.m_checksum);
+
+  rw::Write(sink, category.GetName());
+  WriteToSink(sink, static_cast<uint8_t>(category.IsVisible() ? 1 : 0));
+
+  // User marks are pushed front, so they are written in reverse order to be created
+  // in the same order on loading.
+  size_t const bookmarksCount = category.GetUserMarkCount();
+  WriteVarUint(sink, static_cast<uint64_t>(bookmarksCount));
+  for (size_t i = bookmarksCount; i > 0; --i)
+  {
+    auto const * bookmark = static_cast<Bookmark const *>(category.GetUserMark(i - 1));
+    BookmarkData const & data = bookmark->GetData();
+    WritePoint(sink, bookmark->GetPivot());
+    rw::Write(sink, data.GetName());
+    rw::Write(sink, data.GetType());
+    rw::Write(sink, data.GetDescription());
+    WriteToSink(sink, ToBits(data.GetScale()));
+    WriteVarInt(sink, static_cast<int64_t>(data.GetTimeStamp()));
+  }
+
+  size_t const tracksCount = category.GetTracksCount();
+  WriteVarUint(sink, static_cast<uint64_t>(tracksCount));
+  for (size_t i = 0; i < tracksCount; ++i)
+  {
+    Track const & track = *category.GetTrack(i);
+    rw::Write(sink, track.GetName());
+
+    size_t const layersCount = track.GetLayerCount();
+    WriteVarUint(sink, static_cast<uint64_t>(layersCount));
+    for (size_t j = 0; j < layersCount; ++j)
+    {
+      dp::Color const & color = track.GetColor(j);
+      WriteToSink(sink, static_cast<uint32_t>(ToBits(track.GetWidth(j))));
+      WriteToSink(sink, color.GetRed());
+      WriteToSink(sink, color.GetGreen());
+      WriteToSink(sink, color.GetBlue());
+      WriteToSink(sink, color.GetAlfa());
+    }
+
+    auto const & polyline = track.GetPolyline();
+    WriteVarUint(sink, static_cast<uint64_t>(polyline.GetSize()));
+    for (auto const & pt : polyline.GetPoints())
+      WritePoint(sink, pt);
+  }
+}
+
+template <typename Source>
+uint64_t ReadCount(Source & src)
+{
+  uint64_t const count = ReadVarUint<uint64_t>(src);
+  // Every item takes at least one byte, so it protects from huge allocations on broken data.
+  if (count > src.Size())
+    MYTHROW(Reader::Exception, ("Bad count in bookmarks cache:", count));
+  return count;
+}
+
+template <typename Source>
+void Deserialize(Source & src, BookmarkCategory & category)
+{
+  string name;
+  rw::Read(src, name);
+  category.SetName(name);
+  category.SetIsVisible(ReadPrimitiveFromSource<uint8_t>(src) != 0);
+
+  uint64_t const bookmarksCount = ReadCount(src);
+  for (uint64_t i = 0; i < bookmarksCount; ++i)
+  {
+    m2::PointD const pt = ReadPoint(src);
+    string bmName, type, description;
+    rw::Read(src, bmName);
+    rw::Read(src, type);
+    rw::Read(src, description);
+    double const scale = FromBits<double>(ReadPrimitiveFromSource<uint64_t>(src));
+    auto const timeStamp = static_cast<time_t>(ReadVarInt<int64_t>(src));
+
+    auto * bookmark = static_cast<Bookmark *>(category.CreateUserMark(pt));
+    bookmark->SetData(BookmarkData(bmName, type, description, scale, timeStamp));
+  }
+
+  uint64_t const tracksCount = ReadCount(src);
+  for (uint64_t i = 0; i < tracksCount; ++i)
+  {
+    Track::Params params;
+    rw::Read(src, params.m_name);
+
+    uint64_t const layersCount = ReadCount(src);
+    for (uint64_t j = 0; j < layersCount; ++j)
+    {
+      Track::TrackOutline outline;
+      outline.m_lineWidth = FromBits<float>(ReadPrimitiveFromSource<uint32_t>(src));
+      uint8_t const r = ReadPrimitiveFromSource<uint8_t>(src);
+      uint8_t const g = ReadPrimitiveFromSource<uint8_t>(src);
+      uint8_t const b = ReadPrimitiveFromSource<uint8_t>(src);
+      uint8_t const a = ReadPrimitiveFromSource<uint8_t>(src);
+      outline.m_color = dp::Color(r, g, b, a);
+      params.m_colors.push_back(outline);
+    }
+
+    uint64_t const pointsCount = ReadCount(src);
+    m2::PolylineD polyline;
+    for (uint64_t j = 0; j < pointsCount; ++j)
+      polyline.Add(ReadPoint(src));
+
+    category.AddTrack(my::make_unique<Track>(polyline, params));
+  }
+
+  if (src.Size() != 0)
+    MYTHROW(Reader::Exception, ("Trailing data in bookmarks cache:", src.Size()));
+}
+}  // namespace
+
+string GetCacheFileName(string const & kmlFile)
+{
+  string name = kmlFile;
+  my::GetNameWithoutExt(name);
+  return name + BOOKMARKS_CACHE_FILE_EXTENSION;
+}
+
+bool SaveCache(BookmarkCategory const & category, string const & kmlFile)
+{
+  KmlSignature signature;
+  if (!GetKmlSignature(kmlFile, signature))
+    return false;
+
+  string const cacheFile = GetCacheFileName(kmlFile);
+  string const cacheFileTmp = cacheFile + ".tmp";
+  try
+  {
+    {
+      FileWriter writer(cacheFileTmp);
+      Serialize(category, signature, writer);
+    }
+    if (my::RenameFileX(cacheFileTmp, cacheFile))
+      return true;
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't save bookmarks cache", cacheFile, e.Msg()));
+  }
+  my::DeleteFileX(cacheFileTmp);
+  return false;
+}
+
+bool LoadCache(string const & kmlFile, BookmarkCategory & category)
+{
+  ASSERT_EQUAL(category.GetUserMarkCount(), 0, ());
+  ASSERT_EQUAL(category.GetTracksCount(), 0, ());
+
+  string const cacheFile = GetCacheFileName(kmlFile);
+  uint64_t size = 0;
+  if (!my::GetFileSize(cacheFile, size))
+    return false;
+
+  try
+  {
+    MmapReader reader(cacheFile);
+    ReaderSource<MmapReader> src(reader);
+    if (ReadPrimitiveFromSource<uint8_t>(src) != kVersion)
+      return false;
+
+    KmlSignature cached;
+    cached.m_size = ReadVarUint<uint64_t>(src);
+    cached.m_checksum = ReadPrimitiveFromSource<uint32_t>(src);
+
+    KmlSignature actual;
+    if (!GetKmlSignature(kmlFile, actual) || !(actual == cached))
+      return false;
+
+    Deserialize(src, category);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't load bookmarks cache", cacheFile, e.Msg()));
+    category.Clear();
+    category.ClearTracks();
+    return false;
+  }
+
+  category.NotifyChanges();
+  return true;
+}
+}  // namespace bookmarks
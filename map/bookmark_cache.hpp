@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string>
+
+class BookmarkCategory;
+
+namespace bookmarks
+{
+// Binary copy of a category from a KML file, which is loaded much faster than KML is parsed.
+// The cache keeps the size and the checksum of the KML file and is used only while the KML file
+// isn't changed, so KML remains the only format for import, export and edits by other apps.
+// Only files in the settings directory are cached.
+std::string GetCacheFileName(std::string const & kmlFile);
+
+// Saves |category| which is equal to the contents of |kmlFile|.
+bool SaveCache(BookmarkCategory const & category, std::string const & kmlFile);
+
+// Loads |category| from the cache of |kmlFile|. |category| must be empty.
+// Returns false when there is no cache or it's outdated or broken.
+bool LoadCache(std::string const & kmlFile, BookmarkCategory & category);
+}  // namespace bookmarks
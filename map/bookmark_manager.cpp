@@ -1,4 +1,5 @@
 #include "map/bookmark_manager.hpp"
+#include "map/bookmark_cache.hpp"
 #include "map/framework.hpp"
 #include "map/local_ads_mark.hpp"
 #include "map/routing_mark.hpp"
@@ -171,6 +172,7 @@ void BookmarkManager::DeleteBmCategory(CategoryIter it)
   BookmarkCategory & cat = *it->get();
   cat.DeleteLater();
   FileWriter::DeleteFileX(cat.GetFileName());
+  FileWriter::DeleteFileX(bookmarks::GetCacheFileName(cat.GetFileName()));
   m_categories.erase(it);
 }
 
@@ -127,14 +127,18 @@ bool NormalizeChartData(vector<double> const & distanceDataM,
     return true;
   }
 
+  // Distances of samples grow, so the segment of a sample is found by a sweep
+  // which goes on from the segment of the previous sample. It takes linear time
+  // in the number of route points and samples, which matters for long routes.
+  size_t nextPointIdx = 0;
   auto const calculateAltitude = [&](double distFormStartM) {
     if (distFormStartM <= distanceDataM.front())
       return static_cast<double>(altitudeDataM.front());
     if (distFormStartM >= distanceDataM.back())
       return static_cast<double>(altitudeDataM.back());
 
-    auto const lowerIt = lower_bound(distanceDataM.cbegin(), distanceDataM.cend(), distFormStartM);
-    size_t const nextPointIdx = distance(distanceDataM.cbegin(), lowerIt);
+    while (distanceDataM[nextPointIdx] < distFormStartM)
+      ++nextPointIdx;
     ASSERT_LESS(0, nextPointIdx, ("distFormStartM is greater than 0 but nextPointIdx == 0."));
     size_t const prevPointIdx = nextPointIdx - 1;
 
@@ -302,4 +306,31 @@ bool GenerateChart(uint32_t width, uint32_t height, vector<double> const & dista
 
   return GenerateChartByPoints(width, height, geometry, mapStyle, frameBuffer);
 }
+
+bool CachedChartGenerator::GenerateChart(uint32_t width, uint32_t height,
+                                         vector<double> const & distanceDataM,
+                                         feature::TAltitudes const & altitudeDataM,
+                                         MapStyle mapStyle, vector<uint8_t> & frameBuffer)
+{
+  lock_guard<mutex> lock(m_mutex);
+  if (m_isValid && m_width == width && m_height == height && m_mapStyle == mapStyle &&
+      m_distanceDataM == distanceDataM && m_altitudeDataM == altitudeDataM)
+  {
+    frameBuffer = m_frameBuffer;
+    return true;
+  }
+
+  m_isValid = false;
+  if (!maps::GenerateChart(width, height, distanceDataM, altitudeDataM, mapStyle, frameBuffer))
+    return false;
+
+  m_width = width;
+  m_height = height;
+  m_mapStyle = mapStyle;
+  m_distanceDataM = distanceDataM;
+  m_altitudeDataM = altitudeDataM;
+  m_frameBuffer = frameBuffer;
+  m_isValid = true;
+  return true;
+}
 }  // namespace maps
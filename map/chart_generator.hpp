@@ -6,6 +6,7 @@
 #include "geometry/point2d.hpp"
 
 #include "std/cstdint.hpp"
+#include "std/mutex.hpp"
 #include "std/vector.hpp"
 
 namespace maps
@@ -47,4 +48,26 @@ bool GenerateChartByPoints(uint32_t width, uint32_t height, vector<m2::PointD> c
 bool GenerateChart(uint32_t width, uint32_t height, vector<double> const & distanceDataM,
                    feature::TAltitudes const & altitudeDataM, MapStyle mapStyle,
                    vector<uint8_t> & frameBuffer);
+
+/// \brief generates charts by GenerateChart() and keeps the last generated one. The chart is
+/// requested with the same params many times, e.g. whenever UI is laid out, while the route
+/// stays the same, so the cached image is returned instead of rasterizing the chart again.
+/// \note The class is thread-safe.
+class CachedChartGenerator
+{
+public:
+  bool GenerateChart(uint32_t width, uint32_t height, vector<double> const & distanceDataM,
+                     feature::TAltitudes const & altitudeDataM, MapStyle mapStyle,
+                     vector<uint8_t> & frameBuffer);
+
+private:
+  mutex m_mutex;
+  bool m_isValid = false;
+  uint32_t m_width = 0;
+  uint32_t m_height = 0;
+  MapStyle m_mapStyle = MapStyleClear;
+  vector<double> m_distanceDataM;
+  feature::TAltitudes m_altitudeDataM;
+  vector<uint8_t> m_frameBuffer;
+};
 }  // namespace maps
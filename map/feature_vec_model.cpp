@@ -69,6 +69,27 @@ pair<MwmSet::MwmId, MwmSet::RegResult> FeaturesFetcher::RegisterMap(
   }
 }
 
+vector<pair<MwmSet::MwmId, MwmSet::RegResult>> FeaturesFetcher::RegisterMaps(
+    vector<LocalCountryFile> const & localFiles)
+{
+  auto results = m_multiIndex.Register(localFiles);
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    auto const & result = results[i];
+    if (result.second == MwmSet::RegResult::Success)
+    {
+      MwmSet::MwmId const & id = result.first;
+      ASSERT(id.IsAlive(), ());
+      m_rect.Add(id.GetInfo()->m_limitRect);
+    }
+    else
+    {
+      LOG(LWARNING, ("Can't add map", localFiles[i].GetCountryName(), "(", result.second, ")."));
+    }
+  }
+  return results;
+}
+
 bool FeaturesFetcher::DeregisterMap(CountryFile const & countryFile)
 {
   return m_multiIndex.Deregister(countryFile);
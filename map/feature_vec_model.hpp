@@ -50,6 +50,10 @@ class FeaturesFetcher : public MwmSet::Observer
     pair<MwmSet::MwmId, MwmSet::RegResult> RegisterMap(
         platform::LocalCountryFile const & localFile);
 
+    /// Registers maps, their headers are read in parallel.
+    vector<pair<MwmSet::MwmId, MwmSet::RegResult>> RegisterMaps(
+        vector<platform::LocalCountryFile> const & localFiles);
+
     /// Deregisters a map denoted by file from internal records.
     bool DeregisterMap(platform::CountryFile const & countryFile);
 
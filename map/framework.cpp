@@ -140,6 +140,14 @@ char const kICUDataFile[] = "icudt57l.dat";
 double const kDistEqualQueryMeters = 100.0;
 double const kLargeFontsScaleFactor = 1.6;
 size_t constexpr kMaxTrafficCacheSizeBytes = 64 /* Mb */ * 1024 * 1024;
+// Decoded features used by routing.
+size_t constexpr kMaxFeatureCacheSizeBytes = 16 /* Mb */ * 1024 * 1024;
+
+// Max delays of updates on viewport changes. Larger delays save more work during continuous
+// panning but make updates less responsive.
+auto constexpr kSearchViewportUpdateDelay = std::chrono::milliseconds(300);
+auto constexpr kTrafficViewportUpdateDelay = std::chrono::milliseconds(500);
+auto constexpr kLocalAdsViewportUpdateDelay = std::chrono::seconds(1);
 
 // Must correspond SearchMarkType.
 vector<string> kSearchMarks =
@@ -292,7 +300,12 @@ void Framework::OnViewportChanged(ScreenBase const & screen)
 {
   double constexpr kEps = 1.0E-4;
   if (!screen.GlobalRect().EqualDxDy(m_currentModelView.GlobalRect(), kEps))
-    UpdateUserViewportChanged();
+  {
+    m_searchViewportUpdate.Push([this]()
+    {
+      GetPlatform().RunOnGuiThread([this]() { UpdateUserViewportChanged(); });
+    });
+  }
 
   m_currentModelView = screen;
   if (!m_isViewportInitialized)
@@ -306,8 +319,14 @@ void Framework::OnViewportChanged(ScreenBase const & screen)
     }
   }
 
-  m_trafficManager.UpdateViewport(m_currentModelView);
-  m_localAdsManager.UpdateViewport(m_currentModelView);
+  m_trafficViewportUpdate.Push([this]()
+  {
+    GetPlatform().RunOnGuiThread([this]() { m_trafficManager.UpdateViewport(m_currentModelView); });
+  });
+  m_localAdsViewportUpdate.Push([this]()
+  {
+    GetPlatform().RunOnGuiThread([this]() { m_localAdsManager.UpdateViewport(m_currentModelView); });
+  });
 
   if (m_viewportChanged != nullptr)
     m_viewportChanged(screen);
@@ -359,7 +378,10 @@ void Framework::Migrate(bool keepDownloaded)
   m_selectedFeature = FeatureID();
   m_searchEngine.reset();
   m_infoGetter.reset();
-  m_taxiEngine.reset();
+  {
+    lock_guard<mutex> lock(m_lazyEnginesMutex);
+    m_taxiEngine.reset();
+  }
   m_cityFinder.reset();
   m_ugcApi.reset();
   TCountriesVec existedCountries;
@@ -371,7 +393,6 @@ void Framework::Migrate(bool keepDownloaded)
   InitUGC();
   InitSearchEngine();
   InitCityFinder();
-  InitTaxiEngine();
   RegisterAllMaps();
 
   m_trafficManager.SetCurrentDataVersion(GetStorage().GetCurrentDataVersion());
@@ -400,6 +421,9 @@ Framework::Framework(FrameworkParams const & params)
   , m_localAdsManager(bind(&Framework::GetMwmsByRect, this, _1, true /* rough */),
                       bind(&Framework::GetMwmIdByName, this, _1),
                       bind(&Framework::ReadFeatures, this, _1, _2))
+  , m_searchViewportUpdate(m_viewportUpdatesThread, kSearchViewportUpdateDelay)
+  , m_trafficViewportUpdate(m_viewportUpdatesThread, kTrafficViewportUpdateDelay)
+  , m_localAdsViewportUpdate(m_viewportUpdatesThread, kLocalAdsViewportUpdateDelay)
   , m_displacementModeManager([this](bool show) {
     int const mode = show ? dp::displacement::kHotelMode : dp::displacement::kDefaultMode;
     if (m_drapeEngine != nullptr)
@@ -408,6 +432,7 @@ Framework::Framework(FrameworkParams const & params)
   , m_lastReportedCountry(kInvalidCountryId)
   , m_enabledDiffs(params.m_enableDiffs)
 {
+  m_startupTrace.AddStage("Members");
   m_startBackgroundTime = my::Timer::LocalTime();
 
   // Restore map style before classificator loading
@@ -440,34 +465,35 @@ Framework::Framework(FrameworkParams const & params)
 
   m_model.InitClassificator();
   m_model.SetOnMapDeregisteredCallback(bind(&Framework::OnMapDeregistered, this, _1));
-  LOG(LDEBUG, ("Classificator initialized"));
+  m_startupTrace.AddStage("Classificator");
 
   m_displayedCategories = make_unique<search::DisplayedCategories>(GetDefaultCategories());
+  m_startupTrace.AddStage("Categories");
 
   // To avoid possible races - init country info getter in constructor.
   InitCountryInfoGetter();
-  LOG(LDEBUG, ("Country info getter initialized"));
+  m_startupTrace.AddStage("CountryInfoGetter");
 
   InitUGC();
-  LOG(LDEBUG, ("UGC initialized"));
+  m_startupTrace.AddStage("UGC");
 
   InitSearchEngine();
-  LOG(LDEBUG, ("Search engine initialized"));
+  m_startupTrace.AddStage("SearchEngine");
 
   InitCityFinder();
-  InitTaxiEngine();
+  m_startupTrace.AddStage("CityFinder");
 
   // All members which re-initialize in Migrate() method should be initialized before RegisterAllMaps().
   // Migrate() can be called from RegisterAllMaps().
   RegisterAllMaps();
-  LOG(LDEBUG, ("Maps initialized"));
+  m_startupTrace.AddStage("Maps");
 
   // Init storage with needed callback.
   m_storage.Init(
                  bind(&Framework::OnCountryFileDownloaded, this, _1, _2),
                  bind(&Framework::OnCountryFileDelete, this, _1, _2));
   m_storage.SetDownloadingPolicy(&m_storageDownloadingPolicy);
-  LOG(LDEBUG, ("Storage initialized"));
+  m_startupTrace.AddStage("Storage");
 
   // Local ads manager should be initialized after storage initialization.
   if (params.m_enableLocalAds)
@@ -475,12 +501,13 @@ Framework::Framework(FrameworkParams const & params)
     m_localAdsManager.SetBookmarkManager(&m_bmManager);
     m_localAdsManager.Startup();
   }
+  m_startupTrace.AddStage("LocalAds");
 
+  m_model.GetIndex().GetFeatureCache().SetMaxBytes(kMaxFeatureCacheSizeBytes);
   m_routingManager.SetRouterImpl(RouterType::Vehicle);
 
   UpdateMinBuildingsTapZoom();
-
-  LOG(LDEBUG, ("Routing engine initialized"));
+  m_startupTrace.AddStage("Routing");
 
   LOG(LINFO, ("System languages:", languages::GetPreferred()));
 
@@ -491,19 +518,19 @@ Framework::Framework(FrameworkParams const & params)
   editor.LoadMapEdits();
 
   m_model.GetIndex().AddObserver(editor);
-
-  LOG(LINFO, ("Editor initialized"));
+  m_startupTrace.AddStage("Editor");
 
   m_trafficManager.SetCurrentDataVersion(m_storage.GetCurrentDataVersion());
 
-  m_adsEngine = make_unique<ads::Engine>();
-
   InitTransliteration();
-  LOG(LDEBUG, ("Transliterators initialized"));
+  m_startupTrace.AddStage("Transliteration");
+
+  LOG(LINFO, ("Framework initialized:", m_startupTrace));
 }
 
 Framework::~Framework()
 {
+  m_viewportUpdatesThread.Shutdown(base::WorkerThread::Exit::SkipPending);
   m_trafficManager.Teardown();
   m_localAdsManager.Teardown();
   DestroyDrapeEngine();
@@ -539,9 +566,8 @@ viator::Api * Framework::GetViatorApi(platform::NetworkPolicy const & policy)
 
 taxi::Engine * Framework::GetTaxiEngine(platform::NetworkPolicy const & policy)
 {
-  ASSERT(m_taxiEngine, ());
   if (policy.CanUse())
-    return m_taxiEngine.get();
+    return &GetOrCreateTaxiEngine();
 
   return nullptr;
 }
@@ -685,9 +711,16 @@ void Framework::RegisterAllMaps()
 
   vector<shared_ptr<LocalCountryFile>> maps;
   m_storage.GetLocalMaps(maps);
+  vector<LocalCountryFile> localFiles;
+  localFiles.reserve(maps.size());
   for (auto const & localFile : maps)
+    localFiles.push_back(*localFile);
+
+  LOG(LINFO, ("Loading maps:", localFiles.size()));
+  auto const results = m_model.RegisterMaps(localFiles);
+  for (size_t i = 0; i < results.size(); ++i)
   {
-    auto p = RegisterMap(*localFile);
+    auto const & p = results[i];
     if (p.second != MwmSet::RegResult::Success)
       continue;
 
@@ -696,7 +729,8 @@ void Framework::RegisterAllMaps()
     minFormat = min(minFormat, static_cast<int>(id.GetInfo()->m_version.GetFormat()));
     if (needStatisticsUpdate)
     {
-      listRegisteredMaps << localFile->GetCountryName() << ":" << id.GetInfo()->GetVersion() << ";";
+      listRegisteredMaps << localFiles[i].GetCountryName() << ":" << id.GetInfo()->GetVersion()
+                         << ";";
     }
   }
 
@@ -939,8 +973,7 @@ void Framework::FillInfoFromFeatureType(FeatureType const & ft, place_page::Info
   }
 
   auto const latlon = MercatorBounds::ToLatLon(feature::GetCenter(ft));
-  ASSERT(m_taxiEngine, ());
-  info.SetReachableByTaxiProviders(m_taxiEngine->GetProvidersAtPos(latlon));
+  info.SetReachableByTaxiProviders(GetOrCreateTaxiEngine().GetProvidersAtPos(latlon));
 }
 
 void Framework::FillApiMarkInfo(ApiMarkPoint const & api, place_page::Info & info) const
@@ -1341,6 +1374,7 @@ bool Framework::SearchEverywhere(search::EverywhereSearchParams const & params)
   p.m_suggestsEnabled = true;
   p.m_hotelsFilter = params.m_hotelsFilter;
   p.m_cianMode = IsCianMode(params.m_query);
+  p.m_progressiveResults = true;
 
   p.m_onResults = search::EverywhereSearchCallback(
       static_cast<search::EverywhereSearchCallback::Delegate &>(*this),
@@ -1386,6 +1420,34 @@ bool Framework::SearchInViewport(search::ViewportSearchParams const & params)
 
 bool Framework::SearchInDownloader(DownloaderSearchParams const & params)
 {
+  // Names of countries and regions are found by the name index without mwms,
+  // other queries are processed by the search engine.
+  Storage const & storage = GetStorage();
+  if (!m_downloaderNameIndex || m_downloaderNameIndex->GetLocale() != storage.GetLocale())
+  {
+    m_downloaderNameIndex = make_unique<search::DownloaderNameIndex>(storage.GetLocale());
+    storage.ForEachInSubtree(storage.GetRootId(), [&](TCountryId const & countryId, bool) {
+      if (countryId != storage.GetRootId())
+        m_downloaderNameIndex->Add(countryId, storage.GetNodeLocalName(countryId));
+    });
+    m_downloaderNameIndex->Build();
+  }
+
+  DownloaderSearchResults results;
+  m_downloaderNameIndex->Search(params.m_query, results.m_results);
+  if (!results.m_results.empty())
+  {
+    CancelSearch(search::Mode::Downloader);
+    results.m_query = params.m_query;
+    results.m_endMarker = true;
+    if (params.m_onResults)
+    {
+      auto const onResults = params.m_onResults;
+      RunUITask([onResults, results]() { onResults(results); });
+    }
+    return true;
+  }
+
   search::SearchParams p;
   p.m_query = params.m_query;
   p.m_inputLocale = params.m_inputLocale;
@@ -1439,6 +1501,10 @@ void Framework::EnterBackground()
   m_trafficManager.OnEnterBackground();
   m_routingManager.SetAllowSendingPoints(false);
 
+  // The app may be killed in background, so pending settings are saved now.
+  settings::Flush();
+  marketing::Settings::Flush();
+
   ms::LatLon const ll = MercatorBounds::ToLatLon(GetViewportCenter());
   alohalytics::Stats::Instance().LogEvent("Framework::EnterBackground", {{"zoom", strings::to_string(GetDrawScale())},
                                           {"foregroundSeconds", strings::to_string(
@@ -2502,7 +2568,7 @@ df::SelectionShape::ESelectedObject Framework::OnTapEventImpl(TapEvent const & t
     return df::SelectionShape::OBJECT_MY_POSITION;
   }
 
-  outInfo.SetAdsEngine(m_adsEngine.get());
+  outInfo.SetAdsEngine(&GetOrCreateAdsEngine());
 
   UserMark const * mark = FindUserMarkInTapPosition(tapInfo);
   if (mark != nullptr)
@@ -3320,8 +3386,7 @@ void Framework::VisualizeRoadsInRect(m2::RectD const & rect)
 
 ads::Engine const & Framework::GetAdsEngine() const
 {
-  ASSERT(m_adsEngine, ());
-  return *m_adsEngine;
+  return GetOrCreateAdsEngine();
 }
 
 bool Framework::IsLocalAdsCustomer(search::Result const & result) const
@@ -3393,16 +3458,28 @@ void Framework::InitCityFinder()
   m_cityFinder = make_unique<search::CityFinder>(m_model.GetIndex());
 }
 
-void Framework::InitTaxiEngine()
+taxi::Engine & Framework::GetOrCreateTaxiEngine() const
 {
-  ASSERT(!m_taxiEngine, ());
+  lock_guard<mutex> lock(m_lazyEnginesMutex);
+  if (m_taxiEngine)
+    return *m_taxiEngine;
+
   ASSERT(m_infoGetter, ());
   ASSERT(m_cityFinder, ());
 
   m_taxiEngine = my::make_unique<taxi::Engine>();
 
   m_taxiEngine->SetDelegate(
-      my::make_unique<TaxiDelegate>(GetStorage(), *m_infoGetter, *m_cityFinder));
+      my::make_unique<TaxiDelegate>(m_storage, *m_infoGetter, *m_cityFinder));
+  return *m_taxiEngine;
+}
+
+ads::Engine & Framework::GetOrCreateAdsEngine() const
+{
+  lock_guard<mutex> lock(m_lazyEnginesMutex);
+  if (!m_adsEngine)
+    m_adsEngine = my::make_unique<ads::Engine>();
+  return *m_adsEngine;
 }
 
 void Framework::SetPlacePageLocation(place_page::Info & info)
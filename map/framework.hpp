@@ -10,6 +10,7 @@
 #include "map/place_page_info.hpp"
 #include "map/routing_manager.hpp"
 #include "map/routing_mark.hpp"
+#include "map/startup_trace.hpp"
 #include "map/track.hpp"
 #include "map/traffic_manager.hpp"
 #include "map/user.hpp"
@@ -32,6 +33,7 @@
 
 #include "search/city_finder.hpp"
 #include "search/displayed_categories.hpp"
+#include "search/downloader_name_index.hpp"
 #include "search/downloader_search_callback.hpp"
 #include "search/engine.hpp"
 #include "search/everywhere_search_callback.hpp"
@@ -61,13 +63,16 @@
 #include "geometry/rect2d.hpp"
 #include "geometry/screenbase.hpp"
 
+#include "base/coalescing_task.hpp"
 #include "base/deferred_task.hpp"
 #include "base/macros.hpp"
 #include "base/strings_bundle.hpp"
 #include "base/thread_checker.hpp"
+#include "base/worker_thread.hpp"
 
 #include "std/function.hpp"
 #include "std/list.hpp"
+#include "std/mutex.hpp"
 #include "std/set.hpp"
 #include "std/shared_ptr.hpp"
 #include "std/string.hpp"
@@ -150,6 +155,9 @@ class Framework : public search::ViewportSearchCallback::Delegate,
 protected:
   using TDrapeFunction = function<void (df::DrapeEngine *)>;
 
+  // Must be the first member to take into account initialization of other members.
+  StartupTrace m_startupTrace;
+
   StringsBundle m_stringsBundle;
 
   model::FeaturesFetcher m_model;
@@ -169,6 +177,10 @@ protected:
 
   search::QuerySaver m_searchQuerySaver;
 
+  // Localized names of the country tree for the current locale of storage.
+  // It's built on the first downloader search and rebuilt when the locale changes.
+  unique_ptr<search::DownloaderNameIndex> m_downloaderNameIndex;
+
   ScreenBase m_currentModelView;
   m2::RectD m_visibleViewport;
 
@@ -204,6 +216,14 @@ protected:
 
   LocalAdsManager m_localAdsManager;
 
+  // Updates of subsystems on viewport changes are merged, so continuous panning doesn't
+  // trigger search and network requests on every frame. Merged updates are run on the gui
+  // thread.
+  base::WorkerThread m_viewportUpdatesThread;
+  base::CoalescingTask m_searchViewportUpdate;
+  base::CoalescingTask m_trafficViewportUpdate;
+  base::CoalescingTask m_localAdsViewportUpdate;
+
   User m_user;
 
   /// This function will be called by m_storage when latest local files
@@ -346,6 +366,9 @@ public:
 
   ads::Engine const & GetAdsEngine() const;
 
+  // Durations of the stages of Framework construction.
+  StartupTrace const & GetStartupTrace() const { return m_startupTrace; }
+
 protected:
   // search::ViewportSearchCallback::Delegate overrides:
   void RunUITask(function<void()> fn) override { GetPlatform().RunOnGuiThread(move(fn)); }
@@ -838,17 +861,22 @@ public:
 
 private:
   unique_ptr<search::CityFinder> m_cityFinder;
-  unique_ptr<ads::Engine> m_adsEngine;
+  // ads::Engine and taxi::Engine aren't needed for the first frame, so they are created
+  // on the first use. |m_lazyEnginesMutex| guards both of them.
+  mutable mutex m_lazyEnginesMutex;
+  mutable unique_ptr<ads::Engine> m_adsEngine;
   // The order matters here: storage::CountryInfoGetter and
   // search::CityFinder must be initialized before
   // taxi::Engine and, therefore, destroyed after taxi::Engine.
-  unique_ptr<taxi::Engine> m_taxiEngine;
+  mutable unique_ptr<taxi::Engine> m_taxiEngine;
 
   // TODO: delete me after Cian project is finished.
   bool m_cianSearchMode = false;
 
   void InitCityFinder();
-  void InitTaxiEngine();
+  // Create engines on the first call.
+  taxi::Engine & GetOrCreateTaxiEngine() const;
+  ads::Engine & GetOrCreateAdsEngine() const;
 
   void SetPlacePageLocation(place_page::Info & info);
 
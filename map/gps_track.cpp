@@ -180,7 +180,12 @@ void GpsTrack::InitCollection(hours duration)
     vector<location::GpsInfo> originPoints;
     originPoints.reserve(kItemBlockSize);
 
-    m_storage->ForEach([this, &originPoints](location::GpsInfo const & originPoint)->bool
+    // Points older than the duration are evicted from the collection, so they aren't read.
+    double const lastTimestamp = m_storage->GetLastTimestamp();
+    double const firstTimestamp = lastTimestamp - duration_cast<seconds>(duration).count();
+
+    m_storage->ForEachInTimeRange(firstTimestamp, lastTimestamp,
+                                  [this, &originPoints](location::GpsInfo const & originPoint)->bool
     {
       originPoints.emplace_back(originPoint);
       if (originPoints.size() == originPoints.capacity())
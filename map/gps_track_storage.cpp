@@ -1,19 +1,29 @@
 #include "map/gps_track_storage.hpp"
 
+#include "coding/byte_stream.hpp"
 #include "coding/endianness.hpp"
 #include "coding/internal/file_data.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
 
 #include "std/algorithm.hpp"
+#include "std/cmath.hpp"
 #include "std/cstring.hpp"
 
 #include "base/assert.hpp"
+#include "base/bits.hpp"
 #include "base/logging.hpp"
 
 namespace
 {
 
 // Current file format version
-uint32_t constexpr kCurrentVersion = 1;
+uint32_t constexpr kCurrentVersion = 2;
+
+// Version of the file format where GpsInfo were written as plain values,
+// such files are converted to the current version on open.
+uint32_t constexpr kPlainVersion = 1;
 
 // Header size in bytes, header consists of uint32_t 'version' only
 uint32_t constexpr kHeaderSize = sizeof(uint32_t);
@@ -21,11 +31,26 @@ uint32_t constexpr kHeaderSize = sizeof(uint32_t);
 // Number of items for batch processing
 size_t constexpr kItemBlockSize = 1000;
 
-// TODO
-// Now GpsInfo written as plain values, but values can be compressed.
+// Size of point in bytes in the plain format
+size_t constexpr kPlainPointSize = 8 * sizeof(double) + sizeof(uint8_t);
+
+// Items are stored in chunks. Every chunk has a header: payload size, number of items,
+// timestamps of the first and the last items. The header is the time index of the file,
+// it's read on open, and it's rewritten in place when items are appended to the chunk.
+// Payload is a sequence of items, every value of an item is quantized and written as
+// a varint delta against the previous item of the chunk.
+uint32_t constexpr kChunkItemCount = 512;
+size_t constexpr kChunkHeaderSize = 2 * sizeof(uint32_t) + 2 * sizeof(double);
+
+// Quantization factors of item values: timestamp in milliseconds, coordinates in 1e-7 degrees
+// (about 1cm), altitude, speed, bearing and accuracies in hundredths.
+array<double, 9> const kFactors = {{1e3, 1e7, 1e7, 1e2, 1e2, 1e2, 1e2, 1e2, 1.0}};
 
-// Size of point in bytes to write in file of read from file
-size_t constexpr kPointSize = 8 * sizeof(double) + sizeof(uint8_t);
+// Max absolute value of a quantized value, deltas of such values never overflow. Other values,
+// like garbage coordinates, are stored as they are.
+double constexpr kMaxQuantized = static_cast<double>(1LL << 52);
+
+size_t constexpr kCopyBlockSize = 64 * 1024;
 
 // Writes value in memory in LittleEndian
 template <typename T>
@@ -44,22 +69,7 @@ T MemRead(void const * ptr)
   return SwapIfBigEndian(value);
 }
 
-void Pack(char * p, location::GpsInfo const & info)
-{  
-  MemWrite<double>(p + 0 * sizeof(double), info.m_timestamp);
-  MemWrite<double>(p + 1 * sizeof(double), info.m_latitude);
-  MemWrite<double>(p + 2 * sizeof(double), info.m_longitude);
-  MemWrite<double>(p + 3 * sizeof(double), info.m_altitude);
-  MemWrite<double>(p + 4 * sizeof(double), info.m_speed);
-  MemWrite<double>(p + 5 * sizeof(double), info.m_bearing);
-  MemWrite<double>(p + 6 * sizeof(double), info.m_horizontalAccuracy);
-  MemWrite<double>(p + 7 * sizeof(double), info.m_verticalAccuracy);
-  ASSERT_LESS_OR_EQUAL(static_cast<int>(info.m_source), 255, ());
-  uint8_t const source = static_cast<uint8_t>(info.m_source);
-  MemWrite<uint8_t>(p + 8 * sizeof(double), source);
-}
-
-void Unpack(char const * p, location::GpsInfo & info)
+void UnpackPlain(char const * p, location::GpsInfo & info)
 {
   info.m_timestamp = MemRead<double>(p + 0 * sizeof(double));
   info.m_latitude = MemRead<double>(p + 1 * sizeof(double));
@@ -73,15 +83,86 @@ void Unpack(char const * p, location::GpsInfo & info)
   info.m_source = static_cast<location::TLocationSource>(source);
 }
 
-inline size_t GetItemOffset(size_t itemIndex)
+using TValues = array<double, 9>;
+
+TValues ToValues(location::GpsInfo const & info)
+{
+  ASSERT_LESS_OR_EQUAL(static_cast<int>(info.m_source), 255, ());
+  return {{info.m_timestamp, info.m_latitude, info.m_longitude, info.m_altitude, info.m_speed,
+           info.m_bearing, info.m_horizontalAccuracy, info.m_verticalAccuracy,
+           static_cast<double>(info.m_source)}};
+}
+
+void FromValues(TValues const & values, location::GpsInfo & info)
 {
-  return kHeaderSize + itemIndex * kPointSize;
+  info.m_timestamp = values[0];
+  info.m_latitude = values[1];
+  info.m_longitude = values[2];
+  info.m_altitude = values[3];
+  info.m_speed = values[4];
+  info.m_bearing = values[5];
+  info.m_horizontalAccuracy = values[6];
+  info.m_verticalAccuracy = values[7];
+  info.m_source = static_cast<location::TLocationSource>(values[8]);
 }
 
-inline size_t GetItemCount(size_t fileSize)
+bool Quantize(double value, double factor, int64_t & quantized)
 {
-  ASSERT_GREATER_OR_EQUAL(fileSize, kHeaderSize, ());
-  return (fileSize - kHeaderSize) / kPointSize;
+  if (!isfinite(value))
+    return false;
+  double const q = round(value * factor);
+  if (fabs(q) > kMaxQuantized)
+    return false;
+  quantized = static_cast<int64_t>(q);
+  return true;
+}
+
+// Returns the value as it's read from the file.
+double Restore(double value, double factor)
+{
+  int64_t q = 0;
+  return Quantize(value, factor, q) ? q / factor : value;
+}
+
+// Quantized value is written as a zigzag delta against |base| shifted by one bit. A value
+// which can't be quantized is marked by the lowest bit and written as it is, |base|
+// isn't changed then.
+template <typename TSink>
+void WriteValue(TSink & sink, double value, double factor, int64_t & base)
+{
+  int64_t q = 0;
+  if (Quantize(value, factor, q))
+  {
+    WriteVarUint(sink, static_cast<uint64_t>(bits::ZigZagEncode(q - base)) << 1);
+    base = q;
+    return;
+  }
+
+  uint64_t raw;
+  static_assert(sizeof(raw) == sizeof(value), "");
+  memcpy(&raw, &value, sizeof(raw));
+  WriteVarUint(sink, static_cast<uint64_t>(1));
+  WriteToSink(sink, raw);
+}
+
+template <typename TSource>
+double ReadValue(TSource & src, double factor, int64_t & base)
+{
+  uint64_t const code = ReadVarUint<uint64_t>(src);
+  if (code & 1)
+  {
+    if (code != 1)
+      MYTHROW(GpsTrackStorage::ReadException, ("Bad value code:", code));
+    uint64_t const raw = ReadPrimitiveFromSource<uint64_t>(src);
+    double value;
+    memcpy(&value, &raw, sizeof(value));
+    return value;
+  }
+
+  // Unsigned arithmetic, so broken data can't cause an overflow.
+  auto const delta = static_cast<uint64_t>(bits::ZigZagDecode(code >> 1));
+  base = static_cast<int64_t>(static_cast<uint64_t>(base) + delta);
+  return base / factor;
 }
 
 inline bool WriteVersion(fstream & f, uint32_t version)
@@ -109,6 +190,8 @@ GpsTrackStorage::GpsTrackStorage(string const & filePath, size_t maxItemCount)
 {
   ASSERT_GREATER(m_maxItemCount, 0, ());
 
+  m_lastItem.fill(0);
+
   // Open existing file
   m_stream.open(m_filePath, ios::in | ios::out | ios::binary);
 
@@ -118,43 +201,27 @@ GpsTrackStorage::GpsTrackStorage(string const & filePath, size_t maxItemCount)
     if (!ReadVersion(m_stream, version))
       MYTHROW(OpenException, ("Read version error.", m_filePath));
 
-    if (version == kCurrentVersion)
-    {
-      // Seek to end to get file size
-      m_stream.seekp(0, ios::end);
-      if (!m_stream.good())
-        MYTHROW(OpenException, ("Seek to the end error.", m_filePath));
-
-      size_t const fileSize = m_stream.tellp();
+    // Seek to end to get file size
+    m_stream.seekg(0, ios::end);
+    if (!m_stream.good())
+      MYTHROW(OpenException, ("Seek to the end error.", m_filePath));
 
-      m_itemCount = GetItemCount(fileSize);
+    uint64_t const fileSize = m_stream.tellg();
 
-      // Set write position after last item position
-      size_t const offset = GetItemOffset(m_itemCount);
-      m_stream.seekp(offset, ios::beg);
-      if (!m_stream.good())
-        MYTHROW(OpenException, ("Seek to the offset error:", offset, m_filePath));
-    }
+    if (version == kCurrentVersion)
+      ReadChunks(fileSize);
+    else if (version == kPlainVersion)
+      MigrateFromPlainFormat(fileSize);
     else
-    {
       m_stream.close();
-      // TODO: migration for file m_filePath from version 'version' to version 'kCurrentVersion'
-      // TODO: For now we support only one version, but in future migration may be needed.
-    }
   }
 
-  if (!m_stream)
+  if (!m_stream.is_open() || !m_stream)
   {
+    m_stream.close();
     // Create new file
-    m_stream.open(m_filePath, ios::in | ios::out | ios::binary | ios::trunc);
-
-    if (!m_stream)
+    if (!CreateEmptyFile())
       MYTHROW(OpenException, ("Open file error.", m_filePath));
-
-    if (!WriteVersion(m_stream, kCurrentVersion))
-      MYTHROW(OpenException, ("Write version error.", m_filePath));
-
-    m_itemCount = 0;
   }
 }
 
@@ -170,81 +237,285 @@ void GpsTrackStorage::Append(vector<TItem> const & items)
   if (needTrunc)
     TruncFile();
 
-  // Write position must be after last item position
-  ASSERT_EQUAL(m_stream.tellp(), GetItemOffset(m_itemCount), ());
-
-  vector<char> buff(min(kItemBlockSize, items.size()) * kPointSize);
+  vector<uint8_t> buff;
   for (size_t i = 0; i < items.size();)
   {
-    size_t const n = min(items.size() - i, kItemBlockSize);
+    if (m_chunks.empty() || m_chunks.back().m_itemCount == kChunkItemCount)
+    {
+      Chunk chunk;
+      chunk.m_offset = GetEndOffset();
+      m_chunks.push_back(chunk);
+      m_lastItem.fill(0);
+    }
 
+    Chunk & chunk = m_chunks.back();
+    size_t const n = min(items.size() - i, static_cast<size_t>(kChunkItemCount - chunk.m_itemCount));
+
+    buff.clear();
+    PushBackByteSink<vector<uint8_t>> sink(buff);
     for (size_t j = 0; j < n; ++j)
-      Pack(&buff[0] + j * kPointSize, items[i + j]);
+    {
+      TValues const values = ToValues(items[i + j]);
+      for (size_t k = 0; k < values.size(); ++k)
+        WriteValue(sink, values[k], kFactors[k], m_lastItem[k]);
+    }
+    if (chunk.m_itemCount == 0)
+      chunk.m_firstTimestamp = Restore(items[i].m_timestamp, kFactors[0]);
 
-    m_stream.write(&buff[0], n * kPointSize);
+    // Payload goes first, then the header, so the header never points to unwritten data.
+    m_stream.seekp(chunk.m_offset + kChunkHeaderSize + chunk.m_payloadSize, ios::beg);
+    m_stream.write(reinterpret_cast<char const *>(buff.data()), buff.size());
     if (!m_stream.good())
       MYTHROW(WriteException, ("File:", m_filePath));
 
+    chunk.m_payloadSize += static_cast<uint32_t>(buff.size());
+    chunk.m_itemCount += static_cast<uint32_t>(n);
+    chunk.m_lastTimestamp = Restore(items[i + n - 1].m_timestamp, kFactors[0]);
+    WriteChunkHeader(chunk);
+
     i += n;
+    m_itemCount += n;
   }
 
   m_stream.flush();
   if (!m_stream.good())
     MYTHROW(WriteException, ("File:", m_filePath));
-
-  m_itemCount += items.size();
 }
 
 void GpsTrackStorage::Clear()
 {
   ASSERT(m_stream.is_open(), ());
 
-  m_itemCount = 0;
-
   m_stream.close();
 
-  m_stream.open(m_filePath, ios::in | ios::out | ios::binary | ios::trunc);
-
-  if (!m_stream)
+  if (!CreateEmptyFile())
     MYTHROW(WriteException, ("File:", m_filePath));
+}
 
-  if (!WriteVersion(m_stream, kCurrentVersion))
-    MYTHROW(WriteException, ("File:", m_filePath));
+void GpsTrackStorage::ForEach(TItemFn const & fn)
+{
+  ASSERT(m_stream.is_open(), ());
 
-  // Write position is set to the first item in the file
-  ASSERT_EQUAL(m_stream.tellp(), GetItemOffset(0), ());
+  ForEachFromChunk(GetFirstChunkIndex(), fn);
 }
 
-void GpsTrackStorage::ForEach(std::function<bool(TItem const & item)> const & fn)
+void GpsTrackStorage::ForEachInTimeRange(double from, double to, TItemFn const & fn)
 {
   ASSERT(m_stream.is_open(), ());
 
-  size_t i = GetFirstItemIndex();
+  auto const it = lower_bound(m_chunks.begin() + GetFirstChunkIndex(), m_chunks.end(), from,
+                              [](Chunk const & chunk, double timestamp)
+  {
+    return chunk.m_lastTimestamp < timestamp;
+  });
+
+  ForEachFromChunk(static_cast<size_t>(distance(m_chunks.begin(), it)),
+                   [from, to, &fn](TItem const & item)
+  {
+    if (item.m_timestamp < from)
+      return true;
+    if (item.m_timestamp > to)
+      return false;
+    return fn(item);
+  });
+}
+
+void GpsTrackStorage::ForEachSimplified(double from, double to, double minInterval,
+                                        TItemFn const & fn)
+{
+  bool hasReported = false;
+  double lastReported = 0.0;
+  ForEachInTimeRange(from, to, [&](TItem const & item)
+  {
+    if (hasReported && item.m_timestamp - lastReported < minInterval)
+      return true;
+    hasReported = true;
+    lastReported = item.m_timestamp;
+    return fn(item);
+  });
+}
+
+double GpsTrackStorage::GetLastTimestamp() const
+{
+  return m_chunks.empty() ? 0.0 : m_chunks.back().m_lastTimestamp;
+}
 
-  // Set read position to the first item
-  m_stream.seekg(GetItemOffset(i), ios::beg);
+bool GpsTrackStorage::CreateEmptyFile()
+{
+  m_stream.open(m_filePath, ios::in | ios::out | ios::binary | ios::trunc);
+
+  if (!m_stream || !WriteVersion(m_stream, kCurrentVersion))
+    return false;
+
+  m_itemCount = 0;
+  m_chunks.clear();
+  m_lastItem.fill(0);
+  return true;
+}
+
+void GpsTrackStorage::ReadChunks(uint64_t fileSize)
+{
+  uint64_t offset = kHeaderSize;
+  char header[kChunkHeaderSize];
+  while (offset + kChunkHeaderSize <= fileSize)
+  {
+    m_stream.seekg(offset, ios::beg);
+    m_stream.read(header, kChunkHeaderSize);
+    if (!m_stream.good())
+      MYTHROW(OpenException, ("Read chunk header error:", offset, m_filePath));
+
+    Chunk chunk;
+    chunk.m_offset = offset;
+    chunk.m_payloadSize = MemRead<uint32_t>(header);
+    chunk.m_itemCount = MemRead<uint32_t>(header + sizeof(uint32_t));
+    chunk.m_firstTimestamp = MemRead<double>(header + 2 * sizeof(uint32_t));
+    chunk.m_lastTimestamp = MemRead<double>(header + 2 * sizeof(uint32_t) + sizeof(double));
+
+    uint64_t const end = offset + kChunkHeaderSize + chunk.m_payloadSize;
+    if (chunk.m_itemCount == 0 || chunk.m_itemCount > kChunkItemCount || end > fileSize)
+      break;
+
+    m_chunks.push_back(chunk);
+    m_itemCount += chunk.m_itemCount;
+    offset = end;
+  }
+
+  if (!m_chunks.empty())
+  {
+    vector<TItem> items;
+    ReadChunk(m_chunks.back(), items, m_lastItem);
+  }
+
+  // A tail which is not covered by the chunks is left by an interrupted append.
+  if (offset != fileSize)
+  {
+    LOG(LWARNING, ("Broken tail of the track file is dropped:", fileSize - offset, m_filePath));
+    TruncFile();
+  }
+}
+
+void GpsTrackStorage::MigrateFromPlainFormat(uint64_t fileSize)
+{
+  size_t const itemCount = static_cast<size_t>((fileSize - kHeaderSize) / kPlainPointSize);
+  size_t i = itemCount > m_maxItemCount ? itemCount - m_maxItemCount : 0;
+
+  m_stream.seekg(kHeaderSize + i * kPlainPointSize, ios::beg);
   if (!m_stream.good())
-    MYTHROW(ReadException, ("File:", m_filePath));
+    MYTHROW(OpenException, ("File:", m_filePath));
 
-  vector<char> buff(min(kItemBlockSize, m_itemCount) * kPointSize);
-  for (; i < m_itemCount;)
+  vector<TItem> items;
+  items.reserve(itemCount - i);
+  vector<char> buff(min(kItemBlockSize, itemCount) * kPlainPointSize);
+  while (i < itemCount)
   {
-    size_t const n = min(m_itemCount - i, kItemBlockSize);
+    size_t const n = min(itemCount - i, kItemBlockSize);
 
-    m_stream.read(&buff[0], n * kPointSize);
+    m_stream.read(buff.data(), n * kPlainPointSize);
     if (!m_stream.good())
-      MYTHROW(ReadException, ("File:", m_filePath));
+      MYTHROW(OpenException, ("File:", m_filePath));
 
     for (size_t j = 0; j < n; ++j)
-    {      
-      TItem item;
-      Unpack(&buff[0] + j * kPointSize, item);
+    {
+      items.emplace_back();
+      UnpackPlain(buff.data() + j * kPlainPointSize, items.back());
+    }
+    i += n;
+  }
+
+  m_stream.close();
+  if (!CreateEmptyFile())
+    MYTHROW(OpenException, ("Open file error.", m_filePath));
+
+  Append(items);
+  LOG(LINFO, ("Track file is converted to version", kCurrentVersion, "items:", items.size()));
+}
+
+void GpsTrackStorage::WriteChunkHeader(Chunk const & chunk)
+{
+  char header[kChunkHeaderSize];
+  MemWrite<uint32_t>(header, chunk.m_payloadSize);
+  MemWrite<uint32_t>(header + sizeof(uint32_t), chunk.m_itemCount);
+  MemWrite<double>(header + 2 * sizeof(uint32_t), chunk.m_firstTimestamp);
+  MemWrite<double>(header + 2 * sizeof(uint32_t) + sizeof(double), chunk.m_lastTimestamp);
+
+  m_stream.seekp(chunk.m_offset, ios::beg);
+  m_stream.write(header, kChunkHeaderSize);
+  if (!m_stream.good())
+    MYTHROW(WriteException, ("File:", m_filePath));
+}
+
+void GpsTrackStorage::ReadChunk(Chunk const & chunk, vector<TItem> & items, TPackedItem & base)
+{
+  vector<char> buff(chunk.m_payloadSize);
+  m_stream.seekg(chunk.m_offset + kChunkHeaderSize, ios::beg);
+  m_stream.read(buff.data(), buff.size());
+  if (!m_stream.good())
+    MYTHROW(ReadException, ("File:", m_filePath));
+
+  items.resize(chunk.m_itemCount);
+  base.fill(0);
+  try
+  {
+    MemReaderWithExceptions reader(buff.data(), buff.size());
+    ReaderSource<MemReaderWithExceptions> src(reader);
+    TValues values;
+    for (auto & item : items)
+    {
+      for (size_t k = 0; k < values.size(); ++k)
+        values[k] = ReadValue(src, kFactors[k], base[k]);
+      FromValues(values, item);
+    }
+    if (src.Size() != 0)
+      MYTHROW(ReadException, ("Unexpected chunk size:", chunk.m_offset, m_filePath));
+  }
+  catch (Reader::Exception const & e)
+  {
+    MYTHROW(ReadException, ("Broken chunk:", chunk.m_offset, e.Msg(), m_filePath));
+  }
+}
+
+bool GpsTrackStorage::ForEachFromChunk(size_t chunkIndex, TItemFn const & fn)
+{
+  size_t const firstItemIndex = GetFirstItemIndex();
+  size_t index = 0;
+  for (size_t i = 0; i < chunkIndex; ++i)
+    index += m_chunks[i].m_itemCount;
+
+  vector<TItem> items;
+  TPackedItem base;
+  for (size_t i = chunkIndex; i < m_chunks.size(); ++i)
+  {
+    ReadChunk(m_chunks[i], items, base);
+    for (auto const & item : items)
+    {
+      if (index++ < firstItemIndex)
+        continue;
       if (!fn(item))
-        return;
+        return false;
     }
+  }
+  return true;
+}
 
-    i += n;
+size_t GpsTrackStorage::GetFirstChunkIndex() const
+{
+  size_t const firstItemIndex = GetFirstItemIndex();
+  size_t index = 0;
+  for (size_t i = 0; i < m_chunks.size(); ++i)
+  {
+    index += m_chunks[i].m_itemCount;
+    if (index > firstItemIndex)
+      return i;
   }
+  return m_chunks.size();
+}
+
+uint64_t GpsTrackStorage::GetEndOffset() const
+{
+  if (m_chunks.empty())
+    return kHeaderSize;
+  Chunk const & chunk = m_chunks.back();
+  return chunk.m_offset + kChunkHeaderSize + chunk.m_payloadSize;
 }
 
 void GpsTrackStorage::TruncFile()
@@ -260,31 +531,30 @@ void GpsTrackStorage::TruncFile()
   if (!WriteVersion(tmp, kCurrentVersion))
     MYTHROW(WriteException, ("File:", tmpFilePath));
 
-  size_t i = GetFirstItemIndex();
+  // Chunks are copied as they are, starting from the chunk with the first item.
+  size_t const firstChunkIndex = GetFirstChunkIndex();
+  uint64_t const begin =
+      firstChunkIndex < m_chunks.size() ? m_chunks[firstChunkIndex].m_offset : GetEndOffset();
+  uint64_t const end = GetEndOffset();
 
-  // Set read position to the first item
-  m_stream.seekg(GetItemOffset(i), ios::beg);
+  m_stream.seekg(begin, ios::beg);
   if (!m_stream.good())
     MYTHROW(ReadException, ("File:", m_filePath));
 
-  size_t newItemCount = 0;
-
-  // Copy items
-  vector<char> buff(min(kItemBlockSize, m_itemCount) * kPointSize);
-  for (; i < m_itemCount;)
+  vector<char> buff(static_cast<size_t>(min<uint64_t>(kCopyBlockSize, end - begin)));
+  for (uint64_t pos = begin; pos < end;)
   {
-    size_t const n = min(m_itemCount - i, kItemBlockSize);
+    size_t const n = static_cast<size_t>(min<uint64_t>(end - pos, kCopyBlockSize));
 
-    m_stream.read(&buff[0], n * kPointSize);
+    m_stream.read(buff.data(), n);
     if (!m_stream.good())
       MYTHROW(ReadException, ("File:", m_filePath));
 
-    tmp.write(&buff[0], n * kPointSize);
+    tmp.write(buff.data(), n);
     if (!tmp.good())
       MYTHROW(WriteException, ("File:", tmpFilePath));
 
-    i += n;
-    newItemCount += n;
+    pos += n;
   }
   buff.clear();
   buff.shrink_to_fit();
@@ -300,15 +570,18 @@ void GpsTrackStorage::TruncFile()
   }
 
   // Reopen stream
-  m_stream.open(m_filePath, ios::in | ios::out | ios::binary | ios::ate);
+  m_stream.open(m_filePath, ios::in | ios::out | ios::binary);
 
   if (!m_stream)
     MYTHROW(WriteException, ("File:", m_filePath));
 
-  m_itemCount = newItemCount;
-
-  // Write position must be after last item position (end of file)
-  ASSERT_EQUAL(m_stream.tellp(), GetItemOffset(m_itemCount), ());
+  m_chunks.erase(m_chunks.begin(), m_chunks.begin() + firstChunkIndex);
+  m_itemCount = 0;
+  for (auto & chunk : m_chunks)
+  {
+    chunk.m_offset = chunk.m_offset - begin + kHeaderSize;
+    m_itemCount += chunk.m_itemCount;
+  }
 }
 
 size_t GpsTrackStorage::GetFirstItemIndex() const
@@ -5,10 +5,12 @@
 #include "base/exception.hpp"
 #include "base/macros.hpp"
 
+#include "std/array.hpp"
 #include "std/fstream.hpp"
 #include "std/function.hpp"
 #include "std/limits.hpp"
 #include "std/string.hpp"
+#include "std/vector.hpp"
 
 class GpsTrackStorage final
 {
@@ -18,6 +20,7 @@ public:
   DECLARE_EXCEPTION(ReadException, RootException);
 
   using TItem = location::GpsInfo;
+  using TItemFn = std::function<bool(TItem const & item)>;
 
   /// Opens storage with track data.
   /// @param filePath - path to the file on disk
@@ -37,11 +40,50 @@ public:
   /// Reads the storage and calls functor for each item
   /// @param fn - callable function, return true to stop ForEach
   /// @exceptions ReadException if read fails.
-  void ForEach(std::function<bool(TItem const & item)> const & fn);
+  void ForEach(TItemFn const & fn);
+
+  /// Calls functor for each item with timestamp in [from, to].
+  /// @note Items are expected to be appended in order of timestamps, only chunks which
+  /// overlap the range are read.
+  /// @exceptions ReadException if read fails.
+  void ForEachInTimeRange(double from, double to, TItemFn const & fn);
+
+  /// The same as ForEachInTimeRange, but skips items which are less than |minInterval|
+  /// seconds after the previous reported item. It's used to get a coarse track quickly.
+  /// @exceptions ReadException if read fails.
+  void ForEachSimplified(double from, double to, double minInterval, TItemFn const & fn);
+
+  /// Returns timestamp of the last item or 0 if the storage is empty.
+  double GetLastTimestamp() const;
 
 private:
   DISALLOW_COPY_AND_MOVE(GpsTrackStorage);
 
+  // Quantized values of an item: timestamp, latitude, longitude, altitude, speed, bearing,
+  // horizontal and vertical accuracies, and source.
+  using TPackedItem = array<int64_t, 9>;
+
+  struct Chunk
+  {
+    uint64_t m_offset = 0;
+    uint32_t m_payloadSize = 0;
+    uint32_t m_itemCount = 0;
+    double m_firstTimestamp = 0.0;
+    double m_lastTimestamp = 0.0;
+  };
+
+  bool CreateEmptyFile();
+  void ReadChunks(uint64_t fileSize);
+  void MigrateFromPlainFormat(uint64_t fileSize);
+  void WriteChunkHeader(Chunk const & chunk);
+  // Reads items of |chunk|, |base| is set to quantized values of the last item.
+  void ReadChunk(Chunk const & chunk, vector<TItem> & items, TPackedItem & base);
+  // Calls |fn| for items which are not truncated, starting from the chunk |chunkIndex|.
+  // Returns false if |fn| has stopped the iteration.
+  bool ForEachFromChunk(size_t chunkIndex, TItemFn const & fn);
+  size_t GetFirstChunkIndex() const;
+  uint64_t GetEndOffset() const;
+
   void TruncFile();
   size_t GetFirstItemIndex() const;
 
@@ -50,6 +92,11 @@ private:
   fstream m_stream;
   size_t m_itemCount; // current number of items in file, read note
 
+  // Time index of the file, chunks are sorted by offsets.
+  vector<Chunk> m_chunks;
+  // Quantized values of the last item, next items of the chunk are delta encoded against them.
+  TPackedItem m_lastItem;
+
   // NOTE
   // New items append to the end of file, when file become too big, it is truncated.
   // Here 'silly window sindrome' is possible: for example max file size is 100k items,
@@ -61,4 +108,6 @@ private:
   // exceed 2 x m_maxItemCount, then second half of file - m_maxItemCount items is copying to the tmp file,
   // which replaces origin file. That means that trunc will happens only then new m_maxItemCount items will be
   // added but not every time.
+  // Items are stored in chunks, so the truncation copies whole chunks without decoding and
+  // the file may keep a little more than m_maxItemCount items, extra items are skipped on read.
 };
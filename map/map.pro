@@ -12,8 +12,10 @@ include($$ROOT_DIR/common.pri)
 
 HEADERS += \
     api_mark_point.hpp \
+    batch_service.hpp \
     benchmark_tools.hpp \
     bookmark.hpp \
+    bookmark_cache.hpp \
     bookmark_manager.hpp \
     chart_generator.hpp \
     displacement_mode_manager.hpp \
@@ -35,6 +37,7 @@ HEADERS += \
     routing_helpers.hpp \
     routing_manager.hpp \
     routing_mark.hpp \
+    startup_trace.hpp \
     taxi_delegate.hpp \
     track.hpp \
     traffic_manager.hpp \
@@ -46,8 +49,10 @@ SOURCES += \
     ../api/src/c/api-client.c \
     address_finder.cpp \
     api_mark_point.cpp \
+    batch_service.cpp \
     benchmark_tools.cpp \
     bookmark.cpp \
+    bookmark_cache.cpp \
     bookmark_manager.cpp \
     chart_generator.cpp \
     displacement_mode_manager.cpp \
@@ -70,6 +75,7 @@ SOURCES += \
     routing_helpers.cpp \
     routing_manager.cpp \
     routing_mark.cpp \
+    startup_trace.cpp \
     taxi_delegate.cpp \
     track.cpp \
     traffic_manager.cpp \
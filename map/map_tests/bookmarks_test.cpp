@@ -4,6 +4,7 @@
 
 #include "indexer/data_header.hpp"
 
+#include "map/bookmark_cache.hpp"
 #include "map/framework.hpp"
 
 #include "search/result.hpp"
@@ -210,6 +211,44 @@ UNIT_TEST(Bookmarks_ExportKML)
   cat2.reset(BookmarkCategory::CreateFromKMLFile(catFileName, framework));
   CheckBookmarks(*cat2);
   TEST(my::DeleteFileX(catFileName), ());
+  TEST(my::DeleteFileX(bookmarks::GetCacheFileName(catFileName)), ());
+}
+
+UNIT_TEST(Bookmarks_BinaryCache)
+{
+  Framework framework(kFrameworkParams);
+  df::VisualParams::Init(1.0, 1024);
+
+  BookmarkCategory cat("Default", framework);
+  TEST(cat.LoadFromKML(make_unique<MemReader>(kmlString, strlen(kmlString))), ());
+  TEST(cat.SaveToKMLFile(), ());
+
+  string const kmlFile = cat.GetFileName();
+  string const cacheFile = bookmarks::GetCacheFileName(kmlFile);
+  uint64_t size;
+  TEST(my::GetFileSize(cacheFile, size), ());
+
+  {
+    BookmarkCategory cached("", framework);
+    TEST(bookmarks::LoadCache(kmlFile, cached), ());
+    CheckBookmarks(cached);
+    TEST_EQUAL(cached.GetName(), "MapName", ());
+    TEST_EQUAL(cached.IsVisible(), false, ());
+  }
+
+  // The cache isn't used after KML is changed by someone else.
+  {
+    ofstream of(kmlFile, ios::app);
+    of << "\n";
+  }
+  {
+    BookmarkCategory cached("", framework);
+    TEST(!bookmarks::LoadCache(kmlFile, cached), ());
+    TEST_EQUAL(cached.GetUserMarkCount(), 0, ());
+  }
+
+  TEST(my::DeleteFileX(kmlFile), ());
+  TEST(my::DeleteFileX(cacheFile), ());
 }
 
 namespace
@@ -218,7 +257,10 @@ namespace
   {
     string const path = GetPlatform().SettingsDir();
     for (size_t i = 0; i < N; ++i)
+    {
       FileWriter::DeleteFileX(path + arrFiles[i] + BOOKMARKS_FILE_EXTENSION);
+      FileWriter::DeleteFileX(path + arrFiles[i] + BOOKMARKS_CACHE_FILE_EXTENSION);
+    }
   }
 
   UserMark const * GetMark(Framework & fm, m2::PointD const & pt)
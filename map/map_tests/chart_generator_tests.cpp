@@ -257,4 +257,37 @@ UNIT_TEST(GenerateChart_Test)
                230 /* expectedG */, 140 /* expectedB */, 255 /* expectedA */),
        ());
 }
+
+UNIT_TEST(CachedChartGenerator_Test)
+{
+  size_t constexpr width = 50;
+  size_t constexpr height = 50;
+  vector<double> const distanceDataM = {0.0, 100.0};
+  feature::TAltitudes altitudeDataM = {0, 1000};
+
+  CachedChartGenerator generator;
+  vector<uint8_t> expected;
+  vector<uint8_t> frameBuffer;
+  TEST(maps::GenerateChart(width, height, distanceDataM, altitudeDataM, MapStyleDark, expected), ());
+  for (size_t i = 0; i < 2; ++i)
+  {
+    TEST(generator.GenerateChart(width, height, distanceDataM, altitudeDataM, MapStyleDark,
+                                 frameBuffer),
+         ());
+    TEST_EQUAL(frameBuffer, expected, ());
+  }
+
+  // The chart is generated again for another size or route.
+  TEST(generator.GenerateChart(width, 2 * height, distanceDataM, altitudeDataM, MapStyleDark,
+                               frameBuffer),
+       ());
+  TEST_EQUAL(frameBuffer.size(), 2 * expected.size(), ());
+
+  altitudeDataM = {1000, 0};
+  TEST(maps::GenerateChart(width, height, distanceDataM, altitudeDataM, MapStyleDark, expected), ());
+  TEST(generator.GenerateChart(width, height, distanceDataM, altitudeDataM, MapStyleDark,
+                               frameBuffer),
+       ());
+  TEST_EQUAL(frameBuffer, expected, ());
+}
 }  // namespace
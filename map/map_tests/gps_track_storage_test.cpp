@@ -4,12 +4,16 @@
 
 #include "platform/platform.hpp"
 
+#include "coding/endianness.hpp"
 #include "coding/file_name_utils.hpp"
 #include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
+#include "coding/write_to_sink.hpp"
 
 #include "geometry/latlon.hpp"
 
 #include "base/logging.hpp"
+#include "base/math.hpp"
 #include "base/scope_guard.hpp"
 
 #include "std/chrono.hpp"
@@ -184,3 +188,149 @@ UNIT_TEST(GpsTrackStorage_WriteReadWithTrunc)
     TEST_EQUAL(i, 0, ());
   }
 }
+
+UNIT_TEST(GpsTrackStorage_TimeRange)
+{
+  double const timestamp = 1500000000.0;
+
+  string const filePath = GetGpsTrackFilePath();
+  MY_SCOPE_GUARD(gpsTestFileDeleter, bind(FileWriter::DeleteFileX, filePath));
+  FileWriter::DeleteFileX(filePath);
+
+  size_t const fileMaxItemCount = 10000;
+
+  vector<location::GpsInfo> points;
+  for (size_t i = 0; i < fileMaxItemCount; ++i)
+    points.emplace_back(Make(timestamp + i, ms::LatLon(55.0 + i * 1e-5, 37.0 - i * 1e-5), 5.5));
+
+  {
+    GpsTrackStorage stg(filePath, fileMaxItemCount);
+    // Small appends extend the last chunk.
+    for (size_t i = 0; i < points.size(); i += 3)
+    {
+      size_t const n = min(points.size() - i, static_cast<size_t>(3));
+      stg.Append(vector<location::GpsInfo>(points.begin() + i, points.begin() + i + n));
+    }
+    TEST_ALMOST_EQUAL_ULPS(stg.GetLastTimestamp(), points.back().m_timestamp, ());
+  }
+
+  GpsTrackStorage stg(filePath, fileMaxItemCount);
+  TEST_ALMOST_EQUAL_ULPS(stg.GetLastTimestamp(), points.back().m_timestamp, ());
+
+  size_t const from = 5000;
+  size_t const to = 5999;
+  size_t i = from;
+  stg.ForEachInTimeRange(timestamp + from, timestamp + to, [&](location::GpsInfo const & point)
+  {
+    TEST_EQUAL(point.m_timestamp, points[i].m_timestamp, ());
+    TEST(my::AlmostEqualAbs(point.m_latitude, points[i].m_latitude, 1e-7), ());
+    TEST(my::AlmostEqualAbs(point.m_longitude, points[i].m_longitude, 1e-7), ());
+    TEST_EQUAL(point.m_speed, points[i].m_speed, ());
+    TEST_EQUAL(point.m_source, points[i].m_source, ());
+    ++i;
+    return true;
+  });
+  TEST_EQUAL(i, to + 1, ());
+
+  size_t count = 0;
+  stg.ForEachSimplified(timestamp, timestamp + fileMaxItemCount, 10.0,
+                        [&](location::GpsInfo const & point)
+  {
+    TEST_EQUAL(point.m_timestamp, timestamp + count * 10, ());
+    ++count;
+    return true;
+  });
+  TEST_EQUAL(count, fileMaxItemCount / 10, ());
+
+  count = 0;
+  stg.ForEachInTimeRange(timestamp + fileMaxItemCount, timestamp + 2 * fileMaxItemCount,
+                         [&count](location::GpsInfo const &) { ++count; return true; });
+  TEST_EQUAL(count, 0, ());
+}
+
+UNIT_TEST(GpsTrackStorage_PlainFormatMigration)
+{
+  string const filePath = GetGpsTrackFilePath();
+  MY_SCOPE_GUARD(gpsTestFileDeleter, bind(FileWriter::DeleteFileX, filePath));
+  FileWriter::DeleteFileX(filePath);
+
+  size_t const fileMaxItemCount = 100;
+
+  // Version 1 stores version and then fixed size records.
+  vector<location::GpsInfo> points;
+  {
+    FileWriter writer(filePath);
+    WriteToSink(writer, static_cast<uint32_t>(1));
+    for (size_t i = 0; i < 2 * fileMaxItemCount; ++i)
+    {
+      points.emplace_back(Make(1500000000.0 + i, ms::LatLon(10.0 + i, 20.0 + i), 3.0));
+      location::GpsInfo const & p = points.back();
+      for (double v : {p.m_timestamp, p.m_latitude, p.m_longitude, p.m_altitude, p.m_speed,
+                       p.m_bearing, p.m_horizontalAccuracy, p.m_verticalAccuracy})
+      {
+        double const value = SwapIfBigEndian(v);
+        writer.Write(&value, sizeof(value));
+      }
+      WriteToSink(writer, static_cast<uint8_t>(p.m_source));
+    }
+  }
+
+  GpsTrackStorage stg(filePath, fileMaxItemCount);
+  size_t i = fileMaxItemCount;
+  stg.ForEach([&](location::GpsInfo const & point)
+  {
+    TEST_EQUAL(point.m_timestamp, points[i].m_timestamp, ());
+    TEST_EQUAL(point.m_latitude, points[i].m_latitude, ());
+    TEST_EQUAL(point.m_longitude, points[i].m_longitude, ());
+    TEST_EQUAL(point.m_horizontalAccuracy, points[i].m_horizontalAccuracy, ());
+    ++i;
+    return true;
+  });
+  TEST_EQUAL(i, points.size(), ());
+}
+
+UNIT_TEST(GpsTrackStorage_BrokenTail)
+{
+  string const filePath = GetGpsTrackFilePath();
+  MY_SCOPE_GUARD(gpsTestFileDeleter, bind(FileWriter::DeleteFileX, filePath));
+  FileWriter::DeleteFileX(filePath);
+
+  size_t const fileMaxItemCount = 1000;
+
+  vector<location::GpsInfo> points;
+  for (size_t i = 0; i < fileMaxItemCount; ++i)
+    points.emplace_back(Make(1500000000.0 + i, ms::LatLon(10.0, 20.0), 3.0));
+
+  {
+    GpsTrackStorage stg(filePath, fileMaxItemCount);
+    stg.Append(points);
+  }
+
+  // Simulates an interrupted append: bytes after the last chunk.
+  {
+    FileWriter writer(filePath, FileWriter::OP_APPEND);
+    vector<uint8_t> const garbage(100, 0xFF);
+    writer.Write(garbage.data(), garbage.size());
+  }
+
+  {
+    GpsTrackStorage stg(filePath, fileMaxItemCount);
+    size_t count = 0;
+    stg.ForEach([&count](location::GpsInfo const &) { ++count; return true; });
+    TEST_EQUAL(count, points.size(), ());
+
+    stg.Append({Make(1500000000.0 + fileMaxItemCount, ms::LatLon(10.0, 20.0), 3.0)});
+  }
+
+  GpsTrackStorage stg(filePath, fileMaxItemCount);
+  double lastTimestamp = 0.0;
+  size_t count = 0;
+  stg.ForEach([&](location::GpsInfo const & point)
+  {
+    lastTimestamp = point.m_timestamp;
+    ++count;
+    return true;
+  });
+  TEST_EQUAL(count, fileMaxItemCount, ());
+  TEST_EQUAL(lastTimestamp, 1500000000.0 + fileMaxItemCount, ());
+}
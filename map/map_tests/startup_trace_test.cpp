@@ -0,0 +1,25 @@
+#include "testing/testing.hpp"
+
+#include "map/startup_trace.hpp"
+
+#include <chrono>
+#include <thread>
+
+UNIT_TEST(StartupTrace_Stages)
+{
+  StartupTrace trace;
+  TEST(trace.GetStages().empty(), ());
+  TEST_EQUAL(trace.GetTotalSeconds(), 0.0, ());
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  trace.AddStage("First");
+  trace.AddStage("Second");
+
+  auto const & stages = trace.GetStages();
+  TEST_EQUAL(stages.size(), 2, ());
+  TEST_EQUAL(stages[0].m_name, "First", ());
+  TEST_EQUAL(stages[1].m_name, "Second", ());
+  TEST_GREATER_OR_EQUAL(stages[0].m_seconds, 0.01, ());
+  TEST_GREATER_OR_EQUAL(stages[1].m_seconds, 0.0, ());
+  TEST_ALMOST_EQUAL_ULPS(trace.GetTotalSeconds(), stages[0].m_seconds + stages[1].m_seconds, ());
+}
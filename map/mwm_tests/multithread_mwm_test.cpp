@@ -7,6 +7,10 @@
 #include "base/macros.hpp"
 #include "base/thread.hpp"
 
+#include "std/algorithm.hpp"
+#include "std/mutex.hpp"
+#include "std/vector.hpp"
+
 namespace
 {
   typedef model::FeaturesFetcher SourceT;
@@ -90,3 +94,31 @@ UNIT_TEST(Threading_ForEachFeature)
 {
   RunTest("minsk-pass");
 }
+
+UNIT_TEST(Threading_ForEachInRectParallel)
+{
+  SourceT src;
+  src.InitClassificator();
+  UNUSED_VALUE(src.RegisterMap(platform::LocalCountryFile::MakeForTesting("minsk-pass")));
+
+  m2::RectD const r = src.GetWorldRect();
+  int const scale = scales::GetUpperScale();
+
+  vector<FeatureID> expected;
+  src.GetIndex().ForEachInRect([&](FeatureType const & ft) { expected.push_back(ft.GetID()); },
+                               r, scale);
+
+  mutex featuresLock;
+  vector<FeatureID> features;
+  src.GetIndex().ForEachInRectParallel([&](FeatureType const & ft)
+                                       {
+                                         lock_guard<mutex> lock(featuresLock);
+                                         features.push_back(ft.GetID());
+                                       },
+                                       r, scale, 4 /* numThreads */);
+
+  TEST(!expected.empty(), ());
+  sort(expected.begin(), expected.end());
+  sort(features.begin(), features.end());
+  TEST_EQUAL(expected, features, ());
+}
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "3party/opening_hours/opening_hours.hpp"
+#include "indexer/opening_hours_cache.hpp"
 
 #include "std/chrono.hpp"
 
@@ -31,7 +31,7 @@ inline string DebugPrint(EPlaceState state)
 
 inline EPlaceState PlaceStateCheck(string const & openingHours, time_t timestamp)
 {
-  osmoh::OpeningHours oh(openingHours);
+  auto const oh = GetParsedOpeningHours(openingHours);
 
   auto future = system_clock::from_time_t(timestamp);
   future += minutes(15);
@@ -43,10 +43,10 @@ inline EPlaceState PlaceStateCheck(string const & openingHours, time_t timestamp
 
   // TODO(mgsergio): Switch to three-stated model instead of two-staed
   // I.e. set unknown if we can't parse or can't answer whether it's open.
-  if (oh.IsValid())
+  if (oh->IsValid())
   {
-    nowState = oh.IsOpen(timestamp) ? OPEN : CLOSED;
-    futureState = oh.IsOpen(system_clock::to_time_t(future)) ? OPEN : CLOSED;
+    nowState = oh->IsOpen(timestamp) ? OPEN : CLOSED;
+    futureState = oh->IsOpen(system_clock::to_time_t(future)) ? OPEN : CLOSED;
   }
 
   EPlaceState state[2][2] = {{EPlaceState::Open, EPlaceState::CloseSoon},
@@ -53,9 +53,12 @@ char const kRouterTypeKey[] = "router";
 double const kRouteScaleMultiplier = 1.5;
 
 string const kRoutePointsFile = "route_points.dat";
+string const kTrackingQueueFileName = "tracking_queue.dat";
 
 uint32_t constexpr kInvalidTransactionId = 0;
 
+size_t constexpr kRoadJunctionsCacheBytes = 16 * 1024 * 1024;
+
 void FillTurnsDistancesForRendering(vector<RouteSegment> const & segments,
                                     double baseDistance, vector<double> & turns)
 {
@@ -222,9 +225,11 @@ char const * const kRoutingCalculatingRoute = "Routing_CalculatingRoute";
 
 RoutingManager::RoutingManager(Callbacks && callbacks, Delegate & delegate)
   : m_callbacks(move(callbacks))
+  , m_roadJunctionsCache(make_shared<RoadJunctionsCache>(kRoadJunctionsCacheBytes))
   , m_delegate(delegate)
   , m_trackingReporter(platform::CreateSocket(), TRACKING_REALTIME_HOST, TRACKING_REALTIME_PORT,
-                       tracking::Reporter::kPushDelayMs)
+                       tracking::Reporter::kPushDelayMs,
+                       GetPlatform().WritableDir() + kTrackingQueueFileName)
 {
   auto const routingStatisticsFn = [](map<string, string> const & statistics) {
     alohalytics::LogEvent("Routing_CalculatingRoute", statistics);
@@ -393,6 +398,7 @@ void RoutingManager::SetRouterImpl(RouterType type)
                                          countryFileGetter, getMwmRectByName, numMwmIds,
                                          MakeNumMwmTree(*numMwmIds, m_callbacks.m_countryInfoGetter()),
                                          m_routingSession, index);
+  router->SetRoadJunctionsCache(m_roadJunctionsCache);
 
   m_routingSession.SetRoutingSettings(GetRoutingSettings(vehicleType));
   m_routingSession.SetRouter(move(router), move(fetcher));
@@ -949,8 +955,8 @@ bool RoutingManager::GenerateRouteAltitudeChart(uint32_t width, uint32_t height,
   if (altitudes.empty())
     return false;
 
-  if (!maps::GenerateChart(width, height, segDistance, altitudes,
-                           GetStyleReader().GetCurrentStyle(), imageRGBAData))
+  if (!m_chartGenerator.GenerateChart(width, height, segDistance, altitudes,
+                                      GetStyleReader().GetCurrentStyle(), imageRGBAData))
     return false;
 
   auto const minMaxIt = minmax_element(altitudes.cbegin(), altitudes.cend());
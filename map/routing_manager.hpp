@@ -1,8 +1,10 @@
 #pragma once
 
 #include "map/bookmark_manager.hpp"
+#include "map/chart_generator.hpp"
 #include "map/routing_mark.hpp"
 
+#include "routing/road_junctions_cache.hpp"
 #include "routing/route.hpp"
 #include "routing/routing_session.hpp"
 
@@ -280,10 +282,15 @@ private:
   df::DrapeEngineSafePtr m_drapeEngine;
   routing::RouterType m_currentRouterType = routing::RouterType::Count;
   bool m_loadAltitudes = false;
+  // Road geometry is shared by routers of all vehicle types, so it's not decoded again
+  // when the router type is changed.
+  std::shared_ptr<routing::RoadJunctionsCache> m_roadJunctionsCache;
   routing::RoutingSession m_routingSession;
   Delegate & m_delegate;
   tracking::Reporter m_trackingReporter;
   BookmarkManager * m_bmManager = nullptr;
+  // The altitude chart of the route is requested repeatedly while the route is shown.
+  mutable maps::CachedChartGenerator m_chartGenerator;
 
   std::vector<dp::DrapeID> m_drapeSubroutes;
   mutable std::mutex m_drapeSubroutesMutex;
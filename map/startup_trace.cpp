@@ -0,0 +1,37 @@
+#include "map/startup_trace.hpp"
+
+#include <sstream>
+
+using namespace std;
+
+void StartupTrace::AddStage(string const & name)
+{
+  double const now = m_timer.ElapsedSeconds();
+  m_stages.push_back({name, now - m_lastStageEnd});
+  m_lastStageEnd = now;
+}
+
+double StartupTrace::GetTotalSeconds() const
+{
+  double total = 0.0;
+  for (auto const & stage : m_stages)
+    total += stage.m_seconds;
+  return total;
+}
+
+string DebugPrint(StartupTrace::Stage const & stage)
+{
+  ostringstream os;
+  os << stage.m_name << ": " << static_cast<int>(stage.m_seconds * 1000) << " ms";
+  return os.str();
+}
+
+string DebugPrint(StartupTrace const & trace)
+{
+  ostringstream os;
+  os << "StartupTrace [total: " << static_cast<int>(trace.GetTotalSeconds() * 1000) << " ms";
+  for (auto const & stage : trace.GetStages())
+    os << ", " << DebugPrint(stage);
+  os << "]";
+  return os.str();
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "base/timer.hpp"
+
+#include <string>
+#include <vector>
+
+// Collects durations of initialization stages of the application.
+//
+// *NOTE* This class is not thread-safe.
+class StartupTrace
+{
+public:
+  struct Stage
+  {
+    std::string m_name;
+    double m_seconds;
+  };
+
+  // Adds a stage which took the time since the previous stage or since the construction.
+  void AddStage(std::string const & name);
+
+  std::vector<Stage> const & GetStages() const { return m_stages; }
+  double GetTotalSeconds() const;
+
+private:
+  my::Timer m_timer;
+  double m_lastStageEnd = 0.0;
+  std::vector<Stage> m_stages;
+};
+
+std::string DebugPrint(StartupTrace::Stage const & stage);
+std::string DebugPrint(StartupTrace const & trace);
@@ -379,7 +379,7 @@ void TrafficManager::OnTrafficDataResponse(traffic::TrafficInfo && info)
     if (!info.GetColoring().empty())
     {
       // Update cache.
-      size_t constexpr kElementSize = sizeof(traffic::TrafficInfo::RoadSegmentId) + sizeof(traffic::SpeedGroup);
+      size_t constexpr kElementSize = sizeof(traffic::TrafficInfo::Coloring::value_type);
       size_t const dataSize = info.GetColoring().size() * kElementSize;
       m_currentCacheSizeBytes += (dataSize - it->second.m_dataSize);
       it->second.m_dataSize = dataSize;
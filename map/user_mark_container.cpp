@@ -52,6 +52,12 @@ df::MarkGroupID GenerateMarkGroupId(UserMarkContainer const * cont)
   return reinterpret_cast<df::MarkGroupID>(cont);
 }
 
+m2::RectD GetPivotRect(UserMark const & mark)
+{
+  m2::PointD const & pt = mark.GetPivot();
+  return m2::RectD(pt, pt);
+}
+
 } // namespace
 
 UserMarkContainer::UserMarkContainer(double layerDepth, UserMarkType type, Framework & fm)
@@ -74,11 +80,10 @@ UserMark const * UserMarkContainer::FindMarkInRect(m2::AnyRectD const & rect, do
   if (IsVisible())
   {
     FindMarkFunctor f(&mark, d, rect);
-    for (size_t i = 0; i < m_userMarks.size(); ++i)
-    {
-      if (m_userMarks[i]->IsAvailableForSearch() && rect.IsPointInside(m_userMarks[i]->GetPivot()))
-         f(m_userMarks[i].get());
-    }
+    m_marksTree.ForEachInRect(rect.GetGlobalRect(), [&rect, &f](UserMark const * m) {
+      if (m->IsAvailableForSearch() && rect.IsPointInside(m->GetPivot()))
+        f(const_cast<UserMark *>(m));
+    });
   }
   return mark;
 }
@@ -179,8 +184,10 @@ UserMark * UserMarkContainer::CreateUserMark(m2::PointD const & ptOrg)
   // Push front an user mark.
   SetDirty();
   m_userMarks.push_front(unique_ptr<UserMark>(AllocateUserMark(ptOrg)));
-  m_createdMarks.m_marksID.push_back(m_userMarks.front()->GetId());
-  return m_userMarks.front().get();
+  UserMark * mark = m_userMarks.front().get();
+  m_marksTree.Add(mark, GetPivotRect(*mark));
+  m_createdMarks.m_marksID.push_back(mark->GetId());
+  return mark;
 }
 
 size_t UserMarkContainer::GetUserMarkCount() const
@@ -210,7 +217,19 @@ void UserMarkContainer::Clear(size_t skipCount/* = 0*/)
 {
   SetDirty();
   if (skipCount < m_userMarks.size())
-    m_userMarks.erase(m_userMarks.begin(), m_userMarks.end() - skipCount);
+  {
+    auto const end = m_userMarks.end() - skipCount;
+    if (skipCount == 0)
+    {
+      m_marksTree.Clear();
+    }
+    else
+    {
+      for (auto it = m_userMarks.begin(); it != end; ++it)
+        m_marksTree.Erase(it->get(), GetPivotRect(**it));
+    }
+    m_userMarks.erase(m_userMarks.begin(), end);
+  }
 }
 
 void UserMarkContainer::SetIsDrawable(bool isDrawable)
@@ -252,7 +271,9 @@ void UserMarkContainer::DeleteUserMark(size_t index)
   ASSERT_LESS(index, m_userMarks.size(), ());
   if (index < m_userMarks.size())
   {
-    m_removedMarks.m_marksID.push_back(m_userMarks[index]->GetId());
+    UserMark const & mark = *m_userMarks[index];
+    m_removedMarks.m_marksID.push_back(mark.GetId());
+    m_marksTree.Erase(&mark, GetPivotRect(mark));
     m_userMarks.erase(m_userMarks.begin() + index);
   }
   else
@@ -7,6 +7,7 @@
 #include "geometry/point2d.hpp"
 #include "geometry/rect2d.hpp"
 #include "geometry/any_rect2d.hpp"
+#include "geometry/tree4d.hpp"
 
 #include "std/deque.hpp"
 #include "std/bitset.hpp"
@@ -58,6 +59,16 @@ public:
   // In multiple select choose mark with min(d).
   UserMark const * FindMarkInRect(m2::AnyRectD const & rect, double & d) const;
 
+  // Calls |fn| for every mark with the pivot inside |rect|, in no particular order.
+  template <typename Fn>
+  void ForEachMarkInRect(m2::RectD const & rect, Fn && fn) const
+  {
+    m_marksTree.ForEachInRect(rect, [&rect, &fn](UserMark const * mark) {
+      if (rect.IsPointInside(mark->GetPivot()))
+        fn(mark);
+    });
+  }
+
   static void InitStaticMarks(UserMarkContainer * container);
   static PoiMarkPoint * UserMarkForPoi();
   static MyPositionMarkPoint * UserMarkForMyPostion();
@@ -104,6 +115,9 @@ private:
   bitset<4> m_flags;
   double m_layerDepth;
   TUserMarksList m_userMarks;
+  // Spatial index over pivots of |m_userMarks|. Pivots of marks in containers don't change,
+  // so it's updated only when marks are created or deleted.
+  m4::Tree<UserMark const *> m_marksTree;
   UserMarkType m_type;
   df::MarkIDCollection m_createdMarks;
   df::MarkIDCollection m_removedMarks;
@@ -4,17 +4,24 @@
 #include "software_renderer/feature_processor.hpp"
 #include "software_renderer/frame_image.hpp"
 
+#include "drape_frontend/tile_utils.hpp"
 #include "drape_frontend/visual_params.hpp"
 
 #include "geometry/mercator.hpp"
 
 #include "base/string_utils.hpp"
 
+#include "std/algorithm.hpp"
+#include "std/atomic.hpp"
 #include "std/exception.hpp"
 #include "std/fstream.hpp"
+#include "std/functional.hpp"
 #include "std/iomanip.hpp"
 #include "std/iostream.hpp"
+#include "std/mutex.hpp"
 #include "std/string.hpp"
+#include "std/thread.hpp"
+#include "std/vector.hpp"
 
 #include "3party/gflags/src/gflags/gflags.h"
 
@@ -22,6 +29,9 @@
 //----------------------------------------------------------------------------------------
 DEFINE_bool(c, false, "Read places from stdin");
 DEFINE_string(place, "", "Define place in format \"lat;lon;zoom\"");
+DEFINE_string(tiles, "", "Render all tiles of a region in format \"minLat;minLon;maxLat;maxLon;zoom\"");
+DEFINE_int32(tile_size, 256, "Tile size in pixels");
+DEFINE_int32(threads, 0, "Number of threads to render tiles, 0 means the number of cores");
 DEFINE_string(outpath, "./", "Path for output files");
 DEFINE_string(datapath, "", "Path to data directory");
 DEFINE_string(mwmpath, "", "Path to mwm files");
@@ -58,6 +68,34 @@ Place ParsePlace(string const & src)
   return p;
 }
 
+struct TilesRegion
+{
+  m2::RectD rect;
+  int zoom;
+};
+
+TilesRegion ParseTilesRegion(string const & src)
+{
+  TilesRegion r;
+  try
+  {
+    strings::SimpleTokenizer token(src, ";");
+    double const minLat = stod(*token);
+    double const minLon = stod(*(++token));
+    double const maxLat = stod(*(++token));
+    double const maxLon = stod(*(++token));
+    r.zoom = static_cast<int>(stoi(*(++token)));
+    r.rect = m2::RectD(MercatorBounds::FromLatLon(minLat, minLon),
+                       MercatorBounds::FromLatLon(maxLat, maxLon));
+  }
+  catch (exception & e)
+  {
+    cerr << "Error in [" << src << "]: " << e.what() << endl;
+    exit(1);
+  }
+  return r;
+}
+
 string FilenameSeq(string const & path)
 {
   static size_t counter = 0;
@@ -101,37 +139,46 @@ void ReleaseFrameRenderer()
 ///                   It must be equal render buffer height. For retina it's equal 2.0 * displayHeight
 /// @param symbols - configuration for symbols on the frame
 /// @param image [out] - result image
-void DrawFrame(Framework & framework,
-               m2::PointD const & center, int zoomModifier,
-               uint32_t pxWidth, uint32_t pxHeight,
-               software_renderer::FrameSymbols const & symbols,
-               software_renderer::FrameImage & image)
+/// Draws features of |index| which are visible on |screen|. The frame must be finished by
+/// CPUDrawer::EndFrame.
+/// @param bgZoom - zoom level to take the background color for.
+void DrawFeatures(software_renderer::CPUDrawer & drawer, Index const & index,
+                  ScreenBase const & screen, uint32_t pxWidth, uint32_t pxHeight, int bgZoom)
 {
-  ASSERT(IsFrameRendererInitialized(), ());
-
-  int resultZoom = -1;
-  ScreenBase screen = cpuDrawer->CalculateScreen(center, zoomModifier, pxWidth, pxHeight, symbols, resultZoom);
-  ASSERT_GREATER(resultZoom, 0, ());
-
-  uint32_t const bgColor = drule::rules().GetBgColor(resultZoom);
-  cpuDrawer->BeginFrame(pxWidth, pxHeight, dp::Extract(bgColor, 255 - (bgColor >> 24)));
+  uint32_t const bgColor = drule::rules().GetBgColor(bgZoom);
+  drawer.BeginFrame(pxWidth, pxHeight, dp::Extract(bgColor, 255 - (bgColor >> 24)));
 
   m2::RectD renderRect = m2::RectD(0, 0, pxWidth, pxHeight);
   m2::RectD selectRect;
   m2::RectD clipRect;
-  double const inflationSize = 24 * cpuDrawer->GetVisualScale();
+  double const inflationSize = 24 * drawer.GetVisualScale();
   screen.PtoG(m2::Inflate(renderRect, inflationSize, inflationSize), clipRect);
   screen.PtoG(renderRect, selectRect);
 
   uint32_t const tileSize = static_cast<uint32_t>(df::CalculateTileSize(pxWidth, pxHeight));
-  int const drawScale = df::GetDrawTileScale(screen, tileSize, cpuDrawer->GetVisualScale());
-  software_renderer::FeatureProcessor doDraw(make_ref(cpuDrawer), clipRect, screen, drawScale);
+  int const drawScale = df::GetDrawTileScale(screen, tileSize, drawer.GetVisualScale());
+  software_renderer::FeatureProcessor doDraw(make_ref(&drawer), clipRect, screen, drawScale);
 
   int const upperScale = scales::GetUpperScale();
 
-  framework.GetIndex().ForEachInRect(doDraw, selectRect, min(upperScale, drawScale));
+  index.ForEachInRect(doDraw, selectRect, min(upperScale, drawScale));
+
+  drawer.Flush();
+}
 
-  cpuDrawer->Flush();
+void DrawFrame(Framework & framework,
+               m2::PointD const & center, int zoomModifier,
+               uint32_t pxWidth, uint32_t pxHeight,
+               software_renderer::FrameSymbols const & symbols,
+               software_renderer::FrameImage & image)
+{
+  ASSERT(IsFrameRendererInitialized(), ());
+
+  int resultZoom = -1;
+  ScreenBase screen = cpuDrawer->CalculateScreen(center, zoomModifier, pxWidth, pxHeight, symbols, resultZoom);
+  ASSERT_GREATER(resultZoom, 0, ());
+
+  DrawFeatures(*cpuDrawer, framework.GetIndex(), screen, pxWidth, pxHeight, resultZoom);
   //cpuDrawer->DrawMyPosition(screen.GtoP(center));
 
   if (symbols.m_showSearchResult)
@@ -145,6 +192,13 @@ void DrawFrame(Framework & framework,
   cpuDrawer->EndFrame(image);
 }
 
+void SaveFrame(software_renderer::FrameImage const & frame, string const & filename)
+{
+  ofstream file(filename.c_str());
+  file.write(reinterpret_cast<char const *>(frame.m_data.data()), frame.m_data.size());
+  file.close();
+}
+
 void RenderPlace(Framework & framework, Place const & place, string const & filename)
 {
   software_renderer::FrameImage frame;
@@ -158,9 +212,86 @@ void RenderPlace(Framework & framework, Place const & place, string const & file
   DrawFrame(framework, MercatorBounds::FromLatLon(place.lat, place.lon),
             place.zoom - kMagicBaseScale, place.width, place.height, sym, frame);
 
-  ofstream file(filename.c_str());
-  file.write(reinterpret_cast<char const *>(frame.m_data.data()), frame.m_data.size());
-  file.close();
+  SaveFrame(frame, filename);
+}
+
+void RenderTile(software_renderer::CPUDrawer & drawer, Index const & index,
+                df::TileKey const & tileKey, uint32_t tileSize, string const & filename)
+{
+  ScreenBase screen;
+  screen.OnSize(0, 0, static_cast<int>(tileSize), static_cast<int>(tileSize));
+  screen.SetFromRect(m2::AnyRectD(tileKey.GetGlobalRect(false /* clipByDataMaxZoom */)));
+
+  software_renderer::FrameImage frame;
+  DrawFeatures(drawer, index, screen, tileSize, tileSize, tileKey.m_zoomLevel);
+  drawer.EndFrame(frame);
+  SaveFrame(frame, filename);
+}
+
+/// Renders all tiles of |region| in parallel. Every thread has its own drawer, but
+/// drawers share the glyph cache, and all of them read features from the same index.
+/// Tiles are written to disk as soon as they are rendered.
+void RenderTiles(Framework & framework, TilesRegion const & region, double visualScale)
+{
+  using namespace software_renderer;
+
+  vector<df::TileKey> tiles;
+  df::CalcTilesCoverage(region.rect, region.zoom, [&region, &tiles](int tileX, int tileY)
+  {
+    tiles.emplace_back(tileX, tileY, region.zoom);
+  });
+  if (tiles.empty())
+    return;
+
+  size_t threadsCount = FLAGS_threads > 0 ? static_cast<size_t>(FLAGS_threads)
+                                          : max(thread::hardware_concurrency(), 1u);
+  threadsCount = min(threadsCount, tiles.size());
+
+  // Drawers are created on the main thread, they load resources on creation.
+  string const resPostfix = df::VisualParams::GetResourcePostfix(visualScale);
+  CPUDrawer::Params params(resPostfix, visualScale);
+  params.m_glyphCache = CPUDrawer::CreateGlyphCache(visualScale);
+  vector<unique_ptr<CPUDrawer>> drawers;
+  for (size_t i = 0; i < threadsCount; ++i)
+    drawers.push_back(make_unique<CPUDrawer>(params));
+
+  Index const & index = framework.GetIndex();
+  uint32_t const tileSize = static_cast<uint32_t>(FLAGS_tile_size);
+  atomic<size_t> nextTile(0);
+  mutex outputMutex;
+
+  auto const renderFn = [&](CPUDrawer & drawer)
+  {
+    for (size_t i = nextTile++; i < tiles.size(); i = nextTile++)
+    {
+      df::TileKey const & tileKey = tiles[i];
+      stringstream filename;
+      filename << FLAGS_outpath << "tile_" << tileKey.m_zoomLevel << "_" << tileKey.m_x << "_"
+               << tileKey.m_y << ".png";
+      try
+      {
+        RenderTile(drawer, index, tileKey, tileSize, filename.str());
+      }
+      catch (exception & e)
+      {
+        lock_guard<mutex> lock(outputMutex);
+        cerr << "Rendering of " << filename.str() << " is failed: " << e.what() << endl;
+        continue;
+      }
+
+      lock_guard<mutex> lock(outputMutex);
+      cout << "Rendering " << DebugPrint(tileKey) << " into " << filename.str() << " is finished."
+           << endl;
+    }
+  };
+
+  vector<thread> threads;
+  for (size_t i = 1; i < threadsCount; ++i)
+    threads.emplace_back(renderFn, ref(*drawers[i]));
+  renderFn(*drawers[0]);
+
+  for (auto & t : threads)
+    t.join();
 }
 }  // namespace
 
@@ -170,9 +301,9 @@ int main(int argc, char * argv[])
       "Generate screenshots of MAPS.ME maps in chosen places, specified by coordinates and zoom.");
   google::ParseCommandLineFlags(&argc, &argv, true);
 
-  if (!FLAGS_c && FLAGS_place.empty())
+  if (!FLAGS_c && FLAGS_place.empty() && FLAGS_tiles.empty())
   {
-    cerr << "Either -c or -place must be set" << endl;
+    cerr << "Either -c, -place or -tiles must be set" << endl;
     return 1;
   }
 
@@ -199,7 +330,8 @@ int main(int argc, char * argv[])
     // This magic constant was determined in several attempts.
     // It is a scale level, basically, dpi factor. 1 means 90 or 96, it seems,
     // and with 1.1 the map looks subjectively better.
-    InitFrameRenderer(1.1 /* visualScale */);
+    double constexpr kVisualScale = 1.1;
+    InitFrameRenderer(kVisualScale);
 
     if (!FLAGS_place.empty())
       processPlace(FLAGS_place);
@@ -210,6 +342,9 @@ int main(int argc, char * argv[])
         processPlace(line);
     }
 
+    if (!FLAGS_tiles.empty())
+      RenderTiles(f, ParseTilesRegion(FLAGS_tiles), kVisualScale);
+
     ReleaseFrameRenderer();
     return 0;
   }
@@ -12,6 +12,7 @@ SOURCES += \
   openlr_model.cpp \
   openlr_model_xml.cpp \
   openlr_simple_decoder.cpp \
+  road_graph_cache.cpp \
   road_info_getter.cpp \
   road_type_checkers.cpp \
   router.cpp \
@@ -21,6 +22,7 @@ HEADERS += \
   openlr_model.hpp \
   openlr_model_xml.hpp \
   openlr_simple_decoder.hpp \
+  road_graph_cache.hpp \
   road_info_getter.hpp \
   road_type_checkers.hpp \
   router.hpp \
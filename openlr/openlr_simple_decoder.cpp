@@ -2,6 +2,7 @@
 
 #include "openlr/decoded_path.hpp"
 #include "openlr/openlr_model.hpp"
+#include "openlr/road_graph_cache.hpp"
 #include "openlr/road_info_getter.hpp"
 #include "openlr/router.hpp"
 #include "openlr/way_point.hpp"
@@ -18,7 +19,9 @@
 
 #include "base/logging.hpp"
 #include "base/math.hpp"
+#include "base/timer.hpp"
 
+#include "std/atomic.hpp"
 #include "std/fstream.hpp"
 #include "std/thread.hpp"
 
@@ -40,6 +43,8 @@ struct alignas(kCacheLineSize) Stats
     m_routeIsNotCalculated += rhs.m_routeIsNotCalculated;
     m_tightOffsets += rhs.m_tightOffsets;
     m_total += rhs.m_total;
+    m_timings.m_candidatesSeconds += rhs.m_timings.m_candidatesSeconds;
+    m_timings.m_pathSeconds += rhs.m_timings.m_pathSeconds;
   }
 
   uint32_t m_shortRoutes = 0;
@@ -48,6 +53,7 @@ struct alignas(kCacheLineSize) Stats
   uint32_t m_routeIsNotCalculated = 0;
   uint32_t m_tightOffsets = 0;
   uint32_t m_total = 0;
+  Router::Timings m_timings;
 };
 }  // namespace
 
@@ -96,18 +102,26 @@ void OpenLRSimpleDecoder::Decode(std::vector<LinearSegment> const & segments,
   size_t constexpr kBatchSize = my::LCM(a, b);
   size_t constexpr kProgressFrequency = 100;
 
-  auto worker = [&segments, &paths, kBatchSize, kProgressFrequency, kOffsetToleranceM, numThreads,
-                 this](size_t threadNum, Index const & index, Stats & stats) {
+  // Edges and road infos loaded by one thread are used by all threads.
+  SharedRoadGraphCache sharedCache;
+  // Threads take batches of segments one by one, so a thread which has got easy segments
+  // doesn't wait for the others.
+  atomic<size_t> nextBatch(0);
+
+  auto worker = [&segments, &paths, &sharedCache, &nextBatch, kBatchSize, kProgressFrequency,
+                 kOffsetToleranceM, this](size_t threadNum, Index const & index, Stats & stats) {
     FeaturesRoadGraph roadGraph(index, IRoadGraph::Mode::ObeyOnewayTag,
                                 make_unique<CarModelFactory>(m_countryParentNameGetterFn));
     RoadInfoGetter roadInfoGetter(index);
-    Router router(roadGraph, roadInfoGetter);
+    SharedRoadGraphCache::Accessor cacheAccessor(sharedCache, index);
+    Router router(roadGraph, roadInfoGetter, &cacheAccessor);
 
     size_t const numSegments = segments.size();
 
     vector<WayPoint> points;
 
-    for (size_t i = threadNum * kBatchSize; i < numSegments; i += numThreads * kBatchSize)
+    for (size_t i = nextBatch.fetch_add(kBatchSize); i < numSegments;
+         i = nextBatch.fetch_add(kBatchSize))
     {
       for (size_t j = i; j < numSegments && j < i + kBatchSize; ++j)
       {
@@ -169,8 +183,12 @@ void OpenLRSimpleDecoder::Decode(std::vector<LinearSegment> const & segments,
         }
       }
     }
+
+    stats.m_timings = router.GetTimings();
   };
 
+  my::Timer timer;
+
   vector<Stats> stats(numThreads);
   vector<thread> workers;
   for (size_t i = 1; i < numThreads; ++i)
@@ -189,5 +207,10 @@ void OpenLRSimpleDecoder::Decode(std::vector<LinearSegment> const & segments,
   LOG(LINFO, ("Short routes:", allStats.m_shortRoutes));
   LOG(LINFO, ("Ambiguous routes:", allStats.m_moreThanOneCandidate));
   LOG(LINFO, ("Path is not reconstructed:", allStats.m_zeroCanditates));
+  LOG(LINFO, ("Decoding time, seconds:", timer.ElapsedSeconds()));
+  LOG(LINFO, ("Candidates search time, thread seconds:", allStats.m_timings.m_candidatesSeconds));
+  LOG(LINFO, ("Path search time, thread seconds:", allStats.m_timings.m_pathSeconds));
+  LOG(LINFO, ("Shared road cache hits:", sharedCache.GetNumHits(), "misses:",
+              sharedCache.GetNumMisses()));
 }
 }  // namespace openlr
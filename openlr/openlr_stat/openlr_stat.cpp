@@ -18,6 +18,7 @@
 #include "coding/file_name_utils.hpp"
 
 #include "base/stl_helpers.hpp"
+#include "base/timer.hpp"
 
 #include "3party/gflags/src/gflags/gflags.h"
 #include "3party/pugixml/src/pugixml.hpp"
@@ -240,12 +241,15 @@ int main(int argc, char * argv[])
 
   auto const numThreads = static_cast<uint32_t>(FLAGS_num_threads);
 
+  my::Timer timer;
   std::vector<Index> indexes(numThreads);
   LoadIndexes(FLAGS_mwms_path, indexes);
+  LOG(LINFO, ("Loading of mwms, seconds:", timer.ElapsedSeconds()));
 
   OpenLRSimpleDecoder decoder(indexes, storage::CountryParentGetter(FLAGS_countries_filename,
                                                                     GetPlatform().ResourcesDir()));
 
+  timer.Reset();
   pugi::xml_document document;
   auto const load_result = document.load_file(FLAGS_input.data());
   if (!load_result)
@@ -255,15 +259,20 @@ int main(int argc, char * argv[])
   }
 
   auto const segments = LoadSegments(document);
+  LOG(LINFO, ("Loading of segments, seconds:", timer.ElapsedSeconds()));
 
+  timer.Reset();
   std::vector<DecodedPath> paths(segments.size());
   decoder.Decode(segments, numThreads, paths);
+  LOG(LINFO, ("Decoding, seconds:", timer.ElapsedSeconds()));
 
+  timer.Reset();
   SaveNonMatchedIds(FLAGS_non_matched_ids, paths);
   if (!FLAGS_assessment_output.empty())
     WriteAssessmentFile(FLAGS_assessment_output, document, paths);
   if (!FLAGS_spark_output.empty())
     WriteAsMappingForSpark(FLAGS_spark_output, paths);
+  LOG(LINFO, ("Writing of results, seconds:", timer.ElapsedSeconds()));
 
   return 0;
 }
@@ -0,0 +1,196 @@
+#include "openlr/road_graph_cache.hpp"
+
+#include "indexer/index.hpp"
+
+#include "platform/country_file.hpp"
+
+#include "base/assert.hpp"
+
+#include <functional>
+
+using namespace routing;
+using namespace std;
+
+namespace openlr
+{
+// static
+size_t constexpr SharedRoadGraphCache::kNumShards;
+
+// SharedRoadGraphCache::Accessor ------------------------------------------------------------------
+SharedRoadGraphCache::Accessor::Accessor(SharedRoadGraphCache & cache, Index const & index)
+  : m_cache(cache), m_index(index)
+{
+}
+
+bool SharedRoadGraphCache::Accessor::GetOutgoingEdges(Junction const & junction,
+                                                      EdgeVector & edges)
+{
+  return GetEdges(junction, true /* outgoing */, edges);
+}
+
+bool SharedRoadGraphCache::Accessor::GetIngoingEdges(Junction const & junction, EdgeVector & edges)
+{
+  return GetEdges(junction, false /* outgoing */, edges);
+}
+
+void SharedRoadGraphCache::Accessor::SetOutgoingEdges(Junction const & junction,
+                                                      EdgeVector const & edges)
+{
+  SetEdges(junction, true /* outgoing */, edges);
+}
+
+void SharedRoadGraphCache::Accessor::SetIngoingEdges(Junction const & junction,
+                                                     EdgeVector const & edges)
+{
+  SetEdges(junction, false /* outgoing */, edges);
+}
+
+bool SharedRoadGraphCache::Accessor::GetRoadInfo(FeatureID const & fid, RoadInfo & info)
+{
+  FeatureKey const key(ToMwmNumber(fid.m_mwmId), fid.m_index);
+  auto & shard = m_cache.GetShard(key);
+  {
+    lock_guard<mutex> lock(shard.m_mutex);
+    auto const it = shard.m_roadInfos.find(key);
+    if (it != shard.m_roadInfos.end())
+    {
+      info = it->second;
+      ++m_cache.m_hits;
+      return true;
+    }
+  }
+  ++m_cache.m_misses;
+  return false;
+}
+
+void SharedRoadGraphCache::Accessor::SetRoadInfo(FeatureID const & fid, RoadInfo const & info)
+{
+  FeatureKey const key(ToMwmNumber(fid.m_mwmId), fid.m_index);
+  auto & shard = m_cache.GetShard(key);
+  lock_guard<mutex> lock(shard.m_mutex);
+  shard.m_roadInfos.emplace(key, info);
+}
+
+bool SharedRoadGraphCache::Accessor::GetEdges(Junction const & junction, bool outgoing,
+                                              EdgeVector & edges)
+{
+  // Edges are copied under the lock and translated to MwmIds of |m_index| after that.
+  CachedEdges cached;
+  auto & shard = m_cache.GetShard(junction);
+  {
+    lock_guard<mutex> lock(shard.m_mutex);
+    auto const & map = outgoing ? shard.m_outgoingEdges : shard.m_ingoingEdges;
+    auto const it = map.find(junction);
+    if (it == map.end())
+    {
+      ++m_cache.m_misses;
+      return false;
+    }
+    cached = it->second;
+  }
+
+  size_t const oldSize = edges.size();
+  for (auto const & e : cached)
+  {
+    auto const & mwmId = ToMwmId(e.m_mwmNumber);
+    if (!mwmId.IsAlive())
+    {
+      // The edge has been found by a thread whose Index has more mwms.
+      edges.resize(oldSize);
+      ++m_cache.m_misses;
+      return false;
+    }
+    edges.emplace_back(FeatureID(mwmId, e.m_featureIndex), e.m_forward, e.m_segId,
+                       e.m_startJunction, e.m_endJunction);
+  }
+  ++m_cache.m_hits;
+  return true;
+}
+
+void SharedRoadGraphCache::Accessor::SetEdges(Junction const & junction, bool outgoing,
+                                              EdgeVector const & edges)
+{
+  CachedEdges cached;
+  cached.reserve(edges.size());
+  for (auto const & e : edges)
+  {
+    ASSERT(!e.IsFake(), ());
+    cached.emplace_back();
+    auto & c = cached.back();
+    c.m_mwmNumber = ToMwmNumber(e.GetFeatureId().m_mwmId);
+    c.m_featureIndex = e.GetFeatureId().m_index;
+    c.m_segId = e.GetSegId();
+    c.m_forward = e.IsForward();
+    c.m_startJunction = e.GetStartJunction();
+    c.m_endJunction = e.GetEndJunction();
+  }
+
+  auto & shard = m_cache.GetShard(junction);
+  lock_guard<mutex> lock(shard.m_mutex);
+  auto & map = outgoing ? shard.m_outgoingEdges : shard.m_ingoingEdges;
+  map.emplace(junction, move(cached));
+}
+
+uint32_t SharedRoadGraphCache::Accessor::ToMwmNumber(MwmSet::MwmId const & id)
+{
+  auto const it = m_numbers.find(id);
+  if (it != m_numbers.end())
+    return it->second;
+
+  CHECK(id.IsAlive(), ());
+  auto const number = m_cache.GetMwmNumber(id.GetInfo()->GetCountryName());
+  m_numbers.emplace(id, number);
+  if (number >= m_ids.size())
+    m_ids.resize(number + 1);
+  m_ids[number] = id;
+  return number;
+}
+
+MwmSet::MwmId const & SharedRoadGraphCache::Accessor::ToMwmId(uint32_t number)
+{
+  if (number >= m_ids.size())
+    m_ids.resize(number + 1);
+
+  auto & id = m_ids[number];
+  if (!id.IsAlive())
+  {
+    id = m_index.GetMwmIdByCountryFile(platform::CountryFile(m_cache.GetMwmName(number)));
+    if (id.IsAlive())
+      m_numbers.emplace(id, number);
+  }
+  return id;
+}
+
+// SharedRoadGraphCache ----------------------------------------------------------------------------
+SharedRoadGraphCache::Shard & SharedRoadGraphCache::GetShard(Junction const & junction)
+{
+  auto const & p = junction.GetPoint();
+  size_t const h = hash<double>()(p.x) * 31 + hash<double>()(p.y);
+  return m_shards[h % kNumShards];
+}
+
+SharedRoadGraphCache::Shard & SharedRoadGraphCache::GetShard(FeatureKey const & key)
+{
+  return m_shards[(static_cast<size_t>(key.first) * 31 + key.second) % kNumShards];
+}
+
+uint32_t SharedRoadGraphCache::GetMwmNumber(string const & name)
+{
+  lock_guard<mutex> lock(m_mwmsMutex);
+  auto const it = m_mwmNumbers.find(name);
+  if (it != m_mwmNumbers.end())
+    return it->second;
+
+  auto const number = static_cast<uint32_t>(m_mwmNames.size());
+  m_mwmNames.push_back(name);
+  m_mwmNumbers.emplace(name, number);
+  return number;
+}
+
+string SharedRoadGraphCache::GetMwmName(uint32_t number)
+{
+  lock_guard<mutex> lock(m_mwmsMutex);
+  CHECK_LESS(number, m_mwmNames.size(), ());
+  return m_mwmNames[number];
+}
+}  // namespace openlr
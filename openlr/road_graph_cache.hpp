@@ -0,0 +1,112 @@
+#pragma once
+
+#include "openlr/road_info_getter.hpp"
+
+#include "routing/road_graph.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "base/macros.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+class Index;
+
+namespace openlr
+{
+// Road graph data shared by all decoder threads: regular edges adjacent to junctions and
+// road infos of features. Decoder threads use different Index instances, so the cache
+// identifies mwms by names and each thread accesses it via an Accessor bound to its Index.
+//
+// Values are never changed after insertion, so a lookup returns the same data no matter
+// which thread has loaded it.
+class SharedRoadGraphCache final
+{
+public:
+  using EdgeVector = routing::IRoadGraph::TEdgeVector;
+  using RoadInfo = RoadInfoGetter::RoadInfo;
+
+  // *NOTE* An accessor must be used by a single thread.
+  class Accessor final
+  {
+  public:
+    Accessor(SharedRoadGraphCache & cache, Index const & index);
+
+    // Appends regular edges of |junction| to |edges|, returns false if they aren't cached.
+    bool GetOutgoingEdges(routing::Junction const & junction, EdgeVector & edges);
+    bool GetIngoingEdges(routing::Junction const & junction, EdgeVector & edges);
+    void SetOutgoingEdges(routing::Junction const & junction, EdgeVector const & edges);
+    void SetIngoingEdges(routing::Junction const & junction, EdgeVector const & edges);
+
+    bool GetRoadInfo(FeatureID const & fid, RoadInfo & info);
+    void SetRoadInfo(FeatureID const & fid, RoadInfo const & info);
+
+  private:
+    bool GetEdges(routing::Junction const & junction, bool outgoing, EdgeVector & edges);
+    void SetEdges(routing::Junction const & junction, bool outgoing, EdgeVector const & edges);
+
+    uint32_t ToMwmNumber(MwmSet::MwmId const & id);
+    // Returns a dead id when the mwm is not registered in |m_index|.
+    MwmSet::MwmId const & ToMwmId(uint32_t number);
+
+    SharedRoadGraphCache & m_cache;
+    Index const & m_index;
+    std::map<MwmSet::MwmId, uint32_t> m_numbers;
+    std::vector<MwmSet::MwmId> m_ids;
+  };
+
+  SharedRoadGraphCache() = default;
+
+  uint64_t GetNumHits() const { return m_hits; }
+  uint64_t GetNumMisses() const { return m_misses; }
+
+private:
+  struct CachedEdge
+  {
+    uint32_t m_mwmNumber = 0;
+    uint32_t m_featureIndex = 0;
+    uint32_t m_segId = 0;
+    bool m_forward = true;
+    routing::Junction m_startJunction;
+    routing::Junction m_endJunction;
+  };
+
+  using CachedEdges = std::vector<CachedEdge>;
+  using FeatureKey = std::pair<uint32_t /* mwmNumber */, uint32_t /* featureIndex */>;
+
+  // Lookups of different threads mostly go to different shards.
+  struct Shard
+  {
+    std::mutex m_mutex;
+    std::map<routing::Junction, CachedEdges> m_outgoingEdges;
+    std::map<routing::Junction, CachedEdges> m_ingoingEdges;
+    std::map<FeatureKey, RoadInfo> m_roadInfos;
+  };
+
+  static size_t constexpr kNumShards = 64;
+
+  DISALLOW_COPY_AND_MOVE(SharedRoadGraphCache);
+
+  Shard & GetShard(routing::Junction const & junction);
+  Shard & GetShard(FeatureKey const & key);
+
+  uint32_t GetMwmNumber(std::string const & name);
+  std::string GetMwmName(uint32_t number);
+
+  std::mutex m_mwmsMutex;
+  std::map<std::string, uint32_t> m_mwmNumbers;
+  std::vector<std::string> m_mwmNames;
+
+  std::array<Shard, kNumShards> m_shards;
+
+  std::atomic<uint64_t> m_hits{0};
+  std::atomic<uint64_t> m_misses{0};
+};
+}  // namespace openlr
@@ -11,6 +11,7 @@
 
 #include "base/assert.hpp"
 #include "base/math.hpp"
+#include "base/timer.hpp"
 
 #include "std/transform_iterator.hpp"
 
@@ -185,17 +186,25 @@ pair<m2::PointD, m2::PointD> Router::Edge::ToPairRev() const
 }
 
 // Router::Router ----------------------------------------------------------------------------------
-Router::Router(routing::FeaturesRoadGraph & graph, RoadInfoGetter & roadInfoGetter)
-  : m_graph(graph), m_roadInfoGetter(roadInfoGetter)
+Router::Router(routing::FeaturesRoadGraph & graph, RoadInfoGetter & roadInfoGetter,
+               SharedRoadGraphCache::Accessor * sharedCache)
+  : m_graph(graph), m_roadInfoGetter(roadInfoGetter), m_sharedCache(sharedCache)
 {
 }
 
 bool Router::Go(std::vector<WayPoint> const & points, double positiveOffsetM, double negativeOffsetM,
                 std::vector<routing::Edge> & path)
 {
-  if (!Init(points, positiveOffsetM, negativeOffsetM))
+  my::Timer timer;
+  bool const initialized = Init(points, positiveOffsetM, negativeOffsetM);
+  m_timings.m_candidatesSeconds += timer.ElapsedSeconds();
+  if (!initialized)
     return false;
-  return FindPath(path);
+
+  timer.Reset();
+  bool const found = FindPath(path);
+  m_timings.m_pathSeconds += timer.ElapsedSeconds();
+  return found;
 }
 
 bool Router::Init(std::vector<WayPoint> const & points, double positiveOffsetM, double negativeOffsetM)
@@ -432,7 +441,7 @@ bool Router::PassesRestriction(routing::Edge const & edge,
   if (edge.IsFake())
     return true;
 
-  auto const frc = m_roadInfoGetter.Get(edge.GetFeatureId()).m_frc;
+  auto const frc = GetRoadInfo(edge.GetFeatureId()).m_frc;
   return static_cast<int>(frc) <= static_cast<int>(restriction) + kFRCThreshold;
 }
 
@@ -494,17 +503,17 @@ void Router::ForEachEdge(Vertex const & u, bool outgoing, FunctionalRoadClass re
 
 void Router::GetOutgoingEdges(routing::Junction const & u, routing::IRoadGraph::TEdgeVector & edges)
 {
-  GetEdges(u, &routing::IRoadGraph::GetRegularOutgoingEdges,
+  GetEdges(u, true /* outgoing */, &routing::IRoadGraph::GetRegularOutgoingEdges,
            &routing::IRoadGraph::GetFakeOutgoingEdges, m_outgoingCache, edges);
 }
 
 void Router::GetIngoingEdges(routing::Junction const & u, routing::IRoadGraph::TEdgeVector & edges)
 {
-  GetEdges(u, &routing::IRoadGraph::GetRegularIngoingEdges,
+  GetEdges(u, false /* outgoing */, &routing::IRoadGraph::GetRegularIngoingEdges,
            &routing::IRoadGraph::GetFakeIngoingEdges, m_ingoingCache, edges);
 }
 
-void Router::GetEdges(routing::Junction const & u, RoadGraphEdgesGetter getRegular,
+void Router::GetEdges(routing::Junction const & u, bool outgoing, RoadGraphEdgesGetter getRegular,
                       RoadGraphEdgesGetter getFake,
                       std::map<routing::Junction, routing::IRoadGraph::TEdgeVector> & cache,
                       routing::IRoadGraph::TEdgeVector & edges)
@@ -513,7 +522,19 @@ void Router::GetEdges(routing::Junction const & u, RoadGraphEdgesGetter getRegul
   if (it == cache.end())
   {
     auto & es = cache[u];
-    (m_graph.*getRegular)(u, es);
+    if (!m_sharedCache)
+    {
+      (m_graph.*getRegular)(u, es);
+    }
+    else if (outgoing ? !m_sharedCache->GetOutgoingEdges(u, es)
+                      : !m_sharedCache->GetIngoingEdges(u, es))
+    {
+      (m_graph.*getRegular)(u, es);
+      if (outgoing)
+        m_sharedCache->SetOutgoingEdges(u, es);
+      else
+        m_sharedCache->SetIngoingEdges(u, es);
+    }
     edges.insert(edges.end(), es.begin(), es.end());
   }
   else
@@ -524,6 +545,18 @@ void Router::GetEdges(routing::Junction const & u, RoadGraphEdgesGetter getRegul
   (m_graph.*getFake)(u, edges);
 }
 
+RoadInfoGetter::RoadInfo Router::GetRoadInfo(FeatureID const & fid) const
+{
+  RoadInfoGetter::RoadInfo info;
+  if (m_sharedCache && m_sharedCache->GetRoadInfo(fid, info))
+    return info;
+
+  info = m_roadInfoGetter.Get(fid);
+  if (m_sharedCache)
+    m_sharedCache->SetRoadInfo(fid, info);
+  return info;
+}
+
 template <typename Fn>
 void Router::ForEachNonFakeEdge(Vertex const & u, bool outgoing, FunctionalRoadClass restriction,
                                 Fn && fn)
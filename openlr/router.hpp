@@ -1,5 +1,6 @@
 #pragma once
 
+#include "openlr/road_graph_cache.hpp"
 #include "openlr/way_point.hpp"
 
 #include "routing/road_graph.hpp"
@@ -23,11 +24,24 @@ class RoadInfoGetter;
 class Router final
 {
 public:
-  Router(routing::FeaturesRoadGraph & graph, RoadInfoGetter & roadInfoGetter);
+  // Time spent by Go() since the router was created.
+  struct Timings
+  {
+    // Search of candidate roads near way points.
+    double m_candidatesSeconds = 0.0;
+    double m_pathSeconds = 0.0;
+  };
+
+  // |sharedCache| may be null, otherwise regular edges and road infos are looked up there
+  // before they are loaded from |graph| and |roadInfoGetter|.
+  Router(routing::FeaturesRoadGraph & graph, RoadInfoGetter & roadInfoGetter,
+         SharedRoadGraphCache::Accessor * sharedCache = nullptr);
 
   bool Go(vector<WayPoint> const & points, double positiveOffsetM, double negativeOffsetM,
           vector<routing::Edge> & path);
 
+  Timings const & GetTimings() const { return m_timings; }
+
 private:
   struct Vertex final
   {
@@ -135,11 +149,13 @@ private:
 
   void GetOutgoingEdges(routing::Junction const & u, routing::IRoadGraph::TEdgeVector & edges);
   void GetIngoingEdges(routing::Junction const & u, routing::IRoadGraph::TEdgeVector & edges);
-  void GetEdges(routing::Junction const & u, RoadGraphEdgesGetter getRegular,
+  void GetEdges(routing::Junction const & u, bool outgoing, RoadGraphEdgesGetter getRegular,
                 RoadGraphEdgesGetter getFake,
                 map<routing::Junction, routing::IRoadGraph::TEdgeVector> & cache,
                 routing::IRoadGraph::TEdgeVector & edges);
 
+  RoadInfoGetter::RoadInfo GetRoadInfo(FeatureID const & fid) const;
+
   template <typename Fn>
   void ForEachNonFakeEdge(Vertex const & u, bool outgoing, FunctionalRoadClass restriction,
                           Fn && fn);
@@ -175,6 +191,8 @@ private:
   map<routing::Junction, routing::IRoadGraph::TEdgeVector> m_outgoingCache;
   map<routing::Junction, routing::IRoadGraph::TEdgeVector> m_ingoingCache;
   RoadInfoGetter & m_roadInfoGetter;
+  SharedRoadGraphCache::Accessor * m_sharedCache;
+  Timings m_timings;
 
   vector<WayPoint> m_points;
   double m_positiveOffsetM;
@@ -1,4 +1,5 @@
 #include "partners_api/booking_api.hpp"
+#include "partners_api/response_cache.hpp"
 
 #include "platform/http_client.hpp"
 #include "platform/platform.hpp"
@@ -8,11 +9,14 @@
 #include "base/get_time.hpp"
 #include "base/gmtime.hpp"
 #include "base/logging.hpp"
+#include "base/string_utils.hpp"
 #include "base/thread.hpp"
 
 #include "std/initializer_list.hpp"
 #include "std/iomanip.hpp"
 #include "std/iostream.hpp"
+#include "std/map.hpp"
+#include "std/mutex.hpp"
 #include "std/sstream.hpp"
 #include "std/utility.hpp"
 
@@ -31,20 +35,30 @@ string const kPhotoOriginalUrl = "http://aff.bstatic.com/images/hotel/max500/";
 string const kPhotoSmallUrl = "http://aff.bstatic.com/images/hotel/max300/";
 string const kSearchBaseUrl = "https://www.booking.com/search.html";
 string g_BookingUrlForTesting = "";
+// Descriptions and prices of hotels are requested on every opening of a place page.
+auto constexpr kResponseTtl = std::chrono::minutes(5);
+// Availability of hotels which were shown in a viewport.
+auto constexpr kPricesTtl = std::chrono::minutes(5);
 
 bool RunSimpleHttpRequest(bool const needAuth, string const & url, string & result)
 {
-  HttpClient request(url);
+  auto const response =
+      partners_api::http::ResponseCache::Instance().Get(url, kResponseTtl, [needAuth, &url]()
+  {
+    HttpClient request(url);
 
-  if (needAuth)
-    request.SetUserAndPassword(BOOKING_KEY, BOOKING_SECRET);
+    if (needAuth)
+      request.SetUserAndPassword(BOOKING_KEY, BOOKING_SECRET);
 
-  if (request.RunHttpRequest() && !request.WasRedirected() && request.ErrorCode() == 200)
-  {
-    result = request.ServerResponse();
-    return true;
-  }
-  return false;
+    bool const result = request.RunHttpRequest() && !request.WasRedirected();
+    return partners_api::http::Result(result, request.ErrorCode(), request.ServerResponse());
+  });
+
+  if (!response)
+    return false;
+
+  result = response.m_data;
+  return true;
 }
 
 string MakeApiUrl(string const & func, initializer_list<pair<string, string>> const & params)
@@ -200,19 +214,10 @@ void FillHotelInfo(string const & src, HotelInfo & info)
   info.m_reviews = ParseReviews(reviewsArray);
 }
 
-void FillPriceAndCurrency(string const & src, string const & currency, string & minPrice,
+void FillPriceAndCurrency(json_t * obj, string const & currency, string & minPrice,
                           string & priceCurrency)
 {
-  my::Json root(src.c_str());
-  if (!json_is_array(root.get()))
-    MYTHROW(my::Json::Exception, ("The answer must contain a json array."));
-  size_t const rootSize = json_array_size(root.get());
-
-  if (rootSize == 0)
-    return;
-
   // Read default hotel price and currency.
-  auto obj = json_array_get(root.get(), 0);
   FromJSONObject(obj, "min_price", minPrice);
   FromJSONObject(obj, "currency_code", priceCurrency);
 
@@ -238,10 +243,112 @@ void FillPriceAndCurrency(string const & src, string const & currency, string &
     }
   }
 }
+
+void FillPriceAndCurrency(string const & src, string const & currency, string & minPrice,
+                          string & priceCurrency)
+{
+  my::Json root(src.c_str());
+  if (!json_is_array(root.get()))
+    MYTHROW(my::Json::Exception, ("The answer must contain a json array."));
+  size_t const rootSize = json_array_size(root.get());
+
+  if (rootSize == 0)
+    return;
+
+  FillPriceAndCurrency(json_array_get(root.get(), 0), currency, minPrice, priceCurrency);
+}
+
+void FillPrices(string const & src, string const & currency, vector<HotelPrice> & prices)
+{
+  my::Json root(src.c_str());
+  if (!json_is_array(root.get()))
+    MYTHROW(my::Json::Exception, ("The answer must contain a json array."));
+  size_t const rootSize = json_array_size(root.get());
+
+  for (size_t i = 0; i < rootSize; ++i)
+  {
+    auto obj = json_array_get(root.get(), i);
+    HotelPrice price;
+    auto const hotelId = json_object_get(obj, "hotel_id");
+    if (json_is_integer(hotelId))
+      price.m_hotelId = strings::to_string(json_integer_value(hotelId));
+    else
+      FromJSON(hotelId, price.m_hotelId);
+    FillPriceAndCurrency(obj, currency, price.m_minPrice, price.m_currency);
+    prices.push_back(move(price));
+  }
+}
 }  // namespace
 
 namespace booking
 {
+// Availability of hotels by pairs of a hotel id and a currency. Unavailable hotels are kept
+// with an empty price, so they are not requested again while they are fresh.
+class Api::PricesCache
+{
+public:
+  // Moves available hotels to |prices| and returns ids of hotels to request.
+  vector<string> Get(vector<string> const & hotelIds, string const & currency,
+                     vector<HotelPrice> & prices)
+  {
+    auto const now = steady_clock::now();
+    vector<string> missing;
+
+    lock_guard<mutex> lock(m_mutex);
+    for (auto const & id : hotelIds)
+    {
+      auto const it = m_prices.find(make_pair(id, currency));
+      if (it == m_prices.end() || it->second.m_expirationTime <= now)
+        missing.push_back(id);
+      else if (!it->second.m_price.m_minPrice.empty())
+        prices.push_back(it->second.m_price);
+    }
+    return missing;
+  }
+
+  // Caches |prices| of available hotels, hotels of |requestedIds| which are absent in |prices|
+  // are cached as unavailable.
+  void Put(vector<string> const & requestedIds, string const & currency,
+           vector<HotelPrice> const & prices)
+  {
+    auto const now = steady_clock::now();
+    auto const expirationTime = now + kPricesTtl;
+
+    lock_guard<mutex> lock(m_mutex);
+    for (auto it = m_prices.begin(); it != m_prices.end();)
+    {
+      if (it->second.m_expirationTime <= now)
+        it = m_prices.erase(it);
+      else
+        ++it;
+    }
+
+    for (auto const & id : requestedIds)
+    {
+      auto & entry = m_prices[make_pair(id, currency)];
+      entry.m_price = {id, "" /* minPrice */, "" /* currency */};
+      entry.m_expirationTime = expirationTime;
+    }
+
+    for (auto const & price : prices)
+    {
+      auto & entry = m_prices[make_pair(price.m_hotelId, currency)];
+      entry.m_price = price;
+      entry.m_expirationTime = expirationTime;
+    }
+  }
+
+private:
+  struct Entry
+  {
+    HotelPrice m_price;
+    steady_clock::time_point m_expirationTime;
+  };
+
+  map<pair<string, string>, Entry> m_prices;
+  mutex m_mutex;
+};
+
 // static
 bool RawApi::GetHotelAvailability(string const & hotelId, string const & currency, string & result)
 {
@@ -269,6 +376,8 @@ bool RawApi::GetExtendedInfo(string const & hotelId, string const & lang, string
   return RunSimpleHttpRequest(false, os.str(), result);
 }
 
+Api::Api() : m_pricesCache(make_shared<PricesCache>()) {}
+
 string Api::GetBookHotelUrl(string const & baseUrl) const
 {
   ASSERT(!baseUrl.empty(), ());
@@ -335,6 +444,44 @@ void Api::GetMinPrice(string const & hotelId, string const & currency, GetMinPri
   });
 }
 
+void Api::GetMinPrices(vector<string> const & hotelIds, string const & currency,
+                       GetMinPricesCallback const & fn)
+{
+  auto const cache = m_pricesCache;
+  GetPlatform().RunOnNetworkThread([hotelIds, currency, fn, cache]()
+  {
+    vector<HotelPrice> prices;
+    auto const missing = cache->Get(hotelIds, currency, prices);
+
+    for (size_t i = 0; i < missing.size(); i += kMaxHotelsInAvailabilityRequest)
+    {
+      vector<string> const batch(
+          missing.begin() + i,
+          missing.begin() + min(missing.size(), i + kMaxHotelsInAvailabilityRequest));
+
+      string httpResult;
+      if (!RawApi::GetHotelAvailability(strings::JoinStrings(batch, ","), currency, httpResult))
+        continue;
+
+      vector<HotelPrice> batchPrices;
+      try
+      {
+        FillPrices(httpResult, currency, batchPrices);
+      }
+      catch (my::Json::Exception const & e)
+      {
+        LOG(LERROR, (e.Msg()));
+        continue;
+      }
+
+      cache->Put(batch, currency, batchPrices);
+      prices.insert(prices.end(), batchPrices.begin(), batchPrices.end());
+    }
+
+    fn(prices);
+  });
+}
+
 void Api::GetHotelInfo(string const & hotelId, string const & lang, GetHotelInfoCallback const & fn)
 {
   GetPlatform().RunOnNetworkThread([hotelId, lang, fn]()
@@ -47,19 +47,32 @@ struct HotelInfo
   uint32_t m_scoreCount = 0;
 };
 
+struct HotelPrice
+{
+  string m_hotelId;
+  string m_minPrice;
+  string m_currency;
+};
+
 class RawApi
 {
 public:
+  /// |hotelId| may contain up to kMaxHotelsInAvailabilityRequest ids separated by commas.
   static bool GetHotelAvailability(string const & hotelId, string const & currency, string & result);
   static bool GetExtendedInfo(string const & hotelId, string const & lang, string & result);
 };
 
 using GetMinPriceCallback = platform::SafeCallback<void(string const & hotelId, string const & price, string const & currency)>;
+using GetMinPricesCallback = platform::SafeCallback<void(vector<HotelPrice> const & prices)>;
 using GetHotelInfoCallback = platform::SafeCallback<void(HotelInfo const & hotelInfo)>;
 
+size_t constexpr kMaxHotelsInAvailabilityRequest = 100;
+
 class Api
 {
 public:
+  Api();
+
   string GetBookHotelUrl(string const & baseUrl) const;
   string GetDescriptionUrl(string const & baseUrl) const;
   string GetHotelReviewsUrl(string const & hotelId, string const & baseUrl) const;
@@ -67,10 +80,20 @@ public:
   // Real-time information methods (used for retriving rapidly changing information).
   // These methods send requests directly to Booking.
   void GetMinPrice(string const & hotelId, string const & currency, GetMinPriceCallback const & fn);
+  // Gets min prices of available hotels from |hotelIds| by batched requests. Availability of
+  // hotels is cached for a few minutes, so only new hotels are requested when a viewport is
+  // moved. |fn| is called once, unavailable hotels are omitted.
+  void GetMinPrices(vector<string> const & hotelIds, string const & currency,
+                    GetMinPricesCallback const & fn);
 
   // Static information methods (use for information that can be cached).
   // These methods use caching server to prevent Booking from being ddossed.
   void GetHotelInfo(string const & hotelId, string const & lang, GetHotelInfoCallback const & fn);
+
+private:
+  class PricesCache;
+
+  shared_ptr<PricesCache> m_pricesCache;
 };
 
 void SetBookingUrlForTesting(string const & url);
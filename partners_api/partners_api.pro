@@ -19,6 +19,7 @@ SOURCES += \
     mopub_ads.cpp \
     opentable_api.cpp \
     rb_ads.cpp \
+    response_cache.cpp \
     taxi_base.cpp \
     taxi_countries.cpp \
     taxi_engine.cpp \
@@ -38,6 +39,7 @@ HEADERS += \
     mopub_ads.hpp \
     opentable_api.hpp \
     rb_ads.hpp \
+    response_cache.hpp \
     taxi_base.hpp \
     taxi_countries.hpp \
     taxi_engine.hpp \
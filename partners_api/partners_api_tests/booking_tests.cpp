@@ -91,6 +91,33 @@ UNIT_CLASS_TEST(AsyncGuiThread, Booking_GetMinPrice)
   }
 }
 
+UNIT_CLASS_TEST(AsyncGuiThread, Booking_GetMinPrices)
+{
+  vector<string> const kHotelIds = {"98251", "10623", "98251"};  // Booking hotel ids for testing.
+  booking::Api api;
+
+  for (size_t i = 0; i < 2; ++i)
+  {
+    vector<booking::HotelPrice> prices;
+    api.GetMinPrices(kHotelIds, "" /* default currency */,
+                     [&prices](vector<booking::HotelPrice> const & p)
+                     {
+                       prices = p;
+                       testing::Notify();
+                     });
+    testing::Wait();
+
+    // Prices of the second call are taken from the cache.
+    for (auto const & price : prices)
+    {
+      TEST(find(kHotelIds.begin(), kHotelIds.end(), price.m_hotelId) != kHotelIds.end(),
+           (price.m_hotelId));
+      TEST(!price.m_minPrice.empty(), ());
+      TEST(!price.m_currency.empty(), ());
+    }
+  }
+}
+
 UNIT_CLASS_TEST(AsyncGuiThread, GetHotelInfo)
 {
   string const kHotelId = "0";  // Internal hotel id for testing.
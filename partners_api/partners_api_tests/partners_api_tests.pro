@@ -33,6 +33,7 @@ SOURCES += \
     google_tests.cpp \
     mopub_tests.cpp \
     rb_tests.cpp \
+    response_cache_tests.cpp \
     taxi_engine_tests.cpp \
     uber_tests.cpp \
     viator_tests.cpp \
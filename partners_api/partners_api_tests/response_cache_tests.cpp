@@ -0,0 +1,83 @@
+#include "testing/testing.hpp"
+
+#include "partners_api/response_cache.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace partners_api::http;
+
+namespace
+{
+Result MakeResult(bool success, std::string const & data)
+{
+  return Result(true /* result */, success ? 200 : 404, data);
+}
+
+UNIT_TEST(ResponseCache_Smoke)
+{
+  ResponseCache cache(2 /* maxResponsesCount */);
+  auto const ttl = std::chrono::hours(1);
+  size_t requestsCount = 0;
+
+  auto const result = cache.Get("a", ttl, [&requestsCount]() {
+    ++requestsCount;
+    return MakeResult(true, "first");
+  });
+  TEST(result, ());
+  TEST_EQUAL(result.m_data, "first", ());
+
+  auto const cached = cache.Get("a", ttl, [&requestsCount]() {
+    ++requestsCount;
+    return MakeResult(true, "second");
+  });
+  TEST_EQUAL(cached.m_data, "first", ());
+  TEST_EQUAL(requestsCount, 1, ());
+
+  // Failed responses are not cached.
+  TEST(!cache.Get("b", ttl, [&requestsCount]() {
+    ++requestsCount;
+    return MakeResult(false, "");
+  }), ());
+  TEST(cache.Get("b", ttl, [&requestsCount]() {
+    ++requestsCount;
+    return MakeResult(true, "b");
+  }), ());
+  TEST_EQUAL(requestsCount, 3, ());
+
+  // Expired responses are requested again.
+  cache.Get("c", std::chrono::seconds(0), []() { return MakeResult(true, "old"); });
+  TEST_EQUAL(cache.Get("c", ttl, []() { return MakeResult(true, "new"); }).m_data, "new", ());
+
+  cache.Clear();
+  TEST_EQUAL(cache.Get("a", ttl, []() { return MakeResult(true, "third"); }).m_data, "third",
+             ());
+}
+
+UNIT_TEST(ResponseCache_CoalescedRequests)
+{
+  ResponseCache cache(2 /* maxResponsesCount */);
+  std::atomic<size_t> requestsCount(0);
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 4; ++i)
+  {
+    threads.emplace_back([&cache, &requestsCount]() {
+      auto const result = cache.Get("key", std::chrono::hours(1), [&requestsCount]() {
+        ++requestsCount;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        return MakeResult(true, "data");
+      });
+      TEST_EQUAL(result.m_data, "data", ());
+    });
+  }
+
+  for (auto & thread : threads)
+    thread.join();
+
+  TEST_EQUAL(requestsCount, 1, ());
+}
+}  // namespace
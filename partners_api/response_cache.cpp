@@ -0,0 +1,98 @@
+#include "partners_api/response_cache.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace
+{
+size_t constexpr kMaxResponsesCount = 128;
+}  // namespace
+
+namespace partners_api
+{
+namespace http
+{
+ResponseCache::ResponseCache(size_t maxResponsesCount) : m_maxResponsesCount(maxResponsesCount) {}
+
+// static
+ResponseCache & ResponseCache::Instance()
+{
+  static ResponseCache instance(kMaxResponsesCount);
+  return instance;
+}
+
+Result ResponseCache::Get(std::string const & key, Clock::duration ttl, Request const & request)
+{
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+      auto const it = m_responses.find(key);
+      if (it != m_responses.end() && Clock::now() < it->second.m_expirationTime)
+        return it->second.m_result;
+
+      if (m_runningRequests.find(key) == m_runningRequests.end())
+        break;
+
+      m_requestFinished.wait(lock);
+    }
+    m_runningRequests.insert(key);
+  }
+
+  Result result(false, platform::HttpClient::kNoError, std::string());
+  try
+  {
+    result = request();
+  }
+  catch (...)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_runningRequests.erase(key);
+    m_requestFinished.notify_all();
+    throw;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_runningRequests.erase(key);
+  if (result)
+  {
+    auto const now = Clock::now();
+    EvictResponses(now);
+    m_responses.erase(key);
+    m_responses.emplace(key, Response{result, now + ttl});
+  }
+  m_requestFinished.notify_all();
+  return result;
+}
+
+void ResponseCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_responses.clear();
+}
+
+void ResponseCache::EvictResponses(Clock::time_point now)
+{
+  for (auto it = m_responses.begin(); it != m_responses.end();)
+  {
+    if (it->second.m_expirationTime <= now)
+      it = m_responses.erase(it);
+    else
+      ++it;
+  }
+
+  if (m_responses.size() < m_maxResponsesCount)
+    return;
+
+  std::vector<std::pair<Clock::time_point, std::string>> expirationTimes;
+  expirationTimes.reserve(m_responses.size());
+  for (auto const & response : m_responses)
+    expirationTimes.emplace_back(response.second.m_expirationTime, response.first);
+  std::sort(expirationTimes.begin(), expirationTimes.end());
+
+  for (size_t i = 0; m_responses.size() >= m_maxResponsesCount; ++i)
+    m_responses.erase(expirationTimes[i].second);
+}
+}  // namespace http
+}  // namespace partners_api
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "partners_api/utils.hpp"
+
+#include "base/macros.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace partners_api
+{
+namespace http
+{
+// Cache of responses of partners, whose requests are repeated on every opening of a place page.
+// Only successful responses are cached. Identical requests which are run at the same time are
+// coalesced: the first one goes to the network and the others wait for its result.
+//
+// NOTE: this class is thread-safe.
+class ResponseCache
+{
+public:
+  using Clock = std::chrono::steady_clock;
+  using Request = std::function<Result()>;
+
+  explicit ResponseCache(size_t maxResponsesCount);
+
+  static ResponseCache & Instance();
+
+  // Returns a response which is cached for |key| or runs |request| and caches its response
+  // for |ttl|. |key| must identify a request completely, a url of a GET request for example.
+  Result Get(std::string const & key, Clock::duration ttl, Request const & request);
+
+  void Clear();
+
+private:
+  struct Response
+  {
+    Result m_result;
+    Clock::time_point m_expirationTime;
+  };
+
+  // Removes expired responses and the earliest expiring ones if the cache is full.
+  void EvictResponses(Clock::time_point now);
+
+  size_t const m_maxResponsesCount;
+
+  std::map<std::string, Response> m_responses;
+  std::set<std::string> m_runningRequests;
+  std::mutex m_mutex;
+  std::condition_variable m_requestFinished;
+
+  DISALLOW_COPY_AND_MOVE(ResponseCache);
+};
+}  // namespace http
+}  // namespace partners_api
@@ -1,4 +1,5 @@
 #include "partners_api/uber_api.hpp"
+#include "partners_api/response_cache.hpp"
 #include "partners_api/utils.hpp"
 
 #include "platform/platform.hpp"
@@ -19,15 +20,19 @@ using namespace platform;
 
 namespace
 {
+// Estimates are requested for the same place by every rebuilding of a taxi route.
+auto constexpr kResponseTtl = std::chrono::seconds(30);
+
 bool RunSimpleHttpRequest(std::string const & url, std::string & result)
 {
-  platform::HttpClient request(url);
-  if (request.RunHttpRequest() && !request.WasRedirected() && request.ErrorCode() == 200)
-  {
-    result = request.ServerResponse();
-    return true;
-  }
-  return false;
+  auto const response = partners_api::http::ResponseCache::Instance().Get(
+      url, kResponseTtl, [&url]() { return partners_api::http::RunSimpleRequest(url); });
+
+  if (!response)
+    return false;
+
+  result = response.m_data;
+  return true;
 }
 
 bool CheckUberResponse(json_t const * answer)
@@ -1,4 +1,5 @@
 #include "partners_api/viator_api.hpp"
+#include "partners_api/response_cache.hpp"
 
 #include "platform/http_client.hpp"
 #include "platform/platform.hpp"
@@ -89,20 +90,28 @@ std::string GetAccountId()
   return GetId(kAccountIds);
 }
 
+// Top products of a destination are changed rarely.
+auto constexpr kResponseTtl = std::chrono::minutes(10);
+
 bool RunSimpleHttpRequest(std::string const & url, std::string const & bodyData,
                           std::string & result)
 {
-  HttpClient request(url);
-  request.SetHttpMethod("POST");
-
-  request.SetBodyData(bodyData, "application/json");
-  if (request.RunHttpRequest() && !request.WasRedirected() && request.ErrorCode() == 200)
+  auto const response = partners_api::http::ResponseCache::Instance().Get(
+      url + '\n' + bodyData, kResponseTtl, [&url, &bodyData]()
   {
-    result = request.ServerResponse();
-    return true;
-  }
+    HttpClient request(url);
+    request.SetHttpMethod("POST");
+
+    request.SetBodyData(bodyData, "application/json");
+    bool const result = request.RunHttpRequest() && !request.WasRedirected();
+    return partners_api::http::Result(result, request.ErrorCode(), request.ServerResponse());
+  });
+
+  if (!response)
+    return false;
 
-  return false;
+  result = response.m_data;
+  return true;
 }
 
 std::string MakeSearchProductsRequest(int destId, std::string const & currency, int count)
@@ -1,4 +1,5 @@
 #include "partners_api/yandex_api.hpp"
+#include "partners_api/response_cache.hpp"
 
 #include "platform/http_client.hpp"
 #include "platform/platform.hpp"
@@ -20,18 +21,27 @@
 
 namespace
 {
+// Estimates are requested for the same place by every rebuilding of a taxi route.
+auto constexpr kResponseTtl = std::chrono::seconds(30);
+
 bool RunSimpleHttpRequest(std::string const & url, std::string & result)
 {
-  platform::HttpClient request(url);
-  request.SetRawHeader("Accept", "application/json");
-  request.SetRawHeader("YaTaxi-Api-Key", YANDEX_API_KEY);
-  if (request.RunHttpRequest() && !request.WasRedirected() && request.ErrorCode() == 200)
+  auto const response =
+      partners_api::http::ResponseCache::Instance().Get(url, kResponseTtl, [&url]()
   {
-    result = request.ServerResponse();
-    return true;
-  }
+    platform::HttpClient request(url);
+    request.SetRawHeader("Accept", "application/json");
+    request.SetRawHeader("YaTaxi-Api-Key", YANDEX_API_KEY);
+
+    bool const result = request.RunHttpRequest() && !request.WasRedirected();
+    return partners_api::http::Result(result, request.ErrorCode(), request.ServerResponse());
+  });
 
-  return false;
+  if (!response)
+    return false;
+
+  result = response.m_data;
+  return true;
 }
 
 bool CheckYandexResponse(json_t const * answer)
@@ -0,0 +1,173 @@
+#include "platform/async_file_writer.hpp"
+
+#include "base/logging.hpp"
+#include "base/macros.hpp"
+
+#include "std/cerrno.hpp"
+#include "std/cstring.hpp"
+#include "std/target_os.hpp"
+#include "std/utility.hpp"
+
+#if defined(OMIM_OS_LINUX) || (defined(OMIM_OS_ANDROID) && __ANDROID_API__ >= 21)
+#define USE_FALLOCATE
+#include <fcntl.h>
+#include <linux/falloc.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+// Max size of data which is queued but is not written yet. Write() blocks when
+// it's exceeded, so memory is not exhausted when network is faster than disk.
+size_t constexpr kMaxQueuedBytes = 8 * 1024 * 1024;
+
+void Preallocate(string const & filePath, uint64_t size)
+{
+#ifdef USE_FALLOCATE
+  if (size == 0)
+    return;
+
+  // Unlike posix_fallocate(), fallocate() never falls back to writing zeroes,
+  // which is as slow as writing the file itself on a device.
+  int const fd = open(filePath.c_str(), O_WRONLY);
+  if (fd < 0)
+    return;
+  if (fallocate(fd, FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t>(size)) != 0)
+    LOG(LDEBUG, ("Can't preallocate", size, "bytes for", filePath, strerror(errno)));
+  close(fd);
+#else
+  UNUSED_VALUE(filePath);
+  UNUSED_VALUE(size);
+#endif
+}
+}  // namespace
+
+namespace downloader
+{
+AsyncFileWriter::AsyncFileWriter(string const & filePath, FileWriter::Op op, uint64_t reserveSize)
+  : m_writer(new FileWriter(filePath, op))
+{
+  m_thread = threads::SimpleThread(&AsyncFileWriter::ThreadRoutine, this, reserveSize);
+}
+
+AsyncFileWriter::~AsyncFileWriter() { Close(); }
+
+bool AsyncFileWriter::Write(int64_t offset, void const * buffer, size_t size)
+{
+  ASSERT(!m_closed, ());
+
+  Block block;
+  block.m_offset = offset;
+  block.m_data.assign(static_cast<char const *>(buffer), static_cast<char const *>(buffer) + size);
+
+  unique_lock<mutex> lock(m_mutex);
+  // A block which is larger than the limit is queued when the queue is empty.
+  m_cv.wait(lock, [&]() {
+    return m_failed || m_queuedBytes == 0 || m_queuedBytes + size <= kMaxQueuedBytes;
+  });
+  if (m_failed)
+    return false;
+
+  m_queuedBytes += size;
+  m_blocks.push_back(move(block));
+  m_cv.notify_all();
+  return true;
+}
+
+void AsyncFileWriter::SetCheckpoint(Checkpoint && checkpoint)
+{
+  ASSERT(!m_closed, ());
+
+  lock_guard<mutex> lock(m_mutex);
+  m_checkpoint = move(checkpoint);
+  m_cv.notify_all();
+}
+
+bool AsyncFileWriter::Close()
+{
+  if (m_closed)
+    return !m_failed;
+  m_closed = true;
+
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_closing = true;
+    m_cv.notify_all();
+  }
+  m_thread.join();
+
+  try
+  {
+    m_writer.reset();
+  }
+  catch (Writer::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't close file correctly", e.Msg()));
+    m_failed = true;
+  }
+  return !m_failed;
+}
+
+void AsyncFileWriter::ThreadRoutine(uint64_t reserveSize)
+{
+  Preallocate(m_writer->GetName(), reserveSize);
+
+  while (true)
+  {
+    deque<Block> blocks;
+    Checkpoint checkpoint;
+    {
+      unique_lock<mutex> lock(m_mutex);
+      m_cv.wait(lock, [this]() { return m_closing || !m_blocks.empty() || m_checkpoint; });
+
+      // Everything queued so far is written as a single batch, so a checkpoint
+      // is run at most once per batch whatever the number of SetCheckpoint() calls.
+      blocks.swap(m_blocks);
+      checkpoint.swap(m_checkpoint);
+      if (blocks.empty() && !checkpoint)
+        return;
+    }
+
+    WriteBlocks(blocks, checkpoint);
+
+    size_t bytes = 0;
+    for (auto const & block : blocks)
+      bytes += block.m_data.size();
+
+    lock_guard<mutex> lock(m_mutex);
+    m_queuedBytes -= bytes;
+    m_cv.notify_all();
+  }
+}
+
+void AsyncFileWriter::WriteBlocks(deque<Block> const & blocks, Checkpoint & checkpoint)
+{
+  {
+    lock_guard<mutex> lock(m_mutex);
+    if (m_failed)
+      return;
+  }
+
+  try
+  {
+    for (auto const & block : blocks)
+    {
+      m_writer->Seek(block.m_offset);
+      m_writer->Write(block.m_data.data(), block.m_data.size());
+    }
+
+    // Data must be in the file before a checkpoint refers to it.
+    if (checkpoint)
+    {
+      m_writer->Flush();
+      checkpoint();
+    }
+  }
+  catch (Writer::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't write to", m_writer->GetName(), e.Msg()));
+    lock_guard<mutex> lock(m_mutex);
+    m_failed = true;
+  }
+}
+}  // namespace downloader
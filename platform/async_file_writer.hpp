@@ -0,0 +1,73 @@
+#pragma once
+
+#include "coding/file_writer.hpp"
+
+#include "base/macros.hpp"
+#include "base/thread.hpp"
+
+#include "std/condition_variable.hpp"
+#include "std/cstdint.hpp"
+#include "std/deque.hpp"
+#include "std/function.hpp"
+#include "std/mutex.hpp"
+#include "std/string.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
+
+namespace downloader
+{
+/// Writes downloaded data to a file on a dedicated thread, so a thread which
+/// receives data from network is not stalled by a slow disk.
+///
+/// NOTE: all public methods must be called from the same thread.
+class AsyncFileWriter
+{
+public:
+  using Checkpoint = function<void()>;
+
+  /// Opens |filePath| and preallocates |reserveSize| bytes for it when the file
+  /// system supports it. The size of the file is not changed by preallocation.
+  /// Throws Writer::Exception when the file can't be opened.
+  AsyncFileWriter(string const & filePath, FileWriter::Op op, uint64_t reserveSize);
+  ~AsyncFileWriter();
+
+  /// Queues |size| bytes from |buffer| to be written at |offset|. Blocks while
+  /// too much data is queued.
+  /// @return false if any of previous writes has failed.
+  bool Write(int64_t offset, void const * buffer, size_t size);
+
+  /// Queues |checkpoint| to be run on the writer thread after all data queued
+  /// before is written and flushed. Checkpoints which are queued faster than
+  /// the disk goes are batched, i.e. only the latest of them is run.
+  void SetCheckpoint(Checkpoint && checkpoint);
+
+  /// Writes all queued data, runs the pending checkpoint and closes the file.
+  /// @return false if any of writes has failed.
+  bool Close();
+
+private:
+  struct Block
+  {
+    int64_t m_offset;
+    vector<char> m_data;
+  };
+
+  void ThreadRoutine(uint64_t reserveSize);
+  void WriteBlocks(deque<Block> const & blocks, Checkpoint & checkpoint);
+
+  unique_ptr<FileWriter> m_writer;
+
+  mutex m_mutex;
+  condition_variable m_cv;
+  deque<Block> m_blocks;
+  size_t m_queuedBytes = 0;
+  Checkpoint m_checkpoint;
+  bool m_failed = false;
+  bool m_closing = false;
+
+  threads::SimpleThread m_thread;
+  bool m_closed = false;
+
+  DISALLOW_COPY_AND_MOVE(AsyncFileWriter);
+};
+}  // namespace downloader
@@ -12,11 +12,19 @@
 namespace downloader
 {
 
-ChunksDownloadStrategy::ChunksDownloadStrategy(vector<string> const & urls)
+ChunksDownloadStrategy::ChunksDownloadStrategy(vector<string> const & urls,
+                                               size_t connectionsPerServer)
 {
-  // init servers list
-  for (size_t i = 0; i < urls.size(); ++i)
-    m_servers.push_back(ServerT(urls[i], SERVER_READY));
+  ASSERT_GREATER(connectionsPerServer, 0, ());
+
+  // Init servers list. Every connection is a separate server entry, entries are interleaved
+  // so the first chunks go to different servers. A failed connection is removed alone, other
+  // connections of the same server are removed when they fail too.
+  for (size_t c = 0; c < connectionsPerServer; ++c)
+  {
+    for (size_t i = 0; i < urls.size(); ++i)
+      m_servers.push_back(ServerT(urls[i], SERVER_READY));
+  }
 }
 
 pair<ChunksDownloadStrategy::ChunkT *, int>
@@ -58,7 +58,9 @@ private:
   pair<ChunkT *, int> GetChunk(RangeT const & range);
 
 public:
-  ChunksDownloadStrategy(vector<string> const & urls);
+  /// @param[in]  connectionsPerServer  Number of chunks which are downloaded from every server
+  ///                                   simultaneously.
+  ChunksDownloadStrategy(vector<string> const & urls, size_t connectionsPerServer = 1);
 
   /// Init chunks vector for fileSize.
   void InitChunks(int64_t fileSize, int64_t chunkSize, ChunkStatusT status = CHUNK_FREE);
@@ -74,6 +76,7 @@ public:
   /// @returns url of the chunk
   string ChunkFinished(bool success, RangeT const & range);
 
+  /// @return Number of alive connections to all servers.
   size_t ActiveServersCount() const { return m_servers.size(); }
 
   enum ResultT
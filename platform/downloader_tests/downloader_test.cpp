@@ -14,6 +14,7 @@
 #include "base/logging.hpp"
 #include "base/std_serialization.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/bind.hpp"
 #include "std/unique_ptr.hpp"
 
@@ -330,6 +331,50 @@ UNIT_TEST(ChunksDownloadStrategyFAIL)
   TEST_EQUAL(strategy.NextChunk(s2, r2), ChunksDownloadStrategy::EDownloadFailed, ());
 }
 
+UNIT_TEST(ChunksDownloadStrategyConnectionsPerServer)
+{
+  string const S1 = "UrlOfServer1";
+  string const S2 = "UrlOfServer2";
+
+  typedef pair<int64_t, int64_t> RangeT;
+
+  vector<string> servers;
+  servers.push_back(S1);
+  servers.push_back(S2);
+
+  int64_t const FILE_SIZE = 1000;
+  int64_t const CHUNK_SIZE = 100;
+  ChunksDownloadStrategy strategy(servers, 2 /* connectionsPerServer */);
+  strategy.InitChunks(FILE_SIZE, CHUNK_SIZE);
+  TEST_EQUAL(strategy.ActiveServersCount(), 4, ());
+
+  vector<string> urls(4);
+  vector<RangeT> ranges(4);
+  for (size_t i = 0; i < urls.size(); ++i)
+    TEST_EQUAL(strategy.NextChunk(urls[i], ranges[i]), ChunksDownloadStrategy::ENextChunk, (i));
+
+  string sEmpty;
+  RangeT rEmpty;
+  TEST_EQUAL(strategy.NextChunk(sEmpty, rEmpty), ChunksDownloadStrategy::ENoFreeServers, ());
+
+  // First chunks go to different servers.
+  TEST_EQUAL(urls[0], S1, ());
+  TEST_EQUAL(urls[1], S2, ());
+  TEST_EQUAL(count(urls.begin(), urls.end(), S1), 2, ());
+
+  // Failure removes only one connection of the server.
+  strategy.ChunkFinished(false, ranges[0]);
+  TEST_EQUAL(strategy.ActiveServersCount(), 3, ());
+  TEST_EQUAL(strategy.NextChunk(sEmpty, rEmpty), ChunksDownloadStrategy::ENoFreeServers, ());
+
+  strategy.ChunkFinished(true, ranges[2]);
+  string s;
+  RangeT r;
+  TEST_EQUAL(strategy.NextChunk(s, r), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(s, S1, ());
+  TEST_EQUAL(r, ranges[0], ());
+}
+
 namespace
 {
   string ReadFileAsString(string const & file)
@@ -1,3 +1,4 @@
+#include "platform/async_file_writer.hpp"
 #include "platform/chunks_download_strategy.hpp"
 #include "platform/http_request.hpp"
 #include "platform/http_thread_callback.hpp"
@@ -10,7 +11,6 @@
 #endif
 
 #include "coding/internal/file_data.hpp"
-#include "coding/file_writer.hpp"
 
 #include "base/logging.hpp"
 #include "base/string_utils.hpp"
@@ -152,7 +152,7 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
   ThreadsContainerT m_threads;
 
   string m_filePath;
-  unique_ptr<FileWriter> m_writer;
+  unique_ptr<AsyncFileWriter> m_writer;
 
   size_t m_goodChunksCount;
   bool m_doCleanProgressFiles;
@@ -203,32 +203,24 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
     ASSERT_EQUAL(id, threads::GetCurrentThreadID(), ("OnWrite called from different threads"));
 #endif
 
-    try
-    {
-      m_writer->Seek(offset);
-      m_writer->Write(buffer, size);
+    // Data is written on the writer thread, the failure of one of previous writes is returned.
+    if (m_writer->Write(offset, buffer, size))
       return true;
-    }
-    catch (Writer::Exception const & e)
-    {
-      LOG(LWARNING, ("Can't write buffer for size", size, e.Msg()));
-      return false;
-    }
+
+    LOG(LWARNING, ("Can't write buffer for size", size));
+    return false;
   }
 
   void SaveResumeChunks()
   {
-    try
-    {
-      // Flush writer before saving downloaded chunks.
-      m_writer->Flush();
-
-      m_strategy.SaveChunks(m_progress.second, m_filePath + RESUME_FILE_EXTENSION);
-    }
-    catch (Writer::Exception const & e)
-    {
-      LOG(LWARNING, ("Can't flush writer", e.Msg()));
-    }
+    // Downloaded chunks are saved on the writer thread after the data of these
+    // chunks is flushed, so a snapshot of the strategy is passed there.
+    ChunksDownloadStrategy strategy = m_strategy;
+    int64_t const fileSize = m_progress.second;
+    string const resumeFile = m_filePath + RESUME_FILE_EXTENSION;
+    m_writer->SetCheckpoint([strategy, fileSize, resumeFile]() mutable {
+      strategy.SaveChunks(fileSize, resumeFile);
+    });
   }
 
   /// Called for each chunk by one main (GUI) thread.
@@ -306,23 +298,16 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
 
   void CloseWriter()
   {
-    try
-    {
-      m_writer.reset();
-    }
-    catch (Writer::Exception const & e)
-    {
-      LOG(LWARNING, ("Can't close file correctly", e.Msg()));
-
+    if (!m_writer->Close())
       m_status = EFailed;
-    }
   }
 
 public:
   FileHttpRequest(vector<string> const & urls, string const & filePath, int64_t fileSize,
                   CallbackT const & onFinish, CallbackT const & onProgress,
-                  int64_t chunkSize, bool doCleanProgressFiles)
-    : HttpRequest(onFinish, onProgress), m_strategy(urls), m_filePath(filePath),
+                  int64_t chunkSize, bool doCleanProgressFiles, size_t connectionsPerServer)
+    : HttpRequest(onFinish, onProgress), m_strategy(urls, connectionsPerServer),
+      m_filePath(filePath),
       m_goodChunksCount(0), m_doCleanProgressFiles(doCleanProgressFiles)
   {
     ASSERT ( !urls.empty(), () );
@@ -343,10 +328,10 @@ public:
         m_strategy.InitChunks(fileSize, chunkSize);
     }
 
-    // Create file and reserve needed size.
-    unique_ptr<FileWriter> writer(new FileWriter(filePath + DOWNLOADING_FILE_EXTENSION, openMode));
-    // Reserving disk space is very slow on a device.
-    //writer->Reserve(fileSize);
+    // Create file and reserve needed size. Disk space is preallocated on the writer
+    // thread and only where it's cheap, because writing zeroes is very slow on a device.
+    unique_ptr<AsyncFileWriter> writer(
+        new AsyncFileWriter(filePath + DOWNLOADING_FILE_EXTENSION, openMode, fileSize));
 
     // Assign here, because previous functions can throw an exception.
     m_writer.swap(writer);
@@ -413,11 +398,13 @@ HttpRequest * HttpRequest::PostJson(string const & url, string const & postData,
 HttpRequest * HttpRequest::GetFile(vector<string> const & urls,
                                    string const & filePath, int64_t fileSize,
                                    CallbackT const & onFinish, CallbackT const & onProgress,
-                                   int64_t chunkSize, bool doCleanOnCancel)
+                                   int64_t chunkSize, bool doCleanOnCancel,
+                                   size_t connectionsPerServer)
 {
   try
   {
-    return new FileHttpRequest(urls, filePath, fileSize, onFinish, onProgress, chunkSize, doCleanOnCancel);
+    return new FileHttpRequest(urls, filePath, fileSize, onFinish, onProgress, chunkSize,
+                               doCleanOnCancel, connectionsPerServer);
   }
   catch (FileWriter::Exception const & e)
   {
@@ -78,6 +78,7 @@ linux*|win* {
 # common sources for all platforms
 
 HEADERS += \
+    async_file_writer.hpp \
     chunks_download_strategy.hpp \
     constants.hpp \
     country_defines.hpp \
@@ -106,6 +107,7 @@ HEADERS += \
     string_storage_base.hpp \
 
 SOURCES += \
+    async_file_writer.cpp \
     chunks_download_strategy.cpp \
     country_defines.cpp \
     country_file.cpp \
@@ -0,0 +1,54 @@
+#include "testing/testing.hpp"
+
+#include "platform/async_file_writer.hpp"
+#include "platform/platform_tests_support/scoped_file.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/internal/file_data.hpp"
+
+#include "std/string.hpp"
+
+using namespace downloader;
+using namespace platform::tests_support;
+
+namespace
+{
+string ReadFile(string const & filePath)
+{
+  FileReader reader(filePath);
+  string contents(static_cast<size_t>(reader.Size()), '\0');
+  reader.Read(0, &contents[0], contents.size());
+  return contents;
+}
+}  // namespace
+
+UNIT_TEST(AsyncFileWriter_Smoke)
+{
+  ScopedFile const file("async_file_writer_test.tmp", "");
+  string const & path = file.GetFullPath();
+
+  AsyncFileWriter writer(path, FileWriter::OP_WRITE_TRUNCATE, 1024 /* reserveSize */);
+  // Blocks are written out of order, as chunks come from several connections.
+  TEST(writer.Write(5, "world", 5), ());
+  TEST(writer.Write(0, "hello", 5), ());
+
+  uint64_t sizeAtCheckpoint = 0;
+  writer.SetCheckpoint([&]() { TEST(my::GetFileSize(path, sizeAtCheckpoint), ()); });
+  TEST(writer.Close(), ());
+
+  // Preallocation doesn't change the size of the file.
+  TEST_EQUAL(sizeAtCheckpoint, 10, ());
+  TEST_EQUAL(ReadFile(path), "helloworld", ());
+}
+
+UNIT_TEST(AsyncFileWriter_ExistingFile)
+{
+  ScopedFile const file("async_file_writer_test.tmp", "0123456789");
+  string const & path = file.GetFullPath();
+
+  AsyncFileWriter writer(path, FileWriter::OP_WRITE_EXISTING, 0 /* reserveSize */);
+  TEST(writer.Write(3, "abc", 3), ());
+  TEST(writer.Close(), ());
+
+  TEST_EQUAL(ReadFile(path), "012abc6789", ());
+}
@@ -25,6 +25,7 @@ win32*|linux* {
 SOURCES += \
     ../../testing/testingmain.cpp \
     apk_test.cpp \
+    async_file_writer_test.cpp \
     country_file_tests.cpp \
     get_text_by_id_tests.cpp \
     jansson_test.cpp \
@@ -34,3 +35,4 @@ SOURCES += \
     measurement_tests.cpp \
     mwm_version_test.cpp \
     platform_test.cpp \
+    string_storage_test.cpp \
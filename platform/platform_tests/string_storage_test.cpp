@@ -0,0 +1,102 @@
+#include "testing/testing.hpp"
+
+#include "platform/platform.hpp"
+#include "platform/string_storage_base.hpp"
+
+#include "coding/file_name_utils.hpp"
+#include "coding/file_reader.hpp"
+#include "coding/internal/file_data.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace platform;
+using namespace std;
+
+namespace
+{
+string GetTestPath()
+{
+  return my::JoinFoldersToPath(GetPlatform().WritableDir(), "string_storage_test.ini");
+}
+
+string ReadFile(string const & path)
+{
+  string content;
+  FileReader(path).ReadAsString(content);
+  return content;
+}
+
+UNIT_TEST(StringStorage_Flush)
+{
+  string const path = GetTestPath();
+  my::DeleteFileX(path);
+  {
+    StringStorageBase storage(path);
+    storage.SetValue("a", "1");
+    storage.SetValue("b", "2");
+    storage.SetValue("a", "3");
+    storage.DeleteKeyAndValue("b");
+
+    string value;
+    TEST(storage.GetValue("a", value), ());
+    TEST_EQUAL(value, "3", ());
+    TEST(!storage.GetValue("b", value), ());
+
+    storage.Flush();
+    TEST_EQUAL(ReadFile(path), "a=3\n", ());
+
+    // Pending changes are saved on destruction.
+    storage.SetValue("c", "4");
+  }
+
+  {
+    StringStorageBase storage(path);
+    string value;
+    TEST(storage.GetValue("c", value), ());
+    TEST_EQUAL(value, "4", ());
+    storage.Clear();
+  }
+  TEST_EQUAL(ReadFile(path), "", ());
+  my::DeleteFileX(path);
+}
+
+UNIT_TEST(StringStorage_ConcurrentAccess)
+{
+  size_t constexpr kThreadsCount = 4;
+  size_t constexpr kValuesCount = 100;
+
+  string const path = GetTestPath();
+  my::DeleteFileX(path);
+  {
+    StringStorageBase storage(path);
+
+    vector<thread> threads;
+    for (size_t i = 0; i < kThreadsCount; ++i)
+    {
+      threads.emplace_back([&storage, i]() {
+        string const key = "key" + to_string(i);
+        for (size_t j = 0; j < kValuesCount; ++j)
+        {
+          storage.SetValue(key, to_string(j));
+          string value;
+          TEST(storage.GetValue(key, value), ());
+          TEST_EQUAL(value, to_string(j), ());
+        }
+      });
+    }
+    for (auto & t : threads)
+      t.join();
+  }
+
+  StringStorageBase storage(path);
+  for (size_t i = 0; i < kThreadsCount; ++i)
+  {
+    string value;
+    TEST(storage.GetValue("key" + to_string(i), value), ());
+    TEST_EQUAL(value, to_string(kValuesCount - 1), ());
+  }
+  my::DeleteFileX(path);
+}
+}  // namespace
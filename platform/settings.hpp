@@ -44,6 +44,9 @@ void Set(string const & key, Value const & value)
 
 inline void Delete(string const & key) { StringStorage::Instance().DeleteKeyAndValue(key); }
 inline void Clear() { StringStorage::Instance().Clear(); }
+/// Settings are saved asynchronously, call it when the app may be killed, e.g. on going
+/// to background.
+inline void Flush() { StringStorage::Instance().Flush(); }
 
 /// Use this function for running some stuff once according to date.
 /// @param[in]  date  Current date in format yymmdd.
@@ -68,6 +71,8 @@ public:
     return Instance().GetValue(key, strVal) && settings::FromString(strVal, outValue);
   }
 
+  static void Flush() { Instance().Flush(); }
+
 private:
   static Settings & Instance();
   Settings();
@@ -8,6 +8,7 @@
 #include "base/exception.hpp"
 #include "base/stl_add.hpp"
 
+#include <chrono>
 #include <istream>
 
 using namespace std;
@@ -15,12 +16,16 @@ using namespace std;
 namespace
 {
 constexpr char kDelimChar = '=';
+// Time from the first unsaved change to saving.
+auto constexpr kSaveDelay = chrono::seconds(1);
 }  // namespace
 
 namespace platform
 {
-StringStorageBase::StringStorageBase(string const & path) : m_path(path)
+StringStorageBase::StringStorageBase(string const & path)
+  : m_values(make_shared<Container>()), m_path(path), m_saveTask(kSaveDelay)
 {
+  Container values;
   try
   {
     LOG(LINFO, ("Settings path:", m_path));
@@ -40,21 +45,37 @@ StringStorageBase::StringStorageBase(string const & path) : m_path(path)
       string const key = line.substr(0, delimPos);
       string const value = line.substr(delimPos + 1);
       if (!key.empty() && !value.empty())
-        m_values[key] = value;
+        values[key] = value;
     }
   }
   catch (RootException const & ex)
   {
     LOG(LWARNING, ("Loading settings:", ex.Msg()));
   }
+
+  Snapshot snapshot = make_shared<Container>(move(values));
+  m_savedValues = snapshot;
+  atomic_store(&m_values, snapshot);
 }
 
-void StringStorageBase::Save() const
+StringStorageBase::~StringStorageBase()
 {
+  m_saveTask.Drop();
+  Flush();
+}
+
+void StringStorageBase::Flush()
+{
+  lock_guard<mutex> guard(m_saveMutex);
+
+  auto const values = GetSnapshot();
+  if (values == m_savedValues)
+    return;
+
   try
   {
     FileWriter file(m_path);
-    for (auto const & value : m_values)
+    for (auto const & value : *values)
     {
       string line(value.first);
       line += kDelimChar;
@@ -68,21 +89,21 @@ void StringStorageBase::Save() const
     // Ignore all settings saving exceptions.
     LOG(LWARNING, ("Saving settings:", ex.Msg()));
   }
+  m_savedValues = values;
 }
 
 void StringStorageBase::Clear()
 {
   lock_guard<mutex> guard(m_mutex);
-  m_values.clear();
-  Save();
+  SetSnapshot(Container());
 }
 
 bool StringStorageBase::GetValue(string const & key, string & outValue) const
 {
-  lock_guard<mutex> guard(m_mutex);
+  auto const values = GetSnapshot();
 
-  auto const found = m_values.find(key);
-  if (found == m_values.end())
+  auto const found = values->find(key);
+  if (found == values->end())
     return false;
 
   outValue = found->second;
@@ -93,19 +114,49 @@ void StringStorageBase::SetValue(string const & key, string && value)
 {
   lock_guard<mutex> guard(m_mutex);
 
-  m_values[key] = move(value);
-  Save();
+  auto const values = GetSnapshot();
+  auto const found = values->find(key);
+  if (found != values->end() && found->second == value)
+    return;
+
+  Container copy(*values);
+  copy[key] = move(value);
+  SetSnapshot(move(copy));
 }
 
 void StringStorageBase::DeleteKeyAndValue(string const & key)
 {
   lock_guard<mutex> guard(m_mutex);
 
-  auto const found = m_values.find(key);
-  if (found != m_values.end())
-  {
-    m_values.erase(found);
-    Save();
-  }
+  auto const values = GetSnapshot();
+  if (values->find(key) == values->end())
+    return;
+
+  Container copy(*values);
+  copy.erase(key);
+  SetSnapshot(move(copy));
+}
+
+StringStorageBase::Snapshot StringStorageBase::GetSnapshot() const
+{
+  return atomic_load(&m_values);
+}
+
+void StringStorageBase::SetSnapshot(Container && values)
+{
+  atomic_store(&m_values, Snapshot(make_shared<Container>(move(values))));
+
+  // RestartWith() postpones the task, so it's called only once per batch. Otherwise frequent
+  // changes would postpone saving forever.
+  if (m_savePending)
+    return;
+  m_savePending = true;
+  m_saveTask.RestartWith([this]() {
+    {
+      lock_guard<mutex> guard(m_mutex);
+      m_savePending = false;
+    }
+    Flush();
+  });
 }
 }  // namespace platform
@@ -1,25 +1,56 @@
 #pragma once
 
+#include "base/deferred_task.hpp"
+
 #include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 
 namespace platform
 {
+// Key-value storage which is kept in memory and is saved to a text file.
+//
+// Reads don't take locks, they use a snapshot of values which is replaced on every change.
+// Changes are batched: the file is rewritten on a background thread in kSaveDelay after
+// the first unsaved change, on Flush() or on destruction.
+//
+// *NOTE* This class IS thread-safe.
 class StringStorageBase
 {
 public:
   StringStorageBase(std::string const & path);
-  void Save() const;
+  ~StringStorageBase();
+
+  // Saves pending changes synchronously.
+  void Flush();
+
   void Clear();
   bool GetValue(std::string const & key, std::string & outValue) const;
   void SetValue(std::string const & key, std::string && value);
   void DeleteKeyAndValue(std::string const & key);
-  
+
 private:
   using Container = std::map<std::string, std::string>;
-  Container m_values;
-  mutable std::mutex m_mutex;
+  using Snapshot = std::shared_ptr<Container const>;
+
+  Snapshot GetSnapshot() const;
+  // Publishes |values| and schedules saving. |m_mutex| must be locked.
+  void SetSnapshot(Container && values);
+
+  // Accessed only with std::atomic_load() and std::atomic_store().
+  Snapshot m_values;
+  // Serializes changes of values and guards |m_savePending|.
+  std::mutex m_mutex;
+  bool m_savePending = false;
+
+  // Guards the file and |m_savedValues|.
+  std::mutex m_saveMutex;
+  Snapshot m_savedValues;
   std::string const m_path;
+
+  // Must be the last member, so it's destroyed first and a pending save doesn't see
+  // destroyed members.
+  my::DeferredTask m_saveTask;
 };
 }  // namespace platform
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Python.h"
+
+namespace
+{
+// Releases the GIL in the current scope, so other python threads may run while
+// a long C++ call is in progress. Python objects must not be touched in the scope.
+class scoped_gil_release
+{
+public:
+  scoped_gil_release() : m_state(PyEval_SaveThread()) {}
+  ~scoped_gil_release() { PyEval_RestoreThread(m_state); }
+
+  scoped_gil_release(scoped_gil_release const &) = delete;
+  scoped_gil_release & operator=(scoped_gil_release const &) = delete;
+
+private:
+  PyThreadState * m_state;
+};
+}  // namespace
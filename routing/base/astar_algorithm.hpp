@@ -3,17 +3,51 @@
 #include "routing/base/astar_weight.hpp"
 #include "routing/base/routing_result.hpp"
 
+#include "base/arena.hpp"
 #include "base/assert.hpp"
 #include "base/cancellable.hpp"
+#include "base/macros.hpp"
+#include "base/thread.hpp"
 
 #include <algorithm>
+#include <functional>
 #include <iostream>
+#include <iterator>
 #include <map>
 #include <queue>
+#include <unordered_map>
 #include <vector>
 
 namespace routing
 {
+namespace astar_detail
+{
+template <typename... Ts>
+struct MakeVoid
+{
+  using Type = void;
+};
+}  // namespace astar_detail
+
+// Storage of per-vertex state (distances and parents) of the A* wave.
+// Vertex types which provide a nested Hash functor are kept in a hash table,
+// so relaxation of an edge is O(1) instead of a tree walk. Other vertex types
+// fall back to std::map. Nodes may be allocated from an arena of the query.
+template <typename Vertex, typename Value, typename = void>
+struct AStarVertexMap
+{
+  using Type = std::map<Vertex, Value, std::less<Vertex>,
+                        base::ArenaAllocator<std::pair<Vertex const, Value>>>;
+};
+
+template <typename Vertex, typename Value>
+struct AStarVertexMap<Vertex, Value,
+                      typename astar_detail::MakeVoid<typename Vertex::Hash>::Type>
+{
+  using Type = std::unordered_map<Vertex, Value, typename Vertex::Hash, std::equal_to<Vertex>,
+                                  base::ArenaAllocator<std::pair<Vertex const, Value>>>;
+};
+
 template <typename TGraph>
 class AStarAlgorithm
 {
@@ -23,6 +57,9 @@ public:
   using TEdgeType = typename TGraphType::TEdgeType;
   using TWeightType = typename TGraphType::TWeightType;
 
+  template <typename Value>
+  using TVertexMap = typename AStarVertexMap<TVertexType, Value>::Type;
+
   enum class Result
   {
     OK,
@@ -52,10 +89,18 @@ public:
   class Context final
   {
   public:
+    Context()
+      : m_distanceMap(typename TVertexMap<TWeightType>::allocator_type(m_arena))
+      , m_parents(typename TVertexMap<TVertexType>::allocator_type(m_arena))
+    {
+    }
+
     void Clear()
     {
-      m_distanceMap.clear();
-      m_parents.clear();
+      // Memory of the maps, including buckets, must be released before the arena is reset.
+      TVertexMap<TWeightType>(m_distanceMap.get_allocator()).swap(m_distanceMap);
+      TVertexMap<TVertexType>(m_parents.get_allocator()).swap(m_parents);
+      m_arena.Reset();
     }
 
     bool HasDistance(TVertexType const & vertex) const
@@ -85,8 +130,12 @@ public:
     void ReconstructPath(TVertexType const & v, std::vector<TVertexType> & path) const;
 
   private:
-    std::map<TVertexType, TWeightType> m_distanceMap;
-    std::map<TVertexType, TVertexType> m_parents;
+    // Nodes of the maps are allocated from |m_arena|, so it's declared first.
+    base::Arena m_arena;
+    TVertexMap<TWeightType> m_distanceMap;
+    TVertexMap<TVertexType> m_parents;
+
+    DISALLOW_COPY_AND_MOVE(Context);
   };
 
   // VisitVertex returns true: wave will continue
@@ -111,6 +160,47 @@ public:
                                my::Cancellable const & cancellable = my::Cancellable(),
                                TOnVisitedVertexCallback onVisitedVertexCallback = nullptr) const;
 
+  struct AlternativesParams
+  {
+    // Maximal number of alternatives besides the best path.
+    size_t m_maxAlternatives = 2;
+    // An alternative may be longer than the best path by this share of it at most. The same
+    // holds for the part of the alternative which differs from the best path and the part of
+    // the best path it replaces, so alternatives don't have senseless detours.
+    double m_maxStretch = 0.25;
+    // Maximal share of an alternative it may have in common with the best path. Alternatives
+    // which have more vertices in common with each other are considered duplicates.
+    double m_maxSharing = 0.75;
+    // Number of threads which evaluate via vertex candidates.
+    size_t m_threadsCount = 1;
+  };
+
+  // Finds the best path as FindPathBidirectional does and alternatives to it with the via vertex
+  // method: an alternative is the best path from the start to a via vertex followed by the best
+  // path from it to the finish. After the waves meet each of them goes on until paths longer
+  // than the best one by |params.m_maxStretch| are covered, and every vertex reached by both
+  // waves is a candidate. Candidates are evaluated on |params.m_threadsCount| threads, the evaluation uses
+  // the search spaces of the waves only and doesn't touch |graph|. Candidates with the same
+  // detour from the best path are reduced to the shortest one.
+  // |results[0]| is the best path, alternatives follow in ascending order of their distance.
+  Result FindPathBidirectionalWithAlternatives(
+      TGraphType & graph, TVertexType const & startVertex, TVertexType const & finalVertex,
+      AlternativesParams const & params,
+      std::vector<RoutingResult<TVertexType, TWeightType>> & results,
+      my::Cancellable const & cancellable = my::Cancellable(),
+      TOnVisitedVertexCallback onVisitedVertexCallback = nullptr) const;
+
+  // Bidirectional search for graphs where the forward and the backward waves may traverse
+  // different edges, e.g. a graph with a shortcut overlay: outgoing shortcuts of a vertex are
+  // not necessarily mirrored by ingoing ones. The stopping criterion of FindPathBidirectional
+  // relies on the symmetry, so here the search is stopped when both queue tops are not less
+  // than the best path found. Meeting of the waves is checked on settled vertices too.
+  Result FindPathBidirectionalOverlay(TGraphType & graph, TVertexType const & startVertex,
+                                      TVertexType const & finalVertex,
+                                      RoutingResult<TVertexType, TWeightType> & result,
+                                      my::Cancellable const & cancellable = my::Cancellable(),
+                                      TOnVisitedVertexCallback onVisitedVertexCallback = nullptr) const;
+
   // Adjust route to the previous one.
   // adjustLimit - distance limit for wave propagation, measured in same units as graph edges length.
   typename AStarAlgorithm<TGraph>::Result AdjustRoute(
@@ -169,6 +259,8 @@ private:
         : forward(forward), startVertex(startVertex), finalVertex(finalVertex), graph(graph)
         , m_piRT(graph.HeuristicCostEstimate(finalVertex, startVertex))
         , m_piFS(graph.HeuristicCostEstimate(startVertex, finalVertex))
+        , bestDistance(typename TVertexMap<TWeightType>::allocator_type(arena))
+        , parent(typename TVertexMap<TVertexType>::allocator_type(arena))
     {
       bestVertex = forward ? startVertex : finalVertex;
       pS = ConsistentHeuristic(bestVertex);
@@ -217,19 +309,38 @@ private:
     TWeightType const m_piFS;
 
     std::priority_queue<State, std::vector<State>, std::greater<State>> queue;
-    std::map<TVertexType, TWeightType> bestDistance;
-    std::map<TVertexType, TVertexType> parent;
+    // Nodes of |bestDistance| and |parent|.
+    base::Arena arena;
+    TVertexMap<TWeightType> bestDistance;
+    TVertexMap<TVertexType> parent;
     TVertexType bestVertex;
 
     TWeightType pS;
   };
 
-  static void ReconstructPath(TVertexType const & v,
-                              std::map<TVertexType, TVertexType> const & parent,
+  // Via vertex which passed the checks of FindPathBidirectionalWithAlternatives.
+  struct ViaCandidate
+  {
+    TVertexType m_via;
+    // Indexes of vertices of the best path where the alternative leaves it and rejoins it.
+    size_t m_leaveIdx = 0;
+    size_t m_rejoinIdx = 0;
+    TWeightType m_distance;
+  };
+
+  // Runs both waves of FindPathBidirectional. If |extension| is positive the waves go on after
+  // the best path is found until vertices of paths longer than it by |extension| of it are
+  // reached by both waves.
+  Result RunBidirectional(BidirectionalStepContext & forward, BidirectionalStepContext & backward,
+                          double extension, RoutingResult<TVertexType, TWeightType> & result,
+                          my::Cancellable const & cancellable,
+                          TOnVisitedVertexCallback onVisitedVertexCallback) const;
+
+  static void ReconstructPath(TVertexType const & v, TVertexMap<TVertexType> const & parent,
                               std::vector<TVertexType> & path);
   static void ReconstructPathBidirectional(TVertexType const & v, TVertexType const & w,
-                                           std::map<TVertexType, TVertexType> const & parentV,
-                                           std::map<TVertexType, TVertexType> const & parentW,
+                                           TVertexMap<TVertexType> const & parentV,
+                                           TVertexMap<TVertexType> const & parentW,
                                            std::vector<TVertexType> & path);
 };
 
@@ -372,16 +483,31 @@ typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::FindPathBidirect
     RoutingResult<TVertexType, TWeightType> & result,
     my::Cancellable const & cancellable,
     TOnVisitedVertexCallback onVisitedVertexCallback) const
+{
+  BidirectionalStepContext forward(true /* forward */, startVertex, finalVertex, graph);
+  BidirectionalStepContext backward(false /* forward */, startVertex, finalVertex, graph);
+  return RunBidirectional(forward, backward, 0.0 /* extension */, result, cancellable,
+                          onVisitedVertexCallback);
+}
+
+template <typename TGraph>
+typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::RunBidirectional(
+    BidirectionalStepContext & forward, BidirectionalStepContext & backward, double extension,
+    RoutingResult<TVertexType, TWeightType> & result, my::Cancellable const & cancellable,
+    TOnVisitedVertexCallback onVisitedVertexCallback) const
 {
   if (nullptr == onVisitedVertexCallback)
     onVisitedVertexCallback = [](TVertexType const &, TVertexType const &){};
 
-  BidirectionalStepContext forward(true /* forward */, startVertex, finalVertex, graph);
-  BidirectionalStepContext backward(false /* forward */, startVertex, finalVertex, graph);
+  TVertexType const & startVertex = forward.startVertex;
+  TVertexType const & finalVertex = forward.finalVertex;
 
   bool foundAnyPath = false;
   auto bestPathReducedLength = kZeroDistance;
   auto bestPathRealLength = kZeroDistance;
+  // The best path is kept in |result| once it's found, the waves may go on after that.
+  bool foundResult = false;
+  auto extendedReducedLength = kZeroDistance;
 
   forward.bestDistance[startVertex] = kZeroDistance;
   forward.queue.push(State(startVertex, kZeroDistance));
@@ -404,17 +530,37 @@ typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::FindPathBidirect
   uint32_t steps = 0;
   PeriodicPollCancellable periodicCancellable(cancellable);
 
-  while (!cur->queue.empty() && !nxt->queue.empty())
+  // After the best path is found every wave goes on until it covers all vertices of paths
+  // longer than the best one by |extension| of it: the reduced distance of such a vertex
+  // is not greater than the reduced length of the path.
+  auto const isWaveDone = [&](BidirectionalStepContext const & context) {
+    return context.queue.empty() || context.TopDistance() >= extendedReducedLength - kEpsilon;
+  };
+
+  while (foundResult || (!cur->queue.empty() && !nxt->queue.empty()))
   {
     ++steps;
 
     if (periodicCancellable.IsCancelled())
       return Result::Cancelled;
 
-    if (steps % kQueueSwitchPeriod == 0)
+    if (foundResult)
+    {
+      // The waves go on in turn to cover the search space evenly.
       std::swap(cur, nxt);
+      if (isWaveDone(*cur))
+      {
+        if (isWaveDone(*nxt))
+          return Result::OK;
+        std::swap(cur, nxt);
+      }
+    }
+    else if (steps % kQueueSwitchPeriod == 0)
+    {
+      std::swap(cur, nxt);
+    }
 
-    if (foundAnyPath)
+    if (foundAnyPath && !foundResult)
     {
       auto const curTop = cur->TopDistance();
       auto const nxtTop = nxt->TopDistance();
@@ -438,7 +584,13 @@ typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::FindPathBidirect
         CHECK(!result.m_path.empty(), ());
         if (!cur->forward)
           reverse(result.m_path.begin(), result.m_path.end());
-        return Result::OK;
+
+        if (extension <= 0.0)
+          return Result::OK;
+
+        foundResult = true;
+        extendedReducedLength = bestPathReducedLength + extension * bestPathRealLength;
+        continue;
       }
     }
 
@@ -476,8 +628,9 @@ typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::FindPathBidirect
         // Reduced length that the path we've just found has in the original graph:
         // find the reduced length of the path's parts in the reduced forward and backward graphs.
         auto const curPathReducedLength = newReducedDist + distW;
-        // No epsilon here: it is ok to overshoot slightly.
-        if (!foundAnyPath || bestPathReducedLength > curPathReducedLength)
+        // No epsilon here: it is ok to overshoot slightly. The best path is not changed after
+        // it's found to keep |result| and the best vertices consistent.
+        if (!foundResult && (!foundAnyPath || bestPathReducedLength > curPathReducedLength))
         {
           bestPathReducedLength = curPathReducedLength;
 
@@ -501,6 +654,324 @@ typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::FindPathBidirect
   return Result::NoPath;
 }
 
+template <typename TGraph>
+typename AStarAlgorithm<TGraph>::Result
+AStarAlgorithm<TGraph>::FindPathBidirectionalWithAlternatives(
+    TGraphType & graph, TVertexType const & startVertex, TVertexType const & finalVertex,
+    AlternativesParams const & params,
+    std::vector<RoutingResult<TVertexType, TWeightType>> & results,
+    my::Cancellable const & cancellable, TOnVisitedVertexCallback onVisitedVertexCallback) const
+{
+  results.clear();
+
+  BidirectionalStepContext forward(true /* forward */, startVertex, finalVertex, graph);
+  BidirectionalStepContext backward(false /* forward */, startVertex, finalVertex, graph);
+  RoutingResult<TVertexType, TWeightType> best;
+  Result const result = RunBidirectional(forward, backward, params.m_maxStretch, best,
+                                         cancellable, onVisitedVertexCallback);
+  if (result != Result::OK)
+    return result;
+
+  results.push_back(best);
+  if (params.m_maxAlternatives == 0)
+    return Result::OK;
+
+  // Distances from the start to vertices of the best path. The part of the path before the
+  // meeting vertex of the waves is taken from the forward wave and the rest from the backward one.
+  std::vector<TVertexType> const & bestPath = best.m_path;
+  base::Arena arena;
+  TVertexMap<size_t> bestPathIdx{typename TVertexMap<size_t>::allocator_type(arena)};
+  for (size_t i = 0; i < bestPath.size(); ++i)
+    bestPathIdx.emplace(bestPath[i], i);
+
+  auto const realForward = [&](TVertexType const & v, TWeightType const & reducedDist) {
+    return reducedDist + forward.pS - forward.ConsistentHeuristic(v);
+  };
+  auto const realBackward = [&](TVertexType const & v, TWeightType const & reducedDist) {
+    return reducedDist + backward.pS - backward.ConsistentHeuristic(v);
+  };
+
+  std::vector<TVertexType> forwardPart;
+  ReconstructPath(forward.bestVertex, forward.parent, forwardPart);
+  std::vector<TWeightType> bestPrefix(bestPath.size());
+  for (size_t i = 0; i < bestPath.size(); ++i)
+  {
+    bestPrefix[i] =
+        i < forwardPart.size()
+            ? realForward(bestPath[i], forward.bestDistance.at(bestPath[i]))
+            : best.m_distance - realBackward(bestPath[i], backward.bestDistance.at(bestPath[i]));
+  }
+
+  // Real distances of candidates are calculated here since the heuristic uses the graph.
+  TWeightType const maxDistance = best.m_distance + params.m_maxStretch * best.m_distance;
+  std::vector<std::pair<TVertexType, TWeightType>> vias;
+  for (auto const & kv : forward.bestDistance)
+  {
+    if (bestPathIdx.count(kv.first) != 0)
+      continue;
+
+    auto const it = backward.bestDistance.find(kv.first);
+    if (it == backward.bestDistance.cend())
+      continue;
+
+    auto const distance = realForward(kv.first, kv.second) + realBackward(kv.first, it->second);
+    if (!(maxDistance < distance))
+      vias.emplace_back(kv.first, distance);
+  }
+
+  if (cancellable.IsCancelled())
+    return Result::Cancelled;
+
+  // Finds the vertex where the path from |via| to the root of |parent| joins the best path.
+  auto const findBestPathVertex = [&](TVertexType via, TVertexMap<TVertexType> const & parent,
+                                      size_t & idx) {
+    while (true)
+    {
+      auto const itIdx = bestPathIdx.find(via);
+      if (itIdx != bestPathIdx.cend())
+      {
+        idx = itIdx->second;
+        return true;
+      }
+
+      auto const it = parent.find(via);
+      if (it == parent.cend())
+        return false;
+      via = it->second;
+    }
+  };
+
+  size_t const threadsCount =
+      std::max(std::min(params.m_threadsCount, vias.size()), static_cast<size_t>(1));
+  std::vector<std::vector<ViaCandidate>> threadCandidates(threadsCount);
+  auto const evaluate = [&](size_t threadIdx) {
+    for (size_t i = threadIdx; i < vias.size(); i += threadsCount)
+    {
+      ViaCandidate candidate;
+      candidate.m_via = vias[i].first;
+      candidate.m_distance = vias[i].second;
+      if (!findBestPathVertex(candidate.m_via, forward.parent, candidate.m_leaveIdx) ||
+          !findBestPathVertex(candidate.m_via, backward.parent, candidate.m_rejoinIdx) ||
+          candidate.m_leaveIdx >= candidate.m_rejoinIdx)
+      {
+        continue;
+      }
+
+      auto const shared = bestPrefix[candidate.m_leaveIdx] + best.m_distance -
+                          bestPrefix[candidate.m_rejoinIdx];
+      if (shared > params.m_maxSharing * best.m_distance)
+        continue;
+
+      auto const replaced = bestPrefix[candidate.m_rejoinIdx] - bestPrefix[candidate.m_leaveIdx];
+      if (candidate.m_distance - shared > replaced + params.m_maxStretch * replaced)
+        continue;
+
+      threadCandidates[threadIdx].push_back(candidate);
+    }
+  };
+
+  std::vector<threads::SimpleThread> threads;
+  threads.reserve(threadsCount - 1);
+  for (size_t i = 1; i < threadsCount; ++i)
+    threads.emplace_back(evaluate, i);
+  evaluate(0 /* threadIdx */);
+  for (auto & thread : threads)
+    thread.join();
+
+  // All via vertices of a detour give the same alternative, the shortest one is kept.
+  std::vector<ViaCandidate> candidates;
+  for (auto & c : threadCandidates)
+    candidates.insert(candidates.end(), c.begin(), c.end());
+  std::sort(candidates.begin(), candidates.end(), [](ViaCandidate const & l, ViaCandidate const & r) {
+    if (l.m_leaveIdx != r.m_leaveIdx)
+      return l.m_leaveIdx < r.m_leaveIdx;
+    if (l.m_rejoinIdx != r.m_rejoinIdx)
+      return l.m_rejoinIdx < r.m_rejoinIdx;
+    return l.m_distance < r.m_distance;
+  });
+  candidates.erase(std::unique(candidates.begin(), candidates.end(),
+                               [](ViaCandidate const & l, ViaCandidate const & r) {
+                                 return l.m_leaveIdx == r.m_leaveIdx &&
+                                        l.m_rejoinIdx == r.m_rejoinIdx;
+                               }),
+                   candidates.end());
+  std::sort(candidates.begin(), candidates.end(), [](ViaCandidate const & l, ViaCandidate const & r) {
+    return l.m_distance < r.m_distance;
+  });
+
+  // Alternatives which differ from the chosen ones in few vertices only are skipped.
+  std::vector<TVertexMap<bool>> chosenVertices;
+  for (ViaCandidate const & candidate : candidates)
+  {
+    if (results.size() > params.m_maxAlternatives)
+      break;
+
+    RoutingResult<TVertexType, TWeightType> alternative;
+    ReconstructPathBidirectional(candidate.m_via, candidate.m_via, forward.parent, backward.parent,
+                                 alternative.m_path);
+    alternative.m_distance = candidate.m_distance;
+
+    TVertexMap<bool> vertices{typename TVertexMap<bool>::allocator_type(arena)};
+    bool isSimple = true;
+    for (auto const & v : alternative.m_path)
+    {
+      if (!vertices.emplace(v, true).second)
+      {
+        isSimple = false;
+        break;
+      }
+    }
+    if (!isSimple)
+      continue;
+
+    bool const isDuplicate =
+        std::any_of(chosenVertices.cbegin(), chosenVertices.cend(), [&](TVertexMap<bool> const & chosen) {
+          size_t const sharedCount = std::count_if(
+              alternative.m_path.cbegin(), alternative.m_path.cend(),
+              [&](TVertexType const & v) { return chosen.count(v) != 0; });
+          return sharedCount > params.m_maxSharing * alternative.m_path.size();
+        });
+    if (isDuplicate)
+      continue;
+
+    chosenVertices.push_back(std::move(vertices));
+    results.push_back(std::move(alternative));
+  }
+
+  return Result::OK;
+}
+
+template <typename TGraph>
+typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::FindPathBidirectionalOverlay(
+    TGraphType & graph, TVertexType const & startVertex, TVertexType const & finalVertex,
+    RoutingResult<TVertexType, TWeightType> & result, my::Cancellable const & cancellable,
+    TOnVisitedVertexCallback onVisitedVertexCallback) const
+{
+  if (nullptr == onVisitedVertexCallback)
+    onVisitedVertexCallback = [](TVertexType const &, TVertexType const &){};
+
+  BidirectionalStepContext forward(true /* forward */, startVertex, finalVertex, graph);
+  BidirectionalStepContext backward(false /* forward */, startVertex, finalVertex, graph);
+
+  bool foundAnyPath = false;
+  auto bestPathReducedLength = kZeroDistance;
+  auto bestPathRealLength = kZeroDistance;
+
+  forward.bestDistance[startVertex] = kZeroDistance;
+  forward.queue.push(State(startVertex, kZeroDistance));
+
+  backward.bestDistance[finalVertex] = kZeroDistance;
+  backward.queue.push(State(finalVertex, kZeroDistance));
+
+  // A wave is finished when it can't improve the best path any more.
+  auto const isFinished = [&](BidirectionalStepContext const & context) {
+    return context.queue.empty() ||
+           (foundAnyPath && context.TopDistance() >= bestPathReducedLength - kEpsilon);
+  };
+
+  auto const updateBestPath = [&](BidirectionalStepContext & cur, BidirectionalStepContext & nxt,
+                                  TVertexType const & v, TWeightType const & reducedDistV,
+                                  TWeightType const & realDistV, TVertexType const & w,
+                                  TWeightType const & reducedDistW) {
+    auto const pathReducedLength = reducedDistV + reducedDistW;
+    // No epsilon here: it is ok to overshoot slightly.
+    if (foundAnyPath && !(pathReducedLength < bestPathReducedLength))
+      return;
+
+    bestPathReducedLength = pathReducedLength;
+    bestPathRealLength = realDistV + reducedDistW + nxt.pS - nxt.ConsistentHeuristic(w);
+    foundAnyPath = true;
+    cur.bestVertex = v;
+    nxt.bestVertex = w;
+  };
+
+  BidirectionalStepContext * cur = &forward;
+  BidirectionalStepContext * nxt = &backward;
+
+  std::vector<TEdgeType> adj;
+
+  uint32_t steps = 0;
+  PeriodicPollCancellable periodicCancellable(cancellable);
+
+  while (true)
+  {
+    ++steps;
+
+    if (periodicCancellable.IsCancelled())
+      return Result::Cancelled;
+
+    if (steps % kQueueSwitchPeriod == 0)
+      std::swap(cur, nxt);
+
+    if (isFinished(*cur))
+    {
+      if (isFinished(*nxt))
+        break;
+      std::swap(cur, nxt);
+    }
+
+    State const stateV = cur->queue.top();
+    cur->queue.pop();
+
+    if (stateV.distance > cur->bestDistance[stateV.vertex])
+      continue;
+
+    onVisitedVertexCallback(stateV.vertex, cur->forward ? cur->finalVertex : cur->startVertex);
+
+    auto const pV = cur->ConsistentHeuristic(stateV.vertex);
+    auto const realDistV = stateV.distance + cur->pS - pV;
+
+    // The waves may meet at a vertex without an edge to be relaxed between them, e.g.
+    // when the vertex is reached by a shortcut in one wave and by a regular edge in another.
+    auto const itNxtV = nxt->bestDistance.find(stateV.vertex);
+    if (itNxtV != nxt->bestDistance.end())
+    {
+      updateBestPath(*cur, *nxt, stateV.vertex, stateV.distance, realDistV, stateV.vertex,
+                     itNxtV->second);
+    }
+
+    cur->GetAdjacencyList(stateV.vertex, adj);
+    for (auto const & edge : adj)
+    {
+      State stateW(edge.GetTarget(), kZeroDistance);
+      if (stateV.vertex == stateW.vertex)
+        continue;
+
+      auto const len = edge.GetWeight();
+      auto const pW = cur->ConsistentHeuristic(stateW.vertex);
+      auto const reducedLen = len + pW - pV;
+
+      CHECK(reducedLen >= -kEpsilon, ("Invariant violated:", reducedLen, "<", -kEpsilon));
+      auto const newReducedDist = stateV.distance + std::max(reducedLen, kZeroDistance);
+
+      auto const itCur = cur->bestDistance.find(stateW.vertex);
+      if (itCur != cur->bestDistance.end() && newReducedDist >= itCur->second - kEpsilon)
+        continue;
+
+      auto const itNxt = nxt->bestDistance.find(stateW.vertex);
+      if (itNxt != nxt->bestDistance.end())
+      {
+        updateBestPath(*cur, *nxt, stateV.vertex, newReducedDist, realDistV + len, stateW.vertex,
+                       itNxt->second);
+      }
+
+      stateW.distance = newReducedDist;
+      cur->bestDistance[stateW.vertex] = newReducedDist;
+      cur->parent[stateW.vertex] = stateV.vertex;
+      cur->queue.push(stateW);
+    }
+  }
+
+  if (!foundAnyPath)
+    return Result::NoPath;
+
+  ReconstructPathBidirectional(forward.bestVertex, backward.bestVertex, forward.parent,
+                               backward.parent, result.m_path);
+  result.m_distance = bestPathRealLength;
+  CHECK(!result.m_path.empty(), ());
+  return Result::OK;
+}
+
 template <typename TGraph>
 typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::AdjustRoute(
     TGraphType & graph, TVertexType const & startVertex, std::vector<TEdgeType> const & prevRoute,
@@ -517,7 +988,7 @@ typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::AdjustRoute(
   auto minDistance = kInfiniteDistance;
   TVertexType returnVertex;
 
-  std::map<TVertexType, TWeightType> remainingDistances;
+  TVertexMap<TWeightType> remainingDistances;
   auto remainingDistance = kZeroDistance;
 
   for (auto it = prevRoute.crbegin(); it != prevRoute.crend(); ++it)
@@ -592,7 +1063,7 @@ typename AStarAlgorithm<TGraph>::Result AStarAlgorithm<TGraph>::AdjustRoute(
 // static
 template <typename TGraph>
 void AStarAlgorithm<TGraph>::ReconstructPath(TVertexType const & v,
-                                             std::map<TVertexType, TVertexType> const & parent,
+                                             TVertexMap<TVertexType> const & parent,
                                              std::vector<TVertexType> & path)
 {
   path.clear();
@@ -612,8 +1083,8 @@ void AStarAlgorithm<TGraph>::ReconstructPath(TVertexType const & v,
 template <typename TGraph>
 void AStarAlgorithm<TGraph>::ReconstructPathBidirectional(
     TVertexType const & v, TVertexType const & w,
-    std::map<TVertexType, TVertexType> const & parentV,
-    std::map<TVertexType, TVertexType> const & parentW, std::vector<TVertexType> & path)
+    TVertexMap<TVertexType> const & parentV, TVertexMap<TVertexType> const & parentW,
+    std::vector<TVertexType> & path)
 {
   std::vector<TVertexType> pathV;
   ReconstructPath(v, parentV, pathV);
@@ -622,7 +1093,9 @@ void AStarAlgorithm<TGraph>::ReconstructPathBidirectional(
   path.clear();
   path.reserve(pathV.size() + pathW.size());
   path.insert(path.end(), pathV.begin(), pathV.end());
-  path.insert(path.end(), pathW.rbegin(), pathW.rend());
+  // |v| and |w| are the same vertex if the waves met at a settled vertex.
+  auto const beginW = v == w ? std::next(pathW.rbegin()) : pathW.rbegin();
+  path.insert(path.end(), beginW, pathW.rend());
 }
 
 template <typename TGraph>
@@ -77,6 +77,8 @@ void FollowedPolyline::Swap(FollowedPolyline & rhs)
   m_poly.Swap(rhs.m_poly);
   m_segDistance.swap(rhs.m_segDistance);
   m_segProj.swap(rhs.m_segProj);
+  m_segRects.swap(rhs.m_segRects);
+  swap(m_segRectsLeavesCount, rhs.m_segRectsLeavesCount);
   swap(m_current, rhs.m_current);
   swap(m_nextCheckpointIndex, rhs.m_nextCheckpointIndex);
 }
@@ -90,16 +92,26 @@ void FollowedPolyline::Update()
   m_segDistance.resize(n);
   m_segProj.resize(n);
 
+  MercatorBounds::DistancesOnEarth(m_poly.GetPoints().data(), n + 1, m_segDistance.data());
+
   double dist = 0.0;
   for (size_t i = 0; i < n; ++i)
   {
-    m2::PointD const & p1 = m_poly.GetPoint(i);
-    m2::PointD const & p2 = m_poly.GetPoint(i + 1);
-
-    dist += MercatorBounds::DistanceOnEarth(p1, p2);
-
+    dist += m_segDistance[i];
     m_segDistance[i] = dist;
-    m_segProj[i].SetBounds(p1, p2);
+    m_segProj[i].SetBounds(m_poly.GetPoint(i), m_poly.GetPoint(i + 1));
+  }
+
+  m_segRectsLeavesCount = 1;
+  while (m_segRectsLeavesCount < n)
+    m_segRectsLeavesCount *= 2;
+  m_segRects.assign(2 * m_segRectsLeavesCount, m2::RectD());
+  for (size_t i = 0; i < n; ++i)
+    m_segRects[m_segRectsLeavesCount + i] = m2::RectD(m_poly.GetPoint(i), m_poly.GetPoint(i + 1));
+  for (size_t i = m_segRectsLeavesCount - 1; i > 0; --i)
+  {
+    m_segRects[i] = m_segRects[2 * i];
+    m_segRects[i].Add(m_segRects[2 * i + 1]);
   }
 
   m_current = Iter(m_poly.Front(), 0);
@@ -118,12 +130,13 @@ Iter FollowedPolyline::GetClosestProjectionInInterval(m2::RectD const & posRect,
 
   m2::PointD const currPos = posRect.Center();
 
-  for (size_t i = startIdx; i < endIdx; ++i)
+  // A projection can be inside |posRect| only if the segment's rect intersects |posRect|.
+  ForEachSegmentInRect(posRect, startIdx, endIdx, [&](size_t i)
   {
     m2::PointD const pt = m_segProj[i](currPos);
 
     if (!posRect.IsPointInside(pt))
-      continue;
+      return;
 
     Iter it(pt, i);
     double const dp = distFn(it);
@@ -132,11 +145,38 @@ Iter FollowedPolyline::GetClosestProjectionInInterval(m2::RectD const & posRect,
       res = it;
       minDist = dp;
     }
-  }
+  });
 
   return res;
 }
 
+template <class Fn>
+void FollowedPolyline::ForEachSegmentInRect(m2::RectD const & rect, size_t startIdx,
+                                            size_t endIdx, Fn && fn) const
+{
+  if (startIdx < endIdx)
+    ForEachSegmentInRect(rect, startIdx, endIdx, 1 /* node */, 0, m_segRectsLeavesCount, fn);
+}
+
+template <class Fn>
+void FollowedPolyline::ForEachSegmentInRect(m2::RectD const & rect, size_t startIdx,
+                                            size_t endIdx, size_t node, size_t nodeBegin,
+                                            size_t nodeEnd, Fn && fn) const
+{
+  if (nodeEnd <= startIdx || endIdx <= nodeBegin || !m_segRects[node].IsIntersect(rect))
+    return;
+
+  if (nodeBegin + 1 == nodeEnd)
+  {
+    fn(nodeBegin);
+    return;
+  }
+
+  size_t const middle = nodeBegin + (nodeEnd - nodeBegin) / 2;
+  ForEachSegmentInRect(rect, startIdx, endIdx, 2 * node, nodeBegin, middle, fn);
+  ForEachSegmentInRect(rect, startIdx, endIdx, 2 * node + 1, middle, nodeEnd, fn);
+}
+
 template <class DistanceFn>
 Iter FollowedPolyline::GetBestProjection(m2::RectD const & posRect,
                                          DistanceFn const & distFn) const
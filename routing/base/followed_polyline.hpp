@@ -90,6 +90,15 @@ private:
   template <class DistanceFn>
   Iter GetBestProjection(m2::RectD const & posRect, DistanceFn const & distFn) const;
 
+  /// Calls |fn| for indices of segments in [|startIdx|, |endIdx|) whose bounding rects
+  /// intersect |rect|, in increasing order.
+  template <class Fn>
+  void ForEachSegmentInRect(m2::RectD const & rect, size_t startIdx, size_t endIdx,
+                            Fn && fn) const;
+  template <class Fn>
+  void ForEachSegmentInRect(m2::RectD const & rect, size_t startIdx, size_t endIdx, size_t node,
+                            size_t nodeBegin, size_t nodeEnd, Fn && fn) const;
+
   void Update();
 
   m2::PolylineD m_poly;
@@ -99,6 +108,11 @@ private:
   size_t m_nextCheckpointIndex;
   /// Precalculated info for fast projection finding.
   std::vector<m2::ProjectionToSection<m2::PointD>> m_segProj;
+  /// Segment tree of bounding rects of segments for fast search of segments close to
+  /// a position on long routes. The node |i| has children |2i| and |2i + 1|, the root
+  /// is the node 1, and rects of segments are leaves starting from |m_segRectsLeavesCount|.
+  std::vector<m2::RectD> m_segRects;
+  size_t m_segRectsLeavesCount = 0;
   /// Accumulated cache of segments length in meters.
   std::vector<double> m_segDistance;
 };
@@ -19,6 +19,7 @@
 
 #include "geometry/point2d.hpp"
 
+#include <algorithm>
 #include <cstdlib>
 #include <numeric>
 #include <utility>
@@ -30,6 +31,9 @@ using namespace routing::turns;
 using namespace std;
 using namespace traffic;
 
+// The cache of road attributes is dropped when it gets larger.
+size_t constexpr kMaxCachedRoadAttributes = 100000;
+
 class RoutingResult : public IRoutingResult
 {
 public:
@@ -207,23 +211,62 @@ Index::FeaturesLoaderGuard & BicycleDirectionsEngine::GetLoader(MwmSet::MwmId co
   return *m_loader;
 }
 
-void BicycleDirectionsEngine::LoadPathAttributes(FeatureID const & featureId, LoadedPathSegment & pathSegment)
+void BicycleDirectionsEngine::LoadRoadAttributes(vector<FeatureID> & featureIds)
+{
+  if (m_roadAttributes.size() + featureIds.size() > kMaxCachedRoadAttributes)
+    m_roadAttributes.clear();
+
+  sort(featureIds.begin(), featureIds.end());
+  featureIds.erase(unique(featureIds.begin(), featureIds.end()), featureIds.end());
+
+  for (FeatureID const & featureId : featureIds)
+  {
+    if (!featureId.IsValid() || m_roadAttributes.count(featureId) != 0)
+      continue;
+
+    RoadAttributes & attributes = m_roadAttributes[featureId];
+    FeatureType ft;
+    if (!GetLoader(featureId.m_mwmId).GetFeatureByIndex(featureId.m_index, ft))
+      continue;
+
+    attributes.m_isLoaded = true;
+    attributes.m_highwayClass = ftypes::GetHighwayClass(ft);
+    ASSERT_NOT_EQUAL(attributes.m_highwayClass, ftypes::HighwayClass::Error, ());
+    ASSERT_NOT_EQUAL(attributes.m_highwayClass, ftypes::HighwayClass::Undefined, ());
+    attributes.m_isLink = ftypes::IsLinkChecker::Instance()(ft);
+    attributes.m_onRoundabout = ftypes::IsRoundAboutChecker::Instance()(ft);
+    ft.GetName(FeatureType::DEFAULT_LANG, attributes.m_name);
+  }
+}
+
+BicycleDirectionsEngine::RoadAttributes const * BicycleDirectionsEngine::GetRoadAttributes(
+    FeatureID const & featureId)
 {
   if (!featureId.IsValid())
-    return;
+    return nullptr;
 
-  FeatureType ft;
-  if(!GetLoader(featureId.m_mwmId).GetFeatureByIndex(featureId.m_index, ft))
-    return;
+  auto it = m_roadAttributes.find(featureId);
+  if (it == m_roadAttributes.end())
+  {
+    vector<FeatureID> featureIds = {featureId};
+    LoadRoadAttributes(featureIds);
+    it = m_roadAttributes.find(featureId);
+    CHECK(it != m_roadAttributes.end(), ());
+  }
 
-  auto const highwayClass = ftypes::GetHighwayClass(ft);
-  ASSERT_NOT_EQUAL(highwayClass, ftypes::HighwayClass::Error, ());
-  ASSERT_NOT_EQUAL(highwayClass, ftypes::HighwayClass::Undefined, ());
+  return it->second.m_isLoaded ? &it->second : nullptr;
+}
+
+void BicycleDirectionsEngine::LoadPathAttributes(FeatureID const & featureId, LoadedPathSegment & pathSegment)
+{
+  RoadAttributes const * attributes = GetRoadAttributes(featureId);
+  if (attributes == nullptr)
+    return;
 
-  pathSegment.m_highwayClass = highwayClass;
-  pathSegment.m_isLink = ftypes::IsLinkChecker::Instance()(ft);
-  ft.GetName(FeatureType::DEFAULT_LANG, pathSegment.m_name);
-  pathSegment.m_onRoundabout = ftypes::IsRoundAboutChecker::Instance()(ft);
+  pathSegment.m_highwayClass = attributes->m_highwayClass;
+  pathSegment.m_isLink = attributes->m_isLink;
+  pathSegment.m_name = attributes->m_name;
+  pathSegment.m_onRoundabout = attributes->m_onRoundabout;
 }
 
 void BicycleDirectionsEngine::GetUniNodeIdAndAdjacentEdges(IRoadGraph::TEdgeVector const & outgoingEdges,
@@ -245,14 +288,11 @@ void BicycleDirectionsEngine::GetUniNodeIdAndAdjacentEdges(IRoadGraph::TEdgeVect
     if (edge.IsFake())
       continue;
 
-    auto const & outFeatureId = edge.GetFeatureId();
-    FeatureType ft;
-    if (!GetLoader(outFeatureId.m_mwmId).GetFeatureByIndex(outFeatureId.m_index, ft))
+    RoadAttributes const * attributes = GetRoadAttributes(edge.GetFeatureId());
+    if (attributes == nullptr)
       continue;
 
-    auto const highwayClass = ftypes::GetHighwayClass(ft);
-    ASSERT_NOT_EQUAL(highwayClass, ftypes::HighwayClass::Error, ());
-    ASSERT_NOT_EQUAL(highwayClass, ftypes::HighwayClass::Undefined, ());
+    auto const highwayClass = attributes->m_highwayClass;
 
     double angle = 0;
 
@@ -296,6 +336,29 @@ void BicycleDirectionsEngine::FillPathSegmentsAndAdjacentEdgesMap(
   CHECK_EQUAL(routeEdges.size() + 1, pathSize, ());
   // Filling |m_adjacentEdges|.
   auto constexpr kInvalidSegId = numeric_limits<uint32_t>::max();
+  // Adjacent edges of every junction are got once. They are used to gather features of the
+  // route and of possible turns, which are loaded in one pass, and then to find joints.
+  vector<IRoadGraph::TEdgeVector> junctionsOutgoingEdges(pathSize);
+  vector<IRoadGraph::TEdgeVector> junctionsIngoingEdges(pathSize);
+  vector<FeatureID> featureIds;
+  for (size_t i = 1; i < pathSize; ++i)
+  {
+    if (cancellable.IsCancelled())
+      return;
+
+    bool const isCurrJunctionFinish = (i + 1 == pathSize);
+    GetEdges(graph, path[i], isCurrJunctionFinish, junctionsOutgoingEdges[i],
+             junctionsIngoingEdges[i]);
+
+    featureIds.push_back(routeEdges[i - 1].GetFeatureId());
+    for (Edge const & edge : junctionsOutgoingEdges[i])
+    {
+      if (!edge.IsFake())
+        featureIds.push_back(edge.GetFeatureId());
+    }
+  }
+  LoadRoadAttributes(featureIds);
+
   // |startSegId| is a value to keep start segment id of a new instance of LoadedPathSegment.
   uint32_t startSegId = kInvalidSegId;
   vector<Junction> prevJunctions;
@@ -308,10 +371,9 @@ void BicycleDirectionsEngine::FillPathSegmentsAndAdjacentEdgesMap(
     Junction const & prevJunction = path[i - 1];
     Junction const & currJunction = path[i];
 
-    IRoadGraph::TEdgeVector outgoingEdges;
-    IRoadGraph::TEdgeVector ingoingEdges;
+    IRoadGraph::TEdgeVector const & outgoingEdges = junctionsOutgoingEdges[i];
+    IRoadGraph::TEdgeVector const & ingoingEdges = junctionsIngoingEdges[i];
     bool const isCurrJunctionFinish = (i + 1 == pathSize);
-    GetEdges(graph, currJunction, isCurrJunctionFinish, outgoingEdges, ingoingEdges);
 
     Edge const & inEdge = routeEdges[i - 1];
     // Note. |inFeatureId| may be invalid in case of adding fake features.
@@ -5,10 +5,14 @@
 #include "routing/num_mwm_id.hpp"
 #include "routing/turn_candidate.hpp"
 
+#include "indexer/feature_decl.hpp"
+#include "indexer/ftypes_matcher.hpp"
 #include "indexer/index.hpp"
 
 #include <map>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace routing
 {
@@ -34,7 +38,22 @@ public:
                 vector<Segment> & segments) override;
 
 private:
+  // Attributes of a road feature which are needed for turn generation.
+  struct RoadAttributes
+  {
+    bool m_isLoaded = false;
+    ftypes::HighwayClass m_highwayClass = ftypes::HighwayClass::Undefined;
+    bool m_isLink = false;
+    bool m_onRoundabout = false;
+    std::string m_name;
+  };
+
   Index::FeaturesLoaderGuard & GetLoader(MwmSet::MwmId const & id);
+  /// \brief Loads attributes of |featureIds| which are not cached yet. Features are read
+  /// in the order of mwms and indexes, so every mwm is opened once and reads are sequential.
+  void LoadRoadAttributes(std::vector<FeatureID> & featureIds);
+  /// \returns attributes of |featureId| or nullptr if the feature can't be loaded.
+  RoadAttributes const * GetRoadAttributes(FeatureID const & featureId);
   void LoadPathAttributes(FeatureID const & featureId, LoadedPathSegment & pathSegment);
   void GetUniNodeIdAndAdjacentEdges(IRoadGraph::TEdgeVector const & outgoingEdges,
                                     Edge const & inEdge,
@@ -55,6 +74,8 @@ private:
 
   AdjacentEdgesMap m_adjacentEdges;
   TUnpackedPathSegments m_pathSegments;
+  // Attributes are kept between routes, rerouting usually goes through the same roads.
+  std::map<FeatureID, RoadAttributes> m_roadAttributes;
   Index const & m_index;
   std::shared_ptr<NumMwmIds> m_numMwmIds;
   std::unique_ptr<Index::FeaturesLoaderGuard> m_loader;
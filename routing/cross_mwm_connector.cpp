@@ -135,6 +135,17 @@ bool CrossMwmConnector::WeightsWereLoaded() const
   }
 }
 
+bool CrossMwmConnector::WeightsWereLoaded(Segment const & segment, bool isOutgoing) const
+{
+  if (WeightsWereLoaded())
+    return true;
+
+  if (!isOutgoing)
+    return false;
+
+  return m_enterWeights.count(GetTransition(segment).m_enterIdx) != 0;
+}
+
 std::string DebugPrint(CrossMwmConnector::WeightsLoadState state)
 {
   switch (state)
@@ -166,6 +177,14 @@ CrossMwmConnector::Weight CrossMwmConnector::GetWeight(size_t enterIdx, size_t e
   ASSERT_LESS(enterIdx, m_enters.size(), ());
   ASSERT_LESS(exitIdx, m_exits.size(), ());
 
+  if (m_weights.empty())
+  {
+    auto const it = m_enterWeights.find(base::asserted_cast<uint32_t>(enterIdx));
+    CHECK(it != m_enterWeights.cend(), ("Weights of enter", enterIdx, "weren't loaded."));
+    ASSERT_LESS(exitIdx, it->second.size(), ());
+    return it->second[exitIdx];
+  }
+
   size_t const i = enterIdx * m_exits.size() + exitIdx;
   ASSERT_LESS(i, m_weights.size(), ());
   return m_weights[i];
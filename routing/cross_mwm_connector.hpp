@@ -50,6 +50,9 @@ public:
 
   bool HasWeights() const { return !m_weights.empty(); }
   bool WeightsWereLoaded() const;
+  /// \returns true if weights which are needed for GetEdgeList(|segment|, |isOutgoing|)
+  /// are loaded. It may be so even if all the weights aren't loaded.
+  bool WeightsWereLoaded(Segment const & segment, bool isOutgoing) const;
 
   template <typename CalcWeight>
   void FillWeights(CalcWeight && calcWeight)
@@ -155,6 +158,11 @@ private:
   WeightsLoadState m_weightsLoadState = WeightsLoadState::Unknown;
   uint64_t m_weightsOffset = 0;
   Weight m_granularity = 0;
+  // True if weights of edges from an enter can be loaded without other weights.
+  bool m_canLoadEnterWeights = false;
   std::vector<Weight> m_weights;
+  // Weights of edges from enters, which were loaded one by one, by indices of enters.
+  // It's used while |m_weights| isn't loaded.
+  std::unordered_map<uint32_t, std::vector<Weight>> m_enterWeights;
 };
 }  // namespace routing
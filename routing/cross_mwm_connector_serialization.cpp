@@ -9,6 +9,8 @@ using namespace std;
 namespace routing
 {
 // static
+uint32_t constexpr CrossMwmConnectorSerializer::kEnterOffsetsVersion;
+// static
 uint32_t constexpr CrossMwmConnectorSerializer::kLastVersion;
 
 // static
@@ -34,25 +36,40 @@ void CrossMwmConnectorSerializer::WriteTransitions(vector<Transition> const & tr
 }
 
 // static
-void CrossMwmConnectorSerializer::WriteWeights(vector<Weight> const & weights,
-                                               vector<uint8_t> & buffer)
+void CrossMwmConnectorSerializer::WriteWeights(vector<Weight> const & weights, uint32_t numEnters,
+                                               uint32_t numExits, vector<uint8_t> & buffer)
 {
-  MemWriter<vector<uint8_t>> memWriter(buffer);
-  BitWriter<MemWriter<vector<uint8_t>>> writer(memWriter);
+  CHECK_EQUAL(weights.size(), static_cast<size_t>(numEnters) * numExits, ());
 
-  CrossMwmConnector::Weight prevWeight = 1;
-  for (auto const weight : weights)
+  vector<uint32_t> offsets;
+  offsets.reserve(numEnters);
+  vector<uint8_t> weightsBuffer;
+  MemWriter<vector<uint8_t>> weightsWriter(weightsBuffer);
+  for (size_t enterIdx = 0; enterIdx < numEnters; ++enterIdx)
   {
-    if (weight == CrossMwmConnector::kNoRoute)
+    offsets.push_back(base::checked_cast<uint32_t>(weightsBuffer.size()));
+
+    BitWriter<MemWriter<vector<uint8_t>>> writer(weightsWriter);
+    CrossMwmConnector::Weight prevWeight = 1;
+    for (size_t exitIdx = 0; exitIdx < numExits; ++exitIdx)
     {
-      writer.Write(kNoRouteBit, 1);
-      continue;
-    }
+      auto const weight = weights[enterIdx * numExits + exitIdx];
+      if (weight == CrossMwmConnector::kNoRoute)
+      {
+        writer.Write(kNoRouteBit, 1);
+        continue;
+      }
 
-    writer.Write(kRouteBit, 1);
-    auto const storedWeight = (weight + kGranularity - 1) / kGranularity;
-    WriteDelta(writer, EncodeZigZagDelta(prevWeight, storedWeight) + 1);
-    prevWeight = storedWeight;
+      writer.Write(kRouteBit, 1);
+      auto const storedWeight = (weight + kGranularity - 1) / kGranularity;
+      WriteDelta(writer, EncodeZigZagDelta(prevWeight, storedWeight) + 1);
+      prevWeight = storedWeight;
+    }
   }
+
+  MemWriter<vector<uint8_t>> memWriter(buffer);
+  for (auto const offset : offsets)
+    WriteToSink(memWriter, offset);
+  memWriter.Write(weightsBuffer.data(), weightsBuffer.size());
 }
 }  // namespace routing
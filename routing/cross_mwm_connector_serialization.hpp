@@ -122,9 +122,9 @@ public:
         continue;
 
       std::vector<uint8_t> & buffer = weightBuffers[i];
-      WriteWeights(connector.m_weights, buffer);
       auto const numEnters = base::checked_cast<uint32_t>(connector.GetEnters().size());
       auto const numExits = base::checked_cast<uint32_t>(connector.GetExits().size());
+      WriteWeights(connector.m_weights, numEnters, numExits, buffer);
       auto const vehicleType = static_cast<VehicleType>(i);
       header.AddSection(Section(buffer.size(), numEnters, numExits, vehicleType));
     }
@@ -189,6 +189,7 @@ public:
 
       connector.m_weightsOffset = weightsOffset;
       connector.m_granularity = header.GetGranularity();
+      connector.m_canLoadEnterWeights = header.GetVersion() >= kEnterOffsetsVersion;
       connector.m_weightsLoadState = WeightsLoadState::ReadyToLoad;
       return;
     }
@@ -205,29 +206,54 @@ public:
 
     src.Skip(connector.m_weightsOffset);
 
-    size_t const amount = connector.GetEnters().size() * connector.GetExits().size();
-    connector.m_weights.reserve(amount);
+    size_t const numEnters = connector.GetEnters().size();
+    size_t const numExits = connector.GetExits().size();
+    connector.m_weights.reserve(numEnters * numExits);
 
-    BitReader<Source> reader(src);
-
-    Weight prev = 1;
-    for (size_t i = 0; i < amount; ++i)
+    if (connector.m_canLoadEnterWeights)
     {
-      if (reader.Read(1) == kNoRouteBit)
-      {
-        connector.m_weights.push_back(CrossMwmConnector::kNoRoute);
-        continue;
-      }
-
-      Weight const delta = ReadDelta<Weight>(reader) - 1;
-      Weight const current = DecodeZigZagDelta(prev, delta);
-      connector.m_weights.push_back(current * connector.m_granularity);
-      prev = current;
+      src.Skip(numEnters * sizeof(uint32_t));
+      for (size_t i = 0; i < numEnters; ++i)
+        ReadWeights(numExits, connector.m_granularity, src, connector.m_weights);
+    }
+    else
+    {
+      ReadWeights(numEnters * numExits, connector.m_granularity, src, connector.m_weights);
     }
 
+    connector.m_enterWeights.clear();
     connector.m_weightsLoadState = WeightsLoadState::Loaded;
   }
 
+  /// \brief Loads weights which are needed for CrossMwmConnector::GetEdgeList(|segment|,
+  /// |isOutgoing|). Only weights of edges from |segment| are loaded if it's possible,
+  /// and all weights otherwise.
+  template <class Source>
+  static void DeserializeEdgesWeights(VehicleType vehicle, Segment const & segment,
+                                      bool isOutgoing, CrossMwmConnector & connector, Source & src)
+  {
+    if (!isOutgoing || !connector.m_canLoadEnterWeights)
+    {
+      DeserializeWeights(vehicle, connector, src);
+      return;
+    }
+
+    CHECK(connector.m_weightsLoadState == WeightsLoadState::ReadyToLoad, ());
+    CHECK_GREATER(connector.m_granularity, 0, ());
+
+    uint32_t const enterIdx = connector.GetTransition(segment).m_enterIdx;
+    size_t const numEnters = connector.GetEnters().size();
+    CHECK_LESS(enterIdx, numEnters, ());
+
+    src.Skip(connector.m_weightsOffset + enterIdx * sizeof(uint32_t));
+    auto const offset = ReadPrimitiveFromSource<uint32_t>(src);
+    src.Skip((numEnters - enterIdx - 1) * sizeof(uint32_t) + offset);
+
+    std::vector<Weight> & weights = connector.m_enterWeights[enterIdx];
+    weights.clear();
+    ReadWeights(connector.GetExits().size(), connector.m_granularity, src, weights);
+  }
+
   static void AddTransition(Transition const & transition, VehicleMask requiredMask,
                             CrossMwmConnector & connector)
   {
@@ -244,7 +270,10 @@ private:
   using Weight = CrossMwmConnector::Weight;
   using WeightsLoadState = CrossMwmConnector::WeightsLoadState;
 
-  static uint32_t constexpr kLastVersion = 0;
+  // Since this version weights of edges from every enter are stored separately, with a table
+  // of offsets of them, so weights of edges from an enter can be loaded on demand.
+  static uint32_t constexpr kEnterOffsetsVersion = 1;
+  static uint32_t constexpr kLastVersion = kEnterOffsetsVersion;
   static uint8_t constexpr kNoRouteBit = 0;
   static uint8_t constexpr kRouteBit = 1;
 
@@ -329,7 +358,7 @@ private:
     void Deserialize(Source & src)
     {
       m_version = ReadPrimitiveFromSource<decltype(m_version)>(src);
-      if (m_version != kLastVersion)
+      if (m_version > kLastVersion)
       {
         MYTHROW(CorruptedDataException, ("Unknown cross mwm section version ", m_version,
                                          ", current version ", kLastVersion));
@@ -350,6 +379,7 @@ private:
 
     void AddSection(Section const & section) { m_sections.push_back(section); }
 
+    uint32_t GetVersion() const { return m_version; }
     uint32_t GetNumTransitions() const { return m_numTransitions; }
     uint64_t GetSizeTransitions() const { return m_sizeTransitions; }
     Weight GetGranularity() const { return m_granularity; }
@@ -391,6 +421,32 @@ private:
                                serial::CodingParams const & codingParams, uint32_t bitsPerOsmId,
                                uint8_t bitsPerMask, std::vector<uint8_t> & buffer);
 
-  static void WriteWeights(std::vector<Weight> const & weights, std::vector<uint8_t> & buffer);
+  // Reads |amount| weights, which were written by a single BitWriter, and appends them to |weights|.
+  template <class Source>
+  static void ReadWeights(size_t amount, Weight granularity, Source & src,
+                          std::vector<Weight> & weights)
+  {
+    BitReader<Source> reader(src);
+
+    Weight prev = 1;
+    for (size_t i = 0; i < amount; ++i)
+    {
+      if (reader.Read(1) == kNoRouteBit)
+      {
+        weights.push_back(CrossMwmConnector::kNoRoute);
+        continue;
+      }
+
+      Weight const delta = ReadDelta<Weight>(reader) - 1;
+      Weight const current = DecodeZigZagDelta(prev, delta);
+      weights.push_back(current * granularity);
+      prev = current;
+    }
+  }
+
+  // Writes offsets of weights of edges from every enter and then the weights. Weights of edges
+  // from an enter start from a byte boundary and are written by a separate BitWriter.
+  static void WriteWeights(std::vector<Weight> const & weights, uint32_t numEnters,
+                           uint32_t numExits, std::vector<uint8_t> & buffer);
 };
 }  // namespace routing
@@ -42,7 +42,7 @@ void CrossMwmIndexGraph::GetTwinsByOsmId(Segment const & s, bool isOutgoing,
 void CrossMwmIndexGraph::GetEdgeList(Segment const & s, bool isOutgoing,
                                      vector<SegmentEdge> & edges)
 {
-  CrossMwmConnector const & c = GetCrossMwmConnectorWithWeights(s.GetMwmId());
+  CrossMwmConnector const & c = GetCrossMwmConnectorWithWeights(s, isOutgoing);
   c.GetEdgeList(s, isOutgoing, edges);
 }
 
@@ -57,15 +57,20 @@ CrossMwmConnector const & CrossMwmIndexGraph::GetCrossMwmConnectorWithTransition
       CrossMwmConnectorSerializer::DeserializeTransitions<ReaderSourceFile>);
 }
 
-CrossMwmConnector const & CrossMwmIndexGraph::GetCrossMwmConnectorWithWeights(NumMwmId numMwmId)
+CrossMwmConnector const & CrossMwmIndexGraph::GetCrossMwmConnectorWithWeights(Segment const & s,
+                                                                             bool isOutgoing)
 {
-  CrossMwmConnector const & c = GetCrossMwmConnectorWithTransitions(numMwmId);
-  if (c.WeightsWereLoaded())
+  CrossMwmConnector const & c = GetCrossMwmConnectorWithTransitions(s.GetMwmId());
+  if (c.WeightsWereLoaded(s, isOutgoing))
     return c;
 
-  return Deserialize(
-      numMwmId,
-      CrossMwmConnectorSerializer::DeserializeWeights<ReaderSourceFile>);
+  return Deserialize(s.GetMwmId(), [&s, isOutgoing](VehicleType vehicleType,
+                                                    CrossMwmConnector & connector,
+                                                    ReaderSourceFile & src)
+  {
+    CrossMwmConnectorSerializer::DeserializeEdgesWeights(vehicleType, s, isOutgoing, connector,
+                                                         src);
+  });
 }
 
 TransitionPoints CrossMwmIndexGraph::GetTransitionPoints(Segment const & s, bool isOutgoing)
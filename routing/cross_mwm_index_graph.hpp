@@ -52,7 +52,9 @@ public:
   }
 
 private:
-  CrossMwmConnector const & GetCrossMwmConnectorWithWeights(NumMwmId numMwmId);
+  /// \returns connector of mwm of |s| with loaded weights of edges from (|isOutgoing|)
+  /// or to |s|. Only weights of edges from |s| are loaded when it's possible.
+  CrossMwmConnector const & GetCrossMwmConnectorWithWeights(Segment const & s, bool isOutgoing);
 
   /// \brief Deserializes connectors for an mwm with |numMwmId|.
   /// \param fn is a function implementing deserialization.
@@ -85,9 +87,11 @@ private:
   VehicleType m_vehicleType;
 
   /// \note |m_connectors| contains cache with transition segments and leap edges.
-  /// Each mwm in |m_connectors| may be in two conditions:
+  /// Each mwm in |m_connectors| may be in three conditions:
   /// * with loaded transition segments (after a call to
   /// CrossMwmConnectorSerializer::DeserializeTransitions())
+  /// * with loaded transition segments and with loaded weights of edges from some enters
+  ///   (after calls to CrossMwmConnectorSerializer::DeserializeEdgesWeights())
   /// * with loaded transition segments and with loaded weights
   ///   (after a call to CrossMwmConnectorSerializer::DeserializeTransitions()
   ///   and CrossMwmConnectorSerializer::DeserializeWeights())
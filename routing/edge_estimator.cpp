@@ -97,6 +97,21 @@ double EdgeEstimator::CalcLeapWeight(m2::PointD const & from, m2::PointD const &
   return TimeBetweenSec(from, to, m_maxSpeedMPS / 2.0);
 }
 
+void EdgeEstimator::SetDeparture(m2::PointD const & point, uint32_t timeOfDaySec)
+{
+  m_hasDeparture = true;
+  m_departurePoint = point;
+  m_departureTimeOfDaySec = timeOfDaySec;
+}
+
+uint32_t EdgeEstimator::GetArrivalTimeOfDaySec(m2::PointD const & point) const
+{
+  ASSERT(m_hasDeparture, ());
+  uint32_t constexpr kDaySec = 24 * 60 * 60;
+  auto const travelSec = static_cast<uint64_t>(CalcHeuristic(m_departurePoint, point));
+  return static_cast<uint32_t>((m_departureTimeOfDaySec + travelSec) % kDaySec);
+}
+
 // PedestrianEstimator -----------------------------------------------------------------------------
 class PedestrianEstimator final : public EdgeEstimator
 {
@@ -137,6 +152,8 @@ public:
 
   // EdgeEstimator overrides:
   double CalcSegmentWeight(Segment const & segment, RoadGeometry const & road) const override;
+  double CalcSegmentWeight(Segment const & segment, RoadGeometry const & road,
+                           SpeedProfiles const & profiles) const override;
   double GetUTurnPenalty() const override;
   bool LeapIsAllowed(NumMwmId mwmId) const override;
 
@@ -173,6 +190,23 @@ double CarEstimator::CalcSegmentWeight(Segment const & segment, RoadGeometry con
   return result;
 }
 
+double CarEstimator::CalcSegmentWeight(Segment const & segment, RoadGeometry const & road,
+                                       SpeedProfiles const & profiles) const
+{
+  double const result = CalcSegmentWeight(segment, road);
+  if (profiles.IsEmpty() || !HasDeparture())
+    return result;
+
+  // Live traffic is more accurate than historical speeds.
+  if (m_trafficStash && m_trafficStash->GetSpeedGroup(segment) != SpeedGroup::Unknown)
+    return result;
+
+  m2::PointD const & point = road.GetPoint(segment.GetPointId(false /* front */));
+  double const factor = profiles.GetSpeedFactor(segment, GetArrivalTimeOfDaySec(point));
+  ASSERT_GREATER(factor, 0.0, ());
+  return result / factor;
+}
+
 double CarEstimator::GetUTurnPenalty() const
 {
   // Adds 2 minutes penalty for U-turn. The value is quite arbitrary
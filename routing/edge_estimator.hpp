@@ -3,6 +3,7 @@
 #include "routing/geometry.hpp"
 #include "routing/num_mwm_id.hpp"
 #include "routing/segment.hpp"
+#include "routing/speed_profiles.hpp"
 #include "routing/traffic_stash.hpp"
 #include "routing/vehicle_mask.hpp"
 
@@ -14,6 +15,7 @@
 
 #include "geometry/point2d.hpp"
 
+#include <cstdint>
 #include <memory>
 
 namespace routing
@@ -34,16 +36,39 @@ public:
   double CalcLeapWeight(m2::PointD const & from, m2::PointD const & to) const;
 
   virtual double CalcSegmentWeight(Segment const & segment, RoadGeometry const & road) const = 0;
+  // Returns time in seconds it takes to go along |segment| taking historical speeds of
+  // |profiles| into account. By default the profiles are ignored.
+  virtual double CalcSegmentWeight(Segment const & segment, RoadGeometry const & road,
+                                   SpeedProfiles const & /* profiles */) const
+  {
+    return CalcSegmentWeight(segment, road);
+  }
   virtual double GetUTurnPenalty() const = 0;
   // The leap is the shortcut edge from mwm border enter to exit.
   // Router can't use leaps on some mwms: e.g. mwm with loaded traffic data.
   // Check wherether leap is allowed on specified mwm or not.
   virtual bool LeapIsAllowed(NumMwmId mwmId) const = 0;
 
+  // Sets the start of the route: it departs from |point| at |timeOfDaySec| seconds since
+  // midnight. Historical speeds of a segment are taken at the time the segment is reached.
+  // The time is estimated as the departure time plus CalcHeuristic() from |point| to the segment.
+  // It's a lower bound of the arrival time, but it doesn't depend on the wave which reaches
+  // the segment, so segment weights stay the same during bidirectional and leaps searches.
+  void SetDeparture(m2::PointD const & point, uint32_t timeOfDaySec);
+  // Switches historical speeds off till the next SetDeparture() call.
+  void ResetDeparture() { m_hasDeparture = false; }
+
   static std::shared_ptr<EdgeEstimator> Create(VehicleType, double maxSpeedKMpH,
                                                std::shared_ptr<TrafficStash>);
 
+protected:
+  bool HasDeparture() const { return m_hasDeparture; }
+  uint32_t GetArrivalTimeOfDaySec(m2::PointD const & point) const;
+
 private:
   double const m_maxSpeedMPS;
+  bool m_hasDeparture = false;
+  m2::PointD m_departurePoint = m2::PointD::Zero();
+  uint32_t m_departureTimeOfDaySec = 0;
 };
 }  // namespace routing
@@ -196,7 +196,7 @@ void FeaturesRoadGraph::FindClosestEdges(m2::PointD const & point, uint32_t coun
 void FeaturesRoadGraph::GetFeatureTypes(FeatureID const & featureId, feature::TypesHolder & types) const
 {
   FeatureType ft;
-  Index::FeaturesLoaderGuard loader(m_index, featureId.m_mwmId);
+  Index::FeaturesLoaderGuard loader(m_index, featureId.m_mwmId, true /* useFeatureCache */);
   if (!loader.GetFeatureByIndex(featureId.m_index, ft))
     return;
 
@@ -297,7 +297,7 @@ IRoadGraph::RoadInfo const & FeaturesRoadGraph::GetCachedRoadInfo(FeatureID cons
 
   FeatureType ft;
 
-  Index::FeaturesLoaderGuard loader(m_index, featureId.m_mwmId);
+  Index::FeaturesLoaderGuard loader(m_index, featureId.m_mwmId, true /* useFeatureCache */);
 
   if (!loader.GetFeatureByIndex(featureId.m_index, ft))
     return ri;
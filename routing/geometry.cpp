@@ -8,6 +8,7 @@
 
 #include "base/assert.hpp"
 
+#include <sstream>
 #include <string>
 
 using namespace routing;
@@ -20,7 +21,8 @@ class GeometryLoaderImpl final : public GeometryLoader
 {
 public:
   GeometryLoaderImpl(Index const & index, MwmSet::MwmHandle const & handle,
-                     shared_ptr<VehicleModelInterface> vehicleModel, bool loadAltitudes);
+                     shared_ptr<VehicleModelInterface> vehicleModel, bool loadAltitudes,
+                     shared_ptr<RoadJunctionsCache> junctionsCache);
 
   // GeometryLoader overrides:
   void Load(uint32_t featureId, RoadGeometry & road) override;
@@ -31,15 +33,19 @@ private:
   string const m_country;
   feature::AltitudeLoader m_altitudeLoader;
   bool const m_loadAltitudes;
+  shared_ptr<RoadJunctionsCache> m_junctionsCache;
+  RoadJunctions m_junctions;
 };
 
 GeometryLoaderImpl::GeometryLoaderImpl(Index const & index, MwmSet::MwmHandle const & handle,
-                                       shared_ptr<VehicleModelInterface> vehicleModel, bool loadAltitudes)
+                                       shared_ptr<VehicleModelInterface> vehicleModel, bool loadAltitudes,
+                                       shared_ptr<RoadJunctionsCache> junctionsCache)
   : m_vehicleModel(move(vehicleModel))
-  , m_guard(index, handle.GetId())
+  , m_guard(index, handle.GetId(), true /* useFeatureCache */)
   , m_country(handle.GetInfo()->GetCountryName())
   , m_altitudeLoader(index, handle.GetId())
   , m_loadAltitudes(loadAltitudes)
+  , m_junctionsCache(move(junctionsCache))
 {
   CHECK(handle.IsAlive(), ());
   CHECK(m_vehicleModel, ());
@@ -52,6 +58,14 @@ void GeometryLoaderImpl::Load(uint32_t featureId, RoadGeometry & road)
   if (!isFound)
     MYTHROW(RoutingException, ("Feature", featureId, "not found in ", m_country));
 
+  // Geometry decoding and altitudes are skipped if the road was loaded for another vehicle.
+  MwmSet::MwmId const & mwmId = m_guard.GetId();
+  if (m_junctionsCache && m_junctionsCache->Get(mwmId, featureId, m_loadAltitudes, m_junctions))
+  {
+    road.Load(*m_vehicleModel, feature, m_junctions);
+    return;
+  }
+
   feature.ParseGeometry(FeatureType::BEST_GEOMETRY);
 
   feature::TAltitudes const * altitudes = nullptr;
@@ -60,6 +74,9 @@ void GeometryLoaderImpl::Load(uint32_t featureId, RoadGeometry & road)
 
   road.Load(*m_vehicleModel, feature, altitudes);
   m_altitudeLoader.ClearCache();
+
+  if (m_junctionsCache)
+    m_junctionsCache->Put(mwmId, featureId, m_loadAltitudes, road.GetJunctions());
 }
 
 // FileGeometryLoader ------------------------------------------------------------------------------
@@ -111,11 +128,6 @@ void RoadGeometry::Load(VehicleModelInterface const & vehicleModel, FeatureType
 {
   CHECK(altitudes == nullptr || altitudes->size() == feature.GetPointsCount(), ());
 
-  m_valid = vehicleModel.IsRoad(feature);
-  m_isOneWay = vehicleModel.IsOneWay(feature);
-  m_speed = vehicleModel.GetSpeed(feature);
-  m_isTransitAllowed = vehicleModel.IsTransitAllowed(feature);
-
   m_junctions.clear();
   m_junctions.reserve(feature.GetPointsCount());
   for (size_t i = 0; i < feature.GetPointsCount(); ++i)
@@ -124,6 +136,24 @@ void RoadGeometry::Load(VehicleModelInterface const & vehicleModel, FeatureType
                              altitudes ? (*altitudes)[i] : feature::kDefaultAltitudeMeters);
   }
 
+  LoadAttributes(vehicleModel, feature);
+}
+
+void RoadGeometry::Load(VehicleModelInterface const & vehicleModel, FeatureType const & feature,
+                        RoadJunctions const & junctions)
+{
+  m_junctions = junctions;
+  LoadAttributes(vehicleModel, feature);
+}
+
+void RoadGeometry::LoadAttributes(VehicleModelInterface const & vehicleModel,
+                                  FeatureType const & feature)
+{
+  m_valid = vehicleModel.IsRoad(feature);
+  m_isOneWay = vehicleModel.IsOneWay(feature);
+  m_speed = vehicleModel.GetSpeed(feature);
+  m_isTransitAllowed = vehicleModel.IsTransitAllowed(feature);
+
   if (m_valid && m_speed <= 0.0)
   {
     auto const & id = feature.GetID();
@@ -136,7 +166,21 @@ void RoadGeometry::Load(VehicleModelInterface const & vehicleModel, FeatureType
   }
 }
 
+// static
+size_t constexpr RoadGeometry::kInlineJunctions;
+
+size_t RoadGeometry::GetMemorySize() const
+{
+  size_t bytes = sizeof(RoadGeometry);
+  if (m_junctions.size() > kInlineJunctions)
+    bytes += m_junctions.size() * sizeof(Junction);
+  return bytes;
+}
+
 // Geometry ----------------------------------------------------------------------------------------
+// static
+size_t constexpr Geometry::kMinCachedRoads;
+
 Geometry::Geometry(unique_ptr<GeometryLoader> loader) : m_loader(move(loader))
 {
   CHECK(m_loader, ());
@@ -146,21 +190,81 @@ RoadGeometry const & Geometry::GetRoad(uint32_t featureId)
 {
   auto const & it = m_roads.find(featureId);
   if (it != m_roads.cend())
-    return it->second;
+  {
+    ++m_stats.m_hits;
+    CachedRoad & cached = it->second;
+    if (m_cacheBytesLimit != 0)
+      m_lru.splice(m_lru.begin(), m_lru, cached.m_lruIt);
+    return cached.m_road;
+  }
+
+  ++m_stats.m_misses;
+  CachedRoad & cached = m_roads[featureId];
+  m_loader->Load(featureId, cached.m_road);
+
+  // Hash table and list nodes are taken into account too.
+  cached.m_bytes = cached.m_road.GetMemorySize() + sizeof(CachedRoad) + 4 * sizeof(void *);
+  m_cacheBytes += cached.m_bytes;
 
-  RoadGeometry & road = m_roads[featureId];
-  m_loader->Load(featureId, road);
-  return road;
+  if (m_cacheBytesLimit != 0)
+  {
+    cached.m_lruIt = m_lru.insert(m_lru.begin(), featureId);
+    EvictIfNeeded();
+  }
+  return cached.m_road;
+}
+
+void Geometry::SetCacheBytesLimit(size_t bytesLimit)
+{
+  if (m_cacheBytesLimit == 0 && bytesLimit != 0)
+  {
+    // Order of previously loaded roads is unknown.
+    m_lru.clear();
+    for (auto & kv : m_roads)
+      kv.second.m_lruIt = m_lru.insert(m_lru.end(), kv.first);
+  }
+  else if (bytesLimit == 0)
+  {
+    m_lru.clear();
+  }
+
+  m_cacheBytesLimit = bytesLimit;
+  if (m_cacheBytesLimit != 0)
+    EvictIfNeeded();
+}
+
+void Geometry::EvictIfNeeded()
+{
+  ASSERT_EQUAL(m_lru.size(), m_roads.size(), ());
+  while (m_cacheBytes > m_cacheBytesLimit && m_roads.size() > kMinCachedRoads)
+  {
+    auto const it = m_roads.find(m_lru.back());
+    CHECK(it != m_roads.end(), ());
+    m_cacheBytes -= it->second.m_bytes;
+    m_roads.erase(it);
+    m_lru.pop_back();
+    ++m_stats.m_evictions;
+  }
+}
+
+string DebugPrint(Geometry::CacheStats const & stats)
+{
+  ostringstream out;
+  out << "CacheStats [ hits: " << stats.m_hits << ", misses: " << stats.m_misses
+      << ", evictions: " << stats.m_evictions << " ]";
+  return out.str();
 }
 
 // static
 unique_ptr<GeometryLoader> GeometryLoader::Create(Index const & index,
                                                   MwmSet::MwmHandle const & handle,
                                                   shared_ptr<VehicleModelInterface> vehicleModel,
-                                                  bool loadAltitudes)
+                                                  bool loadAltitudes,
+                                                  shared_ptr<RoadJunctionsCache> junctionsCache)
 {
   CHECK(handle.IsAlive(), ());
-  return make_unique<GeometryLoaderImpl>(index, handle, vehicleModel, loadAltitudes);
+  return make_unique<GeometryLoaderImpl>(index, handle, vehicleModel, loadAltitudes,
+                                         move(junctionsCache));
 }
 
 // static
@@ -1,7 +1,8 @@
 #pragma once
 
-#include "routing/road_point.hpp"
 #include "routing/road_graph.hpp"
+#include "routing/road_junctions_cache.hpp"
+#include "routing/road_point.hpp"
 
 #include "routing_common/vehicle_model.hpp"
 
@@ -12,7 +13,9 @@
 
 #include "base/buffer_vector.hpp"
 
+#include <cstddef>
 #include <cstdint>
+#include <list>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -29,6 +32,10 @@ public:
 
   void Load(VehicleModelInterface const & vehicleModel, FeatureType const & feature,
             feature::TAltitudes const * altitudes);
+  // Loads vehicle dependent attributes of |feature|, geometry of the road is |junctions|.
+  // Geometry of |feature| is not used and may be not parsed.
+  void Load(VehicleModelInterface const & vehicleModel, FeatureType const & feature,
+            RoadJunctions const & junctions);
 
   bool IsOneWay() const { return m_isOneWay; }
   // Kilometers per hour.
@@ -43,6 +50,8 @@ public:
 
   m2::PointD const & GetPoint(uint32_t pointId) const { return GetJunction(pointId).GetPoint(); }
 
+  RoadJunctions const & GetJunctions() const { return m_junctions; }
+
   uint32_t GetPointsCount() const { return static_cast<uint32_t>(m_junctions.size()); }
 
   // Note. It's possible that car_model was changed after the map was built.
@@ -59,8 +68,15 @@ public:
 
   void SetTransitAllowedForTests(bool transitAllowed) { m_isTransitAllowed = transitAllowed; }
 
+  // Approximate number of bytes occupied by the road.
+  size_t GetMemorySize() const;
+
 private:
-  buffer_vector<Junction, 32> m_junctions;
+  void LoadAttributes(VehicleModelInterface const & vehicleModel, FeatureType const & feature);
+
+  static size_t constexpr kInlineJunctions = kRoadInlineJunctions;
+
+  RoadJunctions m_junctions;
   double m_speed = 0.0;
   bool m_isOneWay = false;
   bool m_valid = false;
@@ -75,10 +91,11 @@ public:
   virtual void Load(uint32_t featureId, RoadGeometry & road) = 0;
 
   // handle should be alive: it is caller responsibility to check it.
-  static std::unique_ptr<GeometryLoader> Create(Index const & index,
-                                                MwmSet::MwmHandle const & handle,
-                                                std::shared_ptr<VehicleModelInterface> vehicleModel,
-                                                bool loadAltitudes);
+  // Geometry of roads is shared through |junctionsCache| if it's not null.
+  static std::unique_ptr<GeometryLoader> Create(
+      Index const & index, MwmSet::MwmHandle const & handle,
+      std::shared_ptr<VehicleModelInterface> vehicleModel, bool loadAltitudes,
+      std::shared_ptr<RoadJunctionsCache> junctionsCache = nullptr);
 
   /// This is for stand-alone work.
   /// Use in generator_tool and unit tests.
@@ -89,6 +106,17 @@ public:
 class Geometry final
 {
 public:
+  struct CacheStats
+  {
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
+  };
+
+  // Roads which are not least recently used ones are never evicted, so a reference
+  // returned by GetRoad stays valid while less than kMinCachedRoads other roads are requested.
+  static size_t constexpr kMinCachedRoads = 64;
+
   Geometry() = default;
   explicit Geometry(std::unique_ptr<GeometryLoader> loader);
 
@@ -99,9 +127,34 @@ public:
     return GetRoad(rp.GetFeatureId()).GetPoint(rp.GetPointId());
   }
 
+  // Sets memory budget for loaded roads. Least recently used roads are evicted when
+  // the budget is exceeded. Zero means no limit.
+  void SetCacheBytesLimit(size_t bytesLimit);
+
+  CacheStats const & GetCacheStats() const { return m_stats; }
+  size_t GetCacheBytes() const { return m_cacheBytes; }
+  size_t GetNumCachedRoads() const { return m_roads.size(); }
+
 private:
+  struct CachedRoad
+  {
+    RoadGeometry m_road;
+    size_t m_bytes = 0;
+    std::list<uint32_t>::iterator m_lruIt;
+  };
+
+  void EvictIfNeeded();
+
   // Feature id to RoadGeometry map.
-  std::unordered_map<uint32_t, RoadGeometry> m_roads;
+  std::unordered_map<uint32_t, CachedRoad> m_roads;
+  // Feature ids of |m_roads| from the most recently used to the least recently used one.
+  // It's kept only if |m_cacheBytesLimit| is set.
+  std::list<uint32_t> m_lru;
+  size_t m_cacheBytesLimit = 0;
+  size_t m_cacheBytes = 0;
+  CacheStats m_stats;
   std::unique_ptr<GeometryLoader> m_loader;
 };
+
+std::string DebugPrint(Geometry::CacheStats const & stats);
 }  // namespace routing
@@ -5,6 +5,7 @@
 #include "base/assert.hpp"
 #include "base/checked_cast.hpp"
 #include "base/exception.hpp"
+#include "base/macros.hpp"
 
 #include <algorithm>
 #include <limits>
@@ -20,39 +21,6 @@ bool IsUTurn(Segment const & u, Segment const & v)
   return u.GetFeatureId() == v.GetFeatureId() && u.GetSegmentIdx() == v.GetSegmentIdx() &&
          u.IsForward() != v.IsForward();
 }
-
-bool IsRestricted(RestrictionVec const & restrictions, Segment const & u, Segment const & v,
-                  bool isOutgoing)
-{
-  uint32_t const featureIdFrom = isOutgoing ? u.GetFeatureId() : v.GetFeatureId();
-  uint32_t const featureIdTo = isOutgoing ? v.GetFeatureId() : u.GetFeatureId();
-
-  if (!binary_search(restrictions.cbegin(), restrictions.cend(),
-                     Restriction(Restriction::Type::No, {featureIdFrom, featureIdTo})))
-  {
-    return false;
-  }
-
-  if (featureIdFrom != featureIdTo)
-    return true;
-
-  // @TODO(bykoianko) According to current code if a feature id is marked as a feature with
-  // restrictricted U-turn it's restricted to make a U-turn on the both ends of the feature.
-  // Generally speaking it's wrong. In osm there's information about the end of the feature
-  // where the U-turn is restricted. It's necessary to pass the data to mwm and to use it here.
-  // Please see test LineGraph_RestrictionF1F1No for details.
-  //
-  // Another example when it's necessary to be aware about feature end participated in restriction
-  // is
-  //        *---F1---*
-  //        |        |
-  // *--F3--A        B--F4--*
-  //        |        |
-  //        *---F2---*
-  // In case of restriction F1-A-F2 or F1-B-F2 of any type (No, Only) the important information
-  // is lost.
-  return IsUTurn(u, v);
-}
 }  // namespace
 
 namespace routing
@@ -91,12 +59,29 @@ void IndexGraph::Import(vector<Joint> const & joints)
 
 void IndexGraph::SetRestrictions(RestrictionVec && restrictions)
 {
-  ASSERT(is_sorted(restrictions.cbegin(), restrictions.cend()), ());
-  m_restrictions = move(restrictions);
+  m_restrictions.clear();
+  for (Restriction const & restriction : restrictions)
+  {
+    if (restriction.m_type != Restriction::Type::No || restriction.m_featureIds.size() != 2)
+      continue;
+
+    m_restrictions.insert(
+        UINT64_FROM_UINT32(restriction.m_featureIds[0], restriction.m_featureIds[1]));
+  }
 }
 
 void IndexGraph::SetRoadAccess(RoadAccess && roadAccess) { m_roadAccess = move(roadAccess); }
 
+void IndexGraph::SetShortcutOverlay(ShortcutOverlay && overlay)
+{
+  m_shortcutOverlay = move(overlay);
+}
+
+void IndexGraph::SetSpeedProfiles(SpeedProfiles && profiles)
+{
+  m_speedProfiles = move(profiles);
+}
+
 void IndexGraph::GetOutgoingEdgesList(Segment const & segment, vector<SegmentEdge> & edges)
 {
   edges.clear();
@@ -119,7 +104,8 @@ RouteWeight IndexGraph::HeuristicCostEstimate(Segment const & from, Segment cons
 RouteWeight IndexGraph::CalcSegmentWeight(Segment const & segment)
 {
   return RouteWeight(
-      m_estimator->CalcSegmentWeight(segment, m_geometry.GetRoad(segment.GetFeatureId())),
+      m_estimator->CalcSegmentWeight(segment, m_geometry.GetRoad(segment.GetFeatureId()),
+                                     m_speedProfiles),
       0 /* nontransitCross */);
 }
 
@@ -159,7 +145,7 @@ void IndexGraph::GetNeighboringEdge(Segment const & from, Segment const & to, bo
     return;
   }
 
-  if (IsRestricted(m_restrictions, from, to, isOutgoing))
+  if (IsRestricted(from, to, isOutgoing))
     return;
 
   if (m_roadAccess.GetSegmentType(to) != RoadAccess::Type::Yes)
@@ -170,6 +156,38 @@ void IndexGraph::GetNeighboringEdge(Segment const & from, Segment const & to, bo
   edges.emplace_back(to, weight);
 }
 
+bool IndexGraph::IsRestricted(Segment const & u, Segment const & v, bool isOutgoing) const
+{
+  if (m_restrictions.empty())
+    return false;
+
+  uint32_t const featureIdFrom = isOutgoing ? u.GetFeatureId() : v.GetFeatureId();
+  uint32_t const featureIdTo = isOutgoing ? v.GetFeatureId() : u.GetFeatureId();
+
+  if (m_restrictions.count(UINT64_FROM_UINT32(featureIdFrom, featureIdTo)) == 0)
+    return false;
+
+  if (featureIdFrom != featureIdTo)
+    return true;
+
+  // @TODO(bykoianko) According to current code if a feature id is marked as a feature with
+  // restrictricted U-turn it's restricted to make a U-turn on the both ends of the feature.
+  // Generally speaking it's wrong. In osm there's information about the end of the feature
+  // where the U-turn is restricted. It's necessary to pass the data to mwm and to use it here.
+  // Please see test LineGraph_RestrictionF1F1No for details.
+  //
+  // Another example when it's necessary to be aware about feature end participated in restriction
+  // is
+  //        *---F1---*
+  //        |        |
+  // *--F3--A        B--F4--*
+  //        |        |
+  //        *---F2---*
+  // In case of restriction F1-A-F2 or F1-B-F2 of any type (No, Only) the important information
+  // is lost.
+  return IsUTurn(u, v);
+}
+
 RouteWeight IndexGraph::GetPenalties(Segment const & u, Segment const & v)
 {
   bool const fromTransitAllowed = m_geometry.GetRoad(u.GetFeatureId()).IsTransitAllowed();
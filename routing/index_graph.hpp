@@ -9,12 +9,15 @@
 #include "routing/road_index.hpp"
 #include "routing/road_point.hpp"
 #include "routing/segment.hpp"
+#include "routing/shortcut_overlay.hpp"
+#include "routing/speed_profiles.hpp"
 
 #include "geometry/point2d.hpp"
 
 #include "std/cstdint.hpp"
 #include "std/shared_ptr.hpp"
 #include "std/unique_ptr.hpp"
+#include "std/unordered_set.hpp"
 #include "std/utility.hpp"
 #include "std/vector.hpp"
 
@@ -45,6 +48,9 @@ public:
     return m_roadAccess.GetSegmentType(segment);
   }
 
+  ShortcutOverlay const & GetShortcutOverlay() const { return m_shortcutOverlay; }
+  SpeedProfiles const & GetSpeedProfiles() const { return m_speedProfiles; }
+
   uint32_t GetNumRoads() const { return m_roadIndex.GetSize(); }
   uint32_t GetNumJoints() const { return m_jointIndex.GetNumJoints(); }
   uint32_t GetNumPoints() const { return m_jointIndex.GetNumPoints(); }
@@ -52,14 +58,22 @@ public:
   void Build(uint32_t numJoints);
   void Import(vector<Joint> const & joints);
 
+  /// \note Only restrictions of type No with two features are taken into account,
+  /// restrictions of type Only should be converted with ConvertRestrictionsOnlyToNoAndSort().
   void SetRestrictions(RestrictionVec && restrictions);
   void SetRoadAccess(RoadAccess && roadAccess);
+  void SetShortcutOverlay(ShortcutOverlay && overlay);
+  void SetSpeedProfiles(SpeedProfiles && profiles);
 
   // Interface for AStarAlgorithm:
   void GetOutgoingEdgesList(Segment const & segment, vector<SegmentEdge> & edges);
   void GetIngoingEdgesList(Segment const & segment, vector<SegmentEdge> & edges);
   RouteWeight HeuristicCostEstimate(Segment const & from, Segment const & to);
 
+  RouteWeight CalcSegmentWeight(Segment const & segment);
+
+  void ReserveFromSerializer(size_t numRoads) { m_roadIndex.Reserve(numRoads); }
+
   void PushFromSerializer(Joint::Id jointId, RoadPoint const & rp)
   {
     m_roadIndex.PushFromSerializer(jointId, rp);
@@ -78,12 +92,12 @@ public:
   }
 
 private:
-  RouteWeight CalcSegmentWeight(Segment const & segment);
   void GetNeighboringEdges(Segment const & from, RoadPoint const & rp, bool isOutgoing,
                            vector<SegmentEdge> & edges);
   void GetNeighboringEdge(Segment const & from, Segment const & to, bool isOutgoing,
                           vector<SegmentEdge> & edges);
   RouteWeight GetPenalties(Segment const & u, Segment const & v);
+  bool IsRestricted(Segment const & u, Segment const & v, bool isOutgoing) const;
   m2::PointD const & GetPoint(Segment const & segment, bool front)
   {
     return GetGeometry().GetRoad(segment.GetFeatureId()).GetPoint(segment.GetPointId(front));
@@ -93,7 +107,11 @@ private:
   shared_ptr<EdgeEstimator> m_estimator;
   RoadIndex m_roadIndex;
   JointIndex m_jointIndex;
-  RestrictionVec m_restrictions;
+  // Pairs of features (from, to) of No restrictions, see UINT64_FROM_UINT32.
+  // Every examined edge is checked against restrictions, so they are kept in a hash set.
+  unordered_set<uint64_t> m_restrictions;
   RoadAccess m_roadAccess;
+  ShortcutOverlay m_shortcutOverlay;
+  SpeedProfiles m_speedProfiles;
 };
 }  // namespace routing
@@ -4,11 +4,17 @@
 #include "routing/restriction_loader.hpp"
 #include "routing/road_access_serialization.hpp"
 #include "routing/routing_exceptions.hpp"
+#include "routing/shortcut_overlay_serialization.hpp"
+#include "routing/speed_profiles_serialization.hpp"
 
 #include "coding/file_container.hpp"
 
 #include "base/assert.hpp"
 #include "base/timer.hpp"
+#include "base/worker_thread.hpp"
+
+#include <exception>
+#include <future>
 
 namespace
 {
@@ -20,14 +26,28 @@ class IndexGraphLoaderImpl final : public IndexGraphLoader
 public:
   IndexGraphLoaderImpl(VehicleType vehicleType, bool loadAltitudes, shared_ptr<NumMwmIds> numMwmIds,
                        shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
-                       shared_ptr<EdgeEstimator> estimator, Index & index);
+                       shared_ptr<EdgeEstimator> estimator, Index & index,
+                       size_t roadGeometryCacheBytes, shared_ptr<RoadJunctionsCache> junctionsCache);
 
   // IndexGraphLoader overrides:
   virtual IndexGraph & GetIndexGraph(NumMwmId numMwmId) override;
+  virtual void Prefetch(NumMwmId numMwmId) override;
   virtual void Clear() override;
+  virtual double GetLoadingTimeSec() const override { return m_loadingTimeSec; }
 
 private:
+  // Graph which is deserialized on a prefetch thread.
+  struct PrefetchedGraph
+  {
+    unique_ptr<IndexGraph> m_graph;
+    future<void> m_ready;
+  };
+
   IndexGraph & Load(NumMwmId mwmId);
+  // Creates a graph with a geometry loader. Routing sections are not loaded.
+  unique_ptr<IndexGraph> CreateGraph(NumMwmId numMwmId, MwmSet::MwmHandle const & handle);
+  // Waits for the prefetch of |numMwmId| and moves the graph to |m_graphs|.
+  IndexGraph & TakePrefetched(NumMwmId numMwmId);
 
   VehicleMask m_vehicleMask;
   bool m_loadAltitudes;
@@ -35,18 +55,33 @@ private:
   shared_ptr<NumMwmIds> m_numMwmIds;
   shared_ptr<VehicleModelFactoryInterface> m_vehicleModelFactory;
   shared_ptr<EdgeEstimator> m_estimator;
+  size_t const m_roadGeometryCacheBytes;
+  shared_ptr<RoadJunctionsCache> m_junctionsCache;
   unordered_map<NumMwmId, unique_ptr<IndexGraph>> m_graphs;
+  unordered_map<NumMwmId, PrefetchedGraph> m_prefetched;
+  // Note. Threads are declared after |m_prefetched| to be joined before the graphs
+  // they fill in are destroyed.
+  vector<unique_ptr<base::WorkerThread>> m_prefetchThreads;
+  size_t m_nextPrefetchThread = 0;
+  double m_loadingTimeSec = 0.0;
 };
 
+// Number of threads which deserialize routing sections of mwms the route is expected to enter.
+size_t constexpr kPrefetchThreadsCount = 2;
+
 IndexGraphLoaderImpl::IndexGraphLoaderImpl(VehicleType vehicleType, bool loadAltitudes, shared_ptr<NumMwmIds> numMwmIds,
                                            shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
-                                           shared_ptr<EdgeEstimator> estimator, Index & index)
+                                           shared_ptr<EdgeEstimator> estimator, Index & index,
+                                           size_t roadGeometryCacheBytes,
+                                           shared_ptr<RoadJunctionsCache> junctionsCache)
   : m_vehicleMask(GetVehicleMask(vehicleType))
   , m_loadAltitudes(loadAltitudes)
   , m_index(index)
   , m_numMwmIds(numMwmIds)
   , m_vehicleModelFactory(vehicleModelFactory)
   , m_estimator(estimator)
+  , m_roadGeometryCacheBytes(roadGeometryCacheBytes)
+  , m_junctionsCache(move(junctionsCache))
 {
   CHECK(m_numMwmIds, ());
   CHECK(m_vehicleModelFactory, ());
@@ -59,34 +94,127 @@ IndexGraph & IndexGraphLoaderImpl::GetIndexGraph(NumMwmId numMwmId)
   if (it != m_graphs.end())
     return *it->second;
 
+  if (m_prefetched.count(numMwmId) != 0)
+    return TakePrefetched(numMwmId);
+
   return Load(numMwmId);
 }
 
-IndexGraph & IndexGraphLoaderImpl::Load(NumMwmId numMwmId)
+void IndexGraphLoaderImpl::Prefetch(NumMwmId numMwmId)
 {
-  platform::CountryFile const & file = m_numMwmIds->GetFile(numMwmId);
-  MwmSet::MwmHandle handle = m_index.GetMwmHandleByCountryFile(file);
+  if (m_graphs.count(numMwmId) != 0 || m_prefetched.count(numMwmId) != 0)
+    return;
+
+  MwmSet::MwmHandle handle = m_index.GetMwmHandleByCountryFile(m_numMwmIds->GetFile(numMwmId));
+  // GetIndexGraph reports the error if the mwm is not available.
   if (!handle.IsAlive())
-    MYTHROW(RoutingException, ("Can't get mwm handle for", file));
+    return;
+
+  PrefetchedGraph & prefetched = m_prefetched[numMwmId];
+  prefetched.m_graph = CreateGraph(numMwmId, handle);
+
+  // MwmValue of |handle| is used by the router thread, and its readers are not thread safe.
+  // So the prefetch thread reads the mwm with its own MwmValue.
+  platform::LocalCountryFile const localFile = handle.GetValue<MwmValue>()->m_file;
+  IndexGraph * graph = prefetched.m_graph.get();
+  auto ready = make_shared<promise<void>>();
+  prefetched.m_ready = ready->get_future();
+  VehicleMask const vehicleMask = m_vehicleMask;
+
+  if (m_prefetchThreads.empty())
+  {
+    for (size_t i = 0; i < kPrefetchThreadsCount; ++i)
+      m_prefetchThreads.push_back(make_unique<base::WorkerThread>());
+  }
+
+  auto & thread = *m_prefetchThreads[m_nextPrefetchThread];
+  m_nextPrefetchThread = (m_nextPrefetchThread + 1) % m_prefetchThreads.size();
+  thread.Push([localFile, graph, ready, vehicleMask]() {
+    try
+    {
+      MwmValue const mwmValue(localFile);
+      DeserializeIndexGraph(mwmValue, vehicleMask, *graph);
+      ready->set_value();
+    }
+    catch (...)
+    {
+      ready->set_exception(current_exception());
+    }
+  });
+}
+
+IndexGraph & IndexGraphLoaderImpl::TakePrefetched(NumMwmId numMwmId)
+{
+  auto it = m_prefetched.find(numMwmId);
+  CHECK(it != m_prefetched.end(), (numMwmId));
 
+  my::Timer timer;
+  unique_ptr<IndexGraph> graphPtr = move(it->second.m_graph);
+  future<void> ready = move(it->second.m_ready);
+  m_prefetched.erase(it);
+  // Rethrows an exception of the deserialization, if any.
+  ready.get();
+
+  IndexGraph & graph = *graphPtr;
+  m_graphs[numMwmId] = move(graphPtr);
+  double const elapsedSec = timer.ElapsedSeconds();
+  m_loadingTimeSec += elapsedSec;
+  LOG(LINFO, (ROUTING_FILE_TAG, "section for", m_numMwmIds->GetFile(numMwmId).GetName(),
+              "prefetched, waited for", elapsedSec, "seconds"));
+  return graph;
+}
+
+unique_ptr<IndexGraph> IndexGraphLoaderImpl::CreateGraph(NumMwmId numMwmId,
+                                                       MwmSet::MwmHandle const & handle)
+{
+  platform::CountryFile const & file = m_numMwmIds->GetFile(numMwmId);
   shared_ptr<VehicleModelInterface> vehicleModel =
       m_vehicleModelFactory->GetVehicleModelForCountry(file.GetName());
 
-  auto graphPtr = make_unique<IndexGraph>(
-      GeometryLoader::Create(m_index, handle, vehicleModel, m_loadAltitudes),
+  auto graph = make_unique<IndexGraph>(
+      GeometryLoader::Create(m_index, handle, vehicleModel, m_loadAltitudes, m_junctionsCache),
       m_estimator);
+  graph->GetGeometry().SetCacheBytesLimit(m_roadGeometryCacheBytes);
+  return graph;
+}
+
+IndexGraph & IndexGraphLoaderImpl::Load(NumMwmId numMwmId)
+{
+  platform::CountryFile const & file = m_numMwmIds->GetFile(numMwmId);
+  MwmSet::MwmHandle handle = m_index.GetMwmHandleByCountryFile(file);
+  if (!handle.IsAlive())
+    MYTHROW(RoutingException, ("Can't get mwm handle for", file));
+
+  auto graphPtr = CreateGraph(numMwmId, handle);
   IndexGraph & graph = *graphPtr;
 
   my::Timer timer;
   MwmValue const & mwmValue = *handle.GetValue<MwmValue>();
   DeserializeIndexGraph(mwmValue, m_vehicleMask, graph);
   m_graphs[numMwmId] = move(graphPtr);
-  LOG(LINFO, (ROUTING_FILE_TAG, "section for", file.GetName(), "loaded in", timer.ElapsedSeconds(),
+  double const elapsedSec = timer.ElapsedSeconds();
+  m_loadingTimeSec += elapsedSec;
+  LOG(LINFO, (ROUTING_FILE_TAG, "section for", file.GetName(), "loaded in", elapsedSec,
               "seconds"));
   return graph;
 }
 
-void IndexGraphLoaderImpl::Clear() { m_graphs.clear(); }
+void IndexGraphLoaderImpl::Clear()
+{
+  for (auto const & kv : m_graphs)
+  {
+    Geometry const & geometry = kv.second->GetGeometry();
+    LOG(LDEBUG, ("Road geometry cache for", m_numMwmIds->GetFile(kv.first).GetName(), "roads:",
+                 geometry.GetNumCachedRoads(), "bytes:", geometry.GetCacheBytes(),
+                 geometry.GetCacheStats()));
+  }
+  m_graphs.clear();
+
+  // Prefetch threads may still fill in the graphs.
+  for (auto & kv : m_prefetched)
+    kv.second.m_ready.wait();
+  m_prefetched.clear();
+}
 
 bool ReadRoadAccessFromMwm(MwmValue const & mwmValue, RoadAccess & roadAccess)
 {
@@ -107,6 +235,46 @@ bool ReadRoadAccessFromMwm(MwmValue const & mwmValue, RoadAccess & roadAccess)
   }
   return true;
 }
+
+bool ReadShortcutOverlayFromMwm(MwmValue const & mwmValue, ShortcutOverlay & overlay)
+{
+  if (!mwmValue.m_cont.IsExist(SHORTCUT_OVERLAY_FILE_TAG))
+    return false;
+
+  try
+  {
+    auto const reader = mwmValue.m_cont.GetReader(SHORTCUT_OVERLAY_FILE_TAG);
+    ReaderSource<FilesContainerR::TReader> src(reader);
+
+    ShortcutOverlaySerializer::Deserialize(src, overlay);
+  }
+  catch (Reader::OpenException const & e)
+  {
+    LOG(LERROR, ("Error while reading", SHORTCUT_OVERLAY_FILE_TAG, "section.", e.Msg()));
+    return false;
+  }
+  return true;
+}
+
+bool ReadSpeedProfilesFromMwm(MwmValue const & mwmValue, SpeedProfiles & profiles)
+{
+  if (!mwmValue.m_cont.IsExist(SPEED_PROFILES_FILE_TAG))
+    return false;
+
+  try
+  {
+    auto const reader = mwmValue.m_cont.GetReader(SPEED_PROFILES_FILE_TAG);
+    ReaderSource<FilesContainerR::TReader> src(reader);
+
+    SpeedProfilesSerializer::Deserialize(src, profiles);
+  }
+  catch (Reader::OpenException const & e)
+  {
+    LOG(LERROR, ("Error while reading", SPEED_PROFILES_FILE_TAG, "section.", e.Msg()));
+    return false;
+  }
+  return true;
+}
 }  // namespace
 
 namespace routing
@@ -115,10 +283,11 @@ namespace routing
 unique_ptr<IndexGraphLoader> IndexGraphLoader::Create(
     VehicleType vehicleType, bool loadAltitudes, shared_ptr<NumMwmIds> numMwmIds,
     shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory, shared_ptr<EdgeEstimator> estimator,
-    Index & index)
+    Index & index, size_t roadGeometryCacheBytes, shared_ptr<RoadJunctionsCache> junctionsCache)
 {
   return make_unique<IndexGraphLoaderImpl>(vehicleType, loadAltitudes, numMwmIds, vehicleModelFactory,
-                                           estimator, index);
+                                           estimator, index, roadGeometryCacheBytes,
+                                           move(junctionsCache));
 }
 
 void DeserializeIndexGraph(MwmValue const & mwmValue, VehicleMask vehicleMask, IndexGraph & graph)
@@ -133,5 +302,15 @@ void DeserializeIndexGraph(MwmValue const & mwmValue, VehicleMask vehicleMask, I
   RoadAccess roadAccess;
   if (ReadRoadAccessFromMwm(mwmValue, roadAccess))
     graph.SetRoadAccess(move(roadAccess));
+
+  // Shortcuts are generated for cars only.
+  ShortcutOverlay overlay;
+  if (vehicleMask == kCarMask && ReadShortcutOverlayFromMwm(mwmValue, overlay))
+    graph.SetShortcutOverlay(move(overlay));
+
+  // Historical speeds are collected for cars only.
+  SpeedProfiles profiles;
+  if (vehicleMask == kCarMask && ReadSpeedProfilesFromMwm(mwmValue, profiles))
+    graph.SetSpeedProfiles(move(profiles));
 }
 }  // namespace routing
@@ -3,12 +3,14 @@
 #include "routing/edge_estimator.hpp"
 #include "routing/index_graph.hpp"
 #include "routing/num_mwm_id.hpp"
+#include "routing/road_junctions_cache.hpp"
 #include "routing/vehicle_mask.hpp"
 
 #include "routing_common/vehicle_model.hpp"
 
 #include "indexer/index.hpp"
 
+#include <cstddef>
 #include <memory>
 
 namespace routing
@@ -19,12 +21,22 @@ public:
   virtual ~IndexGraphLoader() = default;
 
   virtual IndexGraph & GetIndexGraph(NumMwmId mwmId) = 0;
+  // Starts loading of the graph in background if it's not loaded yet. It's a hint:
+  // GetIndexGraph(mwmId) returns the same graph with or without Prefetch(mwmId) call.
+  virtual void Prefetch(NumMwmId mwmId) = 0;
   virtual void Clear() = 0;
+  // Returns time in seconds the caller spent on loading of graphs and on waiting for
+  // prefetched ones since the loader was created.
+  virtual double GetLoadingTimeSec() const = 0;
 
+  // |roadGeometryCacheBytes| is a memory budget for road geometry of each loaded mwm,
+  // see Geometry::SetCacheBytesLimit. If |junctionsCache| is not null road geometry is
+  // shared through it with loaders of other vehicle types.
   static std::unique_ptr<IndexGraphLoader> Create(
       VehicleType vehicleType, bool loadAltitudes, std::shared_ptr<NumMwmIds> numMwmIds,
       std::shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
-      std::shared_ptr<EdgeEstimator> estimator, Index & index);
+      std::shared_ptr<EdgeEstimator> estimator, Index & index, size_t roadGeometryCacheBytes = 0,
+      std::shared_ptr<RoadJunctionsCache> junctionsCache = nullptr);
 };
 
 void DeserializeIndexGraph(MwmValue const & mwmValue, VehicleMask vehicleMask, IndexGraph & graph);
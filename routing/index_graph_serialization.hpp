@@ -60,6 +60,16 @@ public:
 
     JointsFilter jointsFilter(graph, header.GetNumJoints());
 
+    // The number of roads is known in advance, so the road index is allocated at once.
+    size_t numRoads = 0;
+    for (uint32_t i = 0; i < header.GetNumSections(); ++i)
+    {
+      Section const & section = header.GetSection(i);
+      if (section.GetMask() & requiredMask)
+        numRoads += section.GetNumRoads();
+    }
+    graph.ReserveFromSerializer(numRoads);
+
     for (uint32_t i = 0; i < header.GetNumSections(); ++i)
     {
       Section const & section = header.GetSection(i);
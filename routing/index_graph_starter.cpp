@@ -328,20 +328,22 @@ void IndexGraphStarter::AddStart(FakeEnding const & startEnding, FakeEnding cons
 
   void IndexGraphStarter::AddFakeEdges(Segment const & segment, vector<SegmentEdge> & edges) const
   {
-    vector<SegmentEdge> fakeEdges;
-    for (auto const & edge : edges)
+    // Fake edges are appended to |edges| in place, only the edges which were there before are
+    // checked. Note. |edges| may be reallocated in the loop so edges are got by index.
+    size_t const realEdgesCount = edges.size();
+    for (size_t i = 0; i < realEdgesCount; ++i)
     {
-      for (auto const & s : m_fake.GetFake(edge.GetTarget()))
+      for (auto const & s : m_fake.GetFake(edges[i].GetTarget()))
       {
         // Check fake segment is connected to source segment.
         if (GetJunction(s, false /* front */) == GetJunction(segment, true) ||
             GetJunction(s, true) == GetJunction(segment, false))
         {
-          fakeEdges.emplace_back(s, edge.GetWeight());
+          RouteWeight const weight = edges[i].GetWeight();
+          edges.emplace_back(s, weight);
         }
       }
     }
-    edges.insert(edges.end(), fakeEdges.begin(), fakeEdges.end());
 }
 
 void IndexGraphStarter::AddRealEdges(Segment const & segment, bool isOutgoing,
@@ -89,11 +89,7 @@ void IndexRoadGraph::GetRouteEdges(TEdgeVector & edges) const
     auto featureId = FeatureID();
 
     if (!IndexGraphStarter::IsFakeSegment(segment))
-    {
-      platform::CountryFile const & file = m_numMwmIds->GetFile(segment.GetMwmId());
-      MwmSet::MwmId const mwmId = m_index.GetMwmIdByCountryFile(file);
-      featureId = FeatureID(mwmId, segment.GetFeatureId());
-    }
+      featureId = FeatureID(GetMwmId(segment.GetMwmId()), segment.GetFeatureId());
     edges.emplace_back(featureId, segment.IsForward(), segment.GetSegmentIdx(),
                        m_starter.GetJunction(segment, false /* front */),
                        m_starter.GetJunction(segment, true /* front */));
@@ -119,10 +115,8 @@ void IndexRoadGraph::GetEdges(Junction const & junction, bool isOutgoing, TEdgeV
     if (IndexGraphStarter::IsFakeSegment(segment))
       continue;
 
-    platform::CountryFile const & file = m_numMwmIds->GetFile(segment.GetMwmId());
-    MwmSet::MwmId const mwmId = m_index.GetMwmIdByCountryFile(file);
-
-    edges.emplace_back(FeatureID(mwmId, segment.GetFeatureId()), segment.IsForward(),
+    edges.emplace_back(FeatureID(GetMwmId(segment.GetMwmId()), segment.GetFeatureId()),
+                       segment.IsForward(),
                        segment.GetSegmentIdx(), m_starter.GetJunction(segment, false /* front */),
                        m_starter.GetJunction(segment, true /* front */));
   }
@@ -138,4 +132,15 @@ vector<Segment> const & IndexRoadGraph::GetSegments(Junction const & junction,
         ("junctionToSegment doesn't contain", junction, ", isOutgoing =", isOutgoing));
   return it->second;
 }
+
+MwmSet::MwmId const & IndexRoadGraph::GetMwmId(NumMwmId numMwmId) const
+{
+  auto it = m_mwmIds.find(numMwmId);
+  if (it == m_mwmIds.end())
+  {
+    platform::CountryFile const & file = m_numMwmIds->GetFile(numMwmId);
+    it = m_mwmIds.emplace(numMwmId, m_index.GetMwmIdByCountryFile(file)).first;
+  }
+  return it->second;
+}
 }  // namespace routing
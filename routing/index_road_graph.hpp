@@ -35,6 +35,8 @@ private:
   void GetEdges(Junction const & junction, bool isOutgoing, TEdgeVector & edges) const;
   Junction const & GetJunction(Segment const & segment, bool front) const;
   std::vector<Segment> const & GetSegments(Junction const & junction, bool isOutgoing) const;
+  // MwmSet looks mwm ids up under a lock, so they are cached for the edges of the route.
+  MwmSet::MwmId const & GetMwmId(NumMwmId numMwmId) const;
 
   Index & m_index;
   std::shared_ptr<NumMwmIds> m_numMwmIds;
@@ -42,5 +44,6 @@ private:
   std::vector<Segment> m_segments;
   std::map<Junction, std::vector<Segment>> m_beginToSegment;
   std::map<Junction, std::vector<Segment>> m_endToSegment;
+  mutable std::map<NumMwmId, MwmSet::MwmId> m_mwmIds;
 };
 }  // namespace routing
@@ -14,6 +14,7 @@
 #include "routing/road_graph_router.hpp"
 #include "routing/route.hpp"
 #include "routing/routing_helpers.hpp"
+#include "routing/routing_settings.hpp"
 #include "routing/single_vehicle_world_graph.hpp"
 #include "routing/turns_generator.hpp"
 #include "routing/vehicle_mask.hpp"
@@ -25,6 +26,7 @@
 
 #include "indexer/feature_altitude.hpp"
 
+#include "geometry/convex_hull.hpp"
 #include "geometry/distance.hpp"
 #include "geometry/mercator.hpp"
 #include "geometry/point2d.hpp"
@@ -32,9 +34,13 @@
 #include "platform/mwm_traits.hpp"
 
 #include "base/exception.hpp"
+#include "base/math.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/thread.hpp"
 
 #include <algorithm>
+#include <ctime>
+#include <iterator>
 #include <map>
 #include <utility>
 
@@ -54,6 +60,11 @@ double constexpr kMinDistanceToFinishM = 10000;
 // Limit of adjust in seconds.
 double constexpr kAdjustLimitSec = 5 * 60;
 
+// Periodicity of checking if distance matrix or isochrone calculation is cancelled.
+uint32_t constexpr kWaveCancelPollPeriod = 128;
+// Precision of isochrone polygons in mercator.
+double constexpr kIsochronePolygonEps = 1e-9;
+
 double CalcMaxSpeed(NumMwmIds const & numMwmIds,
                     VehicleModelFactoryInterface const & vehicleModelFactory,
                     VehicleType vehicleType)
@@ -137,6 +148,28 @@ IRouter::ResultCode FindPath(
                                                               delegate, onVisitedVertexCallback));
 }
 
+template <typename Graph>
+IRouter::ResultCode FindPathOverShortcuts(
+    typename Graph::TVertexType const & start, typename Graph::TVertexType const & finish,
+    RouterDelegate const & delegate, Graph & graph,
+    typename AStarAlgorithm<Graph>::TOnVisitedVertexCallback const & onVisitedVertexCallback,
+    RoutingResult<typename Graph::TVertexType, typename Graph::TWeightType> & routingResult)
+{
+  AStarAlgorithm<Graph> algorithm;
+  return ConvertResult<Graph>(algorithm.FindPathBidirectionalOverlay(
+      graph, start, finish, routingResult, delegate, onVisitedVertexCallback));
+}
+
+bool AreShortcutsAvailable(IndexGraphStarter & starter)
+{
+  for (NumMwmId const mwmId : starter.GetMwms())
+  {
+    if (starter.GetGraph().GetShortcutOverlay(mwmId).IsEmpty())
+      return false;
+  }
+  return true;
+}
+
 bool IsDeadEnd(Segment const & segment, bool isOutgoing, WorldGraph & worldGraph)
 {
   size_t constexpr kDeadEndTestLimit = 50;
@@ -231,6 +264,16 @@ bool GetLastRealOrPart(IndexGraphStarter const & starter, vector<Segment> const
   }
   return false;
 }
+
+// Returns local time of day in seconds since midnight.
+uint32_t GetLocalTimeOfDaySec()
+{
+  time_t const now = time(nullptr);
+  tm local;
+  if (localtime_r(&now, &local) == nullptr)
+    return 0;
+  return static_cast<uint32_t>(local.tm_hour * 60 * 60 + local.tm_min * 60 + local.tm_sec);
+}
 }  // namespace
 
 namespace routing
@@ -280,6 +323,9 @@ double IndexRouter::BestEdgeComparator::GetSquaredDist(Edge const & edge) const
 }
 
 // IndexRouter ------------------------------------------------------------------------------------
+// static
+double constexpr IndexRouter::kNoRoute;
+
 IndexRouter::IndexRouter(VehicleType vehicleType, bool loadAltitudes,
                          CountryParentNameGetterFn const & countryParentNameGetterFn,
                          TCountryFileFn const & countryFileFn, CourntryRectFn const & countryRectFn,
@@ -319,6 +365,8 @@ IRouter::ResultCode IndexRouter::CalculateRoute(Checkpoints const & checkpoints,
                                                 bool adjustToPrevRoute,
                                                 RouterDelegate const & delegate, Route & route)
 {
+  m_lastStats = RoutingStats();
+
   vector<string> outdatedMwms;
   GetOutdatedMwms(m_vehicleType, m_index, outdatedMwms);
   if (!outdatedMwms.empty())
@@ -400,6 +448,7 @@ IRouter::ResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoint
     return IRouter::NeedMoreMaps;
 
   TrafficStash::Guard guard(m_trafficStash);
+  m_estimator->SetDeparture(checkpoints.GetPointFrom(), GetLocalTimeOfDaySec());
   auto graph = MakeWorldGraph();
 
   vector<Segment> segments;
@@ -501,8 +550,12 @@ IRouter::ResultCode IndexRouter::CalculateSubroute(Checkpoints const & checkpoin
       starter.GetGraph().SetMode(WorldGraph::Mode::NoLeaps);
       break;
     case VehicleType::Car:
-      starter.GetGraph().SetMode(AreMwmsNear(starter.GetMwms()) ? WorldGraph::Mode::LeapsIfPossible
-                                                                : WorldGraph::Mode::LeapsOnly);
+      if (!AreMwmsNear(starter.GetMwms()))
+        starter.GetGraph().SetMode(WorldGraph::Mode::LeapsOnly);
+      else if (AreShortcutsAvailable(starter))
+        starter.GetGraph().SetMode(WorldGraph::Mode::Shortcuts);
+      else
+        starter.GetGraph().SetMode(WorldGraph::Mode::LeapsIfPossible);
       break;
     case VehicleType::Count:
       CHECK(false, ("Unknown vehicle type:", m_vehicleType));
@@ -535,9 +588,15 @@ IRouter::ResultCode IndexRouter::CalculateSubroute(Checkpoints const & checkpoin
     delegate.OnPointCheck(pointFrom);
   };
 
+  my::Timer timer;
   RoutingResult<Segment, RouteWeight> routingResult;
-  IRouter::ResultCode const result = FindPath(starter.GetStartSegment(), starter.GetFinishSegment(),
-                                              delegate, starter, onVisitJunction, routingResult);
+  bool const shortcutsMode = starter.GetGraph().GetMode() == WorldGraph::Mode::Shortcuts;
+  IRouter::ResultCode const result =
+      shortcutsMode ? FindPathOverShortcuts(starter.GetStartSegment(), starter.GetFinishSegment(),
+                                            delegate, starter, onVisitJunction, routingResult)
+                    : FindPath(starter.GetStartSegment(), starter.GetFinishSegment(), delegate,
+                               starter, onVisitJunction, routingResult);
+  m_lastStats.m_settledVertices += visitCount;
   if (result != IRouter::NoError)
     return result;
 
@@ -545,7 +604,12 @@ IRouter::ResultCode IndexRouter::CalculateSubroute(Checkpoints const & checkpoin
     return IRouter::RouteNotFound;
 
   IRouter::ResultCode const leapsResult =
-      ProcessLeaps(routingResult.m_path, delegate, starter.GetGraph().GetMode(), starter, subroute);
+      shortcutsMode
+          ? ProcessShortcuts(routingResult.m_path, delegate, starter, subroute)
+          : ProcessLeaps(routingResult.m_path, delegate, starter.GetGraph().GetMode(), starter,
+                         subroute);
+  m_lastStats.m_searchSec += timer.ElapsedSeconds();
+  m_lastStats.m_graphLoadingSec = starter.GetGraph().GetGraphLoadingTimeSec();
   if (leapsResult != IRouter::NoError)
     return leapsResult;
 
@@ -559,6 +623,7 @@ IRouter::ResultCode IndexRouter::AdjustRoute(Checkpoints const & checkpoints,
 {
   my::Timer timer;
   TrafficStash::Guard guard(m_trafficStash);
+  m_estimator->SetDeparture(checkpoints.GetPointFrom(), GetLocalTimeOfDaySec());
   auto graph = MakeWorldGraph();
   graph->SetMode(WorldGraph::Mode::NoLeaps);
 
@@ -612,9 +677,13 @@ IRouter::ResultCode IndexRouter::AdjustRoute(Checkpoints const & checkpoints,
 
   AStarAlgorithm<IndexGraphStarter> algorithm;
   RoutingResult<Segment, RouteWeight> result;
+  my::Timer searchTimer;
   auto resultCode = ConvertResult<IndexGraphStarter>(algorithm.AdjustRoute(
       starter, starter.GetStartSegment(), prevEdges,
       RouteWeight(kAdjustLimitSec, 0 /* nontransitCross */), result, delegate, onVisitJunction));
+  m_lastStats.m_searchSec += searchTimer.ElapsedSeconds();
+  m_lastStats.m_settledVertices += visitCount;
+  m_lastStats.m_graphLoadingSec = graph->GetGraphLoadingTimeSec();
   if (resultCode != IRouter::NoError)
     return resultCode;
 
@@ -652,6 +721,252 @@ IRouter::ResultCode IndexRouter::AdjustRoute(Checkpoints const & checkpoints,
   LOG(LINFO, ("Adjust route, elapsed:", timer.ElapsedSeconds(), ", prev start:", checkpoints,
               ", prev route:", steps.size(), ", new route:", result.m_path.size()));
 
+  // The adjusted route becomes the previous one. So the next reroute joins the detour
+  // and the still valid suffix instead of the route which has already been left.
+  // Note. |starter| contains all the fake edges of |m_lastFakeEdges| after Append().
+  auto lastRoute = make_unique<SegmentedRoute>(m_lastRoute->GetStart(), m_lastRoute->GetFinish(),
+                                               route.GetSubroutes());
+  for (Segment const & segment : result.m_path)
+    lastRoute->AddStep(segment, starter.GetPoint(segment, true /* front */));
+
+  m_lastRoute = move(lastRoute);
+  m_lastFakeEdges = make_unique<FakeEdgesContainer>(move(starter));
+
+  return IRouter::NoError;
+}
+
+IRouter::ResultCode IndexRouter::CalculateDistanceMatrix(vector<m2::PointD> const & sources,
+                                                         vector<m2::PointD> const & targets,
+                                                         RouterDelegate const & delegate,
+                                                         size_t threadsCount,
+                                                         vector<vector<double>> & matrix)
+{
+  matrix.assign(sources.size(), vector<double>(targets.size(), kNoRoute));
+  if (sources.empty() || targets.empty())
+    return IRouter::NoError;
+
+  for (auto const * points : {&sources, &targets})
+  {
+    for (auto const & point : *points)
+    {
+      string const countryName = m_countryFileFn(point);
+      if (countryName.empty())
+      {
+        LOG(LWARNING, ("For point", MercatorBounds::ToLatLon(point),
+                       "CountryInfoGetter returns an empty CountryFile()."));
+        return IRouter::InternalError;
+      }
+
+      if (!m_index.IsLoaded(platform::CountryFile(countryName)))
+        return IRouter::NeedMoreMaps;
+    }
+  }
+
+  TrafficStash::Guard guard(m_trafficStash);
+  // Rows of the matrix have different departure points, so historical speeds are not used
+  // and all the rows are calculated with the same weights.
+  m_estimator->ResetDeparture();
+
+  vector<Segment> sourceSegments(sources.size());
+  vector<Segment> targetSegments(targets.size());
+  try
+  {
+    // FindBestSegment() uses |m_roadGraph| which is not thread safe. So all the points
+    // are snapped to roads before the calculation is spread over threads.
+    auto graph = MakeWorldGraph();
+    graph->SetMode(WorldGraph::Mode::NoLeaps);
+    bool dummy = false;
+    for (size_t i = 0; i < sources.size(); ++i)
+    {
+      if (!FindBestSegment(sources[i], m2::PointD::Zero() /* direction */, true /* isOutgoing */,
+                           *graph, sourceSegments[i], dummy /* bestSegmentIsAlmostCodirectional */))
+      {
+        return IRouter::StartPointNotFound;
+      }
+    }
+
+    for (size_t i = 0; i < targets.size(); ++i)
+    {
+      if (!FindBestSegment(targets[i], m2::PointD::Zero() /* direction */,
+                           false /* isOutgoing */, *graph, targetSegments[i],
+                           dummy /* bestSegmentIsAlmostCodirectional */))
+      {
+        return IRouter::EndPointNotFound;
+      }
+    }
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Can't snap distance matrix points to roads:", e.what()));
+    return IRouter::InternalError;
+  }
+
+  threadsCount = my::clamp(threadsCount, static_cast<size_t>(1), sources.size());
+  vector<IRouter::ResultCode> results(threadsCount, IRouter::NoError);
+  auto const calculateRows = [&](size_t threadIdx) {
+    try
+    {
+      results[threadIdx] = CalculateMatrixRows(sourceSegments, targetSegments, threadIdx,
+                                               threadsCount, delegate, matrix);
+    }
+    catch (RootException const & e)
+    {
+      LOG(LERROR, ("Can't calculate distance matrix:", e.what()));
+      results[threadIdx] = IRouter::InternalError;
+    }
+  };
+
+  vector<threads::SimpleThread> threads;
+  threads.reserve(threadsCount - 1);
+  for (size_t i = 1; i < threadsCount; ++i)
+    threads.emplace_back(calculateRows, i);
+
+  calculateRows(0 /* threadIdx */);
+  for (auto & thread : threads)
+    thread.join();
+
+  for (auto const result : results)
+  {
+    if (result != IRouter::NoError)
+      return result;
+  }
+  return IRouter::NoError;
+}
+
+IRouter::ResultCode IndexRouter::CalculateMatrixRows(vector<Segment> const & sourceSegments,
+                                                     vector<Segment> const & targetSegments,
+                                                     size_t firstRow, size_t rowsStep,
+                                                     RouterDelegate const & delegate,
+                                                     vector<vector<double>> & matrix)
+{
+  CHECK_GREATER(rowsStep, 0, ());
+
+  // The graph is created by the thread which uses it. So mwm handles, loaded index graphs and
+  // road geometry caches are not shared between threads.
+  auto graph = MakeWorldGraph();
+  graph->SetMode(WorldGraph::Mode::NoLeaps);
+
+  // Several targets may be snapped to the same segment.
+  map<Segment, vector<size_t>> targetToColumns;
+  for (size_t j = 0; j < targetSegments.size(); ++j)
+    targetToColumns[targetSegments[j]].push_back(j);
+
+  AStarAlgorithm<WorldGraph> algorithm;
+  AStarAlgorithm<WorldGraph>::Context context;
+  for (size_t row = firstRow; row < sourceSegments.size(); row += rowsStep)
+  {
+    auto & weights = matrix[row];
+    size_t targetsLeft = targetToColumns.size();
+    uint32_t visitCount = 0;
+    bool cancelled = false;
+
+    auto const visitVertex = [&](Segment const & segment) {
+      if (visitCount++ % kWaveCancelPollPeriod == 0 && delegate.IsCancelled())
+      {
+        cancelled = true;
+        return false;
+      }
+
+      auto const it = targetToColumns.find(segment);
+      if (it == targetToColumns.cend())
+        return true;
+
+      double const weight = context.GetDistance(segment).GetWeight();
+      for (size_t const column : it->second)
+        weights[column] = weight;
+
+      --targetsLeft;
+      return targetsLeft != 0;
+    };
+
+    algorithm.PropagateWave(*graph, sourceSegments[row], visitVertex, context);
+    if (cancelled)
+      return IRouter::Cancelled;
+  }
+
+  return IRouter::NoError;
+}
+
+IRouter::ResultCode IndexRouter::CalculateIsochrone(m2::PointD const & start, double maxWeightSec,
+                                                    RouterDelegate const & delegate,
+                                                    Isochrone & isochrone)
+{
+  CHECK_GREATER_OR_EQUAL(maxWeightSec, 0.0, ());
+  isochrone = Isochrone();
+
+  string const countryName = m_countryFileFn(start);
+  if (countryName.empty())
+  {
+    LOG(LWARNING, ("For point", MercatorBounds::ToLatLon(start),
+                   "CountryInfoGetter returns an empty CountryFile()."));
+    return IRouter::InternalError;
+  }
+
+  if (!m_index.IsLoaded(platform::CountryFile(countryName)))
+    return IRouter::NeedMoreMaps;
+
+  TrafficStash::Guard guard(m_trafficStash);
+  m_estimator->ResetDeparture();
+
+  vector<m2::PointD> points = {start};
+  bool cancelled = false;
+  try
+  {
+    auto graph = MakeWorldGraph();
+    graph->SetMode(WorldGraph::Mode::NoLeaps);
+
+    Segment startSegment;
+    bool dummy = false;
+    if (!FindBestSegment(start, m2::PointD::Zero() /* direction */, true /* isOutgoing */, *graph,
+                         startSegment, dummy /* bestSegmentIsAlmostCodirectional */))
+    {
+      return IRouter::StartPointNotFound;
+    }
+
+    AStarAlgorithm<WorldGraph> algorithm;
+    AStarAlgorithm<WorldGraph>::Context context;
+    uint32_t visitCount = 0;
+
+    // Segments are settled in the order of travel times, so the wave stops at the first one
+    // which is out of the limit.
+    auto const visitVertex = [&](Segment const & segment) {
+      if (visitCount++ % kWaveCancelPollPeriod == 0 && delegate.IsCancelled())
+      {
+        cancelled = true;
+        return false;
+      }
+
+      double const weight = context.GetDistance(segment).GetWeight();
+      if (weight > maxWeightSec)
+        return false;
+
+      Isochrone::ReachableSegment reachable;
+      reachable.m_segment = segment;
+      reachable.m_weight = weight;
+      isochrone.m_segments.push_back(reachable);
+      points.push_back(graph->GetPoint(segment, true /* front */));
+      return true;
+    };
+
+    auto const adjustEdgeWeight = [](Segment const & /* vertex */, SegmentEdge const & edge) {
+      return RouteWeight(edge.GetWeight().GetWeight(), 0 /* nontransitCross */);
+    };
+
+    algorithm.PropagateWave(*graph, startSegment, visitVertex, adjustEdgeWeight, context);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Can't calculate isochrone:", e.what()));
+    return IRouter::InternalError;
+  }
+
+  if (cancelled)
+  {
+    isochrone = Isochrone();
+    return IRouter::Cancelled;
+  }
+
+  isochrone.m_polygon = m2::ConvexHull(points, kIsochronePolygonEps).Points();
   return IRouter::NoError;
 }
 
@@ -661,7 +976,9 @@ unique_ptr<WorldGraph> IndexRouter::MakeWorldGraph()
       make_unique<CrossMwmGraph>(m_numMwmIds, m_numMwmTree, m_vehicleModelFactory, m_vehicleType,
                                  m_countryRectFn, m_index, m_indexManager),
       IndexGraphLoader::Create(m_vehicleType, m_loadAltitudes, m_numMwmIds, m_vehicleModelFactory,
-                               m_estimator, m_index),
+                               m_estimator, m_index,
+                               GetRoutingSettings(m_vehicleType).m_roadGeometryCacheBytes,
+                               m_junctionsCache),
       m_estimator);
 }
 
@@ -717,6 +1034,9 @@ IRouter::ResultCode IndexRouter::ProcessLeaps(vector<Segment> const & input,
   output.reserve(input.size());
 
   WorldGraph & worldGraph = starter.GetGraph();
+  auto const onVisitedVertex = [this](Segment const & /* from */, Segment const & /* to */) {
+    ++m_lastStats.m_settledVertices;
+  };
 
   for (size_t i = 0; i < input.size(); ++i)
   {
@@ -751,13 +1071,13 @@ IRouter::ResultCode IndexRouter::ProcessLeaps(vector<Segment> const & input,
     {
       // World graph route.
       worldGraph.SetMode(WorldGraph::Mode::NoLeaps);
-      result = FindPath(current, next, delegate, worldGraph, {} /* onVisitedVertexCallback */, routingResult);
+      result = FindPath(current, next, delegate, worldGraph, onVisitedVertex, routingResult);
     }
     else
     {
       // Single mwm route.
       worldGraph.SetMode(WorldGraph::Mode::SingleMwm);
-      result = FindPath(current, next, delegate, worldGraph, {} /* onVisitedVertexCallback */, routingResult);
+      result = FindPath(current, next, delegate, worldGraph, onVisitedVertex, routingResult);
     }
     if (result != IRouter::NoError)
       return result;
@@ -773,9 +1093,62 @@ IRouter::ResultCode IndexRouter::ProcessLeaps(vector<Segment> const & input,
   return IRouter::NoError;
 }
 
+IRouter::ResultCode IndexRouter::ProcessShortcuts(vector<Segment> const & input,
+                                                  RouterDelegate const & delegate,
+                                                  IndexGraphStarter & starter,
+                                                  vector<Segment> & output)
+{
+  output.reserve(input.size());
+
+  WorldGraph & worldGraph = starter.GetGraph();
+  auto const onVisitedVertex = [this](Segment const & /* from */, Segment const & /* to */) {
+    ++m_lastStats.m_settledVertices;
+  };
+
+  for (size_t i = 0; i < input.size(); ++i)
+  {
+    Segment const & current = input[i];
+    if (i == 0)
+    {
+      output.push_back(current);
+      continue;
+    }
+
+    // A pair of consecutive segments may be a shortcut if the first one is a core segment of
+    // the overlay. Ends of a shortcut are in the same mwm: cross mwm twins are not shortcuts.
+    // Core route endings are expanded with regular edges, such pairs are unpacked to themselves.
+    Segment from = input[i - 1];
+    Segment to = current;
+    if (!starter.ConvertToReal(from) || !starter.ConvertToReal(to) || from == to ||
+        from.GetMwmId() != to.GetMwmId() ||
+        !worldGraph.GetShortcutOverlay(from.GetMwmId()).IsCore(from))
+    {
+      output.push_back(current);
+      continue;
+    }
+
+    worldGraph.SetMode(WorldGraph::Mode::SingleMwm);
+    RoutingResult<Segment, RouteWeight> routingResult;
+    IRouter::ResultCode const result =
+        FindPath(from, to, delegate, worldGraph, onVisitedVertex, routingResult);
+    worldGraph.SetMode(WorldGraph::Mode::Shortcuts);
+    if (result != IRouter::NoError)
+      return result;
+
+    CHECK_GREATER_OR_EQUAL(routingResult.m_path.size(), 2, ());
+    // The first segment of the unpacked shortcut is already in |output|. Ends of the shortcut
+    // may be changed by starter.ConvertToReal, so the original |current| is used for the last one.
+    output.insert(output.end(), next(routingResult.m_path.cbegin()),
+                  prev(routingResult.m_path.cend()));
+    output.push_back(current);
+  }
+
+  return IRouter::NoError;
+}
+
 IRouter::ResultCode IndexRouter::RedressRoute(vector<Segment> const & segments,
                                               RouterDelegate const & delegate,
-                                              IndexGraphStarter & starter, Route & route) const
+                                              IndexGraphStarter & starter, Route & route)
 {
   CHECK(!segments.empty(), ());
   vector<Junction> junctions;
@@ -801,7 +1174,7 @@ IRouter::ResultCode IndexRouter::RedressRoute(vector<Segment> const & segments,
   
   CHECK(m_directionsEngine, ());
   ReconstructRoute(*m_directionsEngine, roadGraph, m_trafficStash, delegate, junctions, move(times),
-                   route);
+                   route, &m_lastStats);
 
   if (!route.IsValid())
   {
@@ -7,8 +7,10 @@
 #include "routing/features_road_graph.hpp"
 #include "routing/joint.hpp"
 #include "routing/num_mwm_id.hpp"
+#include "routing/road_junctions_cache.hpp"
 #include "routing/router.hpp"
 #include "routing/routing_mapping.hpp"
+#include "routing/routing_stats.hpp"
 #include "routing/segmented_route.hpp"
 #include "routing/world_graph.hpp"
 
@@ -69,6 +71,54 @@ public:
                             bool adjustToPrevRoute, RouterDelegate const & delegate,
                             Route & route) override;
 
+  /// \brief Calculates route weights (travel times in seconds) from each of |sources| to each
+  /// of |targets|. |matrix[i][j]| is filled with the weight of the route from |sources[i]| to
+  /// |targets[j]| or with kNoRoute if there's no such route. The weights are calculated between
+  /// the segments closest to the points so partial weights of the first and the last segments
+  /// are not taken into account.
+  /// One-to-many waves from different sources are spread over |threadsCount| threads. Every
+  /// thread uses its own WorldGraph so its road geometry cache is not shared.
+  ResultCode CalculateDistanceMatrix(std::vector<m2::PointD> const & sources,
+                                     std::vector<m2::PointD> const & targets,
+                                     RouterDelegate const & delegate, size_t threadsCount,
+                                     std::vector<std::vector<double>> & matrix);
+
+  static double constexpr kNoRoute = -1.0;
+
+  /// \brief Area which is reachable from a point in a limited time.
+  struct Isochrone
+  {
+    struct ReachableSegment
+    {
+      Segment m_segment;
+      /// Travel time to the end of |m_segment| in seconds.
+      double m_weight = 0.0;
+    };
+
+    /// Segments which may be passed entirely, in the order of their travel times.
+    std::vector<ReachableSegment> m_segments;
+    /// Convex hull of the start and the ends of |m_segments| in mercator, counterclockwise.
+    std::vector<m2::PointD> m_polygon;
+  };
+
+  /// \brief Calculates the area which is reachable from |start| in |maxWeightSec| seconds.
+  /// Dijkstra's wave is bounded by the travel time and crosses mwm borders through cross mwm
+  /// transitions. Penalties for crossings of nontransit areas are not applied, so travel time
+  /// is the only criterion. The wave starts from the segment closest to |start|, the weight of
+  /// its part before |start| is not taken into account.
+  ResultCode CalculateIsochrone(m2::PointD const & start, double maxWeightSec,
+                                RouterDelegate const & delegate, Isochrone & isochrone);
+
+  /// \returns phase timings and search size of the last CalculateRoute() call.
+  RoutingStats const & GetLastRoutingStats() const { return m_lastStats; }
+
+  /// \brief Shares road geometry with routers of other vehicle types through |junctionsCache|.
+  /// It's used by graphs created after the call.
+  void SetRoadJunctionsCache(std::shared_ptr<RoadJunctionsCache> junctionsCache)
+  {
+    m_junctionsCache = move(junctionsCache);
+  }
+
 private:
   IRouter::ResultCode DoCalculateRoute(Checkpoints const & checkpoints,
                                        m2::PointD const & startDirection,
@@ -82,6 +132,14 @@ private:
                                   m2::PointD const & startDirection,
                                   RouterDelegate const & delegate, Route & route);
 
+  /// \brief Fills rows |firstRow|, |firstRow| + |rowsStep|, ... of |matrix| running
+  /// one-to-many Dijkstra from |sourceSegments| till all |targetSegments| are settled.
+  IRouter::ResultCode CalculateMatrixRows(std::vector<Segment> const & sourceSegments,
+                                          std::vector<Segment> const & targetSegments,
+                                          size_t firstRow, size_t rowsStep,
+                                          RouterDelegate const & delegate,
+                                          std::vector<std::vector<double>> & matrix);
+
   std::unique_ptr<WorldGraph> MakeWorldGraph();
 
   /// \brief Finds the best segment (edge) which may be considered as the start of the finish of the route.
@@ -100,9 +158,14 @@ private:
   IRouter::ResultCode ProcessLeaps(std::vector<Segment> const & input,
                                    RouterDelegate const & delegate, WorldGraph::Mode prevMode,
                                    IndexGraphStarter & starter, std::vector<Segment> & output);
+  // Input route may contain shortcuts of mwm shortcut overlays.
+  // ProcessShortcuts replaces each shortcut with calculated route through mwm.
+  IRouter::ResultCode ProcessShortcuts(std::vector<Segment> const & input,
+                                       RouterDelegate const & delegate,
+                                       IndexGraphStarter & starter, std::vector<Segment> & output);
   IRouter::ResultCode RedressRoute(std::vector<Segment> const & segments,
                                    RouterDelegate const & delegate, IndexGraphStarter & starter,
-                                   Route & route) const;
+                                   Route & route);
 
   bool AreMwmsNear(std::set<NumMwmId> const & mwmIds) const;
 
@@ -121,8 +184,10 @@ private:
   FeaturesRoadGraph m_roadGraph;
 
   std::shared_ptr<EdgeEstimator> m_estimator;
+  std::shared_ptr<RoadJunctionsCache> m_junctionsCache;
   std::unique_ptr<IDirectionsEngine> m_directionsEngine;
   std::unique_ptr<SegmentedRoute> m_lastRoute;
   std::unique_ptr<FakeEdgesContainer> m_lastFakeEdges;
+  RoutingStats m_lastStats;
 };
 }  // namespace routing
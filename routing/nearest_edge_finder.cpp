@@ -17,53 +17,66 @@ NearestEdgeFinder::NearestEdgeFinder(m2::PointD const & point)
 
 void NearestEdgeFinder::AddInformationSource(FeatureID const & featureId, IRoadGraph::RoadInfo const & roadInfo)
 {
-  Candidate res;
-
   size_t const count = roadInfo.m_junctions.size();
   ASSERT_GREATER(count, 1, ());
+
+  // Only the closest segment of the feature becomes a candidate. So the projection is found
+  // in a tight loop and the altitude which needs distances on earth is calculated once
+  // for the closest segment.
+  double bestDist = numeric_limits<double>::max();
+  size_t bestIdx = 0;
+  m2::PointD bestProj = m2::PointD::Zero();
+  m2::ProjectionToSection<m2::PointD> segProj;
   for (size_t i = 1; i < count; ++i)
   {
     /// @todo Probably, we need to get exact projection distance in meters.
-    m2::ProjectionToSection<m2::PointD> segProj;
     segProj.SetBounds(roadInfo.m_junctions[i - 1].GetPoint(), roadInfo.m_junctions[i].GetPoint());
 
     m2::PointD const pt = segProj(m_point);
     double const d = m_point.SquareLength(pt);
-    if (d < res.m_dist)
+    if (d < bestDist)
     {
-      Junction const & segStart = roadInfo.m_junctions[i - 1];
-      Junction const & segEnd = roadInfo.m_junctions[i];
-      feature::TAltitude const startAlt = segStart.GetAltitude();
-      feature::TAltitude const endAlt = segEnd.GetAltitude();
-
-      double const segLenM = MercatorBounds::DistanceOnEarth(segStart.GetPoint(), segEnd.GetPoint());
-      feature::TAltitude projPointAlt = feature::kDefaultAltitudeMeters;
-      if (segLenM == 0.0)
-      {
-        LOG(LWARNING, ("Length of segment", i, " of feature", featureId, "is zero."));
-        projPointAlt = startAlt;
-      }
-      else
-      {
-        double const distFromStartM = MercatorBounds::DistanceOnEarth(segStart.GetPoint(), pt);
-        ASSERT_LESS_OR_EQUAL(distFromStartM, segLenM, (featureId));
-        projPointAlt = startAlt + static_cast<feature::TAltitude>((endAlt - startAlt) * distFromStartM / segLenM);
-      }
-
-      res.m_dist = d;
-      res.m_fid = featureId;
-      res.m_segId = static_cast<uint32_t>(i - 1);
-      res.m_segStart = segStart;
-      res.m_segEnd = segEnd;
-      res.m_bidirectional = roadInfo.m_bidirectional;
-
-      ASSERT_NOT_EQUAL(res.m_segStart.GetAltitude() , feature::kInvalidAltitude, ());
-      ASSERT_NOT_EQUAL(res.m_segEnd.GetAltitude(), feature::kInvalidAltitude, ());
-
-      res.m_projPoint = Junction(pt, projPointAlt);
+      bestDist = d;
+      bestIdx = i;
+      bestProj = pt;
     }
   }
 
+  if (bestIdx == 0)
+    return;
+
+  Junction const & segStart = roadInfo.m_junctions[bestIdx - 1];
+  Junction const & segEnd = roadInfo.m_junctions[bestIdx];
+  feature::TAltitude const startAlt = segStart.GetAltitude();
+  feature::TAltitude const endAlt = segEnd.GetAltitude();
+
+  double const segLenM = MercatorBounds::DistanceOnEarth(segStart.GetPoint(), segEnd.GetPoint());
+  feature::TAltitude projPointAlt = feature::kDefaultAltitudeMeters;
+  if (segLenM == 0.0)
+  {
+    LOG(LWARNING, ("Length of segment", bestIdx, " of feature", featureId, "is zero."));
+    projPointAlt = startAlt;
+  }
+  else
+  {
+    double const distFromStartM = MercatorBounds::DistanceOnEarth(segStart.GetPoint(), bestProj);
+    ASSERT_LESS_OR_EQUAL(distFromStartM, segLenM, (featureId));
+    projPointAlt = startAlt + static_cast<feature::TAltitude>((endAlt - startAlt) * distFromStartM / segLenM);
+  }
+
+  Candidate res;
+  res.m_dist = bestDist;
+  res.m_fid = featureId;
+  res.m_segId = static_cast<uint32_t>(bestIdx - 1);
+  res.m_segStart = segStart;
+  res.m_segEnd = segEnd;
+  res.m_bidirectional = roadInfo.m_bidirectional;
+
+  ASSERT_NOT_EQUAL(res.m_segStart.GetAltitude() , feature::kInvalidAltitude, ());
+  ASSERT_NOT_EQUAL(res.m_segEnd.GetAltitude(), feature::kInvalidAltitude, ());
+
+  res.m_projPoint = Junction(bestProj, projPointAlt);
+
   if (res.m_fid.IsValid())
     m_candidates.push_back(res);
 }
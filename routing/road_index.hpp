@@ -117,6 +117,9 @@ class RoadIndex final
 public:
   void Import(vector<Joint> const & joints);
 
+  // Prepares the index for |numRoads| roads to avoid rehashing while the index is filled.
+  void Reserve(size_t numRoads) { m_roads.reserve(numRoads); }
+
   void AddJoint(RoadPoint const & rp, Joint::Id jointId)
   {
     m_roads[rp.GetFeatureId()].AddJoint(rp.GetPointId(), jointId);
@@ -0,0 +1,97 @@
+#include "routing/road_junctions_cache.hpp"
+
+#include "indexer/feature_altitude.hpp"
+
+#include "base/assert.hpp"
+
+using namespace std;
+
+namespace routing
+{
+bool RoadJunctionsCache::Get(MwmSet::MwmId const & mwmId, uint32_t featureId, bool withAltitudes,
+                             RoadJunctions & junctions) const
+{
+  lock_guard<mutex> lock(m_mutex);
+  auto const mwmIt = m_roads.find(mwmId);
+  if (mwmIt == m_roads.cend())
+    return false;
+
+  auto const it = mwmIt->second.find(featureId);
+  if (it == mwmIt->second.cend())
+    return false;
+
+  Road const & road = it->second;
+  if (withAltitudes && !road.m_withAltitudes)
+    return false;
+
+  junctions.assign(road.m_junctions.cbegin(), road.m_junctions.cend());
+  if (!withAltitudes && road.m_withAltitudes)
+  {
+    for (auto & junction : junctions)
+      junction = Junction(junction.GetPoint(), feature::kDefaultAltitudeMeters);
+  }
+  return true;
+}
+
+void RoadJunctionsCache::Put(MwmSet::MwmId const & mwmId, uint32_t featureId, bool withAltitudes,
+                             RoadJunctions const & junctions)
+{
+  lock_guard<mutex> lock(m_mutex);
+  auto & mwmRoads = m_roads[mwmId];
+  auto const it = mwmRoads.find(featureId);
+  if (it != mwmRoads.end())
+  {
+    // The road may be put again with altitudes only.
+    Road & road = it->second;
+    if (road.m_withAltitudes || !withAltitudes)
+      return;
+
+    m_bytes -= GetRoadBytes(road);
+    road.m_junctions.assign(junctions.begin(), junctions.end());
+    road.m_withAltitudes = true;
+    m_bytes += GetRoadBytes(road);
+  }
+  else
+  {
+    Road & road = mwmRoads[featureId];
+    road.m_junctions.assign(junctions.begin(), junctions.end());
+    road.m_withAltitudes = withAltitudes;
+    m_bytes += GetRoadBytes(road);
+    m_order.emplace_back(mwmId, featureId);
+  }
+
+  EvictIfNeeded();
+}
+
+size_t RoadJunctionsCache::GetBytes() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_bytes;
+}
+
+// static
+size_t RoadJunctionsCache::GetRoadBytes(Road const & road)
+{
+  // A hash table node with the road, its key in |m_order| and its junctions.
+  return sizeof(Road) + 2 * sizeof(void *) + sizeof(Key) +
+         road.m_junctions.capacity() * sizeof(Junction);
+}
+
+void RoadJunctionsCache::EvictIfNeeded()
+{
+  while (m_bytes > m_bytesLimit && !m_order.empty())
+  {
+    Key const & key = m_order.front();
+    auto const mwmIt = m_roads.find(key.first);
+    CHECK(mwmIt != m_roads.end(), ());
+    auto const it = mwmIt->second.find(key.second);
+    CHECK(it != mwmIt->second.end(), ());
+
+    m_bytes -= GetRoadBytes(it->second);
+    mwmIt->second.erase(it);
+    if (mwmIt->second.empty())
+      m_roads.erase(mwmIt);
+    m_order.pop_front();
+  }
+}
+}  // namespace routing
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "routing/road_graph.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "base/buffer_vector.hpp"
+#include "base/macros.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace routing
+{
+size_t constexpr kRoadInlineJunctions = 32;
+using RoadJunctions = buffer_vector<Junction, kRoadInlineJunctions>;
+
+// Points and altitudes of road features shared by geometry loaders of all vehicle types.
+// Geometry of a feature doesn't depend on a vehicle, so once it's decoded by a router of one
+// vehicle type a router of another one doesn't decode it again. Attributes which depend on
+// a vehicle (speed, one way, access) are still got from VehicleModelInterface.
+//
+// When the memory budget is exceeded roads are evicted in the order they were added.
+//
+// NOTE: this class is thread-safe.
+class RoadJunctionsCache final
+{
+public:
+  explicit RoadJunctionsCache(size_t bytesLimit) : m_bytesLimit(bytesLimit) {}
+
+  // Copies junctions of |featureId| to |junctions|. Returns false if the road is not cached or
+  // if it's cached without altitudes and |withAltitudes| is true. If |withAltitudes| is false
+  // altitudes of |junctions| are set to feature::kDefaultAltitudeMeters.
+  bool Get(MwmSet::MwmId const & mwmId, uint32_t featureId, bool withAltitudes,
+           RoadJunctions & junctions) const;
+  void Put(MwmSet::MwmId const & mwmId, uint32_t featureId, bool withAltitudes,
+           RoadJunctions const & junctions);
+
+  size_t GetBytes() const;
+
+private:
+  struct Road
+  {
+    std::vector<Junction> m_junctions;
+    bool m_withAltitudes = false;
+  };
+
+  using Key = std::pair<MwmSet::MwmId, uint32_t>;
+
+  static size_t GetRoadBytes(Road const & road);
+
+  void EvictIfNeeded();
+
+  size_t const m_bytesLimit;
+  mutable std::mutex m_mutex;
+  std::map<MwmSet::MwmId, std::unordered_map<uint32_t, Road>> m_roads;
+  // Keys of |m_roads| in the order they were added.
+  std::deque<Key> m_order;
+  size_t m_bytes = 0;
+
+  DISALLOW_COPY_AND_MOVE(RoadJunctionsCache);
+};
+}  // namespace routing
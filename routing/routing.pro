@@ -51,6 +51,7 @@ SOURCES += \
     road_graph.cpp \
     road_graph_router.cpp \
     road_index.cpp \
+    road_junctions_cache.cpp \
     route.cpp \
     route_weight.cpp \
     router.cpp \
@@ -61,9 +62,12 @@ SOURCES += \
     routing_session.cpp \
     routing_settings.cpp \
     segmented_route.cpp \
+    shortcut_overlay.cpp \
     single_vehicle_world_graph.cpp \
     speed_camera.cpp \
+    speed_profiles.cpp \
     traffic_stash.cpp \
+    transit_graph.cpp \
     turns.cpp \
     turns_generator.cpp \
     turns_notification_manager.cpp \
@@ -121,6 +125,7 @@ HEADERS += \
     road_graph.hpp \
     road_graph_router.hpp \
     road_index.hpp \
+    road_junctions_cache.hpp \
     road_point.hpp \
     route.hpp \
     route_point.hpp \
@@ -134,11 +139,17 @@ HEADERS += \
     routing_result_graph.hpp \
     routing_session.hpp \
     routing_settings.hpp \
+    routing_stats.hpp \
     segment.hpp \
     segmented_route.hpp \
+    shortcut_overlay.hpp \
+    shortcut_overlay_serialization.hpp \
     single_vehicle_world_graph.hpp \
     speed_camera.hpp \
+    speed_profiles.hpp \
+    speed_profiles_serialization.hpp \
     traffic_stash.hpp \
+    transit_graph.hpp \
     transition_points.hpp \
     turn_candidate.hpp \
     turns.hpp \
@@ -0,0 +1,163 @@
+#include "testing/testing.hpp"
+
+#include "routing/index_router.hpp"
+#include "routing/route.hpp"
+#include "routing/router_delegate.hpp"
+#include "routing/routing_stats.hpp"
+
+#include "map/routing_helpers.hpp"
+
+#include "traffic/traffic_cache.hpp"
+
+#include "storage/country_info_getter.hpp"
+
+#include "indexer/classificator_loader.hpp"
+#include "indexer/index.hpp"
+
+#include "platform/local_country_file.hpp"
+#include "platform/local_country_file_utils.hpp"
+#include "platform/platform.hpp"
+
+#include "geometry/latlon.hpp"
+#include "geometry/mercator.hpp"
+
+#include "base/logging.hpp"
+#include "base/macros.hpp"
+#include "base/timer.hpp"
+
+#include "std/target_os.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+// Test preconditions: mwms which cover all the routes of kCorpus must be placed
+// in omim/data folder.
+struct RouteCase
+{
+  char const * m_name;
+  ms::LatLon m_start;
+  ms::LatLon m_finish;
+};
+
+// Fixed corpus of origin/destination pairs. It's replayed with the same router in the same
+// order, so the results of different revisions are comparable.
+// Note. Don't change the corpus without a reason: timings of different corpora are not comparable.
+RouteCase const kCorpus[] = {
+    {"MoscowShort", {55.66218, 37.63253}, {55.66237, 37.63560}},
+    {"MoscowBaumanTTK", {55.77399, 37.68468}, {55.77198, 37.68782}},
+    {"MoscowCenterSVO", {55.75100, 37.61790}, {55.97310, 37.41460}},
+    {"MoscowSVOCenter", {55.97310, 37.41460}, {55.75100, 37.61790}},
+    {"NederlandLeeuwardenDenOever", {53.2076, 5.7082}, {52.9337, 5.0308}},
+    {"RussiaUfaUstKatav", {54.7304, 55.9554}, {54.9228, 58.1469}},
+    {"EnglandFranceLeMans", {51.09276, 1.11369}, {50.93227, 1.82725}},
+    {"MoscowMinsk", {55.750650, 37.617673}, {53.902114, 27.562020}},
+    {"MoscowParis", {55.75271, 37.62618}, {48.86123, 2.34129}},
+};
+
+// Returns peak resident set size of the process in bytes.
+uint64_t GetPeakMemoryBytes()
+{
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+
+#if defined(OMIM_OS_MAC)
+  // ru_maxrss is in bytes on macOS.
+  return static_cast<uint64_t>(usage.ru_maxrss);
+#else
+  // ru_maxrss is in kilobytes on Linux.
+  return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+}
+
+class CarRoutingBenchmark
+{
+public:
+  CarRoutingBenchmark()
+  {
+    classificator::Load();
+
+    m_cig = storage::CountryInfoReader::CreateCountryInfoReader(GetPlatform());
+
+    vector<platform::LocalCountryFile> localFiles;
+    platform::FindAllLocalMapsAndCleanup(numeric_limits<int64_t>::max(), localFiles);
+
+    auto numMwmIds = make_shared<NumMwmIds>();
+    for (auto const & localFile : localFiles)
+    {
+      auto const result = m_index.RegisterMap(localFile);
+      if (result.second != MwmSet::RegResult::Success)
+        continue;
+
+      MwmInfo const & info = *result.first.GetInfo();
+      if (info.GetType() == MwmInfo::COUNTRY)
+        numMwmIds->RegisterFile(localFile.GetCountryFile());
+    }
+
+    auto const countryFileGetter = [this](m2::PointD const & pt) {
+      return m_cig->GetRegionCountryId(pt);
+    };
+    auto const getMwmRectByName = [this](string const & countryId) {
+      return m_cig->GetLimitRectForLeaf(countryId);
+    };
+
+    m_router = make_unique<IndexRouter>(VehicleType::Car, false /* loadAltitudes */,
+                                        CountryParentNameGetterFn(), countryFileGetter,
+                                        getMwmRectByName, numMwmIds,
+                                        MakeNumMwmTree(*numMwmIds, *m_cig), m_trafficCache,
+                                        m_index);
+  }
+
+  void Run()
+  {
+    RoutingStats total;
+    double totalSec = 0.0;
+    for (auto const & routeCase : kCorpus)
+    {
+      RouterDelegate delegate;
+      Route route("" /* router */);
+      my::Timer timer;
+      auto const resultCode = m_router->CalculateRoute(
+          Checkpoints(MercatorBounds::FromLatLon(routeCase.m_start),
+                      MercatorBounds::FromLatLon(routeCase.m_finish)),
+          m2::PointD::Zero() /* startDirection */, false /* adjustToPrevRoute */, delegate, route);
+      double const elapsedSec = timer.ElapsedSeconds();
+      TEST_EQUAL(resultCode, IRouter::NoError, (routeCase.m_name));
+      TEST(route.IsValid(), (routeCase.m_name));
+
+      RoutingStats const & stats = m_router->GetLastRoutingStats();
+      LOG(LINFO, (routeCase.m_name, "elapsed:", elapsedSec, "s, distance:",
+                  route.GetTotalDistanceMeters(), "m,", stats, "peak memory:",
+                  GetPeakMemoryBytes(), "bytes"));
+
+      totalSec += elapsedSec;
+      total.m_graphLoadingSec += stats.m_graphLoadingSec;
+      total.m_searchSec += stats.m_searchSec;
+      total.m_directionsSec += stats.m_directionsSec;
+      total.m_polylineSec += stats.m_polylineSec;
+      total.m_settledVertices += stats.m_settledVertices;
+    }
+
+    LOG(LINFO, ("Corpus of", ARRAY_SIZE(kCorpus), "routes, elapsed:", totalSec, "s,", total,
+                "peak memory:", GetPeakMemoryBytes(), "bytes"));
+  }
+
+private:
+  Index m_index;
+  traffic::TrafficCache m_trafficCache;
+  unique_ptr<storage::CountryInfoGetter> m_cig;
+  unique_ptr<IndexRouter> m_router;
+};
+
+UNIT_CLASS_TEST(CarRoutingBenchmark, Corpus) { Run(); }
+}  // namespace
@@ -5,6 +5,7 @@
 #include "traffic/traffic_info.hpp"
 
 #include "base/stl_helpers.hpp"
+#include "base/timer.hpp"
 
 #include <algorithm>
 #include <utility>
@@ -53,6 +54,7 @@ void FillSegmentInfo(vector<Segment> const & segments, vector<Junction> const &
   double routeLengthMeters = 0.0;
   double routeLengthMerc = 0.0;
   double timeFromBeginningS = 0.0;
+  ms::SpherePoint prevPoint = MercatorBounds::ToSpherePoint(junctions[0].GetPoint());
 
   for (size_t i = 0; i < segments.size(); ++i)
   {
@@ -87,8 +89,9 @@ void FillSegmentInfo(vector<Segment> const & segments, vector<Junction> const &
         ++timeIdx;
     }
 
-    routeLengthMeters +=
-      MercatorBounds::DistanceOnEarth(junctions[i].GetPoint(), junctions[i + 1].GetPoint());
+    ms::SpherePoint const point = MercatorBounds::ToSpherePoint(junctions[i + 1].GetPoint());
+    routeLengthMeters += ms::EarthRadiusMeters() * ms::DistanceOnSphere(prevPoint, point);
+    prevPoint = point;
     routeLengthMerc += junctions[i].GetPoint().Length(junctions[i + 1].GetPoint());
 
     routeSegment.emplace_back(
@@ -101,7 +104,7 @@ void FillSegmentInfo(vector<Segment> const & segments, vector<Junction> const &
 void ReconstructRoute(IDirectionsEngine & engine, RoadGraphBase const & graph,
                       shared_ptr<TrafficStash> const & trafficStash,
                       my::Cancellable const & cancellable, vector<Junction> const & path,
-                      Route::TTimes && times, Route & route)
+                      Route::TTimes && times, Route & route, RoutingStats * stats)
 {
   if (path.empty())
   {
@@ -116,7 +119,12 @@ void ReconstructRoute(IDirectionsEngine & engine, RoadGraphBase const & graph,
   Route::TStreets streetNames;
   vector<Segment> segments;
 
-  if (!engine.Generate(graph, path, cancellable, turnsDir, streetNames, junctions, segments))
+  my::Timer timer;
+  bool const generated =
+      engine.Generate(graph, path, cancellable, turnsDir, streetNames, junctions, segments);
+  if (stats)
+    stats->m_directionsSec += timer.ElapsedSeconds();
+  if (!generated)
     return;
 
   if (cancellable.IsCancelled())
@@ -144,7 +152,10 @@ void ReconstructRoute(IDirectionsEngine & engine, RoadGraphBase const & graph,
   vector<m2::PointD> routeGeometry;
   JunctionsToPoints(junctions, routeGeometry);
 
+  timer.Reset();
   route.SetGeometry(routeGeometry.begin(), routeGeometry.end());
+  if (stats)
+    stats->m_polylineSec += timer.ElapsedSeconds();
 }
 
 Segment ConvertEdgeToSegment(NumMwmIds const & numMwmIds, Edge const & edge)
@@ -180,10 +191,12 @@ void CalculateMaxSpeedTimes(RoadGraphBase const & graph, vector<Junction> const
   double trackTimeSec = 0.0;
   times.emplace_back(0, trackTimeSec);
 
+  ms::SpherePoint prevPoint = MercatorBounds::ToSpherePoint(path[0].GetPoint());
   for (size_t i = 1; i < path.size(); ++i)
   {
-    double const lengthM =
-        MercatorBounds::DistanceOnEarth(path[i - 1].GetPoint(), path[i].GetPoint());
+    ms::SpherePoint const point = MercatorBounds::ToSpherePoint(path[i].GetPoint());
+    double const lengthM = ms::EarthRadiusMeters() * ms::DistanceOnSphere(prevPoint, point);
+    prevPoint = point;
     trackTimeSec += lengthM / speedMPS;
 
     times.emplace_back(i, trackTimeSec);
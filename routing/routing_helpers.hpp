@@ -3,6 +3,7 @@
 #include "routing/directions_engine.hpp"
 #include "routing/road_graph.hpp"
 #include "routing/route.hpp"
+#include "routing/routing_stats.hpp"
 #include "routing/traffic_stash.hpp"
 
 #include "traffic/traffic_info.hpp"
@@ -37,7 +38,7 @@ void FillSegmentInfo(std::vector<Segment> const & segments, std::vector<Junction
 void ReconstructRoute(IDirectionsEngine & engine, RoadGraphBase const & graph,
                       std::shared_ptr<TrafficStash> const & trafficStash,
                       my::Cancellable const & cancellable, std::vector<Junction> const & path,
-                      Route::TTimes && times, Route & route);
+                      Route::TTimes && times, Route & route, RoutingStats * stats = nullptr);
 
 /// \brief Converts |edge| to |segment|.
 /// \returns false if mwm of |edge| is not alive.
@@ -606,17 +606,18 @@ double RoutingSession::GetDistanceToCurrentCamM(SpeedCameraRestriction & camera,
   }
   size_t const currentIndex = max(currentIter.m_ind, m_lastCheckedSpeedCameraIndex + 1);
   size_t const upperBound = min(m_poly.GetPolyline().GetSize(), currentIndex + kSpeedCameraLookAheadCount);
-  for (m_lastCheckedSpeedCameraIndex = currentIndex; m_lastCheckedSpeedCameraIndex < upperBound; ++m_lastCheckedSpeedCameraIndex)
-  {
-    uint8_t speed = CheckCameraInPoint(m_poly.GetPolyline().GetPoint(m_lastCheckedSpeedCameraIndex), index);
-    if (speed != kNoSpeedCamera)
-    {
-      camera = SpeedCameraRestriction(static_cast<uint32_t>(m_lastCheckedSpeedCameraIndex), speed);
-      m_lastFoundCamera = camera;
-      return m_poly.GetDistanceM(currentIter, m_poly.GetIterToIndex(m_lastCheckedSpeedCameraIndex));
-    }
-  }
-  return kInvalidSpeedCameraDistance;
+  if (currentIndex >= upperBound)
+    return kInvalidSpeedCameraDistance;
+
+  uint8_t speed = kNoSpeedCamera;
+  m_lastCheckedSpeedCameraIndex = FindCameraOnRoute(m_poly.GetPolyline().GetPoints(), currentIndex,
+                                                    upperBound, index, speed);
+  if (speed == kNoSpeedCamera)
+    return kInvalidSpeedCameraDistance;
+
+  camera = SpeedCameraRestriction(static_cast<uint32_t>(m_lastCheckedSpeedCameraIndex), speed);
+  m_lastFoundCamera = camera;
+  return m_poly.GetDistanceM(currentIter, m_poly.GetIterToIndex(m_lastCheckedSpeedCameraIndex));
 }
 
 void RoutingSession::EmitCloseRoutingEvent() const
@@ -683,6 +684,7 @@ void RoutingSession::OnTrafficInfoAdded(TrafficInfo && info)
 {
   TrafficInfo::Coloring const & fullColoring = info.GetColoring();
   TrafficInfo::Coloring coloring;
+  coloring.reserve(fullColoring.size());
   for (auto const & kv : fullColoring)
   {
     ASSERT_NOT_EQUAL(kv.second, SpeedGroup::Unknown, ());
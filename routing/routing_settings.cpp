@@ -1,5 +1,10 @@
 #include "routing/routing_settings.hpp"
 
+namespace
+{
+size_t constexpr kRoadGeometryCacheBytes = 32 * 1024 * 1024;
+}  // namespace
+
 namespace routing
 {
 RoutingSettings GetRoutingSettings(VehicleType vehicleType)
@@ -10,15 +15,18 @@ RoutingSettings GetRoutingSettings(VehicleType vehicleType)
   case VehicleType::Transit:
     return {true /* m_matchRoute */,         false /* m_soundDirection */,
             20. /* m_matchingThresholdM */,  true /* m_keepPedestrianInfo */,
-            false /* m_showTurnAfterNext */, false /* m_speedCameraWarning*/};
+            false /* m_showTurnAfterNext */, false /* m_speedCameraWarning*/,
+            kRoadGeometryCacheBytes /* m_roadGeometryCacheBytes */};
   case VehicleType::Bicycle:
     return {true /* m_matchRoute */,         true /* m_soundDirection */,
             30. /* m_matchingThresholdM */,  false /* m_keepPedestrianInfo */,
-            false /* m_showTurnAfterNext */, false /* m_speedCameraWarning*/};
+            false /* m_showTurnAfterNext */, false /* m_speedCameraWarning*/,
+            kRoadGeometryCacheBytes /* m_roadGeometryCacheBytes */};
   case VehicleType::Car:
     return {true /* m_matchRoute */,        true /* m_soundDirection */,
             50. /* m_matchingThresholdM */, false /* m_keepPedestrianInfo */,
-            true /* m_showTurnAfterNext */, true /* m_speedCameraWarning*/};
+            true /* m_showTurnAfterNext */, true /* m_speedCameraWarning*/,
+            kRoadGeometryCacheBytes /* m_roadGeometryCacheBytes */};
   case VehicleType::Count:
     CHECK(false, ("Can't create GetRoutingSettings for", vehicleType));
     return {};
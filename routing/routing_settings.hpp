@@ -4,6 +4,8 @@
 
 #include "base/assert.hpp"
 
+#include <cstddef>
+
 namespace routing
 {
 
@@ -37,6 +39,10 @@ struct RoutingSettings
 
   /// \brief m_speedCameraWarning is a flag for enabling user notifications about speed cameras.
   bool m_speedCameraWarning;
+
+  /// \brief m_roadGeometryCacheBytes is a memory budget for road geometry loaded by the router
+  /// for one mwm. Least recently used roads are evicted when it's exceeded. Zero means no limit.
+  size_t m_roadGeometryCacheBytes;
 };
 
 RoutingSettings GetRoutingSettings(VehicleType vehicleType);
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+namespace routing
+{
+// Time spent in phases of a route calculation and the size of the search. It's filled by
+// IndexRouter and is used to find out which phase a routing change slows down.
+struct RoutingStats
+{
+  // Time of waiting for index graphs (routing, restriction and road access sections) of mwms.
+  // Graphs are loaded lazily by the search, so it's a part of |m_searchSec|.
+  double m_graphLoadingSec = 0.0;
+  // Time of AStarAlgorithm searches including unpacking of leaps and shortcuts.
+  double m_searchSec = 0.0;
+  // Time of IDirectionsEngine::Generate(): turns, street names and route segments.
+  double m_directionsSec = 0.0;
+  // Time of Route::SetGeometry(), i.e. building of FollowedPolyline.
+  double m_polylineSec = 0.0;
+  // Number of vertices settled by all the searches.
+  uint64_t m_settledVertices = 0;
+};
+
+inline std::string DebugPrint(RoutingStats const & stats)
+{
+  std::ostringstream out;
+  out << "RoutingStats [ graph loading: " << stats.m_graphLoadingSec
+      << " s, search: " << stats.m_searchSec << " s, directions: " << stats.m_directionsSec
+      << " s, polyline: " << stats.m_polylineSec
+      << " s, settled vertices: " << stats.m_settledVertices << " ]";
+  return out.str();
+}
+}  // namespace routing
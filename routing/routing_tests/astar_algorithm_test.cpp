@@ -1,8 +1,10 @@
+#include "testing/benchmark.hpp"
 #include "testing/testing.hpp"
 
 #include "routing/base/astar_algorithm.hpp"
 #include "routing/base/routing_result.hpp"
 
+#include "std/functional.hpp"
 #include "std/map.hpp"
 #include "std/utility.hpp"
 #include "std/vector.hpp"
@@ -77,6 +79,37 @@ void TestAStar(UndirectedGraph & graph, vector<unsigned> const & expectedRoute,
   TEST_ALMOST_EQUAL_ULPS(expectedDistance, actualRoute.m_distance, ());
 }
 
+#ifndef DEBUG
+BENCHMARK_TEST(AStarAlgorithm_Grid)
+{
+  // A grid of kSide x kSide vertices with edges between neighbours.
+  unsigned constexpr kSide = 100;
+  UndirectedGraph graph;
+  for (unsigned i = 0; i < kSide; ++i)
+  {
+    for (unsigned j = 0; j < kSide; ++j)
+    {
+      unsigned const v = i * kSide + j;
+      if (j + 1 < kSide)
+        graph.AddEdge(v, v + 1, 1 + (v % 3));
+      if (i + 1 < kSide)
+        graph.AddEdge(v, v + kSide, 1 + (v % 5));
+    }
+  }
+
+  TAlgorithm algo;
+  RoutingResult<unsigned /* VertexType */, double /* WeightType */> route;
+  testing::RunBenchmark("AStarAlgorithm FindPath", 1 /* warmUps */, 10 /* repetitions */, [&]() {
+    TEST_EQUAL(TAlgorithm::Result::OK, algo.FindPath(graph, 0u, kSide * kSide - 1, route), ());
+  });
+  testing::RunBenchmark("AStarAlgorithm FindPathBidirectional", 1 /* warmUps */,
+                        10 /* repetitions */, [&]() {
+    TEST_EQUAL(TAlgorithm::Result::OK,
+               algo.FindPathBidirectional(graph, 0u, kSide * kSide - 1, route), ());
+  });
+}
+#endif
+
 UNIT_TEST(AStarAlgorithm_Sample)
 {
   UndirectedGraph graph;
@@ -93,6 +126,238 @@ UNIT_TEST(AStarAlgorithm_Sample)
   TestAStar(graph, expectedRoute, 23);
 }
 
+struct HashableVertex
+{
+  HashableVertex() = default;
+  HashableVertex(unsigned id) : m_id(id) {}
+
+  bool operator==(HashableVertex const & rhs) const { return m_id == rhs.m_id; }
+  bool operator!=(HashableVertex const & rhs) const { return m_id != rhs.m_id; }
+  bool operator<(HashableVertex const & rhs) const { return m_id < rhs.m_id; }
+
+  struct Hash
+  {
+    size_t operator()(HashableVertex const & v) const { return hash<unsigned>()(v.m_id); }
+  };
+
+  unsigned m_id = 0;
+};
+
+struct HashableEdge
+{
+  HashableEdge(HashableVertex const & v, double w) : v(v), w(w) {}
+
+  HashableVertex const & GetTarget() const { return v; }
+  double GetWeight() const { return w; }
+
+  HashableVertex v;
+  double w;
+};
+
+// The same graph as UndirectedGraph but with vertices which are kept in a hash table
+// by AStarAlgorithm.
+class HashableUndirectedGraph
+{
+public:
+  using TVertexType = HashableVertex;
+  using TEdgeType = HashableEdge;
+  using TWeightType = double;
+
+  void AddEdge(unsigned u, unsigned v, unsigned w)
+  {
+    m_adjs[u].push_back(HashableEdge(v, w));
+    m_adjs[v].push_back(HashableEdge(u, w));
+  }
+
+  void GetAdjacencyList(HashableVertex const & v, vector<HashableEdge> & adj) const
+  {
+    adj.clear();
+    auto const it = m_adjs.find(v.m_id);
+    if (it != m_adjs.end())
+      adj = it->second;
+  }
+
+  void GetIngoingEdgesList(HashableVertex const & v, vector<HashableEdge> & adj) const
+  {
+    GetAdjacencyList(v, adj);
+  }
+
+  void GetOutgoingEdgesList(HashableVertex const & v, vector<HashableEdge> & adj) const
+  {
+    GetAdjacencyList(v, adj);
+  }
+
+  double HeuristicCostEstimate(HashableVertex const & v, HashableVertex const & w) const
+  {
+    return 0;
+  }
+
+private:
+  map<unsigned, vector<HashableEdge>> m_adjs;
+};
+
+UNIT_TEST(AStarAlgorithm_HashableVertex)
+{
+  using TAlgorithmHashable = AStarAlgorithm<HashableUndirectedGraph>;
+
+  HashableUndirectedGraph graph;
+
+  // Inserts edges in a format: <source, target, weight>.
+  graph.AddEdge(0, 1, 10);
+  graph.AddEdge(1, 2, 5);
+  graph.AddEdge(2, 3, 5);
+  graph.AddEdge(2, 4, 10);
+  graph.AddEdge(3, 4, 3);
+
+  vector<HashableVertex> const expectedRoute = {0, 1, 2, 3, 4};
+
+  TAlgorithmHashable algo;
+  RoutingResult<HashableVertex /* VertexType */, double /* WeightType */> actualRoute;
+  TEST_EQUAL(TAlgorithmHashable::Result::OK,
+             algo.FindPath(graph, HashableVertex(0), HashableVertex(4), actualRoute), ());
+  TEST(expectedRoute == actualRoute.m_path, ());
+  TEST_ALMOST_EQUAL_ULPS(23.0, actualRoute.m_distance, ());
+
+  actualRoute.m_path.clear();
+  TEST_EQUAL(TAlgorithmHashable::Result::OK,
+             algo.FindPathBidirectional(graph, HashableVertex(0), HashableVertex(4), actualRoute),
+             ());
+  TEST(expectedRoute == actualRoute.m_path, ());
+  TEST_ALMOST_EQUAL_ULPS(23.0, actualRoute.m_distance, ());
+}
+
+// UndirectedGraph with a shortcut overlay: core vertices are expanded with shortcuts only.
+class OverlayGraph
+{
+public:
+  using TVertexType = unsigned;
+  using TEdgeType = Edge;
+  using TWeightType = double;
+
+  void AddEdge(unsigned u, unsigned v, unsigned w) { m_graph.AddEdge(u, v, w); }
+
+  void AddShortcut(unsigned u, unsigned v, unsigned w)
+  {
+    m_outgoing[u].push_back(Edge(v, w));
+    m_ingoing[v].push_back(Edge(u, w));
+  }
+
+  void GetIngoingEdgesList(unsigned v, vector<Edge> & adj) const
+  {
+    GetEdgesList(v, m_ingoing, adj);
+  }
+
+  void GetOutgoingEdgesList(unsigned v, vector<Edge> & adj) const
+  {
+    GetEdgesList(v, m_outgoing, adj);
+  }
+
+  double HeuristicCostEstimate(unsigned v, unsigned w) const { return 0; }
+
+private:
+  void GetEdgesList(unsigned v, map<unsigned, vector<Edge>> const & shortcuts,
+                    vector<Edge> & adj) const
+  {
+    auto const it = shortcuts.find(v);
+    if (it == shortcuts.end())
+    {
+      m_graph.GetAdjacencyList(v, adj);
+      return;
+    }
+    adj = it->second;
+  }
+
+  UndirectedGraph m_graph;
+  map<unsigned, vector<Edge>> m_outgoing;
+  map<unsigned, vector<Edge>> m_ingoing;
+};
+
+UNIT_TEST(AStarAlgorithm_Overlay)
+{
+  using TAlgorithmOverlay = AStarAlgorithm<OverlayGraph>;
+
+  OverlayGraph graph;
+
+  // Inserts edges in a format: <source, target, weight>.
+  graph.AddEdge(0, 1, 1);
+  graph.AddEdge(1, 2, 1);
+  graph.AddEdge(2, 3, 1);
+  graph.AddEdge(3, 4, 1);
+  graph.AddEdge(1, 5, 2);
+  graph.AddEdge(5, 3, 2);
+
+  // Vertices 1 and 3 are the core.
+  graph.AddShortcut(1, 3, 2);
+  graph.AddShortcut(3, 1, 2);
+
+  TAlgorithmOverlay algo;
+  RoutingResult<unsigned /* VertexType */, double /* WeightType */> actualRoute;
+  TEST_EQUAL(TAlgorithmOverlay::Result::OK,
+             algo.FindPathBidirectionalOverlay(graph, 0u, 4u, actualRoute), ());
+  TEST_EQUAL(actualRoute.m_path, vector<unsigned>({0, 1, 3, 4}), ());
+  TEST_ALMOST_EQUAL_ULPS(actualRoute.m_distance, 4.0, ());
+
+  // The finish is between core vertices, the waves meet at a core vertex.
+  actualRoute.m_path.clear();
+  TEST_EQUAL(TAlgorithmOverlay::Result::OK,
+             algo.FindPathBidirectionalOverlay(graph, 0u, 2u, actualRoute), ());
+  TEST_EQUAL(actualRoute.m_path, vector<unsigned>({0, 1, 2}), ());
+  TEST_ALMOST_EQUAL_ULPS(actualRoute.m_distance, 2.0, ());
+
+  actualRoute.m_path.clear();
+  TEST_EQUAL(TAlgorithmOverlay::Result::NoPath,
+             algo.FindPathBidirectionalOverlay(graph, 0u, 6u, actualRoute), ());
+}
+
+UNIT_TEST(AStarAlgorithm_Alternatives)
+{
+  UndirectedGraph graph;
+
+  // The best path: 0, 1, 2, 3, 4, 5.
+  for (unsigned i = 0; i < 5; ++i)
+    graph.AddEdge(i /* from */, i + 1 /* to */, 2 /* weight */);
+  // A detour from 1 to 4 through 6 and 7.
+  graph.AddEdge(1, 6, 2);
+  graph.AddEdge(6, 7, 2);
+  graph.AddEdge(7, 4, 3);
+  // A separate path through 8.
+  graph.AddEdge(0, 8, 6);
+  graph.AddEdge(8, 5, 6);
+  // A path which is too long.
+  graph.AddEdge(0, 9, 20);
+  graph.AddEdge(9, 5, 20);
+
+  TAlgorithm algo;
+  for (size_t threadsCount : {1, 3})
+  {
+    TAlgorithm::AlternativesParams params;
+    params.m_threadsCount = threadsCount;
+
+    vector<RoutingResult<unsigned /* VertexType */, double /* WeightType */>> results;
+    TEST_EQUAL(algo.FindPathBidirectionalWithAlternatives(graph, 0u, 5u, params, results),
+               TAlgorithm::Result::OK, ());
+    TEST_EQUAL(results.size(), 3, ());
+    TEST_EQUAL(results[0].m_path, vector<unsigned>({0, 1, 2, 3, 4, 5}), ());
+    TEST_ALMOST_EQUAL_ULPS(results[0].m_distance, 10.0, ());
+    TEST_EQUAL(results[1].m_path, vector<unsigned>({0, 1, 6, 7, 4, 5}), ());
+    TEST_ALMOST_EQUAL_ULPS(results[1].m_distance, 11.0, ());
+    TEST_EQUAL(results[2].m_path, vector<unsigned>({0, 8, 5}), ());
+    TEST_ALMOST_EQUAL_ULPS(results[2].m_distance, 12.0, ());
+
+    params.m_maxAlternatives = 1;
+    TEST_EQUAL(algo.FindPathBidirectionalWithAlternatives(graph, 0u, 5u, params, results),
+               TAlgorithm::Result::OK, ());
+    TEST_EQUAL(results.size(), 2, ());
+    TEST_EQUAL(results[1].m_path, vector<unsigned>({0, 1, 6, 7, 4, 5}), ());
+  }
+
+  vector<RoutingResult<unsigned /* VertexType */, double /* WeightType */>> results;
+  TEST_EQUAL(algo.FindPathBidirectionalWithAlternatives(graph, 0u, 10u,
+                                                        TAlgorithm::AlternativesParams(), results),
+             TAlgorithm::Result::NoPath, ());
+  TEST(results.empty(), ());
+}
+
 UNIT_TEST(AdjustRoute)
 {
   UndirectedGraph graph;
@@ -291,6 +291,28 @@ UNIT_TEST(WeightsSerialization)
   TEST(!connector.WeightsWereLoaded(), ());
   TEST(!connector.HasWeights(), ());
 
+  // Weights of edges from an enter are loaded without other weights.
+  Segment const lastEnter(mwmId, kNumTransitions - 1, 1, true /* forward */);
+  TEST(!connector.WeightsWereLoaded(lastEnter, true /* isOutgoing */), ());
+  {
+    MemReader reader(buffer.data(), buffer.size());
+    ReaderSource<MemReader> source(reader);
+    CrossMwmConnectorSerializer::DeserializeEdgesWeights(VehicleType::Car, lastEnter,
+                                                         true /* isOutgoing */, connector, source);
+  }
+  TEST(connector.WeightsWereLoaded(lastEnter, true /* isOutgoing */), ());
+  TEST(!connector.WeightsWereLoaded(Segment(mwmId, 0, 1, true /* forward */), true /* isOutgoing */),
+       ());
+  TEST(!connector.WeightsWereLoaded(), ());
+  TEST(!connector.HasWeights(), ());
+  TestEdges(connector, lastEnter, true /* isOutgoing */,
+            {{Segment(mwmId, 0, 1 /* segmentIdx */, false /* forward */),
+              RouteWeight::FromCrossMwmWeight(weights[6])},
+             {Segment(mwmId, 1, 1 /* segmentIdx */, false /* forward */),
+              RouteWeight::FromCrossMwmWeight(weights[7])},
+             {Segment(mwmId, 2, 1 /* segmentIdx */, false /* forward */),
+              RouteWeight::FromCrossMwmWeight(weights[8])}});
+
   {
     MemReader reader(buffer.data(), buffer.size());
     ReaderSource<MemReader> source(reader);
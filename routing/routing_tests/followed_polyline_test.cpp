@@ -68,6 +68,30 @@ UNIT_TEST(FollowedPolylineFollowingTestByProjection)
   TEST_EQUAL(polyline.GetCurrentIter().m_pt, m2::PointD(5, 0), ());
 }
 
+UNIT_TEST(FollowedPolylineFollowingTestOnLongPolyline)
+{
+  // A zigzag, so segments far from each other along the route are close on the map.
+  std::vector<m2::PointD> points;
+  for (size_t i = 0; i < 1001; ++i)
+    points.emplace_back(static_cast<double>(i % 2), i * 0.001);
+  m2::PolylineD testPolyline(points);
+  FollowedPolyline polyline(testPolyline.Begin(), testPolyline.End());
+
+  polyline.UpdateProjection(MercatorBounds::RectByCenterXYAndSizeInMeters({0.5, 0.7005}, 20));
+  TEST_EQUAL(polyline.GetCurrentIter().m_ind, 700, ());
+  TEST_LESS_OR_EQUAL(MercatorBounds::DistanceOnEarth(polyline.GetCurrentIter().m_pt,
+                                                     m2::PointD(0.5, 0.7005)), 0.1, ());
+
+  // The route doesn't go back.
+  auto const iter =
+      polyline.UpdateProjection(MercatorBounds::RectByCenterXYAndSizeInMeters({0.5, 0.3005}, 20));
+  TEST(!iter.IsValid(), ());
+  TEST_EQUAL(polyline.GetCurrentIter().m_ind, 700, ());
+
+  polyline.UpdateProjection(MercatorBounds::RectByCenterXYAndSizeInMeters({0.5, 0.9995}, 20));
+  TEST_EQUAL(polyline.GetCurrentIter().m_ind, 999, ());
+}
+
 UNIT_TEST(FollowedPolylineFollowingTestByPrediction)
 {
   m2::PolylineD testPolyline({{0, 0}, {0.003, 0}, {0.003, 1}});
@@ -83,7 +83,9 @@ class TestIndexGraphLoader final : public IndexGraphLoader
 public:
   // IndexGraphLoader overrides:
   IndexGraph & GetIndexGraph(NumMwmId mwmId) override;
+  void Prefetch(NumMwmId /* mwmId */) override {}
   virtual void Clear() override;
+  double GetLoadingTimeSec() const override { return 0.0; }
 
   void AddGraph(NumMwmId mwmId, unique_ptr<IndexGraph> graph);
 
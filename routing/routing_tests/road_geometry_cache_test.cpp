@@ -0,0 +1,83 @@
+#include "testing/testing.hpp"
+
+#include "routing/geometry.hpp"
+
+#include <cstdint>
+#include <memory>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+class CountingGeometryLoader final : public GeometryLoader
+{
+public:
+  explicit CountingGeometryLoader(uint32_t & loads) : m_loads(loads) {}
+
+  // GeometryLoader overrides:
+  void Load(uint32_t featureId, RoadGeometry & road) override
+  {
+    ++m_loads;
+    auto const x = static_cast<double>(featureId);
+    road = RoadGeometry(false /* oneWay */, 1.0 /* speed */,
+                        RoadGeometry::Points({{x, 0.0}, {x, 1.0}}));
+  }
+
+private:
+  uint32_t & m_loads;
+};
+
+UNIT_TEST(RoadGeometryCache_Unlimited)
+{
+  uint32_t loads = 0;
+  Geometry geometry(make_unique<CountingGeometryLoader>(loads));
+
+  for (uint32_t i = 0; i < 1000; ++i)
+    geometry.GetRoad(i);
+  for (uint32_t i = 0; i < 1000; ++i)
+    TEST_EQUAL(geometry.GetRoad(i).GetPoint(0), m2::PointD(i, 0.0), ());
+
+  TEST_EQUAL(loads, 1000, ());
+  TEST_EQUAL(geometry.GetNumCachedRoads(), 1000, ());
+  TEST_EQUAL(geometry.GetCacheStats().m_hits, 1000, ());
+  TEST_EQUAL(geometry.GetCacheStats().m_misses, 1000, ());
+  TEST_EQUAL(geometry.GetCacheStats().m_evictions, 0, ());
+}
+
+UNIT_TEST(RoadGeometryCache_Lru)
+{
+  uint32_t loads = 0;
+  Geometry geometry(make_unique<CountingGeometryLoader>(loads));
+
+  geometry.GetRoad(0);
+  size_t const roadBytes = geometry.GetCacheBytes();
+  TEST_GREATER(roadBytes, 0, ());
+
+  size_t const capacity = Geometry::kMinCachedRoads + 10;
+  geometry.SetCacheBytesLimit(roadBytes * capacity);
+
+  for (uint32_t i = 1; i < 200; ++i)
+  {
+    geometry.GetRoad(i);
+    // Road 0 is the most recently used one all the time.
+    geometry.GetRoad(0);
+  }
+
+  TEST_EQUAL(geometry.GetNumCachedRoads(), capacity, ());
+  TEST_LESS_OR_EQUAL(geometry.GetCacheBytes(), roadBytes * capacity, ());
+  TEST_EQUAL(geometry.GetCacheStats().m_evictions, 200 - capacity, ());
+  TEST_EQUAL(loads, 200, ());
+
+  // Road 0 and recently loaded roads are kept, old roads are evicted.
+  geometry.GetRoad(0);
+  geometry.GetRoad(199);
+  TEST_EQUAL(loads, 200, ());
+  TEST_EQUAL(geometry.GetRoad(1).GetPoint(0), m2::PointD(1.0, 0.0), ());
+  TEST_EQUAL(loads, 201, ());
+
+  // Budget below kMinCachedRoads roads keeps kMinCachedRoads roads.
+  geometry.SetCacheBytesLimit(1);
+  TEST_EQUAL(geometry.GetNumCachedRoads(), Geometry::kMinCachedRoads, ());
+}
+}  // namespace
@@ -0,0 +1,76 @@
+#include "testing/testing.hpp"
+
+#include "routing/road_junctions_cache.hpp"
+
+#include "indexer/feature_altitude.hpp"
+
+#include <memory>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+RoadJunctions MakeJunctions(double x, feature::TAltitude altitude)
+{
+  return RoadJunctions({Junction({x, 0.0}, altitude), Junction({x, 1.0}, altitude)});
+}
+
+// Note. Junction::operator== doesn't compare altitudes.
+void TestJunctions(RoadJunctions const & junctions, double x, feature::TAltitude altitude)
+{
+  TEST_EQUAL(junctions, MakeJunctions(x, altitude), ());
+  for (auto const & junction : junctions)
+    TEST_EQUAL(junction.GetAltitude(), altitude, ());
+}
+
+UNIT_TEST(RoadJunctionsCache_Altitudes)
+{
+  RoadJunctionsCache cache(1024 * 1024 /* bytesLimit */);
+  MwmSet::MwmId const mwmA(make_shared<MwmInfo>());
+  MwmSet::MwmId const mwmB(make_shared<MwmInfo>());
+
+  RoadJunctions junctions;
+  TEST(!cache.Get(mwmA, 1 /* featureId */, false /* withAltitudes */, junctions), ());
+
+  cache.Put(mwmA, 1 /* featureId */, false /* withAltitudes */, MakeJunctions(1.0, 0));
+  TEST(cache.Get(mwmA, 1 /* featureId */, false /* withAltitudes */, junctions), ());
+  TestJunctions(junctions, 1.0, 0);
+  TEST(!cache.Get(mwmA, 1 /* featureId */, true /* withAltitudes */, junctions), ());
+  TEST(!cache.Get(mwmB, 1 /* featureId */, false /* withAltitudes */, junctions), ());
+
+  cache.Put(mwmA, 1 /* featureId */, true /* withAltitudes */, MakeJunctions(1.0, 100));
+  TEST(cache.Get(mwmA, 1 /* featureId */, true /* withAltitudes */, junctions), ());
+  TestJunctions(junctions, 1.0, 100);
+  TEST(cache.Get(mwmA, 1 /* featureId */, false /* withAltitudes */, junctions), ());
+  TestJunctions(junctions, 1.0, feature::kDefaultAltitudeMeters);
+}
+
+UNIT_TEST(RoadJunctionsCache_Eviction)
+{
+  MwmSet::MwmId const mwmId(make_shared<MwmInfo>());
+  RoadJunctions junctions;
+
+  RoadJunctionsCache probe(0 /* bytesLimit */);
+  probe.Put(mwmId, 0 /* featureId */, false /* withAltitudes */, MakeJunctions(0.0, 0));
+  TEST_EQUAL(probe.GetBytes(), 0, ());
+  TEST(!probe.Get(mwmId, 0 /* featureId */, false /* withAltitudes */, junctions), ());
+
+  RoadJunctionsCache unlimited(1024 * 1024 /* bytesLimit */);
+  unlimited.Put(mwmId, 0 /* featureId */, false /* withAltitudes */, MakeJunctions(0.0, 0));
+  size_t const roadBytes = unlimited.GetBytes();
+
+  RoadJunctionsCache cache(3 * roadBytes /* bytesLimit */);
+  for (uint32_t i = 0; i < 5; ++i)
+    cache.Put(mwmId, i /* featureId */, false /* withAltitudes */, MakeJunctions(i, 0));
+
+  TEST_EQUAL(cache.GetBytes(), 3 * roadBytes, ());
+  for (uint32_t i = 0; i < 2; ++i)
+    TEST(!cache.Get(mwmId, i /* featureId */, false /* withAltitudes */, junctions), (i));
+  for (uint32_t i = 2; i < 5; ++i)
+  {
+    TEST(cache.Get(mwmId, i /* featureId */, false /* withAltitudes */, junctions), (i));
+    TestJunctions(junctions, i, 0 /* altitude */);
+  }
+}
+}  // namespace
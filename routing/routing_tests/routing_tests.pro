@@ -40,12 +40,17 @@ SOURCES += \
   osrm_router_test.cpp \
   restriction_test.cpp \
   road_access_test.cpp \
+  road_geometry_cache_test.cpp \
   road_graph_builder.cpp \
   road_graph_nearest_edges_test.cpp \
+  road_junctions_cache_test.cpp \
   route_tests.cpp \
   routing_helpers_tests.cpp \
   routing_mapping_test.cpp \
   routing_session_test.cpp \
+  shortcut_overlay_test.cpp \
+  speed_profiles_test.cpp \
+  transit_graph_test.cpp \
   turns_generator_test.cpp \
   turns_sound_test.cpp \
   turns_tts_text_tests.cpp \
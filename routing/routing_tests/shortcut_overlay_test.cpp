@@ -0,0 +1,101 @@
+#include "testing/testing.hpp"
+
+#include "routing/route_weight.hpp"
+#include "routing/segment.hpp"
+#include "routing/shortcut_overlay.hpp"
+#include "routing/shortcut_overlay_serialization.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+vector<SegmentEdge> GetEdges(ShortcutOverlay const & overlay, Segment const & segment,
+                             bool isOutgoing)
+{
+  vector<SegmentEdge> edges;
+  overlay.GetEdgeList(segment, isOutgoing, edges);
+  sort(edges.begin(), edges.end());
+  return edges;
+}
+
+UNIT_TEST(ShortcutOverlay_EdgeList)
+{
+  NumMwmId constexpr kMwmId = 3;
+  // Segment is (numMwmId, featureId, segmentIdx, isForward).
+  Segment const a(kFakeNumMwmId, 1, 0, true);
+  Segment const b(kFakeNumMwmId, 7, 2, false);
+  Segment const c(kFakeNumMwmId, 3, 1, true);
+
+  ShortcutOverlay overlay;
+  TEST(overlay.IsEmpty(), ());
+
+  overlay.AddCore(a);
+  overlay.AddCore(b);
+  overlay.AddShortcut(a, b, RouteWeight(10.0, 0 /* nontransitCross */));
+  overlay.AddShortcut(b, a, RouteWeight(12.5, 1 /* nontransitCross */));
+
+  TEST(!overlay.IsEmpty(), ());
+  TEST_EQUAL(overlay.GetNumCore(), 2, ());
+  TEST_EQUAL(overlay.GetNumShortcuts(), 2, ());
+  TEST(overlay.IsCore(Segment(kMwmId, 1, 0, true)), ());
+  TEST(!overlay.IsCore(Segment(kMwmId, 1, 0, false)), ());
+  TEST(!overlay.IsCore(c), ());
+
+  Segment const mwmA(kMwmId, a.GetFeatureId(), a.GetSegmentIdx(), a.IsForward());
+  Segment const mwmB(kMwmId, b.GetFeatureId(), b.GetSegmentIdx(), b.IsForward());
+  TEST_EQUAL(GetEdges(overlay, mwmA, true /* isOutgoing */),
+             vector<SegmentEdge>({SegmentEdge(mwmB, RouteWeight(10.0, 0))}), ());
+  TEST_EQUAL(GetEdges(overlay, mwmA, false /* isOutgoing */),
+             vector<SegmentEdge>({SegmentEdge(mwmB, RouteWeight(12.5, 1))}), ());
+}
+
+UNIT_TEST(ShortcutOverlay_Serialization)
+{
+  // Segment is (numMwmId, featureId, segmentIdx, isForward).
+  vector<Segment> const core = {
+      Segment(kFakeNumMwmId, 5, 0, true), Segment(kFakeNumMwmId, 5, 0, false),
+      Segment(kFakeNumMwmId, 2, 3, true), Segment(kFakeNumMwmId, 100, 1, false)};
+
+  ShortcutOverlay overlay;
+  for (Segment const & segment : core)
+    overlay.AddCore(segment);
+
+  overlay.AddShortcut(core[0], core[2], RouteWeight(3.5, 0 /* nontransitCross */));
+  overlay.AddShortcut(core[0], core[3], RouteWeight(40.0, 2 /* nontransitCross */));
+  overlay.AddShortcut(core[1], core[0], RouteWeight(0.5, 0 /* nontransitCross */));
+  overlay.AddShortcut(core[3], core[2], RouteWeight(17.5, 0 /* nontransitCross */));
+
+  vector<uint8_t> buf;
+  {
+    MemWriter<decltype(buf)> writer(buf);
+    ShortcutOverlaySerializer::Serialize(overlay, writer);
+  }
+
+  ShortcutOverlay deserialized;
+  MemReader memReader(buf.data(), buf.size());
+  ReaderSource<MemReader> src(memReader);
+  ShortcutOverlaySerializer::Deserialize(src, deserialized);
+  TEST_EQUAL(src.Size(), 0, ());
+
+  TEST_EQUAL(deserialized.GetNumCore(), overlay.GetNumCore(), ());
+  TEST_EQUAL(deserialized.GetNumShortcuts(), overlay.GetNumShortcuts(), ());
+  for (Segment const & segment : core)
+  {
+    TEST(deserialized.IsCore(segment), (segment));
+    // Weights are multiples of the serialization precision, so they are restored exactly.
+    for (bool const isOutgoing : {true, false})
+    {
+      TEST_EQUAL(GetEdges(deserialized, segment, isOutgoing),
+                 GetEdges(overlay, segment, isOutgoing), (segment, isOutgoing));
+    }
+  }
+}
+}  // namespace
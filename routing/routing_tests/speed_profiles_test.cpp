@@ -0,0 +1,99 @@
+#include "testing/testing.hpp"
+
+#include "routing/segment.hpp"
+#include "routing/speed_profiles.hpp"
+#include "routing/speed_profiles_serialization.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+SpeedProfiles::Profile MakeProfile(uint8_t speed)
+{
+  SpeedProfiles::Profile profile;
+  profile.fill(speed);
+  return profile;
+}
+
+UNIT_TEST(SpeedProfiles_SpeedFactor)
+{
+  NumMwmId constexpr kMwmId = 3;
+  uint32_t constexpr kHourSec = 60 * 60;
+
+  SpeedProfiles::Profile rushHour = MakeProfile(100);
+  // 8:00 - 9:00 is a rush hour.
+  for (uint32_t bucket = 8 * 4; bucket < 9 * 4; ++bucket)
+    rushHour[bucket] = 25;
+  // There's no data on 3:00 - 3:15.
+  rushHour[3 * 4] = SpeedProfiles::kUnknownSpeed;
+
+  SpeedProfiles profiles;
+  TEST(profiles.IsEmpty(), ());
+  auto const profileId = profiles.AddProfile(rushHour);
+  // Segment is (numMwmId, featureId, segmentIdx, isForward).
+  profiles.SetProfile(Segment(kFakeNumMwmId, 1, 0, true), profileId);
+
+  TEST(!profiles.IsEmpty(), ());
+  TEST_EQUAL(profiles.GetNumProfiles(), 1, ());
+  TEST_EQUAL(profiles.GetNumSegments(), 1, ());
+
+  Segment const segment(kMwmId, 1, 0, true);
+  TEST_EQUAL(profiles.GetSpeedFactor(segment, 7 * kHourSec + 59 * 60), 1.0, ());
+  TEST_EQUAL(profiles.GetSpeedFactor(segment, 8 * kHourSec), 0.25, ());
+  TEST_EQUAL(profiles.GetSpeedFactor(segment, 8 * kHourSec + 59 * 60), 0.25, ());
+  TEST_EQUAL(profiles.GetSpeedFactor(segment, 9 * kHourSec), 1.0, ());
+  TEST_EQUAL(profiles.GetSpeedFactor(segment, 3 * kHourSec + 10 * 60), 1.0, ());
+
+  // There's no profile of the backward segment.
+  TEST_EQUAL(profiles.GetSpeedFactor(Segment(kMwmId, 1, 0, false), 8 * kHourSec), 1.0, ());
+}
+
+UNIT_TEST(SpeedProfiles_Serialization)
+{
+  SpeedProfiles profiles;
+  SpeedProfiles::Profile slow = MakeProfile(50);
+  slow[0] = SpeedProfiles::kUnknownSpeed;
+  auto const slowId = profiles.AddProfile(slow);
+  auto const fastId = profiles.AddProfile(MakeProfile(90));
+
+  // Segment is (numMwmId, featureId, segmentIdx, isForward).
+  vector<Segment> const segments = {
+      Segment(kFakeNumMwmId, 5, 0, true), Segment(kFakeNumMwmId, 5, 0, false),
+      Segment(kFakeNumMwmId, 2, 3, true), Segment(kFakeNumMwmId, 100, 1, false)};
+  vector<uint32_t> const segmentProfiles = {slowId, fastId, fastId, slowId};
+  for (size_t i = 0; i < segments.size(); ++i)
+    profiles.SetProfile(segments[i], segmentProfiles[i]);
+
+  vector<uint8_t> buf;
+  {
+    MemWriter<decltype(buf)> writer(buf);
+    SpeedProfilesSerializer::Serialize(profiles, writer);
+  }
+
+  SpeedProfiles deserialized;
+  MemReader memReader(buf.data(), buf.size());
+  ReaderSource<MemReader> src(memReader);
+  SpeedProfilesSerializer::Deserialize(src, deserialized);
+  TEST_EQUAL(src.Size(), 0, ());
+
+  TEST_EQUAL(deserialized.GetNumProfiles(), profiles.GetNumProfiles(), ());
+  TEST_EQUAL(deserialized.GetNumSegments(), profiles.GetNumSegments(), ());
+  TEST_EQUAL(deserialized.GetProfile(slowId), slow, ());
+  TEST_EQUAL(deserialized.GetProfile(fastId), MakeProfile(90), ());
+  for (size_t i = 0; i < segments.size(); ++i)
+  {
+    for (uint32_t timeSec = 0; timeSec < 24 * 60 * 60; timeSec += SpeedProfiles::kBucketSec)
+    {
+      TEST_EQUAL(deserialized.GetSpeedFactor(segments[i], timeSec),
+                 profiles.GetSpeedFactor(segments[i], timeSec), (segments[i], timeSec));
+    }
+  }
+}
+}  // namespace
@@ -0,0 +1,124 @@
+#include "testing/testing.hpp"
+
+#include "routing/transit_graph.hpp"
+
+#include "routing_common/transit_serdes.hpp"
+#include "routing_common/transit_types.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "base/checked_cast.hpp"
+#include "base/math.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace routing;
+using namespace routing::transit;
+using namespace std;
+
+namespace
+{
+// Weights of the section are quantized.
+double constexpr kEps = 1e-2;
+
+// Line 10 goes through stops 1, 2, 3, 4 and has a branch from 2 to 7. Line 20 goes from 1 to 5
+// and line 40 from 6 to 4, 5 and 6 are connected by a transfer.
+void MakeTransit(vector<Stop> & stops, vector<transit::Edge> & edges)
+{
+  stops.clear();
+  for (StopId id : {1, 2, 3, 4, 5, 6, 7})
+    stops.emplace_back(id, kInvalidFeatureId, kInvalidTransferId, vector<LineId>(),
+                       m2::PointD(static_cast<double>(id), 0.0));
+
+  edges = {{1, 2, 100.0, 10, false, {}},
+           {2, 3, 100.0, 10, false, {}},
+           {3, 4, 100.0, 10, false, {}},
+           {2, 7, 5.0, 10, false, {}},
+           {1, 5, 50.0, 20, false, {}},
+           {5, 6, 20.0, kInvalidLineId, true, {}},
+           {6, 4, 10.0, 40, false, {}}};
+}
+
+void TestLeg(TransitGraph::Leg const & leg, StopId from, StopId to, LineId lineId, double weight)
+{
+  TEST_EQUAL(leg.m_from, from, ());
+  TEST_EQUAL(leg.m_to, to, ());
+  TEST_EQUAL(leg.m_lineId, lineId, ());
+  TEST(my::AlmostEqualAbs(leg.m_weight, weight, kEps), (leg.m_weight));
+}
+
+void TestJourneys(TransitGraph const & graph)
+{
+  TEST_EQUAL(graph.GetStopsCount(), 7, ());
+  // The branch of line 10 is a separate pattern.
+  TEST_EQUAL(graph.GetPatternsCount(), 4, ());
+
+  vector<TransitGraph::Access> const sources = {{1, 10.0}, {100, 0.0}};
+  vector<TransitGraph::Access> const targets = {{4, 0.0}, {3, 1000.0}};
+
+  vector<TransitGraph::Journey> journeys;
+  graph.FindJourneys(sources, targets, 3 /* maxRides */, journeys);
+  TEST_EQUAL(journeys.size(), 2, ());
+
+  TEST(my::AlmostEqualAbs(journeys[0].m_weight, 310.0, kEps), (journeys[0].m_weight));
+  TEST_EQUAL(journeys[0].m_sourceIdx, 0, ());
+  TEST_EQUAL(journeys[0].m_targetIdx, 0, ());
+  TEST_EQUAL(journeys[0].m_ridesCount, 1, ());
+  TEST_EQUAL(journeys[0].m_legs.size(), 1, ());
+  TestLeg(journeys[0].m_legs[0], 1, 4, 10, 300.0);
+
+  TEST(my::AlmostEqualAbs(journeys[1].m_weight, 90.0, kEps), (journeys[1].m_weight));
+  TEST_EQUAL(journeys[1].m_ridesCount, 2, ());
+  TEST_EQUAL(journeys[1].m_legs.size(), 3, ());
+  TestLeg(journeys[1].m_legs[0], 1, 5, 20, 50.0);
+  TestLeg(journeys[1].m_legs[1], 5, 6, kInvalidLineId, 20.0);
+  TestLeg(journeys[1].m_legs[2], 6, 4, 40, 10.0);
+
+  graph.FindJourneys(sources, targets, 1 /* maxRides */, journeys);
+  TEST_EQUAL(journeys.size(), 1, ());
+  TEST(my::AlmostEqualAbs(journeys[0].m_weight, 310.0, kEps), (journeys[0].m_weight));
+
+  // Stop 1 can't be reached from 4.
+  graph.FindJourneys({{4, 0.0}}, {{1, 0.0}}, 3 /* maxRides */, journeys);
+  TEST(journeys.empty(), ());
+}
+
+UNIT_TEST(TransitGraph_FindJourneys)
+{
+  vector<Stop> stops;
+  vector<transit::Edge> edges;
+  MakeTransit(stops, edges);
+
+  TransitGraph graph;
+  graph.Build(stops, edges);
+  TestJourneys(graph);
+}
+
+UNIT_TEST(TransitGraph_Deserialize)
+{
+  vector<Stop> stops;
+  vector<transit::Edge> edges;
+  MakeTransit(stops, edges);
+
+  vector<uint8_t> buffer;
+  MemWriter<vector<uint8_t>> writer(buffer);
+  Serializer<MemWriter<vector<uint8_t>>> serializer(writer);
+
+  TransitHeader header;
+  header.Visit(serializer);
+  serializer(stops);
+  header.m_gatesOffset = base::checked_cast<uint32_t>(writer.Pos());
+  header.m_edgesOffset = header.m_gatesOffset;
+  serializer(edges);
+  header.m_transfersOffset = base::checked_cast<uint32_t>(writer.Pos());
+  header.m_endOffset = header.m_transfersOffset;
+  writer.Seek(0);
+  header.Visit(serializer);
+
+  TransitGraph graph;
+  graph.Deserialize(MemReader(buffer.data(), buffer.size()));
+  TestJourneys(graph);
+}
+}  // namespace
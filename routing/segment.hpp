@@ -5,6 +5,7 @@
 #include "routing/route_weight.hpp"
 
 #include <cstdint>
+#include <functional>
 #include <sstream>
 #include <string>
 
@@ -71,6 +72,18 @@ public:
            m_mwmId == seg.m_mwmId && m_forward != seg.m_forward;
   }
 
+  struct Hash
+  {
+    size_t operator()(Segment const & seg) const
+    {
+      uint64_t const key = (static_cast<uint64_t>(seg.m_featureId) << 32) ^
+                           (static_cast<uint64_t>(seg.m_segmentIdx) << 17) ^
+                           (static_cast<uint64_t>(seg.m_mwmId) << 1) ^
+                           static_cast<uint64_t>(seg.m_forward);
+      return std::hash<uint64_t>()(key);
+    }
+  };
+
 private:
   uint32_t m_featureId = 0;
   uint32_t m_segmentIdx = 0;
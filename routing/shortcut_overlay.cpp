@@ -0,0 +1,45 @@
+#include "routing/shortcut_overlay.hpp"
+
+#include "base/assert.hpp"
+
+using namespace std;
+
+namespace routing
+{
+void ShortcutOverlay::AddCore(Segment const & segment)
+{
+  m_outgoing[GetKey(segment)];
+  m_ingoing[GetKey(segment)];
+}
+
+void ShortcutOverlay::AddShortcut(Segment const & from, Segment const & to,
+                                  RouteWeight const & weight)
+{
+  auto outIt = m_outgoing.find(GetKey(from));
+  CHECK(outIt != m_outgoing.end(), ("Shortcut from non-core segment", from));
+  outIt->second.emplace_back(GetKey(to), weight);
+  ++m_numShortcuts;
+
+  // Note. A shortcut may lead to a non-core segment. Backward wave expands such segments
+  // with regular edges, so the shortcut is not needed in the ingoing list.
+  auto inIt = m_ingoing.find(GetKey(to));
+  if (inIt != m_ingoing.end())
+    inIt->second.emplace_back(GetKey(from), weight);
+}
+
+void ShortcutOverlay::GetEdgeList(Segment const & segment, bool isOutgoing,
+                                  vector<SegmentEdge> & edges) const
+{
+  EdgesMap const & edgesMap = isOutgoing ? m_outgoing : m_ingoing;
+  auto const it = edgesMap.find(GetKey(segment));
+  CHECK(it != edgesMap.cend(), ("Segment", segment, "is not a core segment."));
+
+  for (SegmentEdge const & edge : it->second)
+  {
+    Segment const & target = edge.GetTarget();
+    edges.emplace_back(Segment(segment.GetMwmId(), target.GetFeatureId(), target.GetSegmentIdx(),
+                               target.IsForward()),
+                       edge.GetWeight());
+  }
+}
+}  // namespace routing
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "routing/route_weight.hpp"
+#include "routing/segment.hpp"
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace routing
+{
+// ShortcutOverlay is a one-level hierarchy over the index graph of an mwm.
+// Generator chooses a subset of segments (the core) and for every core segment stores shortcuts
+// to all core segments which are reachable from it through non-core segments only.
+// Weight of a shortcut is the weight of the best such path.
+//
+// Routing over the overlay expands core segments with shortcuts and all other segments with
+// regular index graph edges. Forward wave uses outgoing shortcuts and backward wave uses
+// ingoing ones, so the waves don't traverse mirror images of the same graph and
+// AStarAlgorithm::FindPathBidirectionalOverlay should be used. Shortcuts of the found route are
+// unpacked by a search in the mwm between shortcut ends.
+class ShortcutOverlay final
+{
+public:
+  void AddCore(Segment const & segment);
+  // |from| must be added to the core before. |to| may be a non-core segment.
+  void AddShortcut(Segment const & from, Segment const & to, RouteWeight const & weight);
+
+  bool IsEmpty() const { return m_outgoing.empty(); }
+  bool IsCore(Segment const & segment) const { return m_outgoing.count(GetKey(segment)) != 0; }
+  size_t GetNumCore() const { return m_outgoing.size(); }
+  size_t GetNumShortcuts() const { return m_numShortcuts; }
+
+  // Appends shortcuts outgoing from (ingoing to) |segment| to |edges|.
+  // |segment| should be a core segment. Targets of the shortcuts get mwm id of |segment|.
+  void GetEdgeList(Segment const & segment, bool isOutgoing,
+                   std::vector<SegmentEdge> & edges) const;
+
+  // Calls |fn| for each core segment with the list of its outgoing shortcuts.
+  template <typename Fn>
+  void ForEachCore(Fn && fn) const
+  {
+    for (auto const & kv : m_outgoing)
+      fn(kv.first, kv.second);
+  }
+
+private:
+  // Overlay is stored without numeric mwm ids, they are temporary and differ between sessions.
+  static Segment GetKey(Segment const & segment)
+  {
+    return Segment(kFakeNumMwmId, segment.GetFeatureId(), segment.GetSegmentIdx(),
+                   segment.IsForward());
+  }
+
+  using EdgesMap = std::unordered_map<Segment, std::vector<SegmentEdge>, Segment::Hash>;
+
+  EdgesMap m_outgoing;
+  EdgesMap m_ingoing;
+  size_t m_numShortcuts = 0;
+};
+}  // namespace routing
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "routing/num_mwm_id.hpp"
+#include "routing/route_weight.hpp"
+#include "routing/routing_exceptions.hpp"
+#include "routing/segment.hpp"
+#include "routing/shortcut_overlay.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace routing
+{
+// Section format:
+// uint16_t version;
+// varuint  number of core segments;
+// core segments sorted by feature id: varuint feature id delta, varuint segment key;
+// for each core segment in the same order:
+//   varuint number of shortcuts;
+//   for each shortcut: varint feature id delta from the core segment, varuint segment key,
+//                      varuint weight in kWeightPrecision units, varuint nontransit crosses.
+// Segment key is (segment idx << 1) | forward.
+class ShortcutOverlaySerializer final
+{
+public:
+  ShortcutOverlaySerializer() = delete;
+
+  template <class Sink>
+  static void Serialize(ShortcutOverlay const & overlay, Sink & sink)
+  {
+    std::vector<Segment> core;
+    core.reserve(overlay.GetNumCore());
+    overlay.ForEachCore([&](Segment const & segment, std::vector<SegmentEdge> const & /* edges */) {
+      core.push_back(segment);
+    });
+    std::sort(core.begin(), core.end());
+
+    uint16_t const version = kLatestVersion;
+    WriteToSink(sink, version);
+    WriteVarUint(sink, static_cast<uint64_t>(core.size()));
+
+    uint32_t prevFeatureId = 0;
+    for (Segment const & segment : core)
+    {
+      WriteVarUint(sink, segment.GetFeatureId() - prevFeatureId);
+      WriteVarUint(sink, GetSegmentKey(segment));
+      prevFeatureId = segment.GetFeatureId();
+    }
+
+    std::vector<SegmentEdge> edges;
+    for (Segment const & segment : core)
+    {
+      edges.clear();
+      overlay.GetEdgeList(segment, true /* isOutgoing */, edges);
+      WriteVarUint(sink, static_cast<uint64_t>(edges.size()));
+      for (SegmentEdge const & edge : edges)
+      {
+        Segment const & target = edge.GetTarget();
+        WriteVarInt(sink, static_cast<int64_t>(target.GetFeatureId()) -
+                              static_cast<int64_t>(segment.GetFeatureId()));
+        WriteVarUint(sink, GetSegmentKey(target));
+
+        RouteWeight const & weight = edge.GetWeight();
+        CHECK_GREATER_OR_EQUAL(weight.GetWeight(), 0.0, ());
+        CHECK_GREATER_OR_EQUAL(weight.GetNontransitCross(), 0, ());
+        // Shortcut weight should not be less than the astar heuristic, so round it upwards.
+        WriteVarUint(
+            sink, static_cast<uint64_t>(std::ceil(weight.GetWeight() * kWeightPrecision)));
+        WriteVarUint(sink, static_cast<uint32_t>(weight.GetNontransitCross()));
+      }
+    }
+  }
+
+  template <class Source>
+  static void Deserialize(Source & src, ShortcutOverlay & overlay)
+  {
+    auto const version = ReadPrimitiveFromSource<uint16_t>(src);
+    if (version != kLatestVersion)
+    {
+      MYTHROW(CorruptedDataException, ("Unknown shortcut overlay version", version));
+    }
+
+    auto const numCore = base::checked_cast<size_t>(ReadVarUint<uint64_t>(src));
+    std::vector<Segment> core;
+    core.reserve(numCore);
+
+    uint32_t featureId = 0;
+    for (size_t i = 0; i < numCore; ++i)
+    {
+      featureId += ReadVarUint<uint32_t>(src);
+      core.push_back(GetSegment(featureId, ReadVarUint<uint64_t>(src)));
+      overlay.AddCore(core.back());
+    }
+
+    for (Segment const & segment : core)
+    {
+      auto const numShortcuts = ReadVarUint<uint32_t>(src);
+      for (uint32_t i = 0; i < numShortcuts; ++i)
+      {
+        int64_t const targetFeatureId =
+            static_cast<int64_t>(segment.GetFeatureId()) + ReadVarInt<int64_t>(src);
+        if (targetFeatureId < 0 || targetFeatureId > std::numeric_limits<uint32_t>::max())
+          MYTHROW(CorruptedDataException, ("Wrong shortcut target feature id", targetFeatureId));
+
+        Segment const target = GetSegment(static_cast<uint32_t>(targetFeatureId),
+                                          ReadVarUint<uint64_t>(src));
+        double const weight = static_cast<double>(ReadVarUint<uint64_t>(src)) / kWeightPrecision;
+        auto const nontransitCross = ReadVarUint<uint32_t>(src);
+        overlay.AddShortcut(segment, target,
+                            RouteWeight(weight, base::checked_cast<int>(nontransitCross)));
+      }
+    }
+  }
+
+private:
+  static uint16_t constexpr kLatestVersion = 0;
+  // Shortcut weights are stored in tenths of a second.
+  static double constexpr kWeightPrecision = 10.0;
+
+  static uint64_t GetSegmentKey(Segment const & segment)
+  {
+    return (static_cast<uint64_t>(segment.GetSegmentIdx()) << 1) |
+           static_cast<uint64_t>(segment.IsForward() ? 1 : 0);
+  }
+
+  static Segment GetSegment(uint32_t featureId, uint64_t key)
+  {
+    return Segment(kFakeNumMwmId, featureId, base::checked_cast<uint32_t>(key >> 1), (key & 1) != 0);
+  }
+};
+}  // namespace routing
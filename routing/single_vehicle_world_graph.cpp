@@ -38,7 +38,8 @@ void SingleVehicleWorldGraph::GetEdgeList(Segment const & segment, bool isOutgoi
     return;
   }
 
-  if (m_mode != Mode::NoLeaps && m_mode != Mode::SingleMwm && (isLeap || m_mode == Mode::LeapsOnly))
+  bool const leapsAllowed = m_mode == Mode::LeapsOnly || m_mode == Mode::LeapsIfPossible;
+  if (leapsAllowed && (isLeap || m_mode == Mode::LeapsOnly))
   {
     CHECK(m_crossMwmGraph, ());
     if (m_crossMwmGraph->IsTransition(segment, isOutgoing))
@@ -49,7 +50,11 @@ void SingleVehicleWorldGraph::GetEdgeList(Segment const & segment, bool isOutgoi
   }
 
   IndexGraph & indexGraph = m_loader->GetIndexGraph(segment.GetMwmId());
-  indexGraph.GetEdgeList(segment, isOutgoing, edges);
+  // Route endings are expanded with regular edges to reach the fake segments of the starter.
+  if (m_mode == Mode::Shortcuts && !isEnding && indexGraph.GetShortcutOverlay().IsCore(segment))
+    indexGraph.GetShortcutOverlay().GetEdgeList(segment, isOutgoing, edges);
+  else
+    indexGraph.GetEdgeList(segment, isOutgoing, edges);
 
   if (m_mode != Mode::SingleMwm && m_crossMwmGraph && m_crossMwmGraph->IsTransition(segment, isOutgoing))
     GetTwins(segment, isOutgoing, edges);
@@ -98,9 +103,7 @@ RouteWeight SingleVehicleWorldGraph::HeuristicCostEstimate(m2::PointD const & fr
 
 RouteWeight SingleVehicleWorldGraph::CalcSegmentWeight(Segment const & segment)
 {
-  return RouteWeight(m_estimator->CalcSegmentWeight(
-                         segment, GetRoadGeometry(segment.GetMwmId(), segment.GetFeatureId())),
-                     0 /* nontransitCross */);
+  return m_loader->GetIndexGraph(segment.GetMwmId()).CalcSegmentWeight(segment);
 }
 
 RouteWeight SingleVehicleWorldGraph::CalcLeapWeight(m2::PointD const & from,
@@ -114,6 +117,11 @@ bool SingleVehicleWorldGraph::LeapIsAllowed(NumMwmId mwmId) const
   return m_estimator->LeapIsAllowed(mwmId);
 }
 
+ShortcutOverlay const & SingleVehicleWorldGraph::GetShortcutOverlay(NumMwmId mwmId)
+{
+  return m_loader->GetIndexGraph(mwmId).GetShortcutOverlay();
+}
+
 void SingleVehicleWorldGraph::GetTwins(Segment const & segment, bool isOutgoing,
                                        vector<SegmentEdge> & edges)
 {
@@ -121,6 +129,14 @@ void SingleVehicleWorldGraph::GetTwins(Segment const & segment, bool isOutgoing,
   m_crossMwmGraph->GetTwins(segment, isOutgoing, m_twins);
   for (Segment const & twin : m_twins)
   {
+    // The wave is going to enter the twin mwm. Its index graph is needed in these modes
+    // (in leaps modes it's needed for the start and the finish mwms only).
+    if ((m_mode == Mode::NoLeaps || m_mode == Mode::Shortcuts) &&
+        twin.GetMwmId() != segment.GetMwmId())
+    {
+      m_loader->Prefetch(twin.GetMwmId());
+    }
+
     m2::PointD const & from = GetPoint(segment, true /* front */);
     m2::PointD const & to = GetPoint(twin, true /* front */);
     double const weight = m_estimator->CalcHeuristic(from, to);
@@ -31,6 +31,7 @@ public:
   m2::PointD const & GetPoint(Segment const & segment, bool front) override;
   RoadGeometry const & GetRoadGeometry(NumMwmId mwmId, uint32_t featureId) override;
   void ClearCachedGraphs() override { m_loader->Clear(); }
+  double GetGraphLoadingTimeSec() const override { return m_loader->GetLoadingTimeSec(); }
   void SetMode(Mode mode) override { m_mode = mode; }
   Mode GetMode() const override { return m_mode; }
   void GetOutgoingEdgesList(Segment const & segment, std::vector<SegmentEdge> & edges) override;
@@ -40,6 +41,7 @@ public:
   RouteWeight CalcSegmentWeight(Segment const & segment) override;
   RouteWeight CalcLeapWeight(m2::PointD const & from, m2::PointD const & to) const override;
   bool LeapIsAllowed(NumMwmId mwmId) const override;
+  ShortcutOverlay const & GetShortcutOverlay(NumMwmId mwmId) override;
 
   // This method should be used for tests only
   IndexGraph & GetIndexGraphForTests(NumMwmId numMwmId)
@@ -18,6 +18,20 @@ namespace
 {
 double constexpr kCameraCheckRadiusMeters = 2.0;
 double constexpr kCoordinateEqualityDelta = 0.000001;
+// Max diagonal of a rect around consecutive route points whose features are read at once.
+double constexpr kMaxCamerasQueryRectMeters = 1000.0;
+
+struct Camera
+{
+  m2::PointD m_center;
+  uint8_t m_speedLimit;
+};
+
+bool IsCameraInPoint(m2::PointD const & camera, m2::PointD const & point)
+{
+  return my::AlmostEqualAbs(camera.x, point.x, kCoordinateEqualityDelta) &&
+         my::AlmostEqualAbs(camera.y, point.y, kCoordinateEqualityDelta);
+}
 }  // namespace
 
 namespace routing
@@ -37,11 +51,10 @@ uint8_t ReadCameraRestriction(FeatureType & ft)
   return 0;
 }
 
-uint8_t CheckCameraInPoint(m2::PointD const & point, Index const & index)
+template <typename Fn>
+void ForEachCameraInRect(m2::RectD const & rect, Index const & index, Fn && fn)
 {
-  uint32_t speedLimit = kNoSpeedCamera;
-
-  auto const f = [&point, &speedLimit](FeatureType & ft)
+  auto const f = [&fn](FeatureType & ft)
   {
     if (ft.GetFeatureType() != feature::GEOM_POINT)
       return;
@@ -50,15 +63,72 @@ uint8_t CheckCameraInPoint(m2::PointD const & point, Index const & index)
     if (!ftypes::IsSpeedCamChecker::Instance()(hl))
       return;
 
-    if (my::AlmostEqualAbs(ft.GetCenter().x, point.x, kCoordinateEqualityDelta) &&
-        my::AlmostEqualAbs(ft.GetCenter().y, point.y, kCoordinateEqualityDelta))
-      speedLimit = ReadCameraRestriction(ft);
+    fn(ft);
   };
 
-  index.ForEachInRect(f,
-                      MercatorBounds::RectByCenterXYAndSizeInMeters(point,
-                                                                    kCameraCheckRadiusMeters),
-                      scales::GetUpperScale());
+  index.ForEachInRect(f, rect, scales::GetUpperScale());
+}
+
+uint8_t CheckCameraInPoint(m2::PointD const & point, Index const & index)
+{
+  uint32_t speedLimit = kNoSpeedCamera;
+
+  ForEachCameraInRect(MercatorBounds::RectByCenterXYAndSizeInMeters(point, kCameraCheckRadiusMeters),
+                      index, [&point, &speedLimit](FeatureType & ft)
+  {
+    if (IsCameraInPoint(ft.GetCenter(), point))
+      speedLimit = ReadCameraRestriction(ft);
+  });
   return speedLimit;
 }
+
+size_t FindCameraOnRoute(vector<m2::PointD> const & points, size_t startIdx, size_t endIdx,
+                         Index const & index, uint8_t & speedLimit)
+{
+  ASSERT_LESS_OR_EQUAL(endIdx, points.size(), ());
+
+  speedLimit = kNoSpeedCamera;
+  vector<Camera> cameras;
+  size_t chunkBegin = startIdx;
+  while (chunkBegin < endIdx)
+  {
+    // Collects consecutive points until a rect around them becomes too large.
+    m2::RectD rect =
+        MercatorBounds::RectByCenterXYAndSizeInMeters(points[chunkBegin], kCameraCheckRadiusMeters);
+    size_t chunkEnd = chunkBegin + 1;
+    for (; chunkEnd < endIdx; ++chunkEnd)
+    {
+      m2::RectD extended = rect;
+      extended.Add(MercatorBounds::RectByCenterXYAndSizeInMeters(points[chunkEnd],
+                                                                 kCameraCheckRadiusMeters));
+      if (MercatorBounds::DistanceOnEarth(extended.LeftTop(), extended.RightBottom()) >
+          kMaxCamerasQueryRectMeters)
+      {
+        break;
+      }
+      rect = extended;
+    }
+
+    cameras.clear();
+    ForEachCameraInRect(rect, index, [&cameras](FeatureType & ft)
+    {
+      cameras.push_back({ft.GetCenter(), ReadCameraRestriction(ft)});
+    });
+
+    for (size_t i = chunkBegin; i < chunkEnd && !cameras.empty(); ++i)
+    {
+      for (auto const & camera : cameras)
+      {
+        if (IsCameraInPoint(camera.m_center, points[i]))
+        {
+          speedLimit = camera.m_speedLimit;
+          return i;
+        }
+      }
+    }
+
+    chunkBegin = chunkEnd;
+  }
+  return endIdx;
+}
 }  // namespace routing
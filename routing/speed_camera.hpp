@@ -3,6 +3,7 @@
 #include "geometry/point2d.hpp"
 
 #include "std/cstdint.hpp"
+#include "std/vector.hpp"
 
 class Index;
 
@@ -11,4 +12,12 @@ namespace routing
 extern uint8_t const kNoSpeedCamera;
 
 uint8_t CheckCameraInPoint(m2::PointD const & point, Index const & index);
+
+/// \brief Looks for the first speed camera at |points| with indices in [|startIdx|, |endIdx|).
+/// Features are read once for a rect around several consecutive points instead of
+/// a rect around every point.
+/// \returns index of the point with a camera and sets |speedLimit| to the camera's limit,
+/// or returns |endIdx| and sets |speedLimit| to kNoSpeedCamera if there's no camera.
+size_t FindCameraOnRoute(vector<m2::PointD> const & points, size_t startIdx, size_t endIdx,
+                         Index const & index, uint8_t & speedLimit);
 }  // namespace routing
@@ -0,0 +1,53 @@
+#include "routing/speed_profiles.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+
+namespace routing
+{
+// static
+uint32_t constexpr SpeedProfiles::kBucketSec;
+uint32_t constexpr SpeedProfiles::kBucketsPerDay;
+uint8_t constexpr SpeedProfiles::kUnknownSpeed;
+uint8_t constexpr SpeedProfiles::kMaxSpeedPercent;
+
+uint32_t SpeedProfiles::AddProfile(Profile const & profile)
+{
+  for (uint8_t const speed : profile)
+    CHECK_LESS_OR_EQUAL(speed, kMaxSpeedPercent, ());
+
+  auto const profileId = static_cast<uint32_t>(GetNumProfiles());
+  m_speeds.insert(m_speeds.end(), profile.cbegin(), profile.cend());
+  return profileId;
+}
+
+void SpeedProfiles::SetProfile(Segment const & segment, uint32_t profileId)
+{
+  CHECK_LESS(profileId, GetNumProfiles(), (segment));
+  m_segmentToProfile[GetKey(segment)] = profileId;
+}
+
+SpeedProfiles::Profile SpeedProfiles::GetProfile(uint32_t profileId) const
+{
+  CHECK_LESS(profileId, GetNumProfiles(), ());
+  Profile profile;
+  auto const begin = m_speeds.cbegin() + profileId * kBucketsPerDay;
+  std::copy(begin, begin + kBucketsPerDay, profile.begin());
+  return profile;
+}
+
+double SpeedProfiles::GetSpeedFactor(Segment const & segment, uint32_t timeOfDaySec) const
+{
+  auto const it = m_segmentToProfile.find(GetKey(segment));
+  if (it == m_segmentToProfile.cend())
+    return 1.0;
+
+  uint32_t const bucket = (timeOfDaySec / kBucketSec) % kBucketsPerDay;
+  uint8_t const speed = m_speeds[it->second * kBucketsPerDay + bucket];
+  if (speed == kUnknownSpeed)
+    return 1.0;
+
+  return static_cast<double>(speed) / kMaxSpeedPercent;
+}
+}  // namespace routing
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "routing/segment.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace routing
+{
+// SpeedProfiles keeps historical speeds of segments of an mwm. A profile is a speed for every
+// 15 minutes bucket of a day in percents of the speed of the road in the vehicle model.
+// Speeds are quantized to whole percents and segments with the same speeds share a profile,
+// so a speed lookup is two array accesses after a hash table lookup.
+class SpeedProfiles final
+{
+public:
+  static uint32_t constexpr kBucketSec = 15 * 60;
+  static uint32_t constexpr kBucketsPerDay = 24 * 60 * 60 / kBucketSec;
+  // Speed of a bucket without historical data.
+  static uint8_t constexpr kUnknownSpeed = 0;
+  // Historical speeds can't be greater than speeds of the vehicle model. Otherwise the astar
+  // heuristic which uses the max speed of the model is not admissible.
+  static uint8_t constexpr kMaxSpeedPercent = 100;
+
+  using Profile = std::array<uint8_t, kBucketsPerDay>;
+
+  // Returns id of the added profile. All speeds of |profile| should not be greater than
+  // kMaxSpeedPercent.
+  uint32_t AddProfile(Profile const & profile);
+  void SetProfile(Segment const & segment, uint32_t profileId);
+
+  bool IsEmpty() const { return m_segmentToProfile.empty(); }
+  size_t GetNumProfiles() const { return m_speeds.size() / kBucketsPerDay; }
+  size_t GetNumSegments() const { return m_segmentToProfile.size(); }
+  Profile GetProfile(uint32_t profileId) const;
+
+  // Returns a factor of the road speed on |segment| at |timeOfDaySec| seconds since midnight.
+  // The factor is in (0.0, 1.0]. It's 1.0 if there's no historical speed.
+  double GetSpeedFactor(Segment const & segment, uint32_t timeOfDaySec) const;
+
+  // Calls |fn| for each segment with a profile. The segments have kFakeNumMwmId.
+  template <typename Fn>
+  void ForEachSegment(Fn && fn) const
+  {
+    for (auto const & kv : m_segmentToProfile)
+      fn(kv.first, kv.second);
+  }
+
+private:
+  // Profiles are stored without numeric mwm ids, they are temporary and differ between sessions.
+  static Segment GetKey(Segment const & segment)
+  {
+    return Segment(kFakeNumMwmId, segment.GetFeatureId(), segment.GetSegmentIdx(),
+                   segment.IsForward());
+  }
+
+  // All profiles in a row, kBucketsPerDay speeds per profile.
+  std::vector<uint8_t> m_speeds;
+  std::unordered_map<Segment, uint32_t, Segment::Hash> m_segmentToProfile;
+};
+}  // namespace routing
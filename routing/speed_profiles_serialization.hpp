@@ -0,0 +1,114 @@
+#pragma once
+
+#include "routing/num_mwm_id.hpp"
+#include "routing/routing_exceptions.hpp"
+#include "routing/segment.hpp"
+#include "routing/speed_profiles.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/checked_cast.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace routing
+{
+// Section format:
+// uint16_t version;
+// varuint  number of profiles;
+// profiles: SpeedProfiles::kBucketsPerDay bytes each, speeds in percents of road speeds;
+// varuint  number of segments;
+// segments sorted by feature id: varuint feature id delta, varuint segment key, varuint profile id.
+// Segment key is (segment idx << 1) | forward.
+class SpeedProfilesSerializer final
+{
+public:
+  SpeedProfilesSerializer() = delete;
+
+  template <class Sink>
+  static void Serialize(SpeedProfiles const & profiles, Sink & sink)
+  {
+    uint16_t const version = kLatestVersion;
+    WriteToSink(sink, version);
+
+    auto const numProfiles = profiles.GetNumProfiles();
+    WriteVarUint(sink, static_cast<uint64_t>(numProfiles));
+    for (size_t i = 0; i < numProfiles; ++i)
+    {
+      SpeedProfiles::Profile const profile = profiles.GetProfile(static_cast<uint32_t>(i));
+      sink.Write(profile.data(), profile.size());
+    }
+
+    std::vector<std::pair<Segment, uint32_t>> segments;
+    segments.reserve(profiles.GetNumSegments());
+    profiles.ForEachSegment([&](Segment const & segment, uint32_t profileId) {
+      segments.emplace_back(segment, profileId);
+    });
+    std::sort(segments.begin(), segments.end());
+
+    WriteVarUint(sink, static_cast<uint64_t>(segments.size()));
+    uint32_t prevFeatureId = 0;
+    for (auto const & p : segments)
+    {
+      Segment const & segment = p.first;
+      WriteVarUint(sink, segment.GetFeatureId() - prevFeatureId);
+      WriteVarUint(sink, GetSegmentKey(segment));
+      WriteVarUint(sink, p.second);
+      prevFeatureId = segment.GetFeatureId();
+    }
+  }
+
+  template <class Source>
+  static void Deserialize(Source & src, SpeedProfiles & profiles)
+  {
+    auto const version = ReadPrimitiveFromSource<uint16_t>(src);
+    if (version != kLatestVersion)
+      MYTHROW(CorruptedDataException, ("Unknown speed profiles version", version));
+
+    auto const numProfiles = base::checked_cast<size_t>(ReadVarUint<uint64_t>(src));
+    SpeedProfiles::Profile profile;
+    for (size_t i = 0; i < numProfiles; ++i)
+    {
+      src.Read(profile.data(), profile.size());
+      for (uint8_t const speed : profile)
+      {
+        if (speed > SpeedProfiles::kMaxSpeedPercent)
+          MYTHROW(CorruptedDataException, ("Wrong speed", speed, "of profile", i));
+      }
+      profiles.AddProfile(profile);
+    }
+
+    auto const numSegments = base::checked_cast<size_t>(ReadVarUint<uint64_t>(src));
+    uint32_t featureId = 0;
+    for (size_t i = 0; i < numSegments; ++i)
+    {
+      featureId += ReadVarUint<uint32_t>(src);
+      Segment const segment = GetSegment(featureId, ReadVarUint<uint64_t>(src));
+      auto const profileId = ReadVarUint<uint32_t>(src);
+      if (profileId >= numProfiles)
+        MYTHROW(CorruptedDataException, ("Wrong profile id", profileId, "of", segment));
+
+      profiles.SetProfile(segment, profileId);
+    }
+  }
+
+private:
+  static uint16_t constexpr kLatestVersion = 0;
+
+  static uint64_t GetSegmentKey(Segment const & segment)
+  {
+    return (static_cast<uint64_t>(segment.GetSegmentIdx()) << 1) |
+           static_cast<uint64_t>(segment.IsForward() ? 1 : 0);
+  }
+
+  static Segment GetSegment(uint32_t featureId, uint64_t key)
+  {
+    return Segment(kFakeNumMwmId, featureId, base::checked_cast<uint32_t>(key >> 1), (key & 1) != 0);
+  }
+};
+}  // namespace routing
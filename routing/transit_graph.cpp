@@ -0,0 +1,365 @@
+#include "routing/transit_graph.hpp"
+
+#include "routing_common/transit_serdes.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+
+#include <algorithm>
+#include <map>
+
+using namespace routing::transit;
+using namespace std;
+
+namespace routing
+{
+// static
+TransitGraph::StopIdx constexpr TransitGraph::kInvalidStopIdx;
+uint32_t constexpr TransitGraph::kInvalidPatternIdx;
+
+void TransitGraph::Deserialize(Reader const & reader)
+{
+  NonOwningReaderSource src(reader);
+  Deserializer<NonOwningReaderSource> deserializer(src);
+
+  TransitHeader header;
+  header.Visit(deserializer);
+
+  vector<Stop> stops;
+  deserializer(stops);
+
+  // Sections which were generated before |m_edgesOffset| was filled have no gates, so edges
+  // follow stops.
+  uint64_t const edgesOffset = header.m_edgesOffset != 0 ? header.m_edgesOffset
+                                                         : header.m_gatesOffset;
+  if (src.Pos() > edgesOffset || edgesOffset > reader.Size())
+    MYTHROW(CorruptedDataException, ("Wrong edges offset:", edgesOffset, "stops end:", src.Pos()));
+  src.Skip(edgesOffset - src.Pos());
+
+  vector<transit::Edge> edges;
+  deserializer(edges);
+
+  Build(stops, edges);
+}
+
+void TransitGraph::Build(vector<Stop> const & stops, vector<transit::Edge> const & edges)
+{
+  m_stopIds.clear();
+  m_stopIds.reserve(stops.size());
+  for (auto const & stop : stops)
+    m_stopIds.push_back(stop.GetId());
+  sort(m_stopIds.begin(), m_stopIds.end());
+  m_stopIds.erase(unique(m_stopIds.begin(), m_stopIds.end()), m_stopIds.end());
+
+  m_patternOffsets.assign(1, 0);
+  m_patternStops.clear();
+  m_patternWeights.clear();
+  m_patternLines.clear();
+
+  vector<vector<Transfer>> transfers(m_stopIds.size());
+  map<LineId, vector<transit::Edge const *>> lineEdges;
+  for (auto const & edge : edges)
+  {
+    StopIdx const start = GetStopIdx(edge.GetStartStopId());
+    StopIdx const finish = GetStopIdx(edge.GetFinishStopId());
+    if (start == kInvalidStopIdx || finish == kInvalidStopIdx || start == finish)
+      continue;
+
+    if (edge.GetTransfer() || edge.GetLineId() == kInvalidLineId)
+    {
+      Transfer transfer;
+      transfer.m_target = finish;
+      transfer.m_weight = max(edge.GetWeight(), 0.0);
+      transfers[start].push_back(transfer);
+      continue;
+    }
+
+    lineEdges[edge.GetLineId()].push_back(&edge);
+  }
+
+  for (auto const & kv : lineEdges)
+    AddPatterns(kv.first, kv.second);
+
+  m_transferOffsets.assign(1, 0);
+  m_transfers.clear();
+  for (auto const & stopTransfers : transfers)
+  {
+    m_transfers.insert(m_transfers.end(), stopTransfers.begin(), stopTransfers.end());
+    m_transferOffsets.push_back(base::checked_cast<uint32_t>(m_transfers.size()));
+  }
+
+  vector<vector<pair<uint32_t, uint32_t>>> stopPatterns(m_stopIds.size());
+  for (uint32_t pattern = 0; pattern + 1 < m_patternOffsets.size(); ++pattern)
+  {
+    for (uint32_t i = m_patternOffsets[pattern]; i < m_patternOffsets[pattern + 1]; ++i)
+      stopPatterns[m_patternStops[i]].emplace_back(pattern, i - m_patternOffsets[pattern]);
+  }
+
+  m_stopPatternOffsets.assign(1, 0);
+  m_stopPatterns.clear();
+  for (auto const & patterns : stopPatterns)
+  {
+    m_stopPatterns.insert(m_stopPatterns.end(), patterns.begin(), patterns.end());
+    m_stopPatternOffsets.push_back(base::checked_cast<uint32_t>(m_stopPatterns.size()));
+  }
+}
+
+TransitGraph::StopIdx TransitGraph::GetStopIdx(StopId stopId) const
+{
+  auto const it = lower_bound(m_stopIds.cbegin(), m_stopIds.cend(), stopId);
+  if (it == m_stopIds.cend() || *it != stopId)
+    return kInvalidStopIdx;
+  return static_cast<StopIdx>(distance(m_stopIds.cbegin(), it));
+}
+
+void TransitGraph::FindJourneys(vector<Access> const & sources, vector<Access> const & targets,
+                                uint32_t maxRides, vector<Journey> & journeys) const
+{
+  journeys.clear();
+
+  size_t const stopsCount = m_stopIds.size();
+  vector<RoundLabels> rounds(1, RoundLabels(stopsCount));
+  // The best weight of stops over all rounds, a label which is not better is useless.
+  vector<double> best(stopsCount, numeric_limits<double>::max());
+  vector<bool> marked(stopsCount, false);
+  // Stops improved in the current round, patterns through them are scanned in the next one.
+  vector<StopIdx> markedStops;
+
+  auto const updateLabel = [&](Label const & label, StopIdx stop, vector<Label> & labels) {
+    if (label.m_weight >= best[stop])
+      return;
+
+    best[stop] = label.m_weight;
+    labels[stop] = label;
+    if (!marked[stop])
+    {
+      marked[stop] = true;
+      markedStops.push_back(stop);
+    }
+  };
+
+  // Transfers start from stops reached by rides or access legs of the round only.
+  auto const relaxTransfers = [&](uint32_t round) {
+    RoundLabels & labels = rounds.back();
+    size_t const ridesCount = markedStops.size();
+    for (size_t i = 0; i < ridesCount; ++i)
+    {
+      StopIdx const stop = markedStops[i];
+      for (uint32_t j = m_transferOffsets[stop]; j < m_transferOffsets[stop + 1]; ++j)
+      {
+        Label label;
+        label.m_weight = labels.m_rides[stop].m_weight + m_transfers[j].m_weight;
+        label.m_parent = stop;
+        label.m_round = round;
+        updateLabel(label, m_transfers[j].m_target, labels.m_transfers);
+      }
+    }
+  };
+
+  double bestJourneyWeight = numeric_limits<double>::max();
+  auto const addJourney = [&](uint32_t round) {
+    size_t bestTargetIdx = targets.size();
+    StopIdx bestTargetStop = kInvalidStopIdx;
+    for (size_t i = 0; i < targets.size(); ++i)
+    {
+      StopIdx const stop = GetStopIdx(targets[i].m_stopId);
+      if (stop == kInvalidStopIdx)
+        continue;
+
+      double const stopWeight = rounds.back().GetBest(stop).m_weight;
+      if (stopWeight == numeric_limits<double>::max())
+        continue;
+
+      if (stopWeight + targets[i].m_weight < bestJourneyWeight)
+      {
+        bestJourneyWeight = stopWeight + targets[i].m_weight;
+        bestTargetIdx = i;
+        bestTargetStop = stop;
+      }
+    }
+
+    if (bestTargetStop == kInvalidStopIdx)
+      return;
+
+    Journey journey;
+    journey.m_weight = bestJourneyWeight;
+    journey.m_targetIdx = bestTargetIdx;
+    ReconstructJourney(rounds, round, bestTargetStop, journey);
+    journeys.push_back(move(journey));
+  };
+
+  for (size_t i = 0; i < sources.size(); ++i)
+  {
+    StopIdx const stop = GetStopIdx(sources[i].m_stopId);
+    if (stop == kInvalidStopIdx)
+      continue;
+
+    Label label;
+    label.m_weight = sources[i].m_weight;
+    label.m_sourceIdx = i;
+    updateLabel(label, stop, rounds.back().m_rides);
+  }
+  relaxTransfers(0 /* round */);
+  addJourney(0 /* round */);
+
+  for (uint32_t round = 1; round <= maxRides && !markedStops.empty(); ++round)
+  {
+    // The first position of every pattern where a journey of the previous round may board it.
+    map<uint32_t, uint32_t> patternStarts;
+    for (StopIdx const stop : markedStops)
+    {
+      marked[stop] = false;
+      for (uint32_t i = m_stopPatternOffsets[stop]; i < m_stopPatternOffsets[stop + 1]; ++i)
+      {
+        auto const & patternPos = m_stopPatterns[i];
+        auto const it = patternStarts.emplace(patternPos.first, patternPos.second).first;
+        it->second = min(it->second, patternPos.second);
+      }
+    }
+    markedStops.clear();
+
+    rounds.push_back(rounds.back());
+    RoundLabels const & prev = rounds[round - 1];
+    RoundLabels & cur = rounds[round];
+
+    for (auto const & patternStart : patternStarts)
+    {
+      uint32_t const pattern = patternStart.first;
+      uint32_t const begin = m_patternOffsets[pattern];
+      uint32_t const end = m_patternOffsets[pattern + 1];
+
+      // The label the ride boards the pattern with and its weight reduced to the first stop
+      // of the pattern.
+      Label boardLabel;
+      double boardWeight = numeric_limits<double>::max();
+      for (uint32_t i = begin + patternStart.second; i < end; ++i)
+      {
+        StopIdx const stop = m_patternStops[i];
+        if (boardLabel.m_parent != kInvalidStopIdx)
+        {
+          Label label = boardLabel;
+          label.m_weight = boardWeight + m_patternWeights[i];
+          // Labels which can't improve the best journey are useless.
+          if (label.m_weight < bestJourneyWeight)
+            updateLabel(label, stop, cur.m_rides);
+        }
+
+        Label const & prevLabel = prev.GetBest(stop);
+        if (prevLabel.m_weight != numeric_limits<double>::max() &&
+            prevLabel.m_weight - m_patternWeights[i] < boardWeight)
+        {
+          boardWeight = prevLabel.m_weight - m_patternWeights[i];
+          boardLabel.m_parent = stop;
+          boardLabel.m_pattern = pattern;
+          boardLabel.m_round = round;
+          boardLabel.m_parentTransfer = &prevLabel == &prev.m_transfers[stop];
+        }
+      }
+    }
+
+    relaxTransfers(round);
+    addJourney(round);
+  }
+}
+
+void TransitGraph::AddPatterns(LineId lineId, vector<transit::Edge const *> const & edges)
+{
+  // Edges of the line are chained into patterns: a pattern starts at a stop the line doesn't
+  // come to if there is one, every edge belongs to one pattern exactly.
+  map<StopIdx, vector<size_t>> outgoing;
+  map<StopIdx, size_t> ingoingCount;
+  for (size_t i = 0; i < edges.size(); ++i)
+  {
+    outgoing[GetStopIdx(edges[i]->GetStartStopId())].push_back(i);
+    ++ingoingCount[GetStopIdx(edges[i]->GetFinishStopId())];
+  }
+
+  vector<bool> used(edges.size(), false);
+  size_t usedCount = 0;
+  auto const takeEdge = [&](StopIdx stop, size_t & edgeIdx) {
+    auto const it = outgoing.find(stop);
+    if (it == outgoing.end())
+      return false;
+
+    for (size_t const i : it->second)
+    {
+      if (!used[i])
+      {
+        used[i] = true;
+        ++usedCount;
+        edgeIdx = i;
+        return true;
+      }
+    }
+    return false;
+  };
+
+  while (usedCount < edges.size())
+  {
+    StopIdx start = kInvalidStopIdx;
+    for (auto const & kv : outgoing)
+    {
+      bool const hasUnused =
+          any_of(kv.second.cbegin(), kv.second.cend(), [&](size_t i) { return !used[i]; });
+      if (!hasUnused)
+        continue;
+
+      if (start == kInvalidStopIdx)
+        start = kv.first;
+      if (ingoingCount[kv.first] == 0)
+      {
+        start = kv.first;
+        break;
+      }
+    }
+    CHECK_NOT_EQUAL(start, kInvalidStopIdx, ());
+
+    m_patternStops.push_back(start);
+    m_patternWeights.push_back(0.0);
+
+    StopIdx stop = start;
+    size_t edgeIdx = 0;
+    while (takeEdge(stop, edgeIdx))
+    {
+      stop = GetStopIdx(edges[edgeIdx]->GetFinishStopId());
+      --ingoingCount[stop];
+      m_patternStops.push_back(stop);
+      m_patternWeights.push_back(m_patternWeights.back() + max(edges[edgeIdx]->GetWeight(), 0.0));
+    }
+
+    m_patternOffsets.push_back(base::checked_cast<uint32_t>(m_patternStops.size()));
+    m_patternLines.push_back(lineId);
+  }
+}
+
+void TransitGraph::ReconstructJourney(vector<RoundLabels> const & rounds, uint32_t round,
+                                      StopIdx stop, Journey & journey) const
+{
+  Label const * label = &rounds[round].GetBest(stop);
+  while (label->m_parent != kInvalidStopIdx)
+  {
+    bool const isRide = label->m_pattern != kInvalidPatternIdx;
+    // A ride boards the pattern with the best label of the previous round, a transfer starts
+    // from the label of a ride or an access leg of its round.
+    Label const & parent =
+        isRide ? (label->m_parentTransfer ? rounds[label->m_round - 1].m_transfers
+                                          : rounds[label->m_round - 1].m_rides)[label->m_parent]
+               : rounds[label->m_round].m_rides[label->m_parent];
+
+    Leg leg;
+    leg.m_from = m_stopIds[label->m_parent];
+    leg.m_to = m_stopIds[stop];
+    leg.m_lineId = isRide ? m_patternLines[label->m_pattern] : kInvalidLineId;
+    leg.m_weight = label->m_weight - parent.m_weight;
+    journey.m_legs.push_back(leg);
+    if (isRide)
+      ++journey.m_ridesCount;
+
+    stop = label->m_parent;
+    label = &parent;
+  }
+
+  journey.m_sourceIdx = label->m_sourceIdx;
+  reverse(journey.m_legs.begin(), journey.m_legs.end());
+}
+}  // namespace routing
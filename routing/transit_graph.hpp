@@ -0,0 +1,148 @@
+#pragma once
+
+#include "routing_common/transit_types.hpp"
+
+#include "coding/reader.hpp"
+
+#include "base/exception.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace routing
+{
+// Transit graph of an mwm in a flat layout for fast queries. Stops are sorted by id and are
+// referred to by their indexes. Rides of every line are split into patterns, i.e. chains of
+// stops a vehicle of the line goes through one by one, and stops and cumulative weights of all
+// patterns are kept in two plain arrays. Transfers between stops are grouped by the start stop.
+//
+// Journeys are found with the round based approach of RAPTOR: round k improves arrivals at stops
+// with journeys which board k patterns. Every pattern is scanned once per round
+// from its first improved stop, so a query doesn't need a priority queue. Weights of the section
+// are static, so a journey may board a pattern at any stop at no cost.
+class TransitGraph final
+{
+public:
+  DECLARE_EXCEPTION(CorruptedDataException, RootException);
+
+  using StopIdx = uint32_t;
+  static StopIdx constexpr kInvalidStopIdx = std::numeric_limits<StopIdx>::max();
+
+  // Access leg to a stop or egress leg from it, e.g. a pedestrian route between a stop and
+  // a route point calculated by IndexRouter.
+  struct Access
+  {
+    Access() = default;
+    Access(transit::StopId stopId, double weight) : m_stopId(stopId), m_weight(weight) {}
+
+    transit::StopId m_stopId = transit::kInvalidStopId;
+    double m_weight = 0.0;
+  };
+
+  struct Leg
+  {
+    transit::StopId m_from = transit::kInvalidStopId;
+    transit::StopId m_to = transit::kInvalidStopId;
+    // transit::kInvalidLineId for transfers.
+    transit::LineId m_lineId = transit::kInvalidLineId;
+    double m_weight = 0.0;
+  };
+
+  struct Journey
+  {
+    // Weight of the access leg, the transit legs and the egress leg.
+    double m_weight = 0.0;
+    size_t m_sourceIdx = 0;
+    size_t m_targetIdx = 0;
+    uint32_t m_ridesCount = 0;
+    std::vector<Leg> m_legs;
+  };
+
+  // Reads stops and edges of the transit section.
+  // @exception CorruptedDataException if the section is inconsistent.
+  void Deserialize(Reader const & reader);
+
+  // Edges which refer to unknown stops are skipped.
+  void Build(std::vector<transit::Stop> const & stops, std::vector<transit::Edge> const & edges);
+
+  size_t GetStopsCount() const { return m_stopIds.size(); }
+  size_t GetPatternsCount() const
+  {
+    return m_patternOffsets.empty() ? 0 : m_patternOffsets.size() - 1;
+  }
+  StopIdx GetStopIdx(transit::StopId stopId) const;
+
+  // Finds Pareto optimal journeys from |sources| to |targets| by weight and number of rides:
+  // every journey is better than the previous ones by weight and has more rides.
+  // Journeys which board more than |maxRides| patterns are not considered.
+  void FindJourneys(std::vector<Access> const & sources, std::vector<Access> const & targets,
+                    uint32_t maxRides, std::vector<Journey> & journeys) const;
+
+private:
+  static uint32_t constexpr kInvalidPatternIdx = std::numeric_limits<uint32_t>::max();
+
+  struct Transfer
+  {
+    StopIdx m_target = kInvalidStopIdx;
+    double m_weight = 0.0;
+  };
+
+  // How a stop is reached in a round.
+  struct Label
+  {
+    double m_weight = std::numeric_limits<double>::max();
+    // The previous stop of a ride or a transfer, kInvalidStopIdx for a stop reached by
+    // an access leg.
+    StopIdx m_parent = kInvalidStopIdx;
+    // Pattern of a ride, kInvalidPatternIdx for a transfer or an access leg.
+    uint32_t m_pattern = kInvalidPatternIdx;
+    uint32_t m_round = 0;
+    // True if a ride boards the pattern after a transfer to |m_parent|.
+    bool m_parentTransfer = false;
+    // Index of the access leg for a stop reached by one.
+    size_t m_sourceIdx = 0;
+  };
+
+  // Labels of stops after a round. Labels of transfers are kept apart from labels of rides and
+  // access legs, so a transfer doesn't change the label it starts from.
+  struct RoundLabels
+  {
+    explicit RoundLabels(size_t stopsCount) : m_rides(stopsCount), m_transfers(stopsCount) {}
+
+    Label const & GetBest(StopIdx stop) const
+    {
+      return m_transfers[stop].m_weight < m_rides[stop].m_weight ? m_transfers[stop]
+                                                                 : m_rides[stop];
+    }
+
+    std::vector<Label> m_rides;
+    std::vector<Label> m_transfers;
+  };
+
+  void AddPatterns(transit::LineId lineId, std::vector<transit::Edge const *> const & edges);
+  void ReconstructJourney(std::vector<RoundLabels> const & rounds, uint32_t round, StopIdx stop,
+                          Journey & journey) const;
+
+  // Sorted ids of stops.
+  std::vector<transit::StopId> m_stopIds;
+
+  // Stops of pattern i are m_patternStops[m_patternOffsets[i], m_patternOffsets[i + 1]),
+  // m_patternWeights keeps weights of the ride from the first stop of the pattern to them.
+  std::vector<uint32_t> m_patternOffsets;
+  std::vector<StopIdx> m_patternStops;
+  std::vector<double> m_patternWeights;
+  std::vector<transit::LineId> m_patternLines;
+
+  // Patterns through stop i and positions of the stop in them are
+  // m_stopPatterns[m_stopPatternOffsets[i], m_stopPatternOffsets[i + 1]).
+  std::vector<uint32_t> m_stopPatternOffsets;
+  std::vector<std::pair<uint32_t, uint32_t>> m_stopPatterns;
+
+  // Transfers from stop i are m_transfers[m_transferOffsets[i], m_transferOffsets[i + 1]).
+  std::vector<uint32_t> m_transferOffsets;
+  std::vector<Transfer> m_transfers;
+};
+}  // namespace routing
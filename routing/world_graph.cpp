@@ -12,6 +12,7 @@ string DebugPrint(WorldGraph::Mode mode)
   case WorldGraph::Mode::LeapsIfPossible: return "LeapsIfPossible";
   case WorldGraph::Mode::NoLeaps: return "NoLeaps";
   case WorldGraph::Mode::SingleMwm: return "SingleMwm";
+  case WorldGraph::Mode::Shortcuts: return "Shortcuts";
   }
   ASSERT(false, ("Unknown mode:", static_cast<size_t>(mode)));
   return "Unknown mode";
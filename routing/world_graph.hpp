@@ -5,6 +5,7 @@
 #include "routing/num_mwm_id.hpp"
 #include "routing/road_graph.hpp"
 #include "routing/segment.hpp"
+#include "routing/shortcut_overlay.hpp"
 
 #include "geometry/point2d.hpp"
 
@@ -36,6 +37,9 @@ public:
     NoLeaps,    // Mode for building route and getting outgoing/ingoing edges without leaps at all.
     SingleMwm,  // Mode for building route and getting outgoing/ingoing edges within mwm source
                 // segment belongs to.
+    Shortcuts,  // Mode for building route without leaps over shortcut overlays of mwms.
+                // Core segments of mwms with shortcut_overlay section are connected with
+                // shortcuts only, see ShortcutOverlay for details.
   };
 
   // |isEnding| == true iff |segment| is first or last segment of the route. Needed because first and
@@ -49,6 +53,8 @@ public:
 
   // Clear memory used by loaded graphs.
   virtual void ClearCachedGraphs() = 0;
+  // Returns time in seconds spent on loading of graphs, see IndexGraphLoader::GetLoadingTimeSec.
+  virtual double GetGraphLoadingTimeSec() const = 0;
   virtual void SetMode(Mode mode) = 0;
   virtual Mode GetMode() const = 0;
 
@@ -61,6 +67,10 @@ public:
   virtual RouteWeight CalcSegmentWeight(Segment const & segment) = 0;
   virtual RouteWeight CalcLeapWeight(m2::PointD const & from, m2::PointD const & to) const = 0;
   virtual bool LeapIsAllowed(NumMwmId mwmId) const = 0;
+
+  // Returns shortcut overlay of the mwm. The overlay is empty if the mwm has no
+  // shortcut_overlay section.
+  virtual ShortcutOverlay const & GetShortcutOverlay(NumMwmId mwmId) = 0;
 };
 
 std::string DebugPrint(WorldGraph::Mode mode);
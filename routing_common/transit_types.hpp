@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <limits>
 #include <string>
+#include <vector>
 
 namespace routing
 {
@@ -67,6 +68,12 @@ public:
        m2::PointD const & point);
   bool IsEqualForTesting(Stop const & stop) const;
 
+  StopId GetId() const { return m_id; }
+  FeatureId GetFeatureId() const { return m_featureId; }
+  TransferId GetTransferId() const { return m_transferId; }
+  std::vector<LineId> const & GetLineIds() const { return m_lineIds; }
+  m2::PointD const & GetPoint() const { return m_point; }
+
   DECLARE_VISITOR_AND_DEBUG_PRINT(Stop, visitor(m_id, "id"), visitor(m_featureId, "osm_id"),
                                   visitor(m_transferId, "transfer_id"),
                                   visitor(m_lineIds, "line_ids"), visitor(m_point, "point"))
@@ -90,6 +97,13 @@ public:
 
   bool IsEqualForTesting(Edge const & edge) const;
 
+  StopId GetStartStopId() const { return m_startStopId; }
+  StopId GetFinishStopId() const { return m_finishStopId; }
+  double GetWeight() const { return m_weight; }
+  LineId GetLineId() const { return m_lineId; }
+  bool GetTransfer() const { return m_transfer; }
+  std::vector<ShapeId> const & GetShapeIds() const { return m_shapeIds; }
+
   DECLARE_VISITOR_AND_DEBUG_PRINT(Edge, visitor(m_startStopId, "start_stop_id"),
                                   visitor(m_finishStopId, "finish_stop_id"),
                                   visitor(m_weight, "weight"), visitor(m_lineId, "line_id"),
@@ -7,11 +7,15 @@
 #include "base/macros.hpp"
 
 #include <algorithm>
+#include <limits>
 
 using namespace std;
 
 namespace routing
 {
+// static
+uint32_t constexpr VehicleModel::kTwoLevelTypesCount;
+
 VehicleModel::AdditionalRoadType::AdditionalRoadType(Classificator const & c,
                                                      AdditionalRoadTags const & tag)
   : m_type(c.GetTypeByPath(tag.m_hwtag)), m_speedKMpH(tag.m_speedKMpH)
@@ -26,13 +30,23 @@ VehicleModel::RoadLimits::RoadLimits(double speedKMpH, bool isTransitAllowed)
 
 VehicleModel::VehicleModel(Classificator const & c, InitListT const & featureTypeLimits)
   : m_maxSpeedKMpH(0),
+    m_typeToLimits(kTwoLevelTypesCount, 0),
     m_onewayType(c.GetTypeByPath({ "hwtag", "oneway" }))
 {
+  m_limits.reserve(featureTypeLimits.size());
   for (auto const & v : featureTypeLimits)
   {
     m_maxSpeedKMpH = max(m_maxSpeedKMpH, v.m_speedKMpH);
-    m_types.emplace(c.GetTypeByPath(vector<string>(v.m_types, v.m_types + 2)),
-                    RoadLimits(v.m_speedKMpH, v.m_isTransitAllowed));
+
+    uint32_t const type = c.GetTypeByPath(vector<string>(v.m_types, v.m_types + 2));
+    CHECK_LESS(type, m_typeToLimits.size(), (v.m_types[0], v.m_types[1]));
+    // Only the first limits of a type are used.
+    if (m_typeToLimits[type] != 0)
+      continue;
+
+    m_limits.emplace_back(v.m_speedKMpH, v.m_isTransitAllowed);
+    CHECK_LESS_OR_EQUAL(m_limits.size(), numeric_limits<uint8_t>::max(), ());
+    m_typeToLimits[type] = static_cast<uint8_t>(m_limits.size());
   }
 }
 
@@ -64,10 +78,9 @@ double VehicleModel::GetMinTypeSpeed(feature::TypesHolder const & types) const
   double speed = m_maxSpeedKMpH * 2;
   for (uint32_t t : types)
   {
-    uint32_t const type = ftypes::BaseChecker::PrepareToMatch(t, 2);
-    auto it = m_types.find(type);
-    if (it != m_types.end())
-      speed = min(speed, it->second.GetSpeedKMpH());
+    RoadLimits const * limits = FindRoadLimits(t);
+    if (limits)
+      speed = min(speed, limits->GetSpeedKMpH());
 
     auto const addRoadInfoIter = FindRoadType(t);
     if (addRoadInfoIter != m_addRoadTypes.cend())
@@ -121,9 +134,8 @@ bool VehicleModel::HasTransitType(feature::TypesHolder const & types) const
 {
   for (uint32_t t : types)
   {
-    uint32_t const type = ftypes::BaseChecker::PrepareToMatch(t, 2);
-    auto it = m_types.find(type);
-    if (it != m_types.end() && it->second.IsTransitAllowed())
+    RoadLimits const * limits = FindRoadLimits(t);
+    if (limits && limits->IsTransitAllowed())
       return true;
   }
 
@@ -132,8 +144,20 @@ bool VehicleModel::HasTransitType(feature::TypesHolder const & types) const
 
 bool VehicleModel::IsRoadType(uint32_t type) const
 {
-  return FindRoadType(type) != m_addRoadTypes.cend() ||
-         m_types.find(ftypes::BaseChecker::PrepareToMatch(type, 2)) != m_types.end();
+  return FindRoadLimits(type) != nullptr || FindRoadType(type) != m_addRoadTypes.cend();
+}
+
+bool VehicleModel::EqualsForTests(VehicleModel const & rhs) const
+{
+  for (uint32_t type = 0; type < kTwoLevelTypesCount; ++type)
+  {
+    RoadLimits const * limits = FindRoadLimits(type);
+    RoadLimits const * rhsLimits = rhs.FindRoadLimits(type);
+    if ((limits == nullptr) != (rhsLimits == nullptr) || (limits && !(*limits == *rhsLimits)))
+      return false;
+  }
+
+  return (m_addRoadTypes == rhs.m_addRoadTypes) && (m_onewayType == rhs.m_onewayType);
 }
 
 VehicleModelInterface::RoadAvailability VehicleModel::GetRoadAvailability(feature::TypesHolder const & /* types */) const
@@ -141,6 +165,14 @@ VehicleModelInterface::RoadAvailability VehicleModel::GetRoadAvailability(featur
   return RoadAvailability::Unknown;
 }
 
+VehicleModel::RoadLimits const * VehicleModel::FindRoadLimits(uint32_t type) const
+{
+  type = ftypes::BaseChecker::PrepareToMatch(type, 2);
+  if (type >= m_typeToLimits.size() || m_typeToLimits[type] == 0)
+    return nullptr;
+  return &m_limits[m_typeToLimits[type] - 1];
+}
+
 vector<VehicleModel::AdditionalRoadType>::const_iterator VehicleModel::FindRoadType(
     uint32_t type) const
 {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <initializer_list>
 #include <memory>
 #include <sstream>
@@ -105,12 +107,7 @@ public:
     return false;
   }
 
-  bool EqualsForTests(VehicleModel const & rhs) const
-  {
-    return (m_types == rhs.m_types) &&
-           (m_addRoadTypes == rhs.m_addRoadTypes) &&
-           (m_onewayType == rhs.m_onewayType);
-  }
+  bool EqualsForTests(VehicleModel const & rhs) const;
 
 protected:
   /// @returns a special restriction which is set to the feature.
@@ -163,7 +160,16 @@ private:
 
   std::vector<AdditionalRoadType>::const_iterator FindRoadType(uint32_t type) const;
 
-  std::unordered_map<uint32_t, RoadLimits> m_types;
+  /// @returns limits of |type| truncated to two levels or nullptr if it's not a road type.
+  RoadLimits const * FindRoadLimits(uint32_t type) const;
+
+  // Limits are looked up for every type of every road feature, so instead of a hash map
+  // a dense table indexed by the type truncated to two levels is used. Such types are less
+  // than 2^15 since a level takes 7 bits. m_typeToLimits[type] is 0 if |type| is not
+  // a road type and an index in m_limits plus one otherwise.
+  static uint32_t constexpr kTwoLevelTypesCount = 1 << 15;
+  std::vector<uint8_t> m_typeToLimits;
+  std::vector<RoadLimits> m_limits;
 
   std::vector<AdditionalRoadType> m_addRoadTypes;
   uint32_t m_onewayType;
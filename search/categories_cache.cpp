@@ -1,5 +1,7 @@
 #include "search/categories_cache.hpp"
 
+#include "search/category_bitmaps_table.hpp"
+#include "search/localities_source.hpp"
 #include "search/mwm_context.hpp"
 #include "search/query_params.hpp"
 #include "search/retrieval.hpp"
@@ -11,6 +13,7 @@
 #include "base/assert.hpp"
 #include "base/levenshtein_dfa.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/vector.hpp"
 
 namespace search
@@ -42,14 +45,34 @@ CBV CategoriesCache::Load(MwmContext const & context) const
   // but the interface of Retrieval forces us to make a choice.
   SearchTrieRequest<strings::UniStringDFA> request;
 
-  m_categories.ForEach([&request, &c](uint32_t const type) {
+  vector<uint32_t> types;
+  m_categories.ForEach([&request, &types, &c](uint32_t const type) {
     request.m_categories.emplace_back(FeatureTypeToString(c.GetIndexForType(type)));
+    types.push_back(type);
   });
 
   Retrieval retrieval(context, m_cancellable);
+
+  // Precomputed features are used only when all the types are precomputed, otherwise
+  // the trie is traversed anyway.
+  auto const table = CategoryBitmapsTable::Load(context.m_value);
+  if (table && all_of(types.begin(), types.end(),
+                      [&table](uint32_t type) { return table->HasType(type); }))
+  {
+    return CBV(retrieval.RetrieveCategoryFeatures(*table, types, request));
+  }
+
   return CBV(retrieval.RetrieveAddressFeatures(request));
 }
 
+void ForEachPrecomputedCategoryType(function<void(uint32_t)> const & fn)
+{
+  ftypes::IsStreetChecker::Instance().ForEachType(fn);
+  ftypes::IsVillageChecker::Instance().ForEachType(fn);
+  ftypes::IsHotelChecker::Instance().ForEachType(fn);
+  LocalitiesSource().ForEachType(fn);
+}
+
 // StreetsCache ------------------------------------------------------------------------------------
 StreetsCache::StreetsCache(my::Cancellable const & cancellable)
   : CategoriesCache(ftypes::IsStreetChecker::Instance(), cancellable)
@@ -7,6 +7,7 @@
 
 #include "base/cancellable.hpp"
 
+#include "std/function.hpp"
 #include "std/map.hpp"
 #include "std/set.hpp"
 
@@ -14,6 +15,10 @@ namespace search
 {
 class MwmContext;
 
+// Calls |fn| for types of StreetsCache, VillagesCache, HotelsCache and localities. Features of
+// these categories are precomputed by the generator, see CategoryBitmapsTable.
+void ForEachPrecomputedCategoryType(function<void(uint32_t)> const & fn);
+
 class CategoriesCache
 {
 public:
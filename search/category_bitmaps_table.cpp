@@ -0,0 +1,81 @@
+#include "search/category_bitmaps_table.hpp"
+
+#include "indexer/index.hpp"
+
+#include "base/logging.hpp"
+
+#include "defines.hpp"
+
+using namespace std;
+
+namespace search
+{
+// static
+uint16_t constexpr CategoryBitmapsTable::kLatestVersion;
+
+// static
+unique_ptr<CategoryBitmapsTable> CategoryBitmapsTable::Load(MwmValue const & value)
+{
+  if (!value.m_cont.IsExist(SEARCH_CATEGORY_BITMAPS_FILE_TAG))
+    return nullptr;
+
+  unique_ptr<CategoryBitmapsTable> table(new CategoryBitmapsTable());
+  try
+  {
+    auto const reader = value.m_cont.GetReader(SEARCH_CATEGORY_BITMAPS_FILE_TAG);
+    if (!table->Deserialize(*reader.GetPtr()))
+    {
+      LOG(LWARNING, ("Unknown version of category bitmaps table."));
+      return nullptr;
+    }
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LERROR, ("Can't read category bitmaps table:", e.Msg()));
+    return nullptr;
+  }
+  return table;
+}
+
+bool CategoryBitmapsTable::Deserialize(Reader const & reader)
+{
+  NonOwningReaderSource src(reader);
+  auto const version = ReadPrimitiveFromSource<uint16_t>(src);
+  if (version != kLatestVersion)
+    return false;
+
+  auto const numCategories = base::checked_cast<size_t>(ReadVarUint<uint64_t>(src));
+
+  m_types.clear();
+  m_types.reserve(numCategories);
+  m_offsets.clear();
+  m_offsets.reserve(numCategories + 1);
+
+  vector<uint64_t> sizes;
+  sizes.reserve(numCategories);
+  for (size_t i = 0; i < numCategories; ++i)
+  {
+    m_types.push_back(ReadVarUint<uint32_t>(src));
+    sizes.push_back(ReadVarUint<uint64_t>(src));
+  }
+
+  uint64_t offset = src.Pos();
+  for (auto const size : sizes)
+  {
+    m_offsets.push_back(offset);
+    offset += size;
+  }
+  m_offsets.push_back(offset);
+
+  if (offset > reader.Size() || !is_sorted(m_types.begin(), m_types.end()))
+    MYTHROW(Reader::SizeException, ("Inconsistent category bitmaps table."));
+
+  m_reader = reader.CreateSubReader(0, reader.Size());
+  return true;
+}
+
+bool CategoryBitmapsTable::HasType(uint32_t type) const
+{
+  return binary_search(m_types.begin(), m_types.end(), type);
+}
+}  // namespace search
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "coding/compressed_bit_vector.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+class MwmValue;
+
+namespace search
+{
+// Precomputed features of the categories which are retrieved for every query or mwm, see
+// ForEachPrecomputedCategoryType(). A bit vector of a category holds the same features as
+// the search index gives for the category key, so CategoriesCache doesn't traverse the trie
+// when the section is present.
+//
+// Section format:
+// uint16_t version;
+// varuint  number of categories;
+// categories sorted by type: varuint type, varuint size of the bit vector in bytes;
+// serialized bit vectors of the categories in the same order.
+//
+// Only the directory is read on loading, bit vectors are read from the section on demand.
+class CategoryBitmapsTable
+{
+public:
+  class Builder
+  {
+  public:
+    // Features of a type may be added in any order and more than once.
+    void Add(uint32_t type, uint32_t featureId) { m_features[type].push_back(featureId); }
+
+    // Types without features are written too, so the table knows that they are empty.
+    void AddType(uint32_t type) { m_features[type]; }
+
+    size_t GetNumCategories() const { return m_features.size(); }
+
+    template <typename Sink>
+    void Serialize(Sink & sink)
+    {
+      std::vector<std::vector<uint8_t>> bitmaps;
+      bitmaps.reserve(m_features.size());
+      for (auto & kv : m_features)
+      {
+        auto & features = kv.second;
+        std::sort(features.begin(), features.end());
+        features.erase(std::unique(features.begin(), features.end()), features.end());
+
+        bitmaps.emplace_back();
+        MemWriter<std::vector<uint8_t>> writer(bitmaps.back());
+        coding::CompressedBitVectorBuilder::FromBitPositions(features)->Serialize(writer);
+      }
+
+      uint16_t const version = kLatestVersion;
+      WriteToSink(sink, version);
+      WriteVarUint(sink, static_cast<uint64_t>(m_features.size()));
+
+      size_t i = 0;
+      for (auto const & kv : m_features)
+      {
+        WriteVarUint(sink, kv.first);
+        WriteVarUint(sink, static_cast<uint64_t>(bitmaps[i].size()));
+        ++i;
+      }
+
+      for (auto const & bitmap : bitmaps)
+        sink.Write(bitmap.data(), bitmap.size());
+    }
+
+  private:
+    std::map<uint32_t, std::vector<uint64_t>> m_features;
+  };
+
+  // Returns nullptr if there is no table in the mwm or it can't be read.
+  static std::unique_ptr<CategoryBitmapsTable> Load(MwmValue const & value);
+
+  // Reads the directory of the table, bit vectors are read from a copy of |reader| later.
+  // Returns false if the version of the table is unknown.
+  bool Deserialize(Reader const & reader);
+
+  bool HasType(uint32_t type) const;
+
+  // Calls |fn| for all features of |type| in increasing order of ids. The table must have |type|.
+  template <typename Fn>
+  void ForEachFeature(uint32_t type, Fn && fn) const
+  {
+    auto const it = std::lower_bound(m_types.begin(), m_types.end(), type);
+    ASSERT(it != m_types.end() && *it == type, (type));
+
+    auto const i = std::distance(m_types.begin(), it);
+    auto const reader = m_reader->CreateSubReader(m_offsets[i], m_offsets[i + 1] - m_offsets[i]);
+    NonOwningReaderSource src(*reader);
+    auto const cbv = coding::CompressedBitVectorBuilder::DeserializeFromSource(src);
+    coding::CompressedBitVectorEnumerator::ForEach(*cbv, fn);
+  }
+
+  size_t GetNumCategories() const { return m_types.size(); }
+
+private:
+  static uint16_t constexpr kLatestVersion = 0;
+
+  std::unique_ptr<Reader> m_reader;
+
+  // Sorted types, the bit vector of |m_types[i]| is [m_offsets[i], m_offsets[i + 1]) of
+  // |m_reader|.
+  std::vector<uint32_t> m_types;
+  std::vector<uint64_t> m_offsets;
+};
+}  // namespace search
@@ -0,0 +1,72 @@
+#include "search/downloader_name_index.hpp"
+
+#include "indexer/search_string_utils.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+#include "base/stl_helpers.hpp"
+
+#include <algorithm>
+#include <set>
+
+namespace search
+{
+void DownloaderNameIndex::Add(storage::TCountryId const & countryId, std::string const & name)
+{
+  Entry entry;
+  entry.m_countryId = countryId;
+  entry.m_name = name;
+  NormalizeAndTokenizeString(name, entry.m_tokens);
+  if (entry.m_tokens.empty())
+    return;
+
+  auto const index = base::checked_cast<uint32_t>(m_entries.size());
+  for (auto const & token : entry.m_tokens)
+    m_tokens.emplace_back(token, index);
+  m_entries.push_back(std::move(entry));
+}
+
+void DownloaderNameIndex::Build() { my::SortUnique(m_tokens); }
+
+void DownloaderNameIndex::Search(std::string const & query,
+                                 std::vector<storage::DownloaderSearchResult> & results) const
+{
+  ASSERT(std::is_sorted(m_tokens.begin(), m_tokens.end()), ("Build() wasn't called."));
+
+  std::vector<strings::UniString> queryTokens;
+  NormalizeAndTokenizeString(query, queryTokens);
+  if (queryTokens.empty())
+    return;
+
+  // Candidates are found by the longest token, which is the most selective one.
+  auto const & longest = *std::max_element(
+      queryTokens.begin(), queryTokens.end(),
+      [](strings::UniString const & lhs, strings::UniString const & rhs) {
+        return lhs.size() < rhs.size();
+      });
+
+  std::vector<uint32_t> candidates;
+  auto it = std::lower_bound(m_tokens.begin(), m_tokens.end(),
+                             std::make_pair(longest, static_cast<uint32_t>(0)));
+  for (; it != m_tokens.end() && strings::StartsWith(it->first, longest); ++it)
+    candidates.push_back(it->second);
+  my::SortUnique(candidates);
+
+  auto const hasPrefix = [](Entry const & entry, strings::UniString const & prefix) {
+    return std::any_of(
+        entry.m_tokens.begin(), entry.m_tokens.end(),
+        [&prefix](strings::UniString const & token) { return strings::StartsWith(token, prefix); });
+  };
+
+  std::set<storage::TCountryId> found;
+  for (auto const index : candidates)
+  {
+    Entry const & entry = m_entries[index];
+    bool const matches = std::all_of(
+        queryTokens.begin(), queryTokens.end(),
+        [&](strings::UniString const & prefix) { return hasPrefix(entry, prefix); });
+    if (matches && found.insert(entry.m_countryId).second)
+      results.emplace_back(entry.m_countryId, entry.m_name /* m_matchedName */);
+  }
+}
+}  // namespace search
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "storage/downloader_search_params.hpp"
+#include "storage/index.hpp"
+
+#include "base/string_utils.hpp"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace search
+{
+// A prefix index over localized names of nodes of the country tree. It's built once per
+// locale and finds nodes for downloader queries without mwms: a name matches a query when
+// every token of the query is a prefix of some token of the name.
+//
+// *NOTE* the class is NOT thread safe.
+class DownloaderNameIndex
+{
+public:
+  DownloaderNameIndex() = default;
+  explicit DownloaderNameIndex(std::string const & locale) : m_locale(locale) {}
+
+  std::string const & GetLocale() const { return m_locale; }
+
+  // Adds a localized |name| of |countryId|. Build() must be called after all names are added.
+  void Add(storage::TCountryId const & countryId, std::string const & name);
+  void Build();
+
+  // Appends results for |query| to |results| in the order names were added, a country is
+  // found at most once.
+  void Search(std::string const & query,
+              std::vector<storage::DownloaderSearchResult> & results) const;
+
+private:
+  struct Entry
+  {
+    storage::TCountryId m_countryId;
+    std::string m_name;
+    std::vector<strings::UniString> m_tokens;
+  };
+
+  std::string m_locale;
+  std::vector<Entry> m_entries;
+  // Tokens of names and indices of their entries, sorted by tokens.
+  std::vector<std::pair<strings::UniString, uint32_t>> m_tokens;
+};
+}  // namespace search
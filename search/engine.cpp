@@ -1,7 +1,9 @@
 #include "search/engine.hpp"
 
+#include "search/geometry_cache.hpp"
 #include "search/geometry_utils.hpp"
 #include "search/processor.hpp"
+#include "search/ranking_model.hpp"
 #include "search/search_params.hpp"
 
 #include "storage/country_info_getter.hpp"
@@ -19,16 +21,21 @@
 #include "base/logging.hpp"
 #include "base/scope_guard.hpp"
 #include "base/stl_add.hpp"
+#include "base/timer.hpp"
 
 #include "std/algorithm.hpp"
 #include "std/bind.hpp"
 #include "std/map.hpp"
+#include "std/shared_ptr.hpp"
 #include "std/vector.hpp"
 
 namespace search
 {
 namespace
 {
+// Max size of the cache of features in rects shared by all processors.
+uint64_t constexpr kSharedGeometryCacheBytes = 32 * 1024 * 1024;
+
 class InitSuggestions
 {
   using TSuggestMap = map<pair<strings::UniString, int8_t>, uint8_t>;
@@ -82,10 +89,10 @@ void ProcessorHandle::Detach()
 }
 
 // Engine::Params ----------------------------------------------------------------------------------
-Engine::Params::Params() : m_locale("en"), m_numThreads(1) {}
+Engine::Params::Params() : m_locale("en"), m_numThreads(1), m_numGeocoderThreads(1) {}
 
 Engine::Params::Params(string const & locale, size_t numThreads)
-  : m_locale(locale), m_numThreads(numThreads)
+  : m_locale(locale), m_numThreads(numThreads), m_numGeocoderThreads(1)
 {
 }
 
@@ -99,11 +106,27 @@ Engine::Engine(Index & index, CategoriesHolder const & categories,
   categories.ForEachName(bind<void>(ref(doInit), _1));
   doInit.GetSuggests(m_suggests);
 
+  m_geometryCache = make_shared<SharedGeometryCache>(kSharedGeometryCacheBytes);
+
+  shared_ptr<RankingModel const> rankingModel;
+  if (!params.m_rankingModelPath.empty())
+  {
+    auto model = make_shared<RankingModel>();
+    if (model->Load(params.m_rankingModelPath))
+    {
+      LOG(LINFO, ("Ranking model", params.m_rankingModelPath, "of", model->GetNumTrees(), "trees"));
+      rankingModel = model;
+    }
+  }
+
   m_contexts.resize(params.m_numThreads);
   for (size_t i = 0; i < params.m_numThreads; ++i)
   {
     auto processor = factory->Build(index, categories, m_suggests, infoGetter);
     processor->SetPreferredLocale(params.m_locale);
+    processor->SetNumGeocoderThreads(params.m_numGeocoderThreads);
+    processor->SetRankingModel(rankingModel);
+    processor->SetSharedGeometryCache(m_geometryCache);
     m_contexts[i].m_processor = move(processor);
   }
 
@@ -144,12 +167,27 @@ void Engine::SetLocale(string const & locale)
 
 void Engine::ClearCaches()
 {
+  InvalidateGeometryCache();
   PostMessage(Message::TYPE_BROADCAST, [this](Processor & processor)
               {
                 processor.ClearCaches();
               });
 }
 
+void Engine::InvalidateGeometryCache() { m_geometryCache->Clear(); }
+
+StageHistograms Engine::GetStageHistograms() const
+{
+  lock_guard<mutex> lock(m_stageHistogramsMu);
+  return m_stageHistograms;
+}
+
+void Engine::ResetStageHistograms()
+{
+  lock_guard<mutex> lock(m_stageHistogramsMu);
+  m_stageHistograms = StageHistograms();
+}
+
 void Engine::MainLoop(Context & context)
 {
   while (true)
@@ -229,6 +267,14 @@ void Engine::DoSearch(SearchParams const & params, m2::RectD const & viewport,
                    handle->Detach();
                  });
 
+  my::Timer timer;
   processor.Search(params, viewport);
+  double const elapsedSec = timer.ElapsedSeconds();
+
+  if (!processor.IsCancelled())
+  {
+    lock_guard<mutex> lock(m_stageHistogramsMu);
+    m_stageHistograms.Add(processor.GetStageTimes(), elapsedSec);
+  }
 }
 }  // namespace search
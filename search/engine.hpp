@@ -3,6 +3,7 @@
 #include "search/processor_factory.hpp"
 #include "search/result.hpp"
 #include "search/search_params.hpp"
+#include "search/search_stats.hpp"
 #include "search/suggest.hpp"
 
 #include "indexer/categories_holder.hpp"
@@ -20,6 +21,7 @@
 #include "std/function.hpp"
 #include "std/mutex.hpp"
 #include "std/queue.hpp"
+#include "std/shared_ptr.hpp"
 #include "std/string.hpp"
 #include "std/unique_ptr.hpp"
 #include "std/vector.hpp"
@@ -36,6 +38,7 @@ namespace search
 {
 class EngineData;
 class Processor;
+class SharedGeometryCache;
 
 // This class is used as a reference to a search processor in the
 // SearchEngine's queue.  It's only possible to cancel a search
@@ -89,6 +92,17 @@ public:
     // to process queries. Use this field wisely as large values may
     // negatively affect performance due to false sharing.
     size_t m_numThreads;
+
+    // This field controls number of threads every query processor uses
+    // to geocode a single query over mwms. It's useful for "everywhere"
+    // searches on servers, where queries touch many mwms.
+    size_t m_numGeocoderThreads;
+
+    // Path to a file of RankingModel which ranks results instead of
+    // the linear model. The model is loaded once and is shared by all
+    // query processors. Empty path or a malformed file means the
+    // linear model.
+    string m_rankingModelPath;
   };
 
   // Doesn't take ownership of index and categories.
@@ -103,9 +117,20 @@ public:
   // Sets default locale on all query processors.
   void SetLocale(string const & locale);
 
-  // Posts request to clear caches to the queue.
+  // Posts request to clear caches to the queue. The geometry cache
+  // shared by all processors is invalidated immediately.
   void ClearCaches();
 
+  // Invalidates the cache of features in rects which is shared by all
+  // query processors. Must be called when map edits are changed, as
+  // retrieved rects include edited features.
+  void InvalidateGeometryCache();
+
+  // Returns histograms of times of stages of all completed and not
+  // cancelled queries since the start or the last reset.
+  StageHistograms GetStageHistograms() const;
+  void ResetStageHistograms();
+
 private:
   struct Message
   {
@@ -156,6 +181,11 @@ private:
 
   vector<Suggest> m_suggests;
 
+  shared_ptr<SharedGeometryCache> m_geometryCache;
+
+  StageHistograms m_stageHistograms;
+  mutable mutex m_stageHistogramsMu;
+
   bool m_shutdown;
   mutex m_mu;
   condition_variable m_cv;
@@ -12,6 +12,16 @@ EverywhereSearchCallback::EverywhereSearchCallback(Delegate & delegate, OnResult
 
 void EverywhereSearchCallback::operator()(Results const & results)
 {
+  // New suggests are inserted after the previous ones, other results are appended.
+  auto const suggestsCount = results.GetSuggestsCount();
+  ASSERT_LESS_OR_EQUAL(m_suggestsCount, suggestsCount, ());
+  for (size_t i = m_suggestsCount; i < suggestsCount; ++i)
+  {
+    m_isLocalAdsCustomer.insert(m_isLocalAdsCustomer.begin() + i,
+                                m_delegate.IsLocalAdsCustomer(results[i]));
+  }
+  m_suggestsCount = suggestsCount;
+
   auto const prevSize = m_isLocalAdsCustomer.size();
   ASSERT_LESS_OR_EQUAL(prevSize, results.GetCount(), ());
 
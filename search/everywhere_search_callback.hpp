@@ -3,6 +3,7 @@
 #include "search/everywhere_search_params.hpp"
 #include "search/result.hpp"
 
+#include <cstddef>
 #include <vector>
 
 namespace search
@@ -32,5 +33,6 @@ private:
   Delegate & m_delegate;
   OnResults m_onResults;
   std::vector<bool> m_isLocalAdsCustomer;
+  size_t m_suggestsCount = 0;
 };
 }  // namespace search
@@ -12,6 +12,10 @@ namespace search
 {
 struct EverywhereSearchParams
 {
+  // Results are sent progressively: every call passes all the results found so far, so the UI
+  // may patch its list instead of rebuilding it. Suggests always go first and new suggests
+  // are inserted after the previous ones, feature results keep their order and new ones are
+  // appended. |isLocalAdsCustomer| is parallel to |results|.
   using OnResults =
       function<void(Results const & results, vector<bool> const & isLocalAdsCustomer)>;
 
@@ -1,6 +1,8 @@
 #include "search/feature_loader.hpp"
 
+#include "indexer/feature_algo.hpp"
 #include "indexer/feature_decl.hpp"
+#include "indexer/osm_editor.hpp"
 
 #include "base/stl_add.hpp"
 
@@ -12,15 +14,53 @@ bool FeatureLoader::Load(FeatureID const & id, FeatureType & ft)
 {
   ASSERT(m_checker.CalledOnOriginalThread(), ());
 
-  auto const & mwmId = id.m_mwmId;
-  if (!m_guard || m_guard->GetId() != mwmId)
-    m_guard = my::make_unique<Index::FeaturesLoaderGuard>(m_index, mwmId);
+  SetMwm(id.m_mwmId);
   return m_guard->GetFeatureByIndex(id.m_index, ft);
 }
 
+bool FeatureLoader::Load(FeatureID const & id, FeatureType & ft, m2::PointD & center)
+{
+  if (!Load(id, ft))
+    return false;
+
+  if (osm::Editor::Instance().GetFeatureStatus(id) != osm::Editor::FeatureStatus::Untouched ||
+      !m_centers || !m_centers->Get(id.m_index, center))
+  {
+    center = feature::GetCenter(ft);
+  }
+  return true;
+}
+
+bool FeatureLoader::IsWorld() const
+{
+  ASSERT(m_checker.CalledOnOriginalThread(), ());
+  return m_guard && m_guard->IsWorld();
+}
+
+std::string FeatureLoader::GetCountryFileName() const
+{
+  ASSERT(m_checker.CalledOnOriginalThread(), ());
+  return m_guard ? m_guard->GetCountryFileName() : std::string();
+}
+
 void FeatureLoader::Reset()
 {
   ASSERT(m_checker.CalledOnOriginalThread(), ());
   m_guard.reset();
+  m_centers.reset();
+  m_handle = MwmSet::MwmHandle();
+}
+
+void FeatureLoader::SetMwm(MwmSet::MwmId const & mwmId)
+{
+  if (m_guard && m_guard->GetId() == mwmId)
+    return;
+
+  m_guard = my::make_unique<Index::FeaturesLoaderGuard>(m_index, mwmId);
+
+  m_centers.reset();
+  m_handle = m_index.GetMwmHandleById(mwmId);
+  if (m_handle.IsAlive())
+    m_centers = my::make_unique<LazyCentersTable>(*m_handle.GetValue<MwmValue>());
 }
 }  // namespace search
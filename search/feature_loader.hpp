@@ -1,5 +1,7 @@
 #pragma once
 
+#include "search/lazy_centers_table.hpp"
+
 #include "indexer/index.hpp"
 #include "indexer/scales.hpp"
 
@@ -8,6 +10,7 @@
 #include "base/thread_checker.hpp"
 
 #include <memory>
+#include <string>
 #include <utility>
 
 class FeatureType;
@@ -22,6 +25,16 @@ public:
 
   WARN_UNUSED_RESULT bool Load(FeatureID const & id, FeatureType & ft);
 
+  // Loads |ft| and its center. The center is read from the centers
+  // table when the feature is not edited, so the geometry of |ft| is
+  // not decoded. Other parts of |ft| (names, metadata, etc.) are
+  // decoded lazily, only when they are requested.
+  WARN_UNUSED_RESULT bool Load(FeatureID const & id, FeatureType & ft, m2::PointD & center);
+
+  // Returns properties of the mwm of the last loaded feature.
+  bool IsWorld() const;
+  std::string GetCountryFileName() const;
+
   void Reset();
 
   template <typename ToDo>
@@ -32,9 +45,14 @@ public:
   }
 
 private:
+  void SetMwm(MwmSet::MwmId const & mwmId);
+
   Index const & m_index;
   std::unique_ptr<Index::FeaturesLoaderGuard> m_guard;
 
+  MwmSet::MwmHandle m_handle;
+  std::unique_ptr<LazyCentersTable> m_centers;
+
   ThreadChecker m_checker;
 };
 }  // namespace search
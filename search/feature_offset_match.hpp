@@ -72,7 +72,7 @@ bool MatchInTrie(trie::Iterator<ValueList<Value>> const & trieRoot,
 
   while (!q.empty())
   {
-    auto const p = q.front();
+    auto const p = move(q.front());
     q.pop();
 
     auto const & trieIt = p.first;
@@ -9,16 +9,13 @@
 
 namespace search
 {
-/// Max distance from house to street where we do search matching
-/// even if there is no exact street written for this house.
-int constexpr kMaxApproxStreetDistanceM = 100;
-
 FeaturesLayerMatcher::FeaturesLayerMatcher(Index const & index, my::Cancellable const & cancellable)
   : m_context(nullptr)
   , m_postcodes(nullptr)
   , m_reverseGeocoder(index)
   , m_nearbyStreetsCache("FeatureToNearbyStreets")
   , m_matchingStreetsCache("BuildingToStreet")
+  , m_houseNumberParsesCache("BuildingToHouseNumberParses")
   , m_loader(scales::GetUpperScale(), ReverseGeocoder::kLookupRadiusM)
   , m_cancellable(cancellable)
 {
@@ -43,9 +40,43 @@ void FeaturesLayerMatcher::OnQueryFinished()
 {
   m_nearbyStreetsCache.ClearIfNeeded();
   m_matchingStreetsCache.ClearIfNeeded();
+  m_houseNumberParsesCache.ClearIfNeeded();
   m_loader.OnQueryFinished();
 }
 
+bool FeaturesLayerMatcher::HouseNumberMatches(uint32_t houseId, FeatureType & houseFeature,
+                                              bool & loaded,
+                                              vector<house_numbers::Token> const & queryParse)
+{
+  if (queryParse.empty())
+    return false;
+
+  auto const load = [&]() {
+    if (!loaded)
+    {
+      GetByIndex(houseId, houseFeature);
+      loaded = true;
+    }
+  };
+
+  // House numbers may be changed by user, so edited houses are not cached.
+  if (m_context->IsEdited(houseId))
+  {
+    load();
+    return house_numbers::HouseNumbersMatch(strings::MakeUniString(houseFeature.GetHouseNumber()),
+                                            queryParse);
+  }
+
+  auto entry = m_houseNumberParsesCache.Get(houseId);
+  if (entry.second)
+  {
+    load();
+    house_numbers::ParseHouseNumber(strings::MakeUniString(houseFeature.GetHouseNumber()),
+                                    entry.first);
+  }
+  return house_numbers::HouseNumbersMatch(entry.first, queryParse);
+}
+
 uint32_t FeaturesLayerMatcher::GetMatchingStreet(uint32_t houseId)
 {
   FeatureType feature;
@@ -105,13 +136,23 @@ uint32_t FeaturesLayerMatcher::GetMatchingStreetImpl(uint32_t houseId, FeatureTy
   if (!edited && !entry.second)
     return entry.first;
 
+  uint32_t & result = entry.first;
+
+  // Use the precomputed street when the house is known to the table.
+  StreetsHousesTable const * table = m_context->GetStreetsHousesTable();
+  if (!edited && table && table->Covers(houseId) && !m_context->IsEdited(houseId))
+  {
+    if (!table->GetStreet(houseId, result))
+      result = kInvalidId;
+    return result;
+  }
+
   // Load feature if needed.
   if (!houseFeature.GetID().IsValid())
     GetByIndex(houseId, houseFeature);
 
   // Get nearby streets and calculate the resulting index.
   auto const & streets = GetNearbyStreets(houseId, houseFeature);
-  uint32_t & result = entry.first;
   result = kInvalidId;
 
   if (edited)
@@ -132,7 +173,7 @@ uint32_t FeaturesLayerMatcher::GetMatchingStreetImpl(uint32_t houseId, FeatureTy
 
   // If there is no saved street for feature, assume that it's a nearest street if it's too close.
   if (result == kInvalidId && !streets.empty() &&
-      streets[0].m_distanceMeters < kMaxApproxStreetDistanceM)
+      streets[0].m_distanceMeters < ReverseGeocoder::kMaxApproxStreetDistanceM)
   {
     result = streets[0].m_id.m_index;
   }
@@ -10,6 +10,7 @@
 #include "search/projection_on_street.hpp"
 #include "search/reverse_geocoder.hpp"
 #include "search/street_vicinity_loader.hpp"
+#include "search/streets_houses_table.hpp"
 
 #include "indexer/feature.hpp"
 #include "indexer/feature_algo.hpp"
@@ -169,8 +170,8 @@ private:
           [&](FeatureType & ft) {
             if (m_postcodes && !m_postcodes->HasBit(ft.GetID().m_index))
               return;
-            if (house_numbers::HouseNumbersMatch(strings::MakeUniString(ft.GetHouseNumber()),
-                                                 queryParse))
+            bool loaded = true;
+            if (HouseNumberMatches(ft.GetID().m_index, ft, loaded, queryParse))
             {
               double const distanceM =
                   MercatorBounds::DistanceOnEarth(feature::GetCenter(ft), poiCenters[i].m_point);
@@ -294,17 +295,10 @@ private:
       if (m_postcodes && !m_postcodes->HasBit(id))
         return false;
 
-      if (!loaded)
-      {
-        GetByIndex(id, feature);
-        loaded = true;
-      }
-
       if (!child.m_hasDelayedFeatures)
         return false;
 
-      strings::UniString const houseNumber(strings::MakeUniString(feature.GetHouseNumber()));
-      return house_numbers::HouseNumbersMatch(houseNumber, queryParse);
+      return HouseNumberMatches(id, feature, loaded, queryParse);
     };
 
     unordered_map<uint32_t, bool> cache;
@@ -317,6 +311,42 @@ private:
       return result;
     };
 
+    // Houses of streets are known in advance when there is a
+    // precomputed table, so street vicinities and projections on
+    // streets are not needed.
+    if (StreetsHousesTable const * table = m_context->GetStreetsHousesTable())
+    {
+      for (uint32_t streetId : streets)
+      {
+        BailIfCancelled(m_cancellable);
+        table->ForEachHouse(streetId, [&](uint32_t houseId) {
+          // Edited houses are matched below.
+          if (m_context->IsEdited(houseId))
+            return;
+
+          FeatureType feature;
+          bool loaded = false;
+          if (cachingHouseNumberFilter(houseId, feature, loaded))
+            fn(houseId, streetId);
+        });
+      }
+
+      // The table may be out of date for houses edited by user, so
+      // their streets are matched at runtime.
+      for (uint32_t const houseId : buildings)
+      {
+        if (!m_context->IsEdited(houseId))
+          continue;
+
+        FeatureType feature;
+        GetByIndex(houseId, feature);
+        uint32_t const streetId = GetMatchingStreet(houseId, feature);
+        if (binary_search(streets.begin(), streets.end(), streetId))
+          fn(houseId, streetId);
+      }
+      return;
+    }
+
     ProjectionOnStreet proj;
     for (uint32_t streetId : streets)
     {
@@ -357,6 +387,13 @@ private:
 
   // Returns id of a street feature corresponding to a |houseId|, or
   // kInvalidId if there're not such street.
+  // Returns true if house number of |houseId| matches |queryParse|.
+  // Parsed house numbers are cached, so |houseFeature| is loaded only
+  // when house number of |houseId| is not in the cache yet, |loaded|
+  // is updated correspondingly.
+  bool HouseNumberMatches(uint32_t houseId, FeatureType & houseFeature, bool & loaded,
+                          vector<house_numbers::Token> const & queryParse);
+
   uint32_t GetMatchingStreet(uint32_t houseId);
   uint32_t GetMatchingStreet(uint32_t houseId, FeatureType & houseFeature);
   uint32_t GetMatchingStreetImpl(uint32_t houseId, FeatureType & houseFeature);
@@ -395,6 +432,9 @@ private:
   // located on multiple streets.
   Cache<uint32_t, uint32_t> m_matchingStreetsCache;
 
+  // Cache of parsed house numbers of buildings.
+  Cache<uint32_t, vector<vector<house_numbers::Token>>> m_houseNumberParsesCache;
+
   StreetVicinityLoader m_loader;
   my::Cancellable const & m_cancellable;
 };
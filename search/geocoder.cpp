@@ -39,8 +39,10 @@
 #include "base/scope_guard.hpp"
 #include "base/stl_add.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/thread.hpp"
 
 #include "std/algorithm.hpp"
+#include "std/atomic.hpp"
 #include "std/bind.hpp"
 #include "std/iterator.hpp"
 #include "std/random.hpp"
@@ -73,6 +75,8 @@ size_t const kMaxNumLocalities = LocalityScorer::kDefaultReadLimit;
 
 size_t constexpr kPivotRectsCacheSize = 10;
 size_t constexpr kLocalityRectsCacheSize = 10;
+uint64_t constexpr kRetrievalCacheBytes = 16 * 1024 * 1024;
+size_t constexpr kDFACacheSize = 256;
 
 UniString const kUniSpace(MakeUniString(" "));
 
@@ -324,8 +328,43 @@ CBV DecimateCianResults(CBV const & cbv)
   });
   return CBV(coding::CompressedBitVectorBuilder::FromBitPositions(move(setBits)));
 }
+// Returns a key which identifies features retrieved for the |i|-th
+// token of |params|: the token with its synonyms, the categories
+// of the token, the languages and whether the token is a prefix.
+string MakeTokenKey(QueryParams const & params, size_t i)
+{
+  ostringstream os;
+  os << (params.IsPrefixToken(i) ? 'p' : 't');
+  params.GetToken(i).ForEach([&os](UniString const & s) { os << '\0' << ToUtf8(s); });
+  os << '\0';
+  for (auto const & index : params.GetTypeIndices(i))
+    os << ' ' << index;
+  os << '\0';
+  for (auto const & lang : params.GetLangs())
+    os << ' ' << lang;
+  return os.str();
+}
 }  // namespace
 
+// Geocoder::Worker --------------------------------------------------------------------------------
+struct Geocoder::Worker
+{
+  Worker(Index const & index, storage::CountryInfoGetter const & infoGetter,
+         PreRanker & preRanker, my::Cancellable const & cancellable)
+    : m_villagesCache(cancellable)
+    , m_geocoder(index, infoGetter, preRanker, m_villagesCache, cancellable)
+  {
+    m_geocoder.SetStageTimes(&m_stageTimes);
+  }
+
+  // VillagesCache is not thread-safe, so every worker has its own one.
+  VillagesCache m_villagesCache;
+  // Stage times of the worker thread, they are added to the times of
+  // the main geocoder when the worker is done.
+  StageTimes m_stageTimes;
+  Geocoder m_geocoder;
+};
+
 // Geocoder::Geocoder ------------------------------------------------------------------------------
 Geocoder::Geocoder(Index const & index, storage::CountryInfoGetter const & infoGetter,
                    PreRanker & preRanker, VillagesCache & villagesCache,
@@ -342,14 +381,43 @@ Geocoder::Geocoder(Index const & index, storage::CountryInfoGetter const & infoG
   , m_filter(nullptr)
   , m_matcher(nullptr)
   , m_finder(m_cancellable)
+  , m_dfaCache(kDFACacheSize)
+  , m_retrievalCache(kRetrievalCacheBytes)
   , m_preRanker(preRanker)
 {
 }
 
 Geocoder::~Geocoder() {}
 
+void Geocoder::SetNumThreads(size_t numThreads)
+{
+  CHECK_GREATER(numThreads, 0, ());
+
+  // This geocoder works in the calling thread, so one thread less is needed.
+  m_workers.clear();
+  for (size_t i = 1; i < numThreads; ++i)
+  {
+    m_workers.push_back(
+        my::make_unique<Worker>(m_index, m_infoGetter, m_preRanker, m_cancellable));
+    m_workers.back()->m_geocoder.SetParams(m_params);
+    m_workers.back()->m_geocoder.SetSharedGeometryCache(m_sharedGeometryCache);
+  }
+}
+
+void Geocoder::SetSharedGeometryCache(shared_ptr<SharedGeometryCache> cache)
+{
+  m_sharedGeometryCache = cache;
+  m_pivotRectsCache.SetSharedCache(cache);
+  m_localityRectsCache.SetSharedCache(cache);
+  for (auto & worker : m_workers)
+    worker->m_geocoder.SetSharedGeometryCache(cache);
+}
+
 void Geocoder::SetParams(Params const & params)
 {
+  for (auto & worker : m_workers)
+    worker->m_geocoder.SetParams(params);
+
   if (params.IsCategorialRequest())
   {
     SetParamsForCategorialSearch(params);
@@ -361,14 +429,16 @@ void Geocoder::SetParams(Params const & params)
 
   m_tokenRequests.clear();
   m_prefixTokenRequest.Clear();
+  m_tokenKeys.clear();
   for (size_t i = 0; i < m_params.GetNumTokens(); ++i)
   {
+    m_tokenKeys.push_back(MakeTokenKey(m_params, i));
     if (!m_params.IsPrefixToken(i))
     {
       m_tokenRequests.emplace_back();
       auto & request = m_tokenRequests.back();
-      m_params.GetToken(i).ForEach([&request](UniString const & s) {
-        request.m_names.emplace_back(BuildLevenshteinDFA(s));
+      m_params.GetToken(i).ForEach([this, &request](UniString const & s) {
+        request.m_names.emplace_back(m_dfaCache.Get(s));
       });
       for (auto const & index : m_params.GetTypeIndices(i))
         request.m_categories.emplace_back(FeatureTypeToString(index));
@@ -377,8 +447,8 @@ void Geocoder::SetParams(Params const & params)
     else
     {
       auto & request = m_prefixTokenRequest;
-      m_params.GetToken(i).ForEach([&request](UniString const & s) {
-        request.m_names.emplace_back(BuildLevenshteinDFA(s));
+      m_params.GetToken(i).ForEach([this, &request](UniString const & s) {
+        request.m_names.emplace_back(m_dfaCache.Get(s));
       });
       for (auto const & index : m_params.GetTypeIndices(i))
         request.m_categories.emplace_back(FeatureTypeToString(index));
@@ -436,6 +506,14 @@ void Geocoder::ClearCaches()
   m_hotelsCache.Clear();
   m_hotelsFilter.ClearCaches();
   m_postcodes.Clear();
+  m_dfaCache.Clear();
+  m_retrievalCache.Clear();
+
+  for (auto & worker : m_workers)
+  {
+    worker->m_geocoder.ClearCaches();
+    worker->m_villagesCache.Clear();
+  }
 }
 
 void Geocoder::SetParamsForCategorialSearch(Params const & params)
@@ -445,6 +523,7 @@ void Geocoder::SetParamsForCategorialSearch(Params const & params)
 
   m_tokenRequests.clear();
   m_prefixTokenRequest.Clear();
+  m_tokenKeys.clear();
 
   ASSERT_EQUAL(m_params.GetNumTokens(), 1, ());
   ASSERT(!m_params.IsPrefixToken(0), ());
@@ -456,6 +535,28 @@ void Geocoder::GoImpl(vector<shared_ptr<MwmInfo>> & infos, bool inViewport)
 {
   // base::PProf pprof("/tmp/geocoder.prof");
 
+  ScopedStage stage(m_stageTimes, SearchStage::Geocoder);
+
+  // Features of deregistered mwms won't be requested anymore.
+  m_retrievalCache.RemoveDeadMwms();
+  for (auto & worker : m_workers)
+    worker->m_geocoder.m_retrievalCache.RemoveDeadMwms();
+  if (m_sharedGeometryCache)
+    m_sharedGeometryCache->RemoveDeadMwms();
+
+  // Features in rects may be changed by edits between queries, they
+  // are kept between queries by the shared cache only.
+  if (m_sharedGeometryCache)
+  {
+    m_pivotRectsCache.Clear();
+    m_localityRectsCache.Clear();
+    for (auto & worker : m_workers)
+    {
+      worker->m_geocoder.m_pivotRectsCache.Clear();
+      worker->m_geocoder.m_localityRectsCache.Clear();
+    }
+  }
+
   try
   {
     // Tries to find world and fill localities table.
@@ -497,81 +598,156 @@ void Geocoder::GoImpl(vector<shared_ptr<MwmInfo>> & infos, bool inViewport)
     // found.
     size_t const numIntersectingMaps = OrderCountries(m_params.m_pivot, infos);
 
-    // MatchAroundPivot() should always be matched in mwms
-    // intersecting with position and viewport.
-    auto processCountry = [&](size_t index, unique_ptr<MwmContext> context)
+    if (m_workers.empty())
     {
-      ASSERT(context, ());
-      m_context = move(context);
-
-      MY_SCOPE_GUARD(cleanup, [&]()
-                     {
-                       LOG(LDEBUG, (m_context->GetName(), "geocoding complete."));
-                       m_matcher->OnQueryFinished();
-                       m_matcher = nullptr;
-                       m_context.reset();
-                     });
-
-      auto it = m_matchersCache.find(m_context->GetId());
-      if (it == m_matchersCache.end())
-      {
-        it = m_matchersCache.insert(make_pair(m_context->GetId(), my::make_unique<FeaturesLayerMatcher>(
-                                                                      m_index, m_cancellable)))
-                 .first;
-      }
-      m_matcher = it->second.get();
-      m_matcher->SetContext(m_context.get());
+      ForEachCountry(infos, [&](size_t index, unique_ptr<MwmContext> context) {
+        ProcessCountry(index, numIntersectingMaps, inViewport, move(context));
+      });
+    }
+    else
+    {
+      GoInParallel(infos, numIntersectingMaps, inViewport);
+    }
 
-      BaseContext ctx;
-      InitBaseContext(ctx);
+    m_preRanker.UpdateResults(true /* lastUpdate */, m_stageTimes);
+  }
+  catch (CancelException & e)
+  {
+  }
+}
+
+void Geocoder::GoInParallel(vector<shared_ptr<MwmInfo>> const & infos, size_t numIntersectingMaps,
+                            bool inViewport)
+{
+  // Localities from World are the same for all the mwms.
+  for (auto & worker : m_workers)
+  {
+    auto & geocoder = worker->m_geocoder;
+    geocoder.m_worldId = m_worldId;
+    geocoder.m_cities = m_cities;
+    for (size_t i = 0; i < Region::TYPE_COUNT; ++i)
+      geocoder.m_regions[i] = m_regions[i];
+  }
 
-      if (inViewport)
+  // Mwms are taken in the order of OrderCountries(), so the nearest ones are processed first
+  // like in the single-threaded case.
+  atomic<size_t> nextIndex(0);
+  auto const processCountries = [&](Geocoder & geocoder) {
+    ScopedStage stage(geocoder.m_stageTimes, SearchStage::Geocoder);
+    try
+    {
+      for (size_t index = nextIndex++; index < infos.size(); index = nextIndex++)
       {
-        auto const viewportCBV =
-            RetrieveGeometryFeatures(*m_context, m_params.m_pivot, RECT_ID_PIVOT);
-        for (auto & features : ctx.m_features)
-          features = features.Intersect(viewportCBV);
+        auto context = geocoder.GetCountryContext(infos[index]);
+        if (context)
+          geocoder.ProcessCountry(index, numIntersectingMaps, inViewport, move(context));
       }
+    }
+    catch (CancelException const &)
+    {
+    }
+  };
+
+  vector<threads::SimpleThread> threads;
+  threads.reserve(m_workers.size());
+  for (auto & worker : m_workers)
+  {
+    worker->m_stageTimes.Reset();
+    threads.emplace_back(processCountries, ref(worker->m_geocoder));
+  }
 
-      ctx.m_villages = m_villagesCache.Get(*m_context);
+  processCountries(*this);
 
-      auto citiesFromWorld = m_cities;
-      FillVillageLocalities(ctx);
-      MY_SCOPE_GUARD(remove_villages, [&]()
-                     {
-                       m_cities = citiesFromWorld;
-                     });
+  for (auto & thread : threads)
+    thread.join();
 
-      bool const intersectsPivot = index < numIntersectingMaps;
-      if (m_params.IsCategorialRequest())
-      {
-        MatchCategories(ctx, intersectsPivot);
-      }
-      else
-      {
-        MatchRegions(ctx, Region::TYPE_COUNTRY);
+  if (m_stageTimes)
+  {
+    for (auto const & worker : m_workers)
+      m_stageTimes->Add(worker->m_stageTimes);
+  }
 
-        if (intersectsPivot || m_preRanker.NumSentResults() == 0)
-          MatchAroundPivot(ctx);
-      }
+  BailIfCancelled();
+}
 
-      if (index + 1 >= numIntersectingMaps)
-        m_preRanker.UpdateResults(false /* lastUpdate */);
-    };
+void Geocoder::ProcessCountry(size_t index, size_t numIntersectingMaps, bool inViewport,
+                              unique_ptr<MwmContext> context)
+{
+  ASSERT(context, ());
+  m_context = move(context);
 
-    // Iterates through all alive mwms and performs geocoding.
-    ForEachCountry(infos, processCountry);
+  MY_SCOPE_GUARD(cleanup, [&]()
+                 {
+                   LOG(LDEBUG, (m_context->GetName(), "geocoding complete."));
+                   m_matcher->OnQueryFinished();
+                   m_matcher = nullptr;
+                   m_context.reset();
+                 });
 
-    m_preRanker.UpdateResults(true /* lastUpdate */);
+  auto it = m_matchersCache.find(m_context->GetId());
+  if (it == m_matchersCache.end())
+  {
+    it = m_matchersCache.insert(make_pair(m_context->GetId(), my::make_unique<FeaturesLayerMatcher>(
+                                                                  m_index, m_cancellable)))
+             .first;
   }
-  catch (CancelException & e)
+  m_matcher = it->second.get();
+  m_matcher->SetContext(m_context.get());
+
+  BaseContext ctx;
+  InitBaseContext(ctx);
+
+  if (inViewport)
+  {
+    auto const viewportCBV =
+        RetrieveGeometryFeatures(*m_context, m_params.m_pivot, RECT_ID_PIVOT);
+    for (auto & features : ctx.m_features)
+      features = features.Intersect(viewportCBV);
+  }
+
+  ctx.m_villages = m_villagesCache.Get(*m_context);
+
+  auto citiesFromWorld = m_cities;
+  FillVillageLocalities(ctx);
+  MY_SCOPE_GUARD(remove_villages, [&]()
+                 {
+                   m_cities = citiesFromWorld;
+                 });
+
+  // MatchAroundPivot() should always be matched in mwms
+  // intersecting with position and viewport.
+  bool const intersectsPivot = index < numIntersectingMaps;
+  if (m_params.IsCategorialRequest())
   {
+    MatchCategories(ctx, intersectsPivot);
+  }
+  else
+  {
+    MatchRegions(ctx, Region::TYPE_COUNTRY);
+
+    if (intersectsPivot || m_preRanker.NumSentResults() == 0)
+      MatchAroundPivot(ctx);
+  }
+
+  // Results of the first mwm are sent at once in the progressive mode, e.g. top localities
+  // and categorial results around the pivot, the further updates refine them.
+  if (index + 1 >= numIntersectingMaps ||
+      (m_params.m_progressiveResults && m_preRanker.NumSentResults() == 0))
+  {
+    m_preRanker.UpdateResults(false /* lastUpdate */, m_stageTimes);
   }
 }
 
 void Geocoder::InitBaseContext(BaseContext & ctx)
 {
-  Retrieval retrieval(*m_context, m_cancellable);
+  // Retrieval reads the search index root, so it's created only if
+  // some of the tokens are not cached.
+  unique_ptr<Retrieval> retrieval;
+  auto const getRetrieval = [&]() -> Retrieval & {
+    if (!retrieval)
+      retrieval = my::make_unique<Retrieval>(*m_context, m_cancellable);
+    return *retrieval;
+  };
 
   ctx.m_usedTokens.assign(m_params.GetNumTokens(), false);
   ctx.m_numTokens = m_params.GetNumTokens();
@@ -587,11 +763,15 @@ void Geocoder::InitBaseContext(BaseContext & ctx)
     }
     else if (m_params.IsPrefixToken(i))
     {
-      ctx.m_features[i] = retrieval.RetrieveAddressFeatures(m_prefixTokenRequest);
+      ctx.m_features[i] = m_retrievalCache.Get(m_context->GetId(), m_tokenKeys[i], [&]() {
+        return getRetrieval().RetrieveAddressFeatures(m_prefixTokenRequest);
+      });
     }
     else
     {
-      ctx.m_features[i] = retrieval.RetrieveAddressFeatures(m_tokenRequests[i]);
+      ctx.m_features[i] = m_retrievalCache.Get(m_context->GetId(), m_tokenKeys[i], [&]() {
+        return getRetrieval().RetrieveAddressFeatures(m_tokenRequests[i]);
+      });
     }
 
     if (m_params.m_cianMode)
@@ -625,6 +805,7 @@ void Geocoder::FillLocalityCandidates(BaseContext const & ctx, CBV const & filte
 
   LocalityScorerDelegate delegate(*m_context, m_params);
   LocalityScorer scorer(m_params, delegate);
+  ScopedStage stage(m_stageTimes, SearchStage::LocalityScoring);
   scorer.GetTopLocalities(m_context->GetId(), ctx, filter, maxNumLocalities, preLocalities);
 }
 
@@ -746,24 +927,30 @@ void Geocoder::FillVillageLocalities(BaseContext const & ctx)
   }
 }
 
+unique_ptr<MwmContext> Geocoder::GetCountryContext(shared_ptr<MwmInfo> const & info) const
+{
+  if (info->GetType() != MwmInfo::COUNTRY && info->GetType() != MwmInfo::WORLD)
+    return nullptr;
+  if (info->GetType() == MwmInfo::COUNTRY && m_params.m_mode == Mode::Downloader)
+    return nullptr;
+
+  auto handle = m_index.GetMwmHandleById(MwmSet::MwmId(info));
+  if (!handle.IsAlive())
+    return nullptr;
+  auto & value = *handle.GetValue<MwmValue>();
+  if (!value.HasSearchIndex() || !value.HasGeometryIndex())
+    return nullptr;
+  return make_unique<MwmContext>(move(handle));
+}
+
 template <typename TFn>
 void Geocoder::ForEachCountry(vector<shared_ptr<MwmInfo>> const & infos, TFn && fn)
 {
   for (size_t i = 0; i < infos.size(); ++i)
   {
-    auto const & info = infos[i];
-    if (info->GetType() != MwmInfo::COUNTRY && info->GetType() != MwmInfo::WORLD)
-      continue;
-    if (info->GetType() == MwmInfo::COUNTRY && m_params.m_mode == Mode::Downloader)
-      continue;
-
-    auto handle = m_index.GetMwmHandleById(MwmSet::MwmId(info));
-    if (!handle.IsAlive())
-      continue;
-    auto & value = *handle.GetValue<MwmValue>();
-    if (!value.HasSearchIndex() || !value.HasGeometryIndex())
-      continue;
-    fn(i, make_unique<MwmContext>(move(handle)));
+    auto context = GetCountryContext(infos[i]);
+    if (context)
+      fn(i, move(context));
   }
 }
 
@@ -796,6 +983,8 @@ void Geocoder::MatchCategories(BaseContext & ctx, bool aroundPivot)
 
 void Geocoder::MatchRegions(BaseContext & ctx, Region::Type type)
 {
+  ScopedStage stage(m_stageTimes, SearchStage::GeocoderRegions);
+
   switch (type)
   {
   case Region::TYPE_STATE:
@@ -869,6 +1058,8 @@ void Geocoder::MatchRegions(BaseContext & ctx, Region::Type type)
 
 void Geocoder::MatchCities(BaseContext & ctx)
 {
+  ScopedStage stage(m_stageTimes, SearchStage::GeocoderCities);
+
   ASSERT(!ctx.m_city, ());
 
   // Localities are ordered my (m_startToken, m_endToken) pairs.
@@ -985,6 +1176,8 @@ void Geocoder::WithPostcodes(BaseContext & ctx, TFn && fn)
 
 void Geocoder::GreedilyMatchStreets(BaseContext & ctx)
 {
+  ScopedStage stage(m_stageTimes, SearchStage::GeocoderStreets);
+
   vector<StreetsMatcher::Prediction> predictions;
   StreetsMatcher::Go(ctx, *m_filter, m_params, predictions);
 
@@ -1019,6 +1212,8 @@ void Geocoder::MatchPOIsAndBuildings(BaseContext & ctx, size_t curToken)
 {
   BailIfCancelled();
 
+  ScopedStage stage(m_stageTimes, SearchStage::GeocoderPOIsAndBuildings);
+
   auto & layers = ctx.m_layers;
 
   curToken = ctx.SkipUsedTokens(curToken);
@@ -1244,6 +1439,8 @@ bool Geocoder::IsLayerSequenceSane(vector<FeaturesLayer> const & layers) const
 
 void Geocoder::FindPaths(BaseContext const & ctx)
 {
+  ScopedStage stage(m_stageTimes, SearchStage::PathFinder);
+
   auto const & layers = ctx.m_layers;
 
   if (layers.empty())
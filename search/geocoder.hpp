@@ -10,6 +10,7 @@
 #include "search/geocoder_locality.hpp"
 #include "search/geometry_cache.hpp"
 #include "search/hotels_filter.hpp"
+#include "search/levenshtein_dfa_cache.hpp"
 #include "search/mode.hpp"
 #include "search/model.hpp"
 #include "search/mwm_context.hpp"
@@ -17,6 +18,8 @@
 #include "search/pre_ranking_info.hpp"
 #include "search/query_params.hpp"
 #include "search/ranking_utils.hpp"
+#include "search/retrieval_cache.hpp"
+#include "search/search_stats.hpp"
 #include "search/streets_matcher.hpp"
 #include "search/token_range.hpp"
 
@@ -84,6 +87,8 @@ public:
     m2::RectD m_pivot;
     shared_ptr<hotels_filter::Rule> m_hotelsFilter;
     bool m_cianMode = false;
+    // See SearchParams::m_progressiveResults.
+    bool m_progressiveResults = false;
     set<uint32_t> m_preferredTypes;
   };
 
@@ -93,6 +98,17 @@ public:
 
   ~Geocoder();
 
+  // Sets the number of threads which geocode a query. Mwms of the query are spread over the
+  // threads, every thread has its own mwm contexts, matchers and retrieval caches and feeds
+  // results to the shared |preRanker|. So results may be sent to the ranker from any of the
+  // threads, but never from two threads at once.
+  void SetNumThreads(size_t numThreads);
+
+  // Sets the cache of features in rects which is shared by
+  // geocoders of all queries, it's used by this geocoder and all its
+  // threads. Caches of this geocoder are kept for a single query only.
+  void SetSharedGeometryCache(shared_ptr<SharedGeometryCache> cache);
+
   // Sets search query params.
   void SetParams(Params const & params);
 
@@ -103,6 +119,10 @@ public:
 
   void ClearCaches();
 
+  // Times of stages of geocoding are added to |stageTimes| during
+  // GoEverywhere() and GoInViewport(), it may be nullptr.
+  void SetStageTimes(StageTimes * stageTimes) { m_stageTimes = stageTimes; }
+
 private:
   enum RectId
   {
@@ -111,6 +131,9 @@ private:
     RECT_ID_COUNT
   };
 
+  // A geocoder with its own villages cache which processes a part of mwms of a query.
+  struct Worker;
+
   struct Postcodes
   {
     void Clear()
@@ -128,6 +151,14 @@ private:
 
   void GoImpl(vector<shared_ptr<MwmInfo>> & infos, bool inViewport);
 
+  // Processes |infos| by this geocoder and all the workers, each mwm is processed once.
+  void GoInParallel(vector<shared_ptr<MwmInfo>> const & infos, size_t numIntersectingMaps,
+                    bool inViewport);
+
+  // Performs geocoding in the |index|-th mwm of the ordered by OrderCountries() mwms.
+  void ProcessCountry(size_t index, size_t numIntersectingMaps, bool inViewport,
+                      unique_ptr<MwmContext> context);
+
   template <typename Locality>
   using LocalitiesCache = map<TokenRange, vector<Locality>>;
 
@@ -147,6 +178,9 @@ private:
 
   void FillVillageLocalities(BaseContext const & ctx);
 
+  // Returns context of the mwm if it should be geocoded, nullptr otherwise.
+  unique_ptr<MwmContext> GetCountryContext(shared_ptr<MwmInfo> const & info) const;
+
   template <typename TFn>
   void ForEachCountry(vector<shared_ptr<MwmInfo>> const & infos, TFn && fn);
 
@@ -258,6 +292,7 @@ private:
   // all of them are needed.
   PivotRectsCache m_pivotRectsCache;
   LocalityRectsCache m_localityRectsCache;
+  shared_ptr<SharedGeometryCache> m_sharedGeometryCache;
 
   // Postcodes features in the mwm that is currently being processed.
   Postcodes m_postcodes;
@@ -272,10 +307,24 @@ private:
   // Path finder for interpretations.
   FeaturesLayerPathFinder m_finder;
 
+  // DFAs of the query tokens, they are kept between queries.
+  LevenshteinDFACache m_dfaCache;
+
   // Search query params prepared for retrieval.
   vector<SearchTrieRequest<strings::LevenshteinDFA>> m_tokenRequests;
   SearchTrieRequest<strings::PrefixDFAModifier<strings::LevenshteinDFA>> m_prefixTokenRequest;
 
+  // Keys of the query tokens in |m_retrievalCache|, one per token.
+  vector<string> m_tokenKeys;
+
+  // Features of the query tokens, it's kept between queries.
+  RetrievalCache m_retrievalCache;
+
   PreRanker & m_preRanker;
+
+  // Additional geocoders which run in their own threads during GoImpl().
+  vector<unique_ptr<Worker>> m_workers;
+
+  StageTimes * m_stageTimes = nullptr;
 };
 }  // namespace search
@@ -3,16 +3,144 @@
 #include "search/geometry_utils.hpp"
 #include "search/mwm_context.hpp"
 #include "search/retrieval.hpp"
+#include "search/retrieval_cache.hpp"
 
 #include "geometry/mercator.hpp"
 
+#include "std/cmath.hpp"
+
 namespace search
 {
 namespace
 {
 double constexpr kCellEps = MercatorBounds::GetCellID2PointAbsEpsilon();
+
+// Approximate memory used by a cache entry besides its bit vector.
+uint64_t constexpr kEntryOverheadBytes = 128;
+
+// Centers of pivot rects are snapped to a grid with a step of about
+// 1 / kPivotGridSteps of the rect size.
+double constexpr kPivotGridSteps = 16.0;
+
+// Extends |rect| to the grid of |step|.
+m2::RectD QuantizeRect(m2::RectD const & rect, double step)
+{
+  return m2::RectD(floor(rect.minX() / step) * step, floor(rect.minY() / step) * step,
+                   ceil(rect.maxX() / step) * step, ceil(rect.maxY() / step) * step);
+}
+
+// Returns the largest power of two which is not greater than |value|, so
+// steps of close rects are the same.
+double FloorToPowerOfTwo(double value)
+{
+  return pow(2.0, floor(log2(value)));
+}
 }  // namespace
 
+// SharedGeometryCache -----------------------------------------------------------------------------
+bool SharedGeometryCache::Key::operator<(Key const & rhs) const
+{
+  if (m_id != rhs.m_id)
+    return m_id < rhs.m_id;
+  if (m_scale != rhs.m_scale)
+    return m_scale < rhs.m_scale;
+  if (m_rect.minX() != rhs.m_rect.minX())
+    return m_rect.minX() < rhs.m_rect.minX();
+  if (m_rect.minY() != rhs.m_rect.minY())
+    return m_rect.minY() < rhs.m_rect.minY();
+  if (m_rect.maxX() != rhs.m_rect.maxX())
+    return m_rect.maxX() < rhs.m_rect.maxX();
+  return m_rect.maxY() < rhs.m_rect.maxY();
+}
+
+SharedGeometryCache::SharedGeometryCache(uint64_t maxBytes) : m_maxBytes(maxBytes) {}
+
+unique_ptr<coding::CompressedBitVector> SharedGeometryCache::Get(Key const & key,
+                                                                 uint64_t & generation)
+{
+  lock_guard<mutex> lock(m_mu);
+  generation = m_generation;
+
+  auto const it = m_entries.find(key);
+  if (it == m_entries.end())
+    return {};
+
+  m_lru.splice(m_lru.begin(), m_lru, it->second.m_lruIt);
+  return it->second.m_features->Clone();
+}
+
+void SharedGeometryCache::Put(Key const & key, coding::CompressedBitVector const * features,
+                              uint64_t generation)
+{
+  if (!features)
+    return;
+
+  uint64_t const bytes = kEntryOverheadBytes + EstimateBytes(features);
+  if (bytes > m_maxBytes)
+    return;
+
+  auto copy = features->Clone();
+
+  lock_guard<mutex> lock(m_mu);
+  if (generation != m_generation || m_entries.count(key) != 0)
+    return;
+
+  while (m_bytes + bytes > m_maxBytes)
+  {
+    ASSERT(!m_lru.empty(), ());
+    Erase(m_entries.find(m_lru.back()));
+  }
+
+  m_lru.push_front(key);
+  auto & entry = m_entries[key];
+  entry.m_features = move(copy);
+  entry.m_bytes = bytes;
+  entry.m_lruIt = m_lru.begin();
+  m_bytes += bytes;
+}
+
+void SharedGeometryCache::RemoveDeadMwms()
+{
+  lock_guard<mutex> lock(m_mu);
+  for (auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    if (it->first.m_id.IsAlive())
+      ++it;
+    else
+      Erase(it++);
+  }
+}
+
+void SharedGeometryCache::Clear()
+{
+  lock_guard<mutex> lock(m_mu);
+  m_lru.clear();
+  m_entries.clear();
+  m_bytes = 0;
+  ++m_generation;
+}
+
+uint64_t SharedGeometryCache::GetBytes() const
+{
+  lock_guard<mutex> lock(m_mu);
+  return m_bytes;
+}
+
+size_t SharedGeometryCache::GetNumEntries() const
+{
+  lock_guard<mutex> lock(m_mu);
+  return m_entries.size();
+}
+
+void SharedGeometryCache::Erase(map<Key, Entry>::iterator it)
+{
+  ASSERT(it != m_entries.end(), ());
+  ASSERT_GREATER_OR_EQUAL(m_bytes, it->second.m_bytes, ());
+  m_bytes -= it->second.m_bytes;
+  m_lru.erase(it->second.m_lruIt);
+  m_entries.erase(it);
+}
+
 // GeometryCache -----------------------------------------------------------------------------------
 GeometryCache::GeometryCache(size_t maxNumEntries, my::Cancellable const & cancellable)
   : m_maxNumEntries(maxNumEntries), m_cancellable(cancellable)
@@ -23,11 +151,26 @@ GeometryCache::GeometryCache(size_t maxNumEntries, my::Cancellable const & cance
 void GeometryCache::InitEntry(MwmContext const & context, m2::RectD const & rect, int scale,
                               Entry & entry)
 {
-  Retrieval retrieval(context, m_cancellable);
-
   entry.m_rect = rect;
-  entry.m_cbv = retrieval.RetrieveGeometryFeatures(rect, scale);
   entry.m_scale = scale;
+
+  SharedGeometryCache::Key const key(context.GetId(), rect, scale);
+  uint64_t generation = 0;
+  if (m_sharedCache)
+  {
+    auto features = m_sharedCache->Get(key, generation);
+    if (features)
+    {
+      entry.m_cbv = CBV(move(features));
+      return;
+    }
+  }
+
+  Retrieval retrieval(context, m_cancellable);
+  auto features = retrieval.RetrieveGeometryFeatures(rect, scale);
+  if (m_sharedCache)
+    m_sharedCache->Put(key, features.get(), generation);
+  entry.m_cbv = CBV(move(features));
 }
 
 // PivotRectsCache ---------------------------------------------------------------------------------
@@ -48,10 +191,15 @@ CBV PivotRectsCache::Get(MwmContext const & context, m2::RectD const & rect, int
   auto & entry = p.first;
   if (p.second)
   {
-    m2::RectD normRect =
-        MercatorBounds::RectByCenterXYAndSizeInMeters(rect.Center(), m_maxRadiusMeters);
+    // The center is snapped to a grid, so pivots of a panned viewport
+    // have the same normalized rect.
+    m2::PointD center = rect.Center();
+    m2::RectD normRect = MercatorBounds::RectByCenterXYAndSizeInMeters(center, m_maxRadiusMeters);
+    double const step = FloorToPowerOfTwo(max(normRect.SizeX(), normRect.SizeY()) / kPivotGridSteps);
+    center = m2::PointD(round(center.x / step) * step, round(center.y / step) * step);
+    normRect = MercatorBounds::RectByCenterXYAndSizeInMeters(center, m_maxRadiusMeters);
     if (!normRect.IsRectInside(rect))
-      normRect = rect;
+      normRect = QuantizeRect(rect, kCellEps);
     InitEntry(context, normRect, scale, entry);
   }
   return entry.m_cbv;
@@ -72,7 +220,7 @@ CBV LocalityRectsCache::Get(MwmContext const & context, m2::RectD const & rect,
                              });
   auto & entry = p.first;
   if (p.second)
-    InitEntry(context, rect, scale, entry);
+    InitEntry(context, QuantizeRect(rect, kCellEps), scale, entry);
   return entry.m_cbv;
 }
 
@@ -8,10 +8,15 @@
 
 #include "base/assert.hpp"
 
+#include "coding/compressed_bit_vector.hpp"
+
 #include "std/algorithm.hpp"
 #include "std/cstdint.hpp"
 #include "std/deque.hpp"
+#include "std/list.hpp"
 #include "std/map.hpp"
+#include "std/mutex.hpp"
+#include "std/shared_ptr.hpp"
 #include "std/unique_ptr.hpp"
 #include "std/utility.hpp"
 
@@ -24,7 +29,78 @@ namespace search
 {
 class MwmContext;
 
-// This class represents a simple cache of features in rects for all mwms.
+// This class represents an LRU cache of features in rects which is
+// shared by all query processors and is not cleared between queries,
+// e.g. viewport searches while a user pans the map retrieve almost
+// the same rects again and again. Rects are quantized by
+// GeometryCache before they are retrieved, so close rects of
+// different queries have the same key. The cache is limited by the
+// estimated size of bit vectors in bytes.
+//
+// Features of rects include edited features, so the cache must be
+// cleared when edits are changed, see
+// Engine::InvalidateGeometryCache().
+//
+// *NOTE* This class is thread-safe. Bit vectors are copied on both
+// insertion and lookup, as CBV's reference counter is not atomic.
+class SharedGeometryCache
+{
+public:
+  struct Key
+  {
+    Key() = default;
+    Key(MwmSet::MwmId const & id, m2::RectD const & rect, int scale)
+      : m_id(id), m_rect(rect), m_scale(scale)
+    {
+    }
+
+    bool operator<(Key const & rhs) const;
+
+    MwmSet::MwmId m_id;
+    m2::RectD m_rect;
+    int m_scale = 0;
+  };
+
+  explicit SharedGeometryCache(uint64_t maxBytes);
+
+  // Returns a copy of features of |key| or nullptr. |generation| is
+  // set to the current generation of the cache, it must be passed to
+  // Put() when features are retrieved after a miss.
+  unique_ptr<coding::CompressedBitVector> Get(Key const & key, uint64_t & generation);
+
+  // Caches a copy of |features|. Does nothing if the cache was
+  // cleared after |generation|, since |features| may miss changes of
+  // edits.
+  void Put(Key const & key, coding::CompressedBitVector const * features, uint64_t generation);
+
+  void RemoveDeadMwms();
+  void Clear();
+
+  uint64_t GetBytes() const;
+  size_t GetNumEntries() const;
+
+private:
+  struct Entry
+  {
+    unique_ptr<coding::CompressedBitVector> m_features;
+    uint64_t m_bytes = 0;
+    list<Key>::iterator m_lruIt;
+  };
+
+  void Erase(map<Key, Entry>::iterator it);
+
+  mutable mutex m_mu;
+  // Keys from the most recently used to the least recently used one.
+  list<Key> m_lru;
+  map<Key, Entry> m_entries;
+  uint64_t m_bytes = 0;
+  uint64_t m_generation = 0;
+  uint64_t const m_maxBytes;
+};
+
+// This class represents a simple cache of features in rects for all
+// mwms, it's cleared by Geocoder before every query. Rects which are
+// not in the cache are looked up in SharedGeometryCache, if it's set.
 //
 // *NOTE* This class is not thread-safe.
 class GeometryCache
@@ -39,6 +115,8 @@ public:
 
   inline void Clear() { m_entries.clear(); }
 
+  inline void SetSharedCache(shared_ptr<SharedGeometryCache> cache) { m_sharedCache = cache; }
+
 protected:
   struct Entry
   {
@@ -77,6 +155,7 @@ protected:
   map<MwmSet::MwmId, deque<Entry>> m_entries;
   size_t const m_maxNumEntries;
   my::Cancellable const & m_cancellable;
+  shared_ptr<SharedGeometryCache> m_sharedCache;
 };
 
 class PivotRectsCache : public GeometryCache
@@ -542,8 +542,16 @@ bool HouseNumbersMatch(strings::UniString const & houseNumber, vector<Token> con
 
   vector<vector<Token>> houseNumberParses;
   ParseHouseNumber(houseNumber, houseNumberParses);
+  return HouseNumbersMatch(houseNumberParses, queryParse);
+}
+
+bool HouseNumbersMatch(vector<vector<Token>> const & houseNumberParses,
+                       vector<Token> const & queryParse)
+{
+  if (queryParse.empty())
+    return false;
 
-  for (auto & parse : houseNumberParses)
+  for (auto const & parse : houseNumberParses)
   {
     if (parse.empty())
       continue;
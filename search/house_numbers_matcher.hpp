@@ -69,6 +69,12 @@ bool HouseNumbersMatch(strings::UniString const & houseNumber, strings::UniStrin
 // Returns true if house number matches to a given parsed query.
 bool HouseNumbersMatch(strings::UniString const & houseNumber, vector<Token> const & queryParse);
 
+// Returns true if house number with |houseNumberParses| from
+// ParseHouseNumber() matches to a given parsed query. Parses may be
+// cached, as a house number is usually matched against many queries.
+bool HouseNumbersMatch(vector<vector<Token>> const & houseNumberParses,
+                       vector<Token> const & queryParse);
+
 // Returns true if |s| looks like a house number.
 bool LooksLikeHouseNumber(strings::UniString const & s, bool isPrefix);
 
@@ -10,6 +10,7 @@
 #include "indexer/feature_algo.hpp"
 #include "indexer/ftypes_matcher.hpp"
 #include "indexer/ftypes_sponsored.hpp"
+#include "indexer/opening_hours_cache.hpp"
 #include "indexer/scales.hpp"
 
 #include "geometry/angles.hpp"
@@ -19,8 +20,6 @@
 #include "base/string_utils.hpp"
 #include "base/logging.hpp"
 
-#include "3party/opening_hours/opening_hours.hpp"
-
 namespace search
 {
 double const kDistSameStreetMeters = 5000.0;
@@ -39,11 +38,11 @@ void ProcessMetadata(FeatureType const & ft, Result::Metadata & meta)
   string const openHours = src.Get(feature::Metadata::FMD_OPEN_HOURS);
   if (!openHours.empty())
   {
-    osmoh::OpeningHours const oh(openHours);
+    auto const oh = osm::GetParsedOpeningHours(openHours);
     // TODO: We should check closed/open time for specific feature's timezone.
     time_t const now = time(nullptr);
-    if (oh.IsValid() && !oh.IsUnknown(now))
-      meta.m_isOpenNow = oh.IsOpen(now) ? osm::Yes : osm::No;
+    if (oh->IsValid() && !oh->IsUnknown(now))
+      meta.m_isOpenNow = oh->IsOpen(now) ? osm::Yes : osm::No;
     // In else case value us osm::Unknown, it's set in preview's constructor.
   }
 
@@ -194,6 +194,8 @@ public:
   PreResult2 const & operator*() const { return *m_value; }
 
   inline double GetRank() const { return m_rank; }
+  // Overrides the rank of the linear model, e.g. by RankingModel.
+  inline void SetRank(double rank) { m_rank = rank; }
 
   inline double GetDistanceToPivot() const { return m_distanceToPivot; }
 };
@@ -2,6 +2,8 @@
 
 #include "indexer/index.hpp"
 
+#include "base/logging.hpp"
+
 #include "defines.hpp"
 
 namespace search
@@ -24,6 +26,25 @@ void LazyCentersTable::EnsureTableLoaded()
     return;
   }
 
+  auto const & codingParams = m_value.GetHeader().GetDefCodingParams();
+
+  try
+  {
+    m_mapping = make_unique<FilesMappingContainer>(m_value.m_cont.GetFileName());
+    m_table = CentersTable::Load(*m_mapping, codingParams);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LDEBUG, ("Can't map centers table:", e.Msg()));
+  }
+
+  if (m_table)
+  {
+    m_state = STATE_LOADED;
+    return;
+  }
+  m_mapping.reset();
+
   m_reader = m_value.m_cont.GetReader(CENTERS_FILE_TAG);
   if (!m_reader.GetPtr())
   {
@@ -31,7 +52,7 @@ void LazyCentersTable::EnsureTableLoaded()
     return;
   }
 
-  m_table = CentersTable::Load(*m_reader.GetPtr(), m_value.GetHeader().GetDefCodingParams());
+  m_table = CentersTable::Load(*m_reader.GetPtr(), codingParams);
   if (m_table)
     m_state = STATE_LOADED;
   else
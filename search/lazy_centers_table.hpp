@@ -34,6 +34,11 @@ private:
   MwmValue & m_value;
   State m_state;
 
+  // The centers section is memory-mapped when the mwm is a regular
+  // file, so centers are decoded right from the mapped pages, which
+  // are shared by all search threads. Otherwise the section is read
+  // via |m_reader|.
+  unique_ptr<FilesMappingContainer> m_mapping;
   FilesContainerR::TReader m_reader;
   unique_ptr<CentersTable> m_table;
 };
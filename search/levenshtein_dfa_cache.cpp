@@ -0,0 +1,47 @@
+#include "search/levenshtein_dfa_cache.hpp"
+
+#include "search/utils.hpp"
+
+#include "base/assert.hpp"
+
+namespace search
+{
+LevenshteinDFACache::LevenshteinDFACache(size_t maxEntries) : m_maxEntries(maxEntries)
+{
+  CHECK_GREATER(m_maxEntries, 0, ());
+}
+
+strings::LevenshteinDFA LevenshteinDFACache::Get(strings::UniString const & s)
+{
+  return Get(s, GetMaxErrorsForToken(s));
+}
+
+strings::LevenshteinDFA LevenshteinDFACache::Get(strings::UniString const & s, size_t maxErrors)
+{
+  Key key(s, maxErrors);
+  auto const it = m_entries.find(key);
+  if (it != m_entries.end())
+  {
+    m_lru.splice(m_lru.begin(), m_lru, it->second.m_lruIt);
+    return it->second.m_dfa;
+  }
+
+  if (m_entries.size() == m_maxEntries)
+  {
+    ASSERT(!m_lru.empty(), ());
+    m_entries.erase(m_lru.back());
+    m_lru.pop_back();
+  }
+
+  strings::LevenshteinDFA const dfa(s, 1 /* prefixCharsToKeep */, maxErrors);
+  m_lru.push_front(key);
+  m_entries.emplace(move(key), Entry(dfa, m_lru.begin()));
+  return dfa;
+}
+
+void LevenshteinDFACache::Clear()
+{
+  m_lru.clear();
+  m_entries.clear();
+}
+}  // namespace search
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "base/levenshtein_dfa.hpp"
+#include "base/string_utils.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/list.hpp"
+#include "std/map.hpp"
+#include "std/utility.hpp"
+
+namespace search
+{
+// This class represents an LRU cache of LevenshteinDFAs built for
+// query tokens. In search-as-you-type most tokens of a query are the
+// tokens of the previous query, and building of a DFA for a long
+// token is much more expensive than a copy of a cached one, as copies
+// share the transition table.
+//
+// *NOTE* This class is not thread-safe.
+class LevenshteinDFACache
+{
+public:
+  explicit LevenshteinDFACache(size_t maxEntries);
+
+  // Returns a DFA for |s| with GetMaxErrorsForToken(s) errors, where
+  // the first letter is assumed to be correct, see
+  // BuildLevenshteinDFA().
+  strings::LevenshteinDFA Get(strings::UniString const & s);
+  strings::LevenshteinDFA Get(strings::UniString const & s, size_t maxErrors);
+
+  void Clear();
+
+  inline size_t GetNumEntries() const { return m_entries.size(); }
+
+private:
+  using Key = pair<strings::UniString, size_t>;
+
+  struct Entry
+  {
+    Entry(strings::LevenshteinDFA const & dfa, list<Key>::iterator lruIt)
+      : m_dfa(dfa), m_lruIt(lruIt)
+    {
+    }
+
+    strings::LevenshteinDFA m_dfa;
+    list<Key>::iterator m_lruIt;
+  };
+
+  // Keys from the most recently used to the least recently used one.
+  list<Key> m_lru;
+  map<Key, Entry> m_entries;
+  size_t const m_maxEntries;
+};
+}  // namespace search
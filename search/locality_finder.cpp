@@ -10,8 +10,10 @@
 #include "indexer/index.hpp"
 
 #include "base/assert.hpp"
+#include "base/checked_cast.hpp"
 #include "base/stl_helpers.hpp"
 
+#include <cmath>
 #include <vector>
 
 using namespace std;
@@ -23,59 +25,18 @@ namespace
 double const kMaxCityRadiusMeters = 30000.0;
 double const kMaxVillageRadiusMeters = 2000.0;
 
-struct Filter
-{
-public:
-  virtual ~Filter() = default;
-  virtual bool IsGood(uint32_t id) const = 0;
-};
-
-class CityFilter : public Filter
-{
-public:
-  CityFilter(RankTable const & ranks) : m_ranks(ranks) {}
-
-  // Filter overrides:
-  bool IsGood(uint32_t id) const override { return m_ranks.Get(id) != 0; }
-
-private:
-  RankTable const & m_ranks;
-};
-
-class VillageFilter : public Filter
-{
-public:
-  VillageFilter(MwmContext const & ctx, VillagesCache & villages) : m_cbv(villages.Get(ctx)) {}
-
-  // Filter overrides:
-  bool IsGood(uint32_t id) const override { return m_cbv.HasBit(id); }
-
-private:
-  CBV m_cbv;
-};
-
 class LocalitiesLoader
 {
 public:
-  LocalitiesLoader(MwmContext const & ctx, Filter const & filter, LocalityFinder::Holder & holder,
-                   map<MwmSet::MwmId, unordered_set<uint32_t>> & loadedIds)
-    : m_ctx(ctx)
-    , m_filter(filter)
-    , m_holder(holder)
-    , m_loadedIds(loadedIds[m_ctx.GetId()])
+  LocalitiesLoader(MwmContext const & ctx, LocalityFinder::Holder & holder)
+    : m_ctx(ctx), m_holder(holder)
   {
   }
 
-  void operator()(uint32_t id) const
+  void operator()(uint64_t id) const
   {
-    if (!m_filter.IsGood(id))
-      return;
-
-    if (m_loadedIds.count(id) != 0)
-      return;
-
     FeatureType ft;
-    if (!m_ctx.GetFeature(id, ft))
+    if (!m_ctx.GetFeature(base::asserted_cast<uint32_t>(id), ft))
       return;
 
     if (ft.GetFeatureType() != feature::GEOM_POINT)
@@ -100,15 +61,11 @@ public:
     auto const center = ft.GetCenter();
 
     m_holder.Add(LocalityItem(names, center, population));
-    m_loadedIds.insert(id);
   }
 
 private:
   MwmContext const & m_ctx;
-  Filter const & m_filter;
-
   LocalityFinder::Holder & m_holder;
-  unordered_set<uint32_t> & m_loadedIds;
 };
 }  // namespace
 
@@ -147,29 +104,44 @@ void LocalitySelector::operator()(LocalityItem const & item)
 }
 
 // LocalityFinder::Holder --------------------------------------------------------------------------
-LocalityFinder::Holder::Holder(double radiusMeters) : m_radiusMeters(radiusMeters) {}
-
-bool LocalityFinder::Holder::IsCovered(m2::RectD const & rect) const
-{
-  bool covered = false;
-  m_coverage.ForEachInRect(rect, [&covered](bool) { covered = true; });
-  return covered;
-}
-
-void LocalityFinder::Holder::SetCovered(m2::PointD const & p)
+LocalityFinder::Holder::Holder(double radiusMeters)
+  : m_radiusMeters(radiusMeters)
+  , m_cellSize(MercatorBounds::RectByCenterXYAndSizeInMeters(m2::PointD(), radiusMeters).SizeX())
 {
-  m_coverage.Add(true, m2::RectD(p, p));
+  ASSERT_GREATER(m_cellSize, 0.0, ());
 }
 
 void LocalityFinder::Holder::Add(LocalityItem const & item)
 {
-  m_localities.Add(item, m2::RectD(item.m_center, item.m_center));
+  auto const cellId = GetCellId(ToCellCoord(item.m_center.x), ToCellCoord(item.m_center.y));
+  m_cells[cellId].push_back(base::asserted_cast<uint32_t>(m_localities.size()));
+  m_localities.push_back(item);
 }
 
 void LocalityFinder::Holder::ForEachInVicinity(m2::RectD const & rect,
                                                LocalitySelector & selector) const
 {
-  m_localities.ForEachInRect(rect, selector);
+  int64_t const minX = ToCellCoord(rect.minX());
+  int64_t const maxX = ToCellCoord(rect.maxX());
+  int64_t const minY = ToCellCoord(rect.minY());
+  int64_t const maxY = ToCellCoord(rect.maxY());
+
+  for (int64_t x = minX; x <= maxX; ++x)
+  {
+    for (int64_t y = minY; y <= maxY; ++y)
+    {
+      auto const it = m_cells.find(GetCellId(x, y));
+      if (it == m_cells.end())
+        continue;
+
+      for (auto const i : it->second)
+      {
+        auto const & item = m_localities[i];
+        if (rect.IsPointInside(item.m_center))
+          selector(item);
+      }
+    }
+  }
 }
 
 m2::RectD LocalityFinder::Holder::GetRect(m2::PointD const & p) const
@@ -177,15 +149,20 @@ m2::RectD LocalityFinder::Holder::GetRect(m2::PointD const & p) const
   return MercatorBounds::RectByCenterXYAndSizeInMeters(p, m_radiusMeters);
 }
 
-m2::RectD LocalityFinder::Holder::GetDRect(m2::PointD const & p) const
+void LocalityFinder::Holder::Clear()
 {
-  return MercatorBounds::RectByCenterXYAndSizeInMeters(p, 2 * m_radiusMeters);
+  m_localities.clear();
+  m_cells.clear();
 }
 
-void LocalityFinder::Holder::Clear()
+uint64_t LocalityFinder::Holder::GetCellId(int64_t x, int64_t y) const
+{
+  return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+int64_t LocalityFinder::Holder::ToCellCoord(double c) const
 {
-  m_coverage.Clear();
-  m_localities.Clear();
+  return static_cast<int64_t>(floor(c / m_cellSize));
 }
 
 // LocalityFinder ----------------------------------------------------------------------------------
@@ -195,12 +172,12 @@ LocalityFinder::LocalityFinder(Index const & index, VillagesCache & villagesCach
   , m_cities(kMaxCityRadiusMeters)
   , m_villages(kMaxVillageRadiusMeters)
   , m_mapsLoaded(false)
+  , m_citiesLoaded(false)
 {
 }
 
 void LocalityFinder::ClearCache()
 {
-  m_ranks.reset();
   m_cities.Clear();
   m_villages.Clear();
 
@@ -208,47 +185,47 @@ void LocalityFinder::ClearCache()
   m_worldId.Reset();
   m_mapsLoaded = false;
 
-  m_loadedIds.clear();
+  m_citiesLoaded = false;
+  m_villagesLoaded.clear();
 }
 
-void LocalityFinder::LoadVicinity(m2::PointD const & p, bool loadCities, bool loadVillages)
+void LocalityFinder::LoadVicinity(m2::PointD const & p)
 {
   UpdateMaps();
 
-  if (loadCities)
+  if (!m_citiesLoaded)
   {
-    m2::RectD const crect = m_cities.GetDRect(p);
     auto handle = m_index.GetMwmHandleById(m_worldId);
     if (handle.IsAlive())
     {
       auto const & value = *handle.GetValue<MwmValue>();
-      if (!m_ranks)
-        m_ranks = RankTable::Load(value.m_cont);
-      if (!m_ranks)
-        m_ranks = make_unique<DummyRankTable>();
+      unique_ptr<RankTable> ranks = RankTable::Load(value.m_cont);
+      if (!ranks)
+        ranks = make_unique<DummyRankTable>();
 
       MwmContext ctx(move(handle));
-      ctx.ForEachIndex(crect, LocalitiesLoader(ctx, CityFilter(*m_ranks), m_cities, m_loadedIds));
+      LocalitiesLoader loader(ctx, m_cities);
+      ctx.ForEachIndex(MercatorBounds::FullRect(), [&](uint32_t id) {
+        if (ranks->Get(id) != 0)
+          loader(id);
+      });
     }
 
-    m_cities.SetCovered(p);
+    m_citiesLoaded = true;
   }
 
-  if (loadVillages)
-  {
-    m2::RectD const vrect = m_villages.GetDRect(p);
-    m_maps.ForEachInRect(m2::RectD(p, p), [&](MwmSet::MwmId const & id) {
-      auto handle = m_index.GetMwmHandleById(id);
-      if (!handle.IsAlive())
-        return;
+  m_maps.ForEachInRect(m2::RectD(p, p), [&](MwmSet::MwmId const & id) {
+    if (m_villagesLoaded.count(id) != 0)
+      return;
 
-      MwmContext ctx(move(handle));
-      ctx.ForEachIndex(vrect, LocalitiesLoader(ctx, VillageFilter(ctx, m_villagesCache), m_villages,
-                                               m_loadedIds));
-    });
+    auto handle = m_index.GetMwmHandleById(id);
+    if (!handle.IsAlive())
+      return;
 
-    m_villages.SetCovered(p);
-  }
+    MwmContext ctx(move(handle));
+    m_villagesCache.Get(ctx).ForEach(LocalitiesLoader(ctx, m_villages));
+    m_villagesLoaded.insert(id);
+  });
 }
 
 void LocalityFinder::UpdateMaps()
@@ -13,10 +13,11 @@
 
 #include <cstdint>
 #include <limits>
-#include <map>
 #include <memory>
-#include <unordered_set>
+#include <set>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 class Index;
 
@@ -64,29 +65,36 @@ private:
   LocalityItem const * m_bestLocality = nullptr;
 };
 
+// Finds the best locality for a point, e.g. for an address of a search
+// result. All cities of the World are loaded on the first call, and all
+// villages of a country mwm are loaded on the first call for a point in
+// the mwm, so following calls don't read features at all.
 class LocalityFinder
 {
 public:
+  // Localities of a kind with a uniform grid over them. Cells of the
+  // grid are about the max radius of localities.
   class Holder
   {
   public:
     Holder(double radiusMeters);
 
-    bool IsCovered(m2::RectD const & rect) const;
-    void SetCovered(m2::PointD const & p);
-
     void Add(LocalityItem const & item);
     void ForEachInVicinity(m2::RectD const & rect, LocalitySelector & selector) const;
 
     m2::RectD GetRect(m2::PointD const & p) const;
-    m2::RectD GetDRect(m2::PointD const & p) const;
 
     void Clear();
 
   private:
+    uint64_t GetCellId(int64_t x, int64_t y) const;
+    int64_t ToCellCoord(double c) const;
+
     double const m_radiusMeters;
-    m4::Tree<bool> m_coverage;
-    m4::Tree<LocalityItem> m_localities;
+    double const m_cellSize;
+
+    std::vector<LocalityItem> m_localities;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> m_cells;
 
     DISALLOW_COPY_AND_MOVE(Holder);
   };
@@ -96,15 +104,11 @@ public:
   template <typename Fn>
   bool GetLocality(m2::PointD const & p, Fn && fn)
   {
-    m2::RectD const crect = m_cities.GetRect(p);
-    m2::RectD const vrect = m_villages.GetRect(p);
-
-    LoadVicinity(p, !m_cities.IsCovered(crect) /* loadCities */,
-                 !m_villages.IsCovered(vrect) /* loadVillages */);
+    LoadVicinity(p);
 
     LocalitySelector selector(p);
-    m_cities.ForEachInVicinity(crect, selector);
-    m_villages.ForEachInVicinity(vrect, selector);
+    m_cities.ForEachInVicinity(m_cities.GetRect(p), selector);
+    m_villages.ForEachInVicinity(m_villages.GetRect(p), selector);
 
     return selector.WithBestLocality(std::forward<Fn>(fn));
   }
@@ -112,7 +116,9 @@ public:
   void ClearCache();
 
 private:
-  void LoadVicinity(m2::PointD const & p, bool loadCities, bool loadVillages);
+  // Loads cities if they are not loaded yet, and villages of mwms
+  // covering |p| which are not loaded yet.
+  void LoadVicinity(m2::PointD const & p);
   void UpdateMaps();
 
   Index const & m_index;
@@ -125,8 +131,7 @@ private:
   MwmSet::MwmId m_worldId;
   bool m_mapsLoaded;
 
-  std::unique_ptr<RankTable> m_ranks;
-
-  std::map<MwmSet::MwmId, std::unordered_set<uint32_t>> m_loadedIds;
+  bool m_citiesLoaded;
+  std::set<MwmSet::MwmId> m_villagesLoaded;
 };
 }  // namespace search
@@ -7,8 +7,9 @@
 #include "base/checked_cast.hpp"
 
 #include <algorithm>
+#include <functional>
 #include <sstream>
-#include <unordered_set>
+#include <unordered_map>
 
 namespace search
 {
@@ -50,6 +51,10 @@ void LocalityScorer::GetTopLocalities(MwmSet::MwmId const & countryId, BaseConte
 
   localities.clear();
 
+  // Only the candidate with the largest number of tokens is kept for
+  // each feature, therefore positions of candidates are stored here.
+  std::unordered_map<uint32_t, size_t> candidates;
+
   for (size_t startToken = 0; startToken < ctx.m_numTokens; ++startToken)
   {
     CBV intersection = filter.Intersect(ctx.m_features[startToken]);
@@ -64,11 +69,15 @@ void LocalityScorer::GetTopLocalities(MwmSet::MwmId const & countryId, BaseConte
       // Skip locality candidates that match only numbers.
       if (!m_params.IsNumberTokens(tokenRange))
       {
+        double const prob = static_cast<double>(intersection.PopCount()) /
+                            static_cast<double>(unfilteredIntersection.PopCount());
         intersection.ForEach([&](uint64_t bit) {
           auto const featureId = base::asserted_cast<uint32_t>(bit);
-          double const prob = static_cast<double>(intersection.PopCount()) /
-                              static_cast<double>(unfilteredIntersection.PopCount());
-          localities.emplace_back(countryId, featureId, tokenRange, prob);
+          auto const it = candidates.emplace(featureId, localities.size());
+          if (it.second)
+            localities.emplace_back(countryId, featureId, tokenRange, prob);
+          else if (localities[it.first->second].m_tokenRange.Size() < tokenRange.Size())
+            localities[it.first->second] = Locality(countryId, featureId, tokenRange, prob);
         });
       }
 
@@ -93,7 +102,12 @@ void LocalityScorer::LeaveTopLocalities(size_t limit, std::vector<Locality> & lo
   for (auto const & locality : localities)
     ls.emplace_back(locality);
 
-  RemoveDuplicates(ls);
+  // Candidates are ordered by their features, so ties in the following
+  // sorts are resolved in favour of smaller feature ids.
+  std::sort(ls.begin(), ls.end(), [](ExLocality const & lhs, ExLocality const & rhs) {
+    return lhs.GetId() < rhs.GetId();
+  });
+
   LeaveTopByRankAndProb(std::max(limit, kDefaultReadLimit), ls);
   SortByNameAndProb(ls);
   if (ls.size() > limit)
@@ -105,25 +119,31 @@ void LocalityScorer::LeaveTopLocalities(size_t limit, std::vector<Locality> & lo
     localities.push_back(l.m_locality);
 }
 
-void LocalityScorer::RemoveDuplicates(std::vector<ExLocality> & ls) const
-{
-  std::sort(ls.begin(), ls.end(), [](ExLocality const & lhs, ExLocality const & rhs) {
-    if (lhs.GetId() != rhs.GetId())
-      return lhs.GetId() < rhs.GetId();
-    return lhs.m_numTokens > rhs.m_numTokens;
-  });
-  ls.erase(std::unique(ls.begin(), ls.end(),
-                       [](ExLocality const & lhs, ExLocality const & rhs) {
-                         return lhs.GetId() == rhs.GetId();
-                       }),
-           ls.end());
-}
-
 void LocalityScorer::LeaveTopByRankAndProb(size_t limit, std::vector<ExLocality> & ls) const
 {
   if (ls.size() <= limit)
     return;
 
+  if (limit == 0)
+  {
+    ls.clear();
+    return;
+  }
+
+  // Ranks are compared only when probabilities are equal, so ranks are
+  // loaded only for candidates which are not less probable than the
+  // |limit|-th one.
+  std::vector<double> probs;
+  probs.reserve(ls.size());
+  for (auto const & l : ls)
+    probs.push_back(l.m_locality.m_prob);
+  std::nth_element(probs.begin(), probs.begin() + (limit - 1), probs.end(),
+                   std::greater<double>());
+  double const minProb = probs[limit - 1];
+  ls.erase(std::remove_if(ls.begin(), ls.end(),
+                          [&](ExLocality const & l) { return l.m_locality.m_prob < minProb; }),
+           ls.end());
+
   for (auto & l : ls)
     l.m_rank = m_delegate.GetRank(l.GetId());
 
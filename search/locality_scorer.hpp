@@ -54,7 +54,6 @@ private:
   // combination of ranks and number of matched tokens.
   void LeaveTopLocalities(size_t limit, std::vector<Locality> & localities) const;
 
-  void RemoveDuplicates(std::vector<ExLocality> & ls) const;
   void LeaveTopByRankAndProb(size_t limit, std::vector<ExLocality> & ls) const;
   void SortByNameAndProb(std::vector<ExLocality> & ls) const;
 
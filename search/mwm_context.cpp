@@ -45,4 +45,14 @@ bool MwmContext::GetStreetIndex(uint32_t houseId, uint32_t & streetId)
   }
   return m_houseToStreetTable->Get(houseId, streetId);
 }
+
+StreetsHousesTable const * MwmContext::GetStreetsHousesTable()
+{
+  if (!m_streetsHousesTableLoaded)
+  {
+    m_streetsHousesTable = StreetsHousesTable::Load(m_value);
+    m_streetsHousesTableLoaded = true;
+  }
+  return m_streetsHousesTable.get();
+}
 }  // namespace search
@@ -2,6 +2,7 @@
 
 #include "search/house_to_street_table.hpp"
 #include "search/lazy_centers_table.hpp"
+#include "search/streets_houses_table.hpp"
 
 #include "indexer/features_vector.hpp"
 #include "indexer/index.hpp"
@@ -71,6 +72,15 @@ public:
 
   WARN_UNUSED_RESULT bool GetStreetIndex(uint32_t houseId, uint32_t & streetId);
 
+  // Returns nullptr if the mwm has no precomputed streets-houses table.
+  StreetsHousesTable const * GetStreetsHousesTable();
+
+  // Returns true if the feature was modified, created or deleted in the editor.
+  inline bool IsEdited(uint32_t index) const
+  {
+    return GetEditedStatus(index) != osm::Editor::FeatureStatus::Untouched;
+  }
+
   WARN_UNUSED_RESULT inline bool GetCenter(uint32_t index, m2::PointD & center)
   {
     return m_centers.Get(index, center);
@@ -89,19 +99,20 @@ private:
   void ForEachIndexImpl(covering::IntervalsT const & intervals, uint32_t scale, TFn && fn) const
   {
     CheckUniqueIndexes checkUnique(m_value.GetHeader().GetFormat() >= version::Format::v5);
-    for (auto const & i : intervals)
-      m_index.ForEachInIntervalAndScale(
-          [&](uint32_t index)
-          {
-            if (checkUnique(index))
-              fn(index);
-          },
-          i.first, i.second, scale);
+    m_index.ForEachInIntervalsAndScale(
+        [&](uint32_t index)
+        {
+          if (checkUnique(index))
+            fn(index);
+        },
+        intervals, scale);
   }
 
   FeaturesVector m_vector;
   ScaleIndex<ModelReaderPtr> m_index;
   unique_ptr<HouseToStreetTable> m_houseToStreetTable;
+  unique_ptr<StreetsHousesTable> m_streetsHousesTable;
+  bool m_streetsHousesTableLoaded = false;
   LazyCentersTable m_centers;
 
   DISALLOW_COPY_AND_MOVE(MwmContext);
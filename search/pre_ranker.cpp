@@ -51,10 +51,12 @@ struct ComparePreResult1
 void SweepNearbyResults(double eps, vector<PreResult1> & results)
 {
   m2::NearbyPointsSweeper sweeper(eps);
+  sweeper.Reserve(results.size());
   for (size_t i = 0; i < results.size(); ++i)
   {
-    auto const & p = results[i].GetInfo().m_center;
-    sweeper.Add(p.x, p.y, i);
+    // Results with higher ranks survive in favour of nearby ones.
+    auto const & info = results[i].GetInfo();
+    sweeper.Add(info.m_center.x, info.m_center.y, i, info.m_rank);
   }
 
   vector<PreResult1> filtered;
@@ -198,10 +200,17 @@ void PreRanker::Filter(bool viewportSearch)
   m_results.assign(filtered.begin(), filtered.end());
 }
 
-void PreRanker::UpdateResults(bool lastUpdate)
+void PreRanker::UpdateResults(bool lastUpdate, StageTimes * stageTimes)
 {
+  lock_guard<mutex> lock(m_mutex);
+  ScopedStage stage(stageTimes, SearchStage::Ranking);
+  m_ranker.SetStageTimes(stageTimes);
+
   FillMissingFieldsInPreResults();
-  Filter(m_viewportSearch);
+  {
+    ScopedStage filterStage(stageTimes, SearchStage::PreRankerFilter);
+    Filter(m_viewportSearch);
+  }
   m_numSentResults += m_results.size();
   m_ranker.SetPreResults1(move(m_results));
   m_results.clear();
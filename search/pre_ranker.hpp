@@ -3,6 +3,7 @@
 #include "search/intermediate_result.hpp"
 #include "search/nested_rects_cache.hpp"
 #include "search/ranker.hpp"
+#include "search/search_stats.hpp"
 
 #include "indexer/index.hpp"
 
@@ -13,6 +14,7 @@
 
 #include "std/algorithm.hpp"
 #include "std/cstdint.hpp"
+#include "std/mutex.hpp"
 #include "std/random.hpp"
 #include "std/set.hpp"
 #include "std/utility.hpp"
@@ -21,6 +23,9 @@
 namespace search
 {
 // Fast and simple pre-ranker for search results.
+//
+// NOTE: Emplace(), UpdateResults() and NumSentResults() may be called
+// from several geocoder threads at once.
 class PreRanker
 {
 public:
@@ -54,6 +59,7 @@ public:
   template <typename... TArgs>
   void Emplace(TArgs &&... args)
   {
+    lock_guard<mutex> lock(m_mutex);
     if (m_numSentResults >= m_limit)
       return;
     m_results.emplace_back(forward<TArgs>(args)...);
@@ -66,12 +72,17 @@ public:
 
   // Emit a new batch of results up the pipeline (i.e. to ranker).
   // Use lastUpdate in geocoder to indicate that
-  // no more results will be added.
-  void UpdateResults(bool lastUpdate);
+  // no more results will be added. Times of ranking stages are added
+  // to |stageTimes| of the calling thread, it may be nullptr.
+  void UpdateResults(bool lastUpdate, StageTimes * stageTimes = nullptr);
 
   inline size_t Size() const { return m_results.size(); }
   inline size_t BatchSize() const { return m_params.m_batchSize; }
-  inline size_t NumSentResults() const { return m_numSentResults; }
+  inline size_t NumSentResults() const
+  {
+    lock_guard<mutex> lock(m_mutex);
+    return m_numSentResults;
+  }
   inline size_t Limit() const { return m_limit; }
 
   template <typename TFn>
@@ -109,6 +120,9 @@ private:
 
   minstd_rand m_rng;
 
+  // Guards |m_results|, |m_numSentResults| and the ranker from concurrent geocoder threads.
+  mutable mutex m_mutex;
+
   DISALLOW_COPY_AND_MOVE(PreRanker);
 };
 }  // namespace search
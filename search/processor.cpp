@@ -189,6 +189,8 @@ Processor::Processor(Index const & index, CategoriesHolder const & categories,
   , m_geocoder(index, infoGetter, m_preRanker, m_villagesCache,
                static_cast<my::Cancellable const &>(*this))
 {
+  m_geocoder.SetStageTimes(&m_stageTimes);
+
   // Initialize keywords scorer.
   // Note! This order should match the indexes arrays above.
   vector<vector<int8_t>> langPriorities = {
@@ -420,6 +422,8 @@ void Processor::ForEachCategoryTypeFuzzy(StringSliceBase const & slice, ToDo &&
 
 void Processor::Search(SearchParams const & params, m2::RectD const & viewport)
 {
+  m_stageTimes.Reset();
+
   if (params.m_onStarted)
     params.m_onStarted();
 
@@ -461,10 +465,14 @@ void Processor::Search(SearchParams const & params, m2::RectD const & viewport)
   SetSuggestsEnabled(params.m_suggestsEnabled);
   m_hotelsFilter = params.m_hotelsFilter;
   m_cianMode = params.m_cianMode;
+  m_progressiveResults = params.m_progressiveResults;
 
   SetInputLocale(params.m_inputLocale);
 
-  SetQuery(params.m_query);
+  {
+    ScopedStage stage(&m_stageTimes, SearchStage::Tokenization);
+    SetQuery(params.m_query);
+  }
   SetViewport(viewport, true /* forceUpdate */);
   SetOnResults(params.m_onResults);
 
@@ -490,6 +498,8 @@ void Processor::Search(SearchParams const & params, m2::RectD const & viewport)
       m_geocoder.GoEverywhere();
     }
 
+    ScopedStage stage(&m_stageTimes, SearchStage::Ranking);
+    m_ranker.SetStageTimes(&m_stageTimes);
     m_ranker.UpdateResults(true /* lastUpdate */);
   }
   catch (CancelException const &)
@@ -570,6 +580,7 @@ void Processor::InitGeocoder(Geocoder::Params & params)
     params.m_pivot = GetPivotRect();
   params.m_hotelsFilter = m_hotelsFilter;
   params.m_cianMode = m_cianMode;
+  params.m_progressiveResults = m_progressiveResults;
   params.m_preferredTypes = m_preferredTypes;
 
   m_geocoder.SetParams(params);
@@ -621,6 +632,7 @@ void Processor::InitRanker(Geocoder::Params const & geocoderParams)
   params.m_accuratePivotCenter = GetPivotPoint();
   params.m_viewportSearch = viewportSearch;
   m_ranker.Init(params, geocoderParams);
+  m_ranker.SetStageTimes(&m_stageTimes);
 }
 
 void Processor::InitEmitter() { m_emitter.Init(m_onResults); }
@@ -9,6 +9,7 @@
 #include "search/rank_table_cache.hpp"
 #include "search/ranker.hpp"
 #include "search/search_params.hpp"
+#include "search/search_stats.hpp"
 #include "search/search_trie.hpp"
 #include "search/suggest.hpp"
 #include "search/token_slice.hpp"
@@ -91,8 +92,21 @@ public:
     m_minDistanceOnMapBetweenResults = distance;
   }
   inline void SetOnResults(SearchParams::TOnResults const & onResults) { m_onResults = onResults; }
+  // Sets the number of threads which process mwms of a single query.
+  inline void SetNumGeocoderThreads(size_t numThreads) { m_geocoder.SetNumThreads(numThreads); }
+  inline void SetRankingModel(shared_ptr<RankingModel const> model)
+  {
+    m_ranker.SetRankingModel(model);
+  }
+  // Sets the cache of features in rects which is shared by all processors.
+  inline void SetSharedGeometryCache(shared_ptr<SharedGeometryCache> cache)
+  {
+    m_geocoder.SetSharedGeometryCache(cache);
+  }
   inline string const & GetPivotRegion() const { return m_region; }
   inline m2::PointD const & GetPosition() const { return m_position; }
+  // Returns times of stages of the last query.
+  inline StageTimes const & GetStageTimes() const { return m_stageTimes; }
 
   /// Suggestions language code, not the same as we use in mwm data
   int8_t m_inputLocaleCode, m_currentLocaleCode;
@@ -165,6 +179,7 @@ protected:
   bool m_suggestsEnabled;
   shared_ptr<hotels_filter::Rule> m_hotelsFilter;
   bool m_cianMode = false;
+  bool m_progressiveResults = false;
   SearchParams::TOnResults m_onResults;
 
   /// @name Get ranking params.
@@ -181,6 +196,8 @@ protected:
 
   VillagesCache m_villagesCache;
 
+  StageTimes m_stageTimes;
+
   Emitter m_emitter;
   Ranker m_ranker;
   PreRanker m_preRanker;
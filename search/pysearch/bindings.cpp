@@ -1,5 +1,6 @@
 #include "search/engine.hpp"
 #include "search/processor_factory.hpp"
+#include "search/reverse_geocoder.hpp"
 #include "search/search_tests_support/test_search_engine.hpp"
 #include "search/search_tests_support/test_search_request.hpp"
 
@@ -20,8 +21,14 @@
 
 #include "base/logging.hpp"
 
+#include "pyhelpers/gil.hpp"
+#include "pyhelpers/vector_list_conversion.hpp"
+#include "pyhelpers/vector_uint8.hpp"
+
 #include <boost/python.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <sstream>
@@ -148,17 +155,47 @@ struct Result
   Mercator m_center;
 };
 
+struct Address
+{
+  Address() = default;
+
+  Address(search::ReverseGeocoder::Address const & a)
+    : m_street(a.GetStreetName()), m_houseNumber(a.GetHouseNumber()), m_distance(a.GetDistance())
+  {
+  }
+
+  string ToString() const
+  {
+    ostringstream os;
+    os << m_street << ", " << m_houseNumber << " [ " << m_distance << " ]";
+    return os.str();
+  }
+
+  string m_street;
+  string m_houseNumber;
+  // Distance in meters to the building, negative when nothing is found.
+  double m_distance = -1.0;
+};
+
+// Max number of queries which are started but are not finished yet in a batch,
+// per thread of the engine. It bounds memory used by results of large batches.
+size_t constexpr kMaxQueriesInFlightPerThread = 4;
+
 struct SearchEngineProxy
 {
-  SearchEngineProxy()
+  SearchEngineProxy() : SearchEngineProxy(1 /* numThreads */) {}
+
+  explicit SearchEngineProxy(size_t numThreads) : m_numThreads(max<size_t>(numThreads, 1))
   {
     CHECK(g_storage.get() != nullptr, ("init() was not called."));
     auto & platform = GetPlatform();
     auto infoGetter = storage::CountryInfoReader::CreateCountryInfoReader(platform);
     infoGetter->InitAffiliationsInfo(&g_storage->GetAffiliations());
 
+    search::Engine::Params engineParams;
+    engineParams.m_numThreads = m_numThreads;
     m_engine = make_shared<search::tests_support::TestSearchEngine>(
-        move(infoGetter), make_unique<search::ProcessorFactory>(), search::Engine::Params{});
+        move(infoGetter), make_unique<search::ProcessorFactory>(), engineParams);
 
     vector<platform::LocalCountryFile> mwms;
     platform::FindAllLocalMapsAndCleanup(numeric_limits<int64_t>::max() /* the latest version */,
@@ -174,6 +211,98 @@ struct SearchEngineProxy
   {
     m_engine->SetLocale(params.m_locale);
 
+    search::tests_support::TestSearchRequest request(*m_engine, MakeSearchParams(params),
+                                                     MakeViewport(params));
+    request.Run();
+
+    boost::python::list results;
+    for (auto const & result : request.Results())
+      results.append(Result(result));
+    return results;
+  }
+
+  // Runs |paramsList| queries on all threads of the engine with the GIL released.
+  // Returns a list of lists of results in the order of queries.
+  boost::python::list QueryBatch(boost::python::object const & paramsList) const
+  {
+    auto const params = python_list_to_std_vector<Params>(paramsList);
+    vector<vector<search::Result>> batchResults(params.size());
+
+    {
+      scoped_gil_release release;
+
+      using Request = search::tests_support::TestSearchRequest;
+      size_t const maxInFlight = m_numThreads * kMaxQueriesInFlightPerThread;
+      vector<unique_ptr<Request>> requests(params.size());
+      string locale;
+      size_t finished = 0;
+      for (size_t i = 0; i < params.size(); ++i)
+      {
+        if (i == 0 || params[i].m_locale != locale)
+        {
+          // Engine messages are processed in order, so the locale is changed
+          // between the queries.
+          locale = params[i].m_locale;
+          m_engine->SetLocale(locale);
+        }
+
+        requests[i] = make_unique<Request>(*m_engine, MakeSearchParams(params[i]),
+                                           MakeViewport(params[i]));
+        requests[i]->Start();
+
+        for (; finished + maxInFlight <= i; ++finished)
+          Finish(requests[finished], batchResults[finished]);
+      }
+      for (; finished < params.size(); ++finished)
+        Finish(requests[finished], batchResults[finished]);
+    }
+
+    boost::python::list results;
+    for (auto const & queryResults : batchResults)
+    {
+      boost::python::list list;
+      for (auto const & result : queryResults)
+        list.append(Result(result));
+      results.append(list);
+    }
+    return results;
+  }
+
+  // Finds addresses of points from |pointsBlob| on all threads of the engine with
+  // the GIL released. The blob contains mercator (x, y) pairs of native doubles,
+  // i.e. it's numpy.array(points, dtype=numpy.float64).tobytes().
+  boost::python::list ReverseGeocodeBatch(vector<uint8_t> const & pointsBlob) const
+  {
+    if (pointsBlob.size() % (2 * sizeof(double)) != 0)
+    {
+      PyErr_SetString(PyExc_ValueError, "Points blob must contain pairs of doubles.");
+      boost::python::throw_error_already_set();
+    }
+
+    vector<m2::PointD> points(pointsBlob.size() / (2 * sizeof(double)));
+    vector<search::ReverseGeocoder::Address> addrs;
+    {
+      scoped_gil_release release;
+
+      for (size_t i = 0; i < points.size(); ++i)
+      {
+        double xy[2];
+        memcpy(xy, pointsBlob.data() + i * sizeof(xy), sizeof(xy));
+        points[i] = m2::PointD(xy[0], xy[1]);
+      }
+
+      search::ReverseGeocoder const coder(*m_engine);
+      coder.GetNearbyAddresses(points, m_numThreads, addrs);
+    }
+
+    boost::python::list results;
+    for (auto const & addr : addrs)
+      results.append(Address(addr));
+    return results;
+  }
+
+  static search::SearchParams MakeSearchParams(Params const & params)
+  {
     search::SearchParams sp;
     sp.m_query = params.m_query;
     sp.m_inputLocale = params.m_locale;
@@ -181,19 +310,25 @@ struct SearchEngineProxy
     sp.SetPosition(MercatorBounds::YToLat(params.m_position.m_y),
                    MercatorBounds::XToLon(params.m_position.m_x));
     sp.m_suggestsEnabled = false;
+    return sp;
+  }
 
+  static m2::RectD MakeViewport(Params const & params)
+  {
     auto const & bottomLeft = params.m_viewport.m_min;
     auto const & topRight = params.m_viewport.m_max;
-    m2::RectD const viewport(bottomLeft.m_x, bottomLeft.m_y, topRight.m_x, topRight.m_y);
-    search::tests_support::TestSearchRequest request(*m_engine, sp, viewport);
-    request.Run();
+    return m2::RectD(bottomLeft.m_x, bottomLeft.m_y, topRight.m_x, topRight.m_y);
+  }
 
-    boost::python::list results;
-    for (auto const & result : request.Results())
-      results.append(Result(result));
-    return results;
+  static void Finish(unique_ptr<search::tests_support::TestSearchRequest> & request,
+                     vector<search::Result> & results)
+  {
+    request->Wait();
+    results = request->Results();
+    request.reset();
   }
 
+  size_t m_numThreads;
   shared_ptr<search::tests_support::TestSearchEngine> m_engine;
 };
 }  // namespace
@@ -202,6 +337,10 @@ BOOST_PYTHON_MODULE(pysearch)
 {
   using namespace boost::python;
 
+  // Register the converters of numpy-compatible buffers.
+  to_python_converter<vector<uint8_t>, vector_uint8t_to_str>();
+  vector_uint8t_from_python_str();
+
   def("init", &Init);
 
   class_<Mercator>("Mercator")
@@ -230,5 +369,15 @@ BOOST_PYTHON_MODULE(pysearch)
       .def_readwrite("center", &Result::m_center)
       .def("to_string", &Result::ToString);
 
-  class_<SearchEngineProxy>("SearchEngine").def("query", &SearchEngineProxy::Query);
+  class_<Address>("Address")
+      .def_readwrite("street", &Address::m_street)
+      .def_readwrite("house_number", &Address::m_houseNumber)
+      .def_readwrite("distance", &Address::m_distance)
+      .def("to_string", &Address::ToString);
+
+  class_<SearchEngineProxy>("SearchEngine")
+      .def(init<size_t>())
+      .def("query", &SearchEngineProxy::Query)
+      .def("query_batch", &SearchEngineProxy::QueryBatch)
+      .def("reverse_geocode_batch", &SearchEngineProxy::ReverseGeocodeBatch);
 }
@@ -1,6 +1,7 @@
 #include "search/ranker.hpp"
 
 #include "search/emitter.hpp"
+#include "search/feature_loader.hpp"
 #include "search/string_intersection.hpp"
 #include "search/token_slice.hpp"
 #include "search/utils.hpp"
@@ -167,17 +168,14 @@ public:
 class PreResult2Maker
 {
   Ranker & m_ranker;
-  Index const & m_index;
   Geocoder::Params const & m_params;
   storage::CountryInfoGetter const & m_infoGetter;
 
-  unique_ptr<Index::FeaturesLoaderGuard> m_loader;
+  FeatureLoader m_loader;
 
   bool LoadFeature(FeatureID const & id, FeatureType & ft)
   {
-    if (!m_loader || m_loader->GetId() != id.m_mwmId)
-      m_loader = make_unique<Index::FeaturesLoaderGuard>(m_index, id.m_mwmId);
-    if (!m_loader->GetFeatureByIndex(id.m_index, ft))
+    if (!m_loader.Load(id, ft))
       return false;
 
     ft.SetID(id);
@@ -188,19 +186,21 @@ class PreResult2Maker
   bool LoadFeature(FeatureID const & id, FeatureType & ft, m2::PointD & center, string & name,
                    string & country)
   {
-    if (!LoadFeature(id, ft))
+    // Only the header, names and metadata of |ft| are needed for
+    // ranking, so the center is taken from the centers table instead
+    // of decoding of the feature geometry.
+    if (!m_loader.Load(id, ft, center))
       return false;
 
-    center = feature::GetCenter(ft);
+    ft.SetID(id);
     m_ranker.GetBestMatchName(ft, name);
 
     // Country (region) name is a file name if feature isn't from
     // World.mwm.
-    ASSERT(m_loader && m_loader->GetId() == id.m_mwmId, ());
-    if (m_loader->IsWorld())
+    if (m_loader.IsWorld())
       country.clear();
     else
-      country = m_loader->GetCountryFileName();
+      country = m_loader.GetCountryFileName();
 
     return true;
   }
@@ -290,7 +290,10 @@ public:
   explicit PreResult2Maker(Ranker & ranker, Index const & index,
                            storage::CountryInfoGetter const & infoGetter,
                            Geocoder::Params const & params)
-    : m_ranker(ranker), m_index(index), m_params(params), m_infoGetter(infoGetter)
+    : m_ranker(ranker)
+    , m_params(params)
+    , m_infoGetter(infoGetter)
+    , m_loader(index)
   {
   }
 
@@ -356,6 +359,7 @@ bool Ranker::IsResultExists(PreResult2 const & p, vector<IndexedValue> const & v
 void Ranker::MakePreResult2(Geocoder::Params const & geocoderParams, vector<IndexedValue> & cont)
 {
   PreResult2Maker maker(*this, m_index, m_infoGetter, geocoderParams);
+  size_t const numOldValues = cont.size();
   for (auto const & r : m_preResults1)
   {
     auto p = maker(r);
@@ -371,10 +375,27 @@ void Ranker::MakePreResult2(Geocoder::Params const & geocoderParams, vector<Inde
     if (!IsResultExists(*p, cont))
       cont.push_back(IndexedValue(move(p)));
   };
+
+  if (!m_rankingModel || m_rankingModel->IsEmpty() || cont.size() == numOldValues)
+    return;
+
+  size_t const numNewValues = cont.size() - numOldValues;
+  m_features.resize(numNewValues * RankingModel::FEATURE_COUNT);
+  m_scores.resize(numNewValues);
+  for (size_t i = 0; i < numNewValues; ++i)
+  {
+    RankingModel::GetFeatures((*cont[numOldValues + i]).GetRankingInfo(),
+                              &m_features[i * RankingModel::FEATURE_COUNT]);
+  }
+  m_rankingModel->Score(m_features.data(), numNewValues, m_scores.data());
+  for (size_t i = 0; i < numNewValues; ++i)
+    cont[numOldValues + i].SetRank(m_scores[i]);
 }
 
 Result Ranker::MakeResult(PreResult2 const & r) const
 {
+  ScopedStage stage(m_stageTimes, SearchStage::RankerMakeResult);
+
   Result res = r.GenerateFinalResult(m_infoGetter, &m_categories, &m_params.m_preferredTypes,
                                      m_params.m_currentLocaleCode, &m_reverseGeocoder);
   MakeResultHighlight(res);
@@ -6,9 +6,11 @@
 #include "search/keyword_lang_matcher.hpp"
 #include "search/locality_finder.hpp"
 #include "search/mode.hpp"
+#include "search/ranking_model.hpp"
 #include "search/result.hpp"
 #include "search/reverse_geocoder.hpp"
 #include "search/search_params.hpp"
+#include "search/search_stats.hpp"
 #include "search/suggest.hpp"
 #include "search/utils.hpp"
 
@@ -21,6 +23,7 @@
 #include "base/string_utils.hpp"
 
 #include "std/set.hpp"
+#include "std/shared_ptr.hpp"
 #include "std/string.hpp"
 #include "std/utility.hpp"
 #include "std/vector.hpp"
@@ -119,6 +122,14 @@ public:
     m_keywordsScorer.SetKeywords(keywords, count, prefix);
   }
 
+  // Times of ranking stages are added to |stageTimes|, it may be
+  // nullptr. It should be set by the thread which calls
+  // UpdateResults() before the call.
+  inline void SetStageTimes(StageTimes * stageTimes) { m_stageTimes = stageTimes; }
+
+  // Results are ranked by |model| instead of the linear model if it's not empty.
+  inline void SetRankingModel(shared_ptr<RankingModel const> model) { m_rankingModel = model; }
+
   inline void BailIfCancelled() { ::search::BailIfCancelled(m_cancellable); }
 
 private:
@@ -141,5 +152,12 @@ private:
 
   vector<PreResult1> m_preResults1;
   vector<IndexedValue> m_tentativeResults;
+
+  StageTimes * m_stageTimes = nullptr;
+
+  shared_ptr<RankingModel const> m_rankingModel;
+  // Buffers for batch scoring of new results by |m_rankingModel|.
+  vector<float> m_features;
+  vector<double> m_scores;
 };
 }  // namespace search
@@ -0,0 +1,178 @@
+#include "search/ranking_model.hpp"
+
+#include "search/model.hpp"
+#include "search/ranking_info.hpp"
+#include "search/ranking_utils.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <sstream>
+
+using namespace std;
+
+namespace search
+{
+namespace
+{
+// Reads the next token which is not a part of a comment.
+bool ReadToken(istream & is, string & token)
+{
+  while (is >> token)
+  {
+    if (token[0] != '#')
+      return true;
+    is.ignore(numeric_limits<streamsize>::max(), '\n');
+  }
+  return false;
+}
+
+template <typename T>
+bool ReadValue(istream & is, T & value)
+{
+  string token;
+  if (!ReadToken(is, token))
+    return false;
+  istringstream ss(token);
+  return static_cast<bool>(ss >> value) && ss.eof();
+}
+}  // namespace
+
+// static
+uint16_t constexpr RankingModel::kLeaf;
+
+// static
+void RankingModel::GetFeatures(RankingInfo const & info, float * features)
+{
+  fill(features, features + FEATURE_COUNT, 0.0f);
+
+  features[FEATURE_DISTANCE_TO_PIVOT] = static_cast<float>(
+      min(info.m_distanceToPivot, RankingInfo::kMaxDistMeters) / RankingInfo::kMaxDistMeters);
+  features[FEATURE_RANK] =
+      static_cast<float>(info.m_rank) / static_cast<float>(numeric_limits<uint8_t>::max());
+  features[FEATURE_FALSE_CATS] = info.m_falseCats ? 1.0f : 0.0f;
+  features[FEATURE_ERRORS_MADE] = static_cast<float>(info.GetErrorsMade());
+
+  // See RankingInfo::GetLinearModelRank().
+  auto nameScore = info.m_nameScore;
+  if (info.m_pureCats || info.m_falseCats)
+    nameScore = NAME_SCORE_ZERO;
+  features[FEATURE_NAME_SCORE_ZERO + nameScore] = 1.0f;
+
+  // scoring_model.py trains models with buildings unified with POIs.
+  auto type = info.m_type;
+  if (type == Model::TYPE_BUILDING)
+    type = Model::TYPE_POI;
+  if (type < Model::TYPE_COUNT)
+    features[FEATURE_TYPE_POI + type] = 1.0f;
+}
+
+bool RankingModel::Load(string const & path)
+{
+  ifstream is(path);
+  if (!is)
+  {
+    LOG(LWARNING, ("Can't open ranking model", path));
+    return false;
+  }
+  if (!Load(is))
+  {
+    LOG(LWARNING, ("Malformed ranking model", path));
+    return false;
+  }
+  return true;
+}
+
+bool RankingModel::Load(istream & is)
+{
+  Clear();
+
+  string token;
+  while (ReadToken(is, token))
+  {
+    bool ok = false;
+    if (token == "bias")
+    {
+      ok = ReadValue(is, m_bias);
+    }
+    else if (token == "tree")
+    {
+      uint32_t numNodes = 0;
+      ok = ReadValue(is, numNodes) && numNodes != 0 && ReadTree(is, numNodes);
+    }
+
+    if (!ok)
+    {
+      Clear();
+      return false;
+    }
+  }
+  return true;
+}
+
+bool RankingModel::ReadTree(istream & is, uint32_t numNodes)
+{
+  string token;
+  for (uint32_t i = 0; i < numNodes; ++i)
+  {
+    Node node;
+    if (!ReadToken(is, token))
+      return false;
+
+    if (token == "leaf")
+    {
+      if (!ReadValue(is, node.m_threshold))
+        return false;
+    }
+    else if (token == "split")
+    {
+      if (!ReadValue(is, node.m_feature) || node.m_feature >= FEATURE_COUNT ||
+          !ReadValue(is, node.m_threshold) || !ReadValue(is, node.m_right))
+      {
+        return false;
+      }
+
+      // Children follow their parent, so evaluation of a tree always terminates.
+      if (node.m_right <= i + 1 || node.m_right >= numNodes)
+        return false;
+    }
+    else
+    {
+      return false;
+    }
+    m_nodes.push_back(node);
+  }
+
+  m_treeOffsets.push_back(static_cast<uint32_t>(m_nodes.size()));
+  return true;
+}
+
+double RankingModel::Score(float const * features) const
+{
+  double score = m_bias;
+  for (size_t i = 0; i < GetNumTrees(); ++i)
+    score += EvalTree(i, features);
+  return score;
+}
+
+void RankingModel::Score(float const * features, size_t count, double * scores) const
+{
+  fill(scores, scores + count, m_bias);
+  for (size_t i = 0; i < GetNumTrees(); ++i)
+  {
+    for (size_t j = 0; j < count; ++j)
+      scores[j] += EvalTree(i, features + j * FEATURE_COUNT);
+  }
+}
+
+void RankingModel::Clear()
+{
+  m_bias = 0.0;
+  m_nodes.clear();
+  m_treeOffsets.assign(1, 0);
+}
+}  // namespace search
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace search
+{
+struct RankingInfo;
+
+// Ensemble of regression trees (e.g. gradient boosted trees trained by
+// search/search_quality/scoring_model.py) which ranks results instead of
+// RankingInfo::GetLinearModelRank(). Large values correspond to important features.
+//
+// Nodes of all trees are kept in a single array in preorder, so the left child of a split
+// is the next node and only the index of the right child is stored. A node takes 12 bytes and
+// a tree of depth 6 fits in a few cache lines.
+//
+// Text format of a model file, tokens are separated by whitespaces, '#' starts a comment:
+// bias <value>
+// tree <number of nodes>
+// then the nodes of the tree in preorder, one per line:
+// split <feature index> <threshold> <index of the right child in the tree>
+// leaf <value>
+// and so on for all the trees. A split sends features less than the threshold to the left.
+class RankingModel
+{
+public:
+  // Features in the order of FEATURES in scoring_model.py.
+  enum Feature
+  {
+    FEATURE_DISTANCE_TO_PIVOT,
+    FEATURE_RANK,
+    FEATURE_FALSE_CATS,
+    FEATURE_ERRORS_MADE,
+    FEATURE_NAME_SCORE_ZERO,
+    FEATURE_NAME_SCORE_SUBSTRING,
+    FEATURE_NAME_SCORE_PREFIX,
+    FEATURE_NAME_SCORE_FULL_MATCH,
+    FEATURE_TYPE_POI,
+    FEATURE_TYPE_BUILDING,
+    FEATURE_TYPE_STREET,
+    FEATURE_TYPE_UNCLASSIFIED,
+    FEATURE_TYPE_VILLAGE,
+    FEATURE_TYPE_CITY,
+    FEATURE_TYPE_STATE,
+    FEATURE_TYPE_COUNTRY,
+
+    FEATURE_COUNT
+  };
+
+  // Writes FEATURE_COUNT features of |info| to |features|, they are normalized in the same way
+  // as the features of the linear model.
+  static void GetFeatures(RankingInfo const & info, float * features);
+
+  // Returns false and leaves the model empty if the file can't be read or is malformed.
+  bool Load(std::string const & path);
+  bool Load(std::istream & is);
+
+  bool IsEmpty() const { return m_treeOffsets.size() <= 1; }
+  size_t GetNumTrees() const { return IsEmpty() ? 0 : m_treeOffsets.size() - 1; }
+
+  double Score(float const * features) const;
+
+  // Scores |count| feature vectors of FEATURE_COUNT features each, laid out one by one in
+  // |features|. Trees are evaluated one by one over all the vectors, so every tree
+  // stays in cache while it is in use.
+  void Score(float const * features, size_t count, double * scores) const;
+
+private:
+  static uint16_t constexpr kLeaf = 0xFFFF;
+
+  struct Node
+  {
+    // Value of a leaf.
+    float m_threshold = 0.0;
+    // Index of the right child relative to the first node of the tree.
+    uint32_t m_right = 0;
+    uint16_t m_feature = kLeaf;
+  };
+
+  float EvalTree(size_t tree, float const * features) const
+  {
+    Node const * const root = &m_nodes[m_treeOffsets[tree]];
+    Node const * node = root;
+    while (node->m_feature != kLeaf)
+      node = features[node->m_feature] < node->m_threshold ? node + 1 : root + node->m_right;
+    return node->m_threshold;
+  }
+
+  // Appends a tree of |numNodes| nodes to the model.
+  bool ReadTree(std::istream & is, uint32_t numNodes);
+  void Clear();
+
+  double m_bias = 0.0;
+  std::vector<Node> m_nodes;
+  // Nodes of tree i are [m_treeOffsets[i], m_treeOffsets[i + 1]) of |m_nodes|.
+  std::vector<uint32_t> m_treeOffsets = {0};
+};
+}  // namespace search
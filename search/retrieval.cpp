@@ -1,6 +1,7 @@
 #include "retrieval.hpp"
 
 #include "search/cancel_exception.hpp"
+#include "search/category_bitmaps_table.hpp"
 #include "search/feature_offset_match.hpp"
 #include "search/interval_set.hpp"
 #include "search/mwm_context.hpp"
@@ -176,7 +177,7 @@ bool MatchFeatureByNameAndType(FeatureType const & ft, SearchTrieRequest<DFA> co
 
 bool MatchFeatureByPostcode(FeatureType const & ft, TokenSlice const & slice)
 {
-  string const postcode = ft.GetMetadata().Get(feature::Metadata::FMD_POSTCODE);
+  string const postcode = ft.GetMetadataField(feature::Metadata::FMD_POSTCODE);
   vector<UniString> tokens;
   NormalizeAndTokenizeString(postcode, tokens, Delimiters());
   if (slice.Size() > tokens.size())
@@ -244,6 +245,31 @@ unique_ptr<coding::CompressedBitVector> RetrievePostcodeFeaturesImpl(
   return SortFeaturesAndBuildCBV(move(features));
 }
 
+unique_ptr<coding::CompressedBitVector> RetrieveCategoryFeaturesImpl(
+    MwmContext const & context, my::Cancellable const & cancellable,
+    CategoryBitmapsTable const & table, vector<uint32_t> const & types,
+    SearchTrieRequest<UniStringDFA> const & request)
+{
+  EditedFeaturesHolder holder(context.GetId());
+  vector<uint64_t> features;
+  FeaturesCollector collector(cancellable, features);
+
+  for (auto const type : types)
+  {
+    table.ForEachFeature(type, [&](uint64_t featureIndex) {
+      if (!holder.ModifiedOrDeleted(base::asserted_cast<uint32_t>(featureIndex)))
+        collector(featureIndex);
+    });
+  }
+
+  holder.ForEachModifiedOrCreated([&](FeatureType & ft, uint64_t index) {
+    if (MatchFeatureByNameAndType(ft, request))
+      features.push_back(index);
+  });
+
+  return SortFeaturesAndBuildCBV(move(features));
+}
+
 unique_ptr<coding::CompressedBitVector> RetrieveGeometryFeaturesImpl(
     MwmContext const & context, my::Cancellable const & cancellable, m2::RectD const & rect,
     int scale)
@@ -347,6 +373,13 @@ unique_ptr<coding::CompressedBitVector> Retrieval::RetrievePostcodeFeatures(
   return Retrieve<RetrievePostcodeFeaturesAdaptor>(slice);
 }
 
+unique_ptr<coding::CompressedBitVector> Retrieval::RetrieveCategoryFeatures(
+    CategoryBitmapsTable const & table, vector<uint32_t> const & types,
+    SearchTrieRequest<UniStringDFA> const & request)
+{
+  return RetrieveCategoryFeaturesImpl(m_context, m_cancellable, table, types, request);
+}
+
 unique_ptr<coding::CompressedBitVector> Retrieval::RetrieveGeometryFeatures(m2::RectD const & rect,
                                                                             int scale)
 {
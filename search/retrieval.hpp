@@ -14,6 +14,7 @@
 #include "base/levenshtein_dfa.hpp"
 
 #include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
 
 class MwmValue;
 
@@ -24,6 +25,7 @@ class CompressedBitVector;
 
 namespace search
 {
+class CategoryBitmapsTable;
 class MwmContext;
 class TokenSlice;
 
@@ -53,6 +55,13 @@ public:
   // postcodes matching to |slice|.
   unique_ptr<coding::CompressedBitVector> RetrievePostcodeFeatures(TokenSlice const & slice);
 
+  // Retrieves features of |types| from |table|, which must have all of them, instead of
+  // the search index. Edited features are matched with |request| like by
+  // RetrieveAddressFeatures(), so |request| should have categories of |types| only.
+  unique_ptr<coding::CompressedBitVector> RetrieveCategoryFeatures(
+      CategoryBitmapsTable const & table, vector<uint32_t> const & types,
+      SearchTrieRequest<strings::UniStringDFA> const & request);
+
   // Retrieves from the geometry index corresponding to |value| all features belonging to |rect|.
   unique_ptr<coding::CompressedBitVector> RetrieveGeometryFeatures(m2::RectD const & rect,
                                                                    int scale);
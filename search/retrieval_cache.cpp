@@ -0,0 +1,83 @@
+#include "search/retrieval_cache.hpp"
+
+#include "base/assert.hpp"
+
+namespace search
+{
+namespace
+{
+// Approximate memory used by a cache entry besides its bit vector.
+uint64_t constexpr kEntryOverheadBytes = 128;
+}  // namespace
+
+uint64_t EstimateBytes(coding::CompressedBitVector const * features)
+{
+  if (!features)
+    return 0;
+
+  switch (features->GetStorageStrategy())
+  {
+  case coding::CompressedBitVector::StorageStrategy::Dense:
+    return static_cast<coding::DenseCBV const *>(features)->NumBitGroups() * sizeof(uint64_t);
+  case coding::CompressedBitVector::StorageStrategy::Sparse:
+    return features->PopCount() * sizeof(uint64_t);
+  }
+  return 0;
+}
+
+// RetrievalCache ----------------------------------------------------------------------------------
+RetrievalCache::RetrievalCache(uint64_t maxBytes) : m_maxBytes(maxBytes) {}
+
+// static
+uint64_t RetrievalCache::EstimateBytes(string const & key,
+                                       coding::CompressedBitVector const * features)
+{
+  return kEntryOverheadBytes + key.size() + search::EstimateBytes(features);
+}
+
+void RetrievalCache::RemoveDeadMwms()
+{
+  for (auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    if (it->first.first.IsAlive())
+      ++it;
+    else
+      Erase(it++);
+  }
+}
+
+void RetrievalCache::Clear()
+{
+  m_lru.clear();
+  m_entries.clear();
+  m_bytes = 0;
+}
+
+void RetrievalCache::Insert(Key && key, CBV const & cbv, uint64_t bytes)
+{
+  if (bytes > m_maxBytes)
+    return;
+
+  while (m_bytes + bytes > m_maxBytes)
+  {
+    ASSERT(!m_lru.empty(), ());
+    Erase(m_entries.find(m_lru.back()));
+  }
+
+  m_lru.push_front(key);
+  auto & entry = m_entries[move(key)];
+  entry.m_cbv = cbv;
+  entry.m_bytes = bytes;
+  entry.m_lruIt = m_lru.begin();
+  m_bytes += bytes;
+}
+
+void RetrievalCache::Erase(map<Key, Entry>::iterator it)
+{
+  ASSERT(it != m_entries.end(), ());
+  ASSERT_GREATER_OR_EQUAL(m_bytes, it->second.m_bytes, ());
+  m_bytes -= it->second.m_bytes;
+  m_lru.erase(it->second.m_lruIt);
+  m_entries.erase(it);
+}
+}  // namespace search
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "search/cbv.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "coding/compressed_bit_vector.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/list.hpp"
+#include "std/map.hpp"
+#include "std/string.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/utility.hpp"
+
+namespace search
+{
+// Returns an estimate of memory used by |features|, which may be nullptr.
+uint64_t EstimateBytes(coding::CompressedBitVector const * features);
+
+// This class represents an LRU cache of features retrieved from the
+// search index for tokens of queries. The cache is not cleared
+// between queries, so in search-as-you-type the tokens a user has
+// already typed are retrieved once per mwm for a sequence of
+// queries. The cache is limited by the estimated size of bit vectors
+// in bytes. Entries of deregistered mwms are dropped by
+// RemoveDeadMwms().
+//
+// *NOTE* This class is not thread-safe.
+class RetrievalCache
+{
+public:
+  explicit RetrievalCache(uint64_t maxBytes);
+
+  // Returns features of the token |key| in the mwm |id|. Calls |fn|
+  // to retrieve them when there is no cached entry, |fn| should
+  // return unique_ptr<coding::CompressedBitVector>.
+  template <typename TFn>
+  CBV Get(MwmSet::MwmId const & id, string const & key, TFn && fn)
+  {
+    Key k(id, key);
+    auto const it = m_entries.find(k);
+    if (it != m_entries.end())
+    {
+      m_lru.splice(m_lru.begin(), m_lru, it->second.m_lruIt);
+      return it->second.m_cbv;
+    }
+
+    unique_ptr<coding::CompressedBitVector> features = fn();
+    uint64_t const bytes = EstimateBytes(k.second, features.get());
+    CBV cbv(move(features));
+    Insert(move(k), cbv, bytes);
+    return cbv;
+  }
+
+  void RemoveDeadMwms();
+  void Clear();
+
+  inline uint64_t GetBytes() const { return m_bytes; }
+  inline size_t GetNumEntries() const { return m_entries.size(); }
+
+private:
+  using Key = pair<MwmSet::MwmId, string>;
+
+  struct Entry
+  {
+    CBV m_cbv;
+    uint64_t m_bytes = 0;
+    list<Key>::iterator m_lruIt;
+  };
+
+  static uint64_t EstimateBytes(string const & key, coding::CompressedBitVector const * features);
+
+  void Insert(Key && key, CBV const & cbv, uint64_t bytes);
+  void Erase(map<Key, Entry>::iterator it);
+
+  // Keys from the most recently used to the least recently used one.
+  list<Key> m_lru;
+  map<Key, Entry> m_entries;
+  uint64_t m_bytes = 0;
+  uint64_t const m_maxBytes;
+};
+}  // namespace search
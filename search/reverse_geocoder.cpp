@@ -2,6 +2,7 @@
 
 #include "search/mwm_context.hpp"
 
+#include "indexer/cell_id.hpp"
 #include "indexer/feature.hpp"
 #include "indexer/feature_algo.hpp"
 #include "indexer/ftypes_matcher.hpp"
@@ -9,8 +10,14 @@
 #include "indexer/scales.hpp"
 #include "indexer/search_string_utils.hpp"
 
+#include "geometry/distance.hpp"
+#include "geometry/triangle2d.hpp"
+
 #include "base/stl_helpers.hpp"
+#include "base/thread.hpp"
 
+#include "std/algorithm.hpp"
+#include "std/atomic.hpp"
 #include "std/limits.hpp"
 
 namespace search
@@ -21,8 +28,74 @@ size_t constexpr kSimilarityThresholdPercent = 10;
 int constexpr kQueryScale = scales::GetUpperScale();
 /// Max number of tries (nearest houses with housenumber) to check when getting point address.
 size_t constexpr kMaxNumTriesToApproxAddress = 10;
+/// Points of a batch are grouped by cells of this level, a cell is about 1 km wide.
+int constexpr kBatchCellLevel = 15;
+
+using Converter = CellIdConverter<MercatorBounds, RectId>;
 } // namespace
 
+/// Buildings with house numbers are kept with their geometry to find distances to a lot of points
+/// without reloading the features.
+struct ReverseGeocoder::WorkingSet
+{
+  struct Item
+  {
+    Building m_building;
+    m2::RectD m_rect;
+    feature::EGeomType m_type = feature::GEOM_UNDEFINED;
+    // Center for points, polyline for lines, triangles for areas.
+    vector<m2::PointD> m_points;
+  };
+
+  /// The same as feature::GetMinDistanceMeters() with the best geometry.
+  static double GetMinDistanceMeters(Item const & item, m2::PointD const & pt)
+  {
+    double res = numeric_limits<double>::max();
+    auto const updateDistance = [&](m2::PointD const & p) {
+      double const d = MercatorBounds::DistanceOnEarth(p, pt);
+      if (d < res)
+        res = d;
+    };
+    auto const updateSectionDistance = [&](m2::PointD const & p1, m2::PointD const & p2) {
+      m2::ProjectionToSection<m2::PointD> calc;
+      calc.SetBounds(p1, p2);
+      updateDistance(calc(pt));
+    };
+
+    auto const & points = item.m_points;
+    switch (item.m_type)
+    {
+    case feature::GEOM_POINT:
+      ASSERT_EQUAL(points.size(), 1, ());
+      updateDistance(points[0]);
+      break;
+
+    case feature::GEOM_LINE:
+      for (size_t i = 1; i < points.size(); ++i)
+        updateSectionDistance(points[i - 1], points[i]);
+      break;
+
+    default:
+      ASSERT_EQUAL(item.m_type, feature::GEOM_AREA, ());
+      ASSERT_EQUAL(points.size() % 3, 0, ());
+      for (size_t i = 0; i + 2 < points.size(); i += 3)
+      {
+        if (m2::IsPointInsideTriangle(pt, points[i], points[i + 1], points[i + 2]))
+          return 0.0;
+
+        updateSectionDistance(points[i], points[i + 1]);
+        updateSectionDistance(points[i + 1], points[i + 2]);
+        updateSectionDistance(points[i + 2], points[i]);
+      }
+      break;
+    }
+    return res;
+  }
+
+  vector<Item> m_items;
+  map<FeatureID, vector<Street>> m_streets;
+};
+
 ReverseGeocoder::ReverseGeocoder(Index const & index) : m_index(index) {}
 
 void ReverseGeocoder::GetNearbyStreets(MwmSet::MwmId const & id, m2::PointD const & center,
@@ -125,6 +198,130 @@ void ReverseGeocoder::GetNearbyAddress(m2::PointD const & center, Address & addr
   }
 }
 
+void ReverseGeocoder::GetNearbyAddresses(vector<m2::PointD> const & points, size_t numThreads,
+                                         vector<Address> & addrs) const
+{
+  CHECK_GREATER(numThreads, 0, ());
+
+  addrs.assign(points.size(), Address());
+
+  // Groups of points by cells, in the order of cell ids, so neighbouring cells are close
+  // to each other in memory of the index.
+  map<int64_t, vector<size_t>> cells;
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    auto const cell = Converter::ToCellId(points[i].x, points[i].y).AncestorAtLevel(kBatchCellLevel);
+    cells[cell.ToInt64(RectId::DEPTH_LEVELS)].push_back(i);
+  }
+
+  vector<pair<m2::RectD, vector<size_t>>> groups;
+  groups.reserve(cells.size());
+  for (auto & kv : cells)
+  {
+    auto const cell = RectId::FromInt64(kv.first, RectId::DEPTH_LEVELS);
+    double minX, minY, maxX, maxY;
+    Converter::GetCellBounds(cell, minX, minY, maxX, maxY);
+    groups.emplace_back(m2::RectD(minX, minY, maxX, maxY), move(kv.second));
+  }
+
+  atomic<size_t> nextGroup(0);
+  auto const processGroups = [&]() {
+    HouseTable table(m_index);
+    for (size_t i = nextGroup++; i < groups.size(); i = nextGroup++)
+    {
+      auto const & group = groups[i];
+      if (group.second.size() == 1)
+      {
+        // It's cheaper to load the buildings around an isolated point only.
+        size_t const id = group.second.front();
+        GetNearbyAddress(points[id], addrs[id]);
+      }
+      else
+      {
+        GetNearbyAddresses(points, group.second, group.first, table, addrs);
+      }
+    }
+  };
+
+  vector<threads::SimpleThread> threads;
+  threads.reserve(numThreads - 1);
+  for (size_t i = 1; i < numThreads; ++i)
+    threads.emplace_back(processGroups);
+
+  processGroups();
+
+  for (auto & thread : threads)
+    thread.join();
+}
+
+void ReverseGeocoder::GetNearbyAddresses(vector<m2::PointD> const & points,
+                                         vector<size_t> const & ids, m2::RectD const & rect,
+                                         HouseTable & table, vector<Address> & addrs) const
+{
+  WorkingSet set;
+
+  m2::RectD lookupRect = rect;
+  lookupRect.Add(GetLookupRect(rect.LeftBottom(), kLookupRadiusM));
+  lookupRect.Add(GetLookupRect(rect.RightTop(), kLookupRadiusM));
+
+  auto const addBuilding = [&](FeatureType & ft) {
+    if (ft.GetHouseNumber().empty())
+      return;
+
+    WorkingSet::Item item;
+    item.m_building = FromFeature(ft, 0.0 /* distMeters */);
+    item.m_type = ft.GetFeatureType();
+    switch (item.m_type)
+    {
+    case feature::GEOM_POINT: item.m_points.push_back(ft.GetCenter()); break;
+    case feature::GEOM_LINE:
+      ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
+      for (size_t i = 0; i < ft.GetPointsCount(); ++i)
+        item.m_points.push_back(ft.GetPoint(i));
+      break;
+    default:
+      ft.ForEachTriangle(
+          [&item](m2::PointD const & p1, m2::PointD const & p2, m2::PointD const & p3) {
+            item.m_points.push_back(p1);
+            item.m_points.push_back(p2);
+            item.m_points.push_back(p3);
+          },
+          FeatureType::BEST_GEOMETRY);
+      break;
+    }
+    item.m_rect = ft.GetLimitRect(FeatureType::BEST_GEOMETRY);
+    set.m_items.push_back(move(item));
+  };
+  m_index.ForEachInRect(addBuilding, lookupRect, kQueryScale);
+
+  vector<Building> buildings;
+  for (size_t const id : ids)
+  {
+    m2::PointD const & center = points[id];
+    m2::RectD const pointRect = GetLookupRect(center, kLookupRadiusM);
+
+    buildings.clear();
+    for (auto const & item : set.m_items)
+    {
+      if (!item.m_rect.IsIntersect(pointRect))
+        continue;
+      buildings.push_back(item.m_building);
+      buildings.back().m_distanceMeters = WorkingSet::GetMinDistanceMeters(item, center);
+    }
+    sort(buildings.begin(), buildings.end(), my::LessBy(&Building::m_distanceMeters));
+
+    size_t triesCount = 0;
+    for (auto const & b : buildings)
+    {
+      if (GetNearbyAddress(table, b, &set.m_streets, addrs[id]) ||
+          (++triesCount == kMaxNumTriesToApproxAddress))
+      {
+        break;
+      }
+    }
+  }
+}
+
 bool ReverseGeocoder::GetExactAddress(FeatureType const & ft, Address & addr) const
 {
   if (ft.GetHouseNumber().empty())
@@ -135,6 +332,13 @@ bool ReverseGeocoder::GetExactAddress(FeatureType const & ft, Address & addr) co
 
 bool ReverseGeocoder::GetNearbyAddress(HouseTable & table, Building const & bld,
                                        Address & addr) const
+{
+  return GetNearbyAddress(table, bld, nullptr /* streetsCache */, addr);
+}
+
+bool ReverseGeocoder::GetNearbyAddress(HouseTable & table, Building const & bld,
+                                       map<FeatureID, vector<Street>> * streetsCache,
+                                       Address & addr) const
 {
   string street;
   if (osm::Editor::Instance().GetEditedFeatureStreet(bld.m_id, street))
@@ -148,12 +352,30 @@ bool ReverseGeocoder::GetNearbyAddress(HouseTable & table, Building const & bld,
   if (!table.Get(bld.m_id, ind))
     return false;
 
-  vector<Street> streets;
-  GetNearbyStreets(bld.m_id.m_mwmId, bld.m_center, streets);
-  if (ind < streets.size())
+  vector<Street> localStreets;
+  vector<Street> * streets = &localStreets;
+  if (streetsCache)
+  {
+    auto const it = streetsCache->find(bld.m_id);
+    if (it != streetsCache->end())
+    {
+      streets = &it->second;
+    }
+    else
+    {
+      streets = &(*streetsCache)[bld.m_id];
+      GetNearbyStreets(bld.m_id.m_mwmId, bld.m_center, *streets);
+    }
+  }
+  else
+  {
+    GetNearbyStreets(bld.m_id.m_mwmId, bld.m_center, *streets);
+  }
+
+  if (ind < streets->size())
   {
     addr.m_building = bld;
-    addr.m_street = streets[ind];
+    addr.m_street = (*streets)[ind];
     return true;
   }
   else
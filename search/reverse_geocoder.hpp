@@ -4,8 +4,12 @@
 
 #include "indexer/feature_decl.hpp"
 
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
 #include "base/string_utils.hpp"
 
+#include "std/map.hpp"
 #include "std/string.hpp"
 #include "std/utility.hpp"
 #include "std/vector.hpp"
@@ -42,6 +46,10 @@ public:
   /// All "Nearby" functions work in this lookup radius.
   static int constexpr kLookupRadiusM = 500;
 
+  /// Max distance from house to street where we do search matching
+  /// even if there is no exact street written for this house.
+  static int constexpr kMaxApproxStreetDistanceM = 100;
+
   explicit ReverseGeocoder(Index const & index);
 
   using Street = Object;
@@ -89,6 +97,13 @@ public:
 
   /// @return The nearest exact address where building has house number and valid street match.
   void GetNearbyAddress(m2::PointD const & center, Address & addr) const;
+  /// Batch version of GetNearbyAddress() for a lot of points, |addrs| are in the order of |points|.
+  /// Points are grouped by cells, buildings and streets of a cell are loaded once for all its
+  /// points, and cells are processed in |numThreads| threads.
+  /// @note An address may differ from the GetNearbyAddress() one only when there is no address
+  /// among buildings in the lookup radius.
+  void GetNearbyAddresses(vector<m2::PointD> const & points, size_t numThreads,
+                          vector<Address> & addrs) const;
   /// @param addr (out) the exact address of a feature.
   /// @returns false if  can't extruct address or ft have no house number.
   bool GetExactAddress(FeatureType const & ft, Address & addr) const;
@@ -106,7 +121,18 @@ private:
     bool Get(FeatureID const & fid, uint32_t & streetIndex);
   };
 
+  /// Buildings of a cell with their geometry and streets of the buildings.
+  struct WorkingSet;
+
   bool GetNearbyAddress(HouseTable & table, Building const & bld, Address & addr) const;
+  /// @param streetsCache (in/out) nearby streets of buildings, may be nullptr.
+  bool GetNearbyAddress(HouseTable & table, Building const & bld,
+                        map<FeatureID, vector<Street>> * streetsCache, Address & addr) const;
+
+  /// Calls GetNearbyAddress() for |points| with indices |ids| which are in |rect|.
+  void GetNearbyAddresses(vector<m2::PointD> const & points, vector<size_t> const & ids,
+                          m2::RectD const & rect, HouseTable & table,
+                          vector<Address> & addrs) const;
 
   /// @return Sorted by distance houses vector with valid house number.
   void GetNearbyBuildings(m2::PointD const & center, vector<Building> & buildings) const;
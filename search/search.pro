@@ -14,11 +14,13 @@ HEADERS += \
     cancel_exception.hpp \
     categories_cache.hpp \
     categories_set.hpp \
+    category_bitmaps_table.hpp \
     cbv.hpp \
     cities_boundaries_table.hpp \
     city_finder.hpp \
     common.hpp \
     displayed_categories.hpp \
+    downloader_name_index.hpp \
     downloader_search_callback.hpp \
     dummy_rank_table.hpp \
     editor_delegate.hpp \
@@ -49,6 +51,7 @@ HEADERS += \
     keyword_matcher.hpp \
     latlon_match.hpp \
     lazy_centers_table.hpp \
+    levenshtein_dfa_cache.hpp \
     localities_source.hpp \
     locality_finder.hpp \
     locality_scorer.hpp \
@@ -67,16 +70,20 @@ HEADERS += \
     rank_table_cache.hpp \
     ranker.hpp \
     ranking_info.hpp \
+    ranking_model.hpp \
     ranking_utils.hpp \
     result.hpp \
     retrieval.hpp \
+    retrieval_cache.hpp \
     reverse_geocoder.hpp \
     search_index_values.hpp \
     search_params.hpp \
+    search_stats.hpp \
     search_trie.hpp \
     segment_tree.hpp \
     stats_cache.hpp \
     street_vicinity_loader.hpp \
+    streets_houses_table.hpp \
     streets_matcher.hpp \
     string_intersection.hpp \
     suggest.hpp \
@@ -90,9 +97,11 @@ HEADERS += \
 SOURCES += \
     approximate_string_match.cpp \
     categories_cache.cpp \
+    category_bitmaps_table.cpp \
     cbv.cpp \
     cities_boundaries_table.cpp \
     displayed_categories.cpp \
+    downloader_name_index.cpp \
     downloader_search_callback.cpp \
     dummy_rank_table.cpp \
     editor_delegate.cpp \
@@ -119,6 +128,7 @@ SOURCES += \
     keyword_matcher.cpp \
     latlon_match.cpp \
     lazy_centers_table.cpp \
+    levenshtein_dfa_cache.cpp \
     localities_source.cpp \
     locality_finder.cpp \
     locality_scorer.cpp \
@@ -135,13 +145,17 @@ SOURCES += \
     rank_table_cache.cpp \
     ranker.cpp \
     ranking_info.cpp \
+    ranking_model.cpp \
     ranking_utils.cpp \
     result.cpp \
     retrieval.cpp \
+    retrieval_cache.cpp \
     reverse_geocoder.cpp \
     search_params.cpp \
+    search_stats.cpp \
     segment_tree.cpp \
     street_vicinity_loader.cpp \
+    streets_houses_table.cpp \
     streets_matcher.cpp \
     token_slice.cpp \
     types_skipper.cpp \
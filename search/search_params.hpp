@@ -42,6 +42,10 @@ public:
   bool m_forceSearch = false;
   bool m_suggestsEnabled = true;
 
+  // When true, results which are found in the first mwm are sent before the rest of mwms around
+  // the pivot are processed. Results of the following updates are appended to them.
+  bool m_progressiveResults = false;
+
   shared_ptr<hotels_filter::Rule> m_hotelsFilter;
   bool m_cianMode = false;
 
@@ -4,6 +4,7 @@
 #include "search/search_quality/helpers.hpp"
 #include "search/search_quality/matcher.hpp"
 #include "search/search_quality/sample.hpp"
+#include "search/search_quality/throughput.hpp"
 #include "search/search_tests_support/test_search_engine.hpp"
 #include "search/search_tests_support/test_search_request.hpp"
 
@@ -23,6 +24,7 @@
 
 #include "base/macros.hpp"
 #include "base/string_utils.hpp"
+#include "base/timer.hpp"
 
 #include "std/fstream.hpp"
 #include "std/iostream.hpp"
@@ -43,6 +45,9 @@ DEFINE_string(data_path, "", "Path to data directory (resources dir)");
 DEFINE_string(mwm_path, "", "Path to mwm files (writable dir)");
 DEFINE_string(stats_path, "", "Path to store stats about queries results (default: stderr)");
 DEFINE_string(json_in, "", "Path to the json file with samples (default: stdin)");
+DEFINE_int32(num_threads, 1, "Number of search engine threads");
+DEFINE_bool(throughput, false,
+            "Replay samples at once through --num_threads search threads and report throughput");
 
 struct Stats
 {
@@ -151,7 +156,9 @@ int main(int argc, char * argv[])
   }
 
   classificator::Load();
-  TestSearchEngine engine(move(infoGetter), make_unique<ProcessorFactory>(), Engine::Params{});
+  Engine::Params engineParams;
+  engineParams.m_numThreads = FLAGS_num_threads;
+  TestSearchEngine engine(move(infoGetter), make_unique<ProcessorFactory>(), engineParams);
 
   vector<platform::LocalCountryFile> mwms;
   platform::FindAllLocalMapsAndCleanup(numeric_limits<int64_t>::max() /* the latest version */,
@@ -170,16 +177,44 @@ int main(int argc, char * argv[])
   RankingInfo::PrintCSVHeader(cout);
   cout << ",Relevance" << endl;
 
+  vector<unique_ptr<TestSearchRequest>> requests;
+  requests.reserve(samples.size());
+
+  uint64_t const numAllocations = GetNumAllocations();
+  my::Timer timer;
   for (size_t i = 0; i < samples.size(); ++i)
   {
     auto const & sample = samples[i];
 
-    engine.SetLocale(sample.m_locale);
+    // Locale is set for all the search threads, so all the requests in flight should be done
+    // before the locale is changed.
+    if (i == 0 || sample.m_locale != samples[i - 1].m_locale)
+    {
+      for (auto & request : requests)
+        request->Wait();
+      engine.SetLocale(sample.m_locale);
+    }
 
     search::SearchParams params;
     sample.FillSearchParams(params);
-    TestSearchRequest request(engine, params, sample.m_viewport);
-    request.Run();
+    requests.push_back(make_unique<TestSearchRequest>(engine, params, sample.m_viewport));
+    requests.back()->Start();
+    if (!FLAGS_throughput)
+      requests.back()->Wait();
+  }
+  for (auto & request : requests)
+    request->Wait();
+
+  ThroughputStats throughputStats;
+  throughputStats.m_elapsedSec = timer.ElapsedSeconds();
+  throughputStats.m_numAllocations = GetNumAllocations() - numAllocations;
+
+  for (size_t i = 0; i < samples.size(); ++i)
+  {
+    auto const & sample = samples[i];
+    auto const & request = *requests[i];
+    throughputStats.m_responseTimesSec.push_back(
+        duration_cast<duration<double>>(request.ResponseTime()).count());
 
     auto const & results = request.Results();
 
@@ -215,6 +250,7 @@ int main(int argc, char * argv[])
   if (FLAGS_stats_path.empty())
   {
     DisplayStats(cerr, samples, stats);
+    PrintThroughputStats(cerr, throughputStats);
   }
   else
   {
@@ -225,6 +261,7 @@ int main(int argc, char * argv[])
       return -1;
     }
     DisplayStats(ofs, samples, stats);
+    PrintThroughputStats(ofs, throughputStats);
   }
   return 0;
 }
@@ -14,8 +14,10 @@ HEADERS += \
     helpers.hpp \
     matcher.hpp \
     sample.hpp \
+    throughput.hpp \
 
 SOURCES += \
     helpers.cpp \
     matcher.cpp \
     sample.cpp \
+    throughput.cpp \
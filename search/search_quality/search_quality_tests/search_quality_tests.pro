@@ -15,6 +15,9 @@ include($$ROOT_DIR/common.pri)
 
 INCLUDEPATH += $$ROOT_DIR/3party/jansson/src
 
+# Allocations are counted by the search_quality library.
+DEFINES += OMIM_UNIT_TEST_DISABLE_ALLOCATION_COUNTING
+
 QT *= core
 
 macx-* {
@@ -28,5 +31,6 @@ win32*|linux* {
 SOURCES += \
     ../../../testing/testingmain.cpp \
     sample_test.cpp \
+    throughput_test.cpp \
 
 HEADERS += \
@@ -0,0 +1,33 @@
+#include "testing/testing.hpp"
+
+#include "search/search_quality/throughput.hpp"
+
+#include <vector>
+
+using namespace search;
+using namespace std;
+
+UNIT_TEST(Throughput_Quantiles)
+{
+  TEST_EQUAL(GetQuantile({}, 0.5), 0.0, ());
+
+  vector<double> values;
+  for (size_t i = 100; i > 0; --i)
+    values.push_back(static_cast<double>(i));
+
+  TEST_EQUAL(GetQuantile(values, 0.0), 1.0, ());
+  TEST_EQUAL(GetQuantile(values, 0.5), 50.0, ());
+  TEST_EQUAL(GetQuantile(values, 0.99), 99.0, ());
+  TEST_EQUAL(GetQuantile(values, 1.0), 100.0, ());
+}
+
+UNIT_TEST(Throughput_Allocations)
+{
+  uint64_t const before = GetNumAllocations();
+  // Pointers are volatile to keep allocations from being optimized out.
+  int * volatile a = new int(1);
+  int * volatile b = new int[10];
+  delete a;
+  delete[] b;
+  TEST_GREATER_OR_EQUAL(GetNumAllocations() - before, 2, ());
+}
@@ -10,8 +10,10 @@
 
 #include "search/processor_factory.hpp"
 #include "search/ranking_info.hpp"
+#include "search/ranking_model.hpp"
 #include "search/result.hpp"
 #include "search/search_quality/helpers.hpp"
+#include "search/search_quality/throughput.hpp"
 #include "search/search_tests_support/test_search_engine.hpp"
 #include "search/search_tests_support/test_search_request.hpp"
 
@@ -57,6 +59,7 @@ using namespace storage;
 DEFINE_string(data_path, "", "Path to data directory (resources dir)");
 DEFINE_string(locale, "en", "Locale of all the search queries");
 DEFINE_int32(num_threads, 1, "Number of search engine threads");
+DEFINE_int32(num_geocoder_threads, 1, "Number of threads which process mwms of a query");
 DEFINE_string(mwm_list_path, "",
               "Path to a file containing the names of available mwms, one per line");
 DEFINE_string(mwm_path, "", "Path to mwm files (writable dir)");
@@ -65,6 +68,12 @@ DEFINE_int32(top, 1, "Number of top results to show for every query");
 DEFINE_string(viewport, "", "Viewport to use when searching (default, moscow, london, zurich)");
 DEFINE_string(check_completeness, "", "Path to the file with completeness data");
 DEFINE_string(ranking_csv_file, "", "File ranking info will be exported to");
+DEFINE_string(ranking_model, "",
+              "Path to a ranking model file which ranks results instead of the linear model, "
+              "evaluation of the model is benchmarked against the linear model");
+DEFINE_bool(throughput, false,
+            "Replay all the queries at once through --num_threads search threads and report "
+            "throughput");
 
 map<string, m2::RectD> const kViewports = {
     {"default", m2::RectD(m2::PointD(0.0, 0.0), m2::PointD(1.0, 1.0))},
@@ -345,6 +354,44 @@ void CheckCompleteness(string const & path, m2::RectD const & viewport, TestSear
        << expectedResultsTop1Percentage << "%)." << endl;
 }
 
+// Evaluates the linear model and |model| over |infos| several times and prints the average
+// time per result.
+void BenchmarkRankingModel(RankingModel const & model, vector<RankingInfo> const & infos)
+{
+  if (infos.empty())
+    return;
+
+  size_t const kNumIterations = 100;
+  double const numEvaluations = static_cast<double>(kNumIterations * infos.size());
+
+  // Sums of ranks are printed, so the evaluations are not optimized out.
+  double linearSum = 0.0;
+  my::HighResTimer timer;
+  for (size_t i = 0; i < kNumIterations; ++i)
+  {
+    for (auto const & info : infos)
+      linearSum += info.GetLinearModelRank();
+  }
+  double const linearNs = static_cast<double>(timer.ElapsedNano()) / numEvaluations;
+
+  vector<float> features(infos.size() * RankingModel::FEATURE_COUNT);
+  vector<double> scores(infos.size());
+  double modelSum = 0.0;
+  timer.Reset();
+  for (size_t i = 0; i < kNumIterations; ++i)
+  {
+    for (size_t j = 0; j < infos.size(); ++j)
+      RankingModel::GetFeatures(infos[j], &features[j * RankingModel::FEATURE_COUNT]);
+    model.Score(features.data(), infos.size(), scores.data());
+    modelSum += accumulate(scores.begin(), scores.end(), 0.0);
+  }
+  double const modelNs = static_cast<double>(timer.ElapsedNano()) / numEvaluations;
+
+  cout << "Ranking of " << infos.size() << " results: linear model " << linearNs
+       << "ns per result (sum " << linearSum << "), " << model.GetNumTrees() << " trees "
+       << modelNs << "ns per result (sum " << modelSum << ")" << endl;
+}
+
 int main(int argc, char * argv[])
 {
   ChangeMaxNumberOfOpenFiles(kMaxOpenFiles);
@@ -378,7 +425,9 @@ int main(int argc, char * argv[])
   Engine::Params params;
   params.m_locale = FLAGS_locale;
   params.m_numThreads = FLAGS_num_threads;
-  TestSearchEngine engine(move(infoGetter), make_unique<ProcessorFactory>(), Engine::Params{});
+  params.m_numGeocoderThreads = FLAGS_num_geocoder_threads;
+  params.m_rankingModelPath = FLAGS_ranking_model;
+  TestSearchEngine engine(move(infoGetter), make_unique<ProcessorFactory>(), params);
 
   vector<platform::LocalCountryFile> mwms;
   if (!FLAGS_mwm_list_path.empty())
@@ -457,18 +506,35 @@ int main(int argc, char * argv[])
     csv << endl;
   }
 
+  uint64_t const numAllocations = GetNumAllocations();
+  my::Timer timer;
+  for (auto & request : requests)
+  {
+    request->Start();
+    if (!FLAGS_throughput)
+      request->Wait();
+  }
+  for (auto & request : requests)
+    request->Wait();
+
+  ThroughputStats throughputStats;
+  throughputStats.m_elapsedSec = timer.ElapsedSeconds();
+  throughputStats.m_numAllocations = GetNumAllocations() - numAllocations;
+
   vector<double> responseTimes(queries.size());
+  vector<RankingInfo> rankingInfos;
   for (size_t i = 0; i < queries.size(); ++i)
   {
-    requests[i]->Run();
     auto rt = duration_cast<milliseconds>(requests[i]->ResponseTime()).count();
     responseTimes[i] = static_cast<double>(rt) / 1000;
     PrintTopResults(MakePrefixFree(queries[i]), requests[i]->Results(), FLAGS_top,
                     responseTimes[i]);
 
-    if (dumpCSV)
+    for (auto const & result : requests[i]->Results())
     {
-      for (auto const & result : requests[i]->Results())
+      if (result.GetResultType() == Result::RESULT_FEATURE)
+        rankingInfos.push_back(result.GetRankingInfo());
+      if (dumpCSV)
       {
         result.GetRankingInfo().ToCSV(csv);
         csv << endl;
@@ -488,5 +554,24 @@ int main(int argc, char * argv[])
   cout << "Average response time: " << averageTime << "s"
        << " (std. dev. " << stdDevTime << "s)" << endl;
 
+  throughputStats.m_responseTimesSec = responseTimes;
+  PrintThroughputStats(cout, throughputStats);
+
+  auto const histograms = engine.GetStageHistograms();
+  for (size_t i = 0; i < histograms.m_stages.size(); ++i)
+  {
+    auto const & histogram = histograms.m_stages[i];
+    cout << DebugPrint(static_cast<SearchStage>(i)) << ": p50 " << histogram.GetQuantile(0.5)
+         << "s, p99 " << histogram.GetQuantile(0.99) << "s, total " << histogram.GetTotalSeconds()
+         << "s" << endl;
+  }
+
+  if (!FLAGS_ranking_model.empty())
+  {
+    RankingModel model;
+    if (model.Load(FLAGS_ranking_model))
+      BenchmarkRankingModel(model, rankingInfos);
+  }
+
   return 0;
 }
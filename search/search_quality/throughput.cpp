@@ -0,0 +1,68 @@
+#include "search/search_quality/throughput.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+
+using namespace std;
+
+namespace
+{
+atomic<uint64_t> g_numAllocations(0);
+}  // namespace
+
+void * operator new(size_t size)
+{
+  g_numAllocations.fetch_add(1, memory_order_relaxed);
+  if (void * p = malloc(size == 0 ? 1 : size))
+    return p;
+  throw bad_alloc();
+}
+
+void * operator new[](size_t size) { return operator new(size); }
+
+void operator delete(void * p) noexcept { free(p); }
+
+void operator delete[](void * p) noexcept { free(p); }
+
+namespace search
+{
+uint64_t GetNumAllocations() { return g_numAllocations.load(memory_order_relaxed); }
+
+double GetQuantile(vector<double> values, double q)
+{
+  ASSERT_GREATER_OR_EQUAL(q, 0.0, ());
+  ASSERT_LESS_OR_EQUAL(q, 1.0, ());
+
+  if (values.empty())
+    return 0.0;
+
+  auto const rank = static_cast<size_t>(ceil(q * values.size()));
+  auto const it = values.begin() + (rank == 0 ? 0 : rank - 1);
+  nth_element(values.begin(), it, values.end());
+  return *it;
+}
+
+void PrintThroughputStats(ostream & os, ThroughputStats const & stats)
+{
+  auto const & times = stats.m_responseTimesSec;
+  size_t const numQueries = times.size();
+
+  os << fixed << setprecision(3);
+  os << "Queries: " << numQueries << ", elapsed: " << stats.m_elapsedSec << "s" << endl;
+  if (stats.m_elapsedSec > 0.0)
+    os << "Queries per second: " << numQueries / stats.m_elapsedSec << endl;
+  os << "Response time p50: " << GetQuantile(times, 0.5) << "s, p90: " << GetQuantile(times, 0.9)
+     << "s, p99: " << GetQuantile(times, 0.99) << "s, max: " << GetQuantile(times, 1.0) << "s"
+     << endl;
+  os << "Allocations: " << stats.m_numAllocations;
+  if (numQueries != 0)
+    os << " (" << stats.m_numAllocations / numQueries << " per query)";
+  os << endl;
+}
+}  // namespace search
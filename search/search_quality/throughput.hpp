@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace search
+{
+// Returns the number of calls of the global operator new (and
+// new[]) since the start of the process. The operators are replaced
+// by counting ones in every binary which uses this function.
+uint64_t GetNumAllocations();
+
+// Performance of a replay of queries.
+struct ThroughputStats
+{
+  // Wall time of the whole replay.
+  double m_elapsedSec = 0.0;
+  // Response times of the queries.
+  std::vector<double> m_responseTimesSec;
+  uint64_t m_numAllocations = 0;
+};
+
+// Returns the |q|-quantile of |values|, |q| is in [0.0, 1.0].
+double GetQuantile(std::vector<double> values, double q);
+
+void PrintThroughputStats(std::ostream & os, ThroughputStats const & stats);
+}  // namespace search
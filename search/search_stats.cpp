@@ -0,0 +1,181 @@
+#include "search/search_stats.hpp"
+
+#include "base/assert.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/cmath.hpp"
+#include "std/sstream.hpp"
+
+namespace search
+{
+string DebugPrint(SearchStage stage)
+{
+  switch (stage)
+  {
+  case SearchStage::Tokenization: return "Tokenization";
+  case SearchStage::Geocoder: return "Geocoder";
+  case SearchStage::LocalityScoring: return "LocalityScoring";
+  case SearchStage::GeocoderRegions: return "GeocoderRegions";
+  case SearchStage::GeocoderCities: return "GeocoderCities";
+  case SearchStage::GeocoderStreets: return "GeocoderStreets";
+  case SearchStage::GeocoderPOIsAndBuildings: return "GeocoderPOIsAndBuildings";
+  case SearchStage::PathFinder: return "PathFinder";
+  case SearchStage::Ranking: return "Ranking";
+  case SearchStage::PreRankerFilter: return "PreRankerFilter";
+  case SearchStage::RankerMakeResult: return "RankerMakeResult";
+  case SearchStage::Count: return "Count";
+  }
+  ASSERT(false, ());
+  return "Unknown";
+}
+
+// StageTimes --------------------------------------------------------------------------------------
+StageTimes::StageTimes() { Reset(); }
+
+void StageTimes::Reset()
+{
+  m_nanos.fill(0);
+  m_entries.fill(0);
+  m_stack.clear();
+  m_timer.Reset();
+  m_lastNano = 0;
+}
+
+void StageTimes::Enter(SearchStage stage)
+{
+  ASSERT_LESS(stage, SearchStage::Count, ());
+  Charge(m_timer.ElapsedNano());
+  m_stack.push_back(stage);
+  ++m_entries[static_cast<size_t>(stage)];
+}
+
+void StageTimes::Leave()
+{
+  ASSERT(!m_stack.empty(), ());
+  Charge(m_timer.ElapsedNano());
+  m_stack.pop_back();
+}
+
+void StageTimes::Add(StageTimes const & rhs)
+{
+  for (size_t i = 0; i < m_nanos.size(); ++i)
+  {
+    m_nanos[i] += rhs.m_nanos[i];
+    m_entries[i] += rhs.m_entries[i];
+  }
+}
+
+bool StageTimes::WasEntered(SearchStage stage) const
+{
+  return m_entries[static_cast<size_t>(stage)] != 0;
+}
+
+double StageTimes::GetSeconds(SearchStage stage) const
+{
+  return static_cast<double>(m_nanos[static_cast<size_t>(stage)]) / 1e9;
+}
+
+void StageTimes::Charge(uint64_t nowNano)
+{
+  if (!m_stack.empty())
+    m_nanos[static_cast<size_t>(m_stack.back())] += nowNano - m_lastNano;
+  m_lastNano = nowNano;
+}
+
+// DurationHistogram -------------------------------------------------------------------------------
+// static
+double constexpr DurationHistogram::kMinSeconds;
+size_t constexpr DurationHistogram::kBucketsPerOctave;
+size_t constexpr DurationHistogram::kNumBuckets;
+
+DurationHistogram::DurationHistogram() { m_buckets.fill(0); }
+
+void DurationHistogram::Add(double seconds)
+{
+  ++m_buckets[GetBucket(seconds)];
+  ++m_count;
+  m_totalSeconds += seconds;
+}
+
+void DurationHistogram::Add(DurationHistogram const & rhs)
+{
+  for (size_t i = 0; i < kNumBuckets; ++i)
+    m_buckets[i] += rhs.m_buckets[i];
+  m_count += rhs.m_count;
+  m_totalSeconds += rhs.m_totalSeconds;
+}
+
+double DurationHistogram::GetQuantile(double q) const
+{
+  ASSERT_GREATER_OR_EQUAL(q, 0.0, ());
+  ASSERT_LESS_OR_EQUAL(q, 1.0, ());
+
+  if (m_count == 0)
+    return 0.0;
+
+  // Rank of the quantile among all durations, from 1 to m_count.
+  uint64_t const rank =
+      max(static_cast<uint64_t>(1), static_cast<uint64_t>(ceil(q * static_cast<double>(m_count))));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kNumBuckets; ++i)
+  {
+    seen += m_buckets[i];
+    if (seen >= rank)
+      return GetUpperBound(i);
+  }
+  ASSERT(false, ());
+  return GetUpperBound(kNumBuckets - 1);
+}
+
+// static
+size_t DurationHistogram::GetBucket(double seconds)
+{
+  if (seconds <= kMinSeconds)
+    return 0;
+  double const bucket = ceil(log2(seconds / kMinSeconds) * kBucketsPerOctave);
+  if (bucket >= static_cast<double>(kNumBuckets - 1))
+    return kNumBuckets - 1;
+  return static_cast<size_t>(bucket);
+}
+
+// static
+double DurationHistogram::GetUpperBound(size_t bucket)
+{
+  return kMinSeconds * exp2(static_cast<double>(bucket) / kBucketsPerOctave);
+}
+
+string DebugPrint(DurationHistogram const & histogram)
+{
+  ostringstream os;
+  os << "DurationHistogram [ count: " << histogram.GetCount()
+     << ", total: " << histogram.GetTotalSeconds() << " s, p50: " << histogram.GetQuantile(0.5)
+     << " s, p90: " << histogram.GetQuantile(0.9) << " s, p99: " << histogram.GetQuantile(0.99)
+     << " s ]";
+  return os.str();
+}
+
+// StageHistograms ---------------------------------------------------------------------------------
+void StageHistograms::Add(StageTimes const & times, double querySeconds)
+{
+  for (size_t i = 0; i < m_stages.size(); ++i)
+  {
+    auto const stage = static_cast<SearchStage>(i);
+    if (times.WasEntered(stage))
+      m_stages[i].Add(times.GetSeconds(stage));
+  }
+  m_queries.Add(querySeconds);
+}
+
+string DebugPrint(StageHistograms const & histograms)
+{
+  ostringstream os;
+  os << "StageHistograms [ queries: " << DebugPrint(histograms.m_queries);
+  for (size_t i = 0; i < histograms.m_stages.size(); ++i)
+  {
+    os << ", " << DebugPrint(static_cast<SearchStage>(i)) << ": "
+       << DebugPrint(histograms.m_stages[i]);
+  }
+  os << " ]";
+  return os.str();
+}
+}  // namespace search
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "base/timer.hpp"
+
+#include "std/array.hpp"
+#include "std/cstdint.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+namespace search
+{
+// Stages of a search query. Times of stages are exclusive, i.e. the
+// time of a nested stage (e.g. PathFinder in GeocoderPOIsAndBuildings)
+// is not counted in the time of the enclosing one.
+enum class SearchStage
+{
+  Tokenization,
+  // Geocoding work which is not a part of other stages: retrieval of
+  // features of tokens, localities tables etc.
+  Geocoder,
+  LocalityScoring,
+  GeocoderRegions,
+  GeocoderCities,
+  GeocoderStreets,
+  GeocoderPOIsAndBuildings,
+  PathFinder,
+  // Ranking work which is not a part of other stages.
+  Ranking,
+  PreRankerFilter,
+  RankerMakeResult,
+  Count
+};
+
+string DebugPrint(SearchStage stage);
+
+// Times of stages of a single query in a single thread.
+//
+// *NOTE* This class is not thread-safe.
+class StageTimes
+{
+public:
+  StageTimes();
+
+  void Reset();
+
+  // Stages may be nested, Leave() leaves the last entered stage.
+  void Enter(SearchStage stage);
+  void Leave();
+
+  // Adds times of |rhs|, e.g. of another thread of the same query.
+  void Add(StageTimes const & rhs);
+
+  // Returns whether |stage| was entered since the last Reset().
+  bool WasEntered(SearchStage stage) const;
+  double GetSeconds(SearchStage stage) const;
+
+private:
+  void Charge(uint64_t nowNano);
+
+  array<uint64_t, static_cast<size_t>(SearchStage::Count)> m_nanos;
+  array<uint32_t, static_cast<size_t>(SearchStage::Count)> m_entries;
+  vector<SearchStage> m_stack;
+  my::HighResTimer m_timer;
+  uint64_t m_lastNano = 0;
+};
+
+// Enters a stage for the lifetime of the object. |times| may be
+// nullptr, then nothing is measured.
+class ScopedStage
+{
+public:
+  ScopedStage(StageTimes * times, SearchStage stage) : m_times(times)
+  {
+    if (m_times)
+      m_times->Enter(stage);
+  }
+
+  ~ScopedStage()
+  {
+    if (m_times)
+      m_times->Leave();
+  }
+
+private:
+  StageTimes * m_times;
+};
+
+// Histogram of durations with logarithmic buckets, kBucketsPerOctave
+// buckets for every doubling of a duration from kMinSeconds, so
+// quantiles are known up to ~19%.
+class DurationHistogram
+{
+public:
+  static double constexpr kMinSeconds = 1e-6;
+  static size_t constexpr kBucketsPerOctave = 4;
+  // Up to ~2.3 hours.
+  static size_t constexpr kNumBuckets = 33 * kBucketsPerOctave + 1;
+
+  DurationHistogram();
+
+  void Add(double seconds);
+  void Add(DurationHistogram const & rhs);
+
+  uint64_t GetCount() const { return m_count; }
+  double GetTotalSeconds() const { return m_totalSeconds; }
+
+  // Returns an upper bound of the |q|-quantile of durations, where
+  // |q| is in [0.0, 1.0]. Returns 0.0 for an empty histogram.
+  double GetQuantile(double q) const;
+
+private:
+  static size_t GetBucket(double seconds);
+  static double GetUpperBound(size_t bucket);
+
+  array<uint64_t, kNumBuckets> m_buckets;
+  uint64_t m_count = 0;
+  double m_totalSeconds = 0.0;
+};
+
+string DebugPrint(DurationHistogram const & histogram);
+
+// Histograms of times of stages and of whole queries over a lot of
+// queries. A stage is counted only for queries which entered it.
+struct StageHistograms
+{
+  void Add(StageTimes const & times, double querySeconds);
+
+  DurationHistogram const & Get(SearchStage stage) const
+  {
+    return m_stages[static_cast<size_t>(stage)];
+  }
+
+  array<DurationHistogram, static_cast<size_t>(SearchStage::Count)> m_stages;
+  DurationHistogram m_queries;
+};
+
+string DebugPrint(StageHistograms const & histograms);
+}  // namespace search
@@ -0,0 +1,56 @@
+#include "testing/testing.hpp"
+
+#include "search/category_bitmaps_table.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace search;
+using namespace std;
+
+namespace
+{
+vector<uint64_t> GetFeatures(CategoryBitmapsTable const & table, uint32_t type)
+{
+  vector<uint64_t> features;
+  table.ForEachFeature(type, [&features](uint64_t featureId) { features.push_back(featureId); });
+  return features;
+}
+
+UNIT_TEST(CategoryBitmapsTable_Smoke)
+{
+  vector<uint8_t> buffer;
+  {
+    CategoryBitmapsTable::Builder builder;
+    builder.Add(20 /* type */, 7 /* featureId */);
+    builder.Add(20 /* type */, 3 /* featureId */);
+    builder.Add(20 /* type */, 7 /* featureId */);
+    builder.Add(10 /* type */, 5 /* featureId */);
+    builder.AddType(30 /* type */);
+    builder.AddType(10 /* type */);
+    TEST_EQUAL(builder.GetNumCategories(), 3, ());
+
+    MemWriter<vector<uint8_t>> writer(buffer);
+    builder.Serialize(writer);
+  }
+
+  CategoryBitmapsTable table;
+  {
+    MemReader reader(buffer.data(), buffer.size());
+    TEST(table.Deserialize(reader), ());
+  }
+
+  TEST_EQUAL(table.GetNumCategories(), 3, ());
+  TEST(table.HasType(10), ());
+  TEST(table.HasType(20), ());
+  TEST(table.HasType(30), ());
+  TEST(!table.HasType(15), ());
+
+  TEST_EQUAL(GetFeatures(table, 10), vector<uint64_t>({5}), ());
+  TEST_EQUAL(GetFeatures(table, 20), vector<uint64_t>({3, 7}), ());
+  TEST(GetFeatures(table, 30).empty(), ());
+}
+}  // namespace
@@ -0,0 +1,52 @@
+#include "testing/testing.hpp"
+
+#include "search/downloader_name_index.hpp"
+
+#include "storage/downloader_search_params.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace search;
+using namespace std;
+
+namespace
+{
+vector<storage::TCountryId> Search(DownloaderNameIndex const & index, string const & query)
+{
+  vector<storage::DownloaderSearchResult> results;
+  index.Search(query, results);
+
+  vector<storage::TCountryId> ids;
+  for (auto const & result : results)
+    ids.push_back(result.m_countryId);
+  return ids;
+}
+
+UNIT_TEST(DownloaderNameIndex_Smoke)
+{
+  DownloaderNameIndex index("en");
+  index.Add("Germany", "Germany");
+  index.Add("Germany_Berlin", "Berlin");
+  index.Add("USA_New York", "New York");
+  index.Add("USA_New Jersey", "New Jersey");
+  index.Add("Russia_Moscow", "Moscow");
+  index.Add("Russia_Moscow", "Moscow");
+  index.Build();
+
+  TEST_EQUAL(index.GetLocale(), "en", ());
+  TEST_EQUAL(Search(index, "germ"), vector<storage::TCountryId>({"Germany"}), ());
+  TEST_EQUAL(Search(index, "new"),
+             vector<storage::TCountryId>({"USA_New York", "USA_New Jersey"}), ());
+  TEST_EQUAL(Search(index, "york ne"), vector<storage::TCountryId>({"USA_New York"}), ());
+  TEST_EQUAL(Search(index, "MOSCOW"), vector<storage::TCountryId>({"Russia_Moscow"}), ());
+  TEST(Search(index, "newark").empty(), ());
+  TEST(Search(index, " ").empty(), ());
+
+  vector<storage::DownloaderSearchResult> results;
+  index.Search("berl", results);
+  TEST_EQUAL(results, vector<storage::DownloaderSearchResult>(
+                          {storage::DownloaderSearchResult("Germany_Berlin", "Berlin")}),
+             ());
+}
+}  // namespace
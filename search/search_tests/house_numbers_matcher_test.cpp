@@ -142,6 +142,29 @@ UNIT_TEST(HouseNumbersMatcher_Smoke)
   TEST(HouseNumbersMatch("14 д 1", "дом 14 д1"), ());
 }
 
+UNIT_TEST(HouseNumbersMatcher_ParsedHouseNumber)
+{
+  vector<string> const houseNumbers = {"39с79", "10 к2 с2", "3/7 с1Б", "22к", "", "ev 10"};
+  vector<pair<string, bool>> const queries = {
+      {"39", false},        {"39 с 79", false}, {"10 корпус 2", false}, {"3/7 с 1Д", false},
+      {"22 к", false},      {"22я", false},     {"39 кор", true},       {"10к", true}};
+
+  for (auto const & houseNumber : houseNumbers)
+  {
+    vector<vector<Token>> parses;
+    ParseHouseNumber(MakeUniString(houseNumber), parses);
+
+    for (auto const & query : queries)
+    {
+      vector<Token> queryParse;
+      ParseQuery(MakeUniString(query.first), query.second, queryParse);
+      TEST_EQUAL(search::house_numbers::HouseNumbersMatch(parses, queryParse),
+                 HouseNumbersMatch(houseNumber, query.first, query.second),
+                 (houseNumber, query.first));
+    }
+  }
+}
+
 UNIT_TEST(LooksLikeHouseNumber_Smoke)
 {
   TEST(LooksLikeHouseNumber("1", false /* isPrefix */), ());
@@ -0,0 +1,56 @@
+#include "testing/testing.hpp"
+
+#include "search/levenshtein_dfa_cache.hpp"
+
+#include "base/dfa_helpers.hpp"
+#include "base/levenshtein_dfa.hpp"
+#include "base/string_utils.hpp"
+
+#include "std/string.hpp"
+
+using namespace search;
+using namespace strings;
+
+namespace
+{
+bool Accepts(LevenshteinDFA const & dfa, string const & s)
+{
+  auto it = dfa.Begin();
+  DFAMove(it, s);
+  return it.Accepts();
+}
+
+UNIT_TEST(LevenshteinDFACache_Smoke)
+{
+  LevenshteinDFACache cache(2 /* maxEntries */);
+
+  auto const london = MakeUniString("london");
+  auto const paris = MakeUniString("paris");
+  auto const rome = MakeUniString("rome");
+
+  {
+    auto const dfa = cache.Get(london, 1 /* maxErrors */);
+    TEST(Accepts(dfa, "london"), ());
+    TEST(Accepts(dfa, "londn"), ());
+    TEST(!Accepts(dfa, "lndn"), ());
+  }
+  TEST_EQUAL(cache.GetNumEntries(), 1, ());
+
+  {
+    auto const dfa = cache.Get(london, 0 /* maxErrors */);
+    TEST(Accepts(dfa, "london"), ());
+    TEST(!Accepts(dfa, "londn"), ());
+  }
+  TEST_EQUAL(cache.GetNumEntries(), 2, ());
+
+  // The first letter is assumed to be correct.
+  TEST(!Accepts(cache.Get(paris, 1 /* maxErrors */), "baris"), ());
+  TEST_EQUAL(cache.GetNumEntries(), 2, ());
+
+  TEST(Accepts(cache.Get(rome, 1 /* maxErrors */), "rom"), ());
+  TEST_EQUAL(cache.GetNumEntries(), 2, ());
+
+  cache.Clear();
+  TEST_EQUAL(cache.GetNumEntries(), 0, ());
+}
+}  // namespace
@@ -133,3 +133,34 @@ UNIT_CLASS_TEST(LocalityFinderTest, Moscow)
 
   RunTests(input, results);
 }
+
+UNIT_TEST(LocalityFinder_Holder)
+{
+  search::LocalityFinder::Holder holder(2000.0 /* radiusMeters */);
+
+  StringUtf8Multilang names;
+  names.AddString(StringUtf8Multilang::kDefaultCode, "Small");
+  holder.Add(search::LocalityItem(names, MercatorBounds::FromLatLon(-10.001, -20.001), 100));
+  names.AddString(StringUtf8Multilang::kDefaultCode, "Big");
+  holder.Add(search::LocalityItem(names, MercatorBounds::FromLatLon(-10.01, -20.01), 100000));
+  names.AddString(StringUtf8Multilang::kDefaultCode, "Far");
+  holder.Add(search::LocalityItem(names, MercatorBounds::FromLatLon(-11.0, -20.0), 1000000));
+
+  auto const getLocality = [&](m2::PointD const & p) {
+    search::LocalitySelector selector(p);
+    holder.ForEachInVicinity(holder.GetRect(p), selector);
+
+    string name;
+    selector.WithBestLocality([&](search::LocalityItem const & item) {
+      item.GetSpecifiedOrDefaultName(StringUtf8Multilang::kDefaultCode, name);
+    });
+    return name;
+  };
+
+  TEST_EQUAL(getLocality(MercatorBounds::FromLatLon(-10.0, -20.0)), "Small", ());
+  TEST_EQUAL(getLocality(MercatorBounds::FromLatLon(-10.012, -20.012)), "Big", ());
+  TEST_EQUAL(getLocality(MercatorBounds::FromLatLon(-10.5, -20.0)), "", ());
+
+  holder.Clear();
+  TEST_EQUAL(getLocality(MercatorBounds::FromLatLon(-10.0, -20.0)), "", ());
+}
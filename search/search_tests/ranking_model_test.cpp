@@ -0,0 +1,108 @@
+#include "testing/testing.hpp"
+
+#include "search/model.hpp"
+#include "search/ranking_info.hpp"
+#include "search/ranking_model.hpp"
+#include "search/ranking_utils.hpp"
+
+#include "base/math.hpp"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace search;
+using namespace std;
+
+namespace
+{
+double constexpr kEps = 1e-6;
+
+// The first tree splits by the distance and then by the rank, the second one prefers cities.
+string const kModel = R"(# A model for tests.
+bias 0.5
+tree 5
+split 0 0.5 4
+split 1 0.5 3
+leaf -1.0
+leaf 1.0
+leaf -2.0
+tree 3
+split 13 0.5 2
+leaf 0.0
+leaf 3.0
+)";
+
+bool Load(string const & text, RankingModel & model)
+{
+  istringstream is(text);
+  return model.Load(is);
+}
+
+RankingInfo MakeInfo(double distance, uint8_t rank, Model::Type type)
+{
+  RankingInfo info;
+  info.m_distanceToPivot = distance;
+  info.m_rank = rank;
+  info.m_nameScore = NAME_SCORE_FULL_MATCH;
+  info.m_type = type;
+  return info;
+}
+
+UNIT_TEST(RankingModel_Features)
+{
+  auto info = MakeInfo(RankingInfo::kMaxDistMeters * 2, 255, Model::TYPE_BUILDING);
+  info.m_falseCats = true;
+
+  vector<float> features(RankingModel::FEATURE_COUNT);
+  RankingModel::GetFeatures(info, features.data());
+  TEST(my::AlmostEqualAbs(features[RankingModel::FEATURE_DISTANCE_TO_PIVOT], 1.0f, 1e-6f), ());
+  TEST(my::AlmostEqualAbs(features[RankingModel::FEATURE_RANK], 1.0f, 1e-6f), ());
+  TEST_EQUAL(features[RankingModel::FEATURE_FALSE_CATS], 1.0f, ());
+  // Name score is zero for categorial matches and buildings are POIs.
+  TEST_EQUAL(features[RankingModel::FEATURE_NAME_SCORE_ZERO], 1.0f, ());
+  TEST_EQUAL(features[RankingModel::FEATURE_NAME_SCORE_FULL_MATCH], 0.0f, ());
+  TEST_EQUAL(features[RankingModel::FEATURE_TYPE_POI], 1.0f, ());
+  TEST_EQUAL(features[RankingModel::FEATURE_TYPE_BUILDING], 0.0f, ());
+}
+
+UNIT_TEST(RankingModel_Score)
+{
+  RankingModel model;
+  TEST(Load(kModel, model), ());
+  TEST_EQUAL(model.GetNumTrees(), 2, ());
+
+  vector<RankingInfo> const infos = {MakeInfo(0.0, 0, Model::TYPE_POI),
+                                     MakeInfo(0.0, 255, Model::TYPE_CITY),
+                                     MakeInfo(RankingInfo::kMaxDistMeters, 255, Model::TYPE_POI)};
+  vector<double> const expected = {-0.5, 4.5, -1.5};
+
+  vector<float> features(infos.size() * RankingModel::FEATURE_COUNT);
+  for (size_t i = 0; i < infos.size(); ++i)
+    RankingModel::GetFeatures(infos[i], &features[i * RankingModel::FEATURE_COUNT]);
+
+  vector<double> scores(infos.size());
+  model.Score(features.data(), infos.size(), scores.data());
+  for (size_t i = 0; i < infos.size(); ++i)
+  {
+    TEST(my::AlmostEqualAbs(scores[i], expected[i], kEps), (i, scores[i]));
+    double const score = model.Score(&features[i * RankingModel::FEATURE_COUNT]);
+    TEST(my::AlmostEqualAbs(score, expected[i], kEps), (i, score));
+  }
+}
+
+UNIT_TEST(RankingModel_Malformed)
+{
+  RankingModel model;
+  TEST(Load("", model), ());
+  TEST(model.IsEmpty(), ());
+
+  TEST(!Load("tree 3\nsplit 0 0.5 2\nleaf 1.0\n", model), ());
+  TEST(!Load("tree 1\nsplit 0 0.5 0\n", model), ());
+  TEST(!Load("tree 3\nsplit 100 0.5 2\nleaf 1.0\nleaf 2.0\n", model), ());
+  TEST(!Load("tree 3\nsplit 0 0.5 1\nleaf 1.0\nleaf 2.0\n", model), ());
+  TEST(!Load("bias x\n", model), ());
+  TEST(!Load("forest 1\nleaf 1.0\n", model), ());
+  TEST(model.IsEmpty(), ());
+}
+}  // namespace
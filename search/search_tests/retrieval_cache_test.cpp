@@ -0,0 +1,101 @@
+#include "testing/testing.hpp"
+
+#include "search/cbv.hpp"
+#include "search/retrieval_cache.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "coding/compressed_bit_vector.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/string.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
+
+using namespace search;
+
+namespace
+{
+// Number of bytes of a cache entry with a key of one char and a sparse
+// vector of one bit.
+uint64_t constexpr kOneBitEntryBytes = 128 + 1 + sizeof(uint64_t);
+
+struct Retriever
+{
+  explicit Retriever(uint64_t bit) : m_bit(bit) {}
+
+  unique_ptr<coding::CompressedBitVector> operator()()
+  {
+    ++m_numCalls;
+    return coding::CompressedBitVectorBuilder::FromBitPositions(vector<uint64_t>{m_bit});
+  }
+
+  uint64_t m_bit;
+  size_t m_numCalls = 0;
+};
+
+UNIT_TEST(RetrievalCache_Smoke)
+{
+  MwmSet::MwmId const mwmId;
+  RetrievalCache cache(2 * kOneBitEntryBytes);
+
+  Retriever a(1);
+  TEST(cache.Get(mwmId, "a", a).HasBit(1), ());
+  TEST(cache.Get(mwmId, "a", a).HasBit(1), ());
+  TEST_EQUAL(a.m_numCalls, 1, ());
+  TEST_EQUAL(cache.GetNumEntries(), 1, ());
+  TEST_EQUAL(cache.GetBytes(), kOneBitEntryBytes, ());
+
+  Retriever b(2);
+  TEST(cache.Get(mwmId, "b", b).HasBit(2), ());
+  TEST_EQUAL(b.m_numCalls, 1, ());
+
+  // "a" is used more recently than "b", so "b" is evicted.
+  TEST(cache.Get(mwmId, "a", a).HasBit(1), ());
+  Retriever c(3);
+  TEST(cache.Get(mwmId, "c", c).HasBit(3), ());
+  TEST_EQUAL(cache.GetNumEntries(), 2, ());
+  TEST_EQUAL(cache.GetBytes(), 2 * kOneBitEntryBytes, ());
+
+  TEST(cache.Get(mwmId, "a", a).HasBit(1), ());
+  TEST_EQUAL(a.m_numCalls, 1, ());
+  TEST(cache.Get(mwmId, "b", b).HasBit(2), ());
+  TEST_EQUAL(b.m_numCalls, 2, ());
+
+  cache.Clear();
+  TEST_EQUAL(cache.GetNumEntries(), 0, ());
+  TEST_EQUAL(cache.GetBytes(), 0, ());
+}
+
+UNIT_TEST(RetrievalCache_DeadMwms)
+{
+  RetrievalCache cache(10 * kOneBitEntryBytes);
+
+  // A default MwmId doesn't correspond to a registered mwm.
+  MwmSet::MwmId const mwmId;
+  TEST(!mwmId.IsAlive(), ());
+
+  Retriever a(1);
+  cache.Get(mwmId, "a", a);
+  TEST_EQUAL(cache.GetNumEntries(), 1, ());
+
+  cache.RemoveDeadMwms();
+  TEST_EQUAL(cache.GetNumEntries(), 0, ());
+  TEST_EQUAL(cache.GetBytes(), 0, ());
+
+  cache.Get(mwmId, "a", a);
+  TEST_EQUAL(a.m_numCalls, 2, ());
+}
+
+UNIT_TEST(RetrievalCache_TooLarge)
+{
+  MwmSet::MwmId const mwmId;
+  RetrievalCache cache(kOneBitEntryBytes - 1);
+
+  Retriever a(1);
+  TEST(cache.Get(mwmId, "a", a).HasBit(1), ());
+  TEST(cache.Get(mwmId, "a", a).HasBit(1), ());
+  TEST_EQUAL(a.m_numCalls, 2, ());
+  TEST_EQUAL(cache.GetNumEntries(), 0, ());
+}
+}  // namespace
@@ -0,0 +1,94 @@
+#include "testing/testing.hpp"
+
+#include "search/search_stats.hpp"
+
+#include "base/math.hpp"
+#include "base/thread.hpp"
+#include "base/timer.hpp"
+
+using namespace search;
+
+namespace
+{
+UNIT_TEST(StageTimes_Exclusive)
+{
+  StageTimes times;
+  my::Timer timer;
+  {
+    ScopedStage outer(&times, SearchStage::Geocoder);
+    threads::Sleep(20);
+    {
+      ScopedStage inner(&times, SearchStage::PathFinder);
+      threads::Sleep(40);
+    }
+  }
+  double const totalSec = timer.ElapsedSeconds();
+
+  TEST(times.WasEntered(SearchStage::Geocoder), ());
+  TEST(times.WasEntered(SearchStage::PathFinder), ());
+  TEST(!times.WasEntered(SearchStage::Tokenization), ());
+
+  double const outer = times.GetSeconds(SearchStage::Geocoder);
+  double const inner = times.GetSeconds(SearchStage::PathFinder);
+  TEST_GREATER_OR_EQUAL(outer, 0.019, ());
+  TEST_GREATER_OR_EQUAL(inner, 0.039, ());
+  // The time of the inner stage is not counted in the outer one.
+  TEST_LESS_OR_EQUAL(outer + inner, totalSec, ());
+
+  StageTimes other;
+  other.Add(times);
+  other.Add(times);
+  TEST_ALMOST_EQUAL_ULPS(other.GetSeconds(SearchStage::PathFinder), 2 * inner, ());
+
+  times.Reset();
+  TEST(!times.WasEntered(SearchStage::Geocoder), ());
+  TEST_EQUAL(times.GetSeconds(SearchStage::Geocoder), 0.0, ());
+
+  // Nothing is measured without times.
+  ScopedStage stage(nullptr, SearchStage::Ranking);
+}
+
+UNIT_TEST(DurationHistogram_Quantiles)
+{
+  DurationHistogram histogram;
+  TEST_EQUAL(histogram.GetQuantile(0.5), 0.0, ());
+
+  for (size_t i = 1; i <= 100; ++i)
+    histogram.Add(i * 1e-3);
+  TEST_EQUAL(histogram.GetCount(), 100, ());
+  TEST(my::AlmostEqualAbs(histogram.GetTotalSeconds(), 5.05, 1e-9), ());
+
+  // Quantiles are upper bounds of buckets, which are ~19% wide.
+  auto const testQuantile = [&histogram](double q, double expected) {
+    double const actual = histogram.GetQuantile(q);
+    TEST_GREATER_OR_EQUAL(actual, expected, (q));
+    TEST_LESS_OR_EQUAL(actual, expected * 1.2, (q));
+  };
+  testQuantile(0.5, 0.05);
+  testQuantile(0.99, 0.099);
+  testQuantile(1.0, 0.1);
+  testQuantile(0.0, 0.001);
+
+  DurationHistogram other;
+  other.Add(100.0);
+  histogram.Add(other);
+  TEST_EQUAL(histogram.GetCount(), 101, ());
+  TEST_GREATER_OR_EQUAL(histogram.GetQuantile(1.0), 100.0, ());
+}
+
+UNIT_TEST(StageHistograms_Smoke)
+{
+  StageTimes times;
+  {
+    ScopedStage stage(&times, SearchStage::Tokenization);
+  }
+
+  StageHistograms histograms;
+  histograms.Add(times, 0.5 /* querySeconds */);
+  histograms.Add(times, 1.5 /* querySeconds */);
+
+  TEST_EQUAL(histograms.m_queries.GetCount(), 2, ());
+  TEST_EQUAL(histograms.Get(SearchStage::Tokenization).GetCount(), 2, ());
+  TEST_EQUAL(histograms.Get(SearchStage::PathFinder).GetCount(), 0, ());
+}
+}  // namespace
@@ -25,6 +25,8 @@ win32*|linux* {
 SOURCES += \
     ../../testing/testingmain.cpp \
     algos_tests.cpp \
+    category_bitmaps_table_test.cpp \
+    downloader_name_index_test.cpp \
     hotels_filter_test.cpp \
     house_detector_tests.cpp \
     house_numbers_matcher_test.cpp \
@@ -32,13 +34,19 @@ SOURCES += \
     keyword_lang_matcher_test.cpp \
     keyword_matcher_test.cpp \
     latlon_match_test.cpp \
+    levenshtein_dfa_cache_test.cpp \
     locality_finder_test.cpp \
     locality_scorer_test.cpp \
     locality_selector_test.cpp \
     point_rect_matcher_tests.cpp \
     query_saver_tests.cpp \
+    ranking_model_test.cpp \
     ranking_tests.cpp \
+    retrieval_cache_test.cpp \
+    search_stats_test.cpp \
+    shared_geometry_cache_test.cpp \
     segment_tree_tests.cpp \
+    streets_houses_table_test.cpp \
     string_intersection_test.cpp \
     string_match_test.cpp \
 
@@ -0,0 +1,77 @@
+#include "testing/testing.hpp"
+
+#include "search/geometry_cache.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "geometry/rect2d.hpp"
+
+#include "coding/compressed_bit_vector.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
+
+using namespace search;
+
+namespace
+{
+// Number of bytes of a cache entry with a sparse vector of one bit.
+uint64_t constexpr kOneBitEntryBytes = 128 + sizeof(uint64_t);
+
+unique_ptr<coding::CompressedBitVector> MakeFeatures(uint64_t bit)
+{
+  return coding::CompressedBitVectorBuilder::FromBitPositions(vector<uint64_t>{bit});
+}
+
+UNIT_TEST(SharedGeometryCache_Smoke)
+{
+  MwmSet::MwmId const mwmId;
+  SharedGeometryCache cache(2 * kOneBitEntryBytes);
+
+  SharedGeometryCache::Key const a(mwmId, m2::RectD(0, 0, 1, 1), 10);
+  SharedGeometryCache::Key const b(mwmId, m2::RectD(0, 0, 2, 2), 10);
+  SharedGeometryCache::Key const c(mwmId, m2::RectD(0, 0, 1, 1), 11);
+
+  uint64_t generation = 0;
+  TEST(!cache.Get(a, generation), ());
+  cache.Put(a, MakeFeatures(1).get(), generation);
+  cache.Put(b, MakeFeatures(2).get(), generation);
+  TEST_EQUAL(cache.GetNumEntries(), 2, ());
+  TEST_EQUAL(cache.GetBytes(), 2 * kOneBitEntryBytes, ());
+
+  // |a| is used more recently than |b|, so |b| is evicted.
+  auto features = cache.Get(a, generation);
+  TEST(features, ());
+  TEST(features->GetBit(1), ());
+  cache.Put(c, MakeFeatures(3).get(), generation);
+  TEST(cache.Get(a, generation), ());
+  TEST(!cache.Get(b, generation), ());
+  TEST(cache.Get(c, generation), ());
+  TEST_EQUAL(cache.GetBytes(), 2 * kOneBitEntryBytes, ());
+}
+
+UNIT_TEST(SharedGeometryCache_Invalidation)
+{
+  MwmSet::MwmId const mwmId;
+  SharedGeometryCache cache(10 * kOneBitEntryBytes);
+  SharedGeometryCache::Key const a(mwmId, m2::RectD(0, 0, 1, 1), 10);
+
+  uint64_t generation = 0;
+  TEST(!cache.Get(a, generation), ());
+
+  // Features retrieved before the cache was cleared are not cached.
+  cache.Clear();
+  cache.Put(a, MakeFeatures(1).get(), generation);
+  TEST_EQUAL(cache.GetNumEntries(), 0, ());
+
+  TEST(!cache.Get(a, generation), ());
+  cache.Put(a, MakeFeatures(1).get(), generation);
+  TEST_EQUAL(cache.GetNumEntries(), 1, ());
+
+  // A default MwmId doesn't correspond to a registered mwm.
+  cache.RemoveDeadMwms();
+  TEST_EQUAL(cache.GetNumEntries(), 0, ());
+  TEST_EQUAL(cache.GetBytes(), 0, ());
+}
+}  // namespace
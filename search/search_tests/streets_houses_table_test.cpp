@@ -0,0 +1,65 @@
+#include "testing/testing.hpp"
+
+#include "search/streets_houses_table.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace search;
+using namespace std;
+
+namespace
+{
+vector<uint32_t> GetHouses(StreetsHousesTable const & table, uint32_t streetId)
+{
+  vector<uint32_t> houses;
+  table.ForEachHouse(streetId, [&houses](uint32_t houseId) { houses.push_back(houseId); });
+  return houses;
+}
+
+UNIT_TEST(StreetsHousesTable_Smoke)
+{
+  vector<uint8_t> buffer;
+  {
+    StreetsHousesTable::Builder builder;
+    builder.Add(7 /* houseId */, 100 /* streetId */);
+    builder.Add(3 /* houseId */, 100 /* streetId */);
+    builder.Add(5 /* houseId */, 200 /* streetId */);
+    builder.Add(0 /* houseId */, 300 /* streetId */);
+    builder.SetNumFeatures(10);
+
+    MemWriter<vector<uint8_t>> writer(buffer);
+    builder.Serialize(writer);
+  }
+
+  StreetsHousesTable table;
+  {
+    MemReader reader(buffer.data(), buffer.size());
+    ReaderSource<MemReader> src(reader);
+    TEST(table.Deserialize(src), ());
+    TEST_EQUAL(src.Size(), 0, ());
+  }
+
+  TEST_EQUAL(table.GetNumPairs(), 4, ());
+
+  uint32_t streetId = 0;
+  TEST(table.GetStreet(3, streetId), ());
+  TEST_EQUAL(streetId, 100, ());
+  TEST(table.GetStreet(0, streetId), ());
+  TEST_EQUAL(streetId, 300, ());
+  TEST(table.GetStreet(5, streetId), ());
+  TEST_EQUAL(streetId, 200, ());
+  TEST(!table.GetStreet(4, streetId), ());
+
+  TEST(table.Covers(9), ());
+  TEST(!table.Covers(10), ());
+
+  TEST_EQUAL(GetHouses(table, 100), vector<uint32_t>({3, 7}), ());
+  TEST_EQUAL(GetHouses(table, 200), vector<uint32_t>({5}), ());
+  TEST_EQUAL(GetHouses(table, 300), vector<uint32_t>({0}), ());
+  TEST(GetHouses(table, 150).empty(), ());
+}
+}  // namespace
@@ -32,6 +32,10 @@ public:
   ~TestSearchEngine() override;
 
   inline void SetLocale(string const & locale) { m_engine.SetLocale(locale); }
+  inline search::StageHistograms GetStageHistograms() const
+  {
+    return m_engine.GetStageHistograms();
+  }
 
   weak_ptr<search::ProcessorHandle> Search(search::SearchParams const & params,
                                            m2::RectD const & viewport);
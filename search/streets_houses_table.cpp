@@ -0,0 +1,49 @@
+#include "search/streets_houses_table.hpp"
+
+#include "indexer/index.hpp"
+
+#include "base/logging.hpp"
+
+#include "defines.hpp"
+
+using namespace std;
+
+namespace search
+{
+// static
+uint16_t constexpr StreetsHousesTable::kLatestVersion;
+
+// static
+unique_ptr<StreetsHousesTable> StreetsHousesTable::Load(MwmValue & value)
+{
+  if (!value.m_cont.IsExist(SEARCH_STREETS_HOUSES_FILE_TAG))
+    return nullptr;
+
+  unique_ptr<StreetsHousesTable> table(new StreetsHousesTable());
+  try
+  {
+    auto reader = value.m_cont.GetReader(SEARCH_STREETS_HOUSES_FILE_TAG);
+    ReaderSource<ReaderPtr<ModelReader>> src(reader);
+    if (!table->Deserialize(src))
+    {
+      LOG(LWARNING, ("Unknown version of streets-houses table."));
+      return nullptr;
+    }
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LERROR, ("Can't read streets-houses table:", e.Msg()));
+    return nullptr;
+  }
+  return table;
+}
+
+bool StreetsHousesTable::GetStreet(uint32_t houseId, uint32_t & streetId) const
+{
+  auto const it = lower_bound(m_houses.begin(), m_houses.end(), houseId);
+  if (it == m_houses.end() || *it != houseId)
+    return false;
+  streetId = m_houseStreets[distance(m_houses.begin(), it)];
+  return true;
+}
+}  // namespace search
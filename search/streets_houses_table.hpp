@@ -0,0 +1,139 @@
+#pragma once
+
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class MwmValue;
+
+namespace search
+{
+// Precomputed bipartite graph between houses and streets of an mwm.
+// Every house is matched to at most one street, the same street
+// FeaturesLayerMatcher would choose at runtime: the street from the
+// address table or the nearest street which is closer than
+// ReverseGeocoder::kMaxApproxStreetDistanceM. So, neither nearby
+// streets nor projections on streets are needed to match houses with
+// streets when the section is present.
+//
+// Section format:
+// uint16_t version;
+// varuint  number of features of the mwm covered by the table;
+// varuint  number of pairs;
+// pairs sorted by house id: varuint house id delta, varuint street id.
+//
+// Houses with ids less than the number of covered features and
+// without a pair have no matching street.
+class StreetsHousesTable
+{
+public:
+  class Builder
+  {
+  public:
+    void Add(uint32_t houseId, uint32_t streetId) { m_pairs.emplace_back(houseId, streetId); }
+    void SetNumFeatures(uint32_t numFeatures) { m_numFeatures = numFeatures; }
+
+    size_t GetNumPairs() const { return m_pairs.size(); }
+
+    template <typename Sink>
+    void Serialize(Sink & sink)
+    {
+      std::sort(m_pairs.begin(), m_pairs.end());
+
+      uint16_t const version = kLatestVersion;
+      WriteToSink(sink, version);
+      WriteVarUint(sink, m_numFeatures);
+      WriteVarUint(sink, static_cast<uint64_t>(m_pairs.size()));
+
+      uint32_t prevHouseId = 0;
+      for (auto const & p : m_pairs)
+      {
+        ASSERT_LESS(p.first, m_numFeatures, ());
+        WriteVarUint(sink, p.first - prevHouseId);
+        WriteVarUint(sink, p.second);
+        prevHouseId = p.first;
+      }
+    }
+
+  private:
+    std::vector<std::pair<uint32_t, uint32_t>> m_pairs;
+    uint32_t m_numFeatures = 0;
+  };
+
+  // Returns nullptr if there is no table in the mwm or it can't be read.
+  static std::unique_ptr<StreetsHousesTable> Load(MwmValue & value);
+
+  // Returns false if the version of the table is unknown.
+  template <typename Source>
+  bool Deserialize(Source & src)
+  {
+    auto const version = ReadPrimitiveFromSource<uint16_t>(src);
+    if (version != kLatestVersion)
+      return false;
+
+    m_numFeatures = ReadVarUint<uint32_t>(src);
+    auto const numPairs = base::checked_cast<size_t>(ReadVarUint<uint64_t>(src));
+
+    m_houses.clear();
+    m_houses.reserve(numPairs);
+    m_houseStreets.clear();
+    m_houseStreets.reserve(numPairs);
+    m_streetHouses.clear();
+    m_streetHouses.reserve(numPairs);
+
+    uint32_t houseId = 0;
+    for (size_t i = 0; i < numPairs; ++i)
+    {
+      houseId += ReadVarUint<uint32_t>(src);
+      auto const streetId = ReadVarUint<uint32_t>(src);
+      m_houses.push_back(houseId);
+      m_houseStreets.push_back(streetId);
+      m_streetHouses.emplace_back(streetId, houseId);
+    }
+    std::sort(m_streetHouses.begin(), m_streetHouses.end());
+    return true;
+  }
+
+  // Returns true if the table knows a matching street of |houseId|,
+  // i.e. the absence of a street for |houseId| is meaningful.
+  bool Covers(uint32_t houseId) const { return houseId < m_numFeatures; }
+
+  // Returns true and stores the matching street of |houseId| to
+  // |streetId| if there is one.
+  bool GetStreet(uint32_t houseId, uint32_t & streetId) const;
+
+  // Calls |fn| for all houses matched to |streetId| in increasing
+  // order of ids.
+  template <typename Fn>
+  void ForEachHouse(uint32_t streetId, Fn && fn) const
+  {
+    auto it = std::lower_bound(m_streetHouses.begin(), m_streetHouses.end(),
+                               std::make_pair(streetId, uint32_t{0}));
+    for (; it != m_streetHouses.end() && it->first == streetId; ++it)
+      fn(it->second);
+  }
+
+  size_t GetNumPairs() const { return m_houses.size(); }
+
+private:
+  static uint16_t constexpr kLatestVersion = 0;
+
+  uint32_t m_numFeatures = 0;
+
+  // House -> street, sorted by houses.
+  std::vector<uint32_t> m_houses;
+  std::vector<uint32_t> m_houseStreets;
+
+  // Street -> house pairs, sorted by streets.
+  std::vector<std::pair<uint32_t, uint32_t>> m_streetHouses;
+};
+}  // namespace search
@@ -24,7 +24,7 @@ strings::LevenshteinDFA BuildLevenshteinDFA(strings::UniString const & s)
 {
   // In search we use LevenshteinDFAs for fuzzy matching. But due to
   // performance reasons, we assume that the first letter is always
-  // correct.
+  // correct. Keep it in sync with LevenshteinDFACache.
   return strings::LevenshteinDFA(s, 1 /* prefixCharsToKeep */, GetMaxErrorsForToken(s));
 }
 
@@ -11,6 +11,8 @@
 #include "indexer/scales.hpp"
 #include "indexer/drules_include.hpp"
 
+#include "platform/platform.hpp"
+
 #include "base/macros.hpp"
 #include "base/logging.hpp"
 
@@ -175,12 +177,26 @@ private:
 CPUDrawer::CPUDrawer(Params const & params)
   : m_generationCounter(0)
   , m_visualScale(params.m_visualScale)
+{
+  auto glyphCache = params.m_glyphCache;
+  if (glyphCache == nullptr)
+    glyphCache = CreateGlyphCache(m_visualScale);
+  m_renderer = make_unique<SoftwareRenderer>(glyphCache, params.m_resourcesPrefix);
+}
+
+// static
+shared_ptr<GlyphCache> CPUDrawer::CreateGlyphCache(double visualScale)
 {
   auto glyphParams = GlyphCache::Params("unicode_blocks.txt",
                                         "fonts_whitelist.txt",
                                         "fonts_blacklist.txt",
-                                        2 * 1024 * 1024, m_visualScale, false);
-  m_renderer = make_unique<SoftwareRenderer>(glyphParams, params.m_resourcesPrefix);
+                                        2 * 1024 * 1024, visualScale, false);
+  auto glyphCache = make_shared<GlyphCache>(glyphParams);
+
+  Platform::FilesList fonts;
+  GetPlatform().GetFontNames(fonts);
+  glyphCache->addFonts(fonts);
+  return glyphCache;
 }
 
 CPUDrawer::~CPUDrawer()
@@ -11,11 +11,13 @@
 
 #include "std/function.hpp"
 #include "std/list.hpp"
+#include "std/shared_ptr.hpp"
 #include "std/unique_ptr.hpp"
 
 namespace software_renderer
 {
 
+class GlyphCache;
 class SoftwareRenderer;
 
 class CPUDrawer
@@ -31,11 +33,16 @@ public:
 
     string m_resourcesPrefix;
     double m_visualScale;
+    // Drawers which work on different threads may share a glyph cache.
+    // A new glyph cache is created if it is not set.
+    shared_ptr<GlyphCache> m_glyphCache;
   };
 
   CPUDrawer(Params const & params);
   ~CPUDrawer();
 
+  static shared_ptr<GlyphCache> CreateGlyphCache(double visualScale);
+
   void BeginFrame(uint32_t width, uint32_t height, dp::Color const & bgColor);
   void Flush();
   void DrawMyPosition(m2::PointD const & myPxPotision);
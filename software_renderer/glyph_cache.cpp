@@ -63,21 +63,25 @@ GlyphCache::GlyphCache(Params const & params) : m_impl(new GlyphCacheImpl(params
 
 void GlyphCache::addFonts(vector<string> const & fontNames)
 {
+  lock_guard<mutex> lock(m_impl->m_mutex);
   m_impl->addFonts(fontNames);
 }
 
 pair<Font*, int> GlyphCache::getCharIDX(GlyphKey const & key)
 {
+  lock_guard<mutex> lock(m_impl->m_mutex);
   return m_impl->getCharIDX(key);
 }
 
 GlyphMetrics const GlyphCache::getGlyphMetrics(GlyphKey const & key)
 {
+  lock_guard<mutex> lock(m_impl->m_mutex);
   return m_impl->getGlyphMetrics(key);
 }
 
 shared_ptr<GlyphBitmap> const GlyphCache::getGlyphBitmap(GlyphKey const & key)
 {
+  lock_guard<mutex> lock(m_impl->m_mutex);
   return m_impl->getGlyphBitmap(key);
 }
 
@@ -85,10 +89,12 @@ double GlyphCache::getTextLength(double fontSize, string const & text)
 {
   strings::UniString const s = strings::MakeUniString(text);
   double len = 0;
+
+  lock_guard<mutex> lock(m_impl->m_mutex);
   for (unsigned i = 0; i < s.size(); ++i)
   {
     GlyphKey k(s[i], static_cast<uint32_t>(fontSize), false, dp::Color(0, 0, 0, 255));
-    len += getGlyphMetrics(k).m_xAdvance;
+    len += m_impl->getGlyphMetrics(k).m_xAdvance;
   }
 
   return len;
@@ -13,6 +13,7 @@
 
 #include "coding/reader.hpp"
 
+#include "std/mutex.hpp"
 #include "std/string.hpp"
 #include "std/vector.hpp"
 #include "std/shared_ptr.hpp"
@@ -81,6 +82,8 @@ struct GlyphCacheImpl
   typedef vector<shared_ptr<Font> > TFonts;
   TFonts m_fonts;
 
+  mutex m_mutex; //< guards the caches, GlyphCache may be shared between threads
+
   static FT_Error RequestFace(FTC_FaceID faceID, FT_Library library, FT_Pointer requestData, FT_Face * face);
 
   void initBlocks(string const & fileName);
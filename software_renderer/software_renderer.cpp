@@ -4,8 +4,6 @@
 #include "drape/symbols_texture.hpp"
 #include "drape/texture_manager.hpp"
 
-#include "platform/platform.hpp"
-
 #include "coding/parse_xml.hpp"
 
 #include "indexer/drawing_rules.hpp"
@@ -148,8 +146,9 @@ bool HasOutline(dp::FontDecl const & fontDecl)
   return fontDecl.m_outlineColor.GetAlfa() != 0;
 }
 
-SoftwareRenderer::SoftwareRenderer(GlyphCache::Params const & glyphCacheParams, string const & resourcesPostfix)
-  : m_glyphCache(new GlyphCache(glyphCacheParams))
+SoftwareRenderer::SoftwareRenderer(shared_ptr<GlyphCache> const & glyphCache,
+                                   string const & resourcesPostfix)
+  : m_glyphCache(glyphCache)
   , m_skinWidth(0)
   , m_skinHeight(0)
   , m_frameWidth(0)
@@ -158,12 +157,7 @@ SoftwareRenderer::SoftwareRenderer(GlyphCache::Params const & glyphCacheParams,
   , m_baseRenderer(m_pixelFormat)
   , m_solidRenderer(m_baseRenderer)
 {
-  Platform & pl = GetPlatform();
-
-  Platform::FilesList fonts;
-  pl.GetFontNames(fonts);
-  m_glyphCache->addFonts(fonts);
-
+  ASSERT(m_glyphCache != nullptr, ());
   VERIFY(dp::SymbolsTexture::DecodeToMemory(resourcesPostfix, dp::kDefaultSymbolsTexture,
                                             m_symbolsSkin, m_symbolsIndex, m_skinWidth, m_skinHeight), ());
   ASSERT_NOT_EQUAL(m_skinWidth, 0, ());
@@ -24,6 +24,7 @@
 
 #include "std/cstdint.hpp"
 #include "std/map.hpp"
+#include "std/shared_ptr.hpp"
 #include "std/unique_ptr.hpp"
 #include "std/vector.hpp"
 
@@ -35,7 +36,8 @@ class PathWrapper;
 class SoftwareRenderer
 {
 public:
-  SoftwareRenderer(GlyphCache::Params const & glyphCacheParams, string const & resourcesPostfix);
+  // |glyphCache| must have fonts added, it may be shared between renderers.
+  SoftwareRenderer(shared_ptr<GlyphCache> const & glyphCache, string const & resourcesPostfix);
 
   void BeginFrame(uint32_t width, uint32_t height, dp::Color const & bgColor);
 
@@ -114,7 +116,7 @@ public:
   using TSolidRenderer = agg::renderer_scanline_aa_solid<TBaseRenderer>;
 
 private:
-  unique_ptr<GlyphCache> m_glyphCache;
+  shared_ptr<GlyphCache> m_glyphCache;
   map<string, m2::RectU> m_symbolsIndex;
   vector<uint8_t> m_symbolsSkin;
   uint32_t m_skinWidth, m_skinHeight;
@@ -6,6 +6,7 @@
 
 #include <mutex>
 
+using std::defer_lock;
 using std::lock_guard;
 using std::mutex;
 using std::timed_mutex;
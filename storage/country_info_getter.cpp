@@ -4,10 +4,13 @@
 
 #include "platform/local_country_file_utils.hpp"
 
+#include "indexer/cell_id.hpp"
 #include "indexer/geometry_serialization.hpp"
 
 #include "geometry/latlon.hpp"
+#include "geometry/cellid.hpp"
 #include "geometry/mercator.hpp"
+#include "geometry/rect_intersect.hpp"
 #include "geometry/region2d.hpp"
 
 #include "coding/read_write_utils.hpp"
@@ -27,9 +30,15 @@ namespace
 {
 size_t const kInvalidId = numeric_limits<size_t>::max();
 
+// Cells of the lookup grid are about 10 km at the equator.
+using TGridCell = m2::CellId<13>;
+using TGridConverter = CellIdConverter<MercatorBounds, TGridCell>;
+// The grid cache is dropped when it grows above this size, about 4 MB.
+size_t const kMaxCachedCells = 100000;
+
 struct DoFreeCacheMemory
 {
-  void operator()(vector<m2::RegionD> & v) const { vector<m2::RegionD>().swap(v); }
+  void operator()(vector<m2::IndexedRegionD> & v) const { vector<m2::IndexedRegionD>().swap(v); }
 };
 
 class DoCalcUSA
@@ -270,19 +279,24 @@ CountryInfoReader::CountryInfoReader(ModelReaderPtr polyR, ModelReaderPtr countr
 
 void CountryInfoReader::ClearCachesImpl() const
 {
-  lock_guard<mutex> lock(m_cacheMutex);
+  {
+    lock_guard<mutex> lock(m_cacheMutex);
 
-  m_cache.ForEachValue(DoFreeCacheMemory());
-  m_cache.Reset();
+    m_cache.ForEachValue(DoFreeCacheMemory());
+    m_cache.Reset();
+  }
+
+  lock_guard<mutex> lock(m_cellsMutex);
+  unordered_map<uint64_t, CellLocation>().swap(m_cells);
 }
 
 template <typename TFn>
-typename result_of<TFn(vector<m2::RegionD>)>::type CountryInfoReader::WithRegion(size_t id, TFn && fn) const
+typename result_of<TFn(vector<m2::IndexedRegionD>)>::type CountryInfoReader::WithRegion(size_t id, TFn && fn) const
 {
   lock_guard<mutex> lock(m_cacheMutex);
 
   bool isFound = false;
-  vector<m2::RegionD> & rgns = m_cache.Find(static_cast<uint32_t>(id), isFound);
+  vector<m2::IndexedRegionD> & rgns = m_cache.Find(static_cast<uint32_t>(id), isFound);
 
   if (!isFound)
   {
@@ -295,7 +309,7 @@ typename result_of<TFn(vector<m2::RegionD>)>::type CountryInfoReader::WithRegion
     {
       vector<m2::PointD> points;
       serial::LoadOuterPath(src, serial::CodingParams(), points);
-      rgns.emplace_back(move(points));
+      rgns.emplace_back(m2::RegionD(move(points)));
     }
   }
 
@@ -303,9 +317,72 @@ typename result_of<TFn(vector<m2::RegionD>)>::type CountryInfoReader::WithRegion
 }
 
 
+CountryInfoReader::CellLocation CountryInfoReader::GetCellLocation(size_t id,
+                                                                  m2::PointD const & pt) const
+{
+  if (!MercatorBounds::FullRect().IsPointInside(pt))
+    return CellLocation::Border;
+
+  TGridCell const cell = TGridConverter::ToCellId(pt.x, pt.y);
+  uint64_t const key =
+      static_cast<uint64_t>(cell.ToInt64(TGridCell::DEPTH_LEVELS)) * m_countries.size() + id;
+  {
+    lock_guard<mutex> lock(m_cellsMutex);
+    auto const it = m_cells.find(key);
+    if (it != m_cells.end())
+      return it->second;
+  }
+
+  m2::RectD rect;
+  {
+    double minX, minY, maxX, maxY;
+    TGridConverter::GetCellBounds(cell, minX, minY, maxX, maxY);
+    rect = m2::RectD(minX, minY, maxX, maxY);
+  }
+
+  // A cell is inside the country if it's inside one of its regions. A region contains or doesn't
+  // intersect the cell when none of its edges crosses the cell.
+  auto classify = [&rect](vector<m2::IndexedRegionD> const & regions)
+  {
+    bool atBorder = false;
+    for (auto const & region : regions)
+    {
+      if (!region.GetRect().IsIntersect(rect))
+        continue;
+
+      auto const & points = region.Data();
+      bool crossed = false;
+      for (size_t i = 0; i < points.size() && !crossed; ++i)
+      {
+        m2::PointD p1 = points[i];
+        m2::PointD p2 = points[(i + 1) % points.size()];
+        crossed = m2::Intersect(rect, p1, p2);
+      }
+
+      if (crossed)
+        atBorder = true;
+      else if (region.Contains(rect.Center()))
+        return CellLocation::Inside;
+    }
+    return atBorder ? CellLocation::Border : CellLocation::Outside;
+  };
+
+  CellLocation const location = WithRegion(id, classify);
+
+  lock_guard<mutex> lock(m_cellsMutex);
+  if (m_cells.size() >= kMaxCachedCells)
+    m_cells.clear();
+  m_cells[key] = location;
+  return location;
+}
+
 bool CountryInfoReader::IsBelongToRegionImpl(size_t id, m2::PointD const & pt) const
 {
-  auto contains = [&pt](vector<m2::RegionD> const & regions)
+  CellLocation const location = GetCellLocation(id, pt);
+  if (location != CellLocation::Border)
+    return location == CellLocation::Inside;
+
+  auto contains = [&pt](vector<m2::IndexedRegionD> const & regions)
   {
     for (auto const & region : regions)
     {
@@ -327,7 +404,7 @@ bool CountryInfoReader::IsIntersectedByRegionImpl(size_t id, m2::RectD const & r
     {rect.RightBottom(), rect.LeftBottom()},
     {rect.LeftBottom(), rect.LeftTop()}
   };
-  auto contains = [&edges](vector<m2::RegionD> const & regions)
+  auto contains = [&edges](vector<m2::IndexedRegionD> const & regions)
   {
     for (auto const & region : regions)
     {
@@ -350,7 +427,7 @@ bool CountryInfoReader::IsIntersectedByRegionImpl(size_t id, m2::RectD const & r
 bool CountryInfoReader::IsCloseEnough(size_t id, m2::PointD const & pt, double distance)
 {
   m2::RectD const lookupRect = MercatorBounds::RectByCenterXYAndSizeInMeters(pt, distance);
-  auto isCloseEnough = [&](vector<m2::RegionD> const & regions)
+  auto isCloseEnough = [&](vector<m2::IndexedRegionD> const & regions)
   {
     for (auto const & region : regions)
     {
@@ -156,11 +156,27 @@ protected:
   bool IsCloseEnough(size_t id, m2::PointD const & pt, double distance) override;
 
   template <typename TFn>
-  typename result_of<TFn(vector<m2::RegionD>)>::type WithRegion(size_t id, TFn && fn) const;
+  typename result_of<TFn(vector<m2::IndexedRegionD>)>::type WithRegion(size_t id, TFn && fn) const;
 
   FilesContainerR m_reader;
-  mutable my::Cache<uint32_t, vector<m2::RegionD>> m_cache;
+  mutable my::Cache<uint32_t, vector<m2::IndexedRegionD>> m_cache;
   mutable mutex m_cacheMutex;
+
+private:
+  enum class CellLocation : uint8_t
+  {
+    Inside,
+    Outside,
+    Border
+  };
+
+  // Returns location of the grid cell which contains |pt| relative to the country |id|.
+  // Cells are classified on first use. Only points of border cells need polygon tests.
+  CellLocation GetCellLocation(size_t id, m2::PointD const & pt) const;
+
+  // Maps a pair of a grid cell and a country to the location of the cell.
+  mutable unordered_map<uint64_t, CellLocation> m_cells;
+  mutable mutex m_cellsMutex;
 };
 
 // This class allows users to get info about very simply rectangular
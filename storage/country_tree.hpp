@@ -3,17 +3,17 @@
 #include "base/assert.hpp"
 
 #include "std/algorithm.hpp"
-#include "std/map.hpp"
 #include "std/unique_ptr.hpp"
+#include "std/utility.hpp"
 #include "std/vector.hpp"
 
 /// \brief This class is developed for using in Storage. It's a implementation of a tree with
 /// ability
-/// of access to its nodes in expected constant time with the help of hash table.
+/// of access to its nodes in logarithmic time with the help of a sorted vector of keys.
 /// It should be filled with AddAtDepth method.
 /// This class is used in Storage and filled based on countries.txt (countries_migrate.txt).
 /// While filling CountryTree nodes in countries.txt should be visited in DFS order.
-/// \param TKey is a type of keys to look for |TValue| in |m_countryTreeHashTable|.
+/// \param TKey is a type of keys to look for |TValue| in |m_countryTreeIndex|.
 /// \param TValue is a type of values which are saved in |m_countryTree| nodes.
 template <class TKey, class TValue>
 class CountryTree
@@ -154,7 +154,10 @@ public:
   };
 
 private:
-  using TCountryTreeHashTable = multimap<TKey, Node *>;
+  /// Pairs of keys and nodes sorted by keys. Nodes with equal keys are kept in the order
+  /// they were added. The vector is compact and cache friendly in comparison with a multimap,
+  /// and lookups don't allocate memory.
+  using TCountryTreeIndex = vector<pair<TKey, Node *>>;
 
 public:
   bool IsEmpty() const { return m_countryTree == nullptr; }
@@ -186,7 +189,9 @@ public:
     }
 
     ASSERT(added, ());
-    m_countryTreeHashTable.insert(make_pair(value.Name(), added));
+    auto const it = upper_bound(m_countryTreeIndex.begin(), m_countryTreeIndex.end(),
+                                value.Name(), LessKey());
+    m_countryTreeIndex.emplace(it, value.Name(), added);
     return added->Value();
   }
 
@@ -194,7 +199,7 @@ public:
   void Clear()
   {
     m_countryTree.reset();
-    m_countryTreeHashTable.clear();
+    m_countryTreeIndex.clear();
   }
 
   /// \brief Checks all nodes in tree to find an equal one. If there're several equal nodes
@@ -203,33 +208,25 @@ public:
   void Find(TKey const & key, vector<Node const *> & found) const
   {
     found.clear();
-    if (IsEmpty())
-      return;
-
-    if (key == m_countryTree->Value().Name())
-      found.push_back(m_countryTree.get());
-
-    auto const range = m_countryTreeHashTable.equal_range(key);
-    if (range.first == range.second)
-      return;
+    ForEachEqual(key, [&found](Node const * node) { found.push_back(node); });
+  }
 
-    for_each(range.first, range.second,
-             [&found](typename TCountryTreeHashTable::value_type const & node)
-    {
-      found.push_back(node.second);
-    });
+  /// \returns the number of nodes Find() finds for |key|.
+  size_t Count(TKey const & key) const
+  {
+    size_t count = 0;
+    ForEachEqual(key, [&count](Node const *) { ++count; });
+    return count;
   }
 
   Node const * const FindFirst(TKey const & key) const
   {
-    if (IsEmpty())
-      return nullptr;
-
-    vector<Node const *> found;
-    Find(key, found);
-    if (found.empty())
-      return nullptr;
-    return found[0];
+    Node const * result = nullptr;
+    ForEachEqual(key, [&result](Node const * node) {
+      if (result == nullptr)
+        result = node;
+    });
+    return result;
   }
 
   /// \brief Find only leaves.
@@ -239,21 +236,43 @@ public:
   /// @TODO(bykoianko) Remove this method on countries.txt update.
   Node const * const FindFirstLeaf(TKey const & key) const
   {
-    if (IsEmpty())
-      return nullptr;
-
-    vector<Node const *> found;
-    Find(key, found);
+    Node const * result = nullptr;
+    ForEachEqual(key, [&result](Node const * node) {
+      if (result == nullptr && node->ChildrenCount() == 0)
+        result = node;
+    });
+    return result;
+  }
 
-    for (auto node : found)
+private:
+  struct LessKey
+  {
+    bool operator()(TKey const & lhs, typename TCountryTreeIndex::value_type const & rhs) const
     {
-      if (node->ChildrenCount() == 0)
-        return node;
+      return lhs < rhs.first;
     }
-    return nullptr;
+    bool operator()(typename TCountryTreeIndex::value_type const & lhs, TKey const & rhs) const
+    {
+      return lhs.first < rhs;
+    }
+  };
+
+  /// Calls |fn| for the nodes with |key| in the order of Find().
+  template <typename TFn>
+  void ForEachEqual(TKey const & key, TFn && fn) const
+  {
+    if (IsEmpty())
+      return;
+
+    if (key == m_countryTree->Value().Name())
+      fn(static_cast<Node const *>(m_countryTree.get()));
+
+    auto const range =
+        equal_range(m_countryTreeIndex.begin(), m_countryTreeIndex.end(), key, LessKey());
+    for (auto it = range.first; it != range.second; ++it)
+      fn(static_cast<Node const *>(it->second));
   }
 
-private:
   unique_ptr<Node> m_countryTree;
-  TCountryTreeHashTable m_countryTreeHashTable;
+  TCountryTreeIndex m_countryTreeIndex;
 };
@@ -5,6 +5,7 @@
 
 #include "base/assert.hpp"
 
+#include "std/algorithm.hpp"
 #include "std/bind.hpp"
 #include "base/string_utils.hpp"
 
@@ -26,6 +27,9 @@ public:
 
 namespace storage
 {
+// static
+size_t constexpr HttpMapFilesDownloader::kMaxConnectionsCount;
+
 HttpMapFilesDownloader::~HttpMapFilesDownloader()
 {
   ASSERT_THREAD_CHECKER(m_checker, ());
@@ -48,7 +52,9 @@ void HttpMapFilesDownloader::DownloadMapFile(vector<string> const & urls, string
   ASSERT_THREAD_CHECKER(m_checker, ());
   m_request.reset(downloader::HttpRequest::GetFile(
       urls, path, size, bind(&HttpMapFilesDownloader::OnMapFileDownloaded, this, onDownloaded, _1),
-      bind(&HttpMapFilesDownloader::OnMapFileDownloadingProgress, this, onProgress, _1)));
+      bind(&HttpMapFilesDownloader::OnMapFileDownloadingProgress, this, onProgress, _1),
+      512 * 1024 /* chunkSize */, true /* doCleanOnCancel */,
+      GetConnectionsPerServer(urls.size())));
 
   if (!m_request)
   {
@@ -77,6 +83,14 @@ void HttpMapFilesDownloader::Reset()
   m_request.reset();
 }
 
+// static
+size_t HttpMapFilesDownloader::GetConnectionsPerServer(size_t serversCount)
+{
+  if (serversCount == 0)
+    return 1;
+  return max(kMaxConnectionsCount / serversCount, static_cast<size_t>(1));
+}
+
 void HttpMapFilesDownloader::OnServersListDownloaded(TServersListCallback const & callback,
                                                      downloader::HttpRequest & request)
 {
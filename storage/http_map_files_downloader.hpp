@@ -14,6 +14,10 @@ namespace storage
 class HttpMapFilesDownloader : public MapFilesDownloader
 {
 public:
+  // Total number of simultaneous connections used for one map file. They are distributed
+  // evenly between servers, every server gets at least one connection.
+  static size_t constexpr kMaxConnectionsCount = 6;
+
   virtual ~HttpMapFilesDownloader();
 
   // MapFilesDownloader overrides:
@@ -25,6 +29,8 @@ public:
   bool IsIdle() override;
   void Reset() override;
 
+  static size_t GetConnectionsPerServer(size_t serversCount);
+
 private:
   void OnServersListDownloaded(TServersListCallback const & callback,
                                downloader::HttpRequest & request);
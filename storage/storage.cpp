@@ -1385,9 +1385,7 @@ StatusAndError Storage::GetNodeStatus(TCountryTreeNode const & node) const
 
 bool Storage::IsDisputed(TCountryTreeNode const & node) const
 {
-  vector<TCountryTreeNode const *> found;
-  m_countries.Find(node.Value().Name(), found);
-  return found.size() > 1;
+  return m_countries.Count(node.Value().Name()) > 1;
 }
 
 void Storage::CalMaxMwmSizeBytes()
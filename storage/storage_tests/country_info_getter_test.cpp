@@ -132,6 +132,29 @@ UNIT_TEST(CountryInfoGetter_SomeRects)
   LOG(LINFO, ("Canada: ", getter->CalcLimitRect("Canada_")));
 }
 
+UNIT_TEST(CountryInfoGetter_GetByPoint_CachedCells)
+{
+  auto const getter = CreateCountryInfoGetter();
+
+  // Goes from Poland to Belarus across the border, the second pass uses classified cells.
+  vector<m2::PointD> points;
+  for (double lon = 18.0; lon <= 27.56; lon += 0.01)
+    points.push_back(MercatorBounds::FromLatLon(53.9022651, lon));
+
+  vector<TCountryId> countries;
+  for (auto const & pt : points)
+    countries.push_back(getter->GetRegionCountryId(pt));
+  TEST_EQUAL(countries.front(), "Poland", ());
+  TEST_EQUAL(countries.back(), "Belarus", ());
+
+  for (size_t i = 0; i < points.size(); ++i)
+    TEST_EQUAL(getter->GetRegionCountryId(points[i]), countries[i], (i));
+
+  getter->ClearCaches();
+  for (size_t i = 0; i < points.size(); i += 10)
+    TEST_EQUAL(getter->GetRegionCountryId(points[i]), countries[i], (i));
+}
+
 UNIT_TEST(CountryInfoGetter_HitsInRadius)
 {
   auto const getter = CreateCountryInfoGetterMigrate();
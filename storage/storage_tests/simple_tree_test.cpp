@@ -58,3 +58,46 @@ UNIT_TEST(CountryTree_Smoke)
   tree.Child(4).Child(0).ForEachAncestorExceptForTheRoot(c3);
   TEST_EQUAL(c3.count, 1, ());
 }
+
+namespace
+{
+struct NamedValue
+{
+  NamedValue(int name = 0) : m_name(name) {}
+  int Name() const { return m_name; }
+
+  int m_name;
+};
+}  // namespace
+
+UNIT_TEST(CountryTree_Find)
+{
+  CountryTree<int, NamedValue> tree;
+  tree.AddAtDepth(0, NamedValue(0));
+  tree.AddAtDepth(1, NamedValue(5));
+  tree.AddAtDepth(2, NamedValue(7));
+  tree.AddAtDepth(1, NamedValue(3));
+  tree.AddAtDepth(2, NamedValue(7));
+  tree.AddAtDepth(3, NamedValue(8));
+  tree.AddAtDepth(1, NamedValue(1));
+
+  vector<CountryTree<int, NamedValue>::Node const *> found;
+  tree.Find(7, found);
+  TEST_EQUAL(found.size(), 2, ());
+  // Nodes with equal keys are found in the order they were added.
+  TEST_EQUAL(found[0]->Parent().Value().Name(), 5, ());
+  TEST_EQUAL(found[1]->Parent().Value().Name(), 3, ());
+  TEST_EQUAL(tree.Count(7), 2, ());
+  TEST_EQUAL(tree.FindFirst(7), found[0], ());
+  TEST_EQUAL(tree.FindFirstLeaf(7), found[0], ());
+  TEST_EQUAL(tree.FindFirstLeaf(8)->Parent().Parent().Value().Name(), 3, ());
+
+  TEST_EQUAL(tree.Count(1), 1, ());
+  TEST_EQUAL(tree.Count(4), 0, ());
+  TEST(tree.FindFirst(4) == nullptr, ());
+  TEST(tree.FindFirstLeaf(3) == nullptr, ());
+
+  tree.Clear();
+  TEST(tree.IsEmpty(), ());
+  TEST_EQUAL(tree.Count(7), 0, ());
+}
@@ -1,8 +1,15 @@
 #pragma once
 #include "testing/testing.hpp"
 #include "testing/testregister.hpp"
+#include "base/logging.hpp"
 #include "base/timer.hpp"
+#include "std/algorithm.hpp"
+#include "std/chrono.hpp"
+#include "std/cstdint.hpp"
+#include "std/ctime.hpp"
 #include "std/iostream.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
 
 namespace my
 {
@@ -54,3 +61,76 @@ namespace my
 #define BENCHMARK_N_TIMES(times, maxTimeToSucceed) \
     for (::my::BenchmarkNTimes benchmark(times, maxTimeToSucceed); \
          benchmark.ContinueIterating(); benchmark.NextIteration())
+
+namespace testing
+{
+/// Number and total size of allocations by operator new on all threads since the start of a test
+/// program. Both are zero when OMIM_UNIT_TEST_DISABLE_ALLOCATION_COUNTING is defined for it.
+struct AllocationStats
+{
+  uint64_t m_count = 0;
+  uint64_t m_bytes = 0;
+};
+AllocationStats GetAllocationStats();
+
+/// Stats of a single repetition of a benchmark.
+struct BenchmarkResult
+{
+  string m_name;
+  uint32_t m_repetitions = 0;
+  double m_minWallNs = 0.0;
+  double m_medianWallNs = 0.0;
+  double m_meanWallNs = 0.0;
+  /// CPU time of the process, i.e. of all threads.
+  double m_meanCpuNs = 0.0;
+  double m_allocations = 0.0;
+  double m_allocatedBytes = 0.0;
+};
+string DebugPrint(BenchmarkResult const & result);
+
+/// Keeps |result| to be written to the file passed by --benchmark_json.
+void AddBenchmarkResult(BenchmarkResult const & result);
+
+/// Calls |fn| |warmUps| times to warm up caches, then |repetitions| times with measurements.
+/// The result is logged and is written to the JSON report of the test program.
+template <typename Fn>
+BenchmarkResult RunBenchmark(string const & name, uint32_t warmUps, uint32_t repetitions, Fn && fn)
+{
+  TEST_GREATER(repetitions, 0, (name));
+
+  for (uint32_t i = 0; i < warmUps; ++i)
+    fn();
+
+  vector<double> wallNs(repetitions);
+  AllocationStats const allocationsBefore = GetAllocationStats();
+  std::clock_t const cpuBefore = std::clock();
+  for (uint32_t i = 0; i < repetitions; ++i)
+  {
+    auto const start = steady_clock::now();
+    fn();
+    wallNs[i] = duration<double, std::nano>(steady_clock::now() - start).count();
+  }
+  std::clock_t const cpuAfter = std::clock();
+  AllocationStats const allocationsAfter = GetAllocationStats();
+
+  BenchmarkResult result;
+  result.m_name = name;
+  result.m_repetitions = repetitions;
+  for (double const ns : wallNs)
+    result.m_meanWallNs += ns / repetitions;
+  result.m_meanCpuNs =
+      static_cast<double>(cpuAfter - cpuBefore) * 1e9 / CLOCKS_PER_SEC / repetitions;
+  result.m_allocations =
+      static_cast<double>(allocationsAfter.m_count - allocationsBefore.m_count) / repetitions;
+  result.m_allocatedBytes =
+      static_cast<double>(allocationsAfter.m_bytes - allocationsBefore.m_bytes) / repetitions;
+  auto const median = wallNs.begin() + wallNs.size() / 2;
+  nth_element(wallNs.begin(), median, wallNs.end());
+  result.m_medianWallNs = *median;
+  result.m_minWallNs = *min_element(wallNs.begin(), median + 1);
+
+  LOG(LINFO, (result));
+  AddBenchmarkResult(result);
+  return result;
+}
+}  // namespace testing
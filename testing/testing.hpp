@@ -54,7 +54,7 @@ struct CommandLineOptions
 {
   CommandLineOptions()
       : m_filterRegExp(nullptr), m_suppressRegExp(nullptr),
-      m_dataPath(nullptr), m_resourcePath(nullptr), m_help(false)
+      m_dataPath(nullptr), m_resourcePath(nullptr), m_benchmarkJsonPath(nullptr), m_help(false)
   {
   }
 
@@ -62,6 +62,7 @@ struct CommandLineOptions
   char const * m_suppressRegExp;
   char const * m_dataPath;
   char const * m_resourcePath;
+  char const * m_benchmarkJsonPath;
 
   bool m_help;
   bool m_listTests;
@@ -1,3 +1,4 @@
+#include "testing/benchmark.hpp"
 #include "testing/testing.hpp"
 #include "testing/testregister.hpp"
 
@@ -6,15 +7,21 @@
 #include "base/timer.hpp"
 #include "base/waiter.hpp"
 
+#include "std/atomic.hpp"
 #include "std/chrono.hpp"
+#include "std/cstdlib.hpp"
 #include "std/cstring.hpp"
+#include "std/fstream.hpp"
 #include "std/iomanip.hpp"
 #include "std/iostream.hpp"
+#include "std/sstream.hpp"
 #include "std/regex.hpp"
 #include "std/string.hpp"
 #include "std/target_os.hpp"
 #include "std/vector.hpp"
 
+#include <new>
+
 #ifdef TARGET_OS_IPHONE
 # include <CoreFoundation/CoreFoundation.h>
 #endif
@@ -37,7 +44,30 @@
 namespace
 {
 base::Waiter g_waiter;
+
+atomic<uint64_t> g_numAllocations(0);
+atomic<uint64_t> g_allocatedBytes(0);
+
+vector<testing::BenchmarkResult> g_benchmarkResults;
 }  // namespace
+
+#ifndef OMIM_UNIT_TEST_DISABLE_ALLOCATION_COUNTING
+// Allocations are counted for benchmarks.
+void * operator new(size_t size)
+{
+  g_numAllocations.fetch_add(1, std::memory_order_relaxed);
+  g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+  if (void * p = std::malloc(size == 0 ? 1 : size))
+    return p;
+  throw std::bad_alloc();
+}
+
+void * operator new[](size_t size) { return operator new(size); }
+
+void operator delete(void * p) noexcept { std::free(p); }
+
+void operator delete[](void * p) noexcept { std::free(p); }
+#endif  // OMIM_UNIT_TEST_DISABLE_ALLOCATION_COUNTING
 namespace testing
 {
 
@@ -69,6 +99,27 @@ void Notify()
 {
   g_waiter.Notify();
 }
+
+AllocationStats GetAllocationStats()
+{
+  AllocationStats stats;
+  stats.m_count = g_numAllocations.load(std::memory_order_relaxed);
+  stats.m_bytes = g_allocatedBytes.load(std::memory_order_relaxed);
+  return stats;
+}
+
+string DebugPrint(BenchmarkResult const & result)
+{
+  ostringstream os;
+  os << "BenchmarkResult [ " << result.m_name << ", repetitions: " << result.m_repetitions
+     << ", wall ns min: " << result.m_minWallNs << ", median: " << result.m_medianWallNs
+     << ", mean: " << result.m_meanWallNs << ", cpu ns mean: " << result.m_meanCpuNs
+     << ", allocations: " << result.m_allocations << ", bytes: " << result.m_allocatedBytes
+     << " ]";
+  return os.str();
+}
+
+void AddBenchmarkResult(BenchmarkResult const & result) { g_benchmarkResults.push_back(result); }
 } //  namespace testing
 
 namespace
@@ -83,6 +134,7 @@ char const kHelpOption[] = "--help";
 char const kDataPathOptions[] = "--data_path=";
 char const kResourcePathOptions[] = "--user_resource_path=";
 char const kListAllTestsOption[] = "--list_tests";
+char const kBenchmarkJsonOption[] = "--benchmark_json=";
 
 enum Status
 {
@@ -113,6 +165,8 @@ void Usage(char const * name)
                 "Do not run tests with names corresponding to regexp.");
   DisplayOption(cerr, kDataPathOptions, "<Path>", "Path to data files.");
   DisplayOption(cerr, kResourcePathOptions, "<Path>", "Path to resources, styles and classificators.");
+  DisplayOption(cerr, kBenchmarkJsonOption, "<Path>",
+                "Write results of benchmarks which were run to a JSON file.");
   DisplayOption(cerr, kListAllTestsOption, "List all the tests in the test suite and exit.");
   DisplayOption(cerr, kHelpOption, "Print this help message and exit.");
 }
@@ -130,12 +184,43 @@ void ParseOptions(int argc, char * argv[], CommandLineOptions & options)
       options.m_dataPath = arg + sizeof(kDataPathOptions) - 1;
     if (strings::StartsWith(arg, kResourcePathOptions))
       options.m_resourcePath = arg + sizeof(kResourcePathOptions) - 1;
+    if (strings::StartsWith(arg, kBenchmarkJsonOption))
+      options.m_benchmarkJsonPath = arg + sizeof(kBenchmarkJsonOption) - 1;
     if (strcmp(arg, kHelpOption) == 0)
       options.m_help = true;
     if (strcmp(arg, kListAllTestsOption) == 0)
       options.m_listTests = true;
   }
 }
+
+string EscapeJson(string const & s)
+{
+  string result;
+  for (char const c : s)
+  {
+    if (c == '"' || c == '\\')
+      result += '\\';
+    result += c;
+  }
+  return result;
+}
+
+bool WriteBenchmarkResults(string const & path)
+{
+  ofstream os(path);
+  os << fixed << setprecision(1) << "{\"benchmarks\": [";
+  for (size_t i = 0; i < g_benchmarkResults.size(); ++i)
+  {
+    auto const & r = g_benchmarkResults[i];
+    os << (i == 0 ? "\n" : ",\n") << "  {\"name\": \"" << EscapeJson(r.m_name) << "\""
+       << ", \"repetitions\": " << r.m_repetitions << ", \"min_wall_ns\": " << r.m_minWallNs
+       << ", \"median_wall_ns\": " << r.m_medianWallNs << ", \"mean_wall_ns\": " << r.m_meanWallNs
+       << ", \"mean_cpu_ns\": " << r.m_meanCpuNs << ", \"allocations\": " << r.m_allocations
+       << ", \"allocated_bytes\": " << r.m_allocatedBytes << "}";
+  }
+  os << "\n]}\n";
+  return static_cast<bool>(os);
+}
 }  // namespace
 
 CommandLineOptions const & GetTestingOptions()
@@ -274,6 +359,13 @@ int main(int argc, char * argv[])
     LOG(LINFO, ("Test took", elapsed / 1000000, "ms\n"));
   }
 
+  if (g_testingOptions.m_benchmarkJsonPath &&
+      !WriteBenchmarkResults(g_testingOptions.m_benchmarkJsonPath))
+  {
+    LOG(LERROR, ("Can't write results of benchmarks to", g_testingOptions.m_benchmarkJsonPath));
+    return STATUS_FAILED;
+  }
+
   if (numFailedTests != 0)
   {
     LOG(LINFO, (numFailedTests, " tests failed:"));
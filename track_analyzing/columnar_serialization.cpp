@@ -0,0 +1,381 @@
+#include "track_analyzing/columnar_serialization.hpp"
+
+#include "routing/segment.hpp"
+
+#include "platform/country_file.hpp"
+
+#include "coding/endianness.hpp"
+#include "coding/point_to_integer.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/traffic.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/zlib.hpp"
+
+#include "geometry/latlon.hpp"
+
+#include "base/assert.hpp"
+#include "base/bits.hpp"
+#include "base/checked_cast.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <utility>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+using Buffer = vector<uint8_t>;
+using Source = ReaderSource<MemReaderWithExceptions>;
+
+char const kMagic[] = {'T', 'R', 'K', 'C'};
+uint8_t constexpr kVersion = 0;
+uint64_t constexpr kHeaderSize = sizeof(kMagic) + sizeof(kVersion);
+uint64_t constexpr kFooterSize = sizeof(uint64_t);
+
+// Indexes of the columns in a block.
+size_t constexpr kLengthsColumn = 0;
+size_t constexpr kSegmentsColumn = 1;
+size_t constexpr kTimestampsColumn = 2;
+size_t constexpr kCoordinatesColumn = 3;
+size_t constexpr kTrafficColumn = 4;
+
+uint32_t QuantizeLat(double lat)
+{
+  return DoubleToUint32(lat, ms::LatLon::kMinLat, ms::LatLon::kMaxLat,
+                        coding::TrafficGPSEncoder::kCoordBits);
+}
+
+uint32_t QuantizeLon(double lon)
+{
+  return DoubleToUint32(lon, ms::LatLon::kMinLon, ms::LatLon::kMaxLon,
+                        coding::TrafficGPSEncoder::kCoordBits);
+}
+
+double DequantizeLat(uint32_t lat)
+{
+  return Uint32ToDouble(lat, ms::LatLon::kMinLat, ms::LatLon::kMaxLat,
+                        coding::TrafficGPSEncoder::kCoordBits);
+}
+
+double DequantizeLon(uint32_t lon)
+{
+  return Uint32ToDouble(lon, ms::LatLon::kMinLon, ms::LatLon::kMaxLon,
+                        coding::TrafficGPSEncoder::kCoordBits);
+}
+
+template <typename T>
+int64_t Delta(T current, T prev)
+{
+  return static_cast<int64_t>(current) - static_cast<int64_t>(prev);
+}
+
+template <typename T>
+T ApplyDelta(T prev, int64_t delta)
+{
+  return static_cast<T>(static_cast<int64_t>(prev) + delta);
+}
+
+// Writes columns of |tracks| and returns their compressed sizes.
+array<uint64_t, track_analyzing::ColumnarTracksSerializer::BlockInfo::kColumnsCount> WriteBlock(
+    vector<track_analyzing::MatchedTrack> const & tracks, Writer & writer)
+{
+  using track_analyzing::ColumnarTracksSerializer;
+
+  array<Buffer, ColumnarTracksSerializer::BlockInfo::kColumnsCount> columns;
+  MemWriter<Buffer> lengths(columns[kLengthsColumn]);
+  MemWriter<Buffer> segments(columns[kSegmentsColumn]);
+  MemWriter<Buffer> timestamps(columns[kTimestampsColumn]);
+  MemWriter<Buffer> coordinates(columns[kCoordinatesColumn]);
+  MemWriter<Buffer> traffic(columns[kTrafficColumn]);
+
+  // Deltas run through all tracks of a block, tracks of a user usually follow each other.
+  uint32_t prevFeatureId = 0;
+  uint32_t prevSegmentIdx = 0;
+  uint64_t prevTimestamp = 0;
+  uint32_t prevLat = 0;
+  uint32_t prevLon = 0;
+
+  for (auto const & track : tracks)
+  {
+    CHECK(!track.empty(), ());
+    WriteVarUint(lengths, base::checked_cast<uint64_t>(track.size()));
+
+    for (auto const & point : track)
+    {
+      Segment const & segment = point.GetSegment();
+      WriteVarInt(segments, Delta(segment.GetFeatureId(), prevFeatureId));
+      // The direction is kept in the lowest bit of the segment index delta.
+      uint64_t const segmentIdxDelta =
+          bits::ZigZagEncode(Delta(segment.GetSegmentIdx(), prevSegmentIdx));
+      WriteVarUint(segments, (segmentIdxDelta << 1) | (segment.IsForward() ? 1 : 0));
+      prevFeatureId = segment.GetFeatureId();
+      prevSegmentIdx = segment.GetSegmentIdx();
+
+      track_analyzing::DataPoint const & dataPoint = point.GetDataPoint();
+      WriteVarInt(timestamps, Delta(dataPoint.m_timestamp, prevTimestamp));
+      prevTimestamp = dataPoint.m_timestamp;
+
+      uint32_t const lat = QuantizeLat(dataPoint.m_latLon.lat);
+      uint32_t const lon = QuantizeLon(dataPoint.m_latLon.lon);
+      WriteVarInt(coordinates, Delta(lat, prevLat));
+      WriteVarInt(coordinates, Delta(lon, prevLon));
+      prevLat = lat;
+      prevLon = lon;
+
+      WriteToSink(traffic, dataPoint.m_traffic);
+    }
+  }
+
+  coding::ZLib::Deflate const deflate(coding::ZLib::Deflate::Format::ZLib,
+                                      coding::ZLib::Deflate::Level::DefaultCompression);
+  array<uint64_t, ColumnarTracksSerializer::BlockInfo::kColumnsCount> sizes;
+  for (size_t i = 0; i < columns.size(); ++i)
+  {
+    Buffer compressed;
+    CHECK(deflate(columns[i].data(), columns[i].size(), back_inserter(compressed)), ());
+    writer.Write(compressed.data(), compressed.size());
+    sizes[i] = compressed.size();
+  }
+  return sizes;
+}
+
+Buffer ReadColumn(Reader const & reader, uint64_t offset, uint64_t size)
+{
+  Buffer compressed(base::checked_cast<size_t>(size));
+  reader.Read(offset, compressed.data(), compressed.size());
+
+  Buffer column;
+  coding::ZLib::Inflate const inflate(coding::ZLib::Inflate::Format::ZLib);
+  if (!inflate(compressed.data(), compressed.size(), back_inserter(column)))
+  {
+    MYTHROW(track_analyzing::ColumnarTracksSerializer::FormatException,
+            ("Can't inflate column at", offset));
+  }
+  return column;
+}
+}  // namespace
+
+namespace track_analyzing
+{
+// static
+size_t constexpr ColumnarTracksSerializer::BlockInfo::kColumnsCount;
+
+ColumnarTracksSerializer::ColumnarTracksSerializer(shared_ptr<NumMwmIds> numMwmIds)
+  : m_numMwmIds(move(numMwmIds))
+{
+  CHECK(m_numMwmIds, ());
+}
+
+// static
+bool ColumnarTracksSerializer::IsColumnar(Reader const & reader)
+{
+  if (reader.Size() < kHeaderSize + kFooterSize)
+    return false;
+
+  char magic[sizeof(kMagic)];
+  reader.Read(0 /* pos */, magic, sizeof(magic));
+  return memcmp(magic, kMagic, sizeof(kMagic)) == 0;
+}
+
+void ColumnarTracksSerializer::Serialize(MwmToMatchedTracks const & mwmToMatchedTracks,
+                                         Writer & writer) const
+{
+  uint64_t const startPos = writer.Pos();
+  writer.Write(kMagic, sizeof(kMagic));
+  WriteToSink(writer, kVersion);
+
+  // Blocks are sorted by mwm names and users, so the index may be searched by a reader.
+  vector<pair<string, UserToMatchedTracks const *>> mwms;
+  for (auto const & it : mwmToMatchedTracks)
+    mwms.emplace_back(m_numMwmIds->GetFile(it.first).GetName(), &it.second);
+  sort(mwms.begin(), mwms.end());
+
+  vector<BlockInfo> index;
+  for (auto const & mwm : mwms)
+  {
+    vector<string const *> users;
+    for (auto const & it : *mwm.second)
+      users.push_back(&it.first);
+    sort(users.begin(), users.end(),
+         [](string const * lhs, string const * rhs) { return *lhs < *rhs; });
+
+    for (string const * user : users)
+    {
+      vector<MatchedTrack> const & tracks = mwm.second->at(*user);
+      CHECK(!tracks.empty(), ());
+
+      BlockInfo block;
+      block.m_mwmName = mwm.first;
+      block.m_user = *user;
+      block.m_offset = writer.Pos() - startPos;
+      block.m_tracksCount = tracks.size();
+      for (auto const & track : tracks)
+        block.m_pointsCount += track.size();
+      block.m_columnSizes = WriteBlock(tracks, writer);
+      index.push_back(move(block));
+    }
+  }
+
+  uint64_t const indexOffset = writer.Pos() - startPos;
+  WriteVarUint(writer, base::checked_cast<uint64_t>(index.size()));
+  for (BlockInfo const & block : index)
+  {
+    rw::Write(writer, block.m_mwmName);
+    rw::Write(writer, block.m_user);
+    WriteVarUint(writer, block.m_offset);
+    WriteVarUint(writer, block.m_tracksCount);
+    WriteVarUint(writer, block.m_pointsCount);
+    for (uint64_t size : block.m_columnSizes)
+      WriteVarUint(writer, size);
+  }
+  WriteToSink(writer, indexOffset);
+}
+
+// static
+vector<ColumnarTracksSerializer::BlockInfo> ColumnarTracksSerializer::ReadIndex(
+    Reader const & reader)
+{
+  if (!IsColumnar(reader))
+    MYTHROW(FormatException, ("Not a columnar tracks file"));
+
+  uint8_t version;
+  reader.Read(sizeof(kMagic), &version, sizeof(version));
+  if (version != kVersion)
+    MYTHROW(FormatException, ("Unknown version of columnar tracks:", version));
+
+  uint64_t const size = reader.Size();
+  uint64_t indexOffset;
+  reader.Read(size - kFooterSize, &indexOffset, sizeof(indexOffset));
+  indexOffset = SwapIfBigEndian(indexOffset);
+  if (indexOffset < kHeaderSize || indexOffset > size - kFooterSize)
+    MYTHROW(FormatException, ("Bad index offset:", indexOffset, "file size:", size));
+
+  Buffer buffer(base::checked_cast<size_t>(size - kFooterSize - indexOffset));
+  reader.Read(indexOffset, buffer.data(), buffer.size());
+  MemReaderWithExceptions memReader(buffer.data(), buffer.size());
+  Source src(memReader);
+
+  vector<BlockInfo> index(base::checked_cast<size_t>(ReadVarUint<uint64_t>(src)));
+  for (BlockInfo & block : index)
+  {
+    rw::Read(src, block.m_mwmName);
+    rw::Read(src, block.m_user);
+    block.m_offset = ReadVarUint<uint64_t>(src);
+    block.m_tracksCount = ReadVarUint<uint64_t>(src);
+    block.m_pointsCount = ReadVarUint<uint64_t>(src);
+
+    uint64_t blockSize = 0;
+    for (uint64_t & columnSize : block.m_columnSizes)
+    {
+      columnSize = ReadVarUint<uint64_t>(src);
+      blockSize += columnSize;
+    }
+
+    if (block.m_offset < kHeaderSize || block.m_offset + blockSize > indexOffset)
+      MYTHROW(FormatException, ("Bad block of", block.m_mwmName, block.m_user));
+  }
+
+  return index;
+}
+
+void ColumnarTracksSerializer::Deserialize(Reader const & reader, uint8_t columns,
+                                           BlockFilter const & filter,
+                                           MwmToMatchedTracks & mwmToMatchedTracks) const
+{
+  mwmToMatchedTracks.clear();
+
+  for (BlockInfo const & block : ReadIndex(reader))
+  {
+    if (filter && !filter(block))
+      continue;
+
+    auto const mwmId = m_numMwmIds->GetId(platform::CountryFile(block.m_mwmName));
+    auto const pointsCount = base::checked_cast<size_t>(block.m_pointsCount);
+
+    array<uint64_t, BlockInfo::kColumnsCount> offsets;
+    offsets[0] = block.m_offset;
+    for (size_t i = 1; i < offsets.size(); ++i)
+      offsets[i] = offsets[i - 1] + block.m_columnSizes[i - 1];
+
+    auto const forEachValue = [&](size_t column, function<void(Source &, size_t)> const & fn) {
+      Buffer const buffer = ReadColumn(reader, offsets[column], block.m_columnSizes[column]);
+      MemReaderWithExceptions memReader(buffer.data(), buffer.size());
+      Source src(memReader);
+      for (size_t i = 0; i < pointsCount; ++i)
+        fn(src, i);
+      if (src.Size() != 0)
+      {
+        MYTHROW(FormatException,
+                ("Column", column, "of", block.m_mwmName, block.m_user, "has extra data"));
+      }
+    };
+
+    vector<Segment> segments(pointsCount);
+    if (columns & kSegments)
+    {
+      uint32_t featureId = 0;
+      uint32_t segmentIdx = 0;
+      forEachValue(kSegmentsColumn, [&](Source & src, size_t i) {
+        featureId = ApplyDelta(featureId, ReadVarInt<int64_t>(src));
+        uint64_t const value = ReadVarUint<uint64_t>(src);
+        segmentIdx = ApplyDelta(segmentIdx, bits::ZigZagDecode(value >> 1));
+        segments[i] = Segment(mwmId, featureId, segmentIdx, (value & 1) != 0);
+      });
+    }
+
+    vector<DataPoint> dataPoints(pointsCount);
+    if (columns & kTimestamps)
+    {
+      uint64_t timestamp = 0;
+      forEachValue(kTimestampsColumn, [&](Source & src, size_t i) {
+        timestamp = ApplyDelta(timestamp, ReadVarInt<int64_t>(src));
+        dataPoints[i].m_timestamp = timestamp;
+      });
+    }
+
+    if (columns & kCoordinates)
+    {
+      uint32_t lat = 0;
+      uint32_t lon = 0;
+      forEachValue(kCoordinatesColumn, [&](Source & src, size_t i) {
+        lat = ApplyDelta(lat, ReadVarInt<int64_t>(src));
+        lon = ApplyDelta(lon, ReadVarInt<int64_t>(src));
+        dataPoints[i].m_latLon = ms::LatLon(DequantizeLat(lat), DequantizeLon(lon));
+      });
+    }
+
+    if (columns & kTraffic)
+    {
+      forEachValue(kTrafficColumn, [&](Source & src, size_t i) {
+        dataPoints[i].m_traffic = ReadPrimitiveFromSource<uint8_t>(src);
+      });
+    }
+
+    vector<MatchedTrack> & tracks = mwmToMatchedTracks[mwmId][block.m_user];
+    tracks.resize(base::checked_cast<size_t>(block.m_tracksCount));
+
+    Buffer const lengths =
+        ReadColumn(reader, offsets[kLengthsColumn], block.m_columnSizes[kLengthsColumn]);
+    MemReaderWithExceptions lengthsReader(lengths.data(), lengths.size());
+    Source lengthsSrc(lengthsReader);
+    size_t point = 0;
+    for (MatchedTrack & track : tracks)
+    {
+      auto const length = base::checked_cast<size_t>(ReadVarUint<uint64_t>(lengthsSrc));
+      if (length == 0 || length > pointsCount - point)
+        MYTHROW(FormatException, ("Bad track length of", block.m_mwmName, block.m_user));
+
+      track.reserve(length);
+      for (size_t i = 0; i < length; ++i, ++point)
+        track.emplace_back(dataPoints[point], segments[point]);
+    }
+
+    if (point != pointsCount)
+      MYTHROW(FormatException, ("Bad points count of", block.m_mwmName, block.m_user));
+  }
+}
+}  // namespace track_analyzing
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "track_analyzing/track.hpp"
+
+#include "routing/num_mwm_id.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "base/exception.hpp"
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace track_analyzing
+{
+// Columnar format of matched tracks.
+//
+// Tracks of every (mwm, user) pair form a block. Segments, timestamps, coordinates and traffic
+// of all points of the block are written as separate columns: values are delta coded against
+// the previous point and every column is compressed by zlib. An index of blocks is written
+// at the end of the file, so a reader may read blocks of the mwms and users it needs only and
+// may skip the columns it doesn't need.
+//
+// Coordinates are quantized with the grid of coding::TrafficGPSEncoder::kLatestVersion,
+// so tracks are the same as ones written by MwmToMatchedTracksSerializer.
+class ColumnarTracksSerializer final
+{
+public:
+  DECLARE_EXCEPTION(FormatException, RootException);
+
+  enum Column : uint8_t
+  {
+    // Track lengths are always read.
+    kSegments = 1 << 0,
+    kTimestamps = 1 << 1,
+    kCoordinates = 1 << 2,
+    kTraffic = 1 << 3,
+    kAllColumns = kSegments | kTimestamps | kCoordinates | kTraffic
+  };
+
+  struct BlockInfo
+  {
+    // Columns of the block: track lengths, segments, timestamps, coordinates and traffic.
+    static size_t constexpr kColumnsCount = 5;
+
+    std::string m_mwmName;
+    std::string m_user;
+    uint64_t m_offset = 0;
+    uint64_t m_tracksCount = 0;
+    uint64_t m_pointsCount = 0;
+    std::array<uint64_t, kColumnsCount> m_columnSizes = {};
+  };
+
+  using BlockFilter = std::function<bool(BlockInfo const & block)>;
+
+  explicit ColumnarTracksSerializer(std::shared_ptr<routing::NumMwmIds> numMwmIds);
+
+  // Returns true if |reader| starts with the header of the columnar format.
+  static bool IsColumnar(Reader const & reader);
+
+  void Serialize(MwmToMatchedTracks const & mwmToMatchedTracks, Writer & writer) const;
+
+  // Reads the index of blocks, only the index and the header are read from |reader|.
+  // @exception FormatException if |reader| isn't in the columnar format.
+  static std::vector<BlockInfo> ReadIndex(Reader const & reader);
+
+  // Reads |columns| of the blocks which pass |filter|, fields of the columns which are not read
+  // are left default. An empty |filter| passes all blocks.
+  // @exception FormatException if |reader| isn't in the columnar format.
+  void Deserialize(Reader const & reader, uint8_t columns, BlockFilter const & filter,
+                   MwmToMatchedTracks & mwmToMatchedTracks) const;
+
+  void Deserialize(Reader const & reader, MwmToMatchedTracks & mwmToMatchedTracks) const
+  {
+    Deserialize(reader, kAllColumns, BlockFilter(), mwmToMatchedTracks);
+  }
+
+private:
+  std::shared_ptr<routing::NumMwmIds> m_numMwmIds;
+};
+}  // namespace track_analyzing
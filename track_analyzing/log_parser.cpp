@@ -8,15 +8,27 @@
 #include "platform/platform.hpp"
 
 #include "coding/file_name_utils.hpp"
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
 #include "coding/hex.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
 
 #include "geometry/mercator.hpp"
 
+#include "base/checked_cast.hpp"
+#include "base/stl_add.hpp"
+#include "base/string_utils.hpp"
 #include "base/timer.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <fstream>
+#include <functional>
 #include <regex>
+#include <thread>
 #include <unordered_set>
 
 using namespace std;
@@ -24,6 +36,18 @@ using namespace track_analyzing;
 
 namespace
 {
+char const kLinePattern[] = R"(.*(DataV0|CurrentData)\s+aloha_id\s*:\s*(\S+)\s+.*\|(\w+)\|)";
+char const kShardExtension[] = ".points";
+// Number of log lines which are read into memory and parsed in parallel at a time.
+size_t constexpr kChunkLinesCount = 100000;
+
+enum class LineType
+{
+  Unknown,
+  OldVersion,
+  CurrentVersion
+};
+
 vector<DataPoint> ReadDataPoints(string const & data)
 {
   string const decoded = FromHex(data);
@@ -34,6 +58,63 @@ vector<DataPoint> ReadDataPoints(string const & data)
   return points;
 }
 
+// Parses a line of the log. |user| is set for lines of all versions,
+// |points| are read for lines of the current version only.
+LineType ParseLine(regex const & lineRegex, string const & line, string & user,
+                   vector<DataPoint> & points)
+{
+  smatch match;
+  if (!regex_match(line, match, lineRegex))
+    return LineType::Unknown;
+
+  CHECK_EQUAL(match.size(), 4, ());
+
+  string const version = match[1].str();
+  user = match[2].str();
+  if (version != "CurrentData")
+  {
+    CHECK_EQUAL(version, "DataV0", ());
+    return LineType::OldVersion;
+  }
+
+  points = ReadDataPoints(match[3].str());
+  return LineType::CurrentVersion;
+}
+
+// Points of a log line which belong to the same mwm.
+struct MwmTrack
+{
+  explicit MwmTrack(routing::NumMwmId mwmId) : m_mwmId(mwmId) {}
+
+  routing::NumMwmId m_mwmId;
+  Track m_track;
+};
+
+struct ParsedLine
+{
+  LineType m_type = LineType::Unknown;
+  string m_user;
+  vector<MwmTrack> m_mwmTracks;
+};
+
+// Shard files are temporary and are read on the same host, so coordinates are written
+// as is, without quantization of TrafficGPSEncoder.
+template <typename Sink>
+void WriteShardRecord(routing::NumMwmId mwmId, string const & user, Track const & track,
+                      Sink & sink)
+{
+  WriteToSink(sink, mwmId);
+  rw::Write(sink, user);
+  WriteVarUint(sink, base::checked_cast<uint64_t>(track.size()));
+  for (DataPoint const & point : track)
+  {
+    WriteVarUint(sink, point.m_timestamp);
+    sink.Write(&point.m_latLon.lat, sizeof(point.m_latLon.lat));
+    sink.Write(&point.m_latLon.lon, sizeof(point.m_latLon.lon));
+    WriteToSink(sink, point.m_traffic);
+  }
+}
+
 class PointToMwmId final
 {
 public:
@@ -101,30 +182,25 @@ void LogParser::ParseUserTracks(string const & logFile, UserToTrack & userToTrac
   if (!stream)
     MYTHROW(MessageException, ("Can't open file", logFile, "to parse tracks"));
 
-  std::regex const base_regex(R"(.*(DataV0|CurrentData)\s+aloha_id\s*:\s*(\S+)\s+.*\|(\w+)\|)");
+  std::regex const lineRegex(kLinePattern);
   std::unordered_set<string> usersWithOldVersion;
   uint64_t linesCount = 0;
   size_t pointsCount = 0;
 
+  string userId;
+  vector<DataPoint> packet;
   for (string line; getline(stream, line); ++linesCount)
   {
-    std::smatch base_match;
-    if (!std::regex_match(line, base_match, base_regex))
+    LineType const type = ParseLine(lineRegex, line, userId, packet);
+    if (type == LineType::Unknown)
       continue;
 
-    CHECK_EQUAL(base_match.size(), 4, ());
-
-    string const version = base_match[1].str();
-    string const userId = base_match[2].str();
-    string const data = base_match[3].str();
-    if (version != "CurrentData")
+    if (type == LineType::OldVersion)
     {
-      CHECK_EQUAL(version, "DataV0", ());
       usersWithOldVersion.insert(userId);
       continue;
     }
 
-    auto const packet = ReadDataPoints(data);
     if (!packet.empty())
     {
       Track & track = userToTrack[userId];
@@ -132,7 +208,7 @@ void LogParser::ParseUserTracks(string const & logFile, UserToTrack & userToTrac
     }
 
     pointsCount += packet.size();
-  };
+  }
 
   LOG(LINFO, ("Tracks parsing finished, elapsed:", timer.ElapsedSeconds(), "seconds, lines:",
               linesCount, ", points", pointsCount));
@@ -165,4 +241,137 @@ void LogParser::SplitIntoMwms(UserToTrack const & userToTrack, MwmToTracks & mwm
   LOG(LINFO, ("Data was split into", mwmToTracks.size(), "mwms, elapsed:", timer.ElapsedSeconds(),
               "seconds"));
 }
+
+vector<string> LogParser::ParseToShards(string const & logFile, string const & shardsDir,
+                                        size_t numShards, size_t numThreads) const
+{
+  CHECK_GREATER(numShards, 0, ());
+  numThreads = max(numThreads, static_cast<size_t>(1));
+
+  my::Timer timer;
+
+  std::ifstream stream(logFile);
+  if (!stream)
+    MYTHROW(MessageException, ("Can't open file", logFile, "to parse tracks"));
+
+  if (!Platform::IsDirectory(shardsDir) && !Platform::MkDirChecked(shardsDir))
+    MYTHROW(MessageException, ("Can't create directory", shardsDir, "for shards"));
+
+  vector<string> shardFiles;
+  vector<unique_ptr<FileWriter>> writers;
+  for (size_t i = 0; i < numShards; ++i)
+  {
+    shardFiles.push_back(
+        my::JoinPath(shardsDir, "shard_" + strings::to_string(i) + kShardExtension));
+    writers.push_back(my::make_unique<FileWriter>(shardFiles.back()));
+  }
+
+  PointToMwmId const pointToMwmId(m_mwmTree, *m_numMwmIds, m_dataDir);
+
+  vector<string> lines;
+  vector<ParsedLine> parsedLines;
+  auto const parseLines = [&](size_t begin, size_t end) {
+    std::regex const lineRegex(kLinePattern);
+    vector<DataPoint> packet;
+    for (size_t i = begin; i < end; ++i)
+    {
+      ParsedLine & parsed = parsedLines[i];
+      parsed.m_type = ParseLine(lineRegex, lines[i], parsed.m_user, packet);
+      if (parsed.m_type != LineType::CurrentVersion)
+        continue;
+
+      routing::NumMwmId mwmId = routing::kFakeNumMwmId;
+      for (DataPoint const & point : packet)
+      {
+        mwmId = pointToMwmId.FindMwmId(MercatorBounds::FromLatLon(point.m_latLon), mwmId);
+        if (mwmId == routing::kFakeNumMwmId)
+        {
+          LOG(LERROR, ("Can't match mwm region for", point.m_latLon, ", user:", parsed.m_user));
+          continue;
+        }
+
+        if (parsed.m_mwmTracks.empty() || parsed.m_mwmTracks.back().m_mwmId != mwmId)
+          parsed.m_mwmTracks.emplace_back(mwmId);
+        parsed.m_mwmTracks.back().m_track.push_back(point);
+      }
+    }
+  };
+
+  std::hash<string> const userHash;
+  uint64_t linesCount = 0;
+  uint64_t oldVersionLinesCount = 0;
+  uint64_t pointsCount = 0;
+
+  while (true)
+  {
+    lines.clear();
+    for (string line; lines.size() < kChunkLinesCount && getline(stream, line);)
+      lines.push_back(move(line));
+
+    if (lines.empty())
+      break;
+
+    linesCount += lines.size();
+    parsedLines.assign(lines.size(), ParsedLine());
+
+    size_t const linesPerThread = (lines.size() + numThreads - 1) / numThreads;
+    vector<thread> threads;
+    for (size_t begin = linesPerThread; begin < lines.size(); begin += linesPerThread)
+      threads.emplace_back(parseLines, begin, min(begin + linesPerThread, lines.size()));
+    parseLines(0, min(linesPerThread, lines.size()));
+    for (auto & t : threads)
+      t.join();
+
+    // Lines are written in the order of the log, so points of every user keep their order.
+    for (ParsedLine const & parsed : parsedLines)
+    {
+      if (parsed.m_type == LineType::OldVersion)
+        ++oldVersionLinesCount;
+
+      if (parsed.m_mwmTracks.empty())
+        continue;
+
+      FileWriter & writer = *writers[userHash(parsed.m_user) % numShards];
+      for (MwmTrack const & mwmTrack : parsed.m_mwmTracks)
+      {
+        WriteShardRecord(mwmTrack.m_mwmId, parsed.m_user, mwmTrack.m_track, writer);
+        pointsCount += mwmTrack.m_track.size();
+      }
+    }
+  }
+
+  writers.clear();
+
+  LOG(LINFO, ("Tracks parsing to", numShards, "shards finished, elapsed:", timer.ElapsedSeconds(),
+              "seconds, lines:", linesCount, ", points", pointsCount,
+              ", lines of old version:", oldVersionLinesCount));
+  return shardFiles;
+}
+
+// static
+void LogParser::ReadShard(string const & shardFile, MwmToTracks & mwmToTracks)
+{
+  FileReader reader(shardFile);
+  ReaderSource<FileReader> src(reader);
+
+  string user;
+  while (src.Size() > 0)
+  {
+    auto const mwmId = ReadPrimitiveFromSource<routing::NumMwmId>(src);
+    rw::Read(src, user);
+    Track & track = mwmToTracks[mwmId][user];
+
+    auto const pointsCount = base::checked_cast<size_t>(ReadVarUint<uint64_t>(src));
+    track.reserve(track.size() + pointsCount);
+    for (size_t i = 0; i < pointsCount; ++i)
+    {
+      DataPoint point;
+      point.m_timestamp = ReadVarUint<uint64_t>(src);
+      src.Read(&point.m_latLon.lat, sizeof(point.m_latLon.lat));
+      src.Read(&point.m_latLon.lon, sizeof(point.m_latLon.lon));
+      point.m_traffic = ReadPrimitiveFromSource<uint8_t>(src);
+      track.push_back(point);
+    }
+  }
+}
 }  // namespace track_analyzing
@@ -6,8 +6,10 @@
 
 #include "geometry/tree4d.hpp"
 
+#include <cstddef>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace track_analyzing
 {
@@ -19,6 +21,18 @@ public:
 
   void Parse(std::string const & logFile, MwmToTracks & mwmToTracks) const;
 
+  // Streaming version of Parse. |logFile| is read by chunks of lines, chunks are parsed by
+  // |numThreads| threads and points are appended to |numShards| files in |shardsDir|.
+  // All points of a user go to the same shard, so every shard may be processed independently
+  // and memory usage doesn't depend on the log size. Returns paths of the shard files.
+  std::vector<std::string> ParseToShards(std::string const & logFile,
+                                         std::string const & shardsDir, size_t numShards,
+                                         size_t numThreads) const;
+
+  // Reads a shard written by ParseToShards. |mwmToTracks| is the same as Parse returns
+  // for users of the shard.
+  static void ReadShard(std::string const & shardFile, MwmToTracks & mwmToTracks);
+
 private:
   void ParseUserTracks(std::string const & logFile, UserToTrack & userToTrack) const;
   void SplitIntoMwms(UserToTrack const & userToTrack, MwmToTracks & mwmToTracks) const;
@@ -1,3 +1,4 @@
+#include "track_analyzing/columnar_serialization.hpp"
 #include "track_analyzing/log_parser.hpp"
 #include "track_analyzing/serialization.hpp"
 #include "track_analyzing/track.hpp"
@@ -13,13 +14,21 @@
 
 #include "platform/platform.hpp"
 
+#include "coding/file_name_utils.hpp"
+#include "coding/file_writer.hpp"
+
 #include "geometry/tree4d.hpp"
 
 #include "base/logging.hpp"
 #include "base/timer.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <map>
 #include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 
 using namespace routing;
 using namespace std;
@@ -27,64 +36,137 @@ using namespace track_analyzing;
 
 namespace
 {
+// A track of a user, tracks are matched independently on worker threads.
+struct MatchTask
+{
+  NumMwmId m_mwmId;
+  string const * m_user;
+  Track const * m_track;
+  vector<MatchedTrack> m_matchedTracks;
+  uint64_t m_tracksCount = 0;
+  uint64_t m_nonMatchedPointsCount = 0;
+};
+
 void MatchTracks(MwmToTracks const & mwmToTracks, storage::Storage const & storage,
-                 NumMwmIds const & numMwmIds, MwmToMatchedTracks & mwmToMatchedTracks)
+                 NumMwmIds const & numMwmIds, TrackMatcher::Algorithm algorithm,
+                 size_t numThreads, MwmToMatchedTracks & mwmToMatchedTracks)
 {
   my::Timer timer;
 
-  uint64_t tracksCount = 0;
-  uint64_t pointsCount = 0;
-  uint64_t nonMatchedPointsCount = 0;
-
-  auto processMwm = [&](string const & mwmName, UserToTrack const & userToTrack) {
-    auto const countryFile = platform::CountryFile(mwmName);
-    auto const mwmId = numMwmIds.GetId(countryFile);
-    TrackMatcher matcher(storage, mwmId, countryFile);
-
-    auto & userToMatchedTracks = mwmToMatchedTracks[mwmId];
-
-    for (auto const & it : userToTrack)
+  // Tasks are sorted by mwms, so threads mostly match tracks of the same mwm at a time.
+  // Storage is not thread safe, so local files are found here.
+  vector<MatchTask> tasks;
+  map<NumMwmId, platform::LocalCountryFile> localFiles;
+  ForTracksSortedByMwmName(
+      mwmToTracks, numMwmIds, [&](string const & mwmName, UserToTrack const & userToTrack) {
+        auto const countryFile = platform::CountryFile(mwmName);
+        auto const mwmId = numMwmIds.GetId(countryFile);
+        auto const localFile = storage.GetLatestLocalFile(countryFile);
+        CHECK(localFile, ("Can't find latest country file for", mwmName));
+        localFiles.emplace(mwmId, *localFile);
+
+        for (auto const & it : userToTrack)
+        {
+          tasks.emplace_back();
+          tasks.back().m_mwmId = mwmId;
+          tasks.back().m_user = &it.first;
+          tasks.back().m_track = &it.second;
+        }
+      });
+
+  // Each thread keeps a matcher, and so the road graph, of the mwm of its last task.
+  atomic<size_t> nextTask(0);
+  auto const worker = [&]() {
+    unique_ptr<TrackMatcher> matcher;
+    for (size_t i = nextTask++; i < tasks.size(); i = nextTask++)
     {
-      string const & user = it.first;
-      auto & matchedTracks = userToMatchedTracks[user];
+      MatchTask & task = tasks[i];
+      if (!matcher || matcher->GetMwmId() != task.m_mwmId)
+        matcher = make_unique<TrackMatcher>(localFiles.at(task.m_mwmId), task.m_mwmId, algorithm);
+
+      uint64_t const tracksCount = matcher->GetTracksCount();
+      uint64_t const nonMatchedPointsCount = matcher->GetNonMatchedPointsCount();
       try
       {
-        matcher.MatchTrack(it.second, matchedTracks);
+        matcher->MatchTrack(*task.m_track, task.m_matchedTracks);
       }
       catch (RootException const & e)
       {
-        LOG(LERROR, ("Can't match track for mwm:", mwmName, ", user:", user));
+        LOG(LERROR, ("Can't match track for mwm:", numMwmIds.GetFile(task.m_mwmId).GetName(),
+                     ", user:", *task.m_user));
         LOG(LERROR, ("  ", e.what()));
       }
-
-      if (matchedTracks.empty())
-        userToMatchedTracks.erase(user);
+      task.m_tracksCount = matcher->GetTracksCount() - tracksCount;
+      task.m_nonMatchedPointsCount = matcher->GetNonMatchedPointsCount() - nonMatchedPointsCount;
     }
+  };
 
-    if (userToMatchedTracks.empty())
-      mwmToMatchedTracks.erase(mwmId);
+  vector<thread> threads;
+  for (size_t i = 1; i < numThreads; ++i)
+    threads.emplace_back(worker);
+  worker();
+  for (auto & t : threads)
+    t.join();
 
-    tracksCount += matcher.GetTracksCount();
-    pointsCount += matcher.GetPointsCount();
-    nonMatchedPointsCount += matcher.GetNonMatchedPointsCount();
+  uint64_t tracksCount = 0;
+  uint64_t pointsCount = 0;
+  uint64_t nonMatchedPointsCount = 0;
 
-    LOG(LINFO, (numMwmIds.GetFile(mwmId).GetName(), ", users:", userToTrack.size(), ", tracks:",
-                matcher.GetTracksCount(), ", points:", matcher.GetPointsCount(),
-                ", non matched points:", matcher.GetNonMatchedPointsCount()));
-  };
+  for (size_t begin = 0; begin < tasks.size();)
+  {
+    NumMwmId const mwmId = tasks[begin].m_mwmId;
+    uint64_t mwmTracksCount = 0;
+    uint64_t mwmPointsCount = 0;
+    uint64_t mwmNonMatchedPointsCount = 0;
+
+    size_t end = begin;
+    for (; end < tasks.size() && tasks[end].m_mwmId == mwmId; ++end)
+    {
+      MatchTask & task = tasks[end];
+      mwmTracksCount += task.m_tracksCount;
+      mwmPointsCount += task.m_track->size();
+      mwmNonMatchedPointsCount += task.m_nonMatchedPointsCount;
+      if (!task.m_matchedTracks.empty())
+        mwmToMatchedTracks[mwmId][*task.m_user] = move(task.m_matchedTracks);
+    }
 
-  ForTracksSortedByMwmName(mwmToTracks, numMwmIds, processMwm);
+    LOG(LINFO, (numMwmIds.GetFile(mwmId).GetName(), ", users:", end - begin, ", tracks:",
+                mwmTracksCount, ", points:", mwmPointsCount,
+                ", non matched points:", mwmNonMatchedPointsCount));
+
+    tracksCount += mwmTracksCount;
+    pointsCount += mwmPointsCount;
+    nonMatchedPointsCount += mwmNonMatchedPointsCount;
+    begin = end;
+  }
 
   LOG(LINFO,
       ("Matching finished, elapsed:", timer.ElapsedSeconds(), "seconds, tracks:", tracksCount,
        ", points:", pointsCount, ", non matched points:", nonMatchedPointsCount));
 }
 
+
+void SaveMatchedTracks(MwmToMatchedTracks const & mwmToMatchedTracks,
+                       shared_ptr<NumMwmIds> numMwmIds, bool columnar, string const & trackFile)
+{
+  FileWriter writer(trackFile, FileWriter::OP_WRITE_TRUNCATE);
+  if (columnar)
+  {
+    ColumnarTracksSerializer(numMwmIds).Serialize(mwmToMatchedTracks, writer);
+  }
+  else
+  {
+    MwmToMatchedTracksSerializer serializer(numMwmIds);
+    serializer.Serialize(mwmToMatchedTracks, writer);
+  }
+  LOG(LINFO, ("Matched tracks were saved to", trackFile));
+}
 }  // namespace
 
 namespace track_analyzing
 {
-void CmdMatch(string const & logFile, string const & trackFile)
+void CmdMatch(string const & logFile, string const & trackFile, bool useHmm, size_t numThreads,
+              size_t numShards, bool columnar)
 {
   LOG(LINFO, ("Matching", logFile));
 
@@ -100,15 +182,33 @@ void CmdMatch(string const & logFile, string const & trackFile)
   unique_ptr<m4::Tree<NumMwmId>> mwmTree = MakeNumMwmTree(*numMwmIds, *countryInfoGetter);
 
   LogParser parser(numMwmIds, move(mwmTree), dataDir);
-  MwmToTracks mwmToTracks;
-  parser.Parse(logFile, mwmToTracks);
-
-  MwmToMatchedTracks mwmToMatchedTracks;
-  MatchTracks(mwmToTracks, storage, *numMwmIds, mwmToMatchedTracks);
-
-  FileWriter writer(trackFile, FileWriter::OP_WRITE_TRUNCATE);
-  MwmToMatchedTracksSerializer serializer(numMwmIds);
-  serializer.Serialize(mwmToMatchedTracks, writer);
-  LOG(LINFO, ("Matched tracks were saved to", trackFile));
+  auto const algorithm = useHmm ? TrackMatcher::Algorithm::Hmm : TrackMatcher::Algorithm::Greedy;
+  numThreads = max(numThreads, static_cast<size_t>(1));
+
+  if (numShards == 0)
+  {
+    MwmToTracks mwmToTracks;
+    parser.Parse(logFile, mwmToTracks);
+
+    MwmToMatchedTracks mwmToMatchedTracks;
+    MatchTracks(mwmToTracks, storage, *numMwmIds, algorithm, numThreads, mwmToMatchedTracks);
+    SaveMatchedTracks(mwmToMatchedTracks, numMwmIds, columnar, trackFile);
+    return;
+  }
+
+  // |trackFile| is a directory here, a track file is saved for every shard of users and
+  // only one shard is kept in memory at a time.
+  vector<string> const shardFiles = parser.ParseToShards(logFile, trackFile, numShards, numThreads);
+  for (string const & shardFile : shardFiles)
+  {
+    MwmToTracks mwmToTracks;
+    LogParser::ReadShard(shardFile, mwmToTracks);
+    FileWriter::DeleteFileX(shardFile);
+
+    MwmToMatchedTracks mwmToMatchedTracks;
+    MatchTracks(mwmToTracks, storage, *numMwmIds, algorithm, numThreads, mwmToMatchedTracks);
+    SaveMatchedTracks(mwmToMatchedTracks, numMwmIds, columnar,
+                      my::FilenameWithoutExt(shardFile) + ".track");
+  }
 }
 }  // namespace track_analyzing
@@ -260,6 +260,14 @@ void CmdTagsTable(string const & filepath, string const & trackExtension, String
     ForTracksSortedByMwmName(mwmToMatchedTracks, *numMwmIds, processMwm);
   };
 
-  ForEachTrackFile(filepath, trackExtension, numMwmIds, processTrack);
+  // Coordinates are not used by the table, columnar files allow to skip them as well as
+  // blocks of filtered mwms and users.
+  auto const blockFilter = [&](ColumnarTracksSerializer::BlockInfo const & block) {
+    return !mwmFilter(block.m_mwmName) && !userFilter(block.m_user);
+  };
+  ForEachTrackFile(filepath, trackExtension, numMwmIds, processTrack,
+                   ColumnarTracksSerializer::kSegments | ColumnarTracksSerializer::kTimestamps |
+                       ColumnarTracksSerializer::kTraffic,
+                   blockFilter);
 }
 }  // namespace track_analyzing
@@ -41,6 +41,15 @@ DEFINE_double(min_speed, 15.0, "minimum track average speed in km/hour");
 DEFINE_double(max_speed, 110.0, "maximum track average speed in km/hour");
 DEFINE_bool(ignore_traffic, true, "ignore tracks with traffic data");
 
+DEFINE_bool(hmm, false, "match tracks by the hidden Markov model instead of the greedy matcher");
+DEFINE_uint64(num_threads, 1, "number of threads to parse and match tracks");
+DEFINE_uint64(shards, 0,
+              "parse the log in the streaming mode into the number of shards of users, "
+              "--out is a directory of track files per shard then");
+DEFINE_bool(columnar, false,
+            "save matched tracks in the columnar format, which is smaller and allows to read "
+            "only needed columns, mwms and users");
+
 size_t Checked_track()
 {
   if (FLAGS_track < 0)
@@ -65,7 +74,8 @@ namespace track_analyzing
 void CmdCppTrack(string const & trackFile, string const & mwmName, string const & user,
                  size_t trackIdx);
 // Match raw gps logs to tracks.
-void CmdMatch(string const & logFile, string const & trackFile);
+void CmdMatch(string const & logFile, string const & trackFile, bool useHmm, size_t numThreads,
+              size_t numShards, bool columnar);
 // Print aggregated tracks to csv table.
 void CmdTagsTable(string const & filepath, string const & trackExtension,
                   StringFilter mwmIsFiltered, StringFilter userFilter);
@@ -91,7 +101,9 @@ int main(int argc, char ** argv)
     if (cmd == "match")
     {
       string const & logFile = Checked_in();
-      CmdMatch(logFile, FLAGS_out.empty() ? logFile + ".track" : FLAGS_out);
+      string const defaultOut = logFile + (FLAGS_shards == 0 ? ".track" : ".tracks");
+      CmdMatch(logFile, FLAGS_out.empty() ? defaultOut : FLAGS_out, FLAGS_hmm,
+               static_cast<size_t>(FLAGS_num_threads), static_cast<size_t>(FLAGS_shards), FLAGS_columnar);
     }
     else if (cmd == "tracks")
     {
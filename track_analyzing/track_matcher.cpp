@@ -2,6 +2,7 @@
 
 #include "track_analyzing/exceptions.hpp"
 
+#include <routing/base/astar_algorithm.hpp>
 #include <routing/index_graph_loader.hpp>
 
 #include <routing_common/car_model.hpp>
@@ -10,6 +11,15 @@
 
 #include <geometry/distance.hpp>
 
+#include <base/math.hpp>
+#include <base/stl_helpers.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+
 using namespace routing;
 using namespace std;
 using namespace track_analyzing;
@@ -19,6 +29,67 @@ namespace
 // Matching range in meters.
 double constexpr kMatchingRange = 20.0;
 
+// Parameters of the hidden Markov model, see "Hidden Markov Map Matching Through Noise and
+// Sparseness" by P. Newson and J. Krumm.
+// Standard deviation of gps errors in meters.
+double constexpr kGpsSigmaM = 5.0;
+// Scale of differences between route and direct distances of consecutive points in meters.
+double constexpr kTransitionBetaM = 10.0;
+size_t constexpr kMaxHmmCandidates = 8;
+// Routes between consecutive points are searched up to this length.
+double constexpr kMaxRouteToDirectRatio = 2.0;
+double constexpr kRouteSlackM = 100.0;
+
+double constexpr kImpossible = -numeric_limits<double>::infinity();
+double constexpr kInfiniteDistance = numeric_limits<double>::infinity();
+
+class LengthEdge final
+{
+public:
+  LengthEdge(Segment const & target, double weight) : m_target(target), m_weight(weight) {}
+
+  Segment const & GetTarget() const { return m_target; }
+  double GetWeight() const { return m_weight; }
+
+private:
+  Segment m_target;
+  double m_weight;
+};
+
+// IndexGraph weighted by lengths of segments instead of travel times, the weight of an edge
+// is the length of its target. U-turns and segments without access are skipped.
+class LengthGraph final
+{
+public:
+  using TVertexType = Segment;
+  using TEdgeType = LengthEdge;
+  using TWeightType = double;
+
+  LengthGraph(IndexGraph & graph, function<double(Segment const &)> const & length)
+    : m_graph(graph), m_length(length)
+  {
+  }
+
+  void GetOutgoingEdgesList(Segment const & segment, vector<LengthEdge> & edges)
+  {
+    edges.clear();
+    m_edges.clear();
+    m_graph.GetEdgeList(segment, true /* isOutgoing */, m_edges);
+    for (auto const & edge : m_edges)
+    {
+      Segment const & target = edge.GetTarget();
+      if (segment.IsInverse(target) || m_graph.GetAccessType(target) != RoadAccess::Type::Yes)
+        continue;
+      edges.emplace_back(target, m_length(target));
+    }
+  }
+
+private:
+  IndexGraph & m_graph;
+  function<double(Segment const &)> m_length;
+  vector<SegmentEdge> m_edges;
+};
+
 // Mercator distance from segment to point in meters.
 double DistanceToSegment(m2::PointD const & segmentBegin, m2::PointD const & segmentEnd,
                          m2::PointD const & point)
@@ -35,6 +106,14 @@ double DistanceToSegment(Segment const & segment, m2::PointD const & point, Inde
                            indexGraph.GetGeometry().GetPoint(segment.GetRoadPoint(true)), point);
 }
 
+platform::LocalCountryFile GetLatestLocalFile(storage::Storage const & storage,
+                                              platform::CountryFile const & countryFile)
+{
+  auto localCountryFile = storage.GetLatestLocalFile(countryFile);
+  CHECK(localCountryFile, ("Can't find latest country file for", countryFile.GetName()));
+  return *localCountryFile;
+}
+
 bool EdgesContain(vector<SegmentEdge> const & edges, Segment const & segment)
 {
   for (auto const & edge : edges)
@@ -51,13 +130,20 @@ namespace track_analyzing
 {
 // TrackMatcher ------------------------------------------------------------------------------------
 TrackMatcher::TrackMatcher(storage::Storage const & storage, NumMwmId mwmId,
-                           platform::CountryFile const & countryFile)
+                           platform::CountryFile const & countryFile, Algorithm algorithm)
+  : TrackMatcher(GetLatestLocalFile(storage, countryFile), mwmId, algorithm)
+{
+}
+
+TrackMatcher::TrackMatcher(platform::LocalCountryFile const & localCountryFile, NumMwmId mwmId,
+                           Algorithm algorithm)
   : m_mwmId(mwmId)
-  , m_vehicleModel(CarModelFactory({}).GetVehicleModelForCountry(countryFile.GetName()))
+  , m_algorithm(algorithm)
+  , m_vehicleModel(
+        CarModelFactory({}).GetVehicleModelForCountry(localCountryFile.GetCountryName()))
 {
-  auto localCountryFile = storage.GetLatestLocalFile(countryFile);
-  CHECK(localCountryFile, ("Can't find latest country file for", countryFile.GetName()));
-  auto registerResult = m_index.Register(*localCountryFile);
+  auto const & countryFile = localCountryFile.GetCountryFile();
+  auto registerResult = m_index.Register(localCountryFile);
   CHECK_EQUAL(registerResult.second, MwmSet::RegResult::Success,
               ("Can't register mwm", countryFile.GetName()));
 
@@ -74,6 +160,16 @@ void TrackMatcher::MatchTrack(vector<DataPoint> const & track, vector<MatchedTra
 {
   m_pointsCount += track.size();
 
+  switch (m_algorithm)
+  {
+  case Algorithm::Greedy: MatchTrackGreedy(track, matchedTracks); break;
+  case Algorithm::Hmm: MatchTrackHmm(track, matchedTracks); break;
+  }
+}
+
+void TrackMatcher::MatchTrackGreedy(vector<DataPoint> const & track,
+                                    vector<MatchedTrack> & matchedTracks)
+{
   vector<Step> steps;
   steps.reserve(track.size());
   for (auto const & routePoint : track)
@@ -123,6 +219,191 @@ void TrackMatcher::MatchTrack(vector<DataPoint> const & track, vector<MatchedTra
   }
 }
 
+void TrackMatcher::MatchTrackHmm(vector<DataPoint> const & track,
+                                 vector<MatchedTrack> & matchedTracks)
+{
+  vector<Step> steps;
+  steps.reserve(track.size());
+  for (auto const & routePoint : track)
+    steps.emplace_back(routePoint);
+
+  // Viterbi runs over chains of steps, a chain breaks at a point which has no candidates
+  // or can't be reached from the previous point. |scores| and |parents| are of the steps
+  // [chainBegin, current step).
+  vector<vector<double>> scores;
+  vector<vector<size_t>> parents;
+  size_t chainBegin = 0;
+
+  auto const finishChain = [&](size_t chainEnd) {
+    if (scores.empty())
+      return;
+    CHECK_EQUAL(scores.size(), chainEnd - chainBegin, ());
+
+    auto const & lastScores = scores.back();
+    size_t candidate =
+        distance(lastScores.begin(), max_element(lastScores.begin(), lastScores.end()));
+    for (size_t i = chainEnd; i > chainBegin; --i)
+    {
+      Step & step = steps[i - 1];
+      step.SetSegment(step.GetCandidates()[candidate].GetSegment());
+      candidate = parents[i - 1 - chainBegin][candidate];
+    }
+
+    ++m_tracksCount;
+    matchedTracks.push_back({});
+    MatchedTrack & matchedTrack = matchedTracks.back();
+    for (size_t i = chainBegin; i < chainEnd; ++i)
+      matchedTrack.emplace_back(steps[i].GetDataPoint(), steps[i].GetSegment());
+
+    scores.clear();
+    parents.clear();
+  };
+
+  vector<double> emissions;
+  vector<double> routeDistances;
+  for (size_t i = 0; i < steps.size(); ++i)
+  {
+    Step & step = steps[i];
+    step.FillCandidatesWithNearbySegments(m_index, *m_graph, *m_vehicleModel, m_mwmId);
+    step.PruneCandidates(kMaxHmmCandidates);
+    if (!step.HasCandidates())
+    {
+      ++m_nonMatchedPointsCount;
+      finishChain(i);
+      chainBegin = i + 1;
+      continue;
+    }
+
+    auto const & candidates = step.GetCandidates();
+    emissions.clear();
+    for (auto const & candidate : candidates)
+      emissions.push_back(-0.5 * my::sq(candidate.GetDistance() / kGpsSigmaM));
+
+    vector<double> stepScores(candidates.size(), kImpossible);
+    vector<size_t> stepParents(candidates.size(), 0);
+    if (!scores.empty())
+    {
+      Step const & prevStep = steps[i - 1];
+      auto const & prevScores = scores.back();
+      double const directDistance =
+          MercatorBounds::DistanceOnEarth(prevStep.GetPoint(), step.GetPoint());
+      double const maxRouteDistance = directDistance * kMaxRouteToDirectRatio + kRouteSlackM;
+
+      for (size_t from = 0; from < prevScores.size(); ++from)
+      {
+        if (prevScores[from] == kImpossible)
+          continue;
+
+        CalcRouteDistances(prevStep.GetCandidates()[from].GetSegment(), prevStep.GetPoint(),
+                           candidates, step.GetPoint(), maxRouteDistance, routeDistances);
+        for (size_t to = 0; to < candidates.size(); ++to)
+        {
+          if (routeDistances[to] == kInfiniteDistance)
+            continue;
+
+          double const score = prevScores[from] + emissions[to] -
+                               fabs(routeDistances[to] - directDistance) / kTransitionBetaM;
+          if (score > stepScores[to])
+          {
+            stepScores[to] = score;
+            stepParents[to] = from;
+          }
+        }
+      }
+    }
+
+    if (all_of(stepScores.begin(), stepScores.end(),
+               [](double score) { return score == kImpossible; }))
+    {
+      // The point starts a new chain.
+      finishChain(i);
+      chainBegin = i;
+      stepScores = emissions;
+    }
+
+    scores.push_back(move(stepScores));
+    parents.push_back(move(stepParents));
+  }
+
+  finishChain(steps.size());
+}
+
+void TrackMatcher::CalcRouteDistances(Segment const & from, m2::PointD const & fromPoint,
+                                      vector<Candidate> const & to, m2::PointD const & toPoint,
+                                      double maxDistance, vector<double> & distances)
+{
+  distances.assign(to.size(), kInfiniteDistance);
+
+  double const fromOffset = GetOffset(from, fromPoint);
+  // Distance from |fromPoint| to the end of |from|.
+  double const rest = GetSegmentLength(from) - fromOffset;
+
+  size_t targetsLeft = 0;
+  unordered_map<Segment, size_t, Segment::Hash> targets;
+  for (size_t i = 0; i < to.size(); ++i)
+  {
+    auto const & segment = to[i].GetSegment();
+    if (segment == from)
+    {
+      distances[i] = fabs(GetOffset(segment, toPoint) - fromOffset);
+      continue;
+    }
+    targets.emplace(segment, i);
+    ++targetsLeft;
+  }
+
+  if (targetsLeft == 0)
+    return;
+
+  // Wave distances are lengths of the segments after |from| up to the vertex inclusive.
+  LengthGraph graph(*m_graph, [this](Segment const & s) { return GetSegmentLength(s); });
+  AStarAlgorithm<LengthGraph> algorithm;
+  AStarAlgorithm<LengthGraph>::Context context;
+  algorithm.PropagateWave(graph, from,
+                          [&](Segment const & vertex) {
+                            if (vertex == from)
+                              return true;
+
+                            double const length = GetSegmentLength(vertex);
+                            double const toVertexBegin = rest + context.GetDistance(vertex) - length;
+                            if (toVertexBegin > maxDistance)
+                              return false;
+
+                            auto const it = targets.find(vertex);
+                            if (it != targets.end())
+                            {
+                              distances[it->second] = toVertexBegin + GetOffset(vertex, toPoint);
+                              if (--targetsLeft == 0)
+                                return false;
+                            }
+                            return true;
+                          },
+                          context);
+}
+
+double TrackMatcher::GetSegmentLength(Segment const & segment)
+{
+  auto const it = m_segmentLengths.find(segment);
+  if (it != m_segmentLengths.end())
+    return it->second;
+
+  auto & geometry = m_graph->GetGeometry();
+  double const length =
+      MercatorBounds::DistanceOnEarth(geometry.GetPoint(segment.GetRoadPoint(false /* front */)),
+                                      geometry.GetPoint(segment.GetRoadPoint(true /* front */)));
+  m_segmentLengths.emplace(segment, length);
+  return length;
+}
+
+double TrackMatcher::GetOffset(Segment const & segment, m2::PointD const & point)
+{
+  auto & geometry = m_graph->GetGeometry();
+  m2::PointD const & begin = geometry.GetPoint(segment.GetRoadPoint(false /* front */));
+  m2::ProjectionToSection<m2::PointD> projection;
+  projection.SetBounds(begin, geometry.GetPoint(segment.GetRoadPoint(true /* front */)));
+  return MercatorBounds::DistanceOnEarth(begin, projection(point));
+}
+
 // TrackMatcher::Step ------------------------------------------------------------------------------
 TrackMatcher::Step::Step(DataPoint const & dataPoint)
   : m_dataPoint(dataPoint), m_point(MercatorBounds::FromLatLon(dataPoint.m_latLon))
@@ -221,6 +502,19 @@ void TrackMatcher::Step::ChooseSegment(Step const & nextStep, IndexGraph & index
     MYTHROW(MessageException, ("Can't find previous step for", nextStep.m_segment));
 }
 
+void TrackMatcher::Step::PruneCandidates(size_t maxCount)
+{
+  my::SortUnique(m_candidates);
+  if (m_candidates.size() <= maxCount)
+    return;
+
+  nth_element(m_candidates.begin(), m_candidates.begin() + maxCount, m_candidates.end(),
+              [](Candidate const & lhs, Candidate const & rhs) {
+                return lhs.GetDistance() < rhs.GetDistance();
+              });
+  m_candidates.erase(m_candidates.begin() + maxCount, m_candidates.end());
+}
+
 void TrackMatcher::Step::ChooseNearestSegment()
 {
   CHECK(!m_candidates.empty(), ());
@@ -10,10 +10,13 @@
 
 #include <storage/storage.hpp>
 
+#include "platform/local_country_file.hpp"
+
 #include "geometry/point2d.hpp"
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace track_analyzing
@@ -21,11 +24,24 @@ namespace track_analyzing
 class TrackMatcher final
 {
 public:
+  enum class Algorithm
+  {
+    // Follows adjacent segments from point to point and chooses the nearest ones.
+    Greedy,
+    // Chooses the most probable sequence of segments by the Viterbi algorithm, transitions
+    // between consecutive points are weighted by lengths of routes between them.
+    Hmm
+  };
+
   TrackMatcher(storage::Storage const & storage, routing::NumMwmId mwmId,
-               platform::CountryFile const & countryFile);
+               platform::CountryFile const & countryFile, Algorithm algorithm = Algorithm::Greedy);
+  // Doesn't use Storage, so matchers may be created on any thread.
+  TrackMatcher(platform::LocalCountryFile const & localCountryFile, routing::NumMwmId mwmId,
+               Algorithm algorithm = Algorithm::Greedy);
 
   void MatchTrack(std::vector<DataPoint> const & track, std::vector<MatchedTrack> & matchedTracks);
 
+  routing::NumMwmId GetMwmId() const { return m_mwmId; }
   uint64_t GetTracksCount() const { return m_tracksCount; }
   uint64_t GetPointsCount() const { return m_pointsCount; }
   uint64_t GetNonMatchedPointsCount() const { return m_nonMatchedPointsCount; }
@@ -54,8 +70,13 @@ private:
     explicit Step(DataPoint const & dataPoint);
 
     DataPoint const & GetDataPoint() const { return m_dataPoint; }
+    m2::PointD const & GetPoint() const { return m_point; }
     routing::Segment const & GetSegment() const { return m_segment; }
+    std::vector<Candidate> const & GetCandidates() const { return m_candidates; }
     bool HasCandidates() const { return !m_candidates.empty(); }
+    void SetSegment(routing::Segment const & segment) { m_segment = segment; }
+    // Keeps at most |maxCount| nearest candidates.
+    void PruneCandidates(size_t maxCount);
     void FillCandidatesWithNearbySegments(Index const & index, routing::IndexGraph const & graph,
                                           routing::VehicleModelInterface const & vehicleModel,
                                           routing::NumMwmId mwmId);
@@ -73,10 +94,27 @@ private:
     std::vector<Candidate> m_candidates;
   };
 
+  void MatchTrackGreedy(std::vector<DataPoint> const & track,
+                        std::vector<MatchedTrack> & matchedTracks);
+  void MatchTrackHmm(std::vector<DataPoint> const & track,
+                     std::vector<MatchedTrack> & matchedTracks);
+
+  // Fills |distances| with lengths of routes from the projection of |fromPoint| to |from| to
+  // projections of |toPoint| to segments of |to|. Routes longer than |maxDistance| are not
+  // searched, their lengths are infinite.
+  void CalcRouteDistances(routing::Segment const & from, m2::PointD const & fromPoint,
+                          std::vector<Candidate> const & to, m2::PointD const & toPoint,
+                          double maxDistance, std::vector<double> & distances);
+  double GetSegmentLength(routing::Segment const & segment);
+  // Distance from the beginning of |segment| to the projection of |point|.
+  double GetOffset(routing::Segment const & segment, m2::PointD const & point);
+
   routing::NumMwmId const m_mwmId;
+  Algorithm const m_algorithm;
   Index m_index;
   std::shared_ptr<routing::VehicleModelInterface> m_vehicleModel;
   std::unique_ptr<routing::IndexGraph> m_graph;
+  std::unordered_map<routing::Segment, double, routing::Segment::Hash> m_segmentLengths;
   uint64_t m_tracksCount = 0;
   uint64_t m_pointsCount = 0;
   uint64_t m_nonMatchedPointsCount = 0;
@@ -50,9 +50,16 @@ double CalcSpeedKMpH(double meters, uint64_t secondsElapsed)
 }
 
 void ReadTracks(shared_ptr<NumMwmIds> numMwmIds, string const & filename,
-                MwmToMatchedTracks & mwmToMatchedTracks)
+                MwmToMatchedTracks & mwmToMatchedTracks, uint8_t columns,
+                ColumnarTracksSerializer::BlockFilter const & filter)
 {
   FileReader reader(filename);
+  if (ColumnarTracksSerializer::IsColumnar(reader))
+  {
+    ColumnarTracksSerializer(numMwmIds).Deserialize(reader, columns, filter, mwmToMatchedTracks);
+    return;
+  }
+
   ReaderSource<FileReader> src(reader);
   MwmToMatchedTracksSerializer serializer(numMwmIds);
   serializer.Deserialize(mwmToMatchedTracks, src);
@@ -98,7 +105,8 @@ std::string GetCurrentVersionMwmFile(storage::Storage const & storage, std::stri
 void ForEachTrackFile(
     std::string const & filepath, std::string const & extension,
     shared_ptr<routing::NumMwmIds> numMwmIds,
-    std::function<void(std::string const & filename, MwmToMatchedTracks const &)> && toDo)
+    std::function<void(std::string const & filename, MwmToMatchedTracks const &)> && toDo,
+    uint8_t columns, ColumnarTracksSerializer::BlockFilter const & filter)
 {
   Platform::EFileType fileType = Platform::FILE_TYPE_UNKNOWN;
   Platform::EError const result = Platform::GetFileType(filepath, fileType);
@@ -112,7 +120,7 @@ void ForEachTrackFile(
   if (fileType == Platform::FILE_TYPE_REGULAR)
   {
     MwmToMatchedTracks mwmToMatchedTracks;
-    ReadTracks(numMwmIds, filepath, mwmToMatchedTracks);
+    ReadTracks(numMwmIds, filepath, mwmToMatchedTracks, columns, filter);
     toDo(filepath, mwmToMatchedTracks);
     return;
   }
@@ -128,7 +136,7 @@ void ForEachTrackFile(
         continue;
 
       MwmToMatchedTracks mwmToMatchedTracks;
-      ReadTracks(numMwmIds, file, mwmToMatchedTracks);
+      ReadTracks(numMwmIds, file, mwmToMatchedTracks, columns, filter);
       toDo(file, mwmToMatchedTracks);
     }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "track_analyzing/columnar_serialization.hpp"
 #include "track_analyzing/exceptions.hpp"
 #include "track_analyzing/track.hpp"
 
@@ -24,8 +25,12 @@ double CalcSubtrackLength(MatchedTrack::const_iterator begin, MatchedTrack::cons
                           routing::Geometry & geometry);
 double CalcTrackLength(MatchedTrack const & track, routing::Geometry & geometry);
 double CalcSpeedKMpH(double meters, uint64_t secondsElapsed);
+// Reads tracks of both the plain and the columnar formats. |columns| and |filter| are applied
+// to files of the columnar format only, plain files are read entirely.
 void ReadTracks(std::shared_ptr<routing::NumMwmIds> numMwmIds, std::string const & filename,
-                MwmToMatchedTracks & mwmToMatchedTracks);
+                MwmToMatchedTracks & mwmToMatchedTracks,
+                uint8_t columns = ColumnarTracksSerializer::kAllColumns,
+                ColumnarTracksSerializer::BlockFilter const & filter = {});
 MatchedTrack const & GetMatchedTrack(MwmToMatchedTracks const & mwmToMatchedTracks,
                                      routing::NumMwmIds const & numMwmIds,
                                      std::string const & mwmName, std::string const & user,
@@ -54,5 +59,7 @@ void ForTracksSortedByMwmName(MwmToTracks const & mwmToTracks, routing::NumMwmId
 void ForEachTrackFile(
     std::string const & filepath, std::string const & extension,
     shared_ptr<routing::NumMwmIds> numMwmIds,
-    std::function<void(std::string const & filename, MwmToMatchedTracks const &)> && toDo);
+    std::function<void(std::string const & filename, MwmToMatchedTracks const &)> && toDo,
+    uint8_t columns = ColumnarTracksSerializer::kAllColumns,
+    ColumnarTracksSerializer::BlockFilter const & filter = {});
 }  // namespace track_analyzing
@@ -0,0 +1,258 @@
+#include "tracking/ingestion_service.hpp"
+
+#include "tracking/packet_parser.hpp"
+
+#include "coding/reader.hpp"
+
+#include "base/logging.hpp"
+#include "base/thread.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/condition_variable.hpp"
+#include "std/limits.hpp"
+#include "std/mutex.hpp"
+#include "std/thread.hpp"
+#include "std/unordered_map.hpp"
+#include "std/utility.hpp"
+
+namespace tracking
+{
+class IngestionService::Shard final
+{
+public:
+  Shard(IngestionService & service) : m_service(service), m_thread([this] { Run(); }) {}
+
+  ~Shard()
+  {
+    {
+      lock_guard<mutex> lock(m_mutex);
+      m_isFinished = true;
+    }
+    m_cv.notify_one();
+    m_thread.join();
+  }
+
+  void Push(ConnectionId id, vector<uint8_t> && data, bool isClosed)
+  {
+    {
+      lock_guard<mutex> lock(m_mutex);
+      m_events.push_back({id, move(data), isClosed});
+    }
+    m_cv.notify_one();
+  }
+
+private:
+  struct Event
+  {
+    ConnectionId m_id;
+    vector<uint8_t> m_data;
+    bool m_isClosed;
+  };
+
+  struct Connection
+  {
+    explicit Connection(size_t maxPayloadSize) : m_parser(maxPayloadSize) {}
+
+    PacketParser m_parser;
+    string m_clientId;
+    bool m_isAuthorized = false;
+    // Index of the track of the connection in the batch |m_batchGeneration|.
+    size_t m_trackIndex = 0;
+    uint64_t m_batchGeneration = 0;
+  };
+
+  void Run()
+  {
+    vector<Event> events;
+    while (true)
+    {
+      {
+        unique_lock<mutex> lock(m_mutex);
+        auto const hasWork = [this] { return m_isFinished || !m_events.empty(); };
+        if (m_batch.empty())
+          m_cv.wait(lock, hasWork);
+        else
+          m_cv.wait_until(lock, m_batchStart + m_service.m_params.m_maxBatchDelay, hasWork);
+
+        if (m_isFinished && m_events.empty())
+          break;
+        events.swap(m_events);
+      }
+
+      for (auto & event : events)
+      {
+        Process(event);
+        if (m_batchPoints >= m_service.m_params.m_maxBatchPoints)
+          Flush();
+      }
+      events.clear();
+
+      if (!m_batch.empty() &&
+          steady_clock::now() >= m_batchStart + m_service.m_params.m_maxBatchDelay)
+      {
+        Flush();
+      }
+    }
+    Flush();
+  }
+
+  void Process(Event & event)
+  {
+    if (event.m_isClosed)
+    {
+      m_connections.erase(event.m_id);
+      return;
+    }
+
+    auto it = m_connections.find(event.m_id);
+    if (it == m_connections.end())
+    {
+      it = m_connections.emplace(event.m_id, Connection(m_service.m_params.m_maxPayloadSize))
+               .first;
+    }
+    auto & connection = it->second;
+
+    bool isValid = true;
+    isValid = connection.m_parser.Feed(
+                  event.m_data.data(), event.m_data.size(),
+                  [&](Protocol::PacketType type, uint8_t const * payload, size_t size) {
+                    if (isValid)
+                      isValid = ProcessPacket(event.m_id, connection, type, payload, size);
+                  }) &&
+              isValid;
+
+    if (!isValid)
+    {
+      m_connections.erase(it);
+      ++m_service.m_droppedConnections;
+      if (m_service.m_callbacks.m_dropFn)
+        m_service.m_callbacks.m_dropFn(event.m_id);
+    }
+  }
+
+  bool ProcessPacket(ConnectionId id, Connection & connection, Protocol::PacketType type,
+                     uint8_t const * payload, size_t size)
+  {
+    ++m_service.m_packets;
+
+    if (Protocol::IsAuthPacket(type))
+    {
+      connection.m_clientId = Protocol::DecodeAuthPacket(type, payload, size);
+      connection.m_isAuthorized = true;
+      if (m_service.m_callbacks.m_replyFn)
+        m_service.m_callbacks.m_replyFn(id, Protocol::kOk, sizeof(Protocol::kOk));
+      return true;
+    }
+
+    if (!connection.m_isAuthorized)
+    {
+      LOG(LWARNING, ("Data packet before authorization, connection:", id));
+      return false;
+    }
+
+    if (m_batch.empty())
+      m_batchStart = steady_clock::now();
+
+    if (connection.m_batchGeneration != m_batchGeneration)
+    {
+      connection.m_batchGeneration = m_batchGeneration;
+      connection.m_trackIndex = m_batch.size();
+      m_batch.push_back({connection.m_clientId, {}});
+    }
+
+    // Points are decoded straight to the batch.
+    auto & points = m_batch[connection.m_trackIndex].m_points;
+    size_t const oldSize = points.size();
+    try
+    {
+      Protocol::DecodeDataPacket(type, payload, size, points);
+    }
+    catch (Reader::Exception const & e)
+    {
+      LOG(LWARNING, ("Can't decode data packet, connection:", id, e.Msg()));
+      points.resize(oldSize);
+      return false;
+    }
+
+    m_batchPoints += points.size() - oldSize;
+    m_service.m_points += points.size() - oldSize;
+    return true;
+  }
+
+  void Flush()
+  {
+    if (m_batch.empty())
+      return;
+
+    // Tracks of dropped connections may be empty.
+    m_batch.erase(remove_if(m_batch.begin(), m_batch.end(),
+                            [](Track const & track) { return track.m_points.empty(); }),
+                  m_batch.end());
+    if (!m_batch.empty())
+    {
+      ++m_service.m_batches;
+      if (m_service.m_callbacks.m_writeBatchFn)
+        m_service.m_callbacks.m_writeBatchFn(move(m_batch));
+    }
+
+    m_batch.clear();
+    m_batchPoints = 0;
+    ++m_batchGeneration;
+  }
+
+  IngestionService & m_service;
+
+  mutex m_mutex;
+  condition_variable m_cv;
+  vector<Event> m_events;
+  bool m_isFinished = false;
+
+  // Fields below are used by the shard thread only.
+  unordered_map<ConnectionId, Connection> m_connections;
+  Batch m_batch;
+  size_t m_batchPoints = 0;
+  // Starts from 1, so new connections have no track in the current batch.
+  uint64_t m_batchGeneration = 1;
+  steady_clock::time_point m_batchStart;
+
+  threads::SimpleThread m_thread;
+};
+
+IngestionService::IngestionService(Params const & params, Callbacks const & callbacks)
+  : m_params(params)
+  , m_callbacks(callbacks)
+  , m_packets(0)
+  , m_points(0)
+  , m_batches(0)
+  , m_droppedConnections(0)
+{
+  size_t numShards = m_params.m_numShards;
+  if (numShards == 0)
+    numShards = max(thread::hardware_concurrency(), 1U);
+
+  for (size_t i = 0; i < numShards; ++i)
+    m_shards.push_back(make_unique<Shard>(*this));
+}
+
+IngestionService::~IngestionService() { m_shards.clear(); }
+
+void IngestionService::OnData(ConnectionId id, vector<uint8_t> && data)
+{
+  GetShard(id).Push(id, move(data), false /* isClosed */);
+}
+
+void IngestionService::OnClose(ConnectionId id)
+{
+  GetShard(id).Push(id, vector<uint8_t>(), true /* isClosed */);
+}
+
+IngestionService::Stats IngestionService::GetStats() const
+{
+  Stats stats;
+  stats.m_packets = m_packets;
+  stats.m_points = m_points;
+  stats.m_batches = m_batches;
+  stats.m_droppedConnections = m_droppedConnections;
+  return stats;
+}
+}  // namespace tracking
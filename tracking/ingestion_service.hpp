@@ -0,0 +1,93 @@
+#pragma once
+
+#include "tracking/protocol.hpp"
+
+#include "base/macros.hpp"
+
+#include "std/atomic.hpp"
+#include "std/chrono.hpp"
+#include "std/cstdint.hpp"
+#include "std/function.hpp"
+#include "std/string.hpp"
+#include "std/unique_ptr.hpp"
+#include "std/vector.hpp"
+
+namespace tracking
+{
+// Server side of the tracking protocol. The transport layer owns the sockets and passes the
+// received bytes to OnData(), the service authorizes connections, decodes points and
+// writes them in batches.
+//
+// Connections are sharded between worker threads by their ids, everything about a connection
+// is handled by the thread of its shard, so the shards share no state and scale with cores.
+class IngestionService final
+{
+public:
+  using ConnectionId = uint64_t;
+
+  struct Track
+  {
+    string m_clientId;
+    Protocol::DataElementsVec m_points;
+  };
+  // Points of a batch are grouped by connections, there is one track per connection.
+  using Batch = vector<Track>;
+
+  // All callbacks are called on the shard threads, concurrently for different shards.
+  struct Callbacks
+  {
+    function<void(Batch && batch)> m_writeBatchFn;
+    // Sends a reply to a connection.
+    function<void(ConnectionId id, uint8_t const * data, size_t size)> m_replyFn;
+    // Asks the transport to close a connection which violates the protocol.
+    function<void(ConnectionId id)> m_dropFn;
+  };
+
+  struct Params
+  {
+    // Zero means one shard per hardware thread.
+    size_t m_numShards = 0;
+    // A batch is written when it has this number of points or when it's older than
+    // |m_maxBatchDelay|.
+    size_t m_maxBatchPoints = 10000;
+    milliseconds m_maxBatchDelay = milliseconds(1000);
+    size_t m_maxPayloadSize = 1024 * 1024;
+  };
+
+  struct Stats
+  {
+    uint64_t m_packets = 0;
+    uint64_t m_points = 0;
+    uint64_t m_batches = 0;
+    uint64_t m_droppedConnections = 0;
+  };
+
+  IngestionService(Params const & params, Callbacks const & callbacks);
+  // Processes all received data, writes the last batches and stops the shards.
+  ~IngestionService();
+
+  // Both methods are thread safe, data of a connection must be passed in order of receiving.
+  void OnData(ConnectionId id, vector<uint8_t> && data);
+  void OnClose(ConnectionId id);
+
+  size_t GetNumShards() const { return m_shards.size(); }
+  Stats GetStats() const;
+
+private:
+  class Shard;
+
+  DISALLOW_COPY_AND_MOVE(IngestionService);
+
+  Shard & GetShard(ConnectionId id) { return *m_shards[id % m_shards.size()]; }
+
+  Params const m_params;
+  Callbacks const m_callbacks;
+
+  atomic<uint64_t> m_packets;
+  atomic<uint64_t> m_points;
+  atomic<uint64_t> m_batches;
+  atomic<uint64_t> m_droppedConnections;
+
+  vector<unique_ptr<Shard>> m_shards;
+};
+}  // namespace tracking
@@ -0,0 +1,90 @@
+#include "tracking/packet_parser.hpp"
+
+#include "base/logging.hpp"
+
+#include "std/algorithm.hpp"
+
+namespace tracking
+{
+// static
+size_t constexpr PacketParser::kHeaderSize;
+
+PacketParser::PacketParser(size_t maxPayloadSize) : m_maxPayloadSize(maxPayloadSize) {}
+
+bool PacketParser::Feed(uint8_t const * data, size_t size, PacketFn const & fn)
+{
+  if (m_isBroken)
+    return false;
+
+  Protocol::PacketType type;
+  size_t payloadSize = 0;
+
+  // Completes the packet which has begun in one of the previous chunks.
+  if (!m_pending.empty())
+  {
+    if (m_pending.size() < kHeaderSize)
+    {
+      size_t const n = min(kHeaderSize - m_pending.size(), size);
+      m_pending.insert(m_pending.end(), data, data + n);
+      data += n;
+      size -= n;
+      if (m_pending.size() < kHeaderSize)
+        return true;
+    }
+
+    if (!ReadHeader(m_pending.data(), type, payloadSize))
+      return false;
+
+    size_t const packetSize = kHeaderSize + payloadSize;
+    size_t const n = min(packetSize - m_pending.size(), size);
+    m_pending.insert(m_pending.end(), data, data + n);
+    data += n;
+    size -= n;
+    if (m_pending.size() < packetSize)
+      return true;
+
+    fn(type, m_pending.data() + kHeaderSize, payloadSize);
+    m_pending.clear();
+  }
+
+  while (size >= kHeaderSize)
+  {
+    if (!ReadHeader(data, type, payloadSize))
+      return false;
+
+    size_t const packetSize = kHeaderSize + payloadSize;
+    if (size < packetSize)
+      break;
+
+    fn(type, data + kHeaderSize, payloadSize);
+    data += packetSize;
+    size -= packetSize;
+  }
+
+  m_pending.assign(data, data + size);
+  return true;
+}
+
+bool PacketParser::ReadHeader(uint8_t const * data, Protocol::PacketType & type,
+                              size_t & payloadSize)
+{
+  auto const header = Protocol::DecodeHeader(data, kHeaderSize);
+  type = header.first;
+  payloadSize = header.second;
+
+  if (!Protocol::IsAuthPacket(type) && !Protocol::IsDataPacket(type))
+  {
+    LOG(LWARNING, ("Unknown packet type:", type));
+    m_isBroken = true;
+  }
+  else if (payloadSize > m_maxPayloadSize)
+  {
+    LOG(LWARNING, ("Too large packet:", type, payloadSize));
+    m_isBroken = true;
+  }
+
+  if (m_isBroken)
+    m_pending.clear();
+  return !m_isBroken;
+}
+}  // namespace tracking
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "tracking/protocol.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/function.hpp"
+#include "std/vector.hpp"
+
+namespace tracking
+{
+// Splits a stream of bytes received from a tracking connection into packets.
+// Packets which are entirely inside a chunk passed to Feed() are reported in place,
+// only a packet split between chunks is copied to the internal buffer.
+class PacketParser final
+{
+public:
+  // |payload| is valid only during the call.
+  using PacketFn =
+      function<void(Protocol::PacketType type, uint8_t const * payload, size_t payloadSize)>;
+
+  static size_t constexpr kHeaderSize = sizeof(uint32_t);
+
+  explicit PacketParser(size_t maxPayloadSize);
+
+  // Calls |fn| for each packet completed by the next |size| bytes of the stream.
+  // Returns false when the stream is malformed: a packet has an unknown type or is
+  // too large. The parser rejects all data after that.
+  bool Feed(uint8_t const * data, size_t size, PacketFn const & fn);
+
+  bool IsBroken() const { return m_isBroken; }
+  // Returns number of bytes of an incomplete packet which are kept until the next chunk.
+  size_t GetPendingSize() const { return m_pending.size(); }
+
+private:
+  bool ReadHeader(uint8_t const * data, Protocol::PacketType & type, size_t & payloadSize);
+
+  size_t const m_maxPayloadSize;
+  vector<uint8_t> m_pending;
+  bool m_isBroken = false;
+};
+}  // namespace tracking
@@ -0,0 +1,95 @@
+#include "tracking/points_queue.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/logging.hpp"
+
+namespace tracking
+{
+PointsQueue::PointsQueue(string const & filePath, uint64_t maxFileSize)
+  : m_filePath(filePath), m_maxFileSize(maxFileSize)
+{
+  if (!m_filePath.empty() && !my::GetFileSize(m_filePath, m_fileSize))
+    m_fileSize = 0;
+}
+
+vector<PointsQueue::DataPoint> PointsQueue::ReadAll() const
+{
+  vector<DataPoint> points;
+  if (IsEmpty())
+    return points;
+
+  try
+  {
+    FileReader reader(m_filePath);
+    ReaderSource<FileReader> src(reader);
+    while (src.Size() > 0)
+    {
+      auto const version = ReadPrimitiveFromSource<uint8_t>(src);
+      auto const size = ReadVarUint<uint64_t>(src);
+      if (version > coding::TrafficGPSEncoder::kLatestVersion || size > src.Size())
+      {
+        LOG(LWARNING, ("Broken record in the tracking queue", m_filePath));
+        break;
+      }
+
+      vector<uint8_t> payload(static_cast<size_t>(size));
+      src.Read(payload.data(), payload.size());
+      MemReader memReader(payload.data(), payload.size());
+      ReaderSource<MemReader> recordSrc(memReader);
+      coding::TrafficGPSEncoder::DeserializeDataPoints(version, recordSrc, points);
+    }
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't read the tracking queue", m_filePath, e.Msg()));
+  }
+  return points;
+}
+
+void PointsQueue::Clear()
+{
+  if (m_filePath.empty())
+    return;
+
+  my::DeleteFileX(m_filePath);
+  m_fileSize = 0;
+}
+
+bool PointsQueue::WriteRecord(vector<uint8_t> const & payload)
+{
+  vector<uint8_t> header;
+  {
+    MemWriter<decltype(header)> writer(header);
+    WriteToSink(writer, static_cast<uint8_t>(coding::TrafficGPSEncoder::kLatestVersion));
+    WriteVarUint(writer, static_cast<uint64_t>(payload.size()));
+  }
+
+  uint64_t const recordSize = header.size() + payload.size();
+  if (m_fileSize + recordSize > m_maxFileSize)
+  {
+    LOG(LWARNING, ("The tracking queue is full, points are dropped. Queue size:", m_fileSize));
+    return false;
+  }
+
+  try
+  {
+    FileWriter writer(m_filePath, FileWriter::OP_APPEND);
+    writer.Write(header.data(), header.size());
+    writer.Write(payload.data(), payload.size());
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't write the tracking queue", m_filePath, e.Msg()));
+    return false;
+  }
+
+  m_fileSize += recordSize;
+  return true;
+}
+}  // namespace tracking
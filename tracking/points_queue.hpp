@@ -0,0 +1,59 @@
+#pragma once
+
+#include "coding/traffic.hpp"
+#include "coding/writer.hpp"
+
+#include "std/cstdint.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+namespace tracking
+{
+// Persistent queue of points which could not be sent, so the points survive losses
+// of connection and restarts of the app. The file is a sequence of records:
+// [version of the encoder: uint8] [size of the payload: varuint] [payload]
+// where the payload is the points serialized by coding::TrafficGPSEncoder.
+//
+// *NOTE* This class is not thread safe.
+class PointsQueue final
+{
+public:
+  using DataPoint = coding::TrafficGPSEncoder::DataPoint;
+
+  // An empty |filePath| disables the queue, it stores nothing then.
+  PointsQueue(string const & filePath, uint64_t maxFileSize);
+
+  // Appends |points| to the file. Returns false if the points are not stored because
+  // the queue is disabled or full or the write fails.
+  template <typename Collection>
+  bool Push(Collection const & points)
+  {
+    if (m_filePath.empty())
+      return false;
+    if (points.empty())
+      return true;
+
+    vector<uint8_t> payload;
+    MemWriter<decltype(payload)> writer(payload);
+    coding::TrafficGPSEncoder::SerializeDataPoints(coding::TrafficGPSEncoder::kLatestVersion,
+                                                   writer, points);
+    return WriteRecord(payload);
+  }
+
+  bool IsEmpty() const { return m_fileSize == 0; }
+  uint64_t GetFileSize() const { return m_fileSize; }
+
+  // Returns all stored points in the order they were pushed. A broken record at the end
+  // of the file, for example after a crash during a write, is skipped.
+  vector<DataPoint> ReadAll() const;
+
+  void Clear();
+
+private:
+  bool WriteRecord(vector<uint8_t> const & payload);
+
+  string const m_filePath;
+  uint64_t const m_maxFileSize;
+  uint64_t m_fileSize = 0;
+};
+}  // namespace tracking
@@ -1,11 +1,13 @@
 #include "tracking/protocol.hpp"
 
 #include "coding/endianness.hpp"
+#include "coding/reader.hpp"
 #include "coding/writer.hpp"
 
 #include "base/assert.hpp"
 
 #include "std/cstdint.hpp"
+#include "std/cstring.hpp"
 #include "std/sstream.hpp"
 #include "std/utility.hpp"
 
@@ -23,6 +25,7 @@ vector<uint8_t> CreateDataPacketImpl(Container const & points,
   {
   case tracking::Protocol::PacketType::DataV0: version = 0; break;
   case tracking::Protocol::PacketType::DataV1: version = 1; break;
+  case tracking::Protocol::PacketType::DataV2: version = 2; break;
   case tracking::Protocol::PacketType::AuthV0: ASSERT(false, ("Not a DATA packet.")); break;
   }
 
@@ -76,33 +79,57 @@ vector<uint8_t> Protocol::CreateDataPacket(DataElementsVec const & points, Packe
 //  static
 pair<Protocol::PacketType, size_t> Protocol::DecodeHeader(vector<uint8_t> const & data)
 {
-  ASSERT_GREATER_OR_EQUAL(data.size(), sizeof(uint32_t /* header */), ());
+  return DecodeHeader(data.data(), data.size());
+}
 
-  uint32_t size = (*reinterpret_cast<uint32_t const *>(data.data())) & 0xFFFFFF00;
+//  static
+string Protocol::DecodeAuthPacket(Protocol::PacketType type, vector<uint8_t> const & data)
+{
+  return DecodeAuthPacket(type, data.data(), data.size());
+}
+
+//  static
+Protocol::DataElementsVec Protocol::DecodeDataPacket(PacketType type, vector<uint8_t> const & data)
+{
+  DataElementsVec points;
+  DecodeDataPacket(type, data.data(), data.size(), points);
+  return points;
+}
+
+//  static
+pair<Protocol::PacketType, size_t> Protocol::DecodeHeader(uint8_t const * data, size_t size)
+{
+  ASSERT_GREATER_OR_EQUAL(size, sizeof(uint32_t /* header */), ());
+
+  // |data| may be unaligned when it points into a network buffer.
+  uint32_t payloadSize;
+  memcpy(&payloadSize, data, sizeof(payloadSize));
+  payloadSize &= 0xFFFFFF00;
   if (!IsBigEndian())
-    size = ReverseByteOrder(size);
+    payloadSize = ReverseByteOrder(payloadSize);
 
-  return make_pair(PacketType(static_cast<uint8_t>(data[0])), size);
+  return make_pair(PacketType(data[0]), payloadSize);
 }
 
 //  static
-string Protocol::DecodeAuthPacket(Protocol::PacketType type, vector<uint8_t> const & data)
+string Protocol::DecodeAuthPacket(Protocol::PacketType type, uint8_t const * data, size_t size)
 {
   switch (type)
   {
-  case Protocol::PacketType::AuthV0: return string(begin(data), end(data));
+  case Protocol::PacketType::AuthV0: return string(data, data + size);
   case Protocol::PacketType::DataV0:
-  case Protocol::PacketType::DataV1: ASSERT(false, ("Not an AUTH packet.")); break;
+  case Protocol::PacketType::DataV1:
+  case Protocol::PacketType::DataV2: ASSERT(false, ("Not an AUTH packet.")); break;
   }
   return string();
 }
 
 //  static
-Protocol::DataElementsVec Protocol::DecodeDataPacket(PacketType type, vector<uint8_t> const & data)
+void Protocol::DecodeDataPacket(PacketType type, uint8_t const * data, size_t size,
+                                DataElementsVec & points)
 {
-  DataElementsVec points;
-  MemReader memReader(data.data(), data.size());
-  ReaderSource<MemReader> src(memReader);
+  MemReaderWithExceptions memReader(data, size);
+  ReaderSource<MemReaderWithExceptions> src(memReader);
   switch (type)
   {
   case Protocol::PacketType::DataV0:
@@ -111,9 +138,27 @@ Protocol::DataElementsVec Protocol::DecodeDataPacket(PacketType type, vector<uin
   case Protocol::PacketType::DataV1:
     Encoder::DeserializeDataPoints(1 /* version */, src, points);
     break;
+  case Protocol::PacketType::DataV2:
+    Encoder::DeserializeDataPoints(2 /* version */, src, points);
+    break;
   case Protocol::PacketType::AuthV0: ASSERT(false, ("Not a DATA packet.")); break;
   }
-  return points;
+}
+
+//  static
+bool Protocol::IsAuthPacket(PacketType type) { return type == PacketType::AuthV0; }
+
+//  static
+bool Protocol::IsDataPacket(PacketType type)
+{
+  switch (type)
+  {
+  case Protocol::PacketType::DataV0:
+  case Protocol::PacketType::DataV1:
+  case Protocol::PacketType::DataV2: return true;
+  case Protocol::PacketType::AuthV0: return false;
+  }
+  return false;
 }
 
 //  static
@@ -138,6 +183,7 @@ string DebugPrint(Protocol::PacketType type)
   case Protocol::PacketType::AuthV0: return "AuthV0";
   case Protocol::PacketType::DataV0: return "DataV0";
   case Protocol::PacketType::DataV1: return "DataV1";
+  case Protocol::PacketType::DataV2: return "DataV2";
   }
   stringstream ss;
   ss << "Unknown(" << static_cast<uint32_t>(type) << ")";
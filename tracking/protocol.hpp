@@ -33,9 +33,10 @@ public:
     AuthV0 = 0x81,
     DataV0 = 0x82,
     DataV1 = 0x92,
+    DataV2 = 0xA2,
 
     CurrentAuth = AuthV0,
-    CurrentData = DataV1
+    CurrentData = DataV2
   };
 
   static vector<uint8_t> CreateHeader(PacketType type, uint32_t payloadSize);
@@ -47,6 +48,18 @@ public:
   static string DecodeAuthPacket(PacketType type, vector<uint8_t> const & data);
   static DataElementsVec DecodeDataPacket(PacketType type, vector<uint8_t> const & data);
 
+  // The same as above but read |size| bytes at |data| in place, so packets can be decoded
+  // straight from a network buffer.
+  static std::pair<PacketType, size_t> DecodeHeader(uint8_t const * data, size_t size);
+  static string DecodeAuthPacket(PacketType type, uint8_t const * data, size_t size);
+  // Appends the decoded points to |points|.
+  // @exception Reader::SizeException if the payload is truncated.
+  static void DecodeDataPacket(PacketType type, uint8_t const * data, size_t size,
+                               DataElementsVec & points);
+
+  static bool IsAuthPacket(PacketType type);
+  static bool IsDataPacket(PacketType type);
+
 private:
   static void InitHeader(vector<uint8_t> & packet, PacketType type, uint32_t payloadSize);
 };
@@ -36,6 +36,7 @@ BOOST_PYTHON_MODULE(pytracking)
       .value("AuthV0", Protocol::PacketType::AuthV0)
       .value("DataV0", Protocol::PacketType::DataV0)
       .value("DataV1", Protocol::PacketType::DataV1)
+      .value("DataV2", Protocol::PacketType::DataV2)
       .value("CurrentAuth", Protocol::PacketType::CurrentAuth)
       .value("CurrentData", Protocol::PacketType::CurrentData);
 
@@ -46,6 +47,12 @@ BOOST_PYTHON_MODULE(pytracking)
                                        tracking::Protocol::PacketType) =
       &Protocol::CreateDataPacket;
 
+  pair<Protocol::PacketType, size_t> (*DecodeHeader)(vector<uint8_t> const &) =
+      &Protocol::DecodeHeader;
+  Protocol::DataElementsVec (*DecodeDataPacket)(Protocol::PacketType,
+                                                vector<uint8_t> const &) =
+      &Protocol::DecodeDataPacket;
+
   class_<Protocol>("Protocol")
       .def("CreateAuthPacket", &Protocol::CreateAuthPacket)
       .staticmethod("CreateAuthPacket")
@@ -54,8 +61,8 @@ BOOST_PYTHON_MODULE(pytracking)
       .staticmethod("CreateDataPacket")
       .def("CreateHeader", &Protocol::CreateHeader)
       .staticmethod("CreateHeader")
-      .def("DecodeHeader", &Protocol::DecodeHeader)
+      .def("DecodeHeader", DecodeHeader)
       .staticmethod("DecodeHeader")
-      .def("DecodeDataPacket", &Protocol::DecodeDataPacket)
+      .def("DecodeDataPacket", DecodeDataPacket)
       .staticmethod("DecodeDataPacket");
 }
@@ -26,13 +26,20 @@ const char Reporter::kEnableTrackingKey[] = "StatisticsEnabled";
 
 // static
 milliseconds const Reporter::kPushDelayMs = milliseconds(20000);
+// static
+uint32_t const Reporter::kCellularPushDelayFactor = 3;
+// static
+uint64_t const Reporter::kMaxQueueFileSize = 1024 * 1024;
 
 Reporter::Reporter(unique_ptr<platform::Socket> socket, string const & host, uint16_t port,
-                   milliseconds pushDelay)
+                   milliseconds pushDelay, string const & queueFilePath,
+                   ConnectionStatusFn const & connectionStatusFn)
   : m_allowSendingPoints(true)
   , m_realtimeSender(move(socket), host, port, false)
   , m_pushDelay(pushDelay)
+  , m_connectionStatusFn(connectionStatusFn)
   , m_points(kRealTimeBufferSize)
+  , m_queue(queueFilePath, kMaxQueueFileSize)
   , m_thread([this] { Run(); })
 {
 }
@@ -125,8 +132,38 @@ bool Reporter::SendPoints()
   if (m_points.empty())
     return true;
 
+  // Points are kept on disk while there is no network, a failed attempt to send
+  // them is not worth a radio wakeup.
+  auto const connectionStatus = m_connectionStatusFn();
+  if (connectionStatus == Platform::EConnectionType::CONNECTION_NONE)
+    return m_queue.Push(m_points);
+
+  auto const now = steady_clock::now();
+  if (connectionStatus == Platform::EConnectionType::CONNECTION_WWAN && !m_points.full() &&
+      now < m_lastSendTime + m_pushDelay * kCellularPushDelayFactor)
+  {
+    return false;
+  }
+
+  if (!m_queue.IsEmpty())
+  {
+    if (!Send(m_queue.ReadAll()))
+      return m_queue.Push(m_points);
+    m_queue.Clear();
+  }
+
+  if (!Send(m_points))
+    return m_queue.Push(m_points);
+
+  m_lastSendTime = now;
+  return true;
+}
+
+template <typename Points>
+bool Reporter::Send(Points const & points)
+{
   if (m_wasConnected)
-    m_wasConnected = m_realtimeSender.Send(m_points);
+    m_wasConnected = m_realtimeSender.Send(points);
 
   if (m_wasConnected)
     return true;
@@ -141,7 +178,7 @@ bool Reporter::SendPoints()
   if (!m_wasConnected)
     return false;
 
-  m_wasConnected = m_realtimeSender.Send(m_points);
+  m_wasConnected = m_realtimeSender.Send(points);
   return m_wasConnected;
 }
 }  // namespace tracking
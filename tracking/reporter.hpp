@@ -1,9 +1,12 @@
 #pragma once
 
 #include "tracking/connection.hpp"
+#include "tracking/points_queue.hpp"
 
 #include "traffic/speed_groups.hpp"
 
+#include "platform/platform.hpp"
+
 #include "base/thread.hpp"
 
 #include "std/atomic.hpp"
@@ -33,10 +36,19 @@ class Reporter final
 {
 public:
   static milliseconds const kPushDelayMs;
+  // On a cellular network points are collected for this number of push delays before
+  // they are sent, so the radio wakes up less often.
+  static uint32_t const kCellularPushDelayFactor;
+  static uint64_t const kMaxQueueFileSize;
   static const char kEnableTrackingKey[];
 
+  using ConnectionStatusFn = function<Platform::EConnectionType()>;
+
+  // |queueFilePath| is a file to keep the points which could not be sent while there is
+  // no connection, an empty path disables it.
   Reporter(unique_ptr<platform::Socket> socket, string const & host, uint16_t port,
-           milliseconds pushDelay);
+           milliseconds pushDelay, string const & queueFilePath = string(),
+           ConnectionStatusFn const & connectionStatusFn = &Platform::ConnectionStatus);
   ~Reporter();
 
   void AddLocation(location::GpsInfo const & info, traffic::SpeedGroup traffic);
@@ -48,10 +60,14 @@ public:
 private:
   void Run();
   bool SendPoints();
+  template <typename Points>
+  bool Send(Points const & points);
 
   atomic<bool> m_allowSendingPoints;
   Connection m_realtimeSender;
   milliseconds m_pushDelay;
+  ConnectionStatusFn m_connectionStatusFn;
+  steady_clock::time_point m_lastSendTime;
   bool m_wasConnected = false;
   double m_lastConnectionAttempt = 0.0;
   double m_lastNotChargingEvent = 0.0;
@@ -62,6 +78,9 @@ private:
   vector<DataPoint> m_input;
   // Last collected points, sends periodically to server.
   boost::circular_buffer<DataPoint> m_points;
+  // Points which could not be sent, they are sent before new points as soon as
+  // the connection is restored. It's used by the worker thread only.
+  PointsQueue m_queue;
   double m_lastGpsTime = 0.0;
   bool m_isFinished = false;
   mutex m_mutex;
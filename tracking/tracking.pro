@@ -8,10 +8,16 @@ include($$ROOT_DIR/common.pri)
 
 SOURCES += \
     connection.cpp \
+    ingestion_service.cpp \
+    packet_parser.cpp \
+    points_queue.cpp \
     protocol.cpp \
     reporter.cpp \
 
 HEADERS += \
     connection.hpp \
+    ingestion_service.hpp \
+    packet_parser.hpp \
+    points_queue.hpp \
     protocol.hpp \
     reporter.hpp \
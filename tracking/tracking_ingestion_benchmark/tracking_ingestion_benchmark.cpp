@@ -0,0 +1,140 @@
+// Load generator for tracking::IngestionService. It emulates devices which authorize and send
+// data packets, the streams are split into chunks of --chunk_size bytes as a network layer
+// would receive them, and are fed to the service from --producers threads.
+
+#include "tracking/ingestion_service.hpp"
+#include "tracking/protocol.hpp"
+
+#include "base/logging.hpp"
+#include "base/string_utils.hpp"
+#include "base/timer.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/atomic.hpp"
+#include "std/thread.hpp"
+#include "std/vector.hpp"
+
+#include "3party/gflags/src/gflags/gflags.h"
+
+DEFINE_uint64(devices, 10000, "number of emulated devices");
+DEFINE_uint64(packets, 10, "number of data packets per device");
+DEFINE_uint64(points, 30, "number of points per data packet");
+DEFINE_uint64(chunk_size, 1400, "size of chunks the streams of devices are split to");
+DEFINE_uint64(producers, 2, "number of threads which feed the service");
+DEFINE_uint64(shards, 0, "number of shards of the service, 0 for one per hardware thread");
+DEFINE_uint64(batch_points, 10000, "max number of points in a batch");
+
+using namespace tracking;
+
+namespace
+{
+using Chunks = vector<vector<uint8_t>>;
+
+Chunks GenerateDevice(uint64_t device)
+{
+  vector<uint8_t> stream = Protocol::CreateAuthPacket("device" + strings::to_string(device));
+
+  // Points of a device go along a line with a small per device offset, as real tracks do.
+  uint64_t timestamp = 1500000000 + device % 1000;
+  double lat = 55.0 + static_cast<double>(device % 100) * 0.01;
+  double lon = 37.0 + static_cast<double>(device % 77) * 0.01;
+  for (uint64_t i = 0; i < FLAGS_packets; ++i)
+  {
+    Protocol::DataElementsVec points;
+    for (uint64_t j = 0; j < FLAGS_points; ++j)
+    {
+      points.emplace_back(timestamp++, ms::LatLon(lat, lon), static_cast<uint8_t>(j % 4));
+      lat += 0.0001;
+      lon += 0.00005;
+    }
+    auto const packet = Protocol::CreateDataPacket(points, Protocol::PacketType::CurrentData);
+    stream.insert(stream.end(), packet.begin(), packet.end());
+  }
+
+  Chunks chunks;
+  for (size_t i = 0; i < stream.size(); i += FLAGS_chunk_size)
+  {
+    auto const end = min(stream.size(), static_cast<size_t>(i + FLAGS_chunk_size));
+    chunks.emplace_back(stream.begin() + i, stream.begin() + end);
+  }
+  return chunks;
+}
+}  // namespace
+
+int main(int argc, char * argv[])
+{
+  google::SetUsageMessage("Load generator for the tracking ingestion service.");
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  if (FLAGS_chunk_size == 0 || FLAGS_producers == 0)
+  {
+    LOG(LERROR, ("--chunk_size and --producers must be positive."));
+    return -1;
+  }
+
+  LOG(LINFO, ("Generating", FLAGS_devices, "devices"));
+  vector<Chunks> devices(FLAGS_devices);
+  uint64_t totalBytes = 0;
+  for (uint64_t i = 0; i < FLAGS_devices; ++i)
+  {
+    devices[i] = GenerateDevice(i);
+    for (auto const & chunk : devices[i])
+      totalBytes += chunk.size();
+  }
+
+  atomic<uint64_t> writtenPoints(0);
+  atomic<uint64_t> writtenBatches(0);
+  IngestionService::Callbacks callbacks;
+  callbacks.m_writeBatchFn = [&](IngestionService::Batch && batch) {
+    ++writtenBatches;
+    for (auto const & track : batch)
+      writtenPoints += track.m_points.size();
+  };
+
+  IngestionService::Params params;
+  params.m_numShards = FLAGS_shards;
+  params.m_maxBatchPoints = FLAGS_batch_points;
+
+  my::Timer timer;
+  {
+    IngestionService service(params, callbacks);
+    LOG(LINFO, ("Shards:", service.GetNumShards(), "producers:", FLAGS_producers));
+
+    // Each producer interleaves chunks of its devices, as a network layer would do it.
+    vector<thread> producers;
+    for (uint64_t p = 0; p < FLAGS_producers; ++p)
+    {
+      producers.emplace_back([&devices, &service, p] {
+        for (size_t round = 0;; ++round)
+        {
+          bool hasData = false;
+          for (uint64_t d = p; d < devices.size(); d += FLAGS_producers)
+          {
+            if (round < devices[d].size())
+            {
+              service.OnData(d, move(devices[d][round]));
+              hasData = true;
+            }
+            else if (round == devices[d].size())
+            {
+              service.OnClose(d);
+            }
+          }
+          if (!hasData)
+            break;
+        }
+      });
+    }
+    for (auto & producer : producers)
+      producer.join();
+    // The destructor waits for the shards to process all data.
+  }
+  double const seconds = timer.ElapsedSeconds();
+  double const megabytes = static_cast<double>(totalBytes) / (1024 * 1024);
+
+  LOG(LINFO, ("Points:", writtenPoints.load(), "batches:", writtenBatches.load(), "MB:",
+              megabytes, "seconds:", seconds));
+  LOG(LINFO, ("Points per second:", static_cast<double>(writtenPoints) / seconds,
+              "MB per second:", megabytes / seconds));
+  return 0;
+}
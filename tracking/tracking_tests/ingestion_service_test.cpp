@@ -0,0 +1,157 @@
+#include "testing/testing.hpp"
+
+#include "tracking/ingestion_service.hpp"
+#include "tracking/packet_parser.hpp"
+#include "tracking/protocol.hpp"
+
+#include "base/string_utils.hpp"
+
+#include "std/algorithm.hpp"
+#include "std/map.hpp"
+#include "std/mutex.hpp"
+#include "std/set.hpp"
+#include "std/string.hpp"
+#include "std/vector.hpp"
+
+using namespace tracking;
+
+namespace
+{
+using DataPoint = Protocol::Encoder::DataPoint;
+using Points = Protocol::DataElementsVec;
+
+Points MakePoints(uint64_t firstTimestamp, size_t count)
+{
+  Points points;
+  for (size_t i = 0; i < count; ++i)
+    points.emplace_back(firstTimestamp + i, ms::LatLon(55.0 + i * 0.01, 37.0), 0 /* traffic */);
+  return points;
+}
+
+void Append(vector<uint8_t> const & packet, vector<uint8_t> & stream)
+{
+  stream.insert(stream.end(), packet.begin(), packet.end());
+}
+
+UNIT_TEST(PacketParser_Chunks)
+{
+  vector<uint8_t> stream;
+  Append(Protocol::CreateAuthPacket("client"), stream);
+  Append(Protocol::CreateDataPacket(MakePoints(10, 5), Protocol::PacketType::DataV2), stream);
+  Append(Protocol::CreateDataPacket(MakePoints(20, 3), Protocol::PacketType::DataV1), stream);
+
+  for (size_t const chunkSize : {size_t(1), size_t(3), size_t(7), stream.size()})
+  {
+    PacketParser parser(1024 /* maxPayloadSize */);
+    vector<Protocol::PacketType> types;
+    Points points;
+    for (size_t i = 0; i < stream.size(); i += chunkSize)
+    {
+      size_t const size = min(chunkSize, stream.size() - i);
+      TEST(parser.Feed(stream.data() + i, size,
+                       [&](Protocol::PacketType type, uint8_t const * payload, size_t payloadSize) {
+                         types.push_back(type);
+                         if (Protocol::IsDataPacket(type))
+                           Protocol::DecodeDataPacket(type, payload, payloadSize, points);
+                       }),
+           (chunkSize));
+    }
+    TEST_EQUAL(parser.GetPendingSize(), 0, ());
+
+    vector<Protocol::PacketType> const expectedTypes = {Protocol::PacketType::AuthV0,
+                                                        Protocol::PacketType::DataV2,
+                                                        Protocol::PacketType::DataV1};
+    TEST_EQUAL(types, expectedTypes, (chunkSize));
+    TEST_EQUAL(points.size(), 8, (chunkSize));
+    TEST_EQUAL(points.front().m_timestamp, 10, ());
+    TEST_EQUAL(points.back().m_timestamp, 22, ());
+  }
+}
+
+UNIT_TEST(PacketParser_Malformed)
+{
+  auto const noop = [](Protocol::PacketType, uint8_t const *, size_t) {};
+
+  vector<uint8_t> const unknown = {0x01, 0x00, 0x00, 0x00};
+  PacketParser unknownParser(1024 /* maxPayloadSize */);
+  TEST(!unknownParser.Feed(unknown.data(), unknown.size(), noop), ());
+  TEST(unknownParser.IsBroken(), ());
+
+  auto const large = Protocol::CreateAuthPacket(string(100, 'a'));
+  PacketParser largeParser(10 /* maxPayloadSize */);
+  TEST(!largeParser.Feed(large.data(), large.size(), noop), ());
+}
+
+UNIT_TEST(IngestionService_Smoke)
+{
+  size_t const kConnections = 20;
+  size_t const kPackets = 5;
+  size_t const kPointsPerPacket = 10;
+
+  mutex mu;
+  map<string, vector<uint64_t>> timestamps;
+  set<IngestionService::ConnectionId> replied;
+  set<IngestionService::ConnectionId> dropped;
+
+  IngestionService::Callbacks callbacks;
+  callbacks.m_writeBatchFn = [&](IngestionService::Batch && batch) {
+    lock_guard<mutex> lock(mu);
+    for (auto const & track : batch)
+    {
+      for (auto const & point : track.m_points)
+        timestamps[track.m_clientId].push_back(point.m_timestamp);
+    }
+  };
+  callbacks.m_replyFn = [&](IngestionService::ConnectionId id, uint8_t const * data, size_t size) {
+    lock_guard<mutex> lock(mu);
+    TEST(equal(data, data + size, Protocol::kOk), ());
+    replied.insert(id);
+  };
+  callbacks.m_dropFn = [&](IngestionService::ConnectionId id) {
+    lock_guard<mutex> lock(mu);
+    dropped.insert(id);
+  };
+
+  IngestionService::Params params;
+  params.m_numShards = 3;
+  params.m_maxBatchPoints = 25;
+
+  {
+    IngestionService service(params, callbacks);
+    for (size_t id = 0; id < kConnections; ++id)
+    {
+      vector<uint8_t> stream;
+      Append(Protocol::CreateAuthPacket("client" + strings::to_string(id)), stream);
+      for (size_t i = 0; i < kPackets; ++i)
+      {
+        Append(Protocol::CreateDataPacket(MakePoints(i * kPointsPerPacket, kPointsPerPacket),
+                                          Protocol::PacketType::CurrentData),
+               stream);
+      }
+
+      for (size_t i = 0; i < stream.size(); i += 13)
+      {
+        service.OnData(id, vector<uint8_t>(stream.begin() + i,
+                                           stream.begin() + min(i + 13, stream.size())));
+      }
+      service.OnClose(id);
+    }
+
+    // Data without authorization.
+    service.OnData(kConnections, Protocol::CreateDataPacket(MakePoints(0, 1),
+                                                            Protocol::PacketType::CurrentData));
+  }
+
+  TEST_EQUAL(replied.size(), kConnections, ());
+  TEST_EQUAL(dropped, set<IngestionService::ConnectionId>({kConnections}), ());
+  TEST_EQUAL(timestamps.size(), kConnections, ());
+  for (auto const & client : timestamps)
+  {
+    auto const & ts = client.second;
+    TEST_EQUAL(ts.size(), kPackets * kPointsPerPacket, (client.first));
+    // Points of a connection are written in order.
+    for (size_t i = 0; i < ts.size(); ++i)
+      TEST_EQUAL(ts[i], i, (client.first));
+  }
+}
+}  // namespace
@@ -0,0 +1,86 @@
+#include "testing/testing.hpp"
+
+#include "tracking/points_queue.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_name_utils.hpp"
+#include "coding/internal/file_data.hpp"
+#include "coding/traffic.hpp"
+
+#include "std/vector.hpp"
+
+using namespace tracking;
+
+namespace
+{
+using DataPoint = PointsQueue::DataPoint;
+
+string const kQueueFileName = "points_queue_test.dat";
+
+vector<DataPoint> MakePoints(uint64_t firstTimestamp, size_t count)
+{
+  vector<DataPoint> points;
+  for (size_t i = 0; i < count; ++i)
+  {
+    points.emplace_back(firstTimestamp + i, ms::LatLon(55.0 + i * 0.001, 37.0 - i * 0.001),
+                        static_cast<uint8_t>(i % 5));
+  }
+  return points;
+}
+
+void TestEqual(vector<DataPoint> const & actual, vector<DataPoint> const & expected)
+{
+  TEST_EQUAL(actual.size(), expected.size(), ());
+  for (size_t i = 0; i < actual.size(); ++i)
+  {
+    TEST_EQUAL(actual[i].m_timestamp, expected[i].m_timestamp, ());
+    TEST(actual[i].m_latLon.EqualDxDy(expected[i].m_latLon, 1e-5), (actual[i].m_latLon));
+    TEST_EQUAL(actual[i].m_traffic, expected[i].m_traffic, ());
+  }
+}
+
+UNIT_TEST(PointsQueue_PushAndRead)
+{
+  string const path = my::JoinFoldersToPath(GetPlatform().WritableDir(), kQueueFileName);
+  my::DeleteFileX(path);
+
+  auto const first = MakePoints(1000, 10);
+  auto const second = MakePoints(2000, 3);
+  {
+    PointsQueue queue(path, 1024 * 1024);
+    TEST(queue.IsEmpty(), ());
+    TEST(queue.Push(first), ());
+    TEST(queue.Push(second), ());
+    TEST(!queue.IsEmpty(), ());
+  }
+
+  // The points survive a restart.
+  PointsQueue queue(path, 1024 * 1024);
+  TEST(!queue.IsEmpty(), ());
+  auto expected = first;
+  expected.insert(expected.end(), second.begin(), second.end());
+  TestEqual(queue.ReadAll(), expected);
+
+  queue.Clear();
+  TEST(queue.IsEmpty(), ());
+  TEST(queue.ReadAll().empty(), ());
+}
+
+UNIT_TEST(PointsQueue_Limits)
+{
+  string const path = my::JoinFoldersToPath(GetPlatform().WritableDir(), kQueueFileName);
+  my::DeleteFileX(path);
+
+  PointsQueue disabled(string(), 1024);
+  TEST(!disabled.Push(MakePoints(0, 1)), ());
+  TEST(disabled.IsEmpty(), ());
+
+  PointsQueue queue(path, 64);
+  TEST(!queue.Push(MakePoints(0, 100)), ());
+  TEST(queue.IsEmpty(), ());
+  TEST(queue.Push(MakePoints(0, 2)), ());
+  TestEqual(queue.ReadAll(), MakePoints(0, 2));
+  queue.Clear();
+}
+}  // namespace
@@ -19,6 +19,8 @@ using namespace platform::tests_support;
 
 namespace
 {
+Platform::EConnectionType GetWiFiConnection() { return Platform::EConnectionType::CONNECTION_WIFI; }
+
 void TransferLocation(Reporter & reporter, TestSocket & testSocket, double timestamp,
                       double latidute, double longtitude)
 {
@@ -48,6 +50,7 @@ void TransferLocation(Reporter & reporter, TestSocket & testSocket, double times
     }
     case Packet::DataV0:
     case Packet::DataV1:
+    case Packet::DataV2:
     {
       readSize = 0;
       break;
@@ -92,7 +95,8 @@ UNIT_TEST(Reporter_TransferLocations)
   auto socket = make_unique<TestSocket>();
   TestSocket & testSocket = *socket.get();
 
-  Reporter reporter(move(socket), "localhost", 0, milliseconds(10) /* pushDelay */);
+  Reporter reporter(move(socket), "localhost", 0, milliseconds(10) /* pushDelay */,
+                    string() /* queueFilePath */, &GetWiFiConnection);
   TransferLocation(reporter, testSocket, 1.0, 2.0, 3.0);
   TransferLocation(reporter, testSocket, 4.0, 5.0, 6.0);
   TransferLocation(reporter, testSocket, 7.0, 8.0, 9.0);
@@ -26,5 +26,7 @@ win*|linux* {
 
 SOURCES += \
     $$ROOT_DIR/testing/testingmain.cpp \
+    ingestion_service_test.cpp \
+    points_queue_test.cpp \
     protocol_test.cpp \
     reporter_test.cpp \
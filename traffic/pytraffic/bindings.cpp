@@ -8,13 +8,17 @@
 #include "base/assert.hpp"
 #include "base/logging.hpp"
 #include "base/math.hpp"
+#include "base/thread.hpp"
 
+#include "std/algorithm.hpp"
+#include "std/atomic.hpp"
 #include "std/cstdint.hpp"
 #include "std/map.hpp"
 #include "std/sstream.hpp"
 #include "std/string.hpp"
 #include "std/vector.hpp"
 
+#include "pyhelpers/gil.hpp"
 #include "pyhelpers/vector_list_conversion.hpp"
 #include "pyhelpers/vector_uint8.hpp"
 
@@ -101,6 +105,44 @@ boost::python::list GenerateTrafficKeys(string const & mwmPath)
   return std_vector_to_python_list(result);
 }
 
+// Extracts traffic keys of |mwmPaths| in |numThreads| threads with the GIL released.
+// Returns a list of serialized keys in the order of mwms, the same as
+// generate_traffic_values_from_binary() takes.
+boost::python::list GenerateTrafficKeysBatch(boost::python::object const & mwmPaths,
+                                             size_t numThreads)
+{
+  auto const paths = python_list_to_std_vector<string>(mwmPaths);
+  vector<vector<uint8_t>> blobs(paths.size());
+
+  {
+    scoped_gil_release release;
+
+    atomic<size_t> nextPath(0);
+    auto const extractKeys = [&]() {
+      for (size_t i = nextPath++; i < paths.size(); i = nextPath++)
+      {
+        vector<traffic::TrafficInfo::RoadSegmentId> keys;
+        traffic::TrafficInfo::ExtractTrafficKeys(paths[i], keys);
+        traffic::TrafficInfo::SerializeTrafficKeys(keys, blobs[i]);
+      }
+    };
+
+    numThreads = max<size_t>(min(numThreads, paths.size()), 1);
+    vector<threads::SimpleThread> threads;
+    threads.reserve(numThreads - 1);
+    for (size_t i = 1; i < numThreads; ++i)
+      threads.emplace_back(extractKeys);
+    extractKeys();
+    for (auto & thread : threads)
+      thread.join();
+  }
+
+  boost::python::list result;
+  for (auto const & blob : blobs)
+    result.append(blob);
+  return result;
+}
+
 vector<uint8_t> GenerateTrafficValues(vector<traffic::TrafficInfo::RoadSegmentId> const & keys,
                                       boost::python::dict const & segmentMappingDict)
 {
@@ -197,6 +239,7 @@ BOOST_PYTHON_MODULE(pytraffic)
 
   def("load_classificator", LoadClassificator);
   def("generate_traffic_keys", GenerateTrafficKeys);
+  def("generate_traffic_keys_batch", GenerateTrafficKeysBatch);
   def("generate_traffic_values_from_list", GenerateTrafficValuesFromList);
   def("generate_traffic_values_from_binary", GenerateTrafficValuesFromBinary);
 }
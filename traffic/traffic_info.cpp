@@ -182,28 +182,36 @@ void TrafficInfo::ExtractTrafficKeys(string const & mwmPath, vector<RoadSegmentI
 {
   result.clear();
   feature::ForEachFromDat(mwmPath, [&](FeatureType const & ft, uint32_t const fid) {
-    if (!routing::CarModel::AllLimitsInstance().IsRoad(ft))
-      return;
-
-    ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
-    auto const numPoints = static_cast<uint16_t>(ft.GetPointsCount());
-    uint8_t const numDirs = routing::CarModel::AllLimitsInstance().IsOneWay(ft) ? 1 : 2;
-    for (uint16_t i = 0; i + 1 < numPoints; ++i)
-    {
-      for (uint8_t dir = 0; dir < numDirs; ++dir)
-        result.emplace_back(fid, i, dir);
-    }
+    AppendTrafficKeys(ft, fid, result);
   });
 
   ASSERT(is_sorted(result.begin(), result.end()), ());
 }
 
+// static
+void TrafficInfo::AppendTrafficKeys(FeatureType const & ft, uint32_t fid,
+                                    vector<RoadSegmentId> & result)
+{
+  if (!routing::CarModel::AllLimitsInstance().IsRoad(ft))
+    return;
+
+  ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
+  auto const numPoints = static_cast<uint16_t>(ft.GetPointsCount());
+  uint8_t const numDirs = routing::CarModel::AllLimitsInstance().IsOneWay(ft) ? 1 : 2;
+  for (uint16_t i = 0; i + 1 < numPoints; ++i)
+  {
+    for (uint8_t dir = 0; dir < numDirs; ++dir)
+      result.emplace_back(fid, i, dir);
+  }
+}
+
 // static
 void TrafficInfo::CombineColorings(vector<TrafficInfo::RoadSegmentId> const & keys,
                                    TrafficInfo::Coloring const & knownColors,
                                    TrafficInfo::Coloring & result)
 {
   result.clear();
+  result.reserve(keys.size());
   size_t numKnown = 0;
   size_t numUnknown = 0;
   size_t numUnexpectedKeys = knownColors.size();
@@ -212,12 +220,12 @@ void TrafficInfo::CombineColorings(vector<TrafficInfo::RoadSegmentId> const & ke
     auto it = knownColors.find(key);
     if (it == knownColors.end())
     {
-      result[key] = SpeedGroup::Unknown;
+      result.emplace(key, SpeedGroup::Unknown);
       ++numUnknown;
     }
     else
     {
-      result[key] = it->second;
+      result.emplace(key, it->second);
       ASSERT_GREATER(numUnexpectedKeys, 0, ());
       --numUnexpectedKeys;
       ++numKnown;
@@ -501,6 +509,9 @@ bool TrafficInfo::UpdateTrafficData(vector<SpeedGroup> const & values)
     return false;
   }
 
+  // The keys are sorted, so every segment is appended to the end of the coloring.
+  m_coloring.reserve(static_cast<size_t>(
+      count_if(values.cbegin(), values.cend(), [](SpeedGroup v) { return v != SpeedGroup::Unknown; })));
   for (size_t i = 0; i < m_keys.size(); ++i)
   {
     if (values[i] != SpeedGroup::Unknown)
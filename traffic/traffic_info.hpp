@@ -4,11 +4,14 @@
 
 #include "indexer/mwm_set.hpp"
 
+#include "base/flat_map.hpp"
+
 #include "std/cstdint.hpp"
-#include "std/map.hpp"
 #include "std/shared_ptr.hpp"
 #include "std/vector.hpp"
 
+class FeatureType;
+
 namespace platform
 {
 class HttpClient;
@@ -73,8 +76,9 @@ public:
     uint8_t m_dir : 1;
   };
 
-  // todo(@m) unordered_map?
-  using Coloring = map<RoadSegmentId, SpeedGroup>;
+  // The coloring is built from the sorted keys, so it's kept in a sorted vector:
+  // lookups from rendering and routing are binary searches over contiguous memory.
+  using Coloring = base::FlatMap<RoadSegmentId, SpeedGroup>;
 
   TrafficInfo() = default;
 
@@ -102,6 +106,11 @@ public:
   // Extracts RoadSegmentIds from mwm and stores them in a sorted order.
   static void ExtractTrafficKeys(string const & mwmPath, vector<RoadSegmentId> & result);
 
+  // Appends RoadSegmentIds of the feature |ft| with the index |fid| to |result| if it's a road.
+  // It's thread-safe, so keys of different ranges of features may be extracted in parallel.
+  static void AppendTrafficKeys(FeatureType const & ft, uint32_t fid,
+                                vector<RoadSegmentId> & result);
+
   // Adds the unknown values to the partially known coloring map |knownColors|
   // so that the keys of the resulting map are exactly |keys|.
   static void CombineColorings(vector<TrafficInfo::RoadSegmentId> const & keys,
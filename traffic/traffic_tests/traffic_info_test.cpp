@@ -137,5 +137,7 @@ UNIT_TEST(TrafficInfo_UpdateTrafficData)
   TEST(info.UpdateTrafficData(values2), ());
   for (size_t i = 0; i < keys.size(); ++i)
     TEST_EQUAL(info.GetSpeedGroup(keys[i]), values2[i], ());
+  // Unknown segments are not kept in the coloring.
+  TEST_EQUAL(info.GetColoring().size(), 2, ());
 }
 }  // namespace traffic
@@ -5,6 +5,8 @@
 
 #include "defines.hpp"
 
+#include "base/stl_add.hpp"
+
 namespace ugc
 {
 Loader::Loader(Index const & index) : m_index(index) {}
@@ -24,9 +26,29 @@ UGC Loader::GetUGC(FeatureID const & featureId)
   auto readerPtr = value.m_cont.GetReader(UGC_FILE_TAG);
 
   UGC ugc;
-  if (!m_d.Deserialize(*readerPtr.GetPtr(), featureId.m_index, ugc))
+  if (!GetDeserializer(featureId.m_mwmId).Deserialize(*readerPtr.GetPtr(), featureId.m_index, ugc))
     return {};
 
   return ugc;
 }
+
+binary::UGCDeserializer & Loader::GetDeserializer(MwmSet::MwmId const & id)
+{
+  auto const it = m_deserializers.find(id);
+  if (it != m_deserializers.end())
+    return *it->second;
+
+  // Deserializers of deregistered mwms are removed when a new mwm is seen.
+  for (auto jt = m_deserializers.begin(); jt != m_deserializers.end();)
+  {
+    if (jt->first.IsAlive())
+      ++jt;
+    else
+      jt = m_deserializers.erase(jt);
+  }
+
+  auto & d = m_deserializers[id];
+  d = my::make_unique<binary::UGCDeserializer>();
+  return *d;
+}
 }  // namespace ugc
@@ -3,11 +3,17 @@
 #include "ugc/binary/serdes.hpp"
 #include "ugc/types.hpp"
 
+#include "indexer/mwm_set.hpp"
+
+#include <map>
+#include <memory>
+
 class Index;
 struct FeatureID;
 
 namespace ugc
 {
+// *NOTE* This class is not thread-safe.
 class Loader
 {
 public:
@@ -15,7 +21,11 @@ public:
   UGC GetUGC(FeatureID const & featureId);
 
 private:
+  binary::UGCDeserializer & GetDeserializer(MwmSet::MwmId const & id);
+
   Index const & m_index;
-  binary::UGCDeserializer m_d;
+  // Deserializers cache headers, translation keys and texts of UGC
+  // sections, so there is a deserializer per mwm.
+  std::map<MwmSet::MwmId, std::unique_ptr<binary::UGCDeserializer>> m_deserializers;
 };
 }  // namespace ugc
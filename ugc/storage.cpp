@@ -11,8 +11,13 @@
 #include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
 #include "coding/internal/file_data.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/reader.hpp"
+#include "coding/write_to_sink.hpp"
 
 #include <algorithm>
+#include <cstring>
+#include <functional>
 #include <utility>
 
 #include "3party/jansson/myjansson.hpp"
@@ -24,6 +29,7 @@ using namespace std;
 namespace
 {
 string const kIndexFileName = "index.json";
+string const kJournalFileName = "index.journal.bin";
 string const kUGCUpdateFileName = "ugc.update.bin";
 string const kTmpFileExtension = ".tmp";
 
@@ -33,6 +39,11 @@ string GetUGCFilePath() { return my::JoinPath(GetPlatform().WritableDir(), kUGCU
 
 string GetIndexFilePath() { return my::JoinPath(GetPlatform().WritableDir(), kIndexFileName); }
 
+string GetJournalFilePath()
+{
+  return my::JoinPath(GetPlatform().WritableDir(), kJournalFileName);
+}
+
 bool GetUGCFileSize(uint64_t & size)
 {
   return GetPlatform().GetFileSizeByName(kUGCUpdateFileName, size);
@@ -70,8 +81,58 @@ string SerializeUGCIndex(vector<Storage::UGCIndex> const & indexes)
   unique_ptr<char, JSONFreeDeleter> buffer(json_dumps(array.get(), JSON_COMPACT | JSON_ENSURE_ASCII));
   return string(buffer.get());
 }
+
+uint64_t DoubleToBits(double d)
+{
+  static_assert(sizeof(double) == sizeof(uint64_t), "");
+  uint64_t bits;
+  memcpy(&bits, &d, sizeof(bits));
+  return bits;
+}
+
+double BitsToDouble(uint64_t bits)
+{
+  double d;
+  memcpy(&d, &bits, sizeof(d));
+  return d;
+}
+
+// Journal records are new records of the index, they are never deleted
+// or synchronized, so these flags are not stored.
+template <typename Sink>
+void SerializeJournalRecord(Sink & sink, Storage::UGCIndex const & index)
+{
+  WriteToSink(sink, DoubleToBits(index.m_mercator.x));
+  WriteToSink(sink, DoubleToBits(index.m_mercator.y));
+  WriteToSink(sink, index.m_type);
+  WriteToSink(sink, index.m_offset);
+  WriteToSink(sink, index.m_dataVersion);
+  WriteToSink(sink, index.m_featureId);
+  rw::Write(sink, index.m_mwmName);
+}
+
+template <typename Source>
+void DeserializeJournalRecord(Source & source, Storage::UGCIndex & index)
+{
+  index.m_mercator.x = BitsToDouble(ReadPrimitiveFromSource<uint64_t>(source));
+  index.m_mercator.y = BitsToDouble(ReadPrimitiveFromSource<uint64_t>(source));
+  index.m_type = ReadPrimitiveFromSource<uint32_t>(source);
+  index.m_offset = ReadPrimitiveFromSource<uint64_t>(source);
+  index.m_dataVersion = ReadPrimitiveFromSource<int64_t>(source);
+  index.m_featureId = ReadPrimitiveFromSource<uint32_t>(source);
+  rw::Read(source, index.m_mwmName);
+}
 }  // namespace
 
+size_t Storage::KeyHash::operator()(Key const & key) const
+{
+  auto const h = hash<double>();
+  size_t seed = hash<uint32_t>()(key.m_type);
+  seed ^= h(key.m_mercator.x) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  seed ^= h(key.m_mercator.y) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  return seed;
+}
+
 UGCUpdate Storage::GetUGCUpdate(FeatureID const & id) const
 {
   if (m_UGCIndexes.empty())
@@ -84,16 +145,13 @@ UGCUpdate Storage::GetUGCUpdate(FeatureID const & id) const
   th.SortBySpec();
   auto const type = th.GetBestType();
 
-  auto const index = find_if(
-      m_UGCIndexes.begin(), m_UGCIndexes.end(), [type, &mercator](UGCIndex const & index) -> bool {
-        return type == index.m_type && mercator == index.m_mercator && !index.m_deleted;
-      });
-
-  if (index == m_UGCIndexes.end())
+  auto const it = m_lookup.find(Key(type, mercator));
+  if (it == m_lookup.end())
     return {};
 
-  auto const offset = index->m_offset;
-  auto const size = static_cast<size_t>(UGCSizeAtIndex(distance(m_UGCIndexes.begin(), index)));
+  auto const position = it->second;
+  auto const offset = m_UGCIndexes[position].m_offset;
+  auto const size = static_cast<size_t>(UGCSizeAtIndex(position));
   vector<uint8_t> buf;
   buf.resize(size);
   auto const ugcFilePath = GetUGCFilePath();
@@ -123,16 +181,6 @@ void Storage::SetUGCUpdate(FeatureID const & id, UGCUpdate const & ugc)
   feature::TypesHolder th(*feature);
   th.SortBySpec();
   auto const type = th.GetBestType();
-  for (auto & index : m_UGCIndexes)
-  {
-    if (type == index.m_type && mercator == index.m_mercator && !index.m_deleted)
-    {
-      index.m_deleted = true;
-      m_numberOfDeleted++;
-      break;
-    }
-  }
-  // TODO: Call Defragmentation().
 
   UGCIndex index;
   uint64_t offset;
@@ -151,13 +199,15 @@ void Storage::SetUGCUpdate(FeatureID const & id, UGCUpdate const & ugc)
   {
     FileWriter w(ugcFilePath, FileWriter::Op::OP_APPEND);
     Serialize(w, ugc);
-    m_UGCIndexes.emplace_back(move(index));
   }
   catch (FileWriter::Exception const & exception)
   {
     LOG(LERROR, ("Exception while writing file:", ugcFilePath, "reason:", exception.Msg()));
     return;
   }
+
+  AddIndex(move(index));
+  AppendToJournal(m_UGCIndexes.back());
 }
 
 void Storage::Load()
@@ -172,7 +222,6 @@ void Storage::Load()
   catch (FileReader::Exception const & exception)
   {
     LOG(LWARNING, ("Exception while reading file:", indexFilePath, "reason:", exception.Msg()));
-    return;
   }
 
   DeserializeUGCIndex(data, m_UGCIndexes);
@@ -181,6 +230,10 @@ void Storage::Load()
     if (i.m_deleted)
       ++m_numberOfDeleted;
   }
+
+  BuildLookup();
+  LoadJournal();
+  Defragmentation();
 }
 
 void Storage::SaveIndex() const
@@ -198,13 +251,19 @@ void Storage::SaveIndex() const
   catch (FileWriter::Exception const & exception)
   {
     LOG(LERROR, ("Exception while writing file:", indexFilePath, "reason:", exception.Msg()));
+    return;
   }
+
+  // All journal records are in the snapshot now.
+  auto const journalFilePath = GetJournalFilePath();
+  if (GetPlatform().IsFileExistsByFullPath(journalFilePath))
+    my::DeleteFileX(journalFilePath);
 }
 
 void Storage::Defragmentation()
 {
   auto const indexesSize = m_UGCIndexes.size();
-  if (m_numberOfDeleted < indexesSize / 2)
+  if (m_numberOfDeleted == 0 || m_numberOfDeleted < indexesSize / 2)
     return;
 
   auto const ugcFilePath = GetUGCFilePath();
@@ -249,6 +308,10 @@ void Storage::Defragmentation()
   CHECK(my::RenameFileX(tmpUGCFilePath, ugcFilePath), ());
 
   m_numberOfDeleted = 0;
+  BuildLookup();
+
+  // Offsets of records are changed, so the journal is not valid anymore.
+  SaveIndex();
 }
 
 string Storage::GetUGCToSend() const
@@ -336,6 +399,75 @@ void Storage::MarkAllAsSynchronized()
   SaveIndex();
 }
 
+void Storage::AddIndex(UGCIndex && index)
+{
+  Key const key(index.m_type, index.m_mercator);
+  auto const it = m_lookup.find(key);
+  if (it != m_lookup.end())
+  {
+    m_UGCIndexes[it->second].m_deleted = true;
+    ++m_numberOfDeleted;
+  }
+
+  m_UGCIndexes.emplace_back(move(index));
+  m_lookup[key] = m_UGCIndexes.size() - 1;
+}
+
+void Storage::BuildLookup()
+{
+  m_lookup.clear();
+  for (size_t i = 0; i < m_UGCIndexes.size(); ++i)
+  {
+    auto const & index = m_UGCIndexes[i];
+    if (!index.m_deleted)
+      m_lookup[Key(index.m_type, index.m_mercator)] = i;
+  }
+}
+
+void Storage::AppendToJournal(UGCIndex const & index) const
+{
+  auto const journalFilePath = GetJournalFilePath();
+  try
+  {
+    FileWriter w(journalFilePath, FileWriter::Op::OP_APPEND);
+    SerializeJournalRecord(w, index);
+  }
+  catch (FileWriter::Exception const & exception)
+  {
+    LOG(LERROR, ("Exception while writing file:", journalFilePath, "reason:", exception.Msg()));
+  }
+}
+
+void Storage::LoadJournal()
+{
+  auto const journalFilePath = GetJournalFilePath();
+  if (!GetPlatform().IsFileExistsByFullPath(journalFilePath))
+    return;
+
+  try
+  {
+    FileReader r(journalFilePath);
+    ReaderSource<FileReader> source(r);
+    while (source.Size() > 0)
+    {
+      UGCIndex index;
+      DeserializeJournalRecord(source, index);
+
+      // Records are appended to the file of records, so records with
+      // lesser offsets are already in the snapshot.
+      if (!m_UGCIndexes.empty() && index.m_offset <= m_UGCIndexes.back().m_offset)
+        continue;
+      AddIndex(move(index));
+    }
+  }
+  catch (Reader::Exception const & exception)
+  {
+    // A record may be partially written when the app is killed, all
+    // previous records are loaded anyway.
+    LOG(LWARNING, ("Exception while reading file:", journalFilePath, "reason:", exception.Msg()));
+  }
+}
+
 uint64_t Storage::UGCSizeAtIndex(size_t const indexPosition) const
 {
   CHECK(!m_UGCIndexes.empty(), ());
@@ -7,8 +7,10 @@
 #include "base/thread_checker.hpp"
 #include "base/visitor.hpp"
 
+#include <cstddef>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class Index;
@@ -17,6 +19,12 @@ struct FeatureID;
 
 namespace ugc
 {
+// Stores UGC updates of a user in an append-only file of records.
+// Records are described by an index, which is saved as a json
+// snapshot. Every new record is also appended to a binary journal, so
+// the snapshot isn't rewritten on every update and the journal is
+// replayed over the snapshot on Load(). Actual (not deleted) records
+// are looked up by a hash table by type and position of a feature.
 class Storage
 {
 public:
@@ -44,7 +52,11 @@ public:
   void SaveIndex() const;
   std::string GetUGCToSend() const;
   void MarkAllAsSynchronized();
+  // Removes deleted records from the file of records and saves the
+  // index, if at least a half of records are deleted.
   void Defragmentation();
+  // Loads the index snapshot, replays the journal and compacts the
+  // file of records if needed.
   void Load();
 
   /// Testing
@@ -52,11 +64,38 @@ public:
   size_t GetNumberOfDeletedForTesting() const { return m_numberOfDeleted; }
 
 private:
+  struct Key
+  {
+    Key(uint32_t type, m2::PointD const & mercator) : m_type(type), m_mercator(mercator) {}
+
+    bool operator==(Key const & rhs) const
+    {
+      return m_type == rhs.m_type && m_mercator == rhs.m_mercator;
+    }
+
+    uint32_t m_type;
+    m2::PointD m_mercator;
+  };
+
+  struct KeyHash
+  {
+    size_t operator()(Key const & key) const;
+  };
+
+  // Appends |index| to the index and marks the previous record of the
+  // same feature as deleted.
+  void AddIndex(UGCIndex && index);
+  void BuildLookup();
+  void AppendToJournal(UGCIndex const & index) const;
+  void LoadJournal();
+
   uint64_t UGCSizeAtIndex(size_t const indexPosition) const;
   std::unique_ptr<FeatureType> GetFeature(FeatureID const & id) const;
 
   Index const & m_index;
   std::vector<UGCIndex> m_UGCIndexes;
+  // Positions of actual records in |m_UGCIndexes|.
+  std::unordered_map<Key, size_t, KeyHash> m_lookup;
   size_t m_numberOfDeleted = 0;
 };
 }  // namespace ugc
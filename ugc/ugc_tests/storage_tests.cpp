@@ -43,6 +43,11 @@ bool DeleteUGCFile()
 {
   return my::DeleteFileX(my::JoinPath(GetPlatform().WritableDir(), "ugc.update.bin"));
 }
+
+bool DeleteJournalFile()
+{
+  return my::DeleteFileX(my::JoinPath(GetPlatform().WritableDir(), "index.journal.bin"));
+}
 }  // namespace
 
 namespace ugc_tests
@@ -204,6 +209,7 @@ UNIT_TEST(StorageTests_DuplicatesAndDefragmentationSmoke)
   TEST_EQUAL(storage.GetNumberOfDeletedForTesting(), 0, ());
   TEST_EQUAL(last, storage.GetUGCUpdate(cafeId), ());
   TEST_EQUAL(first, storage.GetUGCUpdate(railwayId), ());
+  TEST(DeleteIndexFile(), ());
   TEST(DeleteUGCFile(), ());
 }
 
@@ -222,6 +228,7 @@ UNIT_TEST(StorageTests_DifferentTypes)
   storage.SetUGCUpdate(railwayId, railwayUGC);
   TEST_EQUAL(railwayUGC, storage.GetUGCUpdate(railwayId), ());
   TEST_EQUAL(cafeUGC, storage.GetUGCUpdate(cafeId), ());
+  TEST(DeleteJournalFile(), ());
   TEST(DeleteUGCFile(), ());
 }
 
@@ -257,5 +264,40 @@ UNIT_TEST(StorageTest_LoadIndex)
   storage.SetUGCUpdate(cafeId, cafeUGC);
   TEST_EQUAL(indexArray.size(), 3, ());
   TEST(DeleteIndexFile(), ());
+  TEST(DeleteJournalFile(), ());
+  TEST(DeleteUGCFile(), ());
+}
+
+UNIT_TEST(StorageTest_LoadJournal)
+{
+  auto & builder = MwmBuilder::Builder();
+  m2::PointD const cafePoint(1.0, 1.0);
+  m2::PointD const railwayPoint(2.0, 2.0);
+  builder.Build({TestCafe(cafePoint), TestRailway(railwayPoint)});
+  auto const cafeId = builder.FeatureIdForCafeAtPoint(cafePoint);
+  auto const railwayId = builder.FeatureIdForRailwayAtPoint(railwayPoint);
+  auto const cafeUGC = MakeTestUGCUpdate(Time(chrono::hours(24 * 10)));
+  auto const railwayUGC = MakeTestUGCUpdate(Time(chrono::hours(24 * 300)));
+
+  {
+    Storage storage(builder.GetIndex());
+    storage.Load();
+    storage.SetUGCUpdate(cafeId, cafeUGC);
+    storage.SaveIndex();
+    // The snapshot is not saved after these updates, they are in the journal only.
+    storage.SetUGCUpdate(railwayId, cafeUGC);
+    storage.SetUGCUpdate(railwayId, railwayUGC);
+  }
+
+  // One of three records is deleted, so the file of records is
+  // compacted on load and the journal is merged into the snapshot.
+  Storage storage(builder.GetIndex());
+  storage.Load();
+  TEST_EQUAL(storage.GetIndexesForTesting().size(), 2, ());
+  TEST_EQUAL(storage.GetNumberOfDeletedForTesting(), 0, ());
+  TEST_EQUAL(cafeUGC, storage.GetUGCUpdate(cafeId), ());
+  TEST_EQUAL(railwayUGC, storage.GetUGCUpdate(railwayId), ());
+  TEST(!DeleteJournalFile(), ());
+  TEST(DeleteIndexFile(), ());
   TEST(DeleteUGCFile(), ());
 }